@@ -70,6 +70,16 @@ NS_BEGIN(analysis)
 // -----------------------------------------------------------------------------
 
 struct text_token_stream::state_t {
+  struct cached_term_t {
+    std::string word; // the word as found in the input (UTF8)
+    bstring term; // the term produced for the word
+    bool ignored{ false }; // the word is one of the ignored words
+  };
+
+  std::string ascii_data; // the input if tokenized without ICU, i.e. plain ASCII
+  size_t ascii_offset{ 0 }; // the current position in 'ascii_data'
+  bool ascii{ false }; // use 'ascii_data' instead of 'break_iterator'
+  bool ascii_case{ false }; // case conversion of ASCII letters is locale independent
   std::shared_ptr<icu::BreakIterator> break_iterator;
   icu::UnicodeString data;
   icu::Locale icu_locale;
@@ -77,7 +87,9 @@ struct text_token_stream::state_t {
   std::shared_ptr<const icu::Normalizer2> normalizer;
   const options_t& options;
   std::shared_ptr<sb_stemmer> stemmer;
+  std::vector<cached_term_t> term_cache; // direct-mapped cache of processed words
   std::string tmp_buf; // used by processTerm(...)
+  std::string tmp_word; // used by next()
   std::shared_ptr<icu::Transliterator> transliterator;
   state_t(const options_t& opts): icu_locale("C"), options(opts) {
     // NOTE: use of the default constructor for Locale() or
@@ -299,6 +311,180 @@ irs::analysis::analyzer::ptr construct(
   return nullptr;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of entries in the term cache of an analyzer instance, the
+///        instances are pooled, so common words stay cached across documents
+////////////////////////////////////////////////////////////////////////////////
+const size_t TERM_CACHE_SIZE = 1024;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief longer words are not cached, they rarely repeat
+////////////////////////////////////////////////////////////////////////////////
+const size_t TERM_CACHE_MAX_WORD = 32;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief skip ignored tokens and stem the normalized word in state.tmp_buf
+////////////////////////////////////////////////////////////////////////////////
+bool process_word(
+  irs::analysis::text_token_stream::bytes_term& term,
+  irs::analysis::text_token_stream::state_t& state
+) {
+  std::string& word_utf8 = state.tmp_buf;
+
+  // ...........................................................................
+  // skip ignored tokens
+  // ...........................................................................
+  if (state.options.ignored_words.find(word_utf8) != state.options.ignored_words.end()) {
+    return false;
+  }
+
+  // ...........................................................................
+  // find the token stem
+  // ...........................................................................
+  if (state.stemmer) {
+    static_assert(sizeof(sb_symbol) == sizeof(char), "sizeof(sb_symbol) != sizeof(char)");
+    const sb_symbol* value = reinterpret_cast<sb_symbol const*>(word_utf8.c_str());
+
+    value = sb_stemmer_stem(state.stemmer.get(), value, (int)word_utf8.size());
+
+    if (value) {
+      static_assert(sizeof(irs::byte_type) == sizeof(sb_symbol), "sizeof(irs::byte_type) != sizeof(sb_symbol)");
+      term.value(irs::bytes_ref(reinterpret_cast<const irs::byte_type*>(value), sb_stemmer_length(state.stemmer.get())));
+
+      return true;
+    }
+  }
+
+  // ...........................................................................
+  // use the value of the unstemmed token
+  // ...........................................................................
+  static_assert(sizeof(irs::byte_type) == sizeof(char), "sizeof(irs::byte_type) != sizeof(char)");
+  term.value(irs::bstring(irs::ref_cast<irs::byte_type>(word_utf8).c_str(), word_utf8.size()));
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief process a word via 'process' unless its term is cached
+/// @param word the word as found in the input (UTF8)
+////////////////////////////////////////////////////////////////////////////////
+template<typename Process>
+bool process_cached_term(
+  irs::analysis::text_token_stream::bytes_term& term,
+  irs::analysis::text_token_stream::state_t& state,
+  const irs::string_ref& word,
+  Process process
+) {
+  if (word.size() > TERM_CACHE_MAX_WORD) {
+    return process();
+  }
+
+  if (state.term_cache.empty()) {
+    state.term_cache.resize(TERM_CACHE_SIZE);
+  }
+
+  auto& entry = state.term_cache[std::hash<irs::string_ref>()(word) % TERM_CACHE_SIZE];
+
+  if (!entry.word.empty() && irs::string_ref(entry.word) == word) {
+    if (entry.ignored) {
+      return false;
+    }
+
+    term.value(entry.term); // valid until the entry is replaced by a later word
+
+    return true;
+  }
+
+  auto const processed = process();
+
+  entry.word.assign(word.c_str(), word.size());
+  entry.ignored = !processed;
+
+  if (processed) {
+    entry.term.assign(term.value().c_str(), term.value().size());
+  } else {
+    entry.term.clear();
+  }
+
+  return processed;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief process a plain ASCII word, normalization and removal of accents do
+///        not change ASCII text, and case conversion is done without ICU
+////////////////////////////////////////////////////////////////////////////////
+bool process_ascii_term(
+  irs::analysis::text_token_stream::bytes_term& term,
+  irs::analysis::text_token_stream::state_t& state,
+  const irs::string_ref& data
+) {
+  std::string& word_utf8 = state.tmp_buf;
+
+  word_utf8.assign(data.c_str(), data.size());
+
+  switch (state.options.case_convert) {
+   case irs::analysis::text_token_stream::options_t::case_convert_t::LOWER:
+    for (auto& c: word_utf8) {
+      if (c >= 'A' && c <= 'Z') {
+        c += 'a' - 'A';
+      }
+    }
+    break;
+   case irs::analysis::text_token_stream::options_t::case_convert_t::UPPER:
+    for (auto& c: word_utf8) {
+      if (c >= 'a' && c <= 'z') {
+        c -= 'a' - 'A';
+      }
+    }
+    break;
+   default:
+    {} // NOOP
+  };
+
+  return process_word(term, state);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @return the input can be split into words without ICU, i.e. it is plain
+///         ASCII without characters whose word-break properties depend on the
+///         ICU version or locale (':' and '_')
+////////////////////////////////////////////////////////////////////////////////
+bool is_simple_ascii(const std::string& data) NOEXCEPT {
+  for (auto c: data) {
+    if (static_cast<unsigned char>(c) >= 0x80 || c == ':' || c == '_') {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+inline bool is_ascii_alpha(char c) NOEXCEPT {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+inline bool is_ascii_digit(char c) NOEXCEPT {
+  return c >= '0' && c <= '9';
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @return the character between prev and next does not break a word, as per
+///         the Unicode word boundary rules WB6, WB7, WB11 and WB12
+////////////////////////////////////////////////////////////////////////////////
+bool is_ascii_mid(char prev, char c, char next) NOEXCEPT {
+  switch (c) {
+   case '.': // MidNumLet
+   case '\'': // Single_Quote
+    return (is_ascii_alpha(prev) && is_ascii_alpha(next))
+      || (is_ascii_digit(prev) && is_ascii_digit(next));
+   case ',': // MidNum
+   case ';': // MidNum
+    return is_ascii_digit(prev) && is_ascii_digit(next);
+   default:
+    return false;
+  }
+}
+
 bool process_term(
   irs::analysis::text_token_stream::bytes_term& term,
   irs::analysis::text_token_stream::state_t& state,
@@ -342,37 +528,7 @@ bool process_term(
   word_utf8.clear();
   word.toUTF8String(word_utf8);
 
-  // ...........................................................................
-  // skip ignored tokens
-  // ...........................................................................
-  if (state.options.ignored_words.find(word_utf8) != state.options.ignored_words.end()) {
-    return false;
-  }
-
-  // ...........................................................................
-  // find the token stem
-  // ...........................................................................
-  if (state.stemmer) {
-    static_assert(sizeof(sb_symbol) == sizeof(char), "sizeof(sb_symbol) != sizeof(char)");
-    const sb_symbol* value = reinterpret_cast<sb_symbol const*>(word_utf8.c_str());
-
-    value = sb_stemmer_stem(state.stemmer.get(), value, (int)word_utf8.size());
-
-    if (value) {
-      static_assert(sizeof(irs::byte_type) == sizeof(sb_symbol), "sizeof(irs::byte_type) != sizeof(sb_symbol)");
-      term.value(irs::bytes_ref(reinterpret_cast<const irs::byte_type*>(value), sb_stemmer_length(state.stemmer.get())));
-
-      return true;
-    }
-  }
-
-  // ...........................................................................
-  // use the value of the unstemmed token
-  // ...........................................................................
-  static_assert(sizeof(irs::byte_type) == sizeof(char), "sizeof(irs::byte_type) != sizeof(char)");
-  term.value(irs::bstring(irs::ref_cast<irs::byte_type>(word_utf8).c_str(), word_utf8.size()));
-
-  return true;
+  return process_word(term, state);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -590,6 +746,11 @@ bool text_token_stream::reset(const string_ref& data) {
     if (state_->icu_locale.isBogus()) {
       return false;
     }
+
+    auto const language = std::string(irs::locale_utils::language(state_->locale));
+
+    // Turkish and Azeri map 'i' and 'I' to dotted and dotless variants
+    state_->ascii_case = language != "tr" && language != "az";
   }
 
   auto err = UErrorCode::U_ZERO_ERROR; // a value that passes the U_SUCCESS() test
@@ -662,6 +823,18 @@ bool text_token_stream::reset(const string_ref& data) {
     return false; // ICU UnicodeString signatures can handle at most INT32_MAX
   }
 
+  // ...........................................................................
+  // tokenise plain ASCII data without ICU
+  // ...........................................................................
+  state_->ascii = state_->ascii_case && is_simple_ascii(data_utf8);
+
+  if (state_->ascii) {
+    state_->ascii_data = std::move(data_utf8);
+    state_->ascii_offset = 0;
+
+    return true;
+  }
+
   state_->data = icu::UnicodeString::fromUTF8(
     icu::StringPiece(data_utf8.c_str(), (int32_t)(data_utf8.size()))
   );
@@ -675,6 +848,10 @@ bool text_token_stream::reset(const string_ref& data) {
 }
 
 bool text_token_stream::next() {
+  if (state_->ascii) {
+    return next_ascii();
+  }
+
   // ...........................................................................
   // find boundaries of the next word
   // ...........................................................................
@@ -686,8 +863,19 @@ bool text_token_stream::next() {
     // ...........................................................................
     // skip whitespace and unsuccessful terms
     // ...........................................................................
-    if (UWordBreak::UBRK_WORD_NONE == state_->break_iterator->getRuleStatus()
-        || !process_term(term_, *state_, state_->data.tempSubString(start, end - start))) {
+    if (UWordBreak::UBRK_WORD_NONE == state_->break_iterator->getRuleStatus()) {
+      continue;
+    }
+
+    auto word = state_->data.tempSubString(start, end - start);
+    auto& word_utf8 = state_->tmp_word;
+
+    word_utf8.clear();
+    word.toUTF8String(word_utf8);
+
+    if (!process_cached_term(term_, *state_, word_utf8, [this, &word]()->bool {
+          return process_term(term_, *state_, word);
+        })) {
       continue;
     }
 
@@ -699,6 +887,56 @@ bool text_token_stream::next() {
   return false;
 }
 
+bool text_token_stream::next_ascii() {
+  auto const& data = state_->ascii_data;
+  auto& offset = state_->ascii_offset;
+  auto const size = data.size();
+
+  while (offset < size) {
+    // ...........................................................................
+    // skip whitespace and punctuation
+    // ...........................................................................
+    if (!is_ascii_alpha(data[offset]) && !is_ascii_digit(data[offset])) {
+      ++offset;
+      continue;
+    }
+
+    // ...........................................................................
+    // find the end of the word, letters and digits do not break a word
+    // ...........................................................................
+    auto const start = offset;
+
+    for (;;) {
+      while (offset < size
+             && (is_ascii_alpha(data[offset]) || is_ascii_digit(data[offset]))) {
+        ++offset;
+      }
+
+      if (offset + 1 < size
+          && is_ascii_mid(data[offset - 1], data[offset], data[offset + 1])) {
+        ++offset;
+        continue;
+      }
+
+      break;
+    }
+
+    irs::string_ref const word(data.c_str() + start, offset - start);
+
+    if (!process_cached_term(term_, *state_, word, [this, &word]()->bool {
+          return process_ascii_term(term_, *state_, word);
+        })) {
+      continue;
+    }
+
+    offs_.start = uint32_t(start);
+    offs_.end = uint32_t(offset);
+    return true;
+  }
+
+  return false;
+}
+
 NS_END // analysis
 NS_END // ROOT
 
@@ -83,6 +83,8 @@ class text_token_stream : public analyzer, util::noncopyable {
   virtual bool reset(const string_ref& data) override;
 
  private:
+  bool next_ascii(); // next() for plain ASCII input
+
   irs::attribute_view attrs_;
   std::shared_ptr<state_t> state_;
   irs::offset offs_;
@@ -94,6 +94,51 @@ TEST_F(TextAnalyzerParserTestSuite, test_nbsp_whitespace) {
   ASSERT_FALSE(pStream->next());
 }
 
+TEST_F(TextAnalyzerParserTestSuite, test_ascii_tokenization) {
+  irs::analysis::text_token_stream::options_t options;
+
+  options.locale = "en_US.UTF-8";
+
+  // plain ASCII is tokenized without ICU, a trailing non-ASCII word forces ICU
+  std::string sDataASCII = "Don't stop, 3.14 1,000;5 e.g. foo-bar x;y a.1 Jumped jumped JUMPED the The";
+  std::string sDataUTF8 = sDataASCII + " \xC3\xA9t\xC3\xA9";
+  irs::analysis::text_token_stream asciiStream(options);
+  irs::analysis::text_token_stream icuStream(options);
+
+  ASSERT_TRUE(asciiStream.reset(sDataASCII));
+  ASSERT_TRUE(icuStream.reset(sDataUTF8));
+
+  auto& asciiOffset = asciiStream.attributes().get<iresearch::offset>();
+  auto& asciiValue = asciiStream.attributes().get<iresearch::term_attribute>();
+  auto& icuOffset = icuStream.attributes().get<iresearch::offset>();
+  auto& icuValue = icuStream.attributes().get<iresearch::term_attribute>();
+  size_t count = 0;
+
+  while (asciiStream.next()) {
+    ASSERT_TRUE(icuStream.next());
+    ASSERT_EQ(
+      std::string((char*)(icuValue->value().c_str()), icuValue->value().size()),
+      std::string((char*)(asciiValue->value().c_str()), asciiValue->value().size())
+    );
+    ASSERT_EQ(icuOffset->start, asciiOffset->start);
+    ASSERT_EQ(icuOffset->end, asciiOffset->end);
+    ++count;
+  }
+
+  ASSERT_EQ(16, count);
+  ASSERT_TRUE(icuStream.next()); // the non-ASCII word
+  ASSERT_EQ("ete", std::string((char*)(icuValue->value().c_str()), icuValue->value().size()));
+  ASSERT_FALSE(icuStream.next());
+
+  // cached terms are reused by the next reset(...)
+  ASSERT_TRUE(asciiStream.reset("JUMPED"));
+  ASSERT_TRUE(asciiStream.next());
+  ASSERT_EQ("jump", std::string((char*)(asciiValue->value().c_str()), asciiValue->value().size()));
+  ASSERT_EQ(0, asciiOffset->start);
+  ASSERT_EQ(6, asciiOffset->end);
+  ASSERT_FALSE(asciiStream.next());
+}
+
 TEST_F(TextAnalyzerParserTestSuite, test_text_analyzer) {
   std::unordered_set<std::string> emptySet;
   std::string sField = "test field";
@@ -51,6 +51,12 @@ std::string const pubApiPrefix("/_api/agency/");
 std::string const privApiPrefix("/_api/agency_priv/");
 std::string const NO_LEADER("");
 
+// Minimum and maximum number of log entries in one appendEntriesRPC, and
+// the volume of log entries after which no more are added to it
+static constexpr index_t minAppendEntries = 100;
+static constexpr index_t maxAppendEntries = 2000;
+static constexpr size_t maxAppendEntriesBytes = 16 * 1024 * 1024;
+
 /// Agent configuration
 Agent::Agent(config_t const& config)
     : Thread("Agent"),
@@ -487,12 +493,23 @@ void Agent::sendAppendEntriesRPC() {
         lastConfirmed = _state.lastCompactionAt() - 1;
       }
 
+      // The next appendEntriesRPC to a follower is only sent once the
+      // previous one was answered, or 30 seconds after it was sent (see
+      // below, at most 5 can be in flight). Everything that has been
+      // appended in the meantime goes out with the next one. Thus the
+      // package grows with the backlog of the follower, e.g. in a burst of
+      // writes or when it is catching up, such that it needs as few round
+      // trips as possible.
+      index_t const batchSize = (std::min)(
+          (std::max)(_state.lastIndex() - lastConfirmed, minAppendEntries), maxAppendEntries);
+
       LOG_TOPIC("7c578", TRACE, Logger::AGENCY) << "Getting unconfirmed from " << lastConfirmed
-                                       << " to " << lastConfirmed + 99;
+                                       << " to " << lastConfirmed + batchSize - 1;
       // If lastConfirmed is one minus the first log entry, then this is
       // corrected in _state::get and we only get from the beginning of the
       // log.
-      std::vector<log_t> unconfirmed = _state.get(lastConfirmed, lastConfirmed + 99);
+      std::vector<log_t> unconfirmed =
+          _state.get(lastConfirmed, lastConfirmed + batchSize - 1);
 
       lockTime = steady_clock::now() - startTime;
       if (lockTime.count() > 0.2) {
@@ -527,7 +544,7 @@ void Agent::sendAppendEntriesRPC() {
       }
       index_t lowest = unconfirmed.front().index;
 
-      Store snapshot(this, "snapshot");
+      std::shared_ptr<VPackBuilder const> snapshot;
       index_t snapshotIndex;
       term_t snapshotTerm;
 
@@ -575,21 +592,25 @@ void Agent::sendAppendEntriesRPC() {
 
       if (needSnapshot) {
         {
+          // the snapshot is sent on as it was persisted, there is no need to
+          // build a store from it
+          TRI_ASSERT(snapshot != nullptr);
           VPackObjectBuilder guard(&builder);
-          builder.add(VPackValue("readDB"));
-          {
-            VPackArrayBuilder guard2(&builder);
-            snapshot.dumpToBuilder(builder);
-          }
+          builder.add("readDB", snapshot->slice().get("readDB"));
           builder.add("term", VPackValue(snapshotTerm));
           builder.add("index", VPackValue(snapshotIndex));
         }
       }
 
       size_t toLog = 0;
+      size_t toLogBytes = 0;
       index_t highest = 0;
       for (size_t i = 0; i < unconfirmed.size(); ++i) {
         auto const& entry = unconfirmed.at(i);
+        if (toLog > 0 && toLogBytes > maxAppendEntriesBytes) {
+          // the rest goes out with the next package
+          break;
+        }
         if (entry.index > lastConfirmed) {
           // This condition is crucial, because usually we have one more
           // entry than we need in unconfirmed, so we want to skip this. If,
@@ -606,6 +627,7 @@ void Agent::sendAppendEntriesRPC() {
           builder.close();
           highest = entry.index;
           ++toLog;
+          toLogBytes += entry.entry->size();
         }
       }
       builder.close();
@@ -644,7 +666,7 @@ void Agent::sendAppendEntriesRPC() {
 
       LOG_TOPIC("2d80d", DEBUG, Logger::AGENCY)
           << "Appending (" << (uint64_t)(TRI_microtime() * 1000000000.0) << ") "
-          << unconfirmed.size() - 1 << " entries up to index " << highest
+          << toLog << " entries up to index " << highest
           << (needSnapshot ? " and a snapshot" : "") << " to follower "
           << followerId << ". Next real log contact to " << followerId << " in: "
           << std::chrono::duration<double, std::milli>(earliestPackage - steady_clock::now())
@@ -1590,6 +1612,10 @@ Store const& Agent::spearhead() const { return _spearhead; }
 ///   Safe ONLY IF via executeLock() (see example Supervisor.cpp)
 Store const& Agent::readDB() const { return _readDB; }
 
+/// Get commit index of _readDB with intentionally no lock acquired here.
+///   Safe ONLY IF via executeLock() (see example Supervisor.cpp)
+arangodb::consensus::index_t Agent::readDBIndex() const { return _commitIndex; }
+
 /// Get readdb
 arangodb::consensus::index_t Agent::readDB(Node& node) const {
   READ_LOCKER(oLocker, _outputLock);
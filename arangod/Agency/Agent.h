@@ -230,6 +230,12 @@ class Agent final : public arangodb::Thread, public AgentInterface {
   ///  executeLockedWrite() with a lambda function
   Store const& readDB() const;
 
+  /// @brief Get commit index, up to which _readDB has applied the log
+  ///  WARNING: this assumes caller holds appropriate
+  ///  locks or will use executeLockedRead() or
+  ///  executeLockedWrite() with a lambda function
+  index_t readDBIndex() const;
+
   /// @brief Get spearhead store
   ///  WARNING: this assumes caller holds appropriate
   ///  locks or will use executeLockedRead() or
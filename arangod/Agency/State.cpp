@@ -63,6 +63,8 @@ State::State()
       _collectionsLoaded(false),
       _nextCompactionAfter(0),
       _lastCompactionAt(0),
+      _lastSnapshotIndex(0),
+      _lastSnapshotTerm(0),
       _queryRegistry(nullptr),
       _cur(0) {}
 
@@ -785,6 +787,35 @@ bool State::loadPersisted() {
 /// is reset to the state after log index `index` has been applied. Sets
 /// `index` to 0 if there is no compacted snapshot.
 bool State::loadLastCompactedSnapshot(Store& store, index_t& index, term_t& term) {
+  std::shared_ptr<VPackBuilder const> snapshot;
+  if (!loadLastCompactedSnapshot(snapshot, index, term)) {
+    return false;
+  }
+  if (snapshot != nullptr) {
+    try {
+      store = snapshot->slice();
+    } catch (std::exception const& e) {
+      LOG_TOPIC("8ef2a", ERR, Logger::AGENCY) << e.what() << " " << __FILE__ << __LINE__;
+      return false;
+    }
+  }
+  return true;
+}
+
+/// @brief get the last compacted snapshot as persisted, served from memory
+/// whenever possible
+bool State::loadLastCompactedSnapshot(std::shared_ptr<VPackBuilder const>& snapshot,
+                                      index_t& index, term_t& term) {
+  {
+    MUTEX_LOCKER(guard, _lastSnapshotLock);
+    if (_lastSnapshot != nullptr) {
+      snapshot = _lastSnapshot;
+      index = _lastSnapshotIndex;
+      term = _lastSnapshotTerm;
+      return true;
+    }
+  }
+
   auto bindVars = std::make_shared<VPackBuilder>();
   bindVars->openObject();
   bindVars->close();
@@ -809,15 +840,19 @@ bool State::loadLastCompactedSnapshot(Store& store, index_t& index, term_t& term
       VPackSlice i = result[0];
       VPackSlice ii = i.resolveExternals();
       try {
-        store = ii;
         index = basics::StringUtils::uint64(ii.get("_key").copyString());
         term = ii.get("term").getNumber<uint64_t>();
+        auto builder = std::make_shared<VPackBuilder>();
+        builder->add(ii);
+        snapshot = builder;
+        rememberLastSnapshot(snapshot, index, term);
         return true;
       } catch (std::exception const& e) {
-        LOG_TOPIC("8ef2a", ERR, Logger::AGENCY) << e.what() << " " << __FILE__ << __LINE__;
+        LOG_TOPIC("0b7c3", ERR, Logger::AGENCY) << e.what() << " " << __FILE__ << __LINE__;
       }
     } else if (result.length() == 0) {
       // No compaction snapshot yet
+      snapshot.reset();
       index = 0;
       term = 0;
       return true;
@@ -1283,6 +1318,7 @@ bool State::persistCompactionSnapshot(index_t cind, arangodb::consensus::term_t
 
     if (res.ok()) {
       _lastCompactionAt = cind;
+      rememberLastSnapshot(std::make_shared<VPackBuilder>(std::move(store)), cind, term);
     }
 
     return res.ok();
@@ -1294,6 +1330,19 @@ bool State::persistCompactionSnapshot(index_t cind, arangodb::consensus::term_t
   return false;
 }
 
+/// @brief keep the latest compaction snapshot in memory, an older one
+/// never replaces a younger one, as the "compact" collection is always
+/// looked at in descending order
+void State::rememberLastSnapshot(std::shared_ptr<VPackBuilder const> snapshot,
+                                 index_t index, term_t term) {
+  MUTEX_LOCKER(guard, _lastSnapshotLock);
+  if (_lastSnapshot == nullptr || index >= _lastSnapshotIndex) {
+    _lastSnapshot = std::move(snapshot);
+    _lastSnapshotIndex = index;
+    _lastSnapshotTerm = term;
+  }
+}
+
 /// @brief restoreLogFromSnapshot, needed in the follower, this erases the
 /// complete log and persists the given snapshot. After this operation, the
 /// log is empty and something ought to be appended to it rather quickly.
@@ -167,6 +167,13 @@ class State {
   /// `index` to 0 if there is no compacted snapshot.
   bool loadLastCompactedSnapshot(Store& store, index_t& index, term_t& term);
 
+  /// @brief get the last compacted snapshot as persisted, i.e. an object
+  /// with attribute "readDB", without rebuilding a store from it. Returns
+  /// true if successful, `snapshot` is nullptr and `index` 0 if there is
+  /// no compacted snapshot yet.
+  bool loadLastCompactedSnapshot(std::shared_ptr<VPackBuilder const>& snapshot,
+                                 index_t& index, term_t& term);
+
   /// @brief lastCompactedAt
   index_t lastCompactionAt() const;
 
@@ -186,6 +193,10 @@ class State {
                                  arangodb::consensus::term_t term,
                                  arangodb::consensus::Store& snapshot);
 
+  /// @brief Keep the latest compaction snapshot in memory
+  void rememberLastSnapshot(std::shared_ptr<VPackBuilder const> snapshot,
+                            index_t index, term_t term);
+
   /// @brief storeLogFromSnapshot, needed in the follower, this erases the
   /// complete log and persists the given snapshot. After this operation, the
   /// log is empty and something ought to be appended to it rather quickly.
@@ -259,6 +270,14 @@ class State {
   std::atomic<index_t> _nextCompactionAfter;
   std::atomic<index_t> _lastCompactionAt;
 
+  /// @brief last compaction snapshot as persisted and its index and term,
+  /// kept in memory so that neither compaction nor followers, which need
+  /// a snapshot, have to read it back from the "compact" collection
+  mutable arangodb::Mutex _lastSnapshotLock;
+  std::shared_ptr<VPackBuilder const> _lastSnapshot;
+  index_t _lastSnapshotIndex;
+  term_t _lastSnapshotTerm;
+
   /// @brief Our query registry
   aql::QueryRegistry* _queryRegistry;
 
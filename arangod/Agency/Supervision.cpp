@@ -32,6 +32,7 @@
 #include "Agency/FailedServer.h"
 #include "Agency/Job.h"
 #include "Agency/JobContext.h"
+#include "Agency/MoveShard.h"
 #include "Agency/RemoveFollower.h"
 #include "Agency/Store.h"
 #include "ApplicationFeatures/ApplicationServer.h"
@@ -163,6 +164,7 @@ Supervision::Supervision()
     : arangodb::CriticalThread("Supervision"),
       _agent(nullptr),
       _snapshot("Supervision"),
+      _snapshotIndex(0),
       _transient("Transient"),
       _frequency(1.),
       _gracePeriod(10.),
@@ -183,6 +185,7 @@ static std::string const syncPrefix = "/Sync/ServerStates/";
 static std::string const supervisionPrefix = "/Supervision";
 static std::string const healthPrefix = "/Supervision/Health/";
 static std::string const targetShortID = "/Target/MapUniqueToShortID/";
+static std::string const rebalanceShardLeadersKey = "/Target/RebalanceShardLeaders";
 static std::string const currentServersRegisteredPrefix =
     "/Current/ServersRegistered";
 static std::string const foxxmaster = "/Current/Foxxmaster";
@@ -684,8 +687,15 @@ bool Supervision::updateSnapshot() {
   }
 
   _agent->executeLockedRead([&]() {
-    if (_agent->readDB().has(_agencyPrefix)) {
-      _snapshot = _agent->readDB().get(_agencyPrefix);
+    // Copying the persistent store is expensive with a large Plan. Nothing
+    // has changed in it, unless the commit index has moved since our last
+    // copy, in which case we can keep on using it.
+    index_t const commitIndex = _agent->readDBIndex();
+    if (_snapshotIndex == 0 || commitIndex != _snapshotIndex) {
+      if (_agent->readDB().has(_agencyPrefix)) {
+        _snapshot = _agent->readDB().get(_agencyPrefix);
+        _snapshotIndex = commitIndex;
+      }
     }
     if (_agent->transient().has(_agencyPrefix)) {
       _transient = _agent->transient().get(_agencyPrefix);
@@ -768,6 +778,7 @@ void Supervision::run() {
       if (_agent->readDB().has(supervisionNode)) {
         try {
           _snapshot = _agent->readDB().get(supervisionNode);
+          _snapshotIndex = 0;
           if (_snapshot.children().size() > 0) {
             done = true;
           }
@@ -1118,6 +1129,9 @@ bool Supervision::handleJobs() {
   LOG_TOPIC("76ffe", TRACE, Logger::SUPERVISION) << "Begin shrinkCluster";
   shrinkCluster();
 
+  LOG_TOPIC("3c5d1", TRACE, Logger::SUPERVISION) << "Begin rebalanceShardLeaders";
+  rebalanceShardLeaders();
+
   LOG_TOPIC("43256", TRACE, Logger::SUPERVISION) << "Begin enforceReplication";
   enforceReplication();
 
@@ -1648,6 +1662,112 @@ void Supervision::shrinkCluster() {
   }
 }
 
+bool Supervision::findLeaderMove(Node const& snapshot, LeaderMove& move) {
+  // Count the planned shard leaders of all healthy DB servers:
+  std::unordered_map<std::string, size_t> leaders;
+  for (auto const& server : Job::availableServers(snapshot)) {
+    if (snapshot.hasAsString(healthPrefix + server + "/Status").first ==
+        HEALTH_STATUS_GOOD) {
+      leaders.emplace(server, 0);
+    }
+  }
+  if (leaders.size() < 2) {
+    return false;
+  }
+
+  auto const& databases = snapshot.hasAsChildren(planColPrefix).first;
+  for (auto const& database : databases) {
+    for (auto const& collection : database.second->children()) {
+      for (auto const& shard : collection.second->hasAsChildren("shards").first) {
+        VPackSlice servers = shard.second->slice();
+        if (servers.isArray() && servers.length() > 0) {
+          auto it = leaders.find(servers[0].copyString());
+          if (it != leaders.end()) {
+            ++it->second;
+          }
+        }
+      }
+    }
+  }
+
+  size_t fewest = leaders.begin()->second;
+  for (auto const& it : leaders) {
+    fewest = (std::min)(fewest, it.second);
+  }
+
+  // Moving the leadership of w shards from a server with a leaders to one
+  // with b leaders evens out the distribution, iff a > b + w. Pick the
+  // handover that improves the most:
+  size_t bestGain = 0;
+  for (auto const& database : databases) {
+    for (auto const& collection : database.second->children()) {
+      if (collection.second->has("distributeShardsLike")) {
+        // Leadership changes together with the prototype's
+        continue;
+      }
+      for (auto const& shard : collection.second->hasAsChildren("shards").first) {
+        VPackSlice servers = shard.second->slice();
+        if (!servers.isArray() || servers.length() < 2) {
+          continue;
+        }
+        std::string const from = servers[0].copyString();
+        auto source = leaders.find(from);
+        if (source == leaders.end() || source->second <= fewest + 1 ||
+            snapshot.has(blockedServersPrefix + from) ||
+            snapshot.has(blockedShardsPrefix + shard.first)) {
+          continue;
+        }
+        std::string const to = Job::findNonblockedCommonHealthyInSyncFollower(
+            snapshot, database.first, collection.first, shard.first);
+        auto target = leaders.find(to);
+        if (target == leaders.end()) {
+          continue;
+        }
+        size_t weight =
+            Job::clones(snapshot, database.first, collection.first, shard.first).size();
+        if (source->second > target->second + weight &&
+            source->second - target->second - weight > bestGain) {
+          bestGain = source->second - target->second - weight;
+          move = LeaderMove{database.first, collection.first, shard.first, from, to};
+        }
+      }
+    }
+  }
+
+  return bestGain > 0;
+}
+
+void Supervision::rebalanceShardLeaders() {
+  _lock.assertLockedByCurrentThread();
+
+  if (!_snapshot.hasAsBool(rebalanceShardLeadersKey).first) {
+    return;
+  }
+
+  // This is low priority, and at most one handover at a time:
+  auto const& todo = _snapshot.hasAsChildren(toDoPrefix).first;
+  auto const& pending = _snapshot.hasAsChildren(pendingPrefix).first;
+  if (!todo.empty() || !pending.empty()) {
+    return;
+  }
+
+  LeaderMove move;
+  if (!findLeaderMove(_snapshot, move)) {
+    return;
+  }
+
+  LOG_TOPIC("a7e20", INFO, Logger::SUPERVISION)
+      << "Moving leadership of shard " << move.shard << " of " << move.database
+      << "/" << move.collection << " from " << move.from << " to " << move.to
+      << " to balance shard leaders";
+
+  // The new leader is an in-sync follower already, so no data is moved:
+  MoveShard(_snapshot, _agent, std::to_string(_jobId++), "supervision",
+            move.database, move.collection, move.shard, move.from, move.to,
+            /*isLeader*/ true, /*remainsFollower*/ true)
+      .create();
+}
+
 // Start thread
 bool Supervision::start() {
   Thread::start();
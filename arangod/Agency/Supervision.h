@@ -170,10 +170,28 @@ class Supervision : public arangodb::CriticalThread {
 
   void shrinkCluster();
 
+  /// @brief Hand shard leadership from DB servers with many leaders to
+  ///        in-sync followers on DB servers with few, if enabled in Target
+  void rebalanceShardLeaders();
+
  public:
   static void cleanupLostCollections(Node const& snapshot, AgentInterface* agent,
                                      uint64_t& jobId);
 
+  /// @brief Handover of a shard's leadership to one of its in-sync followers
+  struct LeaderMove {
+    std::string database;
+    std::string collection;
+    std::string shard;
+    std::string from;
+    std::string to;
+  };
+
+  /// @brief Find the leadership handover that evens out the number of shard
+  ///        leaders on the healthy DB servers the most. Returns false, if no
+  ///        handover would improve the balance.
+  static bool findLeaderMove(Node const& snapshot, LeaderMove& move);
+
  private:
   /**
    * @brief Report status of supervision in agency
@@ -192,6 +210,7 @@ class Supervision : public arangodb::CriticalThread {
   Mutex _lock;   // guards snapshot, _jobId, jobIdMax, _selfShutdown
   Agent* _agent; /**< @brief My agent */
   Node _snapshot;
+  index_t _snapshotIndex;  // commit index of _snapshot, 0 if unknown
   Node _transient;
 
   arangodb::basics::ConditionVariable _cv; /**< @brief Control if thread
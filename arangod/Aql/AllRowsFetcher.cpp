@@ -99,6 +99,14 @@ std::pair<ExecutionState, SharedAqlItemBlockPtr> AllRowsFetcher::fetchBlock() {
   return res;
 }
 
+std::pair<ExecutionState, SharedAqlItemBlockPtr> AllRowsFetcher::fetchBlockForSpilling() {
+  TRI_ASSERT(_aqlItemMatrix == nullptr);
+  if (_upstreamState == ExecutionState::DONE) {
+    return {ExecutionState::DONE, nullptr};
+  }
+  return fetchBlock();
+}
+
 std::pair<ExecutionState, SharedAqlItemBlockPtr> AllRowsFetcher::fetchBlockForModificationExecutor(
     std::size_t limit = ExecutionBlock::DefaultBatchSize()) {
   while (_upstreamState != ExecutionState::DONE) {
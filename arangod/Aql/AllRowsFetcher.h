@@ -98,6 +98,24 @@ class AllRowsFetcher {
    */
   TEST_VIRTUAL std::pair<ExecutionState, size_t> preFetchNumberOfRows(size_t);
 
+  /**
+   * @brief Fetch the next block from upstream without keeping it in the
+   *        matrix. To be used by executors that bound their own memory
+   *        usage, e.g. by spilling to disk. Must not be mixed with
+   *        fetchAllRows() and preFetchNumberOfRows().
+   *
+   * @return A pair with the following properties:
+   *         ExecutionState:
+   *           WAITING => IO going on, immediatly return to caller.
+   *           DONE => No more to expect from Upstream.
+   *           HASMORE => There may be more blocks.
+   *
+   *         SharedAqlItemBlockPtr:
+   *           If WAITING => nullptr.
+   *           Otherwise the next block, or a nullptr if there was none left.
+   */
+  TEST_VIRTUAL std::pair<ExecutionState, SharedAqlItemBlockPtr> fetchBlockForSpilling();
+
   // only for ModificationNodes
   std::pair<ExecutionState, SharedAqlItemBlockPtr> fetchBlockForModificationExecutor(std::size_t);
 
@@ -436,6 +436,13 @@ void AqlFunctionFeature::addMiscFunctions() {
   add({"COLLECTION_COUNT", ".h", Function::makeFlags(), &Functions::CollectionCount});  // not deterministic and not cacheable
   add({"PREGEL_RESULT", ".", Function::makeFlags(FF::CanRunOnDBServer),
        &Functions::PregelResult});  // not deterministic and not cacheable
+  add({"GRAPH_PAGERANK", ".h|.", Function::makeFlags(), &Functions::GraphPageRank});  // not deterministic and not cacheable
+  add({"GRAPH_CONNECTED_COMPONENTS", ".h", Function::makeFlags(),
+       &Functions::GraphConnectedComponents});  // not deterministic and not cacheable
+  add({"GRAPH_DEGREE_CENTRALITY", ".h|.", Function::makeFlags(),
+       &Functions::GraphDegreeCentrality});  // not deterministic and not cacheable
+  add({"GRAPH_TRIANGLE_COUNT", ".h", Function::makeFlags(),
+       &Functions::GraphTriangleCount});  // not deterministic and not cacheable
   add({"ASSERT", ".,.", Function::makeFlags(FF::CanRunOnDBServer), &Functions::Assert});  // not deterministic and not cacheable
   add({"WARN", ".,.", Function::makeFlags(FF::CanRunOnDBServer), &Functions::Warn});  // not deterministic and not cacheable
 
@@ -40,7 +40,11 @@ using VelocyPackHelper = arangodb::basics::VelocyPackHelper;
 
 /// @brief create the block
 AqlItemBlock::AqlItemBlock(AqlItemBlockManager& manager, size_t nrItems, RegisterId nrRegs)
-    : _nrItems(nrItems), _nrRegs(nrRegs), _manager(manager), _refCount(0) {
+    : _nrItems(nrItems),
+      _nrRegs(nrRegs),
+      _layout(manager.layout()),
+      _manager(manager),
+      _refCount(0) {
   TRI_ASSERT(nrItems > 0);  // empty AqlItemBlocks are not allowed!
 
   if (nrRegs > 0) {
@@ -246,10 +250,10 @@ void AqlItemBlock::destroy() noexcept {
       auto &it = _data[i];
       if (it.requiresDestruction()) {
         auto it2 = _valueCount.find(it);
-        if (it2 != _valueCount.end()) {  // if we know it, we are still responsible
-          TRI_ASSERT((*it2).second > 0);
+        if (it2 != nullptr) {  // if we know it, we are still responsible
+          TRI_ASSERT(it2->count > 0);
 
-          if (--((*it2).second) == 0) {
+          if (--(it2->count) == 0) {
             decreaseMemoryUsage(it.memoryUsage());
             it.destroy();
             _valueCount.erase(it2);
@@ -286,27 +290,43 @@ void AqlItemBlock::shrink(size_t nrItems) {
   }
 
   decreaseMemoryUsage(sizeof(AqlValue) * (_nrItems - nrItems) * _nrRegs);
-  
-  for (size_t i = _nrItems * _nrRegs; i < _data.size(); ++i) {
-    AqlValue& a = _data[i];
-    if (a.requiresDestruction()) {
-      auto it = _valueCount.find(a);
 
-      if (it != _valueCount.end()) {
-        TRI_ASSERT((*it).second > 0);
+  // clean the superfluous rows
+  for (size_t row = nrItems; row < _nrItems; ++row) {
+    for (RegisterId col = 0; col < _nrRegs; ++col) {
+      AqlValue& a = _data[getAddress(row, col)];
+      if (a.requiresDestruction()) {
+        auto it = _valueCount.find(a);
 
-        if (--((*it).second) == 0) {
-          decreaseMemoryUsage(a.memoryUsage());
-          a.destroy();
-          try {
+        if (it != nullptr) {
+          TRI_ASSERT(it->count > 0);
+
+          if (--(it->count) == 0) {
+            decreaseMemoryUsage(a.memoryUsage());
+            a.destroy();
             _valueCount.erase(it);
             continue;  // no need for an extra a.erase() here
-          } catch (...) {
           }
         }
       }
+      a.erase();
+    }
+  }
+
+  if (_layout == AqlItemBlockLayout::ColumnMajor) {
+    // the column stride changes with the number of rows, so the remaining
+    // values have to be moved to their new positions. the target position
+    // of a value is never behind its source position, so a single forward
+    // pass suffices (column 0 stays where it is)
+    for (RegisterId col = 1; col < _nrRegs; ++col) {
+      for (size_t row = 0; row < nrItems; ++row) {
+        AqlValue& from = _data[col * _nrItems + row];
+        AqlValue& to = _data[col * nrItems + row];
+        TRI_ASSERT(to.isEmpty());
+        to = from;
+        from.erase();
+      }
     }
-    a.erase();
   }
 
   // adjust the size of the block
@@ -356,22 +376,19 @@ void AqlItemBlock::rescale(size_t nrItems, RegisterId nrRegs) {
 void AqlItemBlock::clearRegisters(std::unordered_set<RegisterId> const& toClear) {
   for (size_t i = 0; i < _nrItems; i++) {
     for (auto const& reg : toClear) {
-      AqlValue& a(_data[_nrRegs * i + reg]);
+      AqlValue& a(_data[getAddress(i, reg)]);
 
       if (a.requiresDestruction()) {
         auto it = _valueCount.find(a);
 
-        if (it != _valueCount.end()) {
-          TRI_ASSERT((*it).second > 0);
+        if (it != nullptr) {
+          TRI_ASSERT(it->count > 0);
 
-          if (--((*it).second) == 0) {
+          if (--(it->count) == 0) {
             decreaseMemoryUsage(a.memoryUsage());
             a.destroy();
-            try {
-              _valueCount.erase(it);
-              continue;  // no need for an extra a.erase() here
-            } catch (...) {
-            }
+            _valueCount.erase(it);
+            continue;  // no need for an extra a.erase() here
           }
         }
       }
@@ -391,7 +408,7 @@ SharedAqlItemBlockPtr AqlItemBlock::slice(size_t from, size_t to) const {
 
   for (size_t row = from; row < to; row++) {
     for (RegisterId col = 0; col < _nrRegs; col++) {
-      AqlValue const& a(_data[row * _nrRegs + col]);
+      AqlValue const& a(_data[getAddress(row, col)]);
 
       if (!a.isEmpty()) {
         if (a.requiresDestruction()) {
@@ -435,7 +452,7 @@ SharedAqlItemBlockPtr AqlItemBlock::slice(size_t row,
       continue;
     }
 
-    AqlValue const& a(_data[row * _nrRegs + col]);
+    AqlValue const& a(_data[getAddress(row, col)]);
 
     if (!a.isEmpty()) {
       if (a.requiresDestruction()) {
@@ -462,6 +479,53 @@ SharedAqlItemBlockPtr AqlItemBlock::slice(size_t row,
   return res;
 }
 
+/// @brief slice/clone rows [from, to) for a subset of the registers, this
+/// does a deep copy of all entries
+SharedAqlItemBlockPtr AqlItemBlock::slice(size_t from, size_t to,
+                                          std::unordered_set<RegisterId> const& registers,
+                                          size_t newNrRegs) const {
+  TRI_ASSERT(from < to && to <= _nrItems);
+  TRI_ASSERT(_nrRegs <= newNrRegs);
+
+  std::unordered_set<AqlValue> cache;
+  cache.reserve((to - from) * registers.size() / 4 + 1);
+
+  SharedAqlItemBlockPtr res{_manager.requestBlock(to - from, newNrRegs)};
+
+  for (size_t row = from; row < to; row++) {
+    for (RegisterId col = 0; col < _nrRegs; col++) {
+      if (registers.find(col) == registers.end()) {
+        continue;
+      }
+
+      AqlValue const& a(_data[getAddress(row, col)]);
+
+      if (!a.isEmpty()) {
+        if (a.requiresDestruction()) {
+          auto it = cache.find(a);
+
+          if (it == cache.end()) {
+            AqlValue b = a.clone();
+            try {
+              res->setValue(row - from, col, b);
+            } catch (...) {
+              b.destroy();
+              throw;
+            }
+            cache.emplace(b);
+          } else {
+            res->setValue(row - from, col, (*it));
+          }
+        } else {
+          res->setValue(row - from, col, a);
+        }
+      }
+    }
+  }
+
+  return res;
+}
+
 /// @brief slice/clone chosen rows for a subset, this does a deep copy
 /// of all entries
 SharedAqlItemBlockPtr AqlItemBlock::slice(std::vector<size_t> const& chosen,
@@ -475,7 +539,7 @@ SharedAqlItemBlockPtr AqlItemBlock::slice(std::vector<size_t> const& chosen,
 
   for (size_t row = from; row < to; row++) {
     for (RegisterId col = 0; col < _nrRegs; col++) {
-      AqlValue const& a(_data[chosen[row] * _nrRegs + col]);
+      AqlValue const& a(_data[getAddress(chosen[row], col)]);
 
       if (!a.isEmpty()) {
         if (a.requiresDestruction()) {
@@ -517,7 +581,7 @@ SharedAqlItemBlockPtr AqlItemBlock::steal(std::vector<size_t> const& chosen,
 
   for (size_t row = from; row < to; row++) {
     for (RegisterId col = 0; col < _nrRegs; col++) {
-      AqlValue& a(_data[chosen[row] * _nrRegs + col]);
+      AqlValue& a(_data[getAddress(chosen[row], col)]);
 
       if (!a.isEmpty()) {
         steal(a);
@@ -634,7 +698,7 @@ void AqlItemBlock::toVelocyPack(transaction::Methods* trx, VPackBuilder& result)
   size_t pos = 2;  // write position in raw
   for (RegisterId column = 0; column < _nrRegs; column++) {
     for (size_t i = 0; i < _nrItems; i++) {
-      AqlValue const& a(_data[i * _nrRegs + column]);
+      AqlValue const& a(_data[getAddress(i, column)]);
 
       // determine current state
       if (a.isEmpty()) {
@@ -25,6 +25,7 @@
 #define ARANGOD_AQL_AQL_ITEM_BLOCK_H 1
 
 #include "Aql/AqlValue.h"
+#include "Aql/AqlValueCountTable.h"
 #include "Aql/Range.h"
 #include "Aql/ResourceUsage.h"
 #include "Aql/types.h"
@@ -55,6 +56,13 @@ class SharedAqlItemBlockPtr;
 // copies. Furthermore, when parts of an AqlItemBlock are handed on
 // to another AqlItemBlock, then the <AqlValue>s inside must be copied
 // (deep copy) to make the blocks independent.
+//
+// The values can either be stored row-major (all registers of an item are
+// adjacent, the default) or column-major (all items of a register are
+// adjacent). The layout is chosen by the AqlItemBlockManager that creates
+// the block and is transparent to all users of getValue/setValue and thus
+// to InputAqlItemRow and OutputAqlItemRow. Only code that wants to scan a
+// single register sequentially via getColumn() needs to care about it.
 
 class AqlItemBlock {
   friend class AqlItemBlockManager;
@@ -84,6 +92,15 @@ class AqlItemBlock {
  private:
   void destroy() noexcept;
 
+  /// @brief position of the value for (index, varNr) inside _data,
+  /// depending on the layout of the block
+  inline size_t getAddress(size_t index, RegisterId varNr) const noexcept {
+    if (_layout == AqlItemBlockLayout::RowMajor) {
+      return index * _nrRegs + varNr;
+    }
+    return static_cast<size_t>(varNr) * _nrItems + index;
+  }
+
   ResourceMonitor& resourceMonitor() noexcept;
 
   inline void increaseMemoryUsage(size_t value) {
@@ -95,35 +112,52 @@ class AqlItemBlock {
   }
 
  public:
+  /// @brief memory layout of this block
+  inline AqlItemBlockLayout layout() const noexcept { return _layout; }
+
+  /// @brief whether or not all values of a register are stored adjacently
+  inline bool hasContiguousRegisters() const noexcept {
+    return _layout == AqlItemBlockLayout::ColumnMajor;
+  }
+
+  /// @brief get a pointer to the first value of a register. the values of
+  /// all _nrItems rows follow it contiguously. only valid for column-major
+  /// blocks
+  inline AqlValue const* getColumn(RegisterId varNr) const {
+    TRI_ASSERT(hasContiguousRegisters());
+    TRI_ASSERT(varNr < _nrRegs);
+    return _data.data() + getAddress(0, varNr);
+  }
+
   /// @brief getValue, get the value of a register
   inline AqlValue getValue(size_t index, RegisterId varNr) const {
     TRI_ASSERT(index < _nrItems);
     TRI_ASSERT(varNr < _nrRegs);
-    return _data[index * _nrRegs + varNr];
+    return _data[getAddress(index, varNr)];
   }
 
   /// @brief getValue, get the value of a register by reference
   inline AqlValue const& getValueReference(size_t index, RegisterId varNr) const {
     TRI_ASSERT(index < _nrItems);
     TRI_ASSERT(varNr < _nrRegs);
-    return _data[index * _nrRegs + varNr];
+    return _data[getAddress(index, varNr)];
   }
 
   /// @brief setValue, set the current value of a register
   inline void setValue(size_t index, RegisterId varNr, AqlValue const& value) {
     TRI_ASSERT(index < _nrItems);
     TRI_ASSERT(varNr < _nrRegs);
-    TRI_ASSERT(_data[index * _nrRegs + varNr].isEmpty());
+    TRI_ASSERT(_data[getAddress(index, varNr)].isEmpty());
 
     // First update the reference count, if this fails, the value is empty
     if (value.requiresDestruction()) {
-      if (++_valueCount[value] == 1) {
+      if (_valueCount.increase(value) == 1) {
         size_t mem = value.memoryUsage();
         increaseMemoryUsage(mem);
       }
     }
 
-    _data[index * _nrRegs + varNr] = value;
+    _data[getAddress(index, varNr)] = value;
   }
 
   /// @brief emplaceValue, set the current value of a register, constructing
@@ -135,7 +169,7 @@ class AqlItemBlock {
     TRI_ASSERT(index < _nrItems);
     TRI_ASSERT(varNr < _nrRegs);
 
-    AqlValue* p = &_data[index * _nrRegs + varNr];
+    AqlValue* p = &_data[getAddress(index, varNr)];
     TRI_ASSERT(p->isEmpty());
     // construct the AqlValue in place
     AqlValue* value;
@@ -143,14 +177,14 @@ class AqlItemBlock {
       value = new (p) AqlValue(std::forward<Args>(args)...);
     } catch (...) {
       // clean up the cell
-      _data[index * _nrRegs + varNr].erase();
+      _data[getAddress(index, varNr)].erase();
       throw;
     }
 
     try {
       // Now update the reference count, if this fails, we'll roll it back
       if (value->requiresDestruction()) {
-        if (++_valueCount[*value] == 1) {
+        if (_valueCount.increase(*value) == 1) {
           increaseMemoryUsage(value->memoryUsage());
         }
       }
@@ -159,7 +193,7 @@ class AqlItemBlock {
       value->~AqlValue();
       // TODO - instead of disabling it completly we could you use
       // a constexpr if() with c++17
-      _data[index * _nrRegs + varNr].destroy();
+      _data[getAddress(index, varNr)].destroy();
       throw;
     }
   }
@@ -169,13 +203,13 @@ class AqlItemBlock {
   /// use with caution only in special situations when it can be ensured that
   /// no one else will be pointing to the same value
   void destroyValue(size_t index, RegisterId varNr) {
-    auto& element = _data[index * _nrRegs + varNr];
+    auto& element = _data[getAddress(index, varNr)];
 
     if (element.requiresDestruction()) {
       auto it = _valueCount.find(element);
 
-      if (it != _valueCount.end()) {
-        if (--(it->second) == 0) {
+      if (it != nullptr) {
+        if (--(it->count) == 0) {
           decreaseMemoryUsage(element.memoryUsage());
           _valueCount.erase(it);
           element.destroy();
@@ -190,18 +224,15 @@ class AqlItemBlock {
   /// @brief eraseValue, erase the current value of a register not freeing it
   /// this is used if the value is stolen and later released from elsewhere
   void eraseValue(size_t index, RegisterId varNr) {
-    auto& element = _data[index * _nrRegs + varNr];
+    auto& element = _data[getAddress(index, varNr)];
 
     if (element.requiresDestruction()) {
       auto it = _valueCount.find(element);
 
-      if (it != _valueCount.end()) {
-        if (--(it->second) == 0) {
+      if (it != nullptr) {
+        if (--(it->count) == 0) {
           decreaseMemoryUsage(element.memoryUsage());
-          try {
-            _valueCount.erase(it);
-          } catch (...) {
-          }
+          _valueCount.erase(it);
         }
       }
     }
@@ -220,11 +251,9 @@ class AqlItemBlock {
       }
     }
 
-    for (auto const& it : _valueCount) {
-      if (it.second > 0) {
-        decreaseMemoryUsage(it.first.memoryUsage());
-      }
-    }
+    _valueCount.forEach([this](AqlValue const& value, uint32_t) {
+      decreaseMemoryUsage(value.memoryUsage());
+    });
     _valueCount.clear();
   }
 
@@ -245,13 +274,13 @@ class AqlItemBlock {
     TRI_ASSERT(currentRow != fromRow);
 
     for (RegisterId i = 0; i < curRegs; i++) {
-      if (_data[currentRow * _nrRegs + i].isEmpty()) {
+      if (_data[getAddress(currentRow, i)].isEmpty()) {
         // First update the reference count, if this fails, the value is empty
-        if (_data[fromRow * _nrRegs + i].requiresDestruction()) {
-          ++_valueCount[_data[fromRow * _nrRegs + i]];
+        if (_data[getAddress(fromRow, i)].requiresDestruction()) {
+          _valueCount.increase(_data[getAddress(fromRow, i)]);
         }
-        TRI_ASSERT(_data[currentRow * _nrRegs + i].isEmpty());
-        _data[currentRow * _nrRegs + i] = _data[fromRow * _nrRegs + i];
+        TRI_ASSERT(_data[getAddress(currentRow, i)].isEmpty());
+        _data[getAddress(currentRow, i)] = _data[getAddress(fromRow, i)];
       }
     }
   }
@@ -266,9 +295,9 @@ class AqlItemBlock {
       if (getValueReference(currentRow, reg).isEmpty()) {
         // First update the reference count, if this fails, the value is empty
         if (getValueReference(fromRow, reg).requiresDestruction()) {
-          ++_valueCount[getValueReference(fromRow, reg)];
+          _valueCount.increase(getValueReference(fromRow, reg));
         }
-        _data[currentRow * _nrRegs + reg] = getValueReference(fromRow, reg);
+        _data[getAddress(currentRow, reg)] = getValueReference(fromRow, reg);
       }
     }
   }
@@ -276,12 +305,15 @@ class AqlItemBlock {
   /// @brief valueCount
   /// this is used if the value is stolen and later released from elsewhere
   uint32_t valueCount(AqlValue const& v) const {
+    if (!v.requiresDestruction()) {
+      return 0;
+    }
     auto it = _valueCount.find(v);
 
-    if (it == _valueCount.end()) {
+    if (it == nullptr) {
       return 0;
     }
-    return it->second;
+    return it->count;
   }
 
   /// @brief steal, steal an AqlValue from an AqlItemBlock, it will never free
@@ -313,6 +345,12 @@ class AqlItemBlock {
 
   inline size_t capacity() const noexcept { return _data.capacity(); }
 
+  /// @brief change the memory layout. the block must be empty
+  void setLayout(AqlItemBlockLayout layout) noexcept {
+    TRI_ASSERT(_valueCount.empty());
+    _layout = layout;
+  }
+
   /// @brief shrink the block to the specified number of rows
   /// the superfluous rows are cleaned
   void shrink(size_t nrItems);
@@ -334,6 +372,11 @@ class AqlItemBlock {
   SharedAqlItemBlockPtr slice(size_t row, std::unordered_set<RegisterId> const& registers,
                       size_t newNrRegs) const;
 
+  /// @brief create an AqlItemBlock with the rows [from, to), with copies
+  /// of the specified registers from the current block
+  SharedAqlItemBlockPtr slice(size_t from, size_t to, std::unordered_set<RegisterId> const& registers,
+                              size_t newNrRegs) const;
+
   /// @brief slice/clone chosen rows for a subset, this does a deep copy
   /// of all entries
   SharedAqlItemBlockPtr slice(std::vector<size_t> const& chosen, size_t from, size_t to) const;
@@ -364,12 +407,12 @@ class AqlItemBlock {
   std::vector<AqlValue> _data;
 
   /// @brief _valueCount, since we have to allow for identical AqlValues
-  /// in an AqlItemBlock, this map keeps track over which AqlValues we
+  /// in an AqlItemBlock, this table keeps track over which AqlValues we
   /// have in this AqlItemBlock and how often.
-  /// setValue above puts values in the map and increases the count if they
+  /// setValue above puts values in the table and increases the count if they
   /// are already there, eraseValue decreases the count. One can ask the
   /// count with valueCount.
-  std::unordered_map<AqlValue, uint32_t> _valueCount;
+  AqlValueCountTable _valueCount;
 
   /// @brief _nrItems, number of rows
   size_t _nrItems = 0;
@@ -377,6 +420,9 @@ class AqlItemBlock {
   /// @brief _nrRegs, number of columns
   RegisterId _nrRegs = 0;
 
+  /// @brief _layout, memory layout of _data
+  AqlItemBlockLayout _layout = AqlItemBlockLayout::RowMajor;
+
   /// @brief manager for this item block
   AqlItemBlockManager& _manager;
 
@@ -24,6 +24,7 @@
 #include "AqlItemBlockManager.h"
 
 #include "Aql/AqlItemBlock.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/VelocyPackHelper.h"
 
 using namespace arangodb::aql;
@@ -32,12 +33,21 @@ using VelocyPackHelper = arangodb::basics::VelocyPackHelper;
 
 /// @brief create the manager
 AqlItemBlockManager::AqlItemBlockManager(ResourceMonitor* resourceMonitor) 
-    : _resourceMonitor(resourceMonitor) {
+    : _resourceMonitor(resourceMonitor),
+      _layout(AqlItemBlockLayout::RowMajor),
+      _threadSafe(false) {
   TRI_ASSERT(resourceMonitor != nullptr);
 }
 
 /// @brief destroy the manager
-AqlItemBlockManager::~AqlItemBlockManager() = default;
+AqlItemBlockManager::~AqlItemBlockManager() {
+  for (auto& sizeClass : _sizeClasses) {
+    for (auto* block : sizeClass.blocks) {
+      delete block;
+    }
+    sizeClass.blocks.clear();
+  }
+}
 
 /// @brief request a block with the specified size
 SharedAqlItemBlockPtr AqlItemBlockManager::requestBlock(size_t nrItems, RegisterId nrRegs) {
@@ -46,28 +56,36 @@ SharedAqlItemBlockPtr AqlItemBlockManager::requestBlock(size_t nrItems, Register
   size_t const targetSize = nrItems * nrRegs;
 
   AqlItemBlock* block = nullptr;
-  size_t i = Bucket::getId(targetSize);
-
-  int tries = 0;
-  while (tries++ < 2) {
-    TRI_ASSERT(i < numBuckets);
-    if (!_buckets[i].empty()) {
-      block = _buckets[i].pop();
-      TRI_ASSERT(block != nullptr);
-      TRI_ASSERT(block->numEntries() == 0);
-      block->rescale(nrItems, nrRegs);
-      // LOG_TOPIC("7157d", TRACE, arangodb::Logger::FIXME) << "returned cached
-      // AqlItemBlock with dimensions " << block->size() << " x " <<
-      // block->getNrRegs();
-      break;
-    }
-    // try next (bigger) bucket
-    if (++i >= numBuckets) {
-      break;
+  {
+    // rescaling the block accounts memory, so it is done outside the lock
+    CONDITIONAL_MUTEX_LOCKER(locker, _mutex, _threadSafe);
+    block = popFromSizeClass(nrItems, nrRegs);
+
+    size_t i = Bucket::getId(targetSize);
+
+    int tries = 0;
+    while (block == nullptr && tries++ < 2) {
+      TRI_ASSERT(i < numBuckets);
+      if (!_buckets[i].empty()) {
+        block = _buckets[i].pop();
+        TRI_ASSERT(block != nullptr);
+        // LOG_TOPIC("7157d", TRACE, arangodb::Logger::FIXME) << "returned cached
+        // AqlItemBlock with dimensions " << block->size() << " x " <<
+        // block->getNrRegs();
+        break;
+      }
+      // try next (bigger) bucket
+      if (++i >= numBuckets) {
+        break;
+      }
     }
   }
 
-  if (block == nullptr) {
+  if (block != nullptr) {
+    TRI_ASSERT(block->numEntries() == 0);
+    block->rescale(nrItems, nrRegs);
+    block->setLayout(_layout);
+  } else {
     block = new AqlItemBlock(*this, nrItems, nrRegs);
     // LOG_TOPIC("eb998", TRACE, arangodb::Logger::FIXME) << "created AqlItemBlock with
     // dimensions " << block->size() << " x " << block->getNrRegs();
@@ -77,6 +95,7 @@ SharedAqlItemBlockPtr AqlItemBlockManager::requestBlock(size_t nrItems, Register
   TRI_ASSERT(block->size() == nrItems);
   TRI_ASSERT(block->getNrRegs() == nrRegs);
   TRI_ASSERT(block->numEntries() == targetSize);
+  TRI_ASSERT(block->layout() == _layout);
   TRI_ASSERT(block->getRefCount() == 0);
 
   return SharedAqlItemBlockPtr{block};
@@ -93,6 +112,9 @@ void AqlItemBlockManager::returnBlock(AqlItemBlock*& block) noexcept {
   size_t const targetSize = block->capacity();
   size_t const i = Bucket::getId(targetSize);
   TRI_ASSERT(i < numBuckets);
+  // the shape is lost in destroy()
+  size_t const nrItems = block->size();
+  RegisterId const nrRegs = block->getNrRegs();
 
   // Destroying the block releases the AqlValues. Which in turn may hold DocVecs
   // and can thus return AqlItemBlocks to this very Manager. So the destroy must
@@ -101,7 +123,11 @@ void AqlItemBlockManager::returnBlock(AqlItemBlock*& block) noexcept {
   // buckets!
   block->destroy();
 
-  if (!_buckets[i].full()) {
+  CONDITIONAL_MUTEX_LOCKER(locker, _mutex, _threadSafe);
+  if (pushToSizeClass(block, nrItems, nrRegs)) {
+    // recycled for requests of the same shape
+    TRI_ASSERT(block->numEntries() == 0);
+  } else if (!_buckets[i].full()) {
     // recycle the block
     TRI_ASSERT(block->numEntries() == 0);
     // store block in bucket (this will not fail)
@@ -130,6 +156,54 @@ SharedAqlItemBlockPtr AqlItemBlockManager::requestAndInitBlock(arangodb::velocyp
   return block;
 }
 
+AqlItemBlock* AqlItemBlockManager::popFromSizeClass(size_t nrItems, RegisterId nrRegs) noexcept {
+  for (auto& sizeClass : _sizeClasses) {
+    if (sizeClass.matches(nrItems, nrRegs)) {
+      if (sizeClass.blocks.empty()) {
+        return nullptr;
+      }
+      AqlItemBlock* block = sizeClass.blocks.back();
+      sizeClass.blocks.pop_back();
+      return block;
+    }
+    if (sizeClass.unused()) {
+      // size classes are assigned from the front
+      break;
+    }
+  }
+  return nullptr;
+}
+
+bool AqlItemBlockManager::pushToSizeClass(AqlItemBlock* block, size_t nrItems,
+                                          RegisterId nrRegs) noexcept {
+  if (nrItems == 0 || nrRegs == 0) {
+    return false;
+  }
+  for (auto& sizeClass : _sizeClasses) {
+    if (sizeClass.unused()) {
+      // first block of this shape
+      sizeClass.nrItems = nrItems;
+      sizeClass.nrRegs = nrRegs;
+    }
+    if (sizeClass.matches(nrItems, nrRegs)) {
+      if (sizeClass.blocks.size() >= numBlocksPerSizeClass) {
+        return false;
+      }
+      try {
+        if (sizeClass.blocks.capacity() == 0) {
+          sizeClass.blocks.reserve(numBlocksPerSizeClass);
+        }
+        sizeClass.blocks.push_back(block);
+      } catch (...) {
+        return false;
+      }
+      return true;
+    }
+  }
+  // all size classes are taken by other shapes
+  return false;
+}
+
 AqlItemBlockManager::Bucket::Bucket() : numItems(0) {
   for (size_t i = 0; i < numBlocksPerBucket; ++i) {
     blocks[i] = nullptr;
@@ -27,8 +27,10 @@
 #include "Aql/SharedAqlItemBlockPtr.h"
 #include "Aql/types.h"
 #include "Basics/Common.h"
+#include "Basics/Mutex.h"
 
 #include <array>
+#include <vector>
 
 namespace arangodb {
 namespace aql {
@@ -54,6 +56,16 @@ class AqlItemBlockManager {
 
   TEST_VIRTUAL ResourceMonitor* resourceMonitor() const noexcept { return _resourceMonitor; }
 
+  /// @brief memory layout used for all blocks handed out from now on
+  AqlItemBlockLayout layout() const noexcept { return _layout; }
+
+  /// @brief set the memory layout used for all blocks handed out from now on
+  void setLayout(AqlItemBlockLayout layout) noexcept { _layout = layout; }
+
+  /// @brief synchronize requesting and returning blocks from now on. this
+  /// is required once blocks of the query are executed on other threads
+  void setThreadSafe() noexcept { _threadSafe = true; }
+
 #ifdef ARANGODB_USE_CATCH_TESTS
   // Only used for the mocks in the catch tests. Other code should always use
   // SharedAqlItemBlockPtr which in turn call returnBlock()!
@@ -72,9 +84,47 @@ class AqlItemBlockManager {
   /// Should only be called by SharedAqlItemBlockPtr!
   TEST_VIRTUAL void returnBlock(AqlItemBlock*& block) noexcept;
 
+ private:
+  /// @brief take a recycled block of exactly this shape, nullptr if there
+  /// is none
+  AqlItemBlock* popFromSizeClass(size_t nrItems, RegisterId nrRegs) noexcept;
+
+  /// @brief recycle a block in the size class of its previous shape.
+  /// returns false if there is no room for it
+  bool pushToSizeClass(AqlItemBlock* block, size_t nrItems, RegisterId nrRegs) noexcept;
+
  private:
   ResourceMonitor* _resourceMonitor;
 
+  AqlItemBlockLayout _layout;
+
+  /// @brief protects the recycled blocks, only used if _threadSafe is set
+  Mutex _mutex;
+  bool _threadSafe;
+
+  /// @brief recycled blocks of a single shape. a query requests blocks of
+  /// only a few different shapes, mostly of DefaultBatchSize() rows and the
+  /// registers of a specific depth. blocks taken from the size class of
+  /// their shape can be reused without reallocating their data
+  struct SizeClass {
+    size_t nrItems;
+    RegisterId nrRegs;
+    std::vector<AqlItemBlock*> blocks;
+
+    SizeClass() : nrItems(0), nrRegs(0) {}
+
+    bool unused() const noexcept { return nrItems == 0; }
+
+    bool matches(size_t items, RegisterId regs) const noexcept {
+      return nrItems == items && nrRegs == regs;
+    }
+  };
+
+  static constexpr size_t numSizeClasses = 8;
+  static constexpr size_t numBlocksPerSizeClass = 16;
+
+  std::array<SizeClass, numSizeClasses> _sizeClasses;
+
   static constexpr size_t numBuckets = 12;
   static constexpr size_t numBlocksPerBucket = 7;
 
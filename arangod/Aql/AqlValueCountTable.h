@@ -0,0 +1,204 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_AQL_VALUE_COUNT_TABLE_H
+#define ARANGOD_AQL_AQL_VALUE_COUNT_TABLE_H 1
+
+#include "Aql/AqlValue.h"
+#include "Basics/Common.h"
+#include "Basics/fasthash.h"
+
+#include <vector>
+
+namespace arangodb {
+namespace aql {
+
+/// @brief reference counts of the dynamic AqlValues in an AqlItemBlock.
+/// this is an open-addressing hash table with linear probing, so counting
+/// a value does not allocate a node, and the slots are kept when the block
+/// is reused. only values that require destruction are counted, these are
+/// identified by their type and pointer.
+class AqlValueCountTable {
+ public:
+  struct Entry {
+    AqlValue value;
+    /// @brief a count of 0 marks an unused slot
+    uint32_t count;
+  };
+
+  AqlValueCountTable() : _size(0) {}
+
+  AqlValueCountTable(AqlValueCountTable const&) = delete;
+  AqlValueCountTable& operator=(AqlValueCountTable const&) = delete;
+
+  bool empty() const noexcept { return _size == 0; }
+
+  size_t size() const noexcept { return _size; }
+
+  /// @brief increase the count of a value, and return the new count. if this
+  /// throws, the table is unchanged
+  uint32_t increase(AqlValue const& value) {
+    TRI_ASSERT(value.requiresDestruction());
+    if ((_size + 1) * 2 > _slots.size()) {
+      grow();
+    }
+    size_t const mask = _slots.size() - 1;
+    size_t i = bucket(value, mask);
+    while (_slots[i].count != 0) {
+      if (equal(_slots[i].value, value)) {
+        return ++_slots[i].count;
+      }
+      i = (i + 1) & mask;
+    }
+    _slots[i].value = value;
+    _slots[i].count = 1;
+    ++_size;
+    return 1;
+  }
+
+  /// @brief find the entry of a value, nullptr if it is not counted
+  Entry* find(AqlValue const& value) noexcept {
+    if (_size == 0) {
+      return nullptr;
+    }
+    size_t const mask = _slots.size() - 1;
+    size_t i = bucket(value, mask);
+    while (_slots[i].count != 0) {
+      if (equal(_slots[i].value, value)) {
+        return &_slots[i];
+      }
+      i = (i + 1) & mask;
+    }
+    return nullptr;
+  }
+
+  Entry const* find(AqlValue const& value) const noexcept {
+    return const_cast<AqlValueCountTable*>(this)->find(value);
+  }
+
+  /// @brief remove an entry returned by find(). its count may already have
+  /// been decreased to 0
+  void erase(Entry* entry) noexcept {
+    TRI_ASSERT(entry >= _slots.data() && entry < _slots.data() + _slots.size());
+    TRI_ASSERT(_size > 0);
+    size_t const mask = _slots.size() - 1;
+    size_t hole = static_cast<size_t>(entry - _slots.data());
+    // move following entries of the same probe sequence into the hole, so
+    // lookups never need tombstones
+    size_t i = hole;
+    while (true) {
+      i = (i + 1) & mask;
+      if (_slots[i].count == 0) {
+        break;
+      }
+      size_t const home = bucket(_slots[i].value, mask);
+      // the entry at i may only be moved if its home is not within (hole, i]
+      if (((i - home) & mask) >= ((i - hole) & mask)) {
+        _slots[hole] = _slots[i];
+        hole = i;
+      }
+    }
+    _slots[hole].value.erase();
+    _slots[hole].count = 0;
+    --_size;
+  }
+
+  /// @brief remove a value regardless of its count. returns whether it was
+  /// counted
+  bool erase(AqlValue const& value) noexcept {
+    Entry* entry = find(value);
+    if (entry == nullptr) {
+      return false;
+    }
+    erase(entry);
+    return true;
+  }
+
+  /// @brief remove all entries, keeping the allocated slots
+  void clear() noexcept {
+    if (_size == 0) {
+      return;
+    }
+    for (auto& it : _slots) {
+      if (it.count != 0) {
+        it.value.erase();
+        it.count = 0;
+      }
+    }
+    _size = 0;
+  }
+
+  /// @brief call cb(value, count) for all counted values
+  template <typename F>
+  void forEach(F&& cb) const {
+    if (_size == 0) {
+      return;
+    }
+    for (auto const& it : _slots) {
+      if (it.count != 0) {
+        cb(it.value, it.count);
+      }
+    }
+  }
+
+ private:
+  static bool equal(AqlValue const& lhs, AqlValue const& rhs) noexcept {
+    return std::equal_to<AqlValue>()(lhs, rhs);
+  }
+
+  /// @brief the home slot of a value. the std::hash of a dynamic value is
+  /// mostly its (aligned) pointer, so the bits have to be mixed for linear
+  /// probing
+  static size_t bucket(AqlValue const& value, size_t mask) noexcept {
+    return static_cast<size_t>(fasthash64_uint64(std::hash<AqlValue>()(value),
+                                                 0xdeadbeefdeadbeefULL)) &
+           mask;
+  }
+
+  void grow() {
+    std::vector<Entry> old;
+    old.resize(_slots.empty() ? 16 : _slots.size() * 2,
+               Entry{AqlValue(), 0});
+    old.swap(_slots);
+
+    size_t const mask = _slots.size() - 1;
+    for (auto const& it : old) {
+      if (it.count != 0) {
+        size_t i = bucket(it.value, mask);
+        while (_slots[i].count != 0) {
+          i = (i + 1) & mask;
+        }
+        _slots[i] = it;
+      }
+    }
+  }
+
+ private:
+  /// @brief the slots, the number is always 0 or a power of two
+  std::vector<Entry> _slots;
+
+  /// @brief number of used slots
+  size_t _size;
+};
+
+}  // namespace aql
+}  // namespace arangodb
+
+#endif
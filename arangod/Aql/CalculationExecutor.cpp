@@ -51,7 +51,13 @@ CalculationExecutor<calculationType>::CalculationExecutor(Fetcher& fetcher,
       _fetcher(fetcher),
       _currentRow(InputAqlItemRow{CreateInvalidInputRowHint{}}),
       _rowState(ExecutionState::HASMORE),
-      _hasEnteredContext(false) {}
+      _hasEnteredContext(false) {
+  if (calculationType == CalculationType::Condition) {
+    _vectorized = VectorizedExpression::compile(_infos.getExpression().node(),
+                                                _infos.getExpInVars(),
+                                                _infos.getExpInRegs());
+  }
+}
 
 template <CalculationType calculationType>
 CalculationExecutor<calculationType>::~CalculationExecutor() = default;
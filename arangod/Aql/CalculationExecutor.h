@@ -30,6 +30,7 @@
 #include "Aql/Query.h"
 #include "Aql/SingleRowFetcher.h"
 #include "Aql/Stats.h"
+#include "Aql/VectorizedExpression.h"
 #include "Cluster/ServerState.h"
 #include "ExecutorExpressionContext.h"
 #include "V8/v8-globals.h"
@@ -140,6 +141,11 @@ class CalculationExecutor {
   // Necessary for owned contexts, which will not be exited when we call
   // exitContext; but only for assertions in maintainer mode.
   bool _hasEnteredContext;
+
+  // batch evaluator for simple conditions, evaluating all remaining rows of
+  // an input block at once. nullptr if the expression is not covered by it.
+  // Only used for Conditions.
+  std::unique_ptr<VectorizedExpression> _vectorized;
 };
 
 template<CalculationType calculationType>
@@ -227,6 +233,27 @@ CalculationExecutor<calculationType>::produceRows(OutputAqlItemRow& output) {
 template <>
 inline void CalculationExecutor<CalculationType::Condition>::doEvaluation(
     InputAqlItemRow& input, OutputAqlItemRow& output) {
+  if (_vectorized != nullptr) {
+    AqlItemBlock const& block = input.getBlock();
+    size_t const row = input.getRowIndex();
+    if (input.isFirstRowInBlock() || !_vectorized->covers(block, row)) {
+      // blocks get recycled, so always start over on the first row
+      _vectorized->evaluate(block, row, block.size());
+    }
+
+    AqlValue a;
+    if (_vectorized->getResult(row, a)) {
+      TRI_IF_FAILURE("CalculationBlock::executeExpression") {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+      }
+      // the result is a plain value, no need to destroy it
+      AqlValueGuard guard(a, false);
+      output.moveValueInto(_infos.getOutputRegisterId(), input, guard);
+      return;
+    }
+    // fall back to the interpreter for this row
+  }
+
   // execute the expression
   ExecutorExpressionContext ctx(&_infos.getQuery(), input,
                                 _infos.getExpInVars(), _infos.getExpInRegs());
@@ -0,0 +1,627 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "CardinalityEstimator.h"
+
+#include "Aql/Ast.h"
+#include "Aql/AstNode.h"
+#include "Aql/Collection.h"
+#include "Aql/ExecutionNode.h"
+#include "Aql/ExecutionPlan.h"
+#include "Aql/Expression.h"
+#include "Aql/IndexNode.h"
+#include "Aql/Query.h"
+#include "Basics/HashSet.h"
+#include "Indexes/Index.h"
+#include "Indexes/SimpleAttributeEqualityMatcher.h"
+#include "StorageEngine/PhysicalCollection.h"
+#include "Transaction/Context.h"
+#include "Transaction/Methods.h"
+#include "Transaction/Status.h"
+#include "VocBase/CollectionStatistics.h"
+#include "VocBase/LogicalCollection.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <algorithm>
+#include <unordered_map>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+/// @brief default selectivities, for conditions the estimates and the
+/// indexes cannot tell anything about
+constexpr double equalitySelectivity = 0.1;
+constexpr double rangeSelectivity = 1.0 / 3.0;
+constexpr double defaultSelectivity = 0.5;
+
+/// @brief the collection of the documents in a variable, if it is set by a
+/// full collection scan or an index lookup
+Collection const* collectionOf(ExecutionPlan const* plan, Variable const* variable) {
+  ExecutionNode const* setter = plan->getVarSetBy(variable->id);
+  if (setter == nullptr) {
+    return nullptr;
+  }
+  if (setter->getType() == ExecutionNode::ENUMERATE_COLLECTION) {
+    auto en = ExecutionNode::castTo<EnumerateCollectionNode const*>(setter);
+    if (en->outVariable() == variable) {
+      return en->collection();
+    }
+  } else if (setter->getType() == ExecutionNode::INDEX) {
+    auto in = ExecutionNode::castTo<IndexNode const*>(setter);
+    if (in->outVariable() == variable) {
+      return in->collection();
+    }
+  }
+  return nullptr;
+}
+
+/// @brief the statistics of the collection of the documents in a variable,
+/// nullptr if it has not been analyzed
+std::shared_ptr<CollectionStatistics const> statisticsOf(ExecutionPlan const* plan,
+                                                         Variable const* variable) {
+  Collection const* collection = collectionOf(plan, variable);
+  if (collection == nullptr) {
+    return nullptr;
+  }
+  auto logical = collection->getCollection();
+  if (logical == nullptr || logical->getPhysical() == nullptr) {
+    return nullptr;
+  }
+  return logical->getPhysical()->statistics();
+}
+
+/// @brief a value the sample has not contained may still be there, so the
+/// statistics never estimate less than a single document
+double atLeastOneDocument(double selectivity, CollectionStatistics const& statistics) {
+  double const documents = static_cast<double>((std::max)(statistics.numberDocuments(), uint64_t(1)));
+  return (std::min)((std::max)(selectivity, 1.0 / documents), 1.0);
+}
+
+/// @brief a FILTER on top of a run of FOR loops, with the loops it refers to
+struct JoinPredicate {
+  /// @brief the loops whose variables are used by the filter
+  uint64_t loops;
+  double selectivity;
+};
+
+/// @brief an equality condition that can be used for an index lookup in a
+/// loop, once all loops of the other side have been entered
+struct JoinLookup {
+  size_t loop;
+  uint64_t required;
+  double documents;
+};
+
+/// @brief the position of the only loop in a set, or 64 if there is not
+/// exactly one
+size_t singleLoop(uint64_t loops) {
+  if (loops == 0 || (loops & (loops - 1)) != 0) {
+    return 64;
+  }
+  size_t result = 0;
+  while ((loops & 1) == 0) {
+    loops >>= 1;
+    ++result;
+  }
+  return result;
+}
+
+/// @brief the information about a run of FOR loops that orders are judged by
+struct JoinGraph {
+  std::vector<double> cardinality;
+  /// @brief the loops whose variables are used by each loop
+  std::vector<uint64_t> required;
+  std::vector<JoinPredicate> predicates;
+  std::vector<JoinLookup> lookups;
+
+  /// @brief number of rows after entering all loops in the set, for each
+  /// row before the first loop
+  double rows(uint64_t loops) const {
+    double result = 1.0;
+    for (size_t i = 0; i < cardinality.size(); ++i) {
+      if (loops & (uint64_t(1) << i)) {
+        result *= cardinality[i];
+      }
+    }
+    for (auto const& it : predicates) {
+      if ((it.loops & ~loops) == 0) {
+        result *= it.selectivity;
+      }
+    }
+    return result;
+  }
+
+  /// @brief number of documents a loop reads for each of its input rows,
+  /// with the given loops already entered
+  double access(size_t loop, uint64_t entered) const {
+    double result = cardinality[loop];
+    for (auto const& it : lookups) {
+      if (it.loop == loop && (it.required & ~entered) == 0) {
+        result = (std::min)(result, it.documents);
+      }
+    }
+    return result;
+  }
+
+  bool available(size_t loop, uint64_t entered) const {
+    return (required[loop] & ~entered) == 0;
+  }
+};
+}  // namespace
+
+/// @brief a range of values of a top-level attribute of the documents in a
+/// variable. a bound is nullptr if the range is open on its side
+struct CardinalityEstimator::Range {
+  Variable const* variable = nullptr;
+  std::string attribute;
+  std::shared_ptr<CollectionStatistics const> statistics;
+  AstNode const* lower = nullptr;
+  bool includeLower = false;
+  AstNode const* upper = nullptr;
+  bool includeUpper = false;
+};
+
+CardinalityEstimator::CardinalityEstimator(ExecutionPlan const* plan)
+    : _plan(plan), _trx(plan->getAst()->query()->trx()) {
+  if (_trx != nullptr && _trx->status() != transaction::Status::RUNNING) {
+    _trx = nullptr;
+  }
+}
+
+double CardinalityEstimator::selectivity(AstNode const* node) const {
+  if (node == nullptr) {
+    return ::defaultSelectivity;
+  }
+
+  switch (node->type) {
+    case NODE_TYPE_OPERATOR_BINARY_AND:
+    case NODE_TYPE_OPERATOR_NARY_AND: {
+      // the bounds of a range of the same attribute are not independent,
+      // so they are judged together
+      std::vector<Range> ranges;
+      double result = 1.0;
+      for (size_t i = 0; i < node->numMembers(); ++i) {
+        AstNode const* member = node->getMemberUnchecked(i);
+        Range range;
+        if (!matchRange(member, range)) {
+          result *= selectivity(member);
+          continue;
+        }
+        auto it = std::find_if(ranges.begin(), ranges.end(), [&range](Range const& other) {
+          return other.variable == range.variable && other.attribute == range.attribute &&
+                 (range.lower == nullptr || other.lower == nullptr) &&
+                 (range.upper == nullptr || other.upper == nullptr);
+        });
+        if (it == ranges.end()) {
+          ranges.emplace_back(std::move(range));
+        } else if (range.lower != nullptr) {
+          it->lower = range.lower;
+          it->includeLower = range.includeLower;
+        } else {
+          it->upper = range.upper;
+          it->includeUpper = range.includeUpper;
+        }
+      }
+      for (auto const& it : ranges) {
+        result *= rangeSelectivity(it);
+      }
+      return result;
+    }
+    case NODE_TYPE_OPERATOR_BINARY_OR:
+    case NODE_TYPE_OPERATOR_NARY_OR: {
+      double result = 0.0;
+      for (size_t i = 0; i < node->numMembers(); ++i) {
+        result += selectivity(node->getMemberUnchecked(i));
+      }
+      return (std::min)(result, 1.0);
+    }
+    case NODE_TYPE_OPERATOR_UNARY_NOT:
+      return 1.0 - selectivity(node->getMember(0));
+    case NODE_TYPE_OPERATOR_BINARY_EQ:
+      return equalitySelectivity(node);
+    case NODE_TYPE_OPERATOR_BINARY_NE:
+      return 1.0 - equalitySelectivity(node);
+    case NODE_TYPE_OPERATOR_BINARY_IN:
+    case NODE_TYPE_OPERATOR_BINARY_NIN: {
+      double result = equalitySelectivity(node) *
+                      SimpleAttributeEqualityMatcher::estimateNumberOfArrayMembers(
+                          node->getMember(1));
+      result = (std::min)(result, 1.0);
+      return node->type == NODE_TYPE_OPERATOR_BINARY_IN ? result : 1.0 - result;
+    }
+    case NODE_TYPE_OPERATOR_BINARY_LT:
+    case NODE_TYPE_OPERATOR_BINARY_LE:
+    case NODE_TYPE_OPERATOR_BINARY_GT:
+    case NODE_TYPE_OPERATOR_BINARY_GE: {
+      Range range;
+      if (matchRange(node, range)) {
+        return rangeSelectivity(range);
+      }
+      return ::rangeSelectivity;
+    }
+    default:
+      break;
+  }
+
+  if (node->isConstant()) {
+    return node->isTrue() ? 1.0 : 0.0;
+  }
+  return ::defaultSelectivity;
+}
+
+std::vector<size_t> CardinalityEstimator::bestJoinOrder(std::vector<ExecutionNode*> const& loops) const {
+  size_t const n = loops.size();
+  std::vector<size_t> order;
+  order.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    order.emplace_back(i);
+  }
+  if (n < 2 || n > 64 || _trx == nullptr) {
+    return order;
+  }
+
+  ::JoinGraph graph;
+
+  // the loops each variable depends on
+  std::unordered_map<VariableId, uint64_t> dependencies;
+  for (size_t i = 0; i < n; ++i) {
+    ExecutionNode const* loop = loops[i];
+    for (auto const& it : loop->getVariablesSetHere()) {
+      dependencies.emplace(it->id, uint64_t(1) << i);
+    }
+
+    double cardinality;
+    if (loop->getType() == ExecutionNode::ENUMERATE_COLLECTION) {
+      auto en = ExecutionNode::castTo<EnumerateCollectionNode const*>(loop);
+      cardinality = static_cast<double>(count(en->collection()));
+    } else {
+      // the length of the list as estimated by the node
+      TRI_ASSERT(loop->getType() == ExecutionNode::ENUMERATE_LIST);
+      double const incoming = static_cast<double>(
+          (std::max)(loop->getFirstDependency()->getCost().estimatedNrItems, size_t(1)));
+      cardinality = static_cast<double>(loop->getCost().estimatedNrItems) / incoming;
+    }
+    graph.cardinality.emplace_back((std::max)(cardinality, 1.0));
+  }
+
+  graph.required.resize(n, 0);
+  for (size_t i = 0; i < n; ++i) {
+    arangodb::HashSet<Variable const*> used;
+    loops[i]->getVariablesUsedHere(used);
+    for (auto const& it : used) {
+      auto dep = dependencies.find(it->id);
+      if (dep != dependencies.end()) {
+        graph.required[i] |= dep->second;
+      }
+    }
+  }
+
+  // collect the filters on top of the loops. calculations in between are
+  // followed, so filters on their results are attributed to the right loops
+  ExecutionNode const* current = loops.back()->getFirstParent();
+  while (current != nullptr && (current->getType() == ExecutionNode::CALCULATION ||
+                                current->getType() == ExecutionNode::FILTER)) {
+    if (current->getType() == ExecutionNode::CALCULATION) {
+      auto cn = ExecutionNode::castTo<CalculationNode const*>(current);
+      arangodb::HashSet<Variable const*> used;
+      cn->getVariablesUsedHere(used);
+      uint64_t mask = 0;
+      for (auto const& it : used) {
+        auto dep = dependencies.find(it->id);
+        if (dep != dependencies.end()) {
+          mask |= dep->second;
+        }
+      }
+      if (mask != 0) {
+        dependencies.emplace(cn->outVariable()->id, mask);
+      }
+    } else {
+      auto fn = ExecutionNode::castTo<FilterNode const*>(current);
+      auto dep = dependencies.find(fn->inVariable()->id);
+      ExecutionNode const* setter = _plan->getVarSetBy(fn->inVariable()->id);
+      if (dep != dependencies.end() && setter != nullptr &&
+          setter->getType() == ExecutionNode::CALCULATION) {
+        AstNode const* condition =
+            ExecutionNode::castTo<CalculationNode const*>(setter)->expression()->node();
+        graph.predicates.emplace_back(::JoinPredicate{dep->second, selectivity(condition)});
+
+        // an equality on an indexed attribute of a loop turns the loop
+        // into a lookup, once the other side is available
+        if (condition->type == NODE_TYPE_OPERATOR_BINARY_EQ) {
+          for (size_t side = 0; side < 2; ++side) {
+            std::pair<Variable const*, std::vector<arangodb::basics::AttributeName>> access;
+            if (!condition->getMemberUnchecked(side)->isAttributeAccessForVariable(access, false)) {
+              continue;
+            }
+            auto loop = dependencies.find(access.first->id);
+            if (loop == dependencies.end()) {
+              continue;
+            }
+            size_t const index = ::singleLoop(loop->second);
+            if (index >= n || loops[index]->getType() != ExecutionNode::ENUMERATE_COLLECTION) {
+              continue;
+            }
+            arangodb::HashSet<Variable const*> other;
+            Ast::getReferencedVariables(condition->getMemberUnchecked(1 - side), other);
+            uint64_t required = 0;
+            for (auto const& it : other) {
+              auto otherDep = dependencies.find(it->id);
+              if (otherDep != dependencies.end()) {
+                required |= otherDep->second;
+              }
+            }
+            if (required & loop->second) {
+              continue;
+            }
+            auto en = ExecutionNode::castTo<EnumerateCollectionNode const*>(loops[index]);
+            double const documents = documentsPerValue(en->collection(), access.second);
+            if (documents > 0.0) {
+              graph.lookups.emplace_back(::JoinLookup{index, required, documents});
+            }
+          }
+        }
+      }
+    }
+    current = current->getFirstParent();
+  }
+
+  // the costs of an order are the documents read by all loops
+  if (n <= maxExhaustiveJoinSize) {
+    // dynamic programming over the sets of entered loops. the costs of a set
+    // only depend on the order within the set via its cheapest order, and
+    // the rows it produces do not depend on the order at all
+    size_t const sets = size_t(1) << n;
+    std::vector<double> costs(sets, -1.0);
+    std::vector<size_t> last(sets, 0);
+    costs[0] = 0.0;
+    for (uint64_t set = 1; set < sets; ++set) {
+      // on ties, the loop that is innermost in the given order is preferred,
+      // which keeps the given order if nothing can be told apart
+      for (size_t i = n; i-- > 0;) {
+        uint64_t const bit = uint64_t(1) << i;
+        if ((set & bit) == 0) {
+          continue;
+        }
+        uint64_t const before = set & ~bit;
+        if (costs[before] < 0.0 || !graph.available(i, before)) {
+          continue;
+        }
+        double const cost = costs[before] + graph.rows(before) * graph.access(i, before);
+        if (costs[set] < 0.0 || cost < costs[set] * (1.0 - 1e-9)) {
+          costs[set] = cost;
+          last[set] = i;
+        }
+      }
+    }
+    if (costs[sets - 1] < 0.0) {
+      // the loops depend on each other in a cycle, cannot happen
+      return order;
+    }
+    uint64_t set = sets - 1;
+    for (size_t i = n; i-- > 0;) {
+      order[i] = last[set];
+      set &= ~(uint64_t(1) << last[set]);
+    }
+    return order;
+  }
+
+  // greedily enter the loop that adds the lowest costs
+  order.clear();
+  uint64_t entered = 0;
+  double rows = 1.0;
+  while (order.size() < n) {
+    size_t best = n;
+    double bestCost = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+      uint64_t const bit = uint64_t(1) << i;
+      if ((entered & bit) != 0 || !graph.available(i, entered)) {
+        continue;
+      }
+      double const cost = rows * graph.access(i, entered) + graph.rows(entered | bit);
+      if (best == n || cost < bestCost * (1.0 - 1e-9)) {
+        best = i;
+        bestCost = cost;
+      }
+    }
+    if (best == n) {
+      // cannot happen, see above
+      order.clear();
+      for (size_t i = 0; i < n; ++i) {
+        order.emplace_back(i);
+      }
+      return order;
+    }
+    order.emplace_back(best);
+    entered |= uint64_t(1) << best;
+    rows = graph.rows(entered);
+  }
+  return order;
+}
+
+double CardinalityEstimator::equalitySelectivity(AstNode const* node) const {
+  TRI_ASSERT(node->numMembers() == 2);
+  if (_trx == nullptr) {
+    return ::equalitySelectivity;
+  }
+
+  for (size_t i = 0; i < 2; ++i) {
+    AstNode const* lhs = node->getMemberUnchecked(i);
+    AstNode const* rhs = node->getMemberUnchecked(1 - i);
+
+    std::pair<Variable const*, std::vector<arangodb::basics::AttributeName>> access;
+    if (!lhs->isAttributeAccessForVariable(access, false)) {
+      continue;
+    }
+    Collection const* collection = ::collectionOf(_plan, access.first);
+    if (collection == nullptr) {
+      continue;
+    }
+    arangodb::HashSet<Variable const*> vars;
+    Ast::getReferencedVariables(rhs, vars);
+    if (vars.find(access.first) != vars.end()) {
+      continue;
+    }
+
+    // the statistics know the frequency of a constant, the indexes only
+    // the average frequency of all values
+    std::shared_ptr<CollectionStatistics const> statistics;
+    CollectionStatistics::Attribute const* attribute = nullptr;
+    if (access.second.size() == 1 && !access.second[0].shouldExpand) {
+      statistics = ::statisticsOf(_plan, access.first);
+      if (statistics != nullptr) {
+        attribute = statistics->attribute(access.second[0].name);
+      }
+    }
+    if (attribute != nullptr && node->type == NODE_TYPE_OPERATOR_BINARY_EQ && rhs->isConstant()) {
+      VPackBuilder value;
+      rhs->toVelocyPackValue(value);
+      return ::atLeastOneDocument(
+          attribute->equalitySelectivity(value.slice(),
+                                         _trx->transactionContextPtr()->getVPackOptions()),
+          *statistics);
+    }
+
+    double const documents = documentsPerValue(collection, access.second);
+    size_t const total = count(collection);
+    if (documents > 0.0 && total > 0) {
+      return (std::min)(documents / static_cast<double>(total), 1.0);
+    }
+    if (attribute != nullptr) {
+      return ::atLeastOneDocument((1.0 - attribute->nullFraction) /
+                                      (std::max)(attribute->distinctValues, 1.0),
+                                  *statistics);
+    }
+  }
+  return ::equalitySelectivity;
+}
+
+double CardinalityEstimator::rangeSelectivity(Range const& range) const {
+  TRI_ASSERT(_trx != nullptr);
+  TRI_ASSERT(range.statistics != nullptr);
+  CollectionStatistics::Attribute const* attribute = range.statistics->attribute(range.attribute);
+  TRI_ASSERT(attribute != nullptr);
+
+  VPackBuilder lower;
+  if (range.lower != nullptr) {
+    range.lower->toVelocyPackValue(lower);
+  }
+  VPackBuilder upper;
+  if (range.upper != nullptr) {
+    range.upper->toVelocyPackValue(upper);
+  }
+  double const result = attribute->rangeSelectivity(
+      range.lower != nullptr ? lower.slice() : VPackSlice::noneSlice(), range.includeLower,
+      range.upper != nullptr ? upper.slice() : VPackSlice::noneSlice(), range.includeUpper,
+      _trx->transactionContextPtr()->getVPackOptions());
+  return ::atLeastOneDocument(result, *range.statistics);
+}
+
+bool CardinalityEstimator::matchRange(AstNode const* node, Range& range) const {
+  if (_trx == nullptr) {
+    return false;
+  }
+
+  bool isLower;
+  bool include;
+  switch (node->type) {
+    case NODE_TYPE_OPERATOR_BINARY_LT:
+      isLower = false;
+      include = false;
+      break;
+    case NODE_TYPE_OPERATOR_BINARY_LE:
+      isLower = false;
+      include = true;
+      break;
+    case NODE_TYPE_OPERATOR_BINARY_GT:
+      isLower = true;
+      include = false;
+      break;
+    case NODE_TYPE_OPERATOR_BINARY_GE:
+      isLower = true;
+      include = true;
+      break;
+    default:
+      return false;
+  }
+
+  for (size_t i = 0; i < 2; ++i) {
+    AstNode const* lhs = node->getMemberUnchecked(i);
+    AstNode const* rhs = node->getMemberUnchecked(1 - i);
+
+    std::pair<Variable const*, std::vector<arangodb::basics::AttributeName>> access;
+    if (!rhs->isConstant() || !lhs->isAttributeAccessForVariable(access, false) ||
+        access.second.size() != 1 || access.second[0].shouldExpand) {
+      continue;
+    }
+    auto statistics = ::statisticsOf(_plan, access.first);
+    if (statistics == nullptr || statistics->attribute(access.second[0].name) == nullptr) {
+      continue;
+    }
+
+    range.variable = access.first;
+    range.attribute = access.second[0].name;
+    range.statistics = std::move(statistics);
+    // with the attribute on the right side, the comparison is the other way round
+    if (isLower == (i == 0)) {
+      range.lower = rhs;
+      range.includeLower = include;
+    } else {
+      range.upper = rhs;
+      range.includeUpper = include;
+    }
+    return true;
+  }
+  return false;
+}
+
+double CardinalityEstimator::documentsPerValue(
+    Collection const* collection, std::vector<arangodb::basics::AttributeName> const& attribute) const {
+  TRI_ASSERT(_trx != nullptr);
+  double result = 0.0;
+  for (auto const& index : _trx->indexesForCollection(collection->name())) {
+    // only single-attribute indexes have estimates for the attribute alone
+    if (index->fields().size() != 1 || index->sparse() ||
+        !arangodb::basics::AttributeName::isIdentical(index->fields()[0], attribute, false)) {
+      continue;
+    }
+    double documents = 0.0;
+    if (index->unique() || index->implicitlyUnique()) {
+      documents = 1.0;
+    } else if (index->hasSelectivityEstimate()) {
+      double const estimate = index->selectivityEstimate();
+      if (estimate > 0.0) {
+        documents = 1.0 / estimate;
+      }
+    }
+    if (documents > 0.0 && (result == 0.0 || documents < result)) {
+      result = documents;
+    }
+  }
+  return result;
+}
+
+size_t CardinalityEstimator::count(Collection const* collection) const {
+  TRI_ASSERT(_trx != nullptr);
+  return collection->count(_trx);
+}
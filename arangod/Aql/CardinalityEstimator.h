@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef ARANGOD_AQL_CARDINALITY_ESTIMATOR_H
+#define ARANGOD_AQL_CARDINALITY_ESTIMATOR_H 1
+
+#include "Basics/AttributeNameParser.h"
+#include "Basics/Common.h"
+
+#include <vector>
+
+namespace arangodb {
+namespace transaction {
+class Methods;
+}
+
+namespace aql {
+struct AstNode;
+struct Collection;
+class ExecutionNode;
+class ExecutionPlan;
+struct Variable;
+
+/// @brief estimates the number of rows that pass FILTER conditions, using
+/// the collection counts, the statistics of analyzed collections and the
+/// selectivity estimates of the indexes, and the order of nested FOR loops
+/// with the lowest estimated costs. conditions that cannot be judged get
+/// the customary default selectivity of their kind of comparison
+class CardinalityEstimator {
+ public:
+  explicit CardinalityEstimator(ExecutionPlan const* plan);
+
+  /// @brief estimated share of rows that fulfill the condition, between 0
+  /// and 1
+  double selectivity(AstNode const* condition) const;
+
+  /// @brief order of adjacent FOR loops, given from the outermost to the
+  /// innermost one, with the lowest estimated costs. the loops must be
+  /// EnumerateCollectionNodes or EnumerateListNodes, the FILTERs directly
+  /// on top of the innermost one are taken into account. returns the
+  /// positions of the loops in the new order, outermost first. the given
+  /// order is kept if the estimates cannot tell the orders apart
+  std::vector<size_t> bestJoinOrder(std::vector<ExecutionNode*> const& loops) const;
+
+  /// @brief up to this number of loops, all orders are considered.
+  /// larger joins are ordered greedily
+  static constexpr size_t maxExhaustiveJoinSize = 10;
+
+ private:
+  struct Range;
+
+  /// @brief selectivity of an equality comparison
+  double equalitySelectivity(AstNode const* node) const;
+
+  /// @brief selectivity of a range of values of an attribute, from the
+  /// statistics of the collection
+  double rangeSelectivity(Range const& range) const;
+
+  /// @brief matches a comparison of a top-level attribute of the documents
+  /// of an analyzed collection with a constant
+  bool matchRange(AstNode const* node, Range& range) const;
+
+  /// @brief estimated number of documents of a collection with the same
+  /// value of an attribute. returns 0 if no index can tell
+  double documentsPerValue(Collection const* collection,
+                           std::vector<arangodb::basics::AttributeName> const& attribute) const;
+
+  size_t count(Collection const* collection) const;
+
+ private:
+  ExecutionPlan const* _plan;
+
+  /// @brief the transaction of the query, nullptr if it is not running
+  transaction::Methods* _trx;
+};
+
+}  // namespace aql
+}  // namespace arangodb
+
+#endif
@@ -279,7 +279,8 @@ std::unique_ptr<ExecutionBlock> CollectNode::createBlock(
           getRegisterPlan()->nrRegs[getDepth()], getRegsToClear(), calcRegsToKeep(),
           std::move(readableInputRegisters), std::move(writeableOutputRegisters),
           std::move(groupRegisters), collectRegister, std::move(aggregateTypes),
-          std::move(aggregateRegisters), trxPtr, _count);
+          std::move(aggregateRegisters), trxPtr, _count,
+          _plan->getAst()->query()->queryOptions().spillMemoryThreshold);
 
       return std::make_unique<ExecutionBlockImpl<HashedCollectExecutor>>(&engine, this,
                                                                          std::move(infos));
@@ -452,6 +453,9 @@ struct UserVarFinder final : public WalkerWorker<ExecutionNode> {
                en->getType() == ExecutionNode::SHORTEST_PATH ||
                en->getType() == ExecutionNode::K_SHORTEST_PATHS ||
                en->getType() == ExecutionNode::ENUMERATE_IRESEARCH_VIEW ||
+               en->getType() == ExecutionNode::HASH_JOIN ||
+               en->getType() == ExecutionNode::MERGE_JOIN ||
+               en->getType() == ExecutionNode::INDEX_COLLECT ||
                en->getType() == ExecutionNode::COLLECT) {
       depth += 1;
     }
@@ -22,6 +22,8 @@
 
 #include "DependencyProxy.h"
 
+#include <numeric>
+
 using namespace arangodb::aql;
 
 template <bool passBlocksThrough>
@@ -39,7 +41,12 @@ ExecutionState DependencyProxy<passBlocksThrough>::prefetchBlock(size_t atMost)
 
     if (state == ExecutionState::WAITING) {
       TRI_ASSERT(block == nullptr);
-      return state;
+      // with multiple dependencies (an unsorted gather) the order in which
+      // they are consumed does not matter, so we ask the others as well and
+      // continue with the first one that has something for us
+      if (!switchToReadyDependency(atMost, state, block)) {
+        return ExecutionState::WAITING;
+      }
     }
 
     if (block == nullptr) {
@@ -53,6 +60,7 @@ ExecutionState DependencyProxy<passBlocksThrough>::prefetchBlock(size_t atMost)
 
   // Now we definitely have a block.
   TRI_ASSERT(block != nullptr);
+  _numRowsFetched += block->size();
 
   if (state == ExecutionState::DONE) {
     // We need to modify the state here s.t. on next call we fetch from
@@ -122,6 +130,7 @@ DependencyProxy<passBlocksThrough>::fetchBlockForDependency(size_t dependency, s
 
   // Now we definitely have a block.
   TRI_ASSERT(block != nullptr);
+  _numRowsFetched += block->size();
 
   return {state, block};
 }
@@ -149,6 +158,7 @@ std::pair<ExecutionState, size_t> DependencyProxy<allowBlockPassthrough>::skipSo
     }
 
     _skipped += skippedNow;
+    _numRowsFetched += skippedNow;
 
     // When the current dependency is done, advance.
     if (state == ExecutionState::DONE && !advanceDependency()) {
@@ -191,5 +201,28 @@ DependencyProxy<allowBlockPassthrough>::fetchBlockForPassthrough(size_t atMost)
   return {state, std::move(block)};
 }
 
+template <bool allowBlockPassthrough>
+bool DependencyProxy<allowBlockPassthrough>::switchToReadyDependency(
+    size_t atMost, ExecutionState& state, SharedAqlItemBlockPtr& block) {
+  if (_currentDependency + 1 >= _dependencies.size()) {
+    return false;
+  }
+  if (_dependencyOrder.empty()) {
+    _dependencyOrder.resize(_dependencies.size());
+    std::iota(_dependencyOrder.begin(), _dependencyOrder.end(), 0);
+  }
+  // asking a dependency that waits sends its request, so all remaining
+  // dependencies fetch in parallel
+  for (size_t i = _currentDependency + 1; i < _dependencyOrder.size(); ++i) {
+    std::tie(state, block) = upstreamBlockForDependency(_dependencyOrder[i]).getSome(atMost);
+    if (state != ExecutionState::WAITING) {
+      std::swap(_dependencyOrder[_currentDependency], _dependencyOrder[i]);
+      return true;
+    }
+    TRI_ASSERT(block == nullptr);
+  }
+  return false;
+}
+
 template class ::arangodb::aql::DependencyProxy<true>;
 template class ::arangodb::aql::DependencyProxy<false>;
@@ -32,6 +32,7 @@
 #include <memory>
 #include <queue>
 #include <utility>
+#include <vector>
 
 namespace arangodb {
 namespace aql {
@@ -75,7 +76,8 @@ class DependencyProxy {
         _blockQueue(),
         _blockPassThroughQueue(),
         _currentDependency(0),
-        _skipped(0) {}
+        _skipped(0),
+        _numRowsFetched(0) {}
 
   TEST_VIRTUAL ~DependencyProxy() = default;
 
@@ -112,10 +114,15 @@ class DependencyProxy {
     return _dependencies.size();
   }
 
+  /// @brief number of rows fetched or skipped from the dependencies so far,
+  /// used for profiling
+  inline size_t numRowsFetched() const { return _numRowsFetched; }
+
   inline void reset() {
     _blockQueue.clear();
     _blockPassThroughQueue.clear();
     _currentDependency = 0;
+    _dependencyOrder.clear();
     // We shouldn't be in a half-skipped state when reset is called
     TRI_ASSERT(_skipped == 0);
     _skipped = 0;
@@ -128,7 +135,9 @@ class DependencyProxy {
   }
 
   inline ExecutionBlock& upstreamBlock() {
-    return upstreamBlockForDependency(_currentDependency);
+    return upstreamBlockForDependency(_dependencyOrder.empty()
+                                          ? _currentDependency
+                                          : _dependencyOrder[_currentDependency]);
   }
 
   inline ExecutionBlock& upstreamBlockForDependency(size_t index) {
@@ -145,6 +154,12 @@ class DependencyProxy {
     return true;
   }
 
+  // Called when the current dependency is WAITING. Asks all following
+  // dependencies for a block, and makes the first one that does not wait
+  // the current dependency. Returns false if all of them are waiting.
+  bool switchToReadyDependency(size_t atMost, ExecutionState& state,
+                               SharedAqlItemBlockPtr& block);
+
  private:
   std::vector<ExecutionBlock*> const& _dependencies;
   AqlItemBlockManager& _itemBlockManager;
@@ -157,7 +172,11 @@ class DependencyProxy {
   std::deque<std::pair<ExecutionState, SharedAqlItemBlockPtr>> _blockPassThroughQueue;
   // only modified in case of multiple dependencies + Passthrough otherwise always 0
   size_t _currentDependency;
+  // order in which the dependencies are consumed, only set up once one of
+  // multiple dependencies had to wait. empty means in order of _dependencies
+  std::vector<size_t> _dependencyOrder;
   size_t _skipped;
+  size_t _numRowsFetched;
 };
 
 }  // namespace aql
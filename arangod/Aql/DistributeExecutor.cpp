@@ -235,11 +235,14 @@ std::pair<ExecutionState, bool> ExecutionBlockImpl<DistributeExecutor>::getBlock
 
     SharedAqlItemBlockPtr cur = _buffer[_index];
 
-    while (_pos < cur->size()) {
+    if (_pos < cur->size()) {
       // this may modify the input item buffer in place
-      size_t const id = sendToClient(cur);
+      sendToClients(cur);
+      TRI_ASSERT(_clientIds.size() == cur->size() - _pos);
 
-      _distBuffer[id].emplace_back(_index, _pos++);
+      for (size_t id : _clientIds) {
+        _distBuffer[id].emplace_back(_index, _pos++);
+      }
     }
 
     if (_pos == cur->size()) {
@@ -253,12 +256,44 @@ std::pair<ExecutionState, bool> ExecutionBlockImpl<DistributeExecutor>::getBlock
   return {getHasMoreStateForClientId(clientId), true};
 }
 
-/// @brief sendToClient: for each row of the incoming AqlItemBlock use the
-/// attributes <shardKeys> of the Aql value <val> to determine to which shard
-/// the row should be sent and return its clientId
-size_t ExecutionBlockImpl<DistributeExecutor>::sendToClient(SharedAqlItemBlockPtr cur) {
-  // inspect cur in row _pos and check to which shard it should be sent . .
-  AqlValue val = cur->getValueReference(_pos, _regId);
+/// @brief sendToClients: for the remaining rows of the incoming AqlItemBlock
+/// use the attributes <shardKeys> of the Aql values to determine to which
+/// shards the rows should be sent, and put their clientIds into _clientIds.
+/// the shards are determined for all rows at once
+void ExecutionBlockImpl<DistributeExecutor>::sendToClients(SharedAqlItemBlockPtr cur) {
+  _values.clear();
+  for (size_t pos = _pos; pos < cur->size(); ++pos) {
+    _values.emplace_back(prepareValue(cur, pos));
+  }
+
+  int res = _collection->getCollection()->getResponsibleShards(_values, _shardIds);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    THROW_ARANGO_EXCEPTION(res);
+  }
+
+  TRI_ASSERT(_shardIds.size() == _values.size());
+
+  _clientIds.clear();
+  for (std::string const& shardId : _shardIds) {
+    TRI_ASSERT(!shardId.empty());
+    // rows for the same shard often follow each other
+    if (!_clientIds.empty() && shardId == _shardIds[_clientIds.size() - 1]) {
+      _clientIds.emplace_back(_clientIds.back());
+    } else {
+      _clientIds.emplace_back(getClientId(shardId));
+    }
+  }
+}
+
+/// @brief prepareValue: make sure the Aql value in row <pos> of the incoming
+/// AqlItemBlock is a document with a key if necessary, and return the
+/// document to determine the responsible shard with. the value stays valid
+/// as long as the row is not modified
+VPackSlice ExecutionBlockImpl<DistributeExecutor>::prepareValue(SharedAqlItemBlockPtr& cur,
+                                                                size_t pos) {
+  // inspect cur in row pos and check to which shard it should be sent . .
+  AqlValue val = cur->getValueReference(pos, _regId);
 
   VPackSlice input = val.slice();  // will throw when wrong type
 
@@ -269,13 +304,14 @@ size_t ExecutionBlockImpl<DistributeExecutor>::sendToClient(SharedAqlItemBlockPt
     // check if there is a second input register available (UPSERT makes use of
     // two input registers,
     // one for the search document, the other for the insert document)
-    val = cur->getValueReference(_pos, _alternativeRegId);
+    val = cur->getValueReference(pos, _alternativeRegId);
 
     input = val.slice();  // will throw when wrong type
     usedAlternativeRegId = true;
   }
 
   VPackSlice value = input;
+  RegisterId valueRegId = usedAlternativeRegId ? _alternativeRegId : _regId;
   bool hasCreatedKeyAttribute = false;
 
   if (input.isString() && _allowKeyConversionToObject) {
@@ -285,12 +321,13 @@ size_t ExecutionBlockImpl<DistributeExecutor>::sendToClient(SharedAqlItemBlockPt
     _keyBuilder.close();
 
     // clear the previous value
-    cur->destroyValue(_pos, _regId);
+    cur->destroyValue(pos, _regId);
 
     // overwrite with new value
-    cur->emplaceValue(_pos, _regId, _keyBuilder.slice());
+    cur->emplaceValue(pos, _regId, _keyBuilder.slice());
 
     value = _keyBuilder.slice();
+    valueRegId = _regId;
     hasCreatedKeyAttribute = true;
   } else if (!input.isObject()) {
     THROW_ARANGO_EXCEPTION(TRI_ERROR_ARANGO_DOCUMENT_TYPE_INVALID);
@@ -332,28 +369,21 @@ size_t ExecutionBlockImpl<DistributeExecutor>::sendToClient(SharedAqlItemBlockPt
 
       // clear the previous value and overwrite with new value:
       if (usedAlternativeRegId) {
-        cur->destroyValue(_pos, _alternativeRegId);
-        cur->emplaceValue(_pos, _alternativeRegId, _objectBuilder.slice());
+        cur->destroyValue(pos, _alternativeRegId);
+        cur->emplaceValue(pos, _alternativeRegId, _objectBuilder.slice());
+        valueRegId = _alternativeRegId;
       } else {
-        cur->destroyValue(_pos, _regId);
-        cur->emplaceValue(_pos, _regId, _objectBuilder.slice());
+        cur->destroyValue(pos, _regId);
+        cur->emplaceValue(pos, _regId, _objectBuilder.slice());
+        valueRegId = _regId;
       }
       value = _objectBuilder.slice();
     }
   }
 
-  std::string shardId;
-  auto collInfo = _collection->getCollection();
-
-  int res = collInfo->getResponsibleShard(value, true, shardId);
-
-  if (res != TRI_ERROR_NO_ERROR) {
-    THROW_ARANGO_EXCEPTION(res);
-  }
-
-  TRI_ASSERT(!shardId.empty());
-
-  return getClientId(shardId);
+  // the builders are reused for the next row, and small values are copied
+  // into the AqlValue, so refer to the value in the block
+  return cur->getValueReference(pos, valueRegId).slice();
 }
 
 /// @brief create a new document key
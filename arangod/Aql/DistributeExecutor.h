@@ -87,10 +87,13 @@ class ExecutionBlockImpl<DistributeExecutor> : public BlocksWithClients {
   /// _distBuffer.at(clientId).
   std::pair<ExecutionState, bool> getBlockForClient(size_t atMost, size_t clientId);
 
-  /// @brief sendToClient: for each row of the incoming AqlItemBlock use the
-  /// attributes <shardKeys> of the register <id> to determine to which shard
-  /// the row should be sent.
-  size_t sendToClient(SharedAqlItemBlockPtr);
+  /// @brief sendToClients: for the remaining rows of the incoming
+  /// AqlItemBlock use the attributes <shardKeys> of the register <id> to
+  /// determine to which shards the rows should be sent.
+  void sendToClients(SharedAqlItemBlockPtr);
+
+  /// @brief prepareValue: the document of a row to determine its shard with
+  arangodb::velocypack::Slice prepareValue(SharedAqlItemBlockPtr&, size_t pos);
 
   /// @brief create a new document key
   std::string createKey(arangodb::velocypack::Slice) const;
@@ -112,6 +115,12 @@ class ExecutionBlockImpl<DistributeExecutor> : public BlocksWithClients {
   // a reusable Builder object for building document objects
   arangodb::velocypack::Builder _objectBuilder;
 
+  // reusable buffers for the rows of a block: the documents, their shards
+  // and their clients
+  std::vector<arangodb::velocypack::Slice> _values;
+  std::vector<std::string> _shardIds;
+  std::vector<size_t> _clientIds;
+
   /// @brief _colectionName: the name of the sharded collection
   Collection const* _collection;
 
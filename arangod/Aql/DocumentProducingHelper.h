@@ -26,6 +26,7 @@
 
 #include "Aql/AqlItemBlock.h"
 #include "Aql/ExecutionNode.h"
+#include "Aql/ExecutorInfos.h"
 #include "Aql/InputAqlItemRow.h"
 #include "Aql/OutputAqlItemRow.h"
 #include "Basics/Common.h"
@@ -40,6 +41,16 @@ namespace aql {
 using DocumentProducingFunction =
     std::function<void(LocalDocumentId const&, VPackSlice slice)>;
 
+/// @brief the output registers of a document producing executor: the
+/// document register, and the docId register, if there is one
+inline std::shared_ptr<std::unordered_set<RegisterId>> documentOutputRegisters(
+    RegisterId outputRegister, RegisterId docIdRegister) {
+  if (docIdRegister == ExecutionNode::MaxRegisterId) {
+    return make_shared_unordered_set({outputRegister});
+  }
+  return make_shared_unordered_set({outputRegister, docIdRegister});
+}
+
 inline void handleProjections(std::vector<std::string> const& projections,
                               transaction::Methods const* trxPtr, VPackSlice slice,
                               VPackBuilder& b, bool useRawDocumentPointers) {
@@ -86,10 +97,12 @@ struct DocumentProducingFunctionContext {
                                    transaction::Methods* trxPtr,
                                    std::vector<size_t> const& coveringIndexAttributePositions,
                                    bool allowCoveringIndexOptimization,
-                                   bool useRawDocumentPointers, bool checkUniqueness)
+                                   bool useRawDocumentPointers, bool checkUniqueness,
+                                   RegisterId const docIdRegister = ExecutionNode::MaxRegisterId)
       : _inputRow(inputRow),
         _outputRow(outputRow),
         _outputRegister(outputRegister),
+        _docIdRegister(docIdRegister),
         _produceResult(produceResult),
         _projections(projections),
         _trxPtr(trxPtr),
@@ -145,6 +158,10 @@ struct DocumentProducingFunctionContext {
 
   RegisterId getOutputRegister() const noexcept { return _outputRegister; }
 
+  /// @brief register for the document ids, MaxRegisterId if they are not
+  /// needed (only used for late materialization)
+  RegisterId getDocIdRegister() const noexcept { return _docIdRegister; }
+
   bool checkUniqueness(LocalDocumentId const& token) {
     if (_checkUniqueness) {
       if (!_isLastIndex) {
@@ -177,6 +194,7 @@ struct DocumentProducingFunctionContext {
   InputAqlItemRow const& _inputRow;
   OutputAqlItemRow* _outputRow;
   RegisterId const _outputRegister;
+  RegisterId const _docIdRegister;
   bool const _produceResult;
   std::vector<std::string> const& _projections;
   transaction::Methods* const _trxPtr;
@@ -196,6 +214,18 @@ struct DocumentProducingFunctionContext {
   bool _checkUniqueness;
 };
 
+/// @brief write the id of the document into the docId register, if there
+/// is one. must be called before the document itself is written
+inline void writeDocumentId(DocumentProducingFunctionContext& context,
+                            LocalDocumentId const& token) {
+  RegisterId const registerId = context.getDocIdRegister();
+  if (registerId != ExecutionNode::MaxRegisterId) {
+    AqlValue v(AqlValueHintUInt(token.id()));
+    AqlValueGuard guard{v, true};
+    context.getOutputRow().moveValueInto(registerId, context.getInputRow(), guard);
+  }
+}
+
 namespace DocumentProducingCallbackVariant {
 struct WithProjectionsCoveredByIndex {};
 struct WithProjectionsNotCoveredByIndex {};
@@ -261,6 +291,7 @@ inline DocumentProducingFunction getCallback(DocumentProducingCallbackVariant::W
     AqlValue v(b.get());
     AqlValueGuard guard{v, true};
     TRI_ASSERT(!output.isFull());
+    writeDocumentId(context, token);
     output.moveValueInto(registerId, input, guard);
     TRI_ASSERT(output.produced());
     output.advanceRow();
@@ -290,6 +321,7 @@ inline DocumentProducingFunction getCallback(DocumentProducingCallbackVariant::W
     AqlValue v(b.get());
     AqlValueGuard guard{v, true};
     TRI_ASSERT(!output.isFull());
+    writeDocumentId(context, token);
     output.moveValueInto(registerId, input, guard);
     TRI_ASSERT(output.produced());
     output.advanceRow();
@@ -313,6 +345,7 @@ inline DocumentProducingFunction getCallback(DocumentProducingCallbackVariant::D
     uint8_t const* vpack = slice.begin();
     // With NoCopy we do not clone anyways
     TRI_ASSERT(!output.isFull());
+    writeDocumentId(context, token);
     AqlValue v{AqlValueHintDocumentNoCopy{vpack}};
     AqlValueGuard guard{v, false};
     output.moveValueInto(registerId, input, guard);
@@ -341,6 +374,7 @@ inline DocumentProducingFunction getCallback(DocumentProducingCallbackVariant::D
     AqlValue v{AqlValueHintCopy{vpack}};
     AqlValueGuard guard{v, true};
     TRI_ASSERT(!output.isFull());
+    writeDocumentId(context, token);
     output.moveValueInto(registerId, input, guard);
     TRI_ASSERT(output.produced());
     output.advanceRow();
@@ -363,6 +397,7 @@ inline std::function<void(LocalDocumentId const& token)> getNullCallback(
     RegisterId registerId = context.getOutputRegister();
     // TODO: optimize this within the register planning mechanism?
     TRI_ASSERT(!output.isFull());
+    writeDocumentId(context, token);
     output.cloneValueInto(registerId, input, AqlValue(AqlValueHintNull()));
     TRI_ASSERT(output.produced());
     output.advanceRow();
@@ -35,14 +35,16 @@
 using namespace arangodb::aql;
 
 DocumentProducingNode::DocumentProducingNode(Variable const* outVariable)
-    : _outVariable(outVariable) {
+    : _outVariable(outVariable), _docIdVariable(nullptr) {
   TRI_ASSERT(_outVariable != nullptr);
 }
 
 DocumentProducingNode::DocumentProducingNode(ExecutionPlan* plan,
                                              arangodb::velocypack::Slice slice)
     : _outVariable(
-          Variable::varFromVPack(plan->getAst(), slice, "outVariable")) {
+          Variable::varFromVPack(plan->getAst(), slice, "outVariable")),
+      _docIdVariable(
+          Variable::varFromVPack(plan->getAst(), slice, "docIdVariable", true)) {
   TRI_ASSERT(_outVariable != nullptr);
 
   if (slice.hasKey("projection")) {
@@ -78,6 +80,11 @@ void DocumentProducingNode::toVelocyPack(arangodb::velocypack::Builder& builder)
   }
   builder.close();
 
+  if (_docIdVariable != nullptr) {
+    builder.add(VPackValue("docIdVariable"));
+    _docIdVariable->toVelocyPack(builder);
+  }
+
   builder.add("producesResult",
               VPackValue(dynamic_cast<ExecutionNode const*>(this)->isVarUsedLater(_outVariable)));
 }
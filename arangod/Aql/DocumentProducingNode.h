@@ -45,6 +45,12 @@ class DocumentProducingNode {
   /// @brief return the out variable
   Variable const* outVariable() const { return _outVariable; }
 
+  /// @brief return the variable the ids of the documents are written into,
+  /// if the documents are materialized later. nullptr otherwise
+  Variable const* docIdVariable() const { return _docIdVariable; }
+
+  void docIdVariable(Variable const* variable) { _docIdVariable = variable; }
+
   std::vector<std::string> const& projections() const { return _projections; }
 
   void projections(std::vector<std::string> const& projections) {
@@ -72,6 +78,9 @@ class DocumentProducingNode {
  protected:
   Variable const* _outVariable;
 
+  /// @brief variable for the document ids, for late materialization
+  Variable const* _docIdVariable;
+
   /// @brief produce only the following attributes
   std::vector<std::string> _projections;
 
@@ -40,8 +40,10 @@
 #include "Cluster/TraverserEngineRegistry.h"
 #include "EngineInfoContainerDBServer.h"
 #include "Graph/BaseOptions.h"
+#include "Random/RandomGenerator.h"
 #include "RestServer/QueryRegistryFeature.h"
 #include "StorageEngine/TransactionState.h"
+#include "Transaction/Hints.h"
 #include "Utils/CollectionNameResolver.h"
 #include "VocBase/LogicalCollection.h"
 #include "VocBase/ticks.h"
@@ -772,7 +774,7 @@ std::map<ServerID, EngineInfoContainerDBServer::DBServerInfo> EngineInfoContaine
             "Could not find responsible server for shard " + s);
       }
 
-      auto& responsible = (*servers)[0];
+      auto& responsible = responsibleServer(s, *servers);
 
       auto& mapping = dbServerMapping[responsible];
 
@@ -843,11 +845,11 @@ void EngineInfoContainerDBServer::injectGraphNodesToMapping(
             "Could not find responsible server for shard " + shard);
       }
       TRI_ASSERT(!serverList->empty());
-      auto& leader = (*serverList)[0];
-      auto pair = mappingServerToCollections.find(leader);
+      auto& responsible = responsibleServer(shard, *serverList);
+      auto pair = mappingServerToCollections.find(responsible);
       if (pair == mappingServerToCollections.end()) {
-        mappingServerToCollections.emplace(leader, TraverserEngineShardLists{length});
-        pair = mappingServerToCollections.find(leader);
+        mappingServerToCollections.emplace(responsible, TraverserEngineShardLists{length});
+        pair = mappingServerToCollections.find(responsible);
       }
       return pair;
     };
@@ -955,6 +957,25 @@ void EngineInfoContainerDBServer::injectGraphNodesToMapping(
   }
 }
 
+ServerID const& EngineInfoContainerDBServer::responsibleServer(
+    ShardID const& shard, std::vector<ServerID> const& servers) const {
+  TRI_ASSERT(!servers.empty());
+  // only read-only queries outside of transactions begun on the leaders
+  // can be answered by followers
+  if (servers.size() == 1 || !_query->queryOptions().allowDirtyReads ||
+      _query->isModificationQuery() ||
+      _query->trx()->state()->hasHint(transaction::Hints::Hint::GLOBAL_MANAGED)) {
+    return servers[0];
+  }
+
+  auto it = _dirtyReadServers.find(shard);
+  if (it == _dirtyReadServers.end()) {
+    uint32_t pick = RandomGenerator::interval(static_cast<uint32_t>(servers.size() - 1));
+    it = _dirtyReadServers.emplace(shard, servers[pick]).first;
+  }
+  return it->second;
+}
+
 Result EngineInfoContainerDBServer::buildEngines(MapRemoteToSnippet& queryIds) const {
   TRI_ASSERT(_engineStack.empty());
 
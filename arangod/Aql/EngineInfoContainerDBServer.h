@@ -264,6 +264,11 @@ class EngineInfoContainerDBServer {
   // @brief Helper to inject the TraverserEngines into the correct infos
   void injectGraphNodesToMapping(std::map<ServerID, DBServerInfo>& dbServerMapping) const;
 
+  // @brief Helper to pick the server that runs the engines for a shard.
+  // This is the shard's leader, unless the query may read from followers
+  ServerID const& responsibleServer(ShardID const& shard,
+                                    std::vector<ServerID> const& servers) const;
+
 #ifdef USE_ENTERPRISE
   void prepareSatellites(std::map<ServerID, DBServerInfo>& dbServerMapping) const;
 
@@ -298,6 +303,10 @@ class EngineInfoContainerDBServer {
   // @brief List of all graphNodes that need to create TraverserEngines on
   // DBServers
   std::vector<GraphNode*> _graphNodes;
+
+  // @brief The followers picked by responsibleServer(), so that all engines
+  // for a shard end up on the same server
+  mutable std::unordered_map<ShardID, ServerID> _dirtyReadServers;
 };
 
 }  // namespace aql
@@ -34,6 +34,7 @@
 #include "Aql/Query.h"
 #include "Aql/SingleRowFetcher.h"
 #include "Basics/Common.h"
+#include "Transaction/Context.h"
 #include "Transaction/Methods.h"
 #include "Utils/OperationCursor.h"
 
@@ -53,12 +54,14 @@ EnumerateCollectionExecutorInfos::EnumerateCollectionExecutorInfos(
     Collection const* collection, Variable const* outVariable, bool produceResult,
     std::vector<std::string> const& projections, transaction::Methods* trxPtr,
     std::vector<size_t> const& coveringIndexAttributePositions,
-    bool useRawDocumentPointers, bool random)
+    bool useRawDocumentPointers, bool random, size_t parallelism,
+    RegisterId docIdRegister, AstNode const* filter)
     : ExecutorInfos(make_shared_unordered_set(),
-                    make_shared_unordered_set({outputRegister}),
+                    documentOutputRegisters(outputRegister, docIdRegister),
                     nrInputRegisters, nrOutputRegisters,
                     std::move(registersToClear), std::move(registersToKeep)),
       _outputRegisterId(outputRegister),
+      _docIdRegisterId(docIdRegister),
       _engine(engine),
       _collection(collection),
       _outVariable(outVariable),
@@ -67,7 +70,9 @@ EnumerateCollectionExecutorInfos::EnumerateCollectionExecutorInfos(
       _coveringIndexAttributePositions(coveringIndexAttributePositions),
       _useRawDocumentPointers(useRawDocumentPointers),
       _produceResult(produceResult),
-      _random(random) {}
+      _random(random),
+      _parallelism(parallelism),
+      _filter(filter) {}
 
 EnumerateCollectionExecutor::EnumerateCollectionExecutor(Fetcher& fetcher, Infos& infos)
     : _infos(infos),
@@ -77,15 +82,18 @@ EnumerateCollectionExecutor::EnumerateCollectionExecutor(Fetcher& fetcher, Infos
                                         _infos.getProduceResult(),
                                         _infos.getProjections(), _infos.getTrxPtr(),
                                         _infos.getCoveringIndexAttributePositions(),
-                                        true, _infos.getUseRawDocumentPointers(), false),
+                                        true, _infos.getUseRawDocumentPointers(), false,
+                                        _infos.getDocIdRegisterId()),
       _state(ExecutionState::HASMORE),
       _input(InputAqlItemRow{CreateInvalidInputRowHint{}}),
+      _numFiltered(0),
       _cursorHasMore(false) {
   _cursor = std::make_unique<OperationCursor>(
       _infos.getTrxPtr()->indexScan(_infos.getCollection()->name(),
                                     (_infos.getRandom()
                                          ? transaction::Methods::CursorType::ANY
-                                         : transaction::Methods::CursorType::ALL)));
+                                         : transaction::Methods::CursorType::ALL),
+                                    _infos.getParallelism()));
 
   if (!waitForSatellites(_infos.getEngine(), _infos.getCollection())) {
     double maxWait = _infos.getEngine()->getQuery()->queryOptions().satelliteSyncWait;
@@ -94,8 +102,34 @@ EnumerateCollectionExecutor::EnumerateCollectionExecutor(Fetcher& fetcher, Infos
                                        " did not come into sync in time (" +
                                        std::to_string(maxWait) + ")");
   }
+  if (_infos.getFilter() != nullptr) {
+    _filter = std::make_unique<ScanFilter>(
+        _infos.getFilter(), _infos.getOutVariable(),
+        _infos.getTrxPtr()->transactionContextPtr()->getVPackOptions());
+  }
+
   if (_infos.getProduceResult()) {
     this->setProducingFunction(buildCallback<false>(_documentProducingFunctionContext));
+  } else if (_filter != nullptr) {
+    // the documents are needed for the filter, but not written
+    auto nullCallback = getNullCallback<false>(_documentProducingFunctionContext);
+    this->setProducingFunction([nullCallback](LocalDocumentId const& token, VPackSlice) {
+      nullCallback(token);
+    });
+  }
+
+  if (_filter != nullptr) {
+    // documents that do not match are dropped before anything is copied
+    this->setProducingFunction(
+        [this, producer = std::move(_documentProducer)](LocalDocumentId const& token,
+                                                        VPackSlice slice) {
+          if (_filter->matches(slice)) {
+            producer(token, slice);
+          } else {
+            ++_numFiltered;
+            _documentProducingFunctionContext.incrScanned();
+          }
+        });
   }
 }
 
@@ -141,7 +175,7 @@ std::pair<ExecutionState, EnumerateCollectionStats> EnumerateCollectionExecutor:
       THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
     }
 
-    if (_infos.getProduceResult()) {
+    if (_infos.getProduceResult() || _filter != nullptr) {
       // properly build up results by fetching the actual documents
       // using nextDocument()
       _cursorHasMore =
@@ -155,6 +189,8 @@ std::pair<ExecutionState, EnumerateCollectionStats> EnumerateCollectionExecutor:
     }
 
     stats.incrScanned(_documentProducingFunctionContext.getAndResetNumScanned());
+    stats.incrFiltered(_numFiltered);
+    _numFiltered = 0;
 
     if (_state == ExecutionState::DONE && !_cursorHasMore) {
       return {_state, stats};
@@ -187,9 +223,13 @@ std::tuple<ExecutionState, EnumerateCollectionStats, size_t> EnumerateCollection
   TRI_ASSERT(_input.isInitialized());
 
   uint64_t actuallySkipped = 0;
-  _cursor->skip(toSkip, actuallySkipped);
-  _cursorHasMore = _cursor->hasMore();
-  stats.incrScanned(actuallySkipped);
+  if (_filter != nullptr) {
+    actuallySkipped = skipFiltered(toSkip, stats);
+  } else {
+    _cursor->skip(toSkip, actuallySkipped);
+    _cursorHasMore = _cursor->hasMore();
+    stats.incrScanned(actuallySkipped);
+  }
 
   if (_state == ExecutionState::DONE && !_cursorHasMore) {
     return {ExecutionState::DONE, stats, actuallySkipped};
@@ -198,6 +238,27 @@ std::tuple<ExecutionState, EnumerateCollectionStats, size_t> EnumerateCollection
   return {ExecutionState::HASMORE, stats, actuallySkipped};
 }
 
+uint64_t EnumerateCollectionExecutor::skipFiltered(uint64_t atMost,
+                                                   EnumerateCollectionStats& stats) {
+  uint64_t skipped = 0;
+  uint64_t scanned = 0;
+  auto callback = [&](LocalDocumentId const&, VPackSlice slice) {
+    ++scanned;
+    if (_filter->matches(slice)) {
+      ++skipped;
+    } else {
+      stats.incrFiltered(1);
+    }
+  };
+
+  _cursorHasMore = true;
+  while (skipped < atMost && _cursorHasMore) {
+    _cursorHasMore = _cursor->nextDocument(callback, atMost - skipped);
+  }
+  stats.incrScanned(scanned);
+  return skipped;
+}
+
 void EnumerateCollectionExecutor::initializeCursor() {
   _state = ExecutionState::HASMORE;
   _input = InputAqlItemRow{CreateInvalidInputRowHint{}};
@@ -30,6 +30,7 @@
 #include "Aql/ExecutionState.h"
 #include "Aql/ExecutorInfos.h"
 #include "Aql/OutputAqlItemRow.h"
+#include "Aql/ScanFilter.h"
 #include "Aql/Stats.h"
 #include "Aql/types.h"
 #include "DocumentProducingHelper.h"
@@ -55,7 +56,9 @@ class EnumerateCollectionExecutorInfos : public ExecutorInfos {
       Collection const* collection, Variable const* outVariable, bool produceResult,
       std::vector<std::string> const& projections, transaction::Methods* trxPtr,
       std::vector<size_t> const& coveringIndexAttributePositions,
-      bool useRawDocumentPointers, bool random);
+      bool useRawDocumentPointers, bool random, size_t parallelism,
+      RegisterId docIdRegister = ExecutionNode::MaxRegisterId,
+      AstNode const* filter = nullptr);
 
   EnumerateCollectionExecutorInfos() = delete;
   EnumerateCollectionExecutorInfos(EnumerateCollectionExecutorInfos&&) = default;
@@ -73,10 +76,18 @@ class EnumerateCollectionExecutorInfos : public ExecutorInfos {
   bool getProduceResult() { return _produceResult; };
   bool getUseRawDocumentPointers() { return _useRawDocumentPointers; };
   bool getRandom() { return _random; };
+  /// @brief number of threads the collection may be scanned with
+  size_t getParallelism() { return _parallelism; };
   RegisterId getOutputRegisterId() { return _outputRegisterId; };
+  /// @brief register for the document ids, MaxRegisterId if not needed
+  RegisterId getDocIdRegisterId() { return _docIdRegisterId; };
+  /// @brief condition on the documents of the outVariable that is evaluated
+  /// while scanning, nullptr if there is none
+  AstNode const* getFilter() { return _filter; };
 
  private:
   RegisterId _outputRegisterId;
+  RegisterId _docIdRegisterId;
   ExecutionEngine* _engine;
   Collection const* _collection;
   Variable const* _outVariable;
@@ -87,6 +98,8 @@ class EnumerateCollectionExecutorInfos : public ExecutorInfos {
   bool _useRawDocumentPointers;
   bool _produceResult;
   bool _random;
+  size_t _parallelism;
+  AstNode const* _filter;
 };
 
 /**
@@ -136,6 +149,9 @@ class EnumerateCollectionExecutor {
  private:
   bool waitForSatellites(ExecutionEngine* engine, Collection const* collection) const;
 
+  /// @brief skip up to atMost documents that match the filter
+  uint64_t skipFiltered(uint64_t atMost, EnumerateCollectionStats& stats);
+
   void setAllowCoveringIndexOptimization(bool const allowCoveringIndexOptimization) {
     _documentProducingFunctionContext.setAllowCoveringIndexOptimization(allowCoveringIndexOptimization);
   }
@@ -154,6 +170,9 @@ class EnumerateCollectionExecutor {
   ExecutionState _state;
   InputAqlItemRow _input;
   std::unique_ptr<OperationCursor> _cursor;
+  std::unique_ptr<ScanFilter> _filter;
+  /// @brief documents rejected by the filter since the stats were taken
+  size_t _numFiltered;
   bool _cursorHasMore;
 };
 
@@ -31,9 +31,31 @@
 #include "Aql/Query.h"
 #include "Basics/Exceptions.h"
 
+#include <time.h>
+
 using namespace arangodb;
 using namespace arangodb::aql;
 
+namespace {
+/// @brief CPU time used by the current thread, in seconds
+double threadCpuTime() {
+#ifdef _WIN32
+  return 0.0;
+#else
+  struct timespec ts;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+    return 0.0;
+  }
+  return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1000000000.0;
+#endif
+}
+
+/// @brief storage engine counters of the thread already attributed to
+/// traced blocks. lets each block report only its own share to the
+/// statistics, while its node stats include its dependencies
+thread_local StoragePerfCounters storageAttributed;
+}  // namespace
+
 ExecutionBlock::ExecutionBlock(ExecutionEngine* engine, ExecutionNode const* ep)
     : _engine(engine),
       _trx(engine->getQuery()->trx()),
@@ -41,8 +63,10 @@ ExecutionBlock::ExecutionBlock(ExecutionEngine* engine, ExecutionNode const* ep)
       _done(false),
       _exeNode(ep),
       _dependencyPos(_dependencies.end()),
-      _profile(engine->getQuery()->queryOptions().getProfileLevel()),
+      _profile(engine->getQuery()->traceLevel()),
       _getSomeBegin(0.0),
+      _cpuTimeBegin(0.0),
+      _memoryUsageBegin(0),
       _upstreamState(ExecutionState::HASMORE),
       _pos(0),
       _collector(&engine->itemBlockManager()) {}
@@ -62,6 +86,28 @@ std::pair<ExecutionState, Result> ExecutionBlock::initializeCursor(InputAqlItemR
     }
   }
 
+  resetCursorState();
+  return {ExecutionState::DONE, TRI_ERROR_NO_ERROR};
+}
+
+std::pair<ExecutionState, Result> ExecutionBlock::initializeCursorWithBatch(SharedAqlItemBlockPtr const& batch) {
+  if (_dependencyPos == _dependencies.end()) {
+    // We need to start again.
+    _dependencyPos = _dependencies.begin();
+  }
+  for (; _dependencyPos != _dependencies.end(); ++_dependencyPos) {
+    auto res = (*_dependencyPos)->initializeCursorWithBatch(batch);
+    if (res.first == ExecutionState::WAITING || !res.second.ok()) {
+      // If we need to wait or get an error we return as is.
+      return res;
+    }
+  }
+
+  resetCursorState();
+  return {ExecutionState::DONE, TRI_ERROR_NO_ERROR};
+}
+
+void ExecutionBlock::resetCursorState() {
   _buffer.clear();
 
   _done = false;
@@ -71,7 +117,55 @@ std::pair<ExecutionState, Result> ExecutionBlock::initializeCursor(InputAqlItemR
 
   TRI_ASSERT(getHasMoreState() == ExecutionState::HASMORE);
   TRI_ASSERT(_dependencyPos == _dependencies.end());
-  return {ExecutionState::DONE, TRI_ERROR_NO_ERROR};
+}
+
+void ExecutionBlock::traceBegin() {
+  _getSomeBegin = TRI_microtime();
+  _cpuTimeBegin = ::threadCpuTime();
+  _memoryUsageBegin =
+      _engine->getQuery()->resourceMonitor()->currentResources.memoryUsage;
+}
+
+void ExecutionBlock::traceStorageBegin() {
+  _storageBegin = StoragePerfScope::current();
+  _storageAttributedBegin = ::storageAttributed;
+}
+
+void ExecutionBlock::traceEnd(ExecutionState state, size_t items, size_t itemsIn) {
+  ExecutionStats::Node stats;
+  stats.storage = StoragePerfScope::current() - _storageBegin;
+  StoragePerfCounters const own =
+      stats.storage - (::storageAttributed - _storageAttributedBegin);
+  ::storageAttributed = _storageAttributedBegin;
+  ::storageAttributed += stats.storage;
+  if (!own.empty()) {
+    StoragePerfStatistics::add("aql", getPlanNode()->getTypeString(), own);
+  }
+
+  stats.calls = 1;
+  stats.items = items;
+  stats.itemsIn = itemsIn;
+  if (state == ExecutionState::WAITING) {
+    stats.waiting = 1;
+  } else {
+    stats.runtime = TRI_microtime() - _getSomeBegin;
+    // other threads may have continued a call that returned WAITING, their
+    // CPU time is not accounted for
+    stats.cpuTime = (std::max)(0.0, ::threadCpuTime() - _cpuTimeBegin);
+    size_t const memoryUsage =
+        _engine->getQuery()->resourceMonitor()->currentResources.memoryUsage;
+    if (memoryUsage > _memoryUsageBegin) {
+      stats.peakMemoryGrowth = memoryUsage - _memoryUsageBegin;
+    }
+    _getSomeBegin = 0.0;
+  }
+
+  auto it = _engine->_stats.nodes.find(getPlanNode()->id());
+  if (it != _engine->_stats.nodes.end()) {
+    it->second += stats;
+  } else {
+    _engine->_stats.nodes.emplace(getPlanNode()->id(), stats);
+  }
 }
 
 std::pair<ExecutionState, Result> ExecutionBlock::shutdown(int errorCode) {
@@ -98,6 +98,12 @@ class ExecutionBlock {
   /// @brief initializeCursor, could be called multiple times
   virtual std::pair<ExecutionState, Result> initializeCursor(InputAqlItemRow const& input) = 0;
 
+  /// @brief initializeCursor with a whole block of input rows instead of a
+  /// single one, used for subqueries that are executed for a batch of
+  /// input rows at once. the singleton of the subquery produces all rows
+  /// of the batch
+  virtual std::pair<ExecutionState, Result> initializeCursorWithBatch(SharedAqlItemBlockPtr const& batch);
+
   /// @brief shutdown, will be called exactly once for the whole query
   virtual std::pair<ExecutionState, Result> shutdown(int errorCode) = 0;
 
@@ -114,8 +120,9 @@ class ExecutionBlock {
   inline void traceGetSomeBegin(size_t atMost) {
     if (_profile >= PROFILE_LEVEL_BLOCKS) {
       if (_getSomeBegin <= 0.0) {
-        _getSomeBegin = TRI_microtime();
+        traceBegin();
       }
+      traceStorageBegin();
       if (_profile >= PROFILE_LEVEL_TRACE_1) {
         auto node = getPlanNode();
         LOG_TOPIC("ca7db", INFO, Logger::QUERIES)
@@ -125,26 +132,13 @@ class ExecutionBlock {
     }
   }
 
-  // Trace the end of a getSome call, potentially with result
+  // Trace the end of a getSome call, potentially with result. itemsIn is
+  // the number of rows fetched from the dependencies during the call
   inline std::pair<ExecutionState, SharedAqlItemBlockPtr> traceGetSomeEnd(
-      ExecutionState state, SharedAqlItemBlockPtr result) {
+      ExecutionState state, SharedAqlItemBlockPtr result, size_t itemsIn = 0) {
     TRI_ASSERT(result != nullptr || state != ExecutionState::HASMORE);
     if (_profile >= PROFILE_LEVEL_BLOCKS) {
-      ExecutionNode const* en = getPlanNode();
-      ExecutionStats::Node stats;
-      stats.calls = 1;
-      stats.items = result != nullptr ? result->size() : 0;
-      if (state != ExecutionState::WAITING) {
-        stats.runtime = TRI_microtime() - _getSomeBegin;
-        _getSomeBegin = 0.0;
-      }
-
-      auto it = _engine->_stats.nodes.find(en->id());
-      if (it != _engine->_stats.nodes.end()) {
-        it->second += stats;
-      } else {
-        _engine->_stats.nodes.emplace(en->id(), stats);
-      }
+      traceEnd(state, result != nullptr ? result->size() : 0, itemsIn);
 
       if (_profile >= PROFILE_LEVEL_TRACE_1) {
         ExecutionNode const* node = getPlanNode();
@@ -176,8 +170,9 @@ class ExecutionBlock {
   inline void traceSkipSomeBegin(size_t atMost) {
     if (_profile >= PROFILE_LEVEL_BLOCKS) {
       if (_getSomeBegin <= 0.0) {
-        _getSomeBegin = TRI_microtime();
+        traceBegin();
       }
+      traceStorageBegin();
       if (_profile >= PROFILE_LEVEL_TRACE_1) {
         auto node = getPlanNode();
         LOG_TOPIC("dba8a", INFO, Logger::QUERIES)
@@ -187,26 +182,12 @@ class ExecutionBlock {
     }
   }
 
-  inline std::pair<ExecutionState, size_t> traceSkipSomeEnd(std::pair<ExecutionState, size_t> const res) {
+  inline std::pair<ExecutionState, size_t> traceSkipSomeEnd(
+      std::pair<ExecutionState, size_t> const res, size_t itemsIn = 0) {
     ExecutionState const state = res.first;
-    size_t const skipped = res.second;
 
     if (_profile >= PROFILE_LEVEL_BLOCKS) {
-      ExecutionNode const* en = getPlanNode();
-      ExecutionStats::Node stats;
-      stats.calls = 1;
-      stats.items = skipped;
-      if (state != ExecutionState::WAITING) {
-        stats.runtime = TRI_microtime() - _getSomeBegin;
-        _getSomeBegin = 0.0;
-      }
-
-      auto it = _engine->_stats.nodes.find(en->id());
-      if (it != _engine->_stats.nodes.end()) {
-        it->second += stats;
-      } else {
-        _engine->_stats.nodes.emplace(en->id(), stats);
-      }
+      traceEnd(state, res.second, itemsIn);
 
       if (_profile >= PROFILE_LEVEL_TRACE_1) {
         ExecutionNode const* node = getPlanNode();
@@ -219,8 +200,9 @@ class ExecutionBlock {
     return res;
   }
 
-  inline std::pair<ExecutionState, size_t> traceSkipSomeEnd(ExecutionState state, size_t skipped) {
-    return traceSkipSomeEnd({state, skipped});
+  inline std::pair<ExecutionState, size_t> traceSkipSomeEnd(ExecutionState state, size_t skipped,
+                                                             size_t itemsIn = 0) {
+    return traceSkipSomeEnd({state, skipped}, itemsIn);
   }
 
   /// @brief skipSome, skips some more items, semantic is as follows: not
@@ -263,6 +245,23 @@ class ExecutionBlock {
     _dependencyPos = _dependencies.end();
   }
 
+ private:
+  /// @brief reset the local state after all dependencies have been
+  /// initialized by initializeCursor
+  void resetCursorState();
+
+  /// @brief take the starting points of a traced call. a call that returns
+  /// WAITING is continued by the next one, so its measurements include the
+  /// time spent waiting
+  void traceBegin();
+
+  /// @brief take the storage engine counters at the start of every traced
+  /// call. they are per thread, so they are not carried across WAITING
+  void traceStorageBegin();
+
+  /// @brief add the measurements of a traced call to the node's stats
+  void traceEnd(ExecutionState state, size_t items, size_t itemsIn);
+
  protected:
   /// @brief the execution engine
   ExecutionEngine* _engine;
@@ -294,6 +293,16 @@ class ExecutionBlock {
   /// @brief getSome begin point in time
   double _getSomeBegin;
 
+  /// @brief CPU time of the thread and memory usage of the query at
+  /// _getSomeBegin
+  double _cpuTimeBegin;
+  size_t _memoryUsageBegin;
+
+  /// @brief storage engine counters of the thread at the start of the
+  /// current call, and the part of them attributed to blocks at that time
+  StoragePerfCounters _storageBegin;
+  StoragePerfCounters _storageAttributedBegin;
+
   /// @brief the execution state of the dependency
   ///        used to determine HASMORE or DONE better
   ExecutionState _upstreamState;
@@ -39,12 +39,16 @@
 #include "Aql/EnumerateCollectionExecutor.h"
 #include "Aql/EnumerateListExecutor.h"
 #include "Aql/FilterExecutor.h"
+#include "Aql/HashJoinExecutor.h"
 #include "Aql/HashedCollectExecutor.h"
 #include "Aql/IResearchViewExecutor.h"
 #include "Aql/IdExecutor.h"
+#include "Aql/IndexCollectExecutor.h"
 #include "Aql/IndexExecutor.h"
 #include "Aql/KShortestPathsExecutor.h"
 #include "Aql/LimitExecutor.h"
+#include "Aql/MaterializeExecutor.h"
+#include "Aql/MergeJoinExecutor.h"
 #include "Aql/ModificationExecutor.h"
 #include "Aql/ModificationExecutorTraits.h"
 #include "Aql/NoResultsExecutor.h"
@@ -90,6 +94,25 @@ using namespace arangodb::aql;
 CREATE_HAS_MEMBER_CHECK(initializeCursor, hasInitializeCursor);
 CREATE_HAS_MEMBER_CHECK(skipRows, hasSkipRows);
 
+namespace {
+/// @brief number of rows of the first output block of a node
+constexpr size_t initialBatchSize = 64;
+
+/// @brief memory the values of a single output block may take at most
+constexpr size_t maxBatchMemory = 4 * 1024 * 1024;
+
+/// @brief the number of rows of the largest output block. if the query has
+/// a memory limit, a single block may take only a small share of it
+size_t maxBatchSize(RegisterId nrRegs, size_t memoryLimit) {
+  size_t budget = ::maxBatchMemory;
+  if (memoryLimit > 0) {
+    budget = (std::min)(budget, memoryLimit / 16);
+  }
+  size_t const rowSize = (std::max)(static_cast<size_t>(nrRegs), size_t(1)) * sizeof(AqlValue);
+  return (std::max)(size_t(1), (std::min)(budget / rowSize, ExecutionBlock::DefaultBatchSize()));
+}
+}  // namespace
+
 template <class Executor>
 ExecutionBlockImpl<Executor>::ExecutionBlockImpl(ExecutionEngine* engine,
                                                  ExecutionNode const* node,
@@ -101,7 +124,11 @@ ExecutionBlockImpl<Executor>::ExecutionBlockImpl(ExecutionEngine* engine,
       _infos(std::move(infos)),
       _executor(_rowFetcher, _infos),
       _outputItemRow(),
-      _query(*engine->getQuery()) {
+      _query(*engine->getQuery()),
+      _maxBatchSize(::maxBatchSize(_infos.numberOfOutputRegisters(),
+                                   _query.queryOptions().memoryLimit)) {
+  _batchSize = (std::min)(::initialBatchSize, _maxBatchSize);
+
   // already insert ourselves into the statistics results
   if (_profile >= PROFILE_LEVEL_BLOCKS) {
     _engine->_stats.nodes.emplace(node->id(), ExecutionStats::Node());
@@ -114,8 +141,10 @@ ExecutionBlockImpl<Executor>::~ExecutionBlockImpl() = default;
 template <class Executor>
 std::pair<ExecutionState, SharedAqlItemBlockPtr> ExecutionBlockImpl<Executor>::getSome(size_t atMost) {
   traceGetSomeBegin(atMost);
+  size_t const fetchedBefore = _dependencyProxy.numRowsFetched();
   auto result = getSomeWithoutTrace(atMost);
-  return traceGetSomeEnd(result.first, std::move(result.second));
+  return traceGetSomeEnd(result.first, std::move(result.second),
+                         _dependencyProxy.numRowsFetched() - fetchedBefore);
 }
 
 template <class Executor>
@@ -139,8 +168,12 @@ std::pair<ExecutionState, SharedAqlItemBlockPtr> ExecutionBlockImpl<Executor>::g
   if (!_outputItemRow) {
     ExecutionState state;
     SharedAqlItemBlockPtr newBlock;
+    // passed-through blocks are sized by the dependency
+    size_t const nrItems = Executor::Properties::allowsBlockPassthrough
+                               ? atMost
+                               : (std::min)(atMost, _batchSize);
     std::tie(state, newBlock) =
-        requestWrappedBlock(atMost, _infos.numberOfOutputRegisters());
+        requestWrappedBlock(nrItems, _infos.numberOfOutputRegisters());
     if (state == ExecutionState::WAITING) {
       TRI_ASSERT(newBlock == nullptr);
       return {state, nullptr};
@@ -153,6 +186,10 @@ std::pair<ExecutionState, SharedAqlItemBlockPtr> ExecutionBlockImpl<Executor>::g
     TRI_ASSERT(newBlock != nullptr);
     TRI_ASSERT(newBlock->size() > 0);
     TRI_ASSERT(newBlock->size() <= atMost);
+    if (_profile >= PROFILE_LEVEL_BLOCKS) {
+      auto& nodeStats = _engine->_stats.nodes[getPlanNode()->id()];
+      nodeStats.batchSize = (std::max)(nodeStats.batchSize, newBlock->size());
+    }
     _outputItemRow = createOutputRow(newBlock);
   }
 
@@ -167,7 +204,7 @@ std::pair<ExecutionState, SharedAqlItemBlockPtr> ExecutionBlockImpl<Executor>::g
     std::tie(state, executorStats) = _executor.produceRows(*_outputItemRow);
     // Count global but executor-specific statistics, like number of filtered
     // rows.
-    _engine->_stats += executorStats;
+    _engine->addStats(executorStats);
     if (_outputItemRow->produced()) {
       _outputItemRow->advanceRow();
     }
@@ -177,6 +214,7 @@ std::pair<ExecutionState, SharedAqlItemBlockPtr> ExecutionBlockImpl<Executor>::g
     }
 
     if (state == ExecutionState::DONE) {
+      adaptBatchSize(state, _outputItemRow->numRowsWritten());
       auto outputBlock = _outputItemRow->stealBlock();
       // This is not strictly necessary here, as we shouldn't be called again
       // after DONE.
@@ -189,8 +227,9 @@ std::pair<ExecutionState, SharedAqlItemBlockPtr> ExecutionBlockImpl<Executor>::g
   // When we're passing blocks through we have no control over the size of the
   // output block.
   if /* constexpr */ (!Executor::Properties::allowsBlockPassthrough) {
-    TRI_ASSERT(_outputItemRow->numRowsWritten() == atMost);
+    TRI_ASSERT(_outputItemRow->numRowsWritten() == (std::min)(atMost, _batchSize));
   }
+  adaptBatchSize(state, _outputItemRow->numRowsWritten());
 
   auto outputBlock = _outputItemRow->stealBlock();
   // we guarantee that we do return a valid pointer in the HASMORE case.
@@ -294,6 +333,7 @@ static SkipVariants constexpr skipType() {
 template <class Executor>
 std::pair<ExecutionState, size_t> ExecutionBlockImpl<Executor>::skipSome(size_t atMost) {
   traceSkipSomeBegin(atMost);
+  size_t const fetchedBefore = _dependencyProxy.numRowsFetched();
 
   constexpr SkipVariants customSkipType = skipType<Executor>();
 
@@ -307,7 +347,8 @@ std::pair<ExecutionState, size_t> ExecutionBlockImpl<Executor>::skipSome(size_t
     }
     TRI_ASSERT(skipped <= atMost);
 
-    return traceSkipSomeEnd({res.first, skipped});
+    return traceSkipSomeEnd({res.first, skipped},
+                            _dependencyProxy.numRowsFetched() - fetchedBefore);
   }
 
   ExecutionState state;
@@ -315,10 +356,10 @@ std::pair<ExecutionState, size_t> ExecutionBlockImpl<Executor>::skipSome(size_t
   size_t skipped;
   std::tie(state, stats, skipped) =
       ExecuteSkipVariant<customSkipType>::executeSkip(_executor, _rowFetcher, atMost);
-  _engine->_stats += stats;
+  _engine->addStats(stats);
   TRI_ASSERT(skipped <= atMost);
 
-  return traceSkipSomeEnd(state, skipped);
+  return traceSkipSomeEnd(state, skipped, _dependencyProxy.numRowsFetched() - fetchedBefore);
 }
 
 template <bool customInit>
@@ -346,7 +387,7 @@ struct InitializeCursor<true> {
 };
 
 template <class Executor>
-std::pair<ExecutionState, Result> ExecutionBlockImpl<Executor>::initializeCursor(InputAqlItemRow const& input) {
+void ExecutionBlockImpl<Executor>::resetExecutor() {
   // reinitialize the DependencyProxy
   _dependencyProxy.reset();
 
@@ -363,7 +404,18 @@ std::pair<ExecutionState, Result> ExecutionBlockImpl<Executor>::initializeCursor
   static_assert(!std::is_same<Executor, IndexExecutor>::value || customInit,
                 "IndexExecutor is expected to implement a custom "
                 "initializeCursor method!");
+  static_assert(!std::is_same<Executor, HashJoinExecutor>::value || customInit,
+                "HashJoinExecutor is expected to implement a custom "
+                "initializeCursor method, to keep its hash table!");
+  static_assert(!std::is_same<Executor, MergeJoinExecutor>::value || customInit,
+                "MergeJoinExecutor is expected to implement a custom "
+                "initializeCursor method, to keep its index position!");
   InitializeCursor<customInit>::init(_executor, _rowFetcher, _infos);
+}
+
+template <class Executor>
+std::pair<ExecutionState, Result> ExecutionBlockImpl<Executor>::initializeCursor(InputAqlItemRow const& input) {
+  resetExecutor();
 
   // // use this with c++17 instead of specialisation below
   // if constexpr (std::is_same_v<Executor, IdExecutor>) {
@@ -376,6 +428,13 @@ std::pair<ExecutionState, Result> ExecutionBlockImpl<Executor>::initializeCursor
   return ExecutionBlock::initializeCursor(input);
 }
 
+template <class Executor>
+std::pair<ExecutionState, Result> ExecutionBlockImpl<Executor>::initializeCursorWithBatch(
+    SharedAqlItemBlockPtr const& batch) {
+  resetExecutor();
+  return ExecutionBlock::initializeCursorWithBatch(batch);
+}
+
 template <class Executor>
 std::pair<ExecutionState, Result> ExecutionBlockImpl<Executor>::shutdown(int errorCode) {
   return ExecutionBlock::shutdown(errorCode);
@@ -410,6 +469,31 @@ std::pair<ExecutionState, Result> ExecutionBlockImpl<IdExecutor<ConstFetcher>>::
   return ExecutionBlock::initializeCursor(input);
 }
 
+template <>
+std::pair<ExecutionState, Result> ExecutionBlockImpl<IdExecutor<ConstFetcher>>::initializeCursorWithBatch(
+    SharedAqlItemBlockPtr const& batch) {
+  TRI_ASSERT(batch != nullptr);
+  // reinitialize the DependencyProxy
+  _dependencyProxy.reset();
+
+  // destroy and re-create the Fetcher
+  _rowFetcher.~Fetcher();
+  new (&_rowFetcher) Fetcher(_dependencyProxy);
+
+  // all rows of the batch are produced, with the same registers as a
+  // single input row would have
+  SharedAqlItemBlockPtr block =
+      batch->slice(0, batch->size(), *(infos().registersToKeep()),
+                   infos().numberOfOutputRegisters());
+
+  _rowFetcher.injectBlock(block);
+
+  constexpr bool customInit = hasInitializeCursor<decltype(_executor)>::value;
+  InitializeCursor<customInit>::init(_executor, _rowFetcher, _infos);
+
+  return ExecutionBlock::initializeCursorWithBatch(batch);
+}
+
 // TODO the shutdown specializations shall be unified!
 
 template <>
@@ -562,6 +646,22 @@ SharedAqlItemBlockPtr ExecutionBlockImpl<Executor>::requestBlock(size_t nrItems,
   return _engine->itemBlockManager().requestBlock(nrItems, nrRegs);
 }
 
+template <class Executor>
+void ExecutionBlockImpl<Executor>::adaptBatchSize(ExecutionState state, size_t rows) {
+  if /* constexpr */ (Executor::Properties::allowsBlockPassthrough) {
+    return;
+  }
+  if (state == ExecutionState::HASMORE) {
+    if (rows >= _batchSize) {
+      // more rows are to come, use bigger blocks
+      _batchSize = (std::min)(_batchSize * 2, _maxBatchSize);
+    }
+  } else if (rows * 4 < _batchSize) {
+    // the next run of this node, e.g. in a subquery, is likely as small
+    _batchSize = (std::max)(_batchSize / 2, (std::min)(::initialBatchSize, _maxBatchSize));
+  }
+}
+
 template class ::arangodb::aql::ExecutionBlockImpl<CalculationExecutor<CalculationType::Condition>>;
 template class ::arangodb::aql::ExecutionBlockImpl<CalculationExecutor<CalculationType::Reference>>;
 template class ::arangodb::aql::ExecutionBlockImpl<CalculationExecutor<CalculationType::V8Condition>>;
@@ -571,13 +671,17 @@ template class ::arangodb::aql::ExecutionBlockImpl<DistinctCollectExecutor>;
 template class ::arangodb::aql::ExecutionBlockImpl<EnumerateCollectionExecutor>;
 template class ::arangodb::aql::ExecutionBlockImpl<EnumerateListExecutor>;
 template class ::arangodb::aql::ExecutionBlockImpl<FilterExecutor>;
+template class ::arangodb::aql::ExecutionBlockImpl<HashJoinExecutor>;
 template class ::arangodb::aql::ExecutionBlockImpl<HashedCollectExecutor>;
 template class ::arangodb::aql::ExecutionBlockImpl<IResearchViewExecutor<false>>;
 template class ::arangodb::aql::ExecutionBlockImpl<IResearchViewExecutor<true>>;
 template class ::arangodb::aql::ExecutionBlockImpl<IdExecutor<ConstFetcher>>;
 template class ::arangodb::aql::ExecutionBlockImpl<IdExecutor<SingleRowFetcher<true>>>;
+template class ::arangodb::aql::ExecutionBlockImpl<IndexCollectExecutor>;
 template class ::arangodb::aql::ExecutionBlockImpl<IndexExecutor>;
 template class ::arangodb::aql::ExecutionBlockImpl<LimitExecutor>;
+template class ::arangodb::aql::ExecutionBlockImpl<MaterializeExecutor>;
+template class ::arangodb::aql::ExecutionBlockImpl<MergeJoinExecutor>;
 template class ::arangodb::aql::ExecutionBlockImpl<ModificationExecutor<Insert, SingleBlockFetcher<false /*allowsBlockPassthrough */>>>;
 template class ::arangodb::aql::ExecutionBlockImpl<ModificationExecutor<Insert, AllRowsFetcher>>;
 template class ::arangodb::aql::ExecutionBlockImpl<ModificationExecutor<Remove, SingleBlockFetcher<false /*allowsBlockPassthrough */>>>;
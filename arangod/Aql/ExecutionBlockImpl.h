@@ -171,6 +171,8 @@ class ExecutionBlockImpl final : public ExecutionBlock {
 
   std::pair<ExecutionState, Result> initializeCursor(InputAqlItemRow const& input) override;
 
+  std::pair<ExecutionState, Result> initializeCursorWithBatch(SharedAqlItemBlockPtr const& batch) override;
+
   Infos const& infos() const { return _infos; }
 
   /// @brief shutdown, will be called exactly once for the whole query
@@ -203,6 +205,10 @@ class ExecutionBlockImpl final : public ExecutionBlock {
 
   std::unique_ptr<OutputAqlItemRow> createOutputRow(SharedAqlItemBlockPtr& newBlock) const;
 
+  /// @brief reset the DependencyProxy, the Fetcher and the Executor for a
+  /// new run, used by initializeCursor and initializeCursorWithBatch
+  void resetExecutor();
+
   Query const& getQuery() const { return _query; }
 
   Executor& executor() { return _executor; }
@@ -210,6 +216,10 @@ class ExecutionBlockImpl final : public ExecutionBlock {
   /// @brief request an AqlItemBlock from the memory manager
   SharedAqlItemBlockPtr requestBlock(size_t nrItems, RegisterId nrRegs);
 
+  /// @brief adapt the size of the next output block, after an output block
+  /// with the given number of rows has been returned
+  void adaptBatchSize(ExecutionState state, size_t rows);
+
  private:
   /**
    * @brief Used to allow the row Fetcher to access selected methods of this
@@ -235,6 +245,15 @@ class ExecutionBlockImpl final : public ExecutionBlock {
   std::unique_ptr<OutputAqlItemRow> _outputItemRow;
 
   Query const& _query;
+
+  /// @brief number of rows of the next output block. it starts small, so
+  /// that a query producing only a few rows does not allocate big blocks,
+  /// and grows up to _maxBatchSize while the blocks are filled completely
+  size_t _batchSize;
+
+  /// @brief the largest output block, limited by the width of its rows and
+  /// the memory limit of the query
+  size_t const _maxBatchSize;
 };
 
 }  // namespace aql
@@ -27,11 +27,14 @@
 #include "Aql/AqlResult.h"
 #include "Aql/BlocksWithClients.h"
 #include "Aql/Collection.h"
+#include "Aql/Condition.h"
 #include "Aql/EngineInfoContainerCoordinator.h"
 #include "Aql/EngineInfoContainerDBServer.h"
 #include "Aql/ExecutionBlockImpl.h"
 #include "Aql/ExecutionNode.h"
 #include "Aql/GraphNode.h"
+#include "Aql/IndexNode.h"
+#include "Aql/PrefetchBlock.h"
 #include "Aql/Query.h"
 #include "Aql/QueryRegistry.h"
 #include "Aql/RemoteExecutor.h"
@@ -40,6 +43,11 @@
 #include "Cluster/ClusterComm.h"
 #include "Cluster/ServerState.h"
 #include "Logger/Logger.h"
+#include "Scheduler/SchedulerFeature.h"
+#include "StorageEngine/StoragePerfCounters.h"
+#include "StorageEngine/TransactionState.h"
+#include "Transaction/Context.h"
+#include "Transaction/Methods.h"
 
 using namespace arangodb;
 using namespace arangodb::aql;
@@ -190,8 +198,15 @@ ExecutionEngine::ExecutionEngine(Query* query)
       _query(query),
       _resultRegister(0),
       _initializeCursorCalled(false),
-      _wasShutdown(false) {
+      _wasShutdown(false),
+      _concurrent(false) {
   _blocks.reserve(8);
+
+  if (query->queryOptions().columnarRegisters) {
+    // register-wise scans (filters, calculations, sorts) will then read
+    // adjacent values
+    _itemBlockManager.setLayout(AqlItemBlockLayout::ColumnMajor);
+  }
 }
 
 /// @brief destroy the engine, frees all assigned blocks
@@ -202,17 +217,74 @@ ExecutionEngine::~ExecutionEngine() {
     // shutdown can throw - ignore it in the destructor
   }
 
-  for (auto& it : _blocks) {
-    delete it;
+  // delete consumers before their dependencies, a PrefetchBlock may still
+  // be waiting for its dependency on a scheduler thread
+  for (auto it = _blocks.rbegin(); it != _blocks.rend(); ++it) {
+    delete *it;
+  }
+}
+
+namespace {
+/// @brief whether a node only reads from the storage engine. such nodes can
+/// be executed on scheduler threads, because they do not use V8, the
+/// query's regex cache or other unsynchronized state
+bool isPrefetchableType(ExecutionNode const* node) {
+  switch (node->getType()) {
+    case ExecutionNode::SINGLETON:
+    case ExecutionNode::ENUMERATE_COLLECTION:
+      return true;
+    case ExecutionNode::INDEX: {
+      Condition const* condition = ExecutionNode::castTo<IndexNode const*>(node)->condition();
+      return condition == nullptr || condition->root() == nullptr ||
+             !condition->root()->callsFunction();
+    }
+    default:
+      return false;
+  }
+}
+
+/// @brief whether a node and all of its dependencies can be executed on
+/// scheduler threads
+bool isPrefetchable(ExecutionNode const* node) {
+  while (node != nullptr) {
+    if (!isPrefetchableType(node) || node->getDependencies().size() > 1) {
+      return false;
+    }
+    node = node->getFirstDependency();
   }
+  return true;
 }
+}  // namespace
 
 struct Instanciator final : public WalkerWorker<ExecutionNode> {
   ExecutionEngine* engine;
   ExecutionBlock* root{};
   std::unordered_map<ExecutionNode*, ExecutionBlock*> cache;
+  /// @brief whether top-level scans may prefetch on scheduler threads
+  bool prefetch;
+  size_t subqueryDepth;
+
+  explicit Instanciator(ExecutionEngine* engine)
+      : engine(engine), prefetch(false), subqueryDepth(0) {
+    Query* query = engine->getQuery();
+    // the parts of the query that stay on the querying thread must not
+    // modify anything concurrently, and per-node profiling is not
+    // synchronized
+    prefetch = query->queryOptions().prefetch &&
+               query->traceLevel() < PROFILE_LEVEL_BLOCKS &&
+               query->trx()->state()->isReadOnlyTransaction() &&
+               SchedulerFeature::SCHEDULER != nullptr;
+  }
 
-  explicit Instanciator(ExecutionEngine* engine) noexcept : engine(engine) {}
+  bool enterSubquery(ExecutionNode*, ExecutionNode*) override final {
+    ++subqueryDepth;
+    return true;
+  }
+
+  void leaveSubquery(ExecutionNode*, ExecutionNode*) override final {
+    TRI_ASSERT(subqueryDepth > 0);
+    --subqueryDepth;
+  }
 
   virtual void after(ExecutionNode* en) override final {
     ExecutionBlock* block = nullptr;
@@ -251,6 +323,18 @@ struct Instanciator final : public WalkerWorker<ExecutionNode> {
       block->addDependency(it2->second);
     }
 
+    // prefetch at the top of a chain of scans, so the rest of the query
+    // runs in parallel to them
+    if (prefetch && subqueryDepth == 0 && en->hasParent() &&
+        en->getType() != ExecutionNode::SINGLETON &&
+        !isPrefetchableType(en->getFirstParent()) && isPrefetchable(en)) {
+      engine->enableConcurrentExecution();
+      ExecutionBlock* prefetchBlock =
+          engine->addBlock(std::make_unique<PrefetchBlock>(engine, en));
+      prefetchBlock->addDependency(block);
+      block = prefetchBlock;
+    }
+
     cache.emplace(en, block);
   }
 };
@@ -463,6 +547,8 @@ std::pair<ExecutionState, Result> ExecutionEngine::initializeCursor(SharedAqlIte
 }
 
 std::pair<ExecutionState, SharedAqlItemBlockPtr> ExecutionEngine::getSome(size_t atMost) {
+  QueryResourceScope resourceScope(_query->resourceUsage());
+  StoragePerfScope perfScope(_query->queryOptions().getProfileLevel() >= PROFILE_LEVEL_BLOCKS);
   if (!_initializeCursorCalled) {
     auto res = initializeCursor(nullptr, 0);
     if (res.first == ExecutionState::WAITING) {
@@ -473,6 +559,8 @@ std::pair<ExecutionState, SharedAqlItemBlockPtr> ExecutionEngine::getSome(size_t
 }
 
 std::pair<ExecutionState, size_t> ExecutionEngine::skipSome(size_t atMost) {
+  QueryResourceScope resourceScope(_query->resourceUsage());
+  StoragePerfScope perfScope(_query->queryOptions().getProfileLevel() >= PROFILE_LEVEL_BLOCKS);
   if (!_initializeCursorCalled) {
     auto res = initializeCursor(nullptr, 0);
     if (res.first == ExecutionState::WAITING) {
@@ -624,3 +712,20 @@ ExecutionBlock* ExecutionEngine::addBlock(std::unique_ptr<ExecutionBlock>&& bloc
   _blocks.emplace_back(block.get());
   return block.release();
 }
+
+/// @brief prepare the engine for blocks that are executed on scheduler threads
+void ExecutionEngine::enableConcurrentExecution() {
+  if (_concurrent) {
+    return;
+  }
+  _concurrent = true;
+  _itemBlockManager.setThreadSafe();
+  _query->resourceMonitor()->setThreadSafe();
+
+  transaction::Context* context = _query->trx()->transactionContextPtr();
+  context->setThreadSafe();
+  // the resolver and the custom type handler are created lazily. create
+  // them now, before more than one thread can ask for them
+  context->resolver();
+  context->getVPackOptions();
+}
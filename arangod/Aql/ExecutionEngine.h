@@ -29,6 +29,8 @@
 #include "Aql/ExecutionStats.h"
 #include "Aql/Query.h"
 #include "Basics/Common.h"
+#include "Basics/Mutex.h"
+#include "Basics/MutexLocker.h"
 
 namespace arangodb {
 namespace aql {
@@ -107,6 +109,18 @@ class ExecutionEngine {
     return _itemBlockManager;
   }
 
+  /// @brief prepare the engine for blocks that are executed on scheduler
+  /// threads, while other blocks of the query keep running. this cannot be
+  /// undone
+  void enableConcurrentExecution();
+
+  /// @brief add executor statistics to _stats
+  template <typename T>
+  void addStats(T const& stats) {
+    CONDITIONAL_MUTEX_LOCKER(locker, _statsLock, _concurrent);
+    _stats += stats;
+  }
+
  public:
   /// @brief execution statistics for the query
   /// note that the statistics are modification by execution blocks
@@ -133,6 +147,12 @@ class ExecutionEngine {
 
   /// @brief whether or not shutdown() was executed
   bool _wasShutdown;
+
+  /// @brief whether blocks may be executed on more than one thread
+  bool _concurrent;
+
+  /// @brief protects _stats, only used if _concurrent is set
+  Mutex _statsLock;
 };
 }  // namespace aql
 }  // namespace arangodb
@@ -29,6 +29,7 @@
 #include "Aql/AqlItemBlock.h"
 #include "Aql/Ast.h"
 #include "Aql/CalculationExecutor.h"
+#include "Aql/CardinalityEstimator.h"
 #include "Aql/ClusterNodes.h"
 #include "Aql/CollectNode.h"
 #include "Aql/Collection.h"
@@ -39,11 +40,15 @@
 #include "Aql/ExecutionPlan.h"
 #include "Aql/FilterExecutor.h"
 #include "Aql/Function.h"
+#include "Aql/HashJoinNode.h"
 #include "Aql/IResearchViewNode.h"
 #include "Aql/IdExecutor.h"
+#include "Aql/IndexCollectNode.h"
 #include "Aql/IndexNode.h"
 #include "Aql/KShortestPathsNode.h"
 #include "Aql/LimitExecutor.h"
+#include "Aql/MaterializeNode.h"
+#include "Aql/MergeJoinNode.h"
 #include "Aql/ModificationNodes.h"
 #include "Aql/NoResultsExecutor.h"
 #include "Aql/NodeFinder.h"
@@ -100,6 +105,10 @@ std::unordered_map<int, std::string const> const typeNames{
      "SingleRemoteOperationNode"},
     {static_cast<int>(ExecutionNode::ENUMERATE_IRESEARCH_VIEW),
      "EnumerateViewNode"},
+    {static_cast<int>(ExecutionNode::HASH_JOIN), "HashJoinNode"},
+    {static_cast<int>(ExecutionNode::MERGE_JOIN), "MergeJoinNode"},
+    {static_cast<int>(ExecutionNode::MATERIALIZE), "MaterializeNode"},
+    {static_cast<int>(ExecutionNode::INDEX_COLLECT), "IndexCollectNode"},
 };
 
 // FIXME -- this temporary function should be
@@ -330,6 +339,14 @@ ExecutionNode* ExecutionNode::fromVPackFactory(ExecutionPlan* plan, VPackSlice c
       return new SingleRemoteOperationNode(plan, slice);
     case ENUMERATE_IRESEARCH_VIEW:
       return new iresearch::IResearchViewNode(*plan, slice);
+    case HASH_JOIN:
+      return new HashJoinNode(plan, slice);
+    case MERGE_JOIN:
+      return new MergeJoinNode(plan, slice);
+    case MATERIALIZE:
+      return new MaterializeNode(plan, slice);
+    case INDEX_COLLECT:
+      return new IndexCollectNode(plan, slice);
     default: {
       // should not reach this point
       TRI_ASSERT(false);
@@ -618,7 +635,8 @@ ExecutionNode const* ExecutionNode::getLoop() const {
 
     if (type == ENUMERATE_COLLECTION || type == INDEX || type == TRAVERSAL ||
         type == ENUMERATE_LIST || type == SHORTEST_PATH ||
-        type == K_SHORTEST_PATHS || type == ENUMERATE_IRESEARCH_VIEW) {
+        type == K_SHORTEST_PATHS || type == ENUMERATE_IRESEARCH_VIEW ||
+        type == HASH_JOIN || type == MERGE_JOIN || type == INDEX_COLLECT) {
       return node;
     }
   }
@@ -859,7 +877,9 @@ ExecutionNode::RegisterPlan* ExecutionNode::RegisterPlan::clone(ExecutionPlan* o
 void ExecutionNode::RegisterPlan::after(ExecutionNode* en) {
   switch (en->getType()) {
     case ExecutionNode::ENUMERATE_COLLECTION:
-    case ExecutionNode::INDEX: {
+    case ExecutionNode::INDEX:
+    case ExecutionNode::HASH_JOIN:
+    case ExecutionNode::MERGE_JOIN: {
       depth++;
       nrRegsHere.emplace_back(1);
       // create a copy of the last value here
@@ -877,6 +897,14 @@ void ExecutionNode::RegisterPlan::after(ExecutionNode* en) {
 
       varInfo.emplace(ep->outVariable()->id, VarInfo(depth, totalNrRegs));
       totalNrRegs++;
+
+      if (ep->docIdVariable() != nullptr) {
+        // the documents are materialized later. their ids need a register
+        nrRegsHere[depth]++;
+        nrRegs[depth]++;
+        varInfo.emplace(ep->docIdVariable()->id, VarInfo(depth, totalNrRegs));
+        totalNrRegs++;
+      }
       break;
     }
 
@@ -906,6 +934,16 @@ void ExecutionNode::RegisterPlan::after(ExecutionNode* en) {
       break;
     }
 
+    case ExecutionNode::MATERIALIZE: {
+      nrRegsHere[depth]++;
+      nrRegs[depth]++;
+      auto ep = ExecutionNode::castTo<MaterializeNode const*>(en);
+      TRI_ASSERT(ep != nullptr);
+      varInfo.emplace(ep->outVariable()->id, VarInfo(depth, totalNrRegs));
+      totalNrRegs++;
+      break;
+    }
+
     case ExecutionNode::SUBQUERY: {
       nrRegsHere[depth]++;
       nrRegs[depth]++;
@@ -913,6 +951,14 @@ void ExecutionNode::RegisterPlan::after(ExecutionNode* en) {
       TRI_ASSERT(ep != nullptr);
       varInfo.emplace(ep->outVariable()->id, VarInfo(depth, totalNrRegs));
       totalNrRegs++;
+      if (ep->rowIdVariable() != nullptr) {
+        // the row id is only written into the blocks passed into the
+        // subquery, but has to be available there
+        nrRegsHere[depth]++;
+        nrRegs[depth]++;
+        varInfo.emplace(ep->rowIdVariable()->id, VarInfo(depth, totalNrRegs));
+        totalNrRegs++;
+      }
       subQueryNodes.emplace_back(en);
       break;
     }
@@ -1013,6 +1059,23 @@ void ExecutionNode::RegisterPlan::after(ExecutionNode* en) {
       break;
     }
 
+    case ExecutionNode::INDEX_COLLECT: {
+      depth++;
+      auto vars = en->getVariablesSetHere();
+      nrRegsHere.emplace_back(static_cast<RegisterId>(vars.size()));
+      // create a copy of the last value here
+      // this is required because back returns a reference and emplace/push_back
+      // may invalidate all references
+      RegisterId registerId = static_cast<RegisterId>(vars.size() + nrRegs.back());
+      nrRegs.emplace_back(registerId);
+
+      for (auto& it : vars) {
+        varInfo.emplace(it->id, VarInfo(depth, totalNrRegs));
+        totalNrRegs++;
+      }
+      break;
+    }
+
     case ExecutionNode::TRAVERSAL:
     case ExecutionNode::SHORTEST_PATH:
     case ExecutionNode::K_SHORTEST_PATHS: {
@@ -1314,7 +1377,12 @@ EnumerateCollectionNode::EnumerateCollectionNode(ExecutionPlan* plan,
       DocumentProducingNode(plan, base),
       CollectionAccessingNode(plan, base),
       _random(base.get("random").getBoolean()),
-      _hint(base) {}
+      _hint(base) {
+  VPackSlice filter = base.get("filter");
+  if (filter.isObject()) {
+    _filter = std::make_unique<Expression>(plan, plan->getAst(), filter);
+  }
+}
 
 /// @brief toVelocyPack, for EnumerateCollectionNode
 void EnumerateCollectionNode::toVelocyPackHelper(VPackBuilder& builder, unsigned flags) const {
@@ -1325,6 +1393,15 @@ void EnumerateCollectionNode::toVelocyPackHelper(VPackBuilder& builder, unsigned
 
   _hint.toVelocyPack(builder);
 
+  if (_filter != nullptr) {
+    builder.add(VPackValue("filter"));
+    builder.openObject();
+    // The Expression constructor expects only this name
+    builder.add(VPackValue("expression"));
+    _filter->toVelocyPack(builder, flags);
+    builder.close();
+  }
+
   // add outvariable and projection
   DocumentProducingNode::toVelocyPack(builder);
 
@@ -1343,13 +1420,24 @@ std::unique_ptr<ExecutionBlock> EnumerateCollectionNode::createBlock(
 
   transaction::Methods* trxPtr = _plan->getAst()->query()->trx();
 
+  // only a top-level loop scans the collection once, so that starting the
+  // parallel scan pays off
+  size_t parallelism = 1;
+  if (!_random && getLoop() == nullptr) {
+    parallelism = engine.getQuery()->queryOptions().maxScanThreads;
+  }
+
   EnumerateCollectionExecutorInfos infos(
       variableToRegisterId(_outVariable),
       getRegisterPlan()->nrRegs[previousNode->getDepth()],
       getRegisterPlan()->nrRegs[getDepth()], getRegsToClear(), calcRegsToKeep(),
       &engine, this->_collection, _outVariable, this->isVarUsedLater(_outVariable),
       this->projections(), trxPtr, this->coveringIndexAttributePositions(),
-      EngineSelectorFeature::ENGINE->useRawDocumentPointers(), this->_random);
+      EngineSelectorFeature::ENGINE->useRawDocumentPointers(), this->_random,
+      parallelism,
+      (_docIdVariable != nullptr ? variableToRegisterId(_docIdVariable)
+                                 : ExecutionNode::MaxRegisterId),
+      (_filter != nullptr ? _filter->node() : nullptr));
   return std::make_unique<ExecutionBlockImpl<EnumerateCollectionExecutor>>(&engine, this,
                                                                            std::move(infos));
 }
@@ -1363,12 +1451,21 @@ ExecutionNode* EnumerateCollectionNode::clone(ExecutionPlan* plan, bool withDepe
     TRI_ASSERT(outVariable != nullptr);
   }
 
+  auto docIdVariable = _docIdVariable;
+  if (withProperties && docIdVariable != nullptr) {
+    docIdVariable = plan->getAst()->variables()->createVariable(docIdVariable);
+  }
+
   auto c = std::make_unique<EnumerateCollectionNode>(plan, _id, _collection,
                                                      outVariable, _random, _hint);
 
   c->projections(_projections);
+  c->docIdVariable(docIdVariable);
   c->_prototypeCollection = _prototypeCollection;
   c->_prototypeOutVariable = _prototypeOutVariable;
+  if (_filter != nullptr) {
+    c->_filter.reset(_filter->clone(plan, plan->getAst()));
+  }
 
   return cloneHelper(std::move(c), withDependencies, withProperties);
 }
@@ -1389,6 +1486,11 @@ CostEstimate EnumerateCollectionNode::estimateCost() const {
   // we also penalize each EnumerateCollectionNode slightly (and do not
   // do the same for IndexNodes) so IndexNodes will be preferred
   estimate.estimatedCost += estimate.estimatedNrItems * (_random ? 1.005 : 1.0) + 1.0;
+  if (_filter != nullptr) {
+    // all documents are still scanned, but only the matching ones are
+    // passed on
+    estimate.estimatedNrItems *= CardinalityEstimator(_plan).selectivity(_filter->node());
+  }
   return estimate;
 }
 
@@ -1691,7 +1793,8 @@ CostEstimate CalculationNode::estimateCost() const {
 SubqueryNode::SubqueryNode(ExecutionPlan* plan, arangodb::velocypack::Slice const& base)
     : ExecutionNode(plan, base),
       _subquery(nullptr),
-      _outVariable(Variable::varFromVPack(plan->getAst(), base, "outVariable")) {}
+      _outVariable(Variable::varFromVPack(plan->getAst(), base, "outVariable")),
+      _rowIdVariable(Variable::varFromVPack(plan->getAst(), base, "rowIdVariable", true)) {}
 
 /// @brief toVelocyPack, for SubqueryNode
 void SubqueryNode::toVelocyPackHelper(VPackBuilder& nodes, unsigned flags) const {
@@ -1702,6 +1805,10 @@ void SubqueryNode::toVelocyPackHelper(VPackBuilder& nodes, unsigned flags) const
   _subquery->toVelocyPack(nodes, flags, /*keepTopLevelOpen*/ false);
   nodes.add(VPackValue("outVariable"));
   _outVariable->toVelocyPack(nodes);
+  if (_rowIdVariable != nullptr) {
+    nodes.add(VPackValue("rowIdVariable"));
+    _rowIdVariable->toVelocyPack(nodes);
+  }
 
   nodes.add("isConst", VPackValue(const_cast<SubqueryNode*>(this)->isConst()));
 
@@ -1763,6 +1870,10 @@ bool SubqueryNode::mayAccessCollections() {
   // a collection
   std::vector<ExecutionNode::NodeType> const types = {ExecutionNode::ENUMERATE_IRESEARCH_VIEW,
                                                       ExecutionNode::ENUMERATE_COLLECTION,
+                                                      ExecutionNode::HASH_JOIN,
+                                                      ExecutionNode::MERGE_JOIN,
+                                                      ExecutionNode::MATERIALIZE,
+                                                      ExecutionNode::INDEX_COLLECT,
                                                       ExecutionNode::INDEX,
                                                       ExecutionNode::INSERT,
                                                       ExecutionNode::UPDATE,
@@ -1806,12 +1917,16 @@ std::unique_ptr<ExecutionBlock> SubqueryNode::createBlock(
   RegisterId outReg = outVar->second.registerId;
   outputRegisters->emplace(outReg);
 
+  RegisterId const rowIdReg = _rowIdVariable != nullptr
+                                  ? variableToRegisterId(_rowIdVariable)
+                                  : ExecutionNode::MaxRegisterId;
+
   // The const_cast has been taken from previous implementation.
   SubqueryExecutorInfos infos(inputRegisters, outputRegisters,
                               getRegisterPlan()->nrRegs[previousNode->getDepth()],
                               getRegisterPlan()->nrRegs[getDepth()],
                               getRegsToClear(), calcRegsToKeep(), *subquery,
-                              outReg, const_cast<SubqueryNode*>(this)->isConst());
+                              outReg, const_cast<SubqueryNode*>(this)->isConst(), rowIdReg);
   if (isModificationSubquery()) {
     return std::make_unique<ExecutionBlockImpl<SubqueryExecutor<true>>>(&engine, this,
                                                                         std::move(infos));
@@ -1824,12 +1939,17 @@ std::unique_ptr<ExecutionBlock> SubqueryNode::createBlock(
 ExecutionNode* SubqueryNode::clone(ExecutionPlan* plan, bool withDependencies,
                                    bool withProperties) const {
   auto outVariable = _outVariable;
+  auto rowIdVariable = _rowIdVariable;
 
   if (withProperties) {
     outVariable = plan->getAst()->variables()->createVariable(outVariable);
+    if (rowIdVariable != nullptr) {
+      rowIdVariable = plan->getAst()->variables()->createVariable(rowIdVariable);
+    }
   }
   auto c = std::make_unique<SubqueryNode>(plan, _id, _subquery->clone(plan, true, withProperties),
                                           outVariable);
+  c->rowIdVariable(rowIdVariable);
 
   return cloneHelper(std::move(c), withDependencies, withProperties);
 }
@@ -1915,7 +2035,8 @@ void SubqueryNode::getVariablesUsedHere(arangodb::HashSet<Variable const*>& vars
   _subquery->walk(finder);
 
   for (auto var : finder._usedLater) {
-    if (finder._valid.find(var) == finder._valid.end()) {
+    // the row id is set by the subquery itself
+    if (finder._valid.find(var) == finder._valid.end() && var != _rowIdVariable) {
       vars.insert(var);
     }
   }
@@ -1995,23 +2116,32 @@ ExecutionNode* FilterNode::clone(ExecutionPlan* plan, bool withDependencies,
 CostEstimate FilterNode::estimateCost() const {
   TRI_ASSERT(!_dependencies.empty());
 
-  // We are pessimistic here by not reducing the nrItems. However, in the
-  // worst case the filter does not reduce the items at all. Furthermore,
-  // no optimizer rule introduces FilterNodes, thus it is not important
-  // that they appear to lower the costs. Note that contrary to this,
-  // an IndexNode does lower the costs, it also has a better idea
-  // to what extent the number of items is reduced. On the other hand it
-  // is important that a FilterNode produces additional costs, otherwise
-  // the rule throwing away a FilterNode that is already covered by an
-  // IndexNode cannot reduce the costs.
+  // the number of items is reduced by the estimated selectivity of the
+  // condition, so that the nodes after the filter, and the order of
+  // joins, are judged by realistic numbers. It is important that a
+  // FilterNode produces additional costs, otherwise the rule throwing away
+  // a FilterNode that is already covered by an IndexNode cannot reduce the
+  // costs.
   CostEstimate estimate = _dependencies.at(0)->getCost();
   estimate.estimatedCost += estimate.estimatedNrItems;
+
+  auto setter = _plan->getVarSetBy(_inVariable->id);
+  if (setter != nullptr && setter->getType() == ExecutionNode::CALCULATION) {
+    auto expression = ExecutionNode::castTo<CalculationNode const*>(setter)->expression();
+    if (expression != nullptr) {
+      double const selectivity =
+          CardinalityEstimator(_plan).selectivity(expression->node());
+      estimate.estimatedNrItems = static_cast<size_t>(
+          std::ceil(static_cast<double>(estimate.estimatedNrItems) * selectivity));
+    }
+  }
   return estimate;
 }
 
 ReturnNode::ReturnNode(ExecutionPlan* plan, arangodb::velocypack::Slice const& base)
     : ExecutionNode(plan, base),
       _inVariable(Variable::varFromVPack(plan->getAst(), base, "inVariable")),
+      _rowIdVariable(Variable::varFromVPack(plan->getAst(), base, "rowIdVariable", true)),
       _count(VelocyPackHelper::getBooleanValue(base, "count", false)) {}
 
 /// @brief toVelocyPack, for ReturnNode
@@ -2021,6 +2151,10 @@ void ReturnNode::toVelocyPackHelper(VPackBuilder& nodes, unsigned flags) const {
 
   nodes.add(VPackValue("inVariable"));
   _inVariable->toVelocyPack(nodes);
+  if (_rowIdVariable != nullptr) {
+    nodes.add(VPackValue("rowIdVariable"));
+    _rowIdVariable->toVelocyPack(nodes);
+  }
   nodes.add("count", VPackValue(_count));
 
   // And close it:
@@ -2045,13 +2179,20 @@ std::unique_ptr<ExecutionBlock> ReturnNode::createBlock(
   // If we have inherited results, we do move the block through
   // and do not modify it in any way.
   // In the other case it is important to shrink the matrix to exactly
-  // one register that is stored within the DOCVEC.
+  // one register that is stored within the DOCVEC. Batched subqueries
+  // additionally return the input row number in a second register.
+  TRI_ASSERT(!returnInheritedResults || _rowIdVariable == nullptr);
+  RegisterId const rowIdRegister = _rowIdVariable != nullptr
+                                       ? variableToRegisterId(_rowIdVariable)
+                                       : ExecutionNode::MaxRegisterId;
   RegisterId const numberOutputRegisters =
-      returnInheritedResults ? getRegisterPlan()->nrRegs[getDepth()] : 1;
+      returnInheritedResults ? getRegisterPlan()->nrRegs[getDepth()]
+                             : (_rowIdVariable != nullptr ? 2 : 1);
 
   ReturnExecutorInfos infos(inputRegister,
                             getRegisterPlan()->nrRegs[previousNode->getDepth()],
-                            numberOutputRegisters, _count, returnInheritedResults);
+                            numberOutputRegisters, _count, returnInheritedResults,
+                            rowIdRegister);
   if (returnInheritedResults) {
     return std::make_unique<ExecutionBlockImpl<ReturnExecutor<true>>>(&engine, this,
                                                                       std::move(infos));
@@ -2065,12 +2206,17 @@ std::unique_ptr<ExecutionBlock> ReturnNode::createBlock(
 ExecutionNode* ReturnNode::clone(ExecutionPlan* plan, bool withDependencies,
                                  bool withProperties) const {
   auto inVariable = _inVariable;
+  auto rowIdVariable = _rowIdVariable;
 
   if (withProperties) {
     inVariable = plan->getAst()->variables()->createVariable(inVariable);
+    if (rowIdVariable != nullptr) {
+      rowIdVariable = plan->getAst()->variables()->createVariable(rowIdVariable);
+    }
   }
 
   auto c = std::make_unique<ReturnNode>(plan, _id, inVariable);
+  c->rowIdVariable(rowIdVariable);
 
   if (_count) {
     c->setCount();
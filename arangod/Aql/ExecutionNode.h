@@ -147,6 +147,10 @@ class ExecutionNode {
     K_SHORTEST_PATHS = 25,
     REMOTESINGLE = 26,
     ENUMERATE_IRESEARCH_VIEW,
+    HASH_JOIN,
+    MERGE_JOIN,
+    MATERIALIZE,
+    INDEX_COLLECT,
     MAX_NODE_TYPE_VALUE
   };
 
@@ -696,6 +700,9 @@ class EnumerateCollectionNode : public ExecutionNode,
 
   /// @brief getVariablesSetHere
   std::vector<Variable const*> getVariablesSetHere() const override final {
+    if (_docIdVariable != nullptr) {
+      return std::vector<Variable const*>{_outVariable, _docIdVariable};
+    }
     return std::vector<Variable const*>{_outVariable};
   }
 
@@ -708,12 +715,23 @@ class EnumerateCollectionNode : public ExecutionNode,
   /// @brief user hint regarding which index ot use
   IndexHint const& hint() const { return _hint; }
 
+  /// @brief the condition the documents are filtered by while scanning,
+  /// nullptr if there is none. only conditions a ScanFilter supports
+  Expression* filter() const { return _filter.get(); }
+
+  void filter(std::unique_ptr<Expression> filter) {
+    _filter = std::move(filter);
+  }
+
  private:
   /// @brief whether or not we want random iteration
   bool _random;
 
   /// @brief a possible hint from the user regarding which index to use
   IndexHint _hint;
+
+  /// @brief condition pushed into the scan
+  std::unique_ptr<Expression> _filter;
 };
 
 /// @brief class EnumerateListNode
@@ -814,6 +832,9 @@ class LimitNode : public ExecutionNode {
   /// @brief tell the node to fully count what it will limit
   void setFullCount() { _fullCount = true; }
 
+  /// @brief whether or not the node fully counts what it limits
+  bool fullCount() const { return _fullCount; }
+
   /// @brief return the offset value
   size_t offset() const { return _offset; }
 
@@ -918,7 +939,10 @@ class SubqueryNode : public ExecutionNode {
   SubqueryNode(ExecutionPlan*, arangodb::velocypack::Slice const& base);
 
   SubqueryNode(ExecutionPlan* plan, size_t id, ExecutionNode* subquery, Variable const* outVariable)
-      : ExecutionNode(plan, id), _subquery(subquery), _outVariable(outVariable) {
+      : ExecutionNode(plan, id),
+        _subquery(subquery),
+        _outVariable(outVariable),
+        _rowIdVariable(nullptr) {
     TRI_ASSERT(_subquery != nullptr);
     TRI_ASSERT(_outVariable != nullptr);
   }
@@ -972,6 +996,14 @@ class SubqueryNode : public ExecutionNode {
   /// @brief replace the out variable, so we can adjust the name.
   void replaceOutVariable(Variable const* var);
 
+  /// @brief the variable holding the number of the input row inside the
+  /// subquery, if the subquery is executed for a batch of input rows at
+  /// once. nullptr otherwise
+  Variable const* rowIdVariable() const { return _rowIdVariable; }
+
+  /// @brief execute the subquery in batches, see rowIdVariable()
+  void rowIdVariable(Variable const* var) { _rowIdVariable = var; }
+
   bool isDeterministic() override final;
 
   bool isConst();
@@ -983,6 +1015,9 @@ class SubqueryNode : public ExecutionNode {
 
   /// @brief variable to write to
   Variable const* _outVariable;
+
+  /// @brief number of the input row inside a batch, optional
+  Variable const* _rowIdVariable;
 };
 
 /// @brief class FilterNode
@@ -1090,7 +1125,7 @@ class ReturnNode : public ExecutionNode {
   /// @brief constructors for various arguments, always with offset and limit
  public:
   ReturnNode(ExecutionPlan* plan, size_t id, Variable const* inVariable)
-      : ExecutionNode(plan, id), _inVariable(inVariable), _count(false) {
+      : ExecutionNode(plan, id), _inVariable(inVariable), _rowIdVariable(nullptr), _count(false) {
     TRI_ASSERT(_inVariable != nullptr);
   }
 
@@ -1120,16 +1155,28 @@ class ReturnNode : public ExecutionNode {
   /// @brief getVariablesUsedHere, modifying the set in-place
   void getVariablesUsedHere(arangodb::HashSet<Variable const*>& vars) const override final {
     vars.emplace(_inVariable);
+    if (_rowIdVariable != nullptr) {
+      vars.emplace(_rowIdVariable);
+    }
   }
 
   Variable const* inVariable() const { return _inVariable; }
 
   void inVariable(Variable const* v) { _inVariable = v; }
 
+  /// @brief return the input row number of a batched subquery together
+  /// with every result, see SubqueryNode::rowIdVariable()
+  Variable const* rowIdVariable() const { return _rowIdVariable; }
+
+  void rowIdVariable(Variable const* v) { _rowIdVariable = v; }
+
  private:
   /// @brief the variable produced by Return
   Variable const* _inVariable;
 
+  /// @brief input row number of a batched subquery, optional
+  Variable const* _rowIdVariable;
+
   bool _count;
 };
 
@@ -159,6 +159,16 @@ std::unique_ptr<graph::BaseOptions> createTraversalOptions(aql::Query* query,
                 "due to unpredictable results. Use 'path' "
                 "or 'none' instead");
           }
+        } else if (name == "edgeSort" && value->isStringValue()) {
+          options->edgeSortAttribute = value->getString();
+        } else if (name == "edgeSortDescending") {
+          options->edgeSortDescending = value->isTrue();
+        } else if (name == "edgesPerVertex" && value->isNumericValue()) {
+          if (value->getIntValue() < 0) {
+            THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                           "edgesPerVertex must not be negative");
+          }
+          options->edgesPerVertex = static_cast<uint64_t>(value->getIntValue());
         }
       }
     }
@@ -196,6 +206,13 @@ std::unique_ptr<graph::BaseOptions> createShortestPathOptions(arangodb::aql::Que
               std::string(value->getStringValue(), value->getStringLength());
         } else if (name == "defaultWeight" && value->isNumericValue()) {
           options->defaultWeight = value->getDoubleValue();
+        } else if (name == "heuristicAttribute" && value->isStringValue()) {
+          options->heuristicAttribute =
+              std::string(value->getStringValue(), value->getStringLength());
+        } else if (name == "heuristicFactor" && value->isNumericValue()) {
+          options->heuristicFactor = value->getDoubleValue();
+        } else if (name == "maxWeight" && value->isNumericValue()) {
+          options->maxWeight = value->getDoubleValue();
         }
       }
     }
@@ -699,6 +716,8 @@ ModificationOptions ExecutionPlan::parseModificationOptions(AstNode const* node)
           options.nullMeansRemove = value->isFalse();
         } else if (name == "mergeObjects") {
           options.mergeObjects = value->isTrue();
+        } else if (name == "incrementNumbers") {
+          options.incrementNumbers = value->isTrue();
         } else if (name == "exclusive") {
           options.exclusive = value->isTrue();
         } else if (name == "overwrite") {
@@ -2334,7 +2353,9 @@ bool ExecutionPlan::isDeadSimple() const {
 
     if (nodeType == ExecutionNode::SUBQUERY || nodeType == ExecutionNode::ENUMERATE_COLLECTION ||
         nodeType == ExecutionNode::ENUMERATE_LIST || nodeType == ExecutionNode::TRAVERSAL ||
-        nodeType == ExecutionNode::SHORTEST_PATH || nodeType == ExecutionNode::INDEX) {
+        nodeType == ExecutionNode::SHORTEST_PATH || nodeType == ExecutionNode::INDEX ||
+        nodeType == ExecutionNode::HASH_JOIN || nodeType == ExecutionNode::MERGE_JOIN ||
+        nodeType == ExecutionNode::INDEX_COLLECT) {
       // these node types are not simple
       return false;
     }
@@ -56,7 +56,17 @@ void ExecutionStats::toVelocyPack(VPackBuilder& builder, bool reportFullCount) c
       builder.add("id", VPackValue(pair.first));
       builder.add("calls", VPackValue(pair.second.calls));
       builder.add("items", VPackValue(pair.second.items));
+      builder.add("itemsIn", VPackValue(pair.second.itemsIn));
+      builder.add("waiting", VPackValue(pair.second.waiting));
       builder.add("runtime", VPackValue(pair.second.runtime));
+      builder.add("cpuTime", VPackValue(pair.second.cpuTime));
+      builder.add("peakMemoryGrowth", VPackValue(pair.second.peakMemoryGrowth));
+      builder.add("batchSize", VPackValue(pair.second.batchSize));
+      if (!pair.second.storage.empty()) {
+        builder.add("storage", VPackValue(VPackValueType::Object));
+        pair.second.storage.toVelocyPack(builder);
+        builder.close();
+      }
       builder.close();
     }
     builder.close();
@@ -129,12 +139,35 @@ ExecutionStats::ExecutionStats(VPackSlice const& slice) : ExecutionStats() {
 
   // note: node stats are optional
   if (slice.hasKey("nodes")) {
-    ExecutionStats::Node node;
     for (VPackSlice val : VPackArrayIterator(slice.get("nodes"))) {
+      ExecutionStats::Node node;
       size_t nid = val.get("id").getNumber<size_t>();
       node.calls = val.get("calls").getNumber<size_t>();
       node.items = val.get("items").getNumber<size_t>();
       node.runtime = val.get("runtime").getNumber<double>();
+      // the detailed values are optional, servers of older versions do
+      // not send them
+      VPackSlice value = val.get("itemsIn");
+      if (value.isNumber()) {
+        node.itemsIn = value.getNumber<size_t>();
+      }
+      value = val.get("waiting");
+      if (value.isNumber()) {
+        node.waiting = value.getNumber<size_t>();
+      }
+      value = val.get("cpuTime");
+      if (value.isNumber()) {
+        node.cpuTime = value.getNumber<double>();
+      }
+      value = val.get("peakMemoryGrowth");
+      if (value.isNumber()) {
+        node.peakMemoryGrowth = value.getNumber<size_t>();
+      }
+      value = val.get("batchSize");
+      if (value.isNumber()) {
+        node.batchSize = value.getNumber<size_t>();
+      }
+      node.storage = StoragePerfCounters::fromVelocyPack(val.get("storage"));
       nodes.emplace(nid, node);
     }
   }
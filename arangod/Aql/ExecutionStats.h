@@ -25,10 +25,13 @@
 #define ARANGOD_AQL_EXECUTION_STATS_H 1
 
 #include "Basics/Common.h"
+#include "StorageEngine/StoragePerfCounters.h"
 
 #include <velocypack/Builder.h>
 #include <velocypack/Slice.h>
 
+#include <algorithm>
+
 namespace arangodb {
 namespace velocypack {
 class Builder;
@@ -41,15 +44,38 @@ struct ExecutionStats {
   /// @brief instantiate the statistics from VelocyPack
   explicit ExecutionStats(arangodb::velocypack::Slice const& slice);
 
-  /// @brief statistics per ExecutionNode
+  /// @brief statistics per ExecutionNode. times and memory include the
+  /// node's dependencies
   struct Node {
+    /// @brief number of getSome/skipSome calls
     size_t calls = 0;
+    /// @brief number of rows returned
     size_t items = 0;
+    /// @brief number of rows fetched from the dependencies
+    size_t itemsIn = 0;
+    /// @brief number of calls that returned WAITING
+    size_t waiting = 0;
+    /// @brief wall-clock time
     double runtime = 0.0;
+    /// @brief CPU time of the executing threads
+    double cpuTime = 0.0;
+    /// @brief largest increase of the query's memory usage during a single
+    /// call
+    size_t peakMemoryGrowth = 0;
+    /// @brief largest number of rows an output block was created for
+    size_t batchSize = 0;
+    /// @brief storage engine counters of the executing threads
+    StoragePerfCounters storage;
     ExecutionStats::Node& operator+=(ExecutionStats::Node const& other) {
       calls += other.calls;
       items += other.items;
+      itemsIn += other.itemsIn;
+      waiting += other.waiting;
       runtime += other.runtime;
+      cpuTime += other.cpuTime;
+      peakMemoryGrowth = std::max(peakMemoryGrowth, other.peakMemoryGrowth);
+      batchSize = std::max(batchSize, other.batchSize);
+      storage += other.storage;
       return *this;
     }
   };
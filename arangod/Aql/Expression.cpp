@@ -315,7 +315,10 @@ void Expression::initExpression() {
     // a collection enumeration/index enumeration
     auto setter = _plan->getVarSetBy(v->id);
     if (setter != nullptr && (setter->getType() == ExecutionNode::INDEX ||
-                              setter->getType() == ExecutionNode::ENUMERATE_COLLECTION)) {
+                              setter->getType() == ExecutionNode::ENUMERATE_COLLECTION ||
+                              setter->getType() == ExecutionNode::HASH_JOIN ||
+                              setter->getType() == ExecutionNode::MERGE_JOIN ||
+                              setter->getType() == ExecutionNode::MATERIALIZE)) {
       // it is
       dataIsFromCollection = true;
     }
@@ -48,6 +48,7 @@
 #include "Geo/GeoParams.h"
 #include "Geo/GeoUtils.h"
 #include "Geo/ShapeContainer.h"
+#include "Graph/AnalyticsGraph.h"
 #include "Indexes/Index.h"
 #include "Logger/Logger.h"
 #include "Pregel/Conductor.h"
@@ -879,6 +880,70 @@ void getDocumentByIdentifier(transaction::Methods* trx, std::string& collectionN
   }
 }
 
+/// @brief append the documents for an array of identifiers (keys or ids) to
+/// the open array in result, in the order of the identifiers. identifiers
+/// that are not strings, refer to other collections or do not exist are
+/// left out. if collectionName is empty, it is taken from the first id.
+/// all documents are looked up in one batch. returns false without
+/// appending anything if the identifiers refer to multiple collections
+bool getDocumentsByIdentifiers(transaction::Methods* trx, std::string collectionName,
+                               VPackSlice identifiers, VPackBuilder& result) {
+  bool const fixedCollection = !collectionName.empty();
+  transaction::BuilderLeaser keys(trx);
+  keys->openArray();
+  for (VPackSlice next : VPackArrayIterator(identifiers)) {
+    if (!next.isString()) {
+      continue;
+    }
+    arangodb::velocypack::StringRef identifier(next);
+    size_t pos = identifier.find('/');
+    if (pos == std::string::npos) {
+      if (!fixedCollection) {
+        // a key without a collection
+        continue;
+      }
+      keys->add(next);
+      continue;
+    }
+    arangodb::velocypack::StringRef name = identifier.substr(0, pos);
+    if (collectionName.empty()) {
+      collectionName = name.toString();
+    } else if (name != collectionName) {
+      if (!fixedCollection) {
+        return false;
+      }
+      // requesting an _id that cannot be stored in this collection
+      continue;
+    }
+    keys->add(VPackValuePair(identifier.data() + pos + 1, identifier.size() - pos - 1,
+                             VPackValueType::String));
+  }
+  keys->close();
+
+  if (keys->slice().isEmptyArray()) {
+    return true;
+  }
+
+  Result res;
+  try {
+    res = trx->documentsFastPath(collectionName, keys->slice(), result);
+  } catch (arangodb::basics::Exception const& ex) {
+    res.reset(ex.code());
+  }
+
+  if (res.fail() && !res.is(TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND)) {
+    if (res.is(TRI_ERROR_TRANSACTION_UNREGISTERED_COLLECTION)) {
+      // special error message to indicate which collection was undeclared
+      THROW_ARANGO_EXCEPTION_MESSAGE(res.errorNumber(),
+                                     res.errorMessage() + ": " + collectionName +
+                                         " [" + AccessMode::typeString(AccessMode::Type::READ) +
+                                         "]");
+    }
+    THROW_ARANGO_EXCEPTION(res);
+  }
+  return true;
+}
+
 /// @brief Helper function to merge given parameters
 ///        Works for an array of objects as first parameter or arbitrary many
 ///        object parameters
@@ -1276,6 +1341,150 @@ static Result parseGeoPolygon(VPackSlice polygon, VPackBuilder& b) {
   return {TRI_ERROR_NO_ERROR};
 }
 
+/// @brief decode an array of numbers into a contiguous buffer, so that the
+/// array aggregate functions can reduce plain doubles instead of comparing
+/// VelocyPack values with full type dispatch. nulls are skipped, the
+/// positions of the numbers in the array are returned in positions.
+/// returns false if the array contains anything but numbers and nulls, or
+/// numbers whose double value does not compare exactly like the original
+/// (NaN and integers beyond 2^53)
+bool decodeNumericArray(VPackSlice array, std::vector<double>& numbers,
+                        std::vector<size_t>& positions, bool& hasNull) {
+  static constexpr double maxExactInteger = 9007199254740992.0;  // 2^53
+
+  VPackArrayIterator it(array);
+  numbers.reserve(it.size());
+  positions.reserve(it.size());
+  hasNull = false;
+  for (; it.valid(); it.next()) {
+    VPackSlice value = it.value();
+    double number;
+    switch (value.type()) {
+      case VPackValueType::Null:
+        hasNull = true;
+        continue;
+      case VPackValueType::SmallInt:
+        number = static_cast<double>(value.getSmallIntUnchecked());
+        break;
+      case VPackValueType::Int: {
+        int64_t v = value.getIntUnchecked();
+        if (v > static_cast<int64_t>(maxExactInteger) ||
+            v < -static_cast<int64_t>(maxExactInteger)) {
+          return false;
+        }
+        number = static_cast<double>(v);
+        break;
+      }
+      case VPackValueType::UInt: {
+        uint64_t v = value.getUIntUnchecked();
+        if (v > static_cast<uint64_t>(maxExactInteger)) {
+          return false;
+        }
+        number = static_cast<double>(v);
+        break;
+      }
+      case VPackValueType::Double:
+        number = value.getDouble();
+        if (std::isnan(number)) {
+          return false;
+        }
+        break;
+      default:
+        return false;
+    }
+    numbers.emplace_back(number);
+    positions.emplace_back(it.index());
+  }
+  return true;
+}
+
+/// @brief position of the first smallest (or largest) value in the buffer.
+/// the extreme value is reduced in independent lanes first, which the
+/// compiler can vectorize, and its first occurrence is searched afterwards
+template <bool isMin>
+size_t extremePosition(double const* values, size_t n) {
+  TRI_ASSERT(n > 0);
+  static constexpr size_t lanes = 4;
+  double extreme[lanes];
+  for (size_t l = 0; l < lanes; ++l) {
+    extreme[l] = values[0];
+  }
+  size_t i = 0;
+  for (; i + lanes <= n; i += lanes) {
+    for (size_t l = 0; l < lanes; ++l) {
+      double v = values[i + l];
+      extreme[l] = (isMin ? v < extreme[l] : v > extreme[l]) ? v : extreme[l];
+    }
+  }
+  for (; i < n; ++i) {
+    double v = values[i];
+    extreme[0] = (isMin ? v < extreme[0] : v > extreme[0]) ? v : extreme[0];
+  }
+  double result = extreme[0];
+  for (size_t l = 1; l < lanes; ++l) {
+    result = (isMin ? extreme[l] < result : extreme[l] > result) ? extreme[l] : result;
+  }
+
+  for (i = 0; i < n; ++i) {
+    if (values[i] == result) {
+      return i;
+    }
+  }
+  TRI_ASSERT(false);
+  return 0;
+}
+
+/// @brief MIN and MAX for arrays of numbers
+template <bool isMin>
+bool numericExtreme(VPackSlice array, AqlValue& result) {
+  std::vector<double> numbers;
+  std::vector<size_t> positions;
+  bool hasNull;
+  if (!::decodeNumericArray(array, numbers, positions, hasNull)) {
+    return false;
+  }
+  if (numbers.empty()) {
+    result = AqlValue(AqlValueHintNull());
+  } else {
+    size_t pos = ::extremePosition<isMin>(numbers.data(), numbers.size());
+    result = AqlValue(array.at(positions[pos]));
+  }
+  return true;
+}
+
+/// @brief loads the edge collection passed to a graph analytics function
+void loadAnalyticsGraph(transaction::Methods* trx, AqlValue const& collection,
+                        char const* AFN, graph::AnalyticsGraph& graph) {
+  if (ServerState::instance()->isCoordinator()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CLUSTER_UNSUPPORTED,
+                                   std::string(AFN) +
+                                       " is not supported in a cluster, use "
+                                       "Pregel instead");
+  }
+  if (!collection.isString()) {
+    THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, AFN);
+  }
+  graph.load(trx, collection.slice().copyString());
+  graph.finish();
+}
+
+/// @brief the result of a graph analytics function, an array with the
+/// _id and the value of each vertex
+template <typename F>
+AqlValue analyticsResult(transaction::Methods* trx,
+                         graph::AnalyticsGraph const& graph, F const& value) {
+  transaction::BuilderLeaser builder(trx);
+  builder->openArray();
+  for (graph::AnalyticsGraph::VertexId v = 0; v < graph.numVertices(); ++v) {
+    builder->openObject();
+    builder->add(StaticStrings::IdString, VPackValue(graph.vertex(v)));
+    builder->add("value", value(v));
+    builder->close();
+  }
+  builder->close();
+  return AqlValue(builder->slice());
+}
+
 }  // namespace
 
 /// @brief append the VelocyPack value to a string buffer
@@ -2579,11 +2788,30 @@ AqlValue Functions::Like(ExpressionContext* expressionContext, transaction::Meth
   static char const* AFN = "LIKE";
 
   bool const caseInsensitive = ::getBooleanParameter(trx, parameters, 2, false);
+  AqlValue const& regex = extractFunctionParameterValue(parameters, 1);
+
+  if (!caseInsensitive) {
+    AqlValue const& value = extractFunctionParameterValue(parameters, 0);
+    if (regex.isString() && value.isString()) {
+      // try matching ASCII patterns without ICU first
+      VPackValueLength patternLength;
+      char const* pattern = regex.slice().getStringUnchecked(patternLength);
+      VPackValueLength valueLength;
+      char const* v = value.slice().getStringUnchecked(valueLength);
+
+      bool handled;
+      bool const result = RegexCache::matchesLikePattern(pattern, patternLength, v,
+                                                         valueLength, handled);
+      if (handled) {
+        return AqlValue(AqlValueHintBool(result));
+      }
+    }
+  }
+
   transaction::StringBufferLeaser buffer(trx);
   arangodb::basics::VPackStringBufferAdapter adapter(buffer->stringBuffer());
 
   // build pattern from parameter #1
-  AqlValue const& regex = extractFunctionParameterValue(parameters, 1);
   ::appendAsString(trx, adapter, regex);
 
   // the matcher is owned by the context!
@@ -3917,6 +4145,11 @@ AqlValue Functions::Min(ExpressionContext* expressionContext, transaction::Metho
   AqlValueMaterializer materializer(trx);
   VPackSlice slice = materializer.slice(value, false);
 
+  AqlValue result;
+  if (::numericExtreme<true>(slice, result)) {
+    return result;
+  }
+
   VPackSlice minValue;
   auto options = trx->transactionContextPtr()->getVPackOptions();
   for (auto const& it : VPackArrayIterator(slice)) {
@@ -3947,6 +4180,12 @@ AqlValue Functions::Max(ExpressionContext* expressionContext, transaction::Metho
 
   AqlValueMaterializer materializer(trx);
   VPackSlice slice = materializer.slice(value, false);
+
+  AqlValue result;
+  if (::numericExtreme<false>(slice, result)) {
+    return result;
+  }
+
   VPackSlice maxValue;
   auto options = trx->transactionContextPtr()->getVPackOptions();
   for (auto const& it : VPackArrayIterator(slice)) {
@@ -4262,6 +4501,20 @@ AqlValue Functions::CountDistinct(ExpressionContext* expressionContext,
   AqlValueMaterializer materializer(trx);
   VPackSlice slice = materializer.slice(value, false);
 
+  {
+    // numbers only: count the distinct values of the sorted numbers, which
+    // is cheaper than hashing VelocyPack values
+    std::vector<double> numbers;
+    std::vector<size_t> positions;
+    bool hasNull;
+    if (::decodeNumericArray(slice, numbers, positions, hasNull)) {
+      std::sort(numbers.begin(), numbers.end());
+      // 0.0 and -0.0 are equal, so they are merged here, too
+      size_t count = std::unique(numbers.begin(), numbers.end()) - numbers.begin();
+      return AqlValue(AqlValueHintUInt(count + (hasNull ? 1 : 0)));
+    }
+  }
+
   auto options = trx->transactionContextPtr()->getVPackOptions();
   std::unordered_set<VPackSlice, arangodb::basics::VelocyPackHelper::VPackHash, arangodb::basics::VelocyPackHelper::VPackEqual>
       values(512, arangodb::basics::VelocyPackHelper::VPackHash(),
@@ -5481,11 +5734,14 @@ AqlValue Functions::Document(ExpressionContext* expressionContext, transaction::
       AqlValueMaterializer materializer(trx);
       VPackSlice idSlice = materializer.slice(id, false);
       builder->openArray();
-      for (auto const& next : VPackArrayIterator(idSlice)) {
-        if (next.isString()) {
-          std::string identifier = next.copyString();
-          std::string colName;
-          ::getDocumentByIdentifier(trx, colName, identifier, true, *builder.get());
+      if (!::getDocumentsByIdentifiers(trx, "", idSlice, *builder.get())) {
+        // ids of different collections, look them up one by one
+        for (auto const& next : VPackArrayIterator(idSlice)) {
+          if (next.isString()) {
+            std::string identifier = next.copyString();
+            std::string colName;
+            ::getDocumentByIdentifier(trx, colName, identifier, true, *builder.get());
+          }
         }
       }
       builder->close();
@@ -5518,13 +5774,8 @@ AqlValue Functions::Document(ExpressionContext* expressionContext, transaction::
 
     AqlValueMaterializer materializer(trx);
     VPackSlice idSlice = materializer.slice(id, false);
-    for (auto const& next : VPackArrayIterator(idSlice)) {
-      if (next.isString()) {
-        std::string identifier(next.copyString());
-        ::getDocumentByIdentifier(trx, collectionName, identifier, true,
-                                  *builder.get());
-      }
-    }
+    // with a given collection, all documents are looked up in one batch
+    ::getDocumentsByIdentifiers(trx, collectionName, idSlice, *builder.get());
 
     builder->close();
     return AqlValue(builder.get());
@@ -6752,6 +7003,95 @@ AqlValue Functions::PregelResult(ExpressionContext* expressionContext,
   return val;
 }
 
+/// @brief function GRAPH_PAGERANK
+AqlValue Functions::GraphPageRank(ExpressionContext*, transaction::Methods* trx,
+                                  VPackFunctionParameters const& parameters) {
+  static char const* AFN = "GRAPH_PAGERANK";
+
+  graph::AnalyticsGraph graph;
+  ::loadAnalyticsGraph(trx, extractFunctionParameterValue(parameters, 0), AFN, graph);
+
+  double dampingFactor = 0.85;
+  double threshold = 0.00001;
+  size_t maxIterations = 100;
+  AqlValue const& options = extractFunctionParameterValue(parameters, 1);
+  if (options.isObject()) {
+    VPackSlice slice = options.slice();
+    dampingFactor = basics::VelocyPackHelper::getNumericValue<double>(
+        slice, "dampingFactor", dampingFactor);
+    threshold = basics::VelocyPackHelper::getNumericValue<double>(slice, "threshold", threshold);
+    maxIterations = basics::VelocyPackHelper::getNumericValue<size_t>(
+        slice, "maxIterations", maxIterations);
+  } else if (!options.isNone() && !options.isNull(false)) {
+    THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, AFN);
+  }
+  if (dampingFactor < 0.0 || dampingFactor > 1.0) {
+    THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, AFN);
+  }
+
+  std::vector<double> ranks = graph.pageRank(dampingFactor, threshold, maxIterations);
+  return ::analyticsResult(trx, graph, [&ranks](graph::AnalyticsGraph::VertexId v) {
+    return VPackValue(ranks[v]);
+  });
+}
+
+/// @brief function GRAPH_CONNECTED_COMPONENTS
+AqlValue Functions::GraphConnectedComponents(ExpressionContext*, transaction::Methods* trx,
+                                             VPackFunctionParameters const& parameters) {
+  static char const* AFN = "GRAPH_CONNECTED_COMPONENTS";
+
+  graph::AnalyticsGraph graph;
+  ::loadAnalyticsGraph(trx, extractFunctionParameterValue(parameters, 0), AFN, graph);
+
+  std::vector<graph::AnalyticsGraph::VertexId> components = graph.connectedComponents();
+  return ::analyticsResult(trx, graph, [&](graph::AnalyticsGraph::VertexId v) {
+    return VPackValue(graph.vertex(components[v]));
+  });
+}
+
+/// @brief function GRAPH_DEGREE_CENTRALITY
+AqlValue Functions::GraphDegreeCentrality(ExpressionContext*, transaction::Methods* trx,
+                                          VPackFunctionParameters const& parameters) {
+  static char const* AFN = "GRAPH_DEGREE_CENTRALITY";
+
+  graph::AnalyticsGraph graph;
+  ::loadAnalyticsGraph(trx, extractFunctionParameterValue(parameters, 0), AFN, graph);
+
+  TRI_edge_direction_e direction = TRI_EDGE_ANY;
+  AqlValue const& value = extractFunctionParameterValue(parameters, 1);
+  if (value.isString()) {
+    std::string const d = basics::StringUtils::tolower(value.slice().copyString());
+    if (d == "outbound") {
+      direction = TRI_EDGE_OUT;
+    } else if (d == "inbound") {
+      direction = TRI_EDGE_IN;
+    } else if (d != "any") {
+      THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, AFN);
+    }
+  } else if (!value.isNone() && !value.isNull(false)) {
+    THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, AFN);
+  }
+
+  std::vector<double> centrality = graph.degreeCentrality(direction);
+  return ::analyticsResult(trx, graph, [&centrality](graph::AnalyticsGraph::VertexId v) {
+    return VPackValue(centrality[v]);
+  });
+}
+
+/// @brief function GRAPH_TRIANGLE_COUNT
+AqlValue Functions::GraphTriangleCount(ExpressionContext*, transaction::Methods* trx,
+                                       VPackFunctionParameters const& parameters) {
+  static char const* AFN = "GRAPH_TRIANGLE_COUNT";
+
+  graph::AnalyticsGraph graph;
+  ::loadAnalyticsGraph(trx, extractFunctionParameterValue(parameters, 0), AFN, graph);
+
+  std::vector<uint64_t> triangles = graph.triangleCount();
+  return ::analyticsResult(trx, graph, [&triangles](graph::AnalyticsGraph::VertexId v) {
+    return VPackValue(triangles[v]);
+  });
+}
+
 AqlValue Functions::Assert(ExpressionContext* expressionContext, transaction::Methods* trx,
                            VPackFunctionParameters const& parameters) {
   static char const* AFN = "ASSERT";
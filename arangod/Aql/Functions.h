@@ -413,6 +413,15 @@ struct Functions {
                                  transaction::Methods*, VPackFunctionParameters const&);
   static AqlValue PregelResult(arangodb::aql::ExpressionContext*,
                                transaction::Methods*, VPackFunctionParameters const&);
+  static AqlValue GraphPageRank(arangodb::aql::ExpressionContext*,
+                                transaction::Methods*, VPackFunctionParameters const&);
+  static AqlValue GraphConnectedComponents(arangodb::aql::ExpressionContext*,
+                                           transaction::Methods*,
+                                           VPackFunctionParameters const&);
+  static AqlValue GraphDegreeCentrality(arangodb::aql::ExpressionContext*,
+                                        transaction::Methods*, VPackFunctionParameters const&);
+  static AqlValue GraphTriangleCount(arangodb::aql::ExpressionContext*,
+                                     transaction::Methods*, VPackFunctionParameters const&);
   static AqlValue VariancePopulation(arangodb::aql::ExpressionContext*,
                                      transaction::Methods*,
                                      VPackFunctionParameters const&);
@@ -0,0 +1,267 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "HashJoinExecutor.h"
+
+#include "Aql/Collection.h"
+#include "Aql/ExecutionEngine.h"
+#include "Aql/OutputAqlItemRow.h"
+#include "Aql/Query.h"
+#include "Aql/ResourceUsage.h"
+#include "Aql/SingleRowFetcher.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Transaction/Context.h"
+#include "Transaction/Methods.h"
+
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+/// @brief estimated memory usage of a hash table entry, on top of the
+/// document itself
+constexpr size_t entryOverhead = 64;
+
+/// @brief number of documents read from the collection at once
+constexpr uint64_t buildBatchSize = 1000;
+}  // namespace
+
+HashJoinExecutorInfos::HashJoinExecutorInfos(
+    RegisterId inputRegister, RegisterId outputRegister, RegisterId nrInputRegisters,
+    RegisterId nrOutputRegisters,
+    // cppcheck-suppress passedByValue
+    std::unordered_set<RegisterId> registersToClear,
+    // cppcheck-suppress passedByValue
+    std::unordered_set<RegisterId> registersToKeep, ExecutionEngine* engine,
+    Collection const* collection, std::vector<std::string> const& attribute,
+    transaction::Methods* trxPtr, std::size_t memoryBudget)
+    : ExecutorInfos(make_shared_unordered_set({inputRegister}),
+                    make_shared_unordered_set({outputRegister}),
+                    nrInputRegisters, nrOutputRegisters,
+                    std::move(registersToClear), std::move(registersToKeep)),
+      _inputRegisterId(inputRegister),
+      _outputRegisterId(outputRegister),
+      _engine(engine),
+      _collection(collection),
+      _attribute(attribute),
+      _trxPtr(trxPtr),
+      _memoryBudget(memoryBudget) {
+  TRI_ASSERT(!_attribute.empty());
+}
+
+size_t HashJoinExecutor::KeyHash::operator()(VPackSlice const& value) const {
+  return static_cast<size_t>(value.normalizedHash());
+}
+
+bool HashJoinExecutor::KeyEqual::operator()(VPackSlice const& lhs, VPackSlice const& rhs) const {
+  return basics::VelocyPackHelper::compare(lhs, rhs, false, options) == 0;
+}
+
+HashJoinExecutor::HashJoinExecutor(Fetcher& fetcher, Infos& infos)
+    : _infos(infos),
+      _fetcher(fetcher),
+      _state(ExecutionState::HASMORE),
+      _input(InputAqlItemRow{CreateInvalidInputRowHint{}}),
+      _cursorHasMore(false),
+      _tableBuilt(false),
+      _useFallback(false),
+      _table(0, KeyHash(),
+             KeyEqual{_infos.getTrxPtr()->transactionContextPtr()->getVPackOptions()}),
+      _memoryUsage(0),
+      _matches(nullptr),
+      _matchPosition(0) {
+  _cursor = std::make_unique<OperationCursor>(
+      _infos.getTrxPtr()->indexScan(_infos.getCollection()->name(),
+                                    transaction::Methods::CursorType::ALL));
+}
+
+HashJoinExecutor::~HashJoinExecutor() { clearTable(); }
+
+void HashJoinExecutor::initializeCursor() {
+  // the hash table only depends on the collection, so we keep it
+  _state = ExecutionState::HASMORE;
+  _input = InputAqlItemRow{CreateInvalidInputRowHint{}};
+  _cursorHasMore = false;
+  _matches = nullptr;
+  _matchPosition = 0;
+}
+
+std::pair<ExecutionState, HashJoinExecutor::Stats> HashJoinExecutor::produceRows(OutputAqlItemRow& output) {
+  TRI_IF_FAILURE("HashJoinExecutor::produceRows") {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  }
+  Stats stats{};
+
+  if (!_tableBuilt) {
+    buildTable(stats);
+  }
+
+  while (!output.isFull()) {
+    if (_useFallback && _cursorHasMore) {
+      scanForMatches(output, stats);
+      continue;
+    }
+
+    if (_matches != nullptr && _matchPosition < _matches->size()) {
+      writeMatch(output, (*_matches)[_matchPosition]);
+      ++_matchPosition;
+      continue;
+    }
+
+    _matches = nullptr;
+    std::tie(_state, _input) = _fetcher.fetchRow();
+
+    if (_state == ExecutionState::WAITING) {
+      return {_state, stats};
+    }
+
+    if (!_input) {
+      TRI_ASSERT(_state == ExecutionState::DONE);
+      return {_state, stats};
+    }
+
+    AqlValue const& value = _input.getValue(_infos.getInputRegisterId());
+    AqlValueMaterializer materializer(_infos.getTrxPtr());
+    VPackSlice probe = materializer.slice(value, true);
+
+    if (_useFallback) {
+      _probe.clear();
+      _probe.add(probe);
+      _cursor->reset();
+      _cursorHasMore = _cursor->hasMore();
+      continue;
+    }
+
+    auto it = _table.find(probe);
+    if (it != _table.end()) {
+      _matches = &(*it).second;
+      _matchPosition = 0;
+    }
+  }
+
+  if (_state == ExecutionState::DONE && !_cursorHasMore &&
+      (_matches == nullptr || _matchPosition >= _matches->size())) {
+    return {ExecutionState::DONE, stats};
+  }
+  return {ExecutionState::HASMORE, stats};
+}
+
+void HashJoinExecutor::buildTable(Stats& stats) {
+  TRI_ASSERT(!_tableBuilt);
+  TRI_ASSERT(_documents.empty());
+  ResourceMonitor* monitor = _infos.getEngine()->getQuery()->resourceMonitor();
+  size_t const budget = _infos.getMemoryBudget();
+  bool exceeded = false;
+
+  _cursor->reset();
+  bool hasMore = _cursor->hasMore();
+  while (hasMore && !exceeded) {
+    hasMore = _cursor->nextDocument(
+        [&](LocalDocumentId const&, VPackSlice document) {
+          if (exceeded) {
+            return;
+          }
+          stats.incrScanned(1);
+
+          AqlValue value{AqlValueHintCopy{document.begin()}};
+          AqlValueGuard guard{value, true};
+          size_t const memory = value.memoryUsage() + ::entryOverhead;
+          monitor->increaseMemoryUsage(memory);
+          _memoryUsage += memory;
+
+          _documents.emplace_back(value);
+          guard.steal();
+          // the slice points into the copy, which stays valid until the
+          // table is cleared
+          _table[joinValue(_documents.back().slice())].emplace_back(_documents.size() - 1);
+
+          if (budget > 0 && _memoryUsage > budget) {
+            exceeded = true;
+          }
+        },
+        ::buildBatchSize);
+  }
+
+  if (exceeded) {
+    // too big for memory. give up on the table, and compare every document
+    // with every input row instead
+    clearTable();
+    _useFallback = true;
+  }
+  _tableBuilt = true;
+}
+
+void HashJoinExecutor::clearTable() {
+  _table.clear();
+  for (auto& it : _documents) {
+    it.destroy();
+  }
+  _documents.clear();
+  _matches = nullptr;
+  _matchPosition = 0;
+  if (_memoryUsage > 0) {
+    _infos.getEngine()->getQuery()->resourceMonitor()->decreaseMemoryUsage(_memoryUsage);
+    _memoryUsage = 0;
+  }
+}
+
+VPackSlice HashJoinExecutor::joinValue(VPackSlice document) const {
+  VPackSlice value = document.get(_infos.getAttribute());
+  if (value.isNone()) {
+    return VPackSlice::nullSlice();
+  }
+  return value;
+}
+
+void HashJoinExecutor::scanForMatches(OutputAqlItemRow& output, Stats& stats) {
+  TRI_ASSERT(_useFallback);
+  TRI_ASSERT(_input.isInitialized());
+  VPackSlice probe = _probe.slice();
+  KeyEqual const& equal = _table.key_eq();
+  RegisterId const registerId = _infos.getOutputRegisterId();
+
+  // at most one result per scanned document, so this cannot overflow the
+  // output
+  _cursorHasMore = _cursor->nextDocument(
+      [&](LocalDocumentId const&, VPackSlice document) {
+        stats.incrScanned(1);
+        if (!equal(joinValue(document), probe)) {
+          return;
+        }
+        AqlValue v{AqlValueHintCopy{document.begin()}};
+        AqlValueGuard guard{v, true};
+        TRI_ASSERT(!output.isFull());
+        output.moveValueInto(registerId, _input, guard);
+        TRI_ASSERT(output.produced());
+        output.advanceRow();
+      },
+      output.numRowsLeft() /*atMost*/);
+}
+
+void HashJoinExecutor::writeMatch(OutputAqlItemRow& output, size_t position) {
+  TRI_ASSERT(position < _documents.size());
+  AqlValue v{AqlValueHintCopy{_documents[position].slice().begin()}};
+  AqlValueGuard guard{v, true};
+  TRI_ASSERT(!output.isFull());
+  output.moveValueInto(_infos.getOutputRegisterId(), _input, guard);
+  TRI_ASSERT(output.produced());
+  output.advanceRow();
+}
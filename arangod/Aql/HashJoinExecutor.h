@@ -0,0 +1,196 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_HASH_JOIN_EXECUTOR_H
+#define ARANGOD_AQL_HASH_JOIN_EXECUTOR_H
+
+#include "Aql/AqlValue.h"
+#include "Aql/ExecutionState.h"
+#include "Aql/ExecutorInfos.h"
+#include "Aql/InputAqlItemRow.h"
+#include "Aql/Stats.h"
+#include "Aql/types.h"
+#include "Utils/OperationCursor.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <deque>
+#include <memory>
+#include <unordered_map>
+
+namespace arangodb {
+namespace transaction {
+class Methods;
+}
+
+namespace aql {
+
+struct Collection;
+class ExecutionEngine;
+class OutputAqlItemRow;
+
+template <bool>
+class SingleRowFetcher;
+
+class HashJoinExecutorInfos : public ExecutorInfos {
+ public:
+  HashJoinExecutorInfos(RegisterId inputRegister, RegisterId outputRegister,
+                        RegisterId nrInputRegisters, RegisterId nrOutputRegisters,
+                        std::unordered_set<RegisterId> registersToClear,
+                        std::unordered_set<RegisterId> registersToKeep,
+                        ExecutionEngine* engine, Collection const* collection,
+                        std::vector<std::string> const& attribute,
+                        transaction::Methods* trxPtr, std::size_t memoryBudget);
+
+  HashJoinExecutorInfos() = delete;
+  HashJoinExecutorInfos(HashJoinExecutorInfos&&) = default;
+  HashJoinExecutorInfos(HashJoinExecutorInfos const&) = delete;
+  ~HashJoinExecutorInfos() = default;
+
+  ExecutionEngine* getEngine() const { return _engine; }
+  Collection const* getCollection() const { return _collection; }
+  std::vector<std::string> const& getAttribute() const { return _attribute; }
+  transaction::Methods* getTrxPtr() const { return _trxPtr; }
+  RegisterId getInputRegisterId() const { return _inputRegisterId; }
+  RegisterId getOutputRegisterId() const { return _outputRegisterId; }
+  /// @brief maximum size of the hash table, 0 means unlimited
+  std::size_t getMemoryBudget() const { return _memoryBudget; }
+
+ private:
+  RegisterId _inputRegisterId;
+  RegisterId _outputRegisterId;
+  ExecutionEngine* _engine;
+  Collection const* _collection;
+  std::vector<std::string> _attribute;
+  transaction::Methods* _trxPtr;
+  std::size_t _memoryBudget;
+};
+
+/**
+ * @brief Implementation of HashJoin Node
+ *
+ * On the first call, all documents of the collection are read into a hash
+ * table keyed by the join attribute. Every input row then looks up its probe
+ * value in the table, and produces one output row per matching document.
+ * The table survives initializeCursor(), so it is built only once even if
+ * the join is executed inside a subquery.
+ * If the table would exceed the memory budget, it is dropped again, and the
+ * executor falls back to scanning the collection for every input row.
+ */
+class HashJoinExecutor {
+ public:
+  struct Properties {
+    static const bool preservesOrder = true;
+    static const bool allowsBlockPassthrough = false;
+    static const bool inputSizeRestrictsOutputSize = false;
+  };
+  using Fetcher = SingleRowFetcher<Properties::allowsBlockPassthrough>;
+  using Infos = HashJoinExecutorInfos;
+  using Stats = EnumerateCollectionStats;
+
+  HashJoinExecutor() = delete;
+  HashJoinExecutor(HashJoinExecutor&&) = default;
+  HashJoinExecutor(HashJoinExecutor const&) = delete;
+  HashJoinExecutor(Fetcher& fetcher, Infos&);
+  ~HashJoinExecutor();
+
+  /**
+   * @brief produce the next Rows of Aql Values.
+   *
+   * @return ExecutionState, and if successful at least one new Row of AqlItems.
+   */
+  std::pair<ExecutionState, Stats> produceRows(OutputAqlItemRow& output);
+
+  inline std::pair<ExecutionState, size_t> expectedNumberOfRows(size_t) const {
+    TRI_ASSERT(false);
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_INTERNAL,
+        "Logic_error, prefetching number fo rows not supported");
+  }
+
+  void initializeCursor();
+
+ private:
+  /// @brief hash and equality for join values, following the semantics of
+  /// AQL's == operator
+  struct KeyHash {
+    size_t operator()(arangodb::velocypack::Slice const& value) const;
+  };
+  struct KeyEqual {
+    arangodb::velocypack::Options const* options;
+    bool operator()(arangodb::velocypack::Slice const& lhs,
+                    arangodb::velocypack::Slice const& rhs) const;
+  };
+
+  using Table = std::unordered_map<arangodb::velocypack::Slice, std::vector<size_t>, KeyHash, KeyEqual>;
+
+  /// @brief read all documents of the collection into the hash table, or
+  /// switch to the fallback if it would exceed the memory budget
+  void buildTable(Stats& stats);
+
+  /// @brief release the hash table and its memory
+  void clearTable();
+
+  /// @brief extract the join attribute from a document, returns a null
+  /// slice if it is not present
+  arangodb::velocypack::Slice joinValue(arangodb::velocypack::Slice document) const;
+
+  /// @brief fallback: scan the collection for the current input row and
+  /// produce rows for all matching documents
+  void scanForMatches(OutputAqlItemRow& output, Stats& stats);
+
+  /// @brief write the matching document at position into the output
+  void writeMatch(OutputAqlItemRow& output, size_t position);
+
+ private:
+  Infos& _infos;
+  Fetcher& _fetcher;
+  ExecutionState _state;
+  InputAqlItemRow _input;
+
+  std::unique_ptr<OperationCursor> _cursor;
+  bool _cursorHasMore;
+
+  /// @brief whether or not the hash table was built (or given up on)
+  bool _tableBuilt;
+  /// @brief whether the table exceeded the memory budget, and the executor
+  /// scans the collection per row instead
+  bool _useFallback;
+
+  /// @brief copies of all documents in the collection. this is a deque so
+  /// the table's slices into inlined values are not invalidated by growing
+  std::deque<AqlValue> _documents;
+  Table _table;
+  /// @brief memory accounted for the table in the query's ResourceMonitor
+  size_t _memoryUsage;
+
+  /// @brief matches of the current input row, and the next one to return
+  std::vector<size_t> const* _matches;
+  size_t _matchPosition;
+
+  /// @brief the probe value of the current input row, for the fallback
+  arangodb::velocypack::Builder _probe;
+};
+
+}  // namespace aql
+}  // namespace arangodb
+
+#endif
@@ -0,0 +1,144 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "HashJoinNode.h"
+#include "Aql/Ast.h"
+#include "Aql/Collection.h"
+#include "Aql/ExecutionBlockImpl.h"
+#include "Aql/ExecutionPlan.h"
+#include "Aql/HashJoinExecutor.h"
+#include "Aql/Query.h"
+#include "Aql/Variable.h"
+#include "Transaction/Methods.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+HashJoinNode::HashJoinNode(ExecutionPlan* plan, size_t id, aql::Collection const* collection,
+                           Variable const* outVariable, Variable const* keyVariable,
+                           std::vector<std::string> const& attribute)
+    : ExecutionNode(plan, id),
+      DocumentProducingNode(outVariable),
+      CollectionAccessingNode(collection),
+      _keyVariable(keyVariable),
+      _attribute(attribute) {
+  TRI_ASSERT(_keyVariable != nullptr);
+  TRI_ASSERT(!_attribute.empty());
+}
+
+HashJoinNode::HashJoinNode(ExecutionPlan* plan, arangodb::velocypack::Slice const& base)
+    : ExecutionNode(plan, base),
+      DocumentProducingNode(plan, base),
+      CollectionAccessingNode(plan, base),
+      _keyVariable(Variable::varFromVPack(plan->getAst(), base, "keyVariable")) {
+  VPackSlice attribute = base.get("attribute");
+  if (!attribute.isArray() || attribute.length() == 0) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                   "\"attribute\" must be a non-empty array");
+  }
+  for (auto const& it : VPackArrayIterator(attribute)) {
+    _attribute.emplace_back(it.copyString());
+  }
+}
+
+/// @brief toVelocyPack, for HashJoinNode
+void HashJoinNode::toVelocyPackHelper(VPackBuilder& builder, unsigned flags) const {
+  // call base class method
+  ExecutionNode::toVelocyPackHelperGeneric(builder, flags);
+
+  builder.add(VPackValue("keyVariable"));
+  _keyVariable->toVelocyPack(builder);
+
+  builder.add(VPackValue("attribute"));
+  builder.openArray();
+  for (auto const& it : _attribute) {
+    builder.add(VPackValue(it));
+  }
+  builder.close();
+
+  // add outvariable and projections
+  DocumentProducingNode::toVelocyPack(builder);
+
+  // add collection information
+  CollectionAccessingNode::toVelocyPack(builder);
+
+  // And close it:
+  builder.close();
+}
+
+/// @brief creates corresponding ExecutionBlock
+std::unique_ptr<ExecutionBlock> HashJoinNode::createBlock(
+    ExecutionEngine& engine, std::unordered_map<ExecutionNode*, ExecutionBlock*> const&) const {
+  ExecutionNode const* previousNode = getFirstDependency();
+  TRI_ASSERT(previousNode != nullptr);
+
+  transaction::Methods* trxPtr = _plan->getAst()->query()->trx();
+
+  HashJoinExecutorInfos infos(variableToRegisterId(_keyVariable),
+                              variableToRegisterId(_outVariable),
+                              getRegisterPlan()->nrRegs[previousNode->getDepth()],
+                              getRegisterPlan()->nrRegs[getDepth()],
+                              getRegsToClear(), calcRegsToKeep(), &engine,
+                              _collection, _attribute, trxPtr,
+                              engine.getQuery()->queryOptions().spillMemoryThreshold);
+  return std::make_unique<ExecutionBlockImpl<HashJoinExecutor>>(&engine, this,
+                                                                std::move(infos));
+}
+
+/// @brief clone ExecutionNode recursively
+ExecutionNode* HashJoinNode::clone(ExecutionPlan* plan, bool withDependencies,
+                                   bool withProperties) const {
+  auto outVariable = _outVariable;
+  auto keyVariable = _keyVariable;
+  if (withProperties) {
+    outVariable = plan->getAst()->variables()->createVariable(outVariable);
+    keyVariable = plan->getAst()->variables()->createVariable(keyVariable);
+    TRI_ASSERT(outVariable != nullptr);
+    TRI_ASSERT(keyVariable != nullptr);
+  }
+
+  auto c = std::make_unique<HashJoinNode>(plan, _id, _collection, outVariable,
+                                          keyVariable, _attribute);
+
+  c->projections(_projections);
+  c->_prototypeCollection = _prototypeCollection;
+  c->_prototypeOutVariable = _prototypeOutVariable;
+
+  return cloneHelper(std::move(c), withDependencies, withProperties);
+}
+
+/// @brief the collection is scanned once to build the hash table, every
+/// incoming item is a single lookup. we assume equality joins to be mostly
+/// on unique attributes, so every lookup produces a single result
+CostEstimate HashJoinNode::estimateCost() const {
+  transaction::Methods* trx = _plan->getAst()->query()->trx();
+  if (trx->status() != transaction::Status::RUNNING) {
+    return CostEstimate::empty();
+  }
+
+  TRI_ASSERT(!_dependencies.empty());
+  CostEstimate estimate = _dependencies.at(0)->getCost();
+  estimate.estimatedCost += static_cast<double>(_collection->count(trx)) +
+                            static_cast<double>(estimate.estimatedNrItems) + 1.0;
+  return estimate;
+}
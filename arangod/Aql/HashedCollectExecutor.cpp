@@ -29,9 +29,12 @@
 #include "Aql/ExecutorInfos.h"
 #include "Aql/InputAqlItemRow.h"
 #include "Aql/SingleRowFetcher.h"
+#include "Aql/SpillFile.h"
 #include "Basics/Common.h"
 
 #include <lib/Logger/LogMacros.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
 
 #include <utility>
 
@@ -40,6 +43,26 @@ using namespace arangodb::aql;
 
 static const AqlValue EmptyValue;
 
+namespace {
+/// @brief number of partitions per level is 2^partitionBits
+constexpr size_t partitionBits = 4;
+
+/// @brief group hash bits used for partitioning start here, so they are
+/// independent of the bits the hash map uses
+constexpr size_t partitionHashShift = 32;
+
+/// @brief partitions of this level are not partitioned further
+constexpr size_t maxPartitionLevel = (64 - partitionHashShift) / partitionBits - 1;
+
+/// @brief spilled rows of a partition are written in chunks of about this size
+constexpr size_t partitionChunkSize = 256 * 1024;
+
+/// @brief rough estimate of the memory usage of a single group, in
+/// addition to its key values
+constexpr size_t groupOverhead = 64;
+constexpr size_t aggregatorOverhead = 64;
+}  // namespace
+
 HashedCollectExecutorInfos::HashedCollectExecutorInfos(
     RegisterId nrInputRegisters, RegisterId nrOutputRegisters,
     std::unordered_set<RegisterId> registersToClear,
@@ -49,7 +72,7 @@ HashedCollectExecutorInfos::HashedCollectExecutorInfos(
     std::vector<std::pair<RegisterId, RegisterId>>&& groupRegisters,
     RegisterId collectRegister, std::vector<std::string>&& aggregateTypes,
     std::vector<std::pair<RegisterId, RegisterId>>&& aggregateRegisters,
-    transaction::Methods* trxPtr, bool count)
+    transaction::Methods* trxPtr, bool count, std::size_t spillMemoryThreshold)
     : ExecutorInfos(std::make_shared<std::unordered_set<RegisterId>>(readableInputRegisters),
                     std::make_shared<std::unordered_set<RegisterId>>(writeableOutputRegisters),
                     nrInputRegisters, nrOutputRegisters,
@@ -59,7 +82,8 @@ HashedCollectExecutorInfos::HashedCollectExecutorInfos(
       _groupRegisters(groupRegisters),
       _collectRegister(collectRegister),
       _count(count),
-      _trxPtr(trxPtr) {
+      _trxPtr(trxPtr),
+      _spillMemoryThreshold(spillMemoryThreshold) {
   TRI_ASSERT(!_groupRegisters.empty());
 }
 
@@ -97,7 +121,10 @@ HashedCollectExecutor::HashedCollectExecutor(Fetcher& fetcher, Infos& infos)
                  AqlValueGroupEqual(_infos.getTransaction())),
       _isInitialized(false),
       _aggregatorFactories(),
-      _returnedGroups(0) {
+      _returnedGroups(0),
+      _groupsMemoryUsage(0),
+      _level(0),
+      _spillNewGroups(false) {
   _aggregatorFactories = createAggregatorFactories(_infos);
   _nextGroupValues.reserve(_infos.getGroupRegisters().size());
 };
@@ -120,33 +147,198 @@ void HashedCollectExecutor::destroyAllGroupsAqlValues() {
 void HashedCollectExecutor::consumeInputRow(InputAqlItemRow& input) {
   TRI_ASSERT(input.isInitialized());
 
-  decltype(_allGroups)::iterator currentGroupIt = findOrEmplaceGroup(input);
+  auto getValue = [&input](size_t, RegisterId reg) -> AqlValue const& {
+    return input.getValue(reg);
+  };
+
+  _nextGroupValues.clear();
+
+  // for hashing simply re-use the aggregate registers, without cloning
+  // their contents
+  for (auto const& reg : _infos.getGroupRegisters()) {
+    _nextGroupValues.emplace_back(input.getValue(reg.second));
+  }
+
+  auto currentGroupIt = _allGroups.find(_nextGroupValues);
+
+  if (currentGroupIt == _allGroups.end()) {
+    if (mustSpillNewGroups()) {
+      spillRow(getValue);
+      return;
+    }
+
+    _nextGroupValues.clear();
+    // for inserting into group we need to clone the values
+    // and take over ownership
+    for (auto const& reg : _infos.getGroupRegisters()) {
+      _nextGroupValues.emplace_back(input.stealValue(reg.second));
+    }
+    currentGroupIt = emplaceGroup();
+  }
 
   // reduce the aggregates
-  AggregateValuesType* aggregateValues = currentGroupIt->second.get();
+  reduceAggregates(*currentGroupIt->second, getValue);
+}
 
+void HashedCollectExecutor::consumeSpilledRow(VPackSlice row) {
+  TRI_ASSERT(row.isArray());
+  size_t const numGroupValues = _infos.getGroupRegisters().size();
+
+  // the aggregate input values follow the group values in the row
+  auto getValue = [row, numGroupValues](size_t j, RegisterId) -> AqlValue {
+    return AqlValue(row.at(numGroupValues + j).begin());
+  };
+
+  _nextGroupValues.clear();
+
+  // refer to the values in the spill file for the lookup
+  for (size_t i = 0; i < numGroupValues; ++i) {
+    _nextGroupValues.emplace_back(row.at(i).begin());
+  }
+
+  auto currentGroupIt = _allGroups.find(_nextGroupValues);
+
+  if (currentGroupIt == _allGroups.end()) {
+    if (mustSpillNewGroups()) {
+      spillRow(getValue);
+      return;
+    }
+
+    _nextGroupValues.clear();
+    for (size_t i = 0; i < numGroupValues; ++i) {
+      _nextGroupValues.emplace_back(row.at(i));
+    }
+    currentGroupIt = emplaceGroup();
+  }
+
+  reduceAggregates(*currentGroupIt->second, getValue);
+}
+
+template <typename ValueGetter>
+void HashedCollectExecutor::reduceAggregates(AggregateValuesType& aggregateValues,
+                                             ValueGetter const& getValue) {
   if (_infos.getAggregateTypes().empty()) {
     // no aggregate registers. simply increase the counter
     if (_infos.getCount()) {
       // TODO get rid of this special case if possible
-      TRI_ASSERT(!aggregateValues->empty());
-      aggregateValues->back()->reduce(EmptyValue);
+      TRI_ASSERT(!aggregateValues.empty());
+      aggregateValues.back()->reduce(EmptyValue);
     }
   } else {
     // apply the aggregators for the group
-    TRI_ASSERT(aggregateValues->size() == _infos.getAggregatedRegisters().size());
+    TRI_ASSERT(aggregateValues.size() == _infos.getAggregatedRegisters().size());
     size_t j = 0;
     for (auto const& r : _infos.getAggregatedRegisters()) {
       if (r.second == ExecutionNode::MaxRegisterId) {
-        (*aggregateValues)[j]->reduce(EmptyValue);
+        aggregateValues[j]->reduce(EmptyValue);
       } else {
-        (*aggregateValues)[j]->reduce(input.getValue(r.second));
+        aggregateValues[j]->reduce(getValue(j, r.second));
       }
       ++j;
     }
   }
 }
 
+bool HashedCollectExecutor::mustSpillNewGroups() {
+  if (!_spillNewGroups && _infos.getSpillMemoryThreshold() > 0 &&
+      _level < ::maxPartitionLevel && !_allGroups.empty() &&
+      _groupsMemoryUsage > _infos.getSpillMemoryThreshold()) {
+    // from now on, all rows of new groups go to disk. at least one group has
+    // been built in this pass, so every pass makes progress
+    _spillNewGroups = true;
+    _partitions.clear();
+    for (size_t i = 0; i < (size_t(1) << ::partitionBits); ++i) {
+      _partitions.emplace_back(std::make_unique<SpilledPartition>());
+    }
+    if (_spillFile == nullptr) {
+      _spillFile = std::make_unique<SpillFile>();
+    }
+  }
+  return _spillNewGroups;
+}
+
+template <typename ValueGetter>
+void HashedCollectExecutor::spillRow(ValueGetter const& getValue) {
+  TRI_ASSERT(_spillNewGroups);
+  TRI_ASSERT(_spillFile != nullptr);
+
+  size_t const hash = _allGroups.hash_function()(_nextGroupValues);
+  size_t const index = (hash >> (::partitionHashShift + _level * ::partitionBits)) &
+                       ((size_t(1) << ::partitionBits) - 1);
+  SpilledPartition& partition = *_partitions[index];
+
+  auto trx = _infos.getTransaction();
+  VPackBuilder& builder = partition.pending;
+  if (builder.isEmpty()) {
+    builder.openArray();
+  }
+  builder.openArray();
+  for (auto const& value : _nextGroupValues) {
+    value.toVelocyPack(trx, builder, false);
+  }
+  size_t j = 0;
+  for (auto const& r : _infos.getAggregatedRegisters()) {
+    if (r.second == ExecutionNode::MaxRegisterId) {
+      builder.add(VPackValue(VPackValueType::Null));
+    } else {
+      getValue(j, r.second).toVelocyPack(trx, builder, false);
+    }
+    ++j;
+  }
+  builder.close();
+  ++partition.numRows;
+
+  if (builder.size() >= ::partitionChunkSize) {
+    builder.close();
+    partition.chunks.emplace_back(_spillFile->append(builder.slice()));
+    builder.clear();
+  }
+}
+
+void HashedCollectExecutor::finishPass() {
+  for (auto& partition : _partitions) {
+    if (partition->numRows == 0) {
+      continue;
+    }
+    VPackBuilder& builder = partition->pending;
+    if (!builder.isEmpty()) {
+      builder.close();
+      partition->chunks.emplace_back(_spillFile->append(builder.slice()));
+      builder.clear();
+    }
+    _pendingPartitions.emplace_back(_level + 1, std::move(partition));
+  }
+  _partitions.clear();
+}
+
+void HashedCollectExecutor::loadNextPartition() {
+  TRI_ASSERT(!_pendingPartitions.empty());
+  TRI_ASSERT(_currentGroup == _allGroups.end());
+
+  std::unique_ptr<SpilledPartition> partition = std::move(_pendingPartitions.back().second);
+  _level = _pendingPartitions.back().first;
+  _pendingPartitions.pop_back();
+
+  // all keys have been handed over to the output already
+  _allGroups.clear();
+  _groupsMemoryUsage = 0;
+  _returnedGroups = 0;
+  _spillNewGroups = false;
+
+  for (uint64_t offset : partition->chunks) {
+    VPackSlice chunk = _spillFile->read(offset);
+    TRI_ASSERT(chunk.isArray());
+    for (auto const& row : VPackArrayIterator(chunk)) {
+      consumeSpilledRow(row);
+    }
+  }
+
+  finishPass();
+  _currentGroup = _allGroups.begin();
+  _nextGroupValues.clear();
+  TRI_ASSERT(!_allGroups.empty());
+}
+
 void HashedCollectExecutor::writeCurrentGroupToOutput(OutputAqlItemRow& output) {
   // build the result
   TRI_ASSERT(!_infos.getCount() || _infos.getCollectRegister() != ExecutionNode::MaxRegisterId);
@@ -207,6 +399,8 @@ ExecutionState HashedCollectExecutor::init() {
     }
   }
 
+  finishPass();
+
   // initialize group iterator for output
   _currentGroup = _allGroups.begin();
   // The values within are not supposed to be used anymore.
@@ -229,6 +423,10 @@ std::pair<ExecutionState, NoStats> HashedCollectExecutor::produceRows(OutputAqlI
     _isInitialized = true;
   }
 
+  if (_currentGroup == _allGroups.end() && !_pendingPartitions.empty()) {
+    loadNextPartition();
+  }
+
   // produce output
   if (_currentGroup != _allGroups.end()) {
     writeCurrentGroupToOutput(output);
@@ -237,38 +435,20 @@ std::pair<ExecutionState, NoStats> HashedCollectExecutor::produceRows(OutputAqlI
     TRI_ASSERT(_returnedGroups <= _allGroups.size());
   }
 
-  ExecutionState state = _currentGroup != _allGroups.end() ? ExecutionState::HASMORE
-                                                           : ExecutionState::DONE;
+  ExecutionState state =
+      (_currentGroup != _allGroups.end() || !_pendingPartitions.empty())
+          ? ExecutionState::HASMORE
+          : ExecutionState::DONE;
 
   return {state, NoStats{}};
 }
 
-// finds the group matching the current row, or emplaces it. in either case,
-// it returns an iterator to the group matching the current row in
-// _allGroups. additionally, .second is true iff a new group was emplaced.
-decltype(HashedCollectExecutor::_allGroups)::iterator HashedCollectExecutor::findOrEmplaceGroup(
-    InputAqlItemRow& input) {
-  _nextGroupValues.clear();
-
-  // for hashing simply re-use the aggregate registers, without cloning
-  // their contents
-  for (auto const& reg : _infos.getGroupRegisters()) {
-    _nextGroupValues.emplace_back(input.getValue(reg.second));
-  }
-
-  auto it = _allGroups.find(_nextGroupValues);
-
-  if (it != _allGroups.end()) {
-    // group already exists
-    return it;
+decltype(HashedCollectExecutor::_allGroups)::iterator HashedCollectExecutor::emplaceGroup() {
+  for (auto const& value : _nextGroupValues) {
+    _groupsMemoryUsage += sizeof(AqlValue) + value.memoryUsage();
   }
+  _groupsMemoryUsage += ::groupOverhead + _aggregatorFactories.size() * ::aggregatorOverhead;
 
-  _nextGroupValues.clear();
-  // for inserting into group we need to clone the values
-  // and take over ownership
-  for (auto const& reg : _infos.getGroupRegisters()) {
-    _nextGroupValues.emplace_back(input.stealValue(reg.second));
-  }
   // this builds a new group with aggregate functions being prepared.
   auto aggregateValues = std::make_unique<AggregateValuesType>();
   aggregateValues->reserve(_aggregatorFactories.size());
@@ -304,6 +484,10 @@ std::pair<ExecutionState, size_t> HashedCollectExecutor::expectedNumberOfRows(si
     // This fetcher nows how exactly many rows are left
     // as it knows how many  groups is has created and not returned.
     rowsLeft = _allGroups.size() - _returnedGroups;
+    // Overestimate for spilled partitions, they have not been grouped yet
+    for (auto const& it : _pendingPartitions) {
+      rowsLeft += it.second->numRows;
+    }
   }
   if (rowsLeft > 0) {
     return {ExecutionState::HASMORE, rowsLeft};
@@ -37,6 +37,8 @@
 #include "Aql/OutputAqlItemRow.h"
 #include "Aql/types.h"
 
+#include <velocypack/Builder.h>
+
 #include <memory>
 
 namespace arangodb {
@@ -44,6 +46,7 @@ namespace aql {
 
 class InputAqlItemRow;
 class ExecutorInfos;
+class SpillFile;
 template <bool>
 class SingleRowFetcher;
 
@@ -57,7 +60,8 @@ class HashedCollectExecutorInfos : public ExecutorInfos {
                              std::vector<std::pair<RegisterId, RegisterId>>&& groupRegisters,
                              RegisterId collectRegister, std::vector<std::string>&& aggregateTypes,
                              std::vector<std::pair<RegisterId, RegisterId>>&& aggregateRegisters,
-                             transaction::Methods* trxPtr, bool count);
+                             transaction::Methods* trxPtr, bool count,
+                             std::size_t spillMemoryThreshold);
 
   HashedCollectExecutorInfos() = delete;
   HashedCollectExecutorInfos(HashedCollectExecutorInfos&&) = default;
@@ -75,6 +79,9 @@ class HashedCollectExecutorInfos : public ExecutorInfos {
   bool getCount() const noexcept { return _count; }
   transaction::Methods* getTransaction() const { return _trxPtr; }
   RegisterId getCollectRegister() const noexcept { return _collectRegister; }
+  std::size_t getSpillMemoryThreshold() const noexcept {
+    return _spillMemoryThreshold;
+  }
 
  private:
   /// @brief aggregate types
@@ -97,10 +104,23 @@ class HashedCollectExecutorInfos : public ExecutorInfos {
 
   /// @brief the transaction for this query
   transaction::Methods* _trxPtr;
+
+  /// @brief estimated memory usage of the groups after which new groups are
+  /// spilled to disk. 0 means never spill
+  std::size_t _spillMemoryThreshold;
 };
 
 /**
  * @brief Implementation of Hashed Collect Executor
+ *
+ * If the infos specify a spillMemoryThreshold, the executor stops creating
+ * new groups once the estimated memory usage of its groups exceeds the
+ * threshold. Input rows that belong to existing groups are still aggregated
+ * in memory, while rows with new group keys are hash-partitioned and
+ * written to a spill file. Since no keys are added after that point, the
+ * in-memory groups are complete and are returned first. Afterwards, the
+ * spilled partitions are re-aggregated one after the other in the same
+ * way, using other bits of the group hash for sub-partitioning.
  */
 
 class HashedCollectExecutor {
@@ -142,6 +162,17 @@ class HashedCollectExecutor {
   using GroupMapType =
       std::unordered_map<GroupKeyType, GroupValueType, AqlValueGroupHash, AqlValueGroupEqual>;
 
+  /// @brief rows of a partition spilled to disk
+  struct SpilledPartition {
+    /// @brief offsets of the chunks of the partition in the spill file. each
+    /// chunk is an array of rows, each row an array of the group values
+    /// followed by the aggregate input values
+    std::vector<uint64_t> chunks;
+    /// @brief rows not yet written to the spill file
+    arangodb::velocypack::Builder pending;
+    size_t numRows = 0;
+  };
+
   Infos const& infos() const noexcept { return _infos; }
 
   /**
@@ -158,10 +189,34 @@ class HashedCollectExecutor {
   static std::vector<std::function<std::unique_ptr<Aggregator>(transaction::Methods*)> const*>
   createAggregatorFactories(HashedCollectExecutor::Infos const& infos);
 
-  GroupMapType::iterator findOrEmplaceGroup(InputAqlItemRow& input);
+  /// @brief emplace a new group for the keys in _nextGroupValues, whose
+  /// ownership is taken over
+  GroupMapType::iterator emplaceGroup();
 
   void consumeInputRow(InputAqlItemRow& input);
 
+  /// @brief aggregate a row read back from a spilled partition
+  void consumeSpilledRow(arangodb::velocypack::Slice row);
+
+  template <typename ValueGetter>
+  void reduceAggregates(AggregateValuesType& aggregateValues, ValueGetter const& getValue);
+
+  /// @brief whether rows of new groups must be spilled instead of being
+  /// added to _allGroups
+  bool mustSpillNewGroups();
+
+  /// @brief append a row of a new group to its partition. the group values
+  /// must be in _nextGroupValues
+  template <typename ValueGetter>
+  void spillRow(ValueGetter const& getValue);
+
+  /// @brief write all pending spilled rows and queue the partitions of the
+  /// current pass for re-aggregation
+  void finishPass();
+
+  /// @brief re-aggregate the next spilled partition into _allGroups
+  void loadNextPartition();
+
   void writeCurrentGroupToOutput(OutputAqlItemRow& output);
 
  private:
@@ -185,6 +240,24 @@ class HashedCollectExecutor {
   size_t _returnedGroups;
 
   GroupKeyType _nextGroupValues;
+
+  /// @brief estimated memory usage of _allGroups
+  size_t _groupsMemoryUsage;
+
+  /// @brief partitioning level of the current pass. a pass over the input
+  /// has level 0, a pass over a partition spilled in level n has level n + 1
+  size_t _level;
+
+  /// @brief set once the memory budget of the current pass is exhausted
+  bool _spillNewGroups;
+
+  std::unique_ptr<SpillFile> _spillFile;
+
+  /// @brief partitions of the current pass, empty if nothing was spilled
+  std::vector<std::unique_ptr<SpilledPartition>> _partitions;
+
+  /// @brief spilled partitions still to be re-aggregated, with their level
+  std::vector<std::pair<size_t, std::unique_ptr<SpilledPartition>>> _pendingPartitions;
 };
 
 }  // namespace aql
@@ -30,6 +30,8 @@
 #include "IResearch/IResearchFilterFactory.h"
 #include "IResearch/IResearchOrderFactory.h"
 #include "IResearch/IResearchView.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "StorageEngine/StorageEngine.h"
 #include "StorageEngine/TransactionCollection.h"
@@ -39,6 +41,10 @@
 #include "search/boolean_filter.hpp"
 #include "search/score.hpp"
 
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+
 // TODO Eliminate access to the plan if possible!
 // I think it is used for two things only:
 //  - to get the Ast, which can simply be passed on its own, and
@@ -55,8 +61,13 @@ using namespace arangodb::iresearch;
 IResearchViewExecutorInfos::IResearchViewExecutorInfos(
     ExecutorInfos&& infos, std::shared_ptr<const IResearchView::Snapshot> reader,
     RegisterId firstOutputRegister, RegisterId numScoreRegisters, Query& query,
-    std::vector<Scorer> const& scorers, ExecutionPlan const& plan, Variable const& outVariable,
-    aql::AstNode const& filterCondition, std::pair<bool, bool> volatility,
+    std::vector<Scorer> const& scorers,
+    std::vector<std::pair<size_t, bool>> const& scorersSort,
+    size_t scorersSortLimit, std::vector<bool> const& primarySort,
+    size_t primarySortLimit, size_t parallelism,
+    std::vector<std::string> const& storedValues, std::string const& facet,
+    ExecutionPlan const& plan, Variable const& outVariable, aql::AstNode const& filterCondition,
+    std::pair<bool, bool> volatility,
     IResearchViewExecutorInfos::VarInfoMap const& varInfoMap, int depth)
     : ExecutorInfos(std::move(infos)),
       _outputRegister(firstOutputRegister),
@@ -64,6 +75,13 @@ IResearchViewExecutorInfos::IResearchViewExecutorInfos(
       _reader(std::move(reader)),
       _query(query),
       _scorers(scorers),
+      _scorersSort(scorersSort),
+      _scorersSortLimit(scorersSortLimit),
+      _primarySort(primarySort),
+      _primarySortLimit(primarySortLimit),
+      _parallelism(parallelism),
+      _storedValues(storedValues),
+      _facet(facet),
       _plan(plan),
       _outVariable(outVariable),
       _filterCondition(filterCondition),
@@ -100,6 +118,35 @@ std::vector<arangodb::iresearch::Scorer> const& IResearchViewExecutorInfos::scor
   return _scorers;
 }
 
+std::vector<std::pair<size_t, bool>> const& IResearchViewExecutorInfos::scorersSort() const
+    noexcept {
+  return _scorersSort;
+}
+
+size_t IResearchViewExecutorInfos::scorersSortLimit() const noexcept {
+  return _scorersSortLimit;
+}
+
+std::vector<bool> const& IResearchViewExecutorInfos::primarySort() const noexcept {
+  return _primarySort;
+}
+
+size_t IResearchViewExecutorInfos::primarySortLimit() const noexcept {
+  return _primarySortLimit;
+}
+
+size_t IResearchViewExecutorInfos::parallelism() const noexcept {
+  return _parallelism;
+}
+
+std::vector<std::string> const& IResearchViewExecutorInfos::storedValues() const noexcept {
+  return _storedValues;
+}
+
+std::string const& IResearchViewExecutorInfos::facet() const noexcept {
+  return _facet;
+}
+
 ExecutionPlan const& IResearchViewExecutorInfos::plan() const noexcept {
   return _plan;
 }
@@ -145,10 +192,16 @@ IResearchViewExecutor<ordered>::IResearchViewExecutor(IResearchViewExecutor::Fet
       _hasMore(true),  // has more data initially
       _isInitialized(false),
       _pkReader(),
+      _storedReader(),
       _itr(),
       _readerOffset(0),
       _scr(nullptr),
-      _scrVal() {
+      _scrVal(),
+      _hasExpressionFilter(false),
+      _collect(false),
+      _documentsOffset(0),
+      _collected(false),
+      _facetsOffset(0) {
   TRI_ASSERT(infos.getQuery().trx() != nullptr);
 
   TRI_ASSERT(ordered == (infos.getNumScoreRegisters() != 0));
@@ -298,6 +351,27 @@ bool readPK(irs::doc_iterator& it, irs::columnstore_reader::values_reader_f cons
   return false;
 }
 
+inline irs::columnstore_reader::values_reader_f pkColumn(irs::sub_reader const& segment) {
+  auto const* reader =
+      segment.column_reader(arangodb::iresearch::DocumentPrimaryKey::PK());
+
+  return reader ? reader->values() : irs::columnstore_reader::values_reader_f{};
+}
+
+inline irs::columnstore_reader::values_reader_f storedValuesColumn(irs::sub_reader const& segment) {
+  auto const* reader =
+      segment.column_reader(arangodb::iresearch::DocumentStoredValues::column());
+
+  return reader ? reader->values() : irs::columnstore_reader::values_reader_f{};
+}
+
+inline irs::columnstore_reader::values_reader_f primarySortColumn(irs::sub_reader const& segment) {
+  auto const* reader =
+      segment.column_reader(arangodb::iresearch::DocumentPrimarySort::column());
+
+  return reader ? reader->values() : irs::columnstore_reader::values_reader_f{};
+}
+
 template <bool ordered>
 bool IResearchViewExecutor<ordered>::writeRow(ReadContext& ctx, IndexReadBufferEntry bufferEntry) {
   LocalDocumentId const& documentId = _indexReadBuffer.getId(bufferEntry);
@@ -307,8 +381,23 @@ bool IResearchViewExecutor<ordered>::writeRow(ReadContext& ctx, IndexReadBufferE
       _indexReadBuffer.getCollection();
   TRI_ASSERT(collection != nullptr);
 
-  // read document from underlying storage engine, if we got an id
-  if (collection->readDocumentWithCallback(infos().getQuery().trx(), documentId, ctx.callback)) {
+  uint8_t const* storedValues = _indexReadBuffer.getStoredValues(bufferEntry);
+  bool found = false;
+
+  if (storedValues != nullptr) {
+    // the stored values have all attributes the query needs
+    AqlValue value{AqlValueHintCopy(storedValues)};
+    bool mustDestroy = true;
+    AqlValueGuard guard{value, mustDestroy};
+    ctx.outputRow.moveValueInto(ctx.docOutReg, ctx.inputRow, guard);
+    found = true;
+  } else {
+    // read document from underlying storage engine, if we got an id
+    found = collection->readDocumentWithCallback(infos().getQuery().trx(),
+                                                 documentId, ctx.callback);
+  }
+
+  if (found) {
     // in the ordered case we have to write scores as well as a document
     if /* constexpr */ (ordered) {
       // scorer register are placed consecutively after the document output register
@@ -434,6 +523,10 @@ void IResearchViewExecutor<ordered>::fillBuffer(IResearchViewExecutor::ReadConte
 
     _indexReadBuffer.pushDocument(documentId);
 
+    if (!infos().storedValues().empty()) {
+      pushStoredValues(_storedReader, _itr->value());
+    }
+
     // in the ordered case we have to write scores as well as a document
     if /* constexpr */ (ordered) {
       // Writes into _scoreBuffer
@@ -458,6 +551,546 @@ void IResearchViewExecutor<ordered>::fillBuffer(IResearchViewExecutor::ReadConte
   }
 }
 
+namespace {
+
+/// @brief whether the filter evaluates AQL expressions, these use the
+/// expression context of the executor and must not run concurrently
+bool hasExpressionFilter(irs::filter const& filter) {
+  if (filter.type() == ByExpression::type()) {
+    return true;
+  }
+
+  if (filter.type() == irs::Not::type()) {
+    auto const* negated = static_cast<irs::Not const&>(filter).filter();
+    return negated != nullptr && hasExpressionFilter(*negated);
+  }
+
+  auto const* boolean = dynamic_cast<irs::boolean_filter const*>(&filter);
+
+  if (boolean != nullptr) {
+    for (auto const& sub : *boolean) {
+      if (hasExpressionFilter(sub)) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+/// @brief whether the document with the scores lhs sorts before the one with
+/// the scores rhs
+bool betterScores(std::vector<std::pair<size_t, bool>> const& sort,
+                  float_t const* lhs, float_t const* rhs) noexcept {
+  for (auto const& it : sort) {
+    if (lhs[it.first] != rhs[it.first]) {
+      return it.second ? lhs[it.first] < rhs[it.first] : lhs[it.first] > rhs[it.first];
+    }
+  }
+  return false;
+}
+
+/// @brief whether the document with the primary sort values lhs sorts before
+/// the one with the values rhs
+bool betterSortValues(std::vector<bool> const& directions,
+                      std::string const& lhs, std::string const& rhs) {
+  return arangodb::iresearch::DocumentPrimarySort::less(
+      lhs.empty() ? VPackSlice::noneSlice()
+                  : VPackSlice(reinterpret_cast<uint8_t const*>(lhs.data())),
+      rhs.empty() ? VPackSlice::noneSlice()
+                  : VPackSlice(reinterpret_cast<uint8_t const*>(rhs.data())),
+      directions);
+}
+
+/// @brief collects the documents of a segment matching the filter. if sort
+/// or primarySort is not empty, only the best limit documents are kept, in no
+/// particular order. segments without primary sort values keep all
+/// documents. only reads from its arguments, so that segments can be
+/// collected concurrently
+void collectSegment(irs::sub_reader const& segment, irs::filter::prepared const& filter,
+                    irs::order::prepared const& order, irs::attribute_view const& filterCtx,
+                    std::vector<std::pair<size_t, bool>> const& sort,
+                    std::vector<bool> const& primarySort, size_t limit,
+                    size_t numScores, bool withDocs, IResearchViewSegmentDocuments& out) {
+  auto pkReader = ::pkColumn(segment);
+
+  if (!pkReader) {
+    LOG_TOPIC("6c1f4", WARN, arangodb::iresearch::TOPIC)
+        << "encountered a sub-reader without a primary key column while "
+           "executing a query, ignoring";
+    return;
+  }
+
+  auto itr = segment.mask(filter.execute(segment, order, filterCtx));
+
+  irs::score const* scr = nullptr;
+  irs::bytes_ref scrVal = irs::bytes_ref::NIL;
+
+  if (numScores > 0) {
+    scr = itr->attributes().get<irs::score>().get();
+    if (scr) {
+      scrVal = scr->value();
+      TRI_ASSERT(scrVal.size() == numScores * sizeof(float_t));
+    }
+  }
+
+  out.scored = scr != nullptr;
+
+  irs::columnstore_reader::values_reader_f sortReader;
+  if (!primarySort.empty()) {
+    // written by the links of a view with a primary sort only
+    sortReader = ::primarySortColumn(segment);
+  }
+
+  bool const sorted = static_cast<bool>(sortReader);
+  out.ranked = sorted || !sort.empty();
+
+  // slots in out.ids of the documents kept, the worst one at the front
+  std::vector<size_t> heap;
+  auto const better = [&sort, &primarySort, &out, sorted, numScores](size_t lhs, size_t rhs) {
+    if (sorted) {
+      return betterSortValues(primarySort, out.sortValues[lhs], out.sortValues[rhs]);
+    }
+    return betterScores(sort, out.scores.data() + lhs * numScores,
+                        out.scores.data() + rhs * numScores);
+  };
+
+  LocalDocumentId documentId;
+  irs::bytes_ref sortValue;
+  while (readPK(*itr, pkReader, documentId)) {
+    if (!documentId.isSet()) {
+      continue;
+    }
+
+    if (numScores == 0 && !out.ranked) {
+      out.ids.emplace_back(documentId);
+      if (withDocs) {
+        out.docs.emplace_back(itr->value());
+      }
+      continue;
+    }
+
+    // the scores and sort values of the candidate go to the slot after the
+    // last document
+    size_t const candidate = out.ids.size();
+    if (numScores > 0) {
+      if (scr) {
+        scr->evaluate();
+
+        // in arangodb we assume all scorers return float_t
+        auto begin = reinterpret_cast<const float_t*>(scrVal.begin());
+        out.scores.insert(out.scores.end(), begin, begin + numScores);
+      } else {
+        // unscored documents sort like null values, i.e. before any score
+        out.scores.insert(out.scores.end(), numScores,
+                          -std::numeric_limits<float_t>::infinity());
+      }
+    }
+
+    if (sorted) {
+      if (out.sortValues.size() <= candidate) {
+        out.sortValues.emplace_back();
+      }
+      if (sortReader(itr->value(), sortValue)) {
+        out.sortValues[candidate].assign(
+            reinterpret_cast<char const*>(sortValue.c_str()), sortValue.size());
+      } else {
+        // sorts like null values
+        out.sortValues[candidate].clear();
+      }
+    }
+
+    if (!out.ranked || out.ids.size() < limit) {
+      out.ids.emplace_back(documentId);
+      if (withDocs) {
+        out.docs.emplace_back(itr->value());
+      }
+      if (out.ranked) {
+        heap.emplace_back(candidate);
+        std::push_heap(heap.begin(), heap.end(), better);
+      }
+      continue;
+    }
+
+    if (limit > 0 && better(candidate, heap.front())) {
+      std::pop_heap(heap.begin(), heap.end(), better);
+      size_t const slot = heap.back();
+      out.ids[slot] = documentId;
+      if (withDocs) {
+        out.docs[slot] = itr->value();
+      }
+      std::copy_n(out.scores.begin() + candidate * numScores, numScores,
+                  out.scores.begin() + slot * numScores);
+      if (sorted) {
+        std::swap(out.sortValues[slot], out.sortValues[candidate]);
+      }
+      std::push_heap(heap.begin(), heap.end(), better);
+    }
+    out.scores.resize(out.ids.size() * numScores);
+  }
+
+  out.sortValues.resize(sorted ? out.ids.size() : 0);
+}
+
+/// @brief counts the documents of a segment matching the filter per value of
+/// the attribute in the stored values. only reads from its arguments, so that
+/// segments can be counted concurrently
+void countSegment(irs::sub_reader const& segment, irs::filter::prepared const& filter,
+                  irs::order::prepared const& order, irs::attribute_view const& filterCtx,
+                  std::vector<std::string> const& attributes,
+                  IResearchViewSegmentFacets& out) {
+  TRI_ASSERT(attributes.size() == 1);
+  auto pkReader = ::pkColumn(segment);
+
+  if (!pkReader) {
+    LOG_TOPIC("0d5c7", WARN, arangodb::iresearch::TOPIC)
+        << "encountered a sub-reader without a primary key column while "
+           "executing a query, ignoring";
+    return;
+  }
+
+  auto storedReader = ::storedValuesColumn(segment);
+  auto itr = segment.mask(filter.execute(segment, order, filterCtx));
+
+  irs::bytes_ref value;
+  std::string key;
+  while (itr->next()) {
+    irs::doc_id_t const docId = itr->value();
+
+    if (storedReader && storedReader(docId, value)) {
+      VPackSlice stored(value.c_str());
+      if (DocumentStoredValues::covers(stored, attributes)) {
+        VPackSlice attribute = stored.get(attributes.front());
+        key.assign(attribute.startAs<char>(), attribute.byteSize());
+        ++out.counts[key];
+        continue;
+      }
+    }
+
+    LocalDocumentId documentId;
+    if (pkReader(docId, value) && DocumentPrimaryKey::read(documentId, value)) {
+      out.ids.emplace_back(documentId);
+    }
+  }
+}
+
+/// @brief collects the segments [0, count) on up to parallelism threads. the
+/// calling thread takes part, so that all segments are collected even if the
+/// scheduler does not get to the queued tasks
+class ParallelCollect : public std::enable_shared_from_this<ParallelCollect> {
+ public:
+  ParallelCollect(size_t count, std::function<void(size_t)>&& collect)
+      : _collect(std::move(collect)), _count(count), _next(0), _active(0), _closed(false) {}
+
+  void run(size_t parallelism) {
+    auto* scheduler = SchedulerFeature::SCHEDULER;
+
+    for (size_t i = 1; i < parallelism && scheduler != nullptr; ++i) {
+      auto self = shared_from_this();
+      if (!scheduler->queue(RequestLane::INTERNAL_LOW, [self]() { self->work(); })) {
+        break;
+      }
+    }
+
+    work();
+
+    std::unique_lock<std::mutex> guard(_mutex);
+    // tasks that did not start yet must not touch the segments anymore
+    _closed = true;
+    _condition.wait(guard, [this]() { return _active == 0; });
+
+    if (_error) {
+      std::rethrow_exception(_error);
+    }
+  }
+
+ private:
+  void work() {
+    {
+      std::lock_guard<std::mutex> guard(_mutex);
+      if (_closed) {
+        return;
+      }
+      ++_active;
+    }
+
+    try {
+      for (size_t i = _next++; i < _count; i = _next++) {
+        _collect(i);
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> guard(_mutex);
+      _error = std::current_exception();
+      _next = _count;
+    }
+
+    std::lock_guard<std::mutex> guard(_mutex);
+    --_active;
+    _condition.notify_all();
+  }
+
+ private:
+  std::function<void(size_t)> const _collect;
+  size_t const _count;
+  std::atomic<size_t> _next;
+
+  std::mutex _mutex;
+  std::condition_variable _condition;
+  size_t _active;
+  bool _closed;
+  std::exception_ptr _error;
+};
+
+}  // namespace
+
+template <bool ordered>
+void IResearchViewExecutor<ordered>::pushStoredValues(
+    irs::columnstore_reader::values_reader_f const& reader, irs::doc_id_t docId) {
+  irs::bytes_ref value;
+
+  if (reader && reader(docId, value) &&
+      DocumentStoredValues::covers(VPackSlice(value.c_str()), infos().storedValues())) {
+    _indexReadBuffer.pushStoredValues(value);
+  } else {
+    _indexReadBuffer.pushStoredValuesNone();
+  }
+}
+
+template <bool ordered>
+bool IResearchViewExecutor<ordered>::topK() const noexcept {
+  return (ordered && !infos().scorersSort().empty()) || !infos().primarySort().empty();
+}
+
+template <bool ordered>
+void IResearchViewExecutor<ordered>::collectDocuments() {
+  TRI_ASSERT(_collect);
+  TRI_ASSERT(_filter != nullptr);
+
+  auto const& sort = infos().scorersSort();
+  auto const& primarySort = infos().primarySort();
+  TRI_ASSERT(sort.empty() || primarySort.empty());
+  size_t const limit = !topK() ? std::numeric_limits<size_t>::max()
+                               : primarySort.empty() ? infos().scorersSortLimit()
+                                                     : infos().primarySortLimit();
+  size_t const numScores = infos().getNumScoreRegisters();
+  size_t const count = _reader->size();
+
+  _segments.clear();
+  _segments.resize(count);
+  _documents.clear();
+  _documentsOffset = 0;
+  _collected = true;
+
+  auto collect = [this, &sort, &primarySort, limit, numScores](size_t i) {
+    ::collectSegment((*_reader)[i], *_filter, _order, _filterCtx, sort, primarySort,
+                     limit, numScores, !infos().storedValues().empty(), _segments[i]);
+  };
+
+  size_t const parallelism = _hasExpressionFilter ? 1 : std::min(infos().parallelism(), count);
+  if (parallelism > 1) {
+    auto parallel = std::make_shared<ParallelCollect>(count, std::move(collect));
+    parallel->run(parallelism);
+  } else {
+    for (size_t i = 0; i < count; ++i) {
+      collect(i);
+    }
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    for (size_t j = 0; j < _segments[i].ids.size(); ++j) {
+      _documents.emplace_back(i, j);
+    }
+  }
+
+  if (!topK()) {
+    return;
+  }
+
+  // documents of segments that could not be ranked are all produced
+  auto const end = std::stable_partition(
+      _documents.begin(), _documents.end(), [this](std::pair<size_t, size_t> const& doc) {
+        return _segments[doc.first].ranked;
+      });
+
+  if (static_cast<size_t>(std::distance(_documents.begin(), end)) > limit) {
+    // keep the best documents of all ranked segments
+    std::nth_element(_documents.begin(), _documents.begin() + limit, end,
+                     [this, &sort, &primarySort, numScores](std::pair<size_t, size_t> const& lhs,
+                                                            std::pair<size_t, size_t> const& rhs) {
+                       auto const& lhsSegment = _segments[lhs.first];
+                       auto const& rhsSegment = _segments[rhs.first];
+                       if (!primarySort.empty()) {
+                         return ::betterSortValues(primarySort,
+                                                   lhsSegment.sortValues[lhs.second],
+                                                   rhsSegment.sortValues[rhs.second]);
+                       }
+                       return ::betterScores(sort, lhsSegment.scores.data() + lhs.second * numScores,
+                                             rhsSegment.scores.data() + rhs.second * numScores);
+                     });
+    _documents.erase(_documents.begin() + limit, end);
+  }
+
+  // produce the documents segment by segment, the following SORT puts
+  // them in order
+  std::sort(_documents.begin(), _documents.end());
+}
+
+template <bool ordered>
+void IResearchViewExecutor<ordered>::fillBufferCollected(ReadContext& ctx) {
+  TRI_ASSERT(_collect);
+
+  if (!_collected) {
+    collectDocuments();
+  }
+
+  std::size_t const atMost = ctx.outputRow.numRowsLeft();
+  size_t const numScores = infos().getNumScoreRegisters();
+
+  while (_indexReadBuffer.empty() && _documentsOffset < _documents.size()) {
+    size_t const readerOffset = _documents[_documentsOffset].first;
+    IResearchViewSegmentDocuments const& segment = _segments[readerOffset];
+    Query& query = infos().getQuery();
+    std::shared_ptr<arangodb::LogicalCollection> collection =
+        lookupCollection(*query.trx(), _reader->cid(readerOffset), query);
+
+    if (!collection) {
+      // We don't have a collection, skip the documents of the reader.
+      while (_documentsOffset < _documents.size() &&
+             _documents[_documentsOffset].first == readerOffset) {
+        ++_documentsOffset;
+      }
+      continue;
+    }
+
+    _indexReadBuffer.setCollectionAndReset(std::move(collection));
+
+    irs::columnstore_reader::values_reader_f storedReader;
+    if (!infos().storedValues().empty()) {
+      storedReader = ::storedValuesColumn((*_reader)[readerOffset]);
+    }
+
+    for (; _documentsOffset < _documents.size() && _indexReadBuffer.size() < atMost;
+         ++_documentsOffset) {
+      if (_documents[_documentsOffset].first != readerOffset) {
+        break;
+      }
+
+      size_t const index = _documents[_documentsOffset].second;
+      _indexReadBuffer.pushDocument(segment.ids[index]);
+      if (!infos().storedValues().empty()) {
+        pushStoredValues(storedReader, segment.docs[index]);
+      }
+      for (size_t i = 0; i < numScores; ++i) {
+        if (segment.scored) {
+          _indexReadBuffer.pushScore(segment.scores[index * numScores + i]);
+        } else {
+          _indexReadBuffer.pushScoreNone();
+        }
+      }
+      _indexReadBuffer.assertSizeCoherence();
+    }
+  }
+}
+
+template <bool ordered>
+void IResearchViewExecutor<ordered>::collectFacets() {
+  TRI_ASSERT(_collect);
+  TRI_ASSERT(_filter != nullptr);
+
+  std::vector<std::string> const attributes{infos().facet()};
+  size_t const count = _reader->size();
+  std::vector<IResearchViewSegmentFacets> segments(count);
+
+  auto collect = [this, &attributes, &segments](size_t i) {
+    ::countSegment((*_reader)[i], *_filter, _order, _filterCtx, attributes, segments[i]);
+  };
+
+  size_t const parallelism = _hasExpressionFilter ? 1 : std::min(infos().parallelism(), count);
+  if (parallelism > 1) {
+    auto parallel = std::make_shared<ParallelCollect>(count, std::move(collect));
+    parallel->run(parallelism);
+  } else {
+    for (size_t i = 0; i < count; ++i) {
+      collect(i);
+    }
+  }
+
+  std::unordered_map<std::string, uint64_t> counts;
+  std::string key;
+  auto countDocument = [&attributes, &counts, &key](LocalDocumentId /*id*/, VPackSlice doc) {
+    // missing attributes count like null values, as in the stored values
+    VPackSlice attribute = doc.get(attributes.front());
+    if (attribute.isNone()) {
+      attribute = VPackSlice::nullSlice();
+    }
+    key.assign(attribute.startAs<char>(), attribute.byteSize());
+    ++counts[key];
+  };
+
+  for (size_t i = 0; i < count; ++i) {
+    for (auto& it : segments[i].counts) {
+      counts[it.first] += it.second;
+    }
+
+    if (segments[i].ids.empty()) {
+      continue;
+    }
+
+    // documents indexed without stored values are read from the collection
+    Query& query = infos().getQuery();
+    std::shared_ptr<arangodb::LogicalCollection> collection =
+        lookupCollection(*query.trx(), _reader->cid(i), query);
+
+    if (!collection) {
+      continue;
+    }
+
+    for (auto const& documentId : segments[i].ids) {
+      collection->readDocumentWithCallback(query.trx(), documentId, countDocument);
+    }
+  }
+
+  _facets.assign(std::make_move_iterator(counts.begin()),
+                 std::make_move_iterator(counts.end()));
+  _facetsOffset = 0;
+  _collected = true;
+}
+
+template <bool ordered>
+bool IResearchViewExecutor<ordered>::writeFacet(ReadContext& ctx) {
+  if (!_collected) {
+    collectFacets();
+  }
+
+  if (_facetsOffset >= _facets.size()) {
+    return false;
+  }
+
+  auto const& facet = _facets[_facetsOffset++];
+
+  // a document with only the attribute, like the stored values
+  _facetBuilder.clear();
+  _facetBuilder.openObject();
+  _facetBuilder.add(infos().facet(),
+                    VPackSlice(reinterpret_cast<uint8_t const*>(facet.first.data())));
+  _facetBuilder.close();
+
+  AqlValue value{AqlValueHintCopy(_facetBuilder.slice().begin())};
+  bool mustDestroy = true;
+  AqlValueGuard guard{value, mustDestroy};
+  ctx.outputRow.moveValueInto(ctx.docOutReg, ctx.inputRow, guard);
+
+  // the count register is placed after the document output register and
+  // the score registers
+  AqlValue countValue{AqlValueHintUInt(facet.second)};
+  bool mustDestroyCount = false;
+  AqlValueGuard countGuard{countValue, mustDestroyCount};
+  ctx.outputRow.moveValueInto(ctx.docOutReg + 1 + infos().getNumScoreRegisters(),
+                              ctx.inputRow, countGuard);
+
+  return true;
+}
+
 template <bool ordered>
 size_t IResearchViewExecutor<ordered>::skip(size_t limit) {
   TRI_ASSERT(_indexReadBuffer.empty());
@@ -465,6 +1098,24 @@ size_t IResearchViewExecutor<ordered>::skip(size_t limit) {
 
   size_t skipped{};
 
+  if (!infos().facet().empty()) {
+    if (!_collected) {
+      collectFacets();
+    }
+    skipped = std::min(limit, _facets.size() - _facetsOffset);
+    _facetsOffset += skipped;
+    return skipped;
+  }
+
+  if (_collect) {
+    if (!_collected) {
+      collectDocuments();
+    }
+    skipped = std::min(limit, _documents.size() - _documentsOffset);
+    _documentsOffset += skipped;
+    return skipped;
+  }
+
   for (size_t count = _reader->size(); _readerOffset < count;) {
     if (!_itr && !resetIterator()) {
       continue;
@@ -515,8 +1166,16 @@ size_t IResearchViewExecutor<ordered>::skip(size_t limit) {
 
 template <bool ordered>
 bool IResearchViewExecutor<ordered>::next(ReadContext& ctx) {
+  if (!infos().facet().empty()) {
+    return writeFacet(ctx);
+  }
+
   if (_indexReadBuffer.empty()) {
-    fillBuffer(ctx);
+    if (_collect) {
+      fillBufferCollected(ctx);
+    } else {
+      fillBuffer(ctx);
+    }
   }
 
   if (_indexReadBuffer.empty()) {
@@ -534,13 +1193,6 @@ bool IResearchViewExecutor<ordered>::next(ReadContext& ctx) {
   return false;
 }
 
-inline irs::columnstore_reader::values_reader_f pkColumn(irs::sub_reader const& segment) {
-  auto const* reader =
-      segment.column_reader(arangodb::iresearch::DocumentPrimaryKey::PK());
-
-  return reader ? reader->values() : irs::columnstore_reader::values_reader_f{};
-}
-
 template <bool ordered>
 bool IResearchViewExecutor<ordered>::resetIterator() {
   TRI_ASSERT(_filter);
@@ -559,6 +1211,10 @@ bool IResearchViewExecutor<ordered>::resetIterator() {
 
   _itr = segmentReader.mask(_filter->execute(segmentReader, _order, _filterCtx));
 
+  if (!infos().storedValues().empty()) {
+    _storedReader = ::storedValuesColumn(segmentReader);
+  }
+
   if /* constexpr */ (ordered) {
     _scr = _itr->attributes().get<irs::score>().get();
 
@@ -618,6 +1274,7 @@ void IResearchViewExecutor<ordered>::reset() {
   // reset iterator state
   _itr.reset();
   _readerOffset = 0;
+  _collected = false;
 
   // The rest is from IResearchViewBlockBase::reset():
   _ctx._inputRow = _inputRow;
@@ -662,6 +1319,12 @@ void IResearchViewExecutor<ordered>::reset() {
     // compile filter
     _filter = root.prepare(*_reader, _order, irs::boost::no_boost(), _filterCtx);
 
+    // expression filters can only be evaluated by this thread
+    _hasExpressionFilter = ::hasExpressionFilter(root);
+    _collect = topK() || !infos().facet().empty() ||
+               (infos().parallelism() > 1 && !_hasExpressionFilter &&
+                _reader->size() > 1);
+
     _isInitialized = true;
   }
 }
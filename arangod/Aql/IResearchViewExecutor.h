@@ -33,6 +33,8 @@
 #include "Indexes/IndexIterator.h"
 #include "VocBase/LocalDocumentId.h"
 
+#include <velocypack/Builder.h>
+
 namespace iresearch {
 class score;
 }
@@ -55,8 +57,12 @@ class IResearchViewExecutorInfos : public ExecutorInfos {
   IResearchViewExecutorInfos(
       ExecutorInfos&& infos, std::shared_ptr<iresearch::IResearchView::Snapshot const> reader,
       RegisterId firstOutputRegister, RegisterId numScoreRegisters, Query& query,
-      std::vector<iresearch::Scorer> const& scorers, ExecutionPlan const& plan,
-      Variable const& outVariable, aql::AstNode const& filterCondition,
+      std::vector<iresearch::Scorer> const& scorers,
+      std::vector<std::pair<size_t, bool>> const& scorersSort,
+      size_t scorersSortLimit, std::vector<bool> const& primarySort,
+      size_t primarySortLimit, size_t parallelism,
+      std::vector<std::string> const& storedValues, std::string const& facet,
+      ExecutionPlan const& plan, Variable const& outVariable, aql::AstNode const& filterCondition,
       std::pair<bool, bool> volatility, VarInfoMap const& varInfoMap, int depth);
 
   RegisterId getOutputRegister() const;
@@ -68,6 +74,13 @@ class IResearchViewExecutorInfos : public ExecutorInfos {
   Query& getQuery() const noexcept;
 
   std::vector<iresearch::Scorer> const& scorers() const noexcept;
+  std::vector<std::pair<size_t, bool>> const& scorersSort() const noexcept;
+  size_t scorersSortLimit() const noexcept;
+  std::vector<bool> const& primarySort() const noexcept;
+  size_t primarySortLimit() const noexcept;
+  size_t parallelism() const noexcept;
+  std::vector<std::string> const& storedValues() const noexcept;
+  std::string const& facet() const noexcept;
   ExecutionPlan const& plan() const noexcept;
   Variable const& outVariable() const noexcept;
   aql::AstNode const& filterCondition() const noexcept;
@@ -85,6 +98,13 @@ class IResearchViewExecutorInfos : public ExecutorInfos {
   Query& _query;
 
   std::vector<iresearch::Scorer> const& _scorers;
+  std::vector<std::pair<size_t, bool>> const& _scorersSort;
+  size_t const _scorersSortLimit;
+  std::vector<bool> const& _primarySort;
+  size_t const _primarySortLimit;
+  size_t const _parallelism;
+  std::vector<std::string> const& _storedValues;
+  std::string const& _facet;
   ExecutionPlan const& _plan;
   Variable const& _outVariable;
   aql::AstNode const& _filterCondition;
@@ -115,6 +135,30 @@ inline ExecutionStats& operator+=(ExecutionStats& executionStats,
   return executionStats;
 }
 
+/// @brief the documents of one segment of a view snapshot matching the filter
+struct IResearchViewSegmentDocuments {
+  std::vector<LocalDocumentId> ids;
+  // getNumScoreRegisters() scores per entry of ids
+  std::vector<float_t> scores;
+  // the segment document of each entry of ids, if stored values are read
+  std::vector<irs::doc_id_t> docs;
+  // the primary sort values of each entry of ids, if ranked by them
+  std::vector<std::string> sortValues;
+  bool scored{false};
+  // whether only the best documents of the segment were kept
+  bool ranked{false};
+};
+
+/// @brief the number of documents of one segment of a view snapshot matching
+/// the filter per value of the facet attribute
+struct IResearchViewSegmentFacets {
+  // velocypack value -> number of documents
+  std::unordered_map<std::string, uint64_t> counts;
+  // the documents without stored values for the attribute, to be counted
+  // by reading them from the collection
+  std::vector<LocalDocumentId> ids;
+};
+
 template <bool ordered>
 class IResearchViewExecutor {
  public:
@@ -248,6 +292,27 @@ class IResearchViewExecutor {
 
     inline void pushScoreNone() { _scoreBuffer.emplace_back(); }
 
+    // the stored values of a document, used instead of the document if they
+    // contain all attributes the query needs. pushed either for all or for
+    // none of the documents
+    inline void pushStoredValues(irs::bytes_ref const& value) {
+      _storedOffsets.emplace_back(_storedBuffer.size());
+      _storedBuffer.append(reinterpret_cast<char const*>(value.c_str()), value.size());
+    }
+
+    inline void pushStoredValuesNone() {
+      _storedOffsets.emplace_back(std::string::npos);
+    }
+
+    inline uint8_t const* getStoredValues(IndexReadBufferEntry const bufferEntry) const {
+      if (bufferEntry._keyIdx >= _storedOffsets.size() ||
+          _storedOffsets[bufferEntry._keyIdx] == std::string::npos) {
+        return nullptr;
+      }
+      return reinterpret_cast<uint8_t const*>(_storedBuffer.data()) +
+             _storedOffsets[bufferEntry._keyIdx];
+    }
+
     inline void setCollectionAndReset(std::shared_ptr<arangodb::LogicalCollection>&& collection) {
       // Should only be called after everything was consumed
       TRI_ASSERT(empty());
@@ -256,6 +321,8 @@ class IResearchViewExecutor {
       _keyBaseIdx = 0;
       _keyBuffer.clear();
       _scoreBuffer.clear();
+      _storedBuffer.clear();
+      _storedOffsets.clear();
     }
 
     inline std::size_t size() const {
@@ -292,6 +359,9 @@ class IResearchViewExecutor {
     // .
     std::vector<LocalDocumentId> _keyBuffer;
     std::vector<AqlValue> _scoreBuffer;
+    // stored values of _keyBuffer[i] at _storedBuffer[_storedOffsets[i]]
+    std::string _storedBuffer;
+    std::vector<size_t> _storedOffsets;
     std::shared_ptr<arangodb::LogicalCollection> _collection;
     std::size_t _numScoreRegisters;
     std::size_t _keyBaseIdx;
@@ -307,8 +377,26 @@ class IResearchViewExecutor {
 
   void fillBuffer(ReadContext& ctx);
 
+  // pushes the stored values of a document if they cover storedValues()
+  void pushStoredValues(irs::columnstore_reader::values_reader_f const& reader,
+                        irs::doc_id_t docId);
+
+  // whether only the best documents of the current input row by
+  // scorersSort() or primarySort() are produced
+  bool topK() const noexcept;
+
+  // collects the documents of all segments for the current input row, in
+  // parallel if allowed
+  void collectDocuments();
+  void fillBufferCollected(ReadContext& ctx);
+
   bool writeRow(ReadContext& ctx, IndexReadBufferEntry bufferEntry);
 
+  // counts the documents of all segments for the current input row per value
+  // of the facet attribute, in parallel if allowed
+  void collectFacets();
+  bool writeFacet(ReadContext& ctx);
+
   bool resetIterator();
 
   void reset();
@@ -336,12 +424,30 @@ class IResearchViewExecutor {
 
   // IResearchViewUnorderedBlock members:
   irs::columnstore_reader::values_reader_f _pkReader;  // current primary key reader
+  irs::columnstore_reader::values_reader_f _storedReader;  // current stored values reader
   irs::doc_iterator::ptr _itr;
   size_t _readerOffset;
 
   // IResearchViewBlock members (i.e., case ordered only):
   irs::score const* _scr;
   irs::bytes_ref _scrVal;
+
+  // whether the filter evaluates AQL expressions
+  bool _hasExpressionFilter;
+
+  // the documents of an input row are collected before producing them, in
+  // the top-k and the parallel case. _documents are the reader offset and
+  // index into _segments[reader offset] of each document to produce
+  bool _collect;
+  std::vector<IResearchViewSegmentDocuments> _segments;
+  std::vector<std::pair<size_t, size_t>> _documents;
+  size_t _documentsOffset;
+  bool _collected;
+
+  // the value and number of documents of each facet of the current input row
+  std::vector<std::pair<std::string, uint64_t>> _facets;
+  size_t _facetsOffset;
+  velocypack::Builder _facetBuilder;
 };
 
 }  // namespace aql
@@ -51,6 +51,9 @@ namespace {
 using namespace arangodb;
 using namespace arangodb::iresearch;
 
+/// @brief maximal number of threads searching the segments of a view
+constexpr size_t MaxParallelism = 64;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief surrogate root for all queries without a filter
 ////////////////////////////////////////////////////////////////////////////////
@@ -128,6 +131,7 @@ std::vector<Scorer> fromVelocyPack(aql::ExecutionPlan& plan, velocypack::Slice c
 void toVelocyPack(velocypack::Builder& builder, IResearchViewNode::Options const& options) {
   VPackObjectBuilder objectScope(&builder);
   builder.add("waitForSync", VPackValue(options.forceSync));
+  builder.add("parallelism", VPackValue(options.parallelism));
 
   if (!options.restrictSources) {
     builder.add("collections", VPackValue(VPackValueType::Null));
@@ -163,6 +167,20 @@ bool fromVelocyPack(velocypack::Slice optionsSlice, IResearchViewNode::Options&
     }
   }
 
+  // parallelism
+  {
+    auto const optionSlice = optionsSlice.get("parallelism");
+
+    if (!optionSlice.isNone()) {
+      // 'parallelism' is optional
+      if (!optionSlice.isInteger() || optionSlice.getNumber<int64_t>() < 1) {
+        return false;
+      }
+
+      options.parallelism = optionSlice.getNumber<size_t>();
+    }
+  }
+
   // collections
   {
     auto const optionSlice = optionsSlice.get("collections");
@@ -294,6 +312,17 @@ bool parseOptions(aql::Query& query, LogicalView const& view, aql::AstNode const
 
          options.forceSync = value.getBoolValue();
          return true;
+       }},
+      {"parallelism", [](aql::Query& /*query*/, LogicalView const& /*view*/,
+                         aql::AstNode const& value,
+                         IResearchViewNode::Options& options, std::string& error) {
+         if (!value.isValueType(aql::VALUE_TYPE_INT) || value.getIntValue() < 1) {
+           error = "positive integer value expected for option 'parallelism'";
+           return false;
+         }
+
+         options.parallelism = std::min<size_t>(value.getIntValue(), MaxParallelism);
+         return true;
        }}};
 
   if (!optionsNode) {
@@ -761,6 +790,71 @@ IResearchViewNode::IResearchViewNode(aql::ExecutionPlan& plan, velocypack::Slice
   if (volatilityMaskSlice.isNumber()) {
     _volatilityMask = volatilityMaskSlice.getNumber<int>();
   }
+
+  // sort by scorers
+  auto const scorersSortSlice = base.get("scorersSort");
+
+  if (scorersSortSlice.isArray()) {
+    for (auto const sortSlice : velocypack::ArrayIterator(scorersSortSlice)) {
+      auto const indexSlice = sortSlice.get("index");
+      auto const ascSlice = sortSlice.get("asc");
+
+      if (!indexSlice.isInteger() || !ascSlice.isBool() ||
+          indexSlice.getNumber<size_t>() >= _scorers.size()) {
+        THROW_ARANGO_EXCEPTION_MESSAGE(
+            TRI_ERROR_BAD_PARAMETER,
+            "invalid vpack format, 'scorersSort' is intended to be an array "
+            "of scorer indices and directions");
+      }
+
+      _scorersSort.emplace_back(indexSlice.getNumber<size_t>(), ascSlice.getBool());
+    }
+
+    _scorersSortLimit = base.get("scorersSortLimit").getNumber<size_t>();
+  }
+
+  // sort by primary sort
+  auto const primarySortSlice = base.get("primarySort");
+
+  if (primarySortSlice.isArray()) {
+    for (auto const ascSlice : velocypack::ArrayIterator(primarySortSlice)) {
+      if (!ascSlice.isBool()) {
+        THROW_ARANGO_EXCEPTION_MESSAGE(
+            TRI_ERROR_BAD_PARAMETER,
+            "invalid vpack format, 'primarySort' is intended to be an array "
+            "of directions");
+      }
+
+      _primarySort.emplace_back(ascSlice.getBool());
+    }
+
+    _primarySortLimit = base.get("primarySortLimit").getNumber<size_t>();
+  }
+
+  // stored values
+  auto const storedValuesSlice = base.get("storedValues");
+
+  if (storedValuesSlice.isArray()) {
+    for (auto const attributeSlice : velocypack::ArrayIterator(storedValuesSlice)) {
+      if (!attributeSlice.isString()) {
+        THROW_ARANGO_EXCEPTION_MESSAGE(
+            TRI_ERROR_BAD_PARAMETER,
+            "invalid vpack format, 'storedValues' is intended to be an array "
+            "of attribute names");
+      }
+
+      _storedValues.emplace_back(attributeSlice.copyString());
+    }
+  }
+
+  // count per value of an attribute
+  auto const facetSlice = base.get("facet");
+
+  if (facetSlice.isString()) {
+    _facet = facetSlice.copyString();
+    _facetCountVariable =
+        aql::Variable::varFromVPack(plan.getAst(), base, "facetCountVariable");
+  }
 }
 
 void IResearchViewNode::planNodeRegisters(std::vector<aql::RegisterId>& nrRegsHere,
@@ -787,6 +881,13 @@ void IResearchViewNode::planNodeRegisters(std::vector<aql::RegisterId>& nrRegsHe
     ++nrRegs[depth];
     varInfo.emplace(scorer.var->id, VarInfo(depth, totalNrRegs++));
   }
+
+  // plan register for the counts of facets, after the scores
+  if (_facetCountVariable != nullptr) {
+    ++nrRegsHere[depth];
+    ++nrRegs[depth];
+    varInfo.emplace(_facetCountVariable->id, VarInfo(depth, totalNrRegs++));
+  }
 }
 
 std::pair<bool, bool> IResearchViewNode::volatility(bool force /*=false*/) const {
@@ -842,6 +943,45 @@ void IResearchViewNode::toVelocyPackHelper(VPackBuilder& nodes, unsigned flags)
   // volatility mask
   nodes.add("volatility", VPackValue(_volatilityMask));
 
+  // sort by scorers
+  if (!_scorersSort.empty()) {
+    {
+      VPackArrayBuilder arrayScope(&nodes, "scorersSort");
+      for (auto const& sort : _scorersSort) {
+        VPackObjectBuilder objectScope(&nodes);
+        nodes.add("index", VPackValue(sort.first));
+        nodes.add("asc", VPackValue(sort.second));
+      }
+    }
+    nodes.add("scorersSortLimit", VPackValue(_scorersSortLimit));
+  }
+
+  // sort by primary sort
+  if (!_primarySort.empty()) {
+    {
+      VPackArrayBuilder arrayScope(&nodes, "primarySort");
+      for (bool const asc : _primarySort) {
+        nodes.add(VPackValue(asc));
+      }
+    }
+    nodes.add("primarySortLimit", VPackValue(_primarySortLimit));
+  }
+
+  // stored values
+  if (!_storedValues.empty()) {
+    VPackArrayBuilder arrayScope(&nodes, "storedValues");
+    for (auto const& attribute : _storedValues) {
+      nodes.add(VPackValue(attribute));
+    }
+  }
+
+  // count per value of an attribute
+  if (_facetCountVariable != nullptr) {
+    nodes.add("facet", VPackValue(_facet));
+    nodes.add(VPackValue("facetCountVariable"));
+    _facetCountVariable->toVelocyPack(nodes);
+  }
+
   nodes.close();
 }
 
@@ -884,9 +1024,13 @@ aql::ExecutionNode* IResearchViewNode::clone(aql::ExecutionPlan* plan, bool with
   TRI_ASSERT(plan);
 
   auto* outVariable = _outVariable;
+  auto* facetCountVariable = _facetCountVariable;
 
   if (withProperties) {
     outVariable = plan->getAst()->variables()->createVariable(outVariable);
+    if (facetCountVariable != nullptr) {
+      facetCountVariable = plan->getAst()->variables()->createVariable(facetCountVariable);
+    }
   }
 
   auto node =
@@ -896,6 +1040,13 @@ aql::ExecutionNode* IResearchViewNode::clone(aql::ExecutionPlan* plan, bool with
   node->_shards = _shards;
   node->_options = _options;
   node->_volatilityMask = _volatilityMask;
+  node->_scorersSort = _scorersSort;
+  node->_scorersSortLimit = _scorersSortLimit;
+  node->_primarySort = _primarySort;
+  node->_primarySortLimit = _primarySortLimit;
+  node->_storedValues = _storedValues;
+  node->_facet = _facet;
+  node->_facetCountVariable = facetCountVariable;
 
   return cloneHelper(std::move(node), withDependencies, withProperties);
 }
@@ -1043,19 +1194,23 @@ std::unique_ptr<aql::ExecutionBlock> IResearchViewNode::createBlock(
   aql::RegisterId const firstOutputRegister = getNrInputRegisters();
   auto numScoreRegisters = static_cast<aql::RegisterId>(_scorers.size());
 
+  // The count of facets is written to the register after these.
+  aql::RegisterId const numCountRegisters = _facetCountVariable != nullptr ? 1 : 0;
+
   // We have one additional output register for each scorer, consecutively after
   // the output register for documents. These must of course fit in the
   // available registers. There may be unused registers reserved for later
   // blocks.
-  TRI_ASSERT(getNrInputRegisters() + 1 + numScoreRegisters <= getNrOutputRegisters());
+  TRI_ASSERT(getNrInputRegisters() + 1 + numScoreRegisters + numCountRegisters <=
+             getNrOutputRegisters());
   std::shared_ptr<std::unordered_set<aql::RegisterId>> writableOutputRegisters =
       aql::make_shared_unordered_set();
-  writableOutputRegisters->reserve(1 + numScoreRegisters);
+  writableOutputRegisters->reserve(1 + numScoreRegisters + numCountRegisters);
   for (aql::RegisterId reg = firstOutputRegister;
-       reg < firstOutputRegister + numScoreRegisters + 1; reg++) {
+       reg < firstOutputRegister + numScoreRegisters + numCountRegisters + 1; reg++) {
     writableOutputRegisters->emplace(reg);
   }
-  TRI_ASSERT(writableOutputRegisters->size() == 1 + numScoreRegisters);
+  TRI_ASSERT(writableOutputRegisters->size() == 1 + numScoreRegisters + numCountRegisters);
   TRI_ASSERT(writableOutputRegisters->begin() != writableOutputRegisters->end());
   TRI_ASSERT(firstOutputRegister == *std::min_element(writableOutputRegisters->begin(),
                                                       writableOutputRegisters->end()));
@@ -1067,6 +1222,13 @@ std::unique_ptr<aql::ExecutionBlock> IResearchViewNode::createBlock(
                                                 numScoreRegisters,
                                                 *engine.getQuery(),
                                                 scorers(),
+                                                scorersSort(),
+                                                scorersSortLimit(),
+                                                primarySort(),
+                                                primarySortLimit(),
+                                                _options.parallelism,
+                                                storedValues(),
+                                                facet(),
                                                 *plan(),
                                                 outVariable(),
                                                 filterCondition(),
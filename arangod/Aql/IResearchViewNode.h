@@ -53,6 +53,11 @@ class IResearchViewNode final : public arangodb::aql::ExecutionNode {
 
     /// @brief sync view before querying to get the latest index snapshot
     bool forceSync{false};
+
+    /// @brief number of threads evaluating the filter on the segments of
+    /// the snapshot, the documents of all segments are collected before
+    /// they are produced if greater than 1
+    size_t parallelism{1};
   };  // Options
 
   IResearchViewNode(aql::ExecutionPlan& plan, size_t id, TRI_vocbase_t& vocbase,
@@ -88,6 +93,10 @@ class IResearchViewNode final : public arangodb::aql::ExecutionNode {
     *std::transform(_scorers.begin(), _scorers.end(), vars.begin(),
                     [](auto const& scorer) { return scorer.var; }) = _outVariable;
 
+    if (_facetCountVariable != nullptr) {
+      vars.emplace_back(_facetCountVariable);
+    }
+
     return vars;
   }
 
@@ -130,6 +139,61 @@ class IResearchViewNode final : public arangodb::aql::ExecutionNode {
     _scorers = std::move(scorers);
   }
 
+  /// @brief the scorers a following SORT sorts by, as index into scorers()
+  /// and ascending flag. if not empty, only the best scorersSortLimit()
+  /// documents are produced for each input row
+  std::vector<std::pair<size_t, bool>> const& scorersSort() const noexcept {
+    return _scorersSort;
+  }
+
+  size_t scorersSortLimit() const noexcept { return _scorersSortLimit; }
+
+  void scorersSort(std::vector<std::pair<size_t, bool>>&& sort, size_t limit) noexcept {
+    _scorersSort = std::move(sort);
+    _scorersSortLimit = limit;
+  }
+
+  /// @brief the ascending flags of the leading fields of the primary sort of
+  /// the view a following SORT sorts by. if not empty, only the first
+  /// primarySortLimit() documents in this order are produced for each input
+  /// row
+  std::vector<bool> const& primarySort() const noexcept {
+    return _primarySort;
+  }
+
+  size_t primarySortLimit() const noexcept { return _primarySortLimit; }
+
+  void primarySort(std::vector<bool>&& directions, size_t limit) noexcept {
+    _primarySort = std::move(directions);
+    _primarySortLimit = limit;
+  }
+
+  /// @brief the top-level attributes of the documents used by the query, if
+  /// the documents are only used via these. the attributes are read from the
+  /// stored values of the links instead of the documents where possible
+  std::vector<std::string> const& storedValues() const noexcept {
+    return _storedValues;
+  }
+
+  void storedValues(std::vector<std::string>&& attributes) noexcept {
+    _storedValues = std::move(attributes);
+  }
+
+  /// @brief the top-level attribute a following COLLECT groups by, if the
+  /// documents are only counted per value of this attribute. the view then
+  /// produces one document per distinct value with only this attribute, and
+  /// the number of matching documents with the value in facetCountVariable()
+  std::string const& facet() const noexcept { return _facet; }
+
+  aql::Variable const* facetCountVariable() const noexcept {
+    return _facetCountVariable;
+  }
+
+  void facet(std::string const& attribute, aql::Variable const* countVariable) {
+    _facet = attribute;
+    _facetCountVariable = countVariable;
+  }
+
   /// @brief getVariablesUsedHere, modifying the set in-place
   void getVariablesUsedHere(arangodb::HashSet<aql::Variable const*>& vars) const override final;
 
@@ -173,6 +237,21 @@ class IResearchViewNode final : public arangodb::aql::ExecutionNode {
   /// @brief scorers related to the view
   std::vector<Scorer> _scorers;
 
+  /// @brief sort by scorers of a following SORT + LIMIT
+  std::vector<std::pair<size_t, bool>> _scorersSort;
+  size_t _scorersSortLimit{0};
+
+  /// @brief sort by the primary sort of the view of a following SORT + LIMIT
+  std::vector<bool> _primarySort;
+  size_t _primarySortLimit{0};
+
+  /// @brief attributes that may be read from the stored values
+  std::vector<std::string> _storedValues;
+
+  /// @brief attribute counted per value for a following COLLECT
+  std::string _facet;
+  aql::Variable const* _facetCountVariable{nullptr};
+
   /// @brief list of shards involved, need this for the cluster
   std::vector<std::string> _shards;
 
@@ -24,6 +24,7 @@
 #include "IResearchViewOptimizerRules.h"
 
 #include "Aql/ClusterNodes.h"
+#include "Aql/CollectNode.h"
 #include "Aql/Condition.h"
 #include "Aql/ExecutionNode.h"
 #include "Aql/ExecutionPlan.h"
@@ -34,9 +35,11 @@
 #include "Aql/SortCondition.h"
 #include "Aql/SortNode.h"
 #include "Aql/WalkerWorker.h"
+#include "Basics/StaticStrings.h"
 #include "Cluster/ServerState.h"
 #include "IResearch/AqlHelper.h"
 #include "IResearch/IResearchView.h"
+#include "IResearch/IResearchViewCoordinator.h"
 #include "IResearch/IResearchFilterFactory.h"
 #include "IResearch/IResearchOrderFactory.h"
 #include "Utils/CollectionNameResolver.h"
@@ -233,6 +236,297 @@ bool optimizeSort(IResearchViewNode& viewNode, ExecutionPlan* plan) {
   }
 }
 
+/// @brief lets the view produce only the best documents of each input row if
+/// it is followed by a SORT on its scorers and a LIMIT, separated by
+/// calculations only. the SORT and LIMIT stay in place, the view just saves
+/// reading the documents that would be dropped anyway
+bool optimizeScoreSort(IResearchViewNode& viewNode) {
+  auto const& scorers = viewNode.scorers();
+
+  if (scorers.empty()) {
+    return false;
+  }
+
+  // variables that are just references to other variables
+  std::unordered_map<VariableId, Variable const*> references;
+  SortNode const* sortNode = nullptr;
+  ExecutionNode* current = viewNode.getFirstParent();
+
+  for (; current != nullptr; current = current->getFirstParent()) {
+    if (current->getType() == EN::CALCULATION) {
+      auto const* calculation = ExecutionNode::castTo<CalculationNode const*>(current);
+      auto const* expression = calculation->expression()->node();
+      if (expression->type == NODE_TYPE_REFERENCE) {
+        references.emplace(calculation->outVariable()->id,
+                           static_cast<Variable const*>(expression->getData()));
+      }
+      continue;
+    }
+
+    if (current->getType() == EN::SORT && sortNode == nullptr) {
+      sortNode = ExecutionNode::castTo<SortNode const*>(current);
+      continue;
+    }
+
+    // anything else may change the number of results
+    break;
+  }
+
+  if (sortNode == nullptr || current == nullptr || current->getType() != EN::LIMIT) {
+    return false;
+  }
+
+  auto const* limitNode = ExecutionNode::castTo<LimitNode const*>(current);
+
+  if (limitNode->fullCount()) {
+    // the LIMIT has to see all documents
+    return false;
+  }
+
+  std::vector<std::pair<size_t, bool>> sort;
+  sort.reserve(sortNode->elements().size());
+
+  for (auto const& element : sortNode->elements()) {
+    Variable const* var = element.var;
+    for (auto it = references.find(var->id); it != references.end();
+         it = references.find(var->id)) {
+      var = it->second;
+    }
+
+    if (!element.attributePath.empty()) {
+      return false;
+    }
+
+    auto scorer = std::find_if(scorers.begin(), scorers.end(),
+                               [var](Scorer const& scorer) { return scorer.var == var; });
+
+    if (scorer == scorers.end()) {
+      // not sorting by scorers of this view
+      return false;
+    }
+
+    sort.emplace_back(std::distance(scorers.begin(), scorer), element.ascending);
+  }
+
+  viewNode.scorersSort(std::move(sort), limitNode->offset() + limitNode->limit());
+  return true;
+}
+
+/// @returns the primary sort of the view of a view node
+IResearchViewMeta::Sort const& primarySort(IResearchViewNode const& viewNode) {
+  if (arangodb::ServerState::instance()->isCoordinator()) {
+    return arangodb::LogicalView::cast<IResearchViewCoordinator>(*viewNode.view()).primarySort();
+  }
+  return arangodb::LogicalView::cast<IResearchView>(*viewNode.view()).primarySort();
+}
+
+/// @brief lets the view produce only the first documents of each input row by
+/// its primary sort if it is followed by a SORT on leading fields of the
+/// primary sort and a LIMIT, separated by calculations only. the links store
+/// the primary sort values of each document, so the view ranks the documents
+/// by these and does not read the ones that would be dropped anyway. the SORT
+/// and LIMIT stay in place, as the segments are not ordered themselves
+bool optimizePrimarySort(IResearchViewNode& viewNode, ExecutionPlan& plan) {
+  auto const& primarySort = ::primarySort(viewNode);
+
+  if (primarySort.empty()) {
+    return false;
+  }
+
+  std::unordered_map<VariableId, AstNode const*> variableDefinitions;
+  SortNode const* sortNode = nullptr;
+  ExecutionNode* current = viewNode.getFirstParent();
+
+  for (; current != nullptr; current = current->getFirstParent()) {
+    if (current->getType() == EN::CALCULATION) {
+      auto const* calculation = ExecutionNode::castTo<CalculationNode const*>(current);
+      variableDefinitions.emplace(calculation->outVariable()->id,
+                                  calculation->expression()->node());
+      continue;
+    }
+
+    if (current->getType() == EN::SORT && sortNode == nullptr) {
+      sortNode = ExecutionNode::castTo<SortNode const*>(current);
+      continue;
+    }
+
+    // anything else may change the number of results
+    break;
+  }
+
+  if (sortNode == nullptr || current == nullptr || current->getType() != EN::LIMIT) {
+    return false;
+  }
+
+  auto const* limitNode = ExecutionNode::castTo<LimitNode const*>(current);
+
+  if (limitNode->fullCount()) {
+    // the LIMIT has to see all documents
+    return false;
+  }
+
+  auto const& sortElements = sortNode->elements();
+
+  if (sortElements.size() > primarySort.size()) {
+    return false;
+  }
+
+  std::vector<std::pair<Variable const*, bool>> sorts;
+  std::vector<bool> directions;
+  sorts.reserve(sortElements.size());
+  directions.reserve(sortElements.size());
+
+  for (size_t i = 0; i < sortElements.size(); ++i) {
+    if (!sortElements[i].attributePath.empty() ||
+        sortElements[i].ascending != primarySort.direction(i)) {
+      return false;
+    }
+
+    auto const& field = primarySort.field(i);
+    if (field.size() == 1 && field[0].name == arangodb::StaticStrings::IdString) {
+      // the stored values of '_id' are custom velocypack values, which can
+      // not be compared without the collection
+      return false;
+    }
+
+    sorts.emplace_back(sortElements[i].var, sortElements[i].ascending);
+    directions.emplace_back(sortElements[i].ascending);
+  }
+
+  SortCondition sortCondition(&plan, sorts,
+                              std::vector<std::vector<arangodb::basics::AttributeName>>(),
+                              variableDefinitions);
+
+  if (sortCondition.isEmpty() || !sortCondition.isOnlyAttributeAccess() ||
+      sortCondition.coveredAttributes(&viewNode.outVariable(), primarySort.fields()) <
+          sortElements.size()) {
+    // not sorting by the leading fields of the primary sort
+    return false;
+  }
+
+  viewNode.primarySort(std::move(directions), limitNode->offset() + limitNode->limit());
+  return true;
+}
+
+/// @brief lets the view read the attributes of its documents from the stored
+/// values of its links if the documents are only used via top-level attribute
+/// accesses in calculations
+bool optimizeStoredValues(IResearchViewNode& viewNode) {
+  Variable const* v = &viewNode.outVariable();
+  arangodb::HashSet<Variable const*> vars;
+  std::unordered_set<std::string> attributes;
+
+  for (ExecutionNode* current = viewNode.getFirstParent(); current != nullptr;
+       current = current->getFirstParent()) {
+    vars.clear();
+    current->getVariablesUsedHere(vars);
+    if (vars.find(v) == vars.end()) {
+      continue;
+    }
+    if (current->getType() != EN::CALCULATION ||
+        !Ast::getReferencedAttributes(
+            ExecutionNode::castTo<CalculationNode const*>(current)->expression()->node(),
+            v, attributes)) {
+      return false;
+    }
+  }
+
+  if (attributes.empty()) {
+    return false;
+  }
+
+  std::vector<std::string> storedValues(attributes.begin(), attributes.end());
+  std::sort(storedValues.begin(), storedValues.end());
+  viewNode.storedValues(std::move(storedValues));
+  return true;
+}
+
+/// @brief lets the view count its documents per value of an attribute if
+/// they are only used by a following COLLECT grouping by this attribute,
+/// separated by calculations and sorts only, with counting aggregates. the
+/// view counts the values of the stored values of its links without
+/// producing the documents, and produces one document per value with its
+/// count instead. the COLLECT sums up these counts
+bool optimizeFacet(IResearchViewNode& viewNode, ExecutionPlan& plan) {
+  auto const& storedValues = viewNode.storedValues();
+
+  if (!viewNode.scorers().empty() || storedValues.size() != 1) {
+    return false;
+  }
+
+  std::unordered_map<VariableId, AstNode const*> variableDefinitions;
+  CollectNode* collectNode = nullptr;
+
+  for (ExecutionNode* current = viewNode.getFirstParent(); current != nullptr;
+       current = current->getFirstParent()) {
+    if (current->getType() == EN::CALCULATION) {
+      auto const* calculation = ExecutionNode::castTo<CalculationNode const*>(current);
+      variableDefinitions.emplace(calculation->outVariable()->id,
+                                  calculation->expression()->node());
+      continue;
+    }
+
+    if (current->getType() == EN::SORT) {
+      // reorders the documents only
+      continue;
+    }
+
+    if (current->getType() == EN::COLLECT) {
+      collectNode = ExecutionNode::castTo<CollectNode*>(current);
+    }
+
+    break;
+  }
+
+  if (collectNode == nullptr || collectNode->groupVariables().size() != 1 ||
+      collectNode->hasExpressionVariable() || collectNode->hasKeepVariables() ||
+      collectNode->hasOutVariableButNoCount()) {
+    return false;
+  }
+
+  auto aggregates = collectNode->aggregateVariables();
+
+  for (auto const& aggregate : aggregates) {
+    if (aggregate.second.second != "LENGTH" && aggregate.second.second != "COUNT") {
+      return false;
+    }
+  }
+
+  auto const definition =
+      variableDefinitions.find(collectNode->groupVariables().front().second->id);
+
+  if (definition == variableDefinitions.end()) {
+    return false;
+  }
+
+  auto const* access = definition->second;
+
+  if (access->type != NODE_TYPE_ATTRIBUTE_ACCESS ||
+      access->getMember(0)->type != NODE_TYPE_REFERENCE ||
+      static_cast<Variable const*>(access->getMember(0)->getData()) != &viewNode.outVariable() ||
+      access->getString() != storedValues.front()) {
+    // not grouping by the attribute itself
+    return false;
+  }
+
+  auto* countVariable = plan.getAst()->variables()->createTemporaryVariable();
+
+  for (auto& aggregate : aggregates) {
+    aggregate.second = std::make_pair(countVariable, std::string("SUM"));
+  }
+
+  if (collectNode->count()) {
+    aggregates.emplace_back(collectNode->outVariable(),
+                            std::make_pair(countVariable, std::string("SUM")));
+    collectNode->count(false);
+    collectNode->clearOutVariable();
+  }
+
+  collectNode->setAggregateVariables(aggregates);
+  viewNode.facet(storedValues.front(), countVariable);
+  return true;
+}
+
 }  // namespace
 
 namespace arangodb {
@@ -297,6 +591,17 @@ void handleViewsRule(arangodb::aql::Optimizer* opt,
     scorerReplacer.extract(viewNode.outVariable(), scorers);
     viewNode.scorers(std::move(scorers));
 
+    // produce only as many documents as a following SORT and LIMIT keep
+    if (!optimizeScoreSort(viewNode)) {
+      optimizePrimarySort(viewNode, *plan);
+    }
+
+    // read only the attributes used by the query where possible, and count
+    // them for a following COLLECT
+    if (optimizeStoredValues(viewNode)) {
+      optimizeFacet(viewNode, *plan);
+    }
+
     modified = true;
   }
 
@@ -0,0 +1,167 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "IndexCollectExecutor.h"
+
+#include "Aql/AqlValue.h"
+#include "Aql/OutputAqlItemRow.h"
+#include "Aql/SingleRowFetcher.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Indexes/IndexIterator.h"
+#include "Transaction/Context.h"
+
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+/// @brief number of index entries read at once
+constexpr uint64_t readBatchSize = 1000;
+
+IndexIteratorOptions sortedScanOptions() {
+  IndexIteratorOptions options;
+  options.sorted = true;
+  options.ascending = true;
+  return options;
+}
+
+std::shared_ptr<std::unordered_set<RegisterId>> outputRegisters(RegisterId groupRegister,
+                                                                RegisterId countRegister) {
+  if (countRegister == ExecutionNode::MaxRegisterId) {
+    return make_shared_unordered_set({groupRegister});
+  }
+  return make_shared_unordered_set({groupRegister, countRegister});
+}
+}  // namespace
+
+IndexCollectExecutorInfos::IndexCollectExecutorInfos(
+    RegisterId groupRegister, RegisterId countRegister, RegisterId nrInputRegisters,
+    RegisterId nrOutputRegisters,
+    // cppcheck-suppress passedByValue
+    std::unordered_set<RegisterId> registersToClear,
+    // cppcheck-suppress passedByValue
+    std::unordered_set<RegisterId> registersToKeep,
+    transaction::Methods::IndexHandle const& index, transaction::Methods* trxPtr)
+    : ExecutorInfos(make_shared_unordered_set(),
+                    ::outputRegisters(groupRegister, countRegister),
+                    nrInputRegisters, nrOutputRegisters,
+                    std::move(registersToClear), std::move(registersToKeep)),
+      _groupRegisterId(groupRegister),
+      _countRegisterId(countRegister),
+      _index(index),
+      _trxPtr(trxPtr) {}
+
+IndexCollectExecutor::IndexCollectExecutor(Fetcher& fetcher, Infos& infos)
+    : _infos(infos),
+      _fetcher(fetcher),
+      _state(ExecutionState::HASMORE),
+      _input(InputAqlItemRow{CreateInvalidInputRowHint{}}),
+      _cursorHasMore(false) {
+  // a null condition makes the index return all its entries in order
+  _cursor = std::make_unique<OperationCursor>(_infos.getTrxPtr()->indexScanForCondition(
+      _infos.getIndex(), nullptr, nullptr, ::sortedScanOptions()));
+}
+
+IndexCollectExecutor::~IndexCollectExecutor() = default;
+
+void IndexCollectExecutor::initializeCursor() {
+  _state = ExecutionState::HASMORE;
+  _input = InputAqlItemRow{CreateInvalidInputRowHint{}};
+  _cursorHasMore = false;
+  _groups.clear();
+  _cursor->reset();
+}
+
+std::pair<ExecutionState, IndexCollectExecutor::Stats> IndexCollectExecutor::produceRows(
+    OutputAqlItemRow& output) {
+  TRI_IF_FAILURE("IndexCollectExecutor::produceRows") {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  }
+  Stats stats{};
+
+  while (!output.isFull()) {
+    if (_groups.size() > (_cursorHasMore ? 1 : 0)) {
+      writeGroup(output, _groups.front());
+      _groups.pop_front();
+      continue;
+    }
+
+    if (_cursorHasMore) {
+      readGroups(stats);
+      continue;
+    }
+
+    std::tie(_state, _input) = _fetcher.fetchRow();
+
+    if (_state == ExecutionState::WAITING) {
+      return {_state, stats};
+    }
+
+    if (!_input) {
+      TRI_ASSERT(_state == ExecutionState::DONE);
+      return {_state, stats};
+    }
+
+    _cursor->reset();
+    _cursorHasMore = _cursor->hasMore();
+  }
+
+  if (_state == ExecutionState::DONE && !_cursorHasMore && _groups.empty()) {
+    return {ExecutionState::DONE, stats};
+  }
+  return {ExecutionState::HASMORE, stats};
+}
+
+void IndexCollectExecutor::readGroups(Stats& stats) {
+  VPackOptions const* options = _infos.getTrxPtr()->transactionContextPtr()->getVPackOptions();
+
+  _cursorHasMore = _cursor->nextCovering(
+      [&](LocalDocumentId const&, VPackSlice values) {
+        // the values of all index fields, the first one is grouped by
+        VPackSlice value = values.isArray() ? values.at(0) : values;
+        stats.incrScanned();
+        if (_groups.empty() ||
+            basics::VelocyPackHelper::compare(_groups.back().value.slice(), value,
+                                              true, options) != 0) {
+          _groups.emplace_back();
+          _groups.back().value.add(value);
+          _groups.back().count = 0;
+        }
+        ++_groups.back().count;
+      },
+      ::readBatchSize);
+}
+
+void IndexCollectExecutor::writeGroup(OutputAqlItemRow& output, Group const& group) {
+  AqlValue value{group.value.slice()};
+  AqlValueGuard guard{value, true};
+  output.moveValueInto(_infos.getGroupRegisterId(), _input, guard);
+
+  if (_infos.getCountRegisterId() != ExecutionNode::MaxRegisterId) {
+    AqlValue count{AqlValueHintUInt(group.count)};
+    AqlValueGuard countGuard{count, true};
+    output.moveValueInto(_infos.getCountRegisterId(), _input, countGuard);
+  }
+
+  TRI_ASSERT(output.produced());
+  output.advanceRow();
+}
@@ -0,0 +1,143 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef ARANGOD_AQL_INDEX_COLLECT_EXECUTOR_H
+#define ARANGOD_AQL_INDEX_COLLECT_EXECUTOR_H
+
+#include "Aql/ExecutionState.h"
+#include "Aql/ExecutorInfos.h"
+#include "Aql/InputAqlItemRow.h"
+#include "Aql/Stats.h"
+#include "Aql/types.h"
+#include "Transaction/Methods.h"
+#include "Utils/OperationCursor.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <deque>
+#include <memory>
+
+namespace arangodb {
+namespace aql {
+
+class OutputAqlItemRow;
+
+template <bool>
+class SingleRowFetcher;
+
+class IndexCollectExecutorInfos : public ExecutorInfos {
+ public:
+  IndexCollectExecutorInfos(RegisterId groupRegister, RegisterId countRegister,
+                            RegisterId nrInputRegisters, RegisterId nrOutputRegisters,
+                            std::unordered_set<RegisterId> registersToClear,
+                            std::unordered_set<RegisterId> registersToKeep,
+                            transaction::Methods::IndexHandle const& index,
+                            transaction::Methods* trxPtr);
+
+  IndexCollectExecutorInfos() = delete;
+  IndexCollectExecutorInfos(IndexCollectExecutorInfos&&) = default;
+  IndexCollectExecutorInfos(IndexCollectExecutorInfos const&) = delete;
+  ~IndexCollectExecutorInfos() = default;
+
+  transaction::Methods::IndexHandle const& getIndex() const { return _index; }
+  transaction::Methods* getTrxPtr() const { return _trxPtr; }
+  RegisterId getGroupRegisterId() const { return _groupRegisterId; }
+  /// @brief register for the counts, MaxRegisterId if not needed
+  RegisterId getCountRegisterId() const { return _countRegisterId; }
+
+ private:
+  RegisterId _groupRegisterId;
+  RegisterId _countRegisterId;
+  transaction::Methods::IndexHandle _index;
+  transaction::Methods* _trxPtr;
+};
+
+/**
+ * @brief Implementation of IndexCollect Node
+ *
+ * For every input row, the whole index is read in its sort order, using
+ * the values stored in the index entries only. Consecutive entries with
+ * the same value of the first index field form a group, which is written
+ * as soon as the next value starts.
+ */
+class IndexCollectExecutor {
+ public:
+  struct Properties {
+    static const bool preservesOrder = true;
+    static const bool allowsBlockPassthrough = false;
+    static const bool inputSizeRestrictsOutputSize = false;
+  };
+  using Fetcher = SingleRowFetcher<Properties::allowsBlockPassthrough>;
+  using Infos = IndexCollectExecutorInfos;
+  using Stats = IndexStats;
+
+  IndexCollectExecutor() = delete;
+  IndexCollectExecutor(IndexCollectExecutor&&) = default;
+  IndexCollectExecutor(IndexCollectExecutor const&) = delete;
+  IndexCollectExecutor(Fetcher& fetcher, Infos&);
+  ~IndexCollectExecutor();
+
+  /**
+   * @brief produce the next Rows of Aql Values.
+   *
+   * @return ExecutionState, and if successful at least one new Row of AqlItems.
+   */
+  std::pair<ExecutionState, Stats> produceRows(OutputAqlItemRow& output);
+
+  inline std::pair<ExecutionState, size_t> expectedNumberOfRows(size_t) const {
+    TRI_ASSERT(false);
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_INTERNAL,
+        "Logic_error, prefetching number fo rows not supported");
+  }
+
+  void initializeCursor();
+
+ private:
+  struct Group {
+    arangodb::velocypack::Builder value;
+    uint64_t count;
+  };
+
+  /// @brief read the next batch of index entries into _groups
+  void readGroups(Stats& stats);
+
+  void writeGroup(OutputAqlItemRow& output, Group const& group);
+
+ private:
+  Infos& _infos;
+  Fetcher& _fetcher;
+  ExecutionState _state;
+  InputAqlItemRow _input;
+
+  std::unique_ptr<OperationCursor> _cursor;
+  bool _cursorHasMore;
+
+  /// @brief groups not yet written. while the index has more entries, the
+  /// last one may still grow
+  std::deque<Group> _groups;
+};
+
+}  // namespace aql
+}  // namespace arangodb
+
+#endif
@@ -0,0 +1,154 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "IndexCollectNode.h"
+#include "Aql/Ast.h"
+#include "Aql/Collection.h"
+#include "Aql/ExecutionBlockImpl.h"
+#include "Aql/ExecutionPlan.h"
+#include "Aql/IndexCollectExecutor.h"
+#include "Aql/Query.h"
+#include "Aql/Variable.h"
+#include "Indexes/Index.h"
+#include "Transaction/Methods.h"
+
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+IndexCollectNode::IndexCollectNode(ExecutionPlan* plan, size_t id,
+                                   aql::Collection const* collection,
+                                   transaction::Methods::IndexHandle const& index,
+                                   Variable const* groupVariable,
+                                   Variable const* countVariable)
+    : ExecutionNode(plan, id),
+      CollectionAccessingNode(collection),
+      _index(index),
+      _groupVariable(groupVariable),
+      _countVariable(countVariable) {
+  TRI_ASSERT(_index.getIndex() != nullptr);
+  TRI_ASSERT(_groupVariable != nullptr);
+}
+
+IndexCollectNode::IndexCollectNode(ExecutionPlan* plan, arangodb::velocypack::Slice const& base)
+    : ExecutionNode(plan, base),
+      CollectionAccessingNode(plan, base),
+      _groupVariable(Variable::varFromVPack(plan->getAst(), base, "groupVariable")),
+      _countVariable(Variable::varFromVPack(plan->getAst(), base, "countVariable", true)) {
+  VPackSlice index = base.get("index");
+  if (!index.isObject()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                   "\"index\" attribute should be an object");
+  }
+  auto trx = plan->getAst()->query()->trx();
+  _index = trx->getIndexByIdentifier(_collection->name(), index.get("id").copyString());
+}
+
+/// @brief toVelocyPack, for IndexCollectNode
+void IndexCollectNode::toVelocyPackHelper(VPackBuilder& builder, unsigned flags) const {
+  // call base class method
+  ExecutionNode::toVelocyPackHelperGeneric(builder, flags);
+
+  builder.add(VPackValue("groupVariable"));
+  _groupVariable->toVelocyPack(builder);
+
+  if (_countVariable != nullptr) {
+    builder.add(VPackValue("countVariable"));
+    _countVariable->toVelocyPack(builder);
+  }
+
+  builder.add(VPackValue("index"));
+  _index.toVelocyPack(builder, Index::makeFlags(Index::Serialize::Estimates));
+
+  // add collection information
+  CollectionAccessingNode::toVelocyPack(builder);
+
+  // And close it:
+  builder.close();
+}
+
+/// @brief creates corresponding ExecutionBlock
+std::unique_ptr<ExecutionBlock> IndexCollectNode::createBlock(
+    ExecutionEngine& engine, std::unordered_map<ExecutionNode*, ExecutionBlock*> const&) const {
+  ExecutionNode const* previousNode = getFirstDependency();
+  TRI_ASSERT(previousNode != nullptr);
+
+  transaction::Methods* trxPtr = _plan->getAst()->query()->trx();
+
+  IndexCollectExecutorInfos infos(variableToRegisterId(_groupVariable),
+                                  (_countVariable != nullptr
+                                       ? variableToRegisterId(_countVariable)
+                                       : ExecutionNode::MaxRegisterId),
+                                  getRegisterPlan()->nrRegs[previousNode->getDepth()],
+                                  getRegisterPlan()->nrRegs[getDepth()],
+                                  getRegsToClear(), calcRegsToKeep(), _index, trxPtr);
+  return std::make_unique<ExecutionBlockImpl<IndexCollectExecutor>>(&engine, this,
+                                                                    std::move(infos));
+}
+
+/// @brief clone ExecutionNode recursively
+ExecutionNode* IndexCollectNode::clone(ExecutionPlan* plan, bool withDependencies,
+                                       bool withProperties) const {
+  auto groupVariable = _groupVariable;
+  auto countVariable = _countVariable;
+  if (withProperties) {
+    groupVariable = plan->getAst()->variables()->createVariable(groupVariable);
+    TRI_ASSERT(groupVariable != nullptr);
+    if (countVariable != nullptr) {
+      countVariable = plan->getAst()->variables()->createVariable(countVariable);
+    }
+  }
+
+  auto c = std::make_unique<IndexCollectNode>(plan, _id, _collection, _index,
+                                              groupVariable, countVariable);
+
+  c->_prototypeCollection = _prototypeCollection;
+  c->_prototypeOutVariable = _prototypeOutVariable;
+
+  return cloneHelper(std::move(c), withDependencies, withProperties);
+}
+
+/// @brief the number of groups is estimated from the selectivity of the
+/// index. for indexes on several attributes, this is the number of their
+/// distinct combinations, so it is an upper bound
+CostEstimate IndexCollectNode::estimateCost() const {
+  transaction::Methods* trx = _plan->getAst()->query()->trx();
+  if (trx->status() != transaction::Status::RUNNING) {
+    return CostEstimate::empty();
+  }
+
+  TRI_ASSERT(!_dependencies.empty());
+  CostEstimate estimate = _dependencies.at(0)->getCost();
+  size_t const incoming = estimate.estimatedNrItems;
+  size_t const count = _collection->count(trx);
+
+  double groups = static_cast<double>(count) * 0.8;
+  auto index = _index.getIndex();
+  if (index->hasSelectivityEstimate()) {
+    groups = static_cast<double>(count) * index->selectivityEstimate();
+  }
+
+  estimate.estimatedNrItems =
+      incoming * std::max<size_t>(1, static_cast<size_t>(groups));
+  estimate.estimatedCost += static_cast<double>(incoming) * static_cast<double>(count) + 1.0;
+  return estimate;
+}
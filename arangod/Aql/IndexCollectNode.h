@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef ARANGOD_AQL_INDEX_COLLECT_NODE_H
+#define ARANGOD_AQL_INDEX_COLLECT_NODE_H 1
+
+#include "Aql/CollectionAccessingNode.h"
+#include "Aql/ExecutionNode.h"
+#include "Aql/types.h"
+#include "Basics/Common.h"
+#include "Transaction/Methods.h"
+
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+namespace aql {
+struct Collection;
+class ExecutionBlock;
+class ExecutionEngine;
+class ExecutionPlan;
+
+/// @brief class IndexCollectNode
+/// replaces
+///   FOR doc IN collection COLLECT value = doc.attr [WITH COUNT INTO count]
+/// if the collection has a sorted index whose first field is attr. the
+/// index entries are read in order, and the groups are formed from the
+/// values stored in the index, without reading any documents
+class IndexCollectNode : public ExecutionNode, public CollectionAccessingNode {
+  friend class ExecutionNode;
+  friend class ExecutionBlock;
+
+ public:
+  IndexCollectNode(ExecutionPlan* plan, size_t id, aql::Collection const* collection,
+                   transaction::Methods::IndexHandle const& index,
+                   Variable const* groupVariable, Variable const* countVariable);
+
+  IndexCollectNode(ExecutionPlan* plan, arangodb::velocypack::Slice const& base);
+
+  /// @brief return the type of the node
+  NodeType getType() const override final { return INDEX_COLLECT; }
+
+  /// @brief export to VelocyPack
+  void toVelocyPackHelper(arangodb::velocypack::Builder&, unsigned flags) const override final;
+
+  /// @brief creates corresponding ExecutionBlock
+  std::unique_ptr<ExecutionBlock> createBlock(
+      ExecutionEngine& engine,
+      std::unordered_map<ExecutionNode*, ExecutionBlock*> const&) const override;
+
+  /// @brief clone ExecutionNode recursively
+  ExecutionNode* clone(ExecutionPlan* plan, bool withDependencies,
+                       bool withProperties) const override final;
+
+  /// @brief all index entries are read for each incoming item, but nothing
+  /// is done for them except comparing their values
+  CostEstimate estimateCost() const override final;
+
+  /// @brief getVariablesSetHere
+  std::vector<Variable const*> getVariablesSetHere() const override final {
+    if (_countVariable != nullptr) {
+      return std::vector<Variable const*>{_groupVariable, _countVariable};
+    }
+    return std::vector<Variable const*>{_groupVariable};
+  }
+
+  /// @brief the variable the distinct values are written into
+  Variable const* groupVariable() const { return _groupVariable; }
+
+  /// @brief the variable the number of documents with each value is written
+  /// into, nullptr if they are not counted
+  Variable const* countVariable() const { return _countVariable; }
+
+  /// @brief the sorted index, whose first field is grouped by
+  transaction::Methods::IndexHandle const& index() const { return _index; }
+
+ private:
+  transaction::Methods::IndexHandle _index;
+
+  Variable const* _groupVariable;
+
+  Variable const* _countVariable;
+};
+
+}  // namespace aql
+}  // namespace arangodb
+
+#endif
@@ -69,7 +69,8 @@ static inline DocumentProducingFunctionContext createContext(InputAqlItemRow con
       inputRow, nullptr, infos.getOutputRegisterId(), infos.getProduceResult(),
       infos.getProjections(), infos.getTrxPtr(),
       infos.getCoveringIndexAttributePositions(), false, infos.getUseRawDocumentPointers(),
-      infos.getIndexes().size() > 1 || infos.hasMultipleExpansions());
+      infos.getIndexes().size() > 1 || infos.hasMultipleExpansions(),
+      infos.getDocIdRegisterId());
 }
 }  // namespace
 
@@ -86,9 +87,9 @@ IndexExecutorInfos::IndexExecutorInfos(
     std::vector<Variable const*>&& expInVars, std::vector<RegisterId>&& expInRegs,
     bool hasV8Expression, AstNode const* condition,
     std::vector<transaction::Methods::IndexHandle> indexes, Ast* ast,
-    IndexIteratorOptions options)
+    IndexIteratorOptions options, RegisterId docIdRegister)
     : ExecutorInfos(make_shared_unordered_set(),
-                    make_shared_unordered_set({outputRegister}),
+                    documentOutputRegisters(outputRegister, docIdRegister),
                     nrInputRegisters, nrOutputRegisters,
                     std::move(registersToClear), std::move(registersToKeep)),
       _indexes(std::move(indexes)),
@@ -97,6 +98,7 @@ IndexExecutorInfos::IndexExecutorInfos(
       _hasMultipleExpansions(false),
       _options(options),
       _outputRegisterId(outputRegister),
+      _docIdRegisterId(docIdRegister),
       _engine(engine),
       _collection(collection),
       _outVariable(outVariable),
@@ -62,7 +62,7 @@ class IndexExecutorInfos : public ExecutorInfos {
       std::vector<Variable const*>&& expInVars, std::vector<RegisterId>&& expInRegs,
       bool hasV8Expression, AstNode const* condition,
       std::vector<transaction::Methods::IndexHandle> indexes, Ast* ast,
-      IndexIteratorOptions options);
+      IndexIteratorOptions options, RegisterId docIdRegister = ExecutionNode::MaxRegisterId);
 
   IndexExecutorInfos() = delete;
   IndexExecutorInfos(IndexExecutorInfos&&) = default;
@@ -87,6 +87,8 @@ class IndexExecutorInfos : public ExecutorInfos {
   AstNode const* getCondition() { return _condition; }
   bool getV8Expression() const { return _hasV8Expression; }
   RegisterId getOutputRegisterId() const { return _outputRegisterId; }
+  /// @brief register for the document ids, MaxRegisterId if not needed
+  RegisterId getDocIdRegisterId() const { return _docIdRegisterId; }
   std::vector<std::unique_ptr<NonConstExpression>> const& getNonConstExpressions() {
     return _nonConstExpression;
   }
@@ -134,6 +136,7 @@ class IndexExecutorInfos : public ExecutorInfos {
   IndexIteratorOptions _options;
 
   RegisterId _outputRegisterId;
+  RegisterId _docIdRegisterId;
   ExecutionEngine* _engine;
   Collection const* _collection;
   Variable const* _outVariable;
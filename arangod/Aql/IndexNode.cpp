@@ -375,6 +375,13 @@ std::unique_ptr<ExecutionBlock> IndexNode::createBlock(
 
   initializeOnce(hasV8Expression, inVars, inRegs, nonConstExpressions, trxPtr);
 
+  // only a top-level loop scans the index once, so that reading index
+  // ranges on several threads pays off
+  IndexIteratorOptions options = this->options();
+  if (getLoop() == nullptr) {
+    options.parallelism = engine.getQuery()->queryOptions().maxScanThreads;
+  }
+
   IndexExecutorInfos infos(outputRegister,
                            getRegisterPlan()->nrRegs[previousNode->getDepth()],
                            getRegisterPlan()->nrRegs[getDepth()], getRegsToClear(),
@@ -384,7 +391,9 @@ std::unique_ptr<ExecutionBlock> IndexNode::createBlock(
                            EngineSelectorFeature::ENGINE->useRawDocumentPointers(),
                            std::move(nonConstExpressions), std::move(inVars),
                            std::move(inRegs), hasV8Expression, _condition->root(),
-                           this->getIndexes(), _plan->getAst(), this->options());
+                           this->getIndexes(), _plan->getAst(), options,
+                           (_docIdVariable != nullptr ? variableToRegisterId(_docIdVariable)
+                                                      : ExecutionNode::MaxRegisterId));
 
   return std::make_unique<ExecutionBlockImpl<IndexExecutor>>(&engine, this,
                                                              std::move(infos));
@@ -398,11 +407,17 @@ ExecutionNode* IndexNode::clone(ExecutionPlan* plan, bool withDependencies,
     outVariable = plan->getAst()->variables()->createVariable(outVariable);
   }
 
+  auto docIdVariable = _docIdVariable;
+  if (withProperties && docIdVariable != nullptr) {
+    docIdVariable = plan->getAst()->variables()->createVariable(docIdVariable);
+  }
+
   auto c = std::make_unique<IndexNode>(plan, _id, _collection, outVariable, _indexes,
                                        std::unique_ptr<Condition>(_condition->clone()),
                                        _options);
 
   c->projections(_projections);
+  c->docIdVariable(docIdVariable);
   c->needsGatherNodeSort(_needsGatherNodeSort);
   c->initIndexCoversProjections();
   c->_prototypeCollection = _prototypeCollection;
@@ -104,6 +104,9 @@ class IndexNode : public ExecutionNode, public DocumentProducingNode, public Col
 
   /// @brief getVariablesSetHere
   std::vector<Variable const*> getVariablesSetHere() const override final {
+    if (_docIdVariable != nullptr) {
+      return std::vector<Variable const*>{_outVariable, _docIdVariable};
+    }
     return std::vector<Variable const*>{_outVariable};
   }
 
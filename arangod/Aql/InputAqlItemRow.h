@@ -127,6 +127,18 @@ class InputAqlItemRow {
 
   inline bool blockHasMoreRows() const noexcept { return !isLastRowInBlock(); }
 
+  /**
+   * @brief The underlying block and the row's index in it. Only meant for
+   *        executors that process all remaining rows of a block at once,
+   *        e.g. by evaluating an expression for a whole register.
+   */
+  inline AqlItemBlock const& getBlock() const noexcept { return block(); }
+
+  inline size_t getRowIndex() const noexcept {
+    TRI_ASSERT(isInitialized());
+    return _baseIndex;
+  }
+
 
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
   /**
@@ -0,0 +1,108 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MaterializeExecutor.h"
+
+#include "Aql/AqlValue.h"
+#include "Aql/Collection.h"
+#include "Aql/InputAqlItemRow.h"
+#include "Aql/OutputAqlItemRow.h"
+#include "Aql/SingleRowFetcher.h"
+#include "Transaction/Methods.h"
+#include "VocBase/LocalDocumentId.h"
+#include "VocBase/LogicalCollection.h"
+
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+MaterializeExecutorInfos::MaterializeExecutorInfos(
+    RegisterId inputRegister, RegisterId outputRegister, RegisterId nrInputRegisters,
+    RegisterId nrOutputRegisters,
+    // cppcheck-suppress passedByValue
+    std::unordered_set<RegisterId> registersToClear,
+    // cppcheck-suppress passedByValue
+    std::unordered_set<RegisterId> registersToKeep, Collection const* collection,
+    transaction::Methods* trxPtr, bool useRawDocumentPointers)
+    : ExecutorInfos(make_shared_unordered_set({inputRegister}),
+                    make_shared_unordered_set({outputRegister}),
+                    nrInputRegisters, nrOutputRegisters,
+                    std::move(registersToClear), std::move(registersToKeep)),
+      _inputRegisterId(inputRegister),
+      _outputRegisterId(outputRegister),
+      _collection(collection),
+      _trxPtr(trxPtr),
+      _useRawDocumentPointers(useRawDocumentPointers) {}
+
+MaterializeExecutor::MaterializeExecutor(Fetcher& fetcher, Infos& infos)
+    : _infos(infos), _fetcher(fetcher) {}
+
+std::pair<ExecutionState, MaterializeExecutor::Stats> MaterializeExecutor::produceRows(
+    OutputAqlItemRow& output) {
+  TRI_IF_FAILURE("MaterializeExecutor::produceRows") {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  }
+  ExecutionState state;
+  InputAqlItemRow input{CreateInvalidInputRowHint{}};
+  std::tie(state, input) = _fetcher.fetchRow();
+
+  if (state == ExecutionState::WAITING) {
+    return {state, NoStats{}};
+  }
+
+  if (!input) {
+    TRI_ASSERT(state == ExecutionState::DONE);
+    return {state, NoStats{}};
+  }
+  TRI_ASSERT(input.isInitialized());
+
+  AqlValue const& id = input.getValue(_infos.getInputRegisterId());
+  TRI_ASSERT(id.isNumber());
+  LocalDocumentId token(id.slice().getNumber<LocalDocumentId::BaseType>());
+
+  RegisterId const registerId = _infos.getOutputRegisterId();
+  bool const found = _infos.getCollection()->getCollection()->readDocumentWithCallback(
+      _infos.getTrxPtr(), token, [&](LocalDocumentId const&, VPackSlice document) {
+        if (_infos.getUseRawDocumentPointers()) {
+          AqlValue v{AqlValueHintDocumentNoCopy{document.begin()}};
+          AqlValueGuard guard{v, false};
+          output.moveValueInto(registerId, input, guard);
+        } else {
+          AqlValue v{AqlValueHintCopy{document.begin()}};
+          AqlValueGuard guard{v, true};
+          output.moveValueInto(registerId, input, guard);
+        }
+      });
+
+  if (!found) {
+    // the document is gone. this can only happen if it was removed by the
+    // query itself after it was enumerated
+    output.cloneValueInto(registerId, input, AqlValue(AqlValueHintNull()));
+  }
+  TRI_ASSERT(output.produced());
+
+  return {state, NoStats{}};
+}
+
+std::pair<ExecutionState, size_t> MaterializeExecutor::expectedNumberOfRows(size_t atMost) const {
+  // exactly one output row per input row
+  return _fetcher.preFetchNumberOfRows(atMost);
+}
@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_MATERIALIZE_EXECUTOR_H
+#define ARANGOD_AQL_MATERIALIZE_EXECUTOR_H
+
+#include "Aql/ExecutionState.h"
+#include "Aql/ExecutorInfos.h"
+#include "Aql/Stats.h"
+#include "Aql/types.h"
+
+#include <memory>
+
+namespace arangodb {
+namespace transaction {
+class Methods;
+}
+
+namespace aql {
+
+struct Collection;
+class OutputAqlItemRow;
+
+template <bool>
+class SingleRowFetcher;
+
+class MaterializeExecutorInfos : public ExecutorInfos {
+ public:
+  MaterializeExecutorInfos(RegisterId inputRegister, RegisterId outputRegister,
+                           RegisterId nrInputRegisters, RegisterId nrOutputRegisters,
+                           std::unordered_set<RegisterId> registersToClear,
+                           std::unordered_set<RegisterId> registersToKeep,
+                           Collection const* collection,
+                           transaction::Methods* trxPtr, bool useRawDocumentPointers);
+
+  MaterializeExecutorInfos() = delete;
+  MaterializeExecutorInfos(MaterializeExecutorInfos&&) = default;
+  MaterializeExecutorInfos(MaterializeExecutorInfos const&) = delete;
+  ~MaterializeExecutorInfos() = default;
+
+  Collection const* getCollection() const { return _collection; }
+  transaction::Methods* getTrxPtr() const { return _trxPtr; }
+  bool getUseRawDocumentPointers() const { return _useRawDocumentPointers; }
+  RegisterId getInputRegisterId() const { return _inputRegisterId; }
+  RegisterId getOutputRegisterId() const { return _outputRegisterId; }
+
+ private:
+  RegisterId _inputRegisterId;
+  RegisterId _outputRegisterId;
+  Collection const* _collection;
+  transaction::Methods* _trxPtr;
+  bool _useRawDocumentPointers;
+};
+
+/**
+ * @brief Implementation of Materialize Node
+ *
+ * Reads the document for the document id in every input row. Documents that
+ * were removed in the meantime produce null.
+ */
+class MaterializeExecutor {
+ public:
+  struct Properties {
+    static const bool preservesOrder = true;
+    static const bool allowsBlockPassthrough = false;
+    static const bool inputSizeRestrictsOutputSize = true;
+  };
+  using Fetcher = SingleRowFetcher<Properties::allowsBlockPassthrough>;
+  using Infos = MaterializeExecutorInfos;
+  using Stats = NoStats;
+
+  MaterializeExecutor() = delete;
+  MaterializeExecutor(MaterializeExecutor&&) = default;
+  MaterializeExecutor(MaterializeExecutor const&) = delete;
+  MaterializeExecutor(Fetcher& fetcher, Infos&);
+  ~MaterializeExecutor() = default;
+
+  /**
+   * @brief produce the next Rows of Aql Values.
+   *
+   * @return ExecutionState, and if successful at least one new Row of AqlItems.
+   */
+  std::pair<ExecutionState, Stats> produceRows(OutputAqlItemRow& output);
+
+  std::pair<ExecutionState, size_t> expectedNumberOfRows(size_t atMost) const;
+
+ private:
+  Infos& _infos;
+  Fetcher& _fetcher;
+};
+
+}  // namespace aql
+}  // namespace arangodb
+
+#endif
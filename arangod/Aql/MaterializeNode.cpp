@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MaterializeNode.h"
+#include "Aql/Ast.h"
+#include "Aql/Collection.h"
+#include "Aql/ExecutionBlockImpl.h"
+#include "Aql/ExecutionPlan.h"
+#include "Aql/MaterializeExecutor.h"
+#include "Aql/Query.h"
+#include "Aql/Variable.h"
+#include "StorageEngine/EngineSelectorFeature.h"
+#include "StorageEngine/StorageEngine.h"
+#include "Transaction/Methods.h"
+
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+MaterializeNode::MaterializeNode(ExecutionPlan* plan, size_t id,
+                                 aql::Collection const* collection,
+                                 Variable const* inDocIdVariable, Variable const* outVariable)
+    : ExecutionNode(plan, id),
+      CollectionAccessingNode(collection),
+      _inDocIdVariable(inDocIdVariable),
+      _outVariable(outVariable) {
+  TRI_ASSERT(_inDocIdVariable != nullptr);
+  TRI_ASSERT(_outVariable != nullptr);
+}
+
+MaterializeNode::MaterializeNode(ExecutionPlan* plan, arangodb::velocypack::Slice const& base)
+    : ExecutionNode(plan, base),
+      CollectionAccessingNode(plan, base),
+      _inDocIdVariable(Variable::varFromVPack(plan->getAst(), base, "docIdVariable")),
+      _outVariable(Variable::varFromVPack(plan->getAst(), base, "outVariable")) {}
+
+/// @brief toVelocyPack, for MaterializeNode
+void MaterializeNode::toVelocyPackHelper(VPackBuilder& builder, unsigned flags) const {
+  // call base class method
+  ExecutionNode::toVelocyPackHelperGeneric(builder, flags);
+
+  builder.add(VPackValue("docIdVariable"));
+  _inDocIdVariable->toVelocyPack(builder);
+
+  builder.add(VPackValue("outVariable"));
+  _outVariable->toVelocyPack(builder);
+
+  // add collection information
+  CollectionAccessingNode::toVelocyPack(builder);
+
+  // And close it:
+  builder.close();
+}
+
+/// @brief creates corresponding ExecutionBlock
+std::unique_ptr<ExecutionBlock> MaterializeNode::createBlock(
+    ExecutionEngine& engine, std::unordered_map<ExecutionNode*, ExecutionBlock*> const&) const {
+  ExecutionNode const* previousNode = getFirstDependency();
+  TRI_ASSERT(previousNode != nullptr);
+
+  transaction::Methods* trxPtr = _plan->getAst()->query()->trx();
+
+  MaterializeExecutorInfos infos(variableToRegisterId(_inDocIdVariable),
+                                 variableToRegisterId(_outVariable),
+                                 getRegisterPlan()->nrRegs[previousNode->getDepth()],
+                                 getRegisterPlan()->nrRegs[getDepth()],
+                                 getRegsToClear(), calcRegsToKeep(), _collection, trxPtr,
+                                 EngineSelectorFeature::ENGINE->useRawDocumentPointers());
+  return std::make_unique<ExecutionBlockImpl<MaterializeExecutor>>(&engine, this,
+                                                                   std::move(infos));
+}
+
+/// @brief clone ExecutionNode recursively
+ExecutionNode* MaterializeNode::clone(ExecutionPlan* plan, bool withDependencies,
+                                      bool withProperties) const {
+  auto inDocIdVariable = _inDocIdVariable;
+  auto outVariable = _outVariable;
+  if (withProperties) {
+    inDocIdVariable = plan->getAst()->variables()->createVariable(inDocIdVariable);
+    outVariable = plan->getAst()->variables()->createVariable(outVariable);
+    TRI_ASSERT(inDocIdVariable != nullptr);
+    TRI_ASSERT(outVariable != nullptr);
+  }
+
+  auto c = std::make_unique<MaterializeNode>(plan, _id, _collection,
+                                             inDocIdVariable, outVariable);
+  c->_prototypeCollection = _prototypeCollection;
+  c->_prototypeOutVariable = _prototypeOutVariable;
+
+  return cloneHelper(std::move(c), withDependencies, withProperties);
+}
+
+/// @brief a single document lookup per incoming item
+CostEstimate MaterializeNode::estimateCost() const {
+  TRI_ASSERT(!_dependencies.empty());
+  CostEstimate estimate = _dependencies.at(0)->getCost();
+  estimate.estimatedCost += static_cast<double>(estimate.estimatedNrItems);
+  return estimate;
+}
@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_MATERIALIZE_NODE_H
+#define ARANGOD_AQL_MATERIALIZE_NODE_H 1
+
+#include "Aql/CollectionAccessingNode.h"
+#include "Aql/ExecutionNode.h"
+#include "Aql/types.h"
+#include "Basics/Common.h"
+
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+namespace aql {
+struct Collection;
+class ExecutionBlock;
+class ExecutionEngine;
+class ExecutionPlan;
+
+/// @brief class MaterializeNode
+/// reads the documents for the ids produced by an EnumerateCollectionNode or
+/// an IndexNode earlier in the plan. this allows to pass only the ids and a
+/// projection of each document through SORT and LIMIT, and to read the full
+/// documents only for the rows that remain
+class MaterializeNode : public ExecutionNode, public CollectionAccessingNode {
+  friend class ExecutionNode;
+  friend class ExecutionBlock;
+
+ public:
+  MaterializeNode(ExecutionPlan* plan, size_t id, aql::Collection const* collection,
+                  Variable const* inDocIdVariable, Variable const* outVariable);
+
+  MaterializeNode(ExecutionPlan* plan, arangodb::velocypack::Slice const& base);
+
+  /// @brief return the type of the node
+  NodeType getType() const override final { return MATERIALIZE; }
+
+  /// @brief export to VelocyPack
+  void toVelocyPackHelper(arangodb::velocypack::Builder&, unsigned flags) const override final;
+
+  /// @brief creates corresponding ExecutionBlock
+  std::unique_ptr<ExecutionBlock> createBlock(
+      ExecutionEngine& engine,
+      std::unordered_map<ExecutionNode*, ExecutionBlock*> const&) const override;
+
+  /// @brief clone ExecutionNode recursively
+  ExecutionNode* clone(ExecutionPlan* plan, bool withDependencies,
+                       bool withProperties) const override final;
+
+  /// @brief every incoming row costs a single document lookup
+  CostEstimate estimateCost() const override final;
+
+  /// @brief getVariablesUsedHere, modifying the set in-place
+  void getVariablesUsedHere(arangodb::HashSet<Variable const*>& vars) const override final {
+    vars.emplace(_inDocIdVariable);
+  }
+
+  /// @brief getVariablesSetHere
+  std::vector<Variable const*> getVariablesSetHere() const override final {
+    return std::vector<Variable const*>{_outVariable};
+  }
+
+  /// @brief return the variable holding the document ids
+  Variable const* inDocIdVariable() const { return _inDocIdVariable; }
+
+  /// @brief return the variable the documents are written into
+  Variable const* outVariable() const { return _outVariable; }
+
+ private:
+  /// @brief variable holding the document ids
+  Variable const* _inDocIdVariable;
+
+  /// @brief variable for the documents
+  Variable const* _outVariable;
+};
+
+}  // namespace aql
+}  // namespace arangodb
+
+#endif
@@ -0,0 +1,232 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MergeJoinExecutor.h"
+
+#include "Aql/Collection.h"
+#include "Aql/OutputAqlItemRow.h"
+#include "Aql/SingleRowFetcher.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Indexes/IndexIterator.h"
+#include "Transaction/Context.h"
+
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+/// @brief number of documents read from the index at once
+constexpr uint64_t readBatchSize = 1000;
+
+IndexIteratorOptions sortedScanOptions() {
+  IndexIteratorOptions options;
+  options.sorted = true;
+  options.ascending = true;
+  return options;
+}
+}  // namespace
+
+MergeJoinExecutorInfos::MergeJoinExecutorInfos(
+    RegisterId inputRegister, RegisterId outputRegister, RegisterId nrInputRegisters,
+    RegisterId nrOutputRegisters,
+    // cppcheck-suppress passedByValue
+    std::unordered_set<RegisterId> registersToClear,
+    // cppcheck-suppress passedByValue
+    std::unordered_set<RegisterId> registersToKeep, ExecutionEngine* engine,
+    Collection const* collection, Variable const* outVariable,
+    std::vector<std::string> const& attribute,
+    transaction::Methods::IndexHandle const& index, transaction::Methods* trxPtr)
+    : ExecutorInfos(make_shared_unordered_set({inputRegister}),
+                    make_shared_unordered_set({outputRegister}),
+                    nrInputRegisters, nrOutputRegisters,
+                    std::move(registersToClear), std::move(registersToKeep)),
+      _inputRegisterId(inputRegister),
+      _outputRegisterId(outputRegister),
+      _engine(engine),
+      _collection(collection),
+      _outVariable(outVariable),
+      _attribute(attribute),
+      _index(index),
+      _trxPtr(trxPtr) {
+  TRI_ASSERT(!_attribute.empty());
+}
+
+MergeJoinExecutor::MergeJoinExecutor(Fetcher& fetcher, Infos& infos)
+    : _infos(infos),
+      _fetcher(fetcher),
+      _state(ExecutionState::HASMORE),
+      _input(InputAqlItemRow{CreateInvalidInputRowHint{}}),
+      _cursorHasMore(false),
+      _groupValid(false),
+      _matching(false),
+      _matchPosition(0) {
+  // a null condition makes the index return all its documents in order
+  _cursor = std::make_unique<OperationCursor>(_infos.getTrxPtr()->indexScanForCondition(
+      _infos.getIndex(), nullptr, _infos.getOutVariable(), ::sortedScanOptions()));
+  _cursorHasMore = _cursor->hasMore();
+}
+
+MergeJoinExecutor::~MergeJoinExecutor() {
+  clearGroup();
+  for (auto& it : _pending) {
+    it.destroy();
+  }
+}
+
+void MergeJoinExecutor::initializeCursor() {
+  _state = ExecutionState::HASMORE;
+  _input = InputAqlItemRow{CreateInvalidInputRowHint{}};
+  _matching = false;
+  _matchPosition = 0;
+  // keep the read position. if the next probe value is smaller than the
+  // last one, the index will be read again
+}
+
+std::pair<ExecutionState, MergeJoinExecutor::Stats> MergeJoinExecutor::produceRows(OutputAqlItemRow& output) {
+  TRI_IF_FAILURE("MergeJoinExecutor::produceRows") {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  }
+  Stats stats{};
+
+  while (!output.isFull()) {
+    if (_matching && _matchPosition < _group.size()) {
+      AqlValue v{AqlValueHintCopy{_group[_matchPosition].slice().begin()}};
+      AqlValueGuard guard{v, true};
+      output.moveValueInto(_infos.getOutputRegisterId(), _input, guard);
+      TRI_ASSERT(output.produced());
+      output.advanceRow();
+      ++_matchPosition;
+      continue;
+    }
+
+    _matching = false;
+    std::tie(_state, _input) = _fetcher.fetchRow();
+
+    if (_state == ExecutionState::WAITING) {
+      return {_state, stats};
+    }
+
+    if (!_input) {
+      TRI_ASSERT(_state == ExecutionState::DONE);
+      return {_state, stats};
+    }
+
+    AqlValue const& value = _input.getValue(_infos.getInputRegisterId());
+    AqlValueMaterializer materializer(_infos.getTrxPtr());
+    VPackSlice probe = materializer.slice(value, true);
+
+    if (!_lastProbe.isEmpty() && compare(probe, _lastProbe.slice()) < 0) {
+      // input is not sorted (anymore)
+      restart();
+    }
+    _lastProbe.clear();
+    _lastProbe.add(probe);
+
+    if (!_groupValid || compare(_groupKey.slice(), probe) != 0) {
+      advanceTo(probe, stats);
+    }
+    if (_groupValid) {
+      TRI_ASSERT(compare(_groupKey.slice(), probe) == 0);
+      _matching = true;
+      _matchPosition = 0;
+    }
+  }
+
+  if (_state == ExecutionState::DONE && (!_matching || _matchPosition >= _group.size())) {
+    return {ExecutionState::DONE, stats};
+  }
+  return {ExecutionState::HASMORE, stats};
+}
+
+int MergeJoinExecutor::compare(VPackSlice lhs, VPackSlice rhs) const {
+  return basics::VelocyPackHelper::compare(
+      lhs, rhs, true, _infos.getTrxPtr()->transactionContextPtr()->getVPackOptions());
+}
+
+VPackSlice MergeJoinExecutor::joinValue(VPackSlice document) const {
+  VPackSlice value = document.get(_infos.getAttribute());
+  if (value.isNone()) {
+    return VPackSlice::nullSlice();
+  }
+  return value;
+}
+
+bool MergeJoinExecutor::fillPending(Stats& stats) {
+  while (_pending.empty() && _cursorHasMore) {
+    _cursorHasMore = _cursor->nextDocument(
+        [&](LocalDocumentId const&, VPackSlice document) {
+          AqlValue value{AqlValueHintCopy{document.begin()}};
+          AqlValueGuard guard{value, true};
+          _pending.emplace_back(value);
+          guard.steal();
+          stats.incrScanned();
+        },
+        ::readBatchSize);
+  }
+  return !_pending.empty();
+}
+
+void MergeJoinExecutor::advanceTo(VPackSlice probe, Stats& stats) {
+  clearGroup();
+
+  // skip all documents with smaller keys
+  while (fillPending(stats)) {
+    if (compare(joinValue(_pending.front().slice()), probe) >= 0) {
+      break;
+    }
+    _pending.front().destroy();
+    _pending.pop_front();
+  }
+
+  // collect all documents with the probe value
+  while (fillPending(stats)) {
+    if (compare(joinValue(_pending.front().slice()), probe) != 0) {
+      break;
+    }
+    _group.emplace_back(_pending.front());
+    _pending.pop_front();
+  }
+
+  if (!_group.empty()) {
+    _groupKey.clear();
+    _groupKey.add(probe);
+    _groupValid = true;
+  }
+}
+
+void MergeJoinExecutor::restart() {
+  clearGroup();
+  for (auto& it : _pending) {
+    it.destroy();
+  }
+  _pending.clear();
+  _cursor->reset();
+  _cursorHasMore = _cursor->hasMore();
+}
+
+void MergeJoinExecutor::clearGroup() {
+  for (auto& it : _group) {
+    it.destroy();
+  }
+  _group.clear();
+  _groupKey.clear();
+  _groupValid = false;
+}
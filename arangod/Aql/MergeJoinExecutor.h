@@ -0,0 +1,182 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_MERGE_JOIN_EXECUTOR_H
+#define ARANGOD_AQL_MERGE_JOIN_EXECUTOR_H
+
+#include "Aql/AqlValue.h"
+#include "Aql/ExecutionState.h"
+#include "Aql/ExecutorInfos.h"
+#include "Aql/InputAqlItemRow.h"
+#include "Aql/Stats.h"
+#include "Aql/types.h"
+#include "Transaction/Methods.h"
+#include "Utils/OperationCursor.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <deque>
+#include <memory>
+
+namespace arangodb {
+namespace aql {
+
+struct Collection;
+class ExecutionEngine;
+class OutputAqlItemRow;
+struct Variable;
+
+template <bool>
+class SingleRowFetcher;
+
+class MergeJoinExecutorInfos : public ExecutorInfos {
+ public:
+  MergeJoinExecutorInfos(RegisterId inputRegister, RegisterId outputRegister,
+                         RegisterId nrInputRegisters, RegisterId nrOutputRegisters,
+                         std::unordered_set<RegisterId> registersToClear,
+                         std::unordered_set<RegisterId> registersToKeep,
+                         ExecutionEngine* engine, Collection const* collection,
+                         Variable const* outVariable,
+                         std::vector<std::string> const& attribute,
+                         transaction::Methods::IndexHandle const& index,
+                         transaction::Methods* trxPtr);
+
+  MergeJoinExecutorInfos() = delete;
+  MergeJoinExecutorInfos(MergeJoinExecutorInfos&&) = default;
+  MergeJoinExecutorInfos(MergeJoinExecutorInfos const&) = delete;
+  ~MergeJoinExecutorInfos() = default;
+
+  ExecutionEngine* getEngine() const { return _engine; }
+  Collection const* getCollection() const { return _collection; }
+  Variable const* getOutVariable() const { return _outVariable; }
+  std::vector<std::string> const& getAttribute() const { return _attribute; }
+  transaction::Methods::IndexHandle const& getIndex() const { return _index; }
+  transaction::Methods* getTrxPtr() const { return _trxPtr; }
+  RegisterId getInputRegisterId() const { return _inputRegisterId; }
+  RegisterId getOutputRegisterId() const { return _outputRegisterId; }
+
+ private:
+  RegisterId _inputRegisterId;
+  RegisterId _outputRegisterId;
+  ExecutionEngine* _engine;
+  Collection const* _collection;
+  Variable const* _outVariable;
+  std::vector<std::string> _attribute;
+  transaction::Methods::IndexHandle _index;
+  transaction::Methods* _trxPtr;
+};
+
+/**
+ * @brief Implementation of MergeJoin Node
+ *
+ * The input rows are expected to arrive sorted by their probe value. The
+ * sorted index is read in the same order, so for every input row it only
+ * has to be advanced up to the probe value. Documents with the same key are
+ * kept until the probe value changes, so duplicates on both sides are
+ * joined correctly.
+ * If a probe value is smaller than the one before (e.g. because the join is
+ * executed in a subquery), the index is read again from its start, so the
+ * result is correct for any input order.
+ */
+class MergeJoinExecutor {
+ public:
+  struct Properties {
+    static const bool preservesOrder = true;
+    static const bool allowsBlockPassthrough = false;
+    static const bool inputSizeRestrictsOutputSize = false;
+  };
+  using Fetcher = SingleRowFetcher<Properties::allowsBlockPassthrough>;
+  using Infos = MergeJoinExecutorInfos;
+  using Stats = IndexStats;
+
+  MergeJoinExecutor() = delete;
+  MergeJoinExecutor(MergeJoinExecutor&&) = default;
+  MergeJoinExecutor(MergeJoinExecutor const&) = delete;
+  MergeJoinExecutor(Fetcher& fetcher, Infos&);
+  ~MergeJoinExecutor();
+
+  /**
+   * @brief produce the next Rows of Aql Values.
+   *
+   * @return ExecutionState, and if successful at least one new Row of AqlItems.
+   */
+  std::pair<ExecutionState, Stats> produceRows(OutputAqlItemRow& output);
+
+  inline std::pair<ExecutionState, size_t> expectedNumberOfRows(size_t) const {
+    TRI_ASSERT(false);
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_INTERNAL,
+        "Logic_error, prefetching number fo rows not supported");
+  }
+
+  void initializeCursor();
+
+ private:
+  /// @brief compare two join values, in the sort order of the index
+  int compare(arangodb::velocypack::Slice lhs, arangodb::velocypack::Slice rhs) const;
+
+  /// @brief extract the join attribute from a document, returns a null
+  /// slice if it is not present
+  arangodb::velocypack::Slice joinValue(arangodb::velocypack::Slice document) const;
+
+  /// @brief make sure there is a document in _pending, reading from the
+  /// index if necessary. returns false if the index is exhausted
+  bool fillPending(Stats& stats);
+
+  /// @brief advance the index to the probe value and collect all documents
+  /// with this key into _group
+  void advanceTo(arangodb::velocypack::Slice probe, Stats& stats);
+
+  /// @brief start reading the index from its beginning again
+  void restart();
+
+  void clearGroup();
+
+ private:
+  Infos& _infos;
+  Fetcher& _fetcher;
+  ExecutionState _state;
+  InputAqlItemRow _input;
+
+  std::unique_ptr<OperationCursor> _cursor;
+  bool _cursorHasMore;
+
+  /// @brief documents read from the index, but not yet joined
+  std::deque<AqlValue> _pending;
+
+  /// @brief documents with the key _groupKey, if _groupValid
+  std::vector<AqlValue> _group;
+  arangodb::velocypack::Builder _groupKey;
+  bool _groupValid;
+
+  /// @brief the previous probe value, to detect unsorted input
+  arangodb::velocypack::Builder _lastProbe;
+
+  /// @brief whether the group is joined with the current input row, and
+  /// the next document of the group to return
+  bool _matching;
+  size_t _matchPosition;
+};
+
+}  // namespace aql
+}  // namespace arangodb
+
+#endif
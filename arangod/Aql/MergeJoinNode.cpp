@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MergeJoinNode.h"
+#include "Aql/Ast.h"
+#include "Aql/Collection.h"
+#include "Aql/ExecutionBlockImpl.h"
+#include "Aql/ExecutionPlan.h"
+#include "Aql/MergeJoinExecutor.h"
+#include "Aql/Query.h"
+#include "Aql/Variable.h"
+#include "Indexes/Index.h"
+#include "Transaction/Methods.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+MergeJoinNode::MergeJoinNode(ExecutionPlan* plan, size_t id, aql::Collection const* collection,
+                             Variable const* outVariable, Variable const* keyVariable,
+                             std::vector<std::string> const& attribute,
+                             transaction::Methods::IndexHandle const& index)
+    : ExecutionNode(plan, id),
+      DocumentProducingNode(outVariable),
+      CollectionAccessingNode(collection),
+      _keyVariable(keyVariable),
+      _attribute(attribute),
+      _index(index) {
+  TRI_ASSERT(_keyVariable != nullptr);
+  TRI_ASSERT(!_attribute.empty());
+  TRI_ASSERT(_index.getIndex() != nullptr);
+}
+
+MergeJoinNode::MergeJoinNode(ExecutionPlan* plan, arangodb::velocypack::Slice const& base)
+    : ExecutionNode(plan, base),
+      DocumentProducingNode(plan, base),
+      CollectionAccessingNode(plan, base),
+      _keyVariable(Variable::varFromVPack(plan->getAst(), base, "keyVariable")) {
+  VPackSlice attribute = base.get("attribute");
+  if (!attribute.isArray() || attribute.length() == 0) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                   "\"attribute\" must be a non-empty array");
+  }
+  for (auto const& it : VPackArrayIterator(attribute)) {
+    _attribute.emplace_back(it.copyString());
+  }
+
+  VPackSlice index = base.get("index");
+  if (!index.isObject()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                   "\"index\" attribute should be an object");
+  }
+  auto trx = plan->getAst()->query()->trx();
+  _index = trx->getIndexByIdentifier(_collection->name(), index.get("id").copyString());
+}
+
+/// @brief toVelocyPack, for MergeJoinNode
+void MergeJoinNode::toVelocyPackHelper(VPackBuilder& builder, unsigned flags) const {
+  // call base class method
+  ExecutionNode::toVelocyPackHelperGeneric(builder, flags);
+
+  builder.add(VPackValue("keyVariable"));
+  _keyVariable->toVelocyPack(builder);
+
+  builder.add(VPackValue("attribute"));
+  builder.openArray();
+  for (auto const& it : _attribute) {
+    builder.add(VPackValue(it));
+  }
+  builder.close();
+
+  builder.add(VPackValue("index"));
+  _index.toVelocyPack(builder, Index::makeFlags(Index::Serialize::Estimates));
+
+  // add outvariable and projections
+  DocumentProducingNode::toVelocyPack(builder);
+
+  // add collection information
+  CollectionAccessingNode::toVelocyPack(builder);
+
+  // And close it:
+  builder.close();
+}
+
+/// @brief creates corresponding ExecutionBlock
+std::unique_ptr<ExecutionBlock> MergeJoinNode::createBlock(
+    ExecutionEngine& engine, std::unordered_map<ExecutionNode*, ExecutionBlock*> const&) const {
+  ExecutionNode const* previousNode = getFirstDependency();
+  TRI_ASSERT(previousNode != nullptr);
+
+  transaction::Methods* trxPtr = _plan->getAst()->query()->trx();
+
+  MergeJoinExecutorInfos infos(variableToRegisterId(_keyVariable),
+                               variableToRegisterId(_outVariable),
+                               getRegisterPlan()->nrRegs[previousNode->getDepth()],
+                               getRegisterPlan()->nrRegs[getDepth()],
+                               getRegsToClear(), calcRegsToKeep(), &engine,
+                               _collection, _outVariable, _attribute, _index, trxPtr);
+  return std::make_unique<ExecutionBlockImpl<MergeJoinExecutor>>(&engine, this,
+                                                                 std::move(infos));
+}
+
+/// @brief clone ExecutionNode recursively
+ExecutionNode* MergeJoinNode::clone(ExecutionPlan* plan, bool withDependencies,
+                                    bool withProperties) const {
+  auto outVariable = _outVariable;
+  auto keyVariable = _keyVariable;
+  if (withProperties) {
+    outVariable = plan->getAst()->variables()->createVariable(outVariable);
+    keyVariable = plan->getAst()->variables()->createVariable(keyVariable);
+    TRI_ASSERT(outVariable != nullptr);
+    TRI_ASSERT(keyVariable != nullptr);
+  }
+
+  auto c = std::make_unique<MergeJoinNode>(plan, _id, _collection, outVariable,
+                                           keyVariable, _attribute, _index);
+
+  c->projections(_projections);
+  c->_prototypeCollection = _prototypeCollection;
+  c->_prototypeOutVariable = _prototypeOutVariable;
+
+  return cloneHelper(std::move(c), withDependencies, withProperties);
+}
+
+/// @brief the index is read once, in parallel with the incoming items. we
+/// assume equality joins to be mostly on unique attributes, so every
+/// incoming item produces a single result
+CostEstimate MergeJoinNode::estimateCost() const {
+  transaction::Methods* trx = _plan->getAst()->query()->trx();
+  if (trx->status() != transaction::Status::RUNNING) {
+    return CostEstimate::empty();
+  }
+
+  TRI_ASSERT(!_dependencies.empty());
+  CostEstimate estimate = _dependencies.at(0)->getCost();
+  estimate.estimatedCost += static_cast<double>(_collection->count(trx)) +
+                            static_cast<double>(estimate.estimatedNrItems) + 1.0;
+  return estimate;
+}
@@ -0,0 +1,114 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_MERGE_JOIN_NODE_H
+#define ARANGOD_AQL_MERGE_JOIN_NODE_H 1
+
+#include "Aql/CollectionAccessingNode.h"
+#include "Aql/DocumentProducingNode.h"
+#include "Aql/ExecutionNode.h"
+#include "Aql/types.h"
+#include "Basics/Common.h"
+#include "Transaction/Methods.h"
+
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+namespace aql {
+struct Collection;
+class ExecutionBlock;
+class ExecutionEngine;
+class ExecutionPlan;
+
+/// @brief class MergeJoinNode
+/// replaces the inner loop of
+///   FOR a IN ... FOR b IN collection FILTER b.attr == a.attr
+/// if the incoming rows are sorted by a.attr, and the collection has a
+/// sorted index on b.attr. the index is then read only once, in parallel
+/// with the incoming rows, instead of being looked up for every row.
+/// the probe value a.attr is computed into keyVariable beforehand
+class MergeJoinNode : public ExecutionNode,
+                     public DocumentProducingNode,
+                     public CollectionAccessingNode {
+  friend class ExecutionNode;
+  friend class ExecutionBlock;
+
+ public:
+  MergeJoinNode(ExecutionPlan* plan, size_t id, aql::Collection const* collection,
+                Variable const* outVariable, Variable const* keyVariable,
+                std::vector<std::string> const& attribute,
+                transaction::Methods::IndexHandle const& index);
+
+  MergeJoinNode(ExecutionPlan* plan, arangodb::velocypack::Slice const& base);
+
+  /// @brief return the type of the node
+  NodeType getType() const override final { return MERGE_JOIN; }
+
+  /// @brief export to VelocyPack
+  void toVelocyPackHelper(arangodb::velocypack::Builder&, unsigned flags) const override final;
+
+  /// @brief creates corresponding ExecutionBlock
+  std::unique_ptr<ExecutionBlock> createBlock(
+      ExecutionEngine& engine,
+      std::unordered_map<ExecutionNode*, ExecutionBlock*> const&) const override;
+
+  /// @brief clone ExecutionNode recursively
+  ExecutionNode* clone(ExecutionPlan* plan, bool withDependencies,
+                       bool withProperties) const override final;
+
+  /// @brief the index is scanned only once, and each incoming row costs a
+  /// single comparison
+  CostEstimate estimateCost() const override final;
+
+  /// @brief getVariablesUsedHere, modifying the set in-place
+  void getVariablesUsedHere(arangodb::HashSet<Variable const*>& vars) const override final {
+    vars.emplace(_keyVariable);
+  }
+
+  /// @brief getVariablesSetHere
+  std::vector<Variable const*> getVariablesSetHere() const override final {
+    return std::vector<Variable const*>{_outVariable};
+  }
+
+  /// @brief return the variable holding the probe value
+  Variable const* keyVariable() const { return _keyVariable; }
+
+  /// @brief return the (possibly nested) attribute of the documents that
+  /// is compared to the probe value
+  std::vector<std::string> const& attribute() const { return _attribute; }
+
+  /// @brief the sorted index on the attribute
+  transaction::Methods::IndexHandle const& index() const { return _index; }
+
+ private:
+  /// @brief variable holding the probe value
+  Variable const* _keyVariable;
+
+  /// @brief attribute path in the documents of the collection
+  std::vector<std::string> _attribute;
+
+  /// @brief sorted index, whose first field is the attribute
+  transaction::Methods::IndexHandle _index;
+};
+
+}  // namespace aql
+}  // namespace arangodb
+
+#endif
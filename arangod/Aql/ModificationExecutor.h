@@ -70,6 +70,7 @@ inline OperationOptions convertOptions(ModificationOptions const& in,
   out.waitForSync = in.waitForSync;
   out.keepNull = !in.nullMeansRemove;
   out.mergeObjects = in.mergeObjects;
+  out.incrementNumbers = in.incrementNumbers;
   // in.ignoreDocumentNotFound;
   // in.readCompleteInput;
   out.isRestore = in.useIsRestore;
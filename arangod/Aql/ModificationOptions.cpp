@@ -36,6 +36,8 @@ ModificationOptions::ModificationOptions(VPackSlice const& slice) {
   nullMeansRemove =
       basics::VelocyPackHelper::getBooleanValue(obj, "nullMeansRemove", false);
   mergeObjects = basics::VelocyPackHelper::getBooleanValue(obj, "mergeObjects", true);
+  incrementNumbers =
+      basics::VelocyPackHelper::getBooleanValue(obj, "incrementNumbers", false);
   ignoreDocumentNotFound =
       basics::VelocyPackHelper::getBooleanValue(obj, "ignoreDocumentNotFound", false);
   readCompleteInput =
@@ -54,6 +56,7 @@ void ModificationOptions::toVelocyPack(VPackBuilder& builder) const {
   builder.add("waitForSync", VPackValue(waitForSync));
   builder.add("nullMeansRemove", VPackValue(nullMeansRemove));
   builder.add("mergeObjects", VPackValue(mergeObjects));
+  builder.add("incrementNumbers", VPackValue(incrementNumbers));
   builder.add("ignoreDocumentNotFound", VPackValue(ignoreDocumentNotFound));
   builder.add("readCompleteInput", VPackValue(readCompleteInput));
   builder.add("useIsRestore", VPackValue(useIsRestore));
@@ -42,6 +42,7 @@ struct ModificationOptions {
         waitForSync(false),
         nullMeansRemove(false),
         mergeObjects(true),
+        incrementNumbers(false),
         ignoreDocumentNotFound(false),
         readCompleteInput(true),
         useIsRestore(false),
@@ -56,6 +57,7 @@ struct ModificationOptions {
   bool waitForSync;
   bool nullMeansRemove;
   bool mergeObjects;
+  bool incrementNumbers;
   bool ignoreDocumentNotFound;
   bool readCompleteInput;
   bool useIsRestore;
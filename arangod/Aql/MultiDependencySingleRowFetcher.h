@@ -104,16 +104,22 @@ class MultiDependencySingleRowFetcher {
   std::pair<ExecutionState, size_t> preFetchNumberOfRows(size_t atMost) {
     ExecutionState state = ExecutionState::DONE;
     size_t available = 0;
+    bool waiting = false;
     for (size_t i = 0; i < numberDependencies(); ++i) {
+      // ask all dependencies before waiting, so they can fetch in parallel
       auto res = preFetchNumberOfRowsForDependency(i, atMost);
       if (res.first == ExecutionState::WAITING) {
-        return {ExecutionState::WAITING, 0};
+        waiting = true;
+        continue;
       }
       available += res.second;
       if (res.first == ExecutionState::HASMORE) {
         state = ExecutionState::HASMORE;
       }
     }
+    if (waiting) {
+      return {ExecutionState::WAITING, 0};
+    }
     return {state, available};
   }
 
@@ -26,6 +26,8 @@
 #include "Aql/ExecutionEngine.h"
 #include "Aql/OptimizerRulesFeature.h"
 #include "Aql/QueryOptions.h"
+#include "Basics/ScopeGuard.h"
+#include "Basics/system-functions.h"
 #include "Cluster/ServerState.h"
 #include "Logger/Logger.h"
 
@@ -94,9 +96,40 @@ void Optimizer::addPlan(std::unique_ptr<ExecutionPlan> plan,
   }
 }
 
+void Optimizer::keepCheapestPlan() {
+  TRI_ASSERT(!_plans.empty());
+
+  // plans may be at different optimizer rules here, so their costs are
+  // only an approximation of the costs of the finished plans
+  auto best = _plans.list.end();
+  for (auto it = _plans.list.begin(); it != _plans.list.end(); ++it) {
+    ExecutionPlan* p = (*it).first.get();
+    p->findVarUsage();
+    p->invalidateCost();
+    if (best == _plans.list.end() ||
+        p->getCost().estimatedCost < (*best).first->getCost().estimatedCost) {
+      best = it;
+    }
+  }
+
+  auto entry = std::move(*best);
+  _stats.plansDiscarded += _plans.size() - 1;
+  _plans.clear();
+  // the plan will still be changed by the remaining rules
+  entry.first->invalidateCost();
+  _plans.push_back(std::move(entry.first), entry.second);
+
+  LOG_TOPIC("2a9e1", DEBUG, Logger::QUERIES)
+      << "optimizer time budget used up, continuing with the cheapest of "
+      << (_stats.plansDiscarded + 1) << " plans";
+}
+
 // @brief the actual optimization
 int Optimizer::createPlans(std::unique_ptr<ExecutionPlan> plan,
                            QueryOptions const& queryOptions, bool estimateAllPlans) {
+  double const startTime = TRI_microtime();
+  TRI_DEFER(_stats.executionTime = TRI_microtime() - startTime);
+
   _runOnlyRequiredRules = false;
   ExecutionPlan* initialPlan = plan.get();
 
@@ -202,6 +235,16 @@ int Optimizer::createPlans(std::unique_ptr<ExecutionPlan> plan,
     // reuse them in the next iteration
     _plans.swap(_newPlans);
 
+    if (queryOptions.maxOptimizationTime > 0.0 &&
+        TRI_microtime() - startTime > queryOptions.maxOptimizationTime) {
+      // the time budget is used up. do not create any further plans, and
+      // only finish the cheapest plan we have so far
+      _runOnlyRequiredRules = true;
+      if (_plans.size() > 1) {
+        keepCheapestPlan();
+      }
+    }
+
     auto fully_optimized = [this](auto const& v) {
       return v.second == _rules.end();
     };
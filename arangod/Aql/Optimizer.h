@@ -43,12 +43,18 @@ class Optimizer {
     int64_t rulesExecuted = 0;
     int64_t rulesSkipped = 0;
     int64_t plansCreated = 1;  // 1 for the initial plan
+    /// @brief plans dropped because the time budget was used up
+    int64_t plansDiscarded = 0;
+    /// @brief seconds spent in createPlans
+    double executionTime = 0.0;
 
     void toVelocyPack(velocypack::Builder& b) const {
       velocypack::ObjectBuilder guard(&b, true);
       b.add("rulesExecuted", velocypack::Value(rulesExecuted));
       b.add("rulesSkipped", velocypack::Value(rulesSkipped));
       b.add("plansCreated", velocypack::Value(plansCreated));
+      b.add("plansDiscarded", velocypack::Value(plansDiscarded));
+      b.add("executionTime", velocypack::Value(executionTime));
     }
   };
 
@@ -137,6 +143,12 @@ class Optimizer {
   
   bool isDisabled(int rule) const;
 
+ private:
+  /// @brief estimates all current plans and drops all but the cheapest one
+  void keepCheapestPlan();
+
+ public:
+
   /// @brief getPlans, ownership of the plans remains with the optimizer
   RollingVector<PlanList::Entry>& getPlans() { return _plans.list; }
 
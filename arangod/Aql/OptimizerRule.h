@@ -136,6 +136,9 @@ struct OptimizerRule {
     /// "Pass 6": use indexes if possible for FILTER and/or SORT nodes
     // ======================================================
 
+    // add range conditions for prefix searches with LIKE and REGEX_TEST
+    addPrefixRangesRule,
+
     // replace simple OR conditions with IN
     replaceOrWithInRule,
 
@@ -158,6 +161,10 @@ struct OptimizerRule {
     // try to find sort blocks which are superseeded by indexes
     useIndexForSortRule,
 
+    // compute COLLECTs on attributes from sorted indexes only
+    // needs to run after use-index-for-sort
+    useIndexForCollectRule,
+
     // sort values used in IN comparisons of remaining filters
     sortInValuesRule,
 
@@ -169,6 +176,19 @@ struct OptimizerRule {
     // move filters and sort conditions into views and remove them
     handleArangoSearchViewsRule,
 
+    // replace index lookups for equality joins with merge joins, if the
+    // outer loop is sorted by the join attribute
+    mergeJoinRule,
+
+    // replace nested loop equality joins of collections with hash joins
+    // needs to run after index selection
+    hashJoinRule,
+
+    // evaluate FILTERs on the documents of full collection scans inside
+    // the scan. needs to run after index selection and the joins, and
+    // before the calculations of the FILTERs are removed
+    pushFiltersIntoEnumerateCollectionRule,
+
     // remove calculations that are redundant
     // needs to run after filter removal
     removeUnnecessaryCalculationsRule2,
@@ -245,6 +265,16 @@ struct OptimizerRule {
     // simplify an EnumerationCollectionNode that fetches an
     // entire document to a projection of this document
     reduceExtractionToProjectionRule,
+
+    // read only document ids and the needed attributes below a SORT +
+    // LIMIT, and the full documents after the LIMIT. must run after the
+    // projections have been determined
+    lateDocumentMaterializationRule,
+
+    // execute subqueries for a whole block of input rows at once, if all
+    // of their nodes handle every input row independently. must run after
+    // all rules that could change the subqueries
+    batchSubqueriesRule,
   };
 
   std::string name;
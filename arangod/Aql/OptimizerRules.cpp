@@ -24,6 +24,7 @@
 
 #include "OptimizerRules.h"
 #include "Aql/AqlItemBlock.h"
+#include "Aql/CardinalityEstimator.h"
 #include "Aql/ClusterNodes.h"
 #include "Aql/CollectNode.h"
 #include "Aql/CollectOptions.h"
@@ -34,12 +35,18 @@
 #include "Aql/ExecutionNode.h"
 #include "Aql/ExecutionPlan.h"
 #include "Aql/Function.h"
+#include "Aql/HashJoinNode.h"
 #include "Aql/IResearchViewNode.h"
+#include "Aql/IndexCollectNode.h"
 #include "Aql/IndexNode.h"
 #include "Aql/KShortestPathsNode.h"
+#include "Aql/MaterializeNode.h"
+#include "Aql/MergeJoinNode.h"
 #include "Aql/ModificationNodes.h"
 #include "Aql/Optimizer.h"
 #include "Aql/Query.h"
+#include "Aql/RegexCache.h"
+#include "Aql/ScanFilter.h"
 #include "Aql/ShortestPathNode.h"
 #include "Aql/SortCondition.h"
 #include "Aql/SortNode.h"
@@ -52,11 +59,14 @@
 #include "Basics/SmallVector.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/StringBuffer.h"
+#include "Basics/Utf8Helper.h"
+#include "Basics/VelocyPackHelper.h"
 #include "Cluster/ClusterInfo.h"
 #include "Geo/GeoParams.h"
 #include "GeoIndex/Index.h"
 #include "Graph/TraverserOptions.h"
 #include "Indexes/Index.h"
+#include "Sharding/ShardingInfo.h"
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "StorageEngine/StorageEngine.h"
 #include "Transaction/Methods.h"
@@ -83,7 +93,8 @@ bool accessesCollectionVariable(arangodb::aql::ExecutionPlan const* plan,
     }
     if (setter->getType() == EN::INDEX || setter->getType() == EN::ENUMERATE_COLLECTION ||
         setter->getType() == EN::ENUMERATE_IRESEARCH_VIEW ||
-        setter->getType() == EN::SUBQUERY ||
+        setter->getType() == EN::HASH_JOIN || setter->getType() == EN::MERGE_JOIN ||
+        setter->getType() == EN::MATERIALIZE || setter->getType() == EN::SUBQUERY ||
         setter->getType() == EN::TRAVERSAL ||
         setter->getType() == EN::K_SHORTEST_PATHS ||
         setter->getType() == EN::SHORTEST_PATH) {
@@ -518,6 +529,115 @@ void findShardKeysInExpression(arangodb::aql::AstNode const* root,
   }
 }
 
+/// @brief narrow the range of the shard key attribute with a comparison
+/// between the attribute and a constant. lower and upper stay empty if the
+/// range is not bounded on that side
+void findShardKeyRangeInComparison(arangodb::aql::AstNode const* root,
+                                   arangodb::aql::Variable const* inputVariable,
+                                   std::string const& shardKey,
+                                   arangodb::velocypack::Builder& lower,
+                                   arangodb::velocypack::Builder& upper) {
+  using arangodb::aql::AstNode;
+  using arangodb::aql::AstNodeType;
+  using arangodb::aql::Variable;
+
+  AstNodeType type = root->type;
+  if (type != AstNodeType::NODE_TYPE_OPERATOR_BINARY_LT &&
+      type != AstNodeType::NODE_TYPE_OPERATOR_BINARY_LE &&
+      type != AstNodeType::NODE_TYPE_OPERATOR_BINARY_GT &&
+      type != AstNodeType::NODE_TYPE_OPERATOR_BINARY_GE) {
+    return;
+  }
+
+  std::pair<Variable const*, std::vector<arangodb::basics::AttributeName>> pair;
+  auto lhs = root->getMember(0);
+  auto rhs = root->getMember(1);
+  AstNode const* value = nullptr;
+  bool isLower;
+  std::string result;
+
+  if (lhs->isAttributeAccessForVariable(pair, false) &&
+      pair.first == inputVariable && rhs->isConstant()) {
+    // attribute > value
+    value = rhs;
+    isLower = (type == AstNodeType::NODE_TYPE_OPERATOR_BINARY_GT ||
+               type == AstNodeType::NODE_TYPE_OPERATOR_BINARY_GE);
+  } else if (rhs->isAttributeAccessForVariable(pair, false) &&
+             pair.first == inputVariable && lhs->isConstant()) {
+    // value < attribute
+    value = lhs;
+    isLower = (type == AstNodeType::NODE_TYPE_OPERATOR_BINARY_LT ||
+               type == AstNodeType::NODE_TYPE_OPERATOR_BINARY_LE);
+  } else {
+    return;
+  }
+
+  TRI_AttributeNamesToString(pair.second, result, true);
+  if (result != shardKey) {
+    return;
+  }
+
+  VPackBuilder bound;
+  value->toVelocyPackValue(bound);
+
+  // keep the tightest bound
+  VPackBuilder& target = isLower ? lower : upper;
+  if (!target.isEmpty()) {
+    int cmp = arangodb::basics::VelocyPackHelper::compare(bound.slice(),
+                                                          target.slice(), true);
+    if ((isLower && cmp <= 0) || (!isLower && cmp >= 0)) {
+      return;
+    }
+  }
+  target = std::move(bound);
+}
+
+/// @brief find the single shard for the range of the only shard key attribute
+/// given by the comparisons in the expression, if the sharding strategy
+/// supports this (range sharding). returns an empty string otherwise
+std::string getSingleShardIdForRange(arangodb::aql::Collection const* collection,
+                                     arangodb::aql::AstNode const* root,
+                                     arangodb::aql::Variable const* inputVariable,
+                                     std::string const& shardKey) {
+  if (root == nullptr) {
+    return std::string();
+  }
+
+  if (root->type == arangodb::aql::AstNodeType::NODE_TYPE_OPERATOR_NARY_OR) {
+    if (root->numMembers() != 1) {
+      return std::string();
+    }
+    root = root->getMember(0);
+  }
+
+  VPackBuilder lower;
+  VPackBuilder upper;
+  if (root != nullptr &&
+      (root->type == arangodb::aql::AstNodeType::NODE_TYPE_OPERATOR_BINARY_AND ||
+       root->type == arangodb::aql::AstNodeType::NODE_TYPE_OPERATOR_NARY_AND)) {
+    for (size_t i = 0; i < root->numMembers(); ++i) {
+      if (root->getMember(i) != nullptr) {
+        findShardKeyRangeInComparison(root->getMember(i), inputVariable,
+                                      shardKey, lower, upper);
+      }
+    }
+  } else if (root != nullptr) {
+    findShardKeyRangeInComparison(root, inputVariable, shardKey, lower, upper);
+  }
+
+  if (lower.isEmpty() && upper.isEmpty()) {
+    return std::string();
+  }
+
+  std::string shardId;
+  if (!collection->getCollection()->shardingInfo()->getResponsibleShardForRange(
+          lower.isEmpty() ? VPackSlice::noneSlice() : lower.slice(),
+          upper.isEmpty() ? VPackSlice::noneSlice() : upper.slice(), shardId)) {
+    return std::string();
+  }
+  return shardId;
+}
+
 // static node types used by some optimizer rules
 // having them statically available avoids having to build the vectors over
 // and over for each AQL query
@@ -618,6 +738,10 @@ std::string getSingleShardId(arangodb::aql::ExecutionPlan const* plan,
   VPackBuilder builder;
   builder.openObject();
 
+  // the condition searched for the shard keys, and its variable
+  arangodb::aql::AstNode const* conditionRoot = nullptr;
+  arangodb::aql::Variable const* conditionVariable = nullptr;
+
   if (setter->getType() == EN::CALCULATION) {
     arangodb::aql::CalculationNode const* c =
         ExecutionNode::castTo<arangodb::aql::CalculationNode const*>(setter);
@@ -669,11 +793,13 @@ std::string getSingleShardId(arangodb::aql::ExecutionPlan const* plan,
         }
       }
     } else {
+      conditionRoot = n;
       if (nullptr != collectionVariable) {
-        ::findShardKeysInExpression(n, collectionVariable, toFind, builder);
+        conditionVariable = collectionVariable;
       } else {
-        ::findShardKeysInExpression(n, inputVariable, toFind, builder);
+        conditionVariable = inputVariable;
       }
+      ::findShardKeysInExpression(n, conditionVariable, toFind, builder);
     }
   } else if (setter->getType() == ExecutionNode::INDEX && setter == node) {
     auto const* c = ExecutionNode::castTo<arangodb::aql::IndexNode const*>(setter);
@@ -689,12 +815,20 @@ std::string getSingleShardId(arangodb::aql::ExecutionPlan const* plan,
     }
 
     arangodb::aql::AstNode const* root = condition->root();
+    conditionRoot = root;
+    conditionVariable = inputVariable;
     ::findShardKeysInExpression(root, inputVariable, toFind, builder);
   }
 
   builder.close();
 
   if (!toFind.empty()) {
+    if (shardKeys.size() == 1 && conditionRoot != nullptr) {
+      // range conditions on the only shard key may still restrict the
+      // operation to a single shard
+      return ::getSingleShardIdForRange(collection, conditionRoot,
+                                        conditionVariable, shardKeys[0]);
+    }
     return std::string();
   }
 
@@ -1670,7 +1804,8 @@ void arangodb::aql::moveCalculationsDownRule(Optimizer* opt,
         }
       } else if (currentType == EN::INDEX || currentType == EN::ENUMERATE_COLLECTION ||
                  currentType == EN::ENUMERATE_IRESEARCH_VIEW ||
-                 currentType == EN::ENUMERATE_LIST ||
+                 currentType == EN::ENUMERATE_LIST || currentType == EN::HASH_JOIN ||
+                 currentType == EN::MERGE_JOIN ||
                  currentType == EN::TRAVERSAL ||
                  currentType == EN::SHORTEST_PATH ||
                  currentType == EN::K_SHORTEST_PATHS ||
@@ -3424,16 +3559,7 @@ void arangodb::aql::interchangeAdjacentEnumerationsRule(Optimizer* opt,
   // independently. This is why we need to compute all permutation tuples.
 
   if (!starts.empty()) {
-    NextPermutationTuple(permTuple, starts);  // will never return false
-
-    do {
-      // check if we already have enough plans (plus the one plan that we will
-      // add at the end of this function)
-      if (opt->runOnlyRequiredRules(1)) {
-        // have enough plans. stop permutations
-        break;
-      }
-
+    auto addPermutedPlan = [&](std::vector<size_t> const& tuple) {
       // Clone the plan:
       std::unique_ptr<ExecutionPlan> newPlan(plan->clone());
 
@@ -3448,11 +3574,11 @@ void arangodb::aql::interchangeAdjacentEnumerationsRule(Optimizer* opt,
       // Now get going with the permutations:
       for (size_t i = 0; i < starts.size(); i++) {
         size_t lowBound = starts[i];
-        size_t highBound = (i < starts.size() - 1) ? starts[i + 1] : permTuple.size();
+        size_t highBound = (i < starts.size() - 1) ? starts[i + 1] : tuple.size();
         // We need to remove the nodes
         // newNodes[lowBound..highBound-1] in newPlan and replace
         // them by the same ones in a different order, given by
-        // permTuple[lowBound..highBound-1].
+        // tuple[lowBound..highBound-1].
         auto parent = newNodes[lowBound]->getFirstParent();
 
         TRI_ASSERT(parent != nullptr);
@@ -3464,12 +3590,51 @@ void arangodb::aql::interchangeAdjacentEnumerationsRule(Optimizer* opt,
 
         // And insert them in the new order:
         for (size_t j = highBound; j-- != lowBound;) {
-          newPlan->insertDependency(parent, newNodes[permTuple[j]]);
+          newPlan->insertDependency(parent, newNodes[tuple[j]]);
         }
       }
 
       // OK, the new plan is ready, let's report it:
       opt->addPlan(std::move(newPlan), rule, true);
+    };
+
+    // the order with the lowest estimated costs comes first, so that it
+    // is considered even if the permutations exceed the maximum number of
+    // plans. the runs are stored from the innermost loop to the outermost
+    // one, the estimator works from the outside in
+    CardinalityEstimator estimator(plan.get());
+    std::vector<size_t> bestTuple = permTuple;
+    for (size_t i = 0; i < starts.size(); i++) {
+      size_t lowBound = starts[i];
+      size_t highBound = (i < starts.size() - 1) ? starts[i + 1] : permTuple.size();
+      size_t n = highBound - lowBound;
+      std::vector<ExecutionNode*> loops(nodesToPermute.rend() - highBound,
+                                        nodesToPermute.rend() - lowBound);
+      std::vector<size_t> order = estimator.bestJoinOrder(loops);
+      TRI_ASSERT(order.size() == n);
+      for (size_t j = 0; j < n; j++) {
+        bestTuple[lowBound + j] = lowBound + (n - 1 - order[n - 1 - j]);
+      }
+    }
+    bool const reordered = (bestTuple != permTuple);
+    if (reordered && !opt->runOnlyRequiredRules(1)) {
+      addPermutedPlan(bestTuple);
+    }
+
+    NextPermutationTuple(permTuple, starts);  // will never return false
+
+    do {
+      // check if we already have enough plans (plus the one plan that we will
+      // add at the end of this function)
+      if (opt->runOnlyRequiredRules(1)) {
+        // have enough plans. stop permutations
+        break;
+      }
+      if (reordered && permTuple == bestTuple) {
+        // already added
+        continue;
+      }
+      addPermutedPlan(permTuple);
     } while (NextPermutationTuple(permTuple, starts));
   }
 
@@ -4518,6 +4683,10 @@ void arangodb::aql::distributeSortToClusterRule(Optimizer* opt,
         case EN::SHORTEST_PATH:
         case EN::REMOTESINGLE:
         case EN::ENUMERATE_IRESEARCH_VIEW:
+        case EN::HASH_JOIN:
+        case EN::MERGE_JOIN:
+        case EN::MATERIALIZE:
+        case EN::INDEX_COLLECT:
 
           // For all these, we do not want to pull a SortNode further down
           // out to the DBservers, note that potential FilterNodes and
@@ -5364,6 +5533,155 @@ struct OrSimplifier {
 //    x.val IN [1,2,3]
 //  when the OR conditions are present in the same FILTER node, and refer to the
 //  same (single) attribute.
+namespace {
+
+/// @brief build a range pre-filter for a LIKE or REGEX_TEST call that
+/// searches for a string prefix. returns nullptr if this is not possible.
+/// the range must include every value the function call can match:
+/// - the functions cast their operands to strings, whereas the comparison
+///   operators do not. the prefix must thus not match the string
+///   representation of any non-string value
+/// - the upper bound appends U+FFFF to the prefix, which sorts higher than
+///   any other character in ICU's root collation. this is not guaranteed
+///   for languages with contractions, so only English collations and ASCII
+///   prefixes are supported
+/// - the search must be case-sensitive
+AstNode* buildPrefixRange(Ast* ast, AstNode const* call) {
+  TRI_ASSERT(call->type == NODE_TYPE_FCALL);
+  auto func = static_cast<Function const*>(call->getData());
+  auto args = call->getMember(0);
+  if (args->numMembers() < 2) {
+    return nullptr;
+  }
+
+  AstNode* value = args->getMemberUnchecked(0);
+  AstNode const* pattern = args->getMemberUnchecked(1);
+  if (value->type != NODE_TYPE_ATTRIBUTE_ACCESS || !pattern->isStringValue()) {
+    return nullptr;
+  }
+  if (args->numMembers() >= 3) {
+    AstNode const* caseArg = args->getMemberUnchecked(2);
+    if (!caseArg->isConstant() || caseArg->isTrue()) {
+      // case-insensitive, or not known yet
+      return nullptr;
+    }
+  }
+
+  std::string prefix;
+  if (func->name == "LIKE") {
+    bool wildcardFound;
+    std::tie(wildcardFound, std::ignore) =
+        RegexCache::inspectLikePattern(prefix, pattern->getStringValue(),
+                                       pattern->getStringLength());
+    if (!wildcardFound) {
+      // LIKE without wildcards is an equality search, but is kept as it is
+      prefix.clear();
+    }
+  } else {
+    TRI_ASSERT(func->name == "REGEX_TEST");
+    RegexCache::inspectRegexPrefix(prefix, pattern->getStringValue(),
+                                   pattern->getStringLength());
+  }
+
+  if (prefix.empty()) {
+    return nullptr;
+  }
+  for (char c : prefix) {
+    if (static_cast<uint8_t>(c) < 0x20 || static_cast<uint8_t>(c) >= 0x80) {
+      return nullptr;
+    }
+  }
+  char const first = prefix[0];
+  if ((first >= '0' && first <= '9') || first == '-' || first == '[' ||
+      first == '{' || std::string("true").compare(0, prefix.size(), prefix) == 0 ||
+      std::string("false").compare(0, prefix.size(), prefix) == 0) {
+    // prefix of a stringified number, bool, array or object
+    return nullptr;
+  }
+
+  std::string const language =
+      basics::Utf8Helper::DefaultUtf8Helper.getCollatorLanguage();
+  if (!language.empty() && language != "en") {
+    return nullptr;
+  }
+
+  char const* p = ast->query()->registerString(prefix.data(), prefix.size());
+  AstNode* lower = ast->createNodeValueString(p, prefix.size());
+
+  prefix.append("\xef\xbf\xbf");  // U+FFFF
+  p = ast->query()->registerString(prefix.data(), prefix.size());
+  AstNode* upper = ast->createNodeValueString(p, prefix.size());
+
+  return ast->createNodeBinaryOperator(
+      NODE_TYPE_OPERATOR_BINARY_AND,
+      ast->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_GE, value, lower),
+      ast->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_LE, value, upper));
+}
+
+/// @brief add range pre-filters to all prefix searches in the top-level
+/// AND of a filter condition
+AstNode* addPrefixRanges(Ast* ast, AstNode* node) {
+  if (node->type == NODE_TYPE_OPERATOR_BINARY_AND) {
+    AstNode* lhs = node->getMemberUnchecked(0);
+    AstNode* rhs = node->getMemberUnchecked(1);
+    AstNode* newLhs = addPrefixRanges(ast, lhs);
+    AstNode* newRhs = addPrefixRanges(ast, rhs);
+    if (newLhs == lhs && newRhs == rhs) {
+      return node;
+    }
+    return ast->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_AND, newLhs, newRhs);
+  }
+
+  if (node->type == NODE_TYPE_FCALL) {
+    auto func = static_cast<Function const*>(node->getData());
+    if (func->name == "LIKE" || func->name == "REGEX_TEST") {
+      AstNode* range = ::buildPrefixRange(ast, node);
+      if (range != nullptr) {
+        // keep the original call, the range is only a pre-filter
+        return ast->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_AND, range, node);
+      }
+    }
+  }
+
+  return node;
+}
+
+}  // namespace
+
+/// @brief add range conditions for prefix searches with LIKE and
+/// REGEX_TEST, so they can use sorted indexes
+void arangodb::aql::addPrefixRangesRule(Optimizer* opt, std::unique_ptr<ExecutionPlan> plan,
+                                        OptimizerRule const* rule) {
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, EN::FILTER, true);
+
+  bool modified = false;
+  for (auto const& n : nodes) {
+    auto fn = ExecutionNode::castTo<FilterNode const*>(n);
+    auto setter = plan->getVarSetBy(fn->inVariable()->id);
+    if (setter == nullptr || setter->getType() != EN::CALCULATION) {
+      continue;
+    }
+
+    auto cn = ExecutionNode::castTo<CalculationNode*>(setter);
+    if (!cn->expression()->isDeterministic()) {
+      continue;
+    }
+
+    AstNode* root = cn->expression()->nodeForModification();
+    AstNode* newRoot = ::addPrefixRanges(plan->getAst(), root);
+
+    if (newRoot != root) {
+      cn->expression()->replaceNode(newRoot);
+      cn->expression()->invalidateAfterReplacements();
+      modified = true;
+    }
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
 void arangodb::aql::replaceOrWithInRule(Optimizer* opt, std::unique_ptr<ExecutionPlan> plan,
                                         OptimizerRule const* rule) {
   SmallVector<ExecutionNode*>::allocator_type::arena_type a;
@@ -5705,7 +6023,8 @@ void arangodb::aql::patchUpdateStatementsRule(Optimizer* opt,
 
       if (type == EN::ENUMERATE_LIST ||
           type == EN::ENUMERATE_IRESEARCH_VIEW ||
-          type == EN::SUBQUERY) {
+          type == EN::HASH_JOIN || type == EN::MERGE_JOIN ||
+          type == EN::INDEX_COLLECT || type == EN::SUBQUERY) {
         // not suitable
         modified = false;
         break;
@@ -6476,9 +6795,10 @@ static bool checkDistanceFunc(ExecutionPlan* plan, AstNode const* funcNode,
   return false;
 }
 
-// contains the AstNode* a supported function?
+// contains the AstNode* a supported function? "exact" is set to false if
+// the index only returns candidates and the filter must be kept
 static bool checkGeoFilterFunction(ExecutionPlan* plan, AstNode const* funcNode,
-                                   GeoIndexInfo& info) {
+                                   GeoIndexInfo& info, bool& exact) {
   // note: this only modifies "info" if the function returns true
   // the expression must exist and it must be a function call
   if (funcNode->type != NODE_TYPE_FCALL || funcNode->numMembers() != 1 ||
@@ -6500,6 +6820,21 @@ static bool checkGeoFilterFunction(ExecutionPlan* plan, AstNode const* funcNode,
     info.filterMode = contains ? geo::FilterType::CONTAINS : geo::FilterType::INTERSECTS;
     info.filterExpr = fargs->getMemberUnchecked(0);
     TRI_ASSERT(info.index);
+    exact = true;
+    return true;
+  }
+
+  // GEO_CONTAINS(doc.geometry, x) and GEO_INTERSECTS(doc.geometry, x) are
+  // answered by looking up the documents whose indexed shape intersects x.
+  // a join of points and regions then does one index lookup per point
+  // instead of testing every region. a shape that contains x also
+  // intersects it, so for GEO_CONTAINS the filter stays in place
+  arg = fargs->getMemberUnchecked(0);
+  if (geoFuncArgCheck(plan, arg, /*legacy*/ false, info)) {
+    info.filterMode = geo::FilterType::INTERSECTS;
+    info.filterExpr = fargs->getMemberUnchecked(1);
+    TRI_ASSERT(info.index);
+    exact = intersect;
     return true;
   }
   return false;
@@ -6531,13 +6866,16 @@ bool checkGeoFilterExpression(ExecutionPlan* plan, AstNode const* node, GeoIndex
   };
 
   switch (node->type) {
-    case NODE_TYPE_FCALL:
-      if (checkGeoFilterFunction(plan, node, info)) {
-        info.nodesToRemove.insert(node);
+    case NODE_TYPE_FCALL: {
+      bool exact = true;
+      if (checkGeoFilterFunction(plan, node, info, exact)) {
+        if (exact) {
+          info.nodesToRemove.insert(node);
+        }
         return true;
       }
       return false;
-      break;
+    }
     // only DISTANCE is allowed with <=, <, >=, >
     case NODE_TYPE_OPERATOR_BINARY_LE:
       TRI_ASSERT(node->numMembers() == 2);
@@ -6854,6 +7192,9 @@ void arangodb::aql::geoIndexRule(Optimizer* opt, std::unique_ptr<ExecutionPlan>
                  current->getType() == EN::ENUMERATE_COLLECTION ||
                  current->getType() == EN::ENUMERATE_LIST ||
                  current->getType() == EN::ENUMERATE_IRESEARCH_VIEW ||
+                 current->getType() == EN::HASH_JOIN ||
+                 current->getType() == EN::MERGE_JOIN ||
+                 current->getType() == EN::INDEX_COLLECT ||
                  current->getType() == EN::TRAVERSAL ||
                  current->getType() == EN::K_SHORTEST_PATHS ||
                  current->getType() == EN::SHORTEST_PATH) {
@@ -6896,6 +7237,9 @@ void arangodb::aql::sortLimitRule(Optimizer* opt, std::unique_ptr<ExecutionPlan>
                  current->getType() == EN::ENUMERATE_COLLECTION ||
                  current->getType() == EN::ENUMERATE_LIST ||
                  current->getType() == EN::ENUMERATE_IRESEARCH_VIEW ||
+                 current->getType() == EN::HASH_JOIN ||
+                 current->getType() == EN::MERGE_JOIN ||
+                 current->getType() == EN::INDEX_COLLECT ||
                  current->getType() == EN::TRAVERSAL ||
                  current->getType() == EN::SHORTEST_PATH ||
                  current->getType() == EN::K_SHORTEST_PATHS ||
@@ -7118,3 +7462,729 @@ void arangodb::aql::optimizeSubqueriesRule(Optimizer* opt,
 
   opt->addPlan(std::move(plan), rule, modified);
 }
+
+namespace {
+
+/// @brief check if the condition is an equality comparison of an attribute
+/// of variable with an expression that does not depend on variable. returns
+/// the attribute path and the other side of the comparison
+bool isEqualityJoinCondition(arangodb::aql::AstNode const* node,
+                         arangodb::aql::Variable const* variable,
+                         std::vector<std::string>& attribute,
+                         arangodb::aql::AstNode const*& other) {
+  using namespace arangodb::aql;
+
+  if (node == nullptr || node->type != NODE_TYPE_OPERATOR_BINARY_EQ) {
+    return false;
+  }
+
+  for (size_t i = 0; i < 2; ++i) {
+    AstNode const* lhs = node->getMemberUnchecked(i);
+    AstNode const* rhs = node->getMemberUnchecked(1 - i);
+
+    std::pair<Variable const*, std::vector<arangodb::basics::AttributeName>> result;
+    if (!lhs->isAttributeAccessForVariable(result, false) || result.first != variable) {
+      continue;
+    }
+
+    arangodb::HashSet<Variable const*> vars;
+    Ast::getReferencedVariables(rhs, vars);
+    if (vars.find(variable) != vars.end()) {
+      continue;
+    }
+
+    attribute.clear();
+    for (auto const& it : result.second) {
+      if (it.shouldExpand) {
+        return false;
+      }
+      attribute.emplace_back(it.name);
+    }
+    if (attribute.empty() || attribute[0] == arangodb::StaticStrings::IdString) {
+      // _id is stored as a custom type, which cannot be compared
+      // to the probe values directly
+      return false;
+    }
+    other = rhs;
+    return true;
+  }
+
+  return false;
+}
+
+}  // namespace
+
+/// @brief replace FOR b IN collection FILTER b.attr == expr(a) with a
+/// hash join, if the enumeration is executed for more than a single row
+void arangodb::aql::hashJoinRule(Optimizer* opt, std::unique_ptr<ExecutionPlan> plan,
+                                 OptimizerRule const* rule) {
+  bool modified = false;
+
+  if (arangodb::ServerState::instance()->isCoordinator()) {
+    // collections are sharded in the cluster, and enumerations are
+    // distributed to the DB servers
+    opt->addPlan(std::move(plan), rule, modified);
+    return;
+  }
+
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, EN::ENUMERATE_COLLECTION, true);
+
+  if (nodes.empty()) {
+    opt->addPlan(std::move(plan), rule, modified);
+    return;
+  }
+
+  // the hash table is built only once per query, so it must not miss any
+  // modifications the query makes to the collection
+  SmallVector<ExecutionNode*>::allocator_type::arena_type b;
+  SmallVector<ExecutionNode*> modificationNodes{b};
+  plan->findNodesOfType(modificationNodes,
+                        {EN::INSERT, EN::UPDATE, EN::REPLACE, EN::REMOVE, EN::UPSERT}, true);
+
+  plan->findVarUsage();
+
+  for (auto const& n : nodes) {
+    auto en = ExecutionNode::castTo<EnumerateCollectionNode*>(n);
+
+    if (!en->isDeterministic() || en->hint().type() != IndexHint::None) {
+      continue;
+    }
+
+    bool modifiedLater = false;
+    for (auto const& m : modificationNodes) {
+      if (ExecutionNode::castTo<ModificationNode const*>(m)->collection() == en->collection()) {
+        modifiedLater = true;
+        break;
+      }
+    }
+    if (modifiedLater) {
+      continue;
+    }
+
+    ExecutionNode* dependency = en->getFirstDependency();
+    TRI_ASSERT(dependency != nullptr);
+
+    // compare the costs of the nested loop with the hash join
+    double const incoming = static_cast<double>(dependency->getCost().estimatedNrItems);
+    double const count = static_cast<double>(en->collection()->count(plan->getAst()->query()->trx()));
+    if (incoming * count <= incoming + count) {
+      continue;
+    }
+
+    // look for a FILTER on a suitable condition directly after the
+    // enumeration
+    FilterNode* filter = nullptr;
+    std::vector<std::string> attribute;
+    AstNode const* other = nullptr;
+
+    ExecutionNode* current = en->getFirstParent();
+    while (current != nullptr &&
+           (current->getType() == EN::CALCULATION || current->getType() == EN::FILTER)) {
+      if (current->getType() == EN::FILTER) {
+        auto fn = ExecutionNode::castTo<FilterNode*>(current);
+        auto setter = plan->getVarSetBy(fn->inVariable()->id);
+        if (setter != nullptr && setter->getType() == EN::CALCULATION) {
+          auto cn = ExecutionNode::castTo<CalculationNode*>(setter);
+          if (cn->expression()->isDeterministic() &&
+              ::isEqualityJoinCondition(cn->expression()->node(), en->outVariable(),
+                                    attribute, other)) {
+            // all variables of the probe expression must be available
+            // before the enumeration
+            arangodb::HashSet<Variable const*> vars;
+            Ast::getReferencedVariables(other, vars);
+            auto const& valid = dependency->getVarsValid();
+            bool usable = true;
+            for (auto const& it : vars) {
+              if (valid.find(it) == valid.end()) {
+                usable = false;
+                break;
+              }
+            }
+            if (usable) {
+              filter = fn;
+              break;
+            }
+          }
+        }
+      }
+      current = current->getFirstParent();
+    }
+
+    if (filter == nullptr) {
+      continue;
+    }
+
+    // compute the probe values before the join
+    Ast* ast = plan->getAst();
+    Variable* keyVariable = ast->variables()->createTemporaryVariable();
+    auto expr = std::make_unique<Expression>(plan.get(), ast, ast->clone(other));
+    auto calculation = new CalculationNode(plan.get(), plan->nextId(), expr.get(), keyVariable);
+    expr.release();
+    plan->registerNode(calculation);
+
+    auto join = new HashJoinNode(plan.get(), plan->nextId(), en->collection(),
+                                 en->outVariable(), keyVariable, attribute);
+    plan->registerNode(join);
+    plan->replaceNode(en, join);
+    plan->insertDependency(join, calculation);
+
+    // the filter condition is now implied by the join. its calculation is
+    // left alone, in case it is used elsewhere
+    plan->unlinkNode(filter);
+    modified = true;
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
+/// @brief move FILTERs on the documents of a full collection scan into the
+/// scan, so that documents that do not match are never copied into the
+/// output registers.
+/// FOR doc IN collection FILTER doc.a == 1 && doc.b IN [1, 2] RETURN doc
+void arangodb::aql::pushFiltersIntoEnumerateCollectionRule(Optimizer* opt,
+                                                           std::unique_ptr<ExecutionPlan> plan,
+                                                           OptimizerRule const* rule) {
+  bool modified = false;
+
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, EN::ENUMERATE_COLLECTION, true);
+
+  if (nodes.empty()) {
+    opt->addPlan(std::move(plan), rule, modified);
+    return;
+  }
+
+  plan->findVarUsage();
+
+  bool const isCoordinator = arangodb::ServerState::instance()->isCoordinator();
+  Ast* ast = plan->getAst();
+
+  for (auto const& n : nodes) {
+    auto en = ExecutionNode::castTo<EnumerateCollectionNode*>(n);
+
+    std::vector<std::string> shardKeys;
+    if (isCoordinator) {
+      // the cluster rules still need to see FILTERs on the shard keys
+      shardKeys = en->collection()->shardKeys(true);
+    }
+
+    std::vector<FilterNode*> filters;
+    AstNode* condition = nullptr;
+    if (en->filter() != nullptr) {
+      condition = ast->clone(en->filter()->node());
+    }
+
+    ExecutionNode* current = en->getFirstParent();
+    while (current != nullptr &&
+           (current->getType() == EN::CALCULATION || current->getType() == EN::FILTER)) {
+      if (current->getType() == EN::FILTER) {
+        auto fn = ExecutionNode::castTo<FilterNode*>(current);
+        auto setter = plan->getVarSetBy(fn->inVariable()->id);
+        if (setter != nullptr && setter->getType() == EN::CALCULATION) {
+          auto cn = ExecutionNode::castTo<CalculationNode*>(setter);
+          AstNode const* node = cn->expression()->node();
+          bool usable = ScanFilter::supports(node, en->outVariable());
+          if (usable && !shardKeys.empty()) {
+            std::unordered_set<std::string> attributes;
+            Ast::getReferencedAttributes(node, en->outVariable(), attributes);
+            for (auto const& it : shardKeys) {
+              if (attributes.find(it) != attributes.end()) {
+                usable = false;
+                break;
+              }
+            }
+          }
+          if (usable) {
+            AstNode* copy = ast->clone(node);
+            condition = (condition == nullptr
+                             ? copy
+                             : ast->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_AND,
+                                                             condition, copy));
+            filters.emplace_back(fn);
+          }
+        }
+      }
+      current = current->getFirstParent();
+    }
+
+    if (filters.empty()) {
+      continue;
+    }
+
+    en->filter(std::make_unique<Expression>(plan.get(), ast, condition));
+    // the calculations of the conditions are removed later if they are not
+    // used elsewhere
+    for (auto const& fn : filters) {
+      plan->unlinkNode(fn);
+    }
+    modified = true;
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
+namespace {
+
+/// @brief whether the index returns all documents sorted by attribute
+bool isSortedIndexOn(arangodb::transaction::Methods::IndexHandle const& handle,
+                     std::vector<std::string> const& attribute, bool requireNonSparse) {
+  auto index = handle.getIndex();
+  if (index == nullptr || !index->isSorted() || index->hasExpansion() ||
+      (requireNonSparse && index->sparse()) ||
+      index->type() == arangodb::Index::TRI_IDX_TYPE_PRIMARY_INDEX ||
+      index->type() == arangodb::Index::TRI_IDX_TYPE_EDGE_INDEX) {
+    return false;
+  }
+
+  auto const& fields = index->fields();
+  if (fields.empty() || fields[0].size() != attribute.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < attribute.size(); ++i) {
+    if (fields[0][i].shouldExpand || fields[0][i].name != attribute[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+/// @brief replace index lookups for b.attr == a.attr with a merge join, if
+/// the outer loop already produces the documents sorted by a.attr
+void arangodb::aql::mergeJoinRule(Optimizer* opt, std::unique_ptr<ExecutionPlan> plan,
+                                  OptimizerRule const* rule) {
+  bool modified = false;
+
+  if (arangodb::ServerState::instance()->isCoordinator()) {
+    // the index nodes are distributed to the DB servers, where the
+    // outer loop is not globally sorted anymore
+    opt->addPlan(std::move(plan), rule, modified);
+    return;
+  }
+
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, EN::INDEX, true);
+
+  for (auto const& n : nodes) {
+    auto inner = ExecutionNode::castTo<IndexNode*>(n);
+    auto outer = inner->getLoop();
+
+    if (outer == nullptr || outer->getType() != EN::INDEX ||
+        inner->getIndexes().size() != 1) {
+      continue;
+    }
+
+    // the inner lookup must be a single equality condition
+    AstNode const* root = inner->condition()->root();
+    if (root == nullptr || root->numMembers() != 1 ||
+        root->getMemberUnchecked(0)->numMembers() != 1) {
+      continue;
+    }
+
+    std::vector<std::string> attribute;
+    AstNode const* other = nullptr;
+    if (!::isEqualityJoinCondition(root->getMemberUnchecked(0)->getMemberUnchecked(0),
+                                   inner->outVariable(), attribute, other) ||
+        !::isSortedIndexOn(inner->getIndexes()[0], attribute, true)) {
+      continue;
+    }
+
+    // the documents of the outer loop must arrive sorted by the other
+    // side of the comparison
+    auto outerIndex = ExecutionNode::castTo<IndexNode const*>(outer);
+    std::pair<Variable const*, std::vector<arangodb::basics::AttributeName>> access;
+    if (outer->getLoop() != nullptr || outerIndex->getIndexes().size() != 1 ||
+        !outerIndex->options().sorted || !outerIndex->options().ascending ||
+        (outerIndex->condition()->root() != nullptr &&
+         outerIndex->condition()->root()->numMembers() > 1) ||
+        !other->isAttributeAccessForVariable(access, false) ||
+        access.first != outerIndex->outVariable()) {
+      continue;
+    }
+    std::vector<std::string> outerAttribute;
+    for (auto const& it : access.second) {
+      outerAttribute.emplace_back(it.name);
+    }
+    if (!::isSortedIndexOn(outerIndex->getIndexes()[0], outerAttribute, false)) {
+      continue;
+    }
+
+    // anything between the loops must retain the order
+    bool retainsOrder = true;
+    for (ExecutionNode* current = inner->getFirstDependency(); current != outer;
+         current = current->getFirstDependency()) {
+      if (current->getType() != EN::CALCULATION && current->getType() != EN::FILTER) {
+        retainsOrder = false;
+        break;
+      }
+    }
+    if (!retainsOrder) {
+      continue;
+    }
+
+    // compare the costs of the index lookups with the merge join
+    ExecutionNode* dependency = inner->getFirstDependency();
+    CostEstimate const before = dependency->getCost();
+    double const lookups = inner->getCost().estimatedCost - before.estimatedCost;
+    double const merge =
+        static_cast<double>(inner->collection()->count(plan->getAst()->query()->trx())) +
+        static_cast<double>(before.estimatedNrItems);
+    if (merge >= lookups) {
+      continue;
+    }
+
+    // compute the probe values before the join
+    Ast* ast = plan->getAst();
+    Variable* keyVariable = ast->variables()->createTemporaryVariable();
+    auto expr = std::make_unique<Expression>(plan.get(), ast, ast->clone(other));
+    auto calculation = new CalculationNode(plan.get(), plan->nextId(), expr.get(), keyVariable);
+    expr.release();
+    plan->registerNode(calculation);
+
+    auto join = new MergeJoinNode(plan.get(), plan->nextId(), inner->collection(),
+                                  inner->outVariable(), keyVariable, attribute,
+                                  inner->getIndexes()[0]);
+    plan->registerNode(join);
+    plan->replaceNode(inner, join);
+    plan->insertDependency(join, calculation);
+    modified = true;
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
+/// @brief replace
+///   FOR doc IN collection COLLECT value = doc.attr [WITH COUNT INTO count]
+/// with a scan of a sorted index on attr, which forms the groups from the
+/// values in the index entries, without reading the documents. the rule
+/// looks at the plans in which the sort of the COLLECT has already been
+/// replaced by a full scan of the index
+void arangodb::aql::useIndexForCollectRule(Optimizer* opt, std::unique_ptr<ExecutionPlan> plan,
+                                           OptimizerRule const* rule) {
+  bool modified = false;
+
+  if (arangodb::ServerState::instance()->isCoordinator()) {
+    // the index scans are distributed to the DB servers, and their groups
+    // would have to be merged
+    opt->addPlan(std::move(plan), rule, modified);
+    return;
+  }
+
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, EN::COLLECT, true);
+
+  for (auto const& n : nodes) {
+    auto collectNode = ExecutionNode::castTo<CollectNode*>(n);
+
+    if (collectNode->aggregationMethod() != CollectOptions::CollectMethod::SORTED ||
+        collectNode->groupVariables().size() != 1 ||
+        !collectNode->aggregateVariables().empty() ||
+        collectNode->hasExpressionVariable() || collectNode->hasKeepVariables() ||
+        collectNode->hasOutVariableButNoCount()) {
+      continue;
+    }
+
+    // the group value must be an attribute of the documents of the index
+    // scan directly before
+    ExecutionNode* dependency = collectNode->getFirstDependency();
+    if (dependency == nullptr || dependency->getType() != EN::CALCULATION) {
+      continue;
+    }
+    auto calculation = ExecutionNode::castTo<CalculationNode*>(dependency);
+    if (calculation->outVariable() != collectNode->groupVariables()[0].second) {
+      continue;
+    }
+
+    dependency = calculation->getFirstDependency();
+    if (dependency == nullptr || dependency->getType() != EN::INDEX) {
+      continue;
+    }
+    auto indexNode = ExecutionNode::castTo<IndexNode*>(dependency);
+
+    std::pair<Variable const*, std::vector<arangodb::basics::AttributeName>> access;
+    if (!calculation->expression()->node()->isAttributeAccessForVariable(access, false) ||
+        access.first != indexNode->outVariable()) {
+      continue;
+    }
+    std::vector<std::string> attribute;
+    for (auto const& it : access.second) {
+      attribute.emplace_back(it.name);
+    }
+
+    // the index has to be scanned completely, in its sort order
+    AstNode const* root = indexNode->condition()->root();
+    if (indexNode->getIndexes().size() != 1 || !indexNode->options().sorted ||
+        (root != nullptr && root->numMembers() > 0) ||
+        indexNode->docIdVariable() != nullptr ||
+        !::isSortedIndexOn(indexNode->getIndexes()[0], attribute, true) ||
+        !indexNode->getIndexes()[0].getIndex()->hasCoveringIterator()) {
+      continue;
+    }
+
+    auto node = new IndexCollectNode(plan.get(), plan->nextId(), indexNode->collection(),
+                                     indexNode->getIndexes()[0],
+                                     collectNode->groupVariables()[0].first,
+                                     collectNode->count() ? collectNode->outVariable() : nullptr);
+    plan->registerNode(node);
+    plan->unlinkNode(calculation);
+    plan->unlinkNode(indexNode);
+    plan->replaceNode(collectNode, node);
+    modified = true;
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
+namespace {
+
+/// @brief maximum number of attributes the SORT and FILTER conditions may
+/// use from the document. same limit as for projections
+constexpr size_t maxLateMaterializationAttributes = 5;
+
+/// @brief whether a node that uses the document variable can be switched
+/// over to use the materialized document instead. nodes of a subquery are
+/// checked when the subquery is walked
+bool canUseMaterializedDocument(ExecutionNode& node, Variable const* v) {
+  arangodb::HashSet<Variable const*> vars;
+  node.getVariablesUsedHere(vars);
+  if (vars.find(v) == vars.end()) {
+    return true;
+  }
+
+  switch (node.getType()) {
+    case EN::ENUMERATE_LIST:
+    case EN::RETURN:
+    case EN::CALCULATION:
+    case EN::FILTER:
+    case EN::SORT:
+    case EN::SUBQUERY:
+      return true;
+    default:
+      return false;
+  }
+}
+
+class MaterializedDocumentChecker final : public WalkerWorker<ExecutionNode> {
+ public:
+  explicit MaterializedDocumentChecker(Variable const* v)
+      : _variable(v), _possible(true) {}
+
+  bool before(ExecutionNode* en) override final {
+    if (!::canUseMaterializedDocument(*en, _variable)) {
+      _possible = false;
+      return true;
+    }
+    return false;
+  }
+
+  bool possible() const { return _possible; }
+
+ private:
+  Variable const* _variable;
+  bool _possible;
+};
+
+}  // namespace
+
+/// @brief read only the document ids and the attributes needed for sorting
+/// below a SORT + LIMIT, and read the full documents after the LIMIT
+void arangodb::aql::lateDocumentMaterializationRule(Optimizer* opt,
+                                                    std::unique_ptr<ExecutionPlan> plan,
+                                                    OptimizerRule const* rule) {
+  bool modified = false;
+
+  if (arangodb::ServerState::instance()->isCoordinator()) {
+    // the documents are produced on the DB servers, and the document ids
+    // are only meaningful there
+    opt->addPlan(std::move(plan), rule, modified);
+    return;
+  }
+
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, EN::LIMIT, true);
+
+  arangodb::HashSet<Variable const*> vars;
+  std::unordered_set<std::string> attributes;
+
+  for (auto const& limit : nodes) {
+    // find the node that produces the documents. only SORT, FILTER and
+    // CALCULATION nodes may be in between, and there must be a SORT
+    bool sorted = false;
+    ExecutionNode* source = limit->getFirstDependency();
+    while (source != nullptr) {
+      auto const type = source->getType();
+      if (type == EN::SORT) {
+        sorted = true;
+      } else if (type != EN::FILTER && type != EN::CALCULATION) {
+        break;
+      }
+      source = source->getFirstDependency();
+    }
+
+    if (!sorted || source == nullptr ||
+        (source->getType() != EN::ENUMERATE_COLLECTION && source->getType() != EN::INDEX) ||
+        !source->isDeterministic()) {
+      continue;
+    }
+
+    auto documentNode = dynamic_cast<DocumentProducingNode*>(source);
+    auto collectionNode = dynamic_cast<CollectionAccessingNode*>(source);
+    TRI_ASSERT(documentNode != nullptr && collectionNode != nullptr);
+    if (!documentNode->projections().empty() || documentNode->docIdVariable() != nullptr) {
+      continue;
+    }
+
+    Variable const* v = documentNode->outVariable();
+    if (!limit->isVarUsedLater(v)) {
+      // the full documents are not needed anyway
+      continue;
+    }
+
+    // below the LIMIT, the document may only be used via attribute accesses
+    // in calculations. these attributes will be read as a projection
+    bool possible = true;
+    attributes.clear();
+    for (ExecutionNode* current = limit->getFirstDependency(); current != source;
+         current = current->getFirstDependency()) {
+      vars.clear();
+      current->getVariablesUsedHere(vars);
+      if (vars.find(v) == vars.end()) {
+        continue;
+      }
+      if (current->getType() != EN::CALCULATION ||
+          !Ast::getReferencedAttributes(
+              ExecutionNode::castTo<CalculationNode*>(current)->expression()->node(),
+              v, attributes)) {
+        possible = false;
+        break;
+      }
+    }
+
+    if (!possible || attributes.empty() ||
+        attributes.size() > ::maxLateMaterializationAttributes) {
+      continue;
+    }
+
+    // above the LIMIT, all nodes using the document must be able to use the
+    // materialized document instead
+    for (ExecutionNode* current = limit->getFirstParent(); current != nullptr && possible;
+         current = current->getFirstParent()) {
+      possible = ::canUseMaterializedDocument(*current, v);
+      if (possible && current->getType() == EN::SUBQUERY) {
+        MaterializedDocumentChecker checker(v);
+        ExecutionNode::castTo<SubqueryNode*>(current)->getSubquery()->walk(checker);
+        possible = checker.possible();
+      }
+    }
+
+    if (!possible) {
+      continue;
+    }
+
+    Variable const* docIdVariable = plan->getAst()->variables()->createTemporaryVariable();
+    Variable const* outVariable = plan->getAst()->variables()->createTemporaryVariable();
+
+    documentNode->projections(std::move(attributes));
+    documentNode->docIdVariable(docIdVariable);
+    if (source->getType() == EN::INDEX) {
+      // the projection may now be covered by the index
+      ExecutionNode::castTo<IndexNode*>(source)->initIndexCoversProjections();
+    }
+
+    auto materialize = new MaterializeNode(plan.get(), plan->nextId(),
+                                           collectionNode->collection(),
+                                           docIdVariable, outVariable);
+    plan->registerNode(materialize);
+    plan->insertAfter(limit, materialize);
+
+    std::unordered_map<VariableId, Variable const*> replacements;
+    replacements.emplace(v->id, outVariable);
+    RedundantCalculationsReplacer replacer(plan->getAst(), replacements);
+    for (ExecutionNode* current = materialize->getFirstParent(); current != nullptr;
+         current = current->getFirstParent()) {
+      replacer.before(current);
+      if (current->getType() == EN::SUBQUERY) {
+        ExecutionNode::castTo<SubqueryNode*>(current)->getSubquery()->walk(replacer);
+      }
+    }
+
+    modified = true;
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
+namespace {
+
+/// @brief whether all nodes of a subquery produce their output rows for
+/// every input row independently, and in the order of the input rows. only
+/// then the subquery can be executed for many input rows at once
+bool isRowLocalSubquery(ExecutionNode const* node) {
+  // subqueries are a single chain of nodes
+  while (node != nullptr) {
+    switch (node->getType()) {
+      case EN::SINGLETON:
+      case EN::CALCULATION:
+      case EN::FILTER:
+      case EN::ENUMERATE_LIST:
+      case EN::ENUMERATE_COLLECTION:
+      case EN::INDEX:
+      case EN::SUBQUERY:
+      case EN::RETURN:
+        break;
+      default:
+        // e.g. LIMIT, SORT and COLLECT work on all of their input rows,
+        // and the cluster nodes cannot pass a batch on
+        return false;
+    }
+    node = node->getFirstDependency();
+  }
+  return true;
+}
+
+}  // namespace
+
+/// @brief execute suitable subqueries for a whole block of input rows at
+/// once. every row of the batch is marked with its number, which the
+/// subquery returns together with its results, so the SubqueryExecutor can
+/// assign the results to their input rows
+void arangodb::aql::batchSubqueriesRule(Optimizer* opt, std::unique_ptr<ExecutionPlan> plan,
+                                        OptimizerRule const* rule) {
+  bool modified = false;
+
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, EN::SUBQUERY, true);
+
+  for (auto const& n : nodes) {
+    auto sq = ExecutionNode::castTo<SubqueryNode*>(n);
+    if (sq->rowIdVariable() != nullptr) {
+      // already batched
+      continue;
+    }
+    if (sq->isModificationSubquery() || sq->isConst()) {
+      // modifications must be executed row by row, and const subqueries are
+      // executed only once per block anyway
+      continue;
+    }
+
+    ExecutionNode* root = sq->getSubquery();
+    if (root == nullptr || root->getType() != EN::RETURN || !::isRowLocalSubquery(root)) {
+      continue;
+    }
+
+    Variable const* rowId = plan->getAst()->variables()->createTemporaryVariable();
+    sq->rowIdVariable(rowId);
+    ExecutionNode::castTo<ReturnNode*>(root)->rowIdVariable(rowId);
+    modified = true;
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
@@ -105,12 +105,25 @@ void removeRedundantCalculationsRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
 void removeUnnecessaryCalculationsRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
                                        OptimizerRule const*);
 
+/// @brief replace index lookups joined by equality with a merge join
+void mergeJoinRule(Optimizer*, std::unique_ptr<ExecutionPlan>, OptimizerRule const*);
+
+/// @brief replace collection enumerations joined by equality with a hash join
+void hashJoinRule(Optimizer*, std::unique_ptr<ExecutionPlan>, OptimizerRule const*);
+
+/// @brief move FILTERs into full collection scans
+void pushFiltersIntoEnumerateCollectionRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
+                                            OptimizerRule const*);
+
 /// @brief useIndex, try to use an index for filtering
 void useIndexesRule(Optimizer*, std::unique_ptr<ExecutionPlan>, OptimizerRule const*);
 
 /// @brief try to use the index for sorting
 void useIndexForSortRule(Optimizer*, std::unique_ptr<ExecutionPlan>, OptimizerRule const*);
 
+/// @brief try to compute a COLLECT from the entries of a sorted index
+void useIndexForCollectRule(Optimizer*, std::unique_ptr<ExecutionPlan>, OptimizerRule const*);
+
 /// @brief try to remove filters which are covered by indexes
 void removeFiltersCoveredByIndexRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
                                      OptimizerRule const*);
@@ -211,6 +224,14 @@ void undistributeRemoveAfterEnumCollRule(Optimizer*, std::unique_ptr<ExecutionPl
 //  same (single) attribute.
 void replaceOrWithInRule(Optimizer*, std::unique_ptr<ExecutionPlan>, OptimizerRule const*);
 
+/// @brief this rule adds range conditions for prefix searches:
+///   LIKE(x.val, 'abc%')
+//  gets the additional condition
+//    x.val >= 'abc' && x.val <= 'abc\uFFFF'
+//  so the search can use a sorted index on x.val. the same is done for
+//  REGEX_TEST(x.val, '^abc')
+void addPrefixRangesRule(Optimizer*, std::unique_ptr<ExecutionPlan>, OptimizerRule const*);
+
 void removeRedundantOrRule(Optimizer*, std::unique_ptr<ExecutionPlan>, OptimizerRule const*);
 
 /// @brief remove $OLD and $NEW variables from data-modification statements
@@ -254,6 +275,13 @@ void sortLimitRule(Optimizer*, std::unique_ptr<aql::ExecutionPlan>, OptimizerRul
 /// @brief push LIMIT into subqueries, and simplify them
 void optimizeSubqueriesRule(Optimizer*, std::unique_ptr<ExecutionPlan>, OptimizerRule const*);
 
+/// @brief read the documents of a SORT + LIMIT only after the LIMIT
+void lateDocumentMaterializationRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
+                                     OptimizerRule const*);
+
+/// @brief execute suitable subqueries for a whole block of input rows at once
+void batchSubqueriesRule(Optimizer*, std::unique_ptr<ExecutionPlan>, OptimizerRule const*);
+
 /// @brief replace legacy JS functions in the plan.
 void replaceNearWithinFulltext(Optimizer*, std::unique_ptr<ExecutionPlan>,
                                OptimizerRule const*);
@@ -222,6 +222,10 @@ void OptimizerRulesFeature::addRules() {
                DoesNotCreateAdditionalPlans, CanBeDisabled);
 
   /// "Pass 6": use indexes if possible for FILTER and/or SORT nodes
+  // add range conditions for prefix searches, which can use sorted indexes
+  registerRule("add-prefix-ranges", addPrefixRangesRule, OptimizerRule::addPrefixRangesRule,
+               DoesNotCreateAdditionalPlans, CanBeDisabled);
+
   // try to replace simple OR conditions with IN
   registerRule("replace-or-with-in", replaceOrWithInRule, OptimizerRule::replaceOrWithInRule,
                DoesNotCreateAdditionalPlans, CanBeDisabled);
@@ -243,11 +247,30 @@ void OptimizerRulesFeature::addRules() {
   registerRule("use-index-for-sort", useIndexForSortRule, OptimizerRule::useIndexForSortRule,
                DoesNotCreateAdditionalPlans, CanBeDisabled);
 
+  // group and count by the values in the entries of sorted indexes
+  registerRule("use-index-for-collect", useIndexForCollectRule,
+               OptimizerRule::useIndexForCollectRule, DoesNotCreateAdditionalPlans,
+               CanBeDisabled);
+
   // sort in-values in filters (note: must come after
   // remove-filter-covered-by-index rule)
   registerRule("sort-in-values", sortInValuesRule, OptimizerRule::sortInValuesRule,
                DoesNotCreateAdditionalPlans, CanBeDisabled);
 
+  // replace equality joins on sorted indexes with merge joins
+  registerRule("merge-join", mergeJoinRule, OptimizerRule::mergeJoinRule,
+               DoesNotCreateAdditionalPlans, CanBeDisabled);
+
+  // replace equality joins with hash joins
+  registerRule("hash-join", hashJoinRule, OptimizerRule::hashJoinRule,
+               DoesNotCreateAdditionalPlans, CanBeDisabled);
+
+  // evaluate filters on the documents inside full collection scans
+  registerRule("push-filters-into-enumerate-collection",
+               pushFiltersIntoEnumerateCollectionRule,
+               OptimizerRule::pushFiltersIntoEnumerateCollectionRule,
+               DoesNotCreateAdditionalPlans, CanBeDisabled);
+
   // remove calculations that are never necessary
   registerRule("remove-unnecessary-calculations-2", removeUnnecessaryCalculationsRule,
                OptimizerRule::removeUnnecessaryCalculationsRule2,
@@ -285,6 +308,16 @@ void OptimizerRulesFeature::addRules() {
                                       OptimizerRule::applySortLimitRule,
                                       DoesNotCreateAdditionalPlans, CanBeDisabled);
 
+  // read the documents of a SORT + LIMIT only after the LIMIT
+  registerRule("late-document-materialization", lateDocumentMaterializationRule,
+               OptimizerRule::lateDocumentMaterializationRule,
+               DoesNotCreateAdditionalPlans, CanBeDisabled);
+
+  // execute subqueries for a whole block of input rows at once
+  registerRule("batch-subqueries", batchSubqueriesRule,
+               OptimizerRule::batchSubqueriesRule, DoesNotCreateAdditionalPlans,
+               CanBeDisabled);
+
   if (arangodb::ServerState::instance()->isCoordinator()) {
     registerRule("optimize-cluster-single-document-operations",
                  substituteClusterSingleDocumentOperations,
@@ -23,29 +23,412 @@
 
 #include "PlanCache.h"
 #include "Aql/Ast.h"
+#include "Aql/AstNode.h"
 #include "Aql/ExecutionPlan.h"
 #include "Aql/Query.h"
+#include "Aql/QueryResult.h"
 #include "Aql/QueryString.h"
 #include "Basics/ReadLocker.h"
+#include "Basics/VelocyPackHelper.h"
 #include "Basics/WriteLocker.h"
 #include "VocBase/vocbase.h"
 
 #include <velocypack/Builder.h>
+#include <velocypack/Collection.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
 
 using namespace arangodb::aql;
 
+namespace {
+
 /// @brief singleton instance of the plan cache
-static arangodb::aql::PlanCache Instance;
+arangodb::aql::PlanCache Instance;
+
+/// @brief node types that can be instantiated from a cached plan
+std::unordered_set<std::string> const supportedNodeTypes{
+    "SingletonNode", "EnumerateCollectionNode", "IndexNode",
+    "EnumerateListNode", "FilterNode", "LimitNode", "CalculationNode",
+    "SubqueryNode", "SortNode", "CollectNode", "ReturnNode", "NoResultsNode",
+    "HashJoinNode", "MergeJoinNode", "IndexCollectNode"};
+
+/// @brief the bind parameters of a query, as an object
+VPackSlice bindParametersSlice(std::shared_ptr<VPackBuilder> const& builder) {
+  if (builder == nullptr || !builder->slice().isObject()) {
+    return VPackSlice::emptyObjectSlice();
+  }
+  return builder->slice();
+}
+
+/// @brief type tag of a bind parameter value, as it will be represented in
+/// the AST
+char typeTag(VPackSlice value) {
+  if (value.isNumber()) {
+    if (value.isSmallInt() || value.isInt() ||
+        (value.isUInt() && value.getUIntUnchecked() <= uint64_t(INT64_MAX))) {
+      return 'i';
+    }
+    return 'd';
+  }
+  if (value.isString()) {
+    return 's';
+  }
+  if (value.isBoolean()) {
+    return 'b';
+  }
+  if (value.isNull()) {
+    return 'n';
+  }
+  if (value.isArray()) {
+    return 'a';
+  }
+  if (value.isObject()) {
+    return 'o';
+  }
+  return 'x';
+}
+
+/// @brief whether the node is an attribute access on a variable, such as
+/// `doc.a.b`
+bool isAttributeAccessOnReference(AstNode const* node) {
+  if (node->type != NODE_TYPE_ATTRIBUTE_ACCESS) {
+    return false;
+  }
+  while (node->type == NODE_TYPE_ATTRIBUTE_ACCESS) {
+    node = node->getMember(0);
+  }
+  return node->type == NODE_TYPE_REFERENCE;
+}
+
+/// @brief count the bind parameter occurrences in the (not yet injected)
+/// AST, separately for equality comparisons with attributes and all others
+void countParameters(AstNode const* node, AstNode const* parent,
+                     std::map<std::string, size_t>& equality,
+                     std::unordered_set<std::string>& other) {
+  if (node == nullptr) {
+    return;
+  }
+
+  if (node->type == NODE_TYPE_PARAMETER) {
+    std::string name = node->getString();
+    if (parent != nullptr && parent->type == NODE_TYPE_OPERATOR_BINARY_EQ &&
+        parent->numMembers() == 2) {
+      AstNode const* operand =
+          parent->getMemberUnchecked(parent->getMemberUnchecked(0) == node ? 1 : 0);
+      if (isAttributeAccessOnReference(operand)) {
+        ++equality[name];
+        return;
+      }
+    }
+    other.emplace(std::move(name));
+    return;
+  }
+  if (node->type == NODE_TYPE_PARAMETER_DATASOURCE) {
+    other.emplace(node->getString());
+    return;
+  }
+
+  size_t const n = node->numMembers();
+  for (size_t i = 0; i < n; ++i) {
+    countParameters(node->getMemberUnchecked(i), node, equality, other);
+  }
+}
+
+/// @brief collect all value nodes of the AST, except the ones that were
+/// created from bind parameters
+void collectLiterals(AstNode const* node, std::vector<AstNode const*>& literals) {
+  if (node == nullptr) {
+    return;
+  }
+  if (node->type == NODE_TYPE_VALUE) {
+    if (!node->hasFlag(FLAG_BIND_PARAMETER)) {
+      literals.emplace_back(node);
+    }
+    return;
+  }
+  size_t const n = node->numMembers();
+  for (size_t i = 0; i < n; ++i) {
+    collectLiterals(node->getMemberUnchecked(i), literals);
+  }
+}
+
+/// @brief whether both values are numbers or both are strings
+bool sameTypeClass(AstNode const* lhs, AstNode const* rhs) {
+  return (lhs->isNumericValue() && rhs->isNumericValue()) ||
+         (lhs->isStringValue() && rhs->isStringValue());
+}
+
+/// @brief a pair of artificial values for a bind parameter. the low value
+/// is smaller and the high value is greater than all literals in the query.
+/// between the parameters, the low values are in ascending and the high
+/// values in descending order. plans built for the two sets can only be
+/// the same if the optimizer did not look at the values
+struct Sentinel {
+  std::string name;
+  VPackBuilder low;
+  VPackBuilder high;
+  AstNode const* lowNode;
+  AstNode const* highNode;
+};
+
+void createSentinel(Sentinel& sentinel, char tag, size_t i, size_t n) {
+  switch (tag) {
+    case 'i':
+      sentinel.low.add(VPackValue(INT64_MIN / 2 + static_cast<int64_t>(i)));
+      sentinel.high.add(VPackValue(INT64_MAX / 2 - static_cast<int64_t>(i)));
+      break;
+    case 'd': {
+      double const factor = 1.0 + static_cast<double>(n - i) / 1024.0;
+      sentinel.low.add(VPackValue(-1e300 * factor));
+      sentinel.high.add(VPackValue(1e300 * factor));
+      break;
+    }
+    default: {
+      TRI_ASSERT(tag == 's');
+      // U+FFFE sorts before and U+FFFF after all other characters
+      std::string low;
+      for (size_t j = 0; j < i + 1; ++j) {
+        low.append("\xEF\xBF\xBE");
+      }
+      std::string high;
+      for (size_t j = 0; j < n - i; ++j) {
+        high.append("\xEF\xBF\xBF");
+      }
+      sentinel.low.add(VPackValue(low));
+      sentinel.high.add(VPackValue(high));
+      break;
+    }
+  }
+}
+
+/// @brief whether the sentinels are ordered as described above
+bool sentinelsValid(std::vector<Sentinel> const& sentinels,
+                    std::vector<AstNode const*> const& literals) {
+  for (size_t i = 0; i < sentinels.size(); ++i) {
+    auto const& s = sentinels[i];
+    if (CompareAstNodes(s.lowNode, s.highNode, true) >= 0) {
+      return false;
+    }
+    for (auto const* literal : literals) {
+      if (!sameTypeClass(s.lowNode, literal)) {
+        continue;
+      }
+      if (CompareAstNodes(s.lowNode, literal, true) >= 0 ||
+          CompareAstNodes(s.highNode, literal, true) <= 0) {
+        return false;
+      }
+    }
+    for (size_t j = i + 1; j < sentinels.size(); ++j) {
+      auto const& other = sentinels[j];
+      if (!sameTypeClass(s.lowNode, other.lowNode)) {
+        continue;
+      }
+      if (CompareAstNodes(s.lowNode, other.lowNode, true) >= 0 ||
+          CompareAstNodes(s.highNode, other.highNode, true) <= 0 ||
+          CompareAstNodes(s.highNode, other.lowNode, true) <= 0) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/// @brief whether the plan only contains nodes we can instantiate again
+bool isSupportedPlan(VPackSlice plan) {
+  VPackSlice nodes = plan.get("nodes");
+  if (!nodes.isArray()) {
+    return false;
+  }
+  for (VPackSlice node : VPackArrayIterator(nodes)) {
+    VPackSlice type = node.get("type");
+    if (!type.isString() || supportedNodeTypes.find(type.copyString()) == supportedNodeTypes.end()) {
+      return false;
+    }
+    VPackSlice subquery = node.get("subquery");
+    if (subquery.isObject() && !isSupportedPlan(subquery)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// @brief copy the plan, replacing all value nodes with sentinel values by
+/// placeholders. fails if a sentinel value is found anywhere else
+bool replaceSentinels(VPackSlice slice, std::vector<Sentinel> const& sentinels,
+                      bool low, VPackBuilder& out, std::map<std::string, size_t>& counts) {
+  auto findSentinel = [&](VPackSlice value) -> Sentinel const* {
+    if (!value.isNumber() && !value.isString()) {
+      return nullptr;
+    }
+    for (auto const& s : sentinels) {
+      VPackSlice sentinel = low ? s.low.slice() : s.high.slice();
+      if (arangodb::basics::VelocyPackHelper::compare(value, sentinel, false) == 0) {
+        return &s;
+      }
+    }
+    return nullptr;
+  };
+
+  if (slice.isObject()) {
+    VPackSlice type = slice.get("type");
+    if (type.isString() && type.isEqualString("value")) {
+      Sentinel const* s = findSentinel(slice.get("value"));
+      if (s != nullptr) {
+        out.openObject();
+        for (auto const& it : VPackObjectIterator(slice)) {
+          if (it.key.isEqualString("value")) {
+            out.add("value", VPackValue(VPackValueType::Null));
+          } else {
+            out.add(it.key.copyString(), it.value);
+          }
+        }
+        out.add("bindParameter", VPackValue(s->name));
+        out.close();
+        ++counts[s->name];
+        return true;
+      }
+    }
+
+    out.openObject();
+    for (auto const& it : VPackObjectIterator(slice)) {
+      out.add(it.key);
+      if (!replaceSentinels(it.value, sentinels, low, out, counts)) {
+        return false;
+      }
+    }
+    out.close();
+    return true;
+  }
+
+  if (slice.isArray()) {
+    out.openArray();
+    for (VPackSlice it : VPackArrayIterator(slice)) {
+      if (!replaceSentinels(it, sentinels, low, out, counts)) {
+        return false;
+      }
+    }
+    out.close();
+    return true;
+  }
+
+  if (findSentinel(slice) != nullptr) {
+    // the value was used for something else than a value node
+    return false;
+  }
+  out.add(slice);
+  return true;
+}
+
+/// @brief copy the plan, putting in the bind parameter values for all
+/// placeholders
+void replacePlaceholders(VPackSlice slice, VPackSlice bindParameters, VPackBuilder& out) {
+  if (slice.isObject()) {
+    VPackSlice name = slice.get("bindParameter");
+    out.openObject();
+    for (auto const& it : VPackObjectIterator(slice)) {
+      if (name.isString()) {
+        if (it.key.isEqualString("bindParameter")) {
+          continue;
+        }
+        if (it.key.isEqualString("value")) {
+          out.add("value", bindParameters.get(name.stringRef()));
+          continue;
+        }
+      }
+      out.add(it.key);
+      replacePlaceholders(it.value, bindParameters, out);
+    }
+    out.close();
+  } else if (slice.isArray()) {
+    out.openArray();
+    for (VPackSlice it : VPackArrayIterator(slice)) {
+      replacePlaceholders(it, bindParameters, out);
+    }
+    out.close();
+  } else {
+    out.add(slice);
+  }
+}
+
+/// @brief explain the query with the sentinel values and turn the plan into
+/// a template
+std::shared_ptr<VPackBuilder> explainWithSentinels(Query& query, VPackSlice options,
+                                                   std::vector<Sentinel> const& sentinels,
+                                                   bool low, std::map<std::string, size_t>& counts) {
+  VPackSlice bindParameters = ::bindParametersSlice(query.bindParameters());
+
+  auto parameters = std::make_shared<VPackBuilder>();
+  {
+    VPackObjectBuilder guard(parameters.get());
+    for (auto const& it : VPackObjectIterator(bindParameters)) {
+      std::string const name = it.key.copyString();
+      auto s = std::find_if(sentinels.begin(), sentinels.end(),
+                            [&name](Sentinel const& s) { return s.name == name; });
+      if (s != sentinels.end()) {
+        parameters->add(name, low ? s->low.slice() : s->high.slice());
+      } else {
+        parameters->add(name, it.value);
+      }
+    }
+  }
+
+  VPackBuilder overrides;
+  {
+    VPackObjectBuilder guard(&overrides);
+    overrides.add("allPlans", VPackValue(false));
+    overrides.add("verbosePlans", VPackValue(true));
+    overrides.add("usePlanCache", VPackValue(false));
+  }
+  auto explainOptions = std::make_shared<VPackBuilder>(
+      VPackCollection::merge(options.isObject() ? options : VPackSlice::emptyObjectSlice(),
+                             overrides.slice(), false));
+
+  Query other(false, query.vocbase(), query.queryString(), parameters,
+              explainOptions, PART_MAIN);
+  QueryResult result = other.explain();
+
+  if (result.result.fail() || !result.cached || result.data == nullptr) {
+    return nullptr;
+  }
+
+  auto plan = std::make_shared<VPackBuilder>();
+  if (!replaceSentinels(result.data->slice(), sentinels, low, *plan, counts)) {
+    return nullptr;
+  }
+  return plan;
+}
+
+}  // namespace
+
+bool PlanCacheEntry::matches(VPackSlice bindParameters) const {
+  if (!bindParameters.isObject()) {
+    bindParameters = VPackSlice::emptyObjectSlice();
+  }
+  for (auto const& it : VPackObjectIterator(fixedParameters->slice())) {
+    VPackSlice value = bindParameters.get(it.key.stringRef());
+    if (value.isNone() ||
+        arangodb::basics::VelocyPackHelper::compare(value, it.value, false) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::shared_ptr<VPackBuilder> PlanCacheEntry::instantiate(VPackSlice bindParameters) const {
+  auto result = std::make_shared<VPackBuilder>();
+  ::replacePlaceholders(plan->slice(), bindParameters, *result);
+  return result;
+}
 
 /// @brief create the plan cache
-PlanCache::PlanCache() : _lock(), _plans() {}
+PlanCache::PlanCache() : _lock(), _plans(), _generation(0) {}
 
 /// @brief destroy the plan cache
 PlanCache::~PlanCache() {}
 
 /// @brief lookup a plan in the cache
-std::shared_ptr<PlanCacheEntry> PlanCache::lookup(TRI_vocbase_t* vocbase, uint64_t queryHash,
-                                                  QueryString const& queryString) {
+std::shared_ptr<PlanCacheEntry> PlanCache::lookup(TRI_vocbase_t* vocbase,
+                                                  std::string const& key) {
   READ_LOCKER(readLocker, _lock);
 
   auto it = _plans.find(vocbase);
@@ -55,7 +438,7 @@ std::shared_ptr<PlanCacheEntry> PlanCache::lookup(TRI_vocbase_t* vocbase, uint64
     return std::shared_ptr<PlanCacheEntry>();
   }
 
-  auto it2 = (*it).second.find(queryHash);
+  auto it2 = (*it).second.find(key);
 
   if (it2 == (*it).second.end()) {
     // plan not found in cache
@@ -67,23 +450,148 @@ std::shared_ptr<PlanCacheEntry> PlanCache::lookup(TRI_vocbase_t* vocbase, uint64
 }
 
 /// @brief store a plan in the cache
-void PlanCache::store(TRI_vocbase_t* vocbase, uint64_t hash,
-                      QueryString const& queryString, ExecutionPlan const* plan) {
-  auto entry = std::make_unique<PlanCacheEntry>(queryString.extract(SIZE_MAX),
-                                                plan->toVelocyPack(plan->getAst(), true));
+void PlanCache::store(TRI_vocbase_t* vocbase, std::shared_ptr<PlanCacheEntry>&& entry,
+                      uint64_t generation) {
+  TRI_ASSERT(entry != nullptr);
 
   WRITE_LOCKER(writeLocker, _lock);
 
+  if (generation != _generation.load()) {
+    // the plan may refer to indexes or collections that are gone now
+    return;
+  }
+
+  auto& plans = _plans[vocbase];
+  if (plans.size() >= maxEntriesPerDatabase) {
+    return;
+  }
+
   // store cache entry
-  _plans[vocbase].insert({hash, std::move(entry)});
+  std::string const& key = entry->key;
+  plans[key] = std::move(entry);
 }
 
 /// @brief invalidate all queries for a particular database
 void PlanCache::invalidate(TRI_vocbase_t* vocbase) {
   WRITE_LOCKER(writeLocker, _lock);
 
+  ++_generation;
   _plans.erase(vocbase);
 }
 
 /// @brief get the plan cache instance
 PlanCache* PlanCache::instance() { return &Instance; }
+
+/// @brief build the cache key for a query
+std::string PlanCache::buildKey(QueryString const& queryString,
+                                VPackSlice options, VPackSlice bindParameters) {
+  std::string key(queryString.data(), queryString.length());
+  key.push_back('\0');
+  if (options.isObject()) {
+    key.append(options.toJson());
+  }
+  key.push_back('\0');
+
+  if (bindParameters.isObject()) {
+    // bind parameters may come in any order
+    std::map<std::string, char> types;
+    for (auto const& it : VPackObjectIterator(bindParameters)) {
+      types.emplace(it.key.copyString(), ::typeTag(it.value));
+    }
+    for (auto const& it : types) {
+      key.append(it.first);
+      key.push_back(':');
+      key.push_back(it.second);
+      key.push_back(',');
+    }
+  }
+  return key;
+}
+
+/// @brief find the bind parameters that can be replaced by placeholders
+std::map<std::string, size_t> PlanCache::findPlaceholderParameters(AstNode const* root,
+                                                                   VPackSlice bindParameters) {
+  std::map<std::string, size_t> equality;
+  std::unordered_set<std::string> other;
+  ::countParameters(root, nullptr, equality, other);
+
+  for (auto it = equality.begin(); it != equality.end(); /* no hoisting */) {
+    VPackSlice value = bindParameters.isObject()
+                           ? bindParameters.get((*it).first)
+                           : VPackSlice::noneSlice();
+    char const tag = ::typeTag(value);
+    if (other.find((*it).first) != other.end() ||
+        (tag != 'i' && tag != 'd' && tag != 's')) {
+      it = equality.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  return equality;
+}
+
+/// @brief create the cache entry for a query that has just been planned
+std::shared_ptr<PlanCacheEntry> PlanCache::buildEntry(std::string&& key, Query& query,
+                                                      VPackSlice options,
+                                                      std::map<std::string, size_t> const& parameters) {
+  VPackSlice bindParameters = ::bindParametersSlice(query.bindParameters());
+  TRI_ASSERT(query.plan() != nullptr);
+
+  if (!parameters.empty()) {
+    std::vector<Sentinel> sentinels(parameters.size());
+    size_t i = 0;
+    for (auto const& it : parameters) {
+      Sentinel& s = sentinels[i];
+      s.name = it.first;
+      ::createSentinel(s, ::typeTag(bindParameters.get(it.first)), i, parameters.size());
+      s.lowNode = query.ast()->nodeFromVPack(s.low.slice(), true);
+      s.highNode = query.ast()->nodeFromVPack(s.high.slice(), true);
+      ++i;
+    }
+
+    std::vector<AstNode const*> literals;
+    ::collectLiterals(query.ast()->root(), literals);
+
+    if (::sentinelsValid(sentinels, literals)) {
+      std::map<std::string, size_t> lowCounts;
+      std::map<std::string, size_t> highCounts;
+      auto low = ::explainWithSentinels(query, options, sentinels, true, lowCounts);
+      auto high = ::explainWithSentinels(query, options, sentinels, false, highCounts);
+
+      bool valid = (low != nullptr && high != nullptr && ::isSupportedPlan(low->slice()) &&
+                    arangodb::basics::VelocyPackHelper::compare(low->slice(), high->slice(),
+                                                                false) == 0);
+      // every comparison must still be there, or the optimizer may have made
+      // use of the values after all
+      for (auto const& it : parameters) {
+        if (!valid) {
+          break;
+        }
+        valid = (lowCounts[it.first] >= it.second);
+      }
+
+      if (valid) {
+        auto fixed = std::make_shared<VPackBuilder>();
+        {
+          VPackObjectBuilder guard(fixed.get());
+          for (auto const& it : VPackObjectIterator(bindParameters)) {
+            if (parameters.find(it.key.copyString()) == parameters.end()) {
+              fixed->add(it.key.copyString(), it.value);
+            }
+          }
+        }
+        return std::make_shared<PlanCacheEntry>(std::move(key), std::move(low),
+                                                std::move(fixed));
+      }
+    }
+  }
+
+  // fall back to the query's own plan, which can only be used for the same
+  // bind parameter values
+  auto plan = query.plan()->toVelocyPack(query.ast(), true);
+  if (!::isSupportedPlan(plan->slice())) {
+    return nullptr;
+  }
+  auto fixed = std::make_shared<VPackBuilder>(bindParameters);
+  return std::make_shared<PlanCacheEntry>(std::move(key), std::move(plan), std::move(fixed));
+}
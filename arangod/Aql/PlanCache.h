@@ -27,6 +27,11 @@
 #include "Basics/Common.h"
 #include "Basics/ReadWriteLock.h"
 
+#include <velocypack/Slice.h>
+
+#include <atomic>
+#include <map>
+
 struct TRI_vocbase_t;
 
 namespace arangodb {
@@ -35,17 +40,36 @@ class Builder;
 }
 
 namespace aql {
-class ExecutionPlan;
+struct AstNode;
+class Query;
 class QueryString;
-class VariableGenerator;
 
 struct PlanCacheEntry {
-  PlanCacheEntry(std::string&& queryString,
-                 std::shared_ptr<arangodb::velocypack::Builder>&& builder)
-      : queryString(std::move(queryString)), builder(std::move(builder)) {}
-
-  std::string queryString;
-  std::shared_ptr<arangodb::velocypack::Builder> builder;
+  PlanCacheEntry(std::string&& key, std::shared_ptr<arangodb::velocypack::Builder>&& plan,
+                 std::shared_ptr<arangodb::velocypack::Builder>&& fixedParameters)
+      : key(std::move(key)),
+        plan(std::move(plan)),
+        fixedParameters(std::move(fixedParameters)) {}
+
+  /// @brief whether or not the plan can be used for the bind parameters.
+  /// this is the case if all bind parameters the plan was built for have the
+  /// same values
+  bool matches(arangodb::velocypack::Slice bindParameters) const;
+
+  /// @brief build the execution plan for the bind parameters, by putting in
+  /// their values for all placeholders
+  std::shared_ptr<arangodb::velocypack::Builder> instantiate(arangodb::velocypack::Slice bindParameters) const;
+
+  /// @brief query string, options and bind parameter names and types
+  std::string const key;
+
+  /// @brief the optimized plan. value nodes containing a placeholder for a
+  /// bind parameter have an additional attribute "bindParameter"
+  std::shared_ptr<arangodb::velocypack::Builder> const plan;
+
+  /// @brief object with all bind parameters whose values are baked into
+  /// the plan
+  std::shared_ptr<arangodb::velocypack::Builder> const fixedParameters;
 };
 
 class PlanCache {
@@ -59,25 +83,58 @@ class PlanCache {
   /// @brief destroy the cache
   ~PlanCache();
 
+  /// @brief maximum number of plans stored per database
+  static constexpr size_t maxEntriesPerDatabase = 256;
+
  public:
   /// @brief lookup a plan in the cache
-  std::shared_ptr<PlanCacheEntry> lookup(TRI_vocbase_t*, uint64_t, QueryString const&);
+  std::shared_ptr<PlanCacheEntry> lookup(TRI_vocbase_t*, std::string const& key);
 
-  /// @brief store a plan in the cache
-  void store(TRI_vocbase_t*, uint64_t, QueryString const&, ExecutionPlan const*);
+  /// @brief store a plan in the cache. the plan is not stored if the cache
+  /// was invalidated after generation() returned the given value
+  void store(TRI_vocbase_t*, std::shared_ptr<PlanCacheEntry>&& entry, uint64_t generation);
 
   /// @brief invalidate all plans for a particular database
   void invalidate(TRI_vocbase_t*);
 
+  /// @brief number of invalidations so far. must be fetched before
+  /// planning a query that is to be stored
+  uint64_t generation() const { return _generation.load(); }
+
   /// @brief get the pointer to the global plan cache
   static PlanCache* instance();
 
+  /// @brief build the cache key for a query
+  static std::string buildKey(QueryString const& queryString,
+                              arangodb::velocypack::Slice options,
+                              arangodb::velocypack::Slice bindParameters);
+
+  /// @brief find the bind parameters that can be replaced by placeholders
+  /// in a plan, and count their occurrences. these are the number and string
+  /// parameters that are only used in comparisons of the form
+  /// `attribute == @value`. must be called before the bind parameters are
+  /// injected into the AST
+  static std::map<std::string, size_t> findPlaceholderParameters(
+      AstNode const* root, arangodb::velocypack::Slice bindParameters);
+
+  /// @brief create the cache entry for a query that has just been planned.
+  /// tries to build a plan that is independent of the values of the
+  /// parameters returned by findPlaceholderParameters, and falls back to the
+  /// query's own plan otherwise. returns a nullptr if the plan cannot be
+  /// cached at all
+  static std::shared_ptr<PlanCacheEntry> buildEntry(
+      std::string&& key, Query& query, arangodb::velocypack::Slice options,
+      std::map<std::string, size_t> const& parameters);
+
  private:
   /// @brief read-write lock for the cache
   arangodb::basics::ReadWriteLock _lock;
 
   /// @brief cached query plans, organized per database
-  std::unordered_map<TRI_vocbase_t*, std::unordered_map<uint64_t, std::shared_ptr<PlanCacheEntry>>> _plans;
+  std::unordered_map<TRI_vocbase_t*, std::unordered_map<std::string, std::shared_ptr<PlanCacheEntry>>> _plans;
+
+  /// @brief incremented on every invalidation
+  std::atomic<uint64_t> _generation;
 };
 }  // namespace aql
 }  // namespace arangodb
@@ -0,0 +1,339 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "PrefetchBlock.h"
+
+#include "Aql/AqlItemBlock.h"
+#include "Aql/ExecutionEngine.h"
+#include "Aql/InputAqlItemRow.h"
+#include "Aql/Query.h"
+#include "Aql/SharedQueryState.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+/// @brief state shared with the scheduler thread. it outlives the block if
+/// a cancelled prefetch is still in the scheduler's queue
+struct PrefetchBlock::Shared {
+  enum class Status { IDLE, QUEUED, RUNNING, FINISHED };
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  Status status = Status::IDLE;
+  /// @brief whether WAITING was returned for the running prefetch, so the
+  /// query has to be woken up
+  bool wakeup = false;
+
+  /// @brief result of the finished prefetch
+  ExecutionState state = ExecutionState::HASMORE;
+  SharedAqlItemBlockPtr block;
+  std::exception_ptr error;
+
+  /// @brief execute a queued prefetch, unless it has been cancelled
+  static void run(std::shared_ptr<Shared> const& shared, ExecutionBlock* upstream,
+                  size_t atMost, std::shared_ptr<SharedQueryState> const& queryState) {
+    {
+      std::lock_guard<std::mutex> guard(shared->mutex);
+      if (shared->status != Status::QUEUED) {
+        // cancelled, or executed by the query itself
+        return;
+      }
+      shared->status = Status::RUNNING;
+    }
+
+    ExecutionState state = ExecutionState::DONE;
+    SharedAqlItemBlockPtr block;
+    std::exception_ptr error;
+    try {
+      std::tie(state, block) = upstream->getSome(atMost);
+    } catch (...) {
+      error = std::current_exception();
+    }
+
+    bool wakeup;
+    {
+      std::lock_guard<std::mutex> guard(shared->mutex);
+      TRI_ASSERT(shared->status == Status::RUNNING);
+      shared->state = state;
+      shared->block = std::move(block);
+      shared->error = error;
+      shared->status = Status::FINISHED;
+      wakeup = shared->wakeup;
+      shared->wakeup = false;
+      shared->condition.notify_all();
+    }
+
+    // the block may be gone by now, only the query state is still valid
+    if (wakeup && queryState != nullptr) {
+      queryState->execute([]() { return true; });
+    }
+  }
+};
+
+PrefetchBlock::PrefetchBlock(ExecutionEngine* engine, ExecutionNode const* node)
+    : ExecutionBlock(engine, node),
+      _shared(std::make_shared<Shared>()),
+      _position(0),
+      _prefetchSize(ExecutionBlock::DefaultBatchSize()) {}
+
+PrefetchBlock::~PrefetchBlock() {
+  // the dependency must not be used anymore once we are gone
+  std::unique_lock<std::mutex> guard(_shared->mutex);
+  if (_shared->status == Shared::Status::QUEUED) {
+    _shared->status = Shared::Status::IDLE;
+  }
+  while (_shared->status == Shared::Status::RUNNING) {
+    _shared->condition.wait(guard);
+  }
+  _shared->wakeup = false;
+  _shared->block = nullptr;
+  _shared->error = nullptr;
+}
+
+std::pair<ExecutionState, Result> PrefetchBlock::initializeCursor(InputAqlItemRow const& input) {
+  if (discardPrefetch() == ExecutionState::WAITING) {
+    return {ExecutionState::WAITING, TRI_ERROR_NO_ERROR};
+  }
+  _block = nullptr;
+  _position = 0;
+  return ExecutionBlock::initializeCursor(input);
+}
+
+std::pair<ExecutionState, Result> PrefetchBlock::initializeCursorWithBatch(SharedAqlItemBlockPtr const& batch) {
+  if (discardPrefetch() == ExecutionState::WAITING) {
+    return {ExecutionState::WAITING, TRI_ERROR_NO_ERROR};
+  }
+  _block = nullptr;
+  _position = 0;
+  return ExecutionBlock::initializeCursorWithBatch(batch);
+}
+
+std::pair<ExecutionState, Result> PrefetchBlock::shutdown(int errorCode) {
+  if (discardPrefetch() == ExecutionState::WAITING) {
+    return {ExecutionState::WAITING, TRI_ERROR_NO_ERROR};
+  }
+  _block = nullptr;
+  _position = 0;
+  return ExecutionBlock::shutdown(errorCode);
+}
+
+/// the dependency traces its own calls, this block is not part of the plan
+std::pair<ExecutionState, SharedAqlItemBlockPtr> PrefetchBlock::getSome(size_t atMost) {
+  TRI_ASSERT(atMost > 0);
+  if (_block == nullptr) {
+    ExecutionState state = fetchBlock(atMost);
+    if (state == ExecutionState::WAITING) {
+      return {state, nullptr};
+    }
+    if (_block == nullptr) {
+      TRI_ASSERT(state == ExecutionState::DONE);
+      return {state, nullptr};
+    }
+  }
+
+  TRI_ASSERT(_position < _block->size());
+  size_t const available = _block->size() - _position;
+  SharedAqlItemBlockPtr result;
+  if (_position == 0 && available <= atMost) {
+    result = std::move(_block);
+    _block = nullptr;
+  } else {
+    size_t const n = (std::min)(available, atMost);
+    result = _block->slice(_position, _position + n);
+    _position += n;
+    if (_position == _block->size()) {
+      _block = nullptr;
+    }
+  }
+  if (_block == nullptr) {
+    _position = 0;
+    if (_upstreamState == ExecutionState::DONE) {
+      return {ExecutionState::DONE, std::move(result)};
+    }
+  }
+  return {ExecutionState::HASMORE, std::move(result)};
+}
+
+std::pair<ExecutionState, size_t> PrefetchBlock::skipSome(size_t atMost) {
+  TRI_ASSERT(atMost > 0);
+  if (_block == nullptr) {
+    // a prefetched block has to be used up before skipping in the dependency
+    bool available;
+    if (collectPrefetch(available) == ExecutionState::WAITING) {
+      return {ExecutionState::WAITING, 0};
+    }
+    if (!available) {
+      if (_upstreamState == ExecutionState::DONE) {
+        return {ExecutionState::DONE, 0};
+      }
+      auto res = upstream().skipSome(atMost);
+      if (res.first != ExecutionState::WAITING) {
+        _upstreamState = res.first;
+      }
+      return res;
+    }
+    if (_block == nullptr) {
+      TRI_ASSERT(_upstreamState == ExecutionState::DONE);
+      return {ExecutionState::DONE, 0};
+    }
+  }
+
+  TRI_ASSERT(_position < _block->size());
+  size_t const skipped = (std::min)(_block->size() - _position, atMost);
+  _position += skipped;
+  if (_position == _block->size()) {
+    _block = nullptr;
+    _position = 0;
+    if (_upstreamState == ExecutionState::DONE) {
+      return {ExecutionState::DONE, skipped};
+    }
+  }
+  return {ExecutionState::HASMORE, skipped};
+}
+
+ExecutionState PrefetchBlock::collectPrefetch(bool& available) {
+  available = false;
+  ExecutionState state;
+  SharedAqlItemBlockPtr block;
+  std::exception_ptr error;
+  {
+    std::lock_guard<std::mutex> guard(_shared->mutex);
+    switch (_shared->status) {
+      case Shared::Status::IDLE:
+        return ExecutionState::DONE;
+      case Shared::Status::QUEUED:
+        // not started yet. cancel it, the caller reads the dependency itself
+        _shared->status = Shared::Status::IDLE;
+        return ExecutionState::DONE;
+      case Shared::Status::RUNNING:
+        _shared->wakeup = true;
+        return ExecutionState::WAITING;
+      case Shared::Status::FINISHED:
+        break;
+    }
+    state = _shared->state;
+    block = std::move(_shared->block);
+    _shared->block = nullptr;
+    error = _shared->error;
+    _shared->error = nullptr;
+    _shared->status = Shared::Status::IDLE;
+  }
+
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+  if (state == ExecutionState::WAITING) {
+    // the dependency has only been able to register for a wakeup, which
+    // has not been waited for by the query. ask it again
+    TRI_ASSERT(block == nullptr);
+    return ExecutionState::DONE;
+  }
+  available = true;
+  setBlock(state, std::move(block), _prefetchSize);
+  return state;
+}
+
+ExecutionState PrefetchBlock::fetchBlock(size_t atMost) {
+  TRI_ASSERT(_block == nullptr);
+  bool available;
+  ExecutionState state = collectPrefetch(available);
+  if (state == ExecutionState::WAITING || available) {
+    return state;
+  }
+  if (_upstreamState == ExecutionState::DONE) {
+    return ExecutionState::DONE;
+  }
+
+  SharedAqlItemBlockPtr block;
+  std::tie(state, block) = upstream().getSome(atMost);
+  if (state == ExecutionState::WAITING) {
+    TRI_ASSERT(block == nullptr);
+    return state;
+  }
+  setBlock(state, std::move(block), atMost);
+  return state;
+}
+
+void PrefetchBlock::setBlock(ExecutionState state, SharedAqlItemBlockPtr&& block, size_t atMost) {
+  TRI_ASSERT(state != ExecutionState::WAITING);
+  TRI_ASSERT(block != nullptr || state == ExecutionState::DONE);
+  _upstreamState = state;
+  _block = std::move(block);
+  _position = 0;
+  if (state == ExecutionState::HASMORE) {
+    startPrefetch(atMost);
+  }
+}
+
+void PrefetchBlock::startPrefetch(size_t atMost) {
+  auto* scheduler = SchedulerFeature::SCHEDULER;
+  if (scheduler == nullptr) {
+    // shutting down. the next block is fetched directly
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(_shared->mutex);
+    TRI_ASSERT(_shared->status == Shared::Status::IDLE);
+    _shared->status = Shared::Status::QUEUED;
+  }
+  _prefetchSize = atMost;
+
+  bool queued = false;
+  try {
+    std::shared_ptr<Shared> shared = _shared;
+    ExecutionBlock* dependency = &upstream();
+    std::shared_ptr<SharedQueryState> queryState = _engine->getQuery()->sharedState();
+    queued = scheduler->queue(RequestLane::CLIENT_AQL, [shared, dependency, atMost, queryState]() {
+      Shared::run(shared, dependency, atMost, queryState);
+    });
+  } catch (...) {
+  }
+
+  if (!queued) {
+    std::lock_guard<std::mutex> guard(_shared->mutex);
+    if (_shared->status == Shared::Status::QUEUED) {
+      _shared->status = Shared::Status::IDLE;
+    }
+  }
+}
+
+ExecutionState PrefetchBlock::discardPrefetch() {
+  std::lock_guard<std::mutex> guard(_shared->mutex);
+  if (_shared->status == Shared::Status::RUNNING) {
+    _shared->wakeup = true;
+    return ExecutionState::WAITING;
+  }
+  _shared->status = Shared::Status::IDLE;
+  _shared->block = nullptr;
+  _shared->error = nullptr;
+  return ExecutionState::DONE;
+}
+
+ExecutionBlock& PrefetchBlock::upstream() const {
+  TRI_ASSERT(_dependencies.size() == 1);
+  return *_dependencies[0];
+}
@@ -0,0 +1,110 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_PREFETCH_BLOCK_H
+#define ARANGOD_AQL_PREFETCH_BLOCK_H 1
+
+#include "Aql/ExecutionBlock.h"
+#include "Aql/ExecutionState.h"
+#include "Aql/SharedAqlItemBlockPtr.h"
+#include "Basics/Result.h"
+
+#include <memory>
+
+namespace arangodb {
+namespace aql {
+
+class ExecutionEngine;
+class ExecutionNode;
+class InputAqlItemRow;
+
+/**
+ * @brief Fetches the next block of its single dependency on a scheduler
+ * thread, while the blocks above it process the current one.
+ *
+ * The block is not part of the execution plan. It is put on top of a
+ * dependency by the ExecutionEngine, and uses the dependency's plan node.
+ * After a block has been handed out, the next getSome() of the dependency
+ * is queued on the scheduler. If it has not been started by the time its
+ * result is needed, it is executed directly, so a busy scheduler cannot
+ * stall the query. If it is still running, WAITING is returned and the
+ * query is woken up via its SharedQueryState once the block is ready.
+ *
+ * The dependency and everything below it must not share any state with
+ * the rest of the query, apart from what is synchronized by
+ * ExecutionEngine::enableConcurrentExecution().
+ */
+class PrefetchBlock final : public ExecutionBlock {
+ public:
+  PrefetchBlock(ExecutionEngine* engine, ExecutionNode const* node);
+  ~PrefetchBlock();
+
+  std::pair<ExecutionState, Result> initializeCursor(InputAqlItemRow const& input) override;
+
+  std::pair<ExecutionState, Result> initializeCursorWithBatch(SharedAqlItemBlockPtr const& batch) override;
+
+  std::pair<ExecutionState, Result> shutdown(int errorCode) override;
+
+  std::pair<ExecutionState, SharedAqlItemBlockPtr> getSome(size_t atMost) override;
+
+  std::pair<ExecutionState, size_t> skipSome(size_t atMost) override;
+
+ private:
+  struct Shared;
+
+  /// @brief take the result of a finished prefetch into _block. sets
+  /// available to false if there was none, in which case a queued prefetch
+  /// is cancelled. returns WAITING if the prefetch is still running
+  ExecutionState collectPrefetch(bool& available);
+
+  /// @brief fetch the next block of the dependency into _block, using the
+  /// prefetched one if possible
+  ExecutionState fetchBlock(size_t atMost);
+
+  /// @brief keep a block of the dependency, and prefetch the next one if
+  /// there are more
+  void setBlock(ExecutionState state, SharedAqlItemBlockPtr&& block, size_t atMost);
+
+  /// @brief queue the next getSome() of the dependency on the scheduler
+  void startPrefetch(size_t atMost);
+
+  /// @brief wait until no prefetch is queued or running, and drop its
+  /// result. returns WAITING instead of blocking if it is running
+  ExecutionState discardPrefetch();
+
+  ExecutionBlock& upstream() const;
+
+ private:
+  std::shared_ptr<Shared> _shared;
+
+  /// @brief the block of the dependency that is currently handed out, and
+  /// the first row that has not been handed out yet
+  SharedAqlItemBlockPtr _block;
+  size_t _position;
+
+  /// @brief atMost of the prefetch, the consumer usually asks for the same
+  /// number of rows every time
+  size_t _prefetchSize;
+};
+
+}  // namespace aql
+}  // namespace arangodb
+
+#endif
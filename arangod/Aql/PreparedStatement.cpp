@@ -0,0 +1,166 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2019 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "PreparedStatement.h"
+#include "Aql/PlanCache.h"
+#include "Basics/MutexLocker.h"
+#include "Basics/system-functions.h"
+#include "VocBase/ticks.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Collection.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+/// @brief singleton registry instance
+arangodb::aql::PreparedStatementRegistry Instance;
+}  // namespace
+
+constexpr size_t PreparedStatementRegistry::maxStatementsPerDatabase;
+constexpr double PreparedStatementRegistry::defaultTTL;
+
+PreparedStatement::PreparedStatement(uint64_t id, std::string&& queryString,
+                                     std::shared_ptr<VPackBuilder>&& options, double ttl)
+    : _id(id),
+      _queryString(std::move(queryString)),
+      _options(std::move(options)),
+      _ttl(ttl),
+      _expires(TRI_microtime() + ttl),
+      _planGeneration(0) {
+  TRI_ASSERT(_options != nullptr && _options->slice().isObject());
+}
+
+VPackSlice PreparedStatement::options() const { return _options->slice(); }
+
+std::shared_ptr<VPackBuilder> PreparedStatement::executionOptions(VPackSlice overrides) const {
+  VPackBuilder pinned;
+  pinned.openObject();
+  pinned.add("preparedStatement", VPackValue(_id));
+  pinned.add("usePlanCache", VPackValue(true));
+  pinned.close();
+
+  VPackBuilder merged =
+      overrides.isObject() ? VPackCollection::merge(options(), overrides, false)
+                           : VPackBuilder(options());
+  return std::make_shared<VPackBuilder>(
+      VPackCollection::merge(merged.slice(), pinned.slice(), false));
+}
+
+std::shared_ptr<PlanCacheEntry> PreparedStatement::plan(std::string const& key,
+                                                        uint64_t generation) const {
+  MUTEX_LOCKER(locker, _planLock);
+  if (_plan == nullptr || _planGeneration != generation || _plan->key != key) {
+    return std::shared_ptr<PlanCacheEntry>();
+  }
+  return _plan;
+}
+
+void PreparedStatement::setPlan(std::shared_ptr<PlanCacheEntry>&& plan, uint64_t generation) {
+  MUTEX_LOCKER(locker, _planLock);
+  if (generation != PlanCache::instance()->generation()) {
+    // the plan may refer to indexes or collections that are gone now
+    return;
+  }
+  _plan = std::move(plan);
+  _planGeneration = generation;
+}
+
+PreparedStatementRegistry::PreparedStatementRegistry() : _lock(), _statements() {}
+
+PreparedStatementRegistry::~PreparedStatementRegistry() {}
+
+std::shared_ptr<PreparedStatement> PreparedStatementRegistry::create(
+    TRI_vocbase_t* vocbase, std::string&& queryString, VPackSlice options, double ttl) {
+  if (ttl <= 0.0) {
+    ttl = defaultTTL;
+  }
+
+  auto statement = std::make_shared<PreparedStatement>(
+      TRI_NewServerSpecificTick(), std::move(queryString),
+      std::make_shared<VPackBuilder>(options.isObject() ? options
+                                                        : VPackSlice::emptyObjectSlice()),
+      ttl);
+
+  MUTEX_LOCKER(locker, _lock);
+
+  auto& statements = _statements[vocbase];
+  if (statements.size() >= maxStatementsPerDatabase) {
+    removeExpired(statements, TRI_microtime());
+    if (statements.size() >= maxStatementsPerDatabase) {
+      return std::shared_ptr<PreparedStatement>();
+    }
+  }
+
+  statements.emplace(statement->id(), statement);
+  return statement;
+}
+
+std::shared_ptr<PreparedStatement> PreparedStatementRegistry::lookup(TRI_vocbase_t* vocbase,
+                                                                     uint64_t id) {
+  MUTEX_LOCKER(locker, _lock);
+
+  auto it = _statements.find(vocbase);
+  if (it == _statements.end()) {
+    return std::shared_ptr<PreparedStatement>();
+  }
+
+  auto it2 = (*it).second.find(id);
+  if (it2 == (*it).second.end()) {
+    return std::shared_ptr<PreparedStatement>();
+  }
+
+  PreparedStatement& statement = *(*it2).second;
+  double const now = TRI_microtime();
+  if (statement._expires < now) {
+    (*it).second.erase(it2);
+    return std::shared_ptr<PreparedStatement>();
+  }
+
+  statement._expires = now + statement._ttl;
+  return (*it2).second;
+}
+
+bool PreparedStatementRegistry::remove(TRI_vocbase_t* vocbase, uint64_t id) {
+  MUTEX_LOCKER(locker, _lock);
+
+  auto it = _statements.find(vocbase);
+  return it != _statements.end() && (*it).second.erase(id) > 0;
+}
+
+void PreparedStatementRegistry::drop(TRI_vocbase_t* vocbase) {
+  MUTEX_LOCKER(locker, _lock);
+  _statements.erase(vocbase);
+}
+
+PreparedStatementRegistry* PreparedStatementRegistry::instance() { return &Instance; }
+
+void PreparedStatementRegistry::removeExpired(StatementMap& statements, double now) {
+  for (auto it = statements.begin(); it != statements.end();) {
+    if ((*it).second->_expires < now) {
+      it = statements.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
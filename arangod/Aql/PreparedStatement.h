@@ -0,0 +1,134 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2019 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_PREPARED_STATEMENT_H
+#define ARANGOD_AQL_PREPARED_STATEMENT_H 1
+
+#include "Basics/Common.h"
+#include "Basics/Mutex.h"
+
+#include <velocypack/Slice.h>
+
+struct TRI_vocbase_t;
+
+namespace arangodb {
+namespace velocypack {
+class Builder;
+}
+
+namespace aql {
+struct PlanCacheEntry;
+
+/// @brief a query string with its options, registered by a client that
+/// executes it repeatedly with different bind parameters. the statement
+/// holds on to the cached plan of its last execution, independent of the
+/// size of the PlanCache
+class PreparedStatement {
+ public:
+  PreparedStatement(PreparedStatement const&) = delete;
+  PreparedStatement& operator=(PreparedStatement const&) = delete;
+
+  PreparedStatement(uint64_t id, std::string&& queryString,
+                    std::shared_ptr<arangodb::velocypack::Builder>&& options, double ttl);
+
+  uint64_t id() const { return _id; }
+  std::string const& queryString() const { return _queryString; }
+  double ttl() const { return _ttl; }
+
+  /// @brief the query options the statement was prepared with, an object
+  arangodb::velocypack::Slice options() const;
+
+  /// @brief the query options for an execution: the statement's options,
+  /// overridden by the given ones, and pinned to the statement
+  std::shared_ptr<arangodb::velocypack::Builder> executionOptions(
+      arangodb::velocypack::Slice overrides) const;
+
+  /// @brief the plan of the last execution, if it was planned for the same
+  /// plan cache key and no DDL operation happened in the meantime
+  std::shared_ptr<PlanCacheEntry> plan(std::string const& key, uint64_t generation) const;
+
+  /// @brief remember the plan of an execution
+  void setPlan(std::shared_ptr<PlanCacheEntry>&& plan, uint64_t generation);
+
+ private:
+  friend class PreparedStatementRegistry;
+
+  uint64_t const _id;
+  std::string const _queryString;
+  std::shared_ptr<arangodb::velocypack::Builder> const _options;
+  double const _ttl;
+  // protected by the lock of the registry
+  double _expires;
+
+  mutable arangodb::Mutex _planLock;
+  std::shared_ptr<PlanCacheEntry> _plan;
+  uint64_t _planGeneration;
+};
+
+class PreparedStatementRegistry {
+ public:
+  PreparedStatementRegistry(PreparedStatementRegistry const&) = delete;
+  PreparedStatementRegistry& operator=(PreparedStatementRegistry const&) = delete;
+
+  PreparedStatementRegistry();
+  ~PreparedStatementRegistry();
+
+  /// @brief maximum number of statements per database
+  static constexpr size_t maxStatementsPerDatabase = 1024;
+
+  /// @brief seconds an unused statement is kept by default
+  static constexpr double defaultTTL = 3600.0;
+
+ public:
+  /// @brief register a statement. returns a nullptr if the database has
+  /// too many statements already
+  std::shared_ptr<PreparedStatement> create(TRI_vocbase_t*, std::string&& queryString,
+                                            arangodb::velocypack::Slice options,
+                                            double ttl);
+
+  /// @brief look up a statement and extend its lifetime
+  std::shared_ptr<PreparedStatement> lookup(TRI_vocbase_t*, uint64_t id);
+
+  /// @brief remove a statement, returns false if it does not exist
+  bool remove(TRI_vocbase_t*, uint64_t id);
+
+  /// @brief remove all statements of a database that is dropped
+  void drop(TRI_vocbase_t*);
+
+  /// @brief get the pointer to the global registry
+  static PreparedStatementRegistry* instance();
+
+ private:
+  typedef std::unordered_map<uint64_t, std::shared_ptr<PreparedStatement>> StatementMap;
+
+  /// @brief remove the expired statements of a database, must be called
+  /// under the lock
+  static void removeExpired(StatementMap&, double now);
+
+ private:
+  arangodb::Mutex _lock;
+
+  std::unordered_map<TRI_vocbase_t*, StatementMap> _statements;
+};
+}  // namespace aql
+}  // namespace arangodb
+
+#endif
@@ -25,22 +25,32 @@
 
 #include "Aql/AqlItemBlock.h"
 #include "Aql/AqlTransaction.h"
+#include "Aql/Condition.h"
 #include "Aql/ExecutionBlock.h"
 #include "Aql/ExecutionEngine.h"
 #include "Aql/ExecutionPlan.h"
+#include "Aql/HashJoinNode.h"
+#include "Aql/IndexCollectNode.h"
+#include "Aql/IndexNode.h"
+#include "Aql/MergeJoinNode.h"
 #include "Aql/Optimizer.h"
 #include "Aql/Parser.h"
 #include "Aql/PlanCache.h"
+#include "Aql/PreparedStatement.h"
 #include "Aql/QueryCache.h"
 #include "Aql/QueryList.h"
 #include "Aql/QueryProfile.h"
 #include "Aql/QueryRegistry.h"
+#include "Aql/WalkerWorker.h"
 #include "Basics/Exceptions.h"
+#include "Basics/MutexLocker.h"
+#include "Basics/StaticStrings.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Basics/fasthash.h"
 #include "Cluster/ServerState.h"
 #include "Graph/Graph.h"
 #include "Graph/GraphManager.h"
+#include "Indexes/Index.h"
 #include "Logger/Logger.h"
 #include "RestServer/AqlFeature.h"
 #include "RestServer/QueryRegistryFeature.h"
@@ -60,17 +70,177 @@
 
 #include <velocypack/Iterator.h>
 
-#ifndef USE_PLAN_CACHE
-#undef USE_PLAN_CACHE
-#endif
-
 using namespace arangodb;
 using namespace arangodb::aql;
 
 namespace {
 static std::atomic<TRI_voc_tick_t> nextQueryId(1);
+
+/// @brief whether the node is an access of the _key attribute of the variable
+bool isKeyAccess(AstNode const* node, Variable const* variable) {
+  if (node->type != NODE_TYPE_ATTRIBUTE_ACCESS ||
+      !node->stringEquals(StaticStrings::KeyString)) {
+    return false;
+  }
+  AstNode const* reference = node->getMember(0);
+  return reference->type == NODE_TYPE_REFERENCE &&
+         static_cast<Variable const*>(reference->getData()) == variable;
+}
+
+/// @brief collect the keys compared against in a `_key == value` or
+/// `_key IN values` condition part. returns false for any other condition
+bool collectKeys(AstNode const* op, Variable const* variable,
+                 std::unordered_set<uint64_t>& keyHashes) {
+  if (op->type != NODE_TYPE_OPERATOR_BINARY_EQ && op->type != NODE_TYPE_OPERATOR_BINARY_IN) {
+    return false;
+  }
+  AstNode const* lhs = op->getMember(0);
+  AstNode const* rhs = op->getMember(1);
+  if (op->type == NODE_TYPE_OPERATOR_BINARY_EQ && !isKeyAccess(lhs, variable)) {
+    std::swap(lhs, rhs);
+  }
+  if (!isKeyAccess(lhs, variable) || !rhs->isConstant()) {
+    return false;
+  }
+
+  auto addKey = [&keyHashes](AstNode const* value) {
+    // values other than strings cannot match any document key
+    if (value->isStringValue()) {
+      keyHashes.emplace(QueryCache::hashKey(arangodb::velocypack::StringRef(
+          value->getStringValue(), value->getStringLength())));
+    }
+  };
+
+  if (op->type == NODE_TYPE_OPERATOR_BINARY_IN) {
+    if (rhs->isArray()) {
+      for (size_t i = 0; i < rhs->numMembers(); ++i) {
+        addKey(rhs->getMemberUnchecked(i));
+      }
+    }
+  } else {
+    addKey(rhs);
+  }
+  return true;
+}
+
+/// @brief determines the document keys an index node looks up. returns false
+/// if the node does not only do point lookups in the primary index
+bool collectKeys(IndexNode const* node, std::unordered_set<uint64_t>& keyHashes) {
+  auto const& indexes = node->getIndexes();
+  if (indexes.size() != 1 ||
+      indexes[0].getIndex()->type() != arangodb::Index::TRI_IDX_TYPE_PRIMARY_INDEX) {
+    return false;
+  }
+  AstNode const* root = node->condition()->root();
+  if (root == nullptr || root->type != NODE_TYPE_OPERATOR_NARY_OR || root->numMembers() == 0) {
+    // a full scan
+    return false;
+  }
+
+  for (size_t i = 0; i < root->numMembers(); ++i) {
+    AstNode const* andNode = root->getMemberUnchecked(i);
+    if (andNode->type != NODE_TYPE_OPERATOR_NARY_AND) {
+      return false;
+    }
+    // one restriction on the key is enough, the others can only
+    // reduce the number of documents read
+    bool found = false;
+    for (size_t j = 0; j < andNode->numMembers() && !found; ++j) {
+      found = collectKeys(andNode->getMemberUnchecked(j), node->outVariable(), keyHashes);
+    }
+    if (!found) {
+      return false;
+    }
+  }
+  return true;
 }
 
+/// @brief finds the collections a query reads only via key lookups, and the
+/// keys it reads from them
+class KeyDependencyFinder final : public WalkerWorker<ExecutionNode> {
+ public:
+  KeyDependencyFinder() : _unknown(false) {}
+
+  bool before(ExecutionNode* en) override final {
+    switch (en->getType()) {
+      case ExecutionNode::SINGLETON:
+      case ExecutionNode::ENUMERATE_LIST:
+      case ExecutionNode::FILTER:
+      case ExecutionNode::LIMIT:
+      case ExecutionNode::CALCULATION:
+      case ExecutionNode::SUBQUERY:
+      case ExecutionNode::SORT:
+      case ExecutionNode::COLLECT:
+      case ExecutionNode::RETURN:
+      case ExecutionNode::NORESULTS:
+      // reads only documents its source node has already produced
+      case ExecutionNode::MATERIALIZE:
+        break;
+      case ExecutionNode::ENUMERATE_COLLECTION:
+        _whole.emplace(
+            ExecutionNode::castTo<EnumerateCollectionNode const*>(en)->collection()->name());
+        break;
+      case ExecutionNode::HASH_JOIN:
+        _whole.emplace(ExecutionNode::castTo<HashJoinNode const*>(en)->collection()->name());
+        break;
+      case ExecutionNode::MERGE_JOIN:
+        _whole.emplace(ExecutionNode::castTo<MergeJoinNode const*>(en)->collection()->name());
+        break;
+      case ExecutionNode::INDEX_COLLECT:
+        _whole.emplace(ExecutionNode::castTo<IndexCollectNode const*>(en)->collection()->name());
+        break;
+      case ExecutionNode::INDEX: {
+        auto node = ExecutionNode::castTo<IndexNode const*>(en);
+        std::string const& name = node->collection()->name();
+        std::unordered_set<uint64_t> keyHashes;
+        if (collectKeys(node, keyHashes)) {
+          _keys[name].insert(keyHashes.begin(), keyHashes.end());
+        } else {
+          _whole.emplace(name);
+        }
+        break;
+      }
+      default:
+        // views, graphs etc. we don't know what these read
+        _unknown = true;
+        return true;
+    }
+    return false;
+  }
+
+  /// @brief set the key dependencies of a cache entry
+  void apply(QueryCacheResultEntry& entry) {
+    if (_unknown) {
+      return;
+    }
+    for (auto const& it : entry._dataSources) {
+      auto it2 = _keys.find(it.second);
+      if (it2 != _keys.end() && _whole.find(it.second) == _whole.end()) {
+        entry._keyDependencies.emplace(it.first, std::move((*it2).second));
+      }
+    }
+  }
+
+ private:
+  bool _unknown;
+  /// @brief collections that are read entirely
+  std::unordered_set<std::string> _whole;
+  /// @brief collections that are read via key lookups, with the keys
+  std::unordered_map<std::string, std::unordered_set<uint64_t>> _keys;
+};
+
+/// @brief restrict the dependencies of a cache entry to the document keys
+/// the query reads, where possible
+void addKeyDependencies(ExecutionPlan* plan, QueryCacheResultEntry& entry) {
+  if (plan == nullptr || plan->getAst()->functionsMayAccessDocuments()) {
+    return;
+  }
+  KeyDependencyFinder finder;
+  plan->root()->walk(finder);
+  finder.apply(entry);
+}
+}  // namespace
+
 /// @brief creates a query
 Query::Query(bool contextOwnedByExterior, TRI_vocbase_t& vocbase,
              QueryString const& queryString, std::shared_ptr<VPackBuilder> const& bindParameters,
@@ -143,6 +313,10 @@ Query::Query(bool contextOwnedByExterior, TRI_vocbase_t& vocbase,
 
   _resourceMonitor.setMemoryLimit(_queryOptions.memoryLimit);
 
+  if (ExecContext::CURRENT != nullptr) {
+    _user = ExecContext::CURRENT->user();
+  }
+
   if (!AqlFeature::lease()) {
     THROW_ARANGO_EXCEPTION(TRI_ERROR_SHUTTING_DOWN);
   }
@@ -193,6 +367,10 @@ Query::Query(bool contextOwnedByExterior, TRI_vocbase_t& vocbase,
 
   _resourceMonitor.setMemoryLimit(_queryOptions.memoryLimit);
 
+  if (ExecContext::CURRENT != nullptr) {
+    _user = ExecContext::CURRENT->user();
+  }
+
   if (!AqlFeature::lease()) {
     THROW_ARANGO_EXCEPTION(TRI_ERROR_SHUTTING_DOWN);
   }
@@ -331,6 +509,7 @@ void Query::registerWarning(int code, char const* details) {
     THROW_ARANGO_EXCEPTION_MESSAGE(code, details);
   }
 
+  MUTEX_LOCKER(locker, _warningsLock);
   if (_warnings.size() >= _queryOptions.maxWarningCount) {
     return;
   }
@@ -345,79 +524,54 @@ void Query::registerWarning(int code, char const* details) {
 void Query::prepare(QueryRegistry* registry) {
   TRI_ASSERT(registry != nullptr);
 
+  QueryResourceScope resourceScope(_resourceUsage);
+
   init();
   enterState(QueryExecutionState::ValueType::PARSING);
 
   std::unique_ptr<ExecutionPlan> plan;
-
-#if USE_PLAN_CACHE
-  if (!_queryString.empty() && hashQuery() != DontCache && _part == PART_MAIN) {
-    // LOG_TOPIC("d79d9", INFO, Logger::FIXME) << "trying to find query in execution plan
-    // cache: '" << _queryString << "', hash: " << hashQuery();
-
-    // store & lookup velocypack plans!!
-    std::shared_ptr<PlanCacheEntry> planCacheEntry =
-        PlanCache::instance()->lookup(_vocbase, hashQuery(), queryString);
-    if (planCacheEntry != nullptr) {
-      // LOG_TOPIC("8aa30", INFO, Logger::FIXME) << "query found in execution plan cache:
-      // '" << _queryString << "'";
-
-      TRI_ASSERT(_trx == nullptr);
-      TRI_ASSERT(_collections.empty());
-
-      // create the transaction object, but do not start it yet
-      _trx = AqlTransaction::create(createTransactionContext(), _collections.collections(),
-                                    _queryOptions.transactionOptions, _part == PART_MAIN);
-      _trx->addHint(transaction::Hints::Hint::FROM_TOPLEVEL_AQL); // only used on toplevel
-
-      VPackBuilder* builder = planCacheEntry->builder.get();
-      VPackSlice slice = builder->slice();
-      ExecutionPlan::getCollectionsFromVelocyPack(_ast.get(), slice);
-      _ast->variables()->fromVelocyPack(slice);
-
-      enterState(QueryExecutionState::ValueType::LOADING_COLLECTIONS);
-
-      Result res = trx->addCollections(*_collections.collections());
-
-      if (res.ok()) {
-        res = _trx->begin();
-      }
-
-      if (res.fail()) {
-        if (!_queryString.empty() && _queryOptions.verboseErrors) {
-          std::string msg = res.errorMessage();
-          msg.append("\nwhile executing:\n");
-          _queryString.append(msg);
-          msg.push_back('\n');
-        }
-
-        THROW_ARANGO_EXCEPTION(res);
-      }
-
-      enterState(QueryExecutionState::ValueType::PLAN_INSTANTIATION);
-
-      plan.reset(ExecutionPlan::instantiateFromVelocyPack(_ast.get(), slice));
-
-      TRI_ASSERT(plan != nullptr);
+  std::shared_ptr<VPackBuilder> cachedPlan;
+  std::string planCacheKey;
+  std::map<std::string, size_t> placeholderParameters;
+  uint64_t planCacheGeneration = 0;
+  bool storeInPlanCache = false;
+  std::shared_ptr<PreparedStatement> statement;
+
+  if (canUsePlanCache()) {
+    VPackSlice bindParameters = bindParametersSlice();
+    planCacheKey = PlanCache::buildKey(
+        _queryString, _options != nullptr ? _options->slice() : VPackSlice::noneSlice(),
+        bindParameters);
+    // must be fetched before planning, so that we don't store a plan that
+    // was made before an index was dropped
+    planCacheGeneration = PlanCache::instance()->generation();
+
+    std::shared_ptr<PlanCacheEntry> entry;
+    if (_queryOptions.preparedStatement != 0) {
+      // the plan of a prepared statement is kept with the statement
+      statement = PreparedStatementRegistry::instance()->lookup(
+          &_vocbase, _queryOptions.preparedStatement);
     }
-  }
-#endif
-
-  if (plan == nullptr) {
-    plan.reset(preparePlan());
-
-    TRI_ASSERT(plan != nullptr);
-
-#if USE_PLAN_CACHE
-    if (!_queryString.empty() && hashQuery() != DontCache &&
-        _part == PART_MAIN && _warnings.empty() && _ast->root()->isCacheable()) {
-      // LOG_TOPIC("6de32", INFO, Logger::FIXME) << "storing query in execution plan
-      // cache '" << _queryString << "', hash: " << hashQuery();
-      PlanCache::instance()->store(_vocbase, hashQuery(), _queryString, plan.get());
+    if (statement != nullptr) {
+      entry = statement->plan(planCacheKey, planCacheGeneration);
+    } else {
+      entry = PlanCache::instance()->lookup(&_vocbase, planCacheKey);
     }
-#endif
+    if (entry == nullptr) {
+      storeInPlanCache = true;
+    } else if (entry->matches(bindParameters)) {
+      cachedPlan = entry->instantiate(bindParameters);
+    } else if (statement != nullptr) {
+      // a statement only keeps the plan for its latest bind parameters
+      storeInPlanCache = true;
+    }
+    // if the entry was made for other bind parameter values, we keep it
+    // instead of replacing it with ours
   }
 
+  plan.reset(preparePlan(cachedPlan != nullptr ? cachedPlan->slice() : VPackSlice::noneSlice(),
+                         storeInPlanCache ? &placeholderParameters : nullptr));
+
   TRI_ASSERT(plan != nullptr);
   plan->findVarUsage();
 
@@ -439,6 +593,23 @@ void Query::prepare(QueryRegistry* registry) {
 
   _plan = std::move(plan);
 
+  if (storeInPlanCache && !_isModificationQuery && _warnings.empty() &&
+      _ast->root()->isCacheable()) {
+    try {
+      auto entry = PlanCache::buildEntry(std::move(planCacheKey), *this,
+                                         _options != nullptr ? _options->slice()
+                                                             : VPackSlice::noneSlice(),
+                                         placeholderParameters);
+      if (entry != nullptr && statement != nullptr) {
+        statement->setPlan(std::move(entry), planCacheGeneration);
+      } else if (entry != nullptr) {
+        PlanCache::instance()->store(&_vocbase, std::move(entry), planCacheGeneration);
+      }
+    } catch (...) {
+      // the query itself is fine, it just does not get into the plan cache
+    }
+  }
+
   enterState(QueryExecutionState::ValueType::EXECUTION);
 }
 
@@ -446,7 +617,12 @@ void Query::prepare(QueryRegistry* registry) {
 /// execute calls it internally. The purpose of this separate method is
 /// to be able to only prepare a query from VelocyPack and then store it in the
 /// QueryRegistry.
-ExecutionPlan* Query::preparePlan() {
+/// if cachedPlan is given, the query string is not parsed, and the plan is
+/// instantiated from it instead. if placeholderParameters is given, it is
+/// filled with the bind parameters that may become placeholders in a cached
+/// version of the plan
+ExecutionPlan* Query::preparePlan(VPackSlice cachedPlan,
+                                  std::map<std::string, size_t>* placeholderParameters) {
   LOG_TOPIC("9625e", DEBUG, Logger::QUERIES) << TRI_microtime() - _startTime << " "
                                     << "Query::prepare"
                                     << " this: " << (uintptr_t)this;
@@ -459,10 +635,18 @@ ExecutionPlan* Query::preparePlan() {
         TRI_ERROR_INTERNAL, "failed to create query transaction context");
   }
 
-  if (!_queryString.empty()) {
+  // we have an AST if we have a query string but no plan for it
+  bool const useAst = !_queryString.empty() && cachedPlan.isNone();
+
+  if (useAst) {
     Parser parser(this);
     parser.parse();
 
+    if (placeholderParameters != nullptr) {
+      *placeholderParameters =
+          PlanCache::findPlaceholderParameters(parser.ast()->root(), bindParametersSlice());
+    }
+
     // put in bind parameters
     parser.ast()->injectBindParameters(_bindParameters, ctx->resolver());
   }
@@ -486,8 +670,7 @@ ExecutionPlan* Query::preparePlan() {
 
   // As soon as we start to instantiate the plan we have to clean it
   // up before killing the unique_ptr
-  if (!_queryString.empty()) {
-    // we have an AST
+  if (useAst) {
     // optimize the ast
     enterState(QueryExecutionState::ValueType::AST_OPTIMIZATION);
 
@@ -515,10 +698,15 @@ ExecutionPlan* Query::preparePlan() {
     arangodb::aql::Optimizer opt(_queryOptions.maxNumberOfPlans);
     // get enabled/disabled rules
     opt.createPlans(std::move(plan), _queryOptions, false);
+    if (_profile != nullptr && _queryOptions.profile >= PROFILE_LEVEL_BASIC) {
+      VPackBuilder stats;
+      opt._stats.toVelocyPack(stats);
+      _profile->setOptimizerStats(stats.slice());
+    }
     // Now plan and all derived plans belong to the optimizer
     plan = opt.stealBest();  // Now we own the best one again
-  } else {  // no queryString, we are instantiating from _queryBuilder
-    VPackSlice const querySlice = _queryBuilder->slice();
+  } else {  // we are instantiating from _queryBuilder or a cached plan
+    VPackSlice const querySlice = cachedPlan.isNone() ? _queryBuilder->slice() : cachedPlan;
     ExecutionPlan::getCollectionsFromVelocyPack(_ast.get(), querySlice);
 
     _ast->variables()->fromVelocyPack(querySlice);
@@ -541,8 +729,7 @@ ExecutionPlan* Query::preparePlan() {
     enterState(QueryExecutionState::ValueType::PLAN_INSTANTIATION);
 
     // we have an execution plan in VelocyPack format
-    plan.reset(ExecutionPlan::instantiateFromVelocyPack(_ast.get(),
-                                                        _queryBuilder->slice()));
+    plan.reset(ExecutionPlan::instantiateFromVelocyPack(_ast.get(), querySlice));
     if (plan == nullptr) {
       // oops
       THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
@@ -567,6 +754,8 @@ ExecutionState Query::execute(QueryRegistry* registry, QueryResult& queryResult)
                                     << " this: " << (uintptr_t)this;
   TRI_ASSERT(registry != nullptr);
 
+  QueryResourceScope resourceScope(_resourceUsage);
+
   try {
     bool useQueryCache = canUseQueryCache();
 
@@ -701,6 +890,7 @@ ExecutionState Query::execute(QueryRegistry* registry, QueryResult& queryResult)
                                                       bindParameters(),
                                                       std::move(dataSources)  // query DataSources
               );
+          ::addKeyDependencies(_plan.get(), *_cacheEntry);
         }
 
         queryResult.data = std::move(_resultBuilder);
@@ -772,6 +962,8 @@ ExecutionState Query::executeV8(v8::Isolate* isolate, QueryRegistry* registry,
                                     << " this: " << (uintptr_t)this;
   TRI_ASSERT(registry != nullptr);
 
+  QueryResourceScope resourceScope(_resourceUsage);
+
   std::shared_ptr<SharedQueryState> ss = sharedState();
   ss->setContinueCallback();
 
@@ -915,6 +1107,7 @@ ExecutionState Query::executeV8(v8::Isolate* isolate, QueryRegistry* registry,
                                                             builder, bindParameters(),
                                                             std::move(dataSources)  // query DataSources
       );
+      ::addKeyDependencies(_plan.get(), *_cacheEntry);
     }
 
     // will set warnings, stats, profile and cleanup plan and engine
@@ -1227,7 +1420,7 @@ void Query::exitContext() {
 void Query::getStats(VPackBuilder& builder) {
   if (_engine != nullptr) {
     setExecutionTime();
-    _engine->_stats.toVelocyPack(builder, _queryOptions.fullCount);
+    engineStatsToVelocyPack(builder);
   } else {
     ExecutionStats::toVelocyPackStatic(builder);
   }
@@ -1322,6 +1515,26 @@ uint64_t Query::calculateHash() const {
   return hash ^ _bindParameters.hash();
 }
 
+/// @brief whether or not the plan cache can be used for the query
+bool Query::canUsePlanCache() const {
+  if (!_queryOptions.usePlanCache || _queryString.empty() || _part != PART_MAIN ||
+      _contextOwnedByExterior) {
+    return false;
+  }
+  // the cache is not invalidated by DDL operations on other servers
+  return !arangodb::ServerState::instance()->isRunningInCluster();
+}
+
+/// @brief the bind parameters as an object, which is empty if there are
+/// none
+VPackSlice Query::bindParametersSlice() const {
+  auto builder = _bindParameters.builder();
+  if (builder == nullptr || !builder->slice().isObject()) {
+    return VPackSlice::emptyObjectSlice();
+  }
+  return builder->slice();
+}
+
 /// @brief whether or not the query cache can be used for the query
 bool Query::canUseQueryCache() const {
   if (_queryString.size() < 8) {
@@ -1331,6 +1544,19 @@ bool Query::canUseQueryCache() const {
     return false;
   }
 
+  // a query inside a transaction that has already modified documents sees
+  // uncommitted data. its result must neither be served from the cache nor
+  // end up in it
+  TransactionState const* parent = nullptr;
+  if (_transactionContext != nullptr) {
+    parent = _transactionContext->getParentTransaction();
+  } else if (_contextOwnedByExterior) {
+    parent = transaction::V8Context::getParentState();
+  }
+  if (parent != nullptr && parent->hasModifications()) {
+    return false;
+  }
+
   auto queryCacheMode = QueryCache::instance()->mode();
 
   if (_queryOptions.cache &&
@@ -1384,10 +1610,11 @@ ExecutionState Query::cleanupPlanAndEngine(int errorCode, VPackBuilder* statsBui
       if (state == ExecutionState::WAITING) {
         return state;
       }
+      captureSlowQuery();
       if (statsBuilder != nullptr) {
         TRI_ASSERT(statsBuilder->isOpenObject());
         statsBuilder->add(VPackValue("stats"));
-        _engine->_stats.toVelocyPack(*statsBuilder, _queryOptions.fullCount);
+        engineStatsToVelocyPack(*statsBuilder);
       }
     } catch (...) {
       // shutdown may fail but we must not throw here
@@ -1405,6 +1632,53 @@ ExecutionState Query::cleanupPlanAndEngine(int errorCode, VPackBuilder* statsBui
   return ExecutionState::DONE;
 }
 
+void Query::engineStatsToVelocyPack(VPackBuilder& builder) const {
+  TRI_ASSERT(_engine != nullptr);
+  if (_queryOptions.profile < PROFILE_LEVEL_BLOCKS && !_engine->_stats.nodes.empty() &&
+      !ServerState::instance()->isDBServer()) {
+    // the per-node statistics were only collected for the capture
+    ExecutionStats stats = _engine->_stats;
+    stats.nodes.clear();
+    stats.toVelocyPack(builder, _queryOptions.fullCount);
+  } else {
+    _engine->_stats.toVelocyPack(builder, _queryOptions.fullCount);
+  }
+}
+
+void Query::captureSlowQuery() {
+  QueryList* queryList = _vocbase.queryList();
+  if (_plan == nullptr || _slowCapture != nullptr || _queryString.empty() ||
+      queryList == nullptr || !queryList->captureSlowQueries() ||
+      !queryList->isSlow(_queryOptions.stream, TRI_microtime() - _startTime)) {
+    return;
+  }
+
+  try {
+    auto capture = std::make_shared<VPackBuilder>();
+    capture->openObject();
+    capture->add(VPackValue("plan"));
+    _plan->toVelocyPack(*capture, _ast.get(), false);
+    if (_engine != nullptr) {
+      capture->add(VPackValue("stats"));
+      _engine->_stats.toVelocyPack(*capture, _queryOptions.fullCount);
+    }
+    capture->close();
+    _slowCapture = std::move(capture);
+  } catch (...) {
+    // the capture is not essential
+  }
+}
+
+ProfileLevel Query::traceLevel() const {
+  if (_queryOptions.profile < PROFILE_LEVEL_BLOCKS) {
+    QueryList* queryList = _vocbase.queryList();
+    if (queryList != nullptr && queryList->captureNodeStats()) {
+      return PROFILE_LEVEL_BLOCKS;
+    }
+  }
+  return _queryOptions.profile;
+}
+
 /// @brief create a transaction::Context
 std::shared_ptr<transaction::Context> Query::createTransactionContext() {
   if (!_transactionContext) {
@@ -30,6 +30,7 @@
 #include "Aql/Graphs.h"
 #include "Aql/QueryExecutionState.h"
 #include "Aql/QueryOptions.h"
+#include "Aql/QueryResourceUsage.h"
 #include "Aql/QueryResources.h"
 #include "Aql/QueryResultV8.h"
 #include "Aql/QueryString.h"
@@ -40,10 +41,14 @@
 #include "Basics/Common.h"
 #include "Basics/ConditionLocker.h"
 #include "Basics/ConditionVariable.h"
+#include "Basics/Mutex.h"
 #include "V8Server/V8Context.h"
 #include "VocBase/voc-types.h"
 
 #include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <map>
 
 struct TRI_vocbase_t;
 
@@ -151,6 +156,27 @@ class Query {
 
   ResourceMonitor* resourceMonitor() { return &_resourceMonitor; }
 
+  /// @brief CPU time, reads and network traffic of the query so far
+  QueryResourceUsage& resourceUsage() { return _resourceUsage; }
+
+  QueryResourceValues resourceValues() const {
+    return _resourceUsage.values(_resourceMonitor.currentResources.peakMemoryUsage);
+  }
+
+  /// @brief the user that started the query, empty without authentication
+  std::string const& user() const { return _user; }
+
+  /// @brief the profiling level the execution blocks trace with. may be
+  /// higher than requested, if per-node statistics are collected for the
+  /// captures of slow queries
+  ProfileLevel traceLevel() const;
+
+  /// @brief the execution plan and statistics, recorded when the query was
+  /// slow at the time its engine was destroyed. nullptr otherwise
+  std::shared_ptr<arangodb::velocypack::Builder> const& slowCapture() const {
+    return _slowCapture;
+  }
+
   /// @brief return the start timestamp of the query
   double startTime() const { return _startTime; }
 
@@ -317,7 +343,8 @@ class Query {
   /// execute calls it internally. The purpose of this separate method is
   /// to be able to only prepare a query from VelocyPack and then store it in
   /// the QueryRegistry.
-  ExecutionPlan* preparePlan();
+  ExecutionPlan* preparePlan(arangodb::velocypack::Slice cachedPlan,
+                             std::map<std::string, size_t>* placeholderParameters);
 
   /// @brief log a query
   void log();
@@ -328,6 +355,12 @@ class Query {
   /// @brief whether or not the query cache can be used for the query
   bool canUseQueryCache() const;
 
+  /// @brief whether or not the plan cache can be used for the query
+  bool canUsePlanCache() const;
+
+  /// @brief the bind parameters as an object
+  arangodb::velocypack::Slice bindParametersSlice() const;
+
   /// @brief enter a new state
   void enterState(QueryExecutionState::ValueType);
 
@@ -338,6 +371,14 @@ class Query {
   /// @brief cleanup plan and engine for current query can issue WAITING
   ExecutionState cleanupPlanAndEngine(int errorCode, VPackBuilder* statsBuilder = nullptr);
 
+  /// @brief the statistics of the engine, with per-node statistics only if
+  /// they were requested or are needed by the coordinator
+  void engineStatsToVelocyPack(VPackBuilder& builder) const;
+
+  /// @brief record the plan and the statistics if the query is slow, for
+  /// the capture of slow queries
+  void captureSlowQuery();
+
   /// @brief create a transaction::Context
   std::shared_ptr<transaction::Context> createTransactionContext();
 
@@ -354,6 +395,15 @@ class Query {
   /// @brief resources used by query
   QueryResources _resources;
 
+  /// @brief CPU time, reads and network traffic of the query
+  QueryResourceUsage _resourceUsage;
+
+  /// @brief the user that started the query
+  std::string _user;
+
+  /// @brief plan and statistics of a slow query, for the capture
+  std::shared_ptr<arangodb::velocypack::Builder> _slowCapture;
+
   /// @brief pointer to vocbase the query runs in
   TRI_vocbase_t& _vocbase;
 
@@ -414,6 +464,10 @@ class Query {
   /// @brief warnings collected during execution
   std::vector<std::pair<int, std::string>> _warnings;
 
+  /// @brief protects _warnings, which may be registered by blocks that are
+  /// executed on scheduler threads
+  Mutex _warningsLock;
+
   /// @brief cache for regular expressions constructed by the query
   RegexCache _regexCache;
 
@@ -323,6 +323,53 @@ void QueryCacheDatabaseEntry::invalidate(std::string const& dataSourceGuid) {
   _entriesByDataSourceGuid.erase(itr);
 }
 
+/// @brief invalidate the entries for a data source that may depend on one
+/// of the given document keys in the database-specific cache
+void QueryCacheDatabaseEntry::invalidate(std::string const& dataSourceGuid,
+                                         std::unordered_set<uint64_t> const& keyHashes) {
+  auto itr = _entriesByDataSourceGuid.find(dataSourceGuid);
+
+  if (itr == _entriesByDataSourceGuid.end()) {
+    return;
+  }
+
+  std::vector<uint64_t> affected;
+  for (auto const& it2 : itr->second.second) {
+    auto it3 = _entriesByHash.find(it2);
+
+    if (it3 == _entriesByHash.end()) {
+      continue;
+    }
+
+    auto const& dependencies = (*it3).second->_keyDependencies;
+    auto it4 = dependencies.find(dataSourceGuid);
+    if (it4 != dependencies.end()) {
+      // entry only depends on some keys of the data source
+      bool intersects = false;
+      for (auto const& keyHash : keyHashes) {
+        if ((*it4).second.find(keyHash) != (*it4).second.end()) {
+          intersects = true;
+          break;
+        }
+      }
+      if (!intersects) {
+        continue;
+      }
+    }
+    affected.emplace_back(it2);
+  }
+
+  for (auto const& hash : affected) {
+    auto it3 = _entriesByHash.find(hash);
+    TRI_ASSERT(it3 != _entriesByHash.end());
+
+    auto entry = (*it3).second;
+    removeDatasources(entry.get());
+    unlink(entry.get());
+    _entriesByHash.erase(it3);
+  }
+}
+
 /// @brief enforce maximum number of results
 /// must be called under the shard's lock
 void QueryCacheDatabaseEntry::enforceMaxResults(size_t numResults, size_t sizeResults) {
@@ -682,6 +729,23 @@ void QueryCache::invalidate(TRI_vocbase_t* vocbase, std::string const& dataSourc
   it->second->invalidate(dataSourceGuid);
 }
 
+/// @brief invalidate the queries for a particular data source that may
+/// depend on one of the given document keys
+void QueryCache::invalidate(TRI_vocbase_t* vocbase, std::string const& dataSourceGuid,
+                            std::unordered_set<uint64_t> const& keyHashes) {
+  auto const part = getPart(vocbase);
+  WRITE_LOCKER(writeLocker, _entriesLock[part]);
+
+  auto it = _entries[part].find(vocbase);
+
+  if (it == _entries[part].end()) {
+    return;
+  }
+
+  // invalidate while holding the lock
+  it->second->invalidate(dataSourceGuid, keyHashes);
+}
+
 /// @brief invalidate all queries for a particular database
 void QueryCache::invalidate(TRI_vocbase_t* vocbase) {
   std::unique_ptr<QueryCacheDatabaseEntry> databaseQueryCache;
@@ -740,6 +804,11 @@ void QueryCache::queriesToVelocyPack(TRI_vocbase_t* vocbase, VPackBuilder& build
 /// @brief get the query cache instance
 QueryCache* QueryCache::instance() { return &::instance; }
 
+/// @brief hash a document key, for key dependencies of cache entries
+uint64_t QueryCache::hashKey(arangodb::velocypack::StringRef const& key) {
+  return fasthash64(key.data(), key.size(), 0x3123456789abcdefULL);
+}
+
 /// @brief enforce maximum number of elements in each database-specific cache
 void QueryCache::enforceMaxResults(size_t numResults, size_t sizeResults) {
   for (unsigned int i = 0; i < numberOfParts; ++i) {
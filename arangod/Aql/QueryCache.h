@@ -29,7 +29,10 @@
 #include "Basics/Mutex.h"
 #include "Basics/ReadWriteLock.h"
 
+#include <velocypack/StringRef.h>
+
 #include <memory>
+#include <unordered_set>
 
 struct TRI_vocbase_t;
 
@@ -75,6 +78,9 @@ struct QueryCacheResultEntry {
   std::shared_ptr<arangodb::velocypack::Builder> const _bindVars;
   // stores datasource guid -> datasource name
   std::unordered_map<std::string, std::string> const _dataSources; 
+  // stores datasource guid -> hashes of the document keys the result
+  // depends on. data sources not contained here are depended on as a whole
+  std::unordered_map<std::string, std::unordered_set<uint64_t>> _keyDependencies;
   std::shared_ptr<arangodb::velocypack::Builder> _stats;
   size_t _size;
   size_t _rows;
@@ -116,6 +122,11 @@ struct QueryCacheDatabaseEntry {
   /// database-specific cache
   void invalidate(std::string const& dataSourceGuid);
 
+  /// @brief invalidate the entries for a data source that may depend on one
+  /// of the given document keys in the database-specific cache
+  void invalidate(std::string const& dataSourceGuid,
+                  std::unordered_set<uint64_t> const& keyHashes);
+
   void queriesToVelocyPack(arangodb::velocypack::Builder& builder) const;
 
   /// @brief enforce maximum number of results
@@ -212,6 +223,11 @@ class QueryCache {
   /// @brief invalidate all queries for a particular data source
   void invalidate(TRI_vocbase_t* vocbase, std::string const& dataSourceGuid);
 
+  /// @brief invalidate the queries for a particular data source that may
+  /// depend on one of the given document keys
+  void invalidate(TRI_vocbase_t* vocbase, std::string const& dataSourceGuid,
+                  std::unordered_set<uint64_t> const& keyHashes);
+
   /// @brief invalidate all queries for a particular database
   void invalidate(TRI_vocbase_t* vocbase);
 
@@ -221,6 +237,9 @@ class QueryCache {
   /// @brief get the pointer to the global query cache
   static QueryCache* instance();
 
+  /// @brief hash a document key, for key dependencies of cache entries
+  static uint64_t hashKey(arangodb::velocypack::StringRef const& key);
+
   /// @brief create a velocypack representation of the queries in the cache
   void queriesToVelocyPack(TRI_vocbase_t* vocbase, arangodb::velocypack::Builder& builder) const;
 
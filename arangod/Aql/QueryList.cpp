@@ -26,30 +26,46 @@
 #include "Aql/Query.h"
 #include "Aql/QueryProfile.h"
 #include "Basics/Exceptions.h"
+#include "Basics/Mutex.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/ReadLocker.h"
 #include "Basics/WriteLocker.h"
+#include "Basics/conversions.h"
 #include "Logger/Logger.h"
 #include "RestServer/QueryRegistryFeature.h"
 #include "VocBase/vocbase.h"
 
 #include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
 #include <velocypack/StringRef.h>
 #include <velocypack/Value.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <fstream>
 
 using namespace arangodb;
 using namespace arangodb::aql;
 
+namespace {
+/// @brief serializes appends to capture files, which are shared by the
+/// query lists of all databases
+arangodb::Mutex captureFileLock;
+}  // namespace
+
 QueryEntryCopy::QueryEntryCopy(TRI_voc_tick_t id, std::string&& queryString,
                                std::shared_ptr<arangodb::velocypack::Builder> const& bindParameters,
                                double started, double runTime,
-                               QueryExecutionState::ValueType state, bool stream)
+                               QueryExecutionState::ValueType state, bool stream,
+                               std::string const& user, QueryResourceValues const& resources)
     : id(id),
       queryString(std::move(queryString)),
       bindParameters(bindParameters),
       started(started),
       runTime(runTime),
       state(state),
-      stream(stream) {}
+      stream(stream),
+      user(user),
+      resources(resources) {}
 
 /// @brief create a query list
 QueryList::QueryList(TRI_vocbase_t*)
@@ -71,7 +87,16 @@ QueryList::QueryList(TRI_vocbase_t*)
           application_features::ApplicationServer::getFeature<arangodb::QueryRegistryFeature>("QueryRegistry")
               ->slowStreamingQueryThreshold()),
       _maxSlowQueries(defaultMaxSlowQueries),
-      _maxQueryStringLength(defaultMaxQueryStringLength) {
+      _maxQueryStringLength(defaultMaxQueryStringLength),
+      _maxCaptures(
+          application_features::ApplicationServer::getFeature<arangodb::QueryRegistryFeature>("QueryRegistry")
+              ->slowQueryCaptures()),
+      _captureNodeStats(
+          application_features::ApplicationServer::getFeature<arangodb::QueryRegistryFeature>("QueryRegistry")
+              ->slowQueryCaptureNodeStats()),
+      _captureFile(
+          application_features::ApplicationServer::getFeature<arangodb::QueryRegistryFeature>("QueryRegistry")
+              ->slowQueryCaptureFile()) {
   _current.reserve(64);
 }
 
@@ -122,6 +147,15 @@ void QueryList::remove(Query* query) {
 
   _current.erase(it);
 
+  QueryResourceValues const resources = query->resourceValues();
+
+  try {
+    QueryUsageTotals& totals = _usageByUser[query->user()];
+    ++totals.queries;
+    totals.resources.add(resources);
+  } catch (...) {
+  }
+
   bool const isStreaming = query->queryOptions().stream;
   double threshold = (isStreaming ? _slowStreamingQueryThreshold : _slowQueryThreshold);
 
@@ -131,6 +165,7 @@ void QueryList::remove(Query* query) {
 
   double const started = query->startTime();
   double const now = TRI_microtime();
+  std::shared_ptr<VPackBuilder> capture;
 
   try {
     // check if we need to push the query into the list of slow queries
@@ -164,30 +199,55 @@ void QueryList::remove(Query* query) {
         }
       }
 
+      std::string usage = ", cpu: " + std::to_string(resources.cpuTime) +
+                          " s, peak memory: " + std::to_string(resources.peakMemoryUsage) +
+                          " bytes, read: " + std::to_string(resources.bytesRead) + " bytes";
+      if (resources.networkBytes > 0) {
+        usage.append(", network: " + std::to_string(resources.networkBytes) + " bytes");
+      }
+      if (!query->user().empty()) {
+        usage.append(", user: '" + query->user() + "'");
+      }
+
       if (loadTime >= 0.1) {
         LOG_TOPIC("d728e", WARN, Logger::QUERIES)
             << "slow " << (isStreaming ? "streaming " : "") << "query: '" << q
             << "'" << bindParameters << ", took: " << Logger::FIXED(now - started)
-            << " s, loading took: " << Logger::FIXED(loadTime) << " s";
+            << " s, loading took: " << Logger::FIXED(loadTime) << " s" << usage;
       } else {
         LOG_TOPIC("8bcee", WARN, Logger::QUERIES)
             << "slow " << (isStreaming ? "streaming " : "") << "query: '" << q << "'"
-            << bindParameters << ", took: " << Logger::FIXED(now - started) << " s";
+            << bindParameters << ", took: " << Logger::FIXED(now - started) << " s"
+            << usage;
       }
 
       _slow.emplace_back(query->id(), std::move(q),
                          _trackBindVars ? query->bindParameters() : nullptr,
                          started, now - started,
-                         QueryExecutionState::ValueType::FINISHED, isStreaming);
+                         QueryExecutionState::ValueType::FINISHED, isStreaming,
+                         query->user(), resources);
 
       if (++_slowCount > _maxSlowQueries) {
         // free first element
         _slow.pop_front();
         --_slowCount;
       }
+
+      if (_maxCaptures > 0 && query->slowCapture() != nullptr) {
+        capture = buildCapture(query, _slow.back().queryString, now - started);
+        _captures.emplace_back(capture);
+        if (_captures.size() > _maxCaptures) {
+          _captures.pop_front();
+        }
+      }
     }
   } catch (...) {
   }
+
+  if (capture != nullptr && !_captureFile.empty()) {
+    writeLocker.unlock();
+    persistCapture(capture->slice());
+  }
 }
 
 /// @brief kills a query
@@ -259,7 +319,8 @@ std::vector<QueryEntryCopy> QueryList::listCurrent() {
 
       result.emplace_back(query->id(), extractQueryString(query, maxLength),
                           _trackBindVars ? query->bindParameters() : nullptr, started,
-                          now - started, query->state(), query->queryOptions().stream);
+                          now - started, query->state(), query->queryOptions().stream,
+                          query->user(), query->resourceValues());
     }
   }
 
@@ -287,11 +348,25 @@ std::vector<QueryEntryCopy> QueryList::listSlow() {
   return result;
 }
 
-/// @brief clear the list of slow queries
+/// @brief get the captures of slow queries
+std::vector<std::shared_ptr<VPackBuilder>> QueryList::listCaptures() {
+  READ_LOCKER(readLocker, _lock);
+  return std::vector<std::shared_ptr<VPackBuilder>>(_captures.begin(), _captures.end());
+}
+
+/// @brief clear the list and the captures of slow queries
 void QueryList::clearSlow() {
   WRITE_LOCKER(writeLocker, _lock);
   _slow.clear();
   _slowCount = 0;
+  _captures.clear();
+}
+
+/// @brief get the resources used per user
+std::vector<std::pair<std::string, QueryUsageTotals>> QueryList::listUsage() {
+  READ_LOCKER(readLocker, _lock);
+  return std::vector<std::pair<std::string, QueryUsageTotals>>(_usageByUser.begin(),
+                                                                _usageByUser.end());
 }
   
 size_t QueryList::count() {
@@ -302,3 +377,52 @@ size_t QueryList::count() {
 std::string QueryList::extractQueryString(Query const* query, size_t maxLength) const {
   return query->queryString().extract(maxLength);
 }
+
+std::shared_ptr<VPackBuilder> QueryList::buildCapture(Query* query,
+                                                      std::string const& queryString,
+                                                      double runTime) const {
+  auto result = std::make_shared<VPackBuilder>();
+  result->openObject();
+  result->add("id", VPackValue(std::to_string(query->id())));
+  result->add("query", VPackValue(queryString));
+  if (_trackBindVars && query->bindParameters() != nullptr) {
+    result->add("bindVars", query->bindParameters()->slice());
+  }
+  result->add("user", VPackValue(query->user()));
+  result->add("started", VPackValue(TRI_StringTimeStamp(query->startTime(), false)));
+  result->add("runTime", VPackValue(runTime));
+  result->add("stream", VPackValue(query->queryOptions().stream));
+
+  // the durations of the execution phases
+  QueryProfile* profile = query->profile();
+  if (profile != nullptr) {
+    profile->toVelocyPack(*result);
+  }
+
+  result->add("resources", VPackValue(VPackValueType::Object));
+  query->resourceValues().toVelocyPack(*result);
+  result->close();
+
+  for (auto const& it : VPackObjectIterator(query->slowCapture()->slice())) {
+    result->add(it.key.copyString(), it.value);
+  }
+  result->close();
+  return result;
+}
+
+void QueryList::persistCapture(VPackSlice capture) const {
+  try {
+    std::string line = capture.toJson();
+    line.push_back('\n');
+
+    MUTEX_LOCKER(locker, ::captureFileLock);
+    std::ofstream file(_captureFile, std::ios::out | std::ios::binary | std::ios::app);
+    file.write(line.data(), line.size());
+    if (!file) {
+      LOG_TOPIC("5d3c2", WARN, Logger::QUERIES)
+          << "cannot append slow query capture to '" << _captureFile << "'";
+    }
+  } catch (...) {
+    // the capture is still kept in memory
+  }
+}
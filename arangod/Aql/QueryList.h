@@ -25,6 +25,7 @@
 #define ARANGOD_AQL_QUERY_LIST_H 1
 
 #include "Aql/QueryExecutionState.h"
+#include "Aql/QueryResourceUsage.h"
 #include "Basics/Common.h"
 #include "Basics/ReadWriteLock.h"
 #include "VocBase/voc-types.h"
@@ -36,6 +37,7 @@ struct TRI_vocbase_t;
 namespace arangodb {
 namespace velocypack {
 class Builder;
+class Slice;
 }
 
 namespace aql {
@@ -46,7 +48,8 @@ struct QueryEntryCopy {
   QueryEntryCopy(TRI_voc_tick_t id, std::string&& queryString,
                  std::shared_ptr<arangodb::velocypack::Builder> const& bindParameters,
                  double started, double runTime,
-                 QueryExecutionState::ValueType state, bool stream);
+                 QueryExecutionState::ValueType state, bool stream,
+                 std::string const& user, QueryResourceValues const& resources);
 
   TRI_voc_tick_t const id;
   std::string const queryString;
@@ -55,6 +58,14 @@ struct QueryEntryCopy {
   double const runTime;
   QueryExecutionState::ValueType const state;
   bool stream;
+  std::string const user;
+  QueryResourceValues const resources;
+};
+
+/// @brief resources used by all finished queries of a user
+struct QueryUsageTotals {
+  uint64_t queries = 0;
+  QueryResourceValues resources;
 };
 
 class QueryList {
@@ -177,6 +188,25 @@ class QueryList {
     _maxQueryStringLength.store(value);
   }
 
+  /// @brief whether the plans and statistics of slow queries are captured
+  inline bool captureSlowQueries() const {
+    return _maxCaptures > 0 && trackSlowQueries();
+  }
+
+  /// @brief whether all queries collect per-node statistics for the
+  /// captures
+  inline bool captureNodeStats() const {
+    return _captureNodeStats && captureSlowQueries();
+  }
+
+  /// @brief whether a query that has been running for runTime seconds is
+  /// slow
+  inline bool isSlow(bool isStreaming, double runTime) const {
+    double const threshold =
+        (isStreaming ? slowStreamingQueryThreshold() : slowQueryThreshold());
+    return threshold >= 0.0 && runTime >= threshold;
+  }
+
   /// @brief enter a query
   bool insert(Query*);
 
@@ -195,14 +225,30 @@ class QueryList {
   /// @brief return the list of slow queries
   std::vector<QueryEntryCopy> listSlow();
 
-  /// @brief clear the list of slow queries
+  /// @brief return the captures of slow queries, oldest first
+  std::vector<std::shared_ptr<arangodb::velocypack::Builder>> listCaptures();
+
+  /// @brief clear the list and the captures of slow queries
   void clearSlow();
 
+  /// @brief return the resources used by the finished queries of each
+  /// user. only tracked queries are accounted
+  std::vector<std::pair<std::string, QueryUsageTotals>> listUsage();
+
   size_t count();
 
  private:
   std::string extractQueryString(Query const* query, size_t maxLength) const;
 
+  /// @brief the capture of a slow query, with the plan and statistics the
+  /// query recorded before its engine was destroyed
+  std::shared_ptr<arangodb::velocypack::Builder> buildCapture(Query* query,
+                                                              std::string const& queryString,
+                                                              double runTime) const;
+
+  /// @brief append a capture to the capture file
+  void persistCapture(arangodb::velocypack::Slice capture) const;
+
   /// @brief default maximum number of slow queries to keep in list
   static constexpr size_t defaultMaxSlowQueries = 64;
 
@@ -222,6 +268,9 @@ class QueryList {
   /// @brief current number of slow queries
   size_t _slowCount;
 
+  /// @brief resources used by the finished queries, per user
+  std::unordered_map<std::string, QueryUsageTotals> _usageByUser;
+
   /// @brief whether or not queries are tracked
   std::atomic<bool> _enabled;
 
@@ -242,6 +291,17 @@ class QueryList {
 
   /// @brief max length of query strings to return
   std::atomic<size_t> _maxQueryStringLength;
+
+  /// @brief captures of the most recent slow queries
+  std::list<std::shared_ptr<arangodb::velocypack::Builder>> _captures;
+
+  /// @brief maximum number of captures to keep
+  size_t const _maxCaptures;
+
+  bool const _captureNodeStats;
+
+  /// @brief file the captures are appended to, empty for none
+  std::string const _captureFile;
 };
 }  // namespace aql
 }  // namespace arangodb
@@ -36,7 +36,10 @@ using namespace arangodb::aql;
 
 QueryOptions::QueryOptions()
     : memoryLimit(0),
+      spillMemoryThreshold(0),
+      maxScanThreads(1),
       maxNumberOfPlans(0),
+      maxOptimizationTime(0.0),
       maxWarningCount(10),
       literalSizeThreshold(-1),
       satelliteSyncWait(60.0),
@@ -51,7 +54,12 @@ QueryOptions::QueryOptions()
       fullCount(false),
       count(false),
       verboseErrors(false),
-      inspectSimplePlans(true) {
+      inspectSimplePlans(true),
+      columnarRegisters(false),
+      usePlanCache(false),
+      preparedStatement(0),
+      prefetch(false),
+      allowDirtyReads(false) {
   // now set some default values from server configuration options
   QueryRegistryFeature* q =
       application_features::ApplicationServer::getFeature<QueryRegistryFeature>(
@@ -76,6 +84,8 @@ QueryOptions::QueryOptions()
 
   maxNumberOfPlans = q->maxQueryPlans();
   TRI_ASSERT(maxNumberOfPlans > 0);
+
+  maxOptimizationTime = q->maxOptimizationTime();
 }
 
 void QueryOptions::fromVelocyPack(VPackSlice const& slice) {
@@ -93,6 +103,14 @@ void QueryOptions::fromVelocyPack(VPackSlice const& slice) {
       memoryLimit = v;
     }
   }
+  value = slice.get("spillMemoryThreshold");
+  if (value.isNumber()) {
+    spillMemoryThreshold = value.getNumber<size_t>();
+  }
+  value = slice.get("maxScanThreads");
+  if (value.isNumber()) {
+    maxScanThreads = value.getNumber<size_t>();
+  }
   value = slice.get("maxNumberOfPlans");
   if (value.isNumber()) {
     maxNumberOfPlans = value.getNumber<size_t>();
@@ -100,6 +118,13 @@ void QueryOptions::fromVelocyPack(VPackSlice const& slice) {
       maxNumberOfPlans = 1;
     }
   }
+  value = slice.get("maxOptimizationTime");
+  if (value.isNumber()) {
+    double v = value.getNumber<double>();
+    if (v >= 0.0) {
+      maxOptimizationTime = v;
+    }
+  }
   value = slice.get("maxWarningCount");
   if (value.isNumber()) {
     maxWarningCount = value.getNumber<size_t>();
@@ -170,6 +195,26 @@ void QueryOptions::fromVelocyPack(VPackSlice const& slice) {
   if (value.isBool()) {
     verboseErrors = value.getBool();
   }
+  value = slice.get("columnarRegisters");
+  if (value.isBool()) {
+    columnarRegisters = value.getBool();
+  }
+  value = slice.get("usePlanCache");
+  if (value.isBool()) {
+    usePlanCache = value.getBool();
+  }
+  value = slice.get("preparedStatement");
+  if (value.isNumber()) {
+    preparedStatement = value.getNumber<uint64_t>();
+  }
+  value = slice.get("prefetch");
+  if (value.isBool()) {
+    prefetch = value.getBool();
+  }
+  value = slice.get("allowDirtyReads");
+  if (value.isBool()) {
+    allowDirtyReads = value.getBool();
+  }
 
   VPackSlice optimizer = slice.get("optimizer");
   if (optimizer.isObject()) {
@@ -220,7 +265,10 @@ void QueryOptions::toVelocyPack(VPackBuilder& builder, bool disableOptimizerRule
   builder.openObject();
 
   builder.add("memoryLimit", VPackValue(memoryLimit));
+  builder.add("spillMemoryThreshold", VPackValue(spillMemoryThreshold));
+  builder.add("maxScanThreads", VPackValue(maxScanThreads));
   builder.add("maxNumberOfPlans", VPackValue(maxNumberOfPlans));
+  builder.add("maxOptimizationTime", VPackValue(maxOptimizationTime));
   builder.add("maxWarningCount", VPackValue(maxWarningCount));
   builder.add("literalSizeThreshold", VPackValue(literalSizeThreshold));
   builder.add("satelliteSyncWait", VPackValue(satelliteSyncWait));
@@ -235,6 +283,10 @@ void QueryOptions::toVelocyPack(VPackBuilder& builder, bool disableOptimizerRule
   builder.add("fullCount", VPackValue(fullCount));
   builder.add("count", VPackValue(count));
   builder.add("verboseErrors", VPackValue(verboseErrors));
+  builder.add("columnarRegisters", VPackValue(columnarRegisters));
+  builder.add("usePlanCache", VPackValue(usePlanCache));
+  builder.add("prefetch", VPackValue(prefetch));
+  builder.add("allowDirtyReads", VPackValue(allowDirtyReads));
 
   builder.add("optimizer", VPackValue(VPackValueType::Object));
   builder.add("inspectSimplePlans", VPackValue(inspectSimplePlans));
@@ -57,7 +57,18 @@ struct QueryOptions {
   TEST_VIRTUAL ProfileLevel getProfileLevel() { return profile; };
 
   size_t memoryLimit;
+  /// @brief memory budget (in bytes) for blocking executors such as SORT,
+  /// after which they spill intermediate results to temporary files.
+  /// 0 means never spill
+  size_t spillMemoryThreshold;
+  /// @brief maximum number of threads a top-level collection scan may use.
+  /// values <= 1 scan with a single thread
+  size_t maxScanThreads;
   size_t maxNumberOfPlans;
+  /// @brief time budget (in seconds) for creating alternative plans. once
+  /// it is used up, only the cheapest plan so far is optimized further.
+  /// 0 means unlimited
+  double maxOptimizationTime;
   size_t maxWarningCount;
   int64_t literalSizeThreshold;
   double satelliteSyncWait;
@@ -74,6 +85,21 @@ struct QueryOptions {
   bool count;
   bool verboseErrors;
   bool inspectSimplePlans;
+  /// @brief store AqlItemBlocks column-major (register-wise) instead of
+  /// row-major
+  bool columnarRegisters;
+  /// @brief look up and store the query's execution plan in the plan cache
+  bool usePlanCache;
+  /// @brief id of the prepared statement the query executes, or 0. its plan
+  /// is kept with the statement instead of the plan cache
+  uint64_t preparedStatement;
+  /// @brief let top-level collection and index scans produce their next
+  /// block on a scheduler thread, while the rest of the query processes the
+  /// current one
+  bool prefetch;
+  /// @brief in a cluster, let read-only queries read shards from any of
+  /// their in-sync followers instead of only from the leaders
+  bool allowDirtyReads;
   std::vector<std::string> optimizerRules;
   std::unordered_set<std::string> shardIds;
 #ifdef USE_ENTERPRISE
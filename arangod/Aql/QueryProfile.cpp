@@ -29,6 +29,7 @@
 #include "VocBase/vocbase.h"
 
 #include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
 #include <velocypack/velocypack-aliases.h>
 
 using namespace arangodb;
@@ -81,14 +82,25 @@ void QueryProfile::setStateEnd(QueryExecutionState::ValueType state, double time
   _timers[static_cast<int>(state)] = time - _lastStamp;
 }
 
+void QueryProfile::setOptimizerStats(VPackSlice stats) {
+  _optimizerStats = std::make_unique<VPackBuilder>();
+  _optimizerStats->add(stats);
+}
+
 /// @brief convert the profile to VelocyPack
 void QueryProfile::toVelocyPack(VPackBuilder& builder) const {
-  VPackObjectBuilder guard(&builder, "profile", true);
-  for (auto state : ENUM_ITERATOR(QueryExecutionState::ValueType, INITIALIZATION, FINALIZATION)) {
-    double const value = _timers[static_cast<size_t>(state)];
+  {
+    VPackObjectBuilder guard(&builder, "profile", true);
+    for (auto state : ENUM_ITERATOR(QueryExecutionState::ValueType, INITIALIZATION, FINALIZATION)) {
+      double const value = _timers[static_cast<size_t>(state)];
 
-    if (value >= 0.0) {
-      builder.add(QueryExecutionState::toString(state), VPackValue(value));
+      if (value >= 0.0) {
+        builder.add(QueryExecutionState::toString(state), VPackValue(value));
+      }
     }
   }
+
+  if (_optimizerStats != nullptr) {
+    builder.add("optimizer", _optimizerStats->slice());
+  }
 }
@@ -28,11 +28,13 @@
 #include "Basics/Common.h"
 
 #include <array>
+#include <memory>
 
 namespace arangodb {
 
 namespace velocypack {
 class Builder;
+class Slice;
 }
 
 namespace aql {
@@ -57,12 +59,17 @@ struct QueryProfile {
     return _timers[QueryExecutionState::toNumber(t)];
   }
 
+  /// @brief remember the statistics of the optimizer run, so they are
+  /// reported next to the timers
+  void setOptimizerStats(arangodb::velocypack::Slice stats);
+
   /// @brief convert the profile to VelocyPack
   void toVelocyPack(arangodb::velocypack::Builder&) const;
 
  private:
   Query* _query;
   std::array<double, static_cast<size_t>(QueryExecutionState::ValueType::INVALID_STATE)> _timers;
+  std::unique_ptr<arangodb::velocypack::Builder> _optimizerStats;
   double _lastStamp;
   bool _tracked;
 };
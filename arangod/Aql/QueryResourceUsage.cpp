@@ -0,0 +1,128 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "QueryResourceUsage.h"
+#include "StorageEngine/EngineSelectorFeature.h"
+#include "StorageEngine/StorageEngine.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Value.h>
+#include <velocypack/velocypack-aliases.h>
+
+#ifndef _WIN32
+#include <time.h>
+#endif
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+/// @brief the query the current thread accounts its resources to
+thread_local QueryResourceUsage* currentUsage = nullptr;
+
+void threadIOCounters(uint64_t& bytesRead, uint64_t& blockCacheHits) {
+  StorageEngine* engine = EngineSelectorFeature::ENGINE;
+  if (engine != nullptr) {
+    engine->threadIOCounters(bytesRead, blockCacheHits);
+  } else {
+    bytesRead = 0;
+    blockCacheHits = 0;
+  }
+}
+}  // namespace
+
+void QueryResourceValues::add(QueryResourceValues const& other) {
+  cpuTime += other.cpuTime;
+  bytesRead += other.bytesRead;
+  blockCacheHits += other.blockCacheHits;
+  networkBytes += other.networkBytes;
+  peakMemoryUsage = (std::max)(peakMemoryUsage, other.peakMemoryUsage);
+}
+
+void QueryResourceValues::toVelocyPack(VPackBuilder& builder) const {
+  builder.add("cpuTime", VPackValue(cpuTime));
+  builder.add("peakMemoryUsage", VPackValue(peakMemoryUsage));
+  builder.add("bytesRead", VPackValue(bytesRead));
+  builder.add("blockCacheHits", VPackValue(blockCacheHits));
+  builder.add("networkBytes", VPackValue(networkBytes));
+}
+
+QueryResourceUsage::QueryResourceUsage()
+    : _cpuTime(0), _bytesRead(0), _blockCacheHits(0), _networkBytes(0) {}
+
+QueryResourceValues QueryResourceUsage::values(size_t peakMemoryUsage) const {
+  QueryResourceValues result;
+  result.cpuTime = static_cast<double>(_cpuTime.load(std::memory_order_relaxed)) / 1.0e9;
+  result.bytesRead = _bytesRead.load(std::memory_order_relaxed);
+  result.blockCacheHits = _blockCacheHits.load(std::memory_order_relaxed);
+  result.networkBytes = _networkBytes.load(std::memory_order_relaxed);
+  result.peakMemoryUsage = peakMemoryUsage;
+  return result;
+}
+
+QueryResourceScope::QueryResourceScope(QueryResourceUsage& usage)
+    : _usage(usage),
+      _previous(currentUsage),
+      _nested(currentUsage == &usage),
+      _cpuTime(0),
+      _bytesRead(0),
+      _blockCacheHits(0) {
+  if (_nested) {
+    return;
+  }
+  currentUsage = &usage;
+  _cpuTime = threadCpuTime();
+  ::threadIOCounters(_bytesRead, _blockCacheHits);
+}
+
+QueryResourceScope::~QueryResourceScope() {
+  if (_nested) {
+    return;
+  }
+  currentUsage = _previous;
+
+  uint64_t const cpuTime = threadCpuTime();
+  uint64_t bytesRead;
+  uint64_t blockCacheHits;
+  ::threadIOCounters(bytesRead, blockCacheHits);
+
+  // the counters of the thread only grow, unless someone resets them
+  if (cpuTime > _cpuTime) {
+    _usage._cpuTime.fetch_add(cpuTime - _cpuTime, std::memory_order_relaxed);
+  }
+  if (bytesRead > _bytesRead) {
+    _usage._bytesRead.fetch_add(bytesRead - _bytesRead, std::memory_order_relaxed);
+  }
+  if (blockCacheHits > _blockCacheHits) {
+    _usage._blockCacheHits.fetch_add(blockCacheHits - _blockCacheHits,
+                                     std::memory_order_relaxed);
+  }
+}
+
+uint64_t QueryResourceScope::threadCpuTime() {
+#ifndef _WIN32
+  struct timespec ts;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL +
+           static_cast<uint64_t>(ts.tv_nsec);
+  }
+#endif
+  return 0;
+}
@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_QUERY_RESOURCE_USAGE_H
+#define ARANGOD_AQL_QUERY_RESOURCE_USAGE_H 1
+
+#include "Basics/Common.h"
+
+#include <atomic>
+
+namespace arangodb {
+namespace velocypack {
+class Builder;
+}
+
+namespace aql {
+
+/// @brief a copy of the resources used by a query, or by all queries of a
+/// user
+struct QueryResourceValues {
+  /// @brief CPU time of all threads working on the query, in seconds
+  double cpuTime = 0.0;
+  uint64_t bytesRead = 0;
+  uint64_t blockCacheHits = 0;
+  /// @brief bytes sent to and received from other servers
+  uint64_t networkBytes = 0;
+  size_t peakMemoryUsage = 0;
+
+  /// @brief sums up everything but the peak memory usage, of which the
+  /// maximum is kept
+  void add(QueryResourceValues const& other);
+
+  /// @brief adds the values as attributes to an open object
+  void toVelocyPack(velocypack::Builder& builder) const;
+};
+
+/// @brief resources used by a query, updated by all threads working on it
+class QueryResourceUsage {
+ public:
+  QueryResourceUsage();
+  QueryResourceUsage(QueryResourceUsage const&) = delete;
+  QueryResourceUsage& operator=(QueryResourceUsage const&) = delete;
+
+  void addNetworkBytes(uint64_t value) {
+    _networkBytes.fetch_add(value, std::memory_order_relaxed);
+  }
+
+  QueryResourceValues values(size_t peakMemoryUsage) const;
+
+ private:
+  friend class QueryResourceScope;
+
+  std::atomic<uint64_t> _cpuTime;  // nanoseconds
+  std::atomic<uint64_t> _bytesRead;
+  std::atomic<uint64_t> _blockCacheHits;
+  std::atomic<uint64_t> _networkBytes;
+};
+
+/// @brief accounts the CPU time and the storage engine reads of the current
+/// thread between construction and destruction to a query. queries move
+/// between scheduler threads, so every piece of work on a query is wrapped
+/// in a scope of its own. a scope nested into a scope for the same query
+/// does nothing
+class QueryResourceScope {
+ public:
+  explicit QueryResourceScope(QueryResourceUsage& usage);
+  ~QueryResourceScope();
+
+  QueryResourceScope(QueryResourceScope const&) = delete;
+  QueryResourceScope& operator=(QueryResourceScope const&) = delete;
+
+  /// @brief CPU time used by the current thread, in nanoseconds
+  static uint64_t threadCpuTime();
+
+ private:
+  QueryResourceUsage& _usage;
+  QueryResourceUsage* _previous;
+  bool _nested;
+  uint64_t _cpuTime;
+  uint64_t _bytesRead;
+  uint64_t _blockCacheHits;
+};
+
+}  // namespace aql
+}  // namespace arangodb
+
+#endif
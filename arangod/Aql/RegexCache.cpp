@@ -242,3 +242,201 @@ std::pair<bool, bool> RegexCache::inspectLikePattern(std::string& out,
 
   return std::make_pair(false, false);
 }
+
+namespace {
+
+/// @brief whether a character has a special meaning in a regex, and is
+/// escaped by buildLikePattern
+bool isRegexSpecialCharacter(char c) {
+  return c == '?' || c == '+' || c == '[' || c == '(' || c == ')' ||
+         c == '{' || c == '}' || c == '^' || c == '$' || c == '|' ||
+         c == '\\' || c == '.' || c == '*';
+}
+
+/// @brief a single element of a LIKE pattern
+struct LikeToken {
+  enum Type { End, Literal, AnyCharacter, AnySequence };
+  Type type;
+  char literal;
+  /// @brief position of the next token in the pattern
+  size_t next;
+};
+
+/// @brief decode the LIKE pattern element at position pos, with the same
+/// escaping rules as buildLikePattern
+LikeToken nextLikeToken(char const* pattern, size_t length, size_t pos) {
+  if (pos >= length) {
+    return LikeToken{LikeToken::End, '\0', pos};
+  }
+  char const c = pattern[pos];
+  if (c == '\\') {
+    if (pos + 1 >= length) {
+      // a trailing backslash is ignored
+      return LikeToken{LikeToken::End, '\0', length};
+    }
+    char const d = pattern[pos + 1];
+    if (d == '\\' || d == '%' || d == '_' || ::isRegexSpecialCharacter(d)) {
+      return LikeToken{LikeToken::Literal, d, pos + 2};
+    }
+    // a backslash followed by no special character is a literal backslash
+    return LikeToken{LikeToken::Literal, '\\', pos + 1};
+  }
+  if (c == '%') {
+    return LikeToken{LikeToken::AnySequence, '\0', pos + 1};
+  }
+  if (c == '_') {
+    return LikeToken{LikeToken::AnyCharacter, '\0', pos + 1};
+  }
+  return LikeToken{LikeToken::Literal, c, pos + 1};
+}
+
+/// @brief position of the next UTF-8 character in value
+size_t nextCharacter(char const* value, size_t length, size_t pos) {
+  TRI_ASSERT(pos < length);
+  do {
+    ++pos;
+  } while (pos < length && (static_cast<uint8_t>(value[pos]) & 0xC0) == 0x80);
+  return pos;
+}
+
+/// @brief whether value contains a line terminator that the wildcards of
+/// the regex built by buildLikePattern do not match. without UREGEX_DOTALL,
+/// ICU's "." matches none of U+000A-U+000D, U+0085, U+2028 and U+2029, and
+/// the wildcards only add "[\r\n]". this leaves U+000B, U+000C, U+0085,
+/// U+2028 and U+2029
+bool containsLineTerminator(char const* value, size_t length) {
+  for (size_t i = 0; i < length; ++i) {
+    uint8_t const c = static_cast<uint8_t>(value[i]);
+    if (c == 0x0B || c == 0x0C) {
+      return true;
+    }
+    if (c == 0xC2 && i + 1 < length && static_cast<uint8_t>(value[i + 1]) == 0x85) {
+      return true;
+    }
+    if (c == 0xE2 && i + 2 < length && static_cast<uint8_t>(value[i + 1]) == 0x80 &&
+        (static_cast<uint8_t>(value[i + 2]) == 0xA8 ||
+         static_cast<uint8_t>(value[i + 2]) == 0xA9)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+/// @brief extract the literal prefix of a regex that is anchored at the
+/// start of the input, e.g. "abc" for "^abc.*". returns false if the
+/// regex is not anchored, or if no literal prefix can be determined
+bool RegexCache::inspectRegexPrefix(std::string& out, char const* ptr, size_t length) {
+  out.clear();
+  if (length == 0 || ptr[0] != '^') {
+    return false;
+  }
+  for (size_t i = 0; i < length; ++i) {
+    if (ptr[i] == '|') {
+      // an alternative may not be anchored
+      return false;
+    }
+  }
+
+  for (size_t i = 1; i < length; ++i) {
+    char const c = ptr[i];
+    if (c == '*' || c == '?' || c == '{') {
+      // the previous character is optional
+      if (!out.empty()) {
+        out.pop_back();
+      }
+      break;
+    }
+    if (c == '+') {
+      // the previous character must occur at least once
+      break;
+    }
+    if (::isRegexSpecialCharacter(c) || c == ']' || c == '#' ||
+        static_cast<uint8_t>(c) < 0x20 || static_cast<uint8_t>(c) >= 0x80) {
+      // only plain ASCII characters are taken
+      break;
+    }
+    out.push_back(c);
+  }
+
+  return !out.empty();
+}
+
+/// @brief match a value against a case-sensitive LIKE pattern byte by
+/// byte, without ICU. this is only possible if the pattern consists of
+/// ASCII characters only. if handled is set to false, the value must
+/// be matched with the matcher from buildLikeMatcher() instead.
+/// the trailing "$" of that regex also matches before a line terminator at
+/// the end of the value, but LIKE requires the whole value to match, so the
+/// end of the pattern only matches at the end of the value here as well
+bool RegexCache::matchesLikePattern(char const* pattern, size_t patternLength,
+                                    char const* value, size_t valueLength,
+                                    bool& handled) {
+  bool hasWildcard = false;
+  for (size_t i = 0; i < patternLength; ++i) {
+    uint8_t const c = static_cast<uint8_t>(pattern[i]);
+    if (c >= 0x80) {
+      // non-ASCII patterns are left to ICU
+      handled = false;
+      return false;
+    }
+    hasWildcard |= (c == '%' || c == '_');
+  }
+  if (hasWildcard && ::containsLineTerminator(value, valueLength)) {
+    handled = false;
+    return false;
+  }
+  handled = true;
+
+  // greedy matching, backtracking to the last % only
+  size_t p = 0;
+  size_t v = 0;
+  bool backtrack = false;
+  size_t backtrackPattern = 0;
+  size_t backtrackValue = 0;
+
+  while (true) {
+    ::LikeToken token = ::nextLikeToken(pattern, patternLength, p);
+    bool matched;
+    switch (token.type) {
+      case ::LikeToken::End:
+        matched = (v == valueLength);
+        if (matched) {
+          return true;
+        }
+        break;
+      case ::LikeToken::AnySequence:
+        // first try to match the empty sequence
+        backtrack = true;
+        backtrackPattern = token.next;
+        backtrackValue = v;
+        p = token.next;
+        continue;
+      case ::LikeToken::AnyCharacter:
+        matched = (v < valueLength);
+        if (matched) {
+          v = ::nextCharacter(value, valueLength, v);
+        }
+        break;
+      case ::LikeToken::Literal:
+        matched = (v < valueLength && value[v] == token.literal);
+        if (matched) {
+          ++v;
+        }
+        break;
+    }
+
+    if (matched) {
+      p = token.next;
+      continue;
+    }
+    if (!backtrack || backtrackValue >= valueLength) {
+      return false;
+    }
+    // let the last % match one more character
+    backtrackValue = ::nextCharacter(value, valueLength, backtrackValue);
+    p = backtrackPattern;
+    v = backtrackValue;
+  }
+}
@@ -64,6 +64,18 @@ class RegexCache {
   static std::pair<bool, bool> inspectLikePattern(std::string& out,
                                                   char const* ptr, size_t length);
 
+  /// @brief extract the literal prefix of a regex that is anchored at the
+  /// start of the input, e.g. "abc" for "^abc.*". returns false if the
+  /// regex is not anchored, or if no literal prefix can be determined
+  static bool inspectRegexPrefix(std::string& out, char const* ptr, size_t length);
+
+  /// @brief match a value against a case-sensitive LIKE pattern byte by
+  /// byte, without ICU. this is only possible if the pattern consists of
+  /// ASCII characters only. if handled is set to false, the value must
+  /// be matched with the matcher from buildLikeMatcher() instead
+  static bool matchesLikePattern(char const* pattern, size_t patternLength,
+                                 char const* value, size_t valueLength, bool& handled);
+
  private:
   /// @brief get matcher from cache, or insert a new matcher for the specified
   /// pattern
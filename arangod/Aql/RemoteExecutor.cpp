@@ -31,9 +31,11 @@
 #include "Basics/VelocyPackHelper.h"
 #include "Cluster/ClusterComm.h"
 #include "Cluster/ServerState.h"
+#include "SimpleHttpClient/SimpleHttpResult.h"
 
 #include <lib/Rest/CommonDefines.h>
 #include <velocypack/Iterator.h>
+#include <velocypack/Validator.h>
 #include <velocypack/velocypack-aliases.h>
 
 using namespace arangodb;
@@ -41,9 +43,38 @@ using namespace arangodb::aql;
 
 using arangodb::basics::VelocyPackHelper;
 
+namespace {
+/// @brief serialize a request body. the DB servers understand VelocyPack
+/// bodies, so we send them as is and save the JSON round trip
+std::shared_ptr<std::string const> bodyToString(VPackSlice slice) {
+  return std::make_shared<std::string const>(slice.startAs<char>(), slice.byteSize());
+}
+
+/// @brief extract the body of a DB server response. the server answers
+/// in VelocyPack as requested by our Accept header, but older servers may
+/// still send JSON, so we fall back to parsing it
+std::shared_ptr<VPackBuilder> responseBodyToVelocyPack(httpclient::SimpleHttpResult& response) {
+  bool found = false;
+  std::string contentType =
+      response.getHeaderField(StaticStrings::ContentTypeHeader, found);
+  if (found && contentType.compare(0, StaticStrings::MimeTypeVPack.size(),
+                                   StaticStrings::MimeTypeVPack) == 0) {
+    arangodb::basics::StringBuffer& body = response.getBody();
+    VPackValidator validator;
+    validator.validate(body.c_str(), body.length());
+    return std::make_shared<VPackBuilder>(
+        VPackSlice(reinterpret_cast<uint8_t const*>(body.c_str())));
+  }
+  return response.getBodyVelocyPack();
+}
+}  // namespace
+
 /// @brief timeout
 double const ExecutionBlockImpl<RemoteExecutor>::defaultTimeOut = 3600.0;
 
+/// @brief credit
+size_t const ExecutionBlockImpl<RemoteExecutor>::defaultCredit = 4;
+
 ExecutionBlockImpl<RemoteExecutor>::ExecutionBlockImpl(
     ExecutionEngine* engine, RemoteNode const* node, ExecutorInfos&& infos,
     std::string const& server, std::string const& ownName, std::string const& queryId)
@@ -57,7 +88,9 @@ ExecutionBlockImpl<RemoteExecutor>::ExecutionBlockImpl(
       _lastResponse(nullptr),
       _lastError(TRI_ERROR_NO_ERROR),
       _lastTicketId(0),
-      _hasTriggeredShutdown(false) {
+      _hasTriggeredShutdown(false),
+      _lastRequestIsGetSome(false),
+      _prefetchedDone(false) {
   TRI_ASSERT(!queryId.empty());
   TRI_ASSERT((arangodb::ServerState::instance()->isCoordinator() && ownName.empty()) ||
              (!arangodb::ServerState::instance()->isCoordinator() && !ownName.empty()));
@@ -85,54 +118,52 @@ std::pair<ExecutionState, SharedAqlItemBlockPtr> ExecutionBlockImpl<RemoteExecut
     THROW_ARANGO_EXCEPTION(TRI_ERROR_QUERY_KILLED);
   }
 
-  // For every call we simply forward via HTTP
-  if (_lastError.fail()) {
-    TRI_ASSERT(_lastResponse == nullptr);
-    Result res = _lastError;
-    _lastError.reset();
-    // we were called with an error need to throw it.
-    THROW_ARANGO_EXCEPTION(res);
-  }
+  if (_prefetched.empty()) {
+    if (hasRequestInFlight()) {
+      // we may be woken up by the response for another block, e.g. when
+      // a gather waits for several shards at once
+      return {ExecutionState::WAITING, nullptr};
+    }
 
-  if (_lastResponse != nullptr) {
-    TRI_ASSERT(_lastError.ok());
-    // We do not have an error but a result, all is good
-    // We have an open result still.
-    std::shared_ptr<VPackBuilder> responseBodyBuilder = stealResultBody();
-    // Result is the response which will be a serialized AqlItemBlock
+    // For every call we simply forward via HTTP
+    if (_lastError.fail()) {
+      TRI_ASSERT(_lastResponse == nullptr);
+      Result res = _lastError;
+      _lastError.reset();
+      // we were called with an error need to throw it.
+      THROW_ARANGO_EXCEPTION(res);
+    }
 
-    // both must be reset before return or throw
-    TRI_ASSERT(_lastError.ok() && _lastResponse == nullptr);
+    if (_lastResponse == nullptr) {
+      // We need to send a request here
+      VPackBuilder builder;
+      builder.openObject();
+      builder.add("atMost", VPackValue(atMost));
+      builder.add("credit", VPackValue(defaultCredit));
+      builder.close();
 
-    VPackSlice responseBody = responseBodyBuilder->slice();
+      auto bodyString = bodyToString(builder.slice());
 
-    ExecutionState state = ExecutionState::HASMORE;
-    if (VelocyPackHelper::getBooleanValue(responseBody, "done", true)) {
-      state = ExecutionState::DONE;
-    }
-    if (responseBody.hasKey("data")) {
-      SharedAqlItemBlockPtr r =
-          _engine->itemBlockManager().requestAndInitBlock(responseBody);
+      auto res = sendAsyncRequest(rest::RequestType::PUT, "/_api/aql/getSome/", bodyString);
+      if (!res.ok()) {
+        THROW_ARANGO_EXCEPTION(res);
+      }
 
-      return {state, std::move(r)};
+      return {ExecutionState::WAITING, nullptr};
     }
-    return {ExecutionState::DONE, nullptr};
-  }
-
-  // We need to send a request here
-  VPackBuilder builder;
-  builder.openObject();
-  builder.add("atMost", VPackValue(atMost));
-  builder.close();
 
-  auto bodyString = std::make_shared<std::string const>(builder.slice().toJson());
-
-  auto res = sendAsyncRequest(rest::RequestType::PUT, "/_api/aql/getSome/", bodyString);
-  if (!res.ok()) {
-    THROW_ARANGO_EXCEPTION(res);
+    TRI_ASSERT(_lastRequestIsGetSome);
+    stealGetSomeResult();
+    if (_prefetched.empty()) {
+      return {ExecutionState::DONE, nullptr};
+    }
   }
 
-  return {ExecutionState::WAITING, nullptr};
+  SharedAqlItemBlockPtr r = takePrefetched(atMost);
+  ExecutionState state = (_prefetched.empty() && _prefetchedDone)
+                             ? ExecutionState::DONE
+                             : ExecutionState::HASMORE;
+  return {state, std::move(r)};
 }
 
 std::pair<ExecutionState, size_t> ExecutionBlockImpl<RemoteExecutor>::skipSome(size_t atMost) {
@@ -142,6 +173,27 @@ std::pair<ExecutionState, size_t> ExecutionBlockImpl<RemoteExecutor>::skipSome(s
 }
 
 std::pair<ExecutionState, size_t> ExecutionBlockImpl<RemoteExecutor>::skipSomeWithoutTrace(size_t atMost) {
+  if (_prefetched.empty() && hasRequestInFlight()) {
+    return {ExecutionState::WAITING, 0};
+  }
+
+  if (_prefetched.empty() && _lastResponse != nullptr && _lastRequestIsGetSome) {
+    // a getSome was sent ahead of us, skip the rows it returned
+    stealGetSomeResult();
+    if (_prefetched.empty()) {
+      return {ExecutionState::DONE, 0};
+    }
+  }
+
+  if (!_prefetched.empty()) {
+    // skip rows the remote side has already sent us
+    size_t skipped = takePrefetched(atMost)->size();
+    ExecutionState state = (_prefetched.empty() && _prefetchedDone)
+                               ? ExecutionState::DONE
+                               : ExecutionState::HASMORE;
+    return {state, skipped};
+  }
+
   if (_lastError.fail()) {
     TRI_ASSERT(_lastResponse == nullptr);
     Result res = _lastError;
@@ -190,7 +242,7 @@ std::pair<ExecutionState, size_t> ExecutionBlockImpl<RemoteExecutor>::skipSomeWi
   builder.add("atMost", VPackValue(atMost));
   builder.close();
 
-  auto bodyString = std::make_shared<std::string const>(builder.slice().toJson());
+  auto bodyString = bodyToString(builder.slice());
 
   auto res = sendAsyncRequest(rest::RequestType::PUT, "/_api/aql/skipSome/", bodyString);
   if (!res.ok()) {
@@ -200,8 +252,23 @@ std::pair<ExecutionState, size_t> ExecutionBlockImpl<RemoteExecutor>::skipSomeWi
   return {ExecutionState::WAITING, 0};
 }
 
+std::pair<ExecutionState, Result> ExecutionBlockImpl<RemoteExecutor>::initializeCursorWithBatch(
+    SharedAqlItemBlockPtr const&) {
+  // the optimizer does not batch subqueries that contain remote nodes
+  TRI_ASSERT(false);
+  return {ExecutionState::DONE,
+          Result(TRI_ERROR_NOT_IMPLEMENTED,
+                 "initializeCursor with a batch of rows is not supported by RemoteBlock")};
+}
+
 std::pair<ExecutionState, Result> ExecutionBlockImpl<RemoteExecutor>::initializeCursor(
     InputAqlItemRow const& input) {
+  if (input.isInitialized()) {
+    // blocks produced ahead belong to the previous run of the remote cursor
+    _prefetched.clear();
+    _prefetchedDone = false;
+  }
+
   // For every call we simply forward via HTTP
 
   if (!_isResponsibleForInitializeCursor) {
@@ -215,6 +282,17 @@ std::pair<ExecutionState, Result> ExecutionBlockImpl<RemoteExecutor>::initialize
     return {ExecutionState::DONE, TRI_ERROR_NO_ERROR};
   }
 
+  if (hasRequestInFlight()) {
+    return {ExecutionState::WAITING, TRI_ERROR_NO_ERROR};
+  }
+
+  if (_lastRequestIsGetSome && (_lastResponse != nullptr || _lastError.fail())) {
+    // the result of a getSome that was sent ahead of time is of no use
+    // anymore, the cursor is about to start over
+    _lastResponse.reset();
+    _lastError.reset();
+  }
+
   if (_lastResponse != nullptr || _lastError.fail()) {
     // We have an open result still.
     std::shared_ptr<VPackBuilder> responseBodyBuilder = stealResultBody();
@@ -251,7 +329,7 @@ std::pair<ExecutionState, Result> ExecutionBlockImpl<RemoteExecutor>::initialize
 
   builder.close();
 
-  auto bodyString = std::make_shared<std::string const>(builder.slice().toJson());
+  auto bodyString = bodyToString(builder.slice());
 
   auto res = sendAsyncRequest(rest::RequestType::PUT,
                               "/_api/aql/initializeCursor/", bodyString);
@@ -287,6 +365,7 @@ std::pair<ExecutionState, Result> ExecutionBlockImpl<RemoteExecutor>::shutdown(i
     _lastTicketId = 0;
     _lastError.reset(TRI_ERROR_NO_ERROR);
     _lastResponse.reset();
+    _prefetched.clear();
     _hasTriggeredShutdown = true;
   }
 
@@ -354,7 +433,7 @@ std::pair<ExecutionState, Result> ExecutionBlockImpl<RemoteExecutor>::shutdown(i
   bodyBuilder.add("code", VPackValue(errorCode));
   bodyBuilder.close();
 
-  auto bodyString = std::make_shared<std::string const>(bodyBuilder.slice().toJson());
+  auto bodyString = bodyToString(bodyBuilder.slice());
 
   auto res = sendAsyncRequest(rest::RequestType::PUT, "/_api/aql/shutdown/", bodyString);
   if (!res.ok()) {
@@ -375,6 +454,8 @@ Result ExecutionBlockImpl<RemoteExecutor>::sendAsyncRequest(
   // Later, we probably want to set these sensibly:
   CoordTransactionID const coordTransactionId = TRI_NewTickServer();
   std::unordered_map<std::string, std::string> headers;
+  headers.emplace(StaticStrings::ContentTypeHeader, StaticStrings::MimeTypeVPack);
+  headers.emplace(StaticStrings::Accept, StaticStrings::MimeTypeVPack);
   if (!_ownName.empty()) {
     headers.emplace("Shard-Id", _ownName);
   }
@@ -385,6 +466,9 @@ Result ExecutionBlockImpl<RemoteExecutor>::sendAsyncRequest(
                     urlPart + _queryId;
 
   ++_engine->_stats.requests;
+  if (body != nullptr) {
+    _engine->getQuery()->resourceUsage().addNetworkBytes(body->size());
+  }
   std::shared_ptr<ClusterCommCallback> callback =
       std::make_shared<WakeupQueryCallback>(this, _engine->getQuery());
 
@@ -401,6 +485,7 @@ Result ExecutionBlockImpl<RemoteExecutor>::sendAsyncRequest(
   // We can only track one request at a time.
   // So assert there is no other request in flight!
   TRI_ASSERT(_lastTicketId == 0);
+  _lastRequestIsGetSome = (urlPart == "/_api/aql/getSome/");
   _lastTicketId =
       cc->asyncRequest(coordTransactionId, _server, type, url, std::move(body),
                        headers, callback, defaultTimeOut, true);
@@ -426,6 +511,10 @@ bool ExecutionBlockImpl<RemoteExecutor>::handleAsyncResult(ClusterCommResult* re
     _lastError = handleCommErrors(result);
     if (_lastError.ok()) {
       _lastResponse = result->result;
+      if (_lastResponse != nullptr) {
+        _engine->getQuery()->resourceUsage().addNetworkBytes(
+            _lastResponse->getBody().length());
+      }
     }
     _lastTicketId = 0;
   }
@@ -452,9 +541,7 @@ arangodb::Result ExecutionBlockImpl<RemoteExecutor>::handleCommErrors(ClusterCom
     int errorNum = TRI_ERROR_INTERNAL;
     if (res->result != nullptr) {
       errorNum = TRI_ERROR_NO_ERROR;
-      arangodb::basics::StringBuffer const& responseBodyBuf(res->result->getBody());
-      std::shared_ptr<VPackBuilder> builder =
-          VPackParser::fromJson(responseBodyBuf.c_str(), responseBodyBuf.length());
+      std::shared_ptr<VPackBuilder> builder = responseBodyToVelocyPack(*res->result);
       VPackSlice slice = builder->slice();
 
       if (!slice.hasKey(StaticStrings::Error) ||
@@ -513,7 +600,56 @@ std::shared_ptr<VPackBuilder> ExecutionBlockImpl<RemoteExecutor>::stealResultBod
   }
   // We have an open result still.
   // Result is the response which is an object containing the ErrorCode
-  std::shared_ptr<VPackBuilder> responseBodyBuilder = _lastResponse->getBodyVelocyPack();
+  std::shared_ptr<VPackBuilder> responseBodyBuilder =
+      responseBodyToVelocyPack(*_lastResponse);
   _lastResponse.reset();
   return responseBodyBuilder;
 }
+
+SharedAqlItemBlockPtr ExecutionBlockImpl<RemoteExecutor>::takePrefetched(size_t atMost) {
+  TRI_ASSERT(!_prefetched.empty());
+  TRI_ASSERT(atMost > 0);
+  SharedAqlItemBlockPtr block = std::move(_prefetched.front());
+  _prefetched.pop_front();
+  if (block->size() > atMost) {
+    // the caller asks for less than the remote side produced per block
+    _prefetched.emplace_front(block->slice(atMost, block->size()));
+    block = block->slice(0, atMost);
+  }
+  return block;
+}
+
+bool ExecutionBlockImpl<RemoteExecutor>::hasRequestInFlight() {
+  #ifdef ARANGODB_USE_CATCH_TESTS
+    RECURSIVE_MUTEX_LOCKER(_communicationMutex, _communicationMutexOwner);
+  #else
+    MUTEX_LOCKER(locker, _communicationMutex);
+  #endif
+  return _lastTicketId != 0;
+}
+
+void ExecutionBlockImpl<RemoteExecutor>::stealGetSomeResult() {
+  TRI_ASSERT(_prefetched.empty());
+  std::shared_ptr<VPackBuilder> responseBodyBuilder = stealResultBody();
+  // Result is the response which will be a serialized AqlItemBlock
+
+  // both must be reset before return or throw
+  TRI_ASSERT(_lastError.ok() && _lastResponse == nullptr);
+
+  VPackSlice responseBody = responseBodyBuilder->slice();
+
+  _prefetchedDone = VelocyPackHelper::getBooleanValue(responseBody, "done", true);
+  if (!responseBody.hasKey("data")) {
+    _prefetchedDone = true;
+    return;
+  }
+  _prefetched.emplace_back(_engine->itemBlockManager().requestAndInitBlock(responseBody));
+
+  // further blocks the remote side produced with our credit
+  VPackSlice next = responseBody.get("next");
+  if (next.isArray()) {
+    for (VPackSlice it : VPackArrayIterator(next)) {
+      _prefetched.emplace_back(_engine->itemBlockManager().requestAndInitBlock(it));
+    }
+  }
+}
@@ -31,6 +31,8 @@
 #include <lib/Rest/CommonDefines.h>
 #include <lib/SimpleHttpClient/SimpleHttpResult.h>
 
+#include <deque>
+
 namespace arangodb {
 namespace aql {
 
@@ -59,6 +61,9 @@ class ExecutionBlockImpl<RemoteExecutor> : public ExecutionBlock {
 
   std::pair<ExecutionState, Result> initializeCursor(InputAqlItemRow const& input) override;
 
+  /// @brief batches of input rows cannot be sent to the remote side
+  std::pair<ExecutionState, Result> initializeCursorWithBatch(SharedAqlItemBlockPtr const& batch) override;
+
   std::pair<ExecutionState, Result> shutdown(int errorCode) override;
 
   /// @brief handleAsyncResult
@@ -98,10 +103,24 @@ class ExecutionBlockImpl<RemoteExecutor> : public ExecutionBlock {
 
   std::shared_ptr<velocypack::Builder> stealResultBody();
 
+  /// @brief whether or not we are still waiting for the response to our
+  /// last request
+  bool hasRequestInFlight();
+
+  /// @brief move the blocks of the last getSome response to _prefetched
+  void stealGetSomeResult();
+
+  /// @brief hand out up to atMost rows of the blocks the remote side has
+  /// already produced ahead. must only be called if there are any
+  SharedAqlItemBlockPtr takePrefetched(size_t atMost);
+
  private:
   /// @brief timeout
   static double const defaultTimeOut;
 
+  /// @brief number of blocks the remote side may return per getSome call
+  static size_t const defaultCredit;
+
   ExecutorInfos _infos;
 
   Query const& _query;
@@ -135,6 +154,15 @@ class ExecutionBlockImpl<RemoteExecutor> : public ExecutionBlock {
   OperationID _lastTicketId;
 
   bool _hasTriggeredShutdown;
+
+  /// @brief whether the last request sent was a getSome
+  bool _lastRequestIsGetSome;
+
+  /// @brief blocks returned by the remote side ahead of being asked for
+  std::deque<SharedAqlItemBlockPtr> _prefetched;
+
+  /// @brief whether the remote side was done after the prefetched blocks
+  bool _prefetchedDone;
 };
 
 }  // namespace aql
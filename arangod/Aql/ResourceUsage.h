@@ -26,6 +26,8 @@
 
 #include "Basics/Common.h"
 #include "Basics/Exceptions.h"
+#include "Basics/Mutex.h"
+#include "Basics/MutexLocker.h"
 
 #include <algorithm>
 
@@ -50,13 +52,25 @@ struct ResourceUsage {
 };
 
 struct ResourceMonitor {
-  ResourceMonitor() : currentResources(), maxResources() {}
+  ResourceMonitor() : currentResources(), maxResources(), _threadSafe(false) {}
   explicit ResourceMonitor(ResourceUsage const& maxResources)
-      : currentResources(), maxResources(maxResources) {}
+      : currentResources(), maxResources(maxResources), _threadSafe(false) {}
+
+  /// @brief copies the usage and the limits, but not the synchronization
+  ResourceMonitor& operator=(ResourceMonitor const& other) noexcept {
+    currentResources = other.currentResources;
+    maxResources = other.maxResources;
+    return *this;
+  }
 
   void setMemoryLimit(size_t value) { maxResources.memoryUsage = value; }
 
+  /// @brief synchronize all changes from now on. this is required once
+  /// parts of the query are executed on other threads
+  void setThreadSafe() noexcept { _threadSafe = true; }
+
   inline void increaseMemoryUsage(size_t value) {
+    CONDITIONAL_MUTEX_LOCKER(locker, _mutex, _threadSafe);
     currentResources.memoryUsage += value;
 
     if (maxResources.memoryUsage > 0 &&
@@ -70,6 +84,7 @@ struct ResourceMonitor {
   }
 
   inline void decreaseMemoryUsage(size_t value) noexcept {
+    CONDITIONAL_MUTEX_LOCKER(locker, _mutex, _threadSafe);
     TRI_ASSERT(currentResources.memoryUsage >= value);
     currentResources.memoryUsage -= value;
   }
@@ -78,6 +93,10 @@ struct ResourceMonitor {
 
   ResourceUsage currentResources;
   ResourceUsage maxResources;
+
+ private:
+  Mutex _mutex;
+  bool _threadSafe;
 };
 
 }  // namespace aql
@@ -31,8 +31,11 @@
 #include "Aql/BlocksWithClients.h"
 #include "Aql/ExecutionBlock.h"
 #include "Aql/ExecutionEngine.h"
+#include "Aql/ExecutionNode.h"
+#include "Aql/ExecutionPlan.h"
 #include "Aql/Query.h"
 #include "Aql/QueryRegistry.h"
+#include "Aql/WalkerWorker.h"
 #include "Basics/Exceptions.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/StringUtils.h"
@@ -57,6 +60,37 @@ using namespace arangodb::aql;
 
 using VelocyPackHelper = arangodb::basics::VelocyPackHelper;
 
+namespace {
+/// @brief maximum number of blocks returned by a single getSome call
+size_t const maxGetSomeCredit = 16;
+
+struct RemoteNodeFinder final : public WalkerWorker<ExecutionNode> {
+  bool found = false;
+
+  bool before(ExecutionNode* en) override final {
+    if (en->getType() == ExecutionNode::REMOTE) {
+      found = true;
+    }
+    return found;
+  }
+};
+
+/// @brief whether or not the query can produce blocks ahead of being
+/// asked for them. producing must never suspend the query, because a
+/// wakeup after we have already answered would hit the wrong request.
+/// only snippets with remote dependencies can suspend, so only snippets
+/// without them may produce ahead.
+bool canProduceAhead(Query const* query) {
+  ExecutionPlan* plan = query->plan();
+  if (plan == nullptr || plan->root() == nullptr) {
+    return false;
+  }
+  RemoteNodeFinder finder;
+  plan->root()->walk(finder);
+  return !finder.found;
+}
+}  // namespace
+
 RestAqlHandler::RestAqlHandler(GeneralRequest* request, GeneralResponse* response,
                                std::pair<QueryRegistry*, traverser::TraverserEngineRegistry*>* registries)
     : RestVocbaseBaseHandler(request, response),
@@ -745,6 +779,25 @@ RestStatus RestAqlHandler::handleUseQuery(std::string const& operation, Query* q
             return RestStatus::WAITING;
           }
         }
+        // use the credit granted by the caller to produce further blocks
+        // right away, saving it a round trip for each of them
+        std::vector<SharedAqlItemBlockPtr> next;
+        if (state == ExecutionState::HASMORE && shardId.empty()) {
+          size_t credit = (std::min)(
+              VelocyPackHelper::getNumericValue<size_t>(querySlice, "credit", 1),
+              maxGetSomeCredit);
+          if (credit > 1 && canProduceAhead(query)) {
+            while (state == ExecutionState::HASMORE && next.size() + 1 < credit) {
+              SharedAqlItemBlockPtr more;
+              std::tie(state, more) = query->engine()->getSome(atMost);
+              TRI_ASSERT(state != ExecutionState::WAITING);
+              if (more.get() == nullptr) {
+                break;
+              }
+              next.emplace_back(std::move(more));
+            }
+          }
+        }
         // Used in 3.4.0 onwards.
         answerBuilder.add("done", VPackValue(state == ExecutionState::DONE));
         if (items.get() == nullptr) {
@@ -754,6 +807,14 @@ RestStatus RestAqlHandler::handleUseQuery(std::string const& operation, Query* q
         } else {
           items->toVelocyPack(query->trx(), answerBuilder);
         }
+        if (!next.empty()) {
+          answerBuilder.add(VPackValue("next"));
+          VPackArrayBuilder nextGuard(&answerBuilder);
+          for (auto const& block : next) {
+            VPackObjectBuilder blockGuard(&answerBuilder);
+            block->toVelocyPack(query->trx(), answerBuilder);
+          }
+        }
       } else if (operation == "skipSome") {
         auto atMost =
             VelocyPackHelper::getNumericValue<size_t>(querySlice, "atMost",
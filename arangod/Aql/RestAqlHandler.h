@@ -70,6 +70,10 @@ class RestAqlHandler : public RestVocbaseBaseHandler {
   //             more than "atMost" items.
   //             The result is the JSON representation of an
   //             AqlItemBlock.
+  //   "credit": optional, the number of blocks the caller is willing to
+  //             take in one response. Blocks beyond the first one are
+  //             returned in the "next" array, each with at most "atMost"
+  //             items.
   // For the "skip" operation one has to give:
   //   "number": must be a positive integer, the cursor skips as many items,
   //             possibly exhausting the cursor.
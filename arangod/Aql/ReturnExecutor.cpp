@@ -33,17 +33,26 @@ using namespace arangodb::aql;
 
 ReturnExecutorInfos::ReturnExecutorInfos(RegisterId inputRegister, RegisterId nrInputRegisters,
                                          RegisterId nrOutputRegisters,
-                                         bool doCount, bool returnInheritedResults)
-    : ExecutorInfos(make_shared_unordered_set({inputRegister}),
-                    returnInheritedResults ? make_shared_unordered_set({})
-                                           : make_shared_unordered_set({0}),
+                                         bool doCount, bool returnInheritedResults,
+                                         RegisterId rowIdRegister)
+    : ExecutorInfos(rowIdRegister == ExecutionNode::MaxRegisterId
+                        ? make_shared_unordered_set({inputRegister})
+                        : make_shared_unordered_set({inputRegister, rowIdRegister}),
+                    returnInheritedResults
+                        ? make_shared_unordered_set({})
+                        : (rowIdRegister == ExecutionNode::MaxRegisterId
+                               ? make_shared_unordered_set({0})
+                               : make_shared_unordered_set({0, rowIdOutputRegisterId()})),
                     nrInputRegisters,
                     nrOutputRegisters, std::unordered_set<RegisterId>{} /*to clear*/,  // std::move(registersToClear) // use this once register planning is fixed
                     std::unordered_set<RegisterId>{} /*to keep*/
                     ),
       _inputRegisterId(inputRegister),
+      _rowIdRegisterId(rowIdRegister),
       _doCount(doCount),
-      _returnInheritedResults(returnInheritedResults) {}
+      _returnInheritedResults(returnInheritedResults) {
+  TRI_ASSERT(!_returnInheritedResults || _rowIdRegisterId == ExecutionNode::MaxRegisterId);
+}
 
 template <bool passBlocksThrough>
 ReturnExecutor<passBlocksThrough>::ReturnExecutor(Fetcher& fetcher, ReturnExecutorInfos& infos)
@@ -23,6 +23,7 @@
 #ifndef ARANGOD_AQL_RETURN_EXECUTOR_H
 #define ARANGOD_AQL_RETURN_EXECUTOR_H
 
+#include "Aql/ExecutionNode.h"
 #include "Aql/ExecutionState.h"
 #include "Aql/ExecutorInfos.h"
 #include "Aql/InputAqlItemRow.h"
@@ -45,7 +46,8 @@ class ReturnExecutorInfos : public ExecutorInfos {
  public:
   ReturnExecutorInfos(RegisterId inputRegister, RegisterId nrInputRegisters,
                       RegisterId nrOutputRegisters, bool doCount,
-                      bool returnInheritedResults);
+                      bool returnInheritedResults,
+                      RegisterId rowIdRegister = ExecutionNode::MaxRegisterId);
 
   ReturnExecutorInfos() = delete;
   ReturnExecutorInfos(ReturnExecutorInfos&&) = default;
@@ -64,9 +66,17 @@ class ReturnExecutorInfos : public ExecutorInfos {
 
   bool returnInheritedResults() const { return _returnInheritedResults; }
 
+  /// @brief the register with the input row number of a batched subquery,
+  /// MaxRegisterId if the subquery is not batched. it is returned in
+  /// register 1, next to the result
+  RegisterId getRowIdRegisterId() const { return _rowIdRegisterId; }
+
+  static constexpr RegisterId rowIdOutputRegisterId() { return 1; }
+
  private:
   /// @brief the variable produced by Return
   RegisterId _inputRegisterId;
+  RegisterId _rowIdRegisterId;
   bool _doCount;
   bool _returnInheritedResults;
 };
@@ -122,6 +132,13 @@ class ReturnExecutor {
         THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
       }
       output.moveValueInto(_infos.getOutputRegisterId(), inputRow, guard);
+      if (_infos.getRowIdRegisterId() != ExecutionNode::MaxRegisterId) {
+        // row ids are plain numbers, so there is nothing to clone
+        AqlValue rowId = inputRow.getValue(_infos.getRowIdRegisterId());
+        TRI_ASSERT(!rowId.requiresDestruction());
+        AqlValueGuard rowIdGuard(rowId, false);
+        output.moveValueInto(ReturnExecutorInfos::rowIdOutputRegisterId(), inputRow, rowIdGuard);
+      }
     }
 
     if (_infos.doCount()) {
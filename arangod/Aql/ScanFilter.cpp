@@ -0,0 +1,215 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ScanFilter.h"
+
+#include "Aql/Ast.h"
+#include "Aql/Function.h"
+#include "Aql/Variable.h"
+#include "Basics/StaticStrings.h"
+#include "Basics/VelocyPackHelper.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <algorithm>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+/// @brief the constant value of an operand, nullptr if it is not constant.
+/// the sortInValues rule wraps long IN lists into SORTED_UNIQUE(), which
+/// does not change which values are in the list
+AstNode const* constantValue(AstNode const* node) {
+  if (node->type == NODE_TYPE_FCALL &&
+      static_cast<Function const*>(node->getData())->name == "SORTED_UNIQUE") {
+    AstNode const* args = node->getMember(0);
+    if (args->numMembers() == 1 && args->getMemberUnchecked(0)->isConstant()) {
+      return args->getMemberUnchecked(0);
+    }
+    return nullptr;
+  }
+  return node->isConstant() ? node : nullptr;
+}
+}  // namespace
+
+ScanFilter::ScanFilter(AstNode const* condition, Variable const* variable,
+                       VPackOptions const* options)
+    : _options(options) {
+  bool const supported = collect(condition, variable, &_terms);
+  TRI_ASSERT(supported);
+  if (!supported) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                   "unsupported condition for collection scan");
+  }
+
+  // IN lists are looked up by binary search
+  for (auto& term : _terms) {
+    if (term.type != NODE_TYPE_OPERATOR_BINARY_IN && term.type != NODE_TYPE_OPERATOR_BINARY_NIN) {
+      continue;
+    }
+    std::vector<VPackSlice> values;
+    for (VPackSlice it : VPackArrayIterator(term.value.slice())) {
+      values.emplace_back(it);
+    }
+    auto less = [options](VPackSlice lhs, VPackSlice rhs) {
+      return basics::VelocyPackHelper::compare(lhs, rhs, true, options) < 0;
+    };
+    std::sort(values.begin(), values.end(), less);
+    VPackBuilder sorted;
+    sorted.openArray();
+    for (size_t i = 0; i < values.size(); ++i) {
+      if (i == 0 || less(values[i - 1], values[i])) {
+        sorted.add(values[i]);
+      }
+    }
+    sorted.close();
+    term.value = std::move(sorted);
+  }
+}
+
+bool ScanFilter::supports(AstNode const* condition, Variable const* variable) {
+  return collect(condition, variable, nullptr);
+}
+
+bool ScanFilter::collect(AstNode const* node, Variable const* variable,
+                         std::vector<Term>* terms) {
+  switch (node->type) {
+    case NODE_TYPE_OPERATOR_BINARY_AND:
+    case NODE_TYPE_OPERATOR_NARY_AND:
+      for (size_t i = 0; i < node->numMembers(); ++i) {
+        if (!collect(node->getMemberUnchecked(i), variable, terms)) {
+          return false;
+        }
+      }
+      return true;
+    case NODE_TYPE_OPERATOR_BINARY_EQ:
+    case NODE_TYPE_OPERATOR_BINARY_NE:
+    case NODE_TYPE_OPERATOR_BINARY_LT:
+    case NODE_TYPE_OPERATOR_BINARY_LE:
+    case NODE_TYPE_OPERATOR_BINARY_GT:
+    case NODE_TYPE_OPERATOR_BINARY_GE:
+    case NODE_TYPE_OPERATOR_BINARY_IN:
+    case NODE_TYPE_OPERATOR_BINARY_NIN:
+      break;
+    default:
+      return false;
+  }
+
+  bool const isIn =
+      node->type == NODE_TYPE_OPERATOR_BINARY_IN || node->type == NODE_TYPE_OPERATOR_BINARY_NIN;
+  // the attribute has to be left of IN
+  size_t const sides = isIn ? 1 : 2;
+  for (size_t i = 0; i < sides; ++i) {
+    AstNode const* value = ::constantValue(node->getMemberUnchecked(1 - i));
+    if (value == nullptr || (isIn && !value->isArray())) {
+      continue;
+    }
+    std::pair<Variable const*, std::vector<arangodb::basics::AttributeName>> access;
+    if (!node->getMemberUnchecked(i)->isAttributeAccessForVariable(access, false) ||
+        access.first->id != variable->id ||
+        // _id is not stored as a string
+        access.second[0].name == StaticStrings::IdString ||
+        std::any_of(access.second.begin(), access.second.end(),
+                    [](arangodb::basics::AttributeName const& it) {
+                      return it.shouldExpand;
+                    })) {
+      continue;
+    }
+
+    if (terms != nullptr) {
+      Term term;
+      for (auto const& it : access.second) {
+        term.attribute.emplace_back(it.name);
+      }
+      term.type = node->type;
+      if (i == 1 && term.type != NODE_TYPE_OPERATOR_BINARY_EQ &&
+          term.type != NODE_TYPE_OPERATOR_BINARY_NE) {
+        term.type = Ast::ReverseOperator(term.type);
+      }
+      value->toVelocyPackValue(term.value);
+      terms->emplace_back(std::move(term));
+    }
+    return true;
+  }
+  return false;
+}
+
+bool ScanFilter::matches(VPackSlice document) const {
+  for (auto const& term : _terms) {
+    if (!matches(term, document)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ScanFilter::matches(Term const& term, VPackSlice document) const {
+  VPackSlice value = document.get(term.attribute);
+  if (value.isNone()) {
+    value = VPackSlice::nullSlice();
+  }
+
+  switch (term.type) {
+    case NODE_TYPE_OPERATOR_BINARY_IN:
+    case NODE_TYPE_OPERATOR_BINARY_NIN: {
+      VPackSlice values = term.value.slice();
+      size_t low = 0;
+      size_t high = static_cast<size_t>(values.length());
+      bool found = false;
+      while (low < high) {
+        size_t const middle = low + (high - low) / 2;
+        int const cmp = basics::VelocyPackHelper::compare(values.at(middle), value, true, _options);
+        if (cmp == 0) {
+          found = true;
+          break;
+        }
+        if (cmp < 0) {
+          low = middle + 1;
+        } else {
+          high = middle;
+        }
+      }
+      return found == (term.type == NODE_TYPE_OPERATOR_BINARY_IN);
+    }
+    default:
+      break;
+  }
+
+  int const cmp = basics::VelocyPackHelper::compare(value, term.value.slice(), true, _options);
+  switch (term.type) {
+    case NODE_TYPE_OPERATOR_BINARY_EQ:
+      return cmp == 0;
+    case NODE_TYPE_OPERATOR_BINARY_NE:
+      return cmp != 0;
+    case NODE_TYPE_OPERATOR_BINARY_LT:
+      return cmp < 0;
+    case NODE_TYPE_OPERATOR_BINARY_LE:
+      return cmp <= 0;
+    case NODE_TYPE_OPERATOR_BINARY_GT:
+      return cmp > 0;
+    case NODE_TYPE_OPERATOR_BINARY_GE:
+      return cmp >= 0;
+    default:
+      TRI_ASSERT(false);
+      return false;
+  }
+}
@@ -0,0 +1,79 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_SCAN_FILTER_H
+#define ARANGOD_AQL_SCAN_FILTER_H 1
+
+#include "Aql/AstNode.h"
+#include "Basics/Common.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <vector>
+
+namespace arangodb {
+namespace velocypack {
+struct Options;
+}
+
+namespace aql {
+struct Variable;
+
+/// @brief a FILTER condition that is evaluated on the documents of a
+/// collection scan before they are written into a register, so documents
+/// that do not match are never copied. the condition must be a conjunction
+/// of comparisons (==, !=, <, <=, >, >=, IN, NOT IN) of attributes of the
+/// documents with constants. missing attributes are null, like in AQL
+class ScanFilter {
+ public:
+  ScanFilter(AstNode const* condition, Variable const* variable,
+             velocypack::Options const* options);
+
+  /// @brief whether the condition on the documents in the variable can be
+  /// evaluated by a ScanFilter
+  static bool supports(AstNode const* condition, Variable const* variable);
+
+  bool matches(velocypack::Slice document) const;
+
+ private:
+  struct Term {
+    std::vector<std::string> attribute;
+    /// @brief the comparison, with the attribute on the left side
+    AstNodeType type;
+    velocypack::Builder value;
+  };
+
+  /// @brief add the terms of a condition. returns false if it cannot be
+  /// evaluated by a ScanFilter
+  static bool collect(AstNode const* condition, Variable const* variable,
+                      std::vector<Term>* terms);
+
+  bool matches(Term const& term, velocypack::Slice document) const;
+
+ private:
+  std::vector<Term> _terms;
+  velocypack::Options const* _options;
+};
+
+}  // namespace aql
+}  // namespace arangodb
+
+#endif
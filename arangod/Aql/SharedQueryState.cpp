@@ -70,6 +70,8 @@ bool SharedQueryState::executeContinueCallback() const {
   }
   // do NOT use scheduler->post(), can have high latency that
   //  then backs up libcurl callbacks to other objects
-  scheduler->queue(RequestLane::CLIENT_AQL, _continueCallback);
+  // the continuation usually resumes the query that the current job has
+  //  been working on, so prefer the same thread
+  scheduler->queueLocal(RequestLane::CLIENT_AQL, _continueCallback);
   return true;
 }
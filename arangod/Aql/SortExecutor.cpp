@@ -28,31 +28,137 @@
 #include "Aql/ExecutionBlockImpl.h"
 #include "Aql/InputAqlItemRow.h"
 #include "Aql/OutputAqlItemRow.h"
+#include "Aql/ResourceUsage.h"
 #include "Aql/SortRegister.h"
+#include "Aql/SpillFile.h"
 #include "Aql/Stats.h"
+#include "Basics/ScopeGuard.h"
+#include "Basics/Utf8Helper.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
 
 #include <algorithm>
+#include <queue>
 
 using namespace arangodb;
 using namespace arangodb::aql;
 
 namespace {
 
+/// @brief compare two rows according to the sort registers
+bool rowLessThan(arangodb::transaction::Methods* trx, InputAqlItemRow const& left,
+                 InputAqlItemRow const& right, std::vector<SortRegister> const& sortRegisters) {
+  for (auto const& reg : sortRegisters) {
+    AqlValue const& lhs = left.getValue(reg.reg);
+    AqlValue const& rhs = right.getValue(reg.reg);
+
+    int const cmp = AqlValue::Compare(trx, lhs, rhs, true);
+
+    if (cmp < 0) {
+      return reg.asc;
+    } else if (cmp > 0) {
+      return !reg.asc;
+    }
+  }
+
+  return false;
+}
+
+/// @brief collation sort keys of the string values in the sort registers,
+/// computed once per row. comparing two sort keys bytewise gives the same
+/// result as collating the strings, which is much more expensive and would
+/// otherwise be done for every comparison of the sort. the memory of the
+/// keys is accounted to the query's ResourceMonitor while they exist
+class SortKeys {
+ public:
+  SortKeys(AqlItemMatrix const& input, std::vector<SortRegister> const& sortRegisters,
+           ResourceMonitor* resourceMonitor)
+      : _numRegisters(sortRegisters.size()),
+        _keys(input.size() * sortRegisters.size()),
+        _hasKey(input.size() * sortRegisters.size(), false),
+        _resourceMonitor(resourceMonitor),
+        _memoryUsage(0) {
+    TRI_ASSERT(_resourceMonitor != nullptr);
+    try {
+      increaseMemoryUsage(_keys.size() * sizeof(std::string));
+      auto const& helper = basics::Utf8Helper::DefaultUtf8Helper;
+      for (size_t i = 0; i < input.size(); ++i) {
+        InputAqlItemRow row = input.getRow(i);
+        for (size_t r = 0; r < _numRegisters; ++r) {
+          AqlValue const& value = row.getValue(sortRegisters[r].reg);
+          if (value.isString()) {
+            VPackValueLength length;
+            char const* p = value.slice().getString(length);
+            std::string& key = _keys[i * _numRegisters + r];
+            helper.sortKeyUtf8(p, static_cast<size_t>(length), key);
+            _hasKey[i * _numRegisters + r] = true;
+            increaseMemoryUsage(key.capacity());
+          }
+        }
+      }
+    } catch (...) {
+      // the destructor is not called
+      _resourceMonitor->decreaseMemoryUsage(_memoryUsage);
+      throw;
+    }
+  }
+
+  ~SortKeys() { _resourceMonitor->decreaseMemoryUsage(_memoryUsage); }
+
+  SortKeys(SortKeys const&) = delete;
+  SortKeys& operator=(SortKeys const&) = delete;
+
+  /// @brief the sort key of the value in the r-th sort register of the row,
+  /// nullptr if the value is not a string
+  std::string const* key(size_t row, size_t r) const {
+    size_t const position = row * _numRegisters + r;
+    return _hasKey[position] ? &_keys[position] : nullptr;
+  }
+
+ private:
+  void increaseMemoryUsage(size_t value) {
+    _resourceMonitor->increaseMemoryUsage(value);
+    _memoryUsage += value;
+  }
+
+  size_t const _numRegisters;
+  std::vector<std::string> _keys;
+  std::vector<bool> _hasKey;
+  ResourceMonitor* _resourceMonitor;
+  size_t _memoryUsage;
+};
+
 /// @brief OurLessThan
 class OurLessThan {
  public:
   OurLessThan(arangodb::transaction::Methods* trx, AqlItemMatrix const& input,
-              std::vector<SortRegister> const& sortRegisters) noexcept
-      : _trx(trx), _input(input), _sortRegisters(sortRegisters) {}
+              std::vector<SortRegister> const& sortRegisters, SortKeys const& sortKeys) noexcept
+      : _trx(trx), _input(input), _sortRegisters(sortRegisters), _sortKeys(sortKeys) {}
 
   bool operator()(size_t const& a, size_t const& b) const {
     InputAqlItemRow left = _input.getRow(a);
     InputAqlItemRow right = _input.getRow(b);
-    for (auto const& reg : _sortRegisters) {
-      AqlValue const& lhs = left.getValue(reg.reg);
-      AqlValue const& rhs = right.getValue(reg.reg);
 
-      int const cmp = AqlValue::Compare(_trx, lhs, rhs, true);
+    for (size_t r = 0; r < _sortRegisters.size(); ++r) {
+      auto const& reg = _sortRegisters[r];
+      std::string const* lhsKey = _sortKeys.key(a, r);
+      std::string const* rhsKey = _sortKeys.key(b, r);
+
+      int cmp;
+      if (lhsKey != nullptr && rhsKey != nullptr) {
+        cmp = lhsKey->compare(*rhsKey);
+        if (cmp == 0) {
+          // like VelocyPackHelper::compareStringValues, strings the collator
+          // considers equal are ordered by their byte length
+          VPackValueLength const nl = left.getValue(reg.reg).slice().getStringLength();
+          VPackValueLength const nr = right.getValue(reg.reg).slice().getStringLength();
+          cmp = (nl < nr) ? -1 : (nl > nr ? 1 : 0);
+        }
+      } else {
+        cmp = AqlValue::Compare(_trx, left.getValue(reg.reg),
+                                right.getValue(reg.reg), true);
+      }
 
       if (cmp < 0) {
         return reg.asc;
@@ -68,6 +174,7 @@ class OurLessThan {
   arangodb::transaction::Methods* _trx;
   AqlItemMatrix const& _input;
   std::vector<SortRegister> const& _sortRegisters;
+  SortKeys const& _sortKeys;
 };  // OurLessThan
 
 }  // namespace
@@ -88,7 +195,8 @@ SortExecutorInfos::SortExecutorInfos(
     // cppcheck-suppress passedByValue
     std::unordered_set<RegisterId> registersToClear,
     // cppcheck-suppress passedByValue
-    std::unordered_set<RegisterId> registersToKeep, transaction::Methods* trx, bool stable)
+    std::unordered_set<RegisterId> registersToKeep, transaction::Methods* trx, bool stable,
+    std::size_t spillMemoryThreshold)
     : ExecutorInfos(mapSortRegistersToRegisterIds(sortRegisters), nullptr,
                     nrInputRegisters, nrOutputRegisters,
                     std::move(registersToClear), std::move(registersToKeep)),
@@ -96,7 +204,8 @@ SortExecutorInfos::SortExecutorInfos(
       _manager(manager),
       _trx(trx),
       _sortRegisters(std::move(sortRegisters)),
-      _stable(stable) {
+      _stable(stable),
+      _spillMemoryThreshold(spillMemoryThreshold) {
   TRI_ASSERT(trx != nullptr);
   TRI_ASSERT(!_sortRegisters.empty());
 }
@@ -109,12 +218,276 @@ std::vector<SortRegister>& SortExecutorInfos::sortRegisters() {
 
 bool SortExecutorInfos::stable() const { return _stable; }
 
+std::size_t SortExecutorInfos::spillMemoryThreshold() const {
+  return _spillMemoryThreshold;
+}
+
+/// @brief state of an external merge sort. Input blocks are collected into
+/// the current run. Whenever the memory buffered in the current run exceeds
+/// the threshold, the current run is sorted and
+/// appended to the spill file in chunks of sorted blocks. Once all input is
+/// consumed, the spilled runs and the last (in-memory) run are merged.
+struct SortExecutor::ExternalSort {
+  /// @brief a sorted run, either in the spill file or in memory
+  struct Run {
+    // spilled runs: offset of the next chunk in the file, and the current
+    // chunk
+    uint64_t nextChunk = 0;
+    uint64_t endOfRun = 0;
+    SharedAqlItemBlockPtr chunk;
+    size_t chunkRow = 0;
+
+    // in-memory run
+    std::unique_ptr<AqlItemMatrix> matrix;
+    std::vector<size_t> sortedIndexes;
+    size_t next = 0;
+
+    InputAqlItemRow current() const {
+      if (matrix != nullptr) {
+        return matrix->getRow(sortedIndexes[next]);
+      }
+      return InputAqlItemRow{chunk, chunkRow};
+    }
+  };
+
+  /// @brief heap order on run indexes: the run with the smallest current row
+  /// ends up on top. ties are resolved by run index, so that the merge is
+  /// stable
+  struct HeapOrder {
+    ExternalSort const& sort;
+
+    bool operator()(size_t a, size_t b) const {
+      InputAqlItemRow left = sort._runs[a].current();
+      InputAqlItemRow right = sort._runs[b].current();
+      auto const& sortRegisters = sort._infos.sortRegisters();
+      if (rowLessThan(sort._infos.trx(), right, left, sortRegisters)) {
+        return true;
+      }
+      if (rowLessThan(sort._infos.trx(), left, right, sortRegisters)) {
+        return false;
+      }
+      return a > b;
+    }
+  };
+
+  explicit ExternalSort(SortExecutorInfos& infos)
+      : _infos(infos), _currentMemoryUsage(0), _consumed(false), _rowsLeft(0) {}
+
+  /// @brief fetch all input, spilling as necessary, and prepare the merge
+  ExecutionState consume(AllRowsFetcher& fetcher) {
+    while (!_consumed) {
+      ExecutionState state;
+      SharedAqlItemBlockPtr block;
+      std::tie(state, block) = fetcher.fetchBlockForSpilling();
+      if (state == ExecutionState::WAITING) {
+        return state;
+      }
+      if (block != nullptr) {
+        if (_current == nullptr) {
+          _current = std::make_unique<AqlItemMatrix>(_infos.numberOfInputRegisters());
+        }
+        _rowsLeft += block->size();
+        _currentMemoryUsage += memoryUsage(*block);
+        _current->addBlock(std::move(block));
+        if (_currentMemoryUsage > _infos.spillMemoryThreshold()) {
+          spillCurrentRun();
+        }
+      }
+      if (state == ExecutionState::DONE) {
+        startMerge();
+        _consumed = true;
+      }
+    }
+    return ExecutionState::DONE;
+  }
+
+  /// @brief whether all input has been fetched
+  bool consumed() const noexcept { return _consumed; }
+
+  size_t rowsLeft() const noexcept { return _rowsLeft; }
+
+  /// @brief write the next row in sort order. must only be called if
+  /// rowsLeft() > 0
+  void produceRow(OutputAqlItemRow& output) {
+    TRI_ASSERT(_consumed);
+    TRI_ASSERT(_rowsLeft > 0);
+    TRI_ASSERT(!_heap.empty());
+
+    std::pop_heap(_heap.begin(), _heap.end(), HeapOrder{*this});
+    size_t const index = _heap.back();
+    Run& run = _runs[index];
+    output.copyRow(run.current());
+    --_rowsLeft;
+
+    if (advance(run)) {
+      std::push_heap(_heap.begin(), _heap.end(), HeapOrder{*this});
+    } else {
+      _heap.pop_back();
+    }
+  }
+
+ private:
+  /// @brief memory used by the values of a block
+  static size_t memoryUsage(AqlItemBlock const& block) {
+    size_t usage = sizeof(AqlValue) * block.size() * block.getNrRegs();
+    for (size_t row = 0; row < block.size(); ++row) {
+      for (RegisterId reg = 0; reg < block.getNrRegs(); ++reg) {
+        usage += block.getValueReference(row, reg).memoryUsage();
+      }
+    }
+    return usage;
+  }
+
+  /// @brief sort the rows of the current run
+  std::vector<size_t> sortCurrentRun() const {
+    TRI_ASSERT(_current != nullptr);
+    std::vector<size_t> indexes;
+    indexes.reserve(_current->size());
+    for (size_t i = 0; i < _current->size(); ++i) {
+      indexes.emplace_back(i);
+    }
+    SortKeys sortKeys(*_current, _infos.sortRegisters(),
+                      _infos._manager.resourceMonitor());
+    OurLessThan ourLessThan(_infos.trx(), *_current, _infos.sortRegisters(), sortKeys);
+    if (_infos.stable()) {
+      std::stable_sort(indexes.begin(), indexes.end(), ourLessThan);
+    } else {
+      std::sort(indexes.begin(), indexes.end(), ourLessThan);
+    }
+    return indexes;
+  }
+
+  void spillCurrentRun() {
+    TRI_ASSERT(_current != nullptr);
+    std::vector<size_t> indexes = sortCurrentRun();
+
+    if (_file == nullptr) {
+      _file = std::make_unique<SpillFile>();
+    }
+
+    Run run;
+    run.nextChunk = _file->size();
+
+    RegisterId const nrRegs = _infos.numberOfInputRegisters();
+    VPackBuilder builder;
+    for (size_t from = 0; from < indexes.size(); from += ExecutionBlock::DefaultBatchSize()) {
+      size_t const n = (std::min)(indexes.size() - from, ExecutionBlock::DefaultBatchSize());
+      SharedAqlItemBlockPtr chunk = _infos._manager.requestBlock(n, nrRegs);
+      {
+        // the values are still owned by the run's blocks, only reference
+        // them in the chunk while serializing
+        TRI_DEFER(chunk->eraseAll());
+        for (size_t i = 0; i < n; ++i) {
+          InputAqlItemRow row = _current->getRow(indexes[from + i]);
+          for (RegisterId reg = 0; reg < nrRegs; ++reg) {
+            AqlValue const& value = row.getValue(reg);
+            if (!value.isEmpty()) {
+              chunk->setValue(i, reg, value);
+            }
+          }
+        }
+        builder.clear();
+        chunk->toVelocyPack(_infos.trx(), builder);
+      }
+      _file->append(builder.slice());
+    }
+
+    run.endOfRun = _file->size();
+    _runs.emplace_back(std::move(run));
+    // release the memory of the run
+    _current.reset();
+    _currentMemoryUsage = 0;
+  }
+
+  void startMerge() {
+    if (_current != nullptr) {
+      // the last run is merged directly from memory
+      Run run;
+      run.sortedIndexes = sortCurrentRun();
+      run.matrix = std::move(_current);
+      _runs.emplace_back(std::move(run));
+    }
+
+    for (size_t i = 0; i < _runs.size(); ++i) {
+      Run& run = _runs[i];
+      if (run.matrix == nullptr) {
+        // load the first chunk
+        run.chunkRow = 0;
+        if (!loadChunk(run)) {
+          continue;
+        }
+      } else if (run.sortedIndexes.empty()) {
+        continue;
+      }
+      _heap.emplace_back(i);
+    }
+    std::make_heap(_heap.begin(), _heap.end(), HeapOrder{*this});
+  }
+
+  bool loadChunk(Run& run) {
+    if (run.nextChunk >= run.endOfRun) {
+      run.chunk = nullptr;
+      return false;
+    }
+    VPackSlice slice = _file->read(run.nextChunk);
+    TRI_ASSERT(!slice.isNone());
+    run.chunk = _infos._manager.requestAndInitBlock(slice);
+    run.chunkRow = 0;
+    return true;
+  }
+
+  /// @brief move the run to its next row. returns false if the run is exhausted
+  bool advance(Run& run) {
+    if (run.matrix != nullptr) {
+      return ++run.next < run.sortedIndexes.size();
+    }
+    if (++run.chunkRow < run.chunk->size()) {
+      return true;
+    }
+    return loadChunk(run);
+  }
+
+ private:
+  SortExecutorInfos& _infos;
+
+  std::unique_ptr<SpillFile> _file;
+  std::unique_ptr<AqlItemMatrix> _current;
+  // memory used by the blocks of the current run
+  size_t _currentMemoryUsage;
+  std::vector<Run> _runs;
+  // max-heap of indexes into _runs, according to HeapOrder{*this}
+  std::vector<size_t> _heap;
+
+  bool _consumed;
+  size_t _rowsLeft;
+};
+
 SortExecutor::SortExecutor(Fetcher& fetcher, SortExecutorInfos& infos)
-    : _infos(infos), _fetcher(fetcher), _input(nullptr), _returnNext(0){};
+    : _infos(infos), _fetcher(fetcher), _input(nullptr), _returnNext(0) {
+  if (_infos.spillMemoryThreshold() > 0) {
+    _external = std::make_unique<ExternalSort>(_infos);
+  }
+}
+
 SortExecutor::~SortExecutor() = default;
 
 std::pair<ExecutionState, NoStats> SortExecutor::produceRows(OutputAqlItemRow& output) {
   ExecutionState state;
+  if (_external != nullptr) {
+    state = _external->consume(_fetcher);
+    if (state == ExecutionState::WAITING) {
+      return {state, NoStats{}};
+    }
+    if (_external->rowsLeft() == 0) {
+      return {ExecutionState::DONE, NoStats{}};
+    }
+    _external->produceRow(output);
+    if (_external->rowsLeft() == 0) {
+      return {ExecutionState::DONE, NoStats{}};
+    }
+    return {ExecutionState::HASMORE, NoStats{}};
+  }
+
   if (_input == nullptr) {
     // We need to get data
     std::tie(state, _input) = _fetcher.fetchAllRows();
@@ -161,7 +534,8 @@ void SortExecutor::doSorting() {
     _sortedIndexes.emplace_back(i);
   }
   // comparison function
-  OurLessThan ourLessThan(_infos.trx(), *_input, _infos.sortRegisters());
+  SortKeys sortKeys(*_input, _infos.sortRegisters(), _infos._manager.resourceMonitor());
+  OurLessThan ourLessThan(_infos.trx(), *_input, _infos.sortRegisters(), sortKeys);
   if (_infos.stable()) {
     std::stable_sort(_sortedIndexes.begin(), _sortedIndexes.end(), ourLessThan);
   } else {
@@ -170,6 +544,15 @@ void SortExecutor::doSorting() {
 }
 
 std::pair<ExecutionState, size_t> SortExecutor::expectedNumberOfRows(size_t atMost) const {
+  if (_external != nullptr) {
+    // We cannot prefetch via the fetcher, as it would keep all rows in memory.
+    // Until produceRows() has consumed the input, atMost is the only bound
+    if (!_external->consumed()) {
+      return {ExecutionState::HASMORE, atMost};
+    }
+    size_t rowsLeft = _external->rowsLeft();
+    return {rowsLeft > 0 ? ExecutionState::HASMORE : ExecutionState::DONE, rowsLeft};
+  }
   if (_input == nullptr) {
     // This executor does not know anything yet.
     // Just take whatever is presented from upstream.
@@ -53,7 +53,8 @@ class SortExecutorInfos : public ExecutorInfos {
                     AqlItemBlockManager& manager, RegisterId nrInputRegisters,
                     RegisterId nrOutputRegisters, std::unordered_set<RegisterId> registersToClear,
                     std::unordered_set<RegisterId> registersToKeep,
-                    transaction::Methods* trx, bool stable);
+                    transaction::Methods* trx, bool stable,
+                    std::size_t spillMemoryThreshold);
 
   SortExecutorInfos() = delete;
   SortExecutorInfos(SortExecutorInfos&&) = default;
@@ -66,6 +67,10 @@ class SortExecutorInfos : public ExecutorInfos {
 
   bool stable() const;
 
+  /// @brief memory budget after which sorted runs are spilled to disk.
+  /// 0 means the executor sorts in memory only
+  std::size_t spillMemoryThreshold() const;
+
   std::size_t _limit;
   AqlItemBlockManager& _manager;
 
@@ -73,10 +78,17 @@ class SortExecutorInfos : public ExecutorInfos {
   arangodb::transaction::Methods* _trx;
   std::vector<SortRegister> _sortRegisters;
   bool _stable;
+  std::size_t _spillMemoryThreshold;
 };
 
 /**
  * @brief Implementation of Sort Node
+ *
+ * If the infos specify a spillMemoryThreshold, the executor does an
+ * external merge sort: input blocks are collected into a run until the
+ * threshold is exceeded, the run is then sorted and written to a temporary
+ * file. Once the input is consumed, all runs are merged while producing
+ * the output, so only one block per run needs to be held in memory.
  */
 class SortExecutor {
  public:
@@ -105,6 +117,8 @@ class SortExecutor {
  private:
   void doSorting();
 
+  struct ExternalSort;
+
  private:
   Infos& _infos;
 
@@ -115,6 +129,9 @@ class SortExecutor {
   std::vector<size_t> _sortedIndexes;
 
   size_t _returnNext;
+
+  // only set if the infos request spilling to disk
+  std::unique_ptr<ExternalSort> _external;
 };
 }  // namespace aql
 }  // namespace arangodb
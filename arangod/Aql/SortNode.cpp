@@ -236,7 +236,8 @@ std::unique_ptr<ExecutionBlock> SortNode::createBlock(
   SortExecutorInfos infos(std::move(sortRegs), _limit, engine.itemBlockManager(),
                           getRegisterPlan()->nrRegs[previousNode->getDepth()],
                           getRegisterPlan()->nrRegs[getDepth()], getRegsToClear(),
-                          calcRegsToKeep(), engine.getQuery()->trx(), _stable);
+                          calcRegsToKeep(), engine.getQuery()->trx(), _stable,
+                          engine.getQuery()->queryOptions().spillMemoryThreshold);
   if (sorterType() == SorterType::Standard){
     return std::make_unique<ExecutionBlockImpl<SortExecutor>>(&engine, this, std::move(infos));
   } else {
@@ -208,7 +208,7 @@ SortingGatherExecutor::~SortingGatherExecutor() = default;
 ///
 ///        What this block does:
 ///        InitPhase:
-///          Fetch 1 Block for every dependency.
+///          Fetch 1 Block for every dependency, all of them in parallel.
 ///        ExecPhase:
 ///          Fetch row of scheduled block.
 ///          Pick the next (sorted) element (by strategy)
@@ -305,19 +305,29 @@ ExecutionState SortingGatherExecutor::init() {
     }
   }
 
-  while (_dependencyToFetch < _numberDependencies) {
-    std::tie(_inputRows[_dependencyToFetch].state,
-             _inputRows[_dependencyToFetch].row) =
-        _fetcher.fetchRowForDependency(_dependencyToFetch);
-    if (_inputRows[_dependencyToFetch].state == ExecutionState::WAITING) {
-      return ExecutionState::WAITING;
+  // ask all dependencies before waiting for any of them, so the requests
+  // to the shards are in flight at the same time
+  bool waiting = false;
+  for (size_t i = 0; i < _numberDependencies; ++i) {
+    auto& inputRow = _inputRows[i];
+    if (inputRow.row || inputRow.state == ExecutionState::DONE) {
+      // already fetched
+      continue;
     }
-    if (!_inputRows[_dependencyToFetch].row) {
-      TRI_ASSERT(_inputRows[_dependencyToFetch].state == ExecutionState::DONE);
-      adjustNrDone(_dependencyToFetch);
+    std::tie(inputRow.state, inputRow.row) = _fetcher.fetchRowForDependency(i);
+    if (inputRow.state == ExecutionState::WAITING) {
+      waiting = true;
+      continue;
     }
-    ++_dependencyToFetch;
+    if (!inputRow.row) {
+      TRI_ASSERT(inputRow.state == ExecutionState::DONE);
+      adjustNrDone(i);
+    }
+  }
+  if (waiting) {
+    return ExecutionState::WAITING;
   }
+  _dependencyToFetch = _numberDependencies;
   _initialized = true;
   if (_nrDone >= _numberDependencies) {
     return ExecutionState::DONE;
@@ -0,0 +1,146 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "SpillFile.h"
+
+#include "Basics/Exceptions.h"
+#include "Basics/files.h"
+#include "Logger/Logger.h"
+
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+/// @brief pending writes are flushed once the buffer exceeds this size
+constexpr size_t writeBufferSize = 4 * 1024 * 1024;
+
+/// @brief minimum number of bytes read from the file at once
+constexpr size_t readBufferSize = 1024 * 1024;
+
+typedef uint64_t LengthType;
+}  // namespace
+
+SpillFile::SpillFile() : _fd(-1), _flushed(0), _readOffset(0), _size(0) {
+  long systemError;
+  std::string errorMessage;
+  int res = TRI_GetTempName("aql-spill", _filename, false, systemError, errorMessage);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(res, "cannot create spill file: " + errorMessage);
+  }
+
+  _fd = TRI_CREATE(_filename.c_str(), O_CREAT | O_EXCL | O_RDWR | TRI_O_CLOEXEC,
+                   S_IRUSR | S_IWUSR);
+
+  if (_fd < 0) {
+    TRI_SYSTEM_ERROR();
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CANNOT_CREATE_TEMP_FILE,
+                                   "cannot create spill file '" + _filename +
+                                       "': " + TRI_GET_ERRORBUF);
+  }
+}
+
+SpillFile::~SpillFile() {
+  if (_fd >= 0) {
+    TRI_CLOSE(_fd);
+  }
+  if (TRI_UnlinkFile(_filename.c_str()) != TRI_ERROR_NO_ERROR) {
+    LOG_TOPIC("3f1a7", WARN, Logger::AQL)
+        << "unable to remove spill file '" << _filename << "'";
+  }
+}
+
+uint64_t SpillFile::append(VPackSlice slice) {
+  LengthType const length = slice.byteSize();
+  uint64_t const offset = _size;
+
+  _writeBuffer.append(reinterpret_cast<char const*>(&length), sizeof(length));
+  _writeBuffer.append(slice.startAs<char>(), static_cast<size_t>(length));
+  _size += sizeof(length) + length;
+
+  if (_writeBuffer.size() >= ::writeBufferSize) {
+    flush();
+  }
+  return offset;
+}
+
+VPackSlice SpillFile::read(uint64_t& offset) {
+  TRI_ASSERT(offset <= _size);
+  if (offset + sizeof(LengthType) > _size) {
+    return VPackSlice::noneSlice();
+  }
+
+  flush();
+
+  fillReadBuffer(offset, sizeof(LengthType));
+  LengthType length;
+  memcpy(&length, _readBuffer.data() + (offset - _readOffset), sizeof(length));
+
+  if (offset + sizeof(LengthType) + length > _size) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CANNOT_READ_FILE,
+                                   "invalid value in spill file '" + _filename + "'");
+  }
+
+  fillReadBuffer(offset, sizeof(LengthType) + static_cast<size_t>(length));
+  VPackSlice result(reinterpret_cast<uint8_t const*>(
+      _readBuffer.data() + (offset - _readOffset) + sizeof(LengthType)));
+  TRI_ASSERT(result.byteSize() == length);
+
+  offset += sizeof(LengthType) + length;
+  return result;
+}
+
+void SpillFile::flush() {
+  if (_writeBuffer.empty()) {
+    return;
+  }
+
+  if (TRI_LSEEK(_fd, static_cast<off_t>(_flushed), SEEK_SET) < 0 ||
+      !TRI_WritePointer(_fd, _writeBuffer.data(), _writeBuffer.size())) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CANNOT_WRITE_FILE,
+                                   "cannot write to spill file '" + _filename + "'");
+  }
+  _flushed += _writeBuffer.size();
+  _writeBuffer.clear();
+}
+
+void SpillFile::fillReadBuffer(uint64_t offset, size_t n) {
+  TRI_ASSERT(_writeBuffer.empty());
+  TRI_ASSERT(offset + n <= _flushed);
+
+  if (offset >= _readOffset && offset + n <= _readOffset + _readBuffer.size()) {
+    // already buffered
+    return;
+  }
+
+  size_t const toRead = static_cast<size_t>(
+      std::min<uint64_t>(_flushed - offset, std::max(n, ::readBufferSize)));
+  _readBuffer.resize(toRead);
+  _readOffset = offset;
+
+  if (TRI_LSEEK(_fd, static_cast<off_t>(offset), SEEK_SET) < 0 ||
+      !TRI_ReadPointer(_fd, &_readBuffer[0], toRead)) {
+    _readBuffer.clear();
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CANNOT_READ_FILE,
+                                   "cannot read from spill file '" + _filename + "'");
+  }
+}
@@ -0,0 +1,82 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_SPILL_FILE_H
+#define ARANGOD_AQL_SPILL_FILE_H 1
+
+#include "Basics/Common.h"
+
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+namespace aql {
+
+/// @brief a temporary file executors can spill intermediate results to, when
+/// they would otherwise exceed their memory budget.
+/// VelocyPack values are appended to the file and can be read back by the
+/// offset append() returned, as often as needed and in any order. Writes and
+/// reads are buffered. The file is created in the server's temporary
+/// directory and removed again when the object is destroyed.
+/// All methods throw on I/O errors.
+class SpillFile {
+ public:
+  SpillFile();
+  ~SpillFile();
+
+  SpillFile(SpillFile const&) = delete;
+  SpillFile& operator=(SpillFile const&) = delete;
+
+  /// @brief append a value to the end of the file. returns the offset the
+  /// value can be read from
+  uint64_t append(arangodb::velocypack::Slice slice);
+
+  /// @brief read the value at offset, and advance offset to the value
+  /// appended after it. returns a none slice if offset is at the end of the
+  /// file. the slice is only valid until the next call to read()
+  arangodb::velocypack::Slice read(uint64_t& offset);
+
+  /// @brief number of bytes appended
+  uint64_t size() const noexcept { return _size; }
+
+ private:
+  void flush();
+
+  /// @brief make sure the n bytes starting at offset are in the read buffer
+  void fillReadBuffer(uint64_t offset, size_t n);
+
+ private:
+  std::string _filename;
+  int _fd;
+
+  std::string _writeBuffer;
+  // number of bytes already written to the file
+  uint64_t _flushed;
+
+  std::string _readBuffer;
+  // file offset of the first byte in the read buffer
+  uint64_t _readOffset;
+
+  uint64_t _size;
+};
+
+}  // namespace aql
+}  // namespace arangodb
+
+#endif
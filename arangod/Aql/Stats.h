@@ -84,19 +84,26 @@ inline ExecutionStats& operator+=(ExecutionStats& executionStats,
 
 class EnumerateCollectionStats {
  public:
-  EnumerateCollectionStats() noexcept : _scannedFull(0) {}
+  EnumerateCollectionStats() noexcept : _scannedFull(0), _filtered(0) {}
 
   void incrScanned(size_t const scanned) noexcept { _scannedFull += scanned; }
 
   std::size_t getScanned() const noexcept { return _scannedFull; }
 
+  /// @brief documents that did not match the filter of the scan
+  void incrFiltered(size_t const filtered) noexcept { _filtered += filtered; }
+
+  std::size_t getFiltered() const noexcept { return _filtered; }
+
  private:
   std::size_t _scannedFull;
+  std::size_t _filtered;
 };
 
 inline ExecutionStats& operator+=(ExecutionStats& executionStats,
                                   EnumerateCollectionStats const& enumerateCollectionStats) noexcept {
   executionStats.scannedFull += enumerateCollectionStats.getScanned();
+  executionStats.filtered += enumerateCollectionStats.getFiltered();
   return executionStats;
 }
 
@@ -23,7 +23,9 @@
 #include "ExecutionBlock.h"
 #include "SubqueryExecutor.h"
 
+#include "Aql/AqlItemBlock.h"
 #include "Aql/OutputAqlItemRow.h"
+#include "Aql/ReturnExecutor.h"
 #include "Aql/SingleRowFetcher.h"
 
 using namespace arangodb;
@@ -35,11 +37,12 @@ SubqueryExecutorInfos::SubqueryExecutorInfos(
     RegisterId nrInputRegisters, RegisterId nrOutputRegisters,
     std::unordered_set<RegisterId> const& registersToClear,
     std::unordered_set<RegisterId>&& registersToKeep, ExecutionBlock& subQuery,
-    RegisterId outReg, bool subqueryIsConst)
+    RegisterId outReg, bool subqueryIsConst, RegisterId rowIdReg)
     : ExecutorInfos(readableInputRegisters, writeableOutputRegisters, nrInputRegisters,
                     nrOutputRegisters, registersToClear, std::move(registersToKeep)),
       _subQuery(subQuery),
       _outReg(outReg),
+      _rowIdReg(rowIdReg),
       _returnsData(subQuery.getPlanNode()->getType() == ExecutionNode::RETURN),
       _isConst(subqueryIsConst) {}
 
@@ -57,7 +60,13 @@ SubqueryExecutor<isModificationSubquery>::SubqueryExecutor(Fetcher& fetcher, Sub
       _shutdownResult(TRI_ERROR_INTERNAL),
       _subquery(infos.getSubquery()),
       _subqueryResults(nullptr),
-      _input(CreateInvalidInputRowHint{}) {}
+      _input(CreateInvalidInputRowHint{}),
+      _batchInitialized(false),
+      _batchDone(false),
+      _batchPosition(0) {
+  // there is no point in running a const subquery in batches
+  TRI_ASSERT(!_infos.isBatched() || (!_infos.isConst() && !isModificationSubquery));
+}
 
 template<bool isModificationSubquery>
 SubqueryExecutor<isModificationSubquery>::~SubqueryExecutor() = default;
@@ -71,6 +80,9 @@ SubqueryExecutor<isModificationSubquery>::~SubqueryExecutor() = default;
 
 template<bool isModificationSubquery>
 std::pair<ExecutionState, NoStats> SubqueryExecutor<isModificationSubquery>::produceRows(OutputAqlItemRow& output) {
+  if (_infos.isBatched()) {
+    return produceRowsBatched(output);
+  }
   if (_state == ExecutionState::DONE && !_input.isInitialized()) {
     // We have seen DONE upstream, and we have discarded our local reference
     // to the last input, we will not be able to produce results anymore.
@@ -175,6 +187,147 @@ void SubqueryExecutor<isModificationSubquery>::writeOutput(OutputAqlItemRow& out
   TRI_ASSERT(output.produced());
 }
 
+template<bool isModificationSubquery>
+std::pair<ExecutionState, NoStats> SubqueryExecutor<isModificationSubquery>::produceRowsBatched(
+    OutputAqlItemRow& output) {
+  while (true) {
+    if (_batchDone) {
+      // write the results in the order of the input rows
+      TRI_ASSERT(_batchPosition < _batch.size());
+      TRI_IF_FAILURE("SubqueryBlock::getSome") {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+      }
+      auto& results = _batchResults[_batchPosition];
+      TRI_ASSERT(results != nullptr);
+      AqlValue resultDocVec{results.get()};
+      AqlValueGuard guard{resultDocVec, true};
+      // Responsibility is handed over
+      results.release();
+      output.moveValueInto(_infos.outputRegister(), _batch[_batchPosition], guard);
+      TRI_ASSERT(output.produced());
+      ++_batchPosition;
+
+      if (_batchPosition < _batch.size()) {
+        return {ExecutionState::HASMORE, NoStats{}};
+      }
+      resetBatch();
+      return {_state, NoStats{}};
+    }
+
+    if (_batchInitialized) {
+      auto res = _subquery.getSome(ExecutionBlock::DefaultBatchSize());
+      if (res.first == ExecutionState::WAITING) {
+        TRI_ASSERT(res.second == nullptr);
+        return {res.first, NoStats{}};
+      }
+      if (res.second != nullptr) {
+        TRI_IF_FAILURE("SubqueryBlock::executeSubquery") {
+          THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+        }
+        if (_infos.returnsData()) {
+          addBatchResults(std::move(res.second));
+        }
+      }
+      if (res.first == ExecutionState::DONE) {
+        _batchDone = true;
+      }
+      continue;
+    }
+
+    if (_batchBlock == nullptr) {
+      // collect all remaining rows of the current input block. the output
+      // block is the input block, so we must not read beyond its end
+      while (_state != ExecutionState::DONE &&
+             (_batch.empty() || !_batch.back().isLastRowInBlock())) {
+        InputAqlItemRow row{CreateInvalidInputRowHint{}};
+        std::tie(_state, row) = _fetcher.fetchRow();
+        if (_state == ExecutionState::WAITING) {
+          TRI_ASSERT(!row);
+          return {_state, NoStats{}};
+        }
+        if (!row) {
+          TRI_ASSERT(_state == ExecutionState::DONE);
+          break;
+        }
+        _batch.emplace_back(std::move(row));
+      }
+
+      if (_batch.empty()) {
+        TRI_ASSERT(_state == ExecutionState::DONE);
+        // We are done!
+        return {_state, NoStats{}};
+      }
+
+      AqlItemBlock const& block = _batch.front().getBlock();
+      size_t const from = _batch.front().getRowIndex();
+      TRI_ASSERT(_batch.back().getRowIndex() + 1 - from == _batch.size());
+      _batchBlock = block.slice(from, from + _batch.size());
+      RegisterId const rowIdReg = _infos.rowIdRegister();
+      for (size_t i = 0; i < _batch.size(); ++i) {
+        TRI_ASSERT(_batchBlock->getValueReference(i, rowIdReg).isEmpty());
+        _batchBlock->emplaceValue(i, rowIdReg, AqlValueHintUInt(static_cast<uint64_t>(i)));
+      }
+    }
+
+    auto initRes = _subquery.initializeCursorWithBatch(_batchBlock);
+    if (initRes.first == ExecutionState::WAITING) {
+      return {ExecutionState::WAITING, NoStats{}};
+    }
+    if (initRes.second.fail()) {
+      // Error during initialize cursor
+      THROW_ARANGO_EXCEPTION(initRes.second);
+    }
+    _batchResults.clear();
+    _batchResults.reserve(_batch.size());
+    for (size_t i = 0; i < _batch.size(); ++i) {
+      _batchResults.emplace_back(std::make_unique<std::vector<SharedAqlItemBlockPtr>>());
+    }
+    // the subquery has made its own copy
+    _batchBlock = nullptr;
+    _batchInitialized = true;
+  }
+}
+
+template<bool isModificationSubquery>
+void SubqueryExecutor<isModificationSubquery>::addBatchResults(SharedAqlItemBlockPtr&& block) {
+  TRI_ASSERT(block != nullptr);
+  RegisterId const rowIdReg = ReturnExecutorInfos::rowIdOutputRegisterId();
+  TRI_ASSERT(block->getNrRegs() > rowIdReg);
+
+  auto rowIdAt = [&block, rowIdReg](size_t row) -> size_t {
+    return static_cast<size_t>(block->getValueReference(row, rowIdReg).toInt64());
+  };
+
+  size_t const n = block->size();
+  size_t from = 0;
+  while (from < n) {
+    // results of the same input row are adjacent
+    size_t const rowId = rowIdAt(from);
+    size_t to = from + 1;
+    while (to < n && rowIdAt(to) == rowId) {
+      ++to;
+    }
+    TRI_ASSERT(rowId < _batchResults.size());
+    if (from == 0 && to == n) {
+      // the whole block belongs to a single input row
+      _batchResults[rowId]->emplace_back(std::move(block));
+      return;
+    }
+    _batchResults[rowId]->emplace_back(block->slice(from, to));
+    from = to;
+  }
+}
+
+template<bool isModificationSubquery>
+void SubqueryExecutor<isModificationSubquery>::resetBatch() {
+  _batch.clear();
+  _batchBlock = nullptr;
+  _batchResults.clear();
+  _batchInitialized = false;
+  _batchDone = false;
+  _batchPosition = 0;
+}
+
 /// @brief shutdown, tell dependency and the subquery
 template<bool isModificationSubquery>
 std::pair<ExecutionState, Result> SubqueryExecutor<isModificationSubquery>::shutdown(int errorCode) {
@@ -23,11 +23,15 @@
 #ifndef ARANGOD_AQL_SUBQUERY_EXECUTOR_H
 #define ARANGOD_AQL_SUBQUERY_EXECUTOR_H
 
+#include "Aql/ExecutionNode.h"
 #include "Aql/ExecutionState.h"
 #include "Aql/ExecutorInfos.h"
 #include "Aql/InputAqlItemRow.h"
+#include "Aql/SharedAqlItemBlockPtr.h"
 #include "Aql/Stats.h"
 
+#include <vector>
+
 namespace arangodb {
 namespace aql {
 
@@ -43,7 +47,8 @@ class SubqueryExecutorInfos : public ExecutorInfos {
                         RegisterId nrInputRegisters, RegisterId nrOutputRegisters,
                         std::unordered_set<RegisterId> const& registersToClear,
                         std::unordered_set<RegisterId>&& registersToKeep,
-                        ExecutionBlock& subQuery, RegisterId outReg, bool subqueryIsConst);
+                        ExecutionBlock& subQuery, RegisterId outReg, bool subqueryIsConst,
+                        RegisterId rowIdReg = ExecutionNode::MaxRegisterId);
 
   SubqueryExecutorInfos() = delete;
   SubqueryExecutorInfos(SubqueryExecutorInfos&&);
@@ -54,10 +59,15 @@ class SubqueryExecutorInfos : public ExecutorInfos {
   inline bool returnsData() const { return _returnsData; }
   inline RegisterId outputRegister() const { return _outReg; }
   inline bool isConst() const { return _isConst; }
+  /// @brief register for the input row number in a batch, MaxRegisterId if
+  /// the subquery is executed once per input row
+  inline RegisterId rowIdRegister() const { return _rowIdReg; }
+  inline bool isBatched() const { return _rowIdReg != ExecutionNode::MaxRegisterId; }
 
  private:
   ExecutionBlock& _subQuery;
   RegisterId const _outReg;
+  RegisterId const _rowIdReg;
   bool const _returnsData;
   bool const _isConst;
 };
@@ -108,6 +118,21 @@ class SubqueryExecutor {
    */
   void writeOutput(OutputAqlItemRow& output);
 
+  /**
+   * Batched mode: all remaining input rows of a block are passed into the
+   * subquery at once, each with its row number in the batch. The subquery
+   * only consists of nodes that produce their output for every input row
+   * independently, and returns the row number with every result. So the
+   * results can be assigned to their input rows afterwards.
+   */
+  std::pair<ExecutionState, NoStats> produceRowsBatched(OutputAqlItemRow& output);
+
+  /// @brief assign the rows of a result block to the input rows of the batch
+  void addBatchResults(SharedAqlItemBlockPtr&& block);
+
+  /// @brief forget the current batch
+  void resetBatch();
+
  private:
   Fetcher& _fetcher;
   SubqueryExecutorInfos& _infos;
@@ -132,6 +157,20 @@ class SubqueryExecutor {
 
   // Cache for the input row we are currently working on
   InputAqlItemRow _input;
+
+  // Batched mode: the input rows of the current batch, the block passed
+  // into the subquery, and the results for every input row
+  std::vector<InputAqlItemRow> _batch;
+  SharedAqlItemBlockPtr _batchBlock;
+  std::vector<std::unique_ptr<std::vector<SharedAqlItemBlockPtr>>> _batchResults;
+
+  // Batched mode: whether the subquery was initialized with the batch, and
+  // whether it has returned all results for it
+  bool _batchInitialized;
+  bool _batchDone;
+
+  // Batched mode: the next input row to write the result for
+  size_t _batchPosition;
 };
 }  // namespace aql
 }  // namespace arangodb
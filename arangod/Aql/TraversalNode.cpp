@@ -31,6 +31,7 @@
 #include "Aql/ExecutionBlockImpl.h"
 #include "Aql/ExecutionEngine.h"
 #include "Aql/ExecutionPlan.h"
+#include "Aql/PruneExpressionEvaluator.h"
 #include "Aql/Query.h"
 #include "Aql/SortCondition.h"
 #include "Aql/TraversalExecutor.h"
@@ -500,6 +501,14 @@ std::unique_ptr<ExecutionBlock> TraversalNode::createBlock(
     traverser.reset(new arangodb::traverser::SingleServerTraverser(opts, trx));
   }
 
+  // only the vertices are produced, which needs no paths
+  if (!usesEdgeOutVariable() && !usesPathOutVariable() && opts->useBreadthFirst &&
+      opts->uniqueVertices == TraverserOptions::UniquenessLevel::GLOBAL &&
+      (!opts->usesPrune() || (!opts->getPruneEvaluator()->needsEdge() &&
+                              !opts->getPruneEvaluator()->needsPath()))) {
+    traverser->allowOptimizedNeighbors();
+  }
+
   // Optimized condition
   std::vector<std::pair<Variable const*, RegisterId>> filterConditionVariables;
   filterConditionVariables.reserve(_conditionVariables.size());
@@ -618,6 +627,8 @@ void TraversalNode::prepareOptions() {
   }
 
   Ast* ast = _plan->getAst();
+  auto opts = static_cast<TraverserOptions*>(options());
+  TRI_ASSERT(opts != nullptr);
 
   // Compute Edge Indexes. First default indexes:
   for (size_t i = 0; i < numEdgeColls; ++i) {
@@ -626,12 +637,14 @@ void TraversalNode::prepareOptions() {
       case TRI_EDGE_IN:
         _options->addLookupInfo(
             _plan, _edgeColls[i]->name(), StaticStrings::ToString,
-            globalEdgeConditionBuilder.getInboundCondition()->clone(ast));
+            globalEdgeConditionBuilder.getInboundCondition()->clone(ast),
+            opts->edgeSortAttribute);
         break;
       case TRI_EDGE_OUT:
         _options->addLookupInfo(
             _plan, _edgeColls[i]->name(), StaticStrings::FromString,
-            globalEdgeConditionBuilder.getOutboundCondition()->clone(ast));
+            globalEdgeConditionBuilder.getOutboundCondition()->clone(ast),
+            opts->edgeSortAttribute);
         break;
       case TRI_EDGE_ANY:
         TRI_ASSERT(false);
@@ -639,8 +652,6 @@ void TraversalNode::prepareOptions() {
     }
   }
 
-  auto opts = static_cast<TraverserOptions*>(options());
-  TRI_ASSERT(opts != nullptr);
   for (auto& it : _edgeConditions) {
     uint64_t depth = it.first;
     // We probably have to adopt minDepth. We cannot fulfill a condition of
@@ -0,0 +1,521 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "VectorizedExpression.h"
+
+#include "Aql/AqlItemBlock.h"
+#include "Aql/Variable.h"
+
+#include <velocypack/velocypack-aliases.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+
+/// @brief largest integer magnitude that can be converted to a double
+/// without losing precision. integers beyond that are left to the
+/// interpreter, which compares them exactly
+constexpr double maxSafeInteger = 9007199254740992.0;  // 2^53
+
+bool isComparison(AstNodeType type) {
+  return (type == NODE_TYPE_OPERATOR_BINARY_EQ || type == NODE_TYPE_OPERATOR_BINARY_NE ||
+          type == NODE_TYPE_OPERATOR_BINARY_LT || type == NODE_TYPE_OPERATOR_BINARY_LE ||
+          type == NODE_TYPE_OPERATOR_BINARY_GT || type == NODE_TYPE_OPERATOR_BINARY_GE);
+}
+
+bool isArithmetic(AstNodeType type) {
+  return (type == NODE_TYPE_OPERATOR_BINARY_PLUS || type == NODE_TYPE_OPERATOR_BINARY_MINUS ||
+          type == NODE_TYPE_OPERATOR_BINARY_TIMES || type == NODE_TYPE_OPERATOR_BINARY_DIV ||
+          type == NODE_TYPE_OPERATOR_BINARY_MOD);
+}
+
+bool isLogical(AstNodeType type) {
+  return (type == NODE_TYPE_OPERATOR_BINARY_AND || type == NODE_TYPE_OPERATOR_BINARY_OR);
+}
+
+template <typename Compare>
+void compareNumbers(double const* lhs, double const* rhs, double* out, size_t n,
+                    Compare&& compare) {
+  // no branches in here, so the compiler can vectorize this
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = compare(lhs[i], rhs[i]) ? 1.0 : 0.0;
+  }
+}
+
+template <typename Compute>
+void computeNumbers(double const* lhs, double const* rhs, double* out, size_t n,
+                    Compute&& compute) {
+  // no branches in here, so the compiler can vectorize this
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = compute(lhs[i], rhs[i]);
+  }
+}
+
+bool compareResult(AstNodeType op, int cmp) {
+  switch (op) {
+    case NODE_TYPE_OPERATOR_BINARY_EQ:
+      return cmp == 0;
+    case NODE_TYPE_OPERATOR_BINARY_NE:
+      return cmp != 0;
+    case NODE_TYPE_OPERATOR_BINARY_LT:
+      return cmp < 0;
+    case NODE_TYPE_OPERATOR_BINARY_LE:
+      return cmp <= 0;
+    case NODE_TYPE_OPERATOR_BINARY_GT:
+      return cmp > 0;
+    case NODE_TYPE_OPERATOR_BINARY_GE:
+      return cmp >= 0;
+    default:
+      TRI_ASSERT(false);
+      return false;
+  }
+}
+
+}  // namespace
+
+void VectorizedExpression::Column::resize(size_t n) {
+  kinds.resize(n);
+  numbers.resize(n);
+  allNumbers = false;
+}
+
+VectorizedExpression::~VectorizedExpression() = default;
+
+std::unique_ptr<VectorizedExpression> VectorizedExpression::compile(
+    AstNode const* root, std::vector<Variable const*> const& vars,
+    std::vector<RegisterId> const& regs) {
+  TRI_ASSERT(vars.size() == regs.size());
+
+  if (root == nullptr || !(isComparison(root->type) || isArithmetic(root->type) ||
+                           isLogical(root->type) ||
+                           root->type == NODE_TYPE_OPERATOR_UNARY_NOT)) {
+    // plain values and attribute accesses are cheap enough already, and
+    // everything else is not supported
+    return nullptr;
+  }
+
+  // cannot use make_unique because of the private constructor
+  std::unique_ptr<VectorizedExpression> result(new VectorizedExpression());
+
+  if (result->compileNode(root, vars, regs) == SIZE_MAX) {
+    return nullptr;
+  }
+
+  TRI_ASSERT(!result->_instructions.empty());
+  result->_columns.resize(result->_instructions.size());
+  return result;
+}
+
+bool VectorizedExpression::producesBoolean(AstNode const* node) {
+  return (node->isBoolValue() || isComparison(node->type) || isLogical(node->type) ||
+          node->type == NODE_TYPE_OPERATOR_UNARY_NOT);
+}
+
+size_t VectorizedExpression::compileNode(AstNode const* node,
+                                         std::vector<Variable const*> const& vars,
+                                         std::vector<RegisterId> const& regs) {
+  Instruction instruction;
+  instruction.op = node->type;
+  instruction.lhs = SIZE_MAX;
+  instruction.rhs = SIZE_MAX;
+  instruction.reg = 0;
+  instruction.constKind = Kind::Other;
+  instruction.constNumber = 0.0;
+
+  if (node->type == NODE_TYPE_VALUE) {
+    instruction.type = Instruction::Type::Constant;
+    switch (node->value.type) {
+      case VALUE_TYPE_NULL:
+        instruction.constKind = Kind::Null;
+        break;
+      case VALUE_TYPE_BOOL:
+        instruction.constKind = Kind::Bool;
+        instruction.constNumber = node->getBoolValue() ? 1.0 : 0.0;
+        break;
+      case VALUE_TYPE_INT:
+      case VALUE_TYPE_DOUBLE: {
+        double v = node->getDoubleValue();
+        if (!std::isfinite(v) || std::abs(v) > maxSafeInteger) {
+          return SIZE_MAX;
+        }
+        instruction.constKind = Kind::Number;
+        instruction.constNumber = v;
+        break;
+      }
+      case VALUE_TYPE_STRING:
+        instruction.constKind = Kind::String;
+        instruction.constString.assign(node->getStringValue(), node->getStringLength());
+        break;
+    }
+  } else if (node->type == NODE_TYPE_ATTRIBUTE_ACCESS || node->type == NODE_TYPE_REFERENCE) {
+    instruction.type = Instruction::Type::Attribute;
+    while (node->type == NODE_TYPE_ATTRIBUTE_ACCESS) {
+      instruction.path.emplace_back(node->getStringValue(), node->getStringLength());
+      node = node->getMemberUnchecked(0);
+    }
+    if (node->type != NODE_TYPE_REFERENCE) {
+      // e.g. attribute access on a function call result
+      return SIZE_MAX;
+    }
+    std::reverse(instruction.path.begin(), instruction.path.end());
+
+    auto v = static_cast<Variable const*>(node->getData());
+    auto it = std::find(vars.begin(), vars.end(), v);
+    if (it == vars.end()) {
+      return SIZE_MAX;
+    }
+    instruction.reg = regs[std::distance(vars.begin(), it)];
+  } else if (node->type == NODE_TYPE_OPERATOR_UNARY_NOT) {
+    instruction.type = Instruction::Type::Unary;
+    instruction.lhs = compileNode(node->getMemberUnchecked(0), vars, regs);
+    if (instruction.lhs == SIZE_MAX) {
+      return SIZE_MAX;
+    }
+  } else if (isComparison(node->type) || isArithmetic(node->type) || isLogical(node->type)) {
+    TRI_ASSERT(node->numMembers() == 2);
+    if (isLogical(node->type) && (!producesBoolean(node->getMemberUnchecked(0)) ||
+                                  !producesBoolean(node->getMemberUnchecked(1)))) {
+      // AND and OR return one of their operands, which can be of any type.
+      // we only support them on boolean operands
+      return SIZE_MAX;
+    }
+    instruction.type = Instruction::Type::Binary;
+    instruction.lhs = compileNode(node->getMemberUnchecked(0), vars, regs);
+    if (instruction.lhs == SIZE_MAX) {
+      return SIZE_MAX;
+    }
+    instruction.rhs = compileNode(node->getMemberUnchecked(1), vars, regs);
+    if (instruction.rhs == SIZE_MAX) {
+      return SIZE_MAX;
+    }
+  } else {
+    return SIZE_MAX;
+  }
+
+  _instructions.emplace_back(std::move(instruction));
+  return _instructions.size() - 1;
+}
+
+void VectorizedExpression::evaluate(AqlItemBlock const& block, size_t from, size_t to) {
+  TRI_ASSERT(from < to && to <= block.size());
+  size_t const n = to - from;
+
+  for (size_t i = 0; i < _instructions.size(); ++i) {
+    Instruction const& instruction = _instructions[i];
+    Column& out = _columns[i];
+    out.resize(n);
+
+    switch (instruction.type) {
+      case Instruction::Type::Constant:
+        loadConstant(instruction, out, n);
+        break;
+      case Instruction::Type::Attribute:
+        loadAttribute(instruction, out, block, from, to);
+        break;
+      case Instruction::Type::Unary:
+        TRI_ASSERT(instruction.lhs < i);
+        executeNot(_columns[instruction.lhs], out, n);
+        break;
+      case Instruction::Type::Binary: {
+        TRI_ASSERT(instruction.lhs < i && instruction.rhs < i);
+        Column const& lhs = _columns[instruction.lhs];
+        Column const& rhs = _columns[instruction.rhs];
+        if (isComparison(instruction.op)) {
+          executeComparison(instruction.op, lhs, rhs, out, n);
+        } else if (isArithmetic(instruction.op)) {
+          executeArithmetic(instruction.op, lhs, rhs, out, n);
+        } else {
+          executeLogical(instruction.op, lhs, rhs, out, n);
+        }
+        break;
+      }
+    }
+  }
+
+  _block = &block;
+  _from = from;
+  _to = to;
+}
+
+bool VectorizedExpression::getResult(size_t row, AqlValue& result) const {
+  TRI_ASSERT(_block != nullptr);
+  TRI_ASSERT(row >= _from && row < _to);
+
+  Column const& column = _columns.back();
+  size_t const i = row - _from;
+
+  switch (column.kinds[i]) {
+    case Kind::Null:
+      result = AqlValue(AqlValueHintNull());
+      return true;
+    case Kind::Bool:
+      result = AqlValue(AqlValueHintBool(column.numbers[i] != 0.0));
+      return true;
+    case Kind::Number:
+      result = AqlValue(AqlValueHintDouble(column.numbers[i]));
+      return true;
+    case Kind::String:
+      // cannot happen, as the root of the program is always an operator
+      TRI_ASSERT(false);
+      return false;
+    case Kind::Other:
+      return false;
+  }
+  return false;
+}
+
+void VectorizedExpression::loadConstant(Instruction const& instruction,
+                                        Column& out, size_t n) {
+  std::fill(out.kinds.begin(), out.kinds.end(), instruction.constKind);
+  std::fill(out.numbers.begin(), out.numbers.end(), instruction.constNumber);
+  if (instruction.constKind == Kind::String) {
+    out.strings.assign(n, VPackStringRef(instruction.constString));
+  }
+  out.allNumbers = (instruction.constKind == Kind::Number);
+}
+
+void VectorizedExpression::loadAttribute(Instruction const& instruction, Column& out,
+                                         AqlItemBlock const& block, size_t from, size_t to) {
+  out.strings.resize(to - from);
+  bool allNumbers = true;
+
+  for (size_t row = from; row < to; ++row) {
+    size_t const i = row - from;
+    AqlValue const& value = block.getValueReference(row, instruction.reg);
+    Kind kind = Kind::Other;
+
+    if (value.isRange() || value.isDocvec()) {
+      // attribute accesses on these yield null, everything else is left
+      // to the interpreter
+      kind = instruction.path.empty() ? Kind::Other : Kind::Null;
+    } else {
+      VPackSlice s = value.slice().resolveExternals();
+      for (auto const& name : instruction.path) {
+        if (!s.isObject()) {
+          s = VPackSlice::nullSlice();
+          break;
+        }
+        s = s.get(name).resolveExternals();
+        if (s.isCustom()) {
+          // _id is resolved by the interpreter
+          break;
+        }
+        if (s.isNone()) {
+          s = VPackSlice::nullSlice();
+          break;
+        }
+      }
+
+      if (s.isNull() || s.isNone()) {
+        kind = Kind::Null;
+        out.numbers[i] = 0.0;
+      } else if (s.isBoolean()) {
+        kind = Kind::Bool;
+        out.numbers[i] = s.getBool() ? 1.0 : 0.0;
+      } else if (s.isNumber()) {
+        double v = s.getNumber<double>();
+        if (std::isfinite(v) && std::abs(v) <= maxSafeInteger) {
+          kind = Kind::Number;
+          out.numbers[i] = v;
+        }
+      } else if (s.isString()) {
+        kind = Kind::String;
+        VPackValueLength length;
+        char const* p = s.getStringUnchecked(length);
+        out.strings[i] = VPackStringRef(p, static_cast<size_t>(length));
+      }
+    }
+
+    out.kinds[i] = kind;
+    allNumbers &= (kind == Kind::Number);
+  }
+
+  out.allNumbers = allNumbers;
+}
+
+void VectorizedExpression::executeNot(Column const& in, Column& out, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    bool value;
+    switch (in.kinds[i]) {
+      case Kind::Null:
+        value = false;
+        break;
+      case Kind::Bool:
+      case Kind::Number:
+        value = (in.numbers[i] != 0.0);
+        break;
+      case Kind::String:
+        value = !in.strings[i].empty();
+        break;
+      default:
+        out.kinds[i] = Kind::Other;
+        continue;
+    }
+    out.kinds[i] = Kind::Bool;
+    out.numbers[i] = value ? 0.0 : 1.0;
+  }
+}
+
+void VectorizedExpression::executeLogical(AstNodeType op, Column const& lhs,
+                                          Column const& rhs, Column& out, size_t n) {
+  // both operands produce booleans (or Other), see compileNode
+  bool const isAnd = (op == NODE_TYPE_OPERATOR_BINARY_AND);
+
+  for (size_t i = 0; i < n; ++i) {
+    if (lhs.kinds[i] != Kind::Bool) {
+      out.kinds[i] = Kind::Other;
+      continue;
+    }
+    bool const left = (lhs.numbers[i] != 0.0);
+    if (left != isAnd) {
+      // short-circuit: false for AND, true for OR
+      out.kinds[i] = Kind::Bool;
+      out.numbers[i] = lhs.numbers[i];
+      continue;
+    }
+    out.kinds[i] = (rhs.kinds[i] == Kind::Bool) ? Kind::Bool : Kind::Other;
+    out.numbers[i] = rhs.numbers[i];
+  }
+}
+
+void VectorizedExpression::executeComparison(AstNodeType op, Column const& lhs,
+                                             Column const& rhs, Column& out, size_t n) {
+  if (lhs.allNumbers && rhs.allNumbers) {
+    double const* l = lhs.numbers.data();
+    double const* r = rhs.numbers.data();
+    double* o = out.numbers.data();
+    switch (op) {
+      case NODE_TYPE_OPERATOR_BINARY_EQ:
+        compareNumbers(l, r, o, n, [](double a, double b) { return a == b; });
+        break;
+      case NODE_TYPE_OPERATOR_BINARY_NE:
+        compareNumbers(l, r, o, n, [](double a, double b) { return a != b; });
+        break;
+      case NODE_TYPE_OPERATOR_BINARY_LT:
+        compareNumbers(l, r, o, n, [](double a, double b) { return a < b; });
+        break;
+      case NODE_TYPE_OPERATOR_BINARY_LE:
+        compareNumbers(l, r, o, n, [](double a, double b) { return a <= b; });
+        break;
+      case NODE_TYPE_OPERATOR_BINARY_GT:
+        compareNumbers(l, r, o, n, [](double a, double b) { return a > b; });
+        break;
+      case NODE_TYPE_OPERATOR_BINARY_GE:
+        compareNumbers(l, r, o, n, [](double a, double b) { return a >= b; });
+        break;
+      default:
+        TRI_ASSERT(false);
+    }
+    std::fill(out.kinds.begin(), out.kinds.end(), Kind::Bool);
+    return;
+  }
+
+  // equality is checked binary by the interpreter, all other comparisons
+  // of strings use ICU, so these are left to the interpreter
+  bool const binary = (op == NODE_TYPE_OPERATOR_BINARY_EQ || op == NODE_TYPE_OPERATOR_BINARY_NE);
+
+  for (size_t i = 0; i < n; ++i) {
+    Kind const lk = lhs.kinds[i];
+    Kind const rk = rhs.kinds[i];
+    if (lk == Kind::Other || rk == Kind::Other) {
+      out.kinds[i] = Kind::Other;
+      continue;
+    }
+
+    int cmp;
+    if (lk != rk) {
+      // the kinds are ordered like the AQL type weights
+      cmp = (lk < rk) ? -1 : 1;
+    } else if (lk == Kind::Null) {
+      cmp = 0;
+    } else if (lk == Kind::String) {
+      if (!binary) {
+        out.kinds[i] = Kind::Other;
+        continue;
+      }
+      cmp = lhs.strings[i].equals(rhs.strings[i]) ? 0 : 1;
+    } else {
+      double const l = lhs.numbers[i];
+      double const r = rhs.numbers[i];
+      cmp = (l == r) ? 0 : (l < r ? -1 : 1);
+    }
+
+    out.kinds[i] = Kind::Bool;
+    out.numbers[i] = compareResult(op, cmp) ? 1.0 : 0.0;
+  }
+}
+
+void VectorizedExpression::executeArithmetic(AstNodeType op, Column const& lhs,
+                                             Column const& rhs, Column& out, size_t n) {
+  bool const isDivision =
+      (op == NODE_TYPE_OPERATOR_BINARY_DIV || op == NODE_TYPE_OPERATOR_BINARY_MOD);
+
+  // operands which cannot be converted to a number cheaply, and divisions by
+  // zero (which register a warning) are left to the interpreter. null and
+  // booleans convert to 0 and 0/1 respectively, which is already the
+  // numeric value stored in the column
+  for (size_t i = 0; i < n; ++i) {
+    Kind const lk = lhs.kinds[i];
+    Kind const rk = rhs.kinds[i];
+    bool const valid = (lk == Kind::Null || lk == Kind::Bool || lk == Kind::Number) &&
+                       (rk == Kind::Null || rk == Kind::Bool || rk == Kind::Number) &&
+                       !(isDivision && (rk == Kind::Null || rhs.numbers[i] == 0.0));
+    out.kinds[i] = valid ? Kind::Number : Kind::Other;
+  }
+
+  double const* l = lhs.numbers.data();
+  double const* r = rhs.numbers.data();
+  double* o = out.numbers.data();
+
+  switch (op) {
+    case NODE_TYPE_OPERATOR_BINARY_PLUS:
+      computeNumbers(l, r, o, n, [](double a, double b) { return a + b; });
+      break;
+    case NODE_TYPE_OPERATOR_BINARY_MINUS:
+      computeNumbers(l, r, o, n, [](double a, double b) { return a - b; });
+      break;
+    case NODE_TYPE_OPERATOR_BINARY_TIMES:
+      computeNumbers(l, r, o, n, [](double a, double b) { return a * b; });
+      break;
+    case NODE_TYPE_OPERATOR_BINARY_DIV:
+      computeNumbers(l, r, o, n, [](double a, double b) { return a / b; });
+      break;
+    case NODE_TYPE_OPERATOR_BINARY_MOD:
+      computeNumbers(l, r, o, n, [](double a, double b) { return std::fmod(a, b); });
+      break;
+    default:
+      TRI_ASSERT(false);
+  }
+
+  bool allNumbers = true;
+  for (size_t i = 0; i < n; ++i) {
+    if (out.kinds[i] == Kind::Number && !std::isfinite(o[i])) {
+      // the interpreter converts NaN, +inf & -inf to null
+      out.kinds[i] = Kind::Null;
+      o[i] = 0.0;
+    }
+    allNumbers &= (out.kinds[i] == Kind::Number);
+  }
+  out.allNumbers = allNumbers;
+}
@@ -0,0 +1,159 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_VECTORIZED_EXPRESSION_H
+#define ARANGOD_AQL_VECTORIZED_EXPRESSION_H 1
+
+#include "Aql/AqlValue.h"
+#include "Aql/AstNode.h"
+#include "Aql/types.h"
+#include "Basics/Common.h"
+
+#include <velocypack/StringRef.h>
+
+namespace arangodb {
+namespace aql {
+
+class AqlItemBlock;
+struct Variable;
+
+/// @brief batch evaluator for simple expressions, consisting only of
+/// comparisons, logical and arithmetic operators over constants and
+/// (nested) attributes of the expression's input variables.
+///
+/// The evaluator computes the expression for a whole range of rows of an
+/// AqlItemBlock at once. All operands are first extracted into typed
+/// columns, and each operator is then executed as a tight loop over the
+/// columns. For columns that contain numbers only, these loops do not
+/// branch and can be auto-vectorized by the compiler.
+///
+/// Rows for which a value cannot be handled by the kernels (e.g. arrays,
+/// objects, ordering comparisons of strings, divisions by zero) are
+/// flagged, and the caller is expected to evaluate them with the regular
+/// Expression interpreter. The results for all other rows are identical to
+/// what the interpreter would produce.
+class VectorizedExpression {
+ public:
+  /// @brief try to build a batch evaluator for the expression. returns a
+  /// nullptr if the expression contains anything that is not covered by the
+  /// kernels
+  static std::unique_ptr<VectorizedExpression> compile(AstNode const* root,
+                                                       std::vector<Variable const*> const& vars,
+                                                       std::vector<RegisterId> const& regs);
+
+  VectorizedExpression(VectorizedExpression const&) = delete;
+  VectorizedExpression& operator=(VectorizedExpression const&) = delete;
+  ~VectorizedExpression();
+
+  /// @brief evaluate the expression for the rows [from, to) of the block.
+  /// results stay valid until the next call to evaluate
+  void evaluate(AqlItemBlock const& block, size_t from, size_t to);
+
+  /// @brief whether or not the result for the row of the block is available
+  /// from the last evaluate() call. note that blocks are recycled, so callers
+  /// must re-evaluate whenever they start reading a new block
+  bool covers(AqlItemBlock const& block, size_t row) const noexcept {
+    return &block == _block && row >= _from && row < _to;
+  }
+
+  /// @brief fetch the result for a row covered by the last evaluate() call.
+  /// returns false if the row has to be evaluated by the interpreter
+  /// instead. the returned value never requires destruction
+  bool getResult(size_t row, AqlValue& result) const;
+
+ private:
+  /// @brief type of a single value in a column
+  enum class Kind : uint8_t {
+    Null = 0,
+    Bool = 1,
+    Number = 2,
+    String = 3,
+    // anything the kernels cannot handle. rows with such a result must
+    // be evaluated by the interpreter
+    Other = 4
+  };
+
+  /// @brief a single input or output column of the program
+  struct Column {
+    std::vector<Kind> kinds;
+    std::vector<double> numbers;
+    std::vector<arangodb::velocypack::StringRef> strings;
+    // true iff all kinds are Kind::Number
+    bool allNumbers = false;
+
+    void resize(size_t n);
+  };
+
+  /// @brief a single instruction of the program
+  struct Instruction {
+    enum class Type : uint8_t { Constant, Attribute, Unary, Binary };
+
+    Type type;
+    // operator for unary and binary instructions
+    AstNodeType op;
+    // operand column indexes for unary and binary instructions
+    size_t lhs;
+    size_t rhs;
+    // input register for attribute instructions
+    RegisterId reg;
+    // attribute path for attribute instructions
+    std::vector<std::string> path;
+    // value for constant instructions
+    Kind constKind;
+    double constNumber;
+    std::string constString;
+  };
+
+  VectorizedExpression() = default;
+
+  /// @brief recursively translate the AST into instructions. returns the
+  /// index of the column the node result is stored in, or SIZE_MAX if the
+  /// node is not supported
+  size_t compileNode(AstNode const* node, std::vector<Variable const*> const& vars,
+                     std::vector<RegisterId> const& regs);
+
+  static bool producesBoolean(AstNode const* node);
+
+  void loadConstant(Instruction const& instruction, Column& out, size_t n);
+  void loadAttribute(Instruction const& instruction, Column& out,
+                     AqlItemBlock const& block, size_t from, size_t to);
+  void executeNot(Column const& in, Column& out, size_t n);
+  void executeLogical(AstNodeType op, Column const& lhs, Column const& rhs,
+                      Column& out, size_t n);
+  void executeComparison(AstNodeType op, Column const& lhs, Column const& rhs,
+                         Column& out, size_t n);
+  void executeArithmetic(AstNodeType op, Column const& lhs, Column const& rhs,
+                         Column& out, size_t n);
+
+ private:
+  std::vector<Instruction> _instructions;
+  // one column per instruction, the last one holds the result
+  std::vector<Column> _columns;
+
+  // block and row range of the last evaluate() call
+  AqlItemBlock const* _block = nullptr;
+  size_t _from = 0;
+  size_t _to = 0;
+};
+
+}  // namespace aql
+}  // namespace arangodb
+
+#endif
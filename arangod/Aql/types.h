@@ -39,6 +39,15 @@ typedef unsigned int RegisterId;
 /// @brief type of a query id
 typedef uint64_t QueryId;
 
+/// @brief memory layout of the values inside an AqlItemBlock
+enum class AqlItemBlockLayout : uint8_t {
+  /// @brief all registers of a row are adjacent (row-major, the default)
+  RowMajor = 0,
+  /// @brief all rows of a register are adjacent (column-major). this makes
+  /// scans over a single register sequential in memory
+  ColumnMajor = 1
+};
+
 // Map RemoteID->ServerID->[SnippetId]
 typedef std::unordered_map<size_t, std::unordered_map<std::string, std::vector<std::string>>> MapRemoteToSnippet;
 }  // namespace aql
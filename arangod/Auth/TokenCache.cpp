@@ -49,20 +49,11 @@ auth::TokenCache::TokenCache(auth::UserManager* um, double timeout)
     : _userManager(um),
       _authTimeout(timeout),
       _basicCacheVersion(0),
+      _basicCache(16384),
       _jwtSecret(""),
       _jwtCache(16384) {}
 
-auth::TokenCache::~TokenCache() {
-  // properly clear structs while using the appropriate locks
-  {
-    WRITE_LOCKER(readLocker, _basicLock);
-    _basicCache.clear();
-  }
-  {
-    WRITE_LOCKER(writeLocker, _jwtLock);
-    _jwtCache.clear();
-  }
-}
+auth::TokenCache::~TokenCache() = default;
 
 void auth::TokenCache::setJwtSecret(std::string const& jwtSecret) {
   WRITE_LOCKER(writeLocker, _jwtLock);
@@ -96,7 +87,6 @@ auth::TokenCache::Entry auth::TokenCache::checkAuthentication(AuthenticationMeth
 }
 
 void auth::TokenCache::invalidateBasicCache() {
-  WRITE_LOCKER(guard, _basicLock);
   _basicCache.clear();
 }
 
@@ -109,20 +99,13 @@ auth::TokenCache::Entry auth::TokenCache::checkAuthenticationBasic(std::string c
 
   uint64_t version = _userManager->globalVersion();
   if (_basicCacheVersion.load(std::memory_order_acquire) != version) {
-    WRITE_LOCKER(guard, _basicLock);
     _basicCache.clear();
     _basicCacheVersion.store(version, std::memory_order_release);
   }
 
   {
-    READ_LOCKER(guard, _basicLock);
-    auto const& it = _basicCache.find(secret);
-    if (it != _basicCache.end() && !it->second.expired()) {
-      // copy entry under the read-lock
-      auth::TokenCache::Entry res = it->second;
-      // and now give up on the read-lock
-      guard.unlock();
-
+    auth::TokenCache::Entry res = auth::TokenCache::Entry::Unauthenticated();
+    if (_basicCache.get(secret, res) && !res.expired()) {
       // LDAP rights might need to be refreshed
       if (!_userManager->refreshUser(res.username())) {
         return res;
@@ -151,45 +134,31 @@ auth::TokenCache::Entry auth::TokenCache::checkAuthenticationBasic(std::string c
   }
 
   auth::TokenCache::Entry entry(username, authorized, expiry);
-  {
-    WRITE_LOCKER(guard, _basicLock);
-    if (authorized) {
-      if (!_basicCache.emplace(secret, entry).second) {
-        // insertion did not work - probably another thread did insert the
-        // same data right now
-        // erase it and re-insert our version
-        _basicCache.erase(secret);
-        _basicCache.emplace(secret, entry);
-      }
-    } else {
-      _basicCache.erase(secret);
-    }
+  if (authorized) {
+    // replaces the entry another thread may have inserted right now
+    _basicCache.put(secret, entry);
+  } else {
+    _basicCache.remove(secret);
   }
 
   return entry;
 }
 
 auth::TokenCache::Entry auth::TokenCache::checkAuthenticationJWT(std::string const& jwt) {
-  // note that we need the write lock here because it is an LRU
-  // cache. reading from it will move the read entry to the start of
-  // the cache's linked list. so acquiring just a read-lock is
-  // insufficient!!
   {
-    WRITE_LOCKER(writeLocker, _jwtLock);
     // intentionally copy the entry from the cache
-    auth::TokenCache::Entry const* entry = _jwtCache.get(jwt);
-    if (entry != nullptr) {
-      // would have thrown if not found
-      if (entry->expired()) {
+    auth::TokenCache::Entry entry = auth::TokenCache::Entry::Unauthenticated();
+    if (_jwtCache.get(jwt, entry)) {
+      if (entry.expired()) {
         _jwtCache.remove(jwt);
         LOG_TOPIC("65e15", TRACE, Logger::AUTHENTICATION) << "JWT Token expired";
         return auth::TokenCache::Entry::Unauthenticated();
       }
       if (_userManager != nullptr) {
         // LDAP rights might need to be refreshed
-        _userManager->refreshUser(entry->username());
+        _userManager->refreshUser(entry.username());
       }
-      return *entry;
+      return entry;
     }
   }
   std::vector<std::string> const parts = StringUtils::split(jwt, '.');
@@ -223,7 +192,6 @@ auth::TokenCache::Entry auth::TokenCache::checkAuthenticationJWT(std::string con
     return auth::TokenCache::Entry::Unauthenticated();
   }
 
-  WRITE_LOCKER(writeLocker, _jwtLock);
   _jwtCache.put(jwt, newEntry);
   return newEntry;
 }
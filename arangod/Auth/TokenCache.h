@@ -25,10 +25,10 @@
 #define ARANGOD_AUTHENTICATION_TOKEN_CACHE_H 1
 
 #include "Basics/Common.h"
-#include "Basics/LruCache.h"
 #include "Basics/Mutex.h"
 #include "Basics/ReadWriteLock.h"
 #include "Basics/Result.h"
+#include "Basics/ShardedLruCache.h"
 #include "Rest/CommonDefines.h"
 
 #include <velocypack/Builder.h>
@@ -113,15 +113,15 @@ class TokenCache {
   /// Timeout in seconds
   double const _authTimeout;
 
-  mutable arangodb::basics::ReadWriteLock _basicLock;
   std::atomic<uint64_t> _basicCacheVersion;
-  std::unordered_map<std::string, TokenCache::Entry> _basicCache;
+  arangodb::basics::ShardedLruCache<std::string, TokenCache::Entry> _basicCache;
 
+  /// protects the secret and the token
+  mutable arangodb::basics::ReadWriteLock _jwtLock;
   std::string _jwtSecret;
   std::string _jwtToken;
 
-  mutable arangodb::basics::ReadWriteLock _jwtLock;
-  arangodb::basics::LruCache<std::string, TokenCache::Entry> _jwtCache;
+  arangodb::basics::ShardedLruCache<std::string, TokenCache::Entry> _jwtCache;
 };
 }  // namespace auth
 }  // namespace arangodb
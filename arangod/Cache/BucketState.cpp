@@ -74,7 +74,21 @@ bool BucketState::lock(uint64_t maxTries, BucketState::CallbackType cb) {
 
 void BucketState::unlock() {
   TRI_ASSERT(isLocked());
-  _state.fetch_and(~static_cast<uint32_t>(Flag::locked), std::memory_order_release);
+  // clears the lock bit and increases the version in one go
+  _state.fetch_add(versionIncrement - static_cast<uint32_t>(Flag::locked),
+                   std::memory_order_release);
+}
+
+bool BucketState::beginOptimisticRead(uint32_t& snapshot) const {
+  snapshot = _state.load(std::memory_order_acquire);
+  return ((snapshot & (static_cast<uint32_t>(Flag::locked) |
+                       static_cast<uint32_t>(Flag::migrated))) == 0);
+}
+
+bool BucketState::validateOptimisticRead(uint32_t snapshot) const {
+  // the reads of the data must not be moved behind the check
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return (_state.load(std::memory_order_relaxed) == snapshot);
 }
 
 bool BucketState::isSet(BucketState::Flag flag) const {
@@ -95,5 +109,5 @@ void BucketState::toggleFlag(BucketState::Flag flag) {
 
 void BucketState::clear() {
   TRI_ASSERT(isLocked());
-  _state = static_cast<uint32_t>(Flag::locked);
+  _state = (_state.load() & ~(versionIncrement - 1)) | static_cast<uint32_t>(Flag::locked);
 }
@@ -42,6 +42,11 @@ namespace cache {
 /// state is locked and, of course, to lock it. Any flags besides the lock flag
 /// are treated uniformly, and can be checked or toggled. Each flag is defined
 /// via an enum and must correspond to exactly one set bit.
+///
+/// The bits above the flags count how often the state was unlocked. This
+/// allows optimistic reads without locking: a reader takes a snapshot of the
+/// unlocked state, reads the data, and then checks that the state is still
+/// the same, i.e. that no writer locked it in the meantime.
 ////////////////////////////////////////////////////////////////////////////////
 struct BucketState {
   typedef std::function<void()> CallbackType;
@@ -68,6 +73,11 @@ struct BucketState {
     shuttingDown = 0x00000200,
   };
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Lowest bit of the version counter, above all flags
+  //////////////////////////////////////////////////////////////////////////////
+  static constexpr uint32_t versionIncrement = 0x00000400;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Initializes state with no flags set and unlocked
   //////////////////////////////////////////////////////////////////////////////
@@ -104,6 +114,21 @@ struct BucketState {
   //////////////////////////////////////////////////////////////////////////////
   void unlock();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Starts an optimistic read without locking the state.
+  ///
+  /// Stores a snapshot of the state in the parameter. Returns false if the
+  /// state is locked or migrated, in which case the data guarded by the state
+  /// must not be read optimistically.
+  //////////////////////////////////////////////////////////////////////////////
+  bool beginOptimisticRead(uint32_t& snapshot) const;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Checks whether the data read since beginOptimisticRead() is
+  /// consistent, i.e. whether the state was not locked in the meantime.
+  //////////////////////////////////////////////////////////////////////////////
+  bool validateOptimisticRead(uint32_t snapshot) const;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Checks whether the given flag is set. Requires state to be locked.
   //////////////////////////////////////////////////////////////////////////////
@@ -116,7 +141,8 @@ struct BucketState {
   void toggleFlag(BucketState::Flag flag);
 
   //////////////////////////////////////////////////////////////////////////////
-  /// @brief Unsets all flags besides Flag::locked. Requires state to be locked.
+  /// @brief Unsets all flags besides Flag::locked, keeps the version. Requires
+  /// state to be locked.
   //////////////////////////////////////////////////////////////////////////////
   void clear();
 
@@ -37,7 +37,9 @@
 #include <chrono>
 #include <cmath>
 #include <list>
+#include <string>
 #include <thread>
+#include <vector>
 
 using namespace arangodb::cache;
 
@@ -66,6 +68,9 @@ Cache::Cache(ConstructionGuard guard, Manager* manager, uint64_t id,
       _slotsPerBucket(slotsPerBucket),
       _insertsTotal(),
       _insertEvictions(),
+      _inserts(),
+      _evictions(),
+      _insertRejections(),
       _migrateRequestTime(std::chrono::steady_clock::now().time_since_epoch().count()),
       _resizeRequestTime(std::chrono::steady_clock::now().time_since_epoch().count()) {
   _tableShrdPtr->setTypeSpecifics(_bucketClearer, _slotsPerBucket);
@@ -130,6 +135,18 @@ void Cache::sizeHint(uint64_t numElements) {
   requestMigrate(requestedLogSize);
 }
 
+Cache::Statistics Cache::statistics() const {
+  // scale up the sampled lookups, see recordStat()
+  Statistics stats;
+  stats.findHits = 8 * static_cast<uint64_t>(_findHits.value(std::memory_order_relaxed));
+  stats.findMisses = 8 * static_cast<uint64_t>(_findMisses.value(std::memory_order_relaxed));
+  stats.inserts = static_cast<uint64_t>(_inserts.value(std::memory_order_relaxed));
+  stats.evictions = static_cast<uint64_t>(_evictions.value(std::memory_order_relaxed));
+  stats.insertRejections =
+      static_cast<uint64_t>(_insertRejections.value(std::memory_order_relaxed));
+  return stats;
+}
+
 std::pair<double, double> Cache::hitRates() {
   double lifetimeRate = std::nan("");
   double windowedRate = std::nan("");
@@ -307,8 +324,10 @@ bool Cache::reportInsert(bool hadEviction) {
   bool shouldMigrate = false;
   if (hadEviction) {
     _insertEvictions.add(1, std::memory_order_relaxed);
+    _evictions.add(1, std::memory_order_relaxed);
   }
   _insertsTotal.add(1, std::memory_order_relaxed);
+  _inserts.add(1, std::memory_order_relaxed);
   if ((basics::SharedPRNG::rand() & _evictionMask) == 0) {
     uint64_t total = _insertsTotal.value(std::memory_order_relaxed);
     uint64_t evictions = _insertEvictions.value(std::memory_order_relaxed);
@@ -327,6 +346,36 @@ bool Cache::reportInsert(bool hadEviction) {
 
 Metadata* Cache::metadata() { return &_metadata; }
 
+void Cache::reportInsertRejection() {
+  _insertRejections.add(1, std::memory_order_relaxed);
+}
+
+std::vector<std::string> Cache::keys(size_t maxKeys) {
+  std::vector<std::string> keys;
+  if (isShutdown()) {
+    return keys;
+  }
+
+  // hold on to the table, so it is not released while we walk it
+  std::shared_ptr<Table> table = this->table();
+  if (table.get() == nullptr) {
+    return keys;
+  }
+
+  for (size_t slot = 0; slot < _slotsPerBucket && keys.size() < maxKeys; slot++) {
+    for (uint64_t i = 0; i < table->size() && keys.size() < maxKeys; i++) {
+      void* bucket = table->primaryBucket(i);
+      if (bucket == nullptr) {
+        // table was disabled
+        return keys;
+      }
+      collectKey(bucket, slot, keys);
+    }
+  }
+
+  return keys;
+}
+
 std::shared_ptr<Table> Cache::table() const {
   return std::atomic_load(&_tableShrdPtr);
 }
@@ -40,6 +40,8 @@
 #include <stdint.h>
 #include <list>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace arangodb {
 namespace cache {
@@ -68,6 +70,22 @@ class Cache : public std::enable_shared_from_this<Cache> {
  public:
   typedef FrequencyBuffer<uint8_t> StatBuffer;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Counters over the lifetime of a cache.
+  ///
+  /// Only one in eight lookups is recorded, so hits and misses are estimates.
+  /// Evictions are inserts which replaced a value with a different key, and
+  /// rejections are inserts which failed because there was no room or the
+  /// admission filter preferred the existing value.
+  //////////////////////////////////////////////////////////////////////////////
+  struct Statistics {
+    uint64_t findHits;
+    uint64_t findMisses;
+    uint64_t inserts;
+    uint64_t evictions;
+    uint64_t insertRejections;
+  };
+
   static const uint64_t minSize;
   static const uint64_t minLogSize;
 
@@ -121,6 +139,11 @@ class Cache : public std::enable_shared_from_this<Cache> {
   //////////////////////////////////////////////////////////////////////////////
   std::pair<double, double> hitRates();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Returns the counters of this cache over its lifetime.
+  //////////////////////////////////////////////////////////////////////////////
+  Statistics statistics() const;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Check whether the cache is currently in the process of resizing.
   //////////////////////////////////////////////////////////////////////////////
@@ -141,6 +164,16 @@ class Cache : public std::enable_shared_from_this<Cache> {
   //////////////////////////////////////////////////////////////////////////////
   inline bool isShutdown() const { return _shutdown.load(); }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Returns up to maxKeys keys of the values currently in the cache.
+  ///
+  /// Buckets keep their most recently used values first, so the first slot of
+  /// every bucket is visited before the second one, and so on. Buckets which
+  /// cannot be locked quickly or are being migrated are skipped. Meant for
+  /// remembering the hot keys of a cache, not for enumerating all of them.
+  //////////////////////////////////////////////////////////////////////////////
+  std::vector<std::string> keys(size_t maxKeys);
+
  protected:
   static constexpr uint64_t triesFast = 200;
   static constexpr uint64_t triesSlow = 10000;
@@ -177,6 +210,11 @@ class Cache : public std::enable_shared_from_this<Cache> {
                                                           // evictions in past 4096
                                                           // inserts, migrate
 
+  // lifetime counters, see Statistics
+  basics::SharedCounter<64> _inserts;
+  basics::SharedCounter<64> _evictions;
+  basics::SharedCounter<64> _insertRejections;
+
   // times to wait until requesting is allowed again
   std::atomic<Manager::time_point::rep> _migrateRequestTime;
   std::atomic<Manager::time_point::rep> _resizeRequestTime;
@@ -200,6 +238,7 @@ class Cache : public std::enable_shared_from_this<Cache> {
   void recordStat(Stat stat);
 
   bool reportInsert(bool hadEviction);
+  void reportInsertRejection();
 
   // management
   Metadata* metadata();
@@ -213,6 +252,7 @@ class Cache : public std::enable_shared_from_this<Cache> {
   virtual uint64_t freeMemoryFrom(uint32_t hash) = 0;
   virtual void migrateBucket(void* sourcePtr, std::unique_ptr<Table::Subtable> targets,
                              std::shared_ptr<Table> newTable) = 0;
+  virtual void collectKey(void* bucketPtr, size_t slot, std::vector<std::string>& keys) = 0;
 };
 
 };  // end namespace cache
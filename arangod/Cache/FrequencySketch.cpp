@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Cache/FrequencySketch.h"
+#include "Basics/Common.h"
+
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+
+using namespace arangodb::cache;
+
+namespace {
+// each 64-bit word holds 16 counters
+constexpr uint64_t countersPerWord = 16;
+constexpr uint64_t countersPerEntry = 8;
+constexpr size_t rows = 4;
+constexpr uint64_t seeds[rows] = {0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL,
+                                  0x9ae16a3b2f90404fULL, 0xcbf29ce484222325ULL};
+// removes the bit that is shifted into the next counter when halving
+constexpr uint64_t halveMask = 0x7777777777777777ULL;
+}  // namespace
+
+constexpr uint32_t FrequencySketch::maxFrequency;
+
+FrequencySketch::FrequencySketch(uint64_t numEntries)
+    : _mask(numWords(numEntries) - 1),
+      _sampleSize(10 * numWords(numEntries) * ::countersPerWord / ::countersPerEntry),
+      _additions(0),
+      _counters(new std::atomic<uint64_t>[numWords(numEntries)]) {
+  clear();
+}
+
+uint64_t FrequencySketch::allocationSize(uint64_t numEntries) {
+  return sizeof(FrequencySketch) + numWords(numEntries) * sizeof(std::atomic<uint64_t>);
+}
+
+void FrequencySketch::record(uint32_t hash) {
+  bool added = false;
+  for (size_t row = 0; row < ::rows; ++row) {
+    uint32_t shift;
+    std::atomic<uint64_t>& word = _counters[position(hash, row, shift)];
+    uint64_t current = word.load(std::memory_order_relaxed);
+    while (((current >> shift) & maxFrequency) < maxFrequency) {
+      if (word.compare_exchange_weak(current, current + (static_cast<uint64_t>(1) << shift),
+                                     std::memory_order_relaxed)) {
+        added = true;
+        break;
+      }
+    }
+  }
+
+  if (added && _additions.fetch_add(1, std::memory_order_relaxed) + 1 == _sampleSize) {
+    age();
+  }
+}
+
+uint32_t FrequencySketch::frequency(uint32_t hash) const {
+  uint32_t result = maxFrequency;
+  for (size_t row = 0; row < ::rows; ++row) {
+    uint32_t shift;
+    uint64_t word = _counters[position(hash, row, shift)].load(std::memory_order_relaxed);
+    result = (std::min)(result, static_cast<uint32_t>((word >> shift) & maxFrequency));
+  }
+  return result;
+}
+
+void FrequencySketch::clear() {
+  for (uint64_t i = 0; i <= _mask; ++i) {
+    _counters[i].store(0, std::memory_order_relaxed);
+  }
+  _additions.store(0, std::memory_order_relaxed);
+}
+
+uint64_t FrequencySketch::numWords(uint64_t numEntries) {
+  uint64_t words = 8;
+  while (words * ::countersPerWord < numEntries * ::countersPerEntry) {
+    words <<= 1;
+  }
+  return words;
+}
+
+uint64_t FrequencySketch::position(uint32_t hash, size_t row, uint32_t& shift) const {
+  uint64_t x = (static_cast<uint64_t>(hash) + ::seeds[row]) * 0x9e3779b97f4a7c15ULL;
+  x ^= x >> 32;
+  shift = static_cast<uint32_t>((x >> 48) & (::countersPerWord - 1)) * 4;
+  return x & _mask;
+}
+
+void FrequencySketch::age() {
+  // accesses recorded concurrently may get lost, which does not matter for
+  // an estimate
+  for (uint64_t i = 0; i <= _mask; ++i) {
+    uint64_t word = _counters[i].load(std::memory_order_relaxed);
+    _counters[i].store((word >> 1) & ::halveMask, std::memory_order_relaxed);
+  }
+  _additions.store(_sampleSize / 2, std::memory_order_relaxed);
+}
@@ -0,0 +1,92 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_CACHE_FREQUENCY_SKETCH_H
+#define ARANGODB_CACHE_FREQUENCY_SKETCH_H
+
+#include "Basics/Common.h"
+
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+
+namespace arangodb {
+namespace cache {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Lockless count-min sketch to estimate how often keys were accessed.
+///
+/// Keys are identified by their hash. Each key maps to four 4-bit counters,
+/// and its frequency is the minimum of them. There are eight counters per
+/// expected entry. Once the number of recorded accesses reaches ten times the
+/// number of entries, all counters are halved, so that the sketch forgets about old accesses. Used as a TinyLFU
+/// admission filter: a new entry may only evict an entry that was accessed
+/// less often.
+////////////////////////////////////////////////////////////////////////////////
+class FrequencySketch {
+ public:
+  static constexpr uint32_t maxFrequency = 15;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Initialize for (at least) the given number of entries.
+  //////////////////////////////////////////////////////////////////////////////
+  explicit FrequencySketch(uint64_t numEntries);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Returns the memory usage of a sketch for the given number of
+  /// entries.
+  //////////////////////////////////////////////////////////////////////////////
+  static uint64_t allocationSize(uint64_t numEntries);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Records an access of the key with the given hash.
+  ///
+  /// Counters at their maximum are not written to, so that accesses of hot
+  /// keys do not contend on the sketch.
+  //////////////////////////////////////////////////////////////////////////////
+  void record(uint32_t hash);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Returns the estimated number of accesses of the key with the given
+  /// hash, at most maxFrequency.
+  //////////////////////////////////////////////////////////////////////////////
+  uint32_t frequency(uint32_t hash) const;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Resets all counters.
+  //////////////////////////////////////////////////////////////////////////////
+  void clear();
+
+ private:
+  static uint64_t numWords(uint64_t numEntries);
+  uint64_t position(uint32_t hash, size_t row, uint32_t& shift) const;
+  void age();
+
+ private:
+  uint64_t const _mask;
+  uint64_t const _sampleSize;
+  std::atomic<uint64_t> _additions;
+  std::unique_ptr<std::atomic<uint64_t>[]> _counters;
+};
+
+};  // end namespace cache
+};  // end namespace arangodb
+
+#endif
@@ -30,6 +30,7 @@
 #include "Cache/FrequencyBuffer.h"
 #include "Cache/ManagerTasks.h"
 #include "Cache/Metadata.h"
+#include "Cache/NumaNodes.h"
 #include "Cache/PlainCache.h"
 #include "Cache/Table.h"
 #include "Cache/Transaction.h"
@@ -54,7 +55,8 @@ const uint64_t Manager::minCacheAllocation =
     Manager::cacheRecordOverhead;
 const std::chrono::milliseconds Manager::rebalancingGracePeriod(10);
 
-Manager::Manager(PostFn schedulerPost, uint64_t globalLimit, bool enableWindowedStats)
+Manager::Manager(PostFn schedulerPost, uint64_t globalLimit,
+                 bool enableWindowedStats, bool rebalanceByUtility)
     : _lock(),
       _shutdown(false),
       _shuttingDown(false),
@@ -67,13 +69,17 @@ Manager::Manager(PostFn schedulerPost, uint64_t globalLimit, bool enableWindowed
       _findStats(nullptr),
       _findHits(),
       _findMisses(),
+      _rebalanceByUtility(rebalanceByUtility),
+      _utilityStats(),
       _caches(),
       _nextCacheId(1),
+      _tables(NumaNodes::count()),
+      _tableAllocation(NumaNodes::count(), 0),
       _globalSoftLimit(globalLimit),
       _globalHardLimit(globalLimit),
       _globalHighwaterMark(static_cast<uint64_t>(
           Manager::highwaterMultiplier * static_cast<double>(_globalSoftLimit))),
-      _fixedAllocation(sizeof(Manager) + Manager::tableListsOverhead +
+      _fixedAllocation(sizeof(Manager) + NumaNodes::count() * Manager::tableListsOverhead +
                        _accessStats.memoryUsage()),
       _spareTableAllocation(0),
       _globalAllocation(_fixedAllocation),
@@ -107,7 +113,7 @@ Manager::~Manager() {
 }
 
 std::shared_ptr<Cache> Manager::createCache(CacheType type, bool enableWindowedStats,
-                                            uint64_t maxSize) {
+                                            uint64_t maxSize, bool enableAdmissionFilter) {
   std::shared_ptr<Cache> result(nullptr);
   _lock.writeLock();
   bool allowed = isOperational();
@@ -136,8 +142,8 @@ std::shared_ptr<Cache> Manager::createCache(CacheType type, bool enableWindowedS
         result = PlainCache::create(this, id, std::move(metadata), table, enableWindowedStats);
         break;
       case CacheType::Transactional:
-        result = TransactionalCache::create(this, id, std::move(metadata),
-                                            table, enableWindowedStats);
+        result = TransactionalCache::create(this, id, std::move(metadata), table,
+                                            enableWindowedStats, enableAdmissionFilter);
         break;
       default:
         break;
@@ -235,6 +241,14 @@ uint64_t Manager::globalAllocation() {
   return allocation;
 }
 
+std::vector<uint64_t> Manager::tableAllocationPerNode() {
+  _lock.readLock();
+  std::vector<uint64_t> allocation = _tableAllocation;
+  _lock.readUnlock();
+
+  return allocation;
+}
+
 std::pair<double, double> Manager::globalHitRates() {
   double lifetimeRate = std::nan("");
   double windowedRate = std::nan("");
@@ -317,6 +331,7 @@ std::tuple<bool, Metadata, std::shared_ptr<Table>> Manager::registerCache(uint64
 void Manager::unregisterCache(uint64_t id) {
   _lock.writeLock();
   _accessStats.purgeRecord(id);
+  _utilityStats.erase(id);
   auto it = _caches.find(id);
   if (it == _caches.end()) {
     _lock.writeUnlock();
@@ -593,11 +608,14 @@ void Manager::shrinkOvergrownCaches(Manager::TaskEnvironment environment) {
 
 void Manager::freeUnusedTables() {
   TRI_ASSERT(_lock.isWriteLocked());
-  for (size_t i = 0; i < 32; i++) {
-    while (!_tables[i].empty()) {
-      auto table = _tables[i].top();
-      _globalAllocation -= table->memoryUsage();
-      _tables[i].pop();
+  for (auto& tables : _tables) {
+    for (size_t i = 0; i < 32; i++) {
+      while (!tables[i].empty()) {
+        auto table = tables[i].top();
+        _spareTableAllocation -= table->memoryUsage();
+        releaseTableMemory(table);
+        tables[i].pop();
+      }
     }
   }
 }
@@ -673,25 +691,47 @@ void Manager::migrateCache(Manager::TaskEnvironment environment, Cache* cache,
 std::shared_ptr<Table> Manager::leaseTable(uint32_t logSize) {
   TRI_ASSERT(_lock.isWriteLocked());
 
+  // prefer tables on the node of the requesting thread, so that lookups by
+  // this thread do not cross the interconnect
+  uint32_t node = NumaNodes::current();
+  TRI_ASSERT(node < _tables.size());
   std::shared_ptr<Table> table(nullptr);
-  if (_tables[logSize].empty()) {
+  if (_tables[node][logSize].empty()) {
     if (increaseAllowed(Table::allocationSize(logSize), true)) {
       try {
         table = std::make_shared<Table>(logSize);
         _globalAllocation += table->memoryUsage();
+        _tableAllocation[table->numaNode()] += table->memoryUsage();
       } catch (std::bad_alloc const&) {
         table.reset();
       }
+    } else {
+      // out of memory, take a spare table from another node if there is one
+      for (auto& tables : _tables) {
+        if (!tables[logSize].empty()) {
+          node = tables[logSize].top()->numaNode();
+          break;
+        }
+      }
     }
-  } else {
-    table = _tables[logSize].top();
+  }
+
+  if (table.get() == nullptr && !_tables[node][logSize].empty()) {
+    table = _tables[node][logSize].top();
     _spareTableAllocation -= table->memoryUsage();
-    _tables[logSize].pop();
+    _tables[node][logSize].pop();
   }
 
   return table;
 }
 
+void Manager::releaseTableMemory(std::shared_ptr<Table>& table) {
+  TRI_ASSERT(_lock.isWriteLocked());
+  _globalAllocation -= table->memoryUsage();
+  _tableAllocation[table->numaNode()] -= table->memoryUsage();
+  table.reset();
+}
+
 void Manager::reclaimTable(std::shared_ptr<Table> table, bool internal) {
   TRI_ASSERT(table.get() != nullptr);
   if (!internal) {
@@ -699,15 +739,15 @@ void Manager::reclaimTable(std::shared_ptr<Table> table, bool internal) {
   }
 
   uint32_t logSize = table->logSize();
+  auto& tables = _tables[table->numaNode()][logSize];
   size_t maxTables = (logSize < 18) ? (1 << (18 - logSize)) : 1;
-  if ((_tables[logSize].size() < maxTables) &&
+  if ((tables.size() < maxTables) &&
       ((table->memoryUsage() + _spareTableAllocation) <
        ((_globalSoftLimit - _globalHighwaterMark) / 2))) {
-    _tables[logSize].emplace(table);
+    tables.emplace(table);
     _spareTableAllocation += table->memoryUsage();
   } else {
-    _globalAllocation -= table->memoryUsage();
-    table.reset();
+    releaseTableMemory(table);
   }
 
   if (!internal) {
@@ -791,12 +831,47 @@ std::shared_ptr<Manager::PriorityList> Manager::priorityList() {
       ((1.0 - allocFrac) * remainingWeight) / static_cast<double>(totalAccesses);
   double usageNormalizer = (allocFrac * remainingWeight) / static_cast<double>(globalUsage);
 
+  // with utility-based rebalancing, the accessed caches are weighed by the
+  // hits they would likely have gained with more memory since the last
+  // rebalancing, rather than by their accesses. a miss is counted as a
+  // capacity miss in the proportion of inserts which had to evict another
+  // value or were rejected for lack of room
+  std::map<uint64_t, double> utilities;
+  double utilityNormalizer = 0.0;
+  if (_rebalanceByUtility) {
+    double totalUtility = 0.0;
+    for (uint64_t id : accessed) {
+      Cache::Statistics current = _caches.find(id)->second->statistics();
+      UtilityStats& last = _utilityStats[id];
+      double misses = static_cast<double>(current.findMisses - last.misses);
+      double inserts = static_cast<double>(current.inserts - last.inserts);
+      double evictions = static_cast<double>(current.evictions - last.evictions);
+      double rejections =
+          static_cast<double>(current.insertRejections - last.rejections);
+      double utility = 0.0;
+      if (inserts + rejections > 0.0) {
+        utility = misses * ((evictions + rejections) / (inserts + rejections));
+      }
+      last.misses = current.findMisses;
+      last.inserts = current.inserts;
+      last.evictions = current.evictions;
+      last.rejections = current.insertRejections;
+      utilities.emplace(id, utility);
+      totalUtility += utility;
+    }
+    if (totalUtility > 0.0) {
+      utilityNormalizer = ((1.0 - allocFrac) * remainingWeight) / totalUtility;
+    }
+  }
+
   // gather all accessed caches in order
   for (auto s : stats) {
     auto it = accessed.find(s.first);
     if (it != accessed.end()) {
       std::shared_ptr<Cache>& cache = _caches.find(s.first)->second;
-      double accessWeight = static_cast<double>(s.second) * accessNormalizer;
+      double accessWeight = (utilityNormalizer > 0.0)
+                                ? utilities[s.first] * utilityNormalizer
+                                : static_cast<double>(s.second) * accessNormalizer;
       double usageWeight = static_cast<double>(cache->usage()) * usageNormalizer;
 
       TRI_ASSERT(accessWeight >= 0.0);
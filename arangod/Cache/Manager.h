@@ -37,12 +37,14 @@
 #include "Cache/TransactionManager.h"
 
 #include <stdint.h>
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <map>
 #include <memory>
 #include <stack>
 #include <utility>
+#include <vector>
 
 namespace arangodb {
 namespace cache {
@@ -85,8 +87,13 @@ class Manager {
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Initialize the manager with a scheduler post method and global
   /// usage limit.
+  ///
+  /// By default, rebalancing weighs the caches by how often they were accessed
+  /// recently. If rebalanceByUtility is true, they are instead weighed by how
+  /// many hits more memory would likely have gained them, see priorityList().
   //////////////////////////////////////////////////////////////////////////////
-  Manager(PostFn schedulerPost, uint64_t globalLimit, bool enableWindowedStats = true);
+  Manager(PostFn schedulerPost, uint64_t globalLimit, bool enableWindowedStats = true,
+          bool rebalanceByUtility = false);
   ~Manager();
 
   //////////////////////////////////////////////////////////////////////////////
@@ -100,10 +107,12 @@ class Manager {
   /// recent window in time, rather than over the full lifetime of the cache.
   /// The third parameter controls the maximum size of the cache over its
   /// lifetime. It should likely only be set to a non-default value for
-  /// infrequently accessed or short-lived caches.
+  /// infrequently accessed or short-lived caches. The fourth parameter enables
+  /// the admission filter of transactional caches, see TransactionalCache.
   //////////////////////////////////////////////////////////////////////////////
   std::shared_ptr<Cache> createCache(CacheType type, bool enableWindowedStats = false,
-                                     uint64_t maxSize = UINT64_MAX);
+                                     uint64_t maxSize = UINT64_MAX,
+                                     bool enableAdmissionFilter = false);
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Destroy the given cache.
@@ -140,6 +149,14 @@ class Manager {
   //////////////////////////////////////////////////////////////////////////////
   uint64_t globalAllocation();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Report the memory of all tables allocated on each NUMA node.
+  ///
+  /// Tables are allocated on the node of the thread requesting them, and spare
+  /// tables are handed out preferably to threads on the same node.
+  //////////////////////////////////////////////////////////////////////////////
+  std::vector<uint64_t> tableAllocationPerNode();
+
   std::pair<double, double> globalHitRates();
 
   //////////////////////////////////////////////////////////////////////////////
@@ -167,6 +184,7 @@ class Manager {
   // most libraries
   static constexpr uint64_t cacheRecordOverhead = sizeof(std::shared_ptr<Cache>) + 64;
   // assume at most 16 slots in each stack -- TODO: check validity
+  // per NUMA node
   static constexpr uint64_t tableListsOverhead = 32 * 16 * sizeof(std::shared_ptr<Cache>);
   static constexpr uint64_t triesFast = 100;
   static constexpr uint64_t triesSlow = 1000;
@@ -187,12 +205,25 @@ class Manager {
   basics::SharedCounter<64> _findHits;
   basics::SharedCounter<64> _findMisses;
 
+  // counters of each cache at the last rebalancing, for utility-based
+  // rebalancing
+  struct UtilityStats {
+    uint64_t misses = 0;
+    uint64_t inserts = 0;
+    uint64_t evictions = 0;
+    uint64_t rejections = 0;
+  };
+  bool const _rebalanceByUtility;
+  std::map<uint64_t, UtilityStats> _utilityStats;
+
   // registry to keep track of registered caches
   std::map<uint64_t, std::shared_ptr<Cache>> _caches;
   uint64_t _nextCacheId;
 
-  // actual tables to lease out
-  std::stack<std::shared_ptr<Table>> _tables[32];
+  // actual tables to lease out, per NUMA node and logSize
+  std::vector<std::array<std::stack<std::shared_ptr<Table>>, 32>> _tables;
+  // memory of leased and spare tables per NUMA node
+  std::vector<uint64_t> _tableAllocation;
 
   // global statistics
   uint64_t _globalSoftLimit;
@@ -263,6 +294,7 @@ class Manager {
   void resizeCache(TaskEnvironment environment, Cache* cache, uint64_t newLimit);
   void migrateCache(TaskEnvironment environment, Cache* cache, std::shared_ptr<Table>& table);
   std::shared_ptr<Table> leaseTable(uint32_t logSize);
+  void releaseTableMemory(std::shared_ptr<Table>& table);
   void reclaimTable(std::shared_ptr<Table> table, bool internal = false);
 
   // helpers for individual allocations
@@ -0,0 +1,95 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Cache/NumaNodes.h"
+#include "Basics/Common.h"
+
+#include <stdint.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+using namespace arangodb::cache;
+
+namespace {
+struct Topology {
+  uint32_t nodes = 1;
+  // node of each cpu, indexed by cpu number
+  std::vector<uint32_t> cpuNodes;
+
+  Topology() {
+#ifdef __linux__
+    for (uint32_t node = 0;; node++) {
+      std::ifstream in("/sys/devices/system/node/node" + std::to_string(node) +
+                       "/cpulist");
+      std::string list;
+      if (!in || !std::getline(in, list)) {
+        break;
+      }
+      nodes = node + 1;
+      // the list looks like "0-7,16-23"
+      std::stringstream ranges(list);
+      std::string range;
+      while (std::getline(ranges, range, ',')) {
+        size_t dash = range.find('-');
+        try {
+          uint32_t first = std::stoul(range.substr(0, dash));
+          uint32_t last =
+              (dash == std::string::npos) ? first : std::stoul(range.substr(dash + 1));
+          if (last >= cpuNodes.size()) {
+            cpuNodes.resize(last + 1, 0);
+          }
+          for (uint32_t cpu = first; cpu <= last; cpu++) {
+            cpuNodes[cpu] = node;
+          }
+        } catch (...) {
+          // ignore malformed ranges, these cpus will be reported as node 0
+        }
+      }
+    }
+#endif
+  }
+};
+
+Topology const& topology() {
+  static Topology const instance;
+  return instance;
+}
+}  // namespace
+
+uint32_t NumaNodes::count() { return ::topology().nodes; }
+
+uint32_t NumaNodes::current() {
+#ifdef __linux__
+  Topology const& t = ::topology();
+  if (t.nodes > 1) {
+    int cpu = sched_getcpu();
+    if (cpu >= 0 && static_cast<size_t>(cpu) < t.cpuNodes.size()) {
+      return t.cpuNodes[cpu];
+    }
+  }
+#endif
+  return 0;
+}
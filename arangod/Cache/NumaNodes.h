@@ -0,0 +1,56 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_CACHE_NUMA_NODES_H
+#define ARANGODB_CACHE_NUMA_NODES_H
+
+#include "Basics/Common.h"
+
+#include <stdint.h>
+
+namespace arangodb {
+namespace cache {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Detects the NUMA nodes of the machine.
+///
+/// The topology is read once from /sys/devices/system/node. On other
+/// platforms, or if it cannot be determined, there is a single node 0.
+////////////////////////////////////////////////////////////////////////////////
+struct NumaNodes {
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Returns the number of NUMA nodes, at least 1.
+  //////////////////////////////////////////////////////////////////////////////
+  static uint32_t count();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Returns the node of the CPU the calling thread is running on.
+  ///
+  /// Memory first touched by the calling thread is usually placed on this
+  /// node. The thread may be moved to another node at any time, so the result
+  /// is only a hint.
+  //////////////////////////////////////////////////////////////////////////////
+  static uint32_t current();
+};
+
+};  // end namespace cache
+};  // end namespace arangodb
+
+#endif
@@ -54,7 +54,7 @@ bool PlainBucket::isFull() const {
   bool hasEmptySlot = false;
   for (size_t i = 0; i < slotsData; i++) {
     size_t slot = slotsData - (i + 1);
-    if (_cachedHashes[slot] == 0) {
+    if (_cachedHashes[slot].load(std::memory_order_relaxed) == 0) {
       hasEmptySlot = true;
       break;
     }
@@ -68,10 +68,11 @@ CachedValue* PlainBucket::find(uint32_t hash, void const* key, size_t keySize, b
   CachedValue* result = nullptr;
 
   for (size_t i = 0; i < slotsData; i++) {
-    if (_cachedHashes[i] == 0) {
+    if (_cachedHashes[i].load(std::memory_order_relaxed) == 0) {
       break;
     }
-    if (_cachedHashes[i] == hash && _cachedData[i]->sameKey(key, keySize)) {
+    if (_cachedHashes[i].load(std::memory_order_relaxed) == hash &&
+        _cachedData[i]->sameKey(key, keySize)) {
       result = _cachedData[i];
       if (moveToFront) {
         moveSlot(i, true);
@@ -83,13 +84,30 @@ CachedValue* PlainBucket::find(uint32_t hash, void const* key, size_t keySize, b
   return result;
 }
 
+bool PlainBucket::lacks(uint32_t hash) const {
+  uint32_t snapshot;
+  if (!_state.beginOptimisticRead(snapshot)) {
+    return false;
+  }
+
+  // only the hashes are read, the values may be freed concurrently. all
+  // slots are checked, as they may be shifted concurrently
+  for (size_t i = 0; i < slotsData; i++) {
+    if (_cachedHashes[i].load(std::memory_order_relaxed) == hash) {
+      return false;
+    }
+  }
+
+  return _state.validateOptimisticRead(snapshot);
+}
+
 // requires there to be an open slot, otherwise will not be inserted
 void PlainBucket::insert(uint32_t hash, CachedValue* value) {
   TRI_ASSERT(isLocked());
   for (size_t i = 0; i < slotsData; i++) {
-    if (_cachedHashes[i] == 0) {
+    if (_cachedHashes[i].load(std::memory_order_relaxed) == 0) {
       // found an empty slot
-      _cachedHashes[i] = hash;
+      _cachedHashes[i].store(hash, std::memory_order_relaxed);
       _cachedData[i] = value;
       if (i != 0) {
         moveSlot(i, true);
@@ -130,7 +148,7 @@ void PlainBucket::evict(CachedValue* value, bool optimizeForInsertion) {
     size_t slot = slotsData - (i + 1);
     if (_cachedData[slot] == value) {
       // found a match
-      _cachedHashes[slot] = 0;
+      _cachedHashes[slot].store(0, std::memory_order_relaxed);
       _cachedData[slot] = nullptr;
       moveSlot(slot, optimizeForInsertion);
       return;
@@ -143,7 +161,7 @@ void PlainBucket::clear() {
   _state.clear();  // "clear" will keep the lock!
 
   for (size_t i = 0; i < slotsData; ++i) {
-    _cachedHashes[i] = 0;
+    _cachedHashes[i].store(0, std::memory_order_relaxed);
     _cachedData[i] = nullptr;
   }
 
@@ -152,22 +170,26 @@ void PlainBucket::clear() {
 
 void PlainBucket::moveSlot(size_t slot, bool moveToFront) {
   TRI_ASSERT(isLocked());
-  uint32_t hash = _cachedHashes[slot];
+  uint32_t hash = _cachedHashes[slot].load(std::memory_order_relaxed);
   CachedValue* value = _cachedData[slot];
   size_t i = slot;
   if (moveToFront) {
     // move slot to front
     for (; i >= 1; i--) {
-      _cachedHashes[i] = _cachedHashes[i - 1];
+      _cachedHashes[i].store(_cachedHashes[i - 1].load(std::memory_order_relaxed),
+                             std::memory_order_relaxed);
       _cachedData[i] = _cachedData[i - 1];
     }
   } else {
     // move slot to back
-    for (; (i < slotsData - 1) && (_cachedHashes[i + 1] != 0); i++) {
-      _cachedHashes[i] = _cachedHashes[i + 1];
+    for (; (i < slotsData - 1) &&
+           (_cachedHashes[i + 1].load(std::memory_order_relaxed) != 0);
+         i++) {
+      _cachedHashes[i].store(_cachedHashes[i + 1].load(std::memory_order_relaxed),
+                             std::memory_order_relaxed);
       _cachedData[i] = _cachedData[i + 1];
     }
   }
-  _cachedHashes[i] = hash;
+  _cachedHashes[i].store(hash, std::memory_order_relaxed);
   _cachedData[i] = value;
 }
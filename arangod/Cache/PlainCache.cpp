@@ -46,6 +46,14 @@ Finding PlainCache::find(void const* key, uint32_t keySize) {
   uint32_t hash = hashKey(key, keySize);
 
   Result status;
+  // misses are answered without locking the bucket, as far as possible
+  if (lacks(hash)) {
+    recordStat(Stat::findMiss);
+    status.reset(TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND);
+    result.reportError(status);
+    return result;
+  }
+
   PlainBucket* bucket;
   Table* source;
   std::tie(status, bucket, source) = getBucket(hash, Cache::triesFast);
@@ -89,6 +97,7 @@ Result PlainCache::insert(CachedValue* value) {
     if (candidate == nullptr) {
       allowed = false;
       status.reset(TRI_ERROR_ARANGO_BUSY);
+      reportInsertRejection();
     }
   }
 
@@ -118,6 +127,7 @@ Result PlainCache::insert(CachedValue* value) {
     } else {
       requestGrow();  // let function do the hard work
       status.reset(TRI_ERROR_RESOURCE_LIMIT);
+      reportInsertRejection();
     }
   }
 
@@ -198,6 +208,19 @@ PlainCache::~PlainCache() {
   }
 }
 
+void PlainCache::collectKey(void* bucketPtr, size_t slot, std::vector<std::string>& keys) {
+  auto bucket = reinterpret_cast<PlainBucket*>(bucketPtr);
+  if (slot >= PlainBucket::slotsData || !bucket->lock(Cache::triesFast)) {
+    return;
+  }
+  if (!bucket->isMigrated() &&
+      bucket->_cachedHashes[slot].load(std::memory_order_relaxed) != 0) {
+    CachedValue const* value = bucket->_cachedData[slot];
+    keys.emplace_back(reinterpret_cast<char const*>(value->key()), value->keySize());
+  }
+  bucket->unlock();
+}
+
 uint64_t PlainCache::freeMemoryFrom(uint32_t hash) {
   uint64_t reclaimed = 0;
   Result status;
@@ -246,8 +269,8 @@ void PlainCache::migrateBucket(void* sourcePtr, std::unique_ptr<Table::Subtable>
 
   for (size_t j = 0; j < PlainBucket::slotsData; j++) {
     size_t k = PlainBucket::slotsData - (j + 1);
-    if (source->_cachedHashes[k] != 0) {
-      uint32_t hash = source->_cachedHashes[k];
+    if (source->_cachedHashes[k].load(std::memory_order_relaxed) != 0) {
+      uint32_t hash = source->_cachedHashes[k].load(std::memory_order_relaxed);
       CachedValue* value = source->_cachedData[k];
 
       auto targetBucket = reinterpret_cast<PlainBucket*>(targets->fetchBucket(hash));
@@ -273,7 +296,7 @@ void PlainCache::migrateBucket(void* sourcePtr, std::unique_ptr<Table::Subtable>
         reclaimMemory(size);
       }
 
-      source->_cachedHashes[k] = 0;
+      source->_cachedHashes[k].store(0, std::memory_order_relaxed);
       source->_cachedData[k] = nullptr;
     }
   }
@@ -290,6 +313,25 @@ void PlainCache::migrateBucket(void* sourcePtr, std::unique_ptr<Table::Subtable>
   source->unlock();
 }
 
+bool PlainCache::lacks(uint32_t hash) {
+  Table* table = _table.load(std::memory_order_relaxed);
+  if (isShutdown() || table == nullptr) {
+    return false;
+  }
+
+  auto bucket = reinterpret_cast<PlainBucket*>(table->fetchBucket(hash, Cache::triesFast));
+  if (bucket == nullptr) {
+    return false;
+  }
+  bool lacking = bucket->lacks(hash);
+  table->releaseBucket();
+
+  if (lacking) {
+    _manager->reportAccess(_id);
+  }
+  return lacking;
+}
+
 std::tuple<Result, PlainBucket*, Table*> PlainCache::getBucket(uint32_t hash, uint64_t maxTries,
                                                                bool singleOperation) {
   Result status;
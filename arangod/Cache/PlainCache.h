@@ -111,8 +111,11 @@ class PlainCache final : public Cache {
   virtual uint64_t freeMemoryFrom(uint32_t hash) override;
   virtual void migrateBucket(void* sourcePtr, std::unique_ptr<Table::Subtable> targets,
                              std::shared_ptr<Table> newTable) override;
+  virtual void collectKey(void* bucketPtr, size_t slot,
+                          std::vector<std::string>& keys) override;
 
   // helpers
+  bool lacks(uint32_t hash);
   std::tuple<Result, PlainBucket*, Table*> getBucket(uint32_t hash, uint64_t maxTries,
                                                      bool singleOperation = true);
   uint32_t getIndex(uint32_t hash, bool useAuxiliary) const;
@@ -24,6 +24,7 @@
 #include "Cache/Table.h"
 #include "Basics/Common.h"
 #include "Cache/Common.h"
+#include "Cache/NumaNodes.h"
 
 #include <stdint.h>
 #include <memory>
@@ -95,7 +96,9 @@ Table::Table(uint32_t logSize)
       _auxiliary(nullptr),
       _bucketClearer(defaultClearer),
       _slotsTotal(_size),
-      _slotsUsed(static_cast<uint64_t>(0)) {
+      _slotsUsed(static_cast<uint64_t>(0)),
+      _sketch(nullptr),
+      _numaNode(NumaNodes::current()) {
   for (size_t i = 0; i < _size; i++) {
     // use placement new in order to properly initialize the bucket
     new (_buckets + i) GenericBucket();
@@ -109,6 +112,7 @@ Table::~Table() {
     // call dtor
     b->~GenericBucket();
   }
+  delete _sketch.load(std::memory_order_relaxed);
 }
 
 uint64_t Table::allocationSize(uint32_t logSize) {
@@ -153,6 +157,19 @@ std::pair<void*, Table*> Table::fetchAndLockBucket(uint32_t hash, uint64_t maxTr
   return std::make_pair(bucket, source);
 }
 
+void* Table::fetchBucket(uint32_t hash, uint64_t maxTries) {
+  if (!_lock.readLock(maxTries)) {
+    return nullptr;
+  }
+  if (_disabled) {
+    _lock.readUnlock();
+    return nullptr;
+  }
+  return &(_buckets[(hash & _mask) >> _shift]);
+}
+
+void Table::releaseBucket() { _lock.readUnlock(); }
+
 std::shared_ptr<Table> Table::setAuxiliary(std::shared_ptr<Table> table) {
   std::shared_ptr<Table> result = table;
   if (table.get() != this) {
@@ -221,6 +238,27 @@ void Table::clear() {
   }
   _bucketClearer = Table::defaultClearer;
   _slotsUsed = 0;
+  // the table may be reused by a cache without an admission filter. the
+  // table is disabled and all buckets were locked by the clearer, so
+  // nobody uses the sketch anymore
+  delete _sketch.exchange(nullptr, std::memory_order_acq_rel);
+}
+
+FrequencySketch* Table::sketch() {
+  FrequencySketch* sketch = _sketch.load(std::memory_order_acquire);
+  if (sketch == nullptr) {
+    std::unique_ptr<FrequencySketch> created;
+    try {
+      created.reset(new FrequencySketch(_size * Table::sketchEntriesPerBucket));
+    } catch (std::bad_alloc const&) {
+      return nullptr;
+    }
+    if (_sketch.compare_exchange_strong(sketch, created.get(), std::memory_order_acq_rel)) {
+      sketch = created.release();
+    }
+    // otherwise another thread was faster, and sketch now points to its one
+  }
+  return sketch;
 }
 
 void Table::disable() {
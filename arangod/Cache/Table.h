@@ -28,6 +28,7 @@
 #include "Basics/ReadWriteSpinLock.h"
 #include "Cache/BucketState.h"
 #include "Cache/Common.h"
+#include "Cache/FrequencySketch.h"
 
 #include <stdint.h>
 #include <memory>
@@ -47,6 +48,9 @@ class Table : public std::enable_shared_from_this<Table> {
   static constexpr uint32_t standardLogSizeAdjustment = 6;
   static constexpr uint64_t triesGuarantee = UINT64_MAX;
   static constexpr uint64_t padding = BUCKET_SIZE;
+  // entries the frequency sketch is sized for per bucket, about the number
+  // of slots
+  static constexpr uint64_t sketchEntriesPerBucket = 8;
 
   typedef std::function<void(void*)> BucketClearer;
 
@@ -116,6 +120,14 @@ class Table : public std::enable_shared_from_this<Table> {
   //////////////////////////////////////////////////////////////////////////////
   uint32_t logSize() const;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Returns the NUMA node the table was allocated on, see NumaNodes.
+  ///
+  /// The buckets are initialized by the constructing thread, so their memory
+  /// is usually placed on that thread's node.
+  //////////////////////////////////////////////////////////////////////////////
+  uint32_t numaNode() const { return _numaNode; }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Fetches a pointer to the bucket mapped by the given hash, and locks
   /// it.
@@ -128,6 +140,23 @@ class Table : public std::enable_shared_from_this<Table> {
   //////////////////////////////////////////////////////////////////////////////
   std::pair<void*, Table*> fetchAndLockBucket(uint32_t hash, uint64_t maxTries = UINT64_MAX);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Fetches a pointer to the primary bucket mapped by the given hash
+  /// without locking it, for an optimistic read.
+  ///
+  /// Returns nullptr if the table is disabled or could not be read-locked
+  /// within maxTries attempts. Otherwise, the table stays read-locked until
+  /// releaseBucket() is called, so that it is neither cleared nor released in
+  /// the meantime. The bucket itself may be modified concurrently and may also
+  /// be migrated, which the caller has to check via its state.
+  //////////////////////////////////////////////////////////////////////////////
+  void* fetchBucket(uint32_t hash, uint64_t maxTries = UINT64_MAX);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Releases the table after a successful fetchBucket().
+  //////////////////////////////////////////////////////////////////////////////
+  void releaseBucket();
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Sets the auxiliary table.
   ///
@@ -195,6 +224,17 @@ class Table : public std::enable_shared_from_this<Table> {
   //////////////////////////////////////////////////////////////////////////////
   uint32_t idealSize();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Returns the sketch of the access frequencies of the keys in this
+  /// table, for caches with an admission filter.
+  ///
+  /// The sketch is allocated on first use, so that tables of caches without
+  /// an admission filter do not pay for it, and freed when the table is
+  /// cleared. Its memory is not part of allocationSize(). Returns nullptr if
+  /// the sketch cannot be allocated.
+  //////////////////////////////////////////////////////////////////////////////
+  FrequencySketch* sketch();
+
  private:
   basics::ReadWriteSpinLock _lock;
   bool _disabled;
@@ -214,6 +254,10 @@ class Table : public std::enable_shared_from_this<Table> {
   uint64_t _slotsTotal;
   std::atomic<uint64_t> _slotsUsed;
 
+  std::atomic<FrequencySketch*> _sketch;
+
+  uint32_t const _numaNode;
+
  private:
   void disable();
   bool isEnabled(uint64_t maxTries = triesGuarantee);
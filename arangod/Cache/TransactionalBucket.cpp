@@ -79,7 +79,8 @@ CachedValue* TransactionalBucket::find(uint32_t hash, void const* key,
     if (_cachedData[i] == nullptr) {
       break;
     }
-    if (_cachedHashes[i] == hash && _cachedData[i]->sameKey(key, keySize)) {
+    if (_cachedHashes[i].load(std::memory_order_relaxed) == hash &&
+        _cachedData[i]->sameKey(key, keySize)) {
       result = _cachedData[i];
       if (moveToFront) {
         moveSlot(i, true);
@@ -91,6 +92,23 @@ CachedValue* TransactionalBucket::find(uint32_t hash, void const* key,
   return result;
 }
 
+bool TransactionalBucket::lacks(uint32_t hash) const {
+  uint32_t snapshot;
+  if (!_state.beginOptimisticRead(snapshot)) {
+    return false;
+  }
+
+  // only the hashes are read, the values may be freed concurrently. all
+  // slots are checked, as they may be shifted concurrently
+  for (size_t i = 0; i < slotsData; i++) {
+    if (_cachedHashes[i].load(std::memory_order_relaxed) == hash) {
+      return false;
+    }
+  }
+
+  return _state.validateOptimisticRead(snapshot);
+}
+
 void TransactionalBucket::insert(uint32_t hash, CachedValue* value) {
   TRI_ASSERT(isLocked());
   TRI_ASSERT(!isBlacklisted(hash));  // checks needs to be done outside
@@ -98,7 +116,7 @@ void TransactionalBucket::insert(uint32_t hash, CachedValue* value) {
   for (size_t i = 0; i < slotsData; i++) {
     if (_cachedData[i] == nullptr) {
       // found an empty slot
-      _cachedHashes[i] = hash;
+      _cachedHashes[i].store(hash, std::memory_order_relaxed);
       _cachedData[i] = value;
       if (i != 0) {
         moveSlot(i, true);
@@ -186,7 +204,7 @@ void TransactionalBucket::evict(CachedValue* value, bool optimizeForInsertion) {
     size_t slot = slotsData - (i + 1);
     if (_cachedData[slot] == value) {
       // found a match
-      _cachedHashes[slot] = 0;
+      _cachedHashes[slot].store(0, std::memory_order_relaxed);
       _cachedData[slot] = nullptr;
       moveSlot(slot, optimizeForInsertion);
       return;
@@ -202,7 +220,7 @@ void TransactionalBucket::clear() {
   }
   _blacklistTerm = 0;
   for (size_t i = 0; i < slotsData; ++i) {
-    _cachedHashes[i] = 0;
+    _cachedHashes[i].store(0, std::memory_order_relaxed);
     _cachedData[i] = nullptr;
   }
   _state.unlock();
@@ -222,23 +240,27 @@ void TransactionalBucket::updateBlacklistTerm(uint64_t term) {
 
 void TransactionalBucket::moveSlot(size_t slot, bool moveToFront) {
   TRI_ASSERT(isLocked());
-  uint32_t hash = _cachedHashes[slot];
+  uint32_t hash = _cachedHashes[slot].load(std::memory_order_relaxed);
   CachedValue* value = _cachedData[slot];
   size_t i = slot;
   if (moveToFront) {
     // move slot to front
     for (; i >= 1; i--) {
-      _cachedHashes[i] = _cachedHashes[i - 1];
+      _cachedHashes[i].store(_cachedHashes[i - 1].load(std::memory_order_relaxed),
+                             std::memory_order_relaxed);
       _cachedData[i] = _cachedData[i - 1];
     }
   } else {
     // move slot to back
-    for (; (i < slotsData - 1) && (_cachedHashes[i + 1] != 0); i++) {
-      _cachedHashes[i] = _cachedHashes[i + 1];
+    for (; (i < slotsData - 1) &&
+           (_cachedHashes[i + 1].load(std::memory_order_relaxed) != 0);
+         i++) {
+      _cachedHashes[i].store(_cachedHashes[i + 1].load(std::memory_order_relaxed),
+                             std::memory_order_relaxed);
       _cachedData[i] = _cachedData[i + 1];
     }
   }
-  _cachedHashes[i] = hash;
+  _cachedHashes[i].store(hash, std::memory_order_relaxed);
   _cachedData[i] = value;
 }
 
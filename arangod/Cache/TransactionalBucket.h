@@ -57,7 +57,9 @@ struct TransactionalBucket {
 
   // actual cached entries
   static constexpr size_t slotsData = 8;
-  uint32_t _cachedHashes[slotsData];
+  // atomic, because lacks() reads them without holding the lock. all
+  // accesses are relaxed, the ordering comes from the bucket state
+  std::atomic<uint32_t> _cachedHashes[slotsData];
   CachedValue* _cachedData[slotsData];
 
 // padding, if necessary?
@@ -114,6 +116,16 @@ struct TransactionalBucket {
   //////////////////////////////////////////////////////////////////////////////
   CachedValue* find(uint32_t hash, void const* key, size_t keySize, bool moveToFront = true);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Checks without locking whether the bucket has no entry with the
+  /// given hash.
+  ///
+  /// Returns true only if it is certain that there is no such entry. If the
+  /// bucket is or gets locked during the check, or if it was migrated, false
+  /// is returned and the bucket must be locked and searched via find().
+  //////////////////////////////////////////////////////////////////////////////
+  bool lacks(uint32_t hash) const;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Inserts a given value if it is not blacklisted. Requires state to
   /// be locked.
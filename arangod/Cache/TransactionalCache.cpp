@@ -47,6 +47,14 @@ Finding TransactionalCache::find(void const* key, uint32_t keySize) {
   uint32_t hash = hashKey(key, keySize);
 
   Result status;
+  // misses are answered without locking the bucket, as far as possible
+  if (lacks(hash)) {
+    recordStat(Stat::findMiss);
+    status.reset(TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND);
+    result.reportError(status);
+    return result;
+  }
+
   TransactionalBucket* bucket;
   Table* source;
   std::tie(status, bucket, source) = getBucket(hash, Cache::triesFast);
@@ -89,9 +97,10 @@ Result TransactionalCache::insert(CachedValue* value) {
 
     if (candidate == nullptr && bucket->isFull()) {
       candidate = bucket->evictionCandidate();
-      if (candidate == nullptr) {
+      if (candidate == nullptr || !admits(source, hash, candidate)) {
         allowed = false;
         status.reset(TRI_ERROR_ARANGO_BUSY);
+        reportInsertRejection();
       }
     }
 
@@ -121,6 +130,7 @@ Result TransactionalCache::insert(CachedValue* value) {
       } else {
         requestGrow();  // let function do the hard work
         status.reset(TRI_ERROR_RESOURCE_LIMIT);
+        reportInsertRejection();
       }
     }
   } else {
@@ -214,17 +224,20 @@ uint64_t TransactionalCache::allocationSize(bool enableWindowedStats) {
 std::shared_ptr<Cache> TransactionalCache::create(Manager* manager, uint64_t id,
                                                   Metadata&& metadata,
                                                   std::shared_ptr<Table> table,
-                                                  bool enableWindowedStats) {
+                                                  bool enableWindowedStats,
+                                                  bool enableAdmissionFilter) {
   return std::make_shared<TransactionalCache>(Cache::ConstructionGuard(),
-                                              manager, id, std::move(metadata),
-                                              table, enableWindowedStats);
+                                              manager, id, std::move(metadata), table,
+                                              enableWindowedStats, enableAdmissionFilter);
 }
 
 TransactionalCache::TransactionalCache(Cache::ConstructionGuard guard, Manager* manager,
                                        uint64_t id, Metadata&& metadata,
-                                       std::shared_ptr<Table> table, bool enableWindowedStats)
+                                       std::shared_ptr<Table> table, bool enableWindowedStats,
+                                       bool enableAdmissionFilter)
     : Cache(guard, manager, id, std::move(metadata), table, enableWindowedStats,
-            TransactionalCache::bucketClearer, TransactionalBucket::slotsData) {}
+            TransactionalCache::bucketClearer, TransactionalBucket::slotsData),
+      _admissionFilter(enableAdmissionFilter) {}
 
 TransactionalCache::~TransactionalCache() {
   if (!isShutdown()) {
@@ -236,6 +249,19 @@ TransactionalCache::~TransactionalCache() {
   }
 }
 
+void TransactionalCache::collectKey(void* bucketPtr, size_t slot, std::vector<std::string>& keys) {
+  auto bucket = reinterpret_cast<TransactionalBucket*>(bucketPtr);
+  if (slot >= TransactionalBucket::slotsData || !bucket->lock(Cache::triesFast)) {
+    return;
+  }
+  if (!bucket->isMigrated() &&
+      bucket->_cachedHashes[slot].load(std::memory_order_relaxed) != 0) {
+    CachedValue const* value = bucket->_cachedData[slot];
+    keys.emplace_back(reinterpret_cast<char const*>(value->key()), value->keySize());
+  }
+  bucket->unlock();
+}
+
 uint64_t TransactionalCache::freeMemoryFrom(uint32_t hash) {
   uint64_t reclaimed = 0;
   Result status;
@@ -326,7 +352,7 @@ void TransactionalCache::migrateBucket(void* sourcePtr,
   for (size_t j = 0; j < TransactionalBucket::slotsData; j++) {
     size_t k = TransactionalBucket::slotsData - (j + 1);
     if (source->_cachedData[k] != nullptr) {
-      uint32_t hash = source->_cachedHashes[k];
+      uint32_t hash = source->_cachedHashes[k].load(std::memory_order_relaxed);
       CachedValue* value = source->_cachedData[k];
 
       auto targetBucket =
@@ -359,7 +385,7 @@ void TransactionalCache::migrateBucket(void* sourcePtr,
         }
       }
 
-      source->_cachedHashes[k] = 0;
+      source->_cachedHashes[k].store(0, std::memory_order_relaxed);
       source->_cachedData[k] = nullptr;
     }
   }
@@ -376,6 +402,46 @@ void TransactionalCache::migrateBucket(void* sourcePtr,
   source->unlock();
 }
 
+bool TransactionalCache::lacks(uint32_t hash) {
+  Table* table = _table.load(std::memory_order_relaxed);
+  if (isShutdown() || table == nullptr) {
+    return false;
+  }
+
+  auto bucket = reinterpret_cast<TransactionalBucket*>(table->fetchBucket(hash, Cache::triesFast));
+  if (bucket == nullptr) {
+    return false;
+  }
+  if (_admissionFilter) {
+    // every lookup goes through here, so this is where the accesses are
+    // counted
+    FrequencySketch* sketch = table->sketch();
+    if (sketch != nullptr) {
+      sketch->record(hash);
+    }
+  }
+  bool lacking = bucket->lacks(hash);
+  table->releaseBucket();
+
+  if (lacking) {
+    _manager->reportAccess(_id);
+  }
+  return lacking;
+}
+
+bool TransactionalCache::admits(Table* source, uint32_t hash,
+                                CachedValue const* candidate) const {
+  if (!_admissionFilter) {
+    return true;
+  }
+  FrequencySketch const* sketch = source->sketch();
+  if (sketch == nullptr) {
+    return true;
+  }
+  return sketch->frequency(hash) >=
+         sketch->frequency(hashKey(candidate->key(), candidate->keySize()));
+}
+
 std::tuple<Result, TransactionalBucket*, Table*> TransactionalCache::getBucket(
     uint32_t hash, uint64_t maxTries, bool singleOperation) {
   Result status;
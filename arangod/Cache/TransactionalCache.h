@@ -58,12 +58,18 @@ namespace cache {
 /// This will prevent the cache from serving stale or potentially incorrect
 /// values and allow for clients to fall through to the backing transactional
 /// store.
+///
+/// With the admission filter enabled, the accesses of all keys are counted
+/// in a sketch, and a new value only evicts another one from a full bucket if
+/// its key was accessed at least as often. This keeps keys that are read only
+/// once, e.g. by a scan, from evicting hot entries.
 ////////////////////////////////////////////////////////////////////////////////
 class TransactionalCache final : public Cache {
  public:
   TransactionalCache(Cache::ConstructionGuard guard, Manager* manager,
                      uint64_t id, Metadata&& metadata,
-                     std::shared_ptr<Table> table, bool enableWindowedStats);
+                     std::shared_ptr<Table> table, bool enableWindowedStats,
+                     bool enableAdmissionFilter);
   ~TransactionalCache();
 
   TransactionalCache() = delete;
@@ -123,18 +129,25 @@ class TransactionalCache final : public Cache {
   static uint64_t allocationSize(bool enableWindowedStats);
   static std::shared_ptr<Cache> create(Manager* manager, uint64_t id, Metadata&& metadata,
                                        std::shared_ptr<Table> table,
-                                       bool enableWindowedStats);
+                                       bool enableWindowedStats, bool enableAdmissionFilter);
 
   virtual uint64_t freeMemoryFrom(uint32_t hash) override;
   virtual void migrateBucket(void* sourcePtr, std::unique_ptr<Table::Subtable> targets,
                              std::shared_ptr<Table> newTable) override;
+  virtual void collectKey(void* bucketPtr, size_t slot,
+                          std::vector<std::string>& keys) override;
 
   // helpers
+  bool lacks(uint32_t hash);
+  bool admits(Table* source, uint32_t hash, CachedValue const* candidate) const;
   std::tuple<Result, TransactionalBucket*, Table*> getBucket(uint32_t hash, uint64_t maxTries,
                                                              bool singleOperation = true);
   uint32_t getIndex(uint32_t hash, bool useAuxiliary) const;
 
   static Table::BucketClearer bucketClearer(Metadata* metadata);
+
+ private:
+  bool const _admissionFilter;
 };
 
 };  // end namespace cache
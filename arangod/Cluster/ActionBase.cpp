@@ -193,6 +193,8 @@ void ActionBase::toVelocyPack(VPackBuilder& builder) const {
     _description.toVelocyPack(builder);
   }
 
+  toVelocyPackDetails(builder);
+
 }  // MaintanceAction::toVelocityPack
 
 VPackBuilder ActionBase::toVelocyPack() const {
@@ -192,6 +192,10 @@ class ActionBase {
   /// @brief common initialization for all constructors
   void init();
 
+  /// @brief add action specific information to the VPackObject built by
+  ///  toVelocyPack()
+  virtual void toVelocyPackDetails(VPackBuilder& builder) const {}
+
   arangodb::MaintenanceFeature& _feature;
 
   ActionDescription _description;
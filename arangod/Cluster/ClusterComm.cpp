@@ -31,9 +31,11 @@
 #include "Cluster/ClusterInfo.h"
 #include "Cluster/ServerState.h"
 #include "GeneralServer/AuthenticationFeature.h"
+#include "GeneralServer/RestHandler.h"
 #include "Logger/Logger.h"
 #include "Scheduler/SchedulerFeature.h"
 #include "SimpleHttpClient/SimpleHttpCommunicatorResult.h"
+#include "Statistics/RequestStatistics.h"
 #include "Transaction/Methods.h"
 #include "VocBase/ticks.h"
 
@@ -42,6 +44,21 @@
 using namespace arangodb;
 using namespace arangodb::communicator;
 
+namespace {
+/// @brief adds the time spent waiting for other servers to the statistics
+/// of the request the current thread works on
+struct ClusterTimeRecorder {
+  ClusterTimeRecorder() : start(TRI_microtime()) {}
+  ~ClusterTimeRecorder() {
+    auto handler = rest::RestHandler::CURRENT_HANDLER;
+    if (handler != nullptr) {
+      RequestStatistics::ADD_CLUSTER_TIME(handler->statistics(), TRI_microtime() - start);
+    }
+  }
+  double const start;
+};
+}  // namespace
+
 /// @brief empty map with headers
 std::unordered_map<std::string, std::string> const ClusterCommRequest::noHeaders;
 
@@ -546,6 +563,7 @@ std::unique_ptr<ClusterCommResult> ClusterComm::syncRequest(
   }
 
   std::unique_ptr<HttpRequest> request(prepared.second);
+  ClusterTimeRecorder recorder;
 
   arangodb::basics::ConditionVariable cv;
   bool doLogConnectionErrors = logConnectionErrors();
@@ -659,6 +677,7 @@ ClusterCommResult const ClusterComm::wait(CoordTransactionID const coordTransact
   AsyncResponse response;
   bool match_good, status_ready;
   ClusterCommTimeout endTime = TRI_microtime() + timeout;
+  ClusterTimeRecorder recorder;
 
   TRI_ASSERT(timeout >= 0.0);
 
@@ -993,6 +1012,15 @@ std::pair<ClusterCommResult*, HttpRequest*> ClusterComm::prepareRequest(
   headersCopy[StaticStrings::HLCHeader] =
       arangodb::basics::HybridLogicalClock::encodeTimeStamp(timeStamp);
 
+  RequestStatistics const* stat =
+      rest::RestHandler::CURRENT_HANDLER == nullptr
+          ? nullptr
+          : rest::RestHandler::CURRENT_HANDLER->statistics();
+  if (stat != nullptr && stat->traced()) {
+    // the receiving server traces the request as part of ours
+    headersCopy[StaticStrings::Trace] = stat->traceHeader();
+  }
+
   auto state = ServerState::instance();
 
   if (state->isCoordinator() || state->isDBServer()) {
@@ -1016,10 +1044,17 @@ std::pair<ClusterCommResult*, HttpRequest*> ClusterComm::prepareRequest(
 #endif
 #endif
 
+  // bodies are JSON unless the caller explicitly sends VelocyPack
+  ContentType contentType = ContentType::JSON;
+  auto it = headersCopy.find(StaticStrings::ContentTypeHeader);
+  if (it != headersCopy.end() && it->second == StaticStrings::MimeTypeVPack) {
+    contentType = ContentType::VPACK;
+  }
+
   if (body == nullptr) {
-    request = HttpRequest::createHttpRequest(ContentType::JSON, "", 0, headersCopy);
+    request = HttpRequest::createHttpRequest(contentType, "", 0, headersCopy);
   } else {
-    request = HttpRequest::createHttpRequest(ContentType::JSON, body->data(),
+    request = HttpRequest::createHttpRequest(contentType, body->data(),
                                              body->size(), headersCopy);
   }
   request->setRequestType(reqtype);
@@ -1055,7 +1090,7 @@ void ClusterComm::disable() {
 }
 
 void ClusterComm::scheduleMe(std::function<void()> task) {
-  arangodb::SchedulerFeature::SCHEDULER->queue(RequestLane::CLUSTER_INTERNAL, task);
+  arangodb::SchedulerFeature::SCHEDULER->queue(RequestLane::CLUSTER_INTERNAL, std::move(task));
 }
 
 ClusterCommThread::ClusterCommThread() : Thread("ClusterComm"), _cc(nullptr) {
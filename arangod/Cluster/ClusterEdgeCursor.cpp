@@ -27,6 +27,7 @@
 #include "Cluster/ClusterTraverser.h"
 #include "Graph/ClusterTraverserCache.h"
 #include "Graph/TraverserCache.h"
+#include "Graph/TraverserOptions.h"
 #include "Transaction/Helpers.h"
 #include "Transaction/Methods.h"
 
@@ -55,6 +56,25 @@ ClusterEdgeCursor::ClusterEdgeCursor(arangodb::velocypack::StringRef vertexId, u
                         _cache->cache(), _edgeList, _cache->datalake(), *(leased.get()),
                         _cache->filteredDocuments(), _cache->insertedDocuments());
   _httpRequests += _cache->engines()->size();
+  static_cast<traverser::TraverserOptions const*>(_opts)->orderEdges(_edgeList);
+}
+
+// Traverser variant for many vertices
+ClusterEdgeCursor::ClusterEdgeCursor(VPackSlice vertexIds, uint64_t depth, graph::BaseOptions* opts)
+    : _position(0),
+      _resolver(opts->trx()->resolver()),
+      _opts(opts),
+      _cache(static_cast<ClusterTraverserCache*>(opts->cache())),
+      _httpRequests(0) {
+  TRI_ASSERT(_cache != nullptr);
+  TRI_ASSERT(vertexIds.isArray());
+  auto trx = _opts->trx();
+  transaction::BuilderLeaser leased(trx);
+
+  fetchEdgesFromEngines(trx->vocbase().name(), _cache->engines(), vertexIds, depth,
+                        _cache->cache(), _edgeList, _cache->datalake(), *(leased.get()),
+                        _cache->filteredDocuments(), _cache->insertedDocuments());
+  _httpRequests += _cache->engines()->size();
 }
 
 // ShortestPath variant
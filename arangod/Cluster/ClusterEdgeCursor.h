@@ -43,6 +43,8 @@ class ClusterEdgeCursor : public graph::EdgeCursor {
  public:
   // Traverser Variant
   ClusterEdgeCursor(arangodb::velocypack::StringRef vid, uint64_t, graph::BaseOptions*);
+  // Traverser Variant for an array of vertex ids, asks each DBServer once
+  ClusterEdgeCursor(arangodb::velocypack::Slice vertexIds, uint64_t, graph::BaseOptions*);
   // ShortestPath Variant
   ClusterEdgeCursor(arangodb::velocypack::StringRef vid, bool isBackward, graph::BaseOptions*);
 
@@ -28,6 +28,7 @@
 #include "Basics/files.h"
 #include "Cluster/ClusterComm.h"
 #include "Cluster/ClusterInfo.h"
+#include "Cluster/DocumentBatcher.h"
 #include "Cluster/HeartbeatThread.h"
 #include "Endpoint/Endpoint.h"
 #include "GeneralServer/AuthenticationFeature.h"
@@ -141,6 +142,20 @@ void ClusterFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
       "be created before giving up",
       new DoubleParameter(&_indexCreationTimeout),
       arangodb::options::makeFlags(arangodb::options::Flags::Hidden));
+
+  options->addOption(
+      "--cluster.document-batch-window",
+      "time (in microseconds) a coordinator waits for concurrent "
+      "single-document operations on the same shard, and a DB server for "
+      "concurrent synchronous replication of single-document operations to the "
+      "same follower, to send them together (0 = no batching)",
+      new UInt64Parameter(&_documentBatchWindow));
+
+  options->addOption(
+      "--cluster.max-document-batch-size",
+      "maximum number of single-document operations a coordinator or DB "
+      "server sends together",
+      new UInt64Parameter(&_maxDocumentBatchSize));
 }
 
 void ClusterFeature::validateOptions(std::shared_ptr<ProgramOptions> options) {
@@ -440,6 +455,11 @@ void ClusterFeature::start() {
 
   comm.increment("Current/Version");
 
+  if (role == ServerState::ROLE_COORDINATOR || role == ServerState::ROLE_DBSERVER) {
+    DocumentBatcher::initialize(std::chrono::microseconds(_documentBatchWindow),
+                                static_cast<size_t>(_maxDocumentBatchSize));
+  }
+
   ServerState::instance()->setState(ServerState::STATE_SERVING);
 }
 
@@ -523,6 +543,7 @@ void ClusterFeature::unprepare() {
 
   AgencyCommManager::MANAGER->stop();
 
+  DocumentBatcher::shutdown();
   ClusterInfo::cleanup();
 }
 
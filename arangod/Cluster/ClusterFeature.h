@@ -66,6 +66,8 @@ class ClusterFeature : public application_features::ApplicationFeature {
   uint32_t _systemReplicationFactor = 2;
   bool _createWaitsForSyncReplication = true;
   double _indexCreationTimeout = 3600.0;
+  uint64_t _documentBatchWindow = 0;
+  uint64_t _maxDocumentBatchSize = 100;
 
   void reportRole(ServerState::RoleEnum);
 
@@ -81,6 +81,18 @@ static inline bool hasError(VPackSlice const& slice) {
   return arangodb::basics::VelocyPackHelper::getBooleanValue(slice, "error", false);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether the "Views" part of a plan has views for the database
+////////////////////////////////////////////////////////////////////////////////
+
+static bool hasViews(VPackSlice const& planViews, std::string const& databaseName) {
+  if (!planViews.isObject()) {
+    return false;
+  }
+  VPackSlice views = planViews.get(databaseName);
+  return views.isObject() && views.length() > 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief extract the error message from a JSON
 ////////////////////////////////////////////////////////////////////////////////
@@ -145,6 +157,8 @@ ClusterInfo::ClusterInfo(AgencyCallbackRegistry* agencyCallbackRegistry)
       _uniqid() {
   _uniqid._currentValue = 1ULL;
   _uniqid._upperValue = 0ULL;
+  _uniqid._batchSize = MinIdsPerBatch;
+  _uniqid._lastFetch = 0.0;
 
   // Actual loading into caches is postponed until necessary
 }
@@ -197,12 +211,20 @@ uint64_t ClusterInfo::uniqid(uint64_t count) {
       oldValue = _uniqid._currentValue;
     }
 
-    // We need to fetch from the agency
+    // We need to fetch from the agency. if the previous batch was used
+    // up within a few seconds, fetch a bigger one to save round trips
 
     uint64_t fetch = count;
-
-    if (fetch < MinIdsPerBatch) {
-      fetch = MinIdsPerBatch;
+    {
+      MUTEX_LOCKER(mutexLocker, _idLock);
+      double const now = TRI_microtime();
+      if (now - _uniqid._lastFetch < 5.0) {
+        _uniqid._batchSize = std::min(_uniqid._batchSize * 2, MaxIdsPerBatch);
+      } else {
+        _uniqid._batchSize = MinIdsPerBatch;
+      }
+      _uniqid._lastFetch = now;
+      fetch = std::max(fetch, _uniqid._batchSize);
     }
 
     uint64_t result = _agency.uniqid(fetch, 0.0);
@@ -687,6 +709,19 @@ void ClusterInfo::loadPlan() {
 
     bool const isCoordinator = ServerState::instance()->isCoordinator();
 
+    // collections whose definition did not change since the last load are
+    // taken over from there instead of being rebuilt. _plan and
+    // _plannedCollections are only modified by this function, which is
+    // protected by a mutex, so we can read them without the lock
+    VPackSlice oldPlanCollectionsSlice;
+    VPackSlice oldPlanViewsSlice;
+    if (_plan != nullptr && _plan->slice().isObject()) {
+      oldPlanCollectionsSlice = _plan->slice().get("Collections");
+      oldPlanViewsSlice = _plan->slice().get("Views");
+    }
+    size_t numCollections = 0;
+    size_t numReused = 0;
+
     for (auto const& databasePairSlice : velocypack::ObjectIterator(planCollectionsSlice)) {
       auto const& collectionsSlice = databasePairSlice.value;
 
@@ -716,6 +751,18 @@ void ClusterInfo::loadPlan() {
         continue;
       }
 
+      // arangosearch links register with their views when the collection is
+      // created, and views are rebuilt on every load. so collections of
+      // databases with views are always rebuilt as well
+      VPackSlice oldCollectionsSlice;
+      auto oldDatabaseIt = _plannedCollections.end();
+      if (oldPlanCollectionsSlice.isObject() &&
+          !::hasViews(planViewsSlice, databaseName) &&
+          !::hasViews(oldPlanViewsSlice, databaseName)) {
+        oldCollectionsSlice = oldPlanCollectionsSlice.get(databaseName);
+        oldDatabaseIt = _plannedCollections.find(databaseName);
+      }
+
       for (auto const& collectionPairSlice : velocypack::ObjectIterator(collectionsSlice)) {
         auto const& collectionSlice = collectionPairSlice.value;
 
@@ -732,61 +779,77 @@ void ClusterInfo::loadPlan() {
 
         try {
           std::shared_ptr<LogicalCollection> newCollection;
+          ++numCollections;
 
-#if defined(USE_ENTERPRISE)
-          auto isSmart = collectionSlice.get(StaticStrings::IsSmart);
+          if (oldDatabaseIt != _plannedCollections.end() && oldCollectionsSlice.isObject()) {
+            VPackSlice oldCollectionSlice = oldCollectionsSlice.get(collectionId);
 
-          if (isSmart.isTrue()) {
-            auto type = collectionSlice.get(StaticStrings::DataSourceType);
+            if (oldCollectionSlice.isObject() && oldCollectionSlice.equals(collectionSlice)) {
+              auto it = (*oldDatabaseIt).second.find(collectionId);
 
-            if (type.isInteger() && type.getUInt() == TRI_COL_TYPE_EDGE) {
-              newCollection = std::make_shared<VirtualSmartEdgeCollection>(  // create collection
-                  *vocbase, collectionSlice, newPlanVersion  // args
-              );
-            } else {
-              newCollection = std::make_shared<SmartVertexCollection>(  // create collection
-                  *vocbase, collectionSlice, newPlanVersion  // args
-              );
+              if (it != (*oldDatabaseIt).second.end() && &(*it).second->vocbase() == vocbase) {
+                newCollection = (*it).second;
+                ++numReused;
+              }
             }
-          } else
-#endif
-          {
-            newCollection = std::make_shared<LogicalCollection>(  // create collection
-                *vocbase, collectionSlice, true, newPlanVersion  // args
-            );
           }
 
-          auto& collectionName = newCollection->name();
-
-          if (isCoordinator) {
-            // copying over index estimates from the old version of the
-            // collection into the new one
-            LOG_TOPIC("7a884", TRACE, Logger::CLUSTER) << "copying index estimates";
-
-            // it is effectively safe to access _plannedCollections in
-            // read-only mode here, as the only places that modify
-            // _plannedCollections are the shutdown and this function
-            // itself, which is protected by a mutex
-            auto it = _plannedCollections.find(databaseName);
-
-            if (it != _plannedCollections.end()) {
-              auto it2 = (*it).second.find(collectionId);
-
-              if (it2 != (*it).second.end()) {
-                try {
-                  auto estimates = (*it2).second->clusterIndexEstimates(false);
+          if (newCollection == nullptr) {
+#if defined(USE_ENTERPRISE)
+            auto isSmart = collectionSlice.get(StaticStrings::IsSmart);
+
+            if (isSmart.isTrue()) {
+              auto type = collectionSlice.get(StaticStrings::DataSourceType);
+
+              if (type.isInteger() && type.getUInt() == TRI_COL_TYPE_EDGE) {
+                newCollection = std::make_shared<VirtualSmartEdgeCollection>(  // create collection
+                    *vocbase, collectionSlice, newPlanVersion  // args
+                );
+              } else {
+                newCollection = std::make_shared<SmartVertexCollection>(  // create collection
+                    *vocbase, collectionSlice, newPlanVersion  // args
+                );
+              }
+            } else
+#endif
+            {
+              newCollection = std::make_shared<LogicalCollection>(  // create collection
+                  *vocbase, collectionSlice, true, newPlanVersion  // args
+              );
+            }
 
-                  if (!estimates.empty()) {
-                    // already have an estimate... now copy it over
-                    newCollection->setClusterIndexEstimates(std::move(estimates));
+            if (isCoordinator) {
+              // copying over index estimates from the old version of the
+              // collection into the new one
+              LOG_TOPIC("7a884", TRACE, Logger::CLUSTER) << "copying index estimates";
+
+              // it is effectively safe to access _plannedCollections in
+              // read-only mode here, as the only places that modify
+              // _plannedCollections are the shutdown and this function
+              // itself, which is protected by a mutex
+              auto it = _plannedCollections.find(databaseName);
+
+              if (it != _plannedCollections.end()) {
+                auto it2 = (*it).second.find(collectionId);
+
+                if (it2 != (*it).second.end()) {
+                  try {
+                    auto estimates = (*it2).second->clusterIndexEstimates(false);
+
+                    if (!estimates.empty()) {
+                      // already have an estimate... now copy it over
+                      newCollection->setClusterIndexEstimates(std::move(estimates));
+                    }
+                  } catch (...) {
+                    // this may fail during unit tests, when mocks are used
                   }
-                } catch (...) {
-                  // this may fail during unit tests, when mocks are used
                 }
               }
             }
           }
 
+          auto& collectionName = newCollection->name();
+
           // register with name as well as with id:
           databaseCollections.emplace(collectionName, newCollection);
           databaseCollections.emplace(collectionId, newCollection);
@@ -846,6 +909,9 @@ void ClusterInfo::loadPlan() {
 
       newCollections.emplace(std::make_pair(databaseName, databaseCollections));
     }
+    LOG_TOPIC("5e9b3", DEBUG, Logger::CLUSTER)
+        << "loadPlan: rebuilt " << (numCollections - numReused) << " of "
+        << numCollections << " collections";
     LOG_TOPIC("12dfa", DEBUG, Logger::CLUSTER)
       << "loadPlan done: wantedVersion=" << storedVersion
       << ", doneVersion=" << _planProt.doneVersion;
@@ -1006,21 +1072,53 @@ void ClusterInfo::loadCurrent() {
   if (currentCollectionsSlice.isObject()) {
     swapCollections = true;
 
+    // entries that did not change since the last load are taken over from
+    // there. _current and _currentCollections are only modified by this
+    // function, which is protected by a mutex, so we can read them without
+    // the lock
+    VPackSlice oldCollectionsSlice;
+    if (_current != nullptr && _current->slice().isObject()) {
+      oldCollectionsSlice = _current->slice().get("Collections");
+    }
+
     for (auto const& databaseSlice : velocypack::ObjectIterator(currentCollectionsSlice)) {
       auto const databaseName = databaseSlice.key.copyString();
       DatabaseCollectionsCurrent databaseCollections;
 
+      VPackSlice oldDatabaseSlice;
+      auto oldDatabaseIt = _currentCollections.end();
+      if (oldCollectionsSlice.isObject()) {
+        oldDatabaseSlice = oldCollectionsSlice.get(databaseName);
+        oldDatabaseIt = _currentCollections.find(databaseName);
+      }
+
       for (auto const& collectionSlice :
            velocypack::ObjectIterator(databaseSlice.value)) {
         auto const collectionName = collectionSlice.key.copyString();
 
-        auto collectionDataCurrent =
-            std::make_shared<CollectionInfoCurrent>(newCurrentVersion);
+        std::shared_ptr<CollectionInfoCurrent> collectionDataCurrent;
+        bool reused = false;
+
+        if (oldDatabaseIt != _currentCollections.end() && oldDatabaseSlice.isObject() &&
+            oldDatabaseSlice.get(collectionName).equals(collectionSlice.value)) {
+          auto it = (*oldDatabaseIt).second.find(collectionName);
+
+          if (it != (*oldDatabaseIt).second.end()) {
+            collectionDataCurrent = (*it).second;
+            reused = true;
+          }
+        }
+
+        if (!reused) {
+          collectionDataCurrent = std::make_shared<CollectionInfoCurrent>(newCurrentVersion);
+        }
 
         for (auto const& shardSlice : velocypack::ObjectIterator(collectionSlice.value)) {
           auto const shardID = shardSlice.key.copyString();
 
-          collectionDataCurrent->add(shardID, shardSlice.value);
+          if (!reused) {
+            collectionDataCurrent->add(shardID, shardSlice.value);
+          }
 
           // Note that we have only inserted the CollectionInfoCurrent under
           // the collection ID and not under the name! It is not possible
@@ -35,6 +35,7 @@
 #include "Basics/Mutex.h"
 #include "Basics/ReadLocker.h"
 #include "Basics/ReadWriteLock.h"
+#include "Basics/ScalableReadWriteLock.h"
 #include "Basics/Result.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/VelocyPackHelper.h"
@@ -679,7 +680,9 @@ class ClusterInfo final {
   // In addition, each group has two atomic version numbers, these are
   // used to prevent a stampede if multiple threads notice concurrently
   // that an update from the agency is necessary. Finally, there is a
-  // read/write lock which protects the actual data structure.
+  // read/write lock which protects the actual data structure. The data is
+  // read far more often than it is reloaded, so the lock lets readers
+  // proceed without writing to a shared cache line.
   // We encapsulate this protection in the struct ProtectionData:
 
   struct ProtectionData {
@@ -687,7 +690,7 @@ class ClusterInfo final {
     Mutex mutex;
     std::atomic<uint64_t> wantedVersion;
     std::atomic<uint64_t> doneVersion;
-    arangodb::basics::ReadWriteLock lock;
+    arangodb::basics::ScalableReadWriteLock lock;
 
     ProtectionData() : isValid(false), wantedVersion(0), doneVersion(0) {}
   };
@@ -764,6 +767,11 @@ class ClusterInfo final {
   struct {
     uint64_t _currentValue;
     uint64_t _upperValue;
+    /// @brief number of ids to fetch from the agency next time. grows while
+    /// batches are used up quickly, and falls back to MinIdsPerBatch
+    uint64_t _batchSize;
+    /// @brief time of the last fetch from the agency
+    double _lastFetch;
   } _uniqid;
 
   //////////////////////////////////////////////////////////////////////////////
@@ -783,6 +791,7 @@ class ClusterInfo final {
   //////////////////////////////////////////////////////////////////////////////
 
   static uint64_t const MinIdsPerBatch = 1000000;
+  static uint64_t const MaxIdsPerBatch = 64 * MinIdsPerBatch;
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief default wait timeout
@@ -31,8 +31,12 @@
 #include "Cluster/ClusterComm.h"
 #include "Cluster/ClusterInfo.h"
 #include "Cluster/ClusterTrxMethods.h"
+#include "Cluster/DocumentBatcher.h"
+#include "Futures/Utilities.h"
 #include "Graph/Traverser.h"
 #include "Indexes/Index.h"
+#include "Network/Methods.h"
+#include "Random/RandomGenerator.h"
 #include "Transaction/Context.h"
 #include "Transaction/Methods.h"
 #include "StorageEngine/TransactionCollection.h"
@@ -219,6 +223,31 @@ static void addTransactionHeaderForShard(transaction::Methods& trx,
     THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "couldnt find shard in shardMap");
   }
 }
+
+/// @brief destination for reading from a shard. this is the shard's leader,
+/// unless dirty reads are allowed, in which case a random in-sync replica
+/// is picked to spread the load
+static std::string readDestination(ClusterInfo* ci, ShardID const& shard,
+                                   bool allowDirtyReads) {
+  if (allowDirtyReads) {
+    auto servers = ci->getResponsibleServer(shard);
+    if (servers != nullptr && !servers->empty()) {
+      uint32_t pick = RandomGenerator::interval(static_cast<uint32_t>(servers->size() - 1));
+      return "server:" + (*servers)[pick];
+    }
+  }
+  return "shard:" + shard;
+}
+
+/// @brief whether a batched single-document operation failed on the DB
+/// server. errors in multi-document responses lack the attributes a
+/// single-document response has for some of them (_id, _key, _rev), so
+/// such operations are repeated on their own. they did not change anything
+static bool isBatchedDocumentError(DocumentBatcher::Result const& r) {
+  return r.error == TRI_ERROR_NO_ERROR && r.body != nullptr &&
+         r.body->slice().isObject() &&
+         r.body->slice().get(StaticStrings::Error).isTrue();
+}
 }  // namespace
 
 namespace arangodb {
@@ -865,44 +894,35 @@ int revisionOnCoordinator(std::string const& dbname,
                               // the DBserver could have reported an error.
 }
 
-int warmupOnCoordinator(std::string const& dbname, std::string const& cid) {
+futures::Future<Result> warmupOnCoordinator(std::string const& dbname,
+                                            std::string const& cid) {
   // Set a few variables needed for our work:
   ClusterInfo* ci = ClusterInfo::instance();
-  auto cc = ClusterComm::instance();
-  if (cc == nullptr) {
-    // nullptr happens only during controlled shutdown
-    return TRI_ERROR_SHUTTING_DOWN;
-  }
 
   // First determine the collection ID from the name:
   std::shared_ptr<LogicalCollection> collinfo;
   collinfo = ci->getCollectionNT(dbname, cid);
   if (collinfo == nullptr) {
-    return TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND;
+    return futures::makeFuture(Result(TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND));
   }
 
   // If we get here, the sharding attributes are not only _key, therefore
   // we have to contact everybody:
   std::shared_ptr<ShardMap> shards = collinfo->shardIds();
-  CoordTransactionID coordTransactionID = TRI_NewTickServer();
 
-  std::unordered_map<std::string, std::string> headers;
+  std::vector<futures::Future<network::Response>> futures;
+  futures.reserve(shards->size());
   for (auto const& p : *shards) {
-    cc->asyncRequest(coordTransactionID, "shard:" + p.first,
-                     arangodb::rest::RequestType::GET,
-                     "/_db/" + StringUtils::urlEncode(dbname) +
-                         "/_api/collection/" + StringUtils::urlEncode(p.first) +
-                         "/loadIndexesIntoMemory",
-                     std::shared_ptr<std::string const>(), headers, nullptr, 300.0);
+    futures.emplace_back(network::sendRequest("shard:" + p.first, fuerte::RestVerb::Get, dbname,
+                                              "/_api/collection/" + StringUtils::urlEncode(p.first) +
+                                                  "/loadIndexesIntoMemory",
+                                              VPackBuffer<uint8_t>(), network::Timeout(300.0)));
   }
 
   // Now listen to the results:
   // Well actually we don't care...
-  int count;
-  for (count = (int)shards->size(); count > 0; count--) {
-    auto res = cc->wait(coordTransactionID, 0, "", 0.0);
-  }
-  return TRI_ERROR_NO_ERROR;
+  return futures::collectAll(futures).thenValue(
+      [](std::vector<futures::Try<network::Response>>&&) { return Result(); });
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -913,11 +933,6 @@ int figuresOnCoordinator(std::string const& dbname, std::string const& collname,
                          std::shared_ptr<arangodb::velocypack::Builder>& result) {
   // Set a few variables needed for our work:
   ClusterInfo* ci = ClusterInfo::instance();
-  auto cc = ClusterComm::instance();
-  if (cc == nullptr) {
-    // nullptr happens only during controlled shutdown
-    return TRI_ERROR_SHUTTING_DOWN;
-  }
 
   // First determine the collection ID from the name:
   std::shared_ptr<LogicalCollection> collinfo;
@@ -929,40 +944,43 @@ int figuresOnCoordinator(std::string const& dbname, std::string const& collname,
   // If we get here, the sharding attributes are not only _key, therefore
   // we have to contact everybody:
   std::shared_ptr<ShardMap> shards = collinfo->shardIds();
-  CoordTransactionID coordTransactionID = TRI_NewTickServer();
 
-  std::unordered_map<std::string, std::string> headers;
+  std::vector<futures::Future<network::Response>> futures;
+  futures.reserve(shards->size());
   for (auto const& p : *shards) {
-    cc->asyncRequest(coordTransactionID, "shard:" + p.first,
-                     arangodb::rest::RequestType::GET,
-                     "/_db/" + StringUtils::urlEncode(dbname) +
-                         "/_api/collection/" + StringUtils::urlEncode(p.first) +
-                         "/figures",
-                     std::shared_ptr<std::string const>(), headers, nullptr, 300.0);
+    futures.emplace_back(network::sendRequest("shard:" + p.first, fuerte::RestVerb::Get, dbname,
+                                              "/_api/collection/" +
+                                                  StringUtils::urlEncode(p.first) + "/figures",
+                                              VPackBuffer<uint8_t>(), network::Timeout(300.0)));
   }
 
   // Now listen to the results:
-  int count;
-  int nrok = 0;
-  for (count = (int)shards->size(); count > 0; count--) {
-    auto res = cc->wait(coordTransactionID, 0, "", 0.0);
-    if (res.status == CL_COMM_RECEIVED) {
-      if (res.answer_code == arangodb::rest::ResponseCode::OK) {
-        VPackSlice answer = res.answer->payload();
+  auto responses = futures::collectAll(futures).get();
 
-        if (answer.isObject()) {
-          VPackSlice figures = answer.get("figures");
-          if (figures.isObject()) {
-            // add to the total
-            recursiveAdd(figures, result);
-          }
-          nrok++;
+  size_t nrok = 0;
+  for (auto& t : responses) {
+    if (!t.hasValue()) {
+      continue;
+    }
+    network::Response const& r = t.get();
+    if (r.statusCode() == fuerte::StatusOK) {
+      // an invalid body is a none slice here, and the shard counts as failed
+      VPackSlice answer = r.slice();
+
+      if (answer.isObject()) {
+        VPackSlice figures = answer.get("figures");
+        if (figures.isObject()) {
+          // add to the total
+          recursiveAdd(figures, result);
         }
+        nrok++;
       }
+    } else if (r.errorCode() == TRI_ERROR_SHUTTING_DOWN) {
+      return TRI_ERROR_SHUTTING_DOWN;
     }
   }
 
-  if (nrok != (int)shards->size()) {
+  if (nrok != shards->size()) {
     return TRI_ERROR_INTERNAL;
   }
 
@@ -1225,6 +1243,37 @@ Result createDocumentOnCoordinator(transaction::Methods& trx, std::string const&
 
   VPackBuilder reqBuilder;
 
+  // a single-document operation can be sent together with concurrent
+  // inserts into the same shard
+  DocumentBatcher* batcher = DocumentBatcher::instance();
+  if (!useMultiple && batcher != nullptr &&
+      trx.state()->hasHint(transaction::Hints::Hint::SINGLE_OPERATION)) {
+    TRI_ASSERT(shardMap.size() == 1);
+    auto const& it = *shardMap.begin();
+    auto idx = it.second.front();
+    VPackSlice document = slice;
+    if (!idx.second.empty()) {
+      reqBuilder.openObject();
+      reqBuilder.add(StaticStrings::KeyString, VPackValue(idx.second));
+      TRI_SanitizeObject(slice, reqBuilder);
+      reqBuilder.close();
+      document = reqBuilder.slice();
+    }
+
+    auto r = batcher->execute(arangodb::rest::RequestType::POST, it.first,
+                              baseUrl + StringUtils::urlEncode(it.first) + optsUrlPart,
+                              document);
+    if (r.error != TRI_ERROR_NO_ERROR) {
+      return r.error;
+    }
+    if (!isBatchedDocumentError(r)) {
+      responseCode = r.code;
+      resultBody.swap(r.body);
+      return TRI_ERROR_NO_ERROR;
+    }
+    // repeat as a single-document request to get its error response
+  }
+
   // Now prepare the requests:
   std::vector<ClusterCommRequest> requests;
   std::shared_ptr<std::string> body;
@@ -1692,6 +1741,10 @@ int getDocumentOnCoordinator(arangodb::transaction::Methods& trx, std::string co
 
   // lazily begin transactions on leaders
   const bool isManaged = trx.state()->hasHint(transaction::Hints::Hint::GLOBAL_MANAGED);
+
+  // followers can only answer reads that are not part of a transaction
+  // begun on the leaders
+  const bool dirtyReads = options.allowDirtyReads && !ClusterTrxMethods::isElCheapo(trx);
   
   // Some stuff to prepare cluster-internal requests:
 
@@ -1746,7 +1799,7 @@ int getDocumentOnCoordinator(arangodb::transaction::Methods& trx, std::string co
         }
 
         // We send to single endpoint
-        requests.emplace_back("shard:" + it.first, reqType,
+        requests.emplace_back(::readDestination(ci, it.first, dirtyReads), reqType,
                               baseUrl + StringUtils::urlEncode(it.first) + "/" +
                                   StringUtils::urlEncode(keySlice.copyString()) + optsUrlPart,
                               body, std::move(headers));
@@ -1761,7 +1814,7 @@ int getDocumentOnCoordinator(arangodb::transaction::Methods& trx, std::string co
         auto headers = std::make_unique<std::unordered_map<std::string, std::string>>();
         addTransactionHeaderForShard(trx, *shardIds, /*shard*/it.first, *headers);
         // We send to Babies endpoint
-        requests.emplace_back("shard:" + it.first, reqType,
+        requests.emplace_back(::readDestination(ci, it.first, dirtyReads), reqType,
                               baseUrl + StringUtils::urlEncode(it.first) + optsUrlPart,
                               body, std::move(headers));
       }
@@ -1825,7 +1878,7 @@ int getDocumentOnCoordinator(arangodb::transaction::Methods& trx, std::string co
       if (addMatch) {
         headers->emplace("if-match", slice.get(StaticStrings::RevString).copyString());
       }
-      requests.emplace_back("shard:" + shard, reqType,
+      requests.emplace_back(::readDestination(ci, shard, dirtyReads), reqType,
                             baseUrl + StringUtils::urlEncode(shard) + "/" +
                                 StringUtils::urlEncode(keySlice.copyString()) + optsUrlPart,
                             nullptr, std::move(headers));
@@ -1836,7 +1889,7 @@ int getDocumentOnCoordinator(arangodb::transaction::Methods& trx, std::string co
       ShardID const& shard = shardServers.first;
       auto headers = std::make_unique<std::unordered_map<std::string, std::string>>();
       addTransactionHeaderForShard(trx, *shardIds, shard, *headers);
-      requests.emplace_back("shard:" + shard, reqType,
+      requests.emplace_back(::readDestination(ci, shard, dirtyReads), reqType,
                             baseUrl + StringUtils::urlEncode(shard) + optsUrlPart,
                             body, std::move(headers));
     }
@@ -2426,6 +2479,9 @@ int modifyDocumentOnCoordinator(
     } else {
       optsUrlPart += "&mergeObjects=false";
     }
+    if (options.incrementNumbers) {
+      optsUrlPart += "&incrementNumbers=true";
+    }
   } else {
     reqType = arangodb::rest::RequestType::PUT;
   }
@@ -2450,6 +2506,32 @@ int modifyDocumentOnCoordinator(
       }
     }
     
+    // a single-document operation can be sent together with concurrent
+    // operations on the same shard. operations with a revision precondition
+    // are not, their conflicts report the current revision
+    DocumentBatcher* batcher = DocumentBatcher::instance();
+    bool const checksRevision =
+        !options.ignoreRevs && slice.hasKey(StaticStrings::RevString);
+    if (!useMultiple && batcher != nullptr && !checksRevision &&
+        trx.state()->hasHint(transaction::Hints::Hint::SINGLE_OPERATION)) {
+      TRI_ASSERT(shardMap.size() == 1);
+      if (!slice.get(StaticStrings::KeyString).isString()) {
+        return TRI_ERROR_ARANGO_DOCUMENT_KEY_BAD;
+      }
+      ShardID const& shard = shardMap.begin()->first;
+      auto r = batcher->execute(reqType, shard,
+                                baseUrl + StringUtils::urlEncode(shard) + optsUrlPart, slice);
+      if (r.error != TRI_ERROR_NO_ERROR) {
+        return r.error;
+      }
+      if (!isBatchedDocumentError(r)) {
+        responseCode = r.code;
+        resultBody.swap(r.body);
+        return TRI_ERROR_NO_ERROR;
+      }
+      // repeat as a single-document request to get its error response
+    }
+
     std::vector<ClusterCommRequest> requests;
     VPackBuilder reqBuilder;
     auto body = std::make_shared<std::string>();
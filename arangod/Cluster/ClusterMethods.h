@@ -27,6 +27,7 @@
 #include "Basics/Common.h"
 #include "Agency/AgencyComm.h"
 #include "Cluster/TraverserEngineRegistry.h"
+#include "Futures/Future.h"
 #include "Rest/HttpResponse.h"
 #include "VocBase/LogicalCollection.h"
 #include "VocBase/voc-types.h"
@@ -77,10 +78,12 @@ int revisionOnCoordinator(std::string const& dbname,
                           std::string const& collname, TRI_voc_rid_t&);
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief Warmup index caches on Shards
+/// @brief Warmup index caches on Shards. the future is resolved once all
+/// shards have answered
 ////////////////////////////////////////////////////////////////////////////////
 
-int warmupOnCoordinator(std::string const& dbname, std::string const& cid);
+futures::Future<Result> warmupOnCoordinator(std::string const& dbname,
+                                            std::string const& cid);
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief returns figures for a sharded collection
@@ -28,6 +28,7 @@
 #include "Cluster/ClusterMethods.h"
 #include "Graph/BreadthFirstEnumerator.h"
 #include "Graph/ClusterTraverserCache.h"
+#include "Graph/NeighborsEnumerator.h"
 #include "Graph/TraverserCache.h"
 #include "Transaction/Helpers.h"
 
@@ -75,7 +76,11 @@ void ClusterTraverser::setStartVertex(std::string const& vid) {
 
   _vertexGetter->reset(persId);
   if (_opts->useBreadthFirst) {
-    _enumerator.reset(new arangodb::graph::BreadthFirstEnumerator(this, idSlice, _opts));
+    if (_canUseOptimizedNeighbors) {
+      _enumerator.reset(new arangodb::graph::NeighborsEnumerator(this, idSlice, _opts));
+    } else {
+      _enumerator.reset(new arangodb::graph::BreadthFirstEnumerator(this, idSlice, _opts));
+    }
   } else {
     _enumerator.reset(new arangodb::traverser::DepthFirstEnumerator(this, vid, _opts));
   }
@@ -107,6 +112,14 @@ bool ClusterTraverser::getSingleVertex(arangodb::velocypack::Slice edge,
   return res;
 }
 
+void ClusterTraverser::prefetchVertices(std::vector<arangodb::velocypack::StringRef> const& ids) {
+  for (auto const& id : ids) {
+    if (_vertices.find(id) == _vertices.end()) {
+      _verticesToFetch.emplace(id);
+    }
+  }
+}
+
 void ClusterTraverser::fetchVertices() {
   auto ch = static_cast<ClusterTraverserCache*>(traverserCache());
   ch->insertedDocuments() += _verticesToFetch.size();
@@ -51,6 +51,9 @@ class ClusterTraverser final : public Traverser {
   ~ClusterTraverser() {}
 
   void setStartVertex(std::string const& id) override;
+
+  /// @brief the vertices are fetched with the next vertex that is not cached
+  void prefetchVertices(std::vector<arangodb::velocypack::StringRef> const&) override;
   
  protected:
   /// @brief Function to load the other sides vertex of an edge
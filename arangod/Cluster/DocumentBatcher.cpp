@@ -0,0 +1,279 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "DocumentBatcher.h"
+
+#include "Basics/Exceptions.h"
+#include "Basics/StaticStrings.h"
+#include "Basics/StringUtils.h"
+#include "Cluster/ClusterComm.h"
+#include "Cluster/ClusterMethods.h"
+#include "Cluster/ReplicationTimeoutFeature.h"
+#include "Cluster/ServerState.h"
+#include "Logger/Logger.h"
+#include "Rest/GeneralResponse.h"
+
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace {
+/// @brief timeout for batched requests, same as for single operations
+double const batchTimeout = 900.0;
+
+/// @brief sends a batch to a shard via ClusterComm
+DocumentBatcher::Result sendToShard(rest::RequestType type, std::string const& shard,
+                                    std::string const& url, VPackSlice documents) {
+  DocumentBatcher::Result result;
+
+  auto cc = ClusterComm::instance();
+  if (cc == nullptr) {
+    // nullptr happens only during controlled shutdown
+    result.error = TRI_ERROR_SHUTTING_DOWN;
+    return result;
+  }
+
+  std::vector<ClusterCommRequest> requests;
+  requests.emplace_back("shard:" + shard, type, url,
+                        std::make_shared<std::string>(documents.toJson()),
+                        std::make_unique<std::unordered_map<std::string, std::string>>());
+  cc->performRequests(requests, batchTimeout, Logger::COMMUNICATION,
+                      /*retryOnCollNotFound*/ true, /*retryOnBackUnavai*/ true);
+
+  auto const& res = requests[0].result;
+  result.error = handleGeneralCommErrors(&res);
+  if (result.error == TRI_ERROR_NO_ERROR) {
+    TRI_ASSERT(res.answer != nullptr);
+    result.code = res.answer_code;
+    result.body = res.answer->toVelocyPackBuilderPtrNoUniquenessChecks();
+  }
+  return result;
+}
+
+/// @brief sends a batch of synchronous replication operations to all
+/// followers of a shard in parallel. the destination is the comma-separated
+/// list of followers
+DocumentBatcher::Result sendToFollowers(rest::RequestType type, std::string const& destination,
+                                        std::string const& url, VPackSlice documents) {
+  DocumentBatcher::Result result;
+
+  auto cc = ClusterComm::instance();
+  if (cc == nullptr) {
+    // nullptr happens only during controlled shutdown
+    result.error = TRI_ERROR_SHUTTING_DOWN;
+    return result;
+  }
+
+  std::vector<std::string> followers = basics::StringUtils::split(destination, ',');
+  auto body = std::make_shared<std::string>(documents.toJson());
+
+  std::vector<ClusterCommRequest> requests;
+  requests.reserve(followers.size());
+  for (auto const& f : followers) {
+    requests.emplace_back("server:" + f, type, url, body,
+                          std::make_unique<std::unordered_map<std::string, std::string>>());
+  }
+
+  double const timeout = ReplicationTimeoutFeature::chooseTimeout(documents.length(),
+                                                                  body->size() * followers.size());
+  cc->performRequests(requests, timeout, Logger::REPLICATION, false);
+
+  // the bodies must outlive the answers pointing into them
+  std::vector<std::shared_ptr<VPackBuilder>> bodies;
+  std::vector<DocumentBatcher::FollowerAnswer> answers(requests.size());
+  for (size_t j = 0; j < requests.size(); ++j) {
+    auto const& req = requests[j];
+    if (req.done && req.result.status == CL_COMM_RECEIVED) {
+      TRI_ASSERT(req.result.answer != nullptr);
+      bodies.emplace_back(req.result.answer->toVelocyPackBuilderPtrNoUniquenessChecks());
+      answers[j].received = true;
+      answers[j].code = req.result.answer_code;
+      answers[j].body = bodies.back()->slice();
+    }
+  }
+
+  return DocumentBatcher::followerResult(followers, answers, documents.length());
+}
+}  // namespace
+
+std::unique_ptr<DocumentBatcher> DocumentBatcher::INSTANCE;
+
+DocumentBatcher::DocumentBatcher(std::chrono::microseconds window,
+                                 size_t maxBatchSize, SendFunction send)
+    : _window(window), _maxBatchSize(maxBatchSize), _send(std::move(send)), _numRequests(0) {
+  TRI_ASSERT(_maxBatchSize > 0);
+}
+
+DocumentBatcher::~DocumentBatcher() {
+  // all participants of a batch are inside execute(), so there cannot be
+  // any open batches left
+  TRI_ASSERT(_batches.empty());
+}
+
+void DocumentBatcher::initialize(std::chrono::microseconds window, size_t maxBatchSize) {
+  TRI_ASSERT(INSTANCE == nullptr);
+  if (window.count() > 0 && maxBatchSize > 1) {
+    INSTANCE = std::make_unique<DocumentBatcher>(window, maxBatchSize,
+                                                 ServerState::instance()->isCoordinator()
+                                                     ? ::sendToShard
+                                                     : ::sendToFollowers);
+  }
+}
+
+void DocumentBatcher::shutdown() { INSTANCE.reset(); }
+
+DocumentBatcher::Result DocumentBatcher::followerResult(std::vector<std::string> const& followers,
+                                                        std::vector<FollowerAnswer> const& answers,
+                                                        size_t numDocuments) {
+  TRI_ASSERT(followers.size() == answers.size());
+
+  Result result;
+  result.code = rest::ResponseCode::OK;
+  result.body = std::make_shared<VPackBuilder>();
+  result.body->openArray();
+  for (size_t i = 0; i < numDocuments; ++i) {
+    result.body->openObject();
+    for (size_t j = 0; j < answers.size(); ++j) {
+      int code = 0;
+      if (answers[j].received) {
+        code = static_cast<int>(answers[j].code);
+        VPackSlice answer = answers[j].body;
+        if (answer.isArray() && answer.length() == numDocuments) {
+          VPackSlice it = answer.at(i);
+          if (it.isObject() && it.get(StaticStrings::Error).isTrue()) {
+            VPackSlice num = it.get(StaticStrings::ErrorNum);
+            code = static_cast<int>(num.isNumber()
+                                        ? GeneralResponse::responseCode(num.getNumber<int>())
+                                        : rest::ResponseCode::SERVER_ERROR);
+          }
+        }
+      }
+      result.body->add(followers[j], VPackValue(code));
+    }
+    result.body->close();
+  }
+  result.body->close();
+  return result;
+}
+
+DocumentBatcher::Result DocumentBatcher::execute(rest::RequestType type,
+                                                 std::string const& destination,
+                                                 std::string const& url,
+                                                 VPackSlice document) {
+  // the url contains the collection or shard and all options of the
+  // operation
+  std::string key = std::to_string(static_cast<int>(type)) + ':' + destination + ':' + url;
+
+  std::unique_lock<std::mutex> guard(_mutex);
+
+  auto it = _batches.find(key);
+  if (it != _batches.end()) {
+    // join the open batch and wait for its leader to deliver our result
+    std::shared_ptr<Batch> batch = it->second;
+    size_t index = batch->size++;
+    batch->documents.add(document);
+    if (batch->size >= _maxBatchSize) {
+      // no one else can join, and the leader can send right away
+      batch->full = true;
+      _batches.erase(it);
+      batch->cv.notify_all();
+    }
+    batch->cv.wait(guard, [&batch]() { return batch->done; });
+    return std::move(batch->results[index]);
+  }
+
+  // open a new batch and lead it
+  auto batch = std::make_shared<Batch>();
+  batch->documents.openArray();
+  batch->documents.add(document);
+  batch->size = 1;
+  _batches.emplace(key, batch);
+
+  batch->cv.wait_for(guard, _window, [&batch]() { return batch->full; });
+  if (!batch->full) {
+    // still registered, close it for newcomers
+    _batches.erase(key);
+  }
+  guard.unlock();
+
+  // the batch is not reachable for others anymore, so we can work on
+  // it without holding the lock
+  batch->documents.close();
+  send(*batch, type, destination, url);
+
+  guard.lock();
+  batch->done = true;
+  guard.unlock();
+  batch->cv.notify_all();
+
+  return std::move(batch->results[0]);
+}
+
+void DocumentBatcher::send(Batch& batch, rest::RequestType type,
+                           std::string const& destination, std::string const& url) {
+  Result result;
+  try {
+    _numRequests.fetch_add(1, std::memory_order_relaxed);
+    result = _send(type, destination, url, batch.documents.slice());
+  } catch (basics::Exception const& ex) {
+    result.error = ex.code();
+  } catch (std::bad_alloc const&) {
+    result.error = TRI_ERROR_OUT_OF_MEMORY;
+  } catch (...) {
+    result.error = TRI_ERROR_INTERNAL;
+  }
+
+  batch.results.resize(batch.size);
+
+  VPackSlice body;
+  if (result.error == TRI_ERROR_NO_ERROR && result.body != nullptr) {
+    body = result.body->slice();
+  }
+
+  if (!body.isArray() || body.length() != batch.size) {
+    // the request failed as a whole, so it failed for everyone
+    for (auto& r : batch.results) {
+      r.error = result.error;
+      r.code = result.code;
+      if (result.body != nullptr) {
+        r.body = std::make_shared<VPackBuilder>(result.body->slice());
+      }
+    }
+    return;
+  }
+
+  // hand out the individual results, turning per-document errors into the
+  // response a single-document request would have gotten
+  size_t i = 0;
+  for (VPackSlice it : VPackArrayIterator(body)) {
+    Result& r = batch.results[i++];
+    r.code = result.code;
+    if (it.isObject() && it.get(StaticStrings::Error).isTrue()) {
+      VPackSlice num = it.get(StaticStrings::ErrorNum);
+      if (num.isNumber() && num.getNumber<int>() != TRI_ERROR_NO_ERROR) {
+        r.code = GeneralResponse::responseCode(num.getNumber<int>());
+      } else {
+        r.code = rest::ResponseCode::SERVER_ERROR;
+      }
+    }
+    r.body = std::make_shared<VPackBuilder>(it);
+  }
+}
@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef ARANGOD_CLUSTER_DOCUMENT_BATCHER_H
+#define ARANGOD_CLUSTER_DOCUMENT_BATCHER_H 1
+
+#include "Basics/Common.h"
+#include "Rest/CommonDefines.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+namespace arangodb {
+
+/// @brief combines concurrent single-document write operations that go to
+/// the same destination with the same options into one multi-document
+/// request. on coordinators the destination is a shard, on DB servers it is
+/// a follower that single-document operations are synchronously replicated
+/// to. the first operation for a destination opens a batch and waits for at
+/// most the configured window for more operations to join, then sends the
+/// batch and hands each participant its own part of the response.
+class DocumentBatcher {
+ public:
+  /// @brief result of one operation
+  struct Result {
+    /// @brief communication error, if any. if set, code and body are unused
+    int error = TRI_ERROR_NO_ERROR;
+    rest::ResponseCode code = rest::ResponseCode::SERVER_ERROR;
+    std::shared_ptr<velocypack::Builder> body;
+  };
+
+  /// @brief sends a multi-document request with the given array of documents
+  /// to the destination. the result body must be an array with one entry per
+  /// document, unless the request failed as a whole
+  typedef std::function<Result(rest::RequestType, std::string const& destination,
+                               std::string const& url, velocypack::Slice documents)>
+      SendFunction;
+
+  /// @brief answer of a follower to a batch of synchronous replication
+  /// operations
+  struct FollowerAnswer {
+    bool received = false;
+    rest::ResponseCode code = rest::ResponseCode::SERVER_ERROR;
+    velocypack::Slice body;
+  };
+
+  DocumentBatcher(std::chrono::microseconds window, size_t maxBatchSize, SendFunction send);
+  ~DocumentBatcher();
+
+  DocumentBatcher(DocumentBatcher const&) = delete;
+  DocumentBatcher& operator=(DocumentBatcher const&) = delete;
+
+  /// @brief execute a single-document operation as part of a batch. the url
+  /// must be the one of the multi-document variant of the operation. blocks
+  /// until the result is available
+  Result execute(rest::RequestType type, std::string const& destination,
+                 std::string const& url, velocypack::Slice document);
+
+  /// @brief number of requests sent so far
+  uint64_t numRequests() const { return _numRequests.load(std::memory_order_relaxed); }
+
+  /// @brief global instance, nullptr if batching is turned off
+  static DocumentBatcher* instance() { return INSTANCE.get(); }
+  static void initialize(std::chrono::microseconds window, size_t maxBatchSize);
+  static void shutdown();
+
+  /// @brief the result of a batch of synchronous replication operations,
+  /// with one answer per follower. the result has one object per document,
+  /// which maps each follower to the response code it gave for the
+  /// document, or to 0 if it did not answer
+  static Result followerResult(std::vector<std::string> const& followers,
+                               std::vector<FollowerAnswer> const& answers,
+                               size_t numDocuments);
+
+ private:
+  struct Batch {
+    velocypack::Builder documents;
+    size_t size = 0;
+    bool full = false;
+    bool done = false;
+    std::condition_variable cv;
+    std::vector<Result> results;
+  };
+
+  void send(Batch& batch, rest::RequestType type, std::string const& destination,
+            std::string const& url);
+
+ private:
+  static std::unique_ptr<DocumentBatcher> INSTANCE;
+
+  std::chrono::microseconds const _window;
+  size_t const _maxBatchSize;
+  SendFunction const _send;
+
+  std::mutex _mutex;
+  /// @brief open batches, by request type, destination and url
+  std::unordered_map<std::string, std::shared_ptr<Batch>> _batches;
+
+  std::atomic<uint64_t> _numRequests;
+};
+
+}  // namespace arangodb
+
+#endif
@@ -357,6 +357,26 @@ void handleLocalShard(std::string const& dbname, std::string const& colname,
   }
 }
 
+/// @brief Check if there are errors for a database or any of its shards
+/// and indexes
+static bool hasErrors(MaintenanceFeature::errors_t const& errors, std::string const& dbname) {
+  if (errors.databases.find(dbname) != errors.databases.end()) {
+    return true;
+  }
+  std::string const prefix = dbname + "/";
+  for (auto const& shard : errors.shards) {
+    if (shard.first.compare(0, prefix.size(), prefix) == 0) {
+      return true;
+    }
+  }
+  for (auto const& shard : errors.indexes) {
+    if (shard.first.compare(0, prefix.size(), prefix) == 0 && !shard.second.empty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
 /// @brief Get a map shardName -> servers
 VPackBuilder getShardMap(VPackSlice const& plan) {
   VPackBuilder shardMap;
@@ -422,12 +442,25 @@ arangodb::Result arangodb::maintenance::diffPlanLocal(
     }
   }
 
+  // A database for which the last comparison produced no actions, and for
+  // which neither Plan nor Local have changed since, is in sync and does
+  // not need to be compared again. The result for one database does not
+  // depend on any other database, as shard names are globally unique.
+  std::unordered_set<std::string> inSync;
+  std::unordered_map<std::string, std::pair<uint64_t, size_t>> compared;  // fingerprint, #actions
+
   // Create or modify if local collections are affected
   pdbs = plan.get(COLLECTIONS);
   for (auto const& pdb : VPackObjectIterator(pdbs)) {  // for each db in Plan
     auto const& dbname = pdb.key.copyString();
     if (local.hasKey(dbname)) {  // have database in both
       auto const& ldb = local.get(dbname);
+      uint64_t const fingerprint = pdb.value.hash(ldb.hash(std::hash<std::string>()(serverId)));
+      if (!hasErrors(errors, dbname) && feature.isInSync(dbname, fingerprint)) {
+        inSync.emplace(dbname);
+        continue;
+      }
+      size_t const numActions = actions.size();
       for (auto const& pcol : VPackObjectIterator(pdb.value)) {  // for each plan collection
         auto const& cprops = pcol.value;
         for (auto const& shard : VPackObjectIterator(cprops.get(SHARDS))) {  // for each shard in plan collection
@@ -447,6 +480,7 @@ arangodb::Result arangodb::maintenance::diffPlanLocal(
           }  // else if(!shard.value.isArray()) - intentionally do nothing
         }
       }
+      compared.emplace(dbname, std::make_pair(fingerprint, actions.size() - numActions));
     }
   }
 
@@ -457,12 +491,21 @@ arangodb::Result arangodb::maintenance::diffPlanLocal(
   auto const shardMap = getShardMap(pdbs);             // plan shards -> servers
   for (auto const& db : VPackObjectIterator(local)) {  // for each local databases
     auto const& dbname = db.key.copyString();
-    if (pdbs.hasKey(dbname)) {                                // if in plan
+    if (pdbs.hasKey(dbname) && inSync.find(dbname) == inSync.end()) {  // if in plan
+      size_t const numActions = actions.size();
       for (auto const& sh : VPackObjectIterator(db.value)) {  // for each local shard
         std::string shName = sh.key.copyString();
         handleLocalShard(dbname, shName, sh.value, shardMap.slice(),
                          commonShrds, indis, serverId, actions);
       }
+      auto const it = compared.find(dbname);
+      if (it != compared.end()) {
+        // a previous failure suppresses actions, but the database is not in
+        // sync and must be compared again once the error is gone
+        feature.setInSync(dbname, it->second.first,
+                          it->second.second == 0 && actions.size() == numActions &&
+                              !hasErrors(errors, dbname));
+      }
     }
   }
 
@@ -1104,6 +1147,11 @@ arangodb::Result arangodb::maintenance::syncReplicatedShardsWithLeaders(
               continue;
             }
 
+            // shards whose leader is the only copy in sync are the most
+            // endangered ones and are synchronized first
+            int const priority = cservers.length() <= 1 ? SYNCHRONIZE_URGENT_PRIORITY
+                                                        : SYNCHRONIZE_PRIORITY;
+
             auto const leader = pservers[0].copyString();
             actions.emplace_back(ActionDescription(
                 {{NAME, "SynchronizeShard"},
@@ -1111,7 +1159,7 @@ arangodb::Result arangodb::maintenance::syncReplicatedShardsWithLeaders(
                  {COLLECTION, colname},
                  {SHARD, shname},
                  {THE_LEADER, leader},
-                 {SHARD_VERSION, std::to_string(feature.shardVersion(shname))}}, SYNCHRONIZE_PRIORITY));
+                 {SHARD_VERSION, std::to_string(feature.shardVersion(shname))}}, priority));
           }
         }
       }
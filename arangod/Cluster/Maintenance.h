@@ -48,6 +48,8 @@ constexpr int RESIGN_PRIORITY = 3;
 // For non fast track:
 constexpr int INDEX_PRIORITY = 2;
 constexpr int SYNCHRONIZE_PRIORITY = 1;
+// synchronizing shards without any in-sync follower goes first:
+constexpr int SYNCHRONIZE_URGENT_PRIORITY = 2;
 
 using Transactions = std::vector<std::pair<VPackBuilder, VPackBuilder>>;
 
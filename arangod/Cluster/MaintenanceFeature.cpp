@@ -35,6 +35,8 @@
 #include "Cluster/ServerState.h"
 #include "Random/RandomGenerator.h"
 
+#include <thread>
+
 using namespace arangodb;
 using namespace arangodb::application_features;
 using namespace arangodb::options;
@@ -46,7 +48,8 @@ const uint32_t MaintenanceFeature::maxThreadLimit = 64;
 MaintenanceFeature::MaintenanceFeature(application_features::ApplicationServer& server)
     : ApplicationFeature(server, "Maintenance"),
       _forceActivation(false),
-      _maintenanceThreadsMax(2) {
+      _maintenanceThreadsMax(2),
+      _syncBandwidth(0) {
   // the number of threads will be adjusted later. it's just that we want to
   // initialize all members properly
 
@@ -97,6 +100,13 @@ void MaintenanceFeature::collectOptions(std::shared_ptr<ProgramOptions> options)
       new Int32Parameter(&_secondsActionsLinger),
       arangodb::options::makeFlags(arangodb::options::Flags::Hidden));
 
+  options->addOption(
+      "--server.maintenance-sync-bandwidth",
+      "maximum number of bytes per second all shard synchronizations may "
+      "receive together (0 = unlimited)",
+      new UInt64Parameter(&_syncBandwidth),
+      arangodb::options::makeFlags(arangodb::options::Flags::Hidden));
+
 }  // MaintenanceFeature::collectOptions
 
 void MaintenanceFeature::validateOptions(std::shared_ptr<ProgramOptions> options) {
@@ -749,3 +759,51 @@ void MaintenanceFeature::delShardVersion(std::string const& shname) {
     _shardVersion.erase(it);
   }
 }
+
+bool MaintenanceFeature::isInSync(std::string const& database, uint64_t fingerprint) const {
+  MUTEX_LOCKER(guard, _inSyncLock);
+  auto const it = _inSyncDatabases.find(database);
+  return (it != _inSyncDatabases.end() && it->second == fingerprint);
+}
+
+void MaintenanceFeature::setInSync(std::string const& database, uint64_t fingerprint, bool inSync) {
+  MUTEX_LOCKER(guard, _inSyncLock);
+  if (inSync) {
+    _inSyncDatabases[database] = fingerprint;
+  } else {
+    _inSyncDatabases.erase(database);
+  }
+}
+
+void MaintenanceFeature::throttleSynchronization(uint64_t bytes) {
+  if (_syncBandwidth == 0 || bytes == 0) {
+    return;
+  }
+
+  // received data may exceed the bandwidth by up to one second worth of
+  // bytes before anyone has to wait
+  auto const burst = std::chrono::seconds(1);
+  auto const now = std::chrono::steady_clock::now();
+  auto const cost = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<double>(static_cast<double>(bytes) /
+                                    static_cast<double>(_syncBandwidth)));
+
+  std::chrono::steady_clock::time_point wakeup;
+  {
+    MUTEX_LOCKER(guard, _syncThrottleLock);
+    _syncThrottleDue = (std::max)(_syncThrottleDue, now) + cost;
+    wakeup = _syncThrottleDue - burst;
+  }
+
+  // sleep in small steps, so that we do not delay a shutdown
+  while (!isShuttingDown()) {
+    auto const left = wakeup - std::chrono::steady_clock::now();
+    if (left <= std::chrono::steady_clock::duration::zero()) {
+      break;
+    }
+    std::this_thread::sleep_for(
+        (std::min)(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                       std::chrono::milliseconds(100)),
+                   left));
+  }
+}
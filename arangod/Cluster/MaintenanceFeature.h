@@ -32,6 +32,7 @@
 #include "Cluster/MaintenanceWorker.h"
 #include "ProgramOptions/ProgramOptions.h"
 
+#include <chrono>
 #include <queue>
 
 namespace arangodb {
@@ -312,6 +313,30 @@ class MaintenanceFeature : public application_features::ApplicationFeature {
    */
   void delShardVersion(std::string const& shardId);
 
+  /**
+   * @brief check if the last comparison of Plan and Local for a database
+   *        was done for the same input and produced no actions
+   * @param  database     Database name
+   * @param  fingerprint  Hash of the Plan and Local parts of the database
+   */
+  bool isInSync(std::string const& database, uint64_t fingerprint) const;
+
+  /**
+   * @brief remember the result of comparing Plan and Local for a database
+   * @param  database     Database name
+   * @param  fingerprint  Hash of the Plan and Local parts of the database
+   * @param  inSync       Whether the comparison produced no actions
+   */
+  void setInSync(std::string const& database, uint64_t fingerprint, bool inSync);
+
+  /**
+   * @brief account for data received by a shard synchronization and wait
+   *        as long as needed to keep all synchronizations together within
+   *        the configured bandwidth
+   * @param  bytes  Number of bytes just received from a leader
+   */
+  void throttleSynchronization(uint64_t bytes);
+
  protected:
   /// @brief common code used by multiple constructors
   void init();
@@ -338,6 +363,10 @@ class MaintenanceFeature : public application_features::ApplicationFeature {
   /// @brief tunable option for thread pool size
   uint32_t _maintenanceThreadsMax;
 
+  /// @brief tunable option for the bandwidth (bytes per second) that all
+  ///  shard synchronizations may use together, 0 means unlimited
+  uint64_t _syncBandwidth;
+
   /// @brief tunable option for number of seconds COMPLETE or FAILED actions block
   ///  duplicates from adding to _actionRegistry
   int32_t _secondsActionsBlock;
@@ -414,6 +443,19 @@ class MaintenanceFeature : public application_features::ApplicationFeature {
   /// @brief shards have versions in order to be able to distinguish between
   /// independant actions
   std::unordered_map<std::string, size_t> _shardVersion;
+
+  /// @brief lock for in sync database map
+  mutable arangodb::Mutex _inSyncLock;
+  /// @brief fingerprints of databases whose last comparison of Plan and
+  /// Local produced no actions
+  std::unordered_map<std::string, uint64_t> _inSyncDatabases;
+
+  /// @brief lock for the synchronization bandwidth budget
+  arangodb::Mutex _syncThrottleLock;
+  /// @brief point in time at which all data received by shard
+  /// synchronizations so far would have been transferred at the
+  /// configured bandwidth
+  std::chrono::steady_clock::time_point _syncThrottleDue;
 };
 
 }  // namespace arangodb
@@ -61,4 +61,21 @@ void ReplicationTimeoutFeature::prepare() {
   lowerLimit = EngineSelectorFeature::ENGINE->minimumSyncReplicationTimeout();
 }
 
+double ReplicationTimeoutFeature::chooseTimeout(size_t count, size_t totalBytes) {
+  // We usually assume that a server can process at least 2500 documents
+  // per second (this is a low estimate), and use a low limit of 0.5s
+  // and a high timeout of 120s
+  double timeout = count / 2500.0;
+
+  // Really big documents need additional adjustment. Using total size
+  // of all messages to handle worst case scenario of constrained resource
+  // processing all
+  timeout += (totalBytes / 4096) * timeoutPer4k;
+
+  if (timeout < lowerLimit) {
+    return lowerLimit * timeoutFactor;
+  }
+  return (std::min)(120.0, timeout) * timeoutFactor;
+}
+
 }  // namespace arangodb
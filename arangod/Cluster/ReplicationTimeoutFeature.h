@@ -37,6 +37,10 @@ class ReplicationTimeoutFeature : public application_features::ApplicationFeatur
   void collectOptions(std::shared_ptr<options::ProgramOptions>) override final;
   void prepare() override final;
 
+  /// @brief choose a timeout for synchronous replication, based on the
+  /// number of documents we ship over
+  static double chooseTimeout(size_t count, size_t totalBytes);
+
   static double timeoutFactor;
   static double timeoutPer4k;
   static double lowerLimit;
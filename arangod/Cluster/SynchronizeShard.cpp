@@ -82,7 +82,7 @@ std::string const TTL("ttl");
 using namespace std::chrono;
 
 SynchronizeShard::SynchronizeShard(MaintenanceFeature& feature, ActionDescription const& desc)
-    : ActionBase(feature, desc) {
+    : ActionBase(feature, desc), _bytesReceived(0) {
   std::stringstream error;
 
   if (!desc.has(COLLECTION)) {
@@ -523,7 +523,8 @@ enum ApplierType { APPLIER_DATABASE, APPLIER_GLOBAL };
 
 static arangodb::Result replicationSynchronize(
     std::shared_ptr<arangodb::LogicalCollection> const& col, VPackSlice const& config,
-    ApplierType applierType, std::shared_ptr<VPackBuilder> sy) {
+    ApplierType applierType, std::shared_ptr<VPackBuilder> sy,
+    std::function<void(uint64_t)> const& dataReceived) {
   auto& vocbase = col->vocbase();
 
   auto database = vocbase.name();
@@ -544,7 +545,9 @@ static arangodb::Result replicationSynchronize(
 
   if (applierType == APPLIER_DATABASE) {
     // database-specific synchronization
-    syncer.reset(new DatabaseInitialSyncer(vocbase, configuration));
+    auto databaseSyncer = std::make_shared<DatabaseInitialSyncer>(vocbase, configuration);
+    databaseSyncer->setDataReceivedHandler(dataReceived);
+    syncer = databaseSyncer;
 
     if (!leaderId.empty()) {
       syncer->setLeaderId(leaderId);
@@ -864,7 +867,13 @@ bool SynchronizeShard::first() {
 
       auto details = std::make_shared<VPackBuilder>();
 
-      res = replicationSynchronize(collection, config.slice(), APPLIER_DATABASE, details);
+      res = replicationSynchronize(collection, config.slice(), APPLIER_DATABASE, details,
+                                   [this](uint64_t bytes) {
+                                     _bytesReceived += bytes;
+                                     // wait here if all synchronizations
+                                     // together exceed their bandwidth
+                                     _feature.throttleSynchronization(bytes);
+                                   });
 
       auto sy = details->slice();
       auto const endTime = system_clock::now();
@@ -1130,3 +1139,7 @@ void SynchronizeShard::setState(ActionState state) {
 
   ActionBase::setState(state);
 }
+
+void SynchronizeShard::toVelocyPackDetails(VPackBuilder& builder) const {
+  builder.add("bytesReceived", VPackValue(_bytesReceived.load()));
+}
@@ -30,6 +30,7 @@
 #include "Cluster/ResultT.h"
 #include "VocBase/voc-types.h"
 
+#include <atomic>
 #include <chrono>
 
 namespace arangodb {
@@ -48,6 +49,9 @@ class SynchronizeShard : public ActionBase {
 
   void setState(ActionState state) override final;
 
+ protected:
+  void toVelocyPackDetails(VPackBuilder& builder) const override final;
+
  private:
   arangodb::Result getReadLock(std::string const& endpoint, std::string const& database,
                                std::string const& collection, std::string const& clientId,
@@ -68,6 +72,9 @@ class SynchronizeShard : public ActionBase {
       std::string const& ep, std::string const& database, LogicalCollection const& collection,
       std::string const& clientId, std::string const& shard,
       std::string const& leader, TRI_voc_tick_t lastLogTick, VPackBuilder& builder);
+
+  /// @brief number of bytes received from the leader so far
+  std::atomic<uint64_t> _bytesReceived;
 };
 
 }  // namespace maintenance
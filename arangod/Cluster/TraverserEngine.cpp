@@ -288,6 +288,12 @@ void BaseTraverserEngine::getEdges(VPackSlice vertex, size_t depth, VPackBuilder
 
       edgeCursor->readAll([&](EdgeDocumentToken&& eid, VPackSlice edge, size_t cursorId) {
         if (edge.isString()) {
+          // skip edges that do not match before reading their documents
+          if (_opts->edgeConditionCoveredByIndex(depth, cursorId) &&
+              !_opts->evaluateEdgeExpression(_opts->edgeForCondition(eid, edge, vertexId, depth, cursorId),
+                                             vertexId, depth, cursorId)) {
+            return;
+          }
           edge = _opts->cache()->lookupToken(eid);
         }
         if (edge.isNull()) {
@@ -304,6 +310,13 @@ void BaseTraverserEngine::getEdges(VPackSlice vertex, size_t depth, VPackBuilder
         _opts->nextCursor(arangodb::velocypack::StringRef(vertex), depth));
     edgeCursor->readAll([&](EdgeDocumentToken&& eid, VPackSlice edge, size_t cursorId) {
       if (edge.isString()) {
+        // skip edges that do not match before reading their documents
+        arangodb::velocypack::StringRef vertexId(vertex);
+        if (_opts->edgeConditionCoveredByIndex(depth, cursorId) &&
+            !_opts->evaluateEdgeExpression(_opts->edgeForCondition(eid, edge, vertexId, depth, cursorId),
+                                           vertexId, depth, cursorId)) {
+          return;
+        }
         edge = _opts->cache()->lookupToken(eid);
       }
       if (edge.isNull()) {
@@ -33,6 +33,7 @@
 #include "Indexes/IndexIterator.h"
 #include "MMFiles/MMFilesCollection.h"
 #include "RestServer/DatabaseFeature.h"
+#include "RocksDBEngine/RocksDBColumnFamily.h"
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "StorageEngine/StorageEngine.h"
 #include "StorageEngine/TransactionState.h"
@@ -91,6 +92,9 @@ ClusterCollection::ClusterCollection(LogicalCollection& collection, ClusterEngin
           TRI_ERROR_BAD_PARAMETER,
           "volatile collections are unsupported in the RocksDB engine");
     }
+    // throws for invalid values
+    RocksDBColumnFamily::storageClassFromString(
+        Helper::getStringValue(info, "storageClass", ""));
   } else if (_engineType != ClusterEngineType::MockEngine) {
     TRI_ASSERT(false);
     THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "invalid storage engine");
@@ -181,6 +185,14 @@ Result ClusterCollection::updateProperties(VPackSlice const& slice, bool doSync)
     merge.add("journalSize", VPackValue(journalSize));
 
   } else if (_engineType == ClusterEngineType::RocksDBEngine) {
+    VPackSlice storageClass = slice.get("storageClass");
+    if (storageClass.isString() &&
+        RocksDBColumnFamily::storageClassFromString(storageClass.copyString()) !=
+            RocksDBColumnFamily::storageClassFromString(
+                Helper::getStringValue(_info.slice(), "storageClass", ""))) {
+      return {TRI_ERROR_BAD_PARAMETER,
+              "storageClass option cannot be changed at runtime"};
+    }
     bool def = Helper::readBooleanValue(_info.slice(), "cacheEnabled", false);
     merge.add("cacheEnabled",
               VPackValue(Helper::readBooleanValue(slice, "cacheEnabled", def)));
@@ -241,6 +253,10 @@ void ClusterCollection::getPropertiesVPack(velocypack::Builder& result) const {
   } else if (_engineType == ClusterEngineType::RocksDBEngine) {
     result.add("cacheEnabled",
                VPackValue(Helper::readBooleanValue(_info.slice(), "cacheEnabled", false)));
+    result.add("storageClass",
+               VPackValue(RocksDBColumnFamily::storageClassName(
+                   RocksDBColumnFamily::storageClassFromString(
+                       Helper::getStringValue(_info.slice(), "storageClass", "")))));
 
   } else if (_engineType != ClusterEngineType::MockEngine) {
     TRI_ASSERT(false);
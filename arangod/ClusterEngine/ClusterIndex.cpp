@@ -204,11 +204,12 @@ void ClusterIndex::updateProperties(velocypack::Slice const& slice) {
 
 bool ClusterIndex::hasCoveringIterator() const {
   if (_engineType == ClusterEngineType::RocksDBEngine) {
+    // the ttl index stores converted timestamps, so it cannot cover
+    // the attribute values
     return _indexType == Index::TRI_IDX_TYPE_PRIMARY_INDEX ||
            _indexType == Index::TRI_IDX_TYPE_EDGE_INDEX ||
            _indexType == Index::TRI_IDX_TYPE_HASH_INDEX ||
            _indexType == Index::TRI_IDX_TYPE_SKIPLIST_INDEX ||
-           _indexType == Index::TRI_IDX_TYPE_TTL_INDEX ||
            _indexType == Index::TRI_IDX_TYPE_PERSISTENT_INDEX;
   }
   return false;
@@ -87,6 +87,13 @@ void AcceptorTcp::open() {
 #else
   _acceptor->set_option(asio_ns::ip::tcp::acceptor::reuse_address(
       ((EndpointIp*)_endpoint)->reuseAddress()));
+#ifdef SO_REUSEPORT
+  if (_server.ioThreadPerCore()) {
+    // every io context binds its own acceptor to this endpoint
+    _acceptor->set_option(
+        asio_ns::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>(true));
+  }
+#endif
 #endif
 
   _acceptor->bind(asioEndpoint, err);
@@ -110,12 +117,12 @@ void AcceptorTcp::open() {
 void AcceptorTcp::asyncAccept(AcceptHandler const& handler) {
   TRI_ASSERT(!_peer);
 
-  // select the io context for this socket
-  auto& context = _server.selectIoContext();
+  // select the io context for this socket. With an io thread per core,
+  // connections stay on the thread that accepted them
+  auto& context = _server.ioThreadPerCore() ? _context : _server.selectIoContext();
 
   if (_endpoint->encryption() == Endpoint::EncryptionType::SSL) {
-    auto sslContext = SslServerFeature::SSL->createSslContext();
-    _peer.reset(new SocketSslTcp(context, std::move(sslContext)));
+    _peer.reset(new SocketSslTcp(context, SslServerFeature::SSL->sslContext()));
     SocketSslTcp* peer = static_cast<SocketSslTcp*>(_peer.get());
     _acceptor->async_accept(peer->_socket, peer->_peerEndpoint, handler);
   } else {
@@ -25,6 +25,7 @@
 
 #include "Basics/ReadLocker.h"
 #include "Basics/WriteLocker.h"
+#include "Basics/system-functions.h"
 #include "Basics/voc-errors.h"
 #include "GeneralServer/RestHandler.h"
 #include "Logger/Logger.h"
@@ -44,32 +45,52 @@ bool authorized(std::pair<std::string, arangodb::rest::AsyncJobResult> const& jo
 
   return (job.first == context->user());
 }
+
+typedef std::vector<std::function<void()>> Waiters;
+
+void notify(Waiters& waiters) {
+  for (auto& waiter : waiters) {
+    waiter();
+  }
+}
 }  // namespace
 
 using namespace arangodb;
 using namespace arangodb::basics;
 using namespace arangodb::rest;
 
+constexpr size_t AsyncJobManager::NumShards;
+
 AsyncJobResult::AsyncJobResult()
-    : _jobId(0), _response(nullptr), _stamp(0.0), _status(JOB_UNDEFINED) {}
+    : _jobId(0), _response(nullptr), _memoryUsage(0), _stamp(0.0), _status(JOB_UNDEFINED) {}
 
 AsyncJobResult::AsyncJobResult(IdType jobId, Status status,
                                std::shared_ptr<RestHandler>&& handler)
     : _jobId(jobId),
       _response(nullptr),
+      _memoryUsage(0),
       _stamp(TRI_microtime()),
       _status(status),
       _handler(std::move(handler)) {}
 
 AsyncJobResult::~AsyncJobResult() {}
 
-AsyncJobManager::AsyncJobManager() : _lock(), _jobs() {}
+AsyncJobManager::AsyncJobManager(uint64_t maxResultsMemory)
+    : _shards(), _maxResultsMemory(maxResultsMemory), _resultsMemory(0) {}
 
 AsyncJobManager::~AsyncJobManager() {
   // remove all results that haven't been fetched
   deleteJobs();
 }
 
+void AsyncJobManager::releaseResult(AsyncJobResult& job) {
+  if (job._response != nullptr) {
+    _resultsMemory -= job._memoryUsage;
+    delete job._response;
+    job._response = nullptr;
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief returns the result of an async job
 ////////////////////////////////////////////////////////////////////////////////
@@ -77,11 +98,12 @@ AsyncJobManager::~AsyncJobManager() {
 GeneralResponse* AsyncJobManager::getJobResult(AsyncJobResult::IdType jobId,
                                                AsyncJobResult::Status& status,
                                                bool removeFromList) {
-  WRITE_LOCKER(writeLocker, _lock);
+  Shard& s = shard(jobId);
+  WRITE_LOCKER(writeLocker, s.lock);
 
-  auto it = _jobs.find(jobId);
+  auto it = s.jobs.find(jobId);
 
-  if (it == _jobs.end() || !::authorized(it->second)) {
+  if (it == s.jobs.end() || !::authorized(it->second)) {
     status = AsyncJobResult::JOB_UNDEFINED;
     return nullptr;
   }
@@ -97,8 +119,9 @@ GeneralResponse* AsyncJobManager::getJobResult(AsyncJobResult::IdType jobId,
     return nullptr;
   }
 
-  // remove the job from the list
-  _jobs.erase(it);
+  // remove the job from the list, the caller takes over the response
+  _resultsMemory -= (*it).second.second._memoryUsage;
+  s.jobs.erase(it);
   return response;
 }
 
@@ -107,22 +130,25 @@ GeneralResponse* AsyncJobManager::getJobResult(AsyncJobResult::IdType jobId,
 ////////////////////////////////////////////////////////////////////////////////
 
 bool AsyncJobManager::deleteJobResult(AsyncJobResult::IdType jobId) {
-  WRITE_LOCKER(writeLocker, _lock);
+  ::Waiters waiters;
+  {
+    Shard& s = shard(jobId);
+    WRITE_LOCKER(writeLocker, s.lock);
 
-  auto it = _jobs.find(jobId);
+    auto it = s.jobs.find(jobId);
 
-  if (it == _jobs.end() || !::authorized(it->second)) {
-    return false;
-  }
+    if (it == s.jobs.end() || !::authorized(it->second)) {
+      return false;
+    }
 
-  GeneralResponse* response = (*it).second.second._response;
+    releaseResult((*it).second.second);
+    waiters = std::move((*it).second.second._waiters);
 
-  if (response != nullptr) {
-    delete response;
+    // remove the job from the list
+    s.jobs.erase(it);
   }
 
-  // remove the job from the list
-  _jobs.erase(it);
+  ::notify(waiters);
   return true;
 }
 
@@ -131,56 +157,69 @@ bool AsyncJobManager::deleteJobResult(AsyncJobResult::IdType jobId) {
 ////////////////////////////////////////////////////////////////////////////////
 
 void AsyncJobManager::deleteJobs() {
-  WRITE_LOCKER(writeLocker, _lock);
-
-  auto it = _jobs.begin();
-
-  while (it != _jobs.end()) {
-    if (::authorized(it->second)) {
-      GeneralResponse* response = (*it).second.second._response;
-      if (response != nullptr) {
-        delete response;
+  for (Shard& s : _shards) {
+    ::Waiters waiters;
+    {
+      WRITE_LOCKER(writeLocker, s.lock);
+
+      auto it = s.jobs.begin();
+
+      while (it != s.jobs.end()) {
+        if (::authorized(it->second)) {
+          releaseResult((*it).second.second);
+          for (auto& waiter : (*it).second.second._waiters) {
+            waiters.emplace_back(std::move(waiter));
+          }
+          s.jobs.erase(it++);
+        } else {
+          ++it;
+        }
       }
-      _jobs.erase(it++);
-    } else {
-      ++it;
     }
+
+    ::notify(waiters);
   }
 }
 
 void AsyncJobManager::deleteExpiredJobResults(double stamp) {
-  WRITE_LOCKER(writeLocker, _lock);
-
-  auto it = _jobs.begin();
-
-  while (it != _jobs.end()) {
-    if (::authorized(it->second)) {
-      AsyncJobResult ajr = (*it).second.second;
-
-      if (ajr._stamp < stamp) {
-        GeneralResponse* response = ajr._response;
-
-        if (response != nullptr) {
-          delete response;
+  for (Shard& s : _shards) {
+    ::Waiters waiters;
+    {
+      WRITE_LOCKER(writeLocker, s.lock);
+
+      auto it = s.jobs.begin();
+
+      while (it != s.jobs.end()) {
+        if (::authorized(it->second)) {
+          AsyncJobResult& ajr = (*it).second.second;
+
+          if (ajr._stamp < stamp) {
+            releaseResult(ajr);
+            for (auto& waiter : ajr._waiters) {
+              waiters.emplace_back(std::move(waiter));
+            }
+            s.jobs.erase(it++);
+          } else {
+            ++it;
+          }
+        } else {
+          ++it;
         }
-
-        _jobs.erase(it++);
-      } else {
-        ++it;
       }
-    } else {
-      ++it;
     }
+
+    ::notify(waiters);
   }
 }
 
 Result AsyncJobManager::cancelJob(AsyncJobResult::IdType jobId) {
   Result rv;
-  WRITE_LOCKER(writeLocker, _lock);
+  Shard& s = shard(jobId);
+  WRITE_LOCKER(writeLocker, s.lock);
 
-  auto it = _jobs.find(jobId);
+  auto it = s.jobs.find(jobId);
 
-  if (it == _jobs.end() || !::authorized(it->second)) {
+  if (it == s.jobs.end() || !::authorized(it->second)) {
     rv.reset(TRI_ERROR_HTTP_NOT_FOUND,
              "could not find job (" + std::to_string(jobId) +
                  ") in AsyncJobManager during cancel operation");
@@ -206,24 +245,37 @@ Result AsyncJobManager::cancelJob(AsyncJobResult::IdType jobId) {
 /// @brief cancel and delete all pending / done jobs
 Result AsyncJobManager::clearAllJobs() {
   Result rv;
-  WRITE_LOCKER(writeLocker, _lock);
 
-  for (auto& it : _jobs) {
-    bool ok = true;
-    std::shared_ptr<RestHandler>& handler = it.second.second._handler;
+  for (Shard& s : _shards) {
+    ::Waiters waiters;
+    {
+      WRITE_LOCKER(writeLocker, s.lock);
 
-    if (handler != nullptr) {
-      ok = handler->cancel();
-    }
+      for (auto& it : s.jobs) {
+        bool ok = true;
+        std::shared_ptr<RestHandler>& handler = it.second.second._handler;
 
-    if (!ok) {
-      // if you end up here you might need to implement the cancel method on
-      // your handler
-      rv.reset(TRI_ERROR_INTERNAL, "could not cancel job (" + std::to_string(it.first) +
-                                       ") in handler " + handler->name());
+        if (handler != nullptr) {
+          ok = handler->cancel();
+        }
+
+        if (!ok) {
+          // if you end up here you might need to implement the cancel method
+          // on your handler
+          rv.reset(TRI_ERROR_INTERNAL, "could not cancel job (" + std::to_string(it.first) +
+                                           ") in handler " + handler->name());
+        }
+
+        releaseResult(it.second.second);
+        for (auto& waiter : it.second.second._waiters) {
+          waiters.emplace_back(std::move(waiter));
+        }
+      }
+      s.jobs.clear();
     }
+
+    ::notify(waiters);
   }
-  _jobs.clear();
 
   return rv;
 }
@@ -248,24 +300,21 @@ std::vector<AsyncJobResult::IdType> AsyncJobManager::byStatus(AsyncJobResult::St
                                                               size_t maxCount) {
   std::vector<AsyncJobResult::IdType> jobs;
 
-  {
-    size_t n = 0;
-    READ_LOCKER(readLocker, _lock);
-    auto it = _jobs.begin();
+  for (Shard& s : _shards) {
+    if (jobs.size() >= maxCount) {
+      break;
+    }
 
-    // iterate the list. the list is sorted by id
-    while (it != _jobs.end()) {
-      AsyncJobResult::IdType jobId = (*it).first;
+    READ_LOCKER(readLocker, s.lock);
 
-      if ((*it).second.second._status == status && ::authorized(it->second)) {
-        jobs.emplace_back(jobId);
+    for (auto const& it : s.jobs) {
+      if (it.second.second._status == status && ::authorized(it.second)) {
+        jobs.emplace_back(it.first);
 
-        if (++n >= maxCount) {
+        if (jobs.size() >= maxCount) {
           break;
         }
       }
-
-      ++it;
     }
   }
 
@@ -276,16 +325,25 @@ std::vector<AsyncJobResult::IdType> AsyncJobManager::byStatus(AsyncJobResult::St
 /// @brief initializes an async job
 ////////////////////////////////////////////////////////////////////////////////
 
-void AsyncJobManager::initAsyncJob(std::shared_ptr<RestHandler> handler) {
+bool AsyncJobManager::initAsyncJob(std::shared_ptr<RestHandler> handler) {
+  if (_maxResultsMemory > 0 && _resultsMemory.load() >= _maxResultsMemory) {
+    LOG_TOPIC("6d2f9", DEBUG, Logger::COMMUNICATION)
+        << "rejecting async job, the stored results use "
+        << _resultsMemory.load() << " bytes";
+    return false;
+  }
+
   handler->assignHandlerId();
   AsyncJobResult::IdType jobId = handler->handlerId();
 
   std::string user = handler->request()->user();
   AsyncJobResult ajr(jobId, AsyncJobResult::JOB_PENDING, std::move(handler));
 
-  WRITE_LOCKER(writeLocker, _lock);
+  Shard& s = shard(jobId);
+  WRITE_LOCKER(writeLocker, s.lock);
 
-  _jobs.emplace(jobId, std::make_pair(std::move(user), ajr));
+  s.jobs.emplace(jobId, std::make_pair(std::move(user), std::move(ajr)));
+  return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -295,17 +353,43 @@ void AsyncJobManager::initAsyncJob(std::shared_ptr<RestHandler> handler) {
 void AsyncJobManager::finishAsyncJob(RestHandler* handler) {
   AsyncJobResult::IdType jobId = handler->handlerId();
   std::unique_ptr<GeneralResponse> response = handler->stealResponse();
+  size_t const memoryUsage =
+      response == nullptr ? 0 : sizeof(*response) + response->bodySize();
 
+  ::Waiters waiters;
   {
-    WRITE_LOCKER(writeLocker, _lock);
-    auto it = _jobs.find(jobId);
+    Shard& s = shard(jobId);
+    WRITE_LOCKER(writeLocker, s.lock);
+    auto it = s.jobs.find(jobId);
 
-    if (it == _jobs.end()) {
+    if (it == s.jobs.end()) {
       return;  // job is already canceled
     }
 
-    it->second.second._response = response.release();
-    it->second.second._status = AsyncJobResult::JOB_DONE;
-    it->second.second._stamp = TRI_microtime();
+    AsyncJobResult& ajr = it->second.second;
+    ajr._response = response.release();
+    ajr._memoryUsage = memoryUsage;
+    ajr._status = AsyncJobResult::JOB_DONE;
+    ajr._stamp = TRI_microtime();
+    waiters = std::move(ajr._waiters);
+    _resultsMemory += memoryUsage;
   }
+
+  ::notify(waiters);
+}
+
+bool AsyncJobManager::waitForJob(AsyncJobResult::IdType jobId,
+                                 std::function<void()>&& callback) {
+  Shard& s = shard(jobId);
+  WRITE_LOCKER(writeLocker, s.lock);
+
+  auto it = s.jobs.find(jobId);
+
+  if (it == s.jobs.end() || !::authorized(it->second) ||
+      it->second.second._status != AsyncJobResult::JOB_PENDING) {
+    return false;
+  }
+
+  it->second.second._waiters.emplace_back(std::move(callback));
+  return true;
 }
@@ -28,6 +28,8 @@
 #include "Basics/ReadWriteLock.h"
 #include "Basics/Result.h"
 
+#include <array>
+
 namespace arangodb {
 class GeneralResponse;
 
@@ -53,9 +55,12 @@ struct AsyncJobResult {
  public:
   IdType _jobId;
   GeneralResponse* _response;
+  size_t _memoryUsage;  // of the response
   double _stamp;
   Status _status;
   std::shared_ptr<RestHandler> _handler;
+  // called once the job is done or removed
+  std::vector<std::function<void()>> _waiters;
 };
 
 // -----------------------------------------------------------------------------
@@ -63,6 +68,10 @@ struct AsyncJobResult {
 // -----------------------------------------------------------------------------
 
 /// @brief Manages responses which will be fetched later by clients.
+///
+/// The jobs are spread over shards by id, each with a lock of its own.
+/// The memory of the stored responses is accounted, new jobs are rejected
+/// while it exceeds the limit.
 class AsyncJobManager {
   AsyncJobManager(AsyncJobManager const&) = delete;
   AsyncJobManager& operator=(AsyncJobManager const&) = delete;
@@ -70,8 +79,11 @@ class AsyncJobManager {
  public:
   typedef std::unordered_map<AsyncJobResult::IdType, std::pair<std::string, AsyncJobResult>> JobList;
 
+  static constexpr size_t NumShards = 16;
+
  public:
-  AsyncJobManager();
+  /// @brief maxResultsMemory = 0 means unlimited
+  explicit AsyncJobManager(uint64_t maxResultsMemory = 0);
   ~AsyncJobManager();
 
  public:
@@ -90,12 +102,36 @@ class AsyncJobManager {
   std::vector<AsyncJobResult::IdType> pending(size_t maxCount);
   std::vector<AsyncJobResult::IdType> done(size_t maxCount);
   std::vector<AsyncJobResult::IdType> byStatus(AsyncJobResult::Status, size_t maxCount);
-  void initAsyncJob(std::shared_ptr<RestHandler>);
+
+  /// @brief registers an async job. returns false if the memory of the
+  /// stored responses exceeds the limit
+  bool initAsyncJob(std::shared_ptr<RestHandler>);
   void finishAsyncJob(RestHandler*);
 
+  /// @brief calls the callback once the job is done, or removed. returns
+  /// false right away if the job is not pending, the callback is not called
+  /// then. The callback must not block, it is called on the thread that
+  /// finishes or removes the job
+  bool waitForJob(AsyncJobResult::IdType, std::function<void()>&&);
+
+  /// @brief memory used by the stored responses
+  uint64_t resultsMemory() const { return _resultsMemory.load(); }
+
+ private:
+  struct Shard {
+    basics::ReadWriteLock lock;
+    JobList jobs;
+  };
+
+  Shard& shard(AsyncJobResult::IdType jobId) { return _shards[jobId % NumShards]; }
+
+  /// @brief deletes the response of a job removed from its shard
+  void releaseResult(AsyncJobResult&);
+
  private:
-  basics::ReadWriteLock _lock;
-  JobList _jobs;
+  std::array<Shard, NumShards> _shards;
+  uint64_t const _maxResultsMemory;
+  std::atomic<uint64_t> _resultsMemory;
 };
 }  // namespace rest
 }  // namespace arangodb
@@ -31,6 +31,7 @@
 #include "Basics/Locking.h"
 #include "Basics/MutexLocker.h"
 #include "Basics/StaticStrings.h"
+#include "Basics/tri-strings.h"
 #include "Cluster/ServerState.h"
 #include "GeneralServer/AsyncJobManager.h"
 #include "GeneralServer/AuthenticationFeature.h"
@@ -42,6 +43,8 @@
 #include "Logger/Logger.h"
 #include "Meta/conversion.h"
 #include "Replication/ReplicationFeature.h"
+#include "Rest/HttpRequest.h"
+#include "Rest/HttpResponse.h"
 #include "RestServer/DatabaseFeature.h"
 #include "RestServer/VocbaseContext.h"
 #include "Scheduler/Scheduler.h"
@@ -67,6 +70,41 @@ inline bool startsWith(std::string const& path, char const* other) {
           path.compare(0, size, other, size) == 0);
 }
 
+/// @brief picks the content coding for a response from the value of an
+/// Accept-Encoding header. gzip is preferred over deflate, codings with
+/// a q-value of 0 are not acceptable. returns nullptr if neither is
+char const* acceptedEncoding(std::string const& value) {
+  bool gzip = false;
+  bool deflate = false;
+
+  for (std::string const& part : StringUtils::split(value, ',')) {
+    std::vector<std::string> params = StringUtils::split(part, ';');
+    if (params.empty()) {
+      continue;
+    }
+
+    bool acceptable = true;
+    for (size_t i = 1; i < params.size(); ++i) {
+      std::string param = StringUtils::trim(params[i]);
+      if (param.size() > 2 && (param[0] == 'q' || param[0] == 'Q') && param[1] == '=') {
+        acceptable = StringUtils::doubleDecimal(param.substr(2)) > 0.0;
+      }
+    }
+    if (!acceptable) {
+      continue;
+    }
+
+    std::string coding = StringUtils::tolower(StringUtils::trim(params[0]));
+    if (coding == "gzip" || coding == "*") {
+      gzip = true;
+    } else if (coding == "deflate") {
+      deflate = true;
+    }
+  }
+
+  return gzip ? "gzip" : (deflate ? "deflate" : nullptr);
+}
+
 }  // namespace
 
 // -----------------------------------------------------------------------------
@@ -303,6 +341,10 @@ void GeneralCommTask::executeRequest(std::unique_ptr<GeneralRequest>&& request,
         << "could not find corresponding request/response";
   }
 
+  bool traced;
+  std::string const& traceParent = request->header(StaticStrings::Trace, traced);
+  RequestStatistics::START_TRACE(statistics(messageId), traced ? &traceParent : nullptr);
+
   rest::ContentType respType = request->contentTypeResponse();
   // create a handler, this takes ownership of request and response
   std::shared_ptr<RestHandler> handler(
@@ -358,11 +400,83 @@ void GeneralCommTask::executeRequest(std::unique_ptr<GeneralRequest>&& request,
   } else {
     // synchronous request
     handler->setStatistics(stealStatistics(messageId));
+    if (canSendResponseParts()) {
+      std::weak_ptr<IoTask> weak = shared_from_this();
+      handler->_responsePartSink = [weak, this](RestHandler& h, bool first,
+                                                std::unique_ptr<StringBuffer> part) {
+        auto self = weak.lock();
+        return self != nullptr && sendResponsePart(h, first, std::move(part));
+      };
+    }
     // handleRequestSync adds an error response
     handleRequestSync(std::move(handler));
   }
 }
 
+ResponseCode GeneralCommTask::handleAuthHeader(HttpRequest* req) {
+  bool found;
+  std::string const& authStr = req->header(StaticStrings::Authorization, found);
+  if (!found) {
+    if (_auth->isActive()) {
+      events::CredentialsMissing(*req);
+      return rest::ResponseCode::UNAUTHORIZED;
+    }
+    return rest::ResponseCode::OK;
+  }
+
+  size_t methodPos = authStr.find_first_of(' ');
+  if (methodPos != std::string::npos) {
+    // skip over authentication method
+    char const* auth = authStr.c_str() + methodPos;
+    while (*auth == ' ') {
+      ++auth;
+    }
+
+    if (Logger::logRequestParameters()) {
+      LOG_TOPIC("c4536", DEBUG, arangodb::Logger::REQUESTS)
+          << "\"authorization-header\",\"" << (void*)this << "\",\"" << authStr << "\"";
+    }
+
+    try {
+      // note that these methods may throw in case of an error
+      AuthenticationMethod authMethod = AuthenticationMethod::NONE;
+      if (TRI_CaseEqualString(authStr.c_str(), "basic ", 6)) {
+        authMethod = AuthenticationMethod::BASIC;
+      } else if (TRI_CaseEqualString(authStr.c_str(), "bearer ", 7)) {
+        authMethod = AuthenticationMethod::JWT;
+      }
+
+      req->setAuthenticationMethod(authMethod);
+      if (authMethod != AuthenticationMethod::NONE) {
+        _authToken = _auth->tokenCache().checkAuthentication(authMethod, auth);
+        req->setAuthenticated(_authToken.authenticated());
+        req->setUser(_authToken._username); // do copy here, so that we do not invalidate the member
+      }
+
+      if (req->authenticated() || !_auth->isActive()) {
+        events::Authenticated(*req, authMethod);
+        return rest::ResponseCode::OK;
+      } else if (_auth->isActive()) {
+        events::CredentialsBad(*req, authMethod);
+        return rest::ResponseCode::UNAUTHORIZED;
+      }
+
+      // intentionally falls through
+    } catch (arangodb::basics::Exception const& ex) {
+      // translate error
+      if (ex.code() == TRI_ERROR_USER_NOT_FOUND) {
+        return rest::ResponseCode::UNAUTHORIZED;
+      }
+      return GeneralResponse::responseCode(ex.what());
+    } catch (...) {
+      return rest::ResponseCode::SERVER_ERROR;
+    }
+  }
+
+  events::UnknownAuthenticationMethod(*req);
+  return rest::ResponseCode::UNAUTHORIZED;
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION-- statistics handling                             protected methods
 // -----------------------------------------------------------------------------
@@ -453,6 +567,20 @@ bool GeneralCommTask::handleRequestSync(std::shared_ptr<RestHandler> handler) {
     return false;
   }
 
+  if (lane == RequestLane::CLIENT_FAST && GeneralServerFeature::ioThreadPerCore()) {
+    // fast requests do not block, hence avoid the hops to a scheduler
+    // thread and back
+    handleRequestDirectly(basics::ConditionalLocking::DoNotLock, std::move(handler));
+    return true;
+  }
+
+  if (SchedulerFeature::SCHEDULER->isOverloaded(lane)) {
+    // reject right away, instead of letting this and all other requests
+    // time out in the queue
+    rejectOverloaded(*handler);
+    return false;
+  }
+
   bool ok = SchedulerFeature::SCHEDULER->queue(lane, [self, this, handler]() {
     handleRequestDirectly(basics::ConditionalLocking::DoLock, std::move(handler));
   });
@@ -467,6 +595,29 @@ bool GeneralCommTask::handleRequestSync(std::shared_ptr<RestHandler> handler) {
   return ok;
 }
 
+// Respond with 503 and a hint for well-behaved clients when to come back
+void GeneralCommTask::rejectOverloaded(RestHandler& handler) {
+  rest::ResponseCode const code = rest::ResponseCode::SERVICE_UNAVAILABLE;
+  int const errorNum = TRI_ERROR_HTTP_SERVICE_UNAVAILABLE;
+
+  VPackBuffer<uint8_t> buffer;
+  VPackBuilder builder(buffer);
+  builder.openObject();
+  builder.add(StaticStrings::Error, VPackValue(true));
+  builder.add(StaticStrings::ErrorNum, VPackValue(errorNum));
+  builder.add(StaticStrings::ErrorMessage, VPackValue("server is overloaded"));
+  builder.add(StaticStrings::Code, VPackValue((int)code));
+  builder.close();
+
+  GeneralResponse& response = *handler.response();
+  response.setResponseCode(code);
+  response.setContentType(handler.request()->contentTypeResponse());
+  response.setHeaderNC(StaticStrings::RetryAfter, "1");
+  response.setPayload(std::move(buffer), true, VPackOptions::Defaults);
+
+  addResponse(response, handler.stealStatistics());
+}
+
 // Just run the handler, could have been called in a different thread
 void GeneralCommTask::handleRequestDirectly(bool doLock, std::shared_ptr<RestHandler> handler) {
   TRI_ASSERT(doLock || _peer->runningInThisThread());
@@ -478,11 +629,67 @@ void GeneralCommTask::handleRequestDirectly(bool doLock, std::shared_ptr<RestHan
   handler->runHandler([self = std::move(self), this](rest::RestHandler* handler) {
     RequestStatistics* stat = handler->stealStatistics();
     auto h = handler->shared_from_this();
+    // compressing is expensive, so do it here rather than on the io thread.
+    // the header of a response sent in parts is out already
+    if (!handler->responsePartsSent()) {
+      compressResponse(*handler->request(), *handler->response());
+    }
     // Pass the response the io context
     _peer->post([self, this, stat, h = std::move(h)]() { addResponse(*(h->response()), stat); });
   });
 }
 
+// Replace the body of an HTTP response with its gzip or deflate encoding,
+// if the client accepts one of them and the body is large enough
+void GeneralCommTask::compressResponse(GeneralRequest const& request,
+                                       GeneralResponse& baseResponse) {
+  uint64_t const threshold = GeneralServerFeature::compressResponseThreshold();
+  if (threshold == 0 ||
+      baseResponse.transportType() != Endpoint::TransportType::HTTP ||
+      request.requestType() == rest::RequestType::HEAD) {
+    return;
+  }
+
+  HttpResponse& response = static_cast<HttpResponse&>(baseResponse);
+  if (response._body == nullptr || response._body->length() < threshold) {
+    return;
+  }
+
+  // leave alone bodies that are encoded already, e.g. by Foxx
+  if (response.headers().find(StaticStrings::ContentEncoding) !=
+      response.headers().end()) {
+    return;
+  }
+
+  bool found;
+  std::string const& accept = request.header(StaticStrings::AcceptEncoding, found);
+  char const* encoding = found ? ::acceptedEncoding(accept) : nullptr;
+  if (encoding == nullptr) {
+    return;
+  }
+
+  StringBuffer* compressed = leaseStringBuffer(response._body->length() / 4);
+  // favor speed, large response bodies are usually JSON, which compresses
+  // well even at the lowest level
+  int res = response._body->compress(*compressed, encoding[0] == 'g', 1);
+
+  if (res != TRI_ERROR_NO_ERROR || compressed->length() >= response._body->length()) {
+    returnStringBuffer(compressed);
+    return;
+  }
+
+  returnStringBuffer(response._body);
+  response._body = compressed;
+  response.setHeaderNC(StaticStrings::ContentEncoding, encoding);
+
+  auto it = response.headers().find(StaticStrings::Vary);
+  if (it == response.headers().end()) {
+    response.setHeaderNC(StaticStrings::Vary, StaticStrings::AcceptEncoding);
+  } else {
+    response.setHeaderNC(StaticStrings::Vary, it->second + ", " + StaticStrings::AcceptEncoding);
+  }
+}
+
 // handle a request which came in with the x-arango-async header
 bool GeneralCommTask::handleRequestAsync(std::shared_ptr<RestHandler> handler,
                                          uint64_t* jobId) {
@@ -492,15 +699,23 @@ bool GeneralCommTask::handleRequestAsync(std::shared_ptr<RestHandler> handler,
   }
 
   if (jobId != nullptr) {
-    GeneralServerFeature::JOB_MANAGER->initAsyncJob(handler);
+    if (!GeneralServerFeature::JOB_MANAGER->initAsyncJob(handler)) {
+      // too many results that have not been fetched
+      return false;
+    }
     *jobId = handler->handlerId();
 
     // callback will persist the response with the AsyncJobManager
-    return SchedulerFeature::SCHEDULER->queue(handler->getRequestLane(), [self = std::move(self), handler] {
+    bool queued = SchedulerFeature::SCHEDULER->queue(handler->getRequestLane(), [self = std::move(self), handler] {
       handler->runHandler([](RestHandler* h) {
         GeneralServerFeature::JOB_MANAGER->finishAsyncJob(h);
       });
     });
+    if (!queued) {
+      // the job would stay pending forever
+      GeneralServerFeature::JOB_MANAGER->deleteJobResult(*jobId);
+    }
+    return queued;
   } else {
     // here the response will just be ignored
     return SchedulerFeature::SCHEDULER->queue(handler->getRequestLane(), [self = std::move(self), handler] {
@@ -40,6 +40,7 @@ namespace arangodb {
 class AuthenticationFeature;
 class GeneralRequest;
 class GeneralResponse;
+class HttpRequest;
 
 namespace rest {
 class RestHandler;
@@ -70,8 +71,8 @@ class RestHandler;
 //     an error has occurred.
 //
 //     It is the responsibility of the sub-class to govern what is supported.
-//     For example, HTTP will only support one active request executing at a
-//     time until the final response has been send out.
+//     For example, HTTP executes pipelined requests concurrently only if
+//     they use safe methods, and sends their responses in request order.
 //
 //     VelocyPack on the other hand, allows multiple active requests. Partial
 //     responses are identified by a request id.
@@ -109,6 +110,18 @@ class GeneralCommTask : public SocketTask {
   /// @brief send the response to the client.
   virtual void addResponse(GeneralResponse&, RequestStatistics*) = 0;
 
+  /// @brief whether handlers of the current request may send their response
+  /// in parts, see RestHandler::sendResponsePart
+  virtual bool canSendResponseParts() const { return false; }
+
+  /// @brief sends a part of a response, called on the thread of the handler.
+  /// returns false if the handler has to wait for the parts to be written
+  virtual bool sendResponsePart(RestHandler&, bool first,
+                                std::unique_ptr<basics::StringBuffer>) {
+    TRI_ASSERT(false);
+    return false;
+  }
+
  protected:
   enum class RequestFlow : bool { Continue = true, Abort = false };
 
@@ -133,6 +146,10 @@ class GeneralCommTask : public SocketTask {
   void addErrorResponse(rest::ResponseCode, rest::ContentType,
                         uint64_t messageId, int errorNum);
 
+  /// @brief authenticates the user from the authorization header of an
+  /// HTTP request
+  rest::ResponseCode handleAuthHeader(HttpRequest*);
+
  protected:
   AuthenticationFeature* _auth;
 
@@ -154,6 +171,8 @@ class GeneralCommTask : public SocketTask {
  private:
   bool handleRequestSync(std::shared_ptr<RestHandler>);
   void handleRequestDirectly(bool doLock, std::shared_ptr<RestHandler>);
+  void rejectOverloaded(RestHandler&);
+  void compressResponse(GeneralRequest const&, GeneralResponse&);
   bool handleRequestAsync(std::shared_ptr<RestHandler>, uint64_t* jobId = nullptr);
 };
 }  // namespace rest
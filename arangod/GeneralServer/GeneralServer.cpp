@@ -46,8 +46,10 @@ using namespace arangodb::rest;
 // -----------------------------------------------------------------------------
 // --SECTION--                                                    public methods
 // -----------------------------------------------------------------------------
-GeneralServer::GeneralServer(uint64_t numIoThreads)
-    : _numIoThreads(numIoThreads), _contexts(numIoThreads) {}
+GeneralServer::GeneralServer(uint64_t numIoThreads, bool ioThreadPerCore)
+    : _numIoThreads(numIoThreads),
+      _ioThreadPerCore(ioThreadPerCore),
+      _contexts(numIoThreads) {}
 
 GeneralServer::~GeneralServer() {}
   
@@ -76,9 +78,19 @@ void GeneralServer::startListening() {
     LOG_TOPIC("e62e0", TRACE, arangodb::Logger::FIXME)
         << "trying to bind to endpoint '" << it.first << "' for requests";
 
-    // distribute endpoints across all io contexts
-    IoContext& ioContext = _contexts[i++ % _numIoThreads];
-    bool ok = openEndpoint(ioContext, it.second);
+    bool ok;
+    if (_ioThreadPerCore && it.second->domainType() != Endpoint::DomainType::UNIX) {
+      // the kernel distributes the connections across all io contexts,
+      // which listen on the same port with SO_REUSEPORT
+      ok = true;
+      for (auto& ioContext : _contexts) {
+        ok = ok && openEndpoint(ioContext, it.second);
+      }
+    } else {
+      // distribute endpoints across all io contexts
+      IoContext& ioContext = _contexts[i++ % _numIoThreads];
+      ok = openEndpoint(ioContext, it.second);
+    }
 
     if (ok) {
       LOG_TOPIC("dc45a", DEBUG, arangodb::Logger::FIXME) << "bound to endpoint '" << it.first << "'";
@@ -44,7 +44,7 @@ class GeneralServer {
   GeneralServer const& operator=(GeneralServer const&) = delete;
 
  public:
-  explicit GeneralServer(uint64_t numIoThreads);
+  GeneralServer(uint64_t numIoThreads, bool ioThreadPerCore);
   ~GeneralServer();
 
  public:
@@ -137,6 +137,10 @@ class GeneralServer {
 
   GeneralServer::IoContext& selectIoContext();
 
+  // every io context listens on each tcp endpoint and keeps the
+  // connections it accepts
+  bool ioThreadPerCore() const { return _ioThreadPerCore; }
+
  protected:
   bool openEndpoint(IoContext& ioContext, Endpoint* endpoint);
 
@@ -145,6 +149,7 @@ class GeneralServer {
   friend class IoContext;
 
   uint64_t const _numIoThreads;
+  bool const _ioThreadPerCore;
   std::vector<IoContext> _contexts;
   EndpointList const* _endpointList = nullptr;
 
@@ -47,6 +47,7 @@
 #include "RestHandler/RestAdminDatabaseHandler.h"
 #include "RestHandler/RestAdminExecuteHandler.h"
 #include "RestHandler/RestAdminLogHandler.h"
+#include "RestHandler/RestAdminMetricsHandler.h"
 #include "RestHandler/RestAdminRoutingHandler.h"
 #include "RestHandler/RestAdminServerHandler.h"
 #include "RestHandler/RestAdminStatisticsHandler.h"
@@ -92,6 +93,7 @@
 #include "RestHandler/RestViewHandler.h"
 #include "RestHandler/RestWalAccessHandler.h"
 #include "RestServer/EndpointFeature.h"
+#include "RestServer/MetricsFeature.h"
 #include "RestServer/QueryRegistryFeature.h"
 #include "RestServer/ServerFeature.h"
 #include "RestServer/TraverserEngineRegistryFeature.h"
@@ -117,6 +119,11 @@ GeneralServerFeature::GeneralServerFeature(application_features::ApplicationServ
     : ApplicationFeature(server, "GeneralServer"),
       _allowMethodOverride(false),
       _proxyCheck(true),
+      _ioThreadPerCore(false),
+      _compressResponseThreshold(0),
+      _maxBatchConcurrency(8),
+      _maxPipelinedRequests(8),
+      _asyncJobsMemoryLimit(1024 * 1024 * 1024),
       _numIoThreads(0) {
   setOptional(true);
   startsAfter("AQLPhase");
@@ -147,6 +154,13 @@ void GeneralServerFeature::collectOptions(std::shared_ptr<ProgramOptions> option
                      new UInt64Parameter(&_numIoThreads),
                      arangodb::options::makeFlags(arangodb::options::Flags::Dynamic));
 
+  options->addOption("--server.io-thread-per-core",
+                     "run one IO thread per core, each accepting connections on "
+                     "its own SO_REUSEPORT socket, and execute fast requests "
+                     "directly on the IO thread",
+                     new BooleanParameter(&_ioThreadPerCore),
+                     arangodb::options::makeFlags(arangodb::options::Flags::Hidden));
+
   options->addSection("http", "HttpServer features");
 
   options->addOption("--http.allow-method-override",
@@ -158,6 +172,29 @@ void GeneralServerFeature::collectOptions(std::shared_ptr<ProgramOptions> option
                      "keep-alive timeout in seconds",
                      new DoubleParameter(&_keepAliveTimeout));
 
+  options->addOption("--http.compress-response-threshold",
+                     "compress HTTP response bodies of at least this many "
+                     "bytes for clients that send an Accept-Encoding header "
+                     "with gzip or deflate (0 = never compress)",
+                     new UInt64Parameter(&_compressResponseThreshold));
+
+  options->addOption("--http.max-batch-concurrency",
+                     "maximum number of parts of a batch request executed "
+                     "concurrently, if the client asks for it",
+                     new UInt64Parameter(&_maxBatchConcurrency));
+
+  options->addOption("--http.max-pipelined-requests",
+                     "maximum number of pipelined requests of an HTTP/1.1 "
+                     "connection executed concurrently, only requests with "
+                     "safe methods are executed concurrently",
+                     new UInt64Parameter(&_maxPipelinedRequests));
+
+  options->addOption("--http.async-jobs-memory-limit",
+                     "maximum memory used by the stored results of async jobs "
+                     "(x-arango-async: store). new jobs are rejected while the "
+                     "results use more (0 = unlimited)",
+                     new UInt64Parameter(&_asyncJobsMemoryLimit));
+
   options->addOption(
       "--http.hide-product-header",
       "do not expose \"Server: ArangoDB\" header in HTTP responses",
@@ -178,7 +215,7 @@ void GeneralServerFeature::collectOptions(std::shared_ptr<ProgramOptions> option
                      new VectorParameter<StringParameter>(&_trustedProxies));
 }
 
-void GeneralServerFeature::validateOptions(std::shared_ptr<ProgramOptions>) {
+void GeneralServerFeature::validateOptions(std::shared_ptr<ProgramOptions> options) {
   if (!_accessControlAllowOrigins.empty()) {
     // trim trailing slash from all members
     for (auto& it : _accessControlAllowOrigins) {
@@ -207,6 +244,18 @@ void GeneralServerFeature::validateOptions(std::shared_ptr<ProgramOptions>) {
         _accessControlAllowOrigins.end());
   }
 
+  if (_maxBatchConcurrency == 0) {
+    _maxBatchConcurrency = 1;
+  }
+
+  if (_maxPipelinedRequests == 0) {
+    _maxPipelinedRequests = 1;
+  }
+
+  if (_ioThreadPerCore && !options->processingResult().touched("server.io-threads")) {
+    _numIoThreads = TRI_numberProcessors();
+  }
+
   // we need at least one io thread and context
   if (_numIoThreads == 0) {
     LOG_TOPIC("1ade3", WARN, Logger::FIXME) << "Need at least one io-context thread.";
@@ -223,7 +272,7 @@ void GeneralServerFeature::prepare() {
 }
 
 void GeneralServerFeature::start() {
-  _jobManager.reset(new AsyncJobManager);
+  _jobManager.reset(new AsyncJobManager(_asyncJobsMemoryLimit));
 
   JOB_MANAGER = _jobManager.get();
 
@@ -289,7 +338,7 @@ void GeneralServerFeature::buildServers() {
     ssl->SSL->verifySslOptions();
   }
 
-  auto server = std::make_unique<GeneralServer>(_numIoThreads);
+  auto server = std::make_unique<GeneralServer>(_numIoThreads, _ioThreadPerCore);
   server->setEndpointList(&endpointList);
   _servers.push_back(std::move(server));
 }
@@ -368,6 +417,10 @@ void GeneralServerFeature::defineHandlers() {
   _handlerFactory->addPrefixHandler(RestVocbaseBaseHandler::INDEX_PATH,
                                     RestHandlerCreator<RestIndexHandler>::createNoData);
 
+  _handlerFactory->addPrefixHandler(RestVocbaseBaseHandler::PREPARE_PATH,
+                                    RestHandlerCreator<RestCursorHandler>::createData<aql::QueryRegistry*>,
+                                    queryRegistry);
+
   _handlerFactory->addPrefixHandler(
       RestVocbaseBaseHandler::SIMPLE_QUERY_ALL_PATH,
       RestHandlerCreator<RestSimpleQueryHandler>::createData<aql::QueryRegistry*>,
@@ -543,6 +596,11 @@ void GeneralServerFeature::defineHandlers() {
   _handlerFactory->addHandler("/_admin/statistics-description",
                               RestHandlerCreator<arangodb::RestAdminStatisticsHandler>::createNoData);
 
+  if (MetricsFeature::exportAPI()) {
+    _handlerFactory->addHandler("/_admin/metrics",
+                                RestHandlerCreator<arangodb::RestAdminMetricsHandler>::createNoData);
+  }
+
   if (cluster->isEnabled()) {
     _handlerFactory->addPrefixHandler("/_admin/repair",
                                       RestHandlerCreator<arangodb::RestRepairHandler>::createNoData);
@@ -73,6 +73,30 @@ class GeneralServerFeature final : public application_features::ApplicationFeatu
     return GENERAL_SERVER->_allowMethodOverride;
   }
 
+  // fast requests are executed directly on the io thread of their
+  // connection, and each io thread accepts its own connections
+  static bool ioThreadPerCore() {
+    return GENERAL_SERVER != nullptr && GENERAL_SERVER->_ioThreadPerCore;
+  }
+
+  // minimum body size of HTTP responses that are compressed for clients
+  // which accept gzip or deflate, 0 if responses are never compressed
+  static uint64_t compressResponseThreshold() {
+    return GENERAL_SERVER != nullptr ? GENERAL_SERVER->_compressResponseThreshold : 0;
+  }
+
+  // maximum number of parts of a batch request that are executed
+  // concurrently, for clients that declare the parts independent
+  static uint64_t maxBatchConcurrency() {
+    return GENERAL_SERVER != nullptr ? GENERAL_SERVER->_maxBatchConcurrency : 1;
+  }
+
+  // maximum number of pipelined requests of an HTTP/1.1 connection that
+  // are executed concurrently
+  static uint64_t maxPipelinedRequests() {
+    return GENERAL_SERVER != nullptr ? GENERAL_SERVER->_maxPipelinedRequests : 1;
+  }
+
   static std::vector<std::string> const& accessControlAllowOrigins() {
     static std::vector<std::string> empty;
 
@@ -108,6 +132,11 @@ class GeneralServerFeature final : public application_features::ApplicationFeatu
   double _keepAliveTimeout = 300.0;
   bool _allowMethodOverride;
   bool _proxyCheck;
+  bool _ioThreadPerCore;
+  uint64_t _compressResponseThreshold;
+  uint64_t _maxBatchConcurrency;
+  uint64_t _maxPipelinedRequests;
+  uint64_t _asyncJobsMemoryLimit;
   std::vector<std::string> _trustedProxies;
   std::vector<std::string> _accessControlAllowOrigins;
   std::unique_ptr<rest::RestHandlerFactory> _handlerFactory;
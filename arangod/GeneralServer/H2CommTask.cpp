@@ -0,0 +1,1083 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2019 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "H2CommTask.h"
+
+#include "Basics/StaticStrings.h"
+#include "Basics/StringUtils.h"
+#include "Cluster/ServerState.h"
+#include "GeneralServer/AuthenticationFeature.h"
+#include "GeneralServer/GeneralServer.h"
+#include "GeneralServer/GeneralServerFeature.h"
+#include "GeneralServer/HttpCommTask.h"
+#include "Rest/HttpRequest.h"
+#include "Rest/HttpResponse.h"
+#include "Statistics/ConnectionStatistics.h"
+
+using namespace arangodb;
+using namespace arangodb::basics;
+using namespace arangodb::rest;
+
+char const* H2CommTask::Preface = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+size_t const H2CommTask::PrefaceLength = 24;
+size_t const H2CommTask::PrefaceHeaderLength = 18;
+size_t const H2CommTask::MaxConcurrentStreams = 256;
+uint32_t const H2CommTask::ReceiveWindow = 1024 * 1024;  // 1 MB
+
+namespace {
+size_t const frameHeaderLength = 9;
+
+// we never announce a larger SETTINGS_MAX_FRAME_SIZE
+uint32_t const maxFrameSize = 16384;
+
+// initial flow control window, RFC 7540, 6.9.2
+uint32_t const defaultWindowSize = 65535;
+int64_t const maxWindowSize = 0x7fffffff;
+
+uint8_t const flagEndStream = 0x1;
+uint8_t const flagAck = 0x1;
+uint8_t const flagEndHeaders = 0x4;
+uint8_t const flagPadded = 0x8;
+uint8_t const flagPriority = 0x20;
+
+uint16_t const settingsHeaderTableSize = 0x1;
+uint16_t const settingsEnablePush = 0x2;
+uint16_t const settingsMaxConcurrentStreams = 0x3;
+uint16_t const settingsInitialWindowSize = 0x4;
+uint16_t const settingsMaxFrameSize = 0x5;
+uint16_t const settingsMaxHeaderListSize = 0x6;
+
+uint32_t readUInt32(char const* p) {
+  return (static_cast<uint32_t>(static_cast<uint8_t>(p[0])) << 24) |
+         (static_cast<uint32_t>(static_cast<uint8_t>(p[1])) << 16) |
+         (static_cast<uint32_t>(static_cast<uint8_t>(p[2])) << 8) |
+         (static_cast<uint32_t>(static_cast<uint8_t>(p[3])));
+}
+
+void appendUInt32(std::string& out, uint32_t value) {
+  out.push_back(static_cast<char>(value >> 24));
+  out.push_back(static_cast<char>(value >> 16));
+  out.push_back(static_cast<char>(value >> 8));
+  out.push_back(static_cast<char>(value));
+}
+
+void appendSetting(std::string& out, uint16_t id, uint32_t value) {
+  out.push_back(static_cast<char>(id >> 8));
+  out.push_back(static_cast<char>(id));
+  appendUInt32(out, value);
+}
+
+// header fields that only make sense for HTTP/1.x, RFC 7540, 8.1.2.2
+bool isConnectionSpecific(std::string const& name) {
+  return name == StaticStrings::Connection || name == "keep-alive" ||
+         name == "proxy-connection" || name == "transfer-encoding" || name == "upgrade";
+}
+
+bool isValidName(std::string const& name) {
+  if (name.empty()) {
+    return false;
+  }
+  for (char c : name) {
+    // field names must be lower case, RFC 7540, 8.1.2
+    if (c <= ' ' || c == ':' || c == 0x7f || (c >= 'A' && c <= 'Z')) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool isValidValue(std::string const& value) {
+  return value.find_first_of(std::string("\r\n\0", 3)) == std::string::npos;
+}
+
+char const* contentTypeValue(ContentType type) {
+  switch (type) {
+    case ContentType::UNSET:
+    case ContentType::JSON:
+      return "application/json; charset=utf-8";
+    case ContentType::VPACK:
+      return "application/x-velocypack";
+    case ContentType::TEXT:
+      return "text/plain; charset=utf-8";
+    case ContentType::HTML:
+      return "text/html; charset=utf-8";
+    case ContentType::DUMP:
+      return "application/x-arango-dump; charset=utf-8";
+    case ContentType::CUSTOM:
+      // the header has been set explicitly
+      return nullptr;
+  }
+  return nullptr;
+}
+}  // namespace
+
+H2CommTask::Stream::Stream(uint32_t sendWindow)
+    : receivedBytes(0),
+      receivedSinceUpdate(0),
+      sendWindow(sendWindow),
+      requestType(rest::RequestType::ILLEGAL),
+      headersComplete(false),
+      endStream(false),
+      refused(false),
+      pendingOffset(0),
+      statistics(nullptr) {}
+
+H2CommTask::H2CommTask(GeneralServer& server, GeneralServer::IoContext& context,
+                       std::unique_ptr<Socket> socket, ConnectionInfo&& info,
+                       double timeout, bool skipSocketInit)
+    : GeneralCommTask(server, context, "H2CommTask", std::move(socket),
+                      std::move(info), timeout, skipSocketInit),
+      _output(nullptr),
+      _readPosition(0),
+      _lastStreamId(0),
+      _continuationStreamId(0),
+      _continuationEndStream(false),
+      _settingsSent(false),
+      _goAwayReceived(false),
+      _allowMethodOverride(GeneralServerFeature::allowMethodOverride()),
+      _sendWindow(defaultWindowSize),
+      _receivedSinceUpdate(0),
+      _peerInitialWindowSize(defaultWindowSize),
+      _peerMaxFrameSize(maxFrameSize) {
+  _protocol = "http";
+  _protocolVersion = rest::ProtocolVersion::HTTP_2;
+
+  ConnectionStatistics::SET_HTTP(_connectionStatistics);
+}
+
+H2CommTask::~H2CommTask() {
+  for (auto& it : _streams) {
+    if (it.second.statistics != nullptr) {
+      it.second.statistics->release();
+    }
+  }
+  delete _output;
+}
+
+// whether or not this task can mix sync and async I/O
+bool H2CommTask::canUseMixedIO() const {
+  // in case SSL is used, we cannot use a combination of sync and async I/O
+  // because that will make TLS fall apart
+  return !_peer->isEncrypted();
+}
+
+// reads frames from the read buffer
+// caller must hold the _lock
+bool H2CommTask::processRead(double startTime) {
+  TRI_ASSERT(_peer->runningInThisThread());
+
+  cancelKeepAlive();
+
+  if (!_settingsSent) {
+    sendSettings();
+  }
+
+  char const* p = _readBuffer.c_str() + _readPosition;
+  size_t const available = _readBuffer.length() - _readPosition;
+
+  uint32_t const length =
+      available < frameHeaderLength
+          ? 0
+          : (static_cast<uint32_t>(static_cast<uint8_t>(p[0])) << 16) |
+                (static_cast<uint32_t>(static_cast<uint8_t>(p[1])) << 8) |
+                static_cast<uint32_t>(static_cast<uint8_t>(p[2]));
+
+  if (length > maxFrameSize) {
+    return connectionError(ErrorCode::FRAME_SIZE_ERROR, "frame too large");
+  }
+
+  if (available < frameHeaderLength + length) {
+    // let the client send more, but send out what we have
+    flushOutput();
+    if (_streams.empty()) {
+      resetKeepAlive();
+    }
+    return false;
+  }
+
+  Frame frame;
+  frame.length = length;
+  frame.type = static_cast<FrameType>(p[3]);
+  frame.flags = static_cast<uint8_t>(p[4]);
+  frame.streamId = readUInt32(p + 5) & 0x7fffffff;
+  frame.payload = p + frameHeaderLength;
+
+  _readPosition += frameHeaderLength + frame.length;
+
+  if (!processFrame(frame, startTime)) {
+    return false;
+  }
+
+  return true;
+}
+
+bool H2CommTask::processFrame(Frame const& frame, double startTime) {
+  if (_continuationStreamId != 0 && (frame.type != FrameType::CONTINUATION ||
+                                     frame.streamId != _continuationStreamId)) {
+    return connectionError(ErrorCode::PROTOCOL_ERROR, "expected CONTINUATION");
+  }
+
+  switch (frame.type) {
+    case FrameType::DATA:
+      return processData(frame);
+    case FrameType::HEADERS:
+      return processHeaders(frame, startTime);
+    case FrameType::PRIORITY:
+      // we do not prioritize streams
+      if (frame.streamId == 0) {
+        return connectionError(ErrorCode::PROTOCOL_ERROR, "PRIORITY on stream 0");
+      }
+      if (frame.length != 5) {
+        resetStream(frame.streamId, ErrorCode::FRAME_SIZE_ERROR);
+      }
+      return true;
+    case FrameType::RST_STREAM:
+      return processRstStream(frame);
+    case FrameType::SETTINGS:
+      return processSettings(frame);
+    case FrameType::PUSH_PROMISE:
+      return connectionError(ErrorCode::PROTOCOL_ERROR,
+                             "clients must not send PUSH_PROMISE");
+    case FrameType::PING:
+      return processPing(frame);
+    case FrameType::GOAWAY:
+      return processGoAway(frame);
+    case FrameType::WINDOW_UPDATE:
+      return processWindowUpdate(frame);
+    case FrameType::CONTINUATION:
+      return processContinuation(frame);
+  }
+
+  // unknown frame types must be ignored, RFC 7540, 4.1
+  return true;
+}
+
+bool H2CommTask::processHeaders(Frame const& frame, double startTime) {
+  uint32_t const id = frame.streamId;
+  if (id == 0 || (id & 1) == 0) {
+    return connectionError(ErrorCode::PROTOCOL_ERROR, "invalid stream id");
+  }
+
+  size_t offset = 0;
+  size_t padding = 0;
+  if (frame.flags & flagPadded) {
+    if (frame.length < 1) {
+      return connectionError(ErrorCode::FRAME_SIZE_ERROR, "invalid HEADERS frame");
+    }
+    padding = static_cast<uint8_t>(frame.payload[0]);
+    offset = 1;
+  }
+  if (frame.flags & flagPriority) {
+    offset += 5;
+  }
+  if (offset + padding > frame.length) {
+    return connectionError(ErrorCode::PROTOCOL_ERROR, "invalid HEADERS padding");
+  }
+
+  auto it = _streams.find(id);
+  if (it == _streams.end()) {
+    if (id <= _lastStreamId) {
+      return connectionError(ErrorCode::STREAM_CLOSED, "HEADERS on closed stream");
+    }
+    _lastStreamId = id;
+    it = _streams.emplace(id, Stream(_peerInitialWindowSize)).first;
+
+    // the header block must be decoded in any case, to keep the dynamic
+    // table in sync
+    it->second.refused = _goAwayReceived || _streams.size() > MaxConcurrentStreams;
+
+    RequestStatistics* stat = acquireStatistics(id);
+    RequestStatistics::SET_READ_START(stat, startTime);
+  } else if (!it->second.headersComplete || it->second.endStream ||
+             (frame.flags & flagEndStream) == 0) {
+    // trailers must end the stream
+    return connectionError(ErrorCode::PROTOCOL_ERROR, "unexpected HEADERS");
+  }
+
+  Stream& stream = it->second;
+  stream.headerBlock.append(frame.payload + offset, frame.length - offset - padding);
+  stream.receivedBytes += frameHeaderLength + frame.length;
+
+  bool const endStream = (frame.flags & flagEndStream) != 0;
+  if (frame.flags & flagEndHeaders) {
+    return processHeaderBlock(id, endStream);
+  }
+
+  _continuationStreamId = id;
+  _continuationEndStream = endStream;
+  return true;
+}
+
+bool H2CommTask::processContinuation(Frame const& frame) {
+  if (_continuationStreamId == 0) {
+    return connectionError(ErrorCode::PROTOCOL_ERROR, "unexpected CONTINUATION");
+  }
+
+  auto it = _streams.find(frame.streamId);
+  TRI_ASSERT(it != _streams.end());
+  Stream& stream = it->second;
+  stream.headerBlock.append(frame.payload, frame.length);
+  stream.receivedBytes += frameHeaderLength + frame.length;
+
+  if (stream.headerBlock.size() > HttpCommTask::MaximalHeaderSize) {
+    return connectionError(ErrorCode::ENHANCE_YOUR_CALM, "header block too large");
+  }
+
+  if (frame.flags & flagEndHeaders) {
+    _continuationStreamId = 0;
+    return processHeaderBlock(frame.streamId, _continuationEndStream);
+  }
+  return true;
+}
+
+bool H2CommTask::processHeaderBlock(uint32_t streamId, bool endStream) {
+  auto it = _streams.find(streamId);
+  TRI_ASSERT(it != _streams.end());
+  Stream& stream = it->second;
+
+  std::vector<hpack::HeaderField> fields;
+  bool const ok = _decoder.decode(reinterpret_cast<uint8_t const*>(stream.headerBlock.data()),
+                                  stream.headerBlock.size(), fields);
+  stream.headerBlock.clear();
+  stream.headerBlock.shrink_to_fit();
+
+  if (!ok) {
+    return connectionError(ErrorCode::COMPRESSION_ERROR, "invalid header block");
+  }
+
+  if (!stream.headersComplete) {
+    stream.headers = std::move(fields);
+    stream.headersComplete = true;
+  }
+  // trailers are ignored
+
+  if (stream.refused) {
+    resetStream(streamId, ErrorCode::REFUSED_STREAM);
+    return true;
+  }
+
+  if (endStream) {
+    stream.endStream = true;
+    processRequest(streamId, stream);
+  }
+  return true;
+}
+
+bool H2CommTask::processData(Frame const& frame) {
+  uint32_t const id = frame.streamId;
+  if (id == 0) {
+    return connectionError(ErrorCode::PROTOCOL_ERROR, "DATA on stream 0");
+  }
+
+  size_t offset = 0;
+  size_t padding = 0;
+  if (frame.flags & flagPadded) {
+    if (frame.length < 1) {
+      return connectionError(ErrorCode::FRAME_SIZE_ERROR, "invalid DATA frame");
+    }
+    padding = static_cast<uint8_t>(frame.payload[0]);
+    offset = 1;
+  }
+  if (offset + padding > frame.length) {
+    return connectionError(ErrorCode::PROTOCOL_ERROR, "invalid DATA padding");
+  }
+
+  // the whole frame counts against the connection window
+  if (frame.length > ReceiveWindow - _receivedSinceUpdate) {
+    return connectionError(ErrorCode::FLOW_CONTROL_ERROR, "connection window exceeded");
+  }
+  _receivedSinceUpdate += frame.length;
+  if (_receivedSinceUpdate >= ReceiveWindow / 2) {
+    sendWindowUpdate(0, _receivedSinceUpdate);
+    _receivedSinceUpdate = 0;
+  }
+
+  auto it = _streams.find(id);
+  if (it == _streams.end() || !it->second.headersComplete || it->second.endStream) {
+    if (id > _lastStreamId) {
+      return connectionError(ErrorCode::PROTOCOL_ERROR, "DATA on idle stream");
+    }
+    // the stream was reset, the peer may not know yet
+    return true;
+  }
+
+  Stream& stream = it->second;
+  if (frame.length > ReceiveWindow - stream.receivedSinceUpdate) {
+    resetStream(id, ErrorCode::FLOW_CONTROL_ERROR);
+    return true;
+  }
+
+  stream.receivedBytes += frameHeaderLength + frame.length;
+  stream.body.append(frame.payload + offset, frame.length - offset - padding);
+
+  if (stream.body.size() > HttpCommTask::MaximalBodySize) {
+    resetStream(id, ErrorCode::CANCEL);
+    return true;
+  }
+
+  if (frame.flags & flagEndStream) {
+    stream.endStream = true;
+    processRequest(id, stream);
+    return true;
+  }
+
+  stream.receivedSinceUpdate += frame.length;
+  if (stream.receivedSinceUpdate >= ReceiveWindow / 2) {
+    sendWindowUpdate(id, stream.receivedSinceUpdate);
+    stream.receivedSinceUpdate = 0;
+  }
+  return true;
+}
+
+bool H2CommTask::processSettings(Frame const& frame) {
+  if (frame.streamId != 0) {
+    return connectionError(ErrorCode::PROTOCOL_ERROR, "SETTINGS on a stream");
+  }
+  if (frame.flags & flagAck) {
+    if (frame.length != 0) {
+      return connectionError(ErrorCode::FRAME_SIZE_ERROR, "invalid SETTINGS ack");
+    }
+    return true;
+  }
+  if (frame.length % 6 != 0) {
+    return connectionError(ErrorCode::FRAME_SIZE_ERROR, "invalid SETTINGS frame");
+  }
+
+  for (uint32_t i = 0; i < frame.length; i += 6) {
+    char const* p = frame.payload + i;
+    uint16_t const id = static_cast<uint16_t>((static_cast<uint8_t>(p[0]) << 8) |
+                                              static_cast<uint8_t>(p[1]));
+    uint32_t const value = readUInt32(p + 2);
+
+    switch (id) {
+      case settingsEnablePush:
+        if (value > 1) {
+          return connectionError(ErrorCode::PROTOCOL_ERROR, "invalid ENABLE_PUSH");
+        }
+        break;
+      case settingsInitialWindowSize: {
+        if (value > maxWindowSize) {
+          return connectionError(ErrorCode::FLOW_CONTROL_ERROR,
+                                 "invalid INITIAL_WINDOW_SIZE");
+        }
+        // applies to the windows of all open streams, RFC 7540, 6.9.2
+        int64_t const delta = static_cast<int64_t>(value) - _peerInitialWindowSize;
+        for (auto& it : _streams) {
+          it.second.sendWindow += delta;
+          if (it.second.sendWindow > maxWindowSize) {
+            return connectionError(ErrorCode::FLOW_CONTROL_ERROR, "window too large");
+          }
+        }
+        _peerInitialWindowSize = value;
+        break;
+      }
+      case settingsMaxFrameSize:
+        if (value < maxFrameSize || value > 0xffffff) {
+          return connectionError(ErrorCode::PROTOCOL_ERROR, "invalid MAX_FRAME_SIZE");
+        }
+        _peerMaxFrameSize = value;
+        break;
+      case settingsHeaderTableSize:
+        // the encoder does not use the dynamic table
+      case settingsMaxConcurrentStreams:
+        // we do not push
+      case settingsMaxHeaderListSize:
+      default:
+        break;
+    }
+  }
+
+  appendFrame(FrameType::SETTINGS, flagAck, 0, nullptr, 0);
+  sendPendingData();
+  return true;
+}
+
+bool H2CommTask::processWindowUpdate(Frame const& frame) {
+  if (frame.length != 4) {
+    return connectionError(ErrorCode::FRAME_SIZE_ERROR, "invalid WINDOW_UPDATE");
+  }
+
+  uint32_t const increment = readUInt32(frame.payload) & 0x7fffffff;
+
+  if (frame.streamId == 0) {
+    if (increment == 0) {
+      return connectionError(ErrorCode::PROTOCOL_ERROR, "invalid window increment");
+    }
+    _sendWindow += increment;
+    if (_sendWindow > maxWindowSize) {
+      return connectionError(ErrorCode::FLOW_CONTROL_ERROR, "window too large");
+    }
+    sendPendingData();
+    return true;
+  }
+
+  auto it = _streams.find(frame.streamId);
+  if (it == _streams.end()) {
+    // the stream is already closed
+    return true;
+  }
+  if (increment == 0) {
+    resetStream(frame.streamId, ErrorCode::PROTOCOL_ERROR);
+    return true;
+  }
+  it->second.sendWindow += increment;
+  if (it->second.sendWindow > maxWindowSize) {
+    resetStream(frame.streamId, ErrorCode::FLOW_CONTROL_ERROR);
+    return true;
+  }
+  if (it->second.pending != nullptr) {
+    sendData(it);
+  }
+  return true;
+}
+
+bool H2CommTask::processRstStream(Frame const& frame) {
+  if (frame.streamId == 0 || frame.streamId > _lastStreamId) {
+    return connectionError(ErrorCode::PROTOCOL_ERROR, "invalid RST_STREAM");
+  }
+  if (frame.length != 4) {
+    return connectionError(ErrorCode::FRAME_SIZE_ERROR, "invalid RST_STREAM");
+  }
+
+  auto it = _streams.find(frame.streamId);
+  if (it != _streams.end()) {
+    // a response that is still in the making will be dropped
+    LOG_TOPIC("6a3f0", DEBUG, Logger::COMMUNICATION)
+        << "stream " << frame.streamId << " reset by peer, error code "
+        << readUInt32(frame.payload);
+    eraseStream(it);
+  }
+  return true;
+}
+
+bool H2CommTask::processPing(Frame const& frame) {
+  if (frame.streamId != 0) {
+    return connectionError(ErrorCode::PROTOCOL_ERROR, "PING on a stream");
+  }
+  if (frame.length != 8) {
+    return connectionError(ErrorCode::FRAME_SIZE_ERROR, "invalid PING");
+  }
+  if ((frame.flags & flagAck) == 0) {
+    appendFrame(FrameType::PING, flagAck, 0, frame.payload, frame.length);
+  }
+  return true;
+}
+
+bool H2CommTask::processGoAway(Frame const& frame) {
+  if (frame.streamId != 0) {
+    return connectionError(ErrorCode::PROTOCOL_ERROR, "GOAWAY on a stream");
+  }
+  if (frame.length < 8) {
+    return connectionError(ErrorCode::FRAME_SIZE_ERROR, "invalid GOAWAY");
+  }
+
+  LOG_TOPIC("c02b1", DEBUG, Logger::COMMUNICATION)
+      << "received GOAWAY, error code " << readUInt32(frame.payload + 4);
+
+  // finish the open streams, but do not accept new ones
+  _goAwayReceived = true;
+  return true;
+}
+
+void H2CommTask::processRequest(uint32_t streamId, Stream& stream) {
+  TRI_ASSERT(stream.endStream);
+
+  // rebuild the request header in HTTP/1.1 syntax, so that the HttpRequest
+  // parser can take it from here
+  std::string method;
+  std::string path;
+  std::string authority;
+  std::string cookies;
+  std::string fields;
+  bool seenRegularHeader = false;
+  int64_t contentLength = -1;
+
+  for (auto const& field : stream.headers) {
+    std::string const& name = field.first;
+    std::string const& value = field.second;
+
+    if (!isValidValue(value)) {
+      resetStream(streamId, ErrorCode::PROTOCOL_ERROR);
+      return;
+    }
+
+    if (!name.empty() && name[0] == ':') {
+      // pseudo header fields must precede all regular ones
+      if (seenRegularHeader) {
+        resetStream(streamId, ErrorCode::PROTOCOL_ERROR);
+        return;
+      }
+      if (name == ":method") {
+        method = value;
+      } else if (name == ":path") {
+        path = value;
+      } else if (name == ":authority") {
+        authority = value;
+      } else if (name != ":scheme") {
+        resetStream(streamId, ErrorCode::PROTOCOL_ERROR);
+        return;
+      }
+      continue;
+    }
+
+    seenRegularHeader = true;
+    if (!isValidName(name) || isConnectionSpecific(name)) {
+      resetStream(streamId, ErrorCode::PROTOCOL_ERROR);
+      return;
+    }
+
+    if (name == "cookie") {
+      // may be split into several fields, RFC 7540, 8.1.2.5
+      if (!cookies.empty()) {
+        cookies.append("; ");
+      }
+      cookies.append(value);
+      continue;
+    }
+    if (name == "te") {
+      continue;
+    }
+    if (name == StaticStrings::ContentLength) {
+      contentLength = StringUtils::int64(value);
+    }
+    fields.append(name).append(": ").append(value).append("\r\n");
+  }
+
+  if (method.empty() || path.empty()) {
+    resetStream(streamId, ErrorCode::PROTOCOL_ERROR);
+    return;
+  }
+  if (contentLength >= 0 && static_cast<uint64_t>(contentLength) != stream.body.size()) {
+    resetStream(streamId, ErrorCode::PROTOCOL_ERROR);
+    return;
+  }
+
+  std::string header;
+  header.reserve(method.size() + path.size() + authority.size() +
+                 cookies.size() + fields.size() + 40);
+  header.append(method).append(" ").append(path).append(" HTTP/1.1\r\n");
+  if (!authority.empty()) {
+    header.append("host: ").append(authority).append("\r\n");
+  }
+  if (!cookies.empty()) {
+    header.append("cookie: ").append(cookies).append("\r\n");
+  }
+  header.append(fields).append("\r\n");
+
+  std::unique_ptr<HttpRequest> request(
+      new HttpRequest(_connectionInfo, header.data(), header.size(), _allowMethodOverride));
+  request->setClientTaskId(_taskId);
+  request->setProtocol(_protocol);
+  request->_version = rest::ProtocolVersion::HTTP_2;
+  request->_messageId = streamId;
+  if (!stream.body.empty()) {
+    request->setBody(stream.body.data(), stream.body.size());
+  }
+  request->_contentLength = static_cast<int64_t>(stream.body.size());
+  stream.body.clear();
+  stream.body.shrink_to_fit();
+
+  stream.requestType = request->requestType();
+
+  RequestStatistics* stat = statistics(streamId);
+  RequestStatistics::SET_READ_END(stat);
+  RequestStatistics::SET_REQUEST_TYPE(stat, stream.requestType);
+  RequestStatistics::ADD_RECEIVED_BYTES(stat, stream.receivedBytes);
+
+  std::string const& fullUrl = request->fullUrl();
+  LOG_TOPIC("0de5c", DEBUG, Logger::REQUESTS)
+      << "\"h2-request-begin\",\"" << (void*)this << "/" << streamId << "\",\""
+      << _connectionInfo.clientAddress << "\",\""
+      << HttpRequest::translateMethod(stream.requestType) << "\",\""
+      << (Logger::logRequestParameters() ? fullUrl
+                                         : fullUrl.substr(0, fullUrl.find_first_of('?')))
+      << "\"";
+
+  switch (stream.requestType) {
+    case rest::RequestType::GET:
+    case rest::RequestType::DELETE_REQ:
+    case rest::RequestType::HEAD:
+    case rest::RequestType::POST:
+    case rest::RequestType::PUT:
+    case rest::RequestType::PATCH:
+      break;
+
+    case rest::RequestType::OPTIONS: {
+      // OPTIONS requests currently go unauthenticated
+      HttpResponse resp(rest::ResponseCode::OK, leaseStringBuffer(0));
+      resp._messageId = streamId;
+      resp.setHeaderNCIfNotSet(StaticStrings::Allow, StaticStrings::CorsMethods);
+      addResponse(resp, stealStatistics(streamId));
+      return;
+    }
+
+    default: {
+      addSimpleResponse(rest::ResponseCode::METHOD_NOT_ALLOWED,
+                        rest::ContentType::UNSET, streamId, VPackBuffer<uint8_t>());
+      return;
+    }
+  }
+
+  if (fullUrl.size() > 16384) {
+    addSimpleResponse(rest::ResponseCode::REQUEST_URI_TOO_LONG,
+                      rest::ContentType::UNSET, streamId, VPackBuffer<uint8_t>());
+    return;
+  }
+
+  // first scrape the auth headers and try to determine and authenticate the
+  // user
+  rest::ResponseCode authResult = handleAuthHeader(request.get());
+
+  if (authResult == rest::ResponseCode::SERVER_ERROR) {
+    HttpResponse resp(rest::ResponseCode::UNAUTHORIZED, leaseStringBuffer(0));
+    resp._messageId = streamId;
+    resp.setHeaderNC(StaticStrings::WwwAuthenticate,
+                     "Bearer token_type=\"JWT\", realm=\"ArangoDB\"");
+    addResponse(resp, stealStatistics(streamId));
+    return;
+  }
+
+  // prepare execution will send an error message
+  RequestFlow cont = prepareExecution(*request.get());
+  if (cont == RequestFlow::Continue) {
+    auto resp = createResponse(rest::ResponseCode::SERVER_ERROR, streamId);
+    resp->setContentType(request->contentTypeResponse());
+    resp->setContentTypeRequested(request->contentTypeResponse());
+
+    executeRequest(std::move(request), std::move(resp));
+  }
+}
+
+std::unique_ptr<GeneralResponse> H2CommTask::createResponse(rest::ResponseCode responseCode,
+                                                            uint64_t messageId) {
+  auto response = std::make_unique<HttpResponse>(responseCode, leaseStringBuffer(0));
+  response->_messageId = messageId;
+  return response;
+}
+
+/// @brief send error response including response body
+void H2CommTask::addSimpleResponse(rest::ResponseCode code, rest::ContentType respType,
+                                   uint64_t messageId, velocypack::Buffer<uint8_t>&& buffer) {
+  try {
+    HttpResponse resp(code, leaseStringBuffer(buffer.size()));
+    resp._messageId = messageId;
+    resp.setContentType(respType);
+    if (!buffer.empty()) {
+      resp.setPayload(std::move(buffer), true, VPackOptions::Defaults);
+    }
+    addResponse(resp, stealStatistics(messageId));
+  } catch (std::exception const& ex) {
+    LOG_TOPIC("9e4d7", WARN, Logger::COMMUNICATION)
+        << "addSimpleResponse received an exception, closing connection:" << ex.what();
+    _closeRequested = true;
+  } catch (...) {
+    LOG_TOPIC("1f8b6", WARN, Logger::COMMUNICATION)
+        << "addSimpleResponse received an exception, closing connection";
+    _closeRequested = true;
+  }
+}
+
+void H2CommTask::addResponse(GeneralResponse& baseResponse, RequestStatistics* stat) {
+  TRI_ASSERT(_peer->runningInThisThread());
+
+#ifdef ARANGODB_ENABLE_MAINTAINER_MODE
+  HttpResponse& response = dynamic_cast<HttpResponse&>(baseResponse);
+#else
+  HttpResponse& response = static_cast<HttpResponse&>(baseResponse);
+#endif
+
+  finishExecution(baseResponse);
+
+  uint32_t const streamId = static_cast<uint32_t>(response.messageId());
+  auto it = _streams.find(streamId);
+  if (it == _streams.end()) {
+    // the stream was reset in the meantime
+    if (stat != nullptr) {
+      stat->release();
+    }
+    return;
+  }
+
+  Stream& stream = it->second;
+  TRI_ASSERT(stream.pending == nullptr);
+
+  if (!ServerState::instance()->isDBServer()) {
+    // DB server is not user-facing, and does not need to set this header
+    // use "IfNotSet" to not overwrite an existing response header
+    response.setHeaderNCIfNotSet(StaticStrings::XContentTypeOptions, StaticStrings::NoSniff);
+  }
+
+  if (stream.requestType == rest::RequestType::HEAD) {
+    // HEAD must not return a body
+    response.headResponse(response.bodySize());
+  }
+
+  std::string block;
+  encodeHeaders(response, block);
+
+  std::unique_ptr<StringBuffer> body = response.stealBody();
+  bool const endStream = body == nullptr || body->empty();
+  sendHeaders(streamId, block, endStream);
+
+  double const totalTime = RequestStatistics::ELAPSED_SINCE_READ_START(stat);
+  LOG_TOPIC("47b1e", INFO, Logger::REQUESTS)
+      << "\"h2-request-end\",\"" << (void*)this << "/" << streamId << "\",\""
+      << _connectionInfo.clientAddress << "\",\""
+      << HttpRequest::translateMethod(stream.requestType) << "\","
+      << static_cast<int>(response.responseCode()) << ","
+      << (endStream ? 0 : body->length()) << "," << Logger::FIXED(totalTime, 6);
+
+  stream.statistics = stat;
+
+  if (endStream) {
+    if (body != nullptr) {
+      returnStringBuffer(body.release());
+    }
+    flushOutput(stream.statistics);
+    stream.statistics = nullptr;
+    eraseStream(it);
+  } else {
+    stream.pending = std::move(body);
+    stream.pendingOffset = 0;
+    sendData(it);
+  }
+
+  if (_streams.empty()) {
+    resetKeepAlive();
+  }
+}
+
+void H2CommTask::encodeHeaders(HttpResponse& response, std::string& block) const {
+  hpack::Encoder::encode(":status",
+                         StringUtils::itoa(static_cast<int32_t>(response.responseCode())),
+                         block);
+
+  bool seenServerHeader = false;
+  for (auto const& it : response.headers()) {
+    std::string const name = StringUtils::tolower(it.first);
+
+    if (name == StaticStrings::ContentLength || isConnectionSpecific(name)) {
+      continue;
+    }
+    if (name == StaticStrings::Server) {
+      seenServerHeader = true;
+    }
+    hpack::Encoder::encode(name, it.second, block);
+  }
+
+  if (!seenServerHeader && !HttpResponse::HIDE_PRODUCT_HEADER) {
+    hpack::Encoder::encode(StaticStrings::Server, "ArangoDB", block);
+  }
+
+  char const* contentType = contentTypeValue(response._contentType);
+  if (contentType != nullptr) {
+    hpack::Encoder::encode(StaticStrings::ContentTypeHeader, contentType, block);
+  }
+
+  for (auto const& cookie : response._cookies) {
+    hpack::Encoder::encode("set-cookie", cookie, block);
+  }
+
+  hpack::Encoder::encode(StaticStrings::ContentLength,
+                         StringUtils::itoa(static_cast<uint64_t>(response.bodySize())),
+                         block);
+}
+
+void H2CommTask::sendHeaders(uint32_t streamId, std::string const& block, bool endStream) {
+  // the header block must not be interleaved with other frames
+  size_t offset = 0;
+  FrameType type = FrameType::HEADERS;
+  do {
+    size_t const length = std::min<size_t>(block.size() - offset, _peerMaxFrameSize);
+    uint8_t flags = 0;
+    if (type == FrameType::HEADERS && endStream) {
+      flags |= flagEndStream;
+    }
+    if (offset + length == block.size()) {
+      flags |= flagEndHeaders;
+    }
+    appendFrame(type, flags, streamId, block.data() + offset, length);
+    offset += length;
+    type = FrameType::CONTINUATION;
+  } while (offset < block.size());
+}
+
+// sends as much of the pending response body as the windows allow
+void H2CommTask::sendData(StreamMap::iterator it) {
+  Stream& stream = it->second;
+  TRI_ASSERT(stream.pending != nullptr);
+
+  size_t const total = stream.pending->length();
+  while (stream.pendingOffset < total) {
+    int64_t window = std::min(_sendWindow, stream.sendWindow);
+    if (window <= 0) {
+      // wait for WINDOW_UPDATE
+      return;
+    }
+
+    size_t const length = std::min<size_t>(
+        std::min<size_t>(total - stream.pendingOffset, _peerMaxFrameSize),
+        static_cast<size_t>(window));
+    bool const last = stream.pendingOffset + length == total;
+
+    appendFrame(FrameType::DATA, last ? flagEndStream : 0, it->first,
+                stream.pending->c_str() + stream.pendingOffset, length);
+    stream.pendingOffset += length;
+    _sendWindow -= length;
+    stream.sendWindow -= length;
+  }
+
+  // response complete, the statistics go with the last write
+  returnStringBuffer(stream.pending.release());
+  flushOutput(stream.statistics);
+  stream.statistics = nullptr;
+  eraseStream(it);
+}
+
+void H2CommTask::sendPendingData() {
+  std::vector<uint32_t> ids;
+  for (auto const& it : _streams) {
+    if (it.second.pending != nullptr) {
+      ids.push_back(it.first);
+    }
+  }
+  // oldest streams first
+  std::sort(ids.begin(), ids.end());
+
+  for (uint32_t id : ids) {
+    if (_sendWindow <= 0) {
+      break;
+    }
+    auto it = _streams.find(id);
+    if (it != _streams.end()) {
+      sendData(it);
+    }
+  }
+}
+
+void H2CommTask::sendSettings() {
+  std::string payload;
+  appendSetting(payload, settingsMaxConcurrentStreams,
+                static_cast<uint32_t>(MaxConcurrentStreams));
+  appendSetting(payload, settingsInitialWindowSize, ReceiveWindow);
+  appendSetting(payload, settingsMaxHeaderListSize,
+                static_cast<uint32_t>(HttpCommTask::MaximalHeaderSize));
+  appendFrame(FrameType::SETTINGS, 0, 0, payload.data(), payload.size());
+
+  // the connection window can only be changed by WINDOW_UPDATE
+  sendWindowUpdate(0, ReceiveWindow - defaultWindowSize);
+  _settingsSent = true;
+}
+
+void H2CommTask::sendWindowUpdate(uint32_t streamId, uint32_t increment) {
+  std::string payload;
+  appendUInt32(payload, increment);
+  appendFrame(FrameType::WINDOW_UPDATE, 0, streamId, payload.data(), payload.size());
+}
+
+void H2CommTask::resetStream(uint32_t streamId, ErrorCode code) {
+  LOG_TOPIC("8b2d4", DEBUG, Logger::COMMUNICATION)
+      << "resetting stream " << streamId << ", error code " << static_cast<uint32_t>(code);
+
+  std::string payload;
+  appendUInt32(payload, static_cast<uint32_t>(code));
+  appendFrame(FrameType::RST_STREAM, 0, streamId, payload.data(), payload.size());
+
+  auto it = _streams.find(streamId);
+  if (it != _streams.end()) {
+    eraseStream(it);
+  }
+}
+
+bool H2CommTask::connectionError(ErrorCode code, char const* reason) {
+  LOG_TOPIC("e4a19", DEBUG, Logger::COMMUNICATION)
+      << "closing HTTP/2 connection: " << reason;
+
+  std::string payload;
+  appendUInt32(payload, _lastStreamId);
+  appendUInt32(payload, static_cast<uint32_t>(code));
+  payload.append(reason);
+  appendFrame(FrameType::GOAWAY, 0, 0, payload.data(), payload.size());
+  flushOutput();
+
+  _readPosition = _readBuffer.length();
+  _closeRequested = true;
+  return false;
+}
+
+void H2CommTask::eraseStream(StreamMap::iterator it) {
+  RequestStatistics* stat = stealStatistics(it->first);
+  if (stat != nullptr) {
+    stat->release();
+  }
+  if (it->second.statistics != nullptr) {
+    it->second.statistics->release();
+  }
+  _streams.erase(it);
+}
+
+void H2CommTask::appendFrame(FrameType type, uint8_t flags, uint32_t streamId,
+                             char const* payload, size_t length) {
+  TRI_ASSERT(length <= 0xffffff);
+
+  if (_output == nullptr) {
+    _output = leaseStringBuffer(frameHeaderLength + length);
+  }
+
+  char header[frameHeaderLength];
+  header[0] = static_cast<char>(length >> 16);
+  header[1] = static_cast<char>(length >> 8);
+  header[2] = static_cast<char>(length);
+  header[3] = static_cast<char>(type);
+  header[4] = static_cast<char>(flags);
+  header[5] = static_cast<char>((streamId >> 24) & 0x7f);
+  header[6] = static_cast<char>(streamId >> 16);
+  header[7] = static_cast<char>(streamId >> 8);
+  header[8] = static_cast<char>(streamId);
+
+  _output->appendText(header, frameHeaderLength);
+  if (length > 0) {
+    _output->appendText(payload, length);
+  }
+}
+
+void H2CommTask::flushOutput(RequestStatistics* stat) {
+  if (_output == nullptr) {
+    if (stat != nullptr) {
+      stat->release();
+    }
+    return;
+  }
+
+  WriteBuffer buffer(_output, stat);
+  _output = nullptr;
+  addWriteBuffer(std::move(buffer));
+}
+
+void H2CommTask::compactify() {
+  if (_readPosition == _readBuffer.length()) {
+    _readBuffer.reset();
+    _readPosition = 0;
+  } else if (_readPosition > maxFrameSize) {
+    _readBuffer.erase_front(_readPosition);
+    _readPosition = 0;
+  }
+}
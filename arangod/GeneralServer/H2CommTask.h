@@ -0,0 +1,189 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2019 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_GENERAL_SERVER_H2_COMM_TASK_H
+#define ARANGOD_GENERAL_SERVER_H2_COMM_TASK_H 1
+
+#include "Basics/Common.h"
+#include "GeneralServer/GeneralCommTask.h"
+#include "GeneralServer/Hpack.h"
+
+namespace arangodb {
+class HttpResponse;
+
+namespace rest {
+
+// HTTP/2 (RFC 7540) without TLS. Clients with prior knowledge start the
+// connection with the HTTP/2 preface on a regular HTTP endpoint, the
+// HttpCommTask then hands over the connection to this task.
+//
+// Every stream carries exactly one request, its id is used as message id.
+// Requests of different streams are executed concurrently, responses are
+// sent in the order they are ready, subject to the flow control windows of
+// the peer.
+class H2CommTask final : public GeneralCommTask {
+ public:
+  // client connection preface, RFC 7540, 3.5
+  static char const* Preface;
+  static size_t const PrefaceLength;
+  // the part of the preface that looks like an HTTP/1.x request header
+  static size_t const PrefaceHeaderLength;
+
+  static size_t const MaxConcurrentStreams;
+  static uint32_t const ReceiveWindow;
+
+ public:
+  H2CommTask(GeneralServer& server, GeneralServer::IoContext& context,
+             std::unique_ptr<Socket> socket, ConnectionInfo&&, double timeout,
+             bool skipSocketInit = false);
+
+  ~H2CommTask();
+
+  arangodb::Endpoint::TransportType transportType() override {
+    return arangodb::Endpoint::TransportType::HTTP;
+  }
+
+  // whether or not this task can mix sync and async I/O
+  bool canUseMixedIO() const override;
+
+ private:
+  bool processRead(double startTime) override;
+  void compactify() override;
+
+  std::unique_ptr<GeneralResponse> createResponse(rest::ResponseCode,
+                                                  uint64_t messageId) override final;
+
+  void addResponse(GeneralResponse& response, RequestStatistics* stat) override;
+
+  /// @brief send error response including response body
+  void addSimpleResponse(rest::ResponseCode, rest::ContentType, uint64_t messageId,
+                         velocypack::Buffer<uint8_t>&&) override;
+
+ private:
+  enum class FrameType : uint8_t {
+    DATA = 0x0,
+    HEADERS = 0x1,
+    PRIORITY = 0x2,
+    RST_STREAM = 0x3,
+    SETTINGS = 0x4,
+    PUSH_PROMISE = 0x5,
+    PING = 0x6,
+    GOAWAY = 0x7,
+    WINDOW_UPDATE = 0x8,
+    CONTINUATION = 0x9
+  };
+
+  enum class ErrorCode : uint32_t {
+    NONE = 0x0,  // NO_ERROR, which is a macro on Windows
+    PROTOCOL_ERROR = 0x1,
+    INTERNAL_ERROR = 0x2,
+    FLOW_CONTROL_ERROR = 0x3,
+    STREAM_CLOSED = 0x5,
+    FRAME_SIZE_ERROR = 0x6,
+    REFUSED_STREAM = 0x7,
+    CANCEL = 0x8,
+    COMPRESSION_ERROR = 0x9,
+    ENHANCE_YOUR_CALM = 0xb
+  };
+
+  struct Frame {
+    uint32_t length;
+    FrameType type;
+    uint8_t flags;
+    uint32_t streamId;
+    char const* payload;
+  };
+
+  struct Stream {
+    explicit Stream(uint32_t sendWindow);
+
+    std::string headerBlock;  // HEADERS and CONTINUATION fragments
+    std::vector<hpack::HeaderField> headers;
+    std::string body;
+    size_t receivedBytes;
+    uint32_t receivedSinceUpdate;  // DATA not yet acknowledged
+    int64_t sendWindow;
+    rest::RequestType requestType;
+    bool headersComplete;
+    bool endStream;  // the peer is done sending
+    bool refused;
+
+    // response body not yet sent because of flow control
+    std::unique_ptr<basics::StringBuffer> pending;
+    size_t pendingOffset;
+    RequestStatistics* statistics;  // released by eraseStream
+  };
+
+  typedef std::unordered_map<uint32_t, Stream> StreamMap;
+
+  // frame handlers, return false after a connection error
+  bool processFrame(Frame const&, double startTime);
+  bool processHeaders(Frame const&, double startTime);
+  bool processContinuation(Frame const&);
+  bool processHeaderBlock(uint32_t streamId, bool endStream);
+  bool processData(Frame const&);
+  bool processSettings(Frame const&);
+  bool processWindowUpdate(Frame const&);
+  bool processRstStream(Frame const&);
+  bool processPing(Frame const&);
+  bool processGoAway(Frame const&);
+
+  // turns a complete stream into an HttpRequest and executes it
+  void processRequest(uint32_t streamId, Stream&);
+
+  void encodeHeaders(HttpResponse&, std::string& block) const;
+  void sendHeaders(uint32_t streamId, std::string const& block, bool endStream);
+  void sendData(StreamMap::iterator);
+  void sendPendingData();
+
+  void sendSettings();
+  void sendWindowUpdate(uint32_t streamId, uint32_t increment);
+  void resetStream(uint32_t streamId, ErrorCode);
+  bool connectionError(ErrorCode, char const* reason);
+  void eraseStream(StreamMap::iterator);
+
+  // frames are collected in _output and written by flushOutput
+  void appendFrame(FrameType, uint8_t flags, uint32_t streamId,
+                   char const* payload, size_t length);
+  void flushOutput(RequestStatistics* stat = nullptr);
+
+ private:
+  hpack::Decoder _decoder;
+  StreamMap _streams;
+  basics::StringBuffer* _output;
+
+  size_t _readPosition;
+  uint32_t _lastStreamId;          // highest stream id opened by the peer
+  uint32_t _continuationStreamId;  // stream expecting CONTINUATION, or 0
+  bool _continuationEndStream;
+  bool _settingsSent;
+  bool _goAwayReceived;
+  bool const _allowMethodOverride;
+
+  int64_t _sendWindow;            // connection window of the peer
+  uint32_t _receivedSinceUpdate;  // DATA not yet acknowledged
+  uint32_t _peerInitialWindowSize;
+  uint32_t _peerMaxFrameSize;
+};
+}  // namespace rest
+}  // namespace arangodb
+
+#endif
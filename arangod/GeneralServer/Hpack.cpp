@@ -0,0 +1,457 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2019 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Hpack.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+using namespace arangodb::rest;
+using namespace arangodb::rest::hpack;
+
+namespace {
+
+// RFC 7541, Appendix A
+HeaderField const staticTable[] = {
+    {":authority", ""},
+    {":method", "GET"},
+    {":method", "POST"},
+    {":path", "/"},
+    {":path", "/index.html"},
+    {":scheme", "http"},
+    {":scheme", "https"},
+    {":status", "200"},
+    {":status", "204"},
+    {":status", "206"},
+    {":status", "304"},
+    {":status", "400"},
+    {":status", "404"},
+    {":status", "500"},
+    {"accept-charset", ""},
+    {"accept-encoding", "gzip, deflate"},
+    {"accept-language", ""},
+    {"accept-ranges", ""},
+    {"accept", ""},
+    {"access-control-allow-origin", ""},
+    {"age", ""},
+    {"allow", ""},
+    {"authorization", ""},
+    {"cache-control", ""},
+    {"content-disposition", ""},
+    {"content-encoding", ""},
+    {"content-language", ""},
+    {"content-length", ""},
+    {"content-location", ""},
+    {"content-range", ""},
+    {"content-type", ""},
+    {"cookie", ""},
+    {"date", ""},
+    {"etag", ""},
+    {"expect", ""},
+    {"expires", ""},
+    {"from", ""},
+    {"host", ""},
+    {"if-match", ""},
+    {"if-modified-since", ""},
+    {"if-none-match", ""},
+    {"if-range", ""},
+    {"if-unmodified-since", ""},
+    {"last-modified", ""},
+    {"link", ""},
+    {"location", ""},
+    {"max-forwards", ""},
+    {"proxy-authenticate", ""},
+    {"proxy-authorization", ""},
+    {"range", ""},
+    {"referer", ""},
+    {"refresh", ""},
+    {"retry-after", ""},
+    {"server", ""},
+    {"set-cookie", ""},
+    {"strict-transport-security", ""},
+    {"transfer-encoding", ""},
+    {"user-agent", ""},
+    {"vary", ""},
+    {"via", ""},
+    {"www-authenticate", ""},
+};
+
+size_t const staticTableLength = sizeof(staticTable) / sizeof(staticTable[0]);
+
+// per entry overhead in the dynamic table, RFC 7541, 4.1
+size_t const entryOverhead = 32;
+
+// Code lengths of the Huffman code of RFC 7541, Appendix B, for the
+// symbols 0 to 256 (EOS). The code is canonical, i.e. the codes follow
+// from the lengths alone: shorter codes come first, codes of the same
+// length are assigned in symbol order.
+uint8_t const huffmanCodeLengths[257] = {
+    13, 23, 28, 28, 28, 28, 28, 28, 28, 24, 30, 28, 28, 30, 28, 28, 28, 28, 28,
+    28, 28, 28, 30, 28, 28, 28, 28, 28, 28, 28, 28, 28, 6,  10, 10, 12, 13, 6,
+    8,  11, 10, 10, 8,  11, 8,  6,  6,  6,  5,  5,  5,  6,  6,  6,  6,  6,  6,
+    6,  7,  8,  15, 6,  12, 10, 13, 6,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,
+    7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  8,  7,  8,  13, 19, 13, 14,
+    6,  15, 5,  6,  5,  6,  5,  6,  6,  6,  5,  7,  7,  6,  6,  6,  5,  6,  7,
+    6,  5,  5,  6,  7,  7,  7,  7,  7,  15, 11, 14, 13, 28, 20, 22, 20, 20, 22,
+    22, 22, 23, 22, 23, 23, 23, 23, 23, 24, 23, 24, 24, 22, 23, 24, 23, 23, 23,
+    23, 21, 22, 23, 22, 23, 23, 24, 22, 21, 20, 22, 22, 23, 23, 21, 23, 22, 22,
+    24, 21, 22, 23, 23, 21, 21, 22, 21, 23, 22, 23, 23, 20, 22, 22, 22, 23, 22,
+    22, 23, 26, 26, 20, 19, 22, 23, 22, 25, 26, 26, 26, 27, 27, 26, 24, 25, 19,
+    21, 26, 27, 27, 26, 27, 24, 21, 21, 26, 26, 28, 27, 27, 27, 20, 24, 20, 21,
+    22, 21, 21, 23, 22, 22, 25, 25, 24, 24, 26, 23, 26, 27, 26, 26, 27, 27, 27,
+    27, 27, 28, 27, 27, 27, 27, 27, 26, 30};
+
+uint16_t const eos = 256;
+
+struct HuffmanCode {
+  uint32_t codes[257];
+
+  // binary decoding tree, node 0 is the root. Inner nodes have two
+  // children, leaves carry a symbol.
+  struct Node {
+    int16_t children[2];
+    int16_t symbol;
+  };
+  std::vector<Node> tree;
+
+  HuffmanCode() {
+    std::vector<uint16_t> symbols(257);
+    for (uint16_t i = 0; i < 257; ++i) {
+      symbols[i] = i;
+    }
+    std::stable_sort(symbols.begin(), symbols.end(), [](uint16_t a, uint16_t b) {
+      return huffmanCodeLengths[a] < huffmanCodeLengths[b];
+    });
+
+    uint32_t code = 0;
+    uint8_t length = huffmanCodeLengths[symbols[0]];
+    for (size_t i = 0; i < symbols.size(); ++i) {
+      uint8_t l = huffmanCodeLengths[symbols[i]];
+      if (i > 0) {
+        code = (code + 1) << (l - length);
+        length = l;
+      }
+      codes[symbols[i]] = code;
+    }
+
+    tree.push_back(Node{{-1, -1}, -1});
+    for (uint16_t s = 0; s < 257; ++s) {
+      size_t node = 0;
+      for (int bit = huffmanCodeLengths[s] - 1; bit >= 0; --bit) {
+        int b = (codes[s] >> bit) & 1;
+        if (tree[node].children[b] < 0) {
+          tree[node].children[b] = static_cast<int16_t>(tree.size());
+          tree.push_back(Node{{-1, -1}, -1});
+        }
+        node = tree[node].children[b];
+      }
+      tree[node].symbol = static_cast<int16_t>(s);
+    }
+  }
+};
+
+HuffmanCode const& huffman() {
+  static HuffmanCode const code;
+  return code;
+}
+
+// index of the first static table entry with a name
+std::unordered_map<std::string, uint8_t> const& staticNames() {
+  static std::unordered_map<std::string, uint8_t> const names = []() {
+    std::unordered_map<std::string, uint8_t> result;
+    for (size_t i = staticTableLength; i > 0; --i) {
+      result[staticTable[i - 1].first] = static_cast<uint8_t>(i);
+    }
+    return result;
+  }();
+  return names;
+}
+
+bool decodeString(uint8_t const*& p, uint8_t const* end, std::string& out) {
+  if (p == end) {
+    return false;
+  }
+  bool isHuffman = (*p & 0x80) != 0;
+  uint64_t length;
+  if (!decodeInteger(p, end, 7, length) || length > static_cast<uint64_t>(end - p)) {
+    return false;
+  }
+
+  out.clear();
+  if (isHuffman) {
+    if (!huffmanDecode(p, length, out)) {
+      return false;
+    }
+  } else {
+    out.assign(reinterpret_cast<char const*>(p), length);
+  }
+  p += length;
+  return true;
+}
+
+void encodeString(std::string const& value, std::string& out) {
+  size_t huffmanLength = huffmanEncodedLength(value.data(), value.size());
+  if (huffmanLength < value.size()) {
+    encodeInteger(huffmanLength, 7, 0x80, out);
+    huffmanEncode(value.data(), value.size(), out);
+  } else {
+    encodeInteger(value.size(), 7, 0x00, out);
+    out.append(value);
+  }
+}
+
+}  // namespace
+
+bool hpack::decodeInteger(uint8_t const*& p, uint8_t const* end,
+                          uint8_t prefixBits, uint64_t& value) {
+  if (p == end) {
+    return false;
+  }
+
+  uint8_t const mask = static_cast<uint8_t>((1 << prefixBits) - 1);
+  value = *p++ & mask;
+  if (value < mask) {
+    return true;
+  }
+
+  // no sane header block needs more than 2^35
+  for (unsigned shift = 0; shift <= 28; shift += 7) {
+    if (p == end) {
+      return false;
+    }
+    uint8_t b = *p++;
+    value += static_cast<uint64_t>(b & 0x7f) << shift;
+    if ((b & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void hpack::encodeInteger(uint64_t value, uint8_t prefixBits, uint8_t flags,
+                          std::string& out) {
+  uint8_t const mask = static_cast<uint8_t>((1 << prefixBits) - 1);
+  if (value < mask) {
+    out.push_back(static_cast<char>(flags | value));
+    return;
+  }
+
+  out.push_back(static_cast<char>(flags | mask));
+  value -= mask;
+  while (value >= 0x80) {
+    out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+bool hpack::huffmanDecode(uint8_t const* p, size_t length, std::string& out) {
+  auto const& tree = huffman().tree;
+
+  size_t node = 0;
+  unsigned depth = 0;  // bits since the last complete symbol
+  bool allOnes = true;
+
+  for (size_t i = 0; i < length; ++i) {
+    for (int bit = 7; bit >= 0; --bit) {
+      int b = (p[i] >> bit) & 1;
+      int16_t next = tree[node].children[b];
+      if (next < 0) {
+        return false;
+      }
+      node = next;
+      ++depth;
+      allOnes = allOnes && b == 1;
+
+      int16_t symbol = tree[node].symbol;
+      if (symbol >= 0) {
+        if (symbol == eos) {
+          // EOS must not appear in a string literal
+          return false;
+        }
+        out.push_back(static_cast<char>(symbol));
+        node = 0;
+        depth = 0;
+        allOnes = true;
+      }
+    }
+  }
+
+  // padding must be a prefix of EOS, and shorter than a byte
+  return depth < 8 && allOnes;
+}
+
+size_t hpack::huffmanEncodedLength(char const* p, size_t length) {
+  uint64_t bits = 0;
+  for (size_t i = 0; i < length; ++i) {
+    bits += huffmanCodeLengths[static_cast<uint8_t>(p[i])];
+  }
+  return static_cast<size_t>((bits + 7) / 8);
+}
+
+void hpack::huffmanEncode(char const* p, size_t length, std::string& out) {
+  auto const& codes = huffman().codes;
+
+  uint64_t pending = 0;   // bits not yet written, right aligned
+  unsigned numPending = 0;
+  for (size_t i = 0; i < length; ++i) {
+    uint8_t c = static_cast<uint8_t>(p[i]);
+    pending = (pending << huffmanCodeLengths[c]) | codes[c];
+    numPending += huffmanCodeLengths[c];
+    while (numPending >= 8) {
+      numPending -= 8;
+      out.push_back(static_cast<char>(pending >> numPending));
+    }
+  }
+
+  if (numPending > 0) {
+    // pad with the most significant bits of EOS, which are all ones
+    out.push_back(static_cast<char>((pending << (8 - numPending)) |
+                                    (0xff >> numPending)));
+  }
+}
+
+Decoder::Decoder(size_t maxTableSize)
+    : _maxTableSize(maxTableSize), _tableSizeLimit(maxTableSize), _tableSize(0) {}
+
+bool Decoder::decode(uint8_t const* data, size_t length, std::vector<HeaderField>& fields) {
+  uint8_t const* p = data;
+  uint8_t const* end = data + length;
+  bool first = true;
+
+  while (p < end) {
+    uint8_t const b = *p;
+
+    if (b & 0x80) {
+      // indexed header field
+      uint64_t index;
+      HeaderField const* field;
+      if (!decodeInteger(p, end, 7, index) || !this->field(index, field)) {
+        return false;
+      }
+      fields.emplace_back(*field);
+    } else if ((b & 0xe0) == 0x20) {
+      // dynamic table size update, only allowed at the start of a block
+      uint64_t size;
+      if (!first || !decodeInteger(p, end, 5, size) || size > _maxTableSize) {
+        return false;
+      }
+      _tableSizeLimit = static_cast<size_t>(size);
+      evict(_tableSizeLimit);
+      continue;
+    } else {
+      // literal header field, with incremental indexing (01), without
+      // indexing (0000) or never indexed (0001)
+      bool const indexing = (b & 0xc0) == 0x40;
+      uint64_t index;
+      if (!decodeInteger(p, end, indexing ? 6 : 4, index)) {
+        return false;
+      }
+
+      HeaderField f;
+      if (index == 0) {
+        if (!decodeString(p, end, f.first)) {
+          return false;
+        }
+      } else {
+        HeaderField const* field;
+        if (!this->field(index, field)) {
+          return false;
+        }
+        f.first = field->first;
+      }
+      if (!decodeString(p, end, f.second)) {
+        return false;
+      }
+
+      if (indexing) {
+        add(f.first, f.second);
+      }
+      fields.emplace_back(std::move(f));
+    }
+    first = false;
+  }
+
+  return true;
+}
+
+bool Decoder::field(uint64_t index, HeaderField const*& result) const {
+  if (index == 0) {
+    return false;
+  }
+  if (index <= staticTableLength) {
+    result = &staticTable[index - 1];
+    return true;
+  }
+  index -= staticTableLength + 1;
+  if (index >= _table.size()) {
+    return false;
+  }
+  result = &_table[static_cast<size_t>(index)];
+  return true;
+}
+
+void Decoder::add(std::string const& name, std::string const& value) {
+  size_t const size = name.size() + value.size() + entryOverhead;
+  if (size > _tableSizeLimit) {
+    // an entry larger than the table empties it, RFC 7541, 4.4
+    _table.clear();
+    _tableSize = 0;
+    return;
+  }
+  evict(_tableSizeLimit - size);
+  _table.emplace_front(name, value);
+  _tableSize += size;
+}
+
+void Decoder::evict(size_t limit) {
+  while (_tableSize > limit) {
+    HeaderField const& oldest = _table.back();
+    _tableSize -= oldest.first.size() + oldest.second.size() + entryOverhead;
+    _table.pop_back();
+  }
+}
+
+void Encoder::encode(std::string const& name, std::string const& value,
+                     std::string& out) {
+  auto const& names = staticNames();
+  auto it = names.find(name);
+
+  if (it == names.end()) {
+    // literal header field without indexing, new name
+    out.push_back(0x00);
+    encodeString(name, out);
+    encodeString(value, out);
+    return;
+  }
+
+  for (size_t i = it->second; i <= staticTableLength && staticTable[i - 1].first == name; ++i) {
+    if (staticTable[i - 1].second == value) {
+      // indexed header field
+      encodeInteger(i, 7, 0x80, out);
+      return;
+    }
+  }
+
+  // literal header field without indexing, indexed name
+  encodeInteger(it->second, 4, 0x00, out);
+  encodeString(value, out);
+}
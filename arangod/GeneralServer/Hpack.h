@@ -0,0 +1,92 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2019 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_GENERAL_SERVER_HPACK_H
+#define ARANGOD_GENERAL_SERVER_HPACK_H 1
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace arangodb {
+namespace rest {
+
+/// @brief header compression for HTTP/2 (RFC 7541)
+namespace hpack {
+
+typedef std::pair<std::string, std::string> HeaderField;
+
+/// @brief decodes the header blocks of one connection. The dynamic table
+/// is shared by all header blocks the peer sends, so a single decoder
+/// must see all of them in order.
+class Decoder {
+ public:
+  /// @brief maxTableSize is the SETTINGS_HEADER_TABLE_SIZE we announced
+  explicit Decoder(size_t maxTableSize = 4096);
+
+  /// @brief decodes a complete header block and appends its fields.
+  /// Returns false on a compression error, after which the connection
+  /// must be closed, because the dynamic table is out of sync.
+  bool decode(uint8_t const* data, size_t length, std::vector<HeaderField>& fields);
+
+  size_t tableSize() const { return _tableSize; }
+
+ private:
+  bool field(uint64_t index, HeaderField const*& result) const;
+  void add(std::string const& name, std::string const& value);
+  void evict(size_t limit);
+
+ private:
+  size_t const _maxTableSize;  // upper bound, as announced in SETTINGS
+  size_t _tableSizeLimit;      // current bound, as set by the peer
+  size_t _tableSize;           // sum of the entry sizes
+  std::deque<HeaderField> _table;  // newest entry first
+};
+
+/// @brief encodes header blocks. The encoder does not insert into the
+/// dynamic table, so it keeps no state and the peer's table stays empty.
+/// Fields are referenced from the static table where possible, strings are
+/// Huffman encoded if that is shorter.
+class Encoder {
+ public:
+  static void encode(std::string const& name, std::string const& value,
+                     std::string& out);
+};
+
+/// @brief integer representation with an N bit prefix (RFC 7541, 5.1).
+/// Returns false, if the input is truncated or the value overflows.
+bool decodeInteger(uint8_t const*& p, uint8_t const* end, uint8_t prefixBits,
+                   uint64_t& value);
+void encodeInteger(uint64_t value, uint8_t prefixBits, uint8_t flags, std::string& out);
+
+/// @brief Huffman code of RFC 7541, Appendix B
+bool huffmanDecode(uint8_t const* p, size_t length, std::string& out);
+void huffmanEncode(char const* p, size_t length, std::string& out);
+size_t huffmanEncodedLength(char const* p, size_t length);
+
+}  // namespace hpack
+}  // namespace rest
+}  // namespace arangodb
+
+#endif
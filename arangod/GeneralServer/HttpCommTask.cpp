@@ -24,28 +24,36 @@
 
 #include "HttpCommTask.h"
 
-#include "Basics/tri-strings.h"
 #include "Cluster/ServerState.h"
 #include "GeneralServer/AuthenticationFeature.h"
 #include "GeneralServer/GeneralServer.h"
 #include "GeneralServer/GeneralServerFeature.h"
+#include "GeneralServer/H2CommTask.h"
 #include "GeneralServer/RestHandler.h"
 #include "GeneralServer/RestHandlerFactory.h"
 #include "GeneralServer/VstCommTask.h"
 #include "Meta/conversion.h"
 #include "Rest/HttpRequest.h"
 #include "Rest/HttpResponse.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "Statistics/ConnectionStatistics.h"
-#include "Utils/Events.h"
 
 using namespace arangodb;
 using namespace arangodb::basics;
 using namespace arangodb::rest;
 
+namespace {
+// statistics of the request being read are kept under this id, the
+// requests of the pipeline get the ids after it
+constexpr uint64_t ReadingRequestId = 1;
+}  // namespace
+
 size_t const HttpCommTask::MaximalHeaderSize = 2 * 1024 * 1024;       //    2 MB
 size_t const HttpCommTask::MaximalBodySize = 1024 * 1024 * 1024;      // 1024 MB
 size_t const HttpCommTask::MaximalPipelineSize = 1024 * 1024 * 1024;  // 1024 MB
 size_t const HttpCommTask::RunCompactEvery = 500;
+size_t const HttpCommTask::MaxUnwrittenParts = 4;
 
 HttpCommTask::HttpCommTask(GeneralServer& server, GeneralServer::IoContext& context,
                            std::unique_ptr<Socket> socket,
@@ -63,7 +71,11 @@ HttpCommTask::HttpCommTask(GeneralServer& server, GeneralServer::IoContext& cont
       _fullUrl(),
       _origin(),
       _sinceCompactification(0),
-      _originalBodyLength(0) {
+      _originalBodyLength(0),
+      _lastMessageId(ReadingRequestId),
+      _pipeline(GeneralServerFeature::maxPipelinedRequests()),
+      _unwrittenParts(0),
+      _partsHandlerWaiting(false) {
   _protocol = "http";
 
   ConnectionStatistics::SET_HTTP(_connectionStatistics);
@@ -80,15 +92,16 @@ bool HttpCommTask::canUseMixedIO() const {
 
 /// @brief send error response including response body
 void HttpCommTask::addSimpleResponse(rest::ResponseCode code,
-                                     rest::ContentType respType, uint64_t /*messageId*/,
+                                     rest::ContentType respType, uint64_t messageId,
                                      velocypack::Buffer<uint8_t>&& buffer) {
   try {
     HttpResponse resp(code, leaseStringBuffer(buffer.size()));
+    resp._messageId = messageId;
     resp.setContentType(respType);
     if (!buffer.empty()) {
       resp.setPayload(std::move(buffer), true, VPackOptions::Defaults);
     }
-    addResponse(resp, stealStatistics(1UL));
+    addResponse(resp, stealStatistics(messageId));
   } catch (std::exception const& ex) {
     LOG_TOPIC("233e6", WARN, Logger::COMMUNICATION)
         << "addSimpleResponse received an exception, closing connection:" << ex.what();
@@ -110,71 +123,64 @@ void HttpCommTask::addResponse(GeneralResponse& baseResponse, RequestStatistics*
 #endif
 
   finishExecution(baseResponse);
-  resetKeepAlive();
-
-  // response has been queued, allow further requests
-  _requestPending = false;
-
-  // CORS response handling
-  if (!_origin.empty()) {
-    // the request contained an Origin header. We have to send back the
-    // access-control-allow-origin header now
-    LOG_TOPIC("ae603", TRACE, arangodb::Logger::FIXME) << "handling CORS response";
-
-    // send back original value of "Origin" header
-    response.setHeaderNCIfNotSet(StaticStrings::AccessControlAllowOrigin, _origin);
-
-    // send back "Access-Control-Allow-Credentials" header
-    response.setHeaderNCIfNotSet(StaticStrings::AccessControlAllowCredentials,
-                                 (_denyCredentials ? "false" : "true"));
 
-    // use "IfNotSet" here because we should not override HTTP headers set
-    // by Foxx applications
-    response.setHeaderNCIfNotSet(StaticStrings::AccessControlExposeHeaders,
-                                 StaticStrings::ExposedCorsHeaders);
+  std::shared_ptr<PipelinedRequest> request = _pipeline.find(response.messageId());
+  if (request == nullptr || request->response != nullptr) {
+    TRI_ASSERT(false);
+    LOG_TOPIC("5a7c3", WARN, Logger::COMMUNICATION)
+        << "dropping HTTP response for unknown request " << response.messageId();
+    if (stat != nullptr) {
+      stat->release();
+    }
+    return;
   }
 
-  if (!ServerState::instance()->isDBServer()) {
-    // DB server is not user-facing, and does not need to set this header
-    // use "IfNotSet" to not overwrite an existing response header
-    response.setHeaderNCIfNotSet(StaticStrings::XContentTypeOptions, StaticStrings::NoSniff);
+  // the header of a response sent in parts is out already
+  bool const sentInParts = (_partsHandler != nullptr && request == _partsRequest);
+  if (!sentInParts) {
+    prepareResponse(response, *request);
   }
 
-  // set "connection" header, keep-alive is the default
-  response.setConnectionType(_closeRequested ? rest::ConnectionType::C_CLOSE
-                                             : rest::ConnectionType::C_KEEP_ALIVE);
-
   size_t const responseBodyLength = response.bodySize();
 
-  if (_requestType == rest::RequestType::HEAD) {
+  if (request->requestType == rest::RequestType::HEAD) {
     // clear body if this is an HTTP HEAD request
     // HEAD must not return a body
     response.headResponse(responseBodyLength);
   }
 
-  // reserve a buffer with some spare capacity
-  WriteBuffer buffer(leaseStringBuffer(responseBodyLength + 220), stat);
+  // the header goes into a buffer of its own, the body is handed over
+  // as is and written right after it
+  WriteBuffer buffer(leaseStringBuffer(220), stat);
 
-  // write header
-  response.writeHeader(buffer._buffer);
+  if (sentInParts) {
+    writeLastResponsePart(response, buffer);
+  } else {
+    // write header
+    response.writeHeader(buffer._buffer);
+    buffer._buffer->ensureNullTerminated();
 
-  // write body
-  if (_requestType != rest::RequestType::HEAD) {
-    buffer._buffer->appendText(response.body());
+    std::unique_ptr<basics::StringBuffer> body = response.stealBody();
+    if (request->requestType == rest::RequestType::HEAD || body->empty()) {
+      returnStringBuffer(body.release());  // takes care of deleting
+    } else {
+      buffer._body = body.release();
+    }
   }
 
-  buffer._buffer->ensureNullTerminated();
-
-  if (!buffer._buffer->empty()) {
+  if (Logger::isEnabled(LogLevel::TRACE, Logger::REQUESTS)) {
     LOG_TOPIC("80778", TRACE, Logger::REQUESTS)
         << "\"http-request-response\",\"" << (void*)this << "\",\""
         << (Logger::logRequestParameters()
-                ? _fullUrl
-                : _fullUrl.substr(0, _fullUrl.find_first_of('?')))
+                ? request->fullUrl
+                : request->fullUrl.substr(0, request->fullUrl.find_first_of('?')))
         << "\",\""
         << (Logger::logRequestParameters()
-                ? StringUtils::escapeUnicode(std::string(buffer._buffer->c_str(),
-                                                         buffer._buffer->length()))
+                ? StringUtils::escapeUnicode(
+                      std::string(buffer._buffer->c_str(), buffer._buffer->length()) +
+                      (buffer._body == nullptr
+                           ? std::string()
+                           : std::string(buffer._body->c_str(), buffer._body->length())))
                 : "--body--")
         << "\"";
   }
@@ -187,33 +193,175 @@ void HttpCommTask::addResponse(GeneralResponse& baseResponse, RequestStatistics*
     LOG_TOPIC("dc718", TRACE, Logger::REQUESTS)
         << "\"http-request-statistics\",\"" << (void*)this << "\",\""
         << _connectionInfo.clientAddress << "\",\""
-        << HttpRequest::translateMethod(_requestType) << "\",\""
-        << HttpRequest::translateVersion(_protocolVersion) << "\","
+        << HttpRequest::translateMethod(request->requestType) << "\",\""
+        << HttpRequest::translateVersion(request->protocolVersion) << "\","
         << static_cast<int>(response.responseCode()) << ","
-        << _originalBodyLength << "," << responseBodyLength << ",\""
+        << request->originalBodyLength << "," << responseBodyLength << ",\""
         << (Logger::logRequestParameters()
-                ? _fullUrl
-                : _fullUrl.substr(0, _fullUrl.find_first_of('?')))
+                ? request->fullUrl
+                : request->fullUrl.substr(0, request->fullUrl.find_first_of('?')))
         << "\"," << stat->timingsCsv();
   }
-  addWriteBuffer(std::move(buffer));
+  request->response.reset(new WriteBuffer(std::move(buffer)));
+  writePipelinedResponses();
   // read pipelined requests
   triggerProcessAll();
 
   // and give some request information
   LOG_TOPIC("8f555", INFO, Logger::REQUESTS)
       << "\"http-request-end\",\"" << (void*)this << "\",\"" << _connectionInfo.clientAddress
-      << "\",\"" << HttpRequest::translateMethod(_requestType) << "\",\""
-      << HttpRequest::translateVersion(_protocolVersion) << "\","
-      << static_cast<int>(response.responseCode()) << "," << _originalBodyLength
+      << "\",\"" << HttpRequest::translateMethod(request->requestType) << "\",\""
+      << HttpRequest::translateVersion(request->protocolVersion) << "\","
+      << static_cast<int>(response.responseCode()) << "," << request->originalBodyLength
       << "," << responseBodyLength << ",\""
       << (Logger::logRequestParameters()
-              ? _fullUrl
-              : _fullUrl.substr(0, _fullUrl.find_first_of('?')))
+              ? request->fullUrl
+              : request->fullUrl.substr(0, request->fullUrl.find_first_of('?')))
       << "\"," << Logger::FIXED(totalTime, 6);
+}
+
+void HttpCommTask::prepareResponse(HttpResponse& response, PipelinedRequest const& request) {
+  // CORS response handling
+  if (!request.origin.empty()) {
+    // the request contained an Origin header. We have to send back the
+    // access-control-allow-origin header now
+    LOG_TOPIC("ae603", TRACE, arangodb::Logger::FIXME) << "handling CORS response";
 
+    // send back original value of "Origin" header
+    response.setHeaderNCIfNotSet(StaticStrings::AccessControlAllowOrigin, request.origin);
+
+    // send back "Access-Control-Allow-Credentials" header
+    response.setHeaderNCIfNotSet(StaticStrings::AccessControlAllowCredentials,
+                                 (request.denyCredentials ? "false" : "true"));
+
+    // use "IfNotSet" here because we should not override HTTP headers set
+    // by Foxx applications
+    response.setHeaderNCIfNotSet(StaticStrings::AccessControlExposeHeaders,
+                                 StaticStrings::ExposedCorsHeaders);
+  }
+
+  if (!ServerState::instance()->isDBServer()) {
+    // DB server is not user-facing, and does not need to set this header
+    // use "IfNotSet" to not overwrite an existing response header
+    response.setHeaderNCIfNotSet(StaticStrings::XContentTypeOptions, StaticStrings::NoSniff);
+  }
+
+  // set "connection" header, keep-alive is the default
+  response.setConnectionType((_closeRequested || request.closeConnection)
+                                 ? rest::ConnectionType::C_CLOSE
+                                 : rest::ConnectionType::C_KEEP_ALIVE);
+}
+
+void HttpCommTask::writeLastResponsePart(HttpResponse& response, WriteBuffer& buffer) {
+  // the handler is done, nothing waits for the written parts anymore
+  _partsHandler.reset();
+  _partsHandlerWaiting.store(false);
+  _unwrittenParts.store(0);
+
+  // the status and headers of the response were sent with the first part,
+  // its body becomes the last chunk, terminated by the zero-length chunk
   std::unique_ptr<basics::StringBuffer> body = response.stealBody();
-  returnStringBuffer(body.release());  // takes care of deleting
+  if (body->empty()) {
+    returnStringBuffer(body.release());  // takes care of deleting
+    buffer._buffer->appendText(TRI_CHAR_LENGTH_PAIR("0\r\n\r\n"));
+  } else {
+    buffer._buffer->appendHex(body->length());
+    buffer._buffer->appendText("\r\n", 2);
+    body->appendText(TRI_CHAR_LENGTH_PAIR("\r\n0\r\n\r\n"));
+    buffer._body = body.release();
+  }
+  buffer._buffer->ensureNullTerminated();
+}
+
+bool HttpCommTask::canSendResponseParts() const {
+  TRI_ASSERT(_peer->runningInThisThread());
+  // chunked transfer coding is HTTP/1.1 only. parts are written as they
+  // come, so no earlier response of the pipeline may be outstanding
+  return _pipeline.size() == 1 && _pipeline.front() == _partsRequest &&
+         _partsRequest->protocolVersion == rest::ProtocolVersion::HTTP_1_1;
+}
+
+bool HttpCommTask::sendResponsePart(RestHandler& handler, bool first,
+                                    std::unique_ptr<basics::StringBuffer> part) {
+  // an empty chunk would end the body
+  if (!first && part->empty()) {
+    return true;
+  }
+
+  StringBuffer* header = leaseStringBuffer(first ? 220 : 16);
+
+  if (first) {
+    // the handler owns its response until it is done, so the response
+    // header can be written here on the thread of the handler
+#ifdef ARANGODB_ENABLE_MAINTAINER_MODE
+    HttpResponse& response = dynamic_cast<HttpResponse&>(*handler.response());
+#else
+    HttpResponse& response = static_cast<HttpResponse&>(*handler.response());
+#endif
+    finishExecution(response);
+    prepareResponse(response, *_partsRequest);
+    response.setHeaderNC("transfer-encoding", "chunked");
+    response.writeHeader(header);
+  }
+
+  StringBuffer* body = nullptr;
+  if (part->empty()) {
+    returnStringBuffer(part.release());
+  } else {
+    header->appendHex(part->length());
+    header->appendText("\r\n", 2);
+    part->appendText("\r\n", 2);
+    body = part.release();
+  }
+  header->ensureNullTerminated();
+
+  size_t const unwritten = ++_unwrittenParts;
+
+  auto self = shared_from_this();
+  std::shared_ptr<RestHandler> h = handler.shared_from_this();
+  _peer->post([self, this, h, header, body]() {
+    if (!_closed) {
+      _partsHandler = h;
+    }
+    // takes care of the buffers, even if the connection is closed
+    addWriteBuffer(WriteBuffer(header, body, nullptr));
+  });
+
+  if (unwritten <= MaxUnwrittenParts) {
+    return true;
+  }
+
+  _partsHandlerWaiting.store(true);
+  // the parts may have been written in the meantime, and then nobody
+  // would continue the handler
+  return _unwrittenParts.load() <= MaxUnwrittenParts &&
+         _partsHandlerWaiting.exchange(false);
+}
+
+void HttpCommTask::writeBufferCompleted() {
+  TRI_ASSERT(_peer->runningInThisThread());
+
+  if (_partsHandler == nullptr) {
+    return;
+  }
+
+  if (--_unwrittenParts <= MaxUnwrittenParts && _partsHandlerWaiting.exchange(false)) {
+    auto h = _partsHandler;
+    auto* scheduler = SchedulerFeature::SCHEDULER;
+    if (scheduler == nullptr ||
+        !scheduler->queue(h->getRequestLane(), [h]() { h->continueHandlerExecution(); })) {
+      // cannot queue, continue right here rather than leave it waiting
+      h->continueHandlerExecution();
+    }
+  }
+}
+
+void HttpCommTask::streamClosed() {
+  TRI_ASSERT(_peer->runningInThisThread());
+  // a waiting handler will not be continued anymore, it cleans up when
+  // released
+  _closed = true;
+  _partsHandler.reset();
 }
 
 // reads data from the socket
@@ -224,7 +372,12 @@ bool HttpCommTask::processRead(double startTime) {
   cancelKeepAlive();
   TRI_ASSERT(_readBuffer.c_str() != nullptr);
 
-  if (_requestPending) {
+  if (_requestComplete) {
+    // the request read last may wait for the earlier ones
+    return dispatchRequest();
+  }
+
+  if (_lastRequestRead) {
     return false;
   }
 
@@ -243,7 +396,7 @@ bool HttpCommTask::processRead(double startTime) {
     // starting a new request
     if (_newRequest) {
       // acquire a new statistics entry for the request
-      stat = acquireStatistics(1UL);
+      stat = acquireStatistics(ReadingRequestId);
       RequestStatistics::SET_READ_START(stat, startTime);
 
       _newRequest = false;
@@ -251,7 +404,9 @@ bool HttpCommTask::processRead(double startTime) {
       _protocolVersion = rest::ProtocolVersion::UNKNOWN;
       _requestType = rest::RequestType::ILLEGAL;
       _fullUrl = "";
+      _origin.clear();
       _denyCredentials = true;
+      _originalBodyLength = 0;
 
       _sinceCompactification++;
     }
@@ -276,8 +431,8 @@ bool HttpCommTask::processRead(double startTime) {
     if (headerLength > MaximalHeaderSize) {
       // header is too large
       addSimpleResponse(rest::ResponseCode::REQUEST_HEADER_FIELDS_TOO_LARGE,
-                        rest::ContentType::UNSET, 1, VPackBuffer<uint8_t>());
-      _closeRequested = true;
+                        rest::ContentType::UNSET, pushRequest(true),
+                        VPackBuffer<uint8_t>());
       return false;
     }
 
@@ -311,6 +466,44 @@ bool HttpCommTask::processRead(double startTime) {
       return false;
     }
 
+    if (_readBuffer.length() >= H2CommTask::PrefaceHeaderLength &&
+        std::memcmp(_readBuffer.c_str(), H2CommTask::Preface,
+                    H2CommTask::PrefaceHeaderLength) == 0) {
+      if (_readBuffer.length() < H2CommTask::PrefaceLength) {
+        // wait for the rest of the connection preface
+        return false;
+      }
+      if (std::memcmp(_readBuffer.c_str(), H2CommTask::Preface,
+                      H2CommTask::PrefaceLength) != 0) {
+        _closeRequested = true;
+        return false;
+      }
+
+      LOG_TOPIC("3b9e2", TRACE, Logger::COMMUNICATION) << "switching from HTTP/1.1 to HTTP/2";
+
+      // mark task as abandoned, no more reads will happen on _peer
+      if (!abandon()) {
+        THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                       "task is already abandoned");
+      }
+
+      _server.unregisterTask(this->id());
+
+      std::shared_ptr<GeneralCommTask> commTask =
+          std::make_shared<H2CommTask>(_server, _context, std::move(_peer),
+                                       std::move(_connectionInfo),
+                                       GeneralServerFeature::keepAliveTimeout(),
+                                       /*skipSocketInit*/ true);
+
+      _server.registerTask(commTask);
+
+      commTask->addToReadBuffer(_readBuffer.c_str() + H2CommTask::PrefaceLength,
+                                _readBuffer.length() - H2CommTask::PrefaceLength);
+      commTask->processAll();
+      commTask->start();
+      return false;
+    }
+
     // header is complete
     if (ptr < end) {
       _readPosition = ptr - _readBuffer.c_str() + 4;
@@ -340,8 +533,8 @@ bool HttpCommTask::processRead(double startTime) {
       if (_protocolVersion != rest::ProtocolVersion::HTTP_1_0 &&
           _protocolVersion != rest::ProtocolVersion::HTTP_1_1) {
         addSimpleResponse(rest::ResponseCode::HTTP_VERSION_NOT_SUPPORTED,
-                          rest::ContentType::UNSET, 1, VPackBuffer<uint8_t>());
-        _closeRequested = true;
+                          rest::ContentType::UNSET, pushRequest(true),
+                          VPackBuffer<uint8_t>());
         return false;
       }
 
@@ -350,8 +543,8 @@ bool HttpCommTask::processRead(double startTime) {
 
       if (_fullUrl.size() > 16384) {
         addSimpleResponse(rest::ResponseCode::REQUEST_URI_TOO_LONG,
-                          rest::ContentType::UNSET, 1, VPackBuffer<uint8_t>());
-        _closeRequested = true;
+                          rest::ContentType::UNSET, pushRequest(true),
+                          VPackBuffer<uint8_t>());
         return false;
       }
 
@@ -403,7 +596,7 @@ bool HttpCommTask::processRead(double startTime) {
       // (original request object gets deleted before responding)
       _requestType = _incompleteRequest->requestType();
 
-      stat = statistics(1UL);
+      stat = statistics(ReadingRequestId);
       RequestStatistics::SET_REQUEST_TYPE(stat, _requestType);
 
       // handle different HTTP methods
@@ -425,7 +618,6 @@ bool HttpCommTask::processRead(double startTime) {
                _requestType == rest::RequestType::DELETE_REQ);
 
           if (!checkContentLength(_incompleteRequest.get(), expectContentLength)) {
-            _closeRequested = true;
             return false;
           }
 
@@ -439,9 +631,8 @@ bool HttpCommTask::processRead(double startTime) {
         default: {
           // bad request, method not allowed
           addSimpleResponse(rest::ResponseCode::METHOD_NOT_ALLOWED,
-                            rest::ContentType::UNSET, 1, VPackBuffer<uint8_t>());
-
-          _closeRequested = true;
+                            rest::ContentType::UNSET, pushRequest(true),
+                            VPackBuffer<uint8_t>());
           return false;
         }
       }
@@ -460,7 +651,13 @@ bool HttpCommTask::processRead(double startTime) {
           buffer._buffer->appendText(
               TRI_CHAR_LENGTH_PAIR("HTTP/1.1 100 (Continue)\r\n\r\n"));
           buffer._buffer->ensureNullTerminated();
-          addWriteBuffer(std::move(buffer));
+
+          // the interim response must not overtake the responses to the
+          // earlier requests of the pipeline
+          auto interim = std::make_shared<PipelinedRequest>();
+          interim->response.reset(new WriteBuffer(std::move(buffer)));
+          _pipeline.push(std::move(interim));
+          writePipelinedResponses();
           triggerProcessAll();  // read pipelined requests
         }
       }
@@ -488,7 +685,7 @@ bool HttpCommTask::processRead(double startTime) {
         if (!StringUtils::gzipUncompress(_readBuffer.c_str() + _bodyPosition,
                                          _bodyLength, uncompressed)) {
           addErrorResponse(rest::ResponseCode::BAD,
-                           _incompleteRequest->contentTypeResponse(), 1,
+                           _incompleteRequest->contentTypeResponse(), pushRequest(true),
                            TRI_ERROR_BAD_PARAMETER, "gzip decoding error");
           return false;
         }
@@ -499,7 +696,7 @@ bool HttpCommTask::processRead(double startTime) {
         if (!StringUtils::gzipDeflate(_readBuffer.c_str() + _bodyPosition,
                                       _bodyLength, uncompressed)) {
           addErrorResponse(rest::ResponseCode::BAD,
-                           _incompleteRequest->contentTypeResponse(), 1,
+                           _incompleteRequest->contentTypeResponse(), pushRequest(true),
                            TRI_ERROR_BAD_PARAMETER, "gzip deflate error");
           return false;
         }
@@ -527,17 +724,35 @@ bool HttpCommTask::processRead(double startTime) {
 
   auto bytes = _bodyPosition - _startPosition + _bodyLength;
 
-  stat = statistics(1UL);
+  stat = statistics(ReadingRequestId);
   RequestStatistics::SET_READ_END(stat);
   RequestStatistics::ADD_RECEIVED_BYTES(stat, bytes);
 
-  bool const isOptionsRequest = (_requestType == rest::RequestType::OPTIONS);
   resetState();
 
+  return dispatchRequest();
+}
+
+bool HttpCommTask::canDispatchRequest() const {
+  return _pipeline.canExecute(_requestType);
+}
+
+bool HttpCommTask::dispatchRequest() {
+  TRI_ASSERT(_requestComplete && _incompleteRequest != nullptr);
+
+  if (!canDispatchRequest()) {
+    // wait for the responses to the earlier requests
+    return false;
+  }
+
+  _requestComplete = false;
+
   // .............................................................................
   // keep-alive handling
   // .............................................................................
 
+  bool closeConnection = false;
+
   // header value can have any case. we'll lower-case it now
   std::string connectionType =
       StringUtils::tolower(_incompleteRequest->header(StaticStrings::Connection));
@@ -547,29 +762,36 @@ bool HttpCommTask::processRead(double startTime) {
     // the connection
     LOG_TOPIC("d2619", DEBUG, arangodb::Logger::FIXME)
         << "connection close requested by client";
-    _closeRequested = true;
+    closeConnection = true;
   } else if (_incompleteRequest->isHttp10() && connectionType != "keep-alive") {
     // HTTP 1.0 request, and no "Connection: Keep-Alive" header sent
     // we should close the connection
     LOG_TOPIC("a3ac6", DEBUG, arangodb::Logger::FIXME)
         << "no keep-alive, connection close requested by client";
-    _closeRequested = true;
+    closeConnection = true;
   } else if (!_useKeepAliveTimer) {
     // if keepAliveTimeout was set to 0.0, we'll close even keep-alive
     // connections immediately
     LOG_TOPIC("cd288", DEBUG, arangodb::Logger::FIXME) << "keep-alive disabled by admin";
-    _closeRequested = true;
+    closeConnection = true;
   }
 
   // we keep the connection open in all other cases (HTTP 1.1 or Keep-Alive
   // header sent)
 
+  uint64_t const messageId = pushRequest(closeConnection);
+  _incompleteRequest->_messageId = messageId;
+
+  if (_pipeline.size() == 1) {
+    _partsRequest = _pipeline.back();
+  }
+
   // .............................................................................
   // CORS
   // .............................................................................
 
   // OPTIONS requests currently go unauthenticated
-  if (isOptionsRequest) {
+  if (_requestType == rest::RequestType::OPTIONS) {
     // handle HTTP OPTIONS requests directly
     processCorsOptions(std::move(_incompleteRequest));
     _incompleteRequest.reset(nullptr);
@@ -595,26 +817,69 @@ bool HttpCommTask::processRead(double startTime) {
   } else {
     std::string realm = "Bearer token_type=\"JWT\", realm=\"ArangoDB\"";
     HttpResponse resp(rest::ResponseCode::UNAUTHORIZED, leaseStringBuffer(0));
+    resp._messageId = messageId;
     resp.setHeaderNC(StaticStrings::WwwAuthenticate, std::move(realm));
-    addResponse(resp, nullptr);
+    addResponse(resp, stealStatistics(messageId));
   }
 
   _incompleteRequest.reset(nullptr);
   return true;
 }
 
+uint64_t HttpCommTask::pushRequest(bool closeConnection) {
+  auto request = std::make_shared<PipelinedRequest>();
+  request->messageId = ++_lastMessageId;
+  request->requestType = _requestType;
+  request->protocolVersion = _protocolVersion;
+  // the request read is done with these
+  request->fullUrl = std::move(_fullUrl);
+  request->origin = std::move(_origin);
+  request->denyCredentials = _denyCredentials;
+  request->safe = HttpPipeline<PipelinedRequest>::isSafe(_requestType);
+  request->closeConnection = closeConnection;
+  request->originalBodyLength = _originalBodyLength;
+
+  // the statistics of the request being read move to its message id
+  setStatistics(request->messageId, stealStatistics(ReadingRequestId));
+
+  if (closeConnection) {
+    // requests after this one are not answered anyway
+    _lastRequestRead = true;
+  }
+
+  _pipeline.push(request);
+  return request->messageId;
+}
+
+void HttpCommTask::writePipelinedResponses() {
+  TRI_ASSERT(_peer->runningInThisThread());
+
+  _pipeline.popReady([this](PipelinedRequest& request) {
+    if (request.closeConnection) {
+      // the connection is closed once this response is written
+      _closeRequested = true;
+    }
+    addWriteBuffer(std::move(*request.response));
+  });
+
+  if (_pipeline.empty()) {
+    resetKeepAlive();
+  }
+}
+
 void HttpCommTask::processRequest(std::unique_ptr<HttpRequest> request) {
   TRI_ASSERT(_peer->runningInThisThread());
 
   {
+    std::string const& fullUrl = _pipeline.back()->fullUrl;
     LOG_TOPIC("6e770", DEBUG, Logger::REQUESTS)
         << "\"http-request-begin\",\"" << (void*)this << "\",\""
         << _connectionInfo.clientAddress << "\",\""
         << HttpRequest::translateMethod(_requestType) << "\",\""
         << HttpRequest::translateVersion(_protocolVersion) << "\",\""
         << (Logger::logRequestParameters()
-                ? _fullUrl
-                : _fullUrl.substr(0, _fullUrl.find_first_of('?')))
+                ? fullUrl
+                : fullUrl.substr(0, fullUrl.find_first_of('?')))
         << "\"";
 
     std::string const& body = request->body();
@@ -630,6 +895,7 @@ void HttpCommTask::processRequest(std::unique_ptr<HttpRequest> request) {
   // create a handler and execute
   auto resp = std::make_unique<HttpResponse>(rest::ResponseCode::SERVER_ERROR,
                                              leaseStringBuffer(1024));
+  resp->_messageId = request->_messageId;
   resp->setContentType(request->contentTypeResponse());
   resp->setContentTypeRequested(request->contentTypeResponse());
 
@@ -645,8 +911,8 @@ bool HttpCommTask::checkContentLength(HttpRequest* request, bool expectContentLe
 
   if (bodyLength < 0) {
     // bad request, body length is < 0. this is a client error
-    addSimpleResponse(rest::ResponseCode::LENGTH_REQUIRED,
-                      rest::ContentType::UNSET, 1, VPackBuffer<uint8_t>());
+    addSimpleResponse(rest::ResponseCode::LENGTH_REQUIRED, rest::ContentType::UNSET,
+                      pushRequest(true), VPackBuffer<uint8_t>());
     return false;
   }
 
@@ -661,7 +927,8 @@ bool HttpCommTask::checkContentLength(HttpRequest* request, bool expectContentLe
   if ((size_t)bodyLength > MaximalBodySize) {
     // request entity too large
     addSimpleResponse(rest::ResponseCode::REQUEST_ENTITY_TOO_LARGE,
-                      rest::ContentType::UNSET, 1, VPackBuffer<uint8_t>());
+                      rest::ContentType::UNSET, pushRequest(true),
+                      VPackBuffer<uint8_t>());
     return false;
   }
 
@@ -680,10 +947,11 @@ bool HttpCommTask::checkContentLength(HttpRequest* request, bool expectContentLe
 
 void HttpCommTask::processCorsOptions(std::unique_ptr<HttpRequest> request) {
   HttpResponse resp(rest::ResponseCode::OK, leaseStringBuffer(0));
+  resp._messageId = request->_messageId;
 
   resp.setHeaderNCIfNotSet(StaticStrings::Allow, StaticStrings::CorsMethods);
 
-  if (!_origin.empty()) {
+  if (!_pipeline.back()->origin.empty()) {
     LOG_TOPIC("e1cfa", TRACE, arangodb::Logger::FIXME) << "got CORS preflight request";
     std::string const allowHeaders =
         StringUtils::trim(request->header(StaticStrings::AccessControlRequestHeaders));
@@ -709,12 +977,14 @@ void HttpCommTask::processCorsOptions(std::unique_ptr<HttpRequest> request) {
     resp.setHeaderNCIfNotSet(StaticStrings::AccessControlMaxAge, StaticStrings::N1800);
   }
 
-  addResponse(resp, nullptr);
+  addResponse(resp, stealStatistics(request->_messageId));
 }
 
 std::unique_ptr<GeneralResponse> HttpCommTask::createResponse(rest::ResponseCode responseCode,
-                                                              uint64_t /* messageId */) {
-  return std::make_unique<HttpResponse>(responseCode, leaseStringBuffer(0));
+                                                              uint64_t messageId) {
+  auto response = std::make_unique<HttpResponse>(responseCode, leaseStringBuffer(0));
+  response->_messageId = messageId;
+  return response;
 }
 
 void HttpCommTask::compactify() {
@@ -755,7 +1025,7 @@ void HttpCommTask::compactify() {
 }
 
 void HttpCommTask::resetState() {
-  _requestPending = true;
+  _requestComplete = true;
 
   _readPosition = _bodyPosition + _bodyLength;
 
@@ -766,67 +1036,3 @@ void HttpCommTask::resetState() {
   _newRequest = true;
   _readRequestBody = false;
 }
-
-ResponseCode HttpCommTask::handleAuthHeader(HttpRequest* req) {
-  bool found;
-  std::string const& authStr = req->header(StaticStrings::Authorization, found);
-  if (!found) {
-    if (_auth->isActive()) {
-      events::CredentialsMissing(*req);
-      return rest::ResponseCode::UNAUTHORIZED;
-    }
-    return rest::ResponseCode::OK;
-  }
-
-  size_t methodPos = authStr.find_first_of(' ');
-  if (methodPos != std::string::npos) {
-    // skip over authentication method
-    char const* auth = authStr.c_str() + methodPos;
-    while (*auth == ' ') {
-      ++auth;
-    }
-
-    if (Logger::logRequestParameters()) {
-      LOG_TOPIC("c4536", DEBUG, arangodb::Logger::REQUESTS)
-          << "\"authorization-header\",\"" << (void*)this << "\",\"" << authStr << "\"";
-    }
-
-    try {
-      // note that these methods may throw in case of an error
-      AuthenticationMethod authMethod = AuthenticationMethod::NONE;
-      if (TRI_CaseEqualString(authStr.c_str(), "basic ", 6)) {
-        authMethod = AuthenticationMethod::BASIC;
-      } else if (TRI_CaseEqualString(authStr.c_str(), "bearer ", 7)) {
-        authMethod = AuthenticationMethod::JWT;
-      }
-
-      req->setAuthenticationMethod(authMethod);
-      if (authMethod != AuthenticationMethod::NONE) {
-        _authToken = _auth->tokenCache().checkAuthentication(authMethod, auth);
-        req->setAuthenticated(_authToken.authenticated());
-        req->setUser(_authToken._username); // do copy here, so that we do not invalidate the member
-      }
-
-      if (req->authenticated() || !_auth->isActive()) {
-        events::Authenticated(*req, authMethod);
-        return rest::ResponseCode::OK;
-      } else if (_auth->isActive()) {
-        events::CredentialsBad(*req, authMethod);
-        return rest::ResponseCode::UNAUTHORIZED;
-      }
-
-      // intentionally falls through
-    } catch (arangodb::basics::Exception const& ex) {
-      // translate error
-      if (ex.code() == TRI_ERROR_USER_NOT_FOUND) {
-        return rest::ResponseCode::UNAUTHORIZED;
-      }
-      return GeneralResponse::responseCode(ex.what());
-    } catch (...) {
-      return rest::ResponseCode::SERVER_ERROR;
-    }
-  }
-
-  events::UnknownAuthenticationMethod(*req);
-  return rest::ResponseCode::UNAUTHORIZED;
-}
@@ -3,9 +3,11 @@
 
 #include "Basics/Common.h"
 #include "GeneralServer/GeneralCommTask.h"
+#include "GeneralServer/HttpPipeline.h"
 
 namespace arangodb {
 class HttpRequest;
+class HttpResponse;
 
 namespace rest {
 class HttpCommTask final : public GeneralCommTask {
@@ -14,6 +16,9 @@ class HttpCommTask final : public GeneralCommTask {
   static size_t const MaximalBodySize;
   static size_t const MaximalPipelineSize;
   static size_t const RunCompactEvery;
+  // parts of a response that may be queued for writing before the handler
+  // that sends them has to wait
+  static size_t const MaxUnwrittenParts;
 
  public:
   HttpCommTask(GeneralServer& server, GeneralServer::IoContext& context,
@@ -41,7 +46,45 @@ class HttpCommTask final : public GeneralCommTask {
   void addSimpleResponse(rest::ResponseCode, rest::ContentType, uint64_t messageId,
                          velocypack::Buffer<uint8_t>&&) override;
 
+  bool canSendResponseParts() const override;
+  bool sendResponsePart(RestHandler&, bool first,
+                        std::unique_ptr<basics::StringBuffer>) override;
+
+  void writeBufferCompleted() override;
+  void streamClosed() override;
+
  private:
+  // a request of the pipeline. Requests with safe methods are executed
+  // concurrently, their responses are written in the order of the requests
+  struct PipelinedRequest {
+    uint64_t messageId = 0;
+    rest::RequestType requestType = rest::RequestType::ILLEGAL;
+    rest::ProtocolVersion protocolVersion = rest::ProtocolVersion::UNKNOWN;
+    std::string fullUrl;
+    std::string origin;
+    bool denyCredentials = true;
+    bool safe = true;
+    // close the connection once the response is written
+    bool closeConnection = false;
+    size_t originalBodyLength = 0;
+    // set when the response is ready to be written
+    std::unique_ptr<WriteBuffer> response;
+  };
+
+  // whether the complete request read can be executed now
+  bool canDispatchRequest() const;
+  // executes the complete request read
+  bool dispatchRequest();
+  // adds the request read to the pipeline, returns its message id
+  uint64_t pushRequest(bool closeConnection);
+  // writes the ready responses at the front of the pipeline
+  void writePipelinedResponses();
+
+  // sets the response headers that depend on the request and the connection
+  void prepareResponse(HttpResponse&, PipelinedRequest const&);
+  // ends the chunked body of a response sent in parts
+  void writeLastResponsePart(HttpResponse&, WriteBuffer&);
+
   void processRequest(std::unique_ptr<HttpRequest>);
   void processCorsOptions(std::unique_ptr<HttpRequest>);
 
@@ -52,7 +95,6 @@ class HttpCommTask final : public GeneralCommTask {
 
   std::string authenticationRealm() const;
   ResponseCode authenticateRequest(HttpRequest*);
-  ResponseCode handleAuthHeader(HttpRequest* request);
 
  private:
   size_t _readPosition;       // current read position
@@ -74,10 +116,25 @@ class HttpCommTask final : public GeneralCommTask {
 
   std::string const _authenticationRealm;
 
-  // true if request is complete but not handled
-  bool _requestPending = false;
+  // true if request is complete but not yet executed
+  bool _requestComplete = false;
+  // true if no further requests are read from the connection
+  bool _lastRequestRead = false;
 
   std::unique_ptr<HttpRequest> _incompleteRequest;
+
+  uint64_t _lastMessageId;
+  HttpPipeline<PipelinedRequest> _pipeline;
+  // the request whose handler may send its response in parts. it is the
+  // only request of the pipeline while the handler runs
+  std::shared_ptr<PipelinedRequest> _partsRequest;
+
+  // handler sending its response in parts, only used on the IO thread.
+  // Holding it keeps a waiting handler alive until it is continued
+  std::shared_ptr<RestHandler> _partsHandler;
+  std::atomic<size_t> _unwrittenParts;
+  std::atomic<bool> _partsHandlerWaiting;
+  bool _closed = false;
 };
 }  // namespace rest
 }  // namespace arangodb
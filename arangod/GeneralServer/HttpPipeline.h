@@ -0,0 +1,94 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_GENERAL_SERVER_HTTP_PIPELINE_H
+#define ARANGOD_GENERAL_SERVER_HTTP_PIPELINE_H 1
+
+#include "Basics/Common.h"
+#include "Rest/CommonDefines.h"
+
+#include <deque>
+
+namespace arangodb {
+namespace rest {
+
+// the requests of an HTTP/1.1 connection that are executed or whose
+// responses wait to be written. Requests with safe methods are executed
+// concurrently (RFC 7230, 6.3.2), a request with any other method is
+// executed on its own. Responses are written in the order of the requests.
+// A Request has a messageId, a flag whether it is safe and a pointer-like
+// response that is set once the response is ready
+template <typename Request>
+class HttpPipeline {
+ public:
+  explicit HttpPipeline(size_t maxRequests) : _maxRequests(maxRequests) {}
+
+  static bool isSafe(rest::RequestType type) {
+    return type == rest::RequestType::GET || type == rest::RequestType::HEAD ||
+           type == rest::RequestType::OPTIONS;
+  }
+
+  bool empty() const { return _requests.empty(); }
+  size_t size() const { return _requests.size(); }
+  std::shared_ptr<Request> const& front() const { return _requests.front(); }
+  std::shared_ptr<Request> const& back() const { return _requests.back(); }
+
+  // whether a request with the given method can be executed now
+  bool canExecute(rest::RequestType type) const {
+    if (_requests.empty()) {
+      return true;
+    }
+    return isSafe(type) && _requests.back()->safe && _requests.size() < _maxRequests;
+  }
+
+  void push(std::shared_ptr<Request> request) {
+    _requests.push_back(std::move(request));
+  }
+
+  // the request with the given message id, nullptr if there is none
+  std::shared_ptr<Request> find(uint64_t messageId) const {
+    for (auto const& it : _requests) {
+      if (it->messageId == messageId) {
+        return it;
+      }
+    }
+    return nullptr;
+  }
+
+  // removes the requests at the front whose responses are ready, and calls
+  // the callback for each of them in request order
+  template <typename F>
+  void popReady(F&& callback) {
+    while (!_requests.empty() && _requests.front()->response != nullptr) {
+      std::shared_ptr<Request> request = std::move(_requests.front());
+      _requests.pop_front();
+      callback(*request);
+    }
+  }
+
+ private:
+  size_t const _maxRequests;
+  std::deque<std::shared_ptr<Request>> _requests;
+};
+
+}  // namespace rest
+}  // namespace arangodb
+
+#endif
@@ -34,7 +34,9 @@
 #include "GeneralServer/GeneralCommTask.h"
 #include "Logger/Logger.h"
 #include "Rest/GeneralRequest.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "Statistics/RequestStatistics.h"
+#include "StorageEngine/StoragePerfCounters.h"
 #include "Utils/ExecContext.h"
 #include "VocBase/ticks.h"
 
@@ -54,7 +56,8 @@ RestHandler::RestHandler(GeneralRequest* request, GeneralResponse* response)
       _response(response),
       _statistics(nullptr),
       _state(HandlerState::PREPARE),
-      _handlerId(0) {}
+      _handlerId(0),
+      _responsePartsSent(false) {}
 
 RestHandler::~RestHandler() {
   RequestStatistics* stat = _statistics.exchange(nullptr);
@@ -255,10 +258,16 @@ bool RestHandler::forwardRequest() {
   return true;
 }
 
-void RestHandler::runHandlerStateMachine() {
+void RestHandler::runHandlerStateMachine(bool onlyIfPaused) {
   TRI_ASSERT(_callback);
   MUTEX_LOCKER(locker, _executionMutex);
 
+  if (onlyIfPaused && _state != HandlerState::PAUSED) {
+    // a wakeup for a handler that has already been continued, or that
+    // has finished in the meantime
+    return;
+  }
+
   while (true) {
     switch (_state) {
       case HandlerState::PREPARE:
@@ -295,6 +304,9 @@ void RestHandler::runHandlerStateMachine() {
 
       case HandlerState::FINALIZE:
         RequestStatistics::SET_REQUEST_END(_statistics);
+        if (_storagePerf != nullptr) {
+          StoragePerfStatistics::add("rest", name(), *_storagePerf);
+        }
         // Callback may stealStatistics!
         _callback(this);
         // Schedule callback BEFORE! finalize
@@ -303,6 +315,9 @@ void RestHandler::runHandlerStateMachine() {
 
       case HandlerState::FAILED:
         RequestStatistics::SET_REQUEST_END(_statistics);
+        if (_storagePerf != nullptr) {
+          StoragePerfStatistics::add("rest", name(), *_storagePerf);
+        }
         // Callback may stealStatistics!
         _callback(this);
         // No need to finalize here!
@@ -322,6 +337,10 @@ void RestHandler::prepareEngine() {
   // set end immediately so we do not get netative statistics
   RequestStatistics::SET_REQUEST_START_END(_statistics);
 
+  if (StoragePerfStatistics::sample()) {
+    _storagePerf = std::make_unique<StoragePerfCounters>();
+  }
+
   if (_canceled) {
     _state = HandlerState::FAILED;
     RequestStatistics::SET_EXECUTE_ERROR(_statistics);
@@ -352,15 +371,20 @@ void RestHandler::prepareEngine() {
   _state = HandlerState::FAILED;
 }
 
-/// Execute the rest handler state machine
-void RestHandler::continueHandlerExecution() {
-#ifdef ARANGODB_ENABLE_MAINTAINER_MODE
-  {
-    MUTEX_LOCKER(locker, _executionMutex);
-    TRI_ASSERT(_state == HandlerState::PAUSED);
+/// Execute the rest handler state machine. With several asynchronous
+/// requests in flight a handler can be woken up more often than it paused,
+/// so wakeups are ignored unless the handler is actually paused
+void RestHandler::continueHandlerExecution() { runHandlerStateMachine(true); }
+
+void RestHandler::wakeupHandler() {
+  auto self = shared_from_this();
+  arangodb::Scheduler* scheduler = SchedulerFeature::SCHEDULER;
+  if (scheduler == nullptr ||
+      !scheduler->queue(getRequestLane(), [self]() { self->continueHandlerExecution(); })) {
+    // continue on the thread that resolved the future rather than losing
+    // the request
+    continueHandlerExecution();
   }
-#endif
-  runHandlerStateMachine();
 }
 
 void RestHandler::shutdownEngine() {
@@ -378,6 +402,10 @@ void RestHandler::executeEngine(bool isContinue) {
   ExecContext* exec = static_cast<ExecContext*>(_request->requestContext());
   ExecContextScope scope(exec);
 
+  // the counters are per thread, so a paused request is measured in slices
+  StoragePerfScope perfScope(_storagePerf != nullptr);
+  TRI_DEFER(if (perfScope.active()) { *_storagePerf += perfScope.elapsed(); });
+
   RestHandler::CURRENT_HANDLER = this;
 
   try {
@@ -386,7 +414,13 @@ void RestHandler::executeEngine(bool isContinue) {
       // only need to run prepareExecute() again when we are continuing
       // otherwise prepareExecute() was already run in the PREPARE phase
       prepareExecute(true);
-      result = continueExecute();
+      if (_continuation) {
+        auto continuation = std::move(_continuation);
+        _continuation = nullptr;
+        result = continuation();
+      } else {
+        result = continueExecute();
+      }
     } else {
       result = execute();
     }
@@ -509,6 +543,13 @@ void RestHandler::generateError(arangodb::Result const& r) {
 // --SECTION--                                                 protected methods
 // -----------------------------------------------------------------------------
 
+bool RestHandler::sendResponsePart(std::unique_ptr<basics::StringBuffer> part) {
+  TRI_ASSERT(canSendResponseParts());
+  bool const first = !_responsePartsSent;
+  _responsePartsSent = true;
+  return _responsePartSink(*this, first, std::move(part));
+}
+
 void RestHandler::resetResponse(rest::ResponseCode code) {
   TRI_ASSERT(_response != nullptr);
   _response->reset(code);
@@ -25,6 +25,8 @@
 #define ARANGOD_HTTP_SERVER_REST_HANDLER_H 1
 
 #include "Basics/Common.h"
+#include "Futures/Future.h"
+#include "Futures/function2/function2.hpp"
 
 #include "GeneralServer/RequestLane.h"
 #include "Rest/GeneralResponse.h"
@@ -33,11 +35,13 @@
 namespace arangodb {
 namespace basics {
 class Exception;
+class StringBuffer;
 }
 
 class GeneralRequest;
 class RequestStatistics;
 class Result;
+struct StoragePerfCounters;
 
 enum class RestStatus { DONE, WAITING, FAIL };
 
@@ -85,6 +89,10 @@ class RestHandler : public std::enable_shared_from_this<RestHandler> {
   /// @brief forwards the request to the appropriate server
   bool forwardRequest();
 
+  /// @brief whether the response body can be sent in parts while the
+  /// handler is still running, see sendResponsePart
+  bool canSendResponseParts() const { return _responsePartSink != nullptr; }
+
  public:
   // rest handler name for debugging and logging
   virtual char const* name() const = 0;
@@ -129,6 +137,16 @@ class RestHandler : public std::enable_shared_from_this<RestHandler> {
 
   void resetResponse(rest::ResponseCode);
 
+  /// @brief sends a part of the response body right away. The response code
+  /// and headers go out with the first part and cannot be changed after
+  /// that, the body set when the handler is done becomes the last part.
+  /// Returns false if the client does not keep up. The handler must then
+  /// return RestStatus::WAITING, it is continued once the parts have been
+  /// written
+  bool sendResponsePart(std::unique_ptr<basics::StringBuffer>);
+
+  bool responsePartsSent() const { return _responsePartsSent; }
+
   void generateError(rest::ResponseCode, int, std::string const&);
 
   // generates an error
@@ -137,8 +155,38 @@ class RestHandler : public std::enable_shared_from_this<RestHandler> {
   // generates an error
   void generateError(arangodb::Result const&);
 
+  /// @brief pauses the handler until the future is resolved, instead of
+  /// blocking the thread while waiting for it. Once the future is resolved,
+  /// the handler is continued on a scheduler thread by calling the callback
+  /// with the Try of the future, in place of continueExecute(). The handler
+  /// must return the RestStatus returned by this method, and must not wait
+  /// for anything else at the same time
+  template <typename T, typename F>
+  RestStatus waitForFuture(futures::Future<T>&& future, F&& callback) {
+    if (future.isReady()) {
+      return std::forward<F>(callback)(std::move(future).getTry());
+    }
+
+    // the result is handed over by the scheduler queue, which orders the
+    // write before the continuation reads it
+    auto result = std::make_shared<futures::Try<T>>();
+    _continuation = [result, callback = std::forward<F>(callback)]() mutable -> RestStatus {
+      return callback(std::move(*result));
+    };
+
+    auto self = shared_from_this();
+    std::move(future).thenFinal([self, result](futures::Try<T>&& t) {
+      *result = std::move(t);
+      self->wakeupHandler();
+    });
+    return RestStatus::WAITING;
+  }
+
  private:
-  void runHandlerStateMachine();
+  void runHandlerStateMachine(bool onlyIfPaused = false);
+
+  /// @brief continues the handler on a scheduler thread
+  void wakeupHandler();
 
   void prepareEngine();
   /// @brief Executes the RestHandler
@@ -172,6 +220,18 @@ class RestHandler : public std::enable_shared_from_this<RestHandler> {
 
   std::function<void(rest::RestHandler*)> _callback;
 
+  // set by the comm task, if the connection supports sending the response
+  // in parts. the flag tells whether this is the first part
+  std::function<bool(RestHandler&, bool, std::unique_ptr<basics::StringBuffer>)> _responsePartSink;
+  bool _responsePartsSent;
+
+  // storage engine counters of a sampled request, nullptr if the request
+  // is not sampled
+  std::unique_ptr<StoragePerfCounters> _storagePerf;
+
+  // set by waitForFuture, runs instead of continueExecute()
+  fu2::unique_function<RestStatus()> _continuation;
+
   mutable Mutex _executionMutex;
 };
 
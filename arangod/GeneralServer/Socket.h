@@ -30,9 +30,16 @@
 #include "GeneralServer/GeneralServer.h"
 #include "Logger/Logger.h"
 
+#include <array>
+
 namespace arangodb {
 
 typedef std::function<void(const asio_ns::error_code& ec, std::size_t transferred)> AsyncHandler;
+typedef std::function<void(const asio_ns::error_code& ec)> HandshakeHandler;
+
+// the parts of a write buffer, e.g. the response header and the body, which
+// are written in one go without copying them together
+typedef std::array<asio_ns::const_buffer, 2> ConstBuffers;
 
 class Socket {
  public:
@@ -48,14 +55,21 @@ class Socket {
 
   bool isEncrypted() const { return _encrypted; }
 
-  bool handshake() {
-    if (!_encrypted || _handshakeDone) {
-      return true;
-    } else if (sslHandshake()) {
-      _handshakeDone = true;
-      return true;
+  bool handshakeDone() const { return !_encrypted || _handshakeDone; }
+
+  // performs the TLS handshake of an encrypted socket without blocking the
+  // thread, the handler is called when it is done
+  void asyncHandshake(HandshakeHandler const& handler) {
+    if (handshakeDone()) {
+      handler(asio_ns::error_code());
+      return;
     }
-    return false;
+    asyncSslHandshake([this, handler](asio_ns::error_code const& ec) {
+      if (!ec) {
+        _handshakeDone = true;
+      }
+      handler(ec);
+    });
   }
 
   void shutdown(asio_ns::error_code& ec, bool mustCloseSend, bool mustCloseReceive) {
@@ -86,9 +100,8 @@ class Socket {
   virtual std::string peerAddress() const = 0;
   virtual int peerPort() const = 0;
   virtual void setNonBlocking(bool) = 0;
-  virtual size_t writeSome(basics::StringBuffer* buffer, asio_ns::error_code& ec) = 0;
-  virtual void asyncWrite(asio_ns::mutable_buffers_1 const& buffer,
-                          AsyncHandler const& handler) = 0;
+  virtual size_t writeSome(ConstBuffers const& buffers, asio_ns::error_code& ec) = 0;
+  virtual void asyncWrite(ConstBuffers const& buffers, AsyncHandler const& handler) = 0;
   virtual size_t readSome(asio_ns::mutable_buffers_1 const& buffer,
                           asio_ns::error_code& ec) = 0;
   virtual std::size_t available(asio_ns::error_code& ec) = 0;
@@ -97,7 +110,7 @@ class Socket {
   virtual void close(asio_ns::error_code& ec) = 0;
 
  protected:
-  virtual bool sslHandshake() = 0;
+  virtual void asyncSslHandshake(HandshakeHandler const&) = 0;
   virtual void shutdownReceive(asio_ns::error_code& ec) = 0;
   virtual void shutdownSend(asio_ns::error_code& ec) = 0;
 
@@ -33,10 +33,11 @@ class SocketSslTcp final : public Socket {
   friend class AcceptorTcp;
 
  public:
-  SocketSslTcp(rest::GeneralServer::IoContext& context, asio_ns::ssl::context&& sslContext)
+  SocketSslTcp(rest::GeneralServer::IoContext& context,
+               std::shared_ptr<asio_ns::ssl::context> sslContext)
       : Socket(context, /*encrypted*/ true),
         _sslContext(std::move(sslContext)),
-        _sslSocket(context.newSslSocket(_sslContext)),
+        _sslSocket(context.newSslSocket(*_sslContext)),
         _socket(_sslSocket->next_layer()),
         _peerEndpoint() {}
 
@@ -53,12 +54,12 @@ class SocketSslTcp final : public Socket {
 
   void setNonBlocking(bool v) override { _socket.non_blocking(v); }
 
-  size_t writeSome(basics::StringBuffer* buffer, asio_ns::error_code& ec) override {
-    return _sslSocket->write_some(asio_ns::buffer(buffer->begin(), buffer->length()), ec);
+  size_t writeSome(ConstBuffers const& buffers, asio_ns::error_code& ec) override {
+    return _sslSocket->write_some(buffers, ec);
   }
 
-  void asyncWrite(asio_ns::mutable_buffers_1 const& buffer, AsyncHandler const& handler) override {
-    return asio_ns::async_write(*_sslSocket, buffer, handler);
+  void asyncWrite(ConstBuffers const& buffers, AsyncHandler const& handler) override {
+    return asio_ns::async_write(*_sslSocket, buffers, handler);
   }
 
   size_t readSome(asio_ns::mutable_buffers_1 const& buffer, asio_ns::error_code& ec) override {
@@ -84,7 +85,9 @@ class SocketSslTcp final : public Socket {
   }
 
  protected:
-  bool sslHandshake() override;
+  void asyncSslHandshake(HandshakeHandler const& handler) override {
+    _sslSocket->async_handshake(asio_ns::ssl::stream_base::handshake_type::server, handler);
+  }
 
   void shutdownReceive(asio_ns::error_code& ec) override {
     _socket.shutdown(asio_ns::ip::tcp::socket::shutdown_receive, ec);
@@ -95,7 +98,8 @@ class SocketSslTcp final : public Socket {
   }
 
  private:
-  asio_ns::ssl::context _sslContext;
+  // shared by all connections, outlives the stream
+  std::shared_ptr<asio_ns::ssl::context> _sslContext;
   std::unique_ptr<asio_ns::ssl::stream<asio_ns::ip::tcp::socket>> _sslSocket;
   asio_ns::ip::tcp::socket& _socket;
   asio_ns::ip::tcp::acceptor::endpoint_type _peerEndpoint;
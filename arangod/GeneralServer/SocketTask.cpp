@@ -39,6 +39,8 @@
 using namespace arangodb::basics;
 using namespace arangodb::rest;
 
+long const SocketTask::HANDSHAKE_TIMEOUT = 3000;
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                      constructors and destructors
 // -----------------------------------------------------------------------------
@@ -71,10 +73,6 @@ SocketTask::SocketTask(GeneralServer& server,
   if (!skipInit) {
     TRI_ASSERT(_peer != nullptr);
     _peer->setNonBlocking(true);
-    if (!_peer->handshake()) {
-      _closedSend = true;
-      _closedReceive = true;
-    }
   }
 }
 
@@ -133,7 +131,49 @@ bool SocketTask::start() {
 
   auto self = shared_from_this();
 
-  _peer->post([self, this]() { asyncReadSome(); });
+  _peer->post([self, this]() {
+    bool const handshake = !_peer->handshakeDone();
+
+    if (handshake) {
+      // a client that does not complete the handshake is dropped
+      asio_ns::error_code err;
+      _keepAliveTimer->expires_from_now(boost::posix_time::milliseconds(HANDSHAKE_TIMEOUT), err);
+      _keepAliveTimerActive.store(true, std::memory_order_relaxed);
+      _keepAliveTimer->async_wait([self, this](asio_ns::error_code const& error) {
+        if (!error) {  // error will be true if timer was canceled
+          LOG_TOPIC("aae1b", DEBUG, Logger::COMMUNICATION)
+              << "forcefully shutting down connection after wait time";
+          closeStreamNoLock();
+        }
+      });
+    }
+
+    // the handshake runs asynchronously like all other I/O, so a slow
+    // client does not hold up the other connections of the I/O thread
+    _peer->asyncHandshake([self, this, handshake](asio_ns::error_code const& ec) {
+      if (handshake) {
+        cancelKeepAlive();
+      }
+
+      if (_closedReceive.load(std::memory_order_acquire)) {
+        // timed out
+        return;
+      }
+
+      if (ec) {
+        // this message will also be emitted if a connection is attempted
+        // with a wrong protocol (e.g. HTTP instead of SSL/TLS). so it's
+        // definitely not worth logging an error here
+        LOG_TOPIC("cb6ca", DEBUG, Logger::COMMUNICATION)
+            << "unable to perform ssl handshake: " << ec.message() << " : "
+            << ec.value();
+        closeStreamNoLock();
+        return;
+      }
+
+      asyncReadSome();
+    });
+  });
 
   return true;
 }
@@ -172,6 +212,7 @@ bool SocketTask::completedWriteBuffer() {
 
   RequestStatistics::SET_WRITE_END(_writeBuffer._statistics);
   _writeBuffer.release(this);  // try to recycle the string buffer
+  writeBufferCompleted();
   if (_writeBuffers.empty()) {
     if (_closeRequested) {
       closeStreamNoLock();
@@ -216,7 +257,9 @@ void SocketTask::closeStreamNoLock() {
   _closeRequested.store(false, std::memory_order_release);
   _keepAliveTimer->cancel();
   _keepAliveTimerActive.store(false, std::memory_order_relaxed);
-  
+
+  streamClosed();
+
   _server.unregisterTask(this->id());
 }
 
@@ -457,7 +500,7 @@ void SocketTask::asyncWriteSome() {
   }
 
   TRI_ASSERT(_writeBuffer._buffer != nullptr);
-  size_t total = _writeBuffer._buffer->length();
+  size_t total = _writeBuffer.length();
   size_t written = 0;
 
   TRI_ASSERT(!_abandoned);
@@ -472,9 +515,9 @@ void SocketTask::asyncWriteSome() {
       TRI_ASSERT(_writeBuffer._buffer != nullptr);
 
       // we can directly skip sending empty buffers
-      if (_writeBuffer._buffer->length() > 0) {
+      if (total > 0) {
         RequestStatistics::SET_WRITE_START(_writeBuffer._statistics);
-        written = _peer->writeSome(_writeBuffer._buffer, err);
+        written = _peer->writeSome(_writeBuffer.data(0), err);
 
         RequestStatistics::ADD_SENT_BYTES(_writeBuffer._statistics, written);
 
@@ -493,7 +536,7 @@ void SocketTask::asyncWriteSome() {
 
       // try to send next buffer
       TRI_ASSERT(_writeBuffer._buffer != nullptr);
-      total = _writeBuffer._buffer->length();
+      total = _writeBuffer.length();
     }
 
     // write could have blocked which is the only acceptable error
@@ -521,7 +564,7 @@ void SocketTask::asyncWriteSome() {
   // was written in one go, begin writing at offset (written)
   auto self = shared_from_this();
 
-  _peer->asyncWrite(asio_ns::buffer(_writeBuffer._buffer->begin() + written, total - written),
+  _peer->asyncWrite(_writeBuffer.data(written),
                     [self, this](const asio_ns::error_code& ec, std::size_t transferred) {
                       if (_abandoned.load(std::memory_order_acquire)) {
                         return;
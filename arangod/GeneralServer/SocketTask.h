@@ -43,6 +43,7 @@ class ConnectionStatistics;
 
 namespace rest {
 class SocketTask : public IoTask {
+  friend class H2CommTask;
   friend class HttpCommTask;
   friend class GeneralServer;
 
@@ -51,6 +52,8 @@ class SocketTask : public IoTask {
 
  private:
   static size_t const READ_BLOCK_SIZE = 10000;
+  // milliseconds a client may take for the TLS handshake
+  static long const HANDSHAKE_TIMEOUT;
 
  public:
   SocketTask(GeneralServer& server, GeneralServer::IoContext& context,
@@ -71,6 +74,12 @@ class SocketTask : public IoTask {
   virtual bool processRead(double startTime) = 0;
   virtual void compactify() {}
 
+  // called after each write buffer has been written completely
+  virtual void writeBufferCompleted() {}
+
+  // called once the connection is closed
+  virtual void streamClosed() {}
+
   // This function is used during the protocol switch from http
   // to VelocyStream. This way we do not require additional
   // constructor arguments. It should not be used otherwise.
@@ -79,17 +88,25 @@ class SocketTask : public IoTask {
  protected:
   struct WriteBuffer {
     basics::StringBuffer* _buffer;
+    // optional second part, e.g. a response body that is written after
+    // _buffer without being copied into it
+    basics::StringBuffer* _body;
     RequestStatistics* _statistics;
 
     WriteBuffer(basics::StringBuffer* buffer, RequestStatistics* statistics)
-        : _buffer(buffer), _statistics(statistics) {}
+        : _buffer(buffer), _body(nullptr), _statistics(statistics) {}
+
+    WriteBuffer(basics::StringBuffer* buffer, basics::StringBuffer* body,
+                RequestStatistics* statistics)
+        : _buffer(buffer), _body(body), _statistics(statistics) {}
 
     WriteBuffer(WriteBuffer const&) = delete;
     WriteBuffer& operator=(WriteBuffer const&) = delete;
 
     WriteBuffer(WriteBuffer&& other) noexcept
-        : _buffer(other._buffer), _statistics(other._statistics) {
+        : _buffer(other._buffer), _body(other._body), _statistics(other._statistics) {
       other._buffer = nullptr;
+      other._body = nullptr;
       other._statistics = nullptr;
     }
 
@@ -100,9 +117,11 @@ class SocketTask : public IoTask {
 
         // take over ownership from other
         _buffer = other._buffer;
+        _body = other._body;
         _statistics = other._statistics;
         // fix other
         other._buffer = nullptr;
+        other._body = nullptr;
         other._statistics = nullptr;
       }
       return *this;
@@ -114,9 +133,29 @@ class SocketTask : public IoTask {
 
     void clear() noexcept {
       _buffer = nullptr;
+      _body = nullptr;
       _statistics = nullptr;
     }
 
+    size_t length() const {
+      return _buffer->length() + (_body == nullptr ? 0 : _body->length());
+    }
+
+    // the unwritten parts, starting at offset
+    ConstBuffers data(size_t offset) const {
+      size_t const headerLength = _buffer->length();
+      size_t const skipBody = offset > headerLength ? offset - headerLength : 0;
+      offset = std::min(offset, headerLength);
+
+      ConstBuffers result;
+      result[0] = asio_ns::const_buffer(_buffer->begin() + offset, headerLength - offset);
+      if (_body != nullptr) {
+        result[1] = asio_ns::const_buffer(_body->begin() + skipBody,
+                                          _body->length() - skipBody);
+      }
+      return result;
+    }
+
     void release(SocketTask* task = nullptr) {
       if (_buffer != nullptr) {
         if (task != nullptr) {
@@ -127,6 +166,15 @@ class SocketTask : public IoTask {
         _buffer = nullptr;
       }
 
+      if (_body != nullptr) {
+        if (task != nullptr) {
+          task->returnStringBuffer(_body);
+        } else {
+          delete _body;
+        }
+        _body = nullptr;
+      }
+
       if (_statistics != nullptr) {
         _statistics->release();
         _statistics = nullptr;
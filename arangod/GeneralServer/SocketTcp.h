@@ -50,12 +50,12 @@ class SocketTcp final : public Socket {
 
   void setNonBlocking(bool v) override { _socket->non_blocking(v); }
 
-  size_t writeSome(basics::StringBuffer* buffer, asio_ns::error_code& ec) override {
-    return _socket->write_some(asio_ns::buffer(buffer->begin(), buffer->length()), ec);
+  size_t writeSome(ConstBuffers const& buffers, asio_ns::error_code& ec) override {
+    return _socket->write_some(buffers, ec);
   }
 
-  void asyncWrite(asio_ns::mutable_buffers_1 const& buffer, AsyncHandler const& handler) override {
-    return asio_ns::async_write(*_socket, buffer, handler);
+  void asyncWrite(ConstBuffers const& buffers, AsyncHandler const& handler) override {
+    return asio_ns::async_write(*_socket, buffers, handler);
   }
 
   size_t readSome(asio_ns::mutable_buffers_1 const& buffer, asio_ns::error_code& ec) override {
@@ -81,7 +81,9 @@ class SocketTcp final : public Socket {
   }
 
  protected:
-  bool sslHandshake() override { return false; }
+  void asyncSslHandshake(HandshakeHandler const& handler) override {
+    handler(asio_ns::error::operation_not_supported);
+  }
 
   void shutdownReceive(asio_ns::error_code& ec) override {
     _socket->shutdown(asio_ns::ip::tcp::socket::shutdown_receive, ec);
@@ -46,9 +46,9 @@ class SocketUnixDomain final : public Socket {
 
   void setNonBlocking(bool v) override { _socket->non_blocking(v); }
 
-  size_t writeSome(basics::StringBuffer* buffer, asio_ns::error_code& ec) override;
+  size_t writeSome(ConstBuffers const& buffers, asio_ns::error_code& ec) override;
 
-  void asyncWrite(asio_ns::mutable_buffers_1 const& buffer, AsyncHandler const& handler) override;
+  void asyncWrite(ConstBuffers const& buffers, AsyncHandler const& handler) override;
 
   size_t readSome(asio_ns::mutable_buffers_1 const& buffer, asio_ns::error_code& ec) override;
 
@@ -57,7 +57,9 @@ class SocketUnixDomain final : public Socket {
   void asyncRead(asio_ns::mutable_buffers_1 const& buffer, AsyncHandler const& handler) override;
 
  protected:
-  bool sslHandshake() override { return false; }
+  void asyncSslHandshake(HandshakeHandler const& handler) override {
+    handler(asio_ns::error::operation_not_supported);
+  }
   void shutdownReceive(asio_ns::error_code& ec) override;
   void shutdownSend(asio_ns::error_code& ec) override;
   void close(asio_ns::error_code& ec) override;
@@ -26,6 +26,7 @@
 #include <vector>
 
 #include <s2/s2latlng.h>
+#include <s2/s2region.h>
 #include <s2/s2region_coverer.h>
 
 #include <velocypack/Slice.h>
@@ -78,12 +79,24 @@ Index::Index(VPackSlice const& info,
 /// @brief Parse document and return cells for indexing
 Result Index::indexCells(VPackSlice const& doc, std::vector<S2CellId>& cells,
                          S2Point& centroid) const {
+  S2LatLngRect bound;
+  return indexCells(doc, cells, centroid, bound);
+}
+
+Result Index::indexCells(VPackSlice const& doc, std::vector<S2CellId>& cells,
+                         S2Point& centroid, S2LatLngRect& bound) const {
   using geo::GeoUtils;
 
+  bound = S2LatLngRect::Empty();
+
   if (_variant == Variant::GEOJSON) {
     VPackSlice loc = doc.get(_location);
     if (loc.isArray()) {
-      return GeoUtils::indexCellsLatLng(loc, /*geojson*/ true, cells, centroid);
+      Result r = GeoUtils::indexCellsLatLng(loc, /*geojson*/ true, cells, centroid);
+      if (r.ok()) {
+        bound = S2LatLngRect::FromPoint(S2LatLng(centroid));
+      }
+      return r;
     }
     geo::ShapeContainer shape;
     Result r = geo::geojson::parseRegion(loc, shape);
@@ -94,6 +107,9 @@ Result Index::indexCells(VPackSlice const& doc, std::vector<S2CellId>& cells,
       if (!S2LatLng(centroid).is_valid()) {
         return TRI_ERROR_BAD_PARAMETER;
       }
+      bound = shape.type() == geo::ShapeContainer::Type::S2_POINT
+                  ? S2LatLngRect::FromPoint(S2LatLng(centroid))
+                  : shape.region()->GetRectBound();
     } else if (r.is(TRI_ERROR_NOT_IMPLEMENTED)) {
       // ignore not-implemented error on inserts, because index is sparse
       return TRI_ERROR_BAD_PARAMETER;
@@ -101,7 +117,11 @@ Result Index::indexCells(VPackSlice const& doc, std::vector<S2CellId>& cells,
     return r;
   } else if (_variant == Variant::COMBINED_LAT_LON) {
     VPackSlice loc = doc.get(_location);
-    return GeoUtils::indexCellsLatLng(loc, /*geojson*/ false, cells, centroid);
+    Result r = GeoUtils::indexCellsLatLng(loc, /*geojson*/ false, cells, centroid);
+    if (r.ok()) {
+      bound = S2LatLngRect::FromPoint(S2LatLng(centroid));
+    }
+    return r;
   } else if (_variant == Variant::INDIVIDUAL_LAT_LON) {
     VPackSlice lat = doc.get(_latitude);
     VPackSlice lon = doc.get(_longitude);
@@ -117,6 +137,7 @@ Result Index::indexCells(VPackSlice const& doc, std::vector<S2CellId>& cells,
     }
     centroid = ll.ToPoint();
     cells.emplace_back(centroid);
+    bound = S2LatLngRect::FromPoint(ll);
     return TRI_ERROR_NO_ERROR;
   }
   return TRI_ERROR_INTERNAL;
@@ -25,6 +25,7 @@
 
 #include <s2/s2cell_id.h>
 #include <s2/s2latlng.h>
+#include <s2/s2latlng_rect.h>
 
 #include "Basics/Result.h"
 #include "Geo/GeoParams.h"
@@ -73,6 +74,11 @@ struct Index {
   Result indexCells(velocypack::Slice const& doc, std::vector<S2CellId>& cells,
                     S2Point& centroid) const;
 
+  /// @brief Parse document and return cells for indexing and the bounding
+  /// rectangle of its shape, which is a point for coordinates
+  Result indexCells(velocypack::Slice const& doc, std::vector<S2CellId>& cells,
+                    S2Point& centroid, S2LatLngRect& bound) const;
+
   Result shape(velocypack::Slice const& doc, geo::ShapeContainer& shape) const;
 
   /// @brief Parse AQL condition into query parameters
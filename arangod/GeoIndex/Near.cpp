@@ -52,7 +52,13 @@ NearUtils<CMP>::NearUtils(geo::QueryParams&& qp) noexcept
       _allIntervalsCovered(false),
       _statsFoundLastInterval(0),
       _numScans(0),
+      _emptyScans(0),
+      _filterBound(S2LatLngRect::Full()),
       _coverer(_params.cover.regionCovererOpts()) {
+  if (!isFilterNone()) {
+    TRI_ASSERT(!_params.filterShape.empty());
+    _filterBound = _params.filterShape.region()->GetRectBound();
+  }
   reset();
   // Level 15 == 474.142m (start with 15 essentially)
   TRI_ASSERT(_params.origin.is_valid());
@@ -89,6 +95,9 @@ void NearUtils<CMP>::reset() {
   _allIntervalsCovered = false;
   _statsFoundLastInterval = 0;
   _numScans = 0;
+  _emptyScans = 0;
+  _found = 0;
+  _rejection = 0;
   // this initial interval is never used like that, see intervals()
   _outerAngle = _innerAngle = isAscending() ? _minAngle : _maxAngle;
   const int level = S2::kAvgDiag.GetClosestLevel(8000 / geo::kEarthRadiusInMeters);
@@ -245,7 +254,8 @@ std::vector<geo::Interval> NearUtils<CMP>::intervals() {
 }
 
 template <typename CMP>
-void NearUtils<CMP>::reportFound(LocalDocumentId lid, S2Point const& center) {
+void NearUtils<CMP>::reportFound(LocalDocumentId lid, S2Point const& center,
+                                  S2LatLngRect const* bound) {
   S1ChordAngle angle(_origin, center);
 
   // cheap rejections based on distance to target
@@ -269,17 +279,32 @@ void NearUtils<CMP>::reportFound(LocalDocumentId lid, S2Point const& center) {
     }
   }
 
-  // possibly expensive point rejection, but saves parsing of document
-  if (isFilterContains()) {
+  bool exact = false;
+  if (!isFilterNone()) {
     TRI_ASSERT(!_params.filterShape.empty());
-    if (!_params.filterShape.contains(center)) {
+    if (_params.pointsOnly || (bound != nullptr && bound->is_point())) {
+      // the shape is its centroid, the point test is exact and saves
+      // parsing of the document. a point intersects a region it is in
+      if (!_params.filterShape.contains(center)) {
+        _rejection++;
+        return;
+      }
+      exact = true;
+    } else if (bound != nullptr &&
+               ((isFilterContains() && !_filterBound.Contains(*bound)) ||
+                (isFilterIntersects() && !_filterBound.Intersects(*bound)))) {
+      // cheap rejection based on the bounding rectangles
+      _rejection++;
+      return;
+    } else if (isFilterContains() && !_params.filterShape.contains(center)) {
+      // possibly expensive point rejection, but saves parsing of document
       _rejection++;
       return;
     }
   }
   _found++;
   _statsFoundLastInterval++;  // we have to estimate scan bounds
-  _buffer.emplace(lid, angle);
+  _buffer.emplace(lid, angle, exact);
 }
 
 /// called after current intervals were scanned
@@ -296,13 +321,39 @@ template <typename CMP>
 void NearUtils<CMP>::estimateDelta() {
   S1ChordAngle minBound =
       S1ChordAngle::Radians(S2::kMaxDiag.GetValue(S2::kMaxCellLevel - 3));
-  if (_statsFoundLastInterval <= 64) {
+  // squared chord length of the whole sphere
+  constexpr double maxLength2 = 4.0;
+
+  if (isAscending() && _params.limit > 0 && _found > 0 &&
+      _found < _params.limit) {
+    // all documents found so far lie within the outer angle. assuming the
+    // same density further out, the remaining ones are within the cap whose
+    // area, which is proportional to the squared chord length, is larger
+    // by limit / found. a bit of slack avoids another tiny expansion
+    double const factor = 1.5 * static_cast<double>(_params.limit) / _found;
+    S1ChordAngle const target = S1ChordAngle::FromLength2(
+        std::min(_outerAngle.length2() * factor, maxLength2));
+    if (target.radians() > _outerAngle.radians() + _deltaAngle.radians()) {
+      _deltaAngle =
+          S1ChordAngle::Radians(target.radians() - _outerAngle.radians());
+    }
+  } else if (_statsFoundLastInterval == 0) {
+    // nothing in the last ring. sparse regions are left behind faster with
+    // each empty ring, instead of doubling the search radius every time
+    _emptyScans = std::min<size_t>(_emptyScans + 1, 4);
+    double const factor = static_cast<double>(size_t(4) << (2 * _emptyScans));
+    _deltaAngle = S1ChordAngle::FromLength2(
+        std::min(_deltaAngle.length2() * factor, maxLength2));
+  } else if (_statsFoundLastInterval <= 64) {
     _deltaAngle = S1ChordAngle::FromLength2(_deltaAngle.length2() * 4);
   } else if (_statsFoundLastInterval <= 256) {
     _deltaAngle += _deltaAngle;
   } else if (_statsFoundLastInterval > 1024 && _deltaAngle > minBound) {
     _deltaAngle = S1ChordAngle::FromLength2(_deltaAngle.length2() / 2);
   }
+  if (_statsFoundLastInterval > 0) {
+    _emptyScans = 0;
+  }
   _statsFoundLastInterval = 0;
   TRI_ASSERT(_deltaAngle > S1ChordAngle::Zero());
 }
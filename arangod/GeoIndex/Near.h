@@ -29,6 +29,7 @@
 
 #include <s2/s2cap.h>
 #include <s2/s2cell_id.h>
+#include <s2/s2latlng_rect.h>
 #include <s2/s2region.h>
 #include <s2/s2region_coverer.h>
 
@@ -45,12 +46,15 @@ namespace geo_index {
 
 /// result of a geospatial index query. distance may or may not be set
 struct Document {
-  Document(LocalDocumentId d, S1ChordAngle angle)
-      : token(d), distAngle(angle) {}
+  Document(LocalDocumentId d, S1ChordAngle angle, bool exact = false)
+      : token(d), distAngle(angle), exact(exact) {}
   /// @brief LocalDocumentId
   LocalDocumentId token;
   /// @brief distance from centroids on the unit sphere
   S1ChordAngle distAngle;
+  /// @brief the filter shape was tested exactly against the document shape
+  /// already, the document does not need to be read for it
+  bool exact;
 };
 
 struct DocumentsAscending {
@@ -146,8 +150,11 @@ class NearUtils {
   /// new ones without calling updateBounds
   std::vector<geo::Interval> intervals();
 
-  /// buffer and sort results
-  void reportFound(LocalDocumentId lid, S2Point const& center);
+  /// buffer and sort results. bound is the bounding rectangle of the
+  /// document shape if known, it allows to reject documents without
+  /// reading them
+  void reportFound(LocalDocumentId lid, S2Point const& center,
+                   S2LatLngRect const* bound = nullptr);
 
   /// Call after scanning all intervals
   void didScanIntervals();
@@ -199,6 +206,8 @@ class NearUtils {
   size_t _statsFoundLastInterval;
   /// Total number of interval calculations
   size_t _numScans;
+  /// number of consecutive scans without results
+  size_t _emptyScans;
 
   /// Amount to increment by
   S1ChordAngle _deltaAngle;
@@ -207,6 +216,9 @@ class NearUtils {
   /// outer limit of search area
   S1ChordAngle _outerAngle;
 
+  /// bounding rectangle of the filter shape
+  S2LatLngRect _filterBound;
+
   /// buffer of found documents
   GeoDocumentsQueue _buffer;
 
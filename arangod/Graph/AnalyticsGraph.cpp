@@ -0,0 +1,272 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2019 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "AnalyticsGraph.h"
+
+#include "Basics/Exceptions.h"
+#include "Indexes/IndexIterator.h"
+#include "Transaction/Helpers.h"
+#include "Transaction/Methods.h"
+
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace arangodb;
+using namespace arangodb::graph;
+
+constexpr size_t AnalyticsGraph::MaxEdges;
+
+namespace {
+constexpr AnalyticsGraph::VertexId NoVertex = std::numeric_limits<AnalyticsGraph::VertexId>::max();
+}  // namespace
+
+AnalyticsGraph::AnalyticsGraph() {}
+
+void AnalyticsGraph::load(transaction::Methods* trx, std::string const& collectionName) {
+  std::unique_ptr<IndexIterator> iterator =
+      trx->indexScan(collectionName, transaction::Methods::CursorType::ALL);
+
+  auto callback = [this](LocalDocumentId const&, VPackSlice edge) {
+    VPackSlice from = transaction::helpers::extractFromFromDocument(edge);
+    VPackSlice to = transaction::helpers::extractToFromDocument(edge);
+    if (!from.isString() || !to.isString()) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_ARANGO_COLLECTION_TYPE_INVALID,
+                                     "expecting an edge collection");
+    }
+    addEdge(velocypack::StringRef(from), velocypack::StringRef(to));
+  };
+  while (iterator->nextDocument(callback, 1000)) {
+  }
+}
+
+void AnalyticsGraph::addEdge(velocypack::StringRef from, velocypack::StringRef to) {
+  if (_edges.size() >= MaxEdges) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_RESOURCE_LIMIT,
+                                   "graph has too many edges to be analyzed "
+                                   "in memory, use Pregel instead");
+  }
+  VertexId source = intern(from);
+  VertexId target = intern(to);
+  _edges.emplace_back(source, target);
+}
+
+AnalyticsGraph::VertexId AnalyticsGraph::intern(velocypack::StringRef id) {
+  auto it = _ids.find(id);
+  if (it != _ids.end()) {
+    return it->second;
+  }
+  VertexId result = static_cast<VertexId>(_vertices.size());
+  // a deque does not move its elements, so the keys stay valid
+  _vertices.emplace_back(id.data(), id.size());
+  _ids.emplace(velocypack::StringRef(_vertices.back()), result);
+  return result;
+}
+
+void AnalyticsGraph::buildRows(bool outbound, std::vector<uint64_t>& offsets,
+                               std::vector<VertexId>& targets) const {
+  offsets.assign(_vertices.size() + 1, 0);
+  for (auto const& edge : _edges) {
+    ++offsets[(outbound ? edge.first : edge.second) + 1];
+  }
+  for (size_t v = 0; v < _vertices.size(); ++v) {
+    offsets[v + 1] += offsets[v];
+  }
+
+  std::vector<uint64_t> positions(offsets.begin(), offsets.end() - 1);
+  targets.resize(_edges.size());
+  for (auto const& edge : _edges) {
+    if (outbound) {
+      targets[positions[edge.first]++] = edge.second;
+    } else {
+      targets[positions[edge.second]++] = edge.first;
+    }
+  }
+}
+
+void AnalyticsGraph::finish() {
+  buildRows(true, _outOffsets, _outTargets);
+  buildRows(false, _inOffsets, _inSources);
+
+  // merge both directions into sorted rows
+  size_t const n = _vertices.size();
+  _offsets.clear();
+  _offsets.reserve(n + 1);
+  _offsets.emplace_back(0);
+  _neighbors.clear();
+  _neighbors.reserve(2 * _edges.size());
+  for (VertexId v = 0; v < n; ++v) {
+    size_t begin = _neighbors.size();
+    for (uint64_t i = _outOffsets[v]; i < _outOffsets[v + 1]; ++i) {
+      if (_outTargets[i] != v) {
+        _neighbors.emplace_back(_outTargets[i]);
+      }
+    }
+    for (uint64_t i = _inOffsets[v]; i < _inOffsets[v + 1]; ++i) {
+      if (_inSources[i] != v) {
+        _neighbors.emplace_back(_inSources[i]);
+      }
+    }
+    std::sort(_neighbors.begin() + begin, _neighbors.end());
+    _neighbors.erase(std::unique(_neighbors.begin() + begin, _neighbors.end()),
+                     _neighbors.end());
+    _offsets.emplace_back(_neighbors.size());
+  }
+  _neighbors.shrink_to_fit();
+
+  _edges.clear();
+  _edges.shrink_to_fit();
+  _ids.clear();
+}
+
+std::vector<double> AnalyticsGraph::pageRank(double dampingFactor, double threshold,
+                                             size_t maxIterations) const {
+  size_t const n = _vertices.size();
+  std::vector<double> rank(n, n == 0 ? 0.0 : 1.0 / n);
+  std::vector<double> next(n);
+  std::vector<double> contribution(n);
+
+  for (size_t iteration = 0; iteration < maxIterations; ++iteration) {
+    double dangling = 0.0;
+    for (VertexId v = 0; v < n; ++v) {
+      uint64_t degree = _outOffsets[v + 1] - _outOffsets[v];
+      if (degree == 0) {
+        dangling += rank[v];
+        contribution[v] = 0.0;
+      } else {
+        contribution[v] = rank[v] / degree;
+      }
+    }
+
+    double const base = (1.0 - dampingFactor) / n + dampingFactor * dangling / n;
+    double diff = 0.0;
+    for (VertexId v = 0; v < n; ++v) {
+      double sum = 0.0;
+      for (uint64_t i = _inOffsets[v]; i < _inOffsets[v + 1]; ++i) {
+        sum += contribution[_inSources[i]];
+      }
+      next[v] = base + dampingFactor * sum;
+      diff += std::abs(next[v] - rank[v]);
+    }
+    rank.swap(next);
+
+    if (diff <= threshold) {
+      break;
+    }
+  }
+  return rank;
+}
+
+std::vector<AnalyticsGraph::VertexId> AnalyticsGraph::connectedComponents() const {
+  size_t const n = _vertices.size();
+  std::vector<VertexId> component(n, ::NoVertex);
+  std::vector<VertexId> members;
+
+  for (VertexId start = 0; start < n; ++start) {
+    if (component[start] != ::NoVertex) {
+      continue;
+    }
+
+    // breadth-first search, members doubles as the queue
+    members.clear();
+    members.emplace_back(start);
+    component[start] = start;
+    VertexId smallest = start;
+    for (size_t next = 0; next < members.size(); ++next) {
+      VertexId v = members[next];
+      if (_vertices[v] < _vertices[smallest]) {
+        smallest = v;
+      }
+      for (uint64_t i = _offsets[v]; i < _offsets[v + 1]; ++i) {
+        VertexId w = _neighbors[i];
+        if (component[w] == ::NoVertex) {
+          component[w] = start;
+          members.emplace_back(w);
+        }
+      }
+    }
+
+    for (VertexId v : members) {
+      component[v] = smallest;
+    }
+  }
+  return component;
+}
+
+std::vector<double> AnalyticsGraph::degreeCentrality(TRI_edge_direction_e direction) const {
+  size_t const n = _vertices.size();
+  std::vector<double> result(n, 0.0);
+  if (n < 2) {
+    return result;
+  }
+
+  for (VertexId v = 0; v < n; ++v) {
+    uint64_t degree = 0;
+    if (direction != TRI_EDGE_IN) {
+      degree += _outOffsets[v + 1] - _outOffsets[v];
+    }
+    if (direction != TRI_EDGE_OUT) {
+      degree += _inOffsets[v + 1] - _inOffsets[v];
+    }
+    result[v] = static_cast<double>(degree) / (n - 1);
+  }
+  return result;
+}
+
+std::vector<uint64_t> AnalyticsGraph::triangleCount() const {
+  size_t const n = _vertices.size();
+  std::vector<uint64_t> result(n, 0);
+
+  // every triangle is found once, from its vertex of lowest degree, by
+  // following edges to vertices of higher degree only. this bounds the
+  // work by O(m * sqrt(m))
+  auto higher = [this](VertexId lhs, VertexId rhs) {
+    uint64_t lhsDegree = _offsets[lhs + 1] - _offsets[lhs];
+    uint64_t rhsDegree = _offsets[rhs + 1] - _offsets[rhs];
+    return lhsDegree > rhsDegree || (lhsDegree == rhsDegree && lhs > rhs);
+  };
+
+  std::vector<VertexId> marked(n, ::NoVertex);
+  for (VertexId u = 0; u < n; ++u) {
+    for (uint64_t i = _offsets[u]; i < _offsets[u + 1]; ++i) {
+      if (higher(_neighbors[i], u)) {
+        marked[_neighbors[i]] = u;
+      }
+    }
+    for (uint64_t i = _offsets[u]; i < _offsets[u + 1]; ++i) {
+      VertexId v = _neighbors[i];
+      if (!higher(v, u)) {
+        continue;
+      }
+      for (uint64_t j = _offsets[v]; j < _offsets[v + 1]; ++j) {
+        VertexId w = _neighbors[j];
+        if (marked[w] == u && higher(w, v)) {
+          ++result[u];
+          ++result[v];
+          ++result[w];
+        }
+      }
+    }
+  }
+  return result;
+}
@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2019 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_GRAPH_ANALYTICS_GRAPH_H
+#define ARANGOD_GRAPH_ANALYTICS_GRAPH_H 1
+
+#include "Basics/Common.h"
+#include "VocBase/voc-types.h"
+
+#include <velocypack/StringRef.h>
+
+#include <deque>
+
+namespace arangodb {
+namespace transaction {
+class Methods;
+}
+
+namespace graph {
+
+/// @brief the edges of one collection as compressed sparse rows in memory,
+/// for running graph algorithms in-process on a single server. this avoids
+/// the setup of a Pregel job, which dominates for small and medium graphs.
+/// only vertices with at least one edge are part of the graph
+class AnalyticsGraph {
+ public:
+  typedef uint32_t VertexId;
+
+  /// @brief maximal number of edges, larger graphs should use Pregel
+  static constexpr size_t MaxEdges = 16 * 1024 * 1024;
+
+  AnalyticsGraph(AnalyticsGraph const&) = delete;
+  AnalyticsGraph& operator=(AnalyticsGraph const&) = delete;
+
+  AnalyticsGraph();
+
+  /// @brief adds all edges of a collection of the transaction
+  void load(transaction::Methods*, std::string const& collectionName);
+
+  void addEdge(arangodb::velocypack::StringRef from, arangodb::velocypack::StringRef to);
+
+  /// @brief builds the adjacency lists, called after the last edge was added
+  void finish();
+
+  size_t numVertices() const { return _vertices.size(); }
+
+  size_t numEdges() const { return _outTargets.size(); }
+
+  std::string const& vertex(VertexId id) const { return _vertices[id]; }
+
+  /// @brief the rank of each vertex, iterated until the sum of all changes
+  /// is at most threshold. ranks of vertices without outgoing edges are
+  /// distributed evenly
+  std::vector<double> pageRank(double dampingFactor, double threshold,
+                               size_t maxIterations) const;
+
+  /// @brief the weakly connected component of each vertex, identified by
+  /// its vertex with the smallest id
+  std::vector<VertexId> connectedComponents() const;
+
+  /// @brief the number of edges of each vertex in the given direction,
+  /// divided by the number of other vertices
+  std::vector<double> degreeCentrality(TRI_edge_direction_e direction) const;
+
+  /// @brief the number of triangles each vertex is part of, ignoring the
+  /// direction and multiplicity of edges
+  std::vector<uint64_t> triangleCount() const;
+
+ private:
+  VertexId intern(arangodb::velocypack::StringRef id);
+
+  /// @brief builds the rows of the given sources from the edge list
+  void buildRows(bool outbound, std::vector<uint64_t>& offsets,
+                 std::vector<VertexId>& targets) const;
+
+ private:
+  // interned vertex ids
+  std::deque<std::string> _vertices;
+  std::unordered_map<arangodb::velocypack::StringRef, VertexId> _ids;
+
+  // the edges, until finish() is called
+  std::vector<std::pair<VertexId, VertexId>> _edges;
+
+  // outgoing and incoming edges, the edges of vertex v are at
+  // [offsets[v], offsets[v + 1])
+  std::vector<uint64_t> _outOffsets;
+  std::vector<VertexId> _outTargets;
+  std::vector<uint64_t> _inOffsets;
+  std::vector<VertexId> _inSources;
+
+  // sorted neighbors of each vertex in any direction, without duplicates
+  // and self loops
+  std::vector<uint64_t> _offsets;
+  std::vector<VertexId> _neighbors;
+};
+
+}  // namespace graph
+}  // namespace arangodb
+
+#endif
@@ -23,7 +23,11 @@
 
 #include "AttributeWeightShortestPathFinder.h"
 
+#include "Aql/AqlValue.h"
 #include "Basics/Exceptions.h"
+#include "Geo/GeoJson.h"
+#include "Geo/GeoParams.h"
+#include "Geo/ShapeContainer.h"
 #include "Graph/EdgeCursor.h"
 #include "Graph/EdgeDocumentToken.h"
 #include "Graph/ShortestPathOptions.h"
@@ -107,7 +111,9 @@ void AttributeWeightShortestPathFinder::Searcher::lookupPeer(arangodb::velocypac
   // Did we find a solution on our own? This is for the
   // single thread case and for the case that the other
   // thread is too slow to even finish its own start vertex!
-  if (s->weight() == 0) {
+  // Only the start vertex of the peer has no predecessor, other
+  // vertices may have a weight of 0 as well
+  if (s->_predecessor.empty()) {
     // We have found the target, we have finished all
     // vertices with a smaller weight than this one (and did
     // not succeed), so this must be a best solution:
@@ -172,12 +178,20 @@ bool AttributeWeightShortestPathFinder::shortestPath(arangodb::velocypack::Slice
   _highscore = 0;
   _bingo = false;
   _intermediateSet = false;
+  _potentials.clear();
 
   arangodb::velocypack::StringRef start =
       _options.cache()->persistString(arangodb::velocypack::StringRef(st));
   arangodb::velocypack::StringRef target =
       _options.cache()->persistString(arangodb::velocypack::StringRef(ta));
 
+  if (_options.useHeuristic()) {
+    _options.fetchVerticesCoordinator(
+        std::deque<arangodb::velocypack::StringRef>{start, target});
+    _startLocation = location(start);
+    _targetLocation = location(target);
+  }
+
   // Forward with initialization:
   arangodb::velocypack::StringRef emptyVertex;
   ThreadInfo forward;
@@ -331,6 +345,87 @@ void AttributeWeightShortestPathFinder::expandVertex(
   };
 
   edgeCursor->readAll(callback);
+
+  if (_options.useHeuristic()) {
+    // the potentials need the vertex documents, fetch them in one go
+    std::deque<arangodb::velocypack::StringRef> missing;
+    for (auto const& step : result) {
+      if (_potentials.find(step->_vertex) == _potentials.end()) {
+        missing.emplace_back(step->_vertex);
+      }
+    }
+    _options.fetchVerticesCoordinator(missing);
+
+    for (auto& step : result) {
+      step->setWeight(reducedWeight(isBackward, vertex, step->_vertex, step->weight()));
+    }
+  }
+}
+
+AttributeWeightShortestPathFinder::Location AttributeWeightShortestPathFinder::location(
+    arangodb::velocypack::StringRef const& vertex) {
+  Location result;
+
+  aql::AqlValue value = _options.cache()->fetchVertexAqlResult(vertex);
+  aql::AqlValueGuard guard(value, true);
+  VPackSlice doc = value.slice();
+  if (!doc.isObject()) {
+    return result;
+  }
+
+  VPackSlice coordinates = doc.get(_options.heuristicAttribute);
+  geo::ShapeContainer shape;
+  Result res;
+  if (coordinates.isArray()) {
+    res = shape.parseCoordinates(coordinates, /*geoJson*/ true);
+  } else if (coordinates.isObject()) {
+    res = geo::geojson::parseRegion(coordinates, shape);
+  } else {
+    return result;
+  }
+  if (res.fail()) {
+    // vertices without a position do not direct the search
+    return result;
+  }
+
+  S2Point point = shape.centroid();
+  result.x = point.x();
+  result.y = point.y();
+  result.z = point.z();
+  result.valid = true;
+  return result;
+}
+
+double AttributeWeightShortestPathFinder::potential(bool isBackward,
+                                                    arangodb::velocypack::StringRef const& vertex) {
+  auto it = _potentials.find(vertex);
+  if (it == _potentials.end()) {
+    auto estimate = [this](Location const& lhs, Location const& rhs) -> double {
+      if (!lhs.valid || !rhs.valid) {
+        return 0.0;
+      }
+      double angle = S2Point(lhs.x, lhs.y, lhs.z).Angle(S2Point(rhs.x, rhs.y, rhs.z));
+      return angle * geo::kEarthRadiusInMeters * _options.heuristicFactor;
+    };
+
+    Location const loc = location(vertex);
+    double p = estimate(loc, _targetLocation);
+    if (_options.bidirectional) {
+      // both searchers need potentials that sum up to a constant, so that
+      // they agree on the weight of a path
+      p = (p - estimate(_startLocation, loc)) / 2.0;
+    }
+    it = _potentials.emplace(vertex, p).first;
+  }
+  return isBackward ? -it->second : it->second;
+}
+
+double AttributeWeightShortestPathFinder::reducedWeight(bool isBackward,
+                                                        arangodb::velocypack::StringRef const& u,
+                                                        arangodb::velocypack::StringRef const& v,
+                                                        double weight) {
+  // an estimate exceeding the actual weight could make it negative
+  return std::max(0.0, weight - potential(isBackward, u) + potential(isBackward, v));
 }
 
 /*
@@ -221,6 +221,29 @@ class AttributeWeightShortestPathFinder : public ShortestPathFinder {
   void expandVertex(bool isBackward, arangodb::velocypack::StringRef const& source,
                     std::vector<std::unique_ptr<Step>>& result);
 
+ private:
+  /// @brief a vertex position on the unit sphere
+  struct Location {
+    double x = 0.0;
+    double y = 0.0;
+    double z = 0.0;
+    bool valid = false;
+  };
+
+  /// @brief the position of a vertex, read from the heuristic attribute
+  Location location(arangodb::velocypack::StringRef const& vertex);
+
+  /// @brief the potential of a vertex in the given direction. the searchers
+  /// use edge weights reduced by the potentials, w - p(u) + p(v), which
+  /// directs them towards each other and leaves the shortest path unchanged
+  double potential(bool isBackward, arangodb::velocypack::StringRef const& vertex);
+
+  /// @brief the weight of an edge from u to v, reduced by the potentials
+  double reducedWeight(bool isBackward, arangodb::velocypack::StringRef const& u,
+                       arangodb::velocypack::StringRef const& v, double weight);
+
+ public:
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief return the shortest path between the start and target vertex,
   /// multi-threaded version using SearcherTwoThreads.
@@ -275,6 +298,15 @@ class AttributeWeightShortestPathFinder : public ShortestPathFinder {
 
   bool _intermediateSet;
   arangodb::velocypack::StringRef _intermediate;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief positions of start and target, and the forward potentials of
+  /// all vertices seen so far, if a heuristic is used
+  //////////////////////////////////////////////////////////////////////////////
+
+  Location _startLocation;
+  Location _targetLocation;
+  std::unordered_map<arangodb::velocypack::StringRef, double> _potentials;
 };
 
 }  // namespace graph
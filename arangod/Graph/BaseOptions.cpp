@@ -29,6 +29,7 @@
 #include "Aql/Expression.h"
 #include "Aql/IndexNode.h"
 #include "Aql/Query.h"
+#include "Basics/AttributeNameParser.h"
 #include "Basics/HashSet.h"
 #include "Graph/ShortestPathOptions.h"
 #include "Graph/SingleServerEdgeCursor.h"
@@ -47,6 +48,22 @@ using namespace arangodb;
 using namespace arangodb::graph;
 using namespace arangodb::traverser;
 
+namespace {
+/// @brief whether an index returns the edges of a vertex sorted by the
+/// given attribute
+bool sortsEdges(Index const& index, std::string const& attributeName,
+                std::string const& sortAttribute) {
+  auto const& fields = index.fields();
+  if (!index.isSorted() || fields.size() < 2 || fields[0].size() != 1 ||
+      fields[0][0].name != attributeName || fields[0][0].shouldExpand) {
+    return false;
+  }
+  std::string name;
+  basics::TRI_AttributeNamesToString(fields[1], name, false);
+  return name == sortAttribute;
+}
+}  // namespace
+
 BaseOptions::LookupInfo::LookupInfo()
     : expression(nullptr),
       indexCondition(nullptr),
@@ -237,25 +254,57 @@ void BaseOptions::setVariable(aql::Variable const* variable) {
 }
 
 void BaseOptions::addLookupInfo(aql::ExecutionPlan* plan, std::string const& collectionName,
-                                std::string const& attributeName, aql::AstNode* condition) {
-  injectLookupInfoInList(_baseLookupInfos, plan, collectionName, attributeName, condition);
+                                std::string const& attributeName, aql::AstNode* condition,
+                                std::string const& sortAttribute) {
+  injectLookupInfoInList(_baseLookupInfos, plan, collectionName, attributeName,
+                         condition, sortAttribute);
 }
 
 void BaseOptions::injectLookupInfoInList(std::vector<LookupInfo>& list,
                                          aql::ExecutionPlan* plan,
                                          std::string const& collectionName,
                                          std::string const& attributeName,
-                                         aql::AstNode* condition) {
+                                         aql::AstNode* condition,
+                                         std::string const& sortAttribute) {
   LookupInfo info;
   info.indexCondition = condition->clone(plan->getAst());
-  bool res =
-      _trx->getBestIndexHandleForFilterCondition(collectionName, info.indexCondition,
-                                                 _tmpVar, 1000, aql::IndexHint(),
-                                                 info.idxHandles[0]);
-  // Right now we have an enforced edge index which should always fit.
-  if (!res) {
-    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
-                                   "expected edge index not found");
+  if (sortAttribute.empty()) {
+    bool res =
+        _trx->getBestIndexHandleForFilterCondition(collectionName, info.indexCondition,
+                                                   _tmpVar, 1000, aql::IndexHint(),
+                                                   info.idxHandles[0]);
+    // Right now we have an enforced edge index which should always fit.
+    if (!res) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                     "expected edge index not found");
+    }
+  } else {
+    // the edges have to come out sorted, so only a sorted index that starts
+    // with the vertex attribute and continues with the sort attribute fits
+    auto indexes = _trx->indexesForCollection(collectionName);
+    std::shared_ptr<Index> best;
+    double bestCost = 0.0;
+    for (auto const& idx : indexes) {
+      if (!::sortsEdges(*idx, attributeName, sortAttribute)) {
+        continue;
+      }
+      size_t estimatedItems;
+      double estimatedCost;
+      if (idx->supportsFilterCondition(indexes, info.indexCondition, _tmpVar, 1000,
+                                       estimatedItems, estimatedCost) &&
+          (best == nullptr || estimatedCost < bestCost)) {
+        best = idx;
+        bestCost = estimatedCost;
+      }
+    }
+    if (best == nullptr) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                     "edgeSort requires a persistent index on [" +
+                                         attributeName + ", " + sortAttribute +
+                                         "] in collection '" + collectionName + "'");
+    }
+    info.indexCondition = best->specializeCondition(info.indexCondition, _tmpVar);
+    info.idxHandles[0] = transaction::Methods::IndexHandle(best);
   }
 
   // We now have to check if we need _from / _to inside the index lookup and
@@ -397,7 +446,8 @@ double BaseOptions::costForLookupInfoList(std::vector<BaseOptions::LookupInfo> c
 }
 
 EdgeCursor* BaseOptions::nextCursorLocal(arangodb::velocypack::StringRef vid,
-                                         std::vector<LookupInfo> const& list) {
+                                         std::vector<LookupInfo> const& list,
+                                         bool descending) {
   auto allCursor = std::make_unique<SingleServerEdgeCursor>(this, list.size());
   auto& opCursors = allCursor->getCursors();
   for (auto& info : list) {
@@ -419,6 +469,7 @@ EdgeCursor* BaseOptions::nextCursorLocal(arangodb::velocypack::StringRef vid,
     std::vector<OperationCursor*> csrs;
     csrs.reserve(info.idxHandles.size());
     IndexIteratorOptions opts;
+    opts.ascending = !descending;
     for (auto const& it : info.idxHandles) {
       // the emplace_back cannot throw here, as we reserved enough space before
       csrs.emplace_back(new OperationCursor(_trx->indexScanForCondition(it, node, _tmpVar, opts)));
@@ -428,6 +479,29 @@ EdgeCursor* BaseOptions::nextCursorLocal(arangodb::velocypack::StringRef vid,
   return allCursor.release();
 }
 
+EdgeCursor* BaseOptions::nextCursorLocal(VPackSlice vertexIds,
+                                         std::vector<LookupInfo> const& list) {
+  auto allCursor = std::make_unique<SingleServerEdgeCursor>(this, list.size());
+  auto& opCursors = allCursor->getCursors();
+  for (auto& info : list) {
+    if (!info.conditionNeedUpdate || info.indexCondition->numMembers() != 1) {
+      return nullptr;
+    }
+    opCursors.emplace_back();
+    auto& csrs = opCursors.back();
+    csrs.reserve(info.idxHandles.size());
+    for (auto const& it : info.idxHandles) {
+      std::unique_ptr<IndexIterator> iterator(it.getIndex()->iteratorForVertices(_trx, vertexIds));
+      if (iterator == nullptr) {
+        return nullptr;
+      }
+      // the emplace_back cannot throw here, as we reserved enough space before
+      csrs.emplace_back(new OperationCursor(std::move(iterator)));
+    }
+  }
+  return allCursor.release();
+}
+
 TraverserCache* BaseOptions::cache() {
   if (_cache == nullptr) {
     // If the Coordinator does NOT activate the Cache
@@ -26,6 +26,7 @@
 
 #include "Aql/FixedVarExpressionContext.h"
 #include "Basics/Common.h"
+#include "Basics/StaticStrings.h"
 #include "Cluster/ClusterInfo.h"
 #include "Cluster/ServerState.h"
 #include "Cluster/TraverserEngineRegistry.h"
@@ -101,8 +102,11 @@ struct BaseOptions {
 
   void setVariable(aql::Variable const*);
 
+  /// @brief adds the lookup of the edges of a collection. if sortAttribute
+  /// is set, the lookup uses a sorted index on [attributeName, sortAttribute]
   void addLookupInfo(aql::ExecutionPlan* plan, std::string const& collectionName,
-                     std::string const& attributeName, aql::AstNode* condition);
+                     std::string const& attributeName, aql::AstNode* condition,
+                     std::string const& sortAttribute = StaticStrings::Empty);
 
   void clearVariableValues();
 
@@ -150,9 +154,20 @@ struct BaseOptions {
 
   void injectLookupInfoInList(std::vector<LookupInfo>&, aql::ExecutionPlan* plan,
                               std::string const& collectionName,
-                              std::string const& attributeName, aql::AstNode* condition);
+                              std::string const& attributeName, aql::AstNode* condition,
+                              std::string const& sortAttribute);
 
+  /// @brief a cursor over the edges of the vertex. sorted indexes return
+  /// them in descending order if descending is set
   EdgeCursor* nextCursorLocal(arangodb::velocypack::StringRef vid,
+                              std::vector<LookupInfo> const&, bool descending = false);
+
+  /// @brief a cursor over the edges of all of the vertex ids in the array,
+  /// which reports the vertex on the other side of each edge, but not the
+  /// vertex the edge belongs to. returns nullptr if the lookups cannot be
+  /// combined, because a condition restricts more than the vertex or an
+  /// index does not support it
+  EdgeCursor* nextCursorLocal(arangodb::velocypack::Slice vertexIds,
                               std::vector<LookupInfo> const&);
 
   void injectTestCache(std::unique_ptr<TraverserCache>&& cache);
@@ -124,7 +124,7 @@ bool BreadthFirstEnumerator::next() {
         if (_opts->hasEdgeFilter(_currentDepth, cursorIdx)) {
           VPackSlice edge = e;
           if (edge.isString()) {
-            edge = _opts->cache()->lookupToken(eid);
+            edge = _opts->edgeForCondition(eid, edge, nextVertex, _currentDepth, cursorIdx);
           }
           if (!_traverser->edgeMatchesConditions(edge, nextVertex, _currentDepth, cursorIdx)) {
             return;
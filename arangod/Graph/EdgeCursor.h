@@ -53,6 +53,11 @@ class EdgeCursor {
   virtual void readAll(std::function<void(EdgeDocumentToken&&, arangodb::velocypack::Slice, size_t)> const& callback) = 0;
 
   virtual size_t httpRequests() const = 0;
+
+  /// @brief whether readAll may run on another thread, concurrently with
+  /// readAll of other cursors of the same transaction. the cursor must still
+  /// be created and destroyed on the thread of the transaction
+  virtual bool supportsConcurrentReads() const { return false; }
 };
 
 }  // namespace graph
@@ -35,6 +35,8 @@
 #include "VocBase/LogicalCollection.h"
 
 #include <velocypack/Iterator.h>
+
+#include <algorithm>
 #include <velocypack/Slice.h>
 #include <velocypack/StringRef.h>
 #include <velocypack/velocypack-aliases.h>
@@ -56,6 +58,8 @@ bool KShortestPathsFinder::startKShortestPathsTraversal(
 
   _pathAvailable = true;
   _shortestPaths.clear();
+  _pathTree.clear();
+  _pathTree.emplace_back();
   _candidatePaths.clear();
 
 
@@ -69,26 +73,35 @@ bool KShortestPathsFinder::startKShortestPathsTraversal(
 bool KShortestPathsFinder::computeShortestPath(VertexRef const& start, VertexRef const& end,
                                                std::unordered_set<VertexRef> const& forbiddenVertices,
                                                std::unordered_set<Edge> const& forbiddenEdges,
-                                               Path& result) {
+                                               double maxWeight, Path& result) {
   bool found = false;
-  Ball left(start, FORWARD);
-  Ball right(end, BACKWARD);
+  _left.reset(start, FORWARD);
+  _right.reset(end, BACKWARD);
   VertexRef join;
 
   result.clear();
 
-  while (!left._frontier.empty() && !right._frontier.empty() && !found) {
+  while (!_left._frontier.empty() && !_right._frontier.empty() && !found) {
     _options.isQueryKilledCallback();
 
+    // A vertex heavier than maxWeight cannot be on a path that is light
+    // enough, so a frontier beyond it is not expanded anymore
+    bool leftOpen = _left._frontier.getMinimal()->_weight <= maxWeight;
+    bool rightOpen = _right._frontier.getMinimal()->_weight <= maxWeight;
+    if (!leftOpen && !rightOpen) {
+      break;
+    }
+
     // Choose the smaller frontier to expand.
-    if (left._frontier.size() < right._frontier.size()) {
-      found = advanceFrontier(left, right, forbiddenVertices, forbiddenEdges, join);
+    if (leftOpen && (!rightOpen || _left._frontier.size() < _right._frontier.size())) {
+      found = advanceFrontier(_left, _right, forbiddenVertices, forbiddenEdges, join);
     } else {
-      found = advanceFrontier(right, left, forbiddenVertices, forbiddenEdges, join);
+      found = advanceFrontier(_right, _left, forbiddenVertices, forbiddenEdges, join);
     }
   }
   if (found) {
-    reconstructPath(left, right, join, result);
+    reconstructPath(_left, _right, join, result);
+    found = result._weight <= maxWeight;
   }
   return found;
 }
@@ -265,60 +278,84 @@ void KShortestPathsFinder::reconstructPath(Ball const& left, Ball const& right,
 bool KShortestPathsFinder::computeNextShortestPath(Path& result) {
   std::unordered_set<VertexRef> forbiddenVertices;
   std::unordered_set<Edge> forbiddenEdges;
-  Path tmpPath, candidate;
+  Path tmpPath;
   TRI_ASSERT(!_shortestPaths.empty());
+  size_t const last = _shortestPaths.size() - 1;
   auto& lastShortestPath = _shortestPaths.back();
-  bool available = false;
-
-  for (size_t i = lastShortestPath._branchpoint; i + 1 < lastShortestPath.length(); ++i) {
-    auto& spur = lastShortestPath._vertices.at(i);
 
-    forbiddenVertices.clear();
-    forbiddenEdges.clear();
+  // Must not use vertices on the prefix, it grows with the spur vertex
+  for (size_t j = 0; j < lastShortestPath._branchpoint; ++j) {
+    forbiddenVertices.emplace(lastShortestPath._vertices[j]);
+  }
 
-    // Must not use vertices on the prefix
-    for (size_t j = 0; j < i; ++j) {
-      forbiddenVertices.emplace(lastShortestPath._vertices[j]);
-    }
+  size_t node = 0;
+  for (size_t i = 0; i + 1 < lastShortestPath.length(); ++i) {
+    if (i >= lastShortestPath._branchpoint) {
+      auto& spur = lastShortestPath._vertices.at(i);
 
-    // TODO: This can be done more efficiently by storing shortest
-    //       paths in a prefix/postfix tree
-    // previous paths with same prefix must not be
-    for (auto const& p : _shortestPaths) {
-      bool eq = true;
-      for (size_t e = 0; e < i; ++e) {
-        if (!p._edges.at(e).equals(lastShortestPath._edges.at(e))) {
-          eq = false;
-          break;
-        }
+      // previous paths with same prefix must not be found again
+      forbiddenEdges.clear();
+      for (auto const& child : _pathTree[node]._children) {
+        forbiddenEdges.emplace(child.first);
       }
-      if (eq && (i < p._edges.size())) {
-        forbiddenEdges.emplace(p._edges.at(i));
+
+      double prefixWeight = lastShortestPath._weights.at(i);
+      if (computeShortestPath(spur, _end, forbiddenVertices, forbiddenEdges,
+                              _options.maxWeight - prefixWeight, tmpPath)) {
+        tmpPath._branchpoint = i;
+        double weight = prefixWeight + tmpPath._weight;
+        _candidatePaths.emplace_back(last, std::move(tmpPath), weight);
+        std::push_heap(_candidatePaths.begin(), _candidatePaths.end(), CandidateGreater());
       }
+      forbiddenVertices.emplace(spur);
     }
 
-    if (computeShortestPath(spur, _end, forbiddenVertices, forbiddenEdges, tmpPath)) {
-      candidate.clear();
-      candidate.append(lastShortestPath, 0, i);
-      candidate.append(tmpPath, 0, tmpPath.length() - 1);
-      candidate._branchpoint = i;
+    // follow the last path down the tree
+    auto const& children = _pathTree[node]._children;
+    auto child = std::find_if(children.begin(), children.end(), [&](auto const& c) {
+      return c.first.equals(lastShortestPath._edges.at(i));
+    });
+    TRI_ASSERT(child != children.end());
+    node = child->second;
+  }
 
-      auto it = find_if(_candidatePaths.begin(), _candidatePaths.end(), [candidate](Path const& v) { return v._weight >= candidate._weight; } );
-      if (!(*it == candidate)) {
-        _candidatePaths.emplace(it, candidate);
-      }
+  while (!_candidatePaths.empty()) {
+    std::pop_heap(_candidatePaths.begin(), _candidatePaths.end(), CandidateGreater());
+    Candidate candidate = std::move(_candidatePaths.back());
+    _candidatePaths.pop_back();
+
+    size_t branchpoint = candidate._spur._branchpoint;
+    result.clear();
+    result.append(_shortestPaths[candidate._parent], 0, branchpoint);
+    result.append(candidate._spur, 0, candidate._spur.length() - 1);
+    result._branchpoint = branchpoint;
+
+    // spur paths of different parents can turn out to be the same path
+    bool duplicate = std::any_of(_shortestPaths.begin(), _shortestPaths.end(),
+                                 [&result](Path const& p) { return p == result; });
+    if (!duplicate) {
+      return true;
     }
   }
+  return false;
+}
 
-  if (!_candidatePaths.empty()) {
-    auto const& p = _candidatePaths.front();
-    result.clear();
-    result.append(p, 0, p.length() - 1);
-    result._branchpoint = p._branchpoint;
-    _candidatePaths.pop_front();
-    available = true;
+void KShortestPathsFinder::addShortestPath(Path const& path) {
+  _shortestPaths.emplace_back(path);
+
+  size_t node = 0;
+  for (auto const& edge : path._edges) {
+    auto& children = _pathTree[node]._children;
+    auto child = std::find_if(children.begin(), children.end(),
+                              [&edge](auto const& c) { return c.first.equals(edge); });
+    if (child != children.end()) {
+      node = child->second;
+    } else {
+      node = _pathTree.size();
+      children.emplace_back(edge, node);
+      _pathTree.emplace_back();
+    }
   }
-  return available;
 }
 
 bool KShortestPathsFinder::getNextPath(Path& result) {
@@ -333,7 +370,7 @@ bool KShortestPathsFinder::getNextPath(Path& result) {
       result._weight = 0;
       available = true;
     } else {
-      available = computeShortestPath(_start, _end, {}, {}, result);
+      available = computeShortestPath(_start, _end, {}, {}, _options.maxWeight, result);
       result._branchpoint = 0;
     }
   } else {
@@ -345,7 +382,7 @@ bool KShortestPathsFinder::getNextPath(Path& result) {
   }
 
   if (available) {
-    _shortestPaths.emplace_back(result);
+    addShortestPath(result);
     _options.fetchVerticesCoordinator(result._vertices);
 
     TRI_IF_FAILURE("TraversalOOMPath") {
@@ -32,7 +32,7 @@
 
 #include <velocypack/StringRef.h>
 
-#include <list>
+#include <vector>
 
 namespace arangodb {
 
@@ -160,6 +160,41 @@ class KShortestPathsFinder : public ShortestPathFinder {
       _frontier.insert(centre, std::make_unique<DijkstraInfo>(centre));
     }
     ~Ball() {}
+
+    // start a new search, reusing the memory of the previous one
+    void reset(VertexRef const& centre, Direction direction) {
+      _centre = centre;
+      _direction = direction;
+      _frontier.clear();
+      _frontier.insert(centre, std::make_unique<DijkstraInfo>(centre));
+    }
+  };
+
+  // A candidate for the next shortest path: the edges of the path
+  // _shortestPaths[_parent] up to the branch point, followed by
+  // a spur path to the end. The prefix is shared with the parent and
+  // only copied once the candidate is chosen
+  struct Candidate {
+    size_t _parent;
+    Path _spur;
+    double _weight;
+
+    Candidate(size_t parent, Path&& spur, double weight)
+        : _parent(parent), _spur(std::move(spur)), _weight(weight) {}
+  };
+
+  // orders the candidate heap by weight, lowest first
+  struct CandidateGreater {
+    bool operator()(Candidate const& lhs, Candidate const& rhs) const {
+      return lhs._weight > rhs._weight;
+    }
+  };
+
+  // The shortest paths found so far as a prefix tree of their edges. A
+  // spur path branching off at a node must not use the edges to any of
+  // its children, or else it would find one of these paths again
+  struct PathTreeNode {
+    std::vector<std::pair<Edge, size_t>> _children;
   };
 
   //
@@ -228,12 +263,16 @@ class KShortestPathsFinder : public ShortestPathFinder {
   bool isPathAvailable(void) { return _pathAvailable; }
 
  private:
-  // Compute the first shortest path
+  // Compute the first shortest path, unless it is heavier than maxWeight
   bool computeShortestPath(VertexRef const& start, VertexRef const& end,
                            std::unordered_set<VertexRef> const& forbiddenVertices,
-                           std::unordered_set<Edge> const& forbiddenEdges, Path& result);
+                           std::unordered_set<Edge> const& forbiddenEdges,
+                           double maxWeight, Path& result);
   bool computeNextShortestPath(Path& result);
 
+  // add a path to _shortestPaths and _pathTree
+  void addShortestPath(Path const& path);
+
   void reconstructPath(Ball const& left, Ball const& right,
                        VertexRef const& join, Path& result);
 
@@ -258,8 +297,14 @@ class KShortestPathsFinder : public ShortestPathFinder {
   FoundVertexCache _vertexCache;
 
   std::vector<Path> _shortestPaths;
+  std::vector<PathTreeNode> _pathTree;
+
+  // a heap ordered by CandidateGreater
+  std::vector<Candidate> _candidatePaths;
 
-  std::list<Path> _candidatePaths;
+  // the searches of all spur paths use these
+  Ball _left;
+  Ball _right;
 };
 
 }  // namespace graph
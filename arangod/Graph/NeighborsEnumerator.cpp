@@ -24,38 +24,154 @@
 #include "NeighborsEnumerator.h"
 
 #include "Aql/PruneExpressionEvaluator.h"
+#include "Basics/ScopeGuard.h"
 #include "Basics/VelocyPackHelper.h"
+#include "Cluster/ServerState.h"
 #include "Graph/EdgeCursor.h"
 #include "Graph/Traverser.h"
 #include "Graph/TraverserCache.h"
 #include "Graph/TraverserOptions.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
 
 using namespace arangodb;
 using namespace arangodb::graph;
 using namespace arangodb::traverser;
 
+namespace {
+/// @brief a depth needs at least this many vertices to be expanded in parallel
+constexpr size_t ParallelMinVertices = 1024;
+
+/// @brief number of vertices whose edges are looked up together
+constexpr size_t BatchSize = 128;
+
+/// @brief number of batches per thread in a round
+constexpr size_t BatchesPerThread = 4;
+
+/// @brief number of vertices whose edges or documents a coordinator fetches
+/// with one request per DBServer
+constexpr size_t ClusterBatchSize = 1000;
+
+/// @brief the vertex on the other side of an edge of vertex. the edge is
+/// either the id of that vertex or an edge document
+VPackSlice otherVertex(VPackSlice edge, arangodb::velocypack::StringRef vertex) {
+  if (edge.isString()) {
+    return edge;
+  }
+  TRI_ASSERT(edge.isObject());
+  VPackSlice tmp = transaction::helpers::extractFromFromDocument(edge);
+  if (tmp.compareString(vertex.data(), vertex.length()) == 0) {
+    tmp = transaction::helpers::extractToFromDocument(edge);
+  }
+  TRI_ASSERT(tmp.isString());
+  return tmp;
+}
+
+/// @brief the cursors of consecutive vertices of a depth, and the vertices
+/// on the other side of their edges, an array per cursor. a combined batch
+/// has a single cursor for all of its vertices
+struct NeighborsBatch {
+  std::vector<std::unique_ptr<EdgeCursor>> cursors;
+  bool combined = false;
+  VPackBuilder neighbors;
+
+  void read() {
+    neighbors.openArray();
+    for (auto& cursor : cursors) {
+      neighbors.openArray();
+      if (cursor != nullptr) {
+        cursor->readAll([this](EdgeDocumentToken&&, VPackSlice other, size_t) {
+          neighbors.add(other);
+        });
+      }
+      neighbors.close();
+    }
+    neighbors.close();
+  }
+};
+
+/// @brief the batches of a part of a depth. they are claimed by the
+/// traversal itself and by the tasks on the scheduler, so the traversal
+/// makes progress even if none of the tasks gets to run. a task that runs
+/// after all batches are claimed only touches the counter
+class NeighborsRound {
+ public:
+  explicit NeighborsRound(size_t count) : batches(count), _count(count), _next(0), _done(0) {}
+
+  std::vector<NeighborsBatch> batches;
+
+  void work() {
+    while (true) {
+      size_t i = _next.fetch_add(1);
+      if (i >= _count) {
+        return;
+      }
+      std::exception_ptr error;
+      try {
+        batches[i].read();
+      } catch (...) {
+        error = std::current_exception();
+      }
+      std::lock_guard<std::mutex> guard(_mutex);
+      if (error != nullptr && _error == nullptr) {
+        _error = error;
+      }
+      if (++_done == _count) {
+        _condition.notify_all();
+      }
+    }
+  }
+
+  /// @brief waits for the claimed batches, rethrows the first error
+  void wait() {
+    std::unique_lock<std::mutex> guard(_mutex);
+    _condition.wait(guard, [this]() { return _done == _count; });
+    if (_error != nullptr) {
+      std::rethrow_exception(_error);
+    }
+  }
+
+ private:
+  size_t const _count;
+  std::atomic<size_t> _next;
+  std::mutex _mutex;
+  std::condition_variable _condition;
+  size_t _done;
+  std::exception_ptr _error;
+};
+}  // namespace
+
 NeighborsEnumerator::NeighborsEnumerator(Traverser* traverser, VPackSlice const& startVertex,
                                          TraverserOptions* opts)
-    : PathEnumerator(traverser, startVertex.copyString(), opts), _searchDepth(0) {
-  arangodb::velocypack::StringRef vId = _traverser->traverserCache()->persistString(
-      arangodb::velocypack::StringRef(startVertex));
+    : PathEnumerator(traverser, startVertex.copyString(), opts),
+      _position(0),
+      _hasPruned(false),
+      _searchDepth(0) {
+  InternedId vId = _opts->cache()->internString(arangodb::velocypack::StringRef(startVertex));
   _allFound.insert(vId);
-  _currentDepth.insert(vId);
-  _iterator = _currentDepth.begin();
+  _currentDepth.emplace_back(vId);
 }
 
 bool NeighborsEnumerator::next() {
   if (_isFirst) {
     _isFirst = false;
-    if (shouldPrune(*_iterator)) {
-      _toPrune.emplace(*_iterator);
+    if (shouldPrune(_currentDepth[_position])) {
+      _toPrune.insert(_currentDepth[_position]);
+      _hasPruned = true;
     }
     if (_opts->minDepth == 0) {
       return true;
     }
   }
 
-  if (_iterator == _currentDepth.end() || ++_iterator == _currentDepth.end()) {
+  if (_position >= _currentDepth.size() || ++_position >= _currentDepth.size()) {
     do {
       // This depth is done. Get next
       if (_opts->maxDepth == _searchDepth) {
@@ -64,52 +180,33 @@ bool NeighborsEnumerator::next() {
       }
 
       swapLastAndCurrentDepth();
-      for (auto const& nextVertex : _lastDepth) {
-        auto callback = [&](EdgeDocumentToken&& eid, VPackSlice other, size_t cursorId) {
-          if (_opts->hasEdgeFilter(_searchDepth, cursorId)) {
-            // execute edge filter
-            VPackSlice edge = other;
-            if (edge.isString()) {
-              edge = _opts->cache()->lookupToken(eid);
-            }
-            if (!_traverser->edgeMatchesConditions(edge, nextVertex, _searchDepth, cursorId)) {
-              // edge does not qualify
-              return;
-            }
-          }
-
-          // Counting should be done in readAll
-          arangodb::velocypack::StringRef v;
-          if (other.isString()) {
-            v = _opts->cache()->persistString(arangodb::velocypack::StringRef(other));
-          } else {
-            TRI_ASSERT(other.isObject());
-            VPackSlice tmp = transaction::helpers::extractFromFromDocument(other);
-            if (tmp.compareString(nextVertex.data(), nextVertex.length()) == 0) {
-              tmp = transaction::helpers::extractToFromDocument(other);
-            }
-            TRI_ASSERT(tmp.isString());
-            v = _opts->cache()->persistString(arangodb::velocypack::StringRef(tmp));
-          }
-
-          if (_allFound.find(v) == _allFound.end()) {
-            if (_traverser->vertexMatchesConditions(v, _searchDepth + 1)) {
-              _allFound.emplace(v);
-              if (shouldPrune(v)) {
-                _toPrune.emplace(v);
+      if (!expandInBatches()) {
+        for (InternedId nextId : _lastDepth) {
+          arangodb::velocypack::StringRef nextVertex =
+              _opts->cache()->internedString(nextId);
+          auto callback = [&](EdgeDocumentToken&& eid, VPackSlice other, size_t cursorId) {
+            if (_opts->hasEdgeFilter(_searchDepth, cursorId)) {
+              // execute edge filter
+              VPackSlice edge = other;
+              if (edge.isString()) {
+                edge = _opts->edgeForCondition(eid, edge, nextVertex, _searchDepth, cursorId);
+              }
+              if (!_traverser->edgeMatchesConditions(edge, nextVertex, _searchDepth, cursorId)) {
+                // edge does not qualify
+                return;
               }
-              _currentDepth.emplace(v);
             }
-          } else {
-            _opts->cache()->increaseFilterCounter();
-          }
-        };
+            // Counting should be done in readAll
+            addNeighbor(_opts->cache()->internString(
+                arangodb::velocypack::StringRef(::otherVertex(other, nextVertex))));
+          };
 
-        std::unique_ptr<arangodb::graph::EdgeCursor> cursor(
-            _opts->nextCursor(nextVertex, _searchDepth));
-        if (cursor != nullptr) {
-          incHttpRequests(cursor->httpRequests());
-          cursor->readAll(callback);
+          std::unique_ptr<arangodb::graph::EdgeCursor> cursor(
+              _opts->nextCursor(nextVertex, _searchDepth));
+          if (cursor != nullptr) {
+            incHttpRequests(cursor->httpRequests());
+            cursor->readAll(callback);
+          }
         }
       }
       if (_currentDepth.empty()) {
@@ -118,15 +215,25 @@ bool NeighborsEnumerator::next() {
       }
       ++_searchDepth;
     } while (_searchDepth < _opts->minDepth);
-    _iterator = _currentDepth.begin();
+    _position = 0;
   }
-  TRI_ASSERT(_iterator != _currentDepth.end());
+  TRI_ASSERT(_position < _currentDepth.size());
   return true;
 }
 
 arangodb::aql::AqlValue NeighborsEnumerator::lastVertexToAqlValue() {
-  TRI_ASSERT(_iterator != _currentDepth.end());
-  return _traverser->fetchVertexData(*_iterator);
+  TRI_ASSERT(_position < _currentDepth.size());
+  if (_position % ::ClusterBatchSize == 0) {
+    // a cluster traverser fetches the next vertices of the depth together
+    std::vector<arangodb::velocypack::StringRef> ids;
+    size_t const end = (std::min)(_currentDepth.size(), _position + ::ClusterBatchSize);
+    ids.reserve(end - _position);
+    for (size_t i = _position; i < end; ++i) {
+      ids.emplace_back(_opts->cache()->internedString(_currentDepth[i]));
+    }
+    _traverser->prefetchVertices(ids);
+  }
+  return _traverser->fetchVertexData(_opts->cache()->internedString(_currentDepth[_position]));
 }
 
 arangodb::aql::AqlValue NeighborsEnumerator::lastEdgeToAqlValue() {
@@ -145,22 +252,163 @@ arangodb::aql::AqlValue NeighborsEnumerator::pathToAqlValue(arangodb::velocypack
 
 void NeighborsEnumerator::swapLastAndCurrentDepth() {
   // Filter all in _toPrune
-  if (!_toPrune.empty()) {
-    for (auto const& it : _toPrune) {
-      _currentDepth.erase(it);
-    }
+  if (_hasPruned) {
+    _currentDepth.erase(std::remove_if(_currentDepth.begin(), _currentDepth.end(),
+                                       [this](InternedId v) { return _toPrune.contains(v); }),
+                        _currentDepth.end());
     _toPrune.clear();
+    _hasPruned = false;
   }
   _lastDepth.swap(_currentDepth);
   _currentDepth.clear();
 }
 
-bool NeighborsEnumerator::shouldPrune(arangodb::velocypack::StringRef v) {
+void NeighborsEnumerator::addNeighbor(InternedId v) {
+  if (!_allFound.contains(v)) {
+    if (_traverser->vertexMatchesConditions(_opts->cache()->internedString(v),
+                                            _searchDepth + 1)) {
+      _allFound.insert(v);
+      if (shouldPrune(v)) {
+        _toPrune.insert(v);
+        _hasPruned = true;
+      }
+      _currentDepth.emplace_back(v);
+    }
+  } else {
+    _opts->cache()->increaseFilterCounter();
+  }
+}
+
+bool NeighborsEnumerator::expandInBatches() {
+  // batched lookups do not report the vertex an edge belongs to, edge
+  // filters need it. on a coordinator the DBServers apply the edge filters
+  if (_opts->hasEdgeFilter(static_cast<int64_t>(_searchDepth))) {
+    return false;
+  }
+
+  bool const isCoordinator = ServerState::instance()->isCoordinator();
+  auto scheduler = SchedulerFeature::SCHEDULER;
+  size_t const threads = (_opts->parallelism > 1 && scheduler != nullptr && !isCoordinator &&
+                          _lastDepth.size() >= ::ParallelMinVertices)
+                             ? _opts->parallelism
+                             : 1;
+  size_t const batchSize = isCoordinator ? ::ClusterBatchSize : ::BatchSize;
+  size_t const roundSize = threads * ::BatchesPerThread * batchSize;
+  // vertex data is fetched together for the filters and PRUNE
+  bool const prefetch = _opts->vertexHasFilter(_searchDepth + 1) || _opts->usesPrune();
+  VPackBuilder ids;
+  std::vector<InternedId> found;
+  std::vector<arangodb::velocypack::StringRef> toFetch;
+  std::unordered_set<arangodb::velocypack::StringRef> sources;
+  for (size_t position = 0; position < _lastDepth.size(); position += roundSize) {
+    size_t const end = (std::min)(_lastDepth.size(), position + roundSize);
+    auto round = std::make_shared<NeighborsRound>((end - position + batchSize - 1) / batchSize);
+    // the cursors must be destroyed by the thread of the transaction
+    auto guard = scopeGuard([&round]() { round->batches.clear(); });
+
+    // the cursors are created here, they modify the lookup conditions
+    bool concurrent = threads > 1;
+    for (size_t b = 0; b < round->batches.size(); ++b) {
+      NeighborsBatch& batch = round->batches[b];
+      size_t const first = position + b * batchSize;
+      size_t const last = (std::min)(end, first + batchSize);
+
+      ids.clear();
+      ids.openArray();
+      for (size_t i = first; i < last; ++i) {
+        arangodb::velocypack::StringRef vertex = _opts->cache()->internedString(_lastDepth[i]);
+        ids.add(VPackValuePair(vertex.data(), vertex.size(), VPackValueType::String));
+      }
+      ids.close();
+
+      std::unique_ptr<EdgeCursor> cursor(_opts->nextCursor(ids.slice(), _searchDepth));
+      batch.combined = cursor != nullptr;
+      if (batch.combined) {
+        batch.cursors.emplace_back(std::move(cursor));
+      } else {
+        for (size_t i = first; i < last; ++i) {
+          batch.cursors.emplace_back(
+              _opts->nextCursor(_opts->cache()->internedString(_lastDepth[i]), _searchDepth));
+        }
+      }
+      for (auto const& c : batch.cursors) {
+        if (c != nullptr && !c->supportsConcurrentReads()) {
+          concurrent = false;
+        }
+      }
+    }
+
+    if (concurrent) {
+      size_t tasks = (std::min)(threads, round->batches.size());
+      for (size_t i = 1; i < tasks; ++i) {
+        if (!scheduler->queue(RequestLane::CLIENT_AQL, [round]() { round->work(); })) {
+          break;
+        }
+      }
+    }
+    round->work();
+    round->wait();
+
+    // in the order of the depth, so the result does not depend on the tasks
+    size_t first = position;
+    for (auto& batch : round->batches) {
+      size_t const last = (std::min)(end, first + batchSize);
+      found.clear();
+      sources.clear();
+      size_t j = 0;
+      for (VPackSlice neighbors : VPackArrayIterator(batch.neighbors.slice())) {
+        if (batch.cursors[j] != nullptr) {
+          incHttpRequests(batch.cursors[j]->httpRequests());
+        }
+        for (VPackSlice edge : VPackArrayIterator(neighbors)) {
+          VPackSlice other;
+          if (!batch.combined) {
+            other = ::otherVertex(edge, _opts->cache()->internedString(_lastDepth[first + j]));
+          } else if (edge.isString()) {
+            other = edge;
+          } else {
+            // the edge belongs to the vertex of the batch on one of its sides
+            if (sources.empty()) {
+              for (size_t i = first; i < last; ++i) {
+                sources.emplace(_opts->cache()->internedString(_lastDepth[i]));
+              }
+            }
+            other = transaction::helpers::extractFromFromDocument(edge);
+            if (sources.find(arangodb::velocypack::StringRef(other)) != sources.end()) {
+              other = transaction::helpers::extractToFromDocument(edge);
+            }
+          }
+          TRI_ASSERT(other.isString());
+          found.emplace_back(_opts->cache()->internString(arangodb::velocypack::StringRef(other)));
+        }
+        ++j;
+      }
+
+      if (prefetch) {
+        toFetch.clear();
+        for (InternedId v : found) {
+          if (!_allFound.contains(v)) {
+            toFetch.emplace_back(_opts->cache()->internedString(v));
+          }
+        }
+        _traverser->prefetchVertices(toFetch);
+      }
+      for (InternedId v : found) {
+        addNeighbor(v);
+      }
+      first = last;
+    }
+  }
+  return true;
+}
+
+bool NeighborsEnumerator::shouldPrune(InternedId v) {
   // Prune here
   if (_opts->usesPrune()) {
     auto* evaluator = _opts->getPruneEvaluator();
     if (evaluator->needsVertex()) {
-      evaluator->injectVertex(_traverser->fetchVertexData(v).slice());
+      evaluator->injectVertex(
+          _traverser->fetchVertexData(_opts->cache()->internedString(v)).slice());
     }
     // We cannot support these two here
     TRI_ASSERT(!evaluator->needsEdge());
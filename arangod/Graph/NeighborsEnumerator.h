@@ -26,6 +26,7 @@
 
 #include "Basics/Common.h"
 #include "Graph/PathEnumerator.h"
+#include "Graph/TraverserCache.h"
 
 #include <velocypack/Slice.h>
 
@@ -34,11 +35,13 @@ namespace graph {
 // @brief Enumerator optimized for neighbors. Does not allow edge access
 
 class NeighborsEnumerator final : public arangodb::traverser::PathEnumerator {
-  std::unordered_set<arangodb::velocypack::StringRef> _allFound;
-  std::unordered_set<arangodb::velocypack::StringRef> _currentDepth;
-  std::unordered_set<arangodb::velocypack::StringRef> _lastDepth;
-  std::unordered_set<arangodb::velocypack::StringRef>::iterator _iterator;
-  std::unordered_set<arangodb::velocypack::StringRef> _toPrune;
+  // vertices are identified by their interned id in the TraverserCache
+  InternedIdSet _allFound;
+  std::vector<InternedId> _currentDepth;
+  std::vector<InternedId> _lastDepth;
+  size_t _position;  // in _currentDepth
+  InternedIdSet _toPrune;
+  bool _hasPruned;
 
   uint64_t _searchDepth;
 
@@ -70,7 +73,16 @@ class NeighborsEnumerator final : public arangodb::traverser::PathEnumerator {
  private:
   void swapLastAndCurrentDepth();
 
-  bool shouldPrune(arangodb::velocypack::StringRef v);
+  bool shouldPrune(InternedId v);
+
+  /// @brief adds a vertex found on the current depth to the next depth,
+  /// unless it was found before or does not match the vertex filter
+  void addNeighbor(InternedId v);
+
+  /// @brief looks up the edges of _lastDepth in batches of vertices, on
+  /// parallelism threads for large depths. returns false if the edges have
+  /// to be looked up one vertex at a time
+  bool expandInBatches();
 };
 
 }  // namespace graph
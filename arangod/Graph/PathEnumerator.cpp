@@ -95,7 +95,9 @@ bool DepthFirstEnumerator::next() {
       if (_opts->hasEdgeFilter(_enumeratedPath.edges.size(), cursorId)) {
         VPackSlice e = edge;
         if (edge.isString()) {
-          e = _opts->cache()->lookupToken(eid);
+          e = _opts->edgeForCondition(eid, edge,
+                                      arangodb::velocypack::StringRef(_enumeratedPath.vertices.back()),
+                                      _enumeratedPath.edges.size(), cursorId);
         }
         if (!_traverser->edgeMatchesConditions(
                 e, arangodb::velocypack::StringRef(_enumeratedPath.vertices.back()),
@@ -34,6 +34,9 @@
 #include <velocypack/Iterator.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include <cmath>
+#include <limits>
+
 using namespace arangodb;
 using namespace arangodb::basics;
 using namespace arangodb::graph;
@@ -44,6 +47,8 @@ ShortestPathOptions::ShortestPathOptions(aql::Query* query)
       direction("outbound"),
       weightAttribute(""),
       defaultWeight(1),
+      heuristicFactor(1),
+      maxWeight(std::numeric_limits<double>::infinity()),
       bidirectional(true),
       multiThreaded(true) {}
 
@@ -52,6 +57,8 @@ ShortestPathOptions::ShortestPathOptions(aql::Query* query, VPackSlice const& in
       direction("outbound"),
       weightAttribute(""),
       defaultWeight(1),
+      heuristicFactor(1),
+      maxWeight(std::numeric_limits<double>::infinity()),
       bidirectional(true),
       multiThreaded(true) {
   TRI_ASSERT(info.isObject());
@@ -64,6 +71,12 @@ ShortestPathOptions::ShortestPathOptions(aql::Query* query, VPackSlice const& in
       VelocyPackHelper::getStringValue(info, "weightAttribute", "");
   defaultWeight =
       VelocyPackHelper::getNumericValue<double>(info, "defaultWeight", 1);
+  heuristicAttribute =
+      VelocyPackHelper::getStringValue(info, "heuristicAttribute", "");
+  heuristicFactor =
+      VelocyPackHelper::getNumericValue<double>(info, "heuristicFactor", 1);
+  maxWeight = VelocyPackHelper::getNumericValue<double>(
+      info, "maxWeight", std::numeric_limits<double>::infinity());
 }
 
 ShortestPathOptions::ShortestPathOptions(aql::Query* query, VPackSlice info, VPackSlice collections)
@@ -71,6 +84,8 @@ ShortestPathOptions::ShortestPathOptions(aql::Query* query, VPackSlice info, VPa
       direction("outbound"),
       weightAttribute(""),
       defaultWeight(1),
+      heuristicFactor(1),
+      maxWeight(std::numeric_limits<double>::infinity()),
       bidirectional(true),
       multiThreaded(true) {
   TRI_ASSERT(info.isObject());
@@ -83,6 +98,12 @@ ShortestPathOptions::ShortestPathOptions(aql::Query* query, VPackSlice info, VPa
       VelocyPackHelper::getStringValue(info, "weightAttribute", "");
   defaultWeight =
       VelocyPackHelper::getNumericValue<double>(info, "defaultWeight", 1);
+  heuristicAttribute =
+      VelocyPackHelper::getStringValue(info, "heuristicAttribute", "");
+  heuristicFactor =
+      VelocyPackHelper::getNumericValue<double>(info, "heuristicFactor", 1);
+  maxWeight = VelocyPackHelper::getNumericValue<double>(
+      info, "maxWeight", std::numeric_limits<double>::infinity());
 
   VPackSlice read = info.get("reverseLookupInfos");
   if (!read.isArray()) {
@@ -136,10 +157,19 @@ VPackSlice ShortestPathOptions::getEnd() const { return endBuilder.slice(); }
 
 bool ShortestPathOptions::useWeight() const { return !weightAttribute.empty(); }
 
+bool ShortestPathOptions::useHeuristic() const {
+  return useWeight() && !heuristicAttribute.empty();
+}
+
 void ShortestPathOptions::toVelocyPack(VPackBuilder& builder) const {
   VPackObjectBuilder guard(&builder);
   builder.add("weightAttribute", VPackValue(weightAttribute));
   builder.add("defaultWeight", VPackValue(defaultWeight));
+  builder.add("heuristicAttribute", VPackValue(heuristicAttribute));
+  builder.add("heuristicFactor", VPackValue(heuristicFactor));
+  if (std::isfinite(maxWeight)) {
+    builder.add("maxWeight", VPackValue(maxWeight));
+  }
   builder.add("type", VPackValue("shortestPath"));
 }
 
@@ -170,7 +200,8 @@ void ShortestPathOptions::addReverseLookupInfo(aql::ExecutionPlan* plan,
                                                std::string const& collectionName,
                                                std::string const& attributeName,
                                                aql::AstNode* condition) {
-  injectLookupInfoInList(_reverseLookupInfos, plan, collectionName, attributeName, condition);
+  injectLookupInfoInList(_reverseLookupInfos, plan, collectionName, attributeName,
+                         condition, StaticStrings::Empty);
 }
 
 double ShortestPathOptions::weightEdge(VPackSlice edge) const {
@@ -45,6 +45,16 @@ struct ShortestPathOptions : public BaseOptions {
   std::string direction;
   std::string weightAttribute;
   double defaultWeight;
+  // vertex attribute with the coordinates of a vertex, either as
+  // [longitude, latitude] or as a GeoJSON point. if set, the weighted
+  // search is directed towards the target (A*), using the great circle
+  // distance between two vertices times heuristicFactor as an estimate
+  // of the weight between them. the estimate must not exceed the actual
+  // weight, otherwise the returned path may not be the shortest one
+  std::string heuristicAttribute;
+  double heuristicFactor;
+  // K_SHORTEST_PATHS stops once the paths get heavier than this
+  double maxWeight;
   bool bidirectional;
   bool multiThreaded;
   std::string end;
@@ -73,6 +83,9 @@ struct ShortestPathOptions : public BaseOptions {
   /// @brief  Test if we have to use a weight attribute
   bool useWeight() const;
 
+  /// @brief Test if we have to estimate the remaining weight of a path
+  bool useHeuristic() const;
+
   /// @brief Build a velocypack for cloning in the plan.
   void toVelocyPack(arangodb::velocypack::Builder&) const override;
 
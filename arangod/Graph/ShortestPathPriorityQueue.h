@@ -82,6 +82,20 @@ class ShortestPathPriorityQueue {
 
   size_t size() { return _heap.size(); }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief clear, removes all keys and values but keeps the memory of the
+  /// lookup table, so that the queue can be reused for another search
+  //////////////////////////////////////////////////////////////////////////////
+
+  void clear() {
+    _lookup.clear();
+    _heap.clear();
+    _history.clear();
+    _popped = 0;
+    _isHeap = false;
+    _maxWeight = 0;
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief insert, data will be copied, returns true, if the key did not
   /// yet exist, and false, in which case nothing else is changed.
@@ -49,7 +49,9 @@ SingleServerEdgeCursor::SingleServerEdgeCursor(BaseOptions* opts, size_t nrCurso
       _currentCursor(0),
       _currentSubCursor(0),
       _cachePos(0),
-      _internalCursorMapping(mapping) {
+      _internalCursorMapping(mapping),
+      _limit(0),
+      _returned(0) {
   _cursors.reserve(nrCursors);
   _cache.reserve(1000);
   if (_opts->cache() == nullptr) {
@@ -97,21 +99,39 @@ void SingleServerEdgeCursor::getDocAndRunCallback(OperationCursor* cursor, EdgeC
         }
 #endif
         _opts->cache()->increaseCounter();
-        if (_internalCursorMapping != nullptr) {
-          TRI_ASSERT(_currentCursor < _internalCursorMapping->size());
-          callback(std::move(etkn), edgeDoc, _internalCursorMapping->at(_currentCursor));
-        } else {
-          callback(std::move(etkn), edgeDoc, _currentCursor);
-        }
+        runCallback(std::move(etkn), edgeDoc, callback);
       });
 }
 
+void SingleServerEdgeCursor::runCallback(EdgeDocumentToken&& token, VPackSlice edge,
+                                         EdgeCursor::Callback const& callback) {
+  size_t cursorId = _currentCursor;
+  if (_internalCursorMapping != nullptr) {
+    TRI_ASSERT(_currentCursor < _internalCursorMapping->size());
+    cursorId = _internalCursorMapping->at(_currentCursor);
+  }
+  if (_limit > 0) {
+    if (limitReached() || (_filter && !_filter(token, edge, cursorId))) {
+      return;
+    }
+    ++_returned;
+  }
+  callback(std::move(token), edge, cursorId);
+}
+
+void SingleServerEdgeCursor::setLimit(uint64_t limit, Filter&& filter) {
+  _limit = limit;
+  _filter = std::move(filter);
+}
+
 bool SingleServerEdgeCursor::advanceCursor(OperationCursor*& cursor,
                                            std::vector<OperationCursor*>& cursorSet) {
   ++_currentSubCursor;
-  if (_currentSubCursor >= cursorSet.size()) {
+  if (_currentSubCursor >= cursorSet.size() || limitReached()) {
+    // the sub cursors of a limited lookup share its limit
     ++_currentCursor;
     _currentSubCursor = 0;
+    _returned = 0;
     if (_currentCursor == _cursors.size()) {
       // We are done, all cursors exhausted.
       return false;
@@ -135,7 +155,7 @@ bool SingleServerEdgeCursor::next(EdgeCursor::Callback const& callback) {
   }
 
   // There is still something in the cache
-  if (_cachePos < _cache.size()) {
+  if (_cachePos < _cache.size() && !limitReached()) {
     // get the collection
     auto cur = _cursors[_currentCursor][_currentSubCursor];
     getDocAndRunCallback(cur, callback);
@@ -152,7 +172,7 @@ bool SingleServerEdgeCursor::next(EdgeCursor::Callback const& callback) {
   // NOTE: We cannot clear the cache,
   // because the cursor expect's it to be filled.
   do {
-    if (cursorSet.empty() || !cursor->hasMore()) {
+    if (cursorSet.empty() || !cursor->hasMore() || limitReached()) {
       if (!advanceCursor(cursor, cursorSet)) {
         return false;
       }
@@ -171,13 +191,7 @@ bool SingleServerEdgeCursor::next(EdgeCursor::Callback const& callback) {
               return;
             }
             operationSuccessful = true;
-            auto etkn = EdgeDocumentToken(cursor->collection()->id(), token);
-            if (_internalCursorMapping != nullptr) {
-              TRI_ASSERT(_currentCursor < _internalCursorMapping->size());
-              callback(std::move(etkn), edge, _internalCursorMapping->at(_currentCursor));
-            } else {
-              callback(std::move(etkn), edge, _currentCursor);
-            }
+            runCallback(EdgeDocumentToken(cursor->collection()->id(), token), edge, callback);
           }
         };
         cursor->nextWithExtra(extraCB, 1);
@@ -203,7 +217,34 @@ bool SingleServerEdgeCursor::next(EdgeCursor::Callback const& callback) {
   return true;
 }
 
+bool SingleServerEdgeCursor::supportsConcurrentReads() const {
+  // the filter of a limited cursor evaluates expressions of the query
+  if (!_trx->state()->isReadOnlyTransaction() || _filter) {
+    return false;
+  }
+#ifdef USE_ENTERPRISE
+  if (_trx->state()->options().skipInaccessibleCollections) {
+    return false;
+  }
+#endif
+  for (auto const& cursorSet : _cursors) {
+    for (auto const& cursor : cursorSet) {
+      if (cursor->collection() != nullptr && !cursor->hasExtra()) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 void SingleServerEdgeCursor::readAll(EdgeCursor::Callback const& callback) {
+  if (_limit > 0) {
+    // stops reading the lookups once their limit is reached
+    while (next(callback)) {
+    }
+    return;
+  }
+
   size_t cursorId = 0;
   for (_currentCursor = 0; _currentCursor < _cursors.size(); ++_currentCursor) {
     if (_internalCursorMapping != nullptr) {
@@ -47,6 +47,10 @@ struct BaseOptions;
 struct SingleServerEdgeDocumentToken;
 
 class SingleServerEdgeCursor final : public EdgeCursor {
+ public:
+  using Filter =
+      std::function<bool(EdgeDocumentToken const&, arangodb::velocypack::Slice, size_t)>;
+
  private:
   BaseOptions* _opts;
   transaction::Methods* _trx;
@@ -56,6 +60,10 @@ class SingleServerEdgeCursor final : public EdgeCursor {
   std::vector<LocalDocumentId> _cache;
   size_t _cachePos;
   std::vector<size_t> const* _internalCursorMapping;
+  // edges to return per cursor set, 0 means no limit
+  uint64_t _limit;
+  uint64_t _returned;
+  Filter _filter;
 
  public:
   SingleServerEdgeCursor(BaseOptions* options, size_t,
@@ -68,15 +76,30 @@ class SingleServerEdgeCursor final : public EdgeCursor {
   void readAll(EdgeCursor::Callback const& callback) override;
 
   std::vector<std::vector<OperationCursor*>>& getCursors() { return _cursors; }
+
+  /// @brief returns at most limit edges of each lookup, counting only the
+  /// edges that pass the filter. the other edges are not returned
+  void setLimit(uint64_t limit, Filter&& filter);
   
   /// @brief number of HTTP requests performed. always 0 in single server
   size_t httpRequests() const override { return 0; }
 
+  /// @brief true if all edges come from index iterators with extra values,
+  /// so that no documents are read, and the transaction is read-only
+  bool supportsConcurrentReads() const override;
+
  private:
   // returns false if cursor can not be further advanced
   bool advanceCursor(OperationCursor*& cursor, std::vector<OperationCursor*>& cursorSet);
 
   void getDocAndRunCallback(OperationCursor*, EdgeCursor::Callback const& callback);
+
+  /// @brief runs the callback for an edge, unless it does not pass the
+  /// filter of a limited cursor
+  void runCallback(EdgeDocumentToken&& token, arangodb::velocypack::Slice edge,
+                   EdgeCursor::Callback const& callback);
+
+  bool limitReached() const { return _limit > 0 && _returned >= _limit; }
 };
 }  // namespace graph
 }  // namespace arangodb
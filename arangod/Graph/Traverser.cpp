@@ -91,18 +91,19 @@ bool Traverser::UniqueVertexGetter::getVertex(VPackSlice edge,
     TRI_ASSERT(toAdd.isString());
   }
 
-  arangodb::velocypack::StringRef toAddStr =
-      _traverser->traverserCache()->persistString(arangodb::velocypack::StringRef(toAdd));
+  graph::TraverserCache* cache = _traverser->traverserCache();
+  graph::InternedId id = cache->internString(arangodb::velocypack::StringRef(toAdd));
+  arangodb::velocypack::StringRef toAddStr = cache->internedString(id);
   // First check if we visited it. If not, then mark
-  if (_returnedVertices.find(toAddStr) != _returnedVertices.end()) {
+  if (_returnedVertices.contains(id)) {
     // This vertex is not unique.
-    _traverser->traverserCache()->increaseFilterCounter();
+    cache->increaseFilterCounter();
     return false;
   } else {
     if (!_traverser->vertexMatchesConditions(toAddStr, result.size())) {
       return false;
     }
-    _returnedVertices.emplace(toAddStr);
+    _returnedVertices.insert(id);
   }
 
   result.emplace_back(toAddStr);
@@ -122,12 +123,13 @@ bool Traverser::UniqueVertexGetter::getSingleVertex(arangodb::velocypack::Slice
     TRI_ASSERT(resSlice.isString());
   }
 
-  result = _traverser->traverserCache()->persistString(
-      arangodb::velocypack::StringRef(resSlice));
+  graph::TraverserCache* cache = _traverser->traverserCache();
+  graph::InternedId id = cache->internString(arangodb::velocypack::StringRef(resSlice));
+  result = cache->internedString(id);
   // First check if we visited it. If not, then mark
-  if (_returnedVertices.find(result) != _returnedVertices.end()) {
+  if (_returnedVertices.contains(id)) {
     // This vertex is not unique.
-    _traverser->traverserCache()->increaseFilterCounter();
+    cache->increaseFilterCounter();
     return false;
   }
 
@@ -135,14 +137,14 @@ bool Traverser::UniqueVertexGetter::getSingleVertex(arangodb::velocypack::Slice
     return false;
   }
 
-  _returnedVertices.emplace(result);
+  _returnedVertices.insert(id);
   return true;
 }
 
 void Traverser::UniqueVertexGetter::reset(arangodb::velocypack::StringRef const& startVertex) {
   _returnedVertices.clear();
   // The startVertex always counts as visited!
-  _returnedVertices.emplace(startVertex);
+  _returnedVertices.insert(_traverser->traverserCache()->internString(startVertex));
 }
 
 Traverser::Traverser(arangodb::traverser::TraverserOptions* opts, transaction::Methods* trx)
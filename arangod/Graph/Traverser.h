@@ -33,6 +33,7 @@
 #include "Graph/ConstantWeightShortestPathFinder.h"
 #include "Graph/PathEnumerator.h"
 #include "Graph/ShortestPathFinder.h"
+#include "Graph/TraverserCache.h"
 #include "Transaction/Helpers.h"
 #include "VocBase/voc-types.h"
 
@@ -165,7 +166,7 @@ class Traverser {
     void reset(arangodb::velocypack::StringRef const&) override;
 
    private:
-    std::unordered_set<arangodb::velocypack::StringRef> _returnedVertices;
+    graph::InternedIdSet _returnedVertices;
   };
 
  public:
@@ -291,6 +292,10 @@ class Traverser {
 
   void allowOptimizedNeighbors();
 
+  /// @brief announces vertices whose data is needed soon, so that they can
+  /// be fetched together. the ids must be persisted in the traverser cache
+  virtual void prefetchVertices(std::vector<arangodb::velocypack::StringRef> const&) {}
+
   transaction::Methods* trx() const { return _trx; }
 
   //////////////////////////////////////////////////////////////////////////////
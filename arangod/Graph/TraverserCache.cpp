@@ -56,6 +56,7 @@ TraverserCache::~TraverserCache() {}
 void TraverserCache::clear() {
   _stringHeap->clear();
   _persistedStrings.clear();
+  _internedStrings.clear();
   _mmdr->clear();
 }
 
@@ -133,12 +134,15 @@ aql::AqlValue TraverserCache::fetchVertexAqlResult(arangodb::velocypack::StringR
   return aql::AqlValue(lookupInCollection(idString));
 }
 
-arangodb::velocypack::StringRef TraverserCache::persistString(arangodb::velocypack::StringRef const idString) {
+InternedId TraverserCache::internString(arangodb::velocypack::StringRef const idString) {
   auto it = _persistedStrings.find(idString);
   if (it != _persistedStrings.end()) {
-    return *it;
+    return it->second;
   }
+  TRI_ASSERT(_internedStrings.size() < std::numeric_limits<InternedId>::max());
   arangodb::velocypack::StringRef res = _stringHeap->registerString(idString.begin(), idString.length());
-  _persistedStrings.emplace(res);
-  return res;
+  InternedId id = static_cast<InternedId>(_internedStrings.size());
+  _internedStrings.emplace_back(res);
+  _persistedStrings.emplace(res, id);
+  return id;
 }
@@ -48,6 +48,37 @@ namespace graph {
 
 struct EdgeDocumentToken;
 
+/// @brief dense id of a vertex, see TraverserCache::internString
+typedef uint32_t InternedId;
+
+/// @brief a set of interned ids, as a bitset
+class InternedIdSet {
+ public:
+  bool contains(InternedId id) const { return id < _bits.size() && _bits[id]; }
+
+  /// @brief returns false if the id was contained already
+  bool insert(InternedId id) {
+    if (id >= _bits.size()) {
+      _bits.resize(std::max<size_t>(id + 1, 2 * _bits.size()), false);
+    } else if (_bits[id]) {
+      return false;
+    }
+    _bits[id] = true;
+    return true;
+  }
+
+  void erase(InternedId id) {
+    if (id < _bits.size()) {
+      _bits[id] = false;
+    }
+  }
+
+  void clear() { _bits.clear(); }
+
+ private:
+  std::vector<bool> _bits;
+};
+
 /// Small wrapper around the actual datastore in
 /// which edges and vertices are stored. The cluster can overwrite this
 /// with an implementation which caches entire documents,
@@ -102,7 +133,22 @@ class TraverserCache {
   /// @brief Persist the given id string. The return value is guaranteed to
   ///        stay valid as long as this cache is valid
   //////////////////////////////////////////////////////////////////////////////
-  arangodb::velocypack::StringRef persistString(arangodb::velocypack::StringRef const idString);
+  arangodb::velocypack::StringRef persistString(arangodb::velocypack::StringRef const idString) {
+    return _internedStrings[internString(idString)];
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Persist the given id string and return a dense id for it, the
+  ///        same for equal strings. Ids start at 0 and stay valid until
+  ///        clear() is called
+  //////////////////////////////////////////////////////////////////////////////
+  InternedId internString(arangodb::velocypack::StringRef const idString);
+
+  /// @brief the persisted string of an interned id
+  arangodb::velocypack::StringRef internedString(InternedId id) const {
+    TRI_ASSERT(id < _internedStrings.size());
+    return _internedStrings[id];
+  }
 
   void increaseFilterCounter() { _filteredDocuments++; }
 
@@ -153,10 +199,15 @@ class TraverserCache {
   std::unique_ptr<arangodb::StringHeap> _stringHeap;
 
   //////////////////////////////////////////////////////////////////////////////
-  /// @brief Set of all strings persisted in the stringHeap. So we can save some
-  ///        memory by not storing them twice.
+  /// @brief All strings persisted in the stringHeap, with their interned id.
+  ///        So we can save some memory by not storing them twice.
+  //////////////////////////////////////////////////////////////////////////////
+  std::unordered_map<arangodb::velocypack::StringRef, InternedId> _persistedStrings;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief The persisted strings by interned id
   //////////////////////////////////////////////////////////////////////////////
-  std::unordered_set<arangodb::velocypack::StringRef> _persistedStrings;
+  std::vector<arangodb::velocypack::StringRef> _internedStrings;
 };
 
 }  // namespace graph
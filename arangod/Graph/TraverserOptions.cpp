@@ -27,21 +27,29 @@
 #include "Aql/Expression.h"
 #include "Aql/PruneExpressionEvaluator.h"
 #include "Aql/Query.h"
+#include "Basics/StaticStrings.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Cluster/ClusterEdgeCursor.h"
+#include "Graph/EdgeDocumentToken.h"
+#include "Graph/SingleServerEdgeCursor.h"
 #include "Graph/SingleServerTraverser.h"
 #include "Indexes/Index.h"
+#include "Transaction/Helpers.h"
 
 #include <velocypack/Iterator.h>
 #include <velocypack/StringRef.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include <algorithm>
+
 using namespace arangodb;
 using namespace arangodb::graph;
 using namespace arangodb::transaction;
 using namespace arangodb::traverser;
 using VPackHelper = arangodb::basics::VelocyPackHelper;
 
+constexpr size_t TraverserOptions::MaxParallelism;
+
 TraverserOptions::TraverserOptions(aql::Query* query)
     : BaseOptions(query),
       _baseVertexExpression(nullptr),
@@ -49,8 +57,11 @@ TraverserOptions::TraverserOptions(aql::Query* query)
       minDepth(1),
       maxDepth(1),
       useBreadthFirst(false),
+      parallelism(1),
       uniqueVertices(UniquenessLevel::NONE),
-      uniqueEdges(UniquenessLevel::PATH) {}
+      uniqueEdges(UniquenessLevel::PATH),
+      edgeSortDescending(false),
+      edgesPerVertex(0) {}
 
 TraverserOptions::TraverserOptions(aql::Query* query, VPackSlice const& obj)
     : BaseOptions(query),
@@ -59,8 +70,11 @@ TraverserOptions::TraverserOptions(aql::Query* query, VPackSlice const& obj)
       minDepth(1),
       maxDepth(1),
       useBreadthFirst(false),
+      parallelism(1),
       uniqueVertices(UniquenessLevel::NONE),
-      uniqueEdges(UniquenessLevel::PATH) {
+      uniqueEdges(UniquenessLevel::PATH),
+      edgeSortDescending(false),
+      edgesPerVertex(0) {
   TRI_ASSERT(obj.isObject());
 
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
@@ -73,6 +87,8 @@ TraverserOptions::TraverserOptions(aql::Query* query, VPackSlice const& obj)
   maxDepth = VPackHelper::getNumericValue<uint64_t>(obj, "maxDepth", 1);
   TRI_ASSERT(minDepth <= maxDepth);
   useBreadthFirst = VPackHelper::getBooleanValue(obj, "bfs", false);
+  parallelism = (std::min)(MaxParallelism, (std::max)(static_cast<size_t>(1),
+      VPackHelper::getNumericValue<size_t>(obj, "parallelism", 1)));
   std::string tmp = VPackHelper::getStringValue(obj, "uniqueVertices", "");
   if (tmp == "path") {
     uniqueVertices = TraverserOptions::UniquenessLevel::PATH;
@@ -99,6 +115,10 @@ TraverserOptions::TraverserOptions(aql::Query* query, VPackSlice const& obj)
   } else {
     uniqueEdges = TraverserOptions::UniquenessLevel::PATH;
   }
+
+  edgeSortAttribute = VPackHelper::getStringValue(obj, "edgeSort", "");
+  edgeSortDescending = VPackHelper::getBooleanValue(obj, "edgeSortDescending", false);
+  edgesPerVertex = VPackHelper::getNumericValue<uint64_t>(obj, "edgesPerVertex", 0);
 }
 
 arangodb::traverser::TraverserOptions::TraverserOptions(arangodb::aql::Query* query,
@@ -109,8 +129,11 @@ arangodb::traverser::TraverserOptions::TraverserOptions(arangodb::aql::Query* qu
       minDepth(1),
       maxDepth(1),
       useBreadthFirst(false),
+      parallelism(1),
       uniqueVertices(UniquenessLevel::NONE),
-      uniqueEdges(UniquenessLevel::PATH) {
+      uniqueEdges(UniquenessLevel::PATH),
+      edgeSortDescending(false),
+      edgesPerVertex(0) {
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
   VPackSlice type = info.get("type");
   TRI_ASSERT(type.isString());
@@ -139,6 +162,12 @@ arangodb::traverser::TraverserOptions::TraverserOptions(arangodb::aql::Query* qu
   }
   useBreadthFirst = read.getBool();
 
+  read = info.get("parallelism");
+  if (read.isInteger()) {
+    parallelism = (std::min)(MaxParallelism,
+                             (std::max)(static_cast<size_t>(1), read.getNumber<size_t>()));
+  }
+
   read = info.get("uniqueVertices");
   if (!read.isInteger()) {
     THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
@@ -178,6 +207,10 @@ arangodb::traverser::TraverserOptions::TraverserOptions(arangodb::aql::Query* qu
                                      "The options require a uniqueEdges");
   }
 
+  edgeSortAttribute = VPackHelper::getStringValue(info, "edgeSort", "");
+  edgeSortDescending = VPackHelper::getBooleanValue(info, "edgeSortDescending", false);
+  edgesPerVertex = VPackHelper::getNumericValue<uint64_t>(info, "edgesPerVertex", 0);
+
   read = info.get("depthLookupInfo");
   if (!read.isNone()) {
     if (!read.isObject()) {
@@ -243,8 +276,12 @@ arangodb::traverser::TraverserOptions::TraverserOptions(TraverserOptions const&
       minDepth(other.minDepth),
       maxDepth(other.maxDepth),
       useBreadthFirst(other.useBreadthFirst),
+      parallelism(other.parallelism),
       uniqueVertices(other.uniqueVertices),
-      uniqueEdges(other.uniqueEdges) {
+      uniqueEdges(other.uniqueEdges),
+      edgeSortAttribute(other.edgeSortAttribute),
+      edgeSortDescending(other.edgeSortDescending),
+      edgesPerVertex(other.edgesPerVertex) {
   TRI_ASSERT(other._baseLookupInfos.empty());
   TRI_ASSERT(other._depthLookupInfo.empty());
   TRI_ASSERT(other._vertexExpressions.empty());
@@ -269,6 +306,7 @@ void TraverserOptions::toVelocyPack(VPackBuilder& builder) const {
   builder.add("minDepth", VPackValue(minDepth));
   builder.add("maxDepth", VPackValue(maxDepth));
   builder.add("bfs", VPackValue(useBreadthFirst));
+  builder.add("parallelism", VPackValue(parallelism));
 
   switch (uniqueVertices) {
     case TraverserOptions::UniquenessLevel::NONE:
@@ -294,6 +332,14 @@ void TraverserOptions::toVelocyPack(VPackBuilder& builder) const {
       break;
   }
 
+  if (!edgeSortAttribute.empty()) {
+    builder.add("edgeSort", VPackValue(edgeSortAttribute));
+    builder.add("edgeSortDescending", VPackValue(edgeSortDescending));
+  }
+  if (edgesPerVertex > 0) {
+    builder.add("edgesPerVertex", VPackValue(edgesPerVertex));
+  }
+
   builder.add("type", VPackValue("traversal"));
 }
 
@@ -331,6 +377,7 @@ void TraverserOptions::buildEngineInfo(VPackBuilder& result) const {
   result.add("minDepth", VPackValue(minDepth));
   result.add("maxDepth", VPackValue(maxDepth));
   result.add("bfs", VPackValue(useBreadthFirst));
+  result.add("parallelism", VPackValue(parallelism));
 
   result.add(VPackValue("uniqueVertices"));
   switch (uniqueVertices) {
@@ -358,6 +405,14 @@ void TraverserOptions::buildEngineInfo(VPackBuilder& result) const {
       break;
   }
 
+  if (!edgeSortAttribute.empty()) {
+    result.add("edgeSort", VPackValue(edgeSortAttribute));
+    result.add("edgeSortDescending", VPackValue(edgeSortDescending));
+  }
+  if (edgesPerVertex > 0) {
+    result.add("edgesPerVertex", VPackValue(edgesPerVertex));
+  }
+
   if (!_depthLookupInfo.empty()) {
     result.add(VPackValue("depthLookupInfo"));
     result.openObject();
@@ -401,7 +456,8 @@ void TraverserOptions::addDepthLookupInfo(aql::ExecutionPlan* plan,
                                           std::string const& attributeName,
                                           aql::AstNode* condition, uint64_t depth) {
   auto& list = _depthLookupInfo[depth];
-  injectLookupInfoInList(list, plan, collectionName, attributeName, condition);
+  injectLookupInfoInList(list, plan, collectionName, attributeName, condition,
+                         edgeSortAttribute);
 }
 
 bool TraverserOptions::vertexHasFilter(uint64_t depth) const {
@@ -411,6 +467,21 @@ bool TraverserOptions::vertexHasFilter(uint64_t depth) const {
   return _vertexExpressions.find(depth) != _vertexExpressions.end();
 }
 
+bool TraverserOptions::hasEdgeFilter(int64_t depth) const {
+  if (_isCoordinator) {
+    return false;
+  }
+  auto specific = _depthLookupInfo.find(depth);
+  std::vector<LookupInfo> const& list =
+      specific != _depthLookupInfo.end() ? specific->second : _baseLookupInfos;
+  for (size_t cursorId = 0; cursorId < list.size(); ++cursorId) {
+    if (hasEdgeFilter(depth, cursorId)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 bool TraverserOptions::hasEdgeFilter(int64_t depth, size_t cursorId) const {
   if (_isCoordinator) {
     // The Coordinator never checks conditions. The DBServer is responsible!
@@ -476,6 +547,70 @@ bool TraverserOptions::evaluateEdgeExpression(arangodb::velocypack::Slice edge,
   return evaluateExpression(expression, edge);
 }
 
+TraverserOptions::LookupInfo const& TraverserOptions::lookupInfo(uint64_t depth,
+                                                                size_t cursorId) const {
+  auto specific = _depthLookupInfo.find(depth);
+  if (specific != _depthLookupInfo.end()) {
+    TRI_ASSERT(specific->second.size() > cursorId);
+    return specific->second[cursorId];
+  }
+  TRI_ASSERT(_baseLookupInfos.size() > cursorId);
+  return _baseLookupInfos[cursorId];
+}
+
+bool TraverserOptions::edgeConditionCoveredByIndex(uint64_t depth, size_t cursorId) {
+  if (_isCoordinator) {
+    return false;
+  }
+  LookupInfo const& info = lookupInfo(depth, cursorId);
+  if (info.expression == nullptr || !info.conditionNeedUpdate ||
+      info.idxHandles.size() != 1 ||
+      info.idxHandles[0].getIndex()->type() != Index::TRI_IDX_TYPE_EDGE_INDEX) {
+    return false;
+  }
+
+  auto it = _edgeExpressionsOnIds.find(info.expression);
+  if (it == _edgeExpressionsOnIds.end()) {
+    std::unordered_set<std::string> attributes;
+    bool onIds = arangodb::aql::Ast::getReferencedAttributes(info.expression->node(),
+                                                             _tmpVar, attributes) &&
+                 std::all_of(attributes.begin(), attributes.end(), [](std::string const& a) {
+                   return a == StaticStrings::FromString || a == StaticStrings::ToString;
+                 });
+    it = _edgeExpressionsOnIds.emplace(info.expression, onIds).first;
+  }
+  return it->second;
+}
+
+VPackSlice TraverserOptions::edgeForCondition(graph::EdgeDocumentToken const& token,
+                                              VPackSlice other,
+                                              arangodb::velocypack::StringRef vertexId,
+                                              uint64_t depth, size_t cursorId) {
+  TRI_ASSERT(other.isString());
+  if (!edgeConditionCoveredByIndex(depth, cursorId)) {
+    return cache()->lookupToken(token);
+  }
+
+  // the edge index on _from returns _to and vice versa
+  Index const* index = lookupInfo(depth, cursorId).idxHandles[0].getIndex().get();
+  TRI_ASSERT(index->fields().size() == 1 && index->fields()[0].size() == 1);
+  bool isFromIndex = index->fields()[0][0].name == StaticStrings::FromString;
+
+  _indexEdge.clear();
+  _indexEdge.openObject();
+  if (isFromIndex) {
+    _indexEdge.add(StaticStrings::FromString,
+                   VPackValuePair(vertexId.data(), vertexId.size(), VPackValueType::String));
+    _indexEdge.add(StaticStrings::ToString, other);
+  } else {
+    _indexEdge.add(StaticStrings::FromString, other);
+    _indexEdge.add(StaticStrings::ToString,
+                   VPackValuePair(vertexId.data(), vertexId.size(), VPackValueType::String));
+  }
+  _indexEdge.close();
+  return _indexEdge.slice();
+}
+
 bool TraverserOptions::evaluateVertexExpression(arangodb::velocypack::Slice vertex,
                                                 uint64_t depth) const {
   arangodb::aql::Expression* expression = nullptr;
@@ -500,10 +635,40 @@ EdgeCursor* arangodb::traverser::TraverserOptions::nextCursor(
     return nextCursorCoordinator(vid, depth);
   }
   auto specific = _depthLookupInfo.find(depth);
+  std::vector<LookupInfo> const& list =
+      specific != _depthLookupInfo.end() ? specific->second : _baseLookupInfos;
+  EdgeCursor* cursor = nextCursorLocal(vid, list, edgeSortDescending);
+  if (edgesPerVertex > 0) {
+    // only the edges passing the edge conditions count towards the limit
+    static_cast<SingleServerEdgeCursor*>(cursor)->setLimit(
+        edgesPerVertex, [this, vid, depth](EdgeDocumentToken const& token,
+                                           VPackSlice edge, size_t cursorId) {
+          if (!hasEdgeFilter(depth, cursorId)) {
+            return true;
+          }
+          if (edge.isString()) {
+            edge = edgeForCondition(token, edge, vid, depth, cursorId);
+          }
+          return evaluateEdgeExpression(edge, vid, depth, cursorId);
+        });
+  }
+  return cursor;
+}
+
+EdgeCursor* TraverserOptions::nextCursor(VPackSlice vertexIds, uint64_t depth) {
+  if (edgesPerVertex > 0 || !edgeSortAttribute.empty()) {
+    // edges are ordered and limited per vertex
+    return nullptr;
+  }
+  if (_isCoordinator) {
+    TRI_ASSERT(_traverser != nullptr);
+    return new ClusterEdgeCursor(vertexIds, depth, this);
+  }
+  auto specific = _depthLookupInfo.find(depth);
   if (specific != _depthLookupInfo.end()) {
-    return nextCursorLocal(vid, specific->second);
-  } 
-  return nextCursorLocal(vid, _baseLookupInfos);
+    return nextCursorLocal(vertexIds, specific->second);
+  }
+  return nextCursorLocal(vertexIds, _baseLookupInfos);
 }
 
 EdgeCursor* TraverserOptions::nextCursorCoordinator(arangodb::velocypack::StringRef vid,
@@ -513,6 +678,42 @@ EdgeCursor* TraverserOptions::nextCursorCoordinator(arangodb::velocypack::String
   return cursor.release();
 }
 
+void TraverserOptions::orderEdges(std::vector<VPackSlice>& edges) const {
+  if (edgeSortAttribute.empty() && edgesPerVertex == 0) {
+    return;
+  }
+
+  // the DBServers order and limit the edges of each of their shards
+  std::vector<std::pair<std::string, VPackSlice>> byCollection;
+  byCollection.reserve(edges.size());
+  for (VPackSlice edge : edges) {
+    std::string id = transaction::helpers::extractIdString(_trx->resolver(), edge, VPackSlice());
+    byCollection.emplace_back(id.substr(0, id.find('/')), edge);
+  }
+
+  if (!edgeSortAttribute.empty()) {
+    std::vector<std::string> path = basics::StringUtils::split(edgeSortAttribute, '.');
+    std::stable_sort(byCollection.begin(), byCollection.end(),
+                     [this, &path](std::pair<std::string, VPackSlice> const& lhs,
+                                   std::pair<std::string, VPackSlice> const& rhs) {
+                       if (lhs.first != rhs.first) {
+                         return lhs.first < rhs.first;
+                       }
+                       int cmp = VPackHelper::compare(lhs.second.get(path),
+                                                      rhs.second.get(path), true);
+                       return edgeSortDescending ? cmp > 0 : cmp < 0;
+                     });
+  }
+
+  std::unordered_map<std::string, uint64_t> counts;
+  edges.clear();
+  for (auto const& it : byCollection) {
+    if (edgesPerVertex == 0 || ++counts[it.first] <= edgesPerVertex) {
+      edges.emplace_back(it.second);
+    }
+  }
+}
+
 void TraverserOptions::linkTraverser(ClusterTraverser* trav) {
   _traverser = trav;
 }
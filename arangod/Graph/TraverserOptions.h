@@ -30,6 +30,7 @@
 #include "StorageEngine/TransactionState.h"
 #include "Transaction/Methods.h"
 
+#include <velocypack/Builder.h>
 #include <velocypack/StringRef.h>
 
 namespace arangodb {
@@ -48,6 +49,10 @@ class TraversalNode;
 struct Variable;
 }  // namespace aql
 
+namespace graph {
+struct EdgeDocumentToken;
+}
+
 namespace traverser {
 
 class ClusterTraverser;
@@ -71,6 +76,12 @@ struct TraverserOptions : public graph::BaseOptions {
   ///        The Node keeps responsibility
   std::unique_ptr<aql::PruneExpressionEvaluator> _pruneExpression;
 
+  /// @brief edge conditions and whether they read nothing but _from and _to
+  std::unordered_map<aql::Expression const*, bool> _edgeExpressionsOnIds;
+
+  /// @brief the edge built from edge index data, see edgeForCondition
+  arangodb::velocypack::Builder _indexEdge;
+
  public:
   uint64_t minDepth;
 
@@ -78,10 +89,27 @@ struct TraverserOptions : public graph::BaseOptions {
 
   bool useBreadthFirst;
 
+  /// @brief number of threads that read the edges of a level of a
+  /// breadth-first neighbors search
+  size_t parallelism;
+
+  static constexpr size_t MaxParallelism = 32;
+
   UniquenessLevel uniqueVertices;
 
   UniquenessLevel uniqueEdges;
 
+  /// @brief attribute to follow the edges of each vertex in order of. this
+  /// needs a persistent index on [_from, attribute] resp. [_to, attribute]
+  std::string edgeSortAttribute;
+
+  bool edgeSortDescending;
+
+  /// @brief maximal number of edges to follow per vertex and edge
+  /// collection, counting the edges that pass the edge conditions. 0 means
+  /// no limit
+  uint64_t edgesPerVertex;
+
   explicit TraverserOptions(aql::Query* query);
 
   TraverserOptions(aql::Query* query, arangodb::velocypack::Slice const& definition);
@@ -115,14 +143,39 @@ struct TraverserOptions : public graph::BaseOptions {
 
   bool hasEdgeFilter(int64_t, size_t) const;
 
+  /// @brief whether any of the cursors of the depth has an edge filter
+  bool hasEdgeFilter(int64_t) const;
+
   bool evaluateEdgeExpression(arangodb::velocypack::Slice,
                               arangodb::velocypack::StringRef vertexId,
                               uint64_t, size_t) const;
 
+  /// @brief whether the edge condition of a cursor can be evaluated on the
+  /// data of its edge index, because it reads nothing but _from and _to
+  bool edgeConditionCoveredByIndex(uint64_t depth, size_t cursorId);
+
+  /// @brief the edge to evaluate the edge condition of a cursor on, for an
+  /// edge index lookup of vertexId that returned the other vertex. if the
+  /// index covers the condition, this is an object with just _from and _to,
+  /// valid until the next call. otherwise it is the edge document
+  arangodb::velocypack::Slice edgeForCondition(graph::EdgeDocumentToken const& token,
+                                               arangodb::velocypack::Slice other,
+                                               arangodb::velocypack::StringRef vertexId,
+                                               uint64_t depth, size_t cursorId);
+
   bool evaluateVertexExpression(arangodb::velocypack::Slice, uint64_t) const;
 
   graph::EdgeCursor* nextCursor(arangodb::velocypack::StringRef vid, uint64_t);
 
+  /// @brief a cursor over the edges of all of the vertex ids in the array,
+  /// see BaseOptions::nextCursorLocal. on a coordinator the edges are edge
+  /// documents, fetched with one request per DBServer
+  graph::EdgeCursor* nextCursor(arangodb::velocypack::Slice vertexIds, uint64_t);
+
+  /// @brief sorts the edges of one vertex fetched from the DBServers by
+  /// edgeSortAttribute, and applies edgesPerVertex to each edge collection
+  void orderEdges(std::vector<arangodb::velocypack::Slice>& edges) const;
+
   void linkTraverser(arangodb::traverser::ClusterTraverser*);
 
   double estimateCost(size_t& nrItems) const override;
@@ -140,6 +193,9 @@ struct TraverserOptions : public graph::BaseOptions {
 
  private:
   graph::EdgeCursor* nextCursorCoordinator(arangodb::velocypack::StringRef vid, uint64_t);
+
+  /// @brief the lookup info of a cursor at the given depth
+  LookupInfo const& lookupInfo(uint64_t depth, size_t cursorId) const;
 };
 }  // namespace traverser
 }  // namespace arangodb
@@ -90,6 +90,10 @@ static_assert(arangodb::iresearch::adjacencyChecker<AttributeType>::checkAdjacen
 
 irs::string_ref const CID_FIELD("@_CID");
 irs::string_ref const PK_COLUMN("@_PK");
+irs::string_ref const STORED_VALUES_COLUMN("@_STORED");
+
+// stored primary sort values column
+irs::string_ref const PRIMARY_SORT_COLUMN("@_PRIMARY_SORT");
 
 // wrapper for use objects with the IResearch unbounded_object_pool
 template <typename T>
@@ -304,6 +308,20 @@ namespace iresearch {
   sstream.reset(field._value);
 }
 
+/*static*/ void Field::setStoredValue(Field& field, irs::bytes_ref const& value) {
+  field._name = STORED_VALUES_COLUMN;
+  field._features = &irs::flags::empty_instance();
+  field._storeValues = ValueStorage::FULL;
+  field._value = value;
+}
+
+/*static*/ void Field::setPrimarySortValue(Field& field, irs::bytes_ref const& value) {
+  field._name = PRIMARY_SORT_COLUMN;
+  field._features = &irs::flags::empty_instance();
+  field._storeValues = ValueStorage::FULL;
+  field._value = value;
+}
+
 Field::Field(Field&& rhs)
     : _features(rhs._features),
       _analyzer(std::move(rhs._analyzer)),
@@ -619,6 +637,96 @@ void FieldIterator::next() {
   } while (!pushAndSetValue(topValue().value, context));
 }
 
+// ----------------------------------------------------------------------------
+// --SECTION--                               DocumentStoredValues implementation
+// ----------------------------------------------------------------------------
+
+/* static */ irs::string_ref const& DocumentStoredValues::column() noexcept {
+  return STORED_VALUES_COLUMN;
+}
+
+/* static */ void DocumentStoredValues::build(arangodb::velocypack::Builder& builder,
+                                              arangodb::velocypack::Slice document,
+                                              std::vector<std::string> const& attributes) {
+  builder.clear();
+  builder.openObject();
+
+  for (auto const& attribute : attributes) {
+    auto value = document.get(attribute);
+    // missing attributes are stored as null, so that a reader can tell them
+    // from attributes that are not stored
+    builder.add(attribute, value.isNone() ? arangodb::velocypack::Slice::nullSlice() : value);
+  }
+
+  builder.close();
+}
+
+/* static */ bool DocumentStoredValues::covers(arangodb::velocypack::Slice stored,
+                                               std::vector<std::string> const& attributes) {
+  if (!stored.isObject()) {
+    return false;
+  }
+
+  for (auto const& attribute : attributes) {
+    if (!stored.hasKey(attribute)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+// --SECTION--                                DocumentPrimarySort implementation
+// ----------------------------------------------------------------------------
+
+/* static */ irs::string_ref const& DocumentPrimarySort::column() noexcept {
+  return PRIMARY_SORT_COLUMN;
+}
+
+/* static */ void DocumentPrimarySort::build(
+    arangodb::velocypack::Builder& builder, arangodb::velocypack::Slice document,
+    std::vector<std::vector<arangodb::basics::AttributeName>> const& fields) {
+  builder.clear();
+  builder.openArray();
+
+  for (auto const& field : fields) {
+    auto value = document;
+
+    for (auto const& attribute : field) {
+      if (!value.isObject()) {
+        value = arangodb::velocypack::Slice::noneSlice();
+        break;
+      }
+      value = value.get(attribute.name);
+    }
+
+    // missing attributes sort like null, as in AQL
+    builder.add(value.isNone() ? arangodb::velocypack::Slice::nullSlice() : value);
+  }
+
+  builder.close();
+}
+
+/* static */ bool DocumentPrimarySort::less(arangodb::velocypack::Slice lhs,
+                                            arangodb::velocypack::Slice rhs,
+                                            std::vector<bool> const& directions) {
+  auto const lhsLength = lhs.isArray() ? lhs.length() : 0;
+  auto const rhsLength = rhs.isArray() ? rhs.length() : 0;
+
+  for (size_t i = 0, size = directions.size(); i < size; ++i) {
+    auto const lhsValue = i < lhsLength ? lhs.at(i) : arangodb::velocypack::Slice::nullSlice();
+    auto const rhsValue = i < rhsLength ? rhs.at(i) : arangodb::velocypack::Slice::nullSlice();
+    int const cmp = arangodb::basics::VelocyPackHelper::compare(lhsValue, rhsValue, true);
+
+    if (cmp != 0) {
+      return directions[i] ? cmp < 0 : cmp > 0;  // true == ascending
+    }
+  }
+
+  return false;
+}
+
 // ----------------------------------------------------------------------------
 // --SECTION--                                DocumentPrimaryKey implementation
 // ----------------------------------------------------------------------------
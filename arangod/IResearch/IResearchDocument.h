@@ -24,6 +24,7 @@
 #ifndef ARANGOD_IRESEARCH__IRESEARCH_DOCUMENT_H
 #define ARANGOD_IRESEARCH__IRESEARCH_DOCUMENT_H 1
 
+#include "Basics/AttributeNameParser.h"
 #include "VocBase/voc-types.h"
 
 #include "IResearchLinkMeta.h"
@@ -87,6 +88,8 @@ struct IResearchViewMeta;  // forward declaration
 ////////////////////////////////////////////////////////////////////////////////
 struct Field {
   static void setPkValue(Field& field, LocalDocumentId::BaseType const& pk);
+  static void setStoredValue(Field& field, irs::bytes_ref const& value);
+  static void setPrimarySortValue(Field& field, irs::bytes_ref const& value);
 
   Field() = default;
   Field(Field&& rhs);
@@ -250,6 +253,53 @@ struct DocumentPrimaryKey {
   DocumentPrimaryKey() = delete;
 };  // DocumentPrimaryKey
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the stored values of an ArangoDB document, a velocypack object with
+///        the attributes listed in IResearchLinkMeta::_storedValues
+////////////////////////////////////////////////////////////////////////////////
+struct DocumentStoredValues {
+  static irs::string_ref const& column() noexcept;  // stored values column
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief builds the stored values of a document
+  ////////////////////////////////////////////////////////////////////////////////
+  static void build(arangodb::velocypack::Builder& builder,
+                    arangodb::velocypack::Slice document,
+                    std::vector<std::string> const& attributes);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @returns 'true' if the stored values contain all of the attributes
+  ////////////////////////////////////////////////////////////////////////////////
+  static bool covers(arangodb::velocypack::Slice stored,
+                     std::vector<std::string> const& attributes);
+
+  DocumentStoredValues() = delete;
+};  // DocumentStoredValues
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the primary sort values of an ArangoDB document, a velocypack array
+///        with the values of the fields of IResearchViewMeta::_primarySort
+////////////////////////////////////////////////////////////////////////////////
+struct DocumentPrimarySort {
+  static irs::string_ref const& column() noexcept;  // primary sort column
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief builds the primary sort values of a document
+  ////////////////////////////////////////////////////////////////////////////////
+  static void build(arangodb::velocypack::Builder& builder,
+                    arangodb::velocypack::Slice document,
+                    std::vector<std::vector<arangodb::basics::AttributeName>> const& fields);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @returns 'true' if the primary sort values lhs sort before rhs, comparing
+  ///          as many values as there are directions
+  ////////////////////////////////////////////////////////////////////////////////
+  static bool less(arangodb::velocypack::Slice lhs, arangodb::velocypack::Slice rhs,
+                   std::vector<bool> const& directions);
+
+  DocumentPrimarySort() = delete;
+};  // DocumentPrimarySort
+
 }  // namespace iresearch
 }  // namespace arangodb
 
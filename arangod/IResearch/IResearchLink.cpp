@@ -33,6 +33,7 @@
 #include "Aql/QueryCache.h"
 #include "Basics/LocalTaskQueue.h"
 #include "Basics/StaticStrings.h"
+#include "Basics/system-functions.h"
 #include "Cluster/ClusterInfo.h"
 #include "MMFiles/MMFilesCollection.h"
 #include "RestServer/DatabaseFeature.h"
@@ -53,6 +54,18 @@ namespace {
 ////////////////////////////////////////////////////////////////////////////////
 const irs::string_ref IRESEARCH_CHECKPOINT_SUFFIX(".checkpoint");
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the number of operations since the last commit after which the
+///        commit task does not wait for the full commit interval, so that
+///        they become visible to queries sooner under heavy ingest
+////////////////////////////////////////////////////////////////////////////////
+constexpr size_t EARLY_COMMIT_OPERATIONS = 10000;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief early commits still wait for this fraction of the commit interval
+////////////////////////////////////////////////////////////////////////////////
+constexpr size_t EARLY_COMMIT_INTERVAL_DIVISOR = 4;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief the storage format used with IResearch writers
 ////////////////////////////////////////////////////////////////////////////////
@@ -68,9 +81,10 @@ struct LinkTrxState final : public arangodb::TransactionState::Cookie {
   irs::index_writer::documents_context _ctx;
   std::unique_lock<ReadMutex> _linkLock;  // prevent data-store deallocation (lock @ AsyncSelf)
   arangodb::iresearch::PrimaryKeyFilterContainer _removals;  // list of document removals
+  std::atomic<size_t> _operations;  // number of inserts and removals (batch inserts may run concurrently)
 
   LinkTrxState(std::unique_lock<ReadMutex>&& linkLock, irs::index_writer& writer) noexcept
-      : _ctx(writer.documents()), _linkLock(std::move(linkLock)) {
+      : _ctx(writer.documents()), _linkLock(std::move(linkLock)), _operations(0) {
     TRI_ASSERT(_linkLock.owns_lock());
   }
 
@@ -98,11 +112,13 @@ struct LinkTrxState final : public arangodb::TransactionState::Cookie {
 
   void remove(arangodb::LocalDocumentId const& value) {
     _ctx.remove(_removals.emplace(value));
+    ++_operations;
   }
 
   void reset() noexcept {
     _removals.clear();
     _ctx.reset();
+    _operations = 0;
   }
 };
 
@@ -172,6 +188,7 @@ inline arangodb::Result insertDocument(irs::index_writer::documents_context& ctx
                                        arangodb::velocypack::Slice const& document,
                                        arangodb::LocalDocumentId const& documentId,
                                        arangodb::iresearch::IResearchLinkMeta const& meta,
+                                       arangodb::iresearch::IResearchViewMeta::Sort const& primarySort,
                                        TRI_idx_iid_t id) {
   body.reset(document, meta);  // reset reusable container to doc
 
@@ -202,6 +219,31 @@ inline arangodb::Result insertDocument(irs::index_writer::documents_context& ctx
   arangodb::iresearch::Field::setPkValue(const_cast<arangodb::iresearch::Field&>(field), docPk);
   doc.insert(irs::action::index_store, field);
 
+  // Stored: the values of the attributes a query may read without the
+  // document
+  if (!meta._storedValues.empty()) {
+    arangodb::velocypack::Builder storedValues;
+    arangodb::iresearch::DocumentStoredValues::build(storedValues, document,
+                                                     meta._storedValues);
+    arangodb::iresearch::Field::setStoredValue(
+        const_cast<arangodb::iresearch::Field&>(field),
+        irs::bytes_ref(storedValues.slice().begin(), storedValues.slice().byteSize()));
+    doc.insert(irs::action::store, field);
+  }
+
+  // Stored: the values of the fields of the primary sort of the view, a query
+  // sorting by them reads these instead of the documents
+  if (!primarySort.empty()) {
+    arangodb::velocypack::Builder primarySortValues;
+    arangodb::iresearch::DocumentPrimarySort::build(primarySortValues, document,
+                                                    primarySort.fields());
+    arangodb::iresearch::Field::setPrimarySortValue(
+        const_cast<arangodb::iresearch::Field&>(field),
+        irs::bytes_ref(primarySortValues.slice().begin(),
+                       primarySortValues.slice().byteSize()));
+    doc.insert(irs::action::store, field);
+  }
+
   if (!doc) {
     return arangodb::Result(
         TRI_ERROR_INTERNAL,
@@ -243,7 +285,7 @@ IResearchLink::IResearchLink( // constructor
     auto prev = state->cookie(key, nullptr);  // get existing cookie
     auto rollback = arangodb::transaction::Status::COMMITTED != status;
 
-    if (rollback && prev) {
+    if (prev) {
 // TODO FIXME find a better way to look up a ViewState
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
       auto& ctx = dynamic_cast<LinkTrxState&>(*prev);
@@ -251,7 +293,11 @@ IResearchLink::IResearchLink( // constructor
       auto& ctx = static_cast<LinkTrxState&>(*prev);
 #endif
 
-      ctx.reset();
+      if (rollback) {
+        ctx.reset();
+      } else {
+        key->trackOperations(ctx._operations.load());  // link is locked by 'ctx'
+      }
     }
 
     prev.reset();
@@ -402,9 +448,12 @@ void IResearchLink::batchInsert( // insert documents
   auto const end = batch.end();
 
   try {
+    ReadMutex mutex(_dataStore._mutex); // '_meta' can be asynchronously modified
+    SCOPED_LOCK(mutex);
+
     for (FieldIterator body(trx); begin != end; ++begin) {
-      auto res =
-          insertDocument(ctx->_ctx, body, begin->second, begin->first, _meta, id());
+      auto res = insertDocument(ctx->_ctx, body, begin->second, begin->first,
+                                _meta, _dataStore._meta._primarySort, id());
 
       if (!res.ok()) {
         LOG_TOPIC("e5eb1", WARN, arangodb::iresearch::TOPIC) << res.errorMessage();
@@ -412,6 +461,8 @@ void IResearchLink::batchInsert( // insert documents
 
         return;
       }
+
+      ++ctx->_operations;
     }
   } catch (arangodb::basics::Exception const& e) {
     LOG_TOPIC("72aa5", WARN, arangodb::iresearch::TOPIC)
@@ -481,6 +532,24 @@ arangodb::Result IResearchLink::commit() {
 ////////////////////////////////////////////////////////////////////////////////
 /// @note assumes that '_asyncSelf' is read-locked (for use with async tasks)
 ////////////////////////////////////////////////////////////////////////////////
+void IResearchLink::trackOperations(size_t operations) noexcept {
+  if (!operations) {
+    return; // nothing to do
+  }
+
+  auto const before = _pendingOperations.fetch_add(operations);
+
+  if (!before) {
+    _pendingSince.store(TRI_microtime());
+  }
+
+  if (_asyncFeature // commit task registered
+      && before < ::EARLY_COMMIT_OPERATIONS
+      && before + operations >= ::EARLY_COMMIT_OPERATIONS) {
+    _asyncFeature->asyncNotify(); // wake up the commit task
+  }
+}
+
 arangodb::Result IResearchLink::commitUnsafe() {
   char runId = 0; // value not used
 
@@ -488,6 +557,20 @@ arangodb::Result IResearchLink::commitUnsafe() {
   TRI_ASSERT(_dataStore); // must be valid if _asyncSelf->get() is valid
 
   try {
+    auto const operations = _pendingOperations.exchange(0);
+    auto const pendingSince = _pendingSince.load();
+    auto const start = TRI_microtime();
+    auto stats = irs::make_finally([this, operations, pendingSince, start]()->void {
+      auto const now = TRI_microtime();
+
+      ++_commits;
+      _lastCommitDuration.store(now - start);
+
+      if (operations && pendingSince > 0.0) {
+        _lastCommitLag.store(now - pendingSince);
+      }
+    });
+
     _dataStore._writer->commit();
 
     SCOPED_LOCK(_readerMutex);
@@ -1170,8 +1253,13 @@ arangodb::Result IResearchLink::initDataStore(InitCallback const& initCallback)
           std::chrono::system_clock::now() - state._last // consumed msec from interval
         ).count();
 
-        if (usedMsec < state._commitIntervalMsec) {
-          timeoutMsec = state._commitIntervalMsec - usedMsec; // still need to sleep
+        size_t intervalMsec = // commit early under heavy ingest
+          _pendingOperations.load() >= ::EARLY_COMMIT_OPERATIONS
+          ? state._commitIntervalMsec / ::EARLY_COMMIT_INTERVAL_DIVISOR
+          : state._commitIntervalMsec;
+
+        if (usedMsec < intervalMsec) {
+          timeoutMsec = intervalMsec - usedMsec; // still need to sleep
 
           return true; // reschedule (with possibly updated '_commitIntervalMsec')
         }
@@ -1333,8 +1421,11 @@ arangodb::Result IResearchLink::insert( // insert document
                         irs::index_writer::documents_context& ctx) -> arangodb::Result {
     try {
       FieldIterator body(trx);
+      ReadMutex mutex(_dataStore._mutex); // '_meta' can be asynchronously modified
+      SCOPED_LOCK(mutex);
 
-      return insertDocument(ctx, body, doc, documentId, _meta, id());
+      return insertDocument(ctx, body, doc, documentId, _meta,
+                            _dataStore._meta._primarySort, id());
     } catch (arangodb::basics::Exception const& e) {
       return arangodb::Result(e.code(),
                               std::string("caught exception while inserting "
@@ -1385,9 +1476,19 @@ arangodb::Result IResearchLink::insert( // insert document
     // optimization for single-document insert-only transactions
     if (trx.isSingleOperationTransaction() // only for single-docuemnt transactions
         && RecoveryState::DONE == _dataStore._recovery) {
-      auto ctx = _dataStore._writer->documents();
+      arangodb::Result res;
+
+      {
+        auto ctx = _dataStore._writer->documents();
+
+        res = insertImpl(ctx);
+      }
 
-      return insertImpl(ctx);
+      if (res.ok()) {
+        trackOperations(1);
+      }
+
+      return res;
     }
 
     auto ptr = irs::memory::make_unique<LinkTrxState>(std::move(lock),
@@ -1417,7 +1518,13 @@ arangodb::Result IResearchLink::insert( // insert document
   // below only during recovery after the 'checkpoint' marker, or post recovery
   // ...........................................................................
 
-  return insertImpl(ctx->_ctx);
+  auto res = insertImpl(ctx->_ctx);
+
+  if (res.ok()) {
+    ++ctx->_operations;
+  }
+
+  return res;
 }
 
 bool IResearchLink::isHidden() const {
@@ -1470,6 +1577,24 @@ size_t IResearchLink::memory() const {
   return size;
 }
 
+void IResearchLink::toVelocyPackStats(arangodb::velocypack::Builder& builder) const {
+  TRI_ASSERT(builder.isOpenObject());
+  auto const pendingOperations = _pendingOperations.load();
+  auto const pendingSince = _pendingSince.load();
+
+  arangodb::velocypack::ObjectBuilder statsBuilder(&builder, "indexing");
+  builder.add("pendingOperations", arangodb::velocypack::Value(pendingOperations));
+  builder.add( // seconds since the oldest operation not visible to queries
+    "pendingSeconds", // key
+    arangodb::velocypack::Value( // value
+      pendingOperations && pendingSince > 0.0 ? TRI_microtime() - pendingSince : 0.0
+    )
+  );
+  builder.add("commits", arangodb::velocypack::Value(_commits.load()));
+  builder.add("lastCommitLag", arangodb::velocypack::Value(_lastCommitLag.load()));
+  builder.add("lastCommitDuration", arangodb::velocypack::Value(_lastCommitDuration.load()));
+}
+
 arangodb::Result IResearchLink::properties( // get link properties
     arangodb::velocypack::Builder& builder, // output buffer
     bool forPersistence // properties for persistance
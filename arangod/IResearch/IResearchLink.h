@@ -153,6 +153,12 @@ class IResearchLink {
   ////////////////////////////////////////////////////////////////////////////////
   size_t memory() const; // arangodb::Index override
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief append how far the documents visible to queries lag behind the
+  ///        committed transactions, for the 'figures' of the link
+  ////////////////////////////////////////////////////////////////////////////////
+  void toVelocyPackStats(arangodb::velocypack::Builder& builder) const;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief fill and return a jSON description of a IResearchLink object
   ///        elements are appended to an existing object
@@ -266,6 +272,11 @@ class IResearchLink {
   DataStore _dataStore; // the iresearch data store, protected by _asyncSelf->mutex()
   std::function<arangodb::Result(arangodb::velocypack::Slice const&)> _flushCallback; // for writing 'Flush' marker during commit (guaranteed valid by init)
   TRI_idx_iid_t const _id; // the index identifier
+  std::atomic<uint64_t> _commits{0}; // number of commits of the data store
+  std::atomic<double> _lastCommitDuration{0.0}; // seconds taken by the last commit
+  std::atomic<double> _lastCommitLag{0.0}; // seconds from the first pending operation until visible in the last commit
+  std::atomic<uint64_t> _pendingOperations{0}; // operations of committed transactions since the last commit
+  std::atomic<double> _pendingSince{0.0}; // time of the first of '_pendingOperations'
   IResearchLinkMeta const _meta; // how this collection should be indexed (read-only, set via init())
   std::mutex _readerMutex; // prevents query cache double invalidation
   std::function<void(arangodb::transaction::Methods& trx, arangodb::transaction::Status status)> _trxCallback; // for insert(...)/remove(...)
@@ -283,6 +294,12 @@ class IResearchLink {
   //////////////////////////////////////////////////////////////////////////////
   arangodb::Result commitUnsafe();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief account for operations of a committed transaction, wakes up the
+  ///        commit task once there are enough for an early commit
+  //////////////////////////////////////////////////////////////////////////////
+  void trackOperations(size_t operations) noexcept;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief run segment consolidation on the data store
   /// @note assumes that '_asyncSelf' is read-locked (for use with async tasks)
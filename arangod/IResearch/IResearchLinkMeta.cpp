@@ -29,6 +29,7 @@
 #include "utils/hash_utils.hpp"
 #include "utils/locale_utils.hpp"
 
+#include "Basics/StaticStrings.h"
 #include "Basics/StringUtils.h"
 #include "Cluster/ServerState.h"
 #include "RestServer/SystemDatabaseFeature.h"
@@ -88,7 +89,8 @@ IResearchLinkMeta::Mask::Mask(bool mask /*= false*/) noexcept
       _fields(mask),
       _includeAllFields(mask),
       _trackListPositions(mask),
-      _storeValues(mask) {}
+      _storeValues(mask),
+      _storedValues(mask) {}
 
 IResearchLinkMeta::IResearchLinkMeta()
     :  //_fields(<empty>), // no fields to index by default
@@ -109,14 +111,16 @@ IResearchLinkMeta::IResearchLinkMeta(IResearchLinkMeta const& other)
       _fields(other._fields),
       _includeAllFields(other._includeAllFields),
       _trackListPositions(other._trackListPositions),
-      _storeValues(other._storeValues) {}
+      _storeValues(other._storeValues),
+      _storedValues(other._storedValues) {}
 
 IResearchLinkMeta::IResearchLinkMeta(IResearchLinkMeta&& other) noexcept
     : _analyzers(std::move(other._analyzers)),
       _fields(std::move(other._fields)),
       _includeAllFields(other._includeAllFields),
       _trackListPositions(other._trackListPositions),
-      _storeValues(other._storeValues) {}
+      _storeValues(other._storeValues),
+      _storedValues(std::move(other._storedValues)) {}
 
 IResearchLinkMeta& IResearchLinkMeta::operator=(IResearchLinkMeta&& other) noexcept {
   if (this != &other) {
@@ -125,6 +129,7 @@ IResearchLinkMeta& IResearchLinkMeta::operator=(IResearchLinkMeta&& other) noexc
     _includeAllFields = std::move(other._includeAllFields);
     _trackListPositions = std::move(other._trackListPositions);
     _storeValues = other._storeValues;
+    _storedValues = std::move(other._storedValues);
   }
 
   return *this;
@@ -137,6 +142,7 @@ IResearchLinkMeta& IResearchLinkMeta::operator=(IResearchLinkMeta const& other)
     _includeAllFields = other._includeAllFields;
     _trackListPositions = other._trackListPositions;
     _storeValues = other._storeValues;
+    _storedValues = other._storedValues;
   }
 
   return *this;
@@ -173,6 +179,10 @@ bool IResearchLinkMeta::operator==(IResearchLinkMeta const& other) const noexcep
     return false;  // values do not match
   }
 
+  if (_storedValues != other._storedValues) {
+    return false;  // values do not match
+  }
+
   return true;
 }
 
@@ -490,6 +500,47 @@ bool IResearchLinkMeta::init( // initialize meta
     }
   }
 
+  {
+    // optional string list
+    static const std::string fieldName("storedValues");
+
+    mask->_storedValues = slice.hasKey(fieldName);
+
+    if (!mask->_storedValues) {
+      _storedValues = defaults._storedValues;
+    } else {
+      auto field = slice.get(fieldName);
+
+      if (!field.isArray()) {
+        errorField = fieldName;
+
+        return false;
+      }
+
+      _storedValues.clear();
+
+      for (arangodb::velocypack::ArrayIterator itr(field); itr.valid(); ++itr) {
+        auto value = *itr;
+
+        // '_id' is stored as a custom type that cannot be resolved outside
+        // of its document
+        if (!value.isString() || value.getStringLength() == 0 ||
+            arangodb::StaticStrings::IdString == value.copyString()) {
+          errorField = fieldName + "=>[" + std::to_string(itr.index()) + "]";
+
+          return false;
+        }
+
+        auto name = value.copyString();
+
+        if (std::find(_storedValues.begin(), _storedValues.end(), name) ==
+            _storedValues.end()) {
+          _storedValues.emplace_back(std::move(name));
+        }
+      }
+    }
+  }
+
   // .............................................................................
   // process fields last since children inherit from parent
   // .............................................................................
@@ -674,6 +725,22 @@ bool IResearchLinkMeta::json( // append meta jSON
     builder.add("storeValues", arangodb::velocypack::Value(policies[policyIdx]));
   }
 
+  // only used at the top level of a link, so only added if set
+  if (!_storedValues.empty() &&
+      (!ignoreEqual || _storedValues != ignoreEqual->_storedValues) &&
+      (!mask || mask->_storedValues)) {
+    builder.add( // add value
+      "storedValues", // key
+      arangodb::velocypack::Value(arangodb::velocypack::ValueType::Array) // value
+    );
+
+    for (auto& name : _storedValues) {
+      builder.add(arangodb::velocypack::Value(name));
+    }
+
+    builder.close(); // storedValues
+  }
+
   // output definitions if 'writeAnalyzerDefinition' requested and not maked
   // this should be the case for the default top-most call
   if (writeAnalyzerDefinition && (!mask || mask->_analyzerDefinitions)) {
@@ -720,6 +787,10 @@ size_t IResearchLinkMeta::memory() const noexcept {
   size += _analyzers.size() * sizeof(decltype(_analyzers)::value_type);
   size += _fields.size() * sizeof(decltype(_fields)::value_type);
 
+  for (auto& name : _storedValues) {
+    size += sizeof(name) + name.size();
+  }
+
   for (auto& entry : _fields) {
     size += entry.key().size();
     size += entry.value()->memory();
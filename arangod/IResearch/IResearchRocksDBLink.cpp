@@ -247,6 +247,7 @@ void IResearchRocksDBLink::toVelocyPack( // generate definition
 
     figuresBuilder.openObject();
     toVelocyPackFigures(figuresBuilder);
+    toVelocyPackStats(figuresBuilder);
     figuresBuilder.close();
     builder.add("figures", figuresBuilder.slice());
   }
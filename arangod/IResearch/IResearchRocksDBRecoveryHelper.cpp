@@ -195,14 +195,13 @@ namespace iresearch {
 
 void IResearchRocksDBRecoveryHelper::prepare() {
   _dbFeature = DatabaseFeature::DATABASE,
-  _engine = static_cast<RocksDBEngine*>(EngineSelectorFeature::ENGINE),
-  _documentCF = RocksDBColumnFamily::documents()->GetID();
+  _engine = static_cast<RocksDBEngine*>(EngineSelectorFeature::ENGINE);
 }
 
 void IResearchRocksDBRecoveryHelper::PutCF(uint32_t column_family_id,
                                            const rocksdb::Slice& key,
                                            const rocksdb::Slice& value) {
-  if (column_family_id == _documentCF) {
+  if (RocksDBColumnFamily::isDocuments(column_family_id)) {
     auto coll = lookupCollection(*_dbFeature, *_engine, RocksDBKey::objectId(key));
 
     if (coll == nullptr) {
@@ -244,7 +243,7 @@ void IResearchRocksDBRecoveryHelper::PutCF(uint32_t column_family_id,
 // common implementation for DeleteCF / SingleDeleteCF
 void IResearchRocksDBRecoveryHelper::handleDeleteCF(uint32_t column_family_id,
                                                     const rocksdb::Slice& key) {
-  if (column_family_id == _documentCF) {
+  if (RocksDBColumnFamily::isDocuments(column_family_id)) {
     return;
   }
   auto coll = lookupCollection(*_dbFeature, *_engine, RocksDBKey::objectId(key));
@@ -85,7 +85,6 @@ class IResearchRocksDBRecoveryHelper final : public RocksDBRecoveryHelper {
   std::set<IndexId> _recoveredIndexes;  // set of already recovered indexes
   DatabaseFeature* _dbFeature{};
   RocksDBEngine* _engine{};
-  uint32_t _documentCF{};
 };
 
 }  // end namespace iresearch
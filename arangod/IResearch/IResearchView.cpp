@@ -784,9 +784,7 @@ arangodb::Result IResearchView::properties( // update properties
     return res;
   }
 
-#if USE_PLAN_CACHE
   arangodb::aql::PlanCache::instance()->invalidate(&vocbase());
-#endif
   arangodb::aql::QueryCache::instance()->invalidate(&vocbase());
 
   return arangodb::ServerState::instance()->isSingleServer()
@@ -919,11 +919,20 @@ bool Index::covers(std::unordered_set<std::string> const& attributes) const {
     return false;
   }
 
+  // every attribute must be one of the index fields. the index may have
+  // more fields than are requested
   std::string result;
-  for (size_t i = 0; i < _fields.size(); ++i) {
-    result.clear();
-    TRI_AttributeNamesToString(_fields[i], result, false);
-    if (std::find(attributes.begin(), attributes.end(), result) == attributes.end()) {
+  for (auto const& it : attributes) {
+    bool found = false;
+    for (auto const& field : _fields) {
+      result.clear();
+      TRI_AttributeNamesToString(field, result, false);
+      if (result == it) {
+        found = true;
+        break;
+      }
+    }
+    if (!found) {
       return false;
     }
   }
@@ -356,6 +356,15 @@ class Index {
                                               aql::Variable const* var,
                                               IndexIteratorOptions const& opts) = 0;
 
+  /// @brief an iterator over the edges of all of the vertex ids in the
+  /// array, which provides the vertex on the other side of each edge as
+  /// extra value. returns nullptr if the index cannot look up several
+  /// vertices at once, only edge indexes can
+  virtual IndexIterator* iteratorForVertices(transaction::Methods* trx,
+                                             arangodb::velocypack::Slice vertexIds) {
+    return nullptr;
+  }
+
   bool canUseConditionPart(arangodb::aql::AstNode const* access,
                            arangodb::aql::AstNode const* other,
                            arangodb::aql::AstNode const* op,
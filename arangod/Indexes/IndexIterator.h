@@ -234,6 +234,9 @@ struct IndexIteratorOptions {
   bool forceProjection = false;
   /// @brief enable caching
   bool enableCache = true;
+  /// @brief number of threads an index may use to read its ranges. only
+  /// honored for read-only transactions
+  size_t parallelism = 1;
 };
   
 /// index estimate map, defined here because it was convenient
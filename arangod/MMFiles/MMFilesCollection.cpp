@@ -35,6 +35,7 @@
 #include "Basics/WriteUnlocker.h"
 #include "Basics/encoding.h"
 #include "Basics/process-utils.h"
+#include "Basics/system-functions.h"
 #include "Cluster/ClusterMethods.h"
 #include "Indexes/IndexIterator.h"
 #include "Logger/Logger.h"
@@ -92,7 +93,13 @@ struct OpenIteratorState {
   uint64_t _deletions{0};
   uint64_t _documents{0};
   int64_t _initialCount{-1};
+  TRI_voc_rid_t _maxRevision{0};
+  size_t _partition{0};
+  size_t _partitions{1};
   bool _hasAllPersistentLocalIds{true};
+  /// @brief whether the revisions cache must be locked, which is the case
+  /// when several states are filled concurrently
+  bool _shouldLock{false};
 
   OpenIteratorState(LogicalCollection* collection, transaction::Methods* trx)
       : _collection(collection),
@@ -109,6 +116,13 @@ struct OpenIteratorState {
       delete it.second;
     }
   }
+
+  /// @brief whether this state processes the markers of the given key.
+  /// keys are partitioned by primary index bucket, so all markers of a key
+  /// are seen by the same state, in datafile order
+  bool isResponsible(VPackSlice const& key) const {
+    return _partitions == 1 || _primaryIndex->bucketId(key) % _partitions == _partition;
+  }
 };
 }  // namespace arangodb
 
@@ -140,6 +154,64 @@ class MMFilesIndexFillerTask : public basics::LocalTask {
   std::shared_ptr<std::vector<std::pair<LocalDocumentId, VPackSlice>>> _documents;
 };
 
+/// @brief helper class for scanning the datafiles of a collection with
+/// multiple threads when it is opened
+class MMFilesOpenIteratorTask : public basics::LocalTask {
+ public:
+  MMFilesOpenIteratorTask(std::shared_ptr<basics::LocalTaskQueue> const& queue,
+                          std::function<void()> const& scan)
+      : LocalTask(queue), _scan(scan) {}
+
+  void run() override {
+    try {
+      _scan();
+    } catch (basics::Exception const& ex) {
+      _queue->setStatus(ex.code());
+    } catch (std::bad_alloc const&) {
+      _queue->setStatus(TRI_ERROR_OUT_OF_MEMORY);
+    } catch (...) {
+      _queue->setStatus(TRI_ERROR_INTERNAL);
+    }
+
+    _queue->join();
+  }
+
+ private:
+  std::function<void()> _scan;
+};
+
+/// @brief minimum combined size of the datafiles of a collection for
+/// scanning them with multiple threads on load
+constexpr uint64_t parallelLoadThreshold = 64 * 1024 * 1024;
+
+/// @brief iterate over the markers of a datafile without updating the tick
+/// statistics of the datafile. used by all but one of the threads scanning
+/// a collection in parallel
+bool iterateMarkersReadOnly(MMFilesDatafile* datafile,
+                            std::function<bool(MMFilesMarker const*)> const& cb) {
+  if (datafile->state() != TRI_DF_STATE_READ && datafile->state() != TRI_DF_STATE_WRITE) {
+    return false;
+  }
+
+  char const* ptr = datafile->data();
+  char const* end = ptr + datafile->currentSize();
+
+  while (ptr < end) {
+    auto const* marker = reinterpret_cast<MMFilesMarker const*>(ptr);
+
+    if (marker->getSize() == 0) {
+      return true;
+    }
+    if (!cb(marker)) {
+      return false;
+    }
+
+    ptr += MMFilesDatafileHelper::AlignedMarkerSize<size_t>(marker);
+  }
+
+  return true;
+}
+
 /// @brief find a statistics container for a given file id
 static MMFilesDatafileStatisticsContainer* FindDatafileStats(OpenIteratorState* state,
                                                              TRI_voc_fid_t fid) {
@@ -337,6 +409,15 @@ int MMFilesCollection::OpenIteratorHandleDocumentMarker(MMFilesMarker const* mar
                          MMFilesDatafileHelper::VPackOffset(TRI_DF_MARKER_VPACK_DOCUMENT));
   uint8_t const* vpack = slice.begin();
 
+  VPackSlice keySlice;
+  TRI_voc_rid_t revisionId;
+
+  transaction::helpers::extractKeyAndRevFromDocument(slice, keySlice, revisionId);
+
+  if (!state->isResponsible(keySlice)) {
+    return TRI_ERROR_NO_ERROR;
+  }
+
   LocalDocumentId localDocumentId;
   if (marker->getSize() == MMFilesDatafileHelper::VPackOffset(TRI_DF_MARKER_VPACK_DOCUMENT) +
                                slice.byteSize() + sizeof(LocalDocumentId::BaseType)) {
@@ -349,12 +430,7 @@ int MMFilesCollection::OpenIteratorHandleDocumentMarker(MMFilesMarker const* mar
     state->_hasAllPersistentLocalIds = false;
   }
 
-  VPackSlice keySlice;
-  TRI_voc_rid_t revisionId;
-
-  transaction::helpers::extractKeyAndRevFromDocument(slice, keySlice, revisionId);
-
-  physical->setRevision(revisionId, false);
+  state->_maxRevision = (std::max)(state->_maxRevision, revisionId);
 
   {
     // track keys
@@ -373,13 +449,13 @@ int MMFilesCollection::OpenIteratorHandleDocumentMarker(MMFilesMarker const* mar
   }
 
   // no primary index lock required here because we are the only ones reading
-  // from the index ATM
+  // from the index ATM, and concurrent states never touch the same bucket
   MMFilesSimpleIndexElement* found =
       state->_primaryIndex->lookupKeyRef(trx, keySlice);
 
   // it is a new entry
   if (found == nullptr || !found->isSet()) {
-    physical->insertLocalDocumentId(localDocumentId, vpack, fid, false, false);
+    physical->insertLocalDocumentId(localDocumentId, vpack, fid, false, state->_shouldLock);
 
     // insert into primary index
     Result res = state->_primaryIndex->insertKey(trx, localDocumentId,
@@ -413,7 +489,7 @@ int MMFilesCollection::OpenIteratorHandleDocumentMarker(MMFilesMarker const* mar
     physical->removeLocalDocumentId(oldLocalDocumentId, false);
 
     // insert new revision
-    physical->insertLocalDocumentId(localDocumentId, vpack, fid, false, false);
+    physical->insertLocalDocumentId(localDocumentId, vpack, fid, false, state->_shouldLock);
 
     // update the datafile info
     MMFilesDatafileStatisticsContainer* dfi;
@@ -460,7 +536,11 @@ int MMFilesCollection::OpenIteratorHandleDeletionMarker(MMFilesMarker const* mar
 
   transaction::helpers::extractKeyAndRevFromDocument(slice, keySlice, revisionId);
 
-  physical->setRevision(revisionId, false);
+  if (!state->isResponsible(keySlice)) {
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  state->_maxRevision = (std::max)(state->_maxRevision, revisionId);
   {
     // track keys
     VPackValueLength length;
@@ -477,7 +557,7 @@ int MMFilesCollection::OpenIteratorHandleDeletionMarker(MMFilesMarker const* mar
   }
 
   // no primary index lock required here because we are the only ones reading
-  // from the index ATM
+  // from the index ATM, and concurrent states never touch the same bucket
   MMFilesSimpleIndexElement found =
       state->_primaryIndex->lookupKey(trx, keySlice);
 
@@ -1940,21 +2020,123 @@ void MMFilesCollection::open(bool ignoreErrors) {
 
 /// @brief iterate all markers of the collection
 int MMFilesCollection::iterateMarkersOnLoad(transaction::Methods* trx) {
-  // initialize state for iteration
-  OpenIteratorState openState(&_logicalCollection, trx);
-
   if (_initialCount != -1) {
     _revisionsCache.sizeHint(_initialCount);
     sizeHint(trx, _initialCount);
-    openState._initialCount = _initialCount;
   }
 
+  READ_LOCKER(readLocker, _filesLock);
+
+  std::vector<MMFilesDatafile*> files;
+  files.reserve(_datafiles.size() + _compactors.size() + _journals.size());
+  files.insert(files.end(), _datafiles.begin(), _datafiles.end());
+  files.insert(files.end(), _compactors.begin(), _compactors.end());
+  files.insert(files.end(), _journals.begin(), _journals.end());
+
+  uint64_t totalSize = 0;
+  for (auto const& datafile : files) {
+    totalSize += datafile->currentSize();
+  }
+
+  // big collections are scanned by multiple threads. every thread reads all
+  // datafiles in order, but only processes the documents of the primary
+  // index buckets it is responsible for. the first thread additionally keeps
+  // track of the ticks of all markers
+  size_t partitions = 1;
+  if (totalSize >= parallelLoadThreshold && SchedulerFeature::SCHEDULER != nullptr) {
+    partitions = (std::max)((std::min)(primaryIndex()->buckets(), TRI_numberProcessors()),
+                            size_t(1));
+  }
+
+  std::vector<std::unique_ptr<OpenIteratorState>> states;
+  for (size_t i = 0; i < partitions; ++i) {
+    auto state = std::make_unique<OpenIteratorState>(&_logicalCollection, trx);
+    state->_initialCount = _initialCount;
+    state->_partition = i;
+    state->_partitions = partitions;
+    state->_shouldLock = (partitions > 1);
+    states.emplace_back(std::move(state));
+  }
+
+  OpenIteratorState& openState = *states[0];
+
   // read all documents and fill primary index
   auto cb = [&openState](MMFilesMarker const* marker, MMFilesDatafile* datafile) -> bool {
     return OpenIterator(marker, &openState, datafile);
   };
 
-  iterateDatafiles(cb);
+  if (states.size() == 1) {
+    iterateDatafilesVector(files, cb);
+  } else {
+    for (auto const& datafile : files) {
+      datafile->sequentialAccess();
+      datafile->willNeed();
+    }
+
+    auto poster = [](std::function<void()> fn) -> void {
+      SchedulerFeature::SCHEDULER->queue(RequestLane::INTERNAL_LOW, fn);
+    };
+    auto queue = std::make_shared<arangodb::basics::LocalTaskQueue>(poster);
+
+    queue->enqueue(std::make_shared<MMFilesOpenIteratorTask>(queue, [&files, &cb]() {
+      for (auto const& datafile : files) {
+        if (!TRI_IterateDatafile(datafile, cb)) {
+          break;
+        }
+      }
+    }));
+
+    for (size_t i = 1; i < states.size(); ++i) {
+      OpenIteratorState* state = states[i].get();
+      queue->enqueue(std::make_shared<MMFilesOpenIteratorTask>(queue, [&files, state]() {
+        for (auto const& datafile : files) {
+          auto handleMarker = [state, datafile](MMFilesMarker const* marker) -> bool {
+            MMFilesMarkerType const type = marker->getType();
+            int res = TRI_ERROR_NO_ERROR;
+            if (type == TRI_DF_MARKER_VPACK_DOCUMENT) {
+              res = OpenIteratorHandleDocumentMarker(marker, datafile, state);
+            } else if (type == TRI_DF_MARKER_VPACK_REMOVE) {
+              res = OpenIteratorHandleDeletionMarker(marker, datafile, state);
+            }
+            return (res == TRI_ERROR_NO_ERROR);
+          };
+          if (!iterateMarkersReadOnly(datafile, handleMarker)) {
+            break;
+          }
+        }
+      }));
+    }
+
+    queue->dispatchAndWait();
+
+    for (auto const& datafile : files) {
+      if (datafile->isPhysical() && datafile->isSealed()) {
+        datafile->randomAccess();
+      }
+    }
+
+    if (queue->status() != TRI_ERROR_NO_ERROR) {
+      return queue->status();
+    }
+
+    // merge the results of all threads into the first state
+    for (size_t i = 1; i < states.size(); ++i) {
+      OpenIteratorState const& other = *states[i];
+      openState._documents += other._documents;
+      openState._deletions += other._deletions;
+      openState._maxRevision = (std::max)(openState._maxRevision, other._maxRevision);
+      if (!other._hasAllPersistentLocalIds) {
+        openState._hasAllPersistentLocalIds = false;
+      }
+      for (auto const& it : other._stats) {
+        FindDatafileStats(&openState, it.first)->update(*it.second);
+      }
+    }
+  }
+
+  readLocker.unlock();
+
+  setRevision(openState._maxRevision, false);
 
   LOG_TOPIC("fc80d", TRACE, arangodb::Logger::ENGINES)
       << "found " << openState._documents << " document markers, " << openState._deletions
@@ -2259,9 +2441,7 @@ std::shared_ptr<Index> MMFilesCollection::createIndex(transaction::Methods& trx,
     THROW_ARANGO_EXCEPTION(res);
   }
 
-#if USE_PLAN_CACHE
-  arangodb::aql::PlanCache::instance()->invalidate(_logicalCollection.vocbase());
-#endif
+  arangodb::aql::PlanCache::instance()->invalidate(&_logicalCollection.vocbase());
   // Until here no harm is done if sth fails. The shared ptr will clean up. if
   // left before
 
@@ -3456,7 +3636,8 @@ Result MMFilesCollection::update(arangodb::transaction::Methods* trx,
   if (options.recoveryData == nullptr) {
     res = mergeObjectsForUpdate(trx, oldDoc, newSlice, isEdgeCollection,
                                 options.mergeObjects, options.keepNull,
-                                *builder.get(), options.isRestore, revisionId);
+                                *builder.get(), options.isRestore, revisionId,
+                                options.incrementNumbers);
 
     if (res.fail()) {
       return res;
@@ -24,6 +24,8 @@
 #include "MMFilesCompactionFeature.h"
 
 #include "Basics/Exceptions.h"
+#include "Basics/MutexLocker.h"
+#include "Basics/system-functions.h"
 #include "Logger/Logger.h"
 #include "MMFiles/MMFilesLogfileManager.h"
 #include "ProgramOptions/ProgramOptions.h"
@@ -47,7 +49,10 @@ MMFilesCompactionFeature::MMFilesCompactionFeature(application_features::Applica
       _maxResultFilesize(128 * 1024 * 1024),
       _deadNumberThreshold(16384),
       _deadSizeThreshold(128 * 1024),
-      _deadShare(0.1) {
+      _deadShare(0.1),
+      _maxBandwidth(0),
+      _threads(1),
+      _bandwidthNext(0.0) {
   setOptional(true);
   onlyEnabledWith("MMFilesEngine");
 
@@ -99,6 +104,16 @@ void MMFilesCompactionFeature::collectOptions(std::shared_ptr<options::ProgramOp
                      "how large the resulting file may be in comparison to the "
                      "collections '--database.maximal-journal-size' setting",
                      new UInt64Parameter(&_maxSizeFactor));
+
+  options->addOption("--compaction.max-bandwidth",
+                     "maximum number of bytes per second all compactions "
+                     "together may read and write (0 = unlimited)",
+                     new UInt64Parameter(&_maxBandwidth));
+
+  options->addOption("--compaction.threads",
+                     "maximum number of collections per database that are "
+                     "compacted in parallel",
+                     new UInt64Parameter(&_threads));
 }
 
 void MMFilesCompactionFeature::validateOptions(std::shared_ptr<options::ProgramOptions> options) {
@@ -132,4 +147,27 @@ void MMFilesCompactionFeature::validateOptions(std::shared_ptr<options::ProgramO
         << "compaction.max-file-size-factor should be at least: 1";
     _maxSizeFactor = 1;
   }
+
+  if (_threads < 1) {
+    LOG_TOPIC("4a0c7", WARN, Logger::COMPACTOR)
+        << "compaction.threads should be at least: 1";
+    _threads = 1;
+  }
+}
+
+double MMFilesCompactionFeature::bandwidthDelay(uint64_t bytes) {
+  if (_maxBandwidth == 0 || bytes == 0) {
+    return 0.0;
+  }
+
+  MUTEX_LOCKER(locker, _bandwidthLock);
+
+  double const now = TRI_microtime();
+  if (_bandwidthNext < now) {
+    // unused bandwidth of idle periods cannot be saved up for later
+    _bandwidthNext = now;
+  }
+  _bandwidthNext += static_cast<double>(bytes) / static_cast<double>(_maxBandwidth);
+
+  return _bandwidthNext - now;
 }
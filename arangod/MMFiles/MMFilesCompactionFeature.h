@@ -25,6 +25,7 @@
 #define ARANGOD_MMFILES_COMPACTION_FEATURE_H 1
 
 #include "ApplicationFeatures/ApplicationFeature.h"
+#include "Basics/Mutex.h"
 
 namespace arangodb {
 namespace options {
@@ -73,6 +74,21 @@ class MMFilesCompactionFeature : public application_features::ApplicationFeature
   /// compacted
   double _deadShare;
 
+  /// @brief maximum number of bytes per second all compactions together may
+  /// read and write. 0 means unlimited
+  uint64_t _maxBandwidth;
+
+  /// @brief maximum number of collections of a database that are compacted
+  /// in parallel
+  uint64_t _threads;
+
+  /// @brief protects _bandwidthNext
+  Mutex _bandwidthLock;
+
+  /// @brief point in time from which on compaction may use I/O bandwidth
+  /// again
+  double _bandwidthNext;
+
   MMFilesCompactionFeature(MMFilesCompactionFeature const&) = delete;
   MMFilesCompactionFeature& operator=(MMFilesCompactionFeature const&) = delete;
 
@@ -121,6 +137,16 @@ class MMFilesCompactionFeature : public application_features::ApplicationFeature
   /// compacted
   double deadShare() const { return _deadShare; }
 
+  /// @brief maximum number of collections of a database that are compacted
+  /// in parallel
+  size_t threads() const { return static_cast<size_t>(_threads); }
+
+  /// @brief account for bytes read and written by a compaction run, and
+  /// return the number of seconds to wait before starting the next run so
+  /// that all compactor threads together stay within the configured
+  /// bandwidth
+  double bandwidthDelay(uint64_t bytes);
+
  public:
   void collectOptions(std::shared_ptr<options::ProgramOptions>) override final;
   void validateOptions(std::shared_ptr<options::ProgramOptions>) override final;
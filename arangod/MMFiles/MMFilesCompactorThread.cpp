@@ -24,6 +24,7 @@
 #include "MMFilesCompactorThread.h"
 #include "Basics/ConditionLocker.h"
 #include "Basics/FileUtils.h"
+#include "Basics/LocalTaskQueue.h"
 #include "Basics/ReadLocker.h"
 #include "Basics/WriteLocker.h"
 #include "Basics/conversions.h"
@@ -39,6 +40,8 @@
 #include "MMFiles/MMFilesIndexElement.h"
 #include "MMFiles/MMFilesPrimaryIndex.h"
 #include "MMFilesCompactionFeature.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "Transaction/Helpers.h"
 #include "Transaction/Hints.h"
@@ -49,6 +52,30 @@
 
 using namespace arangodb;
 
+namespace {
+
+/// @brief helper class for compacting multiple collections in parallel
+class MMFilesCompactionTask : public basics::LocalTask {
+ public:
+  MMFilesCompactionTask(std::shared_ptr<basics::LocalTaskQueue> const& queue,
+                        std::function<void()> const& work)
+      : LocalTask(queue), _work(work) {}
+
+  void run() override {
+    try {
+      _work();
+    } catch (...) {
+      // errors are logged by the compaction itself
+    }
+    _queue->join();
+  }
+
+ private:
+  std::function<void()> _work;
+};
+
+}  // namespace
+
 static char const* ReasonCorrupted =
     "skipped compaction because collection has corrupted datafile(s)";
 static char const* ReasonNoDatafiles =
@@ -391,8 +418,8 @@ MMFilesCompactorThread::CompactionInitialContext MMFilesCompactorThread::getComp
 }
 
 /// @brief compact the specified datafiles
-void MMFilesCompactorThread::compactDatafiles(LogicalCollection* collection,
-                                              std::vector<CompactionInfo> const& toCompact) {
+uint64_t MMFilesCompactorThread::compactDatafiles(LogicalCollection* collection,
+                                                  std::vector<CompactionInfo> const& toCompact) {
   TRI_ASSERT(collection != nullptr);
   auto physical = static_cast<MMFilesCollection*>(collection->getPhysical());
   TRI_ASSERT(physical != nullptr);
@@ -503,7 +530,7 @@ void MMFilesCompactorThread::compactDatafiles(LogicalCollection* collection,
     LOG_TOPIC("33ca7", ERR, Logger::COMPACTOR)
         << "could not create initialize compaction";
 
-    return;
+    return 0;
   }
 
   LOG_TOPIC("002a1", DEBUG, Logger::COMPACTOR)
@@ -520,11 +547,11 @@ void MMFilesCompactorThread::compactDatafiles(LogicalCollection* collection,
   } catch (std::exception const& ex) {
     LOG_TOPIC("10471", ERR, Logger::COMPACTOR)
         << "could not create compactor file: " << ex.what();
-    return;
+    return 0;
   } catch (...) {
     LOG_TOPIC("29a67", ERR, Logger::COMPACTOR)
         << "could not create compactor file: unknown exception";
-    return;
+    return 0;
   }
 
   TRI_ASSERT(compactor != nullptr);
@@ -543,7 +570,7 @@ void MMFilesCompactorThread::compactDatafiles(LogicalCollection* collection,
   if (!res.ok()) {
     LOG_TOPIC("91796", ERR, Logger::COMPACTOR)
         << "error during compaction: " << res.errorMessage();
-    return;
+    return 0;
   }
 
   // now compact all datafiles
@@ -578,12 +605,14 @@ void MMFilesCompactorThread::compactDatafiles(LogicalCollection* collection,
           << "failed to compact datafile '" << df->getName() << "'";
       // compactor file does not need to be removed now. will be removed on next
       // startup
-      return;
+      return compactionBytesRead;
     }
 
     ++nrCombined;
   }  // next file
 
+  uint64_t const bytesProcessed = compactionBytesRead + compactor->currentSize();
+
   TRI_ASSERT(context->_dfi.numberDead == 0);
   TRI_ASSERT(context->_dfi.sizeDead == 0);
 
@@ -605,7 +634,7 @@ void MMFilesCompactorThread::compactDatafiles(LogicalCollection* collection,
   if (physical->closeCompactor(compactor) != TRI_ERROR_NO_ERROR) {
     LOG_TOPIC("d86f1", ERR, Logger::COMPACTOR) << "could not close compactor file";
     // TODO: how do we recover from this state?
-    return;
+    return bytesProcessed;
   }
 
   if (context->_dfi.numberAlive == 0 && context->_dfi.numberDead == 0 &&
@@ -701,16 +730,20 @@ void MMFilesCompactorThread::compactDatafiles(LogicalCollection* collection,
       }
     }
   }
+
+  return bytesProcessed;
 }
 
 /// @brief checks all datafiles of a collection
-bool MMFilesCompactorThread::compactCollection(LogicalCollection* collection, bool& wasBlocked) {
+bool MMFilesCompactorThread::compactCollection(LogicalCollection* collection,
+                                               bool& wasBlocked, uint64_t& bytesProcessed) {
   // we can hopefully get away without the lock here...
   //  if (! document->isFullyCollected()) {
   //    return false;
   //  }
 
   wasBlocked = false;
+  bytesProcessed = 0;
 
   // if we cannot acquire the read lock instantly, we will exit directly.
   // otherwise we'll risk a multi-thread deadlock between synchronizer,
@@ -949,7 +982,7 @@ bool MMFilesCompactorThread::compactCollection(LogicalCollection* collection, bo
   TRI_ASSERT(reason != nullptr);
   physical->setCompactionStatus(reason);
   physical->setNextCompactionStartIndex(start);
-  compactDatafiles(collection, toCompact);
+  bytesProcessed = compactDatafiles(collection, toCompact);
 
   return true;
 }
@@ -964,10 +997,138 @@ void MMFilesCompactorThread::signal() {
   locker.signal();
 }
 
+bool MMFilesCompactorThread::compactCollectionIfDue(LogicalCollection* collection,
+                                                    uint64_t& bytesProcessed) {
+  MMFilesEngine* engine = static_cast<MMFilesEngine*>(EngineSelectorFeature::ENGINE);
+  bool worked = false;
+  bytesProcessed = 0;
+
+  auto callback = [this, &collection, &worked, &bytesProcessed, &engine]() -> void {
+    if (collection->status() != TRI_VOC_COL_STATUS_LOADED &&
+        collection->status() != TRI_VOC_COL_STATUS_UNLOADING) {
+      return;
+    }
+
+    bool doCompact = static_cast<MMFilesCollection*>(collection->getPhysical())->doCompact();
+
+    if (engine->isCompactionDisabled()) {
+      doCompact = false;
+    }
+
+    // for document collection, compactify datafiles
+    if (collection->status() == TRI_VOC_COL_STATUS_LOADED && doCompact) {
+      // check whether someone else holds a read-lock on the
+      // compaction lock
+
+      auto physical = static_cast<MMFilesCollection*>(collection->getPhysical());
+      TRI_ASSERT(physical != nullptr);
+
+      MMFilesTryCompactionLocker compactionLocker(physical);
+
+      if (!compactionLocker.isLocked()) {
+        // someone else is holding the compactor lock, we'll not
+        // compact
+        return;
+      }
+
+      try {
+        double const now = TRI_microtime();
+        if (physical->lastCompactionStamp() +
+                MMFilesCompactionFeature::COMPACTOR->compactionCollectionInterval() <=
+            now) {
+          auto ce = arangodb::MMFilesCollection::toMMFilesCollection(collection)
+                        ->ditches()
+                        ->createMMFilesCompactionDitch(__FILE__, __LINE__);
+
+          if (ce == nullptr) {
+            // out of memory
+            LOG_TOPIC("5cd66", WARN, Logger::COMPACTOR)
+                << "out of memory when trying to create compaction "
+                   "ditch";
+          } else {
+            try {
+              bool wasBlocked = false;
+              worked = compactCollection(collection, wasBlocked, bytesProcessed);
+
+              if (!worked && !wasBlocked) {
+                // set compaction stamp
+                physical->lastCompactionStamp(now);
+              }
+              // if we worked or were blocked, then we don't set the
+              // compaction stamp to force another round of
+              // compaction
+            } catch (std::exception const& ex) {
+              LOG_TOPIC("a9e71", ERR, Logger::COMPACTOR)
+                  << "caught exception during compaction: " << ex.what();
+            } catch (...) {
+              LOG_TOPIC("5f4c3", ERR, Logger::COMPACTOR)
+                  << "an unknown exception occurred during "
+                     "compaction";
+              // in case an error occurs, we must still free this
+              // ditch
+            }
+
+            arangodb::MMFilesCollection::toMMFilesCollection(collection)
+                ->ditches()
+                ->freeDitch(ce);
+          }
+        }
+      } catch (std::exception const& ex) {
+        LOG_TOPIC("e38b9", ERR, Logger::COMPACTOR)
+            << "caught exception during compaction: " << ex.what();
+      } catch (...) {
+        // in case an error occurs, we must still relase the lock
+        LOG_TOPIC("e9a26", ERR, Logger::COMPACTOR)
+            << "an unknown exception occurred during compaction";
+      }
+    }
+  };
+
+  if (!collection->tryExecuteWhileStatusLocked(callback)) {
+    return false;
+  }
+
+  if (worked) {
+    // signal the cleanup thread that we worked and that it can now
+    // wake up
+    CONDITION_LOCKER(locker, _condition);
+    locker.signal();
+  }
+
+  return worked;
+}
+
+void MMFilesCompactorThread::sortByDeadShare(
+    std::vector<std::shared_ptr<arangodb::LogicalCollection>>& collections) {
+  std::vector<std::pair<double, std::shared_ptr<arangodb::LogicalCollection>>> shares;
+  shares.reserve(collections.size());
+
+  for (auto& collection : collections) {
+    auto physical = static_cast<MMFilesCollection*>(collection->getPhysical());
+    MMFilesDatafileStatisticsContainer const dfi = physical->_datafileStatistics.all();
+
+    double share = 0.0;
+    if (dfi.sizeDead > 0) {
+      share = static_cast<double>(dfi.sizeDead) /
+              (static_cast<double>(dfi.sizeDead) + static_cast<double>(dfi.sizeAlive));
+    }
+    shares.emplace_back(share, std::move(collection));
+  }
+
+  std::stable_sort(shares.begin(), shares.end(),
+                   [](auto const& lhs, auto const& rhs) { return lhs.first > rhs.first; });
+
+  collections.clear();
+  for (auto& it : shares) {
+    collections.emplace_back(std::move(it.second));
+  }
+}
+
 void MMFilesCompactorThread::run() {
   MMFilesEngine* engine = static_cast<MMFilesEngine*>(EngineSelectorFeature::ENGINE);
   std::vector<std::shared_ptr<arangodb::LogicalCollection>> collections;
   int numCompacted = 0;
+  uint64_t bytesProcessed = 0;
   while (true) {
     // keep initial _state value as vocbase->_state might change during
     // compaction loop
@@ -976,125 +1137,85 @@ void MMFilesCompactorThread::run() {
     try {
       engine->tryPreventCompaction(
           &_vocbase,
-          [this, &numCompacted, &collections, &engine](TRI_vocbase_t* vocbase) {
+          [this, &numCompacted, &bytesProcessed, &collections, &engine](TRI_vocbase_t* vocbase) {
             // compaction is currently allowed
             numCompacted = 0;
+            bytesProcessed = 0;
 
             try {
-              // copy all collections
+              // copy all collections, the ones with the highest share of
+              // dead data first so that the most space is reclaimed per
+              // byte read and written
               collections = _vocbase.collections(false);
+              sortByDeadShare(collections);
             } catch (...) {
               collections.clear();
             }
 
-            for (auto& collection : collections) {
-              bool worked = false;
-
-              if (engine->isCompactionDisabled()) {
-                continue;
-              }
-
-              auto callback = [this, &collection, &worked, &engine]() -> void {
-                if (collection->status() != TRI_VOC_COL_STATUS_LOADED &&
-                    collection->status() != TRI_VOC_COL_STATUS_UNLOADING) {
-                  return;
-                }
-
-                bool doCompact =
-                    static_cast<MMFilesCollection*>(collection->getPhysical())->doCompact();
+            size_t const threads = MMFilesCompactionFeature::COMPACTOR->threads();
 
+            if (threads <= 1 || SchedulerFeature::SCHEDULER == nullptr) {
+              for (auto& collection : collections) {
                 if (engine->isCompactionDisabled()) {
-                  doCompact = false;
+                  continue;
                 }
 
-                // for document collection, compactify datafiles
-                if (collection->status() == TRI_VOC_COL_STATUS_LOADED && doCompact) {
-                  // check whether someone else holds a read-lock on the
-                  // compaction lock
-
-                  auto physical =
-                      static_cast<MMFilesCollection*>(collection->getPhysical());
-                  TRI_ASSERT(physical != nullptr);
-
-                  MMFilesTryCompactionLocker compactionLocker(physical);
-
-                  if (!compactionLocker.isLocked()) {
-                    // someone else is holding the compactor lock, we'll not
-                    // compact
-                    return;
-                  }
-
-                  try {
-                    double const now = TRI_microtime();
-                    if (physical->lastCompactionStamp() +
-                            MMFilesCompactionFeature::COMPACTOR->compactionCollectionInterval() <=
-                        now) {
-                      auto ce = arangodb::MMFilesCollection::toMMFilesCollection(
-                                    collection.get())
-                                    ->ditches()
-                                    ->createMMFilesCompactionDitch(__FILE__, __LINE__);
-
-                      if (ce == nullptr) {
-                        // out of memory
-                        LOG_TOPIC("5cd66", WARN, Logger::COMPACTOR)
-                            << "out of memory when trying to create compaction "
-                               "ditch";
-                      } else {
-                        try {
-                          bool wasBlocked = false;
-                          worked = compactCollection(collection.get(), wasBlocked);
-
-                          if (!worked && !wasBlocked) {
-                            // set compaction stamp
-                            physical->lastCompactionStamp(now);
-                          }
-                          // if we worked or were blocked, then we don't set the
-                          // compaction stamp to force another round of
-                          // compaction
-                        } catch (std::exception const& ex) {
-                          LOG_TOPIC("a9e71", ERR, Logger::COMPACTOR)
-                              << "caught exception during compaction: " << ex.what();
-                        } catch (...) {
-                          LOG_TOPIC("5f4c3", ERR, Logger::COMPACTOR)
-                              << "an unknown exception occurred during "
-                                 "compaction";
-                          // in case an error occurs, we must still free this
-                          // ditch
-                        }
-
-                        arangodb::MMFilesCollection::toMMFilesCollection(
-                            collection.get())
-                            ->ditches()
-                            ->freeDitch(ce);
-                      }
-                    }
-                  } catch (std::exception const& ex) {
-                    LOG_TOPIC("e38b9", ERR, Logger::COMPACTOR)
-                        << "caught exception during compaction: " << ex.what();
-                  } catch (...) {
-                    // in case an error occurs, we must still relase the lock
-                    LOG_TOPIC("e9a26", ERR, Logger::COMPACTOR)
-                        << "an unknown exception occurred during compaction";
-                  }
+                uint64_t bytes = 0;
+                if (compactCollectionIfDue(collection.get(), bytes)) {
+                  ++numCompacted;
                 }
-              };
+                bytesProcessed += bytes;
+              }
+              return;
+            }
 
-              if (!collection->tryExecuteWhileStatusLocked(callback)) {
-                continue;
+            // compact up to `threads` collections at a time
+            auto poster = [](std::function<void()> fn) -> void {
+              SchedulerFeature::SCHEDULER->queue(RequestLane::INTERNAL_LOW, fn);
+            };
+
+            for (size_t i = 0; i < collections.size(); i += threads) {
+              if (engine->isCompactionDisabled()) {
+                break;
               }
 
-              if (worked) {
-                ++numCompacted;
+              size_t const n = (std::min)(threads, collections.size() - i);
+              std::vector<uint64_t> bytes(n, 0);
+              std::vector<uint8_t> worked(n, 0);
+
+              auto queue = std::make_shared<arangodb::basics::LocalTaskQueue>(poster);
+              for (size_t j = 0; j < n; ++j) {
+                LogicalCollection* collection = collections[i + j].get();
+                queue->enqueue(std::make_shared<MMFilesCompactionTask>(
+                    queue, [this, collection, &bytes, &worked, j]() {
+                      worked[j] = compactCollectionIfDue(collection, bytes[j]) ? 1 : 0;
+                    }));
+              }
+              queue->dispatchAndWait();
 
-                // signal the cleanup thread that we worked and that it can now
-                // wake up
-                CONDITION_LOCKER(locker, _condition);
-                locker.signal();
+              for (size_t j = 0; j < n; ++j) {
+                numCompacted += worked[j];
+                bytesProcessed += bytes[j];
               }
             }
           },
           true);
 
+      // keep the I/O of all compactions within the configured bandwidth.
+      // the wait happens here and not during compaction, because compaction
+      // holds locks that block writes to the collection
+      double delay = MMFilesCompactionFeature::COMPACTOR->bandwidthDelay(bytesProcessed);
+      bytesProcessed = 0;
+      if (delay > 0.0) {
+        double const end = TRI_microtime() + delay;
+        while (delay > 0.0 && state != TRI_vocbase_t::State::SHUTDOWN_COMPACTOR &&
+               _vocbase.state() == TRI_vocbase_t::State::NORMAL && !isStopping()) {
+          CONDITION_LOCKER(locker, _condition);
+          _condition.wait(static_cast<uint64_t>(delay * 1000000.0));
+          delay = end - TRI_microtime();
+        }
+      }
+
       if (numCompacted > 0) {
         // no need to sleep long or go into wait state if we worked.
         // maybe there's still work left
@@ -90,11 +90,21 @@ class MMFilesCompactorThread final : public Thread {
                                                 LogicalCollection* collection,
                                                 std::vector<CompactionInfo> const& toCompact);
 
-  /// @brief compact the specified datafiles
-  void compactDatafiles(LogicalCollection* collection, std::vector<CompactionInfo> const&);
+  /// @brief compact the specified datafiles. returns the number of bytes
+  /// read and written
+  uint64_t compactDatafiles(LogicalCollection* collection, std::vector<CompactionInfo> const&);
 
   /// @brief checks all datafiles of a collection
-  bool compactCollection(LogicalCollection* collection, bool& wasBlocked);
+  bool compactCollection(LogicalCollection* collection, bool& wasBlocked,
+                         uint64_t& bytesProcessed);
+
+  /// @brief compacts a collection if it is loaded and its compaction
+  /// interval has passed. returns whether datafiles were compacted
+  bool compactCollectionIfDue(LogicalCollection* collection, uint64_t& bytesProcessed);
+
+  /// @brief orders collections by the share of dead data in their
+  /// datafiles, highest first
+  static void sortByDeadShare(std::vector<std::shared_ptr<LogicalCollection>>& collections);
 
   int removeCompactor(LogicalCollection* collection, MMFilesDatafile* datafile);
 
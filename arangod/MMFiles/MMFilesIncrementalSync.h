@@ -474,6 +474,7 @@ Result handleSyncKeysMMFiles(arangodb::DatabaseInitialSyncer& syncer,
       if (replutils::hasFailed(response.get())) {
         return buildHttpError(response.get(), url, syncer._state.connection);
       }
+      syncer.dataReceived(*response);
 
       TRI_ASSERT(response != nullptr);
 
@@ -661,6 +662,7 @@ Result handleSyncKeysMMFiles(arangodb::DatabaseInitialSyncer& syncer,
           if (replutils::hasFailed(response.get())) {
             return buildHttpError(response.get(), url, syncer._state.connection);
           }
+          syncer.dataReceived(*response);
 
           TRI_ASSERT(response != nullptr);
 
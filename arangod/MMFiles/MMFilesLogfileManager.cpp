@@ -45,6 +45,7 @@
 #include "MMFiles/MMFilesWalSlots.h"
 #include "ProgramOptions/ProgramOptions.h"
 #include "ProgramOptions/Section.h"
+#include "Replication/ReplicationClients.h"
 #include "RestServer/DatabaseFeature.h"
 #include "RestServer/DatabasePathFeature.h"
 #include "RestServer/FlushFeature.h"
@@ -52,6 +53,7 @@
 #include "StorageEngine/StorageEngine.h"
 #include "Transaction/ManagerFeature.h"
 #include "StorageEngine/TransactionState.h"
+#include "VocBase/vocbase.h"
 
 using namespace arangodb;
 using namespace arangodb::application_features;
@@ -1476,6 +1478,16 @@ MMFilesWalLogfile* MMFilesLogfileManager::getRemovableLogfile() {
   // take all barriers into account
   MMFilesWalLogfile::IdType const minBarrierTick = getMinBarrierTick();
 
+  // and the WAL subscriptions of all databases, which need all ticks after
+  // the one they have committed
+  TRI_voc_tick_t minSubscriptionTick = UINT64_MAX;
+  if (DatabaseFeature::DATABASE != nullptr) {
+    DatabaseFeature::DATABASE->enumerateDatabases([&minSubscriptionTick](TRI_vocbase_t& vocbase) -> void {
+      minSubscriptionTick = (std::min)(minSubscriptionTick,
+                                       vocbase.replicationClients().lowestCommittedTick());
+    });
+  }
+
   MMFilesWalLogfile::IdType minId = UINT64_MAX;
 
   // iterate over all active transactions and find their minimum used logfile id
@@ -1507,7 +1519,8 @@ MMFilesWalLogfile* MMFilesLogfileManager::getRemovableLogfile() {
 
       if (logfile->id() <= minId && logfile->canBeRemoved() &&
           (minBarrierTick == 0 || (logfile->df()->_tickMin < minBarrierTick &&
-                                   logfile->df()->_tickMax < minBarrierTick))) {
+                                   logfile->df()->_tickMax < minBarrierTick)) &&
+          logfile->df()->_tickMax <= minSubscriptionTick) {
         // only check those logfiles that are outside the ranges specified by
         // barriers
 
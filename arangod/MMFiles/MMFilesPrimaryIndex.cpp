@@ -252,6 +252,13 @@ MMFilesPrimaryIndex::MMFilesPrimaryIndex(arangodb::LogicalCollection& collection
 /// @brief return the number of documents from the index
 size_t MMFilesPrimaryIndex::size() const { return _primaryIndex->size(); }
 
+size_t MMFilesPrimaryIndex::buckets() const { return _primaryIndex->buckets(); }
+
+size_t MMFilesPrimaryIndex::bucketId(VPackSlice const& key) const {
+  TRI_ASSERT(key.isString());
+  return _primaryIndex->bucketId(key.begin());
+}
+
 /// @brief return the memory usage of the index
 size_t MMFilesPrimaryIndex::memory() const {
   return _primaryIndex->memoryUsage();
@@ -207,6 +207,13 @@ class MMFilesPrimaryIndex final : public MMFilesIndex {
 
   size_t size() const;
 
+  /// @brief number of independent buckets of the index
+  size_t buckets() const;
+
+  /// @brief bucket the given key is stored in. keys in different buckets
+  /// can be inserted and removed concurrently while the collection is opened
+  size_t bucketId(arangodb::velocypack::Slice const& key) const;
+
   size_t memory() const override;
 
   void toVelocyPack(VPackBuilder&, std::underlying_type<Index::Serialize>::type) const override;
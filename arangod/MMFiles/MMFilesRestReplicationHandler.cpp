@@ -913,6 +913,13 @@ void MMFilesRestReplicationHandler::handleCommandDump() {
     return;
   }
 
+  if (_request->parsedValue("partitions", static_cast<uint64_t>(1)) > 1) {
+    // the datafiles cannot be split into key ranges
+    generateError(rest::ResponseCode::NOT_IMPLEMENTED, TRI_ERROR_NOT_IMPLEMENTED,
+                  "partitioned dumps are not supported by this storage engine");
+    return;
+  }
+
   bool includeSystem = _request->parsedValue("includeSystem", true);
   bool withTicks = _request->parsedValue("ticks", true);
 
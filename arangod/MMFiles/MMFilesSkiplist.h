@@ -25,6 +25,7 @@
 #define ARANGOD_MMFILES_SKIP_LIST_H 1
 
 #include "Basics/Common.h"
+#include "Basics/Exceptions.h"
 #include "Random/RandomGenerator.h"
 
 #include <velocypack/Builder.h>
@@ -45,37 +46,159 @@ class MMFilesSkiplist;
 template <class Key, class Element>
 class MMFilesSkiplistNode {
   friend class MMFilesSkiplist<Key, Element>;
-  MMFilesSkiplistNode<Key, Element>** _next;
-  MMFilesSkiplistNode<Key, Element>* _prev;
+  typedef MMFilesSkiplistNode<Key, Element> Node;
+
   Element* _doc;
+  std::atomic<Node*> _prev;
   int _height;
+  // followed by the tower of _height next pointers, so that the document
+  // and the lowest levels share a cache line with the node header
+
+  std::atomic<Node*>* tower() const {
+    return reinterpret_cast<std::atomic<Node*>*>(const_cast<Node*>(this) + 1);
+  }
+
+  Node* next(int lev) const {
+    return tower()[lev].load(std::memory_order_acquire);
+  }
+
+  void setNext(int lev, Node* node) {
+    tower()[lev].store(node, std::memory_order_release);
+  }
 
  public:
-  MMFilesSkiplistNode<Key, Element>(int height, char* ptr)
-      : _next(reinterpret_cast<MMFilesSkiplistNode<Key, Element>**>(
-            ptr + sizeof(MMFilesSkiplistNode<Key, Element>))),
-        _prev(nullptr),
-        _doc(nullptr),
-        _height(height) {
+  explicit MMFilesSkiplistNode(int height)
+      : _doc(nullptr), _prev(nullptr), _height(height) {
     for (int i = 0; i < _height; i++) {
-      _next[i] = nullptr;
+      new (&tower()[i]) std::atomic<Node*>(nullptr);
     }
   }
 
+  /// @brief number of bytes needed for a node of the given height
+  static size_t byteSize(int height) {
+    return sizeof(Node) + sizeof(std::atomic<Node*>) * height;
+  }
+
   Element* document() const { return _doc; }
 
-  MMFilesSkiplistNode<Key, Element>* nextNode() const {
-    if (_height == 0) {
-      // _next[0] is uninitialized
-      return nullptr;
-    }
-    return _next[0];
-  }
+  Node* nextNode() const { return next(0); }
 
   // Note that the prevNode of the first data node is the artificial
   // _start node not containing data. This is contrary to the prevNode
   // method of the MMFilesSkiplist class, which returns nullptr in that case.
-  MMFilesSkiplistNode<Key, Element>* prevNode() const { return _prev; }
+  Node* prevNode() const { return _prev.load(std::memory_order_acquire); }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief memory for the nodes of a skiplist
+///
+/// Nodes are carved out of cache-line aligned blocks instead of being
+/// allocated one by one. The first block is small, so that the many indexes
+/// of small collections stay cheap, and each further block is twice as large
+/// as the previous one, up to MaxBlockSize. Node sizes are rounded to 32 bytes or to multiples
+/// of 64 bytes, so nodes of up to 64 bytes (all nodes of height 5 or less)
+/// never span two cache lines. Freed nodes are kept in a free list per size
+/// and reused, the blocks are only released all at once.
+////////////////////////////////////////////////////////////////////////////////
+
+class MMFilesSkiplistArena {
+ public:
+  static constexpr size_t CacheLineSize = 64;
+  static constexpr size_t MinBlockSize = 4 * 1024;
+  static constexpr size_t MaxBlockSize = 1024 * 1024;
+  static constexpr size_t MaxSize = 512;
+
+  static_assert(MaxSize <= MinBlockSize, "a block must hold the largest node");
+
+  MMFilesSkiplistArena()
+      : _current(nullptr), _remaining(0), _nextBlockSize(MinBlockSize), _memoryUsed(0) {
+    for (auto& it : _freeLists) {
+      it = nullptr;
+    }
+  }
+
+  ~MMFilesSkiplistArena() { clear(); }
+
+  MMFilesSkiplistArena(MMFilesSkiplistArena const&) = delete;
+  MMFilesSkiplistArena& operator=(MMFilesSkiplistArena const&) = delete;
+
+  static constexpr size_t roundedSize(size_t size) {
+    return size <= CacheLineSize / 2 ? CacheLineSize / 2
+                                     : (size + CacheLineSize - 1) & ~(CacheLineSize - 1);
+  }
+
+  void* allocate(size_t size) {
+    size = roundedSize(size);
+    TRI_ASSERT(size <= MaxSize);
+    void*& freeList = _freeLists[freeListIndex(size)];
+
+    if (freeList != nullptr) {
+      void* ptr = freeList;
+      freeList = *static_cast<void**>(ptr);
+      return ptr;
+    }
+
+    if (_remaining < size) {
+      // the rest of the current block is lost
+      size_t const blockSize = _nextBlockSize;
+      void* block = TRI_Allocate(blockSize + CacheLineSize);
+      if (block == nullptr) {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+      }
+      try {
+        _blocks.emplace_back(block);
+      } catch (...) {
+        TRI_Free(block);
+        throw;
+      }
+      uintptr_t aligned = (reinterpret_cast<uintptr_t>(block) + CacheLineSize - 1) &
+                          ~(static_cast<uintptr_t>(CacheLineSize) - 1);
+      _current = reinterpret_cast<char*>(aligned);
+      _remaining = blockSize;
+      _memoryUsed += blockSize + CacheLineSize;
+      _nextBlockSize = 2 * blockSize < MaxBlockSize ? 2 * blockSize : MaxBlockSize;
+    }
+
+    void* ptr = _current;
+    _current += size;
+    _remaining -= size;
+    return ptr;
+  }
+
+  void free(void* ptr, size_t size) {
+    void*& freeList = _freeLists[freeListIndex(roundedSize(size))];
+    *static_cast<void**>(ptr) = freeList;
+    freeList = ptr;
+  }
+
+  /// @brief release all blocks at once, all nodes become invalid
+  void clear() {
+    for (void* block : _blocks) {
+      TRI_Free(block);
+    }
+    _blocks.clear();
+    for (auto& it : _freeLists) {
+      it = nullptr;
+    }
+    _current = nullptr;
+    _remaining = 0;
+    _nextBlockSize = MinBlockSize;
+    _memoryUsed = 0;
+  }
+
+  size_t memoryUsage() const { return _memoryUsed; }
+
+ private:
+  static constexpr size_t freeListIndex(size_t roundedSize) {
+    return roundedSize / (CacheLineSize / 2);
+  }
+
+  std::vector<void*> _blocks;
+  void* _freeLists[MaxSize / (CacheLineSize / 2) + 1];
+  char* _current;
+  size_t _remaining;
+  size_t _nextBlockSize;
+  size_t _memoryUsed;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -88,13 +211,25 @@ enum MMFilesSkiplistCmpType { SKIPLIST_CMP_PREORDER, SKIPLIST_CMP_TOTORDER };
 /// @brief type of a skiplist
 /// _end always points to the last node in the skiplist, this can be the
 /// same as the _start node. If a node does not have a successor on a certain
-/// level, then the corresponding _next pointer is a nullptr.
+/// level, then the corresponding next pointer is a nullptr.
+///
+/// Lookups and iteration may run concurrently with one thread inserting:
+/// a new node is completely initialized before it is linked in, and all
+/// links are published with release stores and followed with acquire loads,
+/// so readers either see the node in a consistent state or not at all.
+/// Removals and truncate still require exclusive access, because the memory
+/// of removed nodes is reused for later inserts.
 ////////////////////////////////////////////////////////////////////////////////
 
 template <class Key, class Element>
 class MMFilesSkiplist {
   typedef MMFilesSkiplistNode<Key, Element> Node;
 
+  static_assert(MMFilesSkiplistArena::roundedSize(sizeof(Node) + sizeof(std::atomic<Node*>) *
+                                                                     TRI_SKIPLIST_MAX_HEIGHT) <=
+                    MMFilesSkiplistArena::MaxSize,
+                "skiplist nodes must fit into the arena size classes");
+
  public:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief type of a function pointer to a comparison function for a skiplist.
@@ -124,17 +259,19 @@ class MMFilesSkiplist {
   typedef std::function<void(Element*)> FreeElementFuncType;
 
  private:
+  MMFilesSkiplistArena _arena;
   Node* _start;
-  Node* _end;
+  std::atomic<Node*> _end;
+  std::atomic<int> _maxHeight;  // number of levels in use, the start node
+                                // always has TRI_SKIPLIST_MAX_HEIGHT levels
   CmpElmElmFuncType _cmp_elm_elm;
   CmpKeyElmFuncType _cmp_key_elm;
   FreeElementFuncType _free;
   bool _unique;  // indicates whether multiple entries that
                  // are equal in the preorder are allowed in
-  uint64_t _nrUsed;
+  std::atomic<uint64_t> _nrUsed;
   bool _isArray;  // indicates whether this index is used to
                   // index arrays.
-  size_t _memoryUsed;
 
  public:
   //////////////////////////////////////////////////////////////////////////////
@@ -146,22 +283,18 @@ class MMFilesSkiplist {
 
   MMFilesSkiplist(CmpElmElmFuncType cmp_elm_elm, CmpKeyElmFuncType cmp_key_elm,
                   FreeElementFuncType freefunc, bool unique, bool isArray)
-      : _cmp_elm_elm(cmp_elm_elm),
+      : _start(nullptr),
+        _end(nullptr),
+        _maxHeight(1),
+        _cmp_elm_elm(cmp_elm_elm),
         _cmp_key_elm(cmp_key_elm),
         _free(freefunc),
         _unique(unique),
         _nrUsed(0),
         _isArray(isArray) {
-    // Set the initial memory
-    _memoryUsed = sizeof(MMFilesSkiplist);
-
     _start = allocNode(TRI_SKIPLIST_MAX_HEIGHT);
     // Note that this can throw
     _end = _start;
-
-    _start->_height = 1;
-    _start->_next[0] = nullptr;
-    _start->_prev = nullptr;
   }
 
   //////////////////////////////////////////////////////////////////////////////
@@ -176,22 +309,17 @@ class MMFilesSkiplist {
   }
 
   void truncate(bool createStartNode) {
-    Node* p;
-    Node* next;
-
-    // First call free for all documents and free all nodes other than start:
-    p = _start->_next[0];
-    while (nullptr != p) {
-      if (nullptr != _free) {
+    // First call free for all documents, then release all nodes at once:
+    if (nullptr != _free && nullptr != _start) {
+      for (Node* p = _start->next(0); nullptr != p; p = p->next(0)) {
         _free(p->_doc);
       }
-      next = p->_next[0];
-      freeNode(p);
-      p = next;
     }
-    freeNode(_start);
+    _arena.clear();
 
-    _memoryUsed = sizeof(MMFilesSkiplist);
+    _start = nullptr;
+    _end = nullptr;
+    _maxHeight = 1;
     _nrUsed = 0;
 
     if (createStartNode) {
@@ -223,7 +351,7 @@ class MMFilesSkiplist {
   /// @brief return the successor node or nullptr if last node
   //////////////////////////////////////////////////////////////////////////////
 
-  Node* nextNode(Node* node) const { return node->_next[0]; }
+  Node* nextNode(Node* node) const { return node->next(0); }
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief return the predecessor node or _startNode() if first node,
@@ -232,7 +360,7 @@ class MMFilesSkiplist {
   //////////////////////////////////////////////////////////////////////////////
 
   Node* prevNode(Node* node) const {
-    return nullptr == node ? _end : node->_prev;
+    return nullptr == node ? _end.load(std::memory_order_acquire) : node->prevNode();
   }
 
   //////////////////////////////////////////////////////////////////////////////
@@ -280,34 +408,40 @@ class MMFilesSkiplist {
       return TRI_ERROR_OUT_OF_MEMORY;
     }
 
-    if (newNode->_height > _start->_height) {
+    int const maxHeight = _maxHeight.load(std::memory_order_relaxed);
+    if (newNode->_height > maxHeight) {
       // The new levels where not considered in the above search,
       // therefore pos is not set on these levels.
-      for (lev = _start->_height; lev < newNode->_height; lev++) {
+      for (lev = maxHeight; lev < newNode->_height; lev++) {
         pos[lev] = _start;
       }
       // Note that _start is already initialized with nullptr to the top!
-      _start->_height = newNode->_height;
+      // Readers that see the new height before the links below simply
+      // find nullptr on the new levels and go down.
+      _maxHeight.store(newNode->_height, std::memory_order_relaxed);
     }
 
+    // Initialize the new node completely before it becomes reachable:
     newNode->_doc = doc;
+    newNode->_prev.store(pos[0], std::memory_order_relaxed);
+    for (lev = 0; lev < newNode->_height; lev++) {
+      newNode->tower()[lev].store(pos[lev]->next(lev), std::memory_order_relaxed);
+    }
 
-    // Now insert between newNode and next:
-    newNode->_next[0] = pos[0]->_next[0];
-    pos[0]->_next[0] = newNode;
-    newNode->_prev = pos[0];
-    if (newNode->_next[0] == nullptr) {
+    // Now insert between pos[0] and next:
+    pos[0]->setNext(0, newNode);
+    Node* successor = newNode->next(0);
+    if (successor == nullptr) {
       // a new last node
-      _end = newNode;
+      _end.store(newNode, std::memory_order_release);
     } else {
-      newNode->_next[0]->_prev = newNode;
+      successor->_prev.store(newNode, std::memory_order_release);
     }
 
     // Now the element is successfully inserted, the rest is performance
     // optimization:
     for (lev = 1; lev < newNode->_height; lev++) {
-      newNode->_next[lev] = pos[lev]->_next[lev];
-      pos[lev]->_next[lev] = newNode;
+      pos[lev]->setNext(lev, newNode);
     }
 
     _nrUsed++;
@@ -350,13 +484,14 @@ class MMFilesSkiplist {
       // skiplist as long as we are at a level > 0, only some optimizations
       // in performance vanish before that. Only when we have removed it at
       // level 0, it is really gone.
-      pos[lev]->_next[lev] = next->_next[lev];
+      pos[lev]->setNext(lev, next->next(lev));
     }
-    if (next->_next[0] == nullptr) {
+    Node* successor = next->next(0);
+    if (successor == nullptr) {
       // We were the last, so adjust _end
-      _end = next->_prev;
+      _end.store(next->prevNode(), std::memory_order_release);
     } else {
-      next->_next[0]->_prev = next->_prev;
+      successor->_prev.store(next->prevNode(), std::memory_order_release);
     }
 
     freeNode(next);
@@ -370,13 +505,13 @@ class MMFilesSkiplist {
   /// @brief returns the number of entries in the skiplist.
   //////////////////////////////////////////////////////////////////////////////
 
-  uint64_t getNrUsed() const { return _nrUsed; }
+  uint64_t getNrUsed() const { return _nrUsed.load(std::memory_order_relaxed); }
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief returns the memory used by the index
   //////////////////////////////////////////////////////////////////////////////
 
-  size_t memoryUsage() const { return _memoryUsed; }
+  size_t memoryUsage() const { return sizeof(MMFilesSkiplist) + _arena.memoryUsage(); }
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief returns if this indexed is used for arrays
@@ -389,7 +524,7 @@ class MMFilesSkiplist {
   //////////////////////////////////////////////////////////////////////////////
 
   void appendToVelocyPack(VPackBuilder& builder) {
-    builder.add("nrUsed", VPackValue(_nrUsed));
+    builder.add("nrUsed", VPackValue(getNrUsed()));
   }
 
   //////////////////////////////////////////////////////////////////////////////
@@ -507,27 +642,11 @@ class MMFilesSkiplist {
       height = RandomHeight();
     }
 
-    // allocate enough memory for skiplist node plus all the next nodes in one
-    // go
-    void* ptr = TRI_Allocate(sizeof(Node) + sizeof(Node*) * height);
-
-    if (ptr == nullptr) {
-      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-    }
-
-    Node* newNode;
-
-    try {
-      // use placement new
-      newNode = new (ptr) Node(height, static_cast<char*>(ptr));
-    } catch (...) {
-      TRI_Free(ptr);
-      throw;
-    }
-
-    _memoryUsed += sizeof(Node) + sizeof(Node*) * newNode->_height;
+    // the node and its tower of next pointers are allocated in one go
+    void* ptr = _arena.allocate(Node::byteSize(height));
 
-    return newNode;
+    // use placement new, this cannot throw
+    return new (ptr) Node(height);
   }
 
   //////////////////////////////////////////////////////////////////////////////
@@ -535,13 +654,12 @@ class MMFilesSkiplist {
   //////////////////////////////////////////////////////////////////////////////
 
   void freeNode(Node* node) {
-    // update memory usage
-    _memoryUsed -= sizeof(Node) + sizeof(Node*) * node->_height;
+    size_t const size = Node::byteSize(node->_height);
 
     // we have used placement new to construct the skiplist node,
-    // so now we have to manually call its dtor and free the underlying memory
+    // so now we have to manually call its dtor and give back the memory
     node->~Node();
-    TRI_Free(node);
+    _arena.free(node, size);
   }
 
   //////////////////////////////////////////////////////////////////////////////
@@ -567,9 +685,9 @@ class MMFilesSkiplist {
     int cmp = 0;  // just in case to avoid undefined values
 
     Node* cur = _start;
-    for (lev = _start->_height - 1; lev >= 0; lev--) {
+    for (lev = _maxHeight.load(std::memory_order_relaxed) - 1; lev >= 0; lev--) {
       while (true) {  // will be left by break
-        *next = cur->_next[lev];
+        *next = cur->next(lev);
         if (nullptr == *next) {
           break;
         }
@@ -595,7 +713,7 @@ class MMFilesSkiplist {
   /// and proper order comparison if cmp is SKIPLIST_CMP_TOTORDER. At the end,
   /// (*pos)[0] points to the node containing m and *next points to the
   /// node following (*pos)[0], or is nullptr if there is no such node. The
-  /// array *pos contains for each level lev in 0.._start->_height-1
+  /// array *pos contains for each level lev in 0.._maxHeight-1
   /// at (*pos)[lev] the pointer to the node that contains the largest
   /// document that is less than or equal to doc amongst those nodes
   /// that have height > lev.
@@ -608,9 +726,9 @@ class MMFilesSkiplist {
     int cmp = 0;  // just in case to avoid undefined values
 
     Node* cur = _start;
-    for (lev = _start->_height - 1; lev >= 0; lev--) {
+    for (lev = _maxHeight.load(std::memory_order_relaxed) - 1; lev >= 0; lev--) {
       while (true) {  // will be left by break
-        *next = cur->_next[lev];
+        *next = cur->next(lev);
         if (nullptr == *next) {
           break;
         }
@@ -642,9 +760,9 @@ class MMFilesSkiplist {
     int cmp = 0;  // just in case to avoid undefined values
 
     Node* cur = _start;
-    for (lev = _start->_height - 1; lev >= 0; lev--) {
+    for (lev = _maxHeight.load(std::memory_order_relaxed) - 1; lev >= 0; lev--) {
       while (true) {  // will be left by break
-        *next = cur->_next[lev];
+        *next = cur->next(lev);
         if (nullptr == *next) {
           break;
         }
@@ -672,9 +790,9 @@ class MMFilesSkiplist {
     int cmp = 0;  // just in case to avoid undefined values
 
     Node* cur = _start;
-    for (lev = _start->_height - 1; lev >= 0; lev--) {
+    for (lev = _maxHeight.load(std::memory_order_relaxed) - 1; lev >= 0; lev--) {
       while (true) {  // will be left by break
-        *next = cur->_next[lev];
+        *next = cur->next(lev);
         if (nullptr == *next) {
           break;
         }
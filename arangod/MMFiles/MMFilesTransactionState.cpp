@@ -174,7 +174,7 @@ Result MMFilesTransactionState::commitTransaction(transaction::Methods* activeTr
 
     // if a write query, clear the query cache for the participating collections
     if (AccessMode::isWriteOrExclusive(_type) && !_collections.empty() &&
-        !isSingleOperation() && arangodb::aql::QueryCache::instance()->mayBeActive()) {
+        arangodb::aql::QueryCache::instance()->mayBeActive()) {
       clearQueryCache();
     }
 
@@ -352,11 +352,8 @@ int MMFilesTransactionState::addOperation(LocalDocumentId const& documentId,
     _hasOperations = true;
   }
 
-  auto queryCache = arangodb::aql::QueryCache::instance();
-
-  if (queryCache->mayBeActive()) {
-    queryCache->invalidate(&_vocbase, collection->guid());
-  }
+  // the query cache for this collection is cleared on commit
+  trackOperation(collection->id());
 
   physical->setRevision(revisionId, false);
 
@@ -245,9 +245,8 @@ struct MMFilesWalAccessContext : WalAccessContext {
 
     // finally check if the marker is for a collection that we want to ignore
     if (datasourceId != 0) {
-      if (_filter.collection != 0 &&
-          (datasourceId != _filter.collection && !isTransactionWalMarker(marker))) {
-        // restrict output to a single collection, but a different one
+      if (!_filter.includesCollection(datasourceId) && !isTransactionWalMarker(marker)) {
+        // restrict output to some collections, but a different one
         return false;
       }
       if (!isViewWalMarker(marker)) {
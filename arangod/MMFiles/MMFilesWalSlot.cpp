@@ -33,7 +33,7 @@ MMFilesWalSlot::MMFilesWalSlot()
 
 /// @brief return the slot status as a string
 std::string MMFilesWalSlot::statusText() const {
-  switch (_status) {
+  switch (_status.load()) {
     case StatusType::UNUSED:
       return "unused";
     case StatusType::USED:
@@ -127,7 +127,7 @@ void MMFilesWalSlot::setUnused() {
   _logfile = nullptr;
   _mem = nullptr;
   _size = 0;
-  _status = StatusType::UNUSED;
+  _status.store(StatusType::UNUSED, std::memory_order_release);
 }
 
 /// @brief mark as slot as used
@@ -139,16 +139,13 @@ void MMFilesWalSlot::setUsed(void* mem, uint32_t size, MMFilesWalLogfile* logfil
   _logfile = logfile;
   _mem = mem;
   _size = size;
-  _status = StatusType::USED;
+  _status.store(StatusType::USED, std::memory_order_release);
 }
 
 /// @brief mark as slot as returned
 void MMFilesWalSlot::setReturned(bool waitForSync) {
   TRI_ASSERT(_logfile != nullptr);
   TRI_ASSERT(isUsed());
-  if (waitForSync) {
-    _status = StatusType::RETURNED_WFS;
-  } else {
-    _status = StatusType::RETURNED;
-  }
+  _status.store(waitForSync ? StatusType::RETURNED_WFS : StatusType::RETURNED,
+                std::memory_order_release);
 }
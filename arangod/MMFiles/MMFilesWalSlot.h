@@ -47,7 +47,9 @@ class MMFilesWalSlot {
   };
 
   /// @brief create a slot
+#ifndef ARANGODB_USE_CATCH_TESTS
  private:
+#endif
   MMFilesWalSlot();
 
  public:
@@ -82,21 +84,28 @@ class MMFilesWalSlot {
   /// the source region) and copy the calculated marker data into the slot
   void fill(void*, size_t);
 
+#ifndef ARANGODB_USE_CATCH_TESTS
  private:
+#endif
   /// @brief whether or not the slot is unused
-  inline bool isUnused() const { return _status == StatusType::UNUSED; }
+  inline bool isUnused() const {
+    return _status.load(std::memory_order_acquire) == StatusType::UNUSED;
+  }
 
   /// @brief whether or not the slot is used
-  inline bool isUsed() const { return _status == StatusType::USED; }
+  inline bool isUsed() const {
+    return _status.load(std::memory_order_acquire) == StatusType::USED;
+  }
 
   /// @brief whether or not the slot is returned
   inline bool isReturned() const {
-    return (_status == StatusType::RETURNED || _status == StatusType::RETURNED_WFS);
+    StatusType status = _status.load(std::memory_order_acquire);
+    return (status == StatusType::RETURNED || status == StatusType::RETURNED_WFS);
   }
 
   /// @brief whether or not a sync was requested for the slot
   inline bool waitForSync() const {
-    return (_status == StatusType::RETURNED_WFS);
+    return (_status.load(std::memory_order_acquire) == StatusType::RETURNED_WFS);
   }
 
   /// @brief mark as slot as unused
@@ -105,7 +114,9 @@ class MMFilesWalSlot {
   /// @brief mark as slot as used
   void setUsed(void*, uint32_t, MMFilesWalLogfile*, MMFilesWalSlot::TickType);
 
-  /// @brief mark as slot as returned
+  /// @brief mark as slot as returned. this is the only status change that
+  /// is made without holding the slots lock. it publishes the marker data
+  /// written into the slot to the synchronizer thread
   void setReturned(bool waitForSync);
 
  private:
@@ -126,7 +137,7 @@ class MMFilesWalSlot {
   uint32_t _size;
 
   /// @brief slot status
-  StatusType _status;
+  std::atomic<StatusType> _status;
 };
 
 static_assert(sizeof(MMFilesWalSlot) == 32, "invalid slot size");
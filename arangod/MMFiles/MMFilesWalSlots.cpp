@@ -37,11 +37,31 @@ using namespace arangodb;
 static uint32_t const PrologueSize =
     encoding::alignedSize<uint32_t>(sizeof(MMFilesPrologueMarker));
 
+/// @brief extend the tick range of a logfile by the tick of a data marker
+static void UpdateTickRange(MMFilesWalLogfile* logfile, TRI_voc_tick_t tick) {
+  MMFilesDatafile* datafile = logfile->df();
+
+  if (datafile->_tickMin == 0) {
+    datafile->_tickMin = tick;
+  }
+  if (datafile->_tickMax < tick) {
+    datafile->_tickMax = tick;
+  }
+  if (datafile->_dataMin == 0) {
+    datafile->_dataMin = tick;
+  }
+  if (datafile->_dataMax < tick) {
+    datafile->_dataMax = tick;
+  }
+}
+
 /// @brief create the slots
 MMFilesWalSlots::MMFilesWalSlots(MMFilesLogfileManager* logfileManager,
                                  size_t numberOfSlots, MMFilesWalSlot::TickType tick)
     : _logfileManager(logfileManager),
       _condition(),
+      _syncCondition(),
+      _syncWaiters(0),
       _lock(),
       _slots(nullptr),
       _numberOfSlots(numberOfSlots),
@@ -75,7 +95,6 @@ void MMFilesWalSlots::statistics(MMFilesWalSlot::TickType& lastAssignedTick,
                                  MMFilesWalSlot::TickType& lastCommittedTick,
                                  MMFilesWalSlot::TickType& lastCommittedDataTick,
                                  uint64_t& numEvents, uint64_t& numEventsSync) {
-  MUTEX_LOCKER(mutexLocker, _lock);
   lastAssignedTick = _lastAssignedTick;
   lastCommittedTick = _lastCommittedTick;
   lastCommittedDataTick = _lastCommittedDataTick;
@@ -132,8 +151,7 @@ int MMFilesWalSlots::flush(bool waitForSync) {
 
 /// @brief return the last committed tick
 MMFilesWalSlot::TickType MMFilesWalSlots::lastCommittedTick() {
-  MUTEX_LOCKER(mutexLocker, _lock);
-  return _lastCommittedTick;
+  return _lastCommittedTick.load(std::memory_order_acquire);
 }
 
 /// @brief return the next unused slot
@@ -283,6 +301,10 @@ MMFilesWalSlotInfo MMFilesWalSlots::nextUnused(TRI_voc_tick_t databaseId,
         // only in this case we return a valid slot
         slot->setUsed(static_cast<void*>(mem), size, _logfile, handout());
 
+        // account for the tick in the logfile's tick range right away, so
+        // returning the slot later does not need the lock
+        UpdateTickRange(_logfile, slot->tick());
+
         return MMFilesWalSlotInfo(slot);
       }
     }
@@ -295,13 +317,7 @@ MMFilesWalSlotInfo MMFilesWalSlots::nextUnused(TRI_voc_tick_t databaseId,
       hasWaited = true;
     }
 
-    bool mustWait;
-    {
-      MUTEX_LOCKER(mutexLocker, _lock);
-      mustWait = (_freeSlots < 2);
-    }
-
-    if (mustWait) {
+    if (_freeSlots.load() < 2) {
       guard.wait(10 * 1000);
     }
   }
@@ -317,23 +333,21 @@ int MMFilesWalSlots::returnUsed(MMFilesWalSlotInfo& slotInfo, bool wakeUpSynchro
   TRI_ASSERT(!waitUntilSyncDone || waitForSyncRequested);
 
   MMFilesWalSlot::TickType tick = slotInfo.slot->tick();
-  MMFilesMarker const* marker =
-      reinterpret_cast<MMFilesMarker const*>(slotInfo.slot->mem());
-  MMFilesWalLogfile const* logfile = slotInfo.logfile;
 
   TRI_ASSERT(tick > 0);
 
-  {
-    MUTEX_LOCKER(mutexLocker, _lock);
-    TRI_UpdateTicksDatafile(logfile->df(), marker);
-    slotInfo.slot->setReturned(waitForSyncRequested);
-    if (waitForSyncRequested) {
-      ++_numEventsSync;
-    } else {
-      ++_numEvents;
-    }
+  if (waitForSyncRequested) {
+    _numEventsSync.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    _numEvents.fetch_add(1, std::memory_order_relaxed);
   }
 
+  // no lock needed here: the slot is owned by the caller until it is marked
+  // as returned, and the logfile tick range was already updated on handout.
+  // the synchronizer picks the slot up in getSyncRegion(). the slot must
+  // not be accessed anymore afterwards
+  slotInfo.slot->setReturned(waitForSyncRequested);
+
   wakeUpSynchronizer |= waitForSyncRequested;
   wakeUpSynchronizer |= waitUntilSyncDone;
 
@@ -444,8 +458,8 @@ void MMFilesWalSlots::returnSyncRegion(MMFilesWalSyncRegion const& region) {
 
       // note last tick
       MMFilesWalSlot::TickType tick = slot->tick();
-      TRI_ASSERT(tick >= _lastCommittedTick);
-      _lastCommittedTick = tick;
+      TRI_ASSERT(tick >= _lastCommittedTick.load());
+      _lastCommittedTick.store(tick, std::memory_order_release);
 
       // update the data tick
       MMFilesMarker const* m = static_cast<MMFilesMarker const*>(slot->mem());
@@ -473,10 +487,20 @@ void MMFilesWalSlots::returnSyncRegion(MMFilesWalSyncRegion const& region) {
     }
   }
 
-  // signal that we have done something
+  // wake up the threads waiting for their ticks to be synced. they all
+  // check the new committed tick, so a single sync serves all of them
+  {
+    CONDITION_LOCKER(guard, _syncCondition);
+
+    if (_syncWaiters > 0) {
+      guard.broadcast();
+    }
+  }
+
+  // signal that there are free slots again
   CONDITION_LOCKER(guard, _condition);
 
-  if (_waiting > 0 || region.waitForSync) {
+  if (_waiting > 0) {
     _condition.broadcast();
   }
 }
@@ -516,7 +540,7 @@ int MMFilesWalSlots::closeLogfile(MMFilesWalSlot::TickType& lastCommittedTick, b
     {
       MUTEX_LOCKER(mutexLocker, _lock);
 
-      lastCommittedTick = _lastCommittedTick;
+      lastCommittedTick = _lastCommittedTick.load();
 
       MMFilesWalSlot* slot = &_slots[_handoutIndex];
       TRI_ASSERT(slot != nullptr);
@@ -606,13 +630,7 @@ int MMFilesWalSlots::closeLogfile(MMFilesWalSlot::TickType& lastCommittedTick, b
       hasWaited = true;
     }
 
-    bool mustWait;
-    {
-      MUTEX_LOCKER(mutexLocker, _lock);
-      mustWait = (_freeSlots < 2);
-    }
-
-    if (mustWait) {
+    if (_freeSlots.load() < 2) {
       guard.wait(10 * 1000);
     }
 
@@ -719,18 +737,27 @@ bool MMFilesWalSlots::waitForTick(MMFilesWalSlot::TickType tick) {
   static uint64_t const SleepTime = 10000;
   static int const MaxIterations = 30 * 1000 * 1000 / SleepTime;
   int iterations = 0;
+  bool synced = false;
 
-  // wait until data has been committed to disk
+  CONDITION_LOCKER(guard, _syncCondition);
+  ++_syncWaiters;
+
+  // wait until data has been committed to disk. returnSyncRegion() updates
+  // the committed tick before it acquires _syncCondition, so a wakeup
+  // cannot get lost between the check and the wait
   do {
     if (lastCommittedTick() >= tick) {
-      return true;
+      synced = true;
+      break;
     }
 
-    CONDITION_LOCKER(guard, _condition);
     guard.wait(SleepTime);
   } while (++iterations < MaxIterations);
 
-  return false;
+  TRI_ASSERT(_syncWaiters > 0);
+  --_syncWaiters;
+
+  return synced;
 }
 
 /// @brief request a new logfile which can satisfy a marker of the
@@ -159,7 +159,16 @@ class MMFilesWalSlots {
   /// @brief condition variable for slots
   basics::ConditionVariable _condition;
 
-  /// @brief mutex protecting the slots interface
+  /// @brief condition variable for threads waiting for their ticks to be
+  /// synced. the synchronizer thread broadcasts it after each sync region
+  basics::ConditionVariable _syncCondition;
+
+  /// @brief number of threads waiting on _syncCondition, protected by it
+  uint32_t _syncWaiters;
+
+  /// @brief mutex protecting the handout of slots and logfile switches.
+  /// slots are returned without it, the statistics and committed ticks
+  /// are atomics and can also be read without it
   Mutex _lock;
 
   /// @brief all slots
@@ -169,7 +178,7 @@ class MMFilesWalSlots {
   size_t const _numberOfSlots;
 
   /// @brief the number of currently free slots
-  size_t _freeSlots;
+  std::atomic<size_t> _freeSlots;
 
   /// @brief whether or not someone is waiting for a slot
   uint32_t _waiting;
@@ -184,19 +193,19 @@ class MMFilesWalSlots {
   MMFilesWalLogfile* _logfile;
 
   /// @brief last assigned tick value
-  MMFilesWalSlot::TickType _lastAssignedTick;
+  std::atomic<MMFilesWalSlot::TickType> _lastAssignedTick;
 
   /// @brief last committed tick value
-  MMFilesWalSlot::TickType _lastCommittedTick;
+  std::atomic<MMFilesWalSlot::TickType> _lastCommittedTick;
 
   /// @brief last committed data tick value
-  MMFilesWalSlot::TickType _lastCommittedDataTick;
+  std::atomic<MMFilesWalSlot::TickType> _lastCommittedDataTick;
 
   /// @brief number of log events handled
-  uint64_t _numEvents;
+  std::atomic<uint64_t> _numEvents;
 
   /// @brief number of sync log events handled
-  uint64_t _numEventsSync;
+  std::atomic<uint64_t> _numEventsSync;
 
   /// @brief last written database id (in prologue marker)
   TRI_voc_tick_t _lastDatabaseId;
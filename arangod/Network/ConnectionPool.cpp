@@ -0,0 +1,184 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "ConnectionPool.h"
+
+#include "Basics/Exceptions.h"
+#include "Basics/ReadLocker.h"
+#include "Basics/WriteLocker.h"
+#include "GeneralServer/AuthenticationFeature.h"
+#include "Logger/Logger.h"
+
+#include <fuerte/connection.h>
+
+#include <algorithm>
+
+using namespace arangodb;
+using namespace arangodb::network;
+
+ConnectionPool::ConnectionPool(ConnectionPool::Config const& config)
+    : _config(config), _shutdown(false), _loop(config.numIOThreads) {
+  TRI_ASSERT(_config.numIOThreads > 0);
+  TRI_ASSERT(_config.maxOpenConnections > 0);
+}
+
+ConnectionPool::~ConnectionPool() { shutdown(); }
+
+std::shared_ptr<fuerte::Connection> ConnectionPool::leaseConnection(std::string const& endpoint) {
+  Bucket& b = bucket(endpoint);
+
+  std::lock_guard<std::mutex> guard(b.mutex);
+
+  // throw away broken connections first, they will never recover
+  b.connections.erase(std::remove_if(b.connections.begin(), b.connections.end(),
+                                     [](Connection const& c) {
+                                       auto state = c.fuerte->state();
+                                       return state == fuerte::Connection::State::Failed ||
+                                              state == fuerte::Connection::State::Disconnected;
+                                     }),
+                      b.connections.end());
+
+  // pick the least busy connection. an idle one is as good as it gets
+  Connection* best = nullptr;
+  size_t bestLoad = SIZE_MAX;
+  for (auto& c : b.connections) {
+    size_t load = c.fuerte->requestsLeft();
+    if (load < bestLoad) {
+      best = &c;
+      bestLoad = load;
+      if (load == 0) {
+        break;
+      }
+    }
+  }
+
+  // HTTP connections process one request at a time, so open another
+  // connection while we are allowed to. VST multiplexes requests
+  bool const multiplexed = (_config.protocol == fuerte::ProtocolType::Vst);
+  if (best == nullptr ||
+      (bestLoad > 0 && !multiplexed && b.connections.size() < _config.maxOpenConnections)) {
+    fuerte::ConnectionBuilder builder;
+    builder.endpoint(endpoint);
+    if (_config.protocol != fuerte::ProtocolType::Undefined) {
+      builder.protocolType(_config.protocol);
+    }
+    b.connections.emplace_back(createConnection(builder));
+    best = &b.connections.back();
+  }
+
+  best->lastUsed = std::chrono::steady_clock::now();
+  return best->fuerte;
+}
+
+void ConnectionPool::pruneConnections() {
+  auto const now = std::chrono::steady_clock::now();
+  size_t pruned = 0;
+
+  READ_LOCKER(guard, _lock);
+  for (auto& it : _buckets) {
+    Bucket& b = *it.second;
+    std::lock_guard<std::mutex> bucketGuard(b.mutex);
+
+    auto it2 = b.connections.begin();
+    while (it2 != b.connections.end()) {
+      auto state = it2->fuerte->state();
+      bool remove = (state == fuerte::Connection::State::Failed ||
+                     state == fuerte::Connection::State::Disconnected);
+      if (!remove && it2->fuerte->requestsLeft() == 0 &&
+          now - it2->lastUsed > _config.idleConnectionTTL) {
+        it2->fuerte->cancel();
+        remove = true;
+      }
+      if (remove) {
+        it2 = b.connections.erase(it2);
+        ++pruned;
+      } else {
+        ++it2;
+      }
+    }
+  }
+
+  if (pruned > 0) {
+    LOG_TOPIC("91c8e", DEBUG, Logger::COMMUNICATION)
+        << "closed " << pruned << " idle or broken connection(s)";
+  }
+}
+
+void ConnectionPool::shutdown() {
+  WRITE_LOCKER(guard, _lock);
+  _shutdown = true;
+  for (auto& it : _buckets) {
+    Bucket& b = *it.second;
+    std::lock_guard<std::mutex> bucketGuard(b.mutex);
+    for (auto& c : b.connections) {
+      c.fuerte->cancel();
+    }
+    b.connections.clear();
+  }
+  _buckets.clear();
+}
+
+size_t ConnectionPool::numOpenConnections() const {
+  size_t n = 0;
+  READ_LOCKER(guard, _lock);
+  for (auto const& it : _buckets) {
+    std::lock_guard<std::mutex> bucketGuard(it.second->mutex);
+    n += it.second->connections.size();
+  }
+  return n;
+}
+
+ConnectionPool::Bucket& ConnectionPool::bucket(std::string const& endpoint) {
+  {
+    READ_LOCKER(guard, _lock);
+    if (_shutdown) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_SHUTTING_DOWN);
+    }
+    auto it = _buckets.find(endpoint);
+    if (it != _buckets.end()) {
+      return *it->second;
+    }
+  }
+
+  WRITE_LOCKER(guard, _lock);
+  if (_shutdown) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_SHUTTING_DOWN);
+  }
+  auto& b = _buckets[endpoint];
+  if (b == nullptr) {
+    b = std::make_unique<Bucket>();
+  }
+  // buckets are only removed on shutdown, so the reference stays valid
+  return *b;
+}
+
+std::shared_ptr<fuerte::Connection> ConnectionPool::createConnection(fuerte::ConnectionBuilder& builder) {
+  AuthenticationFeature* af = AuthenticationFeature::instance();
+  if (af != nullptr && af->isActive()) {
+    std::string const& token = af->tokenCache().jwtToken();
+    if (!token.empty()) {
+      builder.jwtToken(token);
+      builder.authenticationType(fuerte::AuthenticationType::Jwt);
+    }
+  }
+  builder.verifyHost(_config.verifyHosts);
+  return builder.connect(_loop);
+}
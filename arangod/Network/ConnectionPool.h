@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef ARANGOD_NETWORK_CONNECTION_POOL_H
+#define ARANGOD_NETWORK_CONNECTION_POOL_H 1
+
+#include "Basics/Common.h"
+#include "Basics/ReadWriteLock.h"
+
+#include <fuerte/loop.h>
+#include <fuerte/types.h>
+
+#include <chrono>
+#include <mutex>
+
+namespace arangodb {
+namespace fuerte {
+inline namespace v1 {
+class Connection;
+class ConnectionBuilder;
+}  // namespace v1
+}  // namespace fuerte
+
+namespace network {
+
+/// @brief simple connection pool managing fuerte connections to the other
+/// servers of the cluster. connections are kept open for a while after use,
+/// and several requests share a connection if the protocol supports it (VST)
+/// or if the limit of open connections per destination is reached (HTTP,
+/// requests are queued on the connection then).
+class ConnectionPool final {
+ public:
+  struct Config {
+    /// @brief maximum number of open connections per destination
+    uint64_t maxOpenConnections = 64;
+    /// @brief idle connections are closed after this time
+    std::chrono::milliseconds idleConnectionTTL = std::chrono::milliseconds(120000);
+    /// @brief number of io threads driving the connections
+    unsigned numIOThreads = 1;
+    /// @brief protocol used to talk to the other servers
+    fuerte::ProtocolType protocol = fuerte::ProtocolType::Http;
+    bool verifyHosts = false;
+  };
+
+ public:
+  explicit ConnectionPool(Config const& config);
+  ~ConnectionPool();
+
+  ConnectionPool(ConnectionPool const&) = delete;
+  ConnectionPool& operator=(ConnectionPool const&) = delete;
+
+  /// @brief request a connection to the endpoint, which is an endpoint
+  /// specification like "tcp://host:port". may open a new connection.
+  /// throws if the endpoint is invalid or the pool is shut down
+  std::shared_ptr<fuerte::Connection> leaseConnection(std::string const& endpoint);
+
+  /// @brief close connections that have been idle for longer than the
+  /// configured TTL, or that are broken
+  void pruneConnections();
+
+  /// @brief close all connections, and do not hand out new ones
+  void shutdown();
+
+  /// @brief total number of open connections
+  size_t numOpenConnections() const;
+
+  Config const& config() const { return _config; }
+
+ private:
+  struct Connection {
+    explicit Connection(std::shared_ptr<fuerte::Connection> fuerte)
+        : fuerte(std::move(fuerte)), lastUsed(std::chrono::steady_clock::now()) {}
+
+    std::shared_ptr<fuerte::Connection> fuerte;
+    std::chrono::steady_clock::time_point lastUsed;
+  };
+
+  struct Bucket {
+    std::mutex mutex;
+    std::vector<Connection> connections;
+  };
+
+  Bucket& bucket(std::string const& endpoint);
+
+  std::shared_ptr<fuerte::Connection> createConnection(fuerte::ConnectionBuilder& builder);
+
+ private:
+  Config const _config;
+
+  mutable basics::ReadWriteLock _lock;
+  std::unordered_map<std::string, std::unique_ptr<Bucket>> _buckets;
+  bool _shutdown;
+
+  fuerte::EventLoopService _loop;
+};
+
+}  // namespace network
+}  // namespace arangodb
+
+#endif
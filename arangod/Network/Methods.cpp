@@ -0,0 +1,184 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "Methods.h"
+
+#include "Basics/Exceptions.h"
+#include "Basics/StaticStrings.h"
+#include "Basics/StringUtils.h"
+#include "Cluster/ClusterInfo.h"
+#include "Futures/Promise.h"
+#include "Futures/Utilities.h"
+#include "Logger/Logger.h"
+#include "Network/ConnectionPool.h"
+#include "Network/NetworkFeature.h"
+
+#include <fuerte/connection.h>
+#include <fuerte/requests.h>
+
+using namespace arangodb;
+using namespace arangodb::network;
+
+namespace {
+
+/// @brief resolve a destination to an endpoint. returns an empty string
+/// if the destination cannot be resolved (yet)
+std::string resolveDestination(DestinationId const& dest) {
+  if (dest.compare(0, 6, "tcp://") == 0 || dest.compare(0, 6, "ssl://") == 0) {
+    return dest;
+  }
+
+  ServerID serverId;
+  if (dest.compare(0, 6, "shard:") == 0) {
+    std::shared_ptr<std::vector<ServerID>> resp =
+        ClusterInfo::instance()->getResponsibleServer(dest.substr(6));
+    if (resp->empty()) {
+      LOG_TOPIC("60ee8", DEBUG, Logger::COMMUNICATION)
+          << "cannot find responsible server for '" << dest << "'";
+      return std::string();
+    }
+    serverId = (*resp)[0];
+  } else if (dest.compare(0, 7, "server:") == 0) {
+    serverId = dest.substr(7);
+  } else {
+    LOG_TOPIC("77a84", DEBUG, Logger::COMMUNICATION)
+        << "did not understand destination '" << dest << "'";
+    return std::string();
+  }
+
+  return ClusterInfo::instance()->getServerEndpoint(serverId);
+}
+
+/// @brief replaces a deflate encoded response body with the original one.
+/// returns false if the body cannot be inflated
+bool inflateResponse(fuerte::Response& res) {
+  if (res.header.metaByKey(StaticStrings::ContentEncoding) != "deflate") {
+    return true;
+  }
+
+  auto payload = res.payload();
+  std::string inflated;
+  if (!basics::StringUtils::gzipDeflate(asio_ns::buffer_cast<char const*>(payload),
+                                        asio_ns::buffer_size(payload), inflated)) {
+    return false;
+  }
+
+  velocypack::Buffer<uint8_t> buffer(inflated.size());
+  buffer.append(inflated.data(), inflated.size());
+  res.setPayload(std::move(buffer), 0);
+  res.header.meta.erase(StaticStrings::ContentEncoding);
+  return true;
+}
+
+}  // namespace
+
+namespace arangodb {
+namespace network {
+
+velocypack::Slice Response::slice() const {
+  if (!ok()) {
+    return velocypack::Slice::noneSlice();
+  }
+  try {
+    // validates the body, which comes from another server
+    return response->slice();
+  } catch (std::exception const& ex) {
+    LOG_TOPIC("4b8f2", DEBUG, Logger::COMMUNICATION)
+        << "invalid response body from '" << destination << "': " << ex.what();
+  }
+  return velocypack::Slice::noneSlice();
+}
+
+int Response::errorCode() const {
+  switch (fuerte::intToError(error)) {
+    case fuerte::ErrorCondition::NoError:
+      return TRI_ERROR_NO_ERROR;
+    case fuerte::ErrorCondition::CouldNotConnect:
+      return TRI_ERROR_CLUSTER_BACKEND_UNAVAILABLE;
+    case fuerte::ErrorCondition::Timeout:
+      return TRI_ERROR_CLUSTER_TIMEOUT;
+    case fuerte::ErrorCondition::Canceled:
+      return TRI_ERROR_SHUTTING_DOWN;
+    default:
+      return TRI_ERROR_CLUSTER_CONNECTION_LOST;
+  }
+}
+
+futures::Future<Response> sendRequest(DestinationId const& destination,
+                                      fuerte::RestVerb type, std::string const& database,
+                                      std::string const& path,
+                                      velocypack::Buffer<uint8_t> payload,
+                                      Timeout timeout, Headers const& headers) {
+  auto failed = [&destination](fuerte::ErrorCondition err) {
+    return futures::makeFuture(Response{destination, fuerte::errorToInt(err), nullptr});
+  };
+
+  ConnectionPool* pool = NetworkFeature::pool();
+  if (pool == nullptr) {
+    return failed(fuerte::ErrorCondition::Canceled);
+  }
+
+  std::string endpoint = resolveDestination(destination);
+  if (endpoint.empty()) {
+    return failed(fuerte::ErrorCondition::CouldNotConnect);
+  }
+
+  auto req = fuerte::createRequest(type, fuerte::ContentType::VPack);
+  req->header.database = database;
+  req->header.path = path;
+  if (payload.size() > 0) {
+    req->addVPack(std::move(payload));
+  }
+  for (auto const& header : headers) {
+    req->header.addMeta(header.first, header.second);
+  }
+  // large response bodies may come back compressed
+  req->header.meta[StaticStrings::AcceptEncoding] = "deflate";
+  req->timeout(std::chrono::duration_cast<std::chrono::milliseconds>(timeout));
+
+  std::shared_ptr<fuerte::Connection> conn;
+  try {
+    conn = pool->leaseConnection(endpoint);
+  } catch (std::exception const& ex) {
+    LOG_TOPIC("1a2cd", DEBUG, Logger::COMMUNICATION)
+        << "cannot open connection to '" << endpoint << "': " << ex.what();
+    return failed(fuerte::ErrorCondition::CouldNotConnect);
+  }
+
+  auto promise = std::make_shared<futures::Promise<Response>>();
+  auto future = promise->getFuture();
+  conn->sendRequest(std::move(req),
+                    [destination, promise](fuerte::Error err,
+                                           std::unique_ptr<fuerte::Request> req,
+                                           std::unique_ptr<fuerte::Response> res) {
+                      if (res != nullptr && !::inflateResponse(*res)) {
+                        LOG_TOPIC("c4a51", DEBUG, Logger::COMMUNICATION)
+                            << "cannot inflate response from '" << destination << "'";
+                        err = fuerte::errorToInt(fuerte::ErrorCondition::ProtocolError);
+                        res.reset();
+                      }
+                      promise->setValue(Response{destination, err, std::move(res)});
+                    });
+  return future;
+}
+
+}  // namespace network
+}  // namespace arangodb
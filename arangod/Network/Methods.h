@@ -0,0 +1,80 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef ARANGOD_NETWORK_METHODS_H
+#define ARANGOD_NETWORK_METHODS_H 1
+
+#include "Basics/Common.h"
+#include "Futures/Future.h"
+
+#include <fuerte/message.h>
+#include <fuerte/types.h>
+#include <velocypack/Buffer.h>
+#include <velocypack/Slice.h>
+
+#include <chrono>
+
+namespace arangodb {
+namespace network {
+
+/// @brief destination of a request, either "shard:<shard>",
+/// "server:<server id>" or a plain endpoint like "tcp://host:port"
+typedef std::string DestinationId;
+typedef std::map<std::string, std::string> Headers;
+typedef std::chrono::duration<double> Timeout;
+
+/// @brief result of a request sent via the connection pool
+struct Response {
+  DestinationId destination;
+  fuerte::Error error;
+  std::unique_ptr<fuerte::Response> response;
+
+  bool ok() const {
+    return error == static_cast<fuerte::Error>(fuerte::ErrorCondition::NoError) &&
+           response != nullptr;
+  }
+
+  fuerte::StatusCode statusCode() const {
+    return ok() ? response->statusCode() : fuerte::StatusUndefined;
+  }
+
+  /// @brief the first velocypack slice of the response body. returns a none
+  /// slice if the request failed or the body is not valid velocypack, never
+  /// throws
+  velocypack::Slice slice() const;
+
+  /// @brief convert the error to an ArangoDB error code
+  int errorCode() const;
+};
+
+/// @brief send a request to a destination. the returned future is
+/// fulfilled once the response has arrived or the request has failed.
+/// never throws, errors are reported in the response
+futures::Future<Response> sendRequest(DestinationId const& destination,
+                                      fuerte::RestVerb type, std::string const& database,
+                                      std::string const& path,
+                                      velocypack::Buffer<uint8_t> payload,
+                                      Timeout timeout, Headers const& headers = {});
+
+}  // namespace network
+}  // namespace arangodb
+
+#endif
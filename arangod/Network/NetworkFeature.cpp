@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "NetworkFeature.h"
+
+#include "ApplicationFeatures/ApplicationServer.h"
+#include "Logger/Logger.h"
+#include "Network/ConnectionPool.h"
+#include "ProgramOptions/Parameters.h"
+#include "ProgramOptions/ProgramOptions.h"
+#include "ProgramOptions/Section.h"
+#include "Scheduler/SchedulerFeature.h"
+
+using namespace arangodb::application_features;
+using namespace arangodb::basics;
+using namespace arangodb::options;
+
+namespace arangodb {
+
+std::atomic<network::ConnectionPool*> NetworkFeature::POOL(nullptr);
+
+NetworkFeature::NetworkFeature(application_features::ApplicationServer& server)
+    : ApplicationFeature(server, "Network"),
+      _maxOpenConnections(64),
+      _idleTtlMilli(120000),
+      _numIOThreads(1),
+      _protocol("http"),
+      _workItem(nullptr),
+      _gcfunc() {
+  setOptional(true);
+  startsAfter("CommunicationPhase");
+  startsAfter("Scheduler");
+
+  _gcfunc = [this](bool canceled) {
+    if (canceled) {
+      return;
+    }
+
+    _pool->pruneConnections();
+
+    auto off = std::chrono::seconds(3);
+
+    std::lock_guard<std::mutex> guard(_workItemMutex);
+    if (!ApplicationServer::isStopping() && !canceled) {
+      _workItem = SchedulerFeature::SCHEDULER->queueDelay(RequestLane::INTERNAL_LOW, off, _gcfunc);
+    }
+  };
+}
+
+void NetworkFeature::collectOptions(std::shared_ptr<options::ProgramOptions> options) {
+  options->addSection("network", "Configure cluster-internal communication");
+
+  options->addOption("--network.max-open-connections",
+                     "maximum number of open connections per destination",
+                     new UInt64Parameter(&_maxOpenConnections));
+  options->addOption("--network.idle-connection-ttl",
+                     "idle time (in milliseconds) after which a connection is closed",
+                     new UInt64Parameter(&_idleTtlMilli));
+  options->addOption("--network.io-threads",
+                     "number of network io threads for cluster-internal communication",
+                     new UInt32Parameter(&_numIOThreads));
+  options->addOption("--network.protocol",
+                     "protocol used for cluster-internal communication",
+                     new DiscreteValuesParameter<StringParameter>(
+                         &_protocol, std::unordered_set<std::string>{"http", "vst"}));
+}
+
+void NetworkFeature::validateOptions(std::shared_ptr<options::ProgramOptions>) {
+  if (_maxOpenConnections == 0) {
+    LOG_TOPIC("4f3a9", FATAL, arangodb::Logger::STARTUP)
+        << "invalid value for '--network.max-open-connections'.";
+    FATAL_ERROR_EXIT();
+  }
+
+  if (_numIOThreads == 0) {
+    LOG_TOPIC("8d1c2", FATAL, arangodb::Logger::STARTUP)
+        << "invalid value for '--network.io-threads'.";
+    FATAL_ERROR_EXIT();
+  }
+}
+
+void NetworkFeature::prepare() {
+  network::ConnectionPool::Config config;
+  config.maxOpenConnections = _maxOpenConnections;
+  config.idleConnectionTTL = std::chrono::milliseconds(_idleTtlMilli);
+  config.numIOThreads = _numIOThreads;
+  config.protocol = (_protocol == "vst") ? fuerte::ProtocolType::Vst
+                                         : fuerte::ProtocolType::Http;
+
+  _pool = std::make_unique<network::ConnectionPool>(config);
+  POOL.store(_pool.get(), std::memory_order_release);
+}
+
+void NetworkFeature::start() {
+  auto off = std::chrono::seconds(3);
+
+  Scheduler* scheduler = SchedulerFeature::SCHEDULER;
+  if (scheduler != nullptr) {  // is nullptr in catch tests
+    std::lock_guard<std::mutex> guard(_workItemMutex);
+    _workItem = scheduler->queueDelay(RequestLane::INTERNAL_LOW, off, _gcfunc);
+  }
+}
+
+void NetworkFeature::beginShutdown() {
+  {
+    std::lock_guard<std::mutex> guard(_workItemMutex);
+    _workItem.reset();
+  }
+  POOL.store(nullptr, std::memory_order_release);
+  if (_pool) {
+    _pool->shutdown();
+  }
+}
+
+void NetworkFeature::stop() {
+  // reset again, as there may be a race between beginShutdown and
+  // the execution of the deferred _workItem
+  {
+    std::lock_guard<std::mutex> guard(_workItemMutex);
+    _workItem.reset();
+  }
+  if (_pool) {
+    _pool->shutdown();
+  }
+}
+
+void NetworkFeature::unprepare() {
+  POOL.store(nullptr, std::memory_order_release);
+  _pool.reset();
+}
+
+}  // namespace arangodb
@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef ARANGOD_NETWORK_NETWORK_FEATURE_H
+#define ARANGOD_NETWORK_NETWORK_FEATURE_H 1
+
+#include "ApplicationFeatures/ApplicationFeature.h"
+#include "Scheduler/Scheduler.h"
+
+#include <mutex>
+
+namespace arangodb {
+namespace network {
+class ConnectionPool;
+}
+
+/// @brief owns the pool of connections used for asynchronous requests
+/// to other servers of the cluster
+class NetworkFeature final : public application_features::ApplicationFeature {
+ public:
+  explicit NetworkFeature(application_features::ApplicationServer& server);
+
+  void collectOptions(std::shared_ptr<options::ProgramOptions>) override;
+  void validateOptions(std::shared_ptr<options::ProgramOptions>) override;
+  void prepare() override;
+  void start() override;
+  void beginShutdown() override;
+  void stop() override;
+  void unprepare() override;
+
+  /// @brief the global connection pool. may be a nullptr during
+  /// startup and shutdown
+  static network::ConnectionPool* pool() { return POOL.load(std::memory_order_acquire); }
+
+ private:
+  static std::atomic<network::ConnectionPool*> POOL;
+
+ private:
+  uint64_t _maxOpenConnections;
+  uint64_t _idleTtlMilli;
+  uint32_t _numIOThreads;
+  std::string _protocol;
+
+  std::unique_ptr<network::ConnectionPool> _pool;
+
+  std::mutex _workItemMutex;
+  Scheduler::WorkHandle _workItem;
+  /// @brief closes idle connections from time to time
+  std::function<void(bool)> _gcfunc;
+};
+
+}  // namespace arangodb
+
+#endif
@@ -44,6 +44,9 @@ class VertexComputation;
 template <typename V, typename E, typename M>
 class VertexCompensation;
 
+template <typename V, typename E, typename M>
+class VertexKernel;
+
 class IAggregator;
 class WorkerConfig;
 class MasterContext;
@@ -92,6 +95,12 @@ struct Algorithm : IAlgorithm {
   virtual VertexCompensation<V, E, M>* createCompensation(WorkerConfig const*) const {
     return nullptr;
   }
+  /// @brief kernel used instead of createComputation() in synchronous
+  /// mode if messages are combined and all vertices are loaded
+  virtual VertexKernel<V, E, M>* createKernel(WorkerConfig const*) const {
+    return nullptr;
+  }
+
   virtual std::set<std::string> initialActiveSet() {
     return std::set<std::string>();
   }
@@ -107,6 +107,55 @@ VertexComputation<float, float, float>* PageRank::createComputation(WorkerConfig
   return new PRComputation();
 }
 
+/// same as PRComputation, on blocks of vertices
+struct PRKernel : public VertexKernel<float, float, float> {
+  void compute(uint64_t gss, uint64_t lss, WorkerContext const* context,
+               AggregatorHandler* aggregators, VertexBlock<float, float>& block) override {
+    float const commonProb = static_cast<PRWorkerContext const*>(context)->commonProb;
+    float* values = block.values;
+    float const* messages = block.messages;
+    uint8_t const* received = block.received;
+    uint8_t const* active = block.active;
+    uint8_t* send = block.send;
+    float* outgoing = block.outgoing;
+
+    float maxDiff = -1.0f;
+    for (size_t i = 0; i < block.count; ++i) {
+      uint8_t const compute = received[i] | active[i];
+      float const old = values[i];
+      float value;
+      if (gss == 0) {
+        value = old < 0 ? commonProb : old;
+      } else {
+        value = 0.85f * (received[i] ? messages[i] : 0.0f) + commonProb;
+      }
+      value = compute ? value : old;
+      float const diff = compute ? std::fabs(old - value) : -1.0f;
+      maxDiff = diff > maxDiff ? diff : maxDiff;
+      values[i] = value;
+      outgoing[i] = value;
+      send[i] = compute;
+    }
+    if (maxDiff >= 0.0f) {
+      aggregators->aggregate(kConvergence, &maxDiff);
+    }
+  }
+
+  void send(RangeIterator<Edge<float>>& edges, float const& outgoing,
+            OutCache<float>* cache) override {
+    if (edges.size() > 0) {
+      float const val = outgoing / edges.size();
+      for (Edge<float> const* edge : edges) {
+        cache->appendMessage(edge->targetShard(), edge->toKey(), val);
+      }
+    }
+  }
+};
+
+VertexKernel<float, float, float>* PageRank::createKernel(WorkerConfig const* config) const {
+  return new PRKernel();
+}
+
 WorkerContext* PageRank::workerContext(VPackSlice userParams) const {
   return new PRWorkerContext();
 }
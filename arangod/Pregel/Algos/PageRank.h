@@ -46,6 +46,8 @@ struct PageRank : public SimpleAlgorithm<float, float, float> {
 
   VertexComputation<float, float, float>* createComputation(WorkerConfig const*) const override;
 
+  VertexKernel<float, float, float>* createKernel(WorkerConfig const*) const override;
+
   WorkerContext* workerContext(VPackSlice userParams) const override;
 
   MasterContext* masterContext(VPackSlice userParams) const override;
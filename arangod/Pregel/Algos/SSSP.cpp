@@ -52,6 +52,42 @@ struct SSSPComputation : public VertexComputation<int64_t, int64_t, int64_t> {
   }
 };
 
+/// the relax step of SSSPComputation on blocks of vertices
+struct SSSPKernel : public VertexKernel<int64_t, int64_t, int64_t> {
+  void compute(uint64_t gss, uint64_t lss, WorkerContext const* context,
+               AggregatorHandler* aggregators, VertexBlock<int64_t, int64_t>& block) override {
+    int64_t* values = block.values;
+    int64_t const* messages = block.messages;
+    uint8_t const* received = block.received;
+    uint8_t* active = block.active;
+    uint8_t* send = block.send;
+    int64_t* outgoing = block.outgoing;
+
+    for (size_t i = 0; i < block.count; ++i) {
+      uint8_t const compute = received[i] | active[i];
+      int64_t const state = values[i];
+      int64_t const tmp = received[i] && messages[i] < state ? messages[i] : state;
+      uint8_t const update = compute && (tmp < state || (tmp == 0 && lss == 0));
+      values[i] = tmp;
+      outgoing[i] = tmp;
+      send[i] = update;
+      active[i] = 0;
+    }
+  }
+
+  void send(RangeIterator<Edge<int64_t>>& edges, int64_t const& outgoing,
+            OutCache<int64_t>* cache) override {
+    for (Edge<int64_t>* edge : edges) {
+      cache->appendMessage(edge->targetShard(), edge->toKey(), *edge->data() + outgoing);
+    }
+  }
+};
+
+VertexKernel<int64_t, int64_t, int64_t>* SSSPAlgorithm::createKernel(
+    WorkerConfig const* config) const {
+  return new SSSPKernel();
+}
+
 uint32_t SSSPAlgorithm::messageBatchSize(WorkerConfig const& config,
                                          MessageStats const& stats) const {
   if (config.localSuperstep() <= 1) {
@@ -63,6 +63,8 @@ class SSSPAlgorithm : public Algorithm<int64_t, int64_t, int64_t> {
   }
 
   VertexComputation<int64_t, int64_t, int64_t>* createComputation(WorkerConfig const*) const override;
+
+  VertexKernel<int64_t, int64_t, int64_t>* createKernel(WorkerConfig const*) const override;
   VertexCompensation<int64_t, int64_t, int64_t>* createCompensation(WorkerConfig const*) const override;
 
   uint32_t messageBatchSize(WorkerConfig const& config, MessageStats const& stats) const override;
@@ -45,6 +45,8 @@
 #include <velocypack/Iterator.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include <algorithm>
+
 using namespace arangodb;
 using namespace arangodb::pregel;
 using namespace arangodb::basics;
@@ -90,6 +92,8 @@ Conductor::Conductor(uint64_t executionNumber, TRI_vocbase_t& vocbase,
   }
   _useMemoryMaps = VelocyPackHelper::readBooleanValue(_userParams.slice(),
                                                       Utils::useMemoryMaps, _useMemoryMaps);
+  _checkpointInterval = VelocyPackHelper::getNumericValue(
+      _userParams.slice(), Utils::checkpointIntervalKey.c_str(), _checkpointInterval);
   VPackSlice storeSlice = config.get("store");
   _storeResults = !storeSlice.isBool() || storeSlice.getBool();
   if (!_storeResults) {
@@ -140,6 +144,9 @@ bool Conductor::_startGlobalStep() {
   _statistics.resetActiveCount();
   _totalVerticesCount = 0;  // might change during execution
   _totalEdgesCount = 0;
+  // checkpoints which all workers completed
+  std::vector<uint64_t> checkpoints;
+  bool firstResponse = true;
   // we are explicitly expecting an response containing the aggregated
   // values as well as the count of active vertices
   int res = _sendToAllDBServers(Utils::prepareGSSPath, b, [&](VPackSlice const& payload) {
@@ -147,6 +154,25 @@ bool Conductor::_startGlobalStep() {
     _statistics.accumulateActiveCounts(payload);
     _totalVerticesCount += payload.get(Utils::vertexCountKey).getUInt();
     _totalEdgesCount += payload.get(Utils::edgeCountKey).getUInt();
+
+    std::vector<uint64_t> completed;
+    VPackSlice checkpointSlice = payload.get(Utils::checkpointKey);
+    if (checkpointSlice.isArray()) {
+      for (VPackSlice gss : VPackArrayIterator(checkpointSlice)) {
+        completed.push_back(gss.getUInt());
+      }
+    }
+    if (firstResponse) {
+      checkpoints = std::move(completed);
+      firstResponse = false;
+    } else {
+      checkpoints.erase(std::remove_if(checkpoints.begin(), checkpoints.end(),
+                                       [&](uint64_t gss) {
+                                         return std::find(completed.begin(), completed.end(),
+                                                          gss) == completed.end();
+                                       }),
+                        checkpoints.end());
+    }
   });
   if (res != TRI_ERROR_NO_ERROR) {
     _state = ExecutionState::IN_ERROR;
@@ -155,6 +181,9 @@ bool Conductor::_startGlobalStep() {
     // the recovery mechanisms should take care of this
     return false;
   }
+  if (!checkpoints.empty()) {
+    _checkpointGSS = *std::max_element(checkpoints.begin(), checkpoints.end());
+  }
 
   // workers are done if all messages were processed and no active vertices
   // are left to process
@@ -224,6 +253,7 @@ void Conductor::finishedWorkerStartup(VPackSlice const& data) {
 
   _totalVerticesCount += data.get(Utils::vertexCountKey).getUInt();
   _totalEdgesCount += data.get(Utils::edgeCountKey).getUInt();
+  _statistics.accumulateLoadStats(data);
   if (_respondedServers.size() != _dbServers.size()) {
     return;
   }
@@ -319,15 +349,24 @@ void Conductor::finishedRecoveryStep(VPackSlice const& data) {
     return;
   }
 
+  if (_rollback && !data.get(Utils::checkpointKey).isInteger()) {
+    // the checkpoint is lost together with the server which wrote it
+    LOG_TOPIC("4e6c0", ERR, Logger::PREGEL)
+        << "Worker could not restore the checkpoint of gss " << _globalSuperstep;
+    cancelNoLock();
+    return;
+  }
+
   // the recovery mechanism might be gathering state information
   _aggregators->aggregateValues(data);
   if (_respondedServers.size() != _dbServers.size()) {
     return;
   }
 
-  // only compensations supported
+  // a rollback is done once all workers restored their checkpoint,
+  // otherwise compensate until the master context is satisfied
   bool proceed = false;
-  if (_masterContext) {
+  if (_masterContext && !_rollback) {
     proceed = proceed || _masterContext->postCompensation();
   }
 
@@ -389,7 +428,7 @@ void Conductor::startRecovery() {
   MUTEX_LOCKER(guard, _callbackMutex);
   if (_state != ExecutionState::RUNNING && _state != ExecutionState::IN_ERROR) {
     return;  // maybe we are already in recovery mode
-  } else if (_algorithm->supportsCompensation() == false) {
+  } else if (_algorithm->supportsCompensation() == false && _checkpointGSS == 0) {
     LOG_TOPIC("12e0e", ERR, Logger::PREGEL) << "Algorithm does not support recovery";
     cancelNoLock();
     return;
@@ -427,8 +466,15 @@ void Conductor::startRecovery() {
           return;  // seems like we are canceled
         }
 
-        // Let's try recovery
-        if (_masterContext) {
+        // roll back to the latest checkpoint if there is one, every
+        // worker restores the vertices it loads from its local checkpoint
+        _rollback = _checkpointGSS > 0;
+        if (_rollback) {
+          LOG_TOPIC("b7d24", INFO, Logger::PREGEL)
+              << "Rolling back to the checkpoint of gss " << _checkpointGSS;
+          _globalSuperstep = _checkpointGSS;
+          _statistics.resetHistory(_checkpointGSS);
+        } else if (_masterContext) {  // Let's try recovery
           bool proceed = _masterContext->preCompensation();
           if (!proceed) {
             cancelNoLock();
@@ -437,7 +483,8 @@ void Conductor::startRecovery() {
 
         VPackBuilder additionalKeys;
         additionalKeys.openObject();
-        additionalKeys.add(Utils::recoveryMethodKey, VPackValue(Utils::compensate));
+        additionalKeys.add(Utils::recoveryMethodKey,
+                           VPackValue(_rollback ? Utils::rollback : Utils::compensate));
         _aggregators->serializeValues(b);
         additionalKeys.close();
         _aggregators->resetValues();
@@ -718,6 +765,7 @@ VPackBuilder Conductor::toVelocyPack() const {
     result.add("vertexCount", VPackValue(_totalVerticesCount));
     result.add("edgeCount", VPackValue(_totalEdgesCount));
   }
+  _statistics.serializeHistory(result);
   result.close();
   return result;
 }
@@ -83,6 +83,12 @@ class Conductor {
   bool _lazyLoading = false;
   bool _useMemoryMaps = false;
   bool _storeResults = false;
+  /// workers write a checkpoint every this many global supersteps
+  uint64_t _checkpointInterval = 0;
+  /// latest global superstep all workers have a checkpoint of, 0 if none
+  uint64_t _checkpointGSS = 0;
+  /// whether the current recovery rolls back to _checkpointGSS
+  bool _rollback = false;
 
   /// persistent tracking of active vertices, send messages, runtimes
   StatsManager _statistics;
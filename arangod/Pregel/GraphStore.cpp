@@ -24,6 +24,7 @@
 
 #include "Basics/Common.h"
 #include "Basics/MutexLocker.h"
+#include "Basics/process-utils.h"
 #include "Graph/EdgeCollectionInfo.h"
 #include "Pregel/CommonFormats.h"
 #include "Pregel/PregelFeature.h"
@@ -91,6 +92,9 @@ static const char* shardError =
     "Collections need to have the same number of shards"
     " use distributeShardsLike";
 
+/// number of vertices which are written back with one operation
+static constexpr size_t StoreBatchSize = 1000;
+
 template <typename V, typename E>
 std::map<CollectionID, std::vector<VertexShardInfo>> GraphStore<V, E>::_allocateSpace() {
   if (_vertexData || _edges) {
@@ -102,7 +106,6 @@ std::map<CollectionID, std::vector<VertexShardInfo>> GraphStore<V, E>::_allocate
   std::map<CollectionID, std::vector<VertexShardInfo>> result;
 
   LOG_TOPIC("76e8a", DEBUG, Logger::PREGEL) << "Allocating memory";
-  //uint64_t totalMemory = TRI_totalSystemMemory();
 
   // Contains the shards located on this db server in the right order
   // assuming edges are sharded after _from, vertices after _key
@@ -174,20 +177,23 @@ std::map<CollectionID, std::vector<VertexShardInfo>> GraphStore<V, E>::_allocate
   LOG_TOPIC("d3250", DEBUG, Logger::PREGEL) << "Estimating #numEdges: " << eCount;
 
   _index.resize(vCount);
-//  size_t requiredMem = vCount * _graphFormat->estimatedVertexSize() +
-//                       eCount * _graphFormat->estimatedEdgeSize();
-//  if (!_config->lazyLoading() &&
-//      (_config->useMemoryMaps() || requiredMem > totalMemory / 2)) {
-//    if (_graphFormat->estimatedVertexSize() > 0) {
-//      _vertexData = new MappedFileBuffer<V>(vCount);
-//    }
-//    _edges = new MappedFileBuffer<Edge<E>>(eCount);
-//  } else {
-    if (_graphFormat->estimatedVertexSize() > 0) {
+  if (_graphFormat->estimatedVertexSize() > 0) {
+    // vertex data is only mapped to a file if it can live in zeroed memory
+    // without construction. edges keep their keys on the heap, they are
+    // always kept in memory. lazy loading appends vertices, which a file
+    // mapping does not support
+    size_t requiredMem = vCount * _graphFormat->estimatedVertexSize();
+    if (std::is_trivially_copyable<V>::value && !_config->lazyLoading() &&
+        (_config->useMemoryMaps() || requiredMem > TRI_PhysicalMemory / 2)) {
+      LOG_TOPIC("0c4e7", DEBUG, Logger::PREGEL)
+          << "Mapping " << requiredMem << " bytes of vertex data to a file";
+      _vertexData = new MappedFileBuffer<V>(TRI_GetTempPath(), vCount);
+      _vertexDataMapped = true;
+    } else {
       _vertexData = new VectorTypedBuffer<V>(vCount);
     }
-    _edges = new VectorTypedBuffer<Edge<E>>(eCount);
-//  }
+  }
+  _edges = new VectorTypedBuffer<Edge<E>>(eCount);
 
   return result;
 }
@@ -239,8 +245,11 @@ void GraphStore<V, E>::loadShards(WorkerConfig* config,
           scheduler->queue(RequestLane::INTERNAL_LOW,
                            [this, &info, &edgeDataOffsets, vertexOff, shardIdx] {
                              TRI_DEFER(_runningThreads--);  // exception safe
+                             double start = TRI_microtime();
                              _loadVertices(*info.trx, info.vertexShard, info.edgeShards,
                                            vertexOff, edgeDataOffsets[shardIdx]);
+                             MUTEX_LOCKER(guard, _shardLoadTimesMutex);
+                             _shardLoadTimes[info.vertexShard] = TRI_microtime() - start;
                            });
           // update to next offset
           vertexOff += info.numVertices;
@@ -258,10 +267,38 @@ void GraphStore<V, E>::loadShards(WorkerConfig* config,
       }
     }
 
+    if (_config->vertexFilter().isObject()) {
+      // filtered vertices leave unused entries at the end of the range of
+      // their shard. the entries keep the offsets of their data and edges
+      _index.erase(std::remove_if(_index.begin(), _index.end(),
+                                  [](VertexEntry const& entry) {
+                                    return entry.shard() == InvalidPregelShard;
+                                  }),
+                   _index.end());
+    }
+
     scheduler->queue(RequestLane::INTERNAL_LOW, callback);
   });
 }
 
+template <typename V, typename E>
+size_t GraphStore<V, E>::memoryUsage() const {
+  size_t memory = _index.capacity() * sizeof(VertexEntry);
+  if (_vertexData) {
+    memory += _vertexData->size() * sizeof(V);
+  }
+  if (_edges) {
+    memory += _edges->size() * sizeof(Edge<E>);
+  }
+  return memory;
+}
+
+template <typename V, typename E>
+std::map<ShardID, double> GraphStore<V, E>::shardLoadTimes() const {
+  MUTEX_LOCKER(guard, _shardLoadTimesMutex);
+  return _shardLoadTimes;
+}
+
 template <typename V, typename E>
 void GraphStore<V, E>::loadDocument(WorkerConfig* config, std::string const& documentID) {
   if (!_vertexData) {
@@ -334,6 +371,24 @@ void GraphStore<V, E>::loadDocument(WorkerConfig* config, PregelShard sourceShar
   }
 }
 
+template <typename V, typename E>
+void GraphStore<V, E>::prefetchVertices(size_t start, size_t end) {
+  if (_vertexDataMapped && start < end) {
+    // filtered vertices may leave gaps in the vertex data
+    size_t first = _index[start]._vertexDataOffset;
+    _vertexData->willNeed(first, _index[end - 1]._vertexDataOffset + 1 - first);
+  }
+}
+
+template <typename V, typename E>
+void GraphStore<V, E>::releaseVertices(size_t start, size_t end) {
+  if (_vertexDataMapped && start < end) {
+    // dirty pages of a shared file mapping are written back, not lost
+    size_t first = _index[start]._vertexDataOffset;
+    _vertexData->dontNeed(first, _index[end - 1]._vertexDataOffset + 1 - first);
+  }
+}
+
 template <typename V, typename E>
 RangeIterator<VertexEntry> GraphStore<V, E>::vertexIterator() {
   return vertexIterator(0, _index.size());
@@ -402,30 +457,34 @@ void GraphStore<V, E>::_loadVertices(transaction::Methods& trx, ShardID const& v
   }
   _graphFormat->willLoadVertices(number);
   
+  std::string collectionName;
+  VPackSlice filter = _config->vertexFilter();
   auto cb = [&](LocalDocumentId const& token, VPackSlice slice) {
     if (slice.isExternal()) {
       slice = slice.resolveExternal();
     }
-    
+    if (filter.isObject() && !Utils::matchesExample(filter, slice)) {
+      return;
+    }
+
     VertexEntry& ventry = _index[vertexOffset];
     ventry._shard = sourceShard;
     ventry._key = transaction::helpers::extractKeyFromDocument(slice).copyString();
     ventry._edgeDataOffset = edgeOffset;
+    ventry._edgeCount = 0;
 
     // load vertex data
     std::string documentId = trx.extractIdString(slice);
+    if (collectionName.empty()) {
+      collectionName = documentId.substr(0, documentId.find('/'));
+    }
     if (_graphFormat->estimatedVertexSize() > 0) {
       TRI_ASSERT(vertexOffset < _vertexData->size());
       ventry._vertexDataOffset = vertexOffset;
       V* ptr = _vertexData->data() + vertexOffset;
       _graphFormat->copyVertexData(documentId, slice, ptr, sizeof(V));
     }
-    // load edges
-    for (ShardID const& edgeShard : edgeShards) {
-      _loadEdges(trx, edgeShard, ventry, documentId);
-    }
     vertexOffset++;
-    edgeOffset += ventry._edgeCount;
   };
   while (cursor.nextDocument(cb, 1000)) {
     if (_destroyed) {
@@ -434,8 +493,48 @@ void GraphStore<V, E>::_loadVertices(transaction::Methods& trx, ShardID const& v
     }
   }
 
+  // load the edges of all vertices with one scan per edge shard, instead
+  // of an index lookup per vertex. the edges are then bucketed to their
+  // vertices with a counting sort
+  size_t vertexCount = vertexOffset - originalVertexOffset;
+  std::unordered_map<VPackStringRef, size_t> vertices;
+  vertices.reserve(vertexCount);
+  for (size_t i = 0; i < vertexCount; i++) {
+    vertices.emplace(VPackStringRef(_index[originalVertexOffset + i]._key), i);
+  }
+  std::vector<std::pair<size_t, Edge<E>>> edges;
+  for (ShardID const& edgeShard : edgeShards) {
+    if (_destroyed) {
+      break;
+    }
+    _scanEdges(trx, edgeShard, VPackStringRef(collectionName), vertices, edges);
+  }
+
+  if (edgeOffset + edges.size() > _edges->size()) {
+    std::string msg = "Pregel did not preallocate enough space for all edges. This hints at a bug with collection count()";
+    LOG_TOPIC("2d5f0", ERR, Logger::PREGEL) << msg;
+    TRI_ASSERT(false);
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_INTERNAL);
+  }
+  std::vector<size_t> positions(vertexCount, 0);
+  for (auto const& edge : edges) {
+    positions[edge.first]++;
+  }
+  for (size_t i = 0; i < vertexCount; i++) {
+    VertexEntry& ventry = _index[originalVertexOffset + i];
+    ventry._edgeDataOffset = edgeOffset;
+    ventry._edgeCount = positions[i];
+    positions[i] = edgeOffset;
+    edgeOffset += ventry._edgeCount;
+  }
+  Edge<E>* data = _edges->data();
+  for (auto& edge : edges) {
+    data[positions[edge.first]++] = std::move(edge.second);
+  }
+  _localEdgeCount += edges.size();
+
   // Add all new vertices
-  _localVerticeCount += (vertexOffset - originalVertexOffset);
+  _localVerticeCount += vertexCount;
 
   if (!trx.commit().ok()) {
     LOG_TOPIC("3f75d", WARN, Logger::PREGEL)
@@ -445,6 +544,82 @@ void GraphStore<V, E>::_loadVertices(transaction::Methods& trx, ShardID const& v
   << "Pregel worker: done loading from vertex shard " << vertexShard;
 }
 
+/// @brief reads all edges of an edge shard in storage order and collects
+/// the ones starting at one of the given vertices, with the offset of
+/// their vertex relative to the first one
+template <typename V, typename E>
+void GraphStore<V, E>::_scanEdges(transaction::Methods& trx, ShardID const& edgeShard,
+                                  VPackStringRef collectionName,
+                                  std::unordered_map<VPackStringRef, size_t> const& vertices,
+                                  std::vector<std::pair<size_t, Edge<E>>>& edges) {
+  bool const copyData = _graphFormat->estimatedEdgeSize() > 0;
+  VPackSlice filter = _config->edgeFilter();
+
+  OperationCursor cursor(trx.indexScan(edgeShard, transaction::Methods::CursorType::ALL));
+  auto cb = [&](LocalDocumentId const& token, VPackSlice slice) {
+    if (slice.isExternal()) {
+      slice = slice.resolveExternal();
+    }
+    VPackStringRef from(transaction::helpers::extractFromFromDocument(slice));
+    std::size_t pos = from.find('/');
+    if (pos == std::string::npos || from.substr(0, pos) != collectionName) {
+      return;
+    }
+    auto it = vertices.find(from.substr(pos + 1));
+    if (it == vertices.end()) {
+      return;
+    }
+    if (filter.isObject() && !Utils::matchesExample(filter, slice)) {
+      return;
+    }
+
+    Edge<E> edge;
+    VPackStringRef toValue(transaction::helpers::extractToFromDocument(slice));
+    if (_resolveEdgeTarget(&edge, toValue) != TRI_ERROR_NO_ERROR) {
+      return;
+    }
+    if (copyData) {
+      _graphFormat->copyEdgeData(slice, edge.data(), sizeof(E));
+    }
+    edges.emplace_back(it->second, std::move(edge));
+  };
+  while (cursor.nextDocument(cb, 1000)) {
+    if (_destroyed) {
+      LOG_TOPIC("7b1d4", WARN, Logger::PREGEL) << "Aborted loading graph";
+      break;
+    }
+  }
+}
+
+template <typename V, typename E>
+int GraphStore<V, E>::_resolveEdgeTarget(Edge<E>* edge, VPackStringRef toValue) {
+  std::size_t pos = toValue.find('/');
+  TRI_ASSERT(pos != std::string::npos);
+  VPackStringRef collectionName = toValue.substr(0, pos);
+  VPackStringRef toVal = toValue.substr(pos + 1);
+  TRI_ASSERT(!toVal.empty());
+  edge->_toKey = toVal.toString();
+
+  // resolve the shard of the target vertex.
+  ShardID responsibleShard;
+  int res = Utils::resolveShard(_config, collectionName.toString(),
+                                StaticStrings::KeyString,
+                                toVal, responsibleShard);
+  if (res != TRI_ERROR_NO_ERROR) {
+    LOG_TOPIC("b80ba", ERR, Logger::PREGEL)
+    << "Could not resolve target shard of edge";
+    return res;
+  }
+
+  edge->_targetShard = (PregelShard)_config->shardId(responsibleShard);
+  if (edge->_targetShard == (PregelShard)-1) {
+    LOG_TOPIC("1f413", ERR, Logger::PREGEL)
+    << "Could not resolve target shard of edge";
+    return TRI_ERROR_CLUSTER_BACKEND_UNAVAILABLE;
+  }
+  return TRI_ERROR_NO_ERROR;
+}
+
 template <typename V, typename E>
 void GraphStore<V, E>::_loadEdges(transaction::Methods& trx, ShardID const& edgeShard,
                                   VertexEntry& vertexEntry, std::string const& documentID) {
@@ -473,39 +648,21 @@ void GraphStore<V, E>::_loadEdges(transaction::Methods& trx, ShardID const& edge
   };
   
   auto buildEdge = [&](Edge<E>* edge, VPackStringRef toValue) {
-    std::size_t pos = toValue.find('/');
-    TRI_ASSERT(pos != std::string::npos);
-    VPackStringRef collectionName = toValue.substr(0, pos);
-    VPackStringRef toVal = toValue.substr(pos + 1);
-    TRI_ASSERT(!toVal.empty());
-    edge->_toKey = toVal.toString();
-    
-    // resolve the shard of the target vertex.
-    ShardID responsibleShard;
-    int res = Utils::resolveShard(_config, collectionName.toString(),
-                                  StaticStrings::KeyString,
-                                  toVal, responsibleShard);
+    int res = _resolveEdgeTarget(edge, toValue);
     if (res != TRI_ERROR_NO_ERROR) {
-      LOG_TOPIC("b80ba", ERR, Logger::PREGEL)
-      << "Could not resolve target shard of edge";
       return res;
     }
-    
-    // PregelShard sourceShard = (PregelShard)_config->shardId(edgeShard);
-    edge->_targetShard = (PregelShard)_config->shardId(responsibleShard);
-    if (edge->_targetShard == (PregelShard)-1) {
-      LOG_TOPIC("1f413", ERR, Logger::PREGEL)
-      << "Could not resolve target shard of edge";
-      return TRI_ERROR_CLUSTER_BACKEND_UNAVAILABLE;
-    }
     added++;
     offset++;
     return TRI_ERROR_NO_ERROR;
   };
   
-  // allow for rocksdb edge index optimization
-  if (cursor->hasExtra() &&
-      _graphFormat->estimatedEdgeSize() == 0) {
+  VPackSlice filter = _config->edgeFilter();
+
+  // allow for rocksdb edge index optimization, the extra value is only the
+  // target of the edge, so it cannot be used with a filter
+  if (cursor->hasExtra() && _graphFormat->estimatedEdgeSize() == 0 &&
+      !filter.isObject()) {
     
     auto cb = [&](LocalDocumentId const& token, VPackSlice edgeSlice) {
       allocateSpace();
@@ -528,6 +685,9 @@ void GraphStore<V, E>::_loadEdges(transaction::Methods& trx, ShardID const& edge
       if (slice.isExternal()) {
         slice = slice.resolveExternal();
       }
+      if (filter.isObject() && !Utils::matchesExample(filter, slice)) {
+        return;
+      }
       allocateSpace();
       
       VPackStringRef toValue(transaction::helpers::extractToFromDocument(slice));
@@ -562,13 +722,39 @@ void GraphStore<V, E>::_storeVertices(std::vector<ShardID> const& globalShards,
   
   V* vData = _vertexData->data();
   
+  // the updates of up to StoreBatchSize vertices of the current shard,
+  // they are written with one operation
   VPackBuilder builder;
   size_t numDocs = 0;
+  OperationOptions options;
+  options.silent = true;
+
+  auto flush = [&]() {
+    builder.close();
+    if (numDocs > 0) {
+      ShardID const& shard = globalShards[currentShard];
+      OperationResult result = trx->update(shard, builder.slice(), options);
+      if (result.fail() && result.isNot(TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND)) {
+        THROW_ARANGO_EXCEPTION(result.result);
+      }
+      // errors of single documents, removed documents are skipped
+      for (auto const& error : result.countErrorCodes) {
+        if (error.first != TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND) {
+          THROW_ARANGO_EXCEPTION(error.first);
+        }
+      }
+    }
+    builder.clear();
+    builder.openArray();
+    numDocs = 0;
+  };
+  builder.openArray();
   
   // loop over vertices
   while (it != it.end()) {
-    if (it->shard() != currentShard || numDocs >= 1000) {
+    if (it->shard() != currentShard) {
       if (trx) {
+        flush();
         res = trx->finish(res);
         if (!res.ok()) {
           THROW_ARANGO_EXCEPTION(res);
@@ -577,22 +763,19 @@ void GraphStore<V, E>::_storeVertices(std::vector<ShardID> const& globalShards,
       
       currentShard = it->shard();
       
+      // one transaction per shard, intermediate commits keep it small
       auto ctx = transaction::StandaloneContext::Create(_vocbaseGuard.database());
       ShardID const& shard = globalShards[currentShard];
-      transaction::Options to;
       trx.reset(new SingleCollectionTransaction(ctx, shard, AccessMode::Type::WRITE));
       trx->addHint(transaction::Hints::Hint::INTERMEDIATE_COMMITS);
       res = trx->begin();
       if (!res.ok()) {
         THROW_ARANGO_EXCEPTION(res);
       }
-      numDocs = 0;
+    } else if (numDocs >= StoreBatchSize) {
+      flush();
     }
     
-    builder.clear();
-    // This loop will fill a buffer of vertices until we run into a new
-    // collection
-    // or there are no more vertices for to store (or the buffer is full)
     V* data = vData + it->_vertexDataOffset;
     builder.openObject();
     builder.add(StaticStrings::KeyString, VPackValue(it->key()));
@@ -610,16 +793,10 @@ void GraphStore<V, E>::_storeVertices(std::vector<ShardID> const& globalShards,
       trx.reset();
       break;
     }
-    
-    ShardID const& shard = globalShards[currentShard];
-    OperationOptions options;
-    OperationResult result = trx->update(shard, builder.slice(), options);
-    if (result.fail() && result.isNot(TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND)) {
-      THROW_ARANGO_EXCEPTION(result.result);
-    }
   }
   
   if (trx) {
+    flush();
     res = trx->finish(res);
     if (!res.ok()) {
       THROW_ARANGO_EXCEPTION(res);
@@ -635,7 +812,10 @@ void GraphStore<V, E>::storeResults(WorkerConfig* config,
   _config = config;
   double now = TRI_microtime();
   size_t total = _index.size();
-  size_t delta = _index.size() / _config->localVertexShardIDs().size();
+  // at least one thread per shard, transactions stay on one shard
+  size_t threads = std::max<size_t>(_config->localVertexShardIDs().size(),
+                                    _config->parallelism());
+  size_t delta = _index.size() / threads;
   if (delta < 1000) {
     delta = _index.size();
   }
@@ -23,6 +23,7 @@
 #ifndef ARANGODB_PREGEL_GRAPH_STORE_H
 #define ARANGODB_PREGEL_GRAPH_STORE_H 1
 
+#include "Basics/Mutex.h"
 #include "Basics/StringHeap.h"
 #include "Cluster/ClusterInfo.h"
 #include "Pregel/Graph.h"
@@ -74,6 +75,10 @@ class GraphStore {
 
   uint64_t localVertexCount() const { return _localVerticeCount; }
   uint64_t localEdgeCount() const { return _localEdgeCount; }
+  /// estimated memory of the index, the vertex and the edge data
+  size_t memoryUsage() const;
+  /// seconds it took to load each vertex shard
+  std::map<ShardID, double> shardLoadTimes() const;
   GraphFormat<V, E> const* graphFormat() { return _graphFormat.get(); }
 
   // ====================== NOT THREAD SAFE ===========================
@@ -87,6 +92,16 @@ class GraphStore {
   RangeIterator<VertexEntry> vertexIterator(size_t start, size_t count);
   RangeIterator<Edge<E>> edgeIterator(VertexEntry const* entry);
 
+  /// hint that the vertices [start, end) are processed next, or not
+  /// anymore. only has an effect with memory mapped vertex data
+  void prefetchVertices(size_t start, size_t end);
+  void releaseVertices(size_t start, size_t end);
+
+  /// the position of a vertex in the iteration order
+  size_t vertexOffset(VertexEntry const* entry) const {
+    return static_cast<size_t>(entry - _index.data());
+  }
+
   /// get the pointer to the vertex
   V* mutableVertexData(VertexEntry const* entry);
   /// does nothing currently
@@ -103,6 +118,11 @@ class GraphStore {
                      size_t vertexOffset, size_t& edgeOffset);
   void _loadEdges(transaction::Methods& trx, ShardID const& shard,
                   VertexEntry& vertexEntry, std::string const& documentID);
+  void _scanEdges(transaction::Methods& trx, ShardID const& edgeShard,
+                  arangodb::velocypack::StringRef collectionName,
+                  std::unordered_map<arangodb::velocypack::StringRef, size_t> const& vertices,
+                  std::vector<std::pair<size_t, Edge<E>>>& edges);
+  int _resolveEdgeTarget(Edge<E>* edge, arangodb::velocypack::StringRef toValue);
   void _storeVertices(std::vector<ShardID> const& globalShards,
                       RangeIterator<VertexEntry>& it);
   std::unique_ptr<transaction::Methods> _createTransaction();
@@ -116,6 +136,7 @@ class GraphStore {
 
   /// Vertex data
   TypedBuffer<V>* _vertexData = nullptr;
+  bool _vertexDataMapped = false;
 
   /// Edges (and data)
   TypedBuffer<Edge<E>>* _edges = nullptr;
@@ -123,6 +144,9 @@ class GraphStore {
   // cache the amount of vertices
   std::set<ShardID> _loadedShards;
 
+  mutable Mutex _shardLoadTimesMutex;
+  std::map<ShardID, double> _shardLoadTimes;
+
   // actual count of loaded vertices / edges
   std::atomic<size_t> _localVerticeCount;
   std::atomic<size_t> _localEdgeCount;
@@ -51,6 +51,12 @@ void InCache<M>::parseMessages(VPackSlice const& incomingData) {
   PregelShard shard = (PregelShard)shardSlice.getUInt();
   std::lock_guard<std::mutex> guard(this->_bucketLocker[shard]);
 
+  VPackSlice batch = incomingData.get(Utils::binaryMessagesKey);
+  if (batch.isBinary()) {
+    _parseBinary(shard, batch);
+    return;
+  }
+
   for (VPackSlice current : VPackArrayIterator(messages)) {
     if (i % 2 == 0) {  // TODO support multiple recipients
       key = current.copyString();
@@ -82,6 +88,52 @@ void InCache<M>::parseMessages(VPackSlice const& incomingData) {
   }
 }
 
+template <typename M>
+void InCache<M>::_parseBinary(PregelShard shard, VPackSlice batch) {
+  size_t const size = _format->binarySize();
+  if (size == 0) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                   "binary messages are not supported by "
+                                   "the message format");
+  }
+
+  VPackValueLength length;
+  char const* p = reinterpret_cast<char const*>(batch.getBinary(length));
+  char const* end = p + length;
+  PregelKey key;
+  M value;
+  while (p != end) {
+    uint32_t keyLength;
+    uint32_t count;
+    if (static_cast<size_t>(end - p) < sizeof(keyLength)) {
+      break;
+    }
+    memcpy(&keyLength, p, sizeof(keyLength));
+    p += sizeof(keyLength);
+    if (static_cast<size_t>(end - p) < keyLength + sizeof(count)) {
+      break;
+    }
+    key.assign(p, keyLength);
+    p += keyLength;
+    memcpy(&count, p, sizeof(count));
+    p += sizeof(count);
+    if (static_cast<size_t>(end - p) / size < count) {
+      break;
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+      _format->readBinary(p, value);
+      _set(shard, key, value);
+      p += size;
+    }
+    this->_containedMessageCount += count;
+  }
+
+  if (p != end) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                   "truncated binary message batch");
+  }
+}
+
 template <typename M>
 void InCache<M>::storeMessageNoLock(PregelShard shard,
                                     PregelKey const& vertexId, M const& data) {
@@ -314,6 +366,130 @@ void CombiningInCache<M>::forEach(
   }
 }
 
+// ================== DenseCombiningInCache ==================
+
+VertexOffsets::VertexOffsets(RangeIterator<VertexEntry> vertices)
+    : _vertices(*vertices.begin()), _size(vertices.size()) {
+  for (size_t offset = 0; offset < _size; ++offset) {
+    VertexEntry const& vertex = _vertices[offset];
+    _offsets[vertex.shard()].emplace(velocypack::StringRef(vertex.key()), offset);
+  }
+}
+
+size_t VertexOffsets::find(PregelShard shard, PregelKey const& key) const {
+  auto it = _offsets.find(shard);
+  if (it == _offsets.end()) {
+    return _size;
+  }
+  auto offset = it->second.find(velocypack::StringRef(key));
+  return offset == it->second.end() ? _size : offset->second;
+}
+
+template <typename M>
+DenseCombiningInCache<M>::DenseCombiningInCache(WorkerConfig const* config,
+                                                MessageFormat<M> const* format,
+                                                MessageCombiner<M> const* combiner,
+                                                std::shared_ptr<VertexOffsets const> offsets)
+    : InCache<M>(format),
+      _combiner(combiner),
+      _offsets(std::move(offsets)),
+      _values(_offsets->size()),
+      _present(_offsets->size(), 0) {
+  if (config != nullptr) {
+    for (PregelShard shardID : config->localPregelShardIDs()) {
+      this->_bucketLocker[shardID];
+    }
+  }
+}
+
+template <typename M>
+void DenseCombiningInCache<M>::_store(size_t offset, M const& value) {
+  if (_present[offset]) {
+    _combiner->combine(_values[offset], value);
+  } else {
+    _values[offset] = value;
+    _present[offset] = 1;
+  }
+}
+
+template <typename M>
+void DenseCombiningInCache<M>::_set(PregelShard shard, PregelKey const& key, M const& newValue) {
+  size_t offset = _offsets->find(shard, key);
+  if (offset < _offsets->size()) {
+    _store(offset, newValue);
+  }
+}
+
+template <typename M>
+void DenseCombiningInCache<M>::mergeCache(WorkerConfig const& config,
+                                          InCache<M> const* otherCache) {
+  // the thread local caches are not dense, they only hold few vertices
+  auto other = dynamic_cast<CombiningInCache<M> const*>(otherCache);
+  TRI_ASSERT(other != nullptr);
+  this->_containedMessageCount += other->_containedMessageCount;
+
+  for (auto const& it : other->_shardMap) {
+    if (it.second.empty()) {
+      continue;
+    }
+    std::lock_guard<std::mutex> guard(this->_bucketLocker[it.first]);
+    for (auto const& vertexMessage : it.second) {
+      size_t offset = _offsets->find(it.first, vertexMessage.first);
+      if (offset < _offsets->size()) {
+        _store(offset, vertexMessage.second);
+      }
+    }
+  }
+}
+
+template <typename M>
+MessageIterator<M> DenseCombiningInCache<M>::getMessages(PregelShard shard,
+                                                         PregelKey const& key) {
+  size_t offset = _offsets->find(shard, key);
+  if (offset < _offsets->size() && _present[offset]) {
+    return MessageIterator<M>(&_values[offset]);
+  }
+  return MessageIterator<M>();
+}
+
+template <typename M>
+MessageIterator<M> DenseCombiningInCache<M>::getMessages(size_t offset,
+                                                         VertexEntry const& vertex) {
+  TRI_ASSERT(&_offsets->vertex(offset) == &vertex);
+  if (_present[offset]) {
+    return MessageIterator<M>(&_values[offset]);
+  }
+  return MessageIterator<M>();
+}
+
+template <typename M>
+void DenseCombiningInCache<M>::clear() {
+  std::fill(_present.begin(), _present.end(), 0);
+  this->_containedMessageCount = 0;
+}
+
+/// Deletes one entry. DOES NOT LOCK
+template <typename M>
+void DenseCombiningInCache<M>::erase(PregelShard shard, PregelKey const& key) {
+  size_t offset = _offsets->find(shard, key);
+  if (offset < _offsets->size() && _present[offset]) {
+    _present[offset] = 0;
+    this->_containedMessageCount--;
+  }
+}
+
+/// Calls function for each entry. DOES NOT LOCK
+template <typename M>
+void DenseCombiningInCache<M>::forEach(
+    std::function<void(PregelShard shard, PregelKey const& key, M const&)> func) {
+  for (size_t offset = 0; offset < _present.size(); ++offset) {
+    if (_present[offset]) {
+      VertexEntry const& vertex = _offsets->vertex(offset);
+      func(vertex.shard(), vertex.key(), _values[offset]);
+    }
+  }
+}
+
 // template types to create
 template class arangodb::pregel::InCache<int64_t>;
 template class arangodb::pregel::InCache<uint64_t>;
@@ -324,20 +500,28 @@ template class arangodb::pregel::ArrayInCache<uint64_t>;
 template class arangodb::pregel::ArrayInCache<float>;
 template class arangodb::pregel::ArrayInCache<double>;
 template class arangodb::pregel::CombiningInCache<int64_t>;
+template class arangodb::pregel::DenseCombiningInCache<int64_t>;
 template class arangodb::pregel::CombiningInCache<uint64_t>;
+template class arangodb::pregel::DenseCombiningInCache<uint64_t>;
 template class arangodb::pregel::CombiningInCache<float>;
+template class arangodb::pregel::DenseCombiningInCache<float>;
 template class arangodb::pregel::CombiningInCache<double>;
+template class arangodb::pregel::DenseCombiningInCache<double>;
 
 // algo specific
 template class arangodb::pregel::InCache<SenderMessage<uint64_t>>;
 template class arangodb::pregel::ArrayInCache<SenderMessage<uint64_t>>;
 template class arangodb::pregel::CombiningInCache<SenderMessage<uint64_t>>;
+template class arangodb::pregel::DenseCombiningInCache<SenderMessage<uint64_t>>;
 template class arangodb::pregel::InCache<SenderMessage<double>>;
 template class arangodb::pregel::ArrayInCache<SenderMessage<double>>;
 template class arangodb::pregel::CombiningInCache<SenderMessage<double>>;
+template class arangodb::pregel::DenseCombiningInCache<SenderMessage<double>>;
 template class arangodb::pregel::InCache<DMIDMessage>;
 template class arangodb::pregel::ArrayInCache<DMIDMessage>;
 template class arangodb::pregel::CombiningInCache<DMIDMessage>;
+template class arangodb::pregel::DenseCombiningInCache<DMIDMessage>;
 template class arangodb::pregel::InCache<HLLCounter>;
 template class arangodb::pregel::ArrayInCache<HLLCounter>;
 template class arangodb::pregel::CombiningInCache<HLLCounter>;
+template class arangodb::pregel::DenseCombiningInCache<HLLCounter>;
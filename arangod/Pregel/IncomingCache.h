@@ -24,8 +24,10 @@
 #define ARANGODB_IN_MESSAGE_CACHE_H 1
 
 #include <velocypack/Slice.h>
+#include <velocypack/StringRef.h>
 
 #include <atomic>
+#include <memory>
 #include <string>
 
 #include "Basics/Common.h"
@@ -56,12 +58,22 @@ class InCache {
   explicit InCache(MessageFormat<M> const* format);
   virtual void _set(PregelShard shard, PregelKey const& vertexId, M const& data) = 0;
 
+  /// @brief stores the messages of a binary batch, see
+  /// Utils::binaryMessagesKey. must be called under the lock of the shard
+  void _parseBinary(PregelShard shard, VPackSlice batch);
+
  public:
   virtual ~InCache() {}
 
   MessageFormat<M> const* format() const { return _format; }
   uint64_t containedMessageCount() const { return _containedMessageCount; }
 
+  /// @brief estimated memory of the stored messages, including the map
+  /// entries of their vertices. does not lock
+  virtual size_t memoryUsage() const {
+    return _containedMessageCount * (sizeof(M) + sizeof(PregelKey) + 2 * sizeof(void*));
+  }
+
   void parseMessages(VPackSlice const& messages);
 
   /// @brief Store a single message.
@@ -74,6 +86,11 @@ class InCache {
   /// @brief get messages for vertex id. (Don't use keys from _from or _to
   /// directly, they contain the collection name)
   virtual MessageIterator<M> getMessages(PregelShard shard, PregelKey const& key) = 0;
+  /// @brief get messages for the vertex at the given offset of the index
+  /// of the graph store
+  virtual MessageIterator<M> getMessages(size_t /*offset*/, VertexEntry const& vertex) {
+    return getMessages(vertex.shard(), vertex.key());
+  }
   /// clear cache
   virtual void clear() = 0;
 
@@ -107,6 +124,9 @@ class ArrayInCache : public InCache<M> {
 /// Cache which stores one value per vertex id
 template <typename M>
 class CombiningInCache : public InCache<M> {
+  template <typename T>
+  friend class DenseCombiningInCache;
+
   typedef std::unordered_map<PregelKey, M> HMap;
 
   MessageCombiner<M> const* _combiner;
@@ -128,6 +148,66 @@ class CombiningInCache : public InCache<M> {
   void erase(PregelShard shard, PregelKey const& key) override;
   void forEach(std::function<void(PregelShard, PregelKey const&, M const&)> func) override;
 };
+
+/// @brief the offsets of the vertices in the index of a loaded graph store.
+/// the index must not change while this is used
+class VertexOffsets {
+ public:
+  explicit VertexOffsets(RangeIterator<VertexEntry> vertices);
+
+  size_t size() const { return _size; }
+
+  VertexEntry const& vertex(size_t offset) const { return _vertices[offset]; }
+
+  /// @brief the offset of a vertex, size() if it is not loaded
+  size_t find(PregelShard shard, PregelKey const& key) const;
+
+ private:
+  VertexEntry const* _vertices;
+  size_t _size;
+  std::unordered_map<PregelShard, std::unordered_map<velocypack::StringRef, size_t>> _offsets;
+};
+
+/// @brief cache which stores one value per vertex in an array, at the
+/// offset of the vertex in the graph store. reading the messages of a
+/// vertex during a superstep does not need a lookup. messages are combined
+/// under the lock of their shard, like in CombiningInCache. messages for
+/// vertices that are not loaded are dropped
+template <typename M>
+class DenseCombiningInCache : public InCache<M> {
+  MessageCombiner<M> const* _combiner;
+  std::shared_ptr<VertexOffsets const> _offsets;
+  std::vector<M> _values;
+  // whether _values holds a message, one byte each so that vertices of
+  // different shards can be written concurrently
+  std::vector<uint8_t> _present;
+
+  void _store(size_t offset, M const& value);
+
+ protected:
+  void _set(PregelShard shard, PregelKey const& vertexId, M const& data) override;
+
+ public:
+  DenseCombiningInCache(WorkerConfig const* config, MessageFormat<M> const* format,
+                        MessageCombiner<M> const* combiner,
+                        std::shared_ptr<VertexOffsets const> offsets);
+
+  /// @brief the message at an offset, nullptr if there is none. does not lock
+  M const* message(size_t offset) const {
+    return _present[offset] ? &_values[offset] : nullptr;
+  }
+
+  size_t memoryUsage() const override {
+    return _values.capacity() * sizeof(M) + _present.capacity();
+  }
+
+  void mergeCache(WorkerConfig const& config, InCache<M> const* otherCache) override;
+  MessageIterator<M> getMessages(PregelShard shard, PregelKey const& key) override;
+  MessageIterator<M> getMessages(size_t offset, VertexEntry const& vertex) override;
+  void clear() override;
+  void erase(PregelShard shard, PregelKey const& key) override;
+  void forEach(std::function<void(PregelShard, PregelKey const&, M const&)> func) override;
+};
 }  // namespace pregel
 }  // namespace arangodb
 #endif
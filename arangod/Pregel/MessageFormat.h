@@ -24,6 +24,7 @@
 #define ARANGODB_PREGEL_MFORMAT_H 1
 
 #include <cstddef>
+#include <cstring>
 #include "Basics/Common.h"
 
 #include <velocypack/Builder.h>
@@ -38,6 +39,13 @@ struct MessageFormat {
   virtual ~MessageFormat() {}
   virtual void unwrapValue(VPackSlice body, M& value) const = 0;
   virtual void addValue(VPackBuilder& arrayBuilder, M const& val) const = 0;
+
+  /// @brief the size of a message in binary message batches. formats of
+  /// fixed size messages return it, their messages are copied into the
+  /// batch instead of being built as velocypack. 0 means no binary format
+  virtual size_t binarySize() const { return 0; }
+  virtual void writeBinary(char* /*buffer*/, M const& /*val*/) const {}
+  virtual void readBinary(char const* /*buffer*/, M& /*value*/) const {}
 };
 
 struct IntegerMessageFormat : public MessageFormat<int64_t> {
@@ -48,6 +56,13 @@ struct IntegerMessageFormat : public MessageFormat<int64_t> {
   void addValue(VPackBuilder& arrayBuilder, int64_t const& val) const override {
     arrayBuilder.add(VPackValue(val));
   }
+  size_t binarySize() const override { return sizeof(int64_t); }
+  void writeBinary(char* buffer, int64_t const& val) const override {
+    memcpy(buffer, &val, sizeof(val));
+  }
+  void readBinary(char const* buffer, int64_t& value) const override {
+    memcpy(&value, buffer, sizeof(value));
+  }
 };
 
 /*
@@ -81,6 +96,13 @@ struct NumberMessageFormat : public MessageFormat<M> {
   void addValue(VPackBuilder& arrayBuilder, M const& val) const override {
     arrayBuilder.add(VPackValue(val));
   }
+  size_t binarySize() const override { return sizeof(M); }
+  void writeBinary(char* buffer, M const& val) const override {
+    memcpy(buffer, &val, sizeof(val));
+  }
+  void readBinary(char const* buffer, M& value) const override {
+    memcpy(&value, buffer, sizeof(value));
+  }
 };
 }  // namespace pregel
 }  // namespace arangodb
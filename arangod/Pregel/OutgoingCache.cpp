@@ -44,6 +44,40 @@ OutCache<M>::OutCache(WorkerConfig* state, MessageFormat<M> const* format)
   _baseUrl = Utils::baseUrl(_config->database(), Utils::workerPrefix);
 }
 
+template <typename M>
+void OutCache<M>::_appendBinary(std::string& batch, PregelKey const& key,
+                                M const* values, size_t count) const {
+  size_t const size = _format->binarySize();
+  TRI_ASSERT(size > 0);
+  uint32_t length = static_cast<uint32_t>(key.size());
+  uint32_t number = static_cast<uint32_t>(count);
+  size_t offset = batch.size();
+  batch.resize(offset + 2 * sizeof(uint32_t) + key.size() + count * size);
+  char* p = &batch[offset];
+  memcpy(p, &length, sizeof(length));
+  p += sizeof(length);
+  memcpy(p, key.data(), key.size());
+  p += key.size();
+  memcpy(p, &number, sizeof(number));
+  p += sizeof(number);
+  for (size_t i = 0; i < count; ++i) {
+    _format->writeBinary(p, values[i]);
+    p += size;
+  }
+}
+
+namespace {
+/// @brief a request posting messages to a shard, as velocypack
+ClusterCommRequest messagesRequest(std::string const& shardId, std::string const& url,
+                                   VPackSlice data) {
+  auto headers = std::make_unique<std::unordered_map<std::string, std::string>>();
+  headers->emplace(StaticStrings::ContentTypeHeader, StaticStrings::MimeTypeVPack);
+  auto body = std::make_shared<std::string>(data.startAs<char>(), data.byteSize());
+  return ClusterCommRequest("shard:" + shardId, rest::RequestType::POST, url,
+                            body, std::move(headers));
+}
+}  // namespace
+
 // ================= ArrayOutCache ==================
 
 template <typename M>
@@ -105,29 +139,43 @@ void ArrayOutCache<M>::flushMessages() {
     data.add(Utils::executionNumberKey, VPackValue(this->_config->executionNumber()));
     data.add(Utils::globalSuperstepKey, VPackValue(gss));
     data.add(Utils::shardIdKey, VPackValue(shard));
-    data.add(Utils::messagesKey, VPackValue(VPackValueType::Array, true));
-    for (auto const& vertexMessagePair : vertexMessageMap) {
-      data.add(VPackValuePair(vertexMessagePair.first.data(),
-                              vertexMessagePair.first.size(),
-                              VPackValueType::String));      // key
-      data.add(VPackValue(VPackValueType::Array, true));  // message array
-      for (M const& val : vertexMessagePair.second) {
-        this->_format->addValue(data, val);
-        if (this->_sendToNextGSS) {
-          this->_sendCountNextGSS++;
-        } else {
-          this->_sendCount++;
+    size_t count = 0;
+    if (this->_format->binarySize() > 0) {
+      std::string batch;
+      for (auto const& vertexMessagePair : vertexMessageMap) {
+        this->_appendBinary(batch, vertexMessagePair.first,
+                            vertexMessagePair.second.data(),
+                            vertexMessagePair.second.size());
+        count += vertexMessagePair.second.size();
+      }
+      data.add(Utils::binaryMessagesKey,
+               VPackValuePair(batch.data(), batch.size(), VPackValueType::Binary));
+    } else {
+      data.add(Utils::messagesKey, VPackValue(VPackValueType::Array, true));
+      for (auto const& vertexMessagePair : vertexMessageMap) {
+        data.add(VPackValuePair(vertexMessagePair.first.data(),
+                                vertexMessagePair.first.size(),
+                                VPackValueType::String));      // key
+        data.add(VPackValue(VPackValueType::Array, true));  // message array
+        for (M const& val : vertexMessagePair.second) {
+          this->_format->addValue(data, val);
         }
+        count += vertexMessagePair.second.size();
+        data.close();
       }
       data.close();
     }
     data.close();
-    data.close();
+    this->_sendBytes += data.slice().byteSize();
+    if (this->_sendToNextGSS) {
+      this->_sendCountNextGSS += count;
+    } else {
+      this->_sendCount += count;
+    }
     // add a request
     ShardID const& shardId = this->_config->globalShardIDs()[shard];
-    auto body = std::make_shared<std::string>(data.toJson());
-    requests.emplace_back("shard:" + shardId, rest::RequestType::POST,
-                          this->_baseUrl + Utils::messagesPath, body);
+    requests.emplace_back(::messagesRequest(shardId, this->_baseUrl + Utils::messagesPath,
+                                            data.slice()));
   }
 
   ClusterComm::instance()->performRequests(requests, 120,
@@ -209,26 +257,34 @@ void CombiningOutCache<M>::flushMessages() {
     data.add(Utils::executionNumberKey, VPackValue(this->_config->executionNumber()));
     data.add(Utils::globalSuperstepKey, VPackValue(gss));
     data.add(Utils::shardIdKey, VPackValue(shard));
-    data.add(Utils::messagesKey, VPackValue(VPackValueType::Array, true));
-    for (auto const& vertexMessagePair : vertexMessageMap) {
-      data.add(VPackValuePair(vertexMessagePair.first.data(),
-                              vertexMessagePair.first.size(),
-                              VPackValueType::String));            // key
-      this->_format->addValue(data, vertexMessagePair.second);  // value
-
-      if (this->_sendToNextGSS) {
-        this->_sendCountNextGSS++;
-      } else {
-        this->_sendCount++;
+    if (this->_format->binarySize() > 0) {
+      std::string batch;
+      for (auto const& vertexMessagePair : vertexMessageMap) {
+        this->_appendBinary(batch, vertexMessagePair.first, &vertexMessagePair.second, 1);
+      }
+      data.add(Utils::binaryMessagesKey,
+               VPackValuePair(batch.data(), batch.size(), VPackValueType::Binary));
+    } else {
+      data.add(Utils::messagesKey, VPackValue(VPackValueType::Array, true));
+      for (auto const& vertexMessagePair : vertexMessageMap) {
+        data.add(VPackValuePair(vertexMessagePair.first.data(),
+                                vertexMessagePair.first.size(),
+                                VPackValueType::String));            // key
+        this->_format->addValue(data, vertexMessagePair.second);  // value
       }
+      data.close();
     }
     data.close();
-    data.close();
+    this->_sendBytes += data.slice().byteSize();
+    if (this->_sendToNextGSS) {
+      this->_sendCountNextGSS += vertexMessageMap.size();
+    } else {
+      this->_sendCount += vertexMessageMap.size();
+    }
     // add a request
     ShardID const& shardId = this->_config->globalShardIDs()[shard];
-    auto body = std::make_shared<std::string>(data.toJson());
-    requests.emplace_back("shard:" + shardId, rest::RequestType::POST,
-                          this->_baseUrl + Utils::messagesPath, body);
+    requests.emplace_back(::messagesRequest(shardId, this->_baseUrl + Utils::messagesPath,
+                                            data.slice()));
   }
 
   ClusterComm::instance()->performRequests(requests, 180, LogTopic("Pregel"), false);
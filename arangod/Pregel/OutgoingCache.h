@@ -65,14 +65,22 @@ class OutCache {
   size_t _containedMessages = 0;
   size_t _sendCount = 0;
   size_t _sendCountNextGSS = 0;
+  size_t _sendBytes = 0;
   virtual void _removeContainedMessages() = 0;
 
+  /// @brief appends the messages of a vertex to a binary message batch,
+  /// see Utils::binaryMessagesKey
+  void _appendBinary(std::string& batch, PregelKey const& key, M const* values,
+                     size_t count) const;
+
  public:
   OutCache(WorkerConfig* state, MessageFormat<M> const* format);
   virtual ~OutCache() {}
 
   size_t sendCount() const { return _sendCount; }
   size_t sendCountNextGSS() const { return _sendCountNextGSS; }
+  /// @brief size of the message batches sent to other servers
+  size_t sendBytes() const { return _sendBytes; }
   uint32_t batchSize() const { return _batchSize; }
   void setBatchSize(uint32_t bs) { _batchSize = bs; }
   inline void setLocalCache(InCache<M>* cache) { _localCache = cache; }
@@ -90,6 +98,7 @@ class OutCache {
   void clear() {
     _sendCount = 0;
     _sendCountNextGSS = 0;
+    _sendBytes = 0;
     _removeContainedMessages();
   };
   virtual void appendMessage(PregelShard shard, PregelKey const& key, M const& data) = 0;
@@ -28,6 +28,9 @@
 #include <velocypack/velocypack-aliases.h>
 #include "Pregel/Utils.h"
 
+#include <algorithm>
+#include <map>
+
 namespace arangodb {
 namespace pregel {
 
@@ -36,6 +39,18 @@ struct MessageStats {
   size_t receivedCount = 0;
   double superstepRuntimeSecs = 0;
 
+  // summed up over all threads of a worker
+  size_t sendBytes = 0;
+  double computeSecs = 0;
+  double sendSecs = 0;
+  double parseSecs = 0;
+  // time between the end of the previous superstep and the start of
+  // this one, waiting for the other workers
+  double waitSecs = 0;
+  // estimated memory in bytes, not summed up
+  size_t graphMemory = 0;
+  size_t cacheMemory = 0;
+
   MessageStats() {}
   MessageStats(VPackSlice statValues) { accumulate(statValues); }
   MessageStats(size_t s, size_t r) : sendCount(s), receivedCount(r) {}
@@ -44,6 +59,13 @@ struct MessageStats {
     sendCount += other.sendCount;
     receivedCount += other.receivedCount;
     superstepRuntimeSecs += other.superstepRuntimeSecs;
+    sendBytes += other.sendBytes;
+    computeSecs += other.computeSecs;
+    sendSecs += other.sendSecs;
+    parseSecs += other.parseSecs;
+    waitSecs += other.waitSecs;
+    graphMemory = std::max(graphMemory, other.graphMemory);
+    cacheMemory = std::max(cacheMemory, other.cacheMemory);
   }
 
   void accumulate(VPackSlice statValues) {
@@ -59,6 +81,34 @@ struct MessageStats {
     // if (p.isNumber()) {
     //  superstepRuntimeSecs += p.getNumber<double>();
     //}
+    p = statValues.get(Utils::sendBytesKey);
+    if (p.isInteger()) {
+      sendBytes += p.getUInt();
+    }
+    p = statValues.get(Utils::computeTimeKey);
+    if (p.isNumber()) {
+      computeSecs += p.getNumber<double>();
+    }
+    p = statValues.get(Utils::sendTimeKey);
+    if (p.isNumber()) {
+      sendSecs += p.getNumber<double>();
+    }
+    p = statValues.get(Utils::parseTimeKey);
+    if (p.isNumber()) {
+      parseSecs += p.getNumber<double>();
+    }
+    p = statValues.get(Utils::waitTimeKey);
+    if (p.isNumber()) {
+      waitSecs += p.getNumber<double>();
+    }
+    p = statValues.get(Utils::graphMemoryKey);
+    if (p.isInteger()) {
+      graphMemory = std::max<size_t>(graphMemory, p.getUInt());
+    }
+    p = statValues.get(Utils::cacheMemoryKey);
+    if (p.isInteger()) {
+      cacheMemory = std::max<size_t>(cacheMemory, p.getUInt());
+    }
   }
 
   void serializeValues(VPackBuilder& b) const {
@@ -66,10 +116,28 @@ struct MessageStats {
     b.add(Utils::receivedCountKey, VPackValue(receivedCount));
   }
 
+  /// the timings, bytes and memory, see serializeValues for the counts
+  void serializeTimings(VPackBuilder& b) const {
+    b.add(Utils::sendBytesKey, VPackValue(sendBytes));
+    b.add(Utils::computeTimeKey, VPackValue(computeSecs));
+    b.add(Utils::sendTimeKey, VPackValue(sendSecs));
+    b.add(Utils::parseTimeKey, VPackValue(parseSecs));
+    b.add(Utils::waitTimeKey, VPackValue(waitSecs));
+    b.add(Utils::graphMemoryKey, VPackValue(graphMemory));
+    b.add(Utils::cacheMemoryKey, VPackValue(cacheMemory));
+  }
+
   void resetTracking() {
     sendCount = 0;
     receivedCount = 0;
     superstepRuntimeSecs = 0;
+    sendBytes = 0;
+    computeSecs = 0;
+    sendSecs = 0;
+    parseSecs = 0;
+    waitSecs = 0;
+    graphMemory = 0;
+    cacheMemory = 0;
   }
 
   bool allMessagesProcessed() { return sendCount == receivedCount; }
@@ -90,9 +158,49 @@ struct StatsManager {
     VPackSlice sender = data.get(Utils::senderKey);
     if (sender.isString()) {
       _serverStats[sender.copyString()].accumulate(data);
+      VPackSlice gss = data.get(Utils::globalSuperstepKey);
+      if (gss.isInteger()) {
+        _superstepStats[gss.getUInt()][sender.copyString()].accumulate(data);
+      }
     }
   }
 
+  /// keeps the load times of the shards of a worker
+  void accumulateLoadStats(VPackSlice data) {
+    VPackSlice sender = data.get(Utils::senderKey);
+    VPackSlice times = data.get(Utils::shardLoadTimesKey);
+    if (sender.isString() && times.isObject()) {
+      VPackBuilder& stats = _loadStats[sender.copyString()];
+      stats.clear();
+      stats.add(times);
+    }
+  }
+
+  /// the statistics of every worker in every superstep so far, and the
+  /// load times of their shards
+  void serializeHistory(VPackBuilder& b) const {
+    b.add("supersteps", VPackValue(VPackValueType::Array));
+    for (auto const& step : _superstepStats) {
+      b.openObject();
+      b.add("gss", VPackValue(step.first));
+      b.add("workers", VPackValue(VPackValueType::Object));
+      for (auto const& pair : step.second) {
+        b.add(pair.first, VPackValue(VPackValueType::Object));
+        pair.second.serializeValues(b);
+        pair.second.serializeTimings(b);
+        b.close();
+      }
+      b.close();
+      b.close();
+    }
+    b.close();
+    b.add(Utils::shardLoadTimesKey, VPackValue(VPackValueType::Object));
+    for (auto const& pair : _loadStats) {
+      b.add(pair.first, pair.second.slice());
+    }
+    b.close();
+  }
+
   void serializeValues(VPackBuilder& b) const {
     MessageStats stats;
     for (auto const& pair : _serverStats) {
@@ -138,11 +246,18 @@ struct StatsManager {
 
   void reset() { _serverStats.clear(); }
 
+  /// drops the history of the supersteps from gss on, e.g. after a rollback
+  void resetHistory(uint64_t gss) {
+    _superstepStats.erase(_superstepStats.lower_bound(gss), _superstepStats.end());
+  }
+
   size_t clientCount() const { return _serverStats.size(); }
 
  private:
   std::map<std::string, uint64_t> _activeStats;
   std::map<std::string, MessageStats> _serverStats;
+  std::map<uint64_t, std::map<std::string, MessageStats>> _superstepStats;
+  std::map<std::string, VPackBuilder> _loadStats;
 };
 }  // namespace pregel
 }  // namespace arangodb
@@ -29,6 +29,7 @@
 #include "Basics/memory-map.h"
 #include "Logger/Logger.h"
 
+#include <atomic>
 #include <cstddef>
 
 #ifdef __linux__
@@ -65,6 +66,13 @@ struct TypedBuffer {
   /// of the page size
   virtual void resize(size_t newSize) = 0;
 
+  /// hint that the entries [start, start + count) are accessed soon
+  virtual void willNeed(size_t start, size_t count) {}
+
+  /// hint that the entries [start, start + count) are not accessed
+  /// anymore for a while
+  virtual void dontNeed(size_t start, size_t count) {}
+
  private:
   /// don't copy object
   TypedBuffer(const TypedBuffer&) = delete;
@@ -155,10 +163,19 @@ class MappedFileBuffer : public TypedBuffer<T> {
     // ptr);
   }
 #else
-  explicit MappedFileBuffer(size_t entries) : _size(entries) {
-    double tt = TRI_microtime();
-    std::string file = "pregel_" + std::to_string((uint64_t)tt) + ".mmap";
-    std::string filename = FileUtils::buildFilename(TRI_GetTempPath(), file);
+  explicit MappedFileBuffer(size_t entries)
+      : MappedFileBuffer(TRI_GetTempPath(), entries) {}
+#endif
+
+  /// @brief maps a new file in the given directory, its pages are written
+  /// back to the file instead of the swap space under memory pressure.
+  /// the file is removed on close
+  MappedFileBuffer(std::string const& directory, size_t entries)
+      : _size(entries) {
+    static std::atomic<uint64_t> counter(0);
+    std::string file = "pregel_" + std::to_string((uint64_t)TRI_microtime()) +
+                       "_" + std::to_string(counter++) + ".mmap";
+    std::string filename = basics::FileUtils::buildFilename(directory, file);
 
     _mappedSize = sizeof(T) * _size;
     _fd = TRI_CreateDatafile(filename, _mappedSize);
@@ -178,7 +195,7 @@ class MappedFileBuffer : public TypedBuffer<T> {
 
     if (res != TRI_ERROR_NO_ERROR) {
       TRI_set_errno(res);
-      TRI_CLOSE(fd);
+      TRI_CLOSE(_fd);
 
       // remove empty file
       TRI_UnlinkFile(filename.c_str());
@@ -194,8 +211,8 @@ class MappedFileBuffer : public TypedBuffer<T> {
     }
 
     this->_ptr = (T*)data;
+    _filename = filename;
   }
-#endif
 
   /// close file (see close() )
   ~MappedFileBuffer() { close(); }
@@ -220,6 +237,14 @@ class MappedFileBuffer : public TypedBuffer<T> {
     TRI_MMFileAdvise(this->_ptr, _mappedSize, TRI_MADVISE_DONTNEED);
   }
 
+  void willNeed(size_t start, size_t count) override {
+    advise(start, count, TRI_MADVISE_WILLNEED);
+  }
+
+  void dontNeed(size_t start, size_t count) override {
+    advise(start, count, TRI_MADVISE_DONTNEED);
+  }
+
   /// close file
   void close() override {
     if (this->_ptr == nullptr) {
@@ -239,6 +264,7 @@ class MappedFileBuffer : public TypedBuffer<T> {
         LOG_TOPIC("00e1d", ERR, arangodb::Logger::FIXME)
             << "unable to close pregel mapped file '" << _filename << "': " << res;
       }
+      TRI_UnlinkFile(_filename.c_str());
     }
 
     this->_ptr = nullptr;
@@ -262,6 +288,9 @@ class MappedFileBuffer : public TypedBuffer<T> {
       THROW_ARANGO_EXCEPTION(TRI_ERROR_INTERNAL);
     } else if (newSize == _size) {
       return;
+    } else if (isPhysical() && newSize > _size) {
+      // the file has a fixed size
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_INTERNAL);
     }
 
 #ifdef __linux__
@@ -309,6 +338,20 @@ class MappedFileBuffer : public TypedBuffer<T> {
   /// get OS page size (for remap)
   // static int getpagesize();
 
+  /// madvise needs page aligned addresses, the range is extended to the
+  /// surrounding pages
+  void advise(size_t start, size_t count, int advice) {
+    if (this->_ptr == nullptr || start >= _size) {
+      return;
+    }
+    count = std::min(count, _size - start);
+    uintptr_t const pageSize = arangodb::PageSizeFeature::getPageSize();
+    uintptr_t begin = reinterpret_cast<uintptr_t>(this->_ptr + start);
+    uintptr_t end = reinterpret_cast<uintptr_t>(this->_ptr + start + count);
+    begin -= begin % pageSize;
+    TRI_MMFileAdvise(reinterpret_cast<void*>(begin), end - begin, advice);
+  }
+
   std::string _filename;  // underlying filename
   int _fd = -1;           // underlying file descriptor
   void* _mmHandle;        // underlying memory map object handle (windows only)
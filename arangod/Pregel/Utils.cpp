@@ -22,6 +22,7 @@
 
 #include "Utils.h"
 #include "Basics/StringUtils.h"
+#include "Basics/VelocyPackHelper.h"
 #include "Cluster/ClusterInfo.h"
 #include "Cluster/ServerState.h"
 #include "VocBase/LogicalCollection.h"
@@ -62,12 +63,16 @@ std::string const Utils::asyncModeKey = "asyncMode";
 std::string const Utils::lazyLoadingKey = "lazyloading";
 std::string const Utils::useMemoryMaps = "useMemoryMaps";
 std::string const Utils::parallelismKey = "parallelism";
+std::string const Utils::checkpointIntervalKey = "checkpointInterval";
+std::string const Utils::vertexFilterKey = "vertexFilter";
+std::string const Utils::edgeFilterKey = "edgeFilter";
 
 std::string const Utils::globalSuperstepKey = "gss";
 std::string const Utils::vertexCountKey = "vertexCount";
 std::string const Utils::edgeCountKey = "edgeCount";
 std::string const Utils::shardIdKey = "shrdId";
 std::string const Utils::messagesKey = "msgs";
+std::string const Utils::binaryMessagesKey = "binMsgs";
 std::string const Utils::senderKey = "sender";
 std::string const Utils::recoveryMethodKey = "rmethod";
 std::string const Utils::storeResultsKey = "storeResults";
@@ -75,11 +80,39 @@ std::string const Utils::aggregatorValuesKey = "aggregators";
 std::string const Utils::activeCountKey = "activeCount";
 std::string const Utils::receivedCountKey = "receivedCount";
 std::string const Utils::sendCountKey = "sendCount";
+std::string const Utils::sendBytesKey = "sendBytes";
+std::string const Utils::computeTimeKey = "computeTime";
+std::string const Utils::sendTimeKey = "sendTime";
+std::string const Utils::parseTimeKey = "parseTime";
+std::string const Utils::waitTimeKey = "waitTime";
+std::string const Utils::graphMemoryKey = "graphMemory";
+std::string const Utils::cacheMemoryKey = "cacheMemory";
+std::string const Utils::shardLoadTimesKey = "shardLoadTimes";
 std::string const Utils::enterNextGSSKey = "nextGSS";
+std::string const Utils::checkpointKey = "checkpoint";
 
 std::string const Utils::compensate = "compensate";
 std::string const Utils::rollback = "rollback";
 
+bool Utils::matchesExample(VPackSlice example, VPackSlice document) {
+  for (auto const& pair : VPackObjectIterator(example)) {
+    VPackStringRef name = pair.key.stringRef();
+    VPackSlice value;
+    if (name.find('.') == std::string::npos) {
+      value = document.get(name);
+    } else {
+      value = document.get(basics::StringUtils::split(name.toString(), '.'));
+    }
+    if (value.isNone()) {
+      value = VPackSlice::nullSlice();
+    }
+    if (basics::VelocyPackHelper::compare(value, pair.value, false) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
 std::string Utils::baseUrl(std::string const& dbName, std::string const& prefix) {
   return "/_db/" + basics::StringUtils::urlEncode(dbName) + Utils::apiPrefix +
          prefix + "/";
@@ -72,6 +72,10 @@ class Utils {
   static std::string const lazyLoadingKey;
   static std::string const useMemoryMaps;
   static std::string const parallelismKey;
+  static std::string const checkpointIntervalKey;
+  /// example documents, only matching vertices and edges are loaded
+  static std::string const vertexFilterKey;
+  static std::string const edgeFilterKey;
 
   /// Current global superstep
   static std::string const globalSuperstepKey;
@@ -88,6 +92,11 @@ class Utils {
   /// holds messages
   static std::string const messagesKey;
 
+  /// holds messages of fixed size as a binary batch. for each vertex it
+  /// contains the key length as uint32_t, the key, the number of messages
+  /// as uint32_t and the messages, all in the byte order of the sender
+  static std::string const binaryMessagesKey;
+
   /// sender cluster id
   static std::string const senderKey;
 
@@ -112,10 +121,27 @@ class Utils {
   /// superstep (bookkeeping)
   static std::string const sendCountKey;
 
+  /// Timings in seconds, bytes sent and estimated memory in bytes of a
+  /// worker during the last superstep, for the status of a run
+  static std::string const sendBytesKey;
+  static std::string const computeTimeKey;
+  static std::string const sendTimeKey;
+  static std::string const parseTimeKey;
+  static std::string const waitTimeKey;
+  static std::string const graphMemoryKey;
+  static std::string const cacheMemoryKey;
+
+  /// Seconds it took a worker to load each of its vertex shards
+  static std::string const shardLoadTimesKey;
+
   /// Used to communicate to enter the next phase
   /// only send by the conductor
   static std::string const enterNextGSSKey;
 
+  /// the global supersteps a worker has checkpoints of, or the checkpoint
+  /// a worker restored during a rollback
+  static std::string const checkpointKey;
+
   static std::string const compensate;
   static std::string const rollback;
 
@@ -125,6 +151,12 @@ class Utils {
 
   static int64_t countDocuments(TRI_vocbase_t* vocbase, std::string const& collection);
 
+  /// @brief whether the document has all attributes of the example with
+  /// equal values. attribute names may be paths separated by dots, a
+  /// missing attribute is equal to null
+  static bool matchesExample(arangodb::velocypack::Slice example,
+                             arangodb::velocypack::Slice document);
+
   static int resolveShard(WorkerConfig const* config, std::string const& collectionName,
                           std::string const& shardKey, arangodb::velocypack::StringRef vertexKey,
                           std::string& responsibleShard);
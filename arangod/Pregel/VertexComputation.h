@@ -156,6 +156,43 @@ class VertexCompensation : public VertexContext<V, E, M> {
   virtual ~VertexCompensation() {}
   virtual void compensate(bool inLostPartition) = 0;
 };
+
+/// @brief a block of consecutive vertices as arrays, see VertexKernel
+template <typename V, typename M>
+struct VertexBlock {
+  size_t count = 0;
+  V* values = nullptr;
+  /// combined message of vertex i, only valid if received[i] != 0
+  M const* messages = nullptr;
+  uint8_t const* received = nullptr;
+  /// active flag of vertex i, may be changed by the kernel
+  uint8_t* active = nullptr;
+  /// set by the kernel for every vertex, whether it sends outgoing[i]
+  uint8_t* send = nullptr;
+  M* outgoing = nullptr;
+};
+
+/// @brief optional replacement of a VertexComputation for algorithms whose
+/// vertices are updated only from their value and one combined message.
+/// the worker calls it once per block of vertices instead of once per
+/// vertex, so the update loop can be vectorized by the compiler. vertices
+/// which are not active and received no message must be left unchanged
+template <typename V, typename E, typename M>
+class VertexKernel {
+ public:
+  virtual ~VertexKernel() {}
+
+  virtual void compute(uint64_t gss, uint64_t lss, WorkerContext const* context,
+                       AggregatorHandler* aggregators, VertexBlock<V, M>& block) = 0;
+
+  /// @brief sends the outgoing message of a vertex along its edges
+  virtual void send(RangeIterator<Edge<E>>& edges, M const& outgoing,
+                    OutCache<M>* cache) {
+    for (Edge<E> const* edge : edges) {
+      cache->appendMessage(edge->targetShard(), edge->toKey(), outgoing);
+    }
+  }
+};
 }  // namespace pregel
 }  // namespace arangodb
 #endif
@@ -31,11 +31,16 @@
 #include "Pregel/VertexComputation.h"
 #include "Pregel/WorkerConfig.h"
 
+#include "ApplicationFeatures/ApplicationServer.h"
+#include "Basics/FileUtils.h"
 #include "Basics/MutexLocker.h"
 #include "Basics/ReadLocker.h"
+#include "Basics/ScopeGuard.h"
 #include "Basics/WriteLocker.h"
+#include "Basics/files.h"
 #include "Cluster/ClusterComm.h"
 #include "Cluster/ServerState.h"
+#include "RestServer/DatabasePathFeature.h"
 #include "Scheduler/Scheduler.h"
 #include "Scheduler/SchedulerFeature.h"
 #include "VocBase/ticks.h"
@@ -56,13 +61,22 @@ using namespace arangodb::pregel;
   WriteLocker<ReadWriteLock> obj(&lock, arangodb::basics::LockerType::BLOCKING, \
                                  true, __FILE__, __LINE__)
 
+namespace {
+/// @brief the vertices of a checkpoint
+std::string const checkpointVerticesKey = "vertices";
+
+/// @brief number of vertices passed to a VertexKernel at once
+constexpr size_t kernelBlockSize = 1024;
+}  // namespace
+
 template <typename V, typename E, typename M>
 Worker<V, E, M>::Worker(TRI_vocbase_t& vocbase, Algorithm<V, E, M>* algo, VPackSlice initConfig)
     : _state(WorkerState::IDLE),
       _config(&vocbase, initConfig),
       _algorithm(algo),
       _nextGSSSendMessageCount(0),
-      _requestedNextGSS(false) {
+      _requestedNextGSS(false),
+      _parseMicros(0) {
   MUTEX_LOCKER(guard, _commandMutex);
 
   VPackSlice userParams = initConfig.get(Utils::userParametersKey);
@@ -91,6 +105,9 @@ Worker<V, E, M>::~Worker() {
   delete _readCache;
   delete _writeCache;
   delete _writeCacheNextGSS;
+  for (uint64_t gss : _checkpoints) {
+    TRI_UnlinkFile(_checkpointFile(gss).c_str());
+  }
   for (InCache<M>* cache : _inCaches) {
     delete cache;
   }
@@ -136,16 +153,48 @@ void Worker<V, E, M>::_initializeMessageCaches() {
   }
 }
 
+/// @brief replace the shared caches with ones that store the messages
+/// of each vertex at its offset in the graph store, once the graph is
+/// loaded. only possible with a combiner, and not with lazy loading,
+/// which adds vertices during the computation
+template <typename V, typename E, typename M>
+void Worker<V, E, M>::_indexMessageCaches() {
+  if (!_messageCombiner || _config.lazyLoading()) {
+    return;
+  }
+
+  auto offsets = std::make_shared<VertexOffsets const>(_graphStore->vertexIterator());
+  MY_WRITE_LOCKER(guard, _cacheRWLock);
+  delete _readCache;
+  _readCache = new DenseCombiningInCache<M>(&_config, _messageFormat.get(),
+                                            _messageCombiner.get(), offsets);
+  delete _writeCache;
+  _writeCache = new DenseCombiningInCache<M>(&_config, _messageFormat.get(),
+                                             _messageCombiner.get(), offsets);
+  if (_writeCacheNextGSS) {
+    delete _writeCacheNextGSS;
+    _writeCacheNextGSS =
+        new DenseCombiningInCache<M>(&_config, _messageFormat.get(),
+                                     _messageCombiner.get(), offsets);
+  }
+}
+
 // @brief load the initial worker data, call conductor eventually
 template <typename V, typename E, typename M>
 void Worker<V, E, M>::setupWorker() {
   std::function<void()> callback = [this] {
+    _indexMessageCaches();
     VPackBuilder package;
     package.openObject();
     package.add(Utils::senderKey, VPackValue(ServerState::instance()->getId()));
     package.add(Utils::executionNumberKey, VPackValue(_config.executionNumber()));
     package.add(Utils::vertexCountKey, VPackValue(_graphStore->localVertexCount()));
     package.add(Utils::edgeCountKey, VPackValue(_graphStore->localEdgeCount()));
+    package.add(Utils::shardLoadTimesKey, VPackValue(VPackValueType::Object));
+    for (auto const& pair : _graphStore->shardLoadTimes()) {
+      package.add(pair.first, VPackValue(pair.second));
+    }
+    package.close();
     package.close();
     _callConductor(Utils::finishedStartupPath, package);
   };
@@ -219,10 +268,18 @@ void Worker<V, E, M>::prepareGlobalStep(VPackSlice const& data, VPackBuilder& re
     _messageStats.sendCount = _nextGSSSendMessageCount;
     _nextGSSSendMessageCount = 0;
   } else {
-    MY_WRITE_LOCKER(wguard, _cacheRWLock);
-    TRI_ASSERT(_readCache->containedMessageCount() == 0);
-    std::swap(_readCache, _writeCache);
-    _config._localSuperstep = gss;
+    {
+      MY_WRITE_LOCKER(wguard, _cacheRWLock);
+      TRI_ASSERT(_readCache->containedMessageCount() == 0);
+      std::swap(_readCache, _writeCache);
+      _config._localSuperstep = gss;
+    }
+
+    uint64_t interval = _config.checkpointInterval();
+    if (interval > 0 && gss > 0 && gss % interval == 0 &&
+        !_config.lazyLoading() && std::is_trivially_copyable<V>::value) {
+      _writeCheckpoint(gss);
+    }
   }
 
   // only place where is makes sense to call this, since startGlobalSuperstep
@@ -238,6 +295,14 @@ void Worker<V, E, M>::prepareGlobalStep(VPackSlice const& data, VPackBuilder& re
   response.add(Utils::activeCountKey, VPackValue(_activeCount));
   response.add(Utils::vertexCountKey, VPackValue(_graphStore->localVertexCount()));
   response.add(Utils::edgeCountKey, VPackValue(_graphStore->localEdgeCount()));
+  {
+    MUTEX_LOCKER(guard, _checkpointMutex);
+    response.add(Utils::checkpointKey, VPackValue(VPackValueType::Array));
+    for (uint64_t checkpoint : _checkpoints) {
+      response.add(VPackValue(checkpoint));
+    }
+    response.close();
+  }
   _workerAggregators->serializeValues(response);
   response.close();
 }
@@ -246,6 +311,8 @@ template <typename V, typename E, typename M>
 void Worker<V, E, M>::receivedMessages(VPackSlice const& data) {
   VPackSlice gssSlice = data.get(Utils::globalSuperstepKey);
   uint64_t gss = gssSlice.getUInt();
+  double start = TRI_microtime();
+  TRI_DEFER(_parseMicros += static_cast<uint64_t>((TRI_microtime() - start) * 1000000.0));
   if (gss == _config._globalSuperstep) {
     {  // make sure the pointer is not changed while
        // parsing messages
@@ -296,6 +363,10 @@ void Worker<V, E, M>::startGlobalStep(VPackSlice const& data) {
     _workerContext->preGlobalSuperstep(gss);
   }
 
+  if (_stepFinishedSecs > 0) {
+    _messageStats.waitSecs = TRI_microtime() - _stepFinishedSecs;
+  }
+
   LOG_TOPIC("39e20", DEBUG, Logger::PREGEL) << "Worker starts new gss: " << gss;
   _startProcessing();  // sets _state = COMPUTING;
 }
@@ -332,8 +403,11 @@ void Worker<V, E, M>::_startProcessing() {
         return;
       }
       auto vertices = _graphStore->vertexIterator(start, end);
+      _graphStore->prefetchVertices(start, end);
       // should work like a join operation
-      if (_processVertices(i, vertices) && _state == WorkerState::COMPUTING) {
+      bool last = _processVertices(i, vertices);
+      _graphStore->releaseVertices(start, end);
+      if (last && _state == WorkerState::COMPUTING) {
         _finishedProcessing();  // last thread turns the lights out
       }
     });
@@ -357,6 +431,69 @@ void Worker<V, E, M>::_initializeVertexContext(VertexContext<V, E, M>* ctx) {
   ctx->_readAggregators = _conductorAggregators.get();
 }
 
+// internally called in a WORKER THREAD!!
+// copies blocks of vertices and their messages into arrays for the kernel,
+// the results are written back and sent afterwards
+template <typename V, typename E, typename M>
+size_t Worker<V, E, M>::_processVertexBlocks(VertexKernel<V, E, M>* kernel,
+                                             DenseCombiningInCache<M> const* readCache,
+                                             RangeIterator<VertexEntry>& vertexIterator,
+                                             AggregatorHandler* aggregators,
+                                             OutCache<M>* outCache) {
+  size_t const blockSize = std::min(::kernelBlockSize, vertexIterator.size());
+  std::vector<VertexEntry*> entries(blockSize);
+  std::vector<V> values(blockSize);
+  std::vector<M> messages(blockSize);
+  std::vector<M> outgoing(blockSize);
+  std::vector<uint8_t> received(blockSize);
+  std::vector<uint8_t> active(blockSize);
+  std::vector<uint8_t> send(blockSize);
+
+  VertexBlock<V, M> block;
+  block.values = values.data();
+  block.messages = messages.data();
+  block.received = received.data();
+  block.active = active.data();
+  block.send = send.data();
+  block.outgoing = outgoing.data();
+
+  size_t activeCount = 0;
+  auto it = vertexIterator.begin();
+  auto const end = vertexIterator.end();
+  while (it != end && _state == WorkerState::COMPUTING) {
+    size_t count = 0;
+    for (; count < blockSize && it != end; ++it, ++count) {
+      VertexEntry* entry = *it;
+      M const* message = readCache->message(_graphStore->vertexOffset(entry));
+      entries[count] = entry;
+      values[count] = *_graphStore->mutableVertexData(entry);
+      received[count] = message != nullptr ? 1 : 0;
+      if (message != nullptr) {
+        messages[count] = *message;
+      }
+      active[count] = entry->active() ? 1 : 0;
+    }
+
+    block.count = count;
+    kernel->compute(_config.globalSuperstep(), _config.localSuperstep(),
+                    _workerContext.get(), aggregators, block);
+
+    for (size_t i = 0; i < count; ++i) {
+      VertexEntry* entry = entries[i];
+      *_graphStore->mutableVertexData(entry) = values[i];
+      entry->setActive(active[i] != 0);
+      if (send[i]) {
+        RangeIterator<Edge<E>> edges = _graphStore->edgeIterator(entry);
+        kernel->send(edges, outgoing[i], outCache);
+      }
+      if (active[i]) {
+        activeCount++;
+      }
+    }
+  }
+  return activeCount;
+}
+
 // internally called in a WORKER THREAD!!
 template <typename V, typename E, typename M>
 bool Worker<V, E, M>::_processVertices(size_t threadId,
@@ -387,22 +524,34 @@ bool Worker<V, E, M>::_processVertices(size_t threadId,
     vertexComputation->_enterNextGSS = true;
   }
 
+  std::unique_ptr<VertexKernel<V, E, M>> kernel;
+  auto denseCache = dynamic_cast<DenseCombiningInCache<M> const*>(_readCache);
+  if (denseCache != nullptr && !_config.asynchronousMode()) {
+    kernel.reset(_algorithm->createKernel(&_config));
+  }
+
   size_t activeCount = 0;
-  for (VertexEntry* vertexEntry : vertexIterator) {
-    MessageIterator<M> messages =
-        _readCache->getMessages(vertexEntry->shard(), vertexEntry->key());
-
-    if (messages.size() > 0 || vertexEntry->active()) {
-      vertexComputation->_vertexEntry = vertexEntry;
-      vertexComputation->compute(messages);
-      if (vertexEntry->active()) {
-        activeCount++;
+  if (kernel) {
+    activeCount = _processVertexBlocks(kernel.get(), denseCache, vertexIterator,
+                                       &workerAggregator, outCache);
+  } else {
+    for (VertexEntry* vertexEntry : vertexIterator) {
+      MessageIterator<M> messages =
+          _readCache->getMessages(_graphStore->vertexOffset(vertexEntry), *vertexEntry);
+
+      if (messages.size() > 0 || vertexEntry->active()) {
+        vertexComputation->_vertexEntry = vertexEntry;
+        vertexComputation->compute(messages);
+        if (vertexEntry->active()) {
+          activeCount++;
+        }
+      }
+      if (_state != WorkerState::COMPUTING) {
+        break;
       }
-    }
-    if (_state != WorkerState::COMPUTING) {
-      break;
     }
   }
+  double computeSecs = TRI_microtime() - start;
   // ==================== send messages to other shards ====================
   outCache->flushMessages();
   if (ADB_UNLIKELY(!_writeCache)) {  // ~Worker was called
@@ -423,6 +572,9 @@ bool Worker<V, E, M>::_processVertices(size_t threadId,
   MessageStats stats;
   stats.sendCount = outCache->sendCount();
   stats.superstepRuntimeSecs = TRI_microtime() - start;
+  stats.sendBytes = outCache->sendBytes();
+  stats.computeSecs = computeSecs;
+  stats.sendSecs = stats.superstepRuntimeSecs - computeSecs;
   inCache->clear();
   outCache->clear();
 
@@ -464,6 +616,12 @@ void Worker<V, E, M>::_finishedProcessing() {
 
     // count all received messages
     _messageStats.receivedCount = _readCache->containedMessageCount();
+    _messageStats.parseSecs = _parseMicros.exchange(0) / 1000000.0;
+    _messageStats.graphMemory = _graphStore->memoryUsage();
+    _messageStats.cacheMemory = _readCache->memoryUsage() + _writeCache->memoryUsage();
+    if (_writeCacheNextGSS) {
+      _messageStats.cacheMemory += _writeCacheNextGSS->memoryUsage();
+    }
 
     // lazy loading and async mode are a little tricky
     // the correct halting requires us to accurately track the number
@@ -509,6 +667,7 @@ void Worker<V, E, M>::_finishedProcessing() {
     package.add(Utils::executionNumberKey, VPackValue(_config.executionNumber()));
     package.add(Utils::globalSuperstepKey, VPackValue(_config.globalSuperstep()));
     _messageStats.serializeValues(package);
+    _messageStats.serializeTimings(package);
     if (_config.asynchronousMode()) {
       _workerAggregators->serializeValues(package, true);
     }
@@ -523,23 +682,29 @@ void Worker<V, E, M>::_finishedProcessing() {
       _messageBatchSize = s > 1000 ? (uint32_t)s : 1000;
     }
     _messageStats.resetTracking();
+    _stepFinishedSecs = TRI_microtime();
     LOG_TOPIC("13dbf", DEBUG, Logger::PREGEL) << "Batch size: " << _messageBatchSize;
   }
 
   if (_config.asynchronousMode()) {
     LOG_TOPIC("56a27", DEBUG, Logger::PREGEL) << "Finished LSS: " << package.toJson();
 
-    // if the conductor is unreachable or has send data (try to) proceed
+    // the conductor only answers to tell us to enter the next global
+    // superstep. we do not wait for the answer, messages which arrived in
+    // the meantime are processed right away. the termination is detected
+    // by the conductor from the reported message counts. the aggregated
+    // values of the answer are not used, the next local superstep starts
+    // with the local values anyway
     _callConductorWithResponse(Utils::finishedWorkerStepPath, package, [this](VPackSlice response) {
       if (response.isObject()) {
-        _conductorAggregators->aggregateValues(response);  // only aggregate values
         VPackSlice nextGSS = response.get(Utils::enterNextGSSKey);
-        if (nextGSS.isBool()) {
-          _requestedNextGSS = _requestedNextGSS || nextGSS.getBool();
+        if (nextGSS.isBool() && nextGSS.getBool()) {
+          _requestedNextGSS = true;
         }
         _continueAsync();
       }
     });
+    _continueAsync();
 
   } else {  // no answer expected
     _callConductor(Utils::finishedWorkerStepPath, package);
@@ -643,11 +808,11 @@ void Worker<V, E, M>::startRecovery(VPackSlice const& data) {
   // other methods might lock _commandMutex
   MUTEX_LOCKER(guard, _commandMutex);
   VPackSlice method = data.get(Utils::recoveryMethodKey);
-  if (method.compareString(Utils::compensate) != 0) {
+  bool rollback = method.isString() && method.compareString(Utils::rollback) == 0;
+  if (!rollback && method.compareString(Utils::compensate) != 0) {
     LOG_TOPIC("742c5", ERR, Logger::PREGEL) << "Unsupported operation";
     return;
   }
-  // else if (method.compareString(Utils::rollback) == 0)
 
   _state = WorkerState::RECOVERING;
   {
@@ -664,12 +829,205 @@ void Worker<V, E, M>::startRecovery(VPackSlice const& data) {
   _preRecoveryTotal = _graphStore->localVertexCount();
   WorkerConfig nextState(_config);
   nextState.updateConfig(data);
-  _graphStore->loadShards(&nextState, [this, nextState, copy] {
+  _graphStore->loadShards(&nextState, [this, nextState, copy, rollback] {
     _config = nextState;
-    compensateStep(copy.slice());
+    _indexMessageCaches();
+    if (rollback) {
+      _rollbackStep(copy.slice().get(Utils::globalSuperstepKey).getUInt());
+    } else {
+      compensateStep(copy.slice());
+    }
   });
 }
 
+template <typename V, typename E, typename M>
+std::string Worker<V, E, M>::_checkpointFile(uint64_t gss) const {
+  // in the database directory, so that the checkpoints survive a restart
+  auto databasePath =
+      application_features::ApplicationServer::getFeature<DatabasePathFeature>(
+          "DatabasePath");
+  std::string file = std::to_string(_config.executionNumber()) + "-" +
+                     std::to_string(gss) + ".vpack";
+  return basics::FileUtils::buildFilename(databasePath->subdirectoryName("pregel"), file);
+}
+
+/// @brief saves the state at the start of a global superstep, the data and
+/// active flag of all vertices and the messages they are about to receive.
+/// the snapshot is taken right away, the file is written in the background
+/// while the superstep runs. only the two latest checkpoints are kept, so
+/// that the conductor can always find one which all workers completed
+template <typename V, typename E, typename M>
+void Worker<V, E, M>::_writeCheckpoint(uint64_t gss) {
+  bool const hasData = _graphStore->graphFormat()->estimatedVertexSize() > 0;
+  auto builder = std::make_shared<VPackBuilder>();
+  builder->openObject();
+  builder->add(Utils::globalSuperstepKey, VPackValue(gss));
+  builder->add(::checkpointVerticesKey, VPackValue(VPackValueType::Array));
+  for (VertexEntry* vertexEntry : _graphStore->vertexIterator()) {
+    builder->openArray();
+    builder->add(VPackValue(vertexEntry->shard()));
+    builder->add(VPackValue(vertexEntry->key()));
+    builder->add(VPackValue(vertexEntry->active()));
+    if (hasData) {
+      V const* data = _graphStore->mutableVertexData(vertexEntry);
+      builder->add(VPackValuePair(reinterpret_cast<uint8_t const*>(data),
+                                  sizeof(V), VPackValueType::Binary));
+    }
+    builder->close();
+  }
+  builder->close();
+  builder->add(Utils::messagesKey, VPackValue(VPackValueType::Array));
+  _readCache->forEach([&](PregelShard shard, PregelKey const& key, M const& message) {
+    builder->openArray();
+    builder->add(VPackValue(shard));
+    builder->add(VPackValue(key));
+    _messageFormat->addValue(*builder, message);
+    builder->close();
+  });
+  builder->close();
+  builder->close();
+
+  TRI_ASSERT(SchedulerFeature::SCHEDULER != nullptr);
+  SchedulerFeature::SCHEDULER->queue(RequestLane::INTERNAL_LOW, [this, builder, gss] {
+    std::string file = _checkpointFile(gss);
+    try {
+      auto databasePath =
+          application_features::ApplicationServer::getFeature<DatabasePathFeature>(
+              "DatabasePath");
+      std::string directory = databasePath->subdirectoryName("pregel");
+      if (!basics::FileUtils::isDirectory(directory)) {
+        basics::FileUtils::createDirectory(directory);
+      }
+      basics::FileUtils::spit(file, reinterpret_cast<char const*>(builder->data()),
+                              builder->size(), true);
+    } catch (std::exception const& ex) {
+      LOG_TOPIC("5f0c2", WARN, Logger::PREGEL)
+          << "Could not write checkpoint " << file << ": " << ex.what();
+      TRI_UnlinkFile(file.c_str());
+      return;
+    }
+
+    MUTEX_LOCKER(guard, _checkpointMutex);
+    _checkpoints.push_back(gss);
+    while (_checkpoints.size() > 2) {
+      TRI_UnlinkFile(_checkpointFile(_checkpoints.front()).c_str());
+      _checkpoints.erase(_checkpoints.begin());
+    }
+  });
+}
+
+/// @brief restores vertex data, active flags and messages of all loaded
+/// vertices from a checkpoint. fails if a vertex is not part of it, e.g.
+/// because its shard was moved here from a lost server
+template <typename V, typename E, typename M>
+bool Worker<V, E, M>::_restoreCheckpoint(uint64_t gss) {
+  std::string file = _checkpointFile(gss);
+  if (!basics::FileUtils::exists(file)) {
+    LOG_TOPIC("c1e93", WARN, Logger::PREGEL) << "Checkpoint " << file << " does not exist";
+    return false;
+  }
+  std::string content = basics::FileUtils::slurp(file);
+  VPackSlice checkpoint(reinterpret_cast<uint8_t const*>(content.data()));
+  VPackSlice vertices = checkpoint.get(::checkpointVerticesKey);
+  VPackSlice messages = checkpoint.get(Utils::messagesKey);
+  if (!vertices.isArray() || !messages.isArray() ||
+      checkpoint.get(Utils::globalSuperstepKey).getUInt() != gss) {
+    LOG_TOPIC("9a4d6", WARN, Logger::PREGEL) << "Checkpoint " << file << " is invalid";
+    return false;
+  }
+
+  auto vertexIterator = _graphStore->vertexIterator();
+  VertexEntry* entries = *vertexIterator.begin();
+  VertexOffsets offsets(vertexIterator);
+  std::vector<bool> restored(offsets.size(), false);
+  size_t restoredCount = 0;
+  for (VPackSlice vertex : VPackArrayIterator(vertices)) {
+    PregelShard shard = vertex.at(0).getNumber<PregelShard>();
+    size_t offset = offsets.find(shard, vertex.at(1).copyString());
+    if (offset == offsets.size() || restored[offset]) {
+      continue;
+    }
+    VertexEntry* vertexEntry = entries + offset;
+    vertexEntry->setActive(vertex.at(2).getBool());
+    if (vertex.length() > 3) {
+      VPackValueLength size;
+      uint8_t const* data = vertex.at(3).getBinary(size);
+      if (size != sizeof(V)) {
+        return false;
+      }
+      memcpy(static_cast<void*>(_graphStore->mutableVertexData(vertexEntry)), data, size);
+    }
+    restored[offset] = true;
+    restoredCount++;
+  }
+  if (restoredCount != offsets.size()) {
+    LOG_TOPIC("70db5", WARN, Logger::PREGEL)
+        << "Checkpoint " << file << " misses " << (offsets.size() - restoredCount)
+        << " of the loaded vertices";
+    return false;
+  }
+
+  // the messages go to the write cache, it becomes readable with the next
+  // prepared superstep
+  _activeCount = 0;
+  for (VertexEntry* vertexEntry : _graphStore->vertexIterator()) {
+    if (vertexEntry->active()) {
+      _activeCount++;
+    }
+  }
+  MY_READ_LOCKER(guard, _cacheRWLock);
+  for (VPackSlice message : VPackArrayIterator(messages)) {
+    M value;
+    _messageFormat->unwrapValue(message.at(2), value);
+    _writeCache->storeMessage(message.at(0).getNumber<PregelShard>(),
+                              message.at(1).copyString(), value);
+  }
+  // vertices with messages are woken up, the conductor must not stop
+  if (messages.length() > 0) {
+    _activeCount++;
+  }
+
+  MUTEX_LOCKER(checkpointGuard, _checkpointMutex);
+  if (std::find(_checkpoints.begin(), _checkpoints.end(), gss) == _checkpoints.end()) {
+    _checkpoints.insert(_checkpoints.begin(), gss);
+  }
+  return true;
+}
+
+template <typename V, typename E, typename M>
+void Worker<V, E, M>::_rollbackStep(uint64_t gss) {
+  MUTEX_LOCKER(guard, _commandMutex);
+  if (_state != WorkerState::RECOVERING) {
+    LOG_TOPIC("0b8f3", WARN, Logger::PREGEL) << "Rollback aborted prematurely.";
+    return;
+  }
+
+  _workerAggregators->resetValues();
+  bool restored = false;
+  try {
+    restored = _restoreCheckpoint(gss);
+  } catch (std::exception const& ex) {
+    LOG_TOPIC("e2a71", WARN, Logger::PREGEL)
+        << "Could not restore checkpoint of gss " << gss << ": " << ex.what();
+  }
+  if (restored) {
+    _config._globalSuperstep = gss;
+    _config._localSuperstep = gss;
+  }
+
+  VPackBuilder package;
+  package.openObject();
+  package.add(Utils::senderKey, VPackValue(ServerState::instance()->getId()));
+  package.add(Utils::executionNumberKey, VPackValue(_config.executionNumber()));
+  package.add(Utils::globalSuperstepKey, VPackValue(gss));
+  if (restored) {
+    package.add(Utils::checkpointKey, VPackValue(gss));
+  }
+  _workerAggregators->serializeValues(package);
+  package.close();
+  _callConductor(Utils::finishedRecoveryPath, package);
+}
+
 template <typename V, typename E, typename M>
 void Worker<V, E, M>::compensateStep(VPackSlice const& data) {
   MUTEX_LOCKER(guard, _commandMutex);
@@ -67,6 +67,9 @@ class GraphStore;
 template <typename M>
 class InCache;
 
+template <typename M>
+class DenseCombiningInCache;
+
 template <typename M>
 class OutCache;
 
@@ -77,6 +80,9 @@ class VertexEntry;
 template <typename V, typename E, typename M>
 class VertexContext;
 
+template <typename V, typename E, typename M>
+class VertexKernel;
+
 template <typename V, typename E, typename M>
 class Worker : public IWorker {
   // friend class arangodb::RestPregelHandler;
@@ -134,14 +140,32 @@ class Worker : public IWorker {
   std::atomic<uint64_t> _nextGSSSendMessageCount;
   /// if the worker has started sendng messages to the next GSS
   std::atomic<bool> _requestedNextGSS;
+  /// time spent parsing received messages, in microseconds
+  std::atomic<uint64_t> _parseMicros;
+  /// when the last superstep was reported to the conductor
+  double _stepFinishedSecs = 0;
   Scheduler::WorkHandle _workHandle;
 
+  // locks _checkpoints
+  mutable Mutex _checkpointMutex;
+  /// global supersteps with a completely written checkpoint, oldest first
+  std::vector<uint64_t> _checkpoints;
+
   void _initializeMessageCaches();
+  void _indexMessageCaches();
   void _initializeVertexContext(VertexContext<V, E, M>* ctx);
   void _startProcessing();
   bool _processVertices(size_t threadId, RangeIterator<VertexEntry>& vertexIterator);
+  size_t _processVertexBlocks(VertexKernel<V, E, M>* kernel,
+                              DenseCombiningInCache<M> const* readCache,
+                              RangeIterator<VertexEntry>& vertexIterator,
+                              AggregatorHandler* aggregators, OutCache<M>* outCache);
   void _finishedProcessing();
   void _continueAsync();
+  std::string _checkpointFile(uint64_t gss) const;
+  void _writeCheckpoint(uint64_t gss);
+  bool _restoreCheckpoint(uint64_t gss);
+  void _rollbackStep(uint64_t gss);
   void _callConductor(std::string const& path, VPackBuilder const& message);
   void _callConductorWithResponse(std::string const& path, VPackBuilder const& message,
                                   std::function<void(VPackSlice slice)> handle);
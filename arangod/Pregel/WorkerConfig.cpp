@@ -63,6 +63,20 @@ void WorkerConfig::updateConfig(VPackSlice params) {
   if (parallel.isInteger()) {
     _parallelism = std::min<size_t>(std::max<size_t>(1, parallel.getUInt()), maxP);
   }
+  VPackSlice checkpointInterval = userParams.get(Utils::checkpointIntervalKey);
+  if (checkpointInterval.isInteger()) {
+    _checkpointInterval = checkpointInterval.getUInt();
+  }
+  auto readFilter = [&userParams](std::string const& key, VPackBuilder& filter) {
+    VPackSlice example = userParams.get(key);
+    if (example.isObject()) {
+      filter.add(example);
+    } else if (!example.isNone()) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER, key + " must be an object");
+    }
+  };
+  readFilter(Utils::vertexFilterKey, _vertexFilter);
+  readFilter(Utils::edgeFilterKey, _edgeFilter);
 
   // list of all shards, equal on all workers. Used to avoid storing strings of
   // shard names
@@ -23,6 +23,7 @@
 #ifndef ARANGODB_PREGEL_WORKER_CONFIG_H
 #define ARANGODB_PREGEL_WORKER_CONFIG_H 1
 
+#include <velocypack/Builder.h>
 #include <velocypack/velocypack-aliases.h>
 #include <algorithm>
 #include "Basics/Common.h"
@@ -62,6 +63,14 @@ class WorkerConfig {
 
   inline uint64_t parallelism() const { return _parallelism; }
 
+  /// write a checkpoint every this many global supersteps, 0 if never
+  inline uint64_t checkpointInterval() const { return _checkpointInterval; }
+
+  /// the example documents of the vertices and edges to load, none if
+  /// everything is loaded
+  inline VPackSlice vertexFilter() const { return _vertexFilter.slice(); }
+  inline VPackSlice edgeFilter() const { return _edgeFilter.slice(); }
+
   inline std::string const& coordinatorId() const { return _coordinatorId; }
 
   inline TRI_vocbase_t* const& vocbase() const { return _vocbase; }
@@ -129,6 +138,9 @@ class WorkerConfig {
   bool _useMemoryMaps = false; /// always use mmaps
 
   size_t _parallelism = 1;
+  uint64_t _checkpointInterval = 0;
+  VPackBuilder _vertexFilter;
+  VPackBuilder _edgeFilter;
 
   std::string _coordinatorId;
   TRI_vocbase_t* _vocbase;
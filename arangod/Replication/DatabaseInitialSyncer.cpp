@@ -37,6 +37,8 @@
 #include "Replication/DatabaseReplicationApplier.h"
 #include "Replication/utilities.h"
 #include "RestServer/DatabaseFeature.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "SimpleHttpClient/SimpleHttpClient.h"
 #include "SimpleHttpClient/SimpleHttpResult.h"
 #include "StorageEngine/EngineSelectorFeature.h"
@@ -59,7 +61,10 @@
 #include <velocypack/Validator.h>
 #include <velocypack/velocypack-aliases.h>
 #include <array>
+#include <atomic>
+#include <condition_variable>
 #include <cstring>
+#include <mutex>
 
 // lets keep this experimental until we make it faster
 #define VPACK_DUMP 0
@@ -89,6 +94,52 @@ std::chrono::milliseconds sleepTimeFromWaitTime(double waitTime) {
 std::string const kTypeString = "type";
 std::string const kDataString = "data";
 
+/// @brief shared state of the workers dumping collections in parallel
+struct ParallelDump {
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<std::function<void()>> jobs;
+  /// @brief index of the next collection to dump
+  std::atomic<size_t> next{0};
+  /// @brief number of jobs currently running
+  size_t running = 0;
+  /// @brief first error reported by any worker
+  arangodb::Result result;
+
+  /// @brief run a job unless another thread has taken it already
+  static void run(std::shared_ptr<ParallelDump> const& shared, size_t index) {
+    std::function<void()> job;
+    {
+      std::lock_guard<std::mutex> guard(shared->mutex);
+      if (index >= shared->jobs.size() || !shared->jobs[index]) {
+        return;
+      }
+      job = std::move(shared->jobs[index]);
+      shared->jobs[index] = nullptr;
+      ++shared->running;
+    }
+
+    job();  // must not throw
+
+    std::lock_guard<std::mutex> guard(shared->mutex);
+    --shared->running;
+    shared->cv.notify_all();
+  }
+
+  /// @brief remember the first failure, so that all workers stop
+  void fail(arangodb::Result const& res) {
+    std::lock_guard<std::mutex> guard(mutex);
+    if (result.ok()) {
+      result = res;
+    }
+  }
+
+  bool failed() {
+    std::lock_guard<std::mutex> guard(mutex);
+    return result.fail();
+  }
+};
+
 }  // namespace
 
 namespace arangodb {
@@ -300,6 +351,13 @@ void DatabaseInitialSyncer::setProgress(std::string const& msg) {
   }
 }
 
+void DatabaseInitialSyncer::dataReceived(httpclient::SimpleHttpResult const& response) {
+  if (_dataReceivedHandler) {
+    _dataReceivedHandler(response.hasContentLength() ? response.getContentLength()
+                                                     : response.getBody().length());
+  }
+}
+
 /// @brief send a WAL flush command
 Result DatabaseInitialSyncer::sendFlush() {
   if (isAborted()) {
@@ -692,6 +750,7 @@ Result DatabaseInitialSyncer::fetchCollectionDump(arangodb::LogicalCollection* c
     if (dumpResponse->hasContentLength()) {
       bytesReceived += dumpResponse->getContentLength();
     }
+    dataReceived(*dumpResponse);
 
     bool found;
     std::string header =
@@ -1448,9 +1507,110 @@ Result DatabaseInitialSyncer::handleCollectionsAndViews(VPackSlice const& collSl
   // ----------------------------------------------------------------------------------
 
   // now load the data into the collections
+  if (_config.applier._initialSyncThreads > 1 && collections.size() > 1) {
+    return dumpCollectionsParallel(collections, incremental);
+  }
   return iterateCollections(collections, incremental, PHASE_DUMP);
 }
 
+/// @brief dump the data of several collections concurrently, using child
+/// syncers with their own connections to the master
+Result DatabaseInitialSyncer::dumpCollectionsParallel(
+    std::vector<std::pair<VPackSlice, VPackSlice>> const& collections, bool incremental) {
+  size_t const numWorkers =
+      std::min<size_t>(_config.applier._initialSyncThreads, collections.size());
+
+  // flush the WAL on the master only once instead of once per worker
+  if (!_config.flushed) {
+    Result res = sendFlush();
+    if (res.fail()) {
+      return res;
+    }
+    _config.flushed = true;
+  }
+
+  _config.progress.set("starting phase " + translatePhase(PHASE_DUMP) + " with " +
+                       std::to_string(collections.size()) + " collections and " +
+                       std::to_string(numWorkers) + " workers");
+
+  auto shared = std::make_shared<ParallelDump>();
+  auto dumpCollections = [shared, &collections, incremental](DatabaseInitialSyncer& syncer) {
+    try {
+      while (!shared->failed()) {
+        size_t const i = shared->next.fetch_add(1);
+        if (i >= collections.size()) {
+          break;
+        }
+        Result res = syncer.handleCollection(collections[i].first, collections[i].second,
+                                             incremental, PHASE_DUMP);
+        if (res.fail()) {
+          shared->fail(res);
+        }
+      }
+    } catch (basics::Exception const& ex) {
+      shared->fail(Result(ex.code(), ex.what()));
+    } catch (std::exception const& ex) {
+      shared->fail(Result(TRI_ERROR_INTERNAL, ex.what()));
+    } catch (...) {
+      shared->fail(Result(TRI_ERROR_INTERNAL));
+    }
+  };
+
+  // this syncer is the first worker. the others are child syncers, which
+  // share our dump batch and barrier but use their own connection, so that
+  // their requests to the master do not queue up behind each other
+  std::vector<std::shared_ptr<DatabaseInitialSyncer>> children;
+  shared->jobs.emplace_back([this, dumpCollections]() { dumpCollections(*this); });
+  for (size_t i = 1; i < numWorkers; ++i) {
+    auto child = std::make_shared<DatabaseInitialSyncer>(vocbase(), _state.applier);
+    if (!child->_config.connection.valid()) {
+      break;
+    }
+    child->useAsChildSyncer(_state.master, _state.barrier.id, _state.barrier.updateTime,
+                            _config.batch.id, _config.batch.updateTime);
+    child->_config.flushed = true;
+    child->_dataReceivedHandler = _dataReceivedHandler;
+    shared->jobs.emplace_back([child, dumpCollections]() { dumpCollections(*child); });
+    children.emplace_back(std::move(child));
+  }
+
+  size_t const n = shared->jobs.size();
+  auto* scheduler = SchedulerFeature::SCHEDULER;
+  if (scheduler != nullptr) {
+    for (size_t i = 1; i < n; ++i) {
+      scheduler->queue(RequestLane::INTERNAL_LOW,
+                       [shared, i]() { ParallelDump::run(shared, i); });
+    }
+  }
+  // jobs not picked up by the scheduler yet are run by this thread
+  for (size_t i = 0; i < n; ++i) {
+    ParallelDump::run(shared, i);
+  }
+
+  {
+    // child syncers do not keep the batch and barrier alive on their own
+    std::unique_lock<std::mutex> guard(shared->mutex);
+    while (shared->running > 0) {
+      if (!shared->cv.wait_for(guard, std::chrono::seconds(30),
+                               [&shared]() { return shared->running == 0; }) &&
+          !_config.isChild()) {
+        guard.unlock();
+        _config.batch.extend(_config.connection, _config.progress);
+        _config.barrier.extend(_config.connection);
+        guard.lock();
+      }
+    }
+  }
+
+  if (shared->result.fail()) {
+    return shared->result;
+  }
+  if (isAborted()) {
+    return Result(TRI_ERROR_REPLICATION_APPLIER_STOPPED);
+  }
+  return Result();
+}
+
 /// @brief iterate over all collections from an array and apply an action
 Result DatabaseInitialSyncer::iterateCollections(
     std::vector<std::pair<VPackSlice, VPackSlice>> const& collections,
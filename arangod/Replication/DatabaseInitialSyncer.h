@@ -154,6 +154,13 @@ class DatabaseInitialSyncer final : public InitialSyncer {
   /// in rocksdb for a constant view of the data
   double batchUpdateTime() const { return _config.batch.updateTime; }
 
+  /// @brief set a handler that is told the size of every response with
+  /// document data received from the master. the handler may block in
+  /// order to throttle the synchronization
+  void setDataReceivedHandler(std::function<void(uint64_t)> const& handler) {
+    _dataReceivedHandler = handler;
+  }
+
   /// @brief fetch the server's inventory, public method
   Result getInventory(arangodb::velocypack::Builder& builder);
 
@@ -170,6 +177,9 @@ class DatabaseInitialSyncer final : public InitialSyncer {
   /// @brief set a progress message
   void setProgress(std::string const& msg);
 
+  /// @brief report the size of a response to the data received handler
+  void dataReceived(httpclient::SimpleHttpResult const& response);
+
   /// @brief send a WAL flush command
   Result sendFlush();
 
@@ -210,6 +220,12 @@ class DatabaseInitialSyncer final : public InitialSyncer {
                                    arangodb::velocypack::Slice const& views,
                                    bool incremental);
 
+  /// @brief dump the data of several collections concurrently, using child
+  /// syncers with their own connections to the master
+  Result dumpCollectionsParallel(
+      std::vector<std::pair<arangodb::velocypack::Slice, arangodb::velocypack::Slice>> const&,
+      bool incremental);
+
   /// @brief iterate over all collections from an array and apply an action
   Result iterateCollections(
       std::vector<std::pair<arangodb::velocypack::Slice, arangodb::velocypack::Slice>> const&,
@@ -219,6 +235,9 @@ class DatabaseInitialSyncer final : public InitialSyncer {
   Result handleViewCreation(VPackSlice const& views);
 
   Configuration _config;
+
+  /// @brief optional handler for the size of received responses
+  std::function<void(uint64_t)> _dataReceivedHandler;
 };
 
 }  // namespace arangodb
@@ -130,10 +130,14 @@ Result DatabaseTailingSyncer::syncCollectionCatchupInternal(std::string const& c
                             "&serverId=" + _state.localServerIdString +
                             "&collection=" + StringUtils::urlEncode(collectionName);
 
+    // masters that do not support VelocyPack markers send JSON lines
+    auto headers = replutils::createHeaders();
+    headers[StaticStrings::Accept] = StaticStrings::MimeTypeVPack;
+
     // send request
     std::unique_ptr<httpclient::SimpleHttpResult> response;
     _state.connection.lease([&](httpclient::SimpleHttpClient* client) {
-      response.reset(client->request(rest::RequestType::GET, url, nullptr, 0));
+      response.reset(client->request(rest::RequestType::GET, url, nullptr, 0, headers));
     });
 
     if (replutils::hasFailed(response.get())) {
@@ -0,0 +1,63 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ParallelApply.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
+
+using namespace arangodb;
+
+void ParallelApply::run(std::shared_ptr<ParallelApply> const& shared, size_t index) {
+  std::function<void()> job;
+  {
+    std::lock_guard<std::mutex> guard(shared->mutex);
+    if (index >= shared->jobs.size() || !shared->jobs[index]) {
+      return;
+    }
+    job = std::move(shared->jobs[index]);
+    shared->jobs[index] = nullptr;
+    ++shared->running;
+  }
+
+  job();  // must not throw
+
+  std::lock_guard<std::mutex> guard(shared->mutex);
+  --shared->running;
+  shared->cv.notify_all();
+}
+
+void ParallelApply::execute(std::shared_ptr<ParallelApply> const& shared) {
+  size_t const n = shared->jobs.size();
+  auto* scheduler = SchedulerFeature::SCHEDULER;
+  if (scheduler != nullptr) {
+    for (size_t i = 1; i < n; ++i) {
+      scheduler->queue(RequestLane::INTERNAL_LOW,
+                       [shared, i]() { ParallelApply::run(shared, i); });
+    }
+  }
+  // jobs not picked up by the scheduler yet are run by this thread
+  for (size_t i = 0; i < n; ++i) {
+    ParallelApply::run(shared, i);
+  }
+
+  std::unique_lock<std::mutex> guard(shared->mutex);
+  shared->cv.wait(guard, [&shared]() { return shared->running == 0; });
+  shared->jobs.clear();
+}
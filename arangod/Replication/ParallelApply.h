@@ -0,0 +1,50 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_REPLICATION_PARALLEL_APPLY_H
+#define ARANGOD_REPLICATION_PARALLEL_APPLY_H 1
+
+#include "Basics/Common.h"
+
+#include <condition_variable>
+#include <mutex>
+
+namespace arangodb {
+
+/// @brief jobs that are run by scheduler threads and by the calling thread.
+/// the state is owned jointly, so jobs that only start after all work is
+/// done can still see that they have nothing to do
+struct ParallelApply {
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<std::function<void()>> jobs;
+  /// @brief number of jobs currently running
+  size_t running = 0;
+
+  /// @brief run a job unless another thread has taken it already
+  static void run(std::shared_ptr<ParallelApply> const& shared, size_t index);
+
+  /// @brief run all jobs and wait until they are done
+  static void execute(std::shared_ptr<ParallelApply> const& shared);
+};
+
+}  // namespace arangodb
+
+#endif
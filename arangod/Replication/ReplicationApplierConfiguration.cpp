@@ -53,6 +53,8 @@ ReplicationApplierConfiguration::ReplicationApplierConfiguration()
       _initialSyncMaxWaitTime(300 * 1000 * 1000),
       _autoResyncRetries(2),
       _maxPacketSize(512 * 1024 * 1024),
+      _applyThreads(1),
+      _initialSyncThreads(1),
       _sslProtocol(0),
       _skipCreateDrop(false),
       _autoStart(false),
@@ -84,6 +86,8 @@ void ReplicationApplierConfiguration::reset() {
   _initialSyncMaxWaitTime = 300 * 1000 * 1000;
   _autoResyncRetries = 2;
   _maxPacketSize = 512 * 1024 * 1024;
+  _applyThreads = 1;
+  _initialSyncThreads = 1;
   _sslProtocol = 0;
   _skipCreateDrop = false;
   _autoStart = false;
@@ -138,6 +142,8 @@ void ReplicationApplierConfiguration::toVelocyPack(VPackBuilder& builder, bool i
   builder.add("autoResync", VPackValue(_autoResync));
   builder.add("autoResyncRetries", VPackValue(_autoResyncRetries));
   builder.add("maxPacketSize", VPackValue(_maxPacketSize));
+  builder.add("applyThreads", VPackValue(_applyThreads));
+  builder.add("initialSyncThreads", VPackValue(_initialSyncThreads));
   builder.add("includeSystem", VPackValue(_includeSystem));
   builder.add("includeFoxxQueues", VPackValue(_includeFoxxQueues));
   builder.add("requireFromPresent", VPackValue(_requireFromPresent));
@@ -361,6 +367,18 @@ ReplicationApplierConfiguration ReplicationApplierConfiguration::fromVelocyPack(
     configuration._maxPacketSize = value.getNumber<uint64_t>();
   }
 
+  value = slice.get("applyThreads");
+  if (value.isNumber()) {
+    configuration._applyThreads =
+        std::max<uint64_t>(1, std::min<uint64_t>(value.getNumber<uint64_t>(), 64));
+  }
+
+  value = slice.get("initialSyncThreads");
+  if (value.isNumber()) {
+    configuration._initialSyncThreads =
+        std::max<uint64_t>(1, std::min<uint64_t>(value.getNumber<uint64_t>(), 16));
+  }
+
   // read the endpoint
   value = slice.get("endpoint");
   if (!value.isNone()) {
@@ -23,17 +23,62 @@
 
 #include "ReplicationClients.h"
 #include "Basics/Exceptions.h"
+#include "Basics/FileUtils.h"
 #include "Basics/ReadLocker.h"
+#include "Basics/VelocyPackHelper.h"
 #include "Basics/WriteLocker.h"
+#include "Basics/files.h"
 #include "Logger/Logger.h"
 #include "Replication/common-defines.h"
 #include "Replication/utilities.h"
 
 #include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
 #include <velocypack/velocypack-aliases.h>
 
 using namespace arangodb;
 
+constexpr double ReplicationSubscription::DefaultTtl;
+
+/// @brief add the attributes of the subscription to an open object
+void ReplicationSubscription::toVelocyPack(velocypack::Builder& builder) const {
+  builder.add("committedTick", VPackValue(std::to_string(committedTick)));
+  builder.add("collections", VPackValue(VPackValueType::Array));
+  for (auto const& name : collections) {
+    builder.add(VPackValue(name));
+  }
+  builder.close();  // collections
+  builder.add("ttl", VPackValue(ttl));
+
+  char buffer[21];
+  TRI_GetTimeStampReplication(expireStamp, &buffer[0], sizeof(buffer));
+  builder.add("expires", VPackValue(buffer));
+  builder.add("expireStamp", VPackValue(expireStamp));
+}
+
+/// @brief read a subscription as written by toVelocyPack
+ReplicationSubscription ReplicationSubscription::fromVelocyPack(velocypack::Slice slice) {
+  ReplicationSubscription subscription;
+  subscription.committedTick =
+      basics::VelocyPackHelper::stringUInt64(slice, "committedTick");
+  VPackSlice collections = slice.get("collections");
+  if (collections.isArray()) {
+    for (VPackSlice name : VPackArrayIterator(collections)) {
+      if (name.isString()) {
+        subscription.collections.emplace_back(name.copyString());
+      }
+    }
+  }
+  subscription.ttl = basics::VelocyPackHelper::getNumericValue<double>(slice, "ttl", DefaultTtl);
+  if (subscription.ttl <= 0.0) {
+    subscription.ttl = DefaultTtl;
+  }
+  // files written before subscriptions expired get a full TTL from now
+  subscription.expireStamp = basics::VelocyPackHelper::getNumericValue<double>(
+      slice, "expireStamp", TRI_microtime() + subscription.ttl);
+  return subscription;
+}
+
 /// @brief simply extend the lifetime of a specific client, so that its entry does not expire
 /// does not update the client's lastServedTick value
 void ReplicationClientsProgressTracker::extend(std::string const& clientId, double ttl) {
@@ -128,7 +173,7 @@ void ReplicationClientsProgressTracker::toVelocyPack(velocypack::Builder& builde
   }
 }
 
-/// @brief garbage-collect the existing list of clients
+/// @brief garbage-collect the existing list of clients and subscriptions
 /// thresholdStamp is the timestamp before all older entries will
 /// be collected
 void ReplicationClientsProgressTracker::garbageCollect(double thresholdStamp) {
@@ -149,6 +194,23 @@ void ReplicationClientsProgressTracker::garbageCollect(double thresholdStamp) {
       ++it;
     }
   }
+
+  bool removed = false;
+  for (auto it = _subscriptions.begin(); it != _subscriptions.end();) {
+    if ((*it).second.expireStamp < thresholdStamp) {
+      // a consumer that is gone for good must not keep the WAL forever
+      LOG_TOPIC("c5e02", INFO, Logger::REPLICATION)
+          << "removing expired replication subscription '" << (*it).first
+          << "' at tick " << (*it).second.committedTick;
+      it = _subscriptions.erase(it);
+      removed = true;
+    } else {
+      ++it;
+    }
+  }
+  if (removed) {
+    persistSubscriptions();
+  }
 }
 
 /// @brief return the lowest lastServedTick value for all clients
@@ -159,5 +221,166 @@ uint64_t ReplicationClientsProgressTracker::lowestServedValue() const {
   for (auto const& it : _clients) {
     value = std::min(value, it.second.lastServedTick);
   }
+  for (auto const& it : _subscriptions) {
+    value = std::min(value, it.second.committedTick);
+  }
+  return value;
+}
+
+/// @brief return the lowest committed tick of all subscriptions
+/// returns UINT64_MAX in case no subscriptions exist
+uint64_t ReplicationClientsProgressTracker::lowestCommittedTick() const {
+  READ_LOCKER(readLocker, _lock);
+  uint64_t value = UINT64_MAX;
+  for (auto const& it : _subscriptions) {
+    value = std::min(value, it.second.committedTick);
+  }
   return value;
 }
+
+/// @brief load the subscriptions from a file, which is also used to
+/// persist all later changes
+void ReplicationClientsProgressTracker::loadSubscriptions(std::string const& filename) {
+  WRITE_LOCKER(writeLocker, _lock);
+
+  _subscriptionsFile = filename;
+  _subscriptions.clear();
+
+  if (!basics::FileUtils::exists(filename)) {
+    return;
+  }
+
+  try {
+    VPackBuilder builder = basics::VelocyPackHelper::velocyPackFromFile(filename);
+    VPackSlice subscriptions = builder.slice();
+    if (!subscriptions.isObject()) {
+      return;
+    }
+    for (auto const& it : VPackObjectIterator(subscriptions)) {
+      if (it.value.isObject()) {
+        _subscriptions.emplace(it.key.copyString(),
+                               ReplicationSubscription::fromVelocyPack(it.value));
+      }
+    }
+  } catch (std::exception const& ex) {
+    LOG_TOPIC("3d0f1", WARN, Logger::REPLICATION)
+        << "unable to load replication subscriptions from file '" << filename
+        << "': " << ex.what();
+  }
+}
+
+/// @brief remove all subscriptions including their file
+void ReplicationClientsProgressTracker::dropSubscriptions() {
+  WRITE_LOCKER(writeLocker, _lock);
+
+  _subscriptions.clear();
+  if (!_subscriptionsFile.empty() && basics::FileUtils::exists(_subscriptionsFile)) {
+    TRI_UnlinkFile(_subscriptionsFile.c_str());
+  }
+  _subscriptionsFile.clear();
+}
+
+/// @brief create or update a subscription. the tick is only used for a
+/// new subscription. a ttl <= 0 uses the default TTL
+Result ReplicationClientsProgressTracker::subscribe(std::string const& name,
+                                                    std::vector<std::string> const& collections,
+                                                    uint64_t tick, double ttl) {
+  if (name.empty()) {
+    return Result(TRI_ERROR_BAD_PARAMETER, "invalid subscription name");
+  }
+  if (ttl <= 0.0) {
+    ttl = ReplicationSubscription::DefaultTtl;
+  }
+
+  WRITE_LOCKER(writeLocker, _lock);
+
+  auto it = _subscriptions.find(name);
+  if (it == _subscriptions.end()) {
+    ReplicationSubscription subscription;
+    subscription.committedTick = tick;
+    it = _subscriptions.emplace(name, std::move(subscription)).first;
+    LOG_TOPIC("58a1d", DEBUG, Logger::REPLICATION)
+        << "creating replication subscription '" << name << "' at tick " << tick;
+  }
+  (*it).second.collections = collections;
+  (*it).second.ttl = ttl;
+  (*it).second.expireStamp = TRI_microtime() + ttl;
+
+  return persistSubscriptions();
+}
+
+/// @brief remove a subscription
+Result ReplicationClientsProgressTracker::unsubscribe(std::string const& name) {
+  WRITE_LOCKER(writeLocker, _lock);
+
+  if (_subscriptions.erase(name) == 0) {
+    return Result(TRI_ERROR_HTTP_NOT_FOUND, "subscription not found");
+  }
+  LOG_TOPIC("a0c7e", DEBUG, Logger::REPLICATION)
+      << "removing replication subscription '" << name << "'";
+
+  return persistSubscriptions();
+}
+
+/// @brief commit the progress of a subscription, ticks never go back.
+/// this also extends the lifetime of the subscription
+Result ReplicationClientsProgressTracker::commit(std::string const& name, uint64_t tick) {
+  WRITE_LOCKER(writeLocker, _lock);
+
+  auto it = _subscriptions.find(name);
+  if (it == _subscriptions.end()) {
+    return Result(TRI_ERROR_HTTP_NOT_FOUND, "subscription not found");
+  }
+  // an idle consumer commits its old tick to stay alive
+  (*it).second.committedTick = std::max((*it).second.committedTick, tick);
+  (*it).second.expireStamp = TRI_microtime() + (*it).second.ttl;
+
+  return persistSubscriptions();
+}
+
+/// @brief look up a subscription
+bool ReplicationClientsProgressTracker::subscription(std::string const& name,
+                                                     ReplicationSubscription& result) const {
+  READ_LOCKER(readLocker, _lock);
+
+  auto it = _subscriptions.find(name);
+  if (it == _subscriptions.end()) {
+    return false;
+  }
+  result = (*it).second;
+  return true;
+}
+
+/// @brief serialize the subscriptions to a VelocyPack object
+void ReplicationClientsProgressTracker::subscriptionsToVelocyPack(velocypack::Builder& builder) const {
+  READ_LOCKER(readLocker, _lock);
+  subscriptionsToVelocyPackUnlocked(builder);
+}
+
+/// @brief serialize the subscriptions, must hold the lock
+void ReplicationClientsProgressTracker::subscriptionsToVelocyPackUnlocked(velocypack::Builder& builder) const {
+  builder.openObject();
+  for (auto const& it : _subscriptions) {
+    builder.add(it.first, VPackValue(VPackValueType::Object));
+    it.second.toVelocyPack(builder);
+    builder.close();
+  }
+  builder.close();
+}
+
+/// @brief write the subscriptions to their file, must hold the lock
+Result ReplicationClientsProgressTracker::persistSubscriptions() const {
+  if (_subscriptionsFile.empty()) {
+    return Result();
+  }
+
+  VPackBuilder builder;
+  subscriptionsToVelocyPackUnlocked(builder);
+
+  if (!basics::VelocyPackHelper::velocyPackToFile(_subscriptionsFile, builder.slice(), true)) {
+    return Result(TRI_ERROR_CANNOT_WRITE_FILE,
+                  "unable to write replication subscriptions to file '" +
+                      _subscriptionsFile + "'");
+  }
+  return Result();
+}
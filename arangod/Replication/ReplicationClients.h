@@ -26,10 +26,12 @@
 
 #include "Basics/Common.h"
 #include "Basics/ReadWriteLock.h"
+#include "Basics/Result.h"
 
 namespace arangodb {
 namespace velocypack {
 class Builder;
+class Slice;
 }
 
 /// @brief struct representing how far a replication client
@@ -48,6 +50,29 @@ struct ReplicationClientProgress {
         lastServedTick(lastServedTick) {}
 };
 
+/// @brief a named consumer of the WAL. its progress is persisted and the WAL
+/// is kept until the consumer has committed that it processed it, or until
+/// the consumer has not been heard of for the TTL of the subscription
+struct ReplicationSubscription {
+  /// @brief TTL used when none is given, in seconds
+  static constexpr double DefaultTtl = 7.0 * 24.0 * 3600.0;
+
+  /// @brief collections the consumer is interested in, all if empty
+  std::vector<std::string> collections;
+  /// @brief last tick the consumer has committed
+  uint64_t committedTick = 0;
+  /// @brief seconds after the last subscribe or commit the subscription expires
+  double ttl = DefaultTtl;
+  /// @brief timestamp of when the subscription will be considered expired
+  double expireStamp = 0.0;
+
+  /// @brief add the attributes of the subscription to an open object
+  void toVelocyPack(velocypack::Builder& builder) const;
+
+  /// @brief read a subscription as written by toVelocyPack
+  static ReplicationSubscription fromVelocyPack(velocypack::Slice slice);
+};
+
 /// @brief class to track progress of individual replication clients
 /// for a particular database
 class ReplicationClientsProgressTracker {
@@ -69,20 +94,64 @@ class ReplicationClientsProgressTracker {
   /// @brief serialize the existing clients to a VelocyPack builder
   void toVelocyPack(velocypack::Builder& builder) const;
 
-  /// @brief garbage-collect the existing list of clients
+  /// @brief garbage-collect the existing list of clients and subscriptions
   /// thresholdStamp is the timestamp before all older entries will
   /// be collected
   void garbageCollect(double thresholdStamp);
 
-  /// @brief return the lowest lastServedTick value for all clients
+  /// @brief return the lowest lastServedTick value for all clients and the
+  /// lowest committed tick of all subscriptions
   /// returns UINT64_MAX in case no clients are registered
   uint64_t lowestServedValue() const;
 
+  /// @brief return the lowest committed tick of all subscriptions
+  /// returns UINT64_MAX in case no subscriptions exist
+  uint64_t lowestCommittedTick() const;
+
+  /// @brief load the subscriptions from a file, which is also used to
+  /// persist all later changes
+  void loadSubscriptions(std::string const& filename);
+
+  /// @brief remove all subscriptions including their file
+  void dropSubscriptions();
+
+  /// @brief create or update a subscription. the tick is only used for a
+  /// new subscription. a ttl <= 0 uses the default TTL
+  Result subscribe(std::string const& name,
+                   std::vector<std::string> const& collections, uint64_t tick,
+                   double ttl = 0.0);
+
+  /// @brief remove a subscription
+  Result unsubscribe(std::string const& name);
+
+  /// @brief commit the progress of a subscription, ticks never go back.
+  /// this also extends the lifetime of the subscription
+  Result commit(std::string const& name, uint64_t tick);
+
+  /// @brief look up a subscription
+  bool subscription(std::string const& name, ReplicationSubscription& result) const;
+
+  /// @brief serialize the subscriptions to a VelocyPack object
+  void subscriptionsToVelocyPack(velocypack::Builder& builder) const;
+
+ private:
+  /// @brief serialize the subscriptions, must hold the lock
+  void subscriptionsToVelocyPackUnlocked(velocypack::Builder& builder) const;
+
+  /// @brief write the subscriptions to their file, must hold the lock
+  Result persistSubscriptions() const;
+
  private:
   mutable basics::ReadWriteLock _lock;
 
   /// @brief mapping from client id -> progress
   std::unordered_map<std::string, ReplicationClientProgress> _clients; 
+
+  /// @brief mapping from subscription name -> subscription
+  std::unordered_map<std::string, ReplicationSubscription> _subscriptions;
+
+  /// @brief file the subscriptions are persisted in, empty if not persisted
+  std::string _subscriptionsFile;
 };
 
 }  // namespace arangodb
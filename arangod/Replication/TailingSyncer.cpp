@@ -31,8 +31,10 @@
 #include "Basics/StringBuffer.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Basics/WriteLocker.h"
+#include "Indexes/Index.h"
 #include "Logger/Logger.h"
 #include "Replication/InitialSyncer.h"
+#include "Replication/ParallelApply.h"
 #include "Replication/ReplicationApplier.h"
 #include "Replication/ReplicationTransaction.h"
 #include "Rest/HttpRequest.h"
@@ -56,6 +58,7 @@
 #include <velocypack/Parser.h>
 #include <velocypack/Slice.h>
 #include <velocypack/StringRef.h>
+#include <velocypack/Validator.h>
 #include <velocypack/velocypack-aliases.h>
 
 using namespace arangodb;
@@ -395,6 +398,14 @@ Result TailingSyncer::processDocument(TRI_replication_operation_e type,
     return Result(TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND);
   }
 
+  return processDocument(type, slice, *vocbase, coll, _documentBuilder,
+                         AccessMode::Type::EXCLUSIVE);
+}
+
+Result TailingSyncer::processDocument(TRI_replication_operation_e type,
+                                      VPackSlice const& slice, TRI_vocbase_t& vocbase,
+                                      LogicalCollection* coll, VPackBuilder& builder,
+                                      AccessMode::Type accessType) {
   bool const isSystem = coll->system();
   bool const isUsers = coll->name() == TRI_COL_NAME_USERS; 
 
@@ -437,15 +448,15 @@ Result TailingSyncer::processDocument(TRI_replication_operation_e type,
   // in case this is a removal we need to build our marker
   VPackSlice applySlice = data;
   if (type == REPLICATION_MARKER_REMOVE) {
-    _documentBuilder.clear();
-    _documentBuilder.openObject();
-    _documentBuilder.add(StaticStrings::KeyString, key);
+    builder.clear();
+    builder.openObject();
+    builder.add(StaticStrings::KeyString, key);
     if (rev.isString()) {
       // _rev is an optional attribute
-      _documentBuilder.add(StaticStrings::RevString, rev);
+      builder.add(StaticStrings::RevString, rev);
     }
-    _documentBuilder.close();
-    applySlice = _documentBuilder.slice();
+    builder.close();
+    applySlice = builder.slice();
   }
 
   if (tid > 0) {  // part of a transaction
@@ -501,8 +512,8 @@ Result TailingSyncer::processDocument(TRI_replication_operation_e type,
     }
     
     // update the apply tick for all standalone operations
-    SingleCollectionTransaction trx(transaction::StandaloneContext::Create(*vocbase),
-                                    *coll, AccessMode::Type::EXCLUSIVE);
+    SingleCollectionTransaction trx(transaction::StandaloneContext::Create(vocbase),
+                                    *coll, accessType);
 
     // we will always check if the target document already exists and then either
     // carry out an insert or a replace.
@@ -1048,6 +1059,125 @@ Result TailingSyncer::applyLogMarker(VPackSlice const& slice,
 }
 
 /// @brief apply the data from the continuous log
+/// @brief a standalone document marker waiting to be applied in parallel
+struct TailingSyncer::PendingMarker {
+  /// @brief owns the marker if it was parsed from JSON
+  std::shared_ptr<VPackBuilder> builder;
+  VPackSlice marker;
+  bool skipped;
+  TRI_voc_tick_t tick;
+  TRI_replication_operation_e type;
+  TRI_vocbase_t* vocbase;
+  std::shared_ptr<LogicalCollection> collection;
+  /// @brief markers with the same partition are applied in order
+  size_t partition;
+  Result result;
+};
+
+void TailingSyncer::updateAppliedTick(TRI_voc_tick_t firstRegularTick,
+                                      TRI_voc_tick_t markerTick, bool skipped) {
+  WRITE_LOCKER_EVENTUAL(writeLocker, _applier->_statusLock);
+
+  if (markerTick > firstRegularTick &&
+      markerTick > _applier->_state._lastProcessedContinuousTick) {
+    TRI_ASSERT(markerTick > 0);
+    _applier->_state._lastProcessedContinuousTick = markerTick;
+  }
+
+  if (_applier->_state._lastProcessedContinuousTick > _applier->_state._lastAppliedContinuousTick) {
+    _applier->_state._lastAppliedContinuousTick = _applier->_state._lastProcessedContinuousTick;
+  }
+
+  if (skipped) {
+    ++_applier->_state._totalSkippedOperations;
+  } else if (_ongoingTransactions.empty()) {
+    _applier->_state._safeResumeTick = _applier->_state._lastProcessedContinuousTick;
+  }
+}
+
+Result TailingSyncer::handleApplyError(Result res, VPackSlice const& marker,
+                                       uint64_t& ignoreCount) {
+  TRI_ASSERT(res.fail());
+  std::string errorMsg = res.errorMessage();
+
+  if (ignoreCount == 0) {
+    std::string json = marker.toJson();
+    if (json.size() > 1024) {
+      errorMsg += ", offending marker: " + json.substr(0, 1024) + "...";
+    } else {
+      errorMsg += ", offending marker: " + json;
+    }
+
+    res.reset(res.errorNumber(), errorMsg);
+    return res;
+  }
+
+  ignoreCount--;
+  LOG_TOPIC("c887a", WARN, Logger::REPLICATION)
+      << "ignoring replication error for database '" << _state.databaseName
+      << "': " << errorMsg;
+  return Result();
+}
+
+Result TailingSyncer::applyPendingMarkers(std::vector<PendingMarker>& pending,
+                                         TRI_voc_tick_t firstRegularTick,
+                                         uint64_t& ignoreCount) {
+  if (pending.empty()) {
+    return Result();
+  }
+
+  size_t const numThreads = static_cast<size_t>(_state.applier._applyThreads);
+  TRI_ASSERT(numThreads > 1);
+  std::vector<std::vector<PendingMarker*>> partitions(numThreads);
+  for (auto& marker : pending) {
+    if (!marker.skipped) {
+      partitions[marker.partition % numThreads].push_back(&marker);
+    }
+  }
+
+  auto shared = std::make_shared<ParallelApply>();
+  for (auto& partition : partitions) {
+    if (partition.empty()) {
+      continue;
+    }
+    shared->jobs.emplace_back([this, &partition]() {
+      VPackBuilder builder;
+      for (PendingMarker* marker : partition) {
+        try {
+          // the collection is not a system collection, so the operation
+          // does not touch any state of the syncer
+          marker->result = processDocument(marker->type, marker->marker,
+                                           *marker->vocbase, marker->collection.get(),
+                                           builder, AccessMode::Type::WRITE);
+        } catch (basics::Exception const& ex) {
+          marker->result.reset(ex.code(), ex.what());
+        } catch (std::exception const& ex) {
+          marker->result.reset(TRI_ERROR_INTERNAL, ex.what());
+        } catch (...) {
+          marker->result.reset(TRI_ERROR_INTERNAL,
+                               "unknown exception in processDocument");
+        }
+      }
+    });
+  }
+  ParallelApply::execute(shared);
+
+  // errors are handled and ticks are updated in marker order, as if the
+  // markers had been applied one by one
+  Result res;
+  for (auto const& marker : pending) {
+    if (!marker.skipped && marker.result.fail()) {
+      res = handleApplyError(marker.result, marker.marker, ignoreCount);
+      if (res.fail()) {
+        break;
+      }
+    }
+    updateAppliedTick(firstRegularTick, marker.tick, marker.skipped);
+  }
+  pending.clear();
+  return res;
+}
+
 Result TailingSyncer::applyLog(SimpleHttpResult* response, TRI_voc_tick_t firstRegularTick,
                                ApplyStats& applyStats, uint64_t& ignoreCount) {
   // reload users if they were modified
@@ -1068,41 +1198,73 @@ Result TailingSyncer::applyLog(SimpleHttpResult* response, TRI_voc_tick_t firstR
   // buffer must end with a NUL byte
   TRI_ASSERT(*end == '\0');
 
+  // markers are either consecutive VelocyPack values or JSON lines
+  bool found = false;
+  std::string const& contentType =
+      response->getHeaderField(StaticStrings::ContentTypeHeader, found);
+  bool const binary = found && contentType == StaticStrings::MimeTypeVPack;
+
+  VPackOptions options;
+  options.validateUtf8Strings = true;
+  options.disallowExternals = true;
+  options.disallowCustom = true;
+  options.checkAttributeUniqueness = true;
+  options.unsupportedTypeBehavior = VPackOptions::FailOnUnsupportedType;
+  VPackValidator validator(&options);
+
   // TODO: re-use a builder!
   auto builder = std::make_shared<VPackBuilder>();
 
+  // standalone document operations are collected and applied on several
+  // threads, any other marker is applied after them
+  bool const applyInParallel = _state.applier._applyThreads > 1;
+  std::vector<PendingMarker> pending;
+  // whether or not a collection has unique secondary indexes
+  std::unordered_map<TRI_voc_cid_t, bool> uniqueIndexes;
+
   while (p < end) {
-    char const* q = static_cast<char const*>(memchr(p, '\n', (end - p)));
+    VPackSlice slice;
 
-    if (q == nullptr) {
-      q = end;
-    }
+    if (binary) {
+      try {
+        // throws if the data is invalid
+        validator.validate(p, static_cast<size_t>(end - p), /*isSubPart*/ true);
+      } catch (std::exception const& ex) {
+        return Result(TRI_ERROR_REPLICATION_INVALID_RESPONSE, ex.what());
+      }
 
-    char const* lineStart = p;
-    size_t const lineLength = q - p;
+      // the marker is used in place, the response outlives all uses
+      slice = VPackSlice(reinterpret_cast<uint8_t const*>(p));
+      p += slice.byteSize();
+    } else {
+      char const* q = static_cast<char const*>(memchr(p, '\n', (end - p)));
 
-    if (lineLength < 2) {
-      // we are done
-      return Result();
-    }
+      if (q == nullptr) {
+        q = end;
+      }
 
-    TRI_ASSERT(q <= end);
+      if (q - p < 2) {
+        // we are done
+        return applyPendingMarkers(pending, firstRegularTick, ignoreCount);
+      }
 
-    applyStats.processedMarkers++;
+      TRI_ASSERT(q <= end);
 
-    builder->clear();
-    try {
-      VPackParser parser(builder);
-      parser.parse(p, static_cast<size_t>(q - p));
-    } catch (std::exception const& ex) {
-      return Result(TRI_ERROR_HTTP_CORRUPTED_JSON, ex.what());
-    } catch (...) {
-      return Result(TRI_ERROR_OUT_OF_MEMORY);
-    }
+      builder->clear();
+      try {
+        VPackParser parser(builder);
+        parser.parse(p, static_cast<size_t>(q - p));
+      } catch (std::exception const& ex) {
+        return Result(TRI_ERROR_HTTP_CORRUPTED_JSON, ex.what());
+      } catch (...) {
+        return Result(TRI_ERROR_OUT_OF_MEMORY);
+      }
 
-    p = q + 1;
+      p = q + 1;
+      slice = builder->slice();
+    }
 
-    VPackSlice const slice = builder->slice();
+    applyStats.processedMarkers++;
 
     if (!slice.isObject()) {
       return Result(TRI_ERROR_REPLICATION_INVALID_RESPONSE,
@@ -1124,54 +1286,102 @@ Result TailingSyncer::applyLog(SimpleHttpResult* response, TRI_voc_tick_t firstR
     // entry is skipped?
     bool skipped = skipMarker(firstRegularTick, slice, markerTick, markerType);
 
-    if (!skipped) {
-      Result res = applyLogMarker(slice, applyStats, firstRegularTick, markerTick, markerType);
+    if (skipped && !pending.empty()) {
+      // the tick is updated once the pending markers are applied
+      pending.push_back(PendingMarker{nullptr, VPackSlice(), true, markerTick,
+                                      markerType, nullptr, nullptr, 0, Result()});
+      continue;
+    }
 
-      if (res.fail()) {
-        // apply error
-        std::string errorMsg = res.errorMessage();
-
-        if (ignoreCount == 0) {
-          if (lineLength > 1024) {
-            errorMsg +=
-                ", offending marker: " + std::string(lineStart, 1024) + "...";
-          } else {
-            errorMsg += ", offending marker: " + std::string(lineStart, lineLength);
+    if (!skipped && applyInParallel &&
+        (markerType == REPLICATION_MARKER_DOCUMENT || markerType == REPLICATION_MARKER_REMOVE)) {
+      arangodb::velocypack::StringRef const transactionId =
+          VelocyPackHelper::getStringRef(slice, "tid", "");
+      TRI_voc_tid_t tid = NumberUtils::atoi_zero<TRI_voc_tid_t>(
+          transactionId.data(), transactionId.data() + transactionId.size());
+      VPackSlice const data = slice.get(::dataRef);
+      VPackSlice key;
+      if (data.isObject()) {
+        key = data.get(StaticStrings::KeyString);
+      }
+
+      TRI_vocbase_t* vocbase = nullptr;
+      std::shared_ptr<LogicalCollection> coll;
+      if (tid == 0 && key.isString()) {
+        try {
+          vocbase = resolveVocbase(slice);
+          if (vocbase != nullptr) {
+            coll = resolveCollection(*vocbase, slice);
           }
+        } catch (...) {
+          // the error is reported when the marker is applied regularly
+          coll.reset();
+        }
+      }
 
-          res.reset(res.errorNumber(), errorMsg);
-          return res;
+      // operations on system collections may have side effects, e.g. on
+      // the users, and are applied regularly
+      if (coll != nullptr && !coll->system()) {
+        auto it = uniqueIndexes.find(coll->id());
+        if (it == uniqueIndexes.end()) {
+          bool unique = false;
+          for (auto const& idx : coll->getIndexes()) {
+            if (idx->unique() && idx->type() != Index::TRI_IDX_TYPE_PRIMARY_INDEX) {
+              unique = true;
+              break;
+            }
+          }
+          it = uniqueIndexes.emplace(coll->id(), unique).first;
         }
 
-        ignoreCount--;
-        LOG_TOPIC("c887a", WARN, Logger::REPLICATION)
-            << "ignoring replication error for database '" << _state.databaseName
-            << "': " << errorMsg;
+        // unique constraints may involve several keys, so all operations
+        // on such a collection are applied in order by the same thread
+        size_t partition = std::hash<TRI_voc_cid_t>()(coll->id());
+        if (!it->second) {
+          partition ^= key.hashString();
+        }
+
+        if (markerType == REPLICATION_MARKER_DOCUMENT) {
+          ++applyStats.processedDocuments;
+        } else {
+          ++applyStats.processedRemovals;
+        }
+        if (binary) {
+          pending.push_back(PendingMarker{nullptr, slice, false, markerTick, markerType,
+                                          vocbase, std::move(coll), partition, Result()});
+        } else {
+          pending.push_back(PendingMarker{builder, slice, false, markerTick, markerType,
+                                          vocbase, std::move(coll), partition, Result()});
+          builder = std::make_shared<VPackBuilder>();
+        }
+        continue;
       }
     }
 
-    // update tick value
-    WRITE_LOCKER_EVENTUAL(writeLocker, _applier->_statusLock);
-
-    if (markerTick > firstRegularTick &&
-        markerTick > _applier->_state._lastProcessedContinuousTick) {
-      TRI_ASSERT(markerTick > 0);
-      _applier->_state._lastProcessedContinuousTick = markerTick;
+    // any other marker is applied after all pending ones
+    Result res = applyPendingMarkers(pending, firstRegularTick, ignoreCount);
+    if (res.fail()) {
+      return res;
     }
 
-    if (_applier->_state._lastProcessedContinuousTick > _applier->_state._lastAppliedContinuousTick) {
-      _applier->_state._lastAppliedContinuousTick = _applier->_state._lastProcessedContinuousTick;
-    }
+    if (!skipped) {
+      res = applyLogMarker(slice, applyStats, firstRegularTick, markerTick, markerType);
 
-    if (skipped) {
-      ++_applier->_state._totalSkippedOperations;
-    } else if (_ongoingTransactions.empty()) {
-      _applier->_state._safeResumeTick = _applier->_state._lastProcessedContinuousTick;
+      if (res.fail()) {
+        // apply error
+        res = handleApplyError(std::move(res), slice, ignoreCount);
+        if (res.fail()) {
+          return res;
+        }
+      }
     }
+
+    // update tick value
+    updateAppliedTick(firstRegularTick, markerTick, skipped);
   }
 
   // reached the end
-  return Result();
+  return applyPendingMarkers(pending, firstRegularTick, ignoreCount);
 }
 
 /// @brief run method, performs continuous synchronization
@@ -1801,12 +2011,16 @@ void TailingSyncer::fetchMasterLog(std::shared_ptr<Syncer::JobSynchronizer> shar
 
     std::string body = builder.slice().toJson();
 
+    // masters that do not support VelocyPack markers send JSON lines
+    auto headers = replutils::createHeaders();
+    headers[StaticStrings::Accept] = StaticStrings::MimeTypeVPack;
+
     std::unique_ptr<httpclient::SimpleHttpResult> response;
     double time = TRI_microtime();
 
     _state.connection.lease([&](httpclient::SimpleHttpClient* client) {
       response.reset(client->request(rest::RequestType::PUT, url, body.c_str(),
-                                     body.size()));
+                                     body.size(), headers));
     });
 
     time = TRI_microtime() - time;
@@ -28,6 +28,7 @@
 #include "Basics/Common.h"
 #include "Replication/ReplicationApplierConfiguration.h"
 #include "Replication/Syncer.h"
+#include "VocBase/AccessMode.h"
 
 #include <velocypack/Builder.h>
 
@@ -112,6 +113,13 @@ class TailingSyncer : public Syncer {
   /// @brief process a document operation, based on the VelocyPack provided
   Result processDocument(TRI_replication_operation_e, arangodb::velocypack::Slice const&);
 
+  /// @brief process a document operation for a resolved collection. the
+  /// builder is used to build removal markers, the access type is used for
+  /// standalone operations
+  Result processDocument(TRI_replication_operation_e, arangodb::velocypack::Slice const&,
+                         TRI_vocbase_t&, LogicalCollection*,
+                         arangodb::velocypack::Builder&, AccessMode::Type);
+
   /// @brief renames a collection, based on the VelocyPack provided
   Result renameCollection(arangodb::velocypack::Slice const&);
 
@@ -139,6 +147,15 @@ class TailingSyncer : public Syncer {
   /// @brief perform a continuous sync with the master
   Result runContinuousSync();
 
+  /// @brief update the applier ticks after a marker was processed
+  void updateAppliedTick(TRI_voc_tick_t firstRegularTick,
+                         TRI_voc_tick_t markerTick, bool skipped);
+
+  /// @brief decide whether an apply error can be ignored. returns the error
+  /// including the offending marker otherwise
+  Result handleApplyError(Result res, arangodb::velocypack::Slice const& marker,
+                          uint64_t& ignoreCount);
+
   /// @brief fetch the open transactions we still need to complete
   Result fetchOpenTransactions(TRI_voc_tick_t fromTick, TRI_voc_tick_t toTick,
                                TRI_voc_tick_t& startTick);
@@ -175,6 +192,17 @@ class TailingSyncer : public Syncer {
 
   arangodb::Result removeSingleDocument(arangodb::LogicalCollection* coll, std::string const& key);
 
+  /// @brief a standalone document marker waiting to be applied in parallel
+  struct PendingMarker;
+
+  /// @brief apply pending standalone document markers on several threads.
+  /// markers for the same key, or for the same collection if it has unique
+  /// secondary indexes, are applied in order by the same thread. ticks are
+  /// updated in marker order afterwards
+  arangodb::Result applyPendingMarkers(std::vector<PendingMarker>& pending,
+                                       TRI_voc_tick_t firstRegularTick,
+                                       uint64_t& ignoreCount);
+
   arangodb::Result handleRequiredFromPresentFailure(TRI_voc_tick_t fromTick,
                                                     TRI_voc_tick_t readTick);
 
@@ -0,0 +1,86 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RestAdminMetricsHandler.h"
+#include "GeneralServer/ServerSecurityFeature.h"
+#include "Rest/HttpResponse.h"
+#include "RestServer/MetricsFeature.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::basics;
+using namespace arangodb::rest;
+
+RestAdminMetricsHandler::RestAdminMetricsHandler(GeneralRequest* request,
+                                                 GeneralResponse* response)
+    : RestBaseHandler(request, response) {}
+
+RestStatus RestAdminMetricsHandler::execute() {
+  if (_request->requestType() != rest::RequestType::GET) {
+    generateError(rest::ResponseCode::METHOD_NOT_ALLOWED, TRI_ERROR_HTTP_METHOD_NOT_ALLOWED);
+    return RestStatus::DONE;
+  }
+
+  ServerSecurityFeature* security =
+      application_features::ApplicationServer::getFeature<ServerSecurityFeature>(
+          "ServerSecurity");
+  TRI_ASSERT(security != nullptr);
+
+  if (!security->canAccessHardenedApi()) {
+    // dont leak information about server internals here
+    generateError(rest::ResponseCode::FORBIDDEN, TRI_ERROR_FORBIDDEN);
+    return RestStatus::DONE;
+  }
+
+  metrics::Registry* registry = MetricsFeature::registry();
+  if (registry == nullptr || !MetricsFeature::exportAPI()) {
+    generateError(rest::ResponseCode::NOT_FOUND, TRI_ERROR_DISABLED,
+                  "metrics API not enabled");
+    return RestStatus::DONE;
+  }
+
+  std::string result;
+  registry->toPrometheus(result);
+
+  _response->setResponseCode(rest::ResponseCode::OK);
+  switch (_response->transportType()) {
+    case Endpoint::TransportType::HTTP: {
+      HttpResponse* httpResponse = dynamic_cast<HttpResponse*>(_response.get());
+      if (httpResponse == nullptr) {
+        THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "unable to cast response object");
+      }
+      _response->setContentType(rest::ContentType::TEXT);
+      httpResponse->body().appendText(result.data(), result.size());
+      break;
+    }
+    case Endpoint::TransportType::VST: {
+      VPackBuffer<uint8_t> buffer;
+      VPackBuilder builder(buffer);
+      builder.add(VPackValuePair(result.data(), result.size(), VPackValueType::String));
+      _response->setContentType(rest::ContentType::VPACK);
+      _response->setPayload(std::move(buffer), true);
+      break;
+    }
+  }
+
+  return RestStatus::DONE;
+}
@@ -24,8 +24,12 @@
 #include "RestAdminServerHandler.h"
 
 #include "Actions/RestActionHandler.h"
+#include "Basics/SamplingProfiler.h"
+#include "Basics/VelocyPackHelper.h"
 #include "GeneralServer/AuthenticationFeature.h"
+#include "GeneralServer/ServerSecurityFeature.h"
 #include "Replication/ReplicationFeature.h"
+#include "Rest/HttpResponse.h"
 
 using namespace arangodb;
 using namespace arangodb::basics;
@@ -44,6 +48,8 @@ RestStatus RestAdminServerHandler::execute() {
     handleRole();
   } else if (suffixes.size() == 1 && suffixes[0] == "availability") {
     handleAvailability();
+  } else if (suffixes.size() == 1 && suffixes[0] == "profile") {
+    handleProfile();
   } else {
     generateError(rest::ResponseCode::NOT_FOUND, 404);
   }
@@ -134,24 +140,32 @@ void RestAdminServerHandler::handleAvailability() {
   }
 }
 
+/// @brief whether the user has write access to the system database
+bool RestAdminServerHandler::canModifyServer() {
+  AuthenticationFeature* af = AuthenticationFeature::instance();
+  if (af->isActive() && !_request->user().empty()) {
+    auth::Level lvl;
+    if (af->userManager() != nullptr) {
+      lvl = af->userManager()->databaseAuthLevel(_request->user(), TRI_VOC_SYSTEM_DATABASE,
+                                                 /*configured*/ true);
+    } else {
+      lvl = auth::Level::RW;
+    }
+    if (lvl < auth::Level::RW) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void RestAdminServerHandler::handleMode() {
   auto const requestType = _request->requestType();
   if (requestType == rest::RequestType::GET) {
     writeModeResult(ServerState::readOnly());
   } else if (requestType == rest::RequestType::PUT) {
-    AuthenticationFeature* af = AuthenticationFeature::instance();
-    if (af->isActive() && !_request->user().empty()) {
-      auth::Level lvl;
-      if (af->userManager() != nullptr) {
-        lvl = af->userManager()->databaseAuthLevel(_request->user(), TRI_VOC_SYSTEM_DATABASE,
-                                                   /*configured*/ true);
-      } else {
-        lvl = auth::Level::RW;
-      }
-      if (lvl < auth::Level::RW) {
-        generateError(rest::ResponseCode::FORBIDDEN, TRI_ERROR_FORBIDDEN);
-        return;
-      }
+    if (!canModifyServer()) {
+      generateError(rest::ResponseCode::FORBIDDEN, TRI_ERROR_FORBIDDEN);
+      return;
     }
 
     bool parseSuccess = false;
@@ -199,3 +213,104 @@ void RestAdminServerHandler::handleMode() {
     generateError(rest::ResponseCode::METHOD_NOT_ALLOWED, TRI_ERROR_HTTP_METHOD_NOT_ALLOWED);
   }
 }
+
+/// @brief CPU sampling profiler
+/// PUT starts sampling, the optional body may contain "frequency" (Hz) and
+/// "maxSamples". GET returns the samples recorded since the last GET as
+/// folded stacks and keeps sampling, DELETE stops sampling and returns the
+/// remaining samples. with ?status=true, GET returns the profiler state
+void RestAdminServerHandler::handleProfile() {
+  ServerSecurityFeature* security =
+      application_features::ApplicationServer::getFeature<ServerSecurityFeature>(
+          "ServerSecurity");
+  TRI_ASSERT(security != nullptr);
+
+  if (!security->canAccessHardenedApi() || !canModifyServer()) {
+    generateError(rest::ResponseCode::FORBIDDEN, TRI_ERROR_FORBIDDEN);
+    return;
+  }
+
+  auto const requestType = _request->requestType();
+  if (requestType == rest::RequestType::PUT) {
+    uint32_t frequency = 99;
+    size_t maxSamples = 100000;
+
+    if (_request->contentLength() > 0) {
+      bool parseSuccess = false;
+      VPackSlice slice = this->parseVPackBody(parseSuccess);
+      if (!parseSuccess) {
+        // error already generated
+        return;
+      }
+      if (!slice.isObject()) {
+        generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                      "body must be an object");
+        return;
+      }
+      frequency = basics::VelocyPackHelper::getNumericValue<uint32_t>(slice, "frequency", frequency);
+      maxSamples = basics::VelocyPackHelper::getNumericValue<size_t>(slice, "maxSamples", maxSamples);
+    }
+
+    Result res = basics::SamplingProfiler::start(frequency, maxSamples);
+    if (res.fail()) {
+      generateError(rest::ResponseCode::BAD, res.errorNumber(), res.errorMessage());
+      return;
+    }
+    LOG_TOPIC("5c0d1", INFO, Logger::FIXME)
+        << "sampling profiler started with a frequency of " << frequency << " Hz";
+  } else if (requestType == rest::RequestType::GET) {
+    if (!_request->parsedValue("status", false)) {
+      std::string folded;
+      basics::SamplingProfiler::collect(folded);
+      writeTextResult(folded);
+      return;
+    }
+  } else if (requestType == rest::RequestType::DELETE_REQ) {
+    Result res = basics::SamplingProfiler::stop();
+    if (res.fail()) {
+      generateError(rest::ResponseCode::BAD, res.errorNumber(), res.errorMessage());
+      return;
+    }
+    LOG_TOPIC("0b0d7", INFO, Logger::FIXME) << "sampling profiler stopped";
+
+    std::string folded;
+    basics::SamplingProfiler::collect(folded);
+    writeTextResult(folded);
+    return;
+  } else {
+    generateError(rest::ResponseCode::METHOD_NOT_ALLOWED, TRI_ERROR_HTTP_METHOD_NOT_ALLOWED);
+    return;
+  }
+
+  VPackBuilder builder;
+  {
+    VPackObjectBuilder b(&builder);
+    builder.add("running", VPackValue(basics::SamplingProfiler::isRunning()));
+    builder.add("samples", VPackValue(basics::SamplingProfiler::numSamples()));
+    builder.add("dropped", VPackValue(basics::SamplingProfiler::numDropped()));
+  }
+  generateOk(rest::ResponseCode::OK, builder);
+}
+
+void RestAdminServerHandler::writeTextResult(std::string const& text) {
+  _response->setResponseCode(rest::ResponseCode::OK);
+  switch (_response->transportType()) {
+    case Endpoint::TransportType::HTTP: {
+      HttpResponse* httpResponse = dynamic_cast<HttpResponse*>(_response.get());
+      if (httpResponse == nullptr) {
+        THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "unable to cast response object");
+      }
+      _response->setContentType(rest::ContentType::TEXT);
+      httpResponse->body().appendText(text.data(), text.size());
+      break;
+    }
+    case Endpoint::TransportType::VST: {
+      VPackBuffer<uint8_t> buffer;
+      VPackBuilder builder(buffer);
+      builder.add(VPackValuePair(text.data(), text.size(), VPackValueType::String));
+      _response->setContentType(rest::ContentType::VPACK);
+      _response->setPayload(std::move(buffer), true);
+      break;
+    }
+  }
+}
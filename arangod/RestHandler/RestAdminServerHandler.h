@@ -48,7 +48,10 @@ class RestAdminServerHandler : public RestBaseHandler {
   void handleId();
   void handleRole();
   void handleAvailability();
+  void handleProfile();
+  bool canModifyServer();
   void writeModeResult(bool);
+  void writeTextResult(std::string const&);
 };
 }  // namespace arangodb
 
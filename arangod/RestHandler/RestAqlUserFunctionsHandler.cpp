@@ -39,6 +39,15 @@ RestAqlUserFunctionsHandler::RestAqlUserFunctionsHandler(GeneralRequest* request
                                                          GeneralResponse* response)
     : RestVocbaseBaseHandler(request, response) {}
 
+RequestLane RestAqlUserFunctionsHandler::lane() const {
+  // only registering a function needs a V8 context, to validate the
+  // function code. listing and removing functions are plain AQL queries
+  if (_request->requestType() == rest::RequestType::POST) {
+    return RequestLane::CLIENT_V8;
+  }
+  return RequestLane::CLIENT_AQL;
+}
+
 RestStatus RestAqlUserFunctionsHandler::execute() {
   auto const type = _request->requestType();
 
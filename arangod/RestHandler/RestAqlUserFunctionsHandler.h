@@ -35,7 +35,7 @@ class RestAqlUserFunctionsHandler : public arangodb::RestVocbaseBaseHandler {
   char const* name() const override final {
     return "RestAqlUserFunctionsHandler";
   }
-  RequestLane lane() const override final { return RequestLane::CLIENT_V8; }
+  RequestLane lane() const override final;
   RestStatus execute() override;
 };
 }  // namespace arangodb
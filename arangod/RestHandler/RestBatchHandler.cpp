@@ -38,7 +38,12 @@ using namespace arangodb::basics;
 using namespace arangodb::rest;
 
 RestBatchHandler::RestBatchHandler(GeneralRequest* request, GeneralResponse* response)
-    : RestVocbaseBaseHandler(request, response), _errors(0) {}
+    : RestVocbaseBaseHandler(request, response),
+      _errors(0),
+      _started(0),
+      _written(0),
+      _concurrency(1),
+      _sendParts(false) {}
 
 RestBatchHandler::~RestBatchHandler() {}
 
@@ -66,119 +71,109 @@ RestStatus RestBatchHandler::executeVst() {
   return RestStatus::DONE;
 }
 
-void RestBatchHandler::processSubHandlerResult(RestHandler const& handler) {
-  HttpResponse* httpResponse = dynamic_cast<HttpResponse*>(_response.get());
-
-  HttpResponse* partResponse = dynamic_cast<HttpResponse*>(handler.response());
+RestStatus RestBatchHandler::continueExecute() { return processParts(); }
 
-  if (partResponse == nullptr) {
-    generateError(rest::ResponseCode::BAD, TRI_ERROR_INTERNAL,
-                  "could not create a response for batch part request");
-    continueHandlerExecution();
-    return;
-  }
+BatchPart RestBatchHandler::splitPart(SearchHelper const& helper) const {
+  // split part into header & body
+  char const* partStart = helper.foundStart;
+  char const* partEnd = partStart + helper.foundLength;
+  size_t const partLength = helper.foundLength;
 
-  rest::ResponseCode const code = partResponse->responseCode();
+  BatchPart part;
+  part.headerStart = partStart;
+  part.headerLength = 0;
+  part.bodyStart = nullptr;
+  part.bodyLength = 0;
+  part.done = false;
 
-  // count everything above 400 as error
-  if (int(code) >= 400) {
-    ++_errors;
+  if (helper.contentId != nullptr) {
+    part.contentId.assign(helper.contentId, helper.contentIdLength);
   }
 
-  // append the boundary for this subpart
-  httpResponse->body().appendText(_boundary + "\r\nContent-Type: ");
-  httpResponse->body().appendText(StaticStrings::BatchContentType);
-
-  // append content-id if it is present
-  if (_helper.contentId != nullptr) {
-    httpResponse->body().appendText(
-        "\r\nContent-Id: " + std::string(_helper.contentId, _helper.contentIdLength));
-  }
-
-  httpResponse->body().appendText(TRI_CHAR_LENGTH_PAIR("\r\n\r\n"));
+  // assume Windows linebreak \r\n\r\n as delimiter
+  char const* p = strstr(partStart, "\r\n\r\n");
 
-  // remove some headers we don't need
-  partResponse->setConnectionType(rest::ConnectionType::C_NONE);
-  partResponse->setHeaderNC(StaticStrings::Server, "");
+  if (p != nullptr && p + 4 <= partEnd) {
+    part.headerLength = p - partStart;
+    part.bodyStart = p + 4;
+    part.bodyLength = partEnd - part.bodyStart;
+  } else {
+    // test Unix linebreak
+    p = strstr(partStart, "\n\n");
 
-  // append the part response header
-  partResponse->writeHeader(&httpResponse->body());
+    if (p != nullptr && p + 2 <= partEnd) {
+      part.headerLength = p - partStart;
+      part.bodyStart = p + 2;
+      part.bodyLength = partEnd - part.bodyStart;
+    } else {
+      // no delimiter found, assume we have only a header
+      part.headerLength = partLength;
+    }
+  }
 
-  // append the part response body
-  httpResponse->body().appendText(partResponse->body());
-  httpResponse->body().appendText(TRI_CHAR_LENGTH_PAIR("\r\n"));
+  return part;
+}
 
-  // we've read the last part
-  if (!_helper.containsMore) {
-    // complete the handler
+RestStatus RestBatchHandler::processParts() {
+  // write the parts that are done, in the order of the request
+  bool mayWrite = true;
+  while (mayWrite && _written < _parts.size()) {
+    std::shared_ptr<RestHandler> handler;
+    {
+      MUTEX_LOCKER(locker, _partsLock);
+      if (!_parts[_written].done) {
+        break;
+      }
+      handler = std::move(_parts[_written].handler);
+    }
+    mayWrite = writePart(_parts[_written], *handler);
+    ++_written;
+  }
 
+  if (_written == _parts.size()) {
     // append final boundary + "--"
+    HttpResponse* httpResponse = dynamic_cast<HttpResponse*>(_response.get());
     httpResponse->body().appendText(_boundary + "--");
 
-    if (_errors > 0) {
+    if (_errors > 0 && !responsePartsSent()) {
       httpResponse->setHeaderNC(StaticStrings::Errors, StringUtils::itoa(_errors));
     }
-    continueHandlerExecution();
-  } else {
-    if (!executeNextHandler()) {
-      continueHandlerExecution();
+    return RestStatus::DONE;
+  }
+
+  // start parts until the concurrency limit is reached. a part that is
+  // done but not yet written counts as well
+  while (_started < _parts.size() && _started - _written < _concurrency) {
+    if (!startPart(_started)) {
+      if (_started == _written) {
+        // nothing left that would continue us
+        generateError(rest::ResponseCode::SERVICE_UNAVAILABLE, TRI_ERROR_QUEUE_FULL);
+        return RestStatus::DONE;
+      }
+      // try again when the next part is done
+      break;
     }
+    ++_started;
   }
+
+  // every part that is done continues the handler, and so does the
+  // connection once the parts sent so far are written
+  return RestStatus::WAITING;
 }
 
-bool RestBatchHandler::executeNextHandler() {
+bool RestBatchHandler::startPart(size_t index) {
   auto self(shared_from_this());
+  BatchPart const& part = _parts[index];
 
   // get authorization header. we will inject this into the subparts
   std::string const& authorization = _request->header(StaticStrings::Authorization);
 
-  // get the next part from the multipart message
-  if (!extractPart(_helper)) {
-    // error
-    generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
-                  "invalid multipart message received");
-    LOG_TOPIC("3204a", WARN, arangodb::Logger::REPLICATION)
-        << "received a corrupted multipart message";
-    return false;
-  }
-
-  // split part into header & body
-  char const* partStart = _helper.foundStart;
-  char const* partEnd = partStart + _helper.foundLength;
-  size_t const partLength = _helper.foundLength;
-
-  char const* headerStart = partStart;
-  char const* bodyStart = nullptr;
-  size_t headerLength = 0;
-  size_t bodyLength = 0;
-
-  // assume Windows linebreak \r\n\r\n as delimiter
-  char const* p = strstr(headerStart, "\r\n\r\n");
-
-  if (p != nullptr && p + 4 <= partEnd) {
-    headerLength = p - partStart;
-    bodyStart = p + 4;
-    bodyLength = partEnd - bodyStart;
-  } else {
-    // test Unix linebreak
-    p = strstr(headerStart, "\n\n");
-
-    if (p != nullptr && p + 2 <= partEnd) {
-      headerLength = p - partStart;
-      bodyStart = p + 2;
-      bodyLength = partEnd - bodyStart;
-    } else {
-      // no delimiter found, assume we have only a header
-      headerLength = partLength;
-    }
-  }
-
   // set up request object for the part
   LOG_TOPIC("910e9", TRACE, arangodb::Logger::REPLICATION)
-      << "part header is: " << std::string(headerStart, headerLength);
+      << "part header is: " << std::string(part.headerStart, part.headerLength);
 
   std::unique_ptr<HttpRequest> request(
-      new HttpRequest(_request->connectionInfo(), headerStart, headerLength, false));
+      new HttpRequest(_request->connectionInfo(), part.headerStart, part.headerLength, false));
 
   // we do not have a client task id here
   request->setClientTaskId(0);
@@ -188,10 +183,10 @@ bool RestBatchHandler::executeNextHandler() {
   request->setRequestContext(_request->requestContext(), false);
   request->setDatabaseName(_request->databaseName());
 
-  if (bodyLength > 0) {
+  if (part.bodyLength > 0) {
     LOG_TOPIC("63afb", TRACE, arangodb::Logger::REPLICATION)
-        << "part body is '" << std::string(bodyStart, bodyLength) << "'";
-    request->setBody(bodyStart, bodyLength);
+        << "part body is '" << std::string(part.bodyStart, part.bodyLength) << "'";
+    request->setBody(part.bodyStart, part.bodyLength);
   }
 
   if (!authorization.empty()) {
@@ -211,34 +206,91 @@ bool RestBatchHandler::executeNextHandler() {
                                                              std::move(response)));
 
     if (handler == nullptr) {
-      generateError(rest::ResponseCode::BAD, TRI_ERROR_INTERNAL,
-                    "could not create handler for batch part processing");
-
-      return false;
+      THROW_ARANGO_EXCEPTION_MESSAGE(
+          TRI_ERROR_INTERNAL, "could not create handler for batch part processing");
     }
   }
 
+  {
+    MUTEX_LOCKER(locker, _partsLock);
+    _parts[index].handler = handler;
+  }
+
   // now scheduler the real handler
   bool ok =
-      SchedulerFeature::SCHEDULER->queue(handler->getRequestLane(), [this, self, handler]() {
+      SchedulerFeature::SCHEDULER->queue(handler->getRequestLane(), [this, self, handler, index]() {
         // start to work for this handler
         // ignore any errors here, will be handled later by inspecting the response
         try {
           ExecContextScope scope(nullptr);  // workaround because of assertions
-          handler->runHandler([this, self](RestHandler* handler) {
-            processSubHandlerResult(*handler);
-          });
+          handler->runHandler([this, self, index](RestHandler*) { partDone(index); });
         } catch (...) {
-          processSubHandlerResult(*handler.get());
+          partDone(index);
         }
       });
 
   if (!ok) {
-    generateError(rest::ResponseCode::SERVICE_UNAVAILABLE, TRI_ERROR_QUEUE_FULL);
-    return false;
+    MUTEX_LOCKER(locker, _partsLock);
+    _parts[index].handler.reset();
   }
 
-  return true;
+  return ok;
+}
+
+void RestBatchHandler::partDone(size_t index) {
+  {
+    MUTEX_LOCKER(locker, _partsLock);
+    _parts[index].done = true;
+  }
+  continueHandlerExecution();
+}
+
+bool RestBatchHandler::writePart(BatchPart const& part, RestHandler const& handler) {
+  HttpResponse* partResponse = dynamic_cast<HttpResponse*>(handler.response());
+
+  if (partResponse == nullptr) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                   "could not create a response for batch part request");
+  }
+
+  rest::ResponseCode const code = partResponse->responseCode();
+
+  // count everything above 400 as error
+  if (int(code) >= 400) {
+    ++_errors;
+  }
+
+  // parts that are sent right away get a buffer of their own
+  std::unique_ptr<StringBuffer> buffer;
+  if (_sendParts) {
+    buffer.reset(new StringBuffer(partResponse->body().length() + 256, false));
+  }
+  StringBuffer& output =
+      _sendParts ? *buffer : dynamic_cast<HttpResponse*>(_response.get())->body();
+
+  // append the boundary for this subpart
+  output.appendText(_boundary + "\r\nContent-Type: ");
+  output.appendText(StaticStrings::BatchContentType);
+
+  // append content-id if it is present
+  if (!part.contentId.empty()) {
+    output.appendText("\r\nContent-Id: " + part.contentId);
+  }
+
+  output.appendText(TRI_CHAR_LENGTH_PAIR("\r\n\r\n"));
+
+  // remove some headers we don't need
+  partResponse->setConnectionType(rest::ConnectionType::C_NONE);
+  partResponse->setHeaderNC(StaticStrings::Server, "");
+
+  // append the part response header
+  partResponse->writeHeader(&output);
+
+  // append the part response body
+  output.appendText(partResponse->body());
+  output.appendText(TRI_CHAR_LENGTH_PAIR("\r\n"));
+
+  return !_sendParts || sendResponsePart(std::move(buffer));
 }
 
 RestStatus RestBatchHandler::executeHttp() {
@@ -289,8 +341,31 @@ RestStatus RestBatchHandler::executeHttp() {
   _helper.message = _multipartMessage;
   _helper.searchStart = _multipartMessage.messageStart;
 
+  do {
+    // get the next part from the multipart message
+    if (!extractPart(_helper)) {
+      // error
+      generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                    "invalid multipart message received");
+      LOG_TOPIC("3204a", WARN, arangodb::Logger::REPLICATION)
+          << "received a corrupted multipart message";
+      return RestStatus::DONE;
+    }
+    _parts.emplace_back(splitPart(_helper));
+  } while (_helper.containsMore);
+
+  // parts are executed one after the other, unless the client declares
+  // them independent
+  uint64_t concurrency = _request->parsedValue<uint64_t>("concurrency", 1);
+  _concurrency = static_cast<size_t>(
+      std::max<uint64_t>(1, std::min(concurrency, GeneralServerFeature::maxBatchConcurrency())));
+
+  // the number of failed parts is not known in advance, so the
+  // x-arango-errors header is missing when the parts are sent right away
+  _sendParts = _request->parsedValue("stream", false) && canSendResponseParts();
+
   // and wait for completion
-  return executeNextHandler() ? RestStatus::WAITING : RestStatus::DONE;
+  return processParts();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
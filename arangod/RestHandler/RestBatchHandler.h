@@ -25,6 +25,7 @@
 #define ARANGOD_REST_HANDLER_REST_BATCH_HANDLER_H 1
 
 #include "Basics/Common.h"
+#include "Basics/Mutex.h"
 #include "RestHandler/RestVocbaseBaseHandler.h"
 
 namespace arangodb {
@@ -56,6 +57,18 @@ struct SearchHelper {
   bool containsMore;
 };
 
+// a part of a batch request, located in the body of the batch request
+struct BatchPart {
+  char const* headerStart;
+  size_t headerLength;
+  char const* bodyStart;
+  size_t bodyLength;
+  std::string contentId;
+  // handler of a part that was started and not yet written
+  std::shared_ptr<rest::RestHandler> handler;
+  bool done;
+};
+
 class RestBatchHandler : public RestVocbaseBaseHandler {
  public:
   RestBatchHandler(GeneralRequest*, GeneralResponse*);
@@ -63,6 +76,7 @@ class RestBatchHandler : public RestVocbaseBaseHandler {
 
  public:
   RestStatus execute() override;
+  RestStatus continueExecute() override;
   char const* name() const override final { return "RestBatchHandler"; }
   // be pessimistic about what this handler does... it may invoke V8
   // or not, but as we don't know where, we need to assume it
@@ -84,13 +98,33 @@ class RestBatchHandler : public RestVocbaseBaseHandler {
   bool extractPart(SearchHelper&);
 
  private:
-  bool executeNextHandler();
-  void processSubHandlerResult(RestHandler const& handler);
+  // split the part found by extractPart into header and body
+  BatchPart splitPart(SearchHelper const&) const;
+
+  // writes the parts that are done in order, and starts further parts.
+  // called whenever a part is done
+  RestStatus processParts();
+  bool startPart(size_t index);
+  void partDone(size_t index);
+
+  // appends the response of a part, returns false if the parts are sent to
+  // the client and the handler has to wait for them to be written
+  bool writePart(BatchPart const&, RestHandler const& handler);
 
   MultipartMessage _multipartMessage;
   SearchHelper _helper;
   size_t _errors;
   std::string _boundary;
+
+  // all parts are found before the first one is started. _partsLock protects
+  // the done flags and handlers, the other members are only used by the
+  // handler itself
+  Mutex _partsLock;
+  std::vector<BatchPart> _parts;
+  size_t _started;     // parts started so far
+  size_t _written;     // parts written so far, in order
+  size_t _concurrency;  // maximum of started parts not yet written
+  bool _sendParts;     // send the part responses as soon as they are ready
 };
 }  // namespace arangodb
 
@@ -59,8 +59,7 @@ RestStatus RestCollectionHandler::execute() {
       handleCommandPost();
       break;
     case rest::RequestType::PUT:
-      handleCommandPut();
-      break;
+      return handleCommandPut();
     case rest::RequestType::DELETE_REQ:
       handleCommandDelete();
       break;
@@ -336,18 +335,18 @@ void RestCollectionHandler::handleCommandPost() {
   }
 }
 
-void RestCollectionHandler::handleCommandPut() {
+RestStatus RestCollectionHandler::handleCommandPut() {
   std::vector<std::string> const& suffixes = _request->decodedSuffixes();
   if (suffixes.size() != 2) {
     generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
                   "expected PUT /_api/collection/<collection-name>/<action>");
-    return;
+    return RestStatus::DONE;
   }
   bool parseSuccess = false;
   VPackSlice body = this->parseVPackBody(parseSuccess);
   if (!parseSuccess) {
     // error message generated in parseVPackBody
-    return;
+    return RestStatus::DONE;
   }
 
   if (!body.isObject()) {
@@ -358,6 +357,9 @@ void RestCollectionHandler::handleCommandPut() {
   std::string const& sub = suffixes[1];
   Result res;
   VPackBuilder builder;
+  // set when the collection is warmed up on the shards, which can take a
+  // while
+  auto warmup = futures::Future<Result>::makeEmpty();
   auto found = methods::Collections::lookup( // find collection
     _vocbase, // vocbase to search
     name, // collection name to find
@@ -477,21 +479,44 @@ void RestCollectionHandler::handleCommandPut() {
                                  /*detailedCount*/ true);
       }
     } else if (sub == "loadIndexesIntoMemory") {
-      res = methods::Collections::warmup(_vocbase, *coll);
-
-      VPackObjectBuilder obj(&builder, true);
+      warmup = methods::Collections::warmupAsync(_vocbase, *coll);
+    } else if (sub == "analyze") {
+      VPackBuilder statistics;
+      res = methods::Collections::analyze(_vocbase, *coll, statistics);
 
-      obj->add("result", VPackValue(res.ok()));
+      if (res.ok()) {
+        VPackObjectBuilder obj(&builder, true);
+        obj->add("statistics", statistics.slice());
+      }
     } else {
       res = handleExtraCommandPut(*coll, sub, builder);
       if (res.is(TRI_ERROR_NOT_IMPLEMENTED)) {
         res.reset(TRI_ERROR_HTTP_NOT_FOUND,
                   "expecting one of the actions 'load', 'unload', 'truncate',"
-                  " 'properties', 'compact', 'rename', 'loadIndexesIntoMemory'");
+                  " 'properties', 'compact', 'rename', 'loadIndexesIntoMemory',"
+                  " 'analyze'");
       }
     }
   });
 
+  if (found.ok() && warmup.valid()) {
+    return waitForFuture(std::move(warmup), [this](futures::Try<Result>&& result) {
+      Result res = std::move(result).get();
+      if (res.ok()) {
+        VPackBuilder builder;
+        {
+          VPackObjectBuilder obj(&builder, true);
+          obj->add("result", VPackValue(true));
+        }
+        generateOk(rest::ResponseCode::OK, builder);
+        _response->setHeaderNC(StaticStrings::Location, _request->requestPath());
+      } else {
+        generateError(res);
+      }
+      return RestStatus::DONE;
+    });
+  }
+
   if (found.fail()) {
     generateError(found);
   } else if (res.ok()) {
@@ -500,6 +525,7 @@ void RestCollectionHandler::handleCommandPut() {
   } else {
     generateError(res);
   }
+  return RestStatus::DONE;
 }
 
 void RestCollectionHandler::handleCommandDelete() {
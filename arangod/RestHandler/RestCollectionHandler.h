@@ -59,7 +59,7 @@ class RestCollectionHandler : public arangodb::RestVocbaseBaseHandler {
  private:
   void handleCommandGet();
   void handleCommandPost();
-  void handleCommandPut();
+  RestStatus handleCommandPut();
   void handleCommandDelete();
 };
 
@@ -22,11 +22,15 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "RestCursorHandler.h"
+#include "Aql/PreparedStatement.h"
 #include "Aql/Query.h"
 #include "Aql/QueryRegistry.h"
 #include "Basics/Exceptions.h"
 #include "Basics/MutexLocker.h"
 #include "Basics/StaticStrings.h"
+#include "Basics/StringBuffer.h"
+#include "Basics/VelocyPackBuilderPool.h"
+#include "Basics/VelocyPackDumper.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Cluster/ServerState.h"
 #include "Transaction/Context.h"
@@ -52,7 +56,8 @@ RestCursorHandler::RestCursorHandler(GeneralRequest* request, GeneralResponse* r
       _hasStarted(false),
       _queryKilled(false),
       _isValidForFinalize(false),
-      _auditLogged(false) {}
+      _auditLogged(false),
+      _streamBatches(false) {}
 
 RestCursorHandler::~RestCursorHandler() {
   if (_leasedCursor) {
@@ -66,6 +71,16 @@ RestStatus RestCursorHandler::execute() {
   // extract the sub-request type
   rest::RequestType const type = _request->requestType();
 
+  if (_request->requestPath() == PREPARE_PATH) {
+    if (type == rest::RequestType::POST) {
+      return createPreparedStatement();
+    } else if (type == rest::RequestType::DELETE_REQ) {
+      return deletePreparedStatement();
+    }
+    generateError(rest::ResponseCode::METHOD_NOT_ALLOWED, TRI_ERROR_HTTP_METHOD_NOT_ALLOWED);
+    return RestStatus::DONE;
+  }
+
   if (type == rest::RequestType::POST) {
     return createQueryCursor();
   } else if (type == rest::RequestType::PUT) {
@@ -164,13 +179,22 @@ void RestCursorHandler::handleError(basics::Exception const& ex) {
 ///        If false we are done (error or stream)
 ////////////////////////////////////////////////////////////////////////////////
 
-RestStatus RestCursorHandler::registerQueryOrCursor(VPackSlice const& slice) {
+RestStatus RestCursorHandler::registerQueryOrCursor(VPackSlice const& body) {
   TRI_ASSERT(_query == nullptr);
 
-  if (!slice.isObject()) {
+  if (!body.isObject()) {
     generateError(rest::ResponseCode::BAD, TRI_ERROR_QUERY_EMPTY);
     return RestStatus::DONE;
   }
+
+  VPackSlice slice = body;
+  VPackBuilder statementBody;
+  if (body.hasKey("statement")) {
+    if (!resolvePreparedStatement(body, statementBody)) {
+      return RestStatus::DONE;
+    }
+    slice = statementBody.slice();
+  }
   VPackSlice const querySlice = slice.get("query");
   if (!querySlice.isString() || querySlice.getStringLength() == 0) {
     generateError(rest::ResponseCode::BAD, TRI_ERROR_QUERY_EMPTY);
@@ -202,6 +226,13 @@ RestStatus RestCursorHandler::registerQueryOrCursor(VPackSlice const& slice) {
   double ttl = VelocyPackHelper::getNumericValue<double>(opts, "ttl",
                                                          _queryRegistry->defaultTTL());
   bool count = VelocyPackHelper::getBooleanValue(opts, "count", false);
+  bool streamBatches = VelocyPackHelper::getBooleanValue(opts, "streamBatches", false);
+
+  if (streamBatches && !stream) {
+    generateError(Result(TRI_ERROR_BAD_PARAMETER,
+                         "'streamBatches' option requires a streaming query"));
+    return RestStatus::DONE;
+  }
 
   if (stream) {
     if (count) {
@@ -209,6 +240,10 @@ RestStatus RestCursorHandler::registerQueryOrCursor(VPackSlice const& slice) {
                            "cannot use 'count' option for a streaming query"));
       return RestStatus::DONE;
     } else {
+      // connections that cannot send a response in parts get the first
+      // batch only, as usual
+      _streamBatches = streamBatches && canSendResponseParts();
+
       CursorRepository* cursors = _vocbase.cursorRepository();
       TRI_ASSERT(cursors != nullptr);
       Cursor* cursor = cursors->createQueryStream(querySlice.copyString(), bindVarsBuilder,
@@ -519,29 +554,58 @@ RestStatus RestCursorHandler::generateCursorResult(rest::ResponseCode code,
   // dump might delete the cursor
   std::shared_ptr<transaction::Context> ctx = cursor->context();
 
-  VPackBuffer<uint8_t> buffer;
-  VPackBuilder builder(buffer);
-  builder.openObject();
+  // batches are often large, the builder comes from a pool so that its
+  // memory is reused by later requests
+  basics::PooledBuilder pooled;
+  VPackBuilder& builder = *pooled;
 
   aql::ExecutionState state;
   Result r;
   auto self = shared_from_this();
-  std::tie(state, r) =
-      cursor->dump(builder, [this, self]() { continueHandlerExecution(); });
-  if (state == aql::ExecutionState::WAITING) {
+
+  while (true) {
+    builder.openObject();
+    std::tie(state, r) =
+        cursor->dump(builder, [this, self]() { continueHandlerExecution(); });
+    if (state == aql::ExecutionState::WAITING) {
+      builder.clear();
+      _leasedCursor = cursor;
+      guard.cancel();
+      return RestStatus::WAITING;
+    }
+
+    builder.add(StaticStrings::Error, VPackValue(false));
+    builder.add(StaticStrings::Code, VPackValue(static_cast<int>(code)));
+    builder.close();
+
+    if (!_streamBatches || !r.ok() ||
+        !VelocyPackHelper::getBooleanValue(builder.slice(), "hasMore", false)) {
+      // the last batch is the regular response, or its last part
+      break;
+    }
+
+    // one batch per line
+    if (!responsePartsSent()) {
+      resetResponse(code);
+      _response->setContentType(rest::ContentType::DUMP);
+    }
+    auto part = std::make_unique<basics::StringBuffer>(builder.size() + 1, false);
+    basics::VelocyPackDumper dumper(part.get(), ctx->getVPackOptionsForDump());
+    dumper.dumpValue(builder.slice());
+    part->appendChar('\n');
     builder.clear();
-    _leasedCursor = cursor;
-    guard.cancel();
-    return RestStatus::WAITING;
-  }
 
-  builder.add(StaticStrings::Error, VPackValue(false));
-  builder.add(StaticStrings::Code, VPackValue(static_cast<int>(code)));
-  builder.close();
+    if (!sendResponsePart(std::move(part))) {
+      // wait until the parts sent so far are written
+      _leasedCursor = cursor;
+      guard.cancel();
+      return RestStatus::WAITING;
+    }
+  }
 
   if (r.ok()) {
     _response->setContentType(rest::ContentType::JSON);
-    generateResult(code, std::move(buffer), std::move(ctx));
+    generateResult(code, builder.slice(), std::move(ctx));
   } else {
     generateError(r);
   }
@@ -657,3 +721,146 @@ RestStatus RestCursorHandler::deleteQueryCursor() {
   generateResult(rest::ResponseCode::ACCEPTED, builder.slice());
   return RestStatus::DONE;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief POST /_api/prepare, parses the query and registers it with its
+/// options. executions pass the returned id as "statement" to POST
+/// /_api/cursor instead of "query"
+////////////////////////////////////////////////////////////////////////////////
+
+RestStatus RestCursorHandler::createPreparedStatement() {
+  if (!_request->suffixes().empty()) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                  "expecting POST /_api/prepare");
+    return RestStatus::DONE;
+  }
+
+  bool parseSuccess = false;
+  VPackSlice body = this->parseVPackBody(parseSuccess);
+
+  if (!parseSuccess) {
+    // error message generated in parseVPackBody
+    return RestStatus::DONE;
+  }
+
+  if (!body.isObject()) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_QUERY_EMPTY);
+    return RestStatus::DONE;
+  }
+
+  VPackSlice const querySlice = body.get("query");
+  if (!querySlice.isString() || querySlice.getStringLength() == 0) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_QUERY_EMPTY);
+    return RestStatus::DONE;
+  }
+
+  VPackSlice const options = body.get("options");
+  if (!options.isNone() && !options.isObject()) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_TYPE_ERROR,
+                  "expecting object for <options>");
+    return RestStatus::DONE;
+  }
+
+  std::string queryString = querySlice.copyString();
+
+  // syntax errors are reported now, not on the first execution
+  aql::Query query(false, _vocbase, aql::QueryString(queryString), nullptr,
+                   nullptr, aql::PART_MAIN);
+  aql::QueryResult parseResult = query.parse();
+
+  if (parseResult.result.fail()) {
+    generateError(parseResult.result);
+    return RestStatus::DONE;
+  }
+
+  double ttl = VelocyPackHelper::getNumericValue<double>(body, "ttl", 0.0);
+  auto statement = aql::PreparedStatementRegistry::instance()->create(
+      &_vocbase, std::move(queryString), options, ttl);
+
+  if (statement == nullptr) {
+    generateError(Result(TRI_ERROR_RESOURCE_LIMIT,
+                         "too many prepared statements in this database"));
+    return RestStatus::DONE;
+  }
+
+  VPackBuilder builder;
+  builder.openObject();
+  builder.add("id", VPackValue(std::to_string(statement->id())));
+  builder.add("bindVars", VPackValue(VPackValueType::Array));
+  for (auto const& it : parseResult.bindParameters) {
+    builder.add(VPackValue(it));
+  }
+  builder.close();
+  builder.add("ttl", VPackValue(statement->ttl()));
+  builder.add(StaticStrings::Error, VPackValue(false));
+  builder.add(StaticStrings::Code, VPackValue(static_cast<int>(rest::ResponseCode::CREATED)));
+  builder.close();
+
+  generateResult(rest::ResponseCode::CREATED, builder.slice());
+  return RestStatus::DONE;
+}
+
+RestStatus RestCursorHandler::deletePreparedStatement() {
+  std::vector<std::string> const& suffixes = _request->suffixes();
+
+  if (suffixes.size() != 1) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                  "expecting DELETE /_api/prepare/<statement-id>");
+    return RestStatus::DONE;
+  }
+
+  std::string const& id = suffixes[0];
+  bool found = aql::PreparedStatementRegistry::instance()->remove(
+      &_vocbase, arangodb::basics::StringUtils::uint64(id));
+
+  if (!found) {
+    generateError(rest::ResponseCode::NOT_FOUND, TRI_ERROR_QUERY_NOT_FOUND,
+                  "prepared statement not found");
+    return RestStatus::DONE;
+  }
+
+  VPackBuilder builder;
+  builder.openObject();
+  builder.add("id", VPackValue(id));
+  builder.add(StaticStrings::Error, VPackValue(false));
+  builder.add(StaticStrings::Code,
+              VPackValue(static_cast<int>(rest::ResponseCode::ACCEPTED)));
+  builder.close();
+
+  generateResult(rest::ResponseCode::ACCEPTED, builder.slice());
+  return RestStatus::DONE;
+}
+
+bool RestCursorHandler::resolvePreparedStatement(VPackSlice body, VPackBuilder& result) {
+  if (body.hasKey("query")) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_BAD_PARAMETER,
+                  "expecting either <query> or <statement>");
+    return false;
+  }
+
+  VPackSlice const id = body.get("statement");
+  std::shared_ptr<aql::PreparedStatement> statement;
+  if (id.isString()) {
+    statement = aql::PreparedStatementRegistry::instance()->lookup(
+        &_vocbase, arangodb::basics::StringUtils::uint64(id.copyString()));
+  }
+
+  if (statement == nullptr) {
+    generateError(rest::ResponseCode::NOT_FOUND, TRI_ERROR_QUERY_NOT_FOUND,
+                  "prepared statement not found");
+    return false;
+  }
+
+  // everything except the query and its options comes from the execution
+  result.openObject();
+  for (auto const& it : VPackObjectIterator(body)) {
+    std::string key = it.key.copyString();
+    if (key != "statement" && key != "options") {
+      result.add(key, it.value);
+    }
+  }
+  result.add("query", VPackValue(statement->queryString()));
+  result.add("options", statement->executionOptions(body.get("options"))->slice());
+  result.close();
+  return true;
+}
@@ -155,6 +155,27 @@ class RestCursorHandler : public RestVocbaseBaseHandler {
 
   RestStatus deleteQueryCursor();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief register a prepared statement
+  //////////////////////////////////////////////////////////////////////////////
+
+  RestStatus createPreparedStatement();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief dispose a prepared statement
+  //////////////////////////////////////////////////////////////////////////////
+
+  RestStatus deletePreparedStatement();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief replace the id of a prepared statement in a cursor request by
+  /// the statement's query string and options. returns false after
+  /// generating an error
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool resolvePreparedStatement(arangodb::velocypack::Slice body,
+                                arangodb::velocypack::Builder& result);
+
  protected:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief currently running query
@@ -209,6 +230,10 @@ class RestCursorHandler : public RestVocbaseBaseHandler {
   /// @brief whether or not an audit message has already been logged
   bool _auditLogged;
 
+  /// @brief whether all batches of a streaming cursor are sent in one
+  /// response, one batch per part
+  bool _streamBatches;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief A shared pointer to the query options velocypack, s.t. we avoid
   ///        to reparse and set default options
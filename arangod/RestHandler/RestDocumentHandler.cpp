@@ -26,24 +26,58 @@
 #include "Basics/StringUtils.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Cluster/ServerState.h"
+#include "GeneralServer/GeneralServerFeature.h"
 #include "Rest/HttpRequest.h"
 #include "Transaction/Helpers.h"
 #include "Transaction/Hints.h"
 #include "Transaction/StandaloneContext.h"
+#include "StorageEngine/EngineSelectorFeature.h"
+#include "StorageEngine/PhysicalCollection.h"
 #include "Utils/Events.h"
+#include "Utils/ExecContext.h"
 #include "Utils/OperationOptions.h"
 #include "Utils/SingleCollectionTransaction.h"
+#include "VocBase/LogicalCollection.h"
+#include "VocBase/ManagedDocumentResult.h"
 #include "VocBase/vocbase.h"
 
 #include "Logger/Logger.h"
 
+#include <thread>
+
 using namespace arangodb;
 using namespace arangodb::basics;
 using namespace arangodb::rest;
 
+namespace {
+/// @brief whether the client allows reading from followers of a shard
+bool allowDirtyReads(GeneralRequest const& request) {
+  bool found = false;
+  std::string const& value = request.header(StaticStrings::AllowDirtyReads, found);
+  return found && StringUtils::boolean(value);
+}
+}  // namespace
+
 RestDocumentHandler::RestDocumentHandler(GeneralRequest* request, GeneralResponse* response)
     : RestVocbaseBaseHandler(request, response) {}
 
+RequestLane RestDocumentHandler::lane() const {
+  if (GeneralServerFeature::ioThreadPerCore() && EngineSelectorFeature::isRocksDB() &&
+      !ServerState::instance()->isCoordinator()) {
+    // plain reads of documents are short local lookups on RocksDB, which
+    // reads from a snapshot without taking collection locks. they can still
+    // block on disk I/O, and MMFiles reads wait for the collection lock, so
+    // only RocksDB reads outside of streaming transactions are promoted
+    auto const type = _request->requestType();
+    bool found;
+    _request->header(StaticStrings::TransactionId, found);
+    if ((type == rest::RequestType::GET || type == rest::RequestType::HEAD) && !found) {
+      return RequestLane::CLIENT_FAST;
+    }
+  }
+  return RequestLane::CLIENT_SLOW;
+}
+
 RestStatus RestDocumentHandler::execute() {
   // extract the sub-request type
   auto const type = _request->requestType();
@@ -247,6 +281,7 @@ bool RestDocumentHandler::readSingleDocument(bool generateBody) {
 
   OperationOptions options;
   options.ignoreRevs = true;
+  options.allowDirtyReads = ::allowDirtyReads(*_request);
 
   TRI_voc_rid_t ifRid = extractRevision("if-match", isValidRevision);
   if (!isValidRevision) {
@@ -265,6 +300,18 @@ bool RestDocumentHandler::readSingleDocument(bool generateBody) {
 
   VPackSlice search = builder.slice();
 
+  // plain reads on a single server do not need a transaction. reads that
+  // name a streaming transaction must see its uncommitted writes, and the
+  // transaction id must still be validated, so they take the regular path
+  bool hasTransactionId = false;
+  _request->header(StaticStrings::TransactionId, hasTransactionId);
+
+  bool found = false;
+  if (ifRid == 0 && !hasTransactionId && ServerState::instance()->isSingleServer() &&
+      readSingleDocumentLatest(collection, key, ifNoneRid, generateBody, found)) {
+    return found;
+  }
+
   // find and load collection given by name or identifier
   auto trx = createTransaction(collection, AccessMode::Type::READ);
 
@@ -316,6 +363,55 @@ bool RestDocumentHandler::readSingleDocument(bool generateBody) {
   return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reads the latest committed version of a document without setting
+/// up a transaction. this skips the transaction state, collection locking and
+/// snapshot, which a single-key read does not need. anything unusual (unknown
+/// or unloaded collection, missing permissions, engines without support) is
+/// left to the regular path, which produces the proper errors
+////////////////////////////////////////////////////////////////////////////////
+
+bool RestDocumentHandler::readSingleDocumentLatest(std::string const& collection,
+                                                   std::string const& key,
+                                                   TRI_voc_rid_t ifNoneRid,
+                                                   bool generateBody, bool& found) {
+  auto coll = _vocbase.lookupCollection(collection);
+  if (coll == nullptr || coll->deleted() ||
+      coll->status() != TRI_VOC_COL_STATUS_LOADED) {
+    return false;
+  }
+
+  ExecContext const* exec = ExecContext::CURRENT;
+  if (exec != nullptr &&
+      !exec->canUseCollection(_vocbase.name(), coll->name(), auth::Level::RO)) {
+    return false;
+  }
+
+  ManagedDocumentResult mdr;
+  Result res = coll->getPhysical()->readLatestCommitted(
+      arangodb::velocypack::StringRef(key), mdr);
+
+  if (res.is(TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND)) {
+    generateDocumentNotFound(collection, key);
+    found = false;
+    return true;
+  }
+  if (res.fail()) {
+    return false;
+  }
+  found = true;
+
+  if (ifNoneRid != 0 && ifNoneRid == mdr.revisionId()) {
+    generateNotModified(ifNoneRid);
+    return true;
+  }
+
+  // the context is only needed to resolve _id values in the output
+  auto ctx = transaction::StandaloneContext::Create(_vocbase);
+  generateDocument(VPackSlice(mdr.vpack()), generateBody, ctx->getVPackOptionsForDump());
+  return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief was docuBlock REST_DOCUMENT_READ_HEAD
 ////////////////////////////////////////////////////////////////////////////////
@@ -451,35 +547,66 @@ bool RestDocumentHandler::modifyDocument(bool isPatch) {
     }
   }
 
-  // find and load collection given by name or identifier
-  auto trx = createTransaction(collectionName, AccessMode::Type::WRITE);
-
-  if (!isArrayCase) {
-    trx->addHint(transaction::Hints::Hint::SINGLE_OPERATION);
+  if (isPatch) {
+    opOptions.keepNull = _request->parsedValue(StaticStrings::KeepNullString, true);
+    opOptions.mergeObjects =
+        _request->parsedValue(StaticStrings::MergeObjectsString, true);
+    opOptions.incrementNumbers =
+        _request->parsedValue(StaticStrings::IncrementNumbersString, false);
   }
 
-  // ...........................................................................
-  // inside write transaction
-  // ...........................................................................
+  // increments of a single document commute, so a write-write conflict
+  // can be resolved by simply applying the deltas to the now-current
+  // revision again. this is only safe if the client did not ask for a
+  // specific revision, and if the operation is not part of a streaming
+  // transaction, whose conflicts the client has to handle
+  bool hasTransactionId = false;
+  _request->header(StaticStrings::TransactionId, hasTransactionId);
 
-  Result res = trx->begin();
-  if (!res.ok()) {
-    generateTransactionError(collectionName, res, "");
-    return false;
+  int maxAttempts = 1;
+  if (isPatch && opOptions.incrementNumbers && opOptions.ignoreRevs &&
+      !isArrayCase && !hasTransactionId) {
+    maxAttempts = 64;
   }
 
+  std::unique_ptr<SingleCollectionTransaction> trx;
   OperationResult result(TRI_ERROR_NO_ERROR);
-  if (isPatch) {
-    // patching an existing document
-    opOptions.keepNull = _request->parsedValue(StaticStrings::KeepNullString, true);
-    opOptions.mergeObjects =
-        _request->parsedValue(StaticStrings::MergeObjectsString, true);
-    result = trx->update(collectionName, body, opOptions);
-  } else {
-    result = trx->replace(collectionName, body, opOptions);
-  }
+  Result res;
 
-  res = trx->finish(result.result);
+  for (int attempt = 1; ; ++attempt) {
+    // find and load collection given by name or identifier
+    trx = createTransaction(collectionName, AccessMode::Type::WRITE);
+
+    if (!isArrayCase) {
+      trx->addHint(transaction::Hints::Hint::SINGLE_OPERATION);
+    }
+
+    // .........................................................................
+    // inside write transaction
+    // .........................................................................
+
+    res = trx->begin();
+    if (!res.ok()) {
+      generateTransactionError(collectionName, res, "");
+      return false;
+    }
+
+    if (isPatch) {
+      // patching an existing document
+      result = trx->update(collectionName, body, opOptions);
+    } else {
+      result = trx->replace(collectionName, body, opOptions);
+    }
+
+    res = trx->finish(result.result);
+
+    if (attempt >= maxAttempts ||
+        (!result.is(TRI_ERROR_ARANGO_CONFLICT) &&
+         !res.is(TRI_ERROR_ARANGO_CONFLICT))) {
+      break;
+    }
+    std::this_thread::yield();
+  }
 
   // ...........................................................................
   // outside write transaction
@@ -629,6 +756,7 @@ bool RestDocumentHandler::readManyDocuments() {
 
   OperationOptions opOptions;
   opOptions.ignoreRevs = _request->parsedValue(StaticStrings::IgnoreRevsString, true);
+  opOptions.allowDirtyReads = ::allowDirtyReads(*_request);
 
   auto trx = createTransaction(collectionName, AccessMode::Type::READ);
 
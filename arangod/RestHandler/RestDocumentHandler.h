@@ -35,7 +35,7 @@ class RestDocumentHandler : public RestVocbaseBaseHandler {
  public:
   RestStatus execute() override final;
   char const* name() const override final { return "RestDocumentHandler"; }
-  RequestLane lane() const override final { return RequestLane::CLIENT_SLOW; }
+  RequestLane lane() const override final;
   void shutdownExecute(bool isFinalized) noexcept override;
 
  protected:
@@ -51,6 +51,12 @@ class RestDocumentHandler : public RestVocbaseBaseHandler {
   // reads a single document
   bool readSingleDocument(bool generateBody);
 
+  // reads a single document without a transaction if possible. returns
+  // false if the regular path must be used, otherwise the response has been
+  // generated and found tells whether the document exists
+  bool readSingleDocumentLatest(std::string const& collection, std::string const& key,
+                                TRI_voc_rid_t ifNoneRid, bool generateBody, bool& found);
+
   // reads multiple documents
   bool readManyDocuments();
 
@@ -25,6 +25,7 @@
 #include "Aql/AstNode.h"
 #include "Aql/Graphs.h"
 #include "Aql/Variable.h"
+#include "Basics/VelocyPackBuilderPool.h"
 #include "Cluster/ClusterMethods.h"
 #include "Cluster/ServerState.h"
 #include "Transaction/StandaloneContext.h"
@@ -227,8 +228,10 @@ bool RestEdgesHandler::readEdges() {
   size_t filtered = 0;
   size_t scannedIndex = 0;
 
-  VPackBuffer<uint8_t> buffer;
-  VPackBuilder resultBuilder(buffer);
+  // the edges of a vertex can be many, so reuse a builder that has grown
+  // before
+  basics::PooledBuilder pooled;
+  VPackBuilder& resultBuilder = *pooled;
   resultBuilder.openObject();
   // build edges
   resultBuilder.add(VPackValue("edges"));  // only key
@@ -277,7 +280,7 @@ bool RestEdgesHandler::readEdges() {
   resultBuilder.close();
 
   // and generate a response
-  generateResult(rest::ResponseCode::OK, std::move(buffer), trx->transactionContext());
+  generateResult(rest::ResponseCode::OK, resultBuilder.slice(), trx->transactionContext());
 
   return true;
 }
@@ -366,8 +369,10 @@ bool RestEdgesHandler::readEdgesForMultipleVertices() {
   size_t filtered = 0;
   size_t scannedIndex = 0;
 
-  VPackBuffer<uint8_t> buffer;
-  VPackBuilder resultBuilder(buffer);
+  // the edges of a vertex can be many, so reuse a builder that has grown
+  // before
+  basics::PooledBuilder pooled;
+  VPackBuilder& resultBuilder = *pooled;
   resultBuilder.openObject();
   // build edges
   resultBuilder.add(VPackValue("edges"));  // only key
@@ -417,7 +422,7 @@ bool RestEdgesHandler::readEdgesForMultipleVertices() {
   resultBuilder.close();
 
   // and generate a response
-  generateResult(rest::ResponseCode::OK, std::move(buffer), trx->transactionContext());
+  generateResult(rest::ResponseCode::OK, resultBuilder.slice(), trx->transactionContext());
 
   return true;
 }
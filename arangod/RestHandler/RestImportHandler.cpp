@@ -29,6 +29,8 @@
 #include "Cluster/ServerState.h"
 #include "Logger/Logger.h"
 #include "Rest/HttpRequest.h"
+#include "StorageEngine/EngineSelectorFeature.h"
+#include "StorageEngine/StorageEngine.h"
 #include "Transaction/Helpers.h"
 #include "Transaction/StandaloneContext.h"
 #include "Utils/OperationOptions.h"
@@ -346,6 +348,8 @@ bool RestImportHandler::createFromJson(std::string const& type) {
     return false;
   }
 
+  EngineSelectorFeature::ENGINE->prepareBulkLoad();
+
   // find and load collection given by name or identifier
   auto ctx = transaction::StandaloneContext::Create(_vocbase);
   SingleCollectionTransaction trx(ctx, collectionName, AccessMode::Type::WRITE);
@@ -553,6 +557,18 @@ bool RestImportHandler::createFromVPack(std::string const& type) {
     return false;
   }
 
+  // read line number (optional). clients sending a chunk of a bigger input
+  // file use it to get error positions relative to the whole file
+  size_t lineNumber = 0;
+  std::string const& lineNumValue = _request->value("line", found);
+
+  if (found) {
+    lineNumber = NumberUtils::atoi_zero<size_t>(lineNumValue.data(),
+                                                lineNumValue.data() + lineNumValue.size());
+  }
+
+  EngineSelectorFeature::ENGINE->prepareBulkLoad();
+
   // find and load collection given by name or identifier
   auto ctx = transaction::StandaloneContext::Create(_vocbase);
   SingleCollectionTransaction trx(ctx, collectionName, AccessMode::Type::WRITE);
@@ -595,7 +611,8 @@ bool RestImportHandler::createFromVPack(std::string const& type) {
   VPackArrayIterator it(documents);
   while (it.valid()) {
     res = handleSingleDocument(trx, lineBuilder, result, babies, it.value(),
-                               isEdgeCollection, static_cast<size_t>(it.index() + 1));
+                               isEdgeCollection,
+                               lineNumber + static_cast<size_t>(it.index() + 1));
 
     if (res.fail()) {
       if (complete) {
@@ -735,6 +752,8 @@ bool RestImportHandler::createFromKeyValueList() {
 
   current = next + 1;
 
+  EngineSelectorFeature::ENGINE->prepareBulkLoad();
+
   // find and load collection given by name or identifier
   auto ctx = transaction::StandaloneContext::Create(_vocbase);
   SingleCollectionTransaction trx(ctx, collectionName, AccessMode::Type::WRITE);
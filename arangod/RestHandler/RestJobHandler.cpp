@@ -32,15 +32,21 @@
 #include "GeneralServer/AsyncJobManager.h"
 #include "Rest/HttpRequest.h"
 #include "Rest/HttpResponse.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "VocBase/ticks.h"
 
 using namespace arangodb;
 using namespace arangodb::basics;
 using namespace arangodb::rest;
 
+namespace {
+/// @brief maximum number of seconds a client can wait for a job
+constexpr double MaxWaitTime = 60.0;
+}  // namespace
+
 RestJobHandler::RestJobHandler(GeneralRequest* request, GeneralResponse* response,
                                AsyncJobManager* jobManager)
-    : RestBaseHandler(request, response), _jobManager(jobManager) {
+    : RestBaseHandler(request, response), _jobManager(jobManager), _waited(false) {
   TRI_ASSERT(jobManager != nullptr);
 }
 
@@ -49,12 +55,12 @@ RestStatus RestJobHandler::execute() {
   auto const type = _request->requestType();
 
   if (type == rest::RequestType::GET) {
-    getJob();
+    return getJob();
   } else if (type == rest::RequestType::PUT) {
     std::vector<std::string> const& suffixes = _request->suffixes();
 
     if (suffixes.size() == 1) {
-      putJob();
+      return putJob();
     } else if (suffixes.size() == 2) {
       putJobMethod();
     } else {
@@ -70,7 +76,61 @@ RestStatus RestJobHandler::execute() {
   return RestStatus::DONE;
 }
 
-void RestJobHandler::putJob() {
+RestStatus RestJobHandler::continueExecute() {
+  // the job is done or the timeout has passed, answer with the current
+  // state of the job. _waited prevents waiting a second time
+  _waitTimer.reset();
+  return execute();
+}
+
+bool RestJobHandler::waitForJob(uint64_t jobId) {
+  if (_waited) {
+    return false;
+  }
+
+  double timeout = _request->parsedValue("timeout", 0.0);
+  auto scheduler = SchedulerFeature::SCHEDULER;
+  if (timeout <= 0.0 || scheduler == nullptr) {
+    return false;
+  }
+  _waited = true;
+  timeout = std::min(timeout, MaxWaitTime);
+
+  RequestLane const lane = getRequestLane();
+  std::weak_ptr<RestHandler> weak = shared_from_this();
+  bool waiting = _jobManager->waitForJob(jobId, [weak, lane]() {
+    // called by the thread that finished or removed the job
+    auto self = weak.lock();
+    if (self == nullptr) {
+      return;
+    }
+    auto scheduler = SchedulerFeature::SCHEDULER;
+    if (scheduler == nullptr ||
+        !scheduler->queue(lane, [self]() { self->continueHandlerExecution(); })) {
+      self->continueHandlerExecution();
+    }
+  });
+
+  if (!waiting) {
+    // the job is not pending anymore
+    return false;
+  }
+
+  // the timer keeps the paused handler alive
+  auto self = shared_from_this();
+  _waitTimer = scheduler->queueDelay(
+      lane,
+      std::chrono::duration_cast<Scheduler::clock::duration>(
+          std::chrono::duration<double>(timeout)),
+      [self](bool canceled) {
+        if (!canceled) {
+          self->continueHandlerExecution();
+        }
+      });
+  return true;
+}
+
+RestStatus RestJobHandler::putJob() {
   std::vector<std::string> const& suffixes = _request->suffixes();
   std::string const& value = suffixes[0];
   uint64_t jobId = StringUtils::uint64(value);
@@ -81,13 +141,28 @@ void RestJobHandler::putJob() {
   if (status == AsyncJobResult::JOB_UNDEFINED) {
     // unknown or already fetched job
     generateError(rest::ResponseCode::NOT_FOUND, TRI_ERROR_HTTP_NOT_FOUND);
-    return;
+    return RestStatus::DONE;
+  }
+
+  if (status == AsyncJobResult::JOB_PENDING) {
+    if (waitForJob(jobId)) {
+      return RestStatus::WAITING;
+    }
+    if (_waited) {
+      // the job may have finished in the meantime
+      response = _jobManager->getJobResult(jobId, status, true);
+    }
+  }
+
+  if (status == AsyncJobResult::JOB_UNDEFINED) {
+    generateError(rest::ResponseCode::NOT_FOUND, TRI_ERROR_HTTP_NOT_FOUND);
+    return RestStatus::DONE;
   }
 
   if (status == AsyncJobResult::JOB_PENDING) {
     // job is still pending
     resetResponse(rest::ResponseCode::NO_CONTENT);
-    return;
+    return RestStatus::DONE;
   }
 
   TRI_ASSERT(status == AsyncJobResult::JOB_DONE);
@@ -99,6 +174,7 @@ void RestJobHandler::putJob() {
   // plus a new header
   static std::string const xArango = "x-arango-async-id";
   _response->setHeaderNC(xArango, value);
+  return RestStatus::DONE;
 }
 
 void RestJobHandler::putJobMethod() {
@@ -128,24 +204,24 @@ void RestJobHandler::putJobMethod() {
   }
 }
 
-void RestJobHandler::getJob() {
+RestStatus RestJobHandler::getJob() {
   std::vector<std::string> const& suffixes = _request->suffixes();
 
   if (suffixes.size() != 1) {
     generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER);
-    return;
+    return RestStatus::DONE;
   }
 
   std::string const type = suffixes[0];
 
   if (!type.empty() && type[0] >= '1' && type[0] <= '9') {
-    getJobById(type);
-  } else {
-    getJobByType(type);
+    return getJobById(type);
   }
+  getJobByType(type);
+  return RestStatus::DONE;
 }
 
-void RestJobHandler::getJobById(std::string const& value) {
+RestStatus RestJobHandler::getJobById(std::string const& value) {
   uint64_t jobId = StringUtils::uint64(value);
 
   // numeric job id, just pull the job status and return it
@@ -153,19 +229,28 @@ void RestJobHandler::getJobById(std::string const& value) {
   TRI_ASSERT(_jobManager != nullptr);
   _jobManager->getJobResult(jobId, status, false);  // just gets status
 
+  if (status == AsyncJobResult::JOB_PENDING && waitForJob(jobId)) {
+    return RestStatus::WAITING;
+  }
+  if (status == AsyncJobResult::JOB_PENDING && _waited) {
+    // the job may have finished in the meantime
+    _jobManager->getJobResult(jobId, status, false);
+  }
+
   if (status == AsyncJobResult::JOB_UNDEFINED) {
     // unknown or already fetched job
     generateError(rest::ResponseCode::NOT_FOUND, TRI_ERROR_HTTP_NOT_FOUND);
-    return;
+    return RestStatus::DONE;
   }
 
   if (status == AsyncJobResult::JOB_PENDING) {
     // job is still pending
     resetResponse(rest::ResponseCode::NO_CONTENT);
-    return;
+    return RestStatus::DONE;
   }
 
   resetResponse(rest::ResponseCode::OK);
+  return RestStatus::DONE;
 }
 
 void RestJobHandler::getJobByType(std::string const& type) {
@@ -27,6 +27,7 @@
 #include "Basics/Common.h"
 #include "GeneralServer/AsyncJobManager.h"
 #include "RestHandler/RestBaseHandler.h"
+#include "Scheduler/Scheduler.h"
 
 namespace arangodb {
 namespace rest {
@@ -46,12 +47,13 @@ class RestJobHandler : public RestBaseHandler {
   char const* name() const override final { return "RestJobHandler"; }
   RequestLane lane() const override final { return RequestLane::CLIENT_FAST; }
   RestStatus execute() override;
+  RestStatus continueExecute() override;
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief put handler
   //////////////////////////////////////////////////////////////////////////////
 
-  void putJob();
+  RestStatus putJob();
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief put method handler
@@ -63,13 +65,13 @@ class RestJobHandler : public RestBaseHandler {
   /// @brief get handler
   //////////////////////////////////////////////////////////////////////////////
 
-  void getJob();
+  RestStatus getJob();
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief get a job's status by its id
   //////////////////////////////////////////////////////////////////////////////
 
-  void getJobById(std::string const&);
+  RestStatus getJobById(std::string const&);
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief get job status by type
@@ -86,12 +88,27 @@ class RestJobHandler : public RestBaseHandler {
  protected:
   virtual uint32_t forwardingTarget() override;
 
+ private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief waits for a pending job if the client asked for it with the
+  /// "timeout" parameter. returns true if the handler has to be paused, it
+  /// is continued as soon as the job is done or the timeout has passed
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool waitForJob(uint64_t jobId);
+
  private:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief async job manager
   //////////////////////////////////////////////////////////////////////////////
 
   rest::AsyncJobManager* _jobManager;
+
+  /// @brief continues the handler when the timeout for waiting has passed
+  Scheduler::WorkHandle _waitTimer;
+
+  /// @brief whether the handler has waited for the job already
+  bool _waited;
 };
 }  // namespace arangodb
 
@@ -114,6 +114,46 @@ bool RestQueryHandler::readQuery(bool slow) {
     result.add("runTime", VPackValue(q.runTime));
     result.add("state", VPackValue(QueryExecutionState::toString(q.state)));
     result.add("stream", VPackValue(q.stream));
+    result.add("user", VPackValue(q.user));
+    result.add("resources", VPackValue(VPackValueType::Object));
+    q.resources.toVelocyPack(result);
+    result.close();
+    result.close();
+  }
+  result.close();
+
+  generateResult(rest::ResponseCode::OK, result.slice());
+
+  return true;
+}
+
+bool RestQueryHandler::readQueryCaptures() {
+  auto queryList = _vocbase.queryList();
+  auto captures = queryList->listCaptures();
+  VPackBuilder result;
+
+  result.add(VPackValue(VPackValueType::Array));
+  for (auto const& it : captures) {
+    result.add(it->slice());
+  }
+  result.close();
+
+  generateResult(rest::ResponseCode::OK, result.slice());
+
+  return true;
+}
+
+bool RestQueryHandler::readQueryUsage() {
+  auto queryList = _vocbase.queryList();
+  auto usage = queryList->listUsage();
+  VPackBuilder result;
+
+  result.add(VPackValue(VPackValueType::Array));
+  for (auto const& it : usage) {
+    result.add(VPackValue(VPackValueType::Object));
+    result.add("user", VPackValue(it.first));
+    result.add("queries", VPackValue(it.second.queries));
+    it.second.resources.toVelocyPack(result);
     result.close();
   }
   result.close();
@@ -141,11 +181,16 @@ bool RestQueryHandler::readQuery() {
     return readQuery(false);
   } else if (name == "properties") {
     return readQueryProperties();
+  } else if (name == "usage") {
+    return readQueryUsage();
+  } else if (name == "captures") {
+    return readQueryCaptures();
   }
 
   generateError(rest::ResponseCode::NOT_FOUND, TRI_ERROR_HTTP_NOT_FOUND,
                 "unknown type '" + name +
-                    "', expecting 'slow', 'current', or 'properties'");
+                    "', expecting 'slow', 'current', 'usage', 'captures' or "
+                    "'properties'");
   return true;
 }
 
@@ -59,6 +59,18 @@ class RestQueryHandler : public RestVocbaseBaseHandler {
 
   bool readQuery(bool slow);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief returns the resources used by the queries of each user
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool readQueryUsage();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief returns the captured plans and statistics of slow queries
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool readQueryCaptures();
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief returns AQL query tracking
   //////////////////////////////////////////////////////////////////////////////
@@ -62,6 +62,7 @@
 #include <velocypack/Iterator.h>
 #include <velocypack/Parser.h>
 #include <velocypack/Slice.h>
+#include <velocypack/Validator.h>
 #include <velocypack/velocypack-aliases.h>
 
 using namespace arangodb;
@@ -106,27 +107,10 @@ static bool ignoreHiddenEnterpriseCollection(std::string const& name, bool force
   return false;
 }
 
-static Result restoreDataParser(char const* ptr, char const* pos,
+static Result restoreDataParser(VPackSlice const slice,
                                 std::string const& collectionName, int line,
-                                std::string& key,
-                                VPackBuilder& builder, VPackSlice& doc,
+                                std::string& key, VPackSlice& doc,
                                 TRI_replication_operation_e& type) {
-  builder.clear();
-
-  try {
-    VPackParser parser(builder, builder.options);
-    parser.parse(ptr, static_cast<size_t>(pos - ptr));
-  } catch (std::exception const& ex) {
-    // Could not even build the string
-    return Result{TRI_ERROR_HTTP_CORRUPTED_JSON,
-                  "received invalid JSON data for collection '" +
-                      collectionName + "' on line " + std::to_string(line) + ": " + ex.what()};
-  } catch (...) {
-    return Result{TRI_ERROR_INTERNAL};
-  }
-
-  VPackSlice const slice = builder.slice();
-
   if (!slice.isObject()) {
     return Result{TRI_ERROR_HTTP_CORRUPTED_JSON,
                   "received invalid JSON data for collection '" +
@@ -182,6 +166,28 @@ static Result restoreDataParser(char const* ptr, char const* pos,
   return Result{TRI_ERROR_NO_ERROR};
 }
 
+static Result restoreDataParser(char const* ptr, char const* pos,
+                                std::string const& collectionName, int line,
+                                std::string& key,
+                                VPackBuilder& builder, VPackSlice& doc,
+                                TRI_replication_operation_e& type) {
+  builder.clear();
+
+  try {
+    VPackParser parser(builder, builder.options);
+    parser.parse(ptr, static_cast<size_t>(pos - ptr));
+  } catch (std::exception const& ex) {
+    // Could not even build the string
+    return Result{TRI_ERROR_HTTP_CORRUPTED_JSON,
+                  "received invalid JSON data for collection '" +
+                      collectionName + "' on line " + std::to_string(line) + ": " + ex.what()};
+  } catch (...) {
+    return Result{TRI_ERROR_INTERNAL};
+  }
+
+  return restoreDataParser(builder.slice(), collectionName, line, key, doc, type);
+}
+
 RestReplicationHandler::RestReplicationHandler(GeneralRequest* request, GeneralResponse* response)
     : RestVocbaseBaseHandler(request, response) {}
 
@@ -1164,10 +1170,15 @@ Result RestReplicationHandler::processRestoreData(std::string const& colName) {
     return processRestoreUsersBatch(colName);
   }
 
+  EngineSelectorFeature::ENGINE->prepareBulkLoad();
+
   auto ctx = transaction::StandaloneContext::Create(_vocbase);
   SingleCollectionTransaction trx(ctx, colName, AccessMode::Type::WRITE);
 
   trx.addHint(transaction::Hints::Hint::RECOVERY);  // to turn off waitForSync!
+  // all keys of a batch are distinct, so the writes do not need to be
+  // indexed for reading them back in the same transaction
+  trx.addHint(transaction::Hints::Hint::NO_INDEXING);
 
   Result res = trx.begin();
 
@@ -1179,7 +1190,10 @@ Result RestReplicationHandler::processRestoreData(std::string const& colName) {
     return res;
   }
 
-  res = processRestoreDataBatch(trx, colName);
+  // the client may assert that the collection was empty when the restore
+  // started and that the data contains every key only once
+  bool const bulk = _request->parsedValue("bulk", false);
+  res = processRestoreDataBatch(trx, colName, bulk);
   res = trx.finish(res);
 
   return res;
@@ -1205,6 +1219,39 @@ Result RestReplicationHandler::parseBatch(std::string const& collectionName,
 
   VPackValueLength currentPos = 0;
 
+  if (_request->contentType() == rest::ContentType::VPACK) {
+    // a sequence of VelocyPack markers, as produced by the dump API
+    VPackArrayBuilder guard(&allMarkers);
+    VPackValidator validator(&options);
+    std::string key;
+    int line = 0;
+    while (ptr < end) {
+      ++line;
+      try {
+        validator.validate(ptr, end - ptr, /*isSubPart*/ true);
+      } catch (std::exception const& ex) {
+        return Result{TRI_ERROR_HTTP_CORRUPTED_JSON,
+                      "received invalid VelocyPack data for collection '" +
+                          collectionName + "' in marker " + std::to_string(line) + ": " + ex.what()};
+      }
+      VPackSlice marker(reinterpret_cast<uint8_t const*>(ptr));
+      key.clear();
+      VPackSlice doc;
+      TRI_replication_operation_e type = REPLICATION_INVALID;
+
+      Result res = restoreDataParser(marker, collectionName, line, key, doc, type);
+      if (res.fail()) {
+        return res;
+      }
+
+      allMarkers.add(marker);
+      latest[key] = currentPos;
+      ++currentPos;
+      ptr += marker.byteSize();
+    }
+    return Result{TRI_ERROR_NO_ERROR};
+  }
+
   // First parse and collect all markers, we assemble everything in one
   // large builder holding an array. We keep for each key the latest
   // entry.
@@ -1331,7 +1378,8 @@ Result RestReplicationHandler::processRestoreUsersBatch(std::string const& colle
 ////////////////////////////////////////////////////////////////////////////////
 
 Result RestReplicationHandler::processRestoreDataBatch(transaction::Methods& trx,
-                                                       std::string const& collectionName) {
+                                                       std::string const& collectionName,
+                                                       bool bulk) {
   std::unordered_map<std::string, VPackValueLength> latest;
   VPackBuilder allMarkers;
 
@@ -1340,9 +1388,47 @@ Result RestReplicationHandler::processRestoreDataBatch(transaction::Methods& trx
     return res;
   }
 
+  VPackSlice allMarkersSlice = allMarkers.slice();
+
+  if (bulk && latest.size() == allMarkersSlice.length()) {
+    // no document of the batch can exist yet, so the documents can be
+    // inserted in one go, without the removal and replace passes below
+    VPackBuilder documents;
+    documents.openArray();
+    for (VPackSlice marker : VPackArrayIterator(allMarkersSlice)) {
+      int const type =
+          basics::VelocyPackHelper::getNumericValue<int>(marker.get(::typeString), 0);
+      if (type != REPLICATION_MARKER_DOCUMENT && type != 2301) {
+        bulk = false;
+        break;
+      }
+      documents.add(marker.get(::dataString));
+    }
+    documents.close();
+
+    if (bulk) {
+      OperationOptions options;
+      options.silent = true;
+      options.ignoreRevs = true;
+      options.isRestore = true;
+      options.waitForSync = false;
+      OperationResult opRes = trx.insert(collectionName, documents.slice(), options);
+      if (opRes.fail()) {
+        return opRes.result;
+      }
+      if (!opRes.countErrorCodes.empty()) {
+        // the collection was not empty after all
+        int code = opRes.countErrorCodes.begin()->first;
+        return Result(code, "bulk restore failed for " +
+                                std::to_string(opRes.countErrorCodes.begin()->second) +
+                                " document(s)");
+      }
+      return Result();
+    }
+  }
+
   // First remove all keys of which the last marker we saw was a deletion
   // marker:
-  VPackSlice allMarkersSlice = allMarkers.slice();
 
   VPackBuilder oldBuilder;
   {
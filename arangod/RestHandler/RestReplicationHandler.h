@@ -273,7 +273,8 @@ class RestReplicationHandler : public RestVocbaseBaseHandler {
   /// @brief restores the data of a collection
   //////////////////////////////////////////////////////////////////////////////
 
-  Result processRestoreDataBatch(transaction::Methods& trx, std::string const& colName);
+  Result processRestoreDataBatch(transaction::Methods& trx,
+                                 std::string const& colName, bool bulk);
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief restores the indexes of a collection
@@ -44,6 +44,15 @@ namespace arangodb {
 RestTasksHandler::RestTasksHandler(GeneralRequest* request, GeneralResponse* response)
     : RestVocbaseBaseHandler(request, response) {}
 
+RequestLane RestTasksHandler::lane() const {
+  // only registering a task runs JavaScript in the request itself
+  auto const type = _request->requestType();
+  if (type == rest::RequestType::POST || type == rest::RequestType::PUT) {
+    return RequestLane::CLIENT_V8;
+  }
+  return RequestLane::CLIENT_SLOW;
+}
+
 RestStatus RestTasksHandler::execute() {
   auto const type = _request->requestType();
 
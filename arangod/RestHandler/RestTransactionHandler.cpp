@@ -26,6 +26,7 @@
 #include "Actions/ActionFeature.h"
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Basics/ReadLocker.h"
+#include "Basics/VelocyPackHelper.h"
 #include "Basics/WriteLocker.h"
 #include "Cluster/ClusterInfo.h"
 #include "Cluster/ServerState.h"
@@ -34,6 +35,9 @@
 #include "Transaction/ManagerFeature.h"
 #include "Transaction/Helpers.h"
 #include "Transaction/Status.h"
+#include "Utils/OperationOptions.h"
+#include "Utils/OperationResult.h"
+#include "Utils/SingleCollectionTransaction.h"
 #include "V8/JavaScriptSecurityContext.h"
 #include "V8Server/V8Context.h"
 #include "V8Server/V8DealerFeature.h"
@@ -47,9 +51,51 @@ using namespace arangodb;
 using namespace arangodb::basics;
 using namespace arangodb::rest;
 
+namespace {
+/// @brief operation options of a single batch operation
+OperationOptions batchOperationOptions(VPackSlice options) {
+  OperationOptions opts;
+  if (!options.isObject()) {
+    return opts;
+  }
+  opts.waitForSync =
+      VelocyPackHelper::getBooleanValue(options, StaticStrings::WaitForSyncString, false);
+  opts.keepNull =
+      VelocyPackHelper::getBooleanValue(options, StaticStrings::KeepNullString, true);
+  opts.mergeObjects =
+      VelocyPackHelper::getBooleanValue(options, StaticStrings::MergeObjectsString, true);
+  opts.incrementNumbers =
+      VelocyPackHelper::getBooleanValue(options, StaticStrings::IncrementNumbersString, false);
+  opts.ignoreRevs =
+      VelocyPackHelper::getBooleanValue(options, StaticStrings::IgnoreRevsString, true);
+  opts.returnNew =
+      VelocyPackHelper::getBooleanValue(options, StaticStrings::ReturnNewString, false);
+  opts.returnOld =
+      VelocyPackHelper::getBooleanValue(options, StaticStrings::ReturnOldString, false);
+  opts.silent = VelocyPackHelper::getBooleanValue(options, StaticStrings::SilentString, false);
+  opts.overwrite = VelocyPackHelper::getBooleanValue(options, "overwrite", false);
+  return opts;
+}
+
+/// @brief whether a batch operation type only reads
+bool isReadOperation(VPackSlice type) {
+  return type.isString() && type.isEqualString("document");
+}
+}  // namespace
+
 RestTransactionHandler::RestTransactionHandler(GeneralRequest* request, GeneralResponse* response)
     : RestVocbaseBaseHandler(request, response), _v8Context(nullptr), _lock() {}
 
+RequestLane RestTransactionHandler::lane() const {
+  // only JavaScript transactions need a V8 context. the requests of
+  // managed transactions are handled natively and must not wait for one
+  if (_request->requestType() == rest::RequestType::POST &&
+      _request->suffixes().empty()) {
+    return RequestLane::CLIENT_V8;
+  }
+  return RequestLane::CLIENT_SLOW;
+}
+
 RestStatus RestTransactionHandler::execute() {
     
   switch (_request->requestType()) {
@@ -61,6 +107,9 @@ RestStatus RestTransactionHandler::execute() {
       if (_request->suffixes().size() == 1 &&
           _request->suffixes()[0] == "begin") {
         executeBegin();
+      } else if (_request->suffixes().size() == 2 &&
+                 _request->suffixes()[1] == "batch") {
+        executeBatch();
       } else if (_request->suffixes().empty()) {
         executeJSTransaction();
       } else {
@@ -207,6 +256,139 @@ void RestTransactionHandler::executeAbort() {
   }
 }
 
+/// execute all operations of the request body inside the managed transaction,
+/// leasing the transaction only once for the whole sequence. body:
+/// { "operations": [ { "type": "insert|update|replace|remove|document",
+///                     "collection": "...", "data": {...} | [...],
+///                     "options": {...} }, ... ],
+///   "continueOnError": false }
+void RestTransactionHandler::executeBatch() {
+  TRI_voc_tid_t tid = basics::StringUtils::uint64(_request->suffixes()[0]);
+  if (tid == 0) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_BAD_PARAMETER,
+                  "bad transaction ID");
+    return;
+  }
+
+  bool parseSuccess = false;
+  VPackSlice body = parseVPackBody(parseSuccess);
+  if (!parseSuccess) {
+    // error message generated in parseVPackBody
+    return;
+  }
+
+  VPackSlice operations = body.get("operations");
+  if (!operations.isArray()) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_BAD_PARAMETER,
+                  "expecting 'operations' array");
+    return;
+  }
+  bool const continueOnError =
+      VelocyPackHelper::getBooleanValue(body, "continueOnError", false);
+
+  // validate all operations upfront, so a malformed batch does not leave
+  // the transaction half-modified
+  AccessMode::Type mode = AccessMode::Type::READ;
+  for (VPackSlice op : VPackArrayIterator(operations)) {
+    if (!op.isObject() || !op.get("collection").isString() ||
+        !op.get("type").isString()) {
+      generateError(rest::ResponseCode::BAD, TRI_ERROR_BAD_PARAMETER,
+                    "expecting operations with 'type' and 'collection'");
+      return;
+    }
+    VPackSlice data = op.get("data");
+    if (!data.isObject() && !data.isArray()) {
+      generateError(rest::ResponseCode::BAD, TRI_ERROR_ARANGO_DOCUMENT_TYPE_INVALID);
+      return;
+    }
+    if (!isReadOperation(op.get("type"))) {
+      mode = AccessMode::Type::WRITE;
+    }
+  }
+
+  transaction::Manager* mgr = transaction::ManagerFeature::manager();
+  TRI_ASSERT(mgr != nullptr);
+
+  // the lease keeps the transaction pinned to this thread for the
+  // whole batch
+  auto ctx = mgr->leaseManagedTrx(tid, mode);
+  if (!ctx) {
+    generateError(rest::ResponseCode::NOT_FOUND, TRI_ERROR_TRANSACTION_NOT_FOUND);
+    return;
+  }
+
+  VPackBuffer<uint8_t> buffer;
+  VPackBuilder builder(buffer);
+  builder.openObject(true);
+  builder.add(StaticStrings::Code, VPackValue(static_cast<int>(rest::ResponseCode::OK)));
+  builder.add(StaticStrings::Error, VPackValue(false));
+  builder.add("id", VPackValue(std::to_string(tid)));
+  builder.add("result", VPackValue(VPackValueType::Array));
+
+  for (VPackSlice op : VPackArrayIterator(operations)) {
+    VPackSlice type = op.get("type");
+    std::string const collection = op.get("collection").copyString();
+    VPackSlice data = op.get("data");
+    OperationOptions opts = ::batchOperationOptions(op.get("options"));
+
+    OperationResult result(TRI_ERROR_NO_ERROR);
+    try {
+      AccessMode::Type opMode =
+          isReadOperation(type) ? AccessMode::Type::READ : AccessMode::Type::WRITE;
+      SingleCollectionTransaction trx(ctx, collection, opMode);
+      Result res = trx.begin();
+      if (res.fail()) {
+        result = OperationResult(res);
+      } else {
+        if (type.isEqualString("insert")) {
+          result = trx.insert(collection, data, opts);
+        } else if (type.isEqualString("update")) {
+          result = trx.update(collection, data, opts);
+        } else if (type.isEqualString("replace")) {
+          result = trx.replace(collection, data, opts);
+        } else if (type.isEqualString("remove")) {
+          result = trx.remove(collection, data, opts);
+        } else if (type.isEqualString("document")) {
+          result = trx.document(collection, data, opts);
+        } else {
+          result = OperationResult(Result(TRI_ERROR_BAD_PARAMETER,
+                                          "unknown operation type"));
+        }
+        res = trx.finish(result.result);
+        if (result.ok() && res.fail()) {
+          result = OperationResult(res);
+        }
+      }
+    } catch (basics::Exception const& ex) {
+      result = OperationResult(Result(ex.code(), ex.what()));
+    } catch (std::exception const& ex) {
+      result = OperationResult(Result(TRI_ERROR_INTERNAL, ex.what()));
+    }
+
+    builder.openObject();
+    if (result.fail()) {
+      builder.add(StaticStrings::Error, VPackValue(true));
+      builder.add(StaticStrings::ErrorNum, VPackValue(result.errorNumber()));
+      builder.add(StaticStrings::ErrorMessage, VPackValue(result.errorMessage()));
+    } else {
+      builder.add(StaticStrings::Error, VPackValue(false));
+      if (result.buffer != nullptr) {
+        builder.add("result", result.slice());
+      }
+    }
+    builder.close();
+
+    if (result.fail() && !continueOnError) {
+      break;
+    }
+  }
+
+  builder.close();  // result
+  builder.close();
+
+  generateResult(rest::ResponseCode::OK, std::move(buffer));
+}
+
 void RestTransactionHandler::generateTransactionResult(rest::ResponseCode code,
                                                        TRI_voc_tid_t tid,
                                                        transaction::Status status) {
@@ -305,12 +487,17 @@ bool RestTransactionHandler::cancel() {
 /// @brief returns the short id of the server which should handle this request
 uint32_t RestTransactionHandler::forwardingTarget() {
   rest::RequestType const type = _request->requestType();
-  if (type != rest::RequestType::GET && type != rest::RequestType::PUT &&
-      type != rest::RequestType::DELETE_REQ) {
+  std::vector<std::string> const& suffixes = _request->suffixes();
+  if (type == rest::RequestType::POST) {
+    // only batches of an existing transaction are bound to a server
+    if (suffixes.size() != 2 || suffixes[1] != "batch") {
+      return 0;
+    }
+  } else if (type != rest::RequestType::GET && type != rest::RequestType::PUT &&
+             type != rest::RequestType::DELETE_REQ) {
     return 0;
   }
 
-  std::vector<std::string> const& suffixes = _request->suffixes();
   if (suffixes.size() < 1) {
     return 0;
   }
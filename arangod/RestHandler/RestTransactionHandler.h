@@ -42,7 +42,7 @@ class RestTransactionHandler : public arangodb::RestVocbaseBaseHandler {
 
  public:
   char const* name() const override final { return "RestTransactionHandler"; }
-  RequestLane lane() const override final { return RequestLane::CLIENT_V8; }
+  RequestLane lane() const override final;
   RestStatus execute() override;
   bool cancel() override final;
 
@@ -54,6 +54,8 @@ class RestTransactionHandler : public arangodb::RestVocbaseBaseHandler {
   void executeBegin();
   void executeCommit();
   void executeAbort();
+  /// execute a sequence of document operations inside a managed transaction
+  void executeBatch();
   void generateTransactionResult(rest::ResponseCode code, TRI_voc_tid_t tid,
                                  transaction::Status status);
 
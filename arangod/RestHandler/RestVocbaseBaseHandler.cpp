@@ -137,6 +137,12 @@ std::string const RestVocbaseBaseHandler::IMPORT_PATH = "/_api/import";
 
 std::string const RestVocbaseBaseHandler::INDEX_PATH = "/_api/index";
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief prepared statement path
+////////////////////////////////////////////////////////////////////////////////
+
+std::string const RestVocbaseBaseHandler::PREPARE_PATH = "/_api/prepare";
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief replication path
 ////////////////////////////////////////////////////////////////////////////////
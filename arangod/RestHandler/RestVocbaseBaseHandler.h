@@ -131,6 +131,12 @@ class RestVocbaseBaseHandler : public RestBaseHandler {
 
   static std::string const INDEX_PATH;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief prepared statement path
+  //////////////////////////////////////////////////////////////////////////////
+
+  static std::string const PREPARE_PATH;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief replication path
   //////////////////////////////////////////////////////////////////////////////
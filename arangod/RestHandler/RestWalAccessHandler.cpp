@@ -24,6 +24,7 @@
 #include "Basics/StaticStrings.h"
 #include "Basics/VPackStringBufferAdapter.h"
 #include "Basics/VelocyPackHelper.h"
+#include "Replication/ReplicationClients.h"
 #include "Replication/common-defines.h"
 #include "Replication/utilities.h"
 #include "Rest/HttpResponse.h"
@@ -67,6 +68,19 @@ RestWalAccessHandler::RestWalAccessHandler(GeneralRequest* request, GeneralRespo
     : RestVocbaseBaseHandler(request, response) {}
 
 bool RestWalAccessHandler::parseFilter(WalAccess::Filter& filter) {
+  // a subscription provides the default start tick and the collections
+  bool hasSubscription = false;
+  ReplicationSubscription subscription;
+  std::string const& subscriptionName = _request->value("subscription", hasSubscription);
+  if (hasSubscription) {
+    if (!_vocbase.replicationClients().subscription(subscriptionName, subscription)) {
+      generateError(rest::ResponseCode::NOT_FOUND, TRI_ERROR_HTTP_NOT_FOUND,
+                    "subscription not found");
+      return false;
+    }
+    filter.tickStart = subscription.committedTick;
+  }
+
   // determine start and end tick
   filter.tickStart = _request->parsedValue<uint64_t>("from", filter.tickStart);
   filter.tickLastScanned =
@@ -92,19 +106,35 @@ bool RestWalAccessHandler::parseFilter(WalAccess::Filter& filter) {
     // filter for database
     filter.vocbase = _vocbase.id();
 
-    // extract collection
+    // extract collections, a comma-separated list of names
     bool found = false;
     std::string const& value2 = _request->value("collection", found);
     if (found) {
-      auto c = _vocbase.lookupCollection(value2);
+      for (std::string const& name : StringUtils::split(value2, ',')) {
+        auto c = _vocbase.lookupCollection(name);
 
-      if (c == nullptr) {
-        generateError(rest::ResponseCode::NOT_FOUND, TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND);
+        if (c == nullptr) {
+          generateError(rest::ResponseCode::NOT_FOUND,
+                        TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND);
+          return false;
+        }
+
+        // filter for collection
+        filter.collections.emplace(c->id());
+      }
+    } else if (hasSubscription) {
+      // collections dropped after subscribing are simply not tailed anymore
+      for (std::string const& name : subscription.collections) {
+        auto c = _vocbase.lookupCollection(name);
+        if (c != nullptr) {
+          filter.collections.emplace(c->id());
+        }
+      }
+      if (filter.collections.empty() && !subscription.collections.empty()) {
+        generateError(rest::ResponseCode::NOT_FOUND,
+                      TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND);
         return false;
       }
-
-      // filter for collection
-      filter.collection = c->id();
     }
   }
 
@@ -161,7 +191,7 @@ RestStatus RestWalAccessHandler::execute() {
   std::vector<std::string> suffixes = _request->decodedSuffixes();
   if (suffixes.empty()) {
     generateError(ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
-                  "expected GET _api/wal/[tail|range|lastTick]>");
+                  "expected GET _api/wal/[tail|range|lastTick|open-transactions|subscriptions]>");
     return RestStatus::DONE;
   }
 
@@ -180,10 +210,11 @@ RestStatus RestWalAccessHandler::execute() {
   } else if (suffixes[0] == "open-transactions" &&
              _request->requestType() == RequestType::GET) {
     handleCommandDetermineOpenTransactions(wal);
+  } else if (suffixes[0] == "subscriptions") {
+    handleCommandSubscriptions(wal, suffixes);
   } else {
-    generateError(
-        ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
-        "expected GET _api/wal/[tail|range|lastTick|open-transactions]>");
+    generateError(ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                  "expected GET _api/wal/[tail|range|lastTick|open-transactions|subscriptions]>");
   }
 
   return RestStatus::DONE;
@@ -267,6 +298,9 @@ void RestWalAccessHandler::handleCommandTail(WalAccess const* wal) {
   };
 
   size_t length = 0;
+  // markers are sent as consecutive VelocyPack values if requested, so that
+  // clients do not need to parse JSON
+  bool const binary = !useVst && _request->contentTypeResponse() == rest::ContentType::VPACK;
 
   if (useVst) {
     result = wal->tail(filter, chunkSize, barrierId, 
@@ -287,22 +321,44 @@ void RestWalAccessHandler::handleCommandTail(WalAccess const* wal) {
                                      "invalid response type");
     }
     basics::StringBuffer& buffer = httpResponse->body();
-    basics::VPackStringBufferAdapter adapter(buffer.stringBuffer());
-    // note: we need the CustomTypeHandler here
-    VPackDumper dumper(&adapter, &opts);
-    result = wal->tail(filter, chunkSize, barrierId, 
-                       [&](TRI_vocbase_t* vocbase, VPackSlice const& marker) {
-                         length++;
-
-                         if (vocbase != nullptr) {  // database drop has no vocbase
-                           prepOpts(*vocbase);
-                         }
-
-                         dumper.dump(marker);
-                         buffer.appendChar('\n');
-                         // LOG_TOPIC("cda47", INFO, Logger::REPLICATION) <<
-                         // marker.toJson(&opts);
-                       });
+    if (binary) {
+      VPackBuilder sanitized;
+      result = wal->tail(filter, chunkSize, barrierId,
+                         [&](TRI_vocbase_t* vocbase, VPackSlice const& marker) {
+                           length++;
+
+                           if (vocbase != nullptr) {  // database drop has no vocbase
+                             prepOpts(*vocbase);
+                           }
+
+                           // clients cannot resolve custom types like _id
+                           VPackSlice out = marker;
+                           if (VelocyPackHelper::hasNonClientTypes(marker, true, true)) {
+                             sanitized.clear();
+                             VelocyPackHelper::sanitizeNonClientTypes(
+                                 marker, VPackSlice::noneSlice(), sanitized, &opts, true, true);
+                             out = sanitized.slice();
+                           }
+                           buffer.appendText(out.startAs<char>(), out.byteSize());
+                         });
+    } else {
+      basics::VPackStringBufferAdapter adapter(buffer.stringBuffer());
+      // note: we need the CustomTypeHandler here
+      VPackDumper dumper(&adapter, &opts);
+      result = wal->tail(filter, chunkSize, barrierId,
+                         [&](TRI_vocbase_t* vocbase, VPackSlice const& marker) {
+                           length++;
+
+                           if (vocbase != nullptr) {  // database drop has no vocbase
+                             prepOpts(*vocbase);
+                           }
+
+                           dumper.dump(marker);
+                           buffer.appendChar('\n');
+                           // LOG_TOPIC("cda47", INFO, Logger::REPLICATION) <<
+                           // marker.toJson(&opts);
+                         });
+    }
   }
 
   if (result.fail()) {
@@ -311,7 +367,7 @@ void RestWalAccessHandler::handleCommandTail(WalAccess const* wal) {
   }
 
   // transfer ownership of the buffer contents
-  _response->setContentType(rest::ContentType::DUMP);
+  _response->setContentType(binary ? rest::ContentType::VPACK : rest::ContentType::DUMP);
 
   TRI_ASSERT(result.latestTick() >= result.lastIncludedTick());
   TRI_ASSERT(result.latestTick() >= result.lastScannedTick());
@@ -405,6 +461,124 @@ void RestWalAccessHandler::handleCommandDetermineOpenTransactions(WalAccess cons
   }
 }
 
+/// GET    _api/wal/subscriptions         lists all subscriptions
+/// POST   _api/wal/subscriptions         {name, collections, from, ttl} subscribes
+/// GET    _api/wal/subscriptions/<name>  returns a single subscription
+/// PUT    _api/wal/subscriptions/<name>  {tick} commits the consumer progress
+/// DELETE _api/wal/subscriptions/<name>  unsubscribes
+void RestWalAccessHandler::handleCommandSubscriptions(WalAccess const* wal,
+                                                      std::vector<std::string> const& suffixes) {
+  ReplicationClientsProgressTracker& tracker = _vocbase.replicationClients();
+  auto const type = _request->requestType();
+
+  if (suffixes.size() == 1 && type == RequestType::GET) {
+    VPackBuilder result;
+    tracker.subscriptionsToVelocyPack(result);
+    generateResult(rest::ResponseCode::OK, result.slice());
+    return;
+  }
+
+  auto generateSubscription = [&](std::string const& name, rest::ResponseCode code) {
+    ReplicationSubscription subscription;
+    if (!tracker.subscription(name, subscription)) {
+      generateError(rest::ResponseCode::NOT_FOUND, TRI_ERROR_HTTP_NOT_FOUND,
+                    "subscription not found");
+      return;
+    }
+    VPackBuilder result;
+    result.openObject();
+    result.add("name", VPackValue(name));
+    subscription.toVelocyPack(result);
+    result.close();
+    generateResult(code, result.slice());
+  };
+
+  if (suffixes.size() == 1 && type == RequestType::POST) {
+    bool parseSuccess = false;
+    VPackSlice body = parseVPackBody(parseSuccess);
+    if (!parseSuccess) {
+      return;
+    }
+    if (!body.isObject() || !body.get("name").isString()) {
+      generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                    "invalid body value. expecting object with 'name'");
+      return;
+    }
+    std::vector<std::string> collections;
+    VPackSlice value = body.get("collections");
+    if (value.isArray()) {
+      for (VPackSlice name : VPackArrayIterator(value)) {
+        if (!name.isString()) {
+          generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                        "invalid 'collections' value. expecting array of names");
+          return;
+        }
+        collections.emplace_back(name.copyString());
+      }
+    }
+    // new subscriptions start at the current end of the WAL by default
+    uint64_t tick = wal->lastTick();
+    value = body.get("from");
+    if (value.isString() || value.isNumber()) {
+      tick = VelocyPackHelper::stringUInt64(value);
+    }
+    // subscriptions expire if their consumer does not commit within the TTL
+    double ttl = 0.0;
+    value = body.get("ttl");
+    if (value.isNumber()) {
+      ttl = value.getNumber<double>();
+    }
+    std::string const name = body.get("name").copyString();
+    Result res = tracker.subscribe(name, collections, tick, ttl);
+    if (res.fail()) {
+      generateError(res);
+      return;
+    }
+    generateSubscription(name, rest::ResponseCode::CREATED);
+    return;
+  }
+
+  if (suffixes.size() == 2) {
+    std::string const& name = suffixes[1];
+    if (type == RequestType::GET) {
+      generateSubscription(name, rest::ResponseCode::OK);
+      return;
+    }
+    if (type == RequestType::PUT) {
+      bool parseSuccess = false;
+      VPackSlice body = parseVPackBody(parseSuccess);
+      if (!parseSuccess) {
+        return;
+      }
+      VPackSlice tick = body.isObject() ? body.get("tick") : VPackSlice::noneSlice();
+      if (!tick.isString() && !tick.isNumber()) {
+        generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                      "invalid body value. expecting object with 'tick'");
+        return;
+      }
+      Result res = tracker.commit(name, VelocyPackHelper::stringUInt64(tick));
+      if (res.fail()) {
+        generateError(res);
+        return;
+      }
+      generateSubscription(name, rest::ResponseCode::OK);
+      return;
+    }
+    if (type == RequestType::DELETE_REQ) {
+      Result res = tracker.unsubscribe(name);
+      if (res.fail()) {
+        generateError(res);
+        return;
+      }
+      generateOk(rest::ResponseCode::OK, VPackSlice::emptyObjectSlice());
+      return;
+    }
+  }
+
+  generateError(ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                "expected _api/wal/subscriptions[/<name>]");
+}
+
 //////////////////////////////////////////////////////////////////////////////
 /// @brief Grant temporary restore rights
 //////////////////////////////////////////////////////////////////////////////
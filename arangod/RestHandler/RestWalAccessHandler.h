@@ -48,6 +48,8 @@ class RestWalAccessHandler : public arangodb::RestVocbaseBaseHandler {
   void handleCommandLastTick(WalAccess const* wal);
   void handleCommandTail(WalAccess const* wal);
   void handleCommandDetermineOpenTransactions(WalAccess const* wal);
+  void handleCommandSubscriptions(WalAccess const* wal,
+                                  std::vector<std::string> const& suffixes);
 
   void grantTemporaryRights();
 };
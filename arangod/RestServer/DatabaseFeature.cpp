@@ -26,6 +26,7 @@
 #include "Agency/v8-agency.h"
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Aql/PlanCache.h"
+#include "Aql/PreparedStatement.h"
 #include "Aql/QueryCache.h"
 #include "Aql/QueryList.h"
 #include "Aql/QueryRegistry.h"
@@ -36,6 +37,7 @@
 #include "Basics/StringUtils.h"
 #include "Basics/WriteLocker.h"
 #include "Basics/files.h"
+#include "Basics/system-functions.h"
 #include "Cluster/ServerState.h"
 #include "Cluster/TraverserEngineRegistry.h"
 #include "Cluster/v8-cluster.h"
@@ -64,6 +66,10 @@
 
 #include <velocypack/velocypack-aliases.h>
 
+#include <atomic>
+#include <exception>
+#include <thread>
+
 using namespace arangodb;
 using namespace arangodb::application_features;
 using namespace arangodb::basics;
@@ -242,6 +248,7 @@ DatabaseFeature::DatabaseFeature(application_features::ApplicationServer& server
       _forceSyncProperties(true),
       _ignoreDatafileErrors(false),
       _throwCollectionNotLoadedError(false),
+      _openThreads(0),
       _databasesLists(new DatabasesLists()),
       _isInitiallyEmpty(false),
       _checkVersion(false),
@@ -298,6 +305,12 @@ void DatabaseFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
       new AtomicBooleanParameter(&_throwCollectionNotLoadedError),
       arangodb::options::makeFlags(arangodb::options::Flags::Hidden));
 
+  options->addOption("--database.open-threads",
+                     "number of threads opening the databases at startup "
+                     "(0 = one per processor)",
+                     new UInt64Parameter(&_openThreads),
+                     arangodb::options::makeFlags(arangodb::options::Flags::Hidden));
+
   // the following option was removed in 3.2
   // index-creation is now automatically parallelized via the Boost ASIO thread
   // pool
@@ -807,11 +820,13 @@ int DatabaseFeature::dropDatabase(std::string const& name, bool waitForDeletion,
     vocbase->setIsOwnAppsDirectory(removeAppsDirectory);
 
     // invalidate all entries for the database
-#if USE_PLAN_CACHE
     arangodb::aql::PlanCache::instance()->invalidate(vocbase);
-#endif
+    arangodb::aql::PreparedStatementRegistry::instance()->drop(vocbase);
     arangodb::aql::QueryCache::instance()->invalidate(vocbase);
 
+    // WAL subscriptions must not outlive the database
+    vocbase->replicationClients().dropSubscriptions();
+
     engine->prepareDropDatabase(*vocbase, !engine->inRecovery(), res);
   }
   // must not use the database after here, as it may now be
@@ -1238,6 +1253,7 @@ int DatabaseFeature::iterateDatabases(VPackSlice const& databases) {
   ServerState::RoleEnum role = arangodb::ServerState::instance()->getRole();
 
   try {
+    std::vector<VPackSlice> toOpen;
     for (auto const& it : VPackArrayIterator(databases)) {
       TRI_ASSERT(it.isObject());
 
@@ -1258,10 +1274,56 @@ int DatabaseFeature::iterateDatabases(VPackSlice const& databases) {
         break;
       }
 
-      // open the database and scan collections in it
+      toOpen.emplace_back(it);
+    }
+
+    // open the databases and scan the collections in them. the databases
+    // are independent of each other, so they are opened in parallel
+    std::vector<std::unique_ptr<TRI_vocbase_t>> opened(toOpen.size());
+    std::atomic<size_t> next(0);
+    Mutex errorLock;
+    std::exception_ptr error;
+
+    auto open = [&]() {
+      size_t i;
+      while ((i = next.fetch_add(1)) < toOpen.size()) {
+        try {
+          opened[i] = engine->openDatabase(toOpen[i], _upgrade);
+        } catch (...) {
+          MUTEX_LOCKER(locker, errorLock);
+          if (!error) {
+            error = std::current_exception();
+          }
+          // no need to open any more databases
+          next.store(toOpen.size());
+        }
+      }
+    };
+
+    size_t numThreads =
+        _openThreads > 0 ? static_cast<size_t>(_openThreads)
+                         : (std::max)(TRI_numberProcessors(), size_t(1));
+    numThreads = (std::min)(numThreads, toOpen.size());
+    {
+      std::vector<std::thread> threads;
+      TRI_DEFER(for (auto& thread : threads) { thread.join(); });
+      for (size_t i = 1; i < numThreads; ++i) {
+        threads.emplace_back(open);
+      }
+      open();
+    }
+
+    if (error) {
+      std::rethrow_exception(error);
+    }
+
+    LOG_TOPIC("1e3c0", DEBUG, Logger::FIXME)
+        << "opened " << opened.size() << " database(s) using "
+        << (std::max)(numThreads, size_t(1)) << " thread(s)";
 
-      // try to open this database
-      auto* database = engine->openDatabase(it, _upgrade).release();
+    for (auto& it : opened) {
+      TRI_ASSERT(it != nullptr);
+      auto* database = it.release();
 
       if (!ServerState::isCoordinator(role) && !ServerState::isAgent(role)) {
         try {
@@ -173,6 +173,9 @@ class DatabaseFeature : public application_features::ApplicationFeature {
   bool _forceSyncProperties;
   bool _ignoreDatafileErrors;
   std::atomic<bool> _throwCollectionNotLoadedError;
+  /// @brief number of threads opening the databases at startup, 0 means
+  /// one per processor
+  uint64_t _openThreads;
 
   std::unique_ptr<DatabaseManagerThread> _databaseManager;
 
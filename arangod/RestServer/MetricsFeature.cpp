@@ -0,0 +1,128 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MetricsFeature.h"
+#include "Basics/MutexLocker.h"
+#include "Cache/CacheManagerFeature.h"
+#include "Cache/Manager.h"
+#include "ProgramOptions/ProgramOptions.h"
+#include "ProgramOptions/Section.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
+#include "Statistics/ServerStatistics.h"
+#include "Statistics/StatisticsFeature.h"
+
+using namespace arangodb;
+using namespace arangodb::basics;
+using namespace arangodb::metrics;
+using namespace arangodb::options;
+
+MetricsFeature* MetricsFeature::METRICS = nullptr;
+
+MetricsFeature::MetricsFeature(application_features::ApplicationServer& server)
+    : ApplicationFeature(server, "Metrics"), _registry(new Registry()), _export(true) {
+  setOptional(false);
+  startsAfter("BasicsPhase");
+  METRICS = this;
+}
+
+MetricsFeature::~MetricsFeature() { METRICS = nullptr; }
+
+void MetricsFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
+  options->addSection("server", "Server features");
+
+  options->addOption("--server.export-metrics-api",
+                     "turn metrics API available at /_admin/metrics on or off",
+                     new BooleanParameter(&_export));
+}
+
+void MetricsFeature::start() {
+  _registry->addCollector("statistics", [](std::string& result) {
+    if (!StatisticsFeature::enabled()) {
+      return;
+    }
+
+    Registry::appendHeader(result, "arangodb_client_connections",
+                           "number of open client connections", "gauge");
+    Registry::appendSample(result, "arangodb_client_connections", "",
+                           TRI_HttpConnectionsStatistics._count.load());
+
+    Registry::appendHeader(result, "arangodb_http_requests_total",
+                           "number of HTTP requests", "counter");
+    Registry::appendSample(result, "arangodb_http_requests_total", "",
+                           TRI_TotalRequestsStatistics._count.load());
+
+    Registry::appendHeader(result, "arangodb_http_async_requests_total",
+                           "number of asynchronously executed HTTP requests",
+                           "counter");
+    Registry::appendSample(result, "arangodb_http_async_requests_total", "",
+                           TRI_AsyncRequestsStatistics._count.load());
+
+    Registry::appendHeader(result, "arangodb_http_method_requests_total",
+                           "number of HTTP requests per method", "counter");
+    MUTEX_LOCKER(locker, TRI_RequestsStatisticsMutex);
+    for (size_t i = 0; i < MethodRequestsStatisticsSize; ++i) {
+      auto type = static_cast<rest::RequestType>(i);
+      if (type == rest::RequestType::ILLEGAL) {
+        continue;
+      }
+      Registry::appendSample(result, "arangodb_http_method_requests_total",
+                             std::string("{method=\"") + rest::requestToString(type) + "\"}",
+                             TRI_MethodRequestsStatistics[i]._count.load());
+    }
+  });
+
+  _registry->addCollector("server", [](std::string& result) {
+    ServerStatistics info = ServerStatistics::statistics();
+    Registry::appendHeader(result, "arangodb_server_uptime_seconds",
+                           "time since the server was started", "gauge");
+    Registry::appendSample(result, "arangodb_server_uptime_seconds", "", info._uptime);
+
+    auto scheduler = SchedulerFeature::SCHEDULER;
+    if (scheduler != nullptr) {
+      Scheduler::QueueStatistics qs = scheduler->queueStatistics();
+      Registry::appendHeader(result, "arangodb_scheduler_threads",
+                             "number of scheduler threads", "gauge");
+      Registry::appendSample(result, "arangodb_scheduler_threads", "", qs._running);
+      Registry::appendHeader(result, "arangodb_scheduler_working_threads",
+                             "number of scheduler threads executing a task", "gauge");
+      Registry::appendSample(result, "arangodb_scheduler_working_threads", "", qs._working);
+      Registry::appendHeader(result, "arangodb_scheduler_queue_length",
+                             "number of tasks queued in the scheduler", "gauge");
+      Registry::appendSample(result, "arangodb_scheduler_queue_length", "", qs._queued);
+    }
+
+    auto manager = CacheManagerFeature::MANAGER;
+    if (manager != nullptr) {
+      Registry::appendHeader(result, "arangodb_cache_limit_bytes",
+                             "global memory limit of the in-memory caches", "gauge");
+      Registry::appendSample(result, "arangodb_cache_limit_bytes", "", manager->globalLimit());
+      Registry::appendHeader(result, "arangodb_cache_allocated_bytes",
+                             "memory allocated by the in-memory caches", "gauge");
+      Registry::appendSample(result, "arangodb_cache_allocated_bytes", "",
+                             manager->globalAllocation());
+      Registry::appendHeader(result, "arangodb_cache_hit_rate",
+                             "lifetime hit rate of the in-memory caches in percent",
+                             "gauge");
+      Registry::appendSample(result, "arangodb_cache_hit_rate", "",
+                             manager->globalHitRates().first);
+    }
+  });
+}
@@ -0,0 +1,56 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_REST_SERVER_METRICS_FEATURE_H
+#define ARANGOD_REST_SERVER_METRICS_FEATURE_H 1
+
+#include "ApplicationFeatures/ApplicationFeature.h"
+#include "Basics/Metrics.h"
+
+namespace arangodb {
+
+/// @brief owns the metrics registry of the server. other features register
+/// their metrics and collectors with it, /_admin/metrics exports them
+class MetricsFeature final : public application_features::ApplicationFeature {
+ public:
+  explicit MetricsFeature(application_features::ApplicationServer& server);
+  ~MetricsFeature();
+
+  void collectOptions(std::shared_ptr<options::ProgramOptions>) override final;
+  void start() override final;
+
+  /// @brief the registry, nullptr if the feature does not exist
+  static metrics::Registry* registry() {
+    return METRICS != nullptr ? METRICS->_registry.get() : nullptr;
+  }
+
+  /// @brief whether /_admin/metrics is available
+  static bool exportAPI() { return METRICS != nullptr && METRICS->_export; }
+
+ private:
+  static MetricsFeature* METRICS;
+
+  std::unique_ptr<metrics::Registry> _registry;
+  bool _export;
+};
+
+}  // namespace arangodb
+
+#endif
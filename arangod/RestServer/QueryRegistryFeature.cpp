@@ -45,8 +45,11 @@ QueryRegistryFeature::QueryRegistryFeature(application_features::ApplicationServ
       _smartJoins(true),
       _queryMemoryLimit(0),
       _maxQueryPlans(128),
+      _maxOptimizationTime(0.0),
       _slowQueryThreshold(10.0),
       _slowStreamingQueryThreshold(10.0),
+      _slowQueryCaptures(0),
+      _slowQueryCaptureNodeStats(false),
       _queryCacheMode("off"),
       _queryCacheMaxResultsCount(0),
       _queryCacheMaxResultsSize(0),
@@ -95,6 +98,24 @@ void QueryRegistryFeature::collectOptions(std::shared_ptr<ProgramOptions> option
                      "threshold for slow streaming AQL queries (in seconds)",
                      new DoubleParameter(&_slowStreamingQueryThreshold));
 
+  options->addOption("--query.slow-captures",
+                     "number of slow AQL queries per database whose execution "
+                     "plan, statistics and phase timings are kept in memory "
+                     "(0 = none)",
+                     new UInt64Parameter(&_slowQueryCaptures));
+
+  options->addOption("--query.slow-capture-node-stats",
+                     "collect per-node statistics for all AQL queries, so "
+                     "that they are included in the captures of slow queries "
+                     "(costs some throughput and turns off prefetching)",
+                     new BooleanParameter(&_slowQueryCaptureNodeStats));
+
+  options->addOption("--query.slow-capture-file",
+                     "file the captures of slow AQL queries are appended to, "
+                     "one JSON object per line (empty = keep them in memory "
+                     "only)",
+                     new StringParameter(&_slowQueryCaptureFile));
+
   options->addOption("--query.cache-mode",
                      "mode for the AQL query result cache (on, off, demand)",
                      new StringParameter(&_queryCacheMode));
@@ -123,6 +144,13 @@ void QueryRegistryFeature::collectOptions(std::shared_ptr<ProgramOptions> option
                      "maximum number of query plans to create for a query",
                      new UInt64Parameter(&_maxQueryPlans));
 
+  options->addOption("--query.optimizer-max-time",
+                     "time budget (in seconds) for creating alternative query "
+                     "plans. when it is used up, the optimizer continues only "
+                     "with the cheapest plan found so far. the chosen plan then "
+                     "depends on the server load (0 = unlimited)",
+                     new DoubleParameter(&_maxOptimizationTime));
+
   options->addOption("--query.registry-ttl",
                      "default time-to-live of cursors and query snippets (in "
                      "seconds); if <= 0, value will default to 30 for "
@@ -147,6 +175,12 @@ void QueryRegistryFeature::validateOptions(std::shared_ptr<ProgramOptions> optio
 
   // cap the value somehow. creating this many plans really does not make sense
   _maxQueryPlans = std::min(_maxQueryPlans, decltype(_maxQueryPlans)(1024));
+
+  if (_maxOptimizationTime < 0.0) {
+    _maxOptimizationTime = 0.0;
+  }
+
+  _slowQueryCaptures = std::min(_slowQueryCaptures, decltype(_slowQueryCaptures)(16384));
 }
 
 void QueryRegistryFeature::prepare() {
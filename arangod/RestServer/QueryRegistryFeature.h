@@ -54,10 +54,14 @@ class QueryRegistryFeature final : public application_features::ApplicationFeatu
   double slowStreamingQueryThreshold() const {
     return _slowStreamingQueryThreshold;
   }
+  uint64_t slowQueryCaptures() const { return _slowQueryCaptures; }
+  bool slowQueryCaptureNodeStats() const { return _slowQueryCaptureNodeStats; }
+  std::string const& slowQueryCaptureFile() const { return _slowQueryCaptureFile; }
   bool failOnWarning() const { return _failOnWarning; }
   bool smartJoins() const { return _smartJoins; }
   uint64_t queryMemoryLimit() const { return _queryMemoryLimit; }
   uint64_t maxQueryPlans() const { return _maxQueryPlans; }
+  double maxOptimizationTime() const { return _maxOptimizationTime; }
 
  private:
   bool _trackSlowQueries;
@@ -66,8 +70,12 @@ class QueryRegistryFeature final : public application_features::ApplicationFeatu
   bool _smartJoins;
   uint64_t _queryMemoryLimit;
   uint64_t _maxQueryPlans;
+  double _maxOptimizationTime;
   double _slowQueryThreshold;
   double _slowStreamingQueryThreshold;
+  uint64_t _slowQueryCaptures;
+  bool _slowQueryCaptureNodeStats;
+  std::string _slowQueryCaptureFile;
   std::string _queryCacheMode;
   uint64_t _queryCacheMaxResultsCount;
   uint64_t _queryCacheMaxResultsSize;
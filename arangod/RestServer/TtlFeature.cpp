@@ -52,7 +52,20 @@ using namespace arangodb::options;
         
 namespace {
 // the AQL query to remove documents
-std::string const removeQuery("FOR doc IN @@collection FILTER doc.@indexAttribute >= 0 && doc.@indexAttribute <= @stamp SORT doc.@indexAttribute LIMIT @limit REMOVE doc IN @@collection OPTIONS { ignoreErrors: true }");
+std::string const removeQuery("FOR doc IN @@collection FILTER doc.@indexAttribute >= @lower && doc.@indexAttribute <= @stamp SORT doc.@indexAttribute LIMIT @limit REMOVE doc IN @@collection OPTIONS { ignoreErrors: true }");
+
+// every how many runs the removal for an index starts at the beginning of
+// the index again, to also find documents that were inserted with an expiry
+// date before the position the previous runs got to
+constexpr uint64_t fullScanInterval = 10;
+
+// by how much the interval between runs is shortened while there are more
+// expired documents than one run is allowed to remove
+constexpr uint64_t backlogFrequencyDivisor = 4;
+
+// after how many runs without seeing its index the position for the index
+// is forgotten
+constexpr uint64_t cursorRetention = 100;
 }
 
 namespace arangodb {
@@ -149,6 +162,8 @@ class TtlThread final : public Thread {
   explicit TtlThread(TtlFeature* ttlFeature) 
        : Thread("TTL"), 
          _ttlFeature(ttlFeature),
+         _runs(0),
+         _backlog(false),
          _working(false) {
     TRI_ASSERT(_ttlFeature != nullptr);
   }
@@ -215,6 +230,13 @@ class TtlThread final : public Thread {
         // note: work() will do nothing if isActive() is false
         work(stats, properties);
 
+        if (_backlog) {
+          // there are more expired documents than we were allowed to remove.
+          // run again sooner to catch up with them
+          setNextStart(std::max(properties.frequency / ::backlogFrequencyDivisor,
+                                TtlProperties::minFrequency));
+        }
+
         // merge stats
         _ttlFeature->updateStats(stats);
       } catch (std::exception const& ex) {
@@ -243,6 +265,18 @@ class TtlThread final : public Thread {
     LOG_TOPIC("139af", TRACE, Logger::TTL) << "ttl thread work()";
 
     stats.runs++;
+    ++_runs;
+    _backlog = false;
+
+    // forget about the indexes we have not seen for a while, they have
+    // probably been dropped
+    for (auto it = _cursors.begin(); it != _cursors.end(); /* no hoisting */) {
+      if (_runs - it->second.seen > ::cursorRetention) {
+        it = _cursors.erase(it);
+      } else {
+        ++it;
+      }
+    }
 
     auto queryRegistryFeature =
         application_features::ApplicationServer::getFeature<QueryRegistryFeature>(
@@ -314,7 +348,18 @@ class TtlThread final : public Thread {
           }
 
           double expireAfter = ea.getNumericValue<double>();
-          LOG_TOPIC("5cca5", DEBUG, Logger::TTL) << "TTL thread going to work for collection '" << collection->name() << "', expireAfter: " << Logger::FIXED(expireAfter, 0) << ", stamp: " << (stamp - expireAfter) << ", limit: " << std::min(properties.maxCollectionRemoves, limitLeft);
+          uint64_t const limit = std::min(properties.maxCollectionRemoves, limitLeft);
+
+          // continue where the previous run for the index stopped, all
+          // expired documents before that have been removed already
+          std::string const cursorKey = std::to_string(collection->id()) + '/' + std::to_string(index->id());
+          Cursor& cursor = _cursors[cursorKey];
+          cursor.seen = _runs;
+          if (++cursor.runs % ::fullScanInterval == 0) {
+            cursor.lower = 0.0;
+          }
+
+          LOG_TOPIC("5cca5", DEBUG, Logger::TTL) << "TTL thread going to work for collection '" << collection->name() << "', expireAfter: " << Logger::FIXED(expireAfter, 0) << ", from: " << cursor.lower << ", stamp: " << (stamp - expireAfter) << ", limit: " << limit;
 
           auto bindVars = std::make_shared<VPackBuilder>();
           bindVars->openObject();
@@ -325,8 +370,9 @@ class TtlThread final : public Thread {
             bindVars->add(VPackValue(it.name));
           }
           bindVars->close();
+          bindVars->add("lower", VPackValue(cursor.lower));
           bindVars->add("stamp", VPackValue(stamp - expireAfter));
-          bindVars->add("limit", VPackValue(std::min(properties.maxCollectionRemoves, limitLeft)));
+          bindVars->add("limit", VPackValue(limit));
           bindVars->close();
 
           aql::Query query(false, *vocbase, aql::QueryString(::removeQuery), bindVars, nullptr, arangodb::aql::PART_MAIN);
@@ -349,6 +395,12 @@ class TtlThread final : public Thread {
                 v = v.get("writesExecuted");
                 if (v.isNumber()) {
                   uint64_t removed = v.getNumericValue<uint64_t>();
+                  if (removed < limit) {
+                    // all documents expired at the stamp are gone
+                    cursor.lower = stamp - expireAfter;
+                  } else {
+                    _backlog = true;
+                  }
                   stats.documentsRemoved += removed;
                   if (removed > 0) {
                     LOG_TOPIC("2455e", DEBUG, Logger::TTL) << "TTL thread removed " << removed << " documents for collection '" << collection->name() << "'";
@@ -370,6 +422,7 @@ class TtlThread final : public Thread {
         if (limitLeft == 0) {
           // removed as much as we are allowed to. now stop and remove more in next iteration
           ++stats.limitReached;
+          _backlog = true;
           return;
         }
     
@@ -392,6 +445,26 @@ class TtlThread final : public Thread {
   /// @brief a builder object we reuse to save a few memory allocations
   VPackBuilder _builder;
 
+  /// @brief position of the removal in a TTL index
+  struct Cursor {
+    // all documents expired before this stamp have been removed
+    double lower = 0.0;
+    // number of runs for the index
+    uint64_t runs = 0;
+    // the last run of the thread that has seen the index
+    uint64_t seen = 0;
+  };
+
+  /// @brief positions of the removals, by collection and index id
+  std::unordered_map<std::string, Cursor> _cursors;
+
+  /// @brief number of runs of the thread
+  uint64_t _runs;
+
+  /// @brief whether the last run left expired documents behind, because
+  /// it reached one of its limits
+  bool _backlog;
+
   /// @brief set to true while the TTL thread is actually performing deletions,
   /// false otherwise
   std::atomic<bool> _working;
@@ -68,6 +68,7 @@
 #include "GeneralServer/ServerSecurityFeature.h"
 #include "Logger/LoggerBufferFeature.h"
 #include "Logger/LoggerFeature.h"
+#include "Network/NetworkFeature.h"
 #include "Pregel/PregelFeature.h"
 #include "ProgramOptions/ProgramOptions.h"
 #include "Random/RandomFeature.h"
@@ -86,6 +87,7 @@
 #include "RestServer/InitDatabaseFeature.h"
 #include "RestServer/LanguageCheckFeature.h"
 #include "RestServer/LockfileFeature.h"
+#include "RestServer/MetricsFeature.h"
 #include "RestServer/QueryRegistryFeature.h"
 #include "RestServer/ScriptFeature.h"
 #include "RestServer/ServerFeature.h"
@@ -192,7 +194,9 @@ static int runServer(int argc, char** argv, ArangoGlobalContext& context) {
     server.addFeature(new LoggerBufferFeature(server));
     server.addFeature(new LoggerFeature(server, true));
     server.addFeature(new MaintenanceFeature(server));
+    server.addFeature(new MetricsFeature(server));
     server.addFeature(new MaxMapCountFeature(server));
+    server.addFeature(new NetworkFeature(server));
     server.addFeature(new NonceFeature(server));
     server.addFeature(new PageSizeFeature(server));
     server.addFeature(new PrivilegeFeature(server));
@@ -23,6 +23,7 @@
 #include "RocksDBBackgroundThread.h"
 #include "Basics/ConditionLocker.h"
 #include "RestServer/DatabaseFeature.h"
+#include "RocksDBEngine/RocksDBCacheWarmup.h"
 #include "RocksDBEngine/RocksDBCommon.h"
 #include "RocksDBEngine/RocksDBEngine.h"
 #include "RocksDBEngine/RocksDBReplicationManager.h"
@@ -80,6 +81,12 @@ void RocksDBBackgroundThread::run() {
       bool force = isStopping();
       _engine->replicationManager()->garbageCollect(force);
 
+      _engine->checkBulkLoad();
+
+      if (_engine->cacheWarmup() != nullptr && !isStopping()) {
+        _engine->cacheWarmup()->check();
+      }
+
       uint64_t minTick = rocksutils::latestSequenceNumber();
       auto cmTick = _engine->settingsManager()->earliestSeqNeeded();
 
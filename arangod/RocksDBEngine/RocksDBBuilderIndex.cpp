@@ -27,10 +27,13 @@
 #include "RocksDBEngine/RocksDBCollection.h"
 #include "RocksDBEngine/RocksDBColumnFamily.h"
 #include "RocksDBEngine/RocksDBCommon.h"
+#include "RocksDBEngine/RocksDBEngine.h"
 #include "RocksDBEngine/RocksDBLogValue.h"
 #include "RocksDBEngine/RocksDBMethods.h"
 #include "RocksDBEngine/RocksDBTransactionCollection.h"
 #include "RocksDBEngine/RocksDBTransactionState.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "Transaction/StandaloneContext.h"
 #include "Utils/SingleCollectionTransaction.h"
@@ -46,6 +49,9 @@
 #include <velocypack/Iterator.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include <condition_variable>
+#include <mutex>
+
 using namespace arangodb;
 using namespace arangodb::rocksutils;
 
@@ -146,18 +152,18 @@ Result RocksDBBuilderIndex::remove(transaction::Methods& trx, RocksDBMethods* mt
   return Result();  // do nothing
 }
 
-// fast mode assuming exclusive access locked from outside
+// fast mode assuming exclusive access locked from outside. indexes the
+// documents with keys in [lower, upper)
 template <typename WriteBatchType, typename MethodsType, bool foreground>
 static arangodb::Result fillIndex(RocksDBIndex& ridx, WriteBatchType& batch,
-                                  rocksdb::Snapshot const* snap) {
+                                  rocksdb::Snapshot const* snap,
+                                  rocksdb::Slice lower, rocksdb::Slice upper) {
   // fillindex can be non transactional, we just need to clean up
   rocksdb::DB* rootDB = rocksutils::globalRocksDB()->GetRootDB();
   TRI_ASSERT(rootDB != nullptr);
 
   RocksDBCollection* rcoll =
       static_cast<RocksDBCollection*>(ridx.collection().getPhysical());
-  auto bounds = RocksDBKeyBounds::CollectionDocuments(rcoll->objectId());
-  rocksdb::Slice upper(bounds.end());
 
   rocksdb::Status s;
   rocksdb::WriteOptions wo;
@@ -168,7 +174,7 @@ static arangodb::Result fillIndex(RocksDBIndex& ridx, WriteBatchType& batch,
   ro.prefix_same_as_start = true;
   ro.iterate_upper_bound = &upper;
 
-  rocksdb::ColumnFamilyHandle* docCF = RocksDBColumnFamily::documents();
+  rocksdb::ColumnFamilyHandle* docCF = rcoll->documentsColumnFamily();
   std::unique_ptr<rocksdb::Iterator> it(rootDB->NewIterator(ro, docCF));
 
   auto mode = snap == nullptr ? AccessMode::Type::EXCLUSIVE : AccessMode::Type::WRITE;
@@ -220,7 +226,7 @@ static arangodb::Result fillIndex(RocksDBIndex& ridx, WriteBatchType& batch,
     }
   };
 
-  for (it->Seek(bounds.start()); it->Valid(); it->Next()) {
+  for (it->Seek(lower); it->Valid(); it->Next()) {
     TRI_ASSERT(it->key().compare(upper) < 0);
     if (application_features::ApplicationServer::isStopping()) {
       res.reset(TRI_ERROR_SHUTTING_DOWN);
@@ -265,6 +271,183 @@ static arangodb::Result fillIndex(RocksDBIndex& ridx, WriteBatchType& batch,
   return res;
 }
 
+template <typename WriteBatchType, typename MethodsType, bool foreground>
+static arangodb::Result fillIndex(RocksDBIndex& ridx, WriteBatchType& batch,
+                                  rocksdb::Snapshot const* snap) {
+  RocksDBCollection* rcoll =
+      static_cast<RocksDBCollection*>(ridx.collection().getPhysical());
+  auto bounds = RocksDBKeyBounds::CollectionDocuments(rcoll->objectId());
+  return fillIndex<WriteBatchType, MethodsType, foreground>(ridx, batch, snap,
+                                                            bounds.start(),
+                                                            bounds.end());
+}
+
+namespace {
+/// @brief number of threads to fill the index with. only non-unique vpack
+/// indexes are filled in parallel: the threads would not see each other's
+/// keys when checking unique constraints, and the other index types keep
+/// state outside of RocksDB that is not prepared for concurrent inserts
+size_t fillParallelism(RocksDBIndex const& ridx) {
+  if (ridx.unique()) {
+    return 1;
+  }
+  switch (ridx.type()) {
+    case Index::TRI_IDX_TYPE_HASH_INDEX:
+    case Index::TRI_IDX_TYPE_SKIPLIST_INDEX:
+    case Index::TRI_IDX_TYPE_PERSISTENT_INDEX:
+    case Index::TRI_IDX_TYPE_TTL_INDEX:
+      break;
+    default:
+      return 1;
+  }
+  RocksDBEngine* engine = rocksutils::globalRocksEngine();
+  return std::max<size_t>(engine->indexBuildThreads(), 1);
+}
+
+/// @brief state shared by the threads filling an index in parallel. the
+/// documents are split into ranges that are claimed one after the other.
+/// it is owned jointly, so jobs that only start after the fill is over can
+/// still see that they have nothing to do
+struct ParallelFill {
+  struct Range {
+    std::string lower;
+    std::string upper;
+  };
+
+  ParallelFill(RocksDBIndex& ridx, rocksdb::Snapshot const* snap)
+      : ridx(ridx), snap(snap) {}
+
+  RocksDBIndex& ridx;
+  rocksdb::Snapshot const* snap;
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<Range> ranges;
+  size_t next = 0;
+  /// @brief number of threads currently filling
+  size_t running = 0;
+  /// @brief set by the initiating thread once the fill is over
+  bool finished = false;
+  Result result;
+
+  /// @brief split the documents of the collection into ranges of about
+  /// the same number of document ids
+  void split(size_t parallelism) {
+    RocksDBCollection* rcoll =
+        static_cast<RocksDBCollection*>(ridx.collection().getPhysical());
+    auto bounds = RocksDBKeyBounds::CollectionDocuments(rcoll->objectId());
+    rocksdb::Slice end = bounds.end();
+
+    rocksdb::ReadOptions ro(/*cksum*/ false, /*cache*/ false);
+    ro.snapshot = snap;
+    ro.prefix_same_as_start = true;
+    ro.iterate_upper_bound = &end;
+    rocksdb::DB* rootDB = rocksutils::globalRocksDB()->GetRootDB();
+    std::unique_ptr<rocksdb::Iterator> it(
+        rootDB->NewIterator(ro, rcoll->documentsColumnFamily()));
+
+    // the split points are computed on the bytes of the document id, so the
+    // ranges cover the key space no matter the endianess
+    it->Seek(bounds.start());
+    if (!it->Valid()) {
+      return;
+    }
+    TRI_ASSERT(it->key().size() == 2 * sizeof(uint64_t));
+    std::string prefix(it->key().data(), sizeof(uint64_t));
+    uint64_t const first = rocksutils::uintFromPersistentBigEndian<uint64_t>(
+        it->key().data() + sizeof(uint64_t));
+    it->SeekForPrev(bounds.end());
+    TRI_ASSERT(it->Valid());
+    uint64_t const last = rocksutils::uintFromPersistentBigEndian<uint64_t>(
+        it->key().data() + sizeof(uint64_t));
+    TRI_ASSERT(first <= last);
+
+    // more ranges than threads, so that threads finishing early can help
+    uint64_t const step = (last - first) / (4 * parallelism) + 1;
+    uint64_t lower = first;
+    while (true) {
+      Range range;
+      range.lower = prefix;
+      rocksutils::uintToPersistentBigEndian<uint64_t>(range.lower, lower);
+      bool const isLast = (last - lower < step);
+      if (isLast) {
+        range.upper.assign(end.data(), end.size());
+      } else {
+        lower += step;
+        range.upper = prefix;
+        rocksutils::uintToPersistentBigEndian<uint64_t>(range.upper, lower);
+      }
+      ranges.emplace_back(std::move(range));
+      if (isLast) {
+        break;
+      }
+    }
+  }
+
+  /// @brief fill ranges until there are none left. jobs from the scheduler
+  /// must not touch the index anymore once the initiating thread is done
+  template <bool foreground>
+  static void work(std::shared_ptr<ParallelFill> const& shared, bool initiator) {
+    std::unique_lock<std::mutex> guard(shared->mutex);
+    if (shared->finished && !initiator) {
+      return;
+    }
+    ++shared->running;
+
+    while (shared->result.ok() && shared->next < shared->ranges.size()) {
+      Range const& range = shared->ranges[shared->next++];
+      guard.unlock();
+
+      Result res;
+      try {
+        // non-unique index. all index keys will be unique anyway because they
+        // contain the document id we can therefore get away with a cheap WriteBatch
+        rocksdb::WriteBatch batch(32 * 1024 * 1024);
+        res = ::fillIndex<rocksdb::WriteBatch, RocksDBBatchedMethods, foreground>(
+            shared->ridx, batch, shared->snap, range.lower, range.upper);
+      } catch (basics::Exception const& ex) {
+        res.reset(ex.code(), ex.what());
+      } catch (std::exception const& ex) {
+        res.reset(TRI_ERROR_INTERNAL, ex.what());
+      }
+
+      guard.lock();
+      if (res.fail() && shared->result.ok()) {
+        shared->result = res;
+      }
+    }
+
+    --shared->running;
+    shared->cv.notify_all();
+  }
+};
+
+/// @brief fill a non-unique index from several threads. the calling thread
+/// takes part, so the fill completes even if the scheduler is busy
+template <bool foreground>
+Result fillIndexParallel(RocksDBIndex& ridx, rocksdb::Snapshot const* snap,
+                         size_t parallelism) {
+  auto shared = std::make_shared<ParallelFill>(ridx, snap);
+  shared->split(parallelism);
+
+  auto* scheduler = SchedulerFeature::SCHEDULER;
+  if (scheduler != nullptr) {
+    size_t const jobs = std::min(parallelism, shared->ranges.size());
+    for (size_t i = 1; i < jobs; ++i) {
+      scheduler->queue(RequestLane::INTERNAL_LOW, [shared]() {
+        ParallelFill::work<foreground>(shared, false);
+      });
+    }
+  }
+  ParallelFill::work<foreground>(shared, true);
+
+  std::unique_lock<std::mutex> guard(shared->mutex);
+  shared->finished = true;
+  shared->cv.wait(guard, [&shared]() { return shared->running == 0; });
+  return shared->result;
+}
+}  // namespace
+
 arangodb::Result RocksDBBuilderIndex::fillIndexForeground() {
   RocksDBIndex* internal = _wrapped.get();
   TRI_ASSERT(internal != nullptr);
@@ -272,7 +455,10 @@ arangodb::Result RocksDBBuilderIndex::fillIndexForeground() {
   const rocksdb::Snapshot* snap = nullptr;
 
   Result res;
-  if (this->unique()) {
+  size_t const parallelism = ::fillParallelism(*internal);
+  if (parallelism > 1) {
+    res = ::fillIndexParallel<true>(*internal, snap, parallelism);
+  } else if (this->unique()) {
     const rocksdb::Comparator* cmp = internal->columnFamily()->GetComparator();
     // unique index. we need to keep track of all our changes because we need to
     // avoid duplicate index keys. must therefore use a WriteBatchWithIndex
@@ -351,7 +537,7 @@ struct ReplayHandler final : public rocksdb::WriteBatch::Handler {
     incTick();
     if (column_family_id == RocksDBColumnFamily::definitions()->GetID()) {
       _lastObjectID = 0;
-    } else if (column_family_id == RocksDBColumnFamily::documents()->GetID()) {
+    } else if (RocksDBColumnFamily::isDocuments(column_family_id)) {
       _lastObjectID = RocksDBKey::objectId(key);
     }
 
@@ -362,7 +548,7 @@ struct ReplayHandler final : public rocksdb::WriteBatch::Handler {
     incTick();
     if (column_family_id == RocksDBColumnFamily::definitions()->GetID()) {
       _lastObjectID = 0;
-    } else if (column_family_id == RocksDBColumnFamily::documents()->GetID()) {
+    } else if (RocksDBColumnFamily::isDocuments(column_family_id)) {
       _lastObjectID = RocksDBKey::objectId(key);
     }
     return rocksdb::Status();
@@ -372,7 +558,7 @@ struct ReplayHandler final : public rocksdb::WriteBatch::Handler {
     incTick();
     if (column_family_id == RocksDBColumnFamily::definitions()->GetID()) {
       _lastObjectID = 0;
-    } else if (column_family_id == RocksDBColumnFamily::documents()->GetID()) {
+    } else if (RocksDBColumnFamily::isDocuments(column_family_id)) {
       _lastObjectID = RocksDBKey::objectId(key);
     }
     return rocksdb::Status();
@@ -552,7 +738,10 @@ arangodb::Result RocksDBBuilderIndex::fillIndexBackground(Locker& locker) {
 
   locker.unlock();
   // Step 1. Capture with snapshot
-  if (internal->unique()) {
+  size_t const parallelism = ::fillParallelism(*internal);
+  if (parallelism > 1) {
+    res = ::fillIndexParallel<false>(*internal, snap, parallelism);
+  } else if (internal->unique()) {
     const rocksdb::Comparator* cmp = internal->columnFamily()->GetComparator();
     // unique index. we need to keep track of all our changes because we need to
     // avoid duplicate index keys. must therefore use a WriteBatchWithIndex
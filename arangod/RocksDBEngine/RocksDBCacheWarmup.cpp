@@ -0,0 +1,229 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "RocksDBCacheWarmup.h"
+#include "ApplicationFeatures/ApplicationServer.h"
+#include "Basics/FileUtils.h"
+#include "Basics/ScopeGuard.h"
+#include "Basics/StringUtils.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Basics/system-functions.h"
+#include "Logger/Logger.h"
+#include "RestServer/BootstrapFeature.h"
+#include "RestServer/DatabaseFeature.h"
+#include "RocksDBEngine/RocksDBCommon.h"
+#include "RocksDBEngine/RocksDBEngine.h"
+#include "RocksDBEngine/RocksDBIndex.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
+#include "Transaction/StandaloneContext.h"
+#include "Utils/SingleCollectionTransaction.h"
+#include "VocBase/LogicalCollection.h"
+#include "VocBase/vocbase.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <chrono>
+#include <thread>
+
+using namespace arangodb;
+
+RocksDBCacheWarmup::RocksDBCacheWarmup(std::string const& filename,
+                                       size_t maxValuesPerIndex, double saveInterval)
+    : _filename(filename),
+      _maxValuesPerIndex(maxValuesPerIndex),
+      _saveInterval(saveInterval),
+      _lastSave(0.0),
+      _loadStarted(false),
+      _loadDone(false) {}
+
+void RocksDBCacheWarmup::check() {
+  if (!_loadStarted) {
+    // only start filling the caches once the server is ready for business, so
+    // the warmup does not delay the startup
+    auto bootstrap = application_features::ApplicationServer::lookupFeature<BootstrapFeature>();
+    auto* scheduler = SchedulerFeature::SCHEDULER;
+    if (bootstrap == nullptr || !bootstrap->isReady() || scheduler == nullptr) {
+      return;
+    }
+
+    auto self = shared_from_this();
+    _loadStarted = scheduler->queue(RequestLane::INTERNAL_LOW, [self]() {
+      Result res = self->load();
+      if (res.fail()) {
+        LOG_TOPIC("3f9a1", WARN, Logger::ENGINES)
+            << "cache warmup failed: " << res.errorMessage();
+      }
+      self->_loadDone.store(true);
+    });
+    _lastSave = TRI_microtime();
+    return;
+  }
+
+  if (!_loadDone.load()) {
+    // do not overwrite the file with the contents of the still cold caches
+    return;
+  }
+
+  double now = TRI_microtime();
+  if (now - _lastSave < _saveInterval) {
+    return;
+  }
+  _lastSave = now;
+
+  Result res = save();
+  if (res.fail()) {
+    LOG_TOPIC("b07c4", WARN, Logger::ENGINES)
+        << "saving the hot cache entries failed: " << res.errorMessage();
+  }
+}
+
+Result RocksDBCacheWarmup::save() {
+  if (DatabaseFeature::DATABASE == nullptr) {
+    return Result();
+  }
+
+  VPackBuilder builder;
+  builder.openObject();
+  DatabaseFeature::DATABASE->enumerateDatabases([&](TRI_vocbase_t& vocbase) -> void {
+    vocbase.processCollections(
+        [&](LogicalCollection* collection) -> void {
+          for (auto const& index : collection->getIndexes()) {
+            auto* rocksIndex = dynamic_cast<RocksDBIndex*>(index.get());
+            if (rocksIndex == nullptr) {
+              continue;
+            }
+            auto values = rocksIndex->cachedLookupValues(_maxValuesPerIndex);
+            if (values.empty()) {
+              continue;
+            }
+            builder.add(VPackValue(std::to_string(rocksIndex->objectId())));
+            builder.openArray();
+            for (auto const& value : values) {
+              builder.add(VPackValue(value));
+            }
+            builder.close();
+          }
+        },
+        false);
+  });
+  builder.close();
+
+  if (!basics::VelocyPackHelper::velocyPackToFile(_filename, builder.slice(), false)) {
+    return Result(TRI_ERROR_CANNOT_WRITE_FILE,
+                  "cannot write cache warmup file '" + _filename + "'");
+  }
+  return Result();
+}
+
+Result RocksDBCacheWarmup::load() {
+  if (!basics::FileUtils::exists(_filename) || DatabaseFeature::DATABASE == nullptr) {
+    return Result();
+  }
+
+  VPackBuilder builder;
+  try {
+    builder = basics::VelocyPackHelper::velocyPackFromFile(_filename);
+  } catch (...) {
+    return Result(TRI_ERROR_CANNOT_READ_FILE,
+                  "cannot read cache warmup file '" + _filename + "'");
+  }
+  VPackSlice root = builder.slice();
+  if (!root.isObject()) {
+    return Result(TRI_ERROR_BAD_PARAMETER,
+                  "invalid cache warmup file '" + _filename + "'");
+  }
+
+  RocksDBEngine* engine = rocksutils::globalRocksEngine();
+  double start = TRI_microtime();
+  size_t loaded = 0;
+
+  for (auto it : VPackObjectIterator(root)) {
+    if (application_features::ApplicationServer::isStopping()) {
+      break;
+    }
+    if (!it.value.isArray()) {
+      continue;
+    }
+
+    uint64_t objectId = basics::StringUtils::uint64(it.key.copyString());
+    auto triple = engine->mapObjectToIndex(objectId);
+    if (std::get<0>(triple) == 0 && std::get<1>(triple) == 0) {
+      // index was dropped in the meantime
+      continue;
+    }
+    TRI_vocbase_t* vocbase = DatabaseFeature::DATABASE->useDatabase(std::get<0>(triple));
+    if (vocbase == nullptr) {
+      continue;
+    }
+    TRI_DEFER(vocbase->release());
+    auto collection = vocbase->lookupCollection(std::get<1>(triple));
+    if (collection == nullptr) {
+      continue;
+    }
+    auto index = collection->lookupIndex(std::get<2>(triple));
+    auto* rocksIndex = dynamic_cast<RocksDBIndex*>(index.get());
+    if (rocksIndex == nullptr) {
+      continue;
+    }
+
+    std::vector<std::string> values;
+    auto warmup = [&]() -> Result {
+      SingleCollectionTransaction trx(transaction::StandaloneContext::Create(*vocbase),
+                                      *collection, AccessMode::Type::READ);
+      Result res = trx.begin();
+      if (res.ok()) {
+        rocksIndex->warmupCache(&trx, values);
+        res = trx.commit();
+      }
+      loaded += values.size();
+      values.clear();
+      // give the actual workload some room
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      return res;
+    };
+
+    for (VPackSlice value : VPackArrayIterator(it.value)) {
+      if (value.isString()) {
+        values.emplace_back(value.copyString());
+      }
+      if (values.size() >= batchSize) {
+        Result res = warmup();
+        if (res.fail()) {
+          return res;
+        }
+      }
+    }
+    if (!values.empty()) {
+      Result res = warmup();
+      if (res.fail()) {
+        return res;
+      }
+    }
+  }
+
+  LOG_TOPIC("e6d25", INFO, Logger::ENGINES)
+      << "filled index caches with " << loaded << " entries in "
+      << Logger::FIXED(TRI_microtime() - start, 3) << " s";
+  return Result();
+}
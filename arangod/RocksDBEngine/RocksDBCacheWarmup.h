@@ -0,0 +1,69 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef ARANGOD_ROCKSDB_ENGINE_ROCKSDB_CACHE_WARMUP_H
+#define ARANGOD_ROCKSDB_ENGINE_ROCKSDB_CACHE_WARMUP_H 1
+
+#include "Basics/Common.h"
+#include "Basics/Result.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+namespace arangodb {
+
+/// @brief remembers the hot entries of the index caches across restarts.
+/// the lookup values of the entries currently in the caches are periodically
+/// written to a file, as an object mapping the index object id to an array
+/// of values. after a restart, once the server is ready for business, the
+/// caches are filled again from this file in the background
+class RocksDBCacheWarmup : public std::enable_shared_from_this<RocksDBCacheWarmup> {
+ public:
+  RocksDBCacheWarmup(std::string const& filename, size_t maxValuesPerIndex,
+                     double saveInterval);
+
+  /// @brief called periodically by the background thread. starts the
+  /// warmup once the server is ready, and saves the hot entries afterwards
+  void check();
+
+  /// @brief writes the lookup values of all index caches to the file
+  Result save();
+
+  /// @brief fills the index caches from the file
+  Result load();
+
+ private:
+  /// @brief number of values looked up per transaction, after which the
+  /// warmup pauses briefly so it does not saturate the disk
+  static constexpr size_t batchSize = 1000;
+
+  std::string const _filename;
+  size_t const _maxValuesPerIndex;
+  double const _saveInterval;
+  double _lastSave;
+  bool _loadStarted;
+  std::atomic<bool> _loadDone;
+};
+
+}  // namespace arangodb
+
+#endif
@@ -37,6 +37,7 @@
 #include "RestServer/DatabaseFeature.h"
 #include "RocksDBCollection.h"
 #include "RocksDBEngine/RocksDBBuilderIndex.h"
+#include "RocksDBEngine/RocksDBColumnFamily.h"
 #include "RocksDBEngine/RocksDBCommon.h"
 #include "RocksDBEngine/RocksDBComparator.h"
 #include "RocksDBEngine/RocksDBEngine.h"
@@ -54,6 +55,7 @@
 #include "Utils/CollectionNameResolver.h"
 #include "Utils/Events.h"
 #include "Utils/OperationOptions.h"
+#include "VocBase/CollectionStatistics.h"
 #include "VocBase/KeyGenerator.h"
 #include "VocBase/LocalDocumentId.h"
 #include "VocBase/LogicalCollection.h"
@@ -66,6 +68,8 @@
 #include <velocypack/Iterator.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include <algorithm>
+
 using namespace arangodb;
 
 RocksDBCollection::RocksDBCollection(LogicalCollection& collection,
@@ -81,6 +85,8 @@ RocksDBCollection::RocksDBCollection(LogicalCollection& collection,
           !collection.system() &&
           basics::VelocyPackHelper::readBooleanValue(info, "cacheEnabled", false) &&
           CacheManagerFeature::MANAGER != nullptr),
+      _storageClass(RocksDBColumnFamily::storageClassFromString(
+          basics::VelocyPackHelper::getStringValue(info, "storageClass", ""))),
       _numIndexCreations(0) {
   TRI_ASSERT(!ServerState::instance()->isCoordinator());
   VPackSlice s = info.get("isVolatile");
@@ -93,6 +99,7 @@ RocksDBCollection::RocksDBCollection(LogicalCollection& collection,
   TRI_ASSERT(_logicalCollection.isAStub() || _objectId != 0);
   rocksutils::globalRocksEngine()->addCollectionMapping(
       _objectId, _logicalCollection.vocbase().id(), _logicalCollection.id());
+  RocksDBColumnFamily::setStorageClass(_objectId, _storageClass);
 
   if (_cacheEnabled) {
     createCache();
@@ -110,6 +117,7 @@ RocksDBCollection::RocksDBCollection(LogicalCollection& collection,
       _cachePresent(false),
       _cacheEnabled(static_cast<RocksDBCollection const*>(physical)->_cacheEnabled &&
                     CacheManagerFeature::MANAGER != nullptr),
+      _storageClass(static_cast<RocksDBCollection const*>(physical)->_storageClass),
       _numIndexCreations(0) {
   TRI_ASSERT(!ServerState::instance()->isCoordinator());
   rocksutils::globalRocksEngine()->addCollectionMapping(
@@ -140,6 +148,13 @@ void RocksDBCollection::setPath(std::string const&) {
 Result RocksDBCollection::updateProperties(VPackSlice const& slice, bool doSync) {
   auto isSys = _logicalCollection.system();
 
+  VPackSlice storageClass = slice.get("storageClass");
+  if (storageClass.isString() &&
+      RocksDBColumnFamily::storageClassFromString(storageClass.copyString()) != _storageClass) {
+    return Result(TRI_ERROR_BAD_PARAMETER,
+                  "storageClass option cannot be changed at runtime");
+  }
+
   _cacheEnabled =
       !isSys &&
       basics::VelocyPackHelper::readBooleanValue(slice, "cacheEnabled", _cacheEnabled) &&
@@ -175,6 +190,7 @@ void RocksDBCollection::getPropertiesVPack(velocypack::Builder& result) const {
   TRI_ASSERT(result.isOpenObject());
   result.add("objectId", VPackValue(std::to_string(_objectId)));
   result.add("cacheEnabled", VPackValue(_cacheEnabled));
+  result.add("storageClass", VPackValue(RocksDBColumnFamily::storageClassName(_storageClass)));
   TRI_ASSERT(result.isOpenObject());
 }
 
@@ -246,6 +262,30 @@ void RocksDBCollection::open(bool /*ignoreErrors*/) {
   TRI_ASSERT(_objectId != 0);
 }
 
+Result RocksDBCollection::setStatistics(std::shared_ptr<CollectionStatistics const> statistics) {
+  RocksDBKey key;
+  key.constructCollectionStatisticsValue(_objectId);
+  rocksdb::WriteOptions wo;
+  rocksdb::Status s;
+  if (statistics == nullptr) {
+    s = rocksutils::globalRocksDB()->Delete(wo, RocksDBColumnFamily::definitions(),
+                                            key.string());
+  } else {
+    VPackBuilder builder;
+    statistics->toVelocyPack(builder);
+    RocksDBValue value = RocksDBValue::CollectionStatisticsValue(builder.slice());
+    s = rocksutils::globalRocksDB()->Put(wo, RocksDBColumnFamily::definitions(),
+                                         key.string(), value.string());
+  }
+  if (!s.ok()) {
+    LOG_TOPIC("a0e38", WARN, Logger::ENGINES)
+        << "writing statistics of collection '" << _logicalCollection.name()
+        << "' failed: " << s.ToString();
+    return rocksutils::convertStatus(s);
+  }
+  return PhysicalCollection::setStatistics(std::move(statistics));
+}
+
 void RocksDBCollection::prepareIndexes(arangodb::velocypack::Slice indexesSlice) {
   TRI_ASSERT(indexesSlice.isArray());
 
@@ -444,9 +484,7 @@ std::shared_ptr<Index> RocksDBCollection::createIndex(VPackSlice const& info,
       _indexes.push_back(idx);
     }
     guard.unlock();
-#if USE_PLAN_CACHE
-    arangodb::aql::PlanCache::instance()->invalidate(_logicalCollection.vocbase());
-#endif
+    arangodb::aql::PlanCache::instance()->invalidate(&_logicalCollection.vocbase());
 
     // inBackground index might not recover selectivity estimate w/o sync
     if (inBackground && !idx->unique() && idx->hasSelectivityEstimate()) {
@@ -562,6 +600,17 @@ std::unique_ptr<IndexIterator> RocksDBCollection::getAnyIterator(transaction::Me
   return std::make_unique<RocksDBAnyIndexIterator>(&_logicalCollection, trx);
 }
 
+std::unique_ptr<IndexIterator> RocksDBCollection::getParallelAllIterator(transaction::Methods* trx,
+                                                                         size_t parallelism) const {
+  // parallel iterators all read from the transaction's snapshot, so they
+  // would not see the transaction's own writes
+  if (parallelism <= 1 || !trx->state()->isReadOnlyTransaction()) {
+    return getAllIterator(trx);
+  }
+  return std::make_unique<RocksDBParallelAllIndexIterator>(&_logicalCollection, trx,
+                                                           parallelism);
+}
+
 void RocksDBCollection::invokeOnAllElements(transaction::Methods* trx,
                                             std::function<bool(LocalDocumentId const&)> callback) {
   std::unique_ptr<IndexIterator> cursor(this->getAllIterator(trx));
@@ -676,7 +725,7 @@ Result RocksDBCollection::truncate(transaction::Methods& trx, OperationOptions&
 
   // normal transactional truncate
   RocksDBKeyBounds documentBounds = RocksDBKeyBounds::CollectionDocuments(_objectId);
-  rocksdb::Comparator const* cmp = RocksDBColumnFamily::documents()->GetComparator();
+  rocksdb::Comparator const* cmp = documentsColumnFamily()->GetComparator();
   rocksdb::ReadOptions ro = mthds->iteratorReadOptions();
   rocksdb::Slice const end = documentBounds.end();
   ro.iterate_upper_bound = &end;
@@ -764,6 +813,12 @@ LocalDocumentId RocksDBCollection::lookupKey(transaction::Methods* trx,
   return primaryIndex()->lookupKey(trx, arangodb::velocypack::StringRef(key));
 }
 
+void RocksDBCollection::lookupKeys(transaction::Methods* trx,
+                                   std::vector<VPackSlice> const& keys,
+                                   std::vector<LocalDocumentId>& result) const {
+  primaryIndex()->lookupKeys(trx, keys, result);
+}
+
 bool RocksDBCollection::lookupRevision(transaction::Methods* trx, VPackSlice const& key,
                                        TRI_voc_rid_t& revisionId) const {
   TRI_ASSERT(key.isString());
@@ -813,6 +868,54 @@ Result RocksDBCollection::read(transaction::Methods* trx,
   return res;
 }
 
+/// @brief read a document without a transaction. the primary index and the
+/// document are read without a common snapshot, so a concurrent replace or
+/// remove can make the document vanish in between. the lookup is repeated
+/// a few times in this case, and then left to a regular transaction
+Result RocksDBCollection::readLatestCommitted(arangodb::velocypack::StringRef const& key,
+                                              ManagedDocumentResult& result) const {
+  TRI_ASSERT(_objectId != 0);
+
+  for (int attempt = 0; attempt < 3; ++attempt) {
+    LocalDocumentId const documentId = primaryIndex()->lookupKeyLatestCommitted(key);
+    if (!documentId.isSet()) {
+      return Result(TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND);
+    }
+
+    RocksDBKey docKey;
+    docKey.constructDocument(_objectId, documentId);
+
+    if (useCache()) {
+      TRI_ASSERT(_cache != nullptr);
+      auto f = _cache->find(docKey.string().data(),
+                            static_cast<uint32_t>(docKey.string().size()));
+      if (f.found()) {
+        result.setManaged(reinterpret_cast<uint8_t const*>(f.value()->value()));
+        result.setRevisionId();
+        return Result();
+      }
+    }
+
+    std::string* buffer = result.setManaged();
+    rocksdb::PinnableSlice ps(buffer);
+    rocksdb::Status s = rocksutils::globalRocksDB()->Get(rocksdb::ReadOptions(),
+                                                         documentsColumnFamily(),
+                                                         docKey.string(), &ps);
+    if (s.ok()) {
+      if (ps.IsPinned()) {
+        buffer->assign(ps.data(), ps.size());
+      }  // else value is already assigned
+      result.setRevisionId();  // extracts id from buffer
+      return Result();
+    }
+    if (!s.IsNotFound()) {
+      return rocksutils::convertStatus(s, rocksutils::document);
+    }
+  }
+
+  return Result(TRI_ERROR_NOT_IMPLEMENTED);
+}
+
 // read using a token!
 bool RocksDBCollection::readDocument(transaction::Methods* trx,
                                      LocalDocumentId const& documentId,
@@ -841,6 +944,131 @@ bool RocksDBCollection::readDocumentWithCallback(transaction::Methods* trx,
   return false;
 }
 
+size_t RocksDBCollection::readMultiple(transaction::Methods* trx,
+                                       std::vector<LocalDocumentId> const& documentIds,
+                                       IndexIterator::DocumentCallback const& cb) const {
+  TRI_ASSERT(trx->state()->isRunning());
+  TRI_ASSERT(_objectId != 0);
+
+  if (documentIds.size() <= 1) {
+    // nothing to batch
+    size_t found = 0;
+    for (auto const& documentId : documentIds) {
+      if (readDocumentWithCallback(trx, documentId, cb)) {
+        ++found;
+      }
+    }
+    return found;
+  }
+
+  RocksDBMethods* mthd = RocksDBTransactionState::toMethods(trx);
+  rocksdb::ColumnFamilyHandle* cf = documentsColumnFamily();
+  return readMultiple(_objectId, useCache() ? _cache.get() : nullptr, documentIds,
+                      [mthd, cf](std::vector<rocksdb::Slice> const& keys,
+                                 std::vector<std::string>* values) {
+                        return mthd->MultiGet(cf, keys, values);
+                      },
+                      cb);
+}
+
+size_t RocksDBCollection::readMultiple(uint64_t objectId, cache::Cache* cache,
+                                       std::vector<LocalDocumentId> const& documentIds,
+                                       MultiGetFunction const& multiGet,
+                                       IndexIterator::DocumentCallback const& cb) {
+  bool const withCache = cache != nullptr;
+  bool lockTimeout = false;
+
+  // documents found in the cache are copied, so that all documents can be
+  // returned in the order of the ids
+  std::vector<std::string> values(documentIds.size());
+  std::vector<bool> found(documentIds.size(), false);
+  std::vector<RocksDBKey> keys;
+  keys.reserve(documentIds.size());
+  std::vector<size_t> lookupPositions;
+
+  for (size_t i = 0; i < documentIds.size(); ++i) {
+    keys.emplace_back();
+    if (!documentIds[i].isSet()) {
+      continue;
+    }
+    RocksDBKey& key = keys.back();
+    key.constructDocument(objectId, documentIds[i]);
+
+    if (withCache) {
+      auto f = cache->find(key.string().data(), static_cast<uint32_t>(key.string().size()));
+      if (f.found()) {
+        values[i].assign(reinterpret_cast<char const*>(f.value()->value()),
+                         f.value()->valueSize());
+        found[i] = true;
+        continue;
+      }
+      if (f.result().errorNumber() == TRI_ERROR_LOCK_TIMEOUT) {
+        lockTimeout = true;
+      }
+    }
+    lookupPositions.emplace_back(i);
+  }
+
+  // reading the documents in the order of their keys touches every block
+  // only once
+  std::sort(lookupPositions.begin(), lookupPositions.end(), [&keys](size_t lhs, size_t rhs) {
+    return keys[lhs].string().compare(keys[rhs].string()) < 0;
+  });
+  std::vector<rocksdb::Slice> lookupKeys;
+  lookupKeys.reserve(lookupPositions.size());
+  for (size_t i : lookupPositions) {
+    lookupKeys.emplace_back(keys[i].string());
+  }
+
+  if (!lookupKeys.empty()) {
+    std::vector<std::string> lookupValues;
+    std::vector<rocksdb::Status> statuses = multiGet(lookupKeys, &lookupValues);
+    TRI_ASSERT(statuses.size() == lookupKeys.size());
+    TRI_ASSERT(lookupValues.size() == lookupKeys.size());
+
+    for (size_t j = 0; j < lookupKeys.size(); ++j) {
+      size_t const i = lookupPositions[j];
+      if (!statuses[j].ok()) {
+        continue;
+      }
+      values[i] = std::move(lookupValues[j]);
+      found[i] = true;
+
+      if (withCache && !lockTimeout) {
+        // write entry back to cache
+        auto entry = cache::CachedValue::construct(lookupKeys[j].data(),
+                                                   static_cast<uint32_t>(lookupKeys[j].size()),
+                                                   values[i].data(),
+                                                   static_cast<uint64_t>(values[i].size()));
+        if (entry) {
+          auto status = cache->insert(entry);
+          if (status.fail()) {
+            delete entry;
+          }
+        }
+      }
+    }
+  }
+
+  size_t numFound = 0;
+  for (size_t i = 0; i < documentIds.size(); ++i) {
+    if (found[i]) {
+      TRI_ASSERT(!values[i].empty());
+      cb(documentIds[i], VPackSlice(reinterpret_cast<uint8_t const*>(values[i].data())));
+      ++numFound;
+    }
+  }
+  return numFound;
+}
+
+size_t RocksDBCollection::readMultipleKeys(transaction::Methods* trx,
+                                           std::vector<VPackSlice> const& keys,
+                                           IndexIterator::DocumentCallback const& cb) const {
+  std::vector<LocalDocumentId> documentIds;
+  primaryIndex()->lookupKeys(trx, keys, documentIds);
+  return readMultiple(trx, documentIds, cb);
+}
+
 Result RocksDBCollection::insert(arangodb::transaction::Methods* trx,
                                  arangodb::velocypack::Slice const slice,
                                  arangodb::ManagedDocumentResult& resultMdr,
@@ -983,7 +1211,8 @@ Result RocksDBCollection::update(arangodb::transaction::Methods* trx,
   transaction::BuilderLeaser builder(trx);
   res = mergeObjectsForUpdate(trx, oldDoc, newSlice, isEdgeCollection,
                               options.mergeObjects, options.keepNull,
-                              *builder.get(), options.isRestore, revisionId);
+                              *builder.get(), options.isRestore, revisionId,
+                              options.incrementNumbers);
   if (res.fail()) {
     return res;
   }
@@ -1229,7 +1458,7 @@ void RocksDBCollection::figuresSpecific(std::shared_ptr<arangodb::velocypack::Bu
   rocksdb::Range r(bounds.start(), bounds.end());
 
   uint64_t out = 0;
-  db->GetApproximateSizes(RocksDBColumnFamily::documents(), &r, 1, &out,
+  db->GetApproximateSizes(documentsColumnFamily(), &r, 1, &out,
                           static_cast<uint8_t>(
                               rocksdb::DB::SizeApproximationFlags::INCLUDE_MEMTABLES |
                               rocksdb::DB::SizeApproximationFlags::INCLUDE_FILES));
@@ -1247,6 +1476,12 @@ void RocksDBCollection::figuresSpecific(std::shared_ptr<arangodb::velocypack::Bu
     rate = hitRates.second;
     rate = std::isnan(rate) ? 0.0 : rate;
     builder->add("cacheWindowedHitRate", VPackValue(rate));
+    auto stats = _cache->statistics();
+    builder->add("cacheHits", VPackValue(stats.findHits));
+    builder->add("cacheMisses", VPackValue(stats.findMisses));
+    builder->add("cacheInserts", VPackValue(stats.inserts));
+    builder->add("cacheEvictions", VPackValue(stats.evictions));
+    builder->add("cacheInsertRejections", VPackValue(stats.insertRejections));
   } else {
     builder->add("cacheSize", VPackValue(0));
     builder->add("cacheUsage", VPackValue(0));
@@ -1277,7 +1512,7 @@ Result RocksDBCollection::insertDocument(arangodb::transaction::Methods* trx,
 
   TRI_ASSERT(key->containsLocalDocumentId(documentId));
   rocksdb::Status s =
-      mthds->PutUntracked(RocksDBColumnFamily::documents(), key.ref(),
+      mthds->PutUntracked(documentsColumnFamily(), key.ref(),
                           rocksdb::Slice(doc.startAs<char>(),
                                          static_cast<size_t>(doc.byteSize())));
   if (!s.ok()) {
@@ -1317,7 +1552,7 @@ Result RocksDBCollection::removeDocument(arangodb::transaction::Methods* trx,
   // disable indexing in this transaction if we are allowed to
   IndexingDisabler disabler(mthds, trx->isSingleOperationTransaction());
 
-  rocksdb::Status s = mthds->SingleDelete(RocksDBColumnFamily::documents(), key.ref());
+  rocksdb::Status s = mthds->SingleDelete(documentsColumnFamily(), key.ref());
   if (!s.ok()) {
     return res.reset(rocksutils::convertStatus(s, rocksutils::document));
   }
@@ -1362,14 +1597,14 @@ Result RocksDBCollection::updateDocument(transaction::Methods* trx,
   TRI_ASSERT(key->containsLocalDocumentId(oldDocumentId));
   blackListKey(key.ref());
 
-  rocksdb::Status s = mthds->SingleDelete(RocksDBColumnFamily::documents(), key.ref());
+  rocksdb::Status s = mthds->SingleDelete(documentsColumnFamily(), key.ref());
   if (!s.ok()) {
     return res.reset(rocksutils::convertStatus(s, rocksutils::document));
   }
 
   key->constructDocument(_objectId, newDocumentId);
   TRI_ASSERT(key->containsLocalDocumentId(newDocumentId));
-  s = mthds->PutUntracked(RocksDBColumnFamily::documents(), key.ref(),
+  s = mthds->PutUntracked(documentsColumnFamily(), key.ref(),
                           rocksdb::Slice(newDoc.startAs<char>(),
                                          static_cast<size_t>(newDoc.byteSize())));
   if (!s.ok()) {
@@ -1430,7 +1665,7 @@ arangodb::Result RocksDBCollection::lookupDocumentVPack(transaction::Methods* tr
   }
 
   RocksDBMethods* mthd = RocksDBTransactionState::toMethods(trx);
-  rocksdb::Status s = mthd->Get(RocksDBColumnFamily::documents(), key->string(), &ps);
+  rocksdb::Status s = mthd->Get(documentsColumnFamily(), key->string(), &ps);
 
   if (!s.ok()) {
     LOG_TOPIC("f63dd", DEBUG, Logger::ENGINES)
@@ -1709,7 +1944,7 @@ void RocksDBCollection::estimateSize(velocypack::Builder& builder) {
   RocksDBKeyBounds bounds = RocksDBKeyBounds::CollectionDocuments(_objectId);
   rocksdb::Range r(bounds.start(), bounds.end());
   uint64_t out = 0, total = 0;
-  db->GetApproximateSizes(RocksDBColumnFamily::documents(), &r, 1, &out,
+  db->GetApproximateSizes(documentsColumnFamily(), &r, 1, &out,
                           static_cast<uint8_t>(
                               rocksdb::DB::SizeApproximationFlags::INCLUDE_MEMTABLES |
                               rocksdb::DB::SizeApproximationFlags::INCLUDE_FILES));
@@ -1743,7 +1978,12 @@ void RocksDBCollection::createCache() const {
   TRI_ASSERT(_cache.get() == nullptr);
   TRI_ASSERT(CacheManagerFeature::MANAGER != nullptr);
   LOG_TOPIC("f5df2", DEBUG, Logger::CACHE) << "Creating document cache";
-  _cache = CacheManagerFeature::MANAGER->createCache(cache::CacheType::Transactional);
+  // documents are often read by scans, which must not evict the hot ones.
+  // the windowed stats give the recent hit rate in the figures
+  _cache = CacheManagerFeature::MANAGER->createCache(cache::CacheType::Transactional,
+                                                     /*enableWindowedStats*/ true,
+                                                     UINT64_MAX,
+                                                     /*enableAdmissionFilter*/ true);
   _cachePresent = (_cache.get() != nullptr);
   TRI_ASSERT(_cacheEnabled);
 }
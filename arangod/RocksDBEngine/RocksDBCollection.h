@@ -27,6 +27,7 @@
 #include "Basics/Common.h"
 #include "Basics/ReadWriteLock.h"
 #include "RocksDBEngine/RocksDBCollectionMeta.h"
+#include "RocksDBEngine/RocksDBColumnFamily.h"
 #include "RocksDBEngine/RocksDBCommon.h"
 #include "StorageEngine/PhysicalCollection.h"
 #include "VocBase/LogicalCollection.h"
@@ -93,6 +94,9 @@ class RocksDBCollection final : public PhysicalCollection {
 
   void prepareIndexes(arangodb::velocypack::Slice indexesSlice) override;
 
+  /// @brief persists the statistics in the definitions column family
+  Result setStatistics(std::shared_ptr<CollectionStatistics const> statistics) override;
+
   std::shared_ptr<Index> createIndex(arangodb::velocypack::Slice const& info,
                                      bool restore, bool& created) override;
 
@@ -100,6 +104,8 @@ class RocksDBCollection final : public PhysicalCollection {
   bool dropIndex(TRI_idx_iid_t iid) override;
   std::unique_ptr<IndexIterator> getAllIterator(transaction::Methods* trx) const override;
   std::unique_ptr<IndexIterator> getAnyIterator(transaction::Methods* trx) const override;
+  std::unique_ptr<IndexIterator> getParallelAllIterator(transaction::Methods* trx,
+                                                        size_t parallelism) const override;
 
   void invokeOnAllElements(transaction::Methods* trx,
                            std::function<bool(LocalDocumentId const&)> callback) override;
@@ -118,12 +124,19 @@ class RocksDBCollection final : public PhysicalCollection {
 
   LocalDocumentId lookupKey(transaction::Methods* trx, velocypack::Slice const& key) const override;
 
+  /// @brief looks up all keys in the primary index with one MultiGet
+  void lookupKeys(transaction::Methods* trx, std::vector<velocypack::Slice> const& keys,
+                  std::vector<LocalDocumentId>& result) const override;
+
   bool lookupRevision(transaction::Methods* trx, velocypack::Slice const& key,
                       TRI_voc_rid_t& revisionId) const;
 
   Result read(transaction::Methods*, arangodb::velocypack::StringRef const& key,
               ManagedDocumentResult& result, bool) override;
 
+  Result readLatestCommitted(arangodb::velocypack::StringRef const& key,
+                             ManagedDocumentResult& result) const override;
+
   Result read(transaction::Methods* trx, arangodb::velocypack::Slice const& key,
               ManagedDocumentResult& result, bool locked) override {
     if (!key.isString()) {
@@ -139,6 +152,31 @@ class RocksDBCollection final : public PhysicalCollection {
   bool readDocumentWithCallback(transaction::Methods* trx, LocalDocumentId const& token,
                                 IndexIterator::DocumentCallback const& cb) const override;
 
+  /// @brief lookup multiple documents with a single MultiGet, calls the
+  /// callback for every document found, in the order of the ids.
+  /// returns the number of documents found
+  size_t readMultiple(transaction::Methods* trx, std::vector<LocalDocumentId> const& documentIds,
+                      IndexIterator::DocumentCallback const& cb) const;
+
+  /// @brief looks up the given keys, the i-th status and value belong to
+  /// the i-th key
+  typedef std::function<std::vector<rocksdb::Status>(std::vector<rocksdb::Slice> const&,
+                                                     std::vector<std::string>*)>
+      MultiGetFunction;
+
+  /// @brief the batched part of readMultiple. the documents not found in the
+  /// cache (if any) are read with a single call of multiGet, in the order
+  /// of their keys. the callback is called in the order of the ids
+  static size_t readMultiple(uint64_t objectId, cache::Cache* cache,
+                             std::vector<LocalDocumentId> const& documentIds,
+                             MultiGetFunction const& multiGet,
+                             IndexIterator::DocumentCallback const& cb);
+
+  /// @brief looks up all keys in the primary index with one MultiGet, and
+  /// then reads all documents found with another one
+  size_t readMultipleKeys(transaction::Methods* trx, std::vector<velocypack::Slice> const& keys,
+                          IndexIterator::DocumentCallback const& cb) const override;
+
   Result insert(arangodb::transaction::Methods* trx, arangodb::velocypack::Slice newSlice,
                 arangodb::ManagedDocumentResult& resultMdr, OperationOptions& options,
                 bool lock, KeyLockInfo* /*keyLockInfo*/,
@@ -176,6 +214,11 @@ class RocksDBCollection final : public PhysicalCollection {
 
   inline bool cacheEnabled() const { return _cacheEnabled; }
 
+  /// @brief the column family with the documents of the collection
+  rocksdb::ColumnFamilyHandle* documentsColumnFamily() const {
+    return RocksDBColumnFamily::documents(_storageClass);
+  }
+
   RocksDBCollectionMeta& meta() { return _meta; }
 
  private:
@@ -258,6 +301,7 @@ class RocksDBCollection final : public PhysicalCollection {
   // it's quicker than accessing the shared_ptr each time
   mutable bool _cachePresent;
   bool _cacheEnabled;
+  RocksDBColumnFamily::StorageClass const _storageClass;
   /// @brief number of index creations in progress
   std::atomic<int> _numIndexCreations;
 };
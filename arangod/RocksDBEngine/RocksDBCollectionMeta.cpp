@@ -22,12 +22,14 @@
 
 #include "RocksDBCollectionMeta.h"
 
+#include "Basics/Exceptions.h"
 #include "Basics/ReadLocker.h"
 #include "Basics/WriteLocker.h"
 #include "RocksDBEngine/RocksDBCollection.h"
 #include "RocksDBEngine/RocksDBColumnFamily.h"
 #include "RocksDBEngine/RocksDBCuckooIndexEstimator.h"
 #include "RocksDBEngine/RocksDBIndex.h"
+#include "VocBase/CollectionStatistics.h"
 #include "VocBase/KeyGenerator.h"
 #include "VocBase/LogicalCollection.h"
 
@@ -187,7 +189,8 @@ void RocksDBCollectionMeta::adjustNumberDocuments(rocksdb::SequenceNumber seq,
 Result RocksDBCollectionMeta::serializeMeta(rocksdb::WriteBatch& batch,
                                             LogicalCollection& coll, bool force,
                                             VPackBuilder& tmp,
-                                            rocksdb::SequenceNumber& appliedSeq) {
+                                            rocksdb::SequenceNumber& appliedSeq,
+                                            size_t& estimatorBudget) {
   TRI_ASSERT(appliedSeq != UINT64_MAX);
   
   Result res;
@@ -260,6 +263,15 @@ Result RocksDBCollectionMeta::serializeMeta(rocksdb::WriteBatch& batch,
       continue;
     }
 
+    if (est->needToPersist() && !force && estimatorBudget == 0) {
+      // enough estimates were serialized already, this one is written by a
+      // later sync. until then its changes must be kept in the WAL
+      LOG_TOPIC("3c1e7", TRACE, Logger::ENGINES)
+          << "postponing estimate serialization for index '" << idx->objectId() << "'";
+      appliedSeq = std::min(appliedSeq, est->appliedSeq());
+      continue;
+    }
+
     if (est->needToPersist() || force) {
       LOG_TOPIC("82a07", TRACE, Logger::ENGINES)
           << "beginning estimate serialization for index '" << idx->objectId() << "'";
@@ -267,6 +279,7 @@ Result RocksDBCollectionMeta::serializeMeta(rocksdb::WriteBatch& batch,
 
       est->serialize(output, maxCommitSeq);
       TRI_ASSERT(output.size() > sizeof(uint64_t));
+      estimatorBudget -= std::min(estimatorBudget, output.size());
 
       LOG_TOPIC("6b761", TRACE, Logger::ENGINES)
           << "serialized estimate for index '" << idx->objectId() << "' with estimate "
@@ -372,6 +385,24 @@ Result RocksDBCollectionMeta::deserializeMeta(rocksdb::DB* db, LogicalCollection
     }
   }
 
+  // Step 4. load the statistics of the documents
+  key.constructCollectionStatisticsValue(rcoll->objectId());
+  s = db->Get(ro, cf, key.string(), &value);
+  if (s.ok()) {
+    try {
+      auto statistics = std::make_shared<CollectionStatistics>(RocksDBValue::data(value));
+      // already persisted
+      rcoll->PhysicalCollection::setStatistics(std::move(statistics));
+    } catch (basics::Exception const& ex) {
+      // the optimizer can do without them
+      LOG_TOPIC("4c1e9", WARN, Logger::ENGINES)
+          << "ignoring invalid statistics of collection with objectId '"
+          << rcoll->objectId() << "': " << ex.what();
+    }
+  } else if (!s.IsNotFound()) {
+    return rocksutils::convertStatus(s);
+  }
+
   return Result();
 }
 
@@ -419,6 +450,14 @@ Result RocksDBCollectionMeta::deserializeMeta(rocksdb::DB* db, LogicalCollection
     return rocksutils::convertStatus(s);
   }
 
+  key.constructCollectionStatisticsValue(objectId);
+  s = db->Delete(wo, cf, key.string());
+  if (!s.ok() && !s.IsNotFound()) {
+    LOG_TOPIC("62d0b", ERR, Logger::ENGINES)
+        << "could not delete collection statistics: " << s.ToString();
+    return rocksutils::convertStatus(s);
+  }
+
   return Result();
 }
 
@@ -104,10 +104,14 @@ struct RocksDBCollectionMeta final {
   /// @brief buffer a counter adjustment
   void adjustNumberDocuments(rocksdb::SequenceNumber seq, TRI_voc_rid_t revId, int64_t adj);
 
-  /// @brief serialize the collection metadata
+  /// @brief serialize the collection metadata. estimatorBudget is the
+  /// number of bytes of index estimates that may still be serialized, it is
+  /// reduced by the size of the estimates written. once it is used up, the
+  /// remaining estimates are left for a later call, unless force is set
   arangodb::Result serializeMeta(rocksdb::WriteBatch&, LogicalCollection&,
                                  bool force, arangodb::velocypack::Builder&,
-                                 rocksdb::SequenceNumber& appliedSeq);
+                                 rocksdb::SequenceNumber& appliedSeq,
+                                 size_t& estimatorBudget);
 
   /// @brief deserialize collection metadata, only called on startup
   arangodb::Result deserializeMeta(rocksdb::DB*, LogicalCollection&);
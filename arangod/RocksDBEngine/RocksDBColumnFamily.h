@@ -27,6 +27,8 @@
 
 #include <rocksdb/db.h>
 
+#include <string>
+
 namespace arangodb {
 
 /// Globally defined column families. If you do change the number of column
@@ -42,12 +44,45 @@ struct RocksDBColumnFamily {
   friend class RocksDBEngine;
 
   static constexpr size_t minNumberOfColumnFamilies = 7;
-  static constexpr size_t numberOfColumnFamilies = 7;
+  static constexpr size_t numberOfColumnFamilies = 8;
+
+  /// @brief the storage classes of collections. the documents of each class
+  /// are kept in a column family of their own, with its own memtables,
+  /// table options and compaction style
+  enum class StorageClass {
+    /// @brief the documents column family
+    Default,
+    /// @brief large blocks without bloom filters and a write-optimized
+    /// compaction style, for collections that are mostly appended to
+    Log
+  };
+
+  static StorageClass storageClassFromString(std::string const& name);
+  static std::string storageClassName(StorageClass storageClass);
+
+  /// @brief remembers the storage class of a collection, so that the
+  /// bounds of its documents use the right column family
+  static void setStorageClass(uint64_t collectionObjectId, StorageClass storageClass);
 
   static rocksdb::ColumnFamilyHandle* definitions() { return _definitions; }
 
   static rocksdb::ColumnFamilyHandle* documents() { return _documents; }
 
+  static rocksdb::ColumnFamilyHandle* logDocuments() { return _logDocuments; }
+
+  static rocksdb::ColumnFamilyHandle* documents(StorageClass storageClass) {
+    return storageClass == StorageClass::Log ? _logDocuments : _documents;
+  }
+
+  /// @brief the column family with the documents of a collection
+  static rocksdb::ColumnFamilyHandle* documents(uint64_t collectionObjectId);
+
+  /// @brief whether the column family contains documents, of any storage class
+  static bool isDocuments(uint32_t columnFamilyId) {
+    return columnFamilyId == _documents->GetID() ||
+           columnFamilyId == _logDocuments->GetID();
+  }
+
   static rocksdb::ColumnFamilyHandle* primary() { return _primary; }
 
   static rocksdb::ColumnFamilyHandle* edge() { return _edge; }
@@ -85,6 +120,9 @@ struct RocksDBColumnFamily {
     if (cf == _fulltext) {
       return "fulltext";
     }
+    if (cf == _logDocuments) {
+      return "logDocuments";
+    }
     if (cf == rocksutils::defaultCF()) {
       return "invalid";
     }
@@ -103,6 +141,7 @@ struct RocksDBColumnFamily {
   static rocksdb::ColumnFamilyHandle* _vpack;
   static rocksdb::ColumnFamilyHandle* _geo;
   static rocksdb::ColumnFamilyHandle* _fulltext;
+  static rocksdb::ColumnFamilyHandle* _logDocuments;
   static std::vector<rocksdb::ColumnFamilyHandle*> _allHandles;
 };
 
@@ -35,11 +35,26 @@ using namespace arangodb;
 
 namespace {
 
+/// @brief whether two values are stored with the same bytes. such values
+/// always compare equal, and checking this is much cheaper than the
+/// type-aware comparison, which needs a collation for strings
+inline bool identicalBytes(arangodb::velocypack::Slice const& lhs,
+                           arangodb::velocypack::Slice const& rhs) {
+  auto const size = lhs.byteSize();
+  return size == rhs.byteSize() && memcmp(lhs.start(), rhs.start(), size) == 0;
+}
+
 int compareIndexedValues(arangodb::velocypack::Slice const& lhs,
                          arangodb::velocypack::Slice const& rhs) {
   TRI_ASSERT(lhs.isArray());
   TRI_ASSERT(rhs.isArray());
 
+  // entries of non-unique indexes often have the same index values and
+  // only differ in their LocalDocumentIds
+  if (identicalBytes(lhs, rhs)) {
+    return 0;
+  }
+
   arangodb::velocypack::ArrayIterator lhsIter(lhs);
   arangodb::velocypack::ArrayIterator rhsIter(rhs);
   size_t const lLength = lhsIter.size();
@@ -47,9 +62,12 @@ int compareIndexedValues(arangodb::velocypack::Slice const& lhs,
 
   while (lhsIter.valid() || rhsIter.valid()) {
     size_t i = lhsIter.index();
-    int res = arangodb::basics::VelocyPackHelper::compare(
-        (i < lLength ? *lhsIter : VPackSlice::noneSlice()),
-        (i < rLength ? *rhsIter : VPackSlice::noneSlice()), true);
+    VPackSlice const l = (i < lLength ? *lhsIter : VPackSlice::noneSlice());
+    VPackSlice const r = (i < rLength ? *rhsIter : VPackSlice::noneSlice());
+    // in combined indexes, the leading attributes are often equal
+    int res = identicalBytes(l, r)
+                  ? 0
+                  : arangodb::basics::VelocyPackHelper::compare(l, r, true);
     if (res != 0) {
       return res;
     }
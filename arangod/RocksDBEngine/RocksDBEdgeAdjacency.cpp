@@ -0,0 +1,284 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2019 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RocksDBEdgeAdjacency.h"
+#include "ApplicationFeatures/ApplicationServer.h"
+#include "Basics/ReadLocker.h"
+#include "Basics/ScopeGuard.h"
+#include "Basics/WriteLocker.h"
+#include "Basics/system-functions.h"
+#include "Logger/Logger.h"
+#include "RocksDBEngine/RocksDBCommon.h"
+#include "RocksDBEngine/RocksDBKey.h"
+#include "RocksDBEngine/RocksDBKeyBounds.h"
+#include "RocksDBEngine/RocksDBValue.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
+
+#include <rocksdb/db.h>
+#include <rocksdb/utilities/transaction_db.h>
+
+using namespace arangodb;
+
+namespace {
+/// @brief estimated memory per entry of an unordered_map
+constexpr size_t MapEntryOverhead = 32;
+
+/// @brief seconds to wait before building again after a failed build
+constexpr double RetryInterval = 60.0;
+
+/// @brief appends a vertex id as velocypack string
+void appendString(velocypack::Buffer<uint8_t>& buffer, velocypack::StringRef value) {
+  uint64_t length = value.size();
+  if (length <= 126) {
+    buffer.push_back(static_cast<uint8_t>(0x40 + length));
+  } else {
+    buffer.push_back(0xbf);
+    for (size_t i = 0; i < 8; ++i) {
+      buffer.push_back(static_cast<uint8_t>(length & 0xff));
+      length >>= 8;
+    }
+  }
+  buffer.append(value.data(), value.size());
+}
+}  // namespace
+
+RocksDBEdgeAdjacency::RocksDBEdgeAdjacency() : _sequenceNumber(0), _memory(0) {}
+
+bool RocksDBEdgeAdjacency::build(rocksdb::DB* db, rocksdb::ColumnFamilyHandle* cf,
+                                 uint64_t objectId, uint64_t maxMemory,
+                                 std::atomic<bool> const& canceled) {
+  rocksdb::Snapshot const* snapshot = db->GetSnapshot();
+  auto guard = scopeGuard([&]() { db->ReleaseSnapshot(snapshot); });
+  _sequenceNumber = snapshot->GetSequenceNumber();
+
+  RocksDBKeyBounds bounds = RocksDBKeyBounds::EdgeIndex(objectId);
+  rocksdb::Slice const end = bounds.end();
+  rocksdb::ReadOptions ro;
+  ro.snapshot = snapshot;
+  ro.prefix_same_as_start = false;  // key-prefix includes the vertex id
+  ro.total_order_seek = true;
+  ro.verify_checksums = false;
+  ro.fill_cache = false;
+  ro.iterate_upper_bound = &end;
+  std::unique_ptr<rocksdb::Iterator> it(db->NewIterator(ro, cf));
+
+  // vertex id => offset in _vertices, while reading
+  std::unordered_map<std::string, uint32_t> interned;
+  std::vector<std::pair<uint32_t, uint32_t>> rows;  // offset, row
+  size_t memory = 0;
+
+  auto intern = [&](velocypack::StringRef vertex, uint32_t& offset) -> bool {
+    std::string key = vertex.toString();
+    auto found = interned.find(key);
+    if (found != interned.end()) {
+      offset = found->second;
+      return true;
+    }
+    if (_vertices.size() + vertex.size() + 9 > std::numeric_limits<uint32_t>::max()) {
+      return false;
+    }
+    offset = static_cast<uint32_t>(_vertices.size());
+    appendString(_vertices, vertex);
+    memory += 2 * vertex.size() + MapEntryOverhead;
+    interned.emplace(std::move(key), offset);
+    return true;
+  };
+
+  std::string lastVertex;
+  size_t count = 0;
+  for (it->Seek(bounds.start()); it->Valid(); it->Next()) {
+    if (++count % 4096 == 0 &&
+        (canceled.load() || application_features::ApplicationServer::isStopping())) {
+      return false;
+    }
+
+    velocypack::StringRef vertex = RocksDBKey::vertexId(it->key());
+    if (_offsets.empty() || vertex != velocypack::StringRef(lastVertex)) {
+      uint32_t offset;
+      if (!intern(vertex, offset)) {
+        return false;
+      }
+      rows.emplace_back(offset, static_cast<uint32_t>(_offsets.size()));
+      _offsets.emplace_back(_documentIds.size());
+      lastVertex = vertex.toString();
+      memory += sizeof(uint64_t) + MapEntryOverhead;
+    }
+
+    uint32_t neighbor;
+    if (!intern(RocksDBValue::vertexId(it->value()), neighbor)) {
+      return false;
+    }
+    _documentIds.emplace_back(
+        RocksDBKey::indexDocumentId(RocksDBEntryType::EdgeIndexValue, it->key()).id());
+    _neighbors.emplace_back(neighbor);
+    memory += sizeof(LocalDocumentId::BaseType) + sizeof(uint32_t);
+
+    if (memory > maxMemory) {
+      LOG_TOPIC("a3d5f", INFO, Logger::ENGINES)
+          << "edges of index " << objectId << " need more than " << maxMemory
+          << " bytes, not using an adjacency cache";
+      return false;
+    }
+  }
+  if (!it->status().ok()) {
+    return false;
+  }
+  _offsets.emplace_back(_documentIds.size());
+
+  // the vertices do not move anymore
+  interned.clear();
+  _rows.reserve(rows.size());
+  for (auto const& row : rows) {
+    _rows.emplace(velocypack::Slice(_vertices.data() + row.first).stringRef(), row.second);
+  }
+
+  _offsets.shrink_to_fit();
+  _documentIds.shrink_to_fit();
+  _neighbors.shrink_to_fit();
+  _memory = _vertices.size() + _rows.size() * MapEntryOverhead +
+            _offsets.size() * sizeof(uint64_t) +
+            _documentIds.size() * sizeof(LocalDocumentId::BaseType) +
+            _neighbors.size() * sizeof(uint32_t);
+  return true;
+}
+
+bool RocksDBEdgeAdjacency::lookup(velocypack::StringRef vertex, uint64_t hash,
+                                  size_t& begin, size_t& end) const {
+  {
+    READ_LOCKER(locker, _changedLock);
+    if (_changed.find(hash) != _changed.end()) {
+      return false;
+    }
+  }
+
+  auto it = _rows.find(vertex);
+  if (it == _rows.end()) {
+    // the vertex had no edges in the snapshot
+    begin = end = 0;
+  } else {
+    begin = _offsets[it->second];
+    end = _offsets[it->second + 1];
+  }
+  return true;
+}
+
+void RocksDBEdgeAdjacency::markChanged(std::vector<uint64_t> const& hashes) {
+  WRITE_LOCKER(locker, _changedLock);
+  _changed.insert(hashes.begin(), hashes.end());
+}
+
+bool RocksDBEdgeAdjacency::needsRebuild() const {
+  READ_LOCKER(locker, _changedLock);
+  return _changed.size() > std::max<size_t>(1024, _rows.size() / 8);
+}
+
+RocksDBEdgeAdjacencyCache::RocksDBEdgeAdjacencyCache(rocksdb::ColumnFamilyHandle* cf,
+                                                     uint64_t objectId, uint64_t maxMemory)
+    : _cf(cf), _objectId(objectId), _maxMemory(maxMemory), _lastFailure(0.0), _canceled(false) {}
+
+std::shared_ptr<RocksDBEdgeAdjacency const> RocksDBEdgeAdjacencyCache::get(rocksdb::SequenceNumber seq) {
+  std::lock_guard<std::mutex> guard(_lock);
+
+  if (_building == nullptr && !_canceled.load() &&
+      (_current == nullptr ? TRI_microtime() - _lastFailure > ::RetryInterval
+                           : _current->needsRebuild())) {
+    scheduleBuild();
+  }
+
+  if (_current == nullptr || _current->sequenceNumber() > seq) {
+    return nullptr;
+  }
+  return _current;
+}
+
+void RocksDBEdgeAdjacencyCache::markChanged(std::vector<uint64_t> const& hashes) {
+  if (hashes.empty()) {
+    return;
+  }
+  std::lock_guard<std::mutex> guard(_lock);
+  if (_current != nullptr) {
+    _current->markChanged(hashes);
+  }
+  if (_building != nullptr) {
+    _building->markChanged(hashes);
+  }
+}
+
+void RocksDBEdgeAdjacencyCache::clear() {
+  std::lock_guard<std::mutex> guard(_lock);
+  // a running build is discarded when it finishes
+  _current.reset();
+  _building.reset();
+}
+
+void RocksDBEdgeAdjacencyCache::cancel() {
+  _canceled.store(true);
+  clear();
+}
+
+size_t RocksDBEdgeAdjacencyCache::memory() const {
+  std::lock_guard<std::mutex> guard(_lock);
+  return _current == nullptr ? 0 : _current->memory();
+}
+
+void RocksDBEdgeAdjacencyCache::scheduleBuild() {
+  auto scheduler = SchedulerFeature::SCHEDULER;
+  if (scheduler == nullptr) {
+    return;
+  }
+
+  // registered before the snapshot is taken, so that no commit after the
+  // snapshot is missed
+  auto adjacency = std::make_shared<RocksDBEdgeAdjacency>();
+  _building = adjacency;
+
+  auto self = shared_from_this();
+  bool queued = scheduler->queue(RequestLane::INTERNAL_LOW, [self, adjacency]() {
+    bool ok = false;
+    try {
+      ok = adjacency->build(rocksutils::globalRocksDB()->GetRootDB(), self->_cf,
+                            self->_objectId, self->_maxMemory, self->_canceled);
+    } catch (std::exception const& ex) {
+      LOG_TOPIC("5b81c", WARN, Logger::ENGINES)
+          << "failed to build adjacency cache of index " << self->_objectId
+          << ": " << ex.what();
+    }
+
+    std::lock_guard<std::mutex> guard(self->_lock);
+    if (self->_building != adjacency) {
+      // cleared in the meantime
+      return;
+    }
+    self->_building.reset();
+    if (ok) {
+      self->_current = adjacency;
+    } else {
+      self->_current.reset();
+      self->_lastFailure = TRI_microtime();
+    }
+  });
+
+  if (!queued) {
+    _building.reset();
+    _lastFailure = TRI_microtime();
+  }
+}
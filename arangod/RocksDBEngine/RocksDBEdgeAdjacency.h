@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2019 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_ROCKSDB_ENGINE_ROCKSDB_EDGE_ADJACENCY_H
+#define ARANGOD_ROCKSDB_ENGINE_ROCKSDB_EDGE_ADJACENCY_H 1
+
+#include "Basics/Common.h"
+#include "Basics/ReadWriteLock.h"
+#include "VocBase/LocalDocumentId.h"
+
+#include <rocksdb/types.h>
+#include <velocypack/Buffer.h>
+#include <velocypack/Slice.h>
+#include <velocypack/StringRef.h>
+
+#include <atomic>
+#include <mutex>
+#include <unordered_set>
+
+namespace rocksdb {
+class ColumnFamilyHandle;
+class DB;
+}
+
+namespace arangodb {
+
+/// @brief the adjacency lists of an edge index in compressed sparse row
+/// layout, read from a snapshot. vertex ids are interned as velocypack
+/// strings, so that a lookup hands out the other side of each edge without
+/// decoding anything. vertices touched by commits after the snapshot are
+/// marked as changed, their edges have to be read from the index instead
+class RocksDBEdgeAdjacency {
+ public:
+  RocksDBEdgeAdjacency(RocksDBEdgeAdjacency const&) = delete;
+  RocksDBEdgeAdjacency& operator=(RocksDBEdgeAdjacency const&) = delete;
+
+  RocksDBEdgeAdjacency();
+
+  /// @brief reads the edges of the index from a new snapshot of the
+  /// database. returns false if they need more than maxMemory bytes or if
+  /// canceled is set
+  bool build(rocksdb::DB*, rocksdb::ColumnFamilyHandle*, uint64_t objectId,
+             uint64_t maxMemory, std::atomic<bool> const& canceled);
+
+  rocksdb::SequenceNumber sequenceNumber() const { return _sequenceNumber; }
+
+  size_t memory() const { return _memory; }
+
+  /// @brief finds the edges of a vertex with the given hash, they are at the
+  /// positions [begin, end). returns false if the vertex changed after the
+  /// snapshot
+  bool lookup(arangodb::velocypack::StringRef vertex, uint64_t hash,
+              size_t& begin, size_t& end) const;
+
+  LocalDocumentId documentId(size_t position) const {
+    return LocalDocumentId(_documentIds[position]);
+  }
+
+  /// @brief the vertex on the other side of an edge
+  arangodb::velocypack::Slice neighbor(size_t position) const {
+    return arangodb::velocypack::Slice(_vertices.data() + _neighbors[position]);
+  }
+
+  /// @brief marks the vertices with the given hashes as changed
+  void markChanged(std::vector<uint64_t> const& hashes);
+
+  /// @brief whether so many vertices changed that the lookups should use
+  /// a new snapshot
+  bool needsRebuild() const;
+
+ private:
+  rocksdb::SequenceNumber _sequenceNumber;
+  size_t _memory;
+
+  // all vertex ids, as velocypack strings
+  arangodb::velocypack::Buffer<uint8_t> _vertices;
+  // vertex with outgoing edges => row
+  std::unordered_map<arangodb::velocypack::StringRef, uint32_t> _rows;
+  // the edges of row i are at [_offsets[i], _offsets[i + 1])
+  std::vector<uint64_t> _offsets;
+  std::vector<LocalDocumentId::BaseType> _documentIds;
+  // offsets of the other vertices in _vertices
+  std::vector<uint32_t> _neighbors;
+
+  mutable basics::ReadWriteLock _changedLock;
+  std::unordered_set<uint64_t> _changed;
+};
+
+/// @brief provides the adjacency of an edge index for lookups, builds it
+/// in the background and replaces it once too many vertices changed
+class RocksDBEdgeAdjacencyCache
+    : public std::enable_shared_from_this<RocksDBEdgeAdjacencyCache> {
+ public:
+  RocksDBEdgeAdjacencyCache(rocksdb::ColumnFamilyHandle*, uint64_t objectId,
+                            uint64_t maxMemory);
+
+  /// @brief the adjacency for a reader with the given snapshot, or nullptr
+  /// if there is none or it is newer than the reader's snapshot
+  std::shared_ptr<RocksDBEdgeAdjacency const> get(rocksdb::SequenceNumber);
+
+  /// @brief marks the vertices with the given hashes as changed, called
+  /// for the operations of a commit
+  void markChanged(std::vector<uint64_t> const& hashes);
+
+  /// @brief drops the adjacency, e.g. after a truncate
+  void clear();
+
+  /// @brief stops a running build, called when the index goes away
+  void cancel();
+
+  size_t memory() const;
+
+ private:
+  /// @brief must be called under _lock
+  void scheduleBuild();
+
+ private:
+  rocksdb::ColumnFamilyHandle* const _cf;
+  uint64_t const _objectId;
+  uint64_t const _maxMemory;
+
+  mutable std::mutex _lock;
+  std::shared_ptr<RocksDBEdgeAdjacency> _current;
+  std::shared_ptr<RocksDBEdgeAdjacency> _building;
+  double _lastFailure;
+  std::atomic<bool> _canceled;
+};
+
+}  // namespace arangodb
+
+#endif
@@ -34,12 +34,15 @@
 #include "RocksDBEdgeIndex.h"
 #include "RocksDBEngine/RocksDBCollection.h"
 #include "RocksDBEngine/RocksDBCommon.h"
+#include "RocksDBEngine/RocksDBEdgeAdjacency.h"
+#include "RocksDBEngine/RocksDBEngine.h"
 #include "RocksDBEngine/RocksDBKey.h"
 #include "RocksDBEngine/RocksDBKeyBounds.h"
 #include "RocksDBEngine/RocksDBMethods.h"
 #include "RocksDBEngine/RocksDBSettingsManager.h"
 #include "RocksDBEngine/RocksDBTransactionState.h"
 #include "RocksDBEngine/RocksDBTypes.h"
+#include "StorageEngine/TransactionCollection.h"
 #include "Transaction/Context.h"
 #include "Transaction/Helpers.h"
 #include "Transaction/Methods.h"
@@ -87,10 +90,14 @@ class RocksDBEdgeIndexLookupIterator final : public IndexIterator {
   RocksDBEdgeIndexLookupIterator(LogicalCollection* collection, transaction::Methods* trx,
                                  arangodb::RocksDBEdgeIndex const* index,
                                  std::unique_ptr<VPackBuilder> keys,
-                                 std::shared_ptr<cache::Cache> cache)
+                                 std::shared_ptr<cache::Cache> cache,
+                                 std::shared_ptr<RocksDBEdgeAdjacency const> adjacency)
       : IndexIterator(collection, trx),
         _index(index),
         _cache(std::move(cache)),
+        _adjacency(std::move(adjacency)),
+        _adjacencyPosition(0),
+        _adjacencyEnd(0),
         _keys(std::move(keys)),
         _keysIterator(_keys->slice()),
         _bounds(RocksDBKeyBounds::EdgeIndex(0)),
@@ -136,6 +143,17 @@ class RocksDBEdgeIndexLookupIterator final : public IndexIterator {
 #endif
     
     while (limit > 0) {
+      while (_adjacencyPosition < _adjacencyEnd) {
+        std::forward<F>(cb)(_adjacency->documentId(_adjacencyPosition),
+                            _adjacency->neighbor(_adjacencyPosition));
+        ++_adjacencyPosition;
+        limit--;
+
+        if (limit == 0) {
+          return true;
+        }
+      }
+
       while (_builderIterator.valid()) {
         // We still have unreturned edges in out memory.
         // Just plainly return those.
@@ -168,7 +186,12 @@ class RocksDBEdgeIndexLookupIterator final : public IndexIterator {
       arangodb::velocypack::StringRef fromTo(_lastKey);
       
       bool needRocksLookup = true;
-      if (_cache) {
+      if (_adjacency != nullptr &&
+          _adjacency->lookup(fromTo, std::hash<VPackStringRef>()(fromTo),
+                             _adjacencyPosition, _adjacencyEnd)) {
+        // the vertex did not change since the adjacency was read
+        needRocksLookup = false;
+      } else if (_cache) {
         for (size_t attempts = 0; attempts < 10; ++attempts) {
           // Try to read from cache
           auto finding = _cache->find(fromTo.data(), (uint32_t)fromTo.size());
@@ -221,7 +244,8 @@ class RocksDBEdgeIndexLookupIterator final : public IndexIterator {
       _keysIterator.next();
     }
     TRI_ASSERT(limit == 0);
-    return _builderIterator.valid() || _keysIterator.valid();
+    return _adjacencyPosition < _adjacencyEnd || _builderIterator.valid() ||
+           _keysIterator.valid();
   }
 
   // calls cb(documentId)
@@ -246,6 +270,18 @@ class RocksDBEdgeIndexLookupIterator final : public IndexIterator {
     }, limit);
   }
 
+  // collects the document ids of the batch, and reads all of the edges
+  // with a single MultiGet
+  bool nextDocument(DocumentCallback const& cb, size_t limit) override {
+    _documentIds.clear();
+    bool hasMore = nextImplementation([this](LocalDocumentId docId,
+                                             VPackSlice) {
+      _documentIds.emplace_back(docId);
+    }, limit);
+    toRocksDBCollection(_collection->getPhysical())->readMultiple(_trx, _documentIds, cb);
+    return hasMore;
+  }
+
   // calls cb(documentId, _from) or (documentId, _to)
   bool nextExtra(ExtraCallback const& cb, size_t limit) override {
     return nextImplementation([&cb](LocalDocumentId docId,
@@ -256,6 +292,8 @@ class RocksDBEdgeIndexLookupIterator final : public IndexIterator {
 
   void reset() override {
     resetInplaceMemory();
+    _adjacencyPosition = 0;
+    _adjacencyEnd = 0;
     _keysIterator.reset();
     _lastKey = VPackSlice::nullSlice();
     _builderIterator =
@@ -362,6 +400,10 @@ class RocksDBEdgeIndexLookupIterator final : public IndexIterator {
   RocksDBEdgeIndex const* _index;
 
   std::shared_ptr<cache::Cache> _cache;
+  std::shared_ptr<RocksDBEdgeAdjacency const> _adjacency;
+  // edges of the current vertex in _adjacency still to return
+  size_t _adjacencyPosition;
+  size_t _adjacencyEnd;
   std::unique_ptr<arangodb::velocypack::Builder> _keys;
   arangodb::velocypack::ArrayIterator _keysIterator;
 
@@ -372,6 +414,9 @@ class RocksDBEdgeIndexLookupIterator final : public IndexIterator {
   arangodb::velocypack::Builder _builder;
   arangodb::velocypack::ArrayIterator _builderIterator;
   arangodb::velocypack::Slice _lastKey;
+
+  // document ids of the current batch, for nextDocument
+  std::vector<LocalDocumentId> _documentIds;
 };
 
 }  // namespace arangodb
@@ -409,13 +454,23 @@ RocksDBEdgeIndex::RocksDBEdgeIndex(TRI_idx_iid_t iid, arangodb::LogicalCollectio
     _estimator = std::make_unique<RocksDBCuckooIndexEstimator<uint64_t>>(
         RocksDBIndex::ESTIMATOR_SIZE);
     TRI_ASSERT(_estimator != nullptr);
+
+    uint64_t maxMemory = rocksutils::globalRocksEngine()->edgeAdjacencyMaxMemory();
+    if (maxMemory > 0) {
+      _adjacencyCache =
+          std::make_shared<RocksDBEdgeAdjacencyCache>(_cf, _objectId, maxMemory);
+    }
   }
   // edge indexes are always created with ID 1 or 2
   TRI_ASSERT(iid == 1 || iid == 2);
   TRI_ASSERT(_objectId != 0);
 }
 
-RocksDBEdgeIndex::~RocksDBEdgeIndex() {}
+RocksDBEdgeIndex::~RocksDBEdgeIndex() {
+  if (_adjacencyCache != nullptr) {
+    _adjacencyCache->cancel();
+  }
+}
 
 std::vector<std::vector<arangodb::basics::AttributeName>> const& RocksDBEdgeIndex::coveredFields() const {
   TRI_ASSERT(_coveredFields.size() == 2);  // _from/_to or _to/_from
@@ -675,6 +730,29 @@ void RocksDBEdgeIndex::warmup(transaction::Methods* trx,
   queue->enqueue(task4);
 }
 
+std::vector<std::string> RocksDBEdgeIndex::cachedLookupValues(size_t maxValues) const {
+  if (!useCache()) {
+    return {};
+  }
+  // the cache is keyed by vertex id
+  return _cache->keys(maxValues);
+}
+
+void RocksDBEdgeIndex::warmupCache(transaction::Methods* trx,
+                                   std::vector<std::string> const& values) {
+  if (!useCache()) {
+    return;
+  }
+  for (auto const& vertexId : values) {
+    if (application_features::ApplicationServer::isStopping()) {
+      return;
+    }
+    auto bounds = RocksDBKeyBounds::EdgeIndexVertex(_objectId,
+                                                    arangodb::velocypack::StringRef(vertexId));
+    warmupInternal(trx, bounds.start(), bounds.end());
+  }
+}
+
 void RocksDBEdgeIndex::warmupInternal(transaction::Methods* trx, rocksdb::Slice const& lower,
                                       rocksdb::Slice const& upper) {
   auto rocksColl = toRocksDBCollection(_collection);
@@ -829,7 +907,8 @@ IndexIterator* RocksDBEdgeIndex::createEqIterator(transaction::Methods* trx,
   std::unique_ptr<VPackBuilder> keys(builder.steal());
 
   fillLookupValue(*(keys.get()), valNode);
-  return new RocksDBEdgeIndexLookupIterator(&_collection, trx, this, std::move(keys), _cache);
+  return new RocksDBEdgeIndexLookupIterator(&_collection, trx, this, std::move(keys), _cache,
+                                            adjacency(trx));
 }
 
 /// @brief create the iterator
@@ -841,7 +920,40 @@ IndexIterator* RocksDBEdgeIndex::createInIterator(transaction::Methods* trx,
   std::unique_ptr<VPackBuilder> keys(builder.steal());
 
   fillInLookupValues(trx, *(keys.get()), valNode);
-  return new RocksDBEdgeIndexLookupIterator(&_collection, trx, this, std::move(keys), _cache);
+  return new RocksDBEdgeIndexLookupIterator(&_collection, trx, this, std::move(keys), _cache,
+                                            adjacency(trx));
+}
+
+IndexIterator* RocksDBEdgeIndex::iteratorForVertices(transaction::Methods* trx,
+                                                     VPackSlice vertexIds) {
+  TRI_ASSERT(vertexIds.isArray());
+  std::vector<VPackStringRef> sorted;
+  sorted.reserve(vertexIds.length());
+  for (VPackSlice id : VPackArrayIterator(vertexIds)) {
+    if (id.isString() && id.getStringLength() > 0) {
+      sorted.emplace_back(id);
+    }
+  }
+  std::sort(sorted.begin(), sorted.end(), [](VPackStringRef const& lhs, VPackStringRef const& rhs) {
+    return lhs.compare(rhs) < 0;
+  });
+  sorted.erase(std::unique(sorted.begin(), sorted.end(),
+                           [](VPackStringRef const& lhs, VPackStringRef const& rhs) {
+                             return lhs.equals(rhs);
+                           }),
+               sorted.end());
+
+  // lease builder, but immediately pass it to the unique_ptr so we don't leak
+  transaction::BuilderLeaser builder(trx);
+  std::unique_ptr<VPackBuilder> keys(builder.steal());
+
+  keys->openArray(/*unindexed*/true);
+  for (auto const& id : sorted) {
+    keys->add(VPackValuePair(id.data(), id.size(), VPackValueType::String));
+  }
+  keys->close();
+  return new RocksDBEdgeIndexLookupIterator(&_collection, trx, this, std::move(keys), _cache,
+                                            adjacency(trx));
 }
 
 void RocksDBEdgeIndex::fillLookupValue(VPackBuilder& keys,
@@ -894,9 +1006,42 @@ void RocksDBEdgeIndex::handleValNode(VPackBuilder* keys,
 void RocksDBEdgeIndex::afterTruncate(TRI_voc_tick_t tick) {
   TRI_ASSERT(_estimator != nullptr);
   _estimator->bufferTruncate(tick);
+  if (_adjacencyCache != nullptr) {
+    _adjacencyCache->clear();
+  }
   RocksDBIndex::afterTruncate(tick);
 }
 
+void RocksDBEdgeIndex::afterCommit(std::vector<uint64_t> const& inserts,
+                                   std::vector<uint64_t> const& removals) {
+  if (_adjacencyCache != nullptr) {
+    _adjacencyCache->markChanged(inserts);
+    _adjacencyCache->markChanged(removals);
+  }
+}
+
+std::shared_ptr<RocksDBEdgeAdjacency const> RocksDBEdgeIndex::adjacency(
+    transaction::Methods* trx) const {
+  if (_adjacencyCache == nullptr) {
+    return nullptr;
+  }
+
+  RocksDBTransactionState* state = RocksDBTransactionState::toState(trx);
+  TransactionCollection* trxColl = state->findCollection(_collection.id());
+  if (trxColl != nullptr && trxColl->hasOperations()) {
+    // the own changes of the transaction are only visible in rocksdb
+    return nullptr;
+  }
+
+  rocksdb::SequenceNumber seq = state->sequenceNumber();
+  if (toRocksDBCollection(_collection)->meta().committableSeq(seq) < seq) {
+    // commits in progress may be visible to the transaction, but are not
+    // marked in the adjacency yet
+    return nullptr;
+  }
+  return _adjacencyCache->get(seq);
+}
+
 RocksDBCuckooIndexEstimator<uint64_t>* RocksDBEdgeIndex::estimator() {
   return _estimator.get();
 }
@@ -40,6 +40,8 @@
 #include <velocypack/Slice.h>
 
 namespace arangodb {
+class RocksDBEdgeAdjacency;
+class RocksDBEdgeAdjacencyCache;
 class RocksDBEdgeIndex;
 
 class RocksDBEdgeIndexWarmupTask : public basics::LocalTask {
@@ -102,6 +104,11 @@ class RocksDBEdgeIndex final : public RocksDBIndex {
                                       arangodb::aql::Variable const*,
                                       IndexIteratorOptions const&) override;
 
+  /// @brief looks up the vertices in key order, so that lookups which miss
+  /// the cache seek forward and read neighboring blocks
+  IndexIterator* iteratorForVertices(transaction::Methods*,
+                                     arangodb::velocypack::Slice vertexIds) override;
+
   arangodb::aql::AstNode* specializeCondition(arangodb::aql::AstNode*,
                                               arangodb::aql::Variable const*) const override;
 
@@ -109,8 +116,16 @@ class RocksDBEdgeIndex final : public RocksDBIndex {
   void warmup(arangodb::transaction::Methods* trx,
               std::shared_ptr<basics::LocalTaskQueue> queue) override;
 
+  std::vector<std::string> cachedLookupValues(size_t maxValues) const override;
+
+  void warmupCache(transaction::Methods* trx,
+                   std::vector<std::string> const& values) override;
+
   void afterTruncate(TRI_voc_tick_t tick) override;
 
+  void afterCommit(std::vector<uint64_t> const& inserts,
+                   std::vector<uint64_t> const& removals) override;
+
   Result insert(transaction::Methods& trx, RocksDBMethods* methods,
                 LocalDocumentId const& documentId,
                 velocypack::Slice const& doc, Index::OperationMode mode) override;
@@ -142,6 +157,9 @@ class RocksDBEdgeIndex final : public RocksDBIndex {
   void warmupInternal(transaction::Methods* trx, rocksdb::Slice const& lower,
                       rocksdb::Slice const& upper);
 
+  /// @brief the adjacency lookups of the transaction can use, or nullptr
+  std::shared_ptr<RocksDBEdgeAdjacency const> adjacency(transaction::Methods* trx) const;
+
  private:
   std::string const _directionAttr;
   bool const _isFromIndex;
@@ -155,6 +173,10 @@ class RocksDBEdgeIndex final : public RocksDBIndex {
   ///        First is the actual index attribute (e.g. _from), second is the
   ///        opposite (e.g. _to)
   std::vector<std::vector<arangodb::basics::AttributeName>> const _coveredFields;
+
+  /// @brief adjacency lists read from a snapshot, nullptr unless
+  /// --rocksdb.edge-adjacency-max-memory is set
+  std::shared_ptr<RocksDBEdgeAdjacencyCache> _adjacencyCache;
 };
 }  // namespace arangodb
 
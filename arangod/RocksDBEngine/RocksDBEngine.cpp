@@ -27,6 +27,7 @@
 #include "ApplicationFeatures/RocksDBOptionFeature.h"
 #include "Basics/Exceptions.h"
 #include "Basics/FileUtils.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/ReadLocker.h"
 #include "Basics/Result.h"
 #include "Basics/RocksDBLogger.h"
@@ -45,13 +46,16 @@
 #include "Rest/Version.h"
 #include "RestHandler/RestHandlerCreator.h"
 #include "RestServer/DatabasePathFeature.h"
+#include "RestServer/MetricsFeature.h"
 #include "RestServer/ServerIdFeature.h"
 #include "RocksDBEngine/RocksDBBackgroundErrorListener.h"
 #include "RocksDBEngine/RocksDBBackgroundThread.h"
+#include "RocksDBEngine/RocksDBCacheWarmup.h"
 #include "RocksDBEngine/RocksDBCollection.h"
 #include "RocksDBEngine/RocksDBColumnFamily.h"
 #include "RocksDBEngine/RocksDBCommon.h"
 #include "RocksDBEngine/RocksDBComparator.h"
+#include "RocksDBEngine/RocksDBFilterPolicy.h"
 #include "RocksDBEngine/RocksDBIncrementalSync.h"
 #include "RocksDBEngine/RocksDBIndex.h"
 #include "RocksDBEngine/RocksDBIndexFactory.h"
@@ -64,6 +68,7 @@
 #include "RocksDBEngine/RocksDBReplicationTailing.h"
 #include "RocksDBEngine/RocksDBRestHandlers.h"
 #include "RocksDBEngine/RocksDBSettingsManager.h"
+#include "RocksDBEngine/RocksDBSnapshotPool.h"
 #include "RocksDBEngine/RocksDBSyncThread.h"
 #include "RocksDBEngine/RocksDBThrottle.h"
 #include "RocksDBEngine/RocksDBTransactionCollection.h"
@@ -73,6 +78,7 @@
 #include "RocksDBEngine/RocksDBV8Functions.h"
 #include "RocksDBEngine/RocksDBValue.h"
 #include "RocksDBEngine/RocksDBWalAccess.h"
+#include "StorageEngine/StoragePerfCounters.h"
 #include "Transaction/Context.h"
 #include "Transaction/ContextData.h"
 #include "Transaction/Manager.h"
@@ -85,12 +91,15 @@
 #include <rocksdb/db.h>
 #include <rocksdb/env.h>
 #include <rocksdb/filter_policy.h>
+#include <rocksdb/iostats_context.h>
 #include <rocksdb/iterator.h>
 #include <rocksdb/options.h>
+#include <rocksdb/perf_context.h>
 #include <rocksdb/slice_transform.h>
 #include <rocksdb/statistics.h>
 #include <rocksdb/table.h>
 #include <rocksdb/transaction_log.h>
+#include <rocksdb/utilities/table_properties_collectors.h>
 #include <rocksdb/utilities/transaction_db.h>
 #include <rocksdb/write_batch.h>
 
@@ -114,8 +123,55 @@ rocksdb::ColumnFamilyHandle* RocksDBColumnFamily::_edge(nullptr);
 rocksdb::ColumnFamilyHandle* RocksDBColumnFamily::_vpack(nullptr);
 rocksdb::ColumnFamilyHandle* RocksDBColumnFamily::_geo(nullptr);
 rocksdb::ColumnFamilyHandle* RocksDBColumnFamily::_fulltext(nullptr);
+rocksdb::ColumnFamilyHandle* RocksDBColumnFamily::_logDocuments(nullptr);
 std::vector<rocksdb::ColumnFamilyHandle*> RocksDBColumnFamily::_allHandles;
 
+namespace {
+// object ids of all collections with the "log" storage class. entries are
+// never removed, as object ids are not reused, and the documents of dropped
+// collections may still have to be removed from the column family
+arangodb::basics::ReadWriteLock logCollectionsLock;
+std::unordered_set<uint64_t> logCollections;
+
+// compression types for --rocksdb.documents-compression
+std::unordered_map<std::string, rocksdb::CompressionType> const compressionTypes = {
+    {"none", rocksdb::kNoCompression},      {"snappy", rocksdb::kSnappyCompression},
+    {"lz4", rocksdb::kLZ4Compression},      {"lz4hc", rocksdb::kLZ4HCCompression},
+    {"zlib", rocksdb::kZlibCompression},    {"zstd", rocksdb::kZSTD}};
+}  // namespace
+
+RocksDBColumnFamily::StorageClass RocksDBColumnFamily::storageClassFromString(std::string const& name) {
+  if (name.empty() || name == "default") {
+    return StorageClass::Default;
+  }
+  if (name == "log") {
+    return StorageClass::Log;
+  }
+  THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                 "invalid storageClass '" + name +
+                                     "', expecting 'default' or 'log'");
+}
+
+std::string RocksDBColumnFamily::storageClassName(StorageClass storageClass) {
+  return storageClass == StorageClass::Log ? "log" : "default";
+}
+
+void RocksDBColumnFamily::setStorageClass(uint64_t collectionObjectId,
+                                          StorageClass storageClass) {
+  if (storageClass == StorageClass::Log) {
+    WRITE_LOCKER(guard, ::logCollectionsLock);
+    ::logCollections.emplace(collectionObjectId);
+  }
+}
+
+rocksdb::ColumnFamilyHandle* RocksDBColumnFamily::documents(uint64_t collectionObjectId) {
+  READ_LOCKER(guard, ::logCollectionsLock);
+  if (::logCollections.find(collectionObjectId) != ::logCollections.end()) {
+    return _logDocuments;
+  }
+  return _documents;
+}
+
 // minimum value for --rocksdb.sync-interval (in ms)
 // a value of 0 however means turning off the syncing altogether!
 static constexpr uint64_t minSyncInterval = 5;
@@ -178,6 +234,24 @@ RocksDBEngine::RocksDBEngine(application_features::ApplicationServer& server)
       _pruneWaitTime(10.0),
       _pruneWaitTimeInitial(180.0),
       _maxWalArchiveSizeLimit(0),
+      _logDocumentsBlockSize(64 * 1024),
+      _logDocumentsBloomFilterBits(0),
+      _logDocumentsCompactionStyle("universal"),
+      _compactionDeletionWindow(0),
+      _compactionDeletionTrigger(0),
+      _vpackIndexBloomFilterBits(0),
+      _partitionIndexAndFilters(false),
+      _indexBuildThreads(2),
+      _edgeAdjacencyMaxMemory(0),
+      _bulkLoadIdleTime(0.0),
+      _lastBulkLoad(0.0),
+      _cacheWarmupEntries(0),
+      _cacheWarmupInterval(300.0),
+      _sharedSnapshotMaxAge(2000),
+      _documentsCompression("snappy"),
+      _documentsCompressionDictionarySize(0),
+      _documentsCompressionTrainingSize(0),
+      _perfContextSampling(0),
       _releasedTick(0),
 #ifdef _WIN32
       // background syncing is not supported on Windows
@@ -186,6 +260,8 @@ RocksDBEngine::RocksDBEngine(application_features::ApplicationServer& server)
       _syncInterval(100),
 #endif
       _useThrottle(true),
+      _throttleMaxPendingCompactionBytes(0),
+      _throttleMaxBackgroundJobs(0),
       _debugLogging(false) {
 
   startsAfter("BasicsPhase");
@@ -210,6 +286,9 @@ void RocksDBEngine::shutdownRocksDBInstance() noexcept {
     _listener->StopThread();
   }  // if
 
+  // give back the last shared snapshot before closing the database
+  _snapshotPool.reset();
+
   for (rocksdb::ColumnFamilyHandle* h : RocksDBColumnFamily::_allHandles) {
     _db->DestroyColumnFamilyHandle(h);
   }
@@ -290,6 +369,17 @@ void RocksDBEngine::collectOptions(std::shared_ptr<options::ProgramOptions> opti
   options->addOption("--rocksdb.throttle", "enable write-throttling",
                      new BooleanParameter(&_useThrottle));
 
+  options->addOption("--rocksdb.throttle-max-pending-compaction-bytes",
+                     "throttle writes further while the estimated number of "
+                     "bytes pending compaction exceeds this value (0 = no limit)",
+                     new UInt64Parameter(&_throttleMaxPendingCompactionBytes));
+
+  options->addOption("--rocksdb.throttle-max-background-jobs",
+                     "maximum number of background jobs the write-throttle "
+                     "raises --rocksdb.max-background-jobs to while compactions "
+                     "are behind (0 = never change the number of background jobs)",
+                     new UInt64Parameter(&_throttleMaxBackgroundJobs));
+
   options->addOption("--rocksdb.debug-logging",
                      "true to enable rocksdb debug logging",
                      new BooleanParameter(&_debugLogging),
@@ -300,6 +390,108 @@ void RocksDBEngine::collectOptions(std::shared_ptr<options::ProgramOptions> opti
                      new UInt64Parameter(&_maxWalArchiveSizeLimit),
                      arangodb::options::makeFlags(arangodb::options::Flags::Hidden));
 
+  options->addOption("--rocksdb.log-documents-block-size",
+                     "approximate size (in bytes) of user data packed per block "
+                     "for the documents of collections with storage class 'log'",
+                     new UInt64Parameter(&_logDocumentsBlockSize));
+
+  options->addOption("--rocksdb.log-documents-bloom-filter-bits",
+                     "bits per key of the bloom filters for the documents of "
+                     "collections with storage class 'log' (0 = no bloom filters)",
+                     new UInt64Parameter(&_logDocumentsBloomFilterBits));
+
+  std::unordered_set<std::string> compactionStyles = {"level", "universal"};
+  options->addOption("--rocksdb.log-documents-compaction-style",
+                     "compaction style for the documents of collections with "
+                     "storage class 'log'",
+                     new DiscreteValuesParameter<StringParameter>(
+                         &_logDocumentsCompactionStyle, compactionStyles));
+
+  options->addOption("--rocksdb.compaction-deletion-window",
+                     "number of consecutive keys in .sst files that are checked "
+                     "for deletions, files with too many deletions are compacted "
+                     "early (0 = never compact because of deletions)",
+                     new UInt64Parameter(&_compactionDeletionWindow));
+
+  options->addOption("--rocksdb.compaction-deletion-trigger",
+                     "number of deletions within the window of "
+                     "'--rocksdb.compaction-deletion-window' keys that makes "
+                     "an .sst file be compacted early",
+                     new UInt64Parameter(&_compactionDeletionTrigger));
+
+  options->addOption("--rocksdb.persistent-index-bloom-filter-bits",
+                     "bits per key of the bloom filters for equality lookups in "
+                     "persistent, hash and skiplist indexes (0 = no bloom filters)",
+                     new UInt64Parameter(&_vpackIndexBloomFilterBits));
+
+  options->addOption("--rocksdb.partition-index-and-filters",
+                     "split the index and filter blocks of .sst files into "
+                     "partitions, so that only the partitions needed are loaded",
+                     new BooleanParameter(&_partitionIndexAndFilters));
+
+  options->addOption("--rocksdb.index-build-threads",
+                     "number of threads filling a new non-unique index",
+                     new UInt64Parameter(&_indexBuildThreads));
+
+  options->addOption("--rocksdb.edge-adjacency-max-memory",
+                     "maximum memory (in bytes) per edge index for keeping "
+                     "its edges as adjacency lists in memory, so that "
+                     "traversals and path searches need no index lookups "
+                     "for unchanged vertices (0 = no adjacency lists)",
+                     new UInt64Parameter(&_edgeAdjacencyMaxMemory));
+
+  options->addOption("--rocksdb.bulk-load-idle-time",
+                     "while data is restored, postpone compactions until no "
+                     "data was restored for this many seconds (0 = do not "
+                     "postpone compactions)",
+                     new DoubleParameter(&_bulkLoadIdleTime));
+
+  options->addOption("--rocksdb.cache-warmup-entries",
+                     "maximum number of entries per index cache to remember "
+                     "across restarts, and to load again in the background "
+                     "once the server is ready (0 = start with cold caches)",
+                     new UInt64Parameter(&_cacheWarmupEntries));
+
+  options->addOption("--rocksdb.cache-warmup-interval",
+                     "seconds between saving the entries of the index caches "
+                     "to remember across restarts",
+                     new DoubleParameter(&_cacheWarmupInterval));
+
+  options->addOption("--rocksdb.shared-snapshot-max-age",
+                     "maximum age (in microseconds) of a snapshot shared by "
+                     "read-only transactions started with the "
+                     "'shareReadSnapshot' option",
+                     new UInt64Parameter(&_sharedSnapshotMaxAge));
+
+  std::unordered_set<std::string> compressions;
+  for (auto const& it : ::compressionTypes) {
+    compressions.emplace(it.first);
+  }
+  options->addOption("--rocksdb.documents-compression",
+                     "compression of the documents in .sst files (the types "
+                     "other than none and snappy depend on the RocksDB build)",
+                     new DiscreteValuesParameter<StringParameter>(
+                         &_documentsCompression, compressions));
+
+  options->addOption("--rocksdb.documents-compression-dictionary-size",
+                     "maximum size (in bytes) of the dictionary that is sampled "
+                     "from the documents of each .sst file and shared by all "
+                     "of its blocks (0 = no dictionary, needs lz4, lz4hc, zlib "
+                     "or zstd compression)",
+                     new UInt64Parameter(&_documentsCompressionDictionarySize));
+
+  options->addOption("--rocksdb.documents-compression-training-size",
+                     "maximum size (in bytes) of the document samples a zstd "
+                     "dictionary is trained from (0 = use the samples as the "
+                     "dictionary)",
+                     new UInt64Parameter(&_documentsCompressionTrainingSize));
+
+  options->addOption("--rocksdb.perf-context-sampling",
+                     "collect the RocksDB perf context for one in this many "
+                     "requests and export it per endpoint and AQL node type "
+                     "(0 = off)",
+                     new UInt32Parameter(&_perfContextSampling));
+
 #ifdef USE_ENTERPRISE
   collectEnterpriseOptions(options);
 #endif
@@ -335,6 +527,49 @@ void RocksDBEngine::validateOptions(std::shared_ptr<options::ProgramOptions> opt
            "--rocksdb.wal-file-timeout-initial. "
         << "Replication clients might have trouble to get in sync";
   }
+
+  if (_compactionDeletionWindow > 0 &&
+      (_compactionDeletionTrigger == 0 ||
+       _compactionDeletionTrigger > _compactionDeletionWindow)) {
+    LOG_TOPIC("4c7e1", FATAL, arangodb::Logger::CONFIG)
+        << "invalid value for --rocksdb.compaction-deletion-trigger. Please "
+        << "use a value between 1 and the value of "
+        << "--rocksdb.compaction-deletion-window";
+    FATAL_ERROR_EXIT();
+  }
+
+  auto const compression = ::compressionTypes.at(_documentsCompression);
+  auto const supported = rocksdb::GetSupportedCompressions();
+  if (compression != rocksdb::kNoCompression &&
+      std::find(supported.begin(), supported.end(), compression) == supported.end()) {
+    LOG_TOPIC("2c4b8", FATAL, arangodb::Logger::CONFIG)
+        << "compression '" << _documentsCompression
+        << "' for --rocksdb.documents-compression is not supported by this "
+        << "build. supported compression types: " << getCompressionSupport();
+    FATAL_ERROR_EXIT();
+  }
+
+  if (_documentsCompressionDictionarySize > std::numeric_limits<uint32_t>::max() ||
+      _documentsCompressionTrainingSize > std::numeric_limits<uint32_t>::max()) {
+    LOG_TOPIC("7f0d3", FATAL, arangodb::Logger::CONFIG)
+        << "too high value for --rocksdb.documents-compression-dictionary-size "
+        << "or --rocksdb.documents-compression-training-size";
+    FATAL_ERROR_EXIT();
+  }
+
+  if (_documentsCompressionDictionarySize > 0 &&
+      (compression == rocksdb::kNoCompression ||
+       compression == rocksdb::kSnappyCompression)) {
+    LOG_TOPIC("e1b59", WARN, arangodb::Logger::CONFIG)
+        << "--rocksdb.documents-compression-dictionary-size has no effect "
+        << "with compression '" << _documentsCompression << "'";
+  }
+
+  if (_documentsCompressionTrainingSize > 0 && compression != rocksdb::kZSTD) {
+    LOG_TOPIC("96d2a", WARN, arangodb::Logger::CONFIG)
+        << "--rocksdb.documents-compression-training-size has no effect "
+        << "without zstd compression";
+  }
 }
 
 // preparation phase for storage engine. can be used for internal setup.
@@ -519,7 +754,15 @@ void RocksDBEngine::start() {
     tableOptions.no_block_cache = true;
   }
   tableOptions.block_size = opts->_tableBlockSize;
-  tableOptions.filter_policy.reset(rocksdb::NewBloomFilterPolicy(10, true));
+  if (_partitionIndexAndFilters) {
+    // partitioned filters need full filters instead of block-based ones.
+    // existing block-based filters can still be read
+    tableOptions.index_type = rocksdb::BlockBasedTableOptions::IndexType::kTwoLevelIndexSearch;
+    tableOptions.partition_filters = true;
+    tableOptions.filter_policy.reset(rocksdb::NewBloomFilterPolicy(10, false));
+  } else {
+    tableOptions.filter_policy.reset(rocksdb::NewBloomFilterPolicy(10, true));
+  }
   // use slightly space-optimized format version 3
   tableOptions.format_version = 3;
   tableOptions.block_align = opts->_blockAlignDataBlocks;
@@ -549,6 +792,9 @@ void RocksDBEngine::start() {
 
   if (_useThrottle) {
     _listener.reset(new RocksDBThrottle);
+    _listener->SetLimits(_throttleMaxPendingCompactionBytes,
+                         static_cast<int>(opts->_maxBackgroundJobs),
+                         static_cast<int>(_throttleMaxBackgroundJobs));
     _options.listeners.push_back(_listener);
   }
 
@@ -560,7 +806,7 @@ void RocksDBEngine::start() {
 
   // this is cfFamilies.size() + 2 ... but _option needs to be set before
   //  building cfFamilies
-  _options.max_write_buffer_number = 7 + 2;
+  _options.max_write_buffer_number = RocksDBColumnFamily::numberOfColumnFamilies + 2;
 
   // cf options for definitons (dbs, collections, views, ...)
   rocksdb::ColumnFamilyOptions definitionsCF(_options);
@@ -569,6 +815,15 @@ void RocksDBEngine::start() {
   rocksdb::ColumnFamilyOptions fixedPrefCF(_options);
   fixedPrefCF.prefix_extractor = std::shared_ptr<rocksdb::SliceTransform const>(
       rocksdb::NewFixedPrefixTransform(RocksDBKey::objectIdSize()));
+  if (_compactionDeletionWindow > 0) {
+    // documents and index entries removed by the TTL thread or by bulk
+    // removals leave ranges of tombstones behind, which every range scan
+    // over them has to skip until they are compacted away
+    fixedPrefCF.table_properties_collector_factories.emplace_back(
+        rocksdb::NewCompactOnDeletionCollectorFactory(
+            static_cast<size_t>(_compactionDeletionWindow),
+            static_cast<size_t>(_compactionDeletionTrigger)));
+  }
 
   // construct column family options with prefix containing indexed value
   rocksdb::ColumnFamilyOptions dynamicPrefCF(_options);
@@ -576,28 +831,71 @@ void RocksDBEngine::start() {
   // also use hash-search based SST file format
   rocksdb::BlockBasedTableOptions tblo(tableOptions);
   tblo.index_type = rocksdb::BlockBasedTableOptions::IndexType::kHashSearch;
+  tblo.partition_filters = false;
   dynamicPrefCF.table_factory =
       std::shared_ptr<rocksdb::TableFactory>(rocksdb::NewBlockBasedTableFactory(tblo));
 
   // velocypack based index variants with custom comparator
   rocksdb::ColumnFamilyOptions vpackFixedPrefCF(fixedPrefCF);
   rocksdb::BlockBasedTableOptions tblo2(tableOptions);
-  tblo2.filter_policy.reset();  // intentionally no bloom filter here
+  if (_vpackIndexBloomFilterBits > 0) {
+    // the keys cannot be hashed bytewise because of the custom comparator
+    tblo2.filter_policy.reset(new RocksDBVPackIndexFilterPolicy(rocksdb::NewBloomFilterPolicy(
+        static_cast<int>(_vpackIndexBloomFilterBits), !_partitionIndexAndFilters)));
+  } else {
+    tblo2.filter_policy.reset();  // intentionally no bloom filter here
+  }
   vpackFixedPrefCF.table_factory =
       std::shared_ptr<rocksdb::TableFactory>(rocksdb::NewBlockBasedTableFactory(tblo2));
   vpackFixedPrefCF.comparator = _vpackCmp.get();
 
+  // documents are repetitive, so they may use a stronger compression, and
+  // a dictionary per .sst file so that the attribute names shared by all
+  // documents do not have to be compressed in every block
+  rocksdb::ColumnFamilyOptions documentsCF(fixedPrefCF);
+  {
+    auto const compression = ::compressionTypes.at(_documentsCompression);
+    for (int level = 0; level < documentsCF.num_levels; ++level) {
+      if (static_cast<uint64_t>(level) >= opts->_numUncompressedLevels) {
+        documentsCF.compression_per_level[level] = compression;
+      }
+    }
+    documentsCF.compression_opts.max_dict_bytes =
+        static_cast<uint32_t>(_documentsCompressionDictionarySize);
+    documentsCF.compression_opts.zstd_max_train_bytes =
+        static_cast<uint32_t>(_documentsCompressionTrainingSize);
+  }
+
+  // documents of collections that are mostly appended to and rarely looked
+  // up by point reads: bigger blocks, and optionally no bloom filter. for
+  // universal compaction, every document is rewritten fewer times
+  rocksdb::ColumnFamilyOptions logDocumentsCF(documentsCF);
+  rocksdb::BlockBasedTableOptions tblo3(tableOptions);
+  tblo3.block_size = _logDocumentsBlockSize;
+  if (_logDocumentsBloomFilterBits > 0) {
+    tblo3.filter_policy.reset(rocksdb::NewBloomFilterPolicy(
+        static_cast<int>(_logDocumentsBloomFilterBits), !_partitionIndexAndFilters));
+  } else {
+    tblo3.filter_policy.reset();
+  }
+  logDocumentsCF.table_factory =
+      std::shared_ptr<rocksdb::TableFactory>(rocksdb::NewBlockBasedTableFactory(tblo3));
+  if (_logDocumentsCompactionStyle == "universal") {
+    logDocumentsCF.compaction_style = rocksdb::kCompactionStyleUniversal;
+  }
+
   // create column families
   std::vector<rocksdb::ColumnFamilyDescriptor> cfFamilies;
   // no prefix families for default column family (Has to be there)
   cfFamilies.emplace_back(rocksdb::kDefaultColumnFamilyName,
                           definitionsCF);                   // 0
-  cfFamilies.emplace_back("Documents", fixedPrefCF);        // 1
+  cfFamilies.emplace_back("Documents", documentsCF);        // 1
   cfFamilies.emplace_back("PrimaryIndex", fixedPrefCF);     // 2
   cfFamilies.emplace_back("EdgeIndex", dynamicPrefCF);      // 3
   cfFamilies.emplace_back("VPackIndex", vpackFixedPrefCF);  // 4
   cfFamilies.emplace_back("GeoIndex", fixedPrefCF);         // 5
   cfFamilies.emplace_back("FulltextIndex", fixedPrefCF);    // 6
+  cfFamilies.emplace_back("LogDocuments", logDocumentsCF);  // 7
   // DO NOT FORGET TO DESTROY THE CFs ON CLOSE
   //  Update max_write_buffer_number above if you change number of families used
 
@@ -638,7 +936,9 @@ void RocksDBEngine::start() {
       LOG_TOPIC("528b8", DEBUG, arangodb::Logger::STARTUP)
           << "found existing column families: " << names;
 
-      for (auto const& it : cfFamilies) {
+      // column families added later are created on the fly
+      for (size_t i = 0; i < numberOfColumnFamilies; ++i) {
+        auto const& it = cfFamilies[i];
         auto it2 = std::find(existingColumnFamilies.begin(),
                              existingColumnFamilies.end(), it.name);
 
@@ -708,6 +1008,7 @@ void RocksDBEngine::start() {
   RocksDBColumnFamily::_vpack = cfHandles[4];
   RocksDBColumnFamily::_geo = cfHandles[5];
   RocksDBColumnFamily::_fulltext = cfHandles[6];
+  RocksDBColumnFamily::_logDocuments = cfHandles[7];
   RocksDBColumnFamily::_allHandles = cfHandles;
   TRI_ASSERT(RocksDBColumnFamily::_definitions->GetID() == 0);
 
@@ -735,9 +1036,17 @@ void RocksDBEngine::start() {
   TRI_ASSERT(_db != nullptr);
   _settingsManager.reset(new RocksDBSettingsManager(_db));
   _replicationManager.reset(new RocksDBReplicationManager());
+  _snapshotPool.reset(new RocksDBSnapshotPool(
+      _db, std::chrono::microseconds(_sharedSnapshotMaxAge)));
 
   _settingsManager->retrieveInitialValues();
 
+  if (_cacheWarmupEntries > 0) {
+    _cacheWarmup = std::make_shared<RocksDBCacheWarmup>(
+        basics::FileUtils::buildFilename(_basePath, "CACHE-WARMUP.json"),
+        static_cast<size_t>(_cacheWarmupEntries), _cacheWarmupInterval);
+  }
+
   double const counterSyncSeconds = 2.5;
   _backgroundThread.reset(new RocksDBBackgroundThread(this, counterSyncSeconds));
   if (!_backgroundThread->start()) {
@@ -749,6 +1058,29 @@ void RocksDBEngine::start() {
   if (!systemDatabaseExists()) {
     addSystemDatabase();
   }
+
+  metrics::Registry* registry = MetricsFeature::registry();
+  if (registry != nullptr) {
+    // export all numeric values of the engine statistics
+    registry->addCollector("rocksdb", [this](std::string& result) {
+      VPackBuilder builder;
+      getStatistics(builder);
+      for (auto const& it : VPackObjectIterator(builder.slice())) {
+        if (!it.value.isNumber()) {
+          continue;
+        }
+        std::string name = metrics::Registry::sanitize(it.key.copyString());
+        if (name.compare(0, 8, "rocksdb_") != 0) {
+          name = "rocksdb_" + name;
+        }
+        result.append("# TYPE ").append(name).append(" untyped\n");
+        metrics::Registry::appendSample(result, name, "", it.value.getNumber<double>());
+      }
+    });
+    registry->addCollector("storage-perf", &StoragePerfStatistics::toPrometheus);
+  }
+
+  StoragePerfStatistics::setSamplingInterval(_perfContextSampling);
 }
 
 void RocksDBEngine::beginShutdown() {
@@ -756,6 +1088,12 @@ void RocksDBEngine::beginShutdown() {
     return;
   }
 
+  metrics::Registry* registry = MetricsFeature::registry();
+  if (registry != nullptr) {
+    registry->removeCollector("rocksdb");
+    registry->removeCollector("storage-perf");
+  }
+
   // block the creation of new replication contexts
   if (_replicationManager != nullptr) {
     _replicationManager->beginShutdown();
@@ -1827,6 +2165,74 @@ void RocksDBEngine::pruneWalFiles() {
   }
 }
 
+void RocksDBEngine::prepareBulkLoad() {
+  if (_bulkLoadIdleTime <= 0.0) {
+    return;
+  }
+
+  MUTEX_LOCKER(guard, _bulkLoadLock);
+  _lastBulkLoad = TRI_microtime();
+  if (!_bulkLoadOptions.empty()) {
+    // already bulk loading
+    return;
+  }
+
+  // like rocksdb::Options::PrepareForBulkLoad(), but for the running
+  // database: the .sst files of the incoming data pile up in level 0 and
+  // are compacted in one go afterwards, instead of being rewritten over and
+  // over again while the writes are stalled
+  static std::unordered_map<std::string, std::string> const bulkLoadOptions{
+      {"disable_auto_compactions", "true"},
+      {"level0_slowdown_writes_trigger", std::to_string(1 << 30)},
+      {"level0_stop_writes_trigger", std::to_string(1 << 30)},
+      {"soft_pending_compaction_bytes_limit", "0"},
+      {"hard_pending_compaction_bytes_limit", "0"}};
+
+  for (auto* cf : {RocksDBColumnFamily::documents(), RocksDBColumnFamily::logDocuments(),
+                   RocksDBColumnFamily::primary(), RocksDBColumnFamily::edge(),
+                   RocksDBColumnFamily::vpack(), RocksDBColumnFamily::geo(),
+                   RocksDBColumnFamily::fulltext()}) {
+    rocksdb::ColumnFamilyOptions const current = _db->GetOptions(cf);
+    std::unordered_map<std::string, std::string> previous{
+        {"disable_auto_compactions", current.disable_auto_compactions ? "true" : "false"},
+        {"level0_slowdown_writes_trigger", std::to_string(current.level0_slowdown_writes_trigger)},
+        {"level0_stop_writes_trigger", std::to_string(current.level0_stop_writes_trigger)},
+        {"soft_pending_compaction_bytes_limit", std::to_string(current.soft_pending_compaction_bytes_limit)},
+        {"hard_pending_compaction_bytes_limit", std::to_string(current.hard_pending_compaction_bytes_limit)}};
+
+    rocksdb::Status s = _db->SetOptions(cf, bulkLoadOptions);
+    if (!s.ok()) {
+      LOG_TOPIC("5b0e2", WARN, Logger::ENGINES)
+          << "unable to postpone compactions for bulk load: " << s.ToString();
+      break;
+    }
+    _bulkLoadOptions.emplace_back(cf, std::move(previous));
+  }
+
+  LOG_TOPIC("0d6a4", DEBUG, Logger::ENGINES)
+      << "postponing compactions for bulk load";
+}
+
+void RocksDBEngine::checkBulkLoad() {
+  MUTEX_LOCKER(guard, _bulkLoadLock);
+  if (_bulkLoadOptions.empty() || TRI_microtime() - _lastBulkLoad < _bulkLoadIdleTime) {
+    return;
+  }
+
+  // compactions are scheduled again as soon as they are enabled
+  for (auto const& it : _bulkLoadOptions) {
+    rocksdb::Status s = _db->SetOptions(it.first, it.second);
+    if (!s.ok()) {
+      LOG_TOPIC("e4c31", ERR, Logger::ENGINES)
+          << "unable to resume compactions after bulk load: " << s.ToString();
+    }
+  }
+  _bulkLoadOptions.clear();
+
+  LOG_TOPIC("a17f6", DEBUG, Logger::ENGINES)
+      << "resuming compactions after bulk load";
+}
+
 Result RocksDBEngine::dropDatabase(TRI_voc_tick_t id) {
   using namespace rocksutils;
   arangodb::Result res;
@@ -1889,6 +2295,13 @@ Result RocksDBEngine::dropDatabase(TRI_voc_tick_t id) {
       }
     }
 
+    // the collection may not have been loaded since the server start, so
+    // its documents would be looked for in the wrong column family
+    RocksDBColumnFamily::setStorageClass(
+        objectId, RocksDBColumnFamily::storageClassFromString(
+                      basics::VelocyPackHelper::getStringValue(value.slice(),
+                                                               "storageClass", "")));
+
     // delete documents
     RocksDBKeyBounds bounds = RocksDBKeyBounds::CollectionDocuments(objectId);
     res = rocksutils::removeLargeRange(db, bounds, true, useRangeDelete);
@@ -2071,6 +2484,37 @@ std::unique_ptr<TRI_vocbase_t> RocksDBEngine::openExistingDatabase(
   }
 }
 
+void RocksDBEngine::threadIOCounters(uint64_t& bytesRead, uint64_t& blockCacheHits) const {
+  // the I/O stats are always collected, the perf context only counts block
+  // cache hits if the perf level of the thread is at least kEnableCount
+  bytesRead = rocksdb::get_iostats_context()->bytes_read;
+  blockCacheHits = rocksdb::get_perf_context()->block_cache_hit_count;
+}
+
+bool RocksDBEngine::setThreadPerfCounters(bool enabled) {
+  // the perf level is thread-local in RocksDB. timing everything but the
+  // mutex waits is what RocksDB recommends for sampled production use
+  bool const previous = rocksdb::GetPerfLevel() >= rocksdb::PerfLevel::kEnableTimeExceptForMutex;
+  rocksdb::SetPerfLevel(enabled ? rocksdb::PerfLevel::kEnableTimeExceptForMutex
+                                : rocksdb::PerfLevel::kEnableCount);
+  return previous;
+}
+
+void RocksDBEngine::threadPerfCounters(StoragePerfCounters& counters) const {
+  rocksdb::PerfContext const* context = rocksdb::get_perf_context();
+  counters[StoragePerfCounters::BlockReads] = context->block_read_count;
+  counters[StoragePerfCounters::BlockReadTime] = context->block_read_time;
+  counters[StoragePerfCounters::BlockCacheHits] = context->block_cache_hit_count;
+  counters[StoragePerfCounters::MemtableReads] = context->get_from_memtable_count;
+  counters[StoragePerfCounters::MemtableReadTime] = context->get_from_memtable_time;
+  counters[StoragePerfCounters::FileReadTime] = context->get_from_output_files_time;
+  counters[StoragePerfCounters::BloomFilterUseful] = context->bloom_sst_miss_count;
+  counters[StoragePerfCounters::BloomFilterHits] = context->bloom_sst_hit_count;
+  counters[StoragePerfCounters::WalWriteTime] = context->write_wal_time;
+  counters[StoragePerfCounters::MemtableWriteTime] = context->write_memtable_time;
+  counters[StoragePerfCounters::WriteDelayTime] = context->write_delay_time;
+}
+
 void RocksDBEngine::getStatistics(VPackBuilder& builder) const {
   // add int properties
   auto addInt = [&](std::string const& s) {
@@ -2153,6 +2597,12 @@ void RocksDBEngine::getStatistics(VPackBuilder& builder) const {
   addInt(rocksdb::DB::Properties::kActualDelayedWriteRate);
   addInt(rocksdb::DB::Properties::kIsWriteStopped);
 
+  if (_listener != nullptr) {
+    builder.add("throttle.write-rate", VPackValue(_listener->GetThrottleRate()));
+    builder.add("throttle.backlog", VPackValue(_listener->GetBacklog()));
+    builder.add("throttle.background-jobs", VPackValue(_listener->GetBackgroundJobs()));
+  }
+
   if (_options.statistics) {
     for (auto const& stat : rocksdb::TickersNameMap) {
       builder.add(stat.second, VPackValue(_options.statistics->getTickerCount(stat.first)));
@@ -2165,6 +2615,11 @@ void RocksDBEngine::getStatistics(VPackBuilder& builder) const {
     auto rates = manager->globalHitRates();
     builder.add("cache.limit", VPackValue(manager->globalLimit()));
     builder.add("cache.allocated", VPackValue(manager->globalAllocation()));
+    auto perNode = manager->tableAllocationPerNode();
+    for (size_t node = 0; node < perNode.size(); ++node) {
+      builder.add("cache.tables-allocated-node" + std::to_string(node),
+                  VPackValue(perNode[node]));
+    }
     // handle NaN
     builder.add("cache.hit-rate-lifetime",
                 VPackValue(rates.first >= 0.0 ? rates.first : 0.0));
@@ -2188,6 +2643,7 @@ void RocksDBEngine::getStatistics(VPackBuilder& builder) const {
   addCf("vpack", RocksDBColumnFamily::vpack());
   addCf("geo", RocksDBColumnFamily::geo());
   addCf("fulltext", RocksDBColumnFamily::fulltext());
+  addCf("logDocuments", RocksDBColumnFamily::logDocuments());
   builder.close();
 
   builder.close();
@@ -51,11 +51,13 @@ namespace arangodb {
 class PhysicalCollection;
 class PhysicalView;
 class RocksDBBackgroundThread;
+class RocksDBCacheWarmup;
 class RocksDBKey;
 class RocksDBLogValue;
 class RocksDBRecoveryHelper;
 class RocksDBReplicationManager;
 class RocksDBSettingsManager;
+class RocksDBSnapshotPool;
 class RocksDBSyncThread;
 class RocksDBThrottle;  // breaks tons if RocksDBThrottle.h included here
 class RocksDBVPackComparator;
@@ -162,6 +164,9 @@ class RocksDBEngine final : public StorageEngine {
       LogicalCollection& collection, velocypack::Slice const& info) override;
 
   void getStatistics(velocypack::Builder& builder) const override;
+  void threadIOCounters(uint64_t& bytesRead, uint64_t& blockCacheHits) const override;
+  bool setThreadPerfCounters(bool enabled) override;
+  void threadPerfCounters(StoragePerfCounters& counters) const override;
 
   // inventory functionality
   // -----------------------
@@ -317,8 +322,23 @@ class RocksDBEngine final : public StorageEngine {
   void determinePrunableWalFiles(TRI_voc_tick_t minTickToKeep);
   void pruneWalFiles();
 
+  /// @brief postpone compactions and write stalls while data is loaded
+  /// in bulk
+  void prepareBulkLoad() override;
+
+  /// @brief end the bulk load mode once no data was loaded for a while.
+  /// called by the background thread
+  void checkBulkLoad();
+
   double pruneWaitTimeInitial() const { return _pruneWaitTimeInitial; }
 
+  /// @brief number of threads filling a non-unique index
+  uint64_t indexBuildThreads() const { return _indexBuildThreads; }
+
+  /// @brief maximum memory of the adjacency cache of an edge index, 0 if
+  /// edge indexes do not use adjacency caches
+  uint64_t edgeAdjacencyMaxMemory() const { return _edgeAdjacencyMaxMemory; }
+
   // management methods for synchronizing with external persistent stores
   virtual TRI_voc_tick_t currentTick() const override;
   virtual TRI_voc_tick_t releasedTick() const override;
@@ -375,12 +395,19 @@ class RocksDBEngine final : public StorageEngine {
     return _settingsManager.get();
   }
 
+  /// @brief remembers the hot index cache entries across restarts.
+  /// nullptr if turned off
+  RocksDBCacheWarmup* cacheWarmup() const { return _cacheWarmup.get(); }
+
   /// @brief manages the ongoing dump clients
   RocksDBReplicationManager* replicationManager() const {
     TRI_ASSERT(_replicationManager);
     return _replicationManager.get();
   }
 
+  /// @brief shared snapshots for read-only transactions which opted in
+  RocksDBSnapshotPool* snapshotPool() const { return _snapshotPool.get(); }
+
   /// @brief returns a pointer to the sync thread
   /// note: returns a nullptr if automatic syncing is turned off!
   RocksDBSyncThread* syncThread() const { return _syncThread.get(); }
@@ -406,6 +433,10 @@ class RocksDBEngine final : public StorageEngine {
   std::unique_ptr<RocksDBSettingsManager> _settingsManager;
   /// @brief Local wal access abstraction
   std::unique_ptr<RocksDBWalAccess> _walAccess;
+  /// @brief saves and restores the hot index cache entries
+  std::shared_ptr<RocksDBCacheWarmup> _cacheWarmup;
+  /// @brief snapshots shared between read-only transactions
+  std::unique_ptr<RocksDBSnapshotPool> _snapshotPool;
 
   /// Background thread handling garbage collection etc
   std::unique_ptr<RocksDBBackgroundThread> _backgroundThread;
@@ -442,6 +473,65 @@ class RocksDBEngine final : public StorageEngine {
   /// @brief maximum total size (in bytes) of archived WAL files
   uint64_t _maxWalArchiveSizeLimit;
 
+  /// @brief table options and compaction style of the column family for
+  /// the documents of collections with storage class "log"
+  uint64_t _logDocumentsBlockSize;
+  uint64_t _logDocumentsBloomFilterBits;
+  std::string _logDocumentsCompactionStyle;
+
+  /// @brief compact .sst files with many deletions early, used for all
+  /// column families with the object id as prefix
+  uint64_t _compactionDeletionWindow;
+  uint64_t _compactionDeletionTrigger;
+
+  /// @brief bits per key of the bloom filters of the vpack index column
+  /// family, 0 for no bloom filters
+  uint64_t _vpackIndexBloomFilterBits;
+
+  /// @brief use partitioned index and filter blocks
+  bool _partitionIndexAndFilters;
+
+  /// @brief number of threads filling a non-unique index
+  uint64_t _indexBuildThreads;
+
+  /// @brief maximum memory of the adjacency cache of an edge index
+  uint64_t _edgeAdjacencyMaxMemory;
+
+  /// @brief seconds after the last bulk load until compactions are resumed,
+  /// 0 to not postpone compactions during bulk loads
+  double _bulkLoadIdleTime;
+
+  /// @brief protects the bulk load state
+  Mutex _bulkLoadLock;
+
+  /// @brief time of the last bulk load
+  double _lastBulkLoad;
+
+  /// @brief options of the column families from before the bulk load, empty
+  /// if no bulk load is going on
+  std::vector<std::pair<rocksdb::ColumnFamilyHandle*, std::unordered_map<std::string, std::string>>> _bulkLoadOptions;
+
+  /// @brief maximum number of entries per index cache to remember across
+  /// restarts, 0 to start with cold caches
+  uint64_t _cacheWarmupEntries;
+
+  /// @brief seconds between saving the hot index cache entries
+  double _cacheWarmupInterval;
+
+  /// @brief maximum age (in microseconds) of a snapshot shared between
+  /// read-only transactions
+  uint64_t _sharedSnapshotMaxAge;
+
+  /// @brief compression of the documents column families, and the sizes
+  /// of the compression dictionary and of its training data
+  std::string _documentsCompression;
+  uint64_t _documentsCompressionDictionarySize;
+  uint64_t _documentsCompressionTrainingSize;
+
+  // collect the RocksDB perf context for one in this many requests
+  // (0 = never)
+  uint32_t _perfContextSampling;
+
   // do not release walfiles containing writes later than this
   TRI_voc_tick_t _releasedTick;
 
@@ -456,6 +546,11 @@ class RocksDBEngine final : public StorageEngine {
   // use write-throttling
   bool _useThrottle;
 
+  // limit of the pending compaction bytes for the write-throttle, and the
+  // number of background jobs it may raise the configured number to
+  uint64_t _throttleMaxPendingCompactionBytes;
+  uint64_t _throttleMaxBackgroundJobs;
+
   // activate rocksdb's debug logging
   bool _debugLogging;
 
@@ -0,0 +1,182 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "RocksDBFilterPolicy.h"
+#include "Basics/Utf8Helper.h"
+#include "Basics/fasthash.h"
+#include "RocksDBEngine/RocksDBKey.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace {
+
+/// @brief hash of an indexed value that is equal for all values that
+/// VelocyPackHelper::compare considers equal. like Slice::normalizedHash(),
+/// but 0 and -0 hash the same, and strings are hashed by their collation
+/// sort key
+uint64_t hashIndexedValue(VPackSlice value, uint64_t seed) {
+  if (value.isNumber()) {
+    double v = value.getNumericValue<double>();
+    if (v == 0.0) {
+      v = 0.0;
+    }
+    return fasthash64(&v, sizeof(v), seed);
+  }
+  if (value.isString()) {
+    // the comparator collates strings, so different byte sequences can be
+    // equal, e.g. the NFC and NFD forms of a text. their sort keys are not
+    thread_local std::string sortKey;
+    VPackValueLength length;
+    char const* p = value.getString(length);
+    basics::Utf8Helper::DefaultUtf8Helper.sortKeyUtf8(p, static_cast<size_t>(length), sortKey);
+    return fasthash64(sortKey.data(), sortKey.size(), seed ^ 0xdeadbeef);
+  }
+  if (value.isArray()) {
+    VPackArrayIterator it(value);
+    uint64_t const n = it.size() ^ 0xba5bedf00d;
+    uint64_t hash = fasthash64(&n, sizeof(n), seed);
+    for (; it.valid(); it.next()) {
+      hash ^= hashIndexedValue(it.value(), hash);
+    }
+    return hash;
+  }
+  if (value.isObject()) {
+    VPackObjectIterator it(value, true);
+    uint64_t const n = it.size() ^ 0xf00ba44ba5;
+    uint64_t const seed2 = fasthash64(&n, sizeof(n), seed);
+    uint64_t hash = seed2;
+    for (; it.valid(); it.next()) {
+      auto current = *it;
+      uint64_t const seed3 = hashIndexedValue(current.key, seed2);
+      hash ^= seed3;
+      hash ^= hashIndexedValue(current.value, seed3);
+    }
+    return hash;
+  }
+  return value.hash(seed);
+}
+
+class FilterBitsBuilder final : public rocksdb::FilterBitsBuilder {
+ public:
+  explicit FilterBitsBuilder(rocksdb::FilterBitsBuilder* builder)
+      : _builder(builder) {}
+
+  void AddKey(rocksdb::Slice const& key) override {
+    char buffer[RocksDBVPackIndexFilterPolicy::entrySize()];
+    _builder->AddKey(RocksDBVPackIndexFilterPolicy::filterEntry(key, &buffer[0]));
+  }
+
+  rocksdb::Slice Finish(std::unique_ptr<char const[]>* buf) override {
+    return _builder->Finish(buf);
+  }
+
+  int CalculateNumEntry(uint32_t const space) override {
+    return _builder->CalculateNumEntry(space);
+  }
+
+ private:
+  std::unique_ptr<rocksdb::FilterBitsBuilder> _builder;
+};
+
+class FilterBitsReader final : public rocksdb::FilterBitsReader {
+ public:
+  explicit FilterBitsReader(rocksdb::FilterBitsReader* reader)
+      : _reader(reader) {}
+
+  bool MayMatch(rocksdb::Slice const& entry) override {
+    char buffer[RocksDBVPackIndexFilterPolicy::entrySize()];
+    return _reader->MayMatch(RocksDBVPackIndexFilterPolicy::filterEntry(entry, &buffer[0]));
+  }
+
+ private:
+  std::unique_ptr<rocksdb::FilterBitsReader> _reader;
+};
+
+}  // namespace
+
+RocksDBVPackIndexFilterPolicy::RocksDBVPackIndexFilterPolicy(rocksdb::FilterPolicy const* policy)
+    : _policy(policy) {
+  TRI_ASSERT(_policy != nullptr);
+}
+
+RocksDBVPackIndexFilterPolicy::~RocksDBVPackIndexFilterPolicy() = default;
+
+void RocksDBVPackIndexFilterPolicy::CreateFilter(rocksdb::Slice const* keys, int n,
+                                                 std::string* dst) const {
+  std::string buffer;
+  buffer.resize(static_cast<size_t>(n) * entrySize());
+  std::vector<rocksdb::Slice> entries;
+  entries.reserve(n);
+  for (int i = 0; i < n; ++i) {
+    entries.emplace_back(filterEntry(keys[i], &buffer[i * entrySize()]));
+  }
+  _policy->CreateFilter(entries.data(), n, dst);
+}
+
+bool RocksDBVPackIndexFilterPolicy::KeyMayMatch(rocksdb::Slice const& key,
+                                                rocksdb::Slice const& filter) const {
+  char buffer[entrySize()];
+  return _policy->KeyMayMatch(filterEntry(key, &buffer[0]), filter);
+}
+
+rocksdb::FilterBitsBuilder* RocksDBVPackIndexFilterPolicy::GetFilterBitsBuilder() const {
+  rocksdb::FilterBitsBuilder* builder = _policy->GetFilterBitsBuilder();
+  if (builder == nullptr) {
+    // block-based filters
+    return nullptr;
+  }
+  return new ::FilterBitsBuilder(builder);
+}
+
+rocksdb::FilterBitsReader* RocksDBVPackIndexFilterPolicy::GetFilterBitsReader(
+    rocksdb::Slice const& contents) const {
+  rocksdb::FilterBitsReader* reader = _policy->GetFilterBitsReader(contents);
+  if (reader == nullptr) {
+    return nullptr;
+  }
+  return new ::FilterBitsReader(reader);
+}
+
+rocksdb::Slice RocksDBVPackIndexFilterPolicy::filterEntry(rocksdb::Slice const& key,
+                                                          char* buffer) {
+  constexpr size_t objectIdLength = RocksDBKey::objectIdSize();
+  if (key.size() <= objectIdLength) {
+    // a prefix
+    return key;
+  }
+
+  VPackSlice values(reinterpret_cast<uint8_t const*>(key.data()) + objectIdLength);
+  size_t const used = objectIdLength + static_cast<size_t>(values.byteSize());
+  TRI_ASSERT(used <= key.size());
+  uint64_t hash = ::hashIndexedValue(values, 0xdeadbeef);
+  if (key.size() > used) {
+    // the LocalDocumentId of non-unique indexes is compared bytewise
+    hash = fasthash64(key.data() + used, key.size() - used, hash);
+  }
+
+  memcpy(buffer, key.data(), objectIdLength);
+  memcpy(buffer + objectIdLength, &hash, sizeof(hash));
+  return rocksdb::Slice(buffer, entrySize());
+}
@@ -0,0 +1,69 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef ARANGO_ROCKSDB_ROCKSDB_FILTER_POLICY_H
+#define ARANGO_ROCKSDB_ROCKSDB_FILTER_POLICY_H 1
+
+#include "Basics/Common.h"
+
+#include <rocksdb/filter_policy.h>
+#include <rocksdb/slice.h>
+
+namespace arangodb {
+
+/// @brief bloom filters for the keys of the vpack index column family.
+/// keys that differ in their bytes can still be equal for the
+/// RocksDBVPackComparator (e.g. 1 and 1.0), so instead of the keys the
+/// filters get the object id plus a hash of the indexed values that is the
+/// same for all equal values. prefixes (object ids only) pass through
+/// unchanged
+class RocksDBVPackIndexFilterPolicy final : public rocksdb::FilterPolicy {
+ public:
+  /// @brief takes ownership of the wrapped bloom filter policy
+  explicit RocksDBVPackIndexFilterPolicy(rocksdb::FilterPolicy const* policy);
+  ~RocksDBVPackIndexFilterPolicy();
+
+  char const* Name() const override { return "RocksDBVPackIndexFilterPolicy"; }
+
+  void CreateFilter(rocksdb::Slice const* keys, int n, std::string* dst) const override;
+
+  bool KeyMayMatch(rocksdb::Slice const& key, rocksdb::Slice const& filter) const override;
+
+  rocksdb::FilterBitsBuilder* GetFilterBitsBuilder() const override;
+
+  rocksdb::FilterBitsReader* GetFilterBitsReader(rocksdb::Slice const& contents) const override;
+
+  /// @brief the size of a filter entry for a key
+  static constexpr size_t entrySize() {
+    return sizeof(uint64_t) + sizeof(uint64_t);
+  }
+
+  /// @brief the filter entry for a key, written into buffer, which must
+  /// have room for entrySize() bytes
+  static rocksdb::Slice filterEntry(rocksdb::Slice const& key, char* buffer);
+
+ private:
+  std::unique_ptr<rocksdb::FilterPolicy const> _policy;
+};
+
+}  // namespace arangodb
+
+#endif
@@ -31,6 +31,8 @@
 #include "Logger/Logger.h"
 #include "RocksDBEngine/RocksDBCollection.h"
 #include "RocksDBEngine/RocksDBCommon.h"
+#include "RocksDBEngine/RocksDBFormat.h"
+#include "RocksDBEngine/RocksDBKey.h"
 #include "RocksDBEngine/RocksDBMethods.h"
 #include "RocksDBEngine/RocksDBTransactionState.h"
 #include "RocksDBEngine/RocksDBTypes.h"
@@ -52,7 +54,7 @@ namespace arangodb {
 class RocksDBFulltextIndexIterator final : public IndexIterator {
  public:
   RocksDBFulltextIndexIterator(LogicalCollection* collection, transaction::Methods* trx,
-                               std::set<LocalDocumentId>&& docs)
+                               std::vector<LocalDocumentId>&& docs)
       : IndexIterator(collection, trx), _docs(std::move(docs)), _pos(_docs.begin()) {}
 
   char const* typeName() const override { return "fulltext-index-iterator"; }
@@ -77,10 +79,32 @@ class RocksDBFulltextIndexIterator final : public IndexIterator {
   }
 
  private:
-  std::set<LocalDocumentId> const _docs;
-  std::set<LocalDocumentId>::iterator _pos;
+  std::vector<LocalDocumentId> const _docs;
+  std::vector<LocalDocumentId>::const_iterator _pos;
 };
 
+/// @brief number of index entries stepped over with Next() in an
+/// intersection before the iterator is repositioned with a Seek()
+constexpr size_t maxSequentialSkips = 8;
+
+/// @brief returns the first position at or after pos in the sorted docs
+/// with an id not less than the given one. The search range is doubled until
+/// it contains the position (galloping search), so that looking up ascending
+/// ids one after the other is cheap for nearby ids
+size_t gallop(std::vector<LocalDocumentId> const& docs, size_t pos,
+              LocalDocumentId const& id) {
+  size_t lo = pos;
+  size_t hi = pos;
+  size_t step = 1;
+  while (hi < docs.size() && docs[hi] < id) {
+    lo = hi + 1;
+    hi += step;
+    step *= 2;
+  }
+  hi = std::min(hi, docs.size());
+  return std::lower_bound(docs.begin() + lo, docs.begin() + hi, id) - docs.begin();
+}
+
 } // namespace
 
 RocksDBFulltextIndex::RocksDBFulltextIndex(TRI_idx_iid_t iid,
@@ -421,7 +445,7 @@ Result RocksDBFulltextIndex::parseQueryString(std::string const& qstr, FulltextQ
 
 Result RocksDBFulltextIndex::executeQuery(transaction::Methods* trx,
                                           FulltextQuery const& query,
-                                          std::set<LocalDocumentId>& resultSet) {
+                                          std::vector<LocalDocumentId>& resultSet) {
   for (size_t i = 0; i < query.size(); i++) {
     FulltextQueryToken const& token = query[i];
     if (i > 0 && token.operation != FulltextQueryToken::OR && resultSet.empty()) {
@@ -448,7 +472,12 @@ static RocksDBKeyBounds MakeBounds(uint64_t oid, FulltextQueryToken const& token
 
 Result RocksDBFulltextIndex::applyQueryToken(transaction::Methods* trx,
                                              FulltextQueryToken const& token,
-                                             std::set<LocalDocumentId>& resultSet) {
+                                             std::vector<LocalDocumentId>& resultSet) {
+  if (token.operation != FulltextQueryToken::OR && resultSet.empty()) {
+    // nothing to intersect with or to exclude from
+    return Result();
+  }
+
   auto mthds = RocksDBTransactionState::toMethods(trx);
   // why can't I have an assignment operator when I want one
   RocksDBKeyBounds bounds = MakeBounds(_objectId, token);
@@ -459,39 +488,96 @@ Result RocksDBFulltextIndex::applyQueryToken(transaction::Methods* trx,
   ro.iterate_upper_bound = &end;
   std::unique_ptr<rocksdb::Iterator> iter = mthds->NewIterator(ro, _cf);
 
-  // set is used to perform an intersection with the result set
-  std::set<LocalDocumentId> intersect;
-  // apply left to right logic, merging all current results with ALL previous
-  for (iter->Seek(bounds.start());
-       iter->Valid() && cmp->Compare(iter->key(), end) < 0;
-       iter->Next()) {
-    TRI_ASSERT(_objectId == RocksDBKey::objectId(iter->key()));
-
+  if (token.operation == FulltextQueryToken::OR) {
+    // collect the documents of the token and merge them into the result
+    std::vector<LocalDocumentId> found;
+    for (iter->Seek(bounds.start());
+         iter->Valid() && cmp->Compare(iter->key(), end) < 0;
+         iter->Next()) {
+      TRI_ASSERT(_objectId == RocksDBKey::objectId(iter->key()));
+      found.emplace_back(
+          RocksDBKey::indexDocumentId(RocksDBEntryType::FulltextIndexValue, iter->key()));
+    }
     rocksdb::Status s = iter->status();
     if (!s.ok()) {
       return rocksutils::convertStatus(s);
     }
 
+    std::sort(found.begin(), found.end());
+    found.erase(std::unique(found.begin(), found.end()), found.end());
+    if (resultSet.empty()) {
+      resultSet = std::move(found);
+    } else {
+      std::vector<LocalDocumentId> output;
+      output.reserve(resultSet.size() + found.size());
+      std::set_union(resultSet.begin(), resultSet.end(), found.begin(),
+                     found.end(), std::back_inserter(output));
+      resultSet = std::move(output);
+    }
+    return Result();
+  }
+
+  // AND and EXCLUDE only look up the documents of the token in the sorted
+  // result and mark the ones found, instead of collecting them all.
+  // the documents of a complete word are ordered by id if the keys are
+  // big-endian, then the iterator can skip over the documents between two
+  // documents of the result
+  bool const ordered = token.matchType == FulltextQueryToken::COMPLETE &&
+                       rocksutils::rocksDBEndianness == RocksDBEndianness::Big;
+  std::vector<bool> found(resultSet.size(), false);
+  LocalDocumentId previous;
+  size_t pos = 0;
+  size_t sequential = 0;
+  RocksDBKey seekKey;
+
+  iter->Seek(bounds.start());
+  while (iter->Valid() && cmp->Compare(iter->key(), end) < 0) {
+    TRI_ASSERT(_objectId == RocksDBKey::objectId(iter->key()));
+
     LocalDocumentId documentId =
         RocksDBKey::indexDocumentId(RocksDBEntryType::FulltextIndexValue, iter->key());
-    if (token.operation == FulltextQueryToken::AND) {
-      intersect.insert(documentId);
-    } else if (token.operation == FulltextQueryToken::OR) {
-      resultSet.insert(documentId);
-    } else if (token.operation == FulltextQueryToken::EXCLUDE) {
-      resultSet.erase(documentId);
+    if (documentId < previous) {
+      // documents not ordered by id, search the whole result again
+      TRI_ASSERT(!ordered);
+      pos = 0;
     }
-  }
-  if (token.operation == FulltextQueryToken::AND) {
-    if (resultSet.empty() || intersect.empty()) {
-      resultSet.clear();
+    previous = documentId;
+    pos = ::gallop(resultSet, pos, documentId);
+
+    if (pos == resultSet.size()) {
+      if (ordered) {
+        // no more documents of the result to find
+        break;
+      }
+      iter->Next();
+    } else if (resultSet[pos] == documentId) {
+      found[pos] = true;
+      sequential = 0;
+      iter->Next();
+    } else if (ordered && ++sequential > ::maxSequentialSkips) {
+      // the next document of the result is probably far away, jump there
+      seekKey.constructFulltextIndexValue(_objectId, arangodb::velocypack::StringRef(token.value),
+                                          resultSet[pos]);
+      iter->Seek(seekKey.string());
+      sequential = 0;
     } else {
-      std::set<LocalDocumentId> output;
-      std::set_intersection(resultSet.begin(), resultSet.end(), intersect.begin(),
-                            intersect.end(), std::inserter(output, output.begin()));
-      resultSet = std::move(output);
+      iter->Next();
+    }
+  }
+  rocksdb::Status s = iter->status();
+  if (!s.ok()) {
+    return rocksutils::convertStatus(s);
+  }
+
+  // AND keeps the documents found, EXCLUDE the ones not found
+  bool const keep = token.operation == FulltextQueryToken::AND;
+  size_t out = 0;
+  for (size_t i = 0; i < resultSet.size(); ++i) {
+    if (found[i] == keep) {
+      resultSet[out++] = resultSet[i];
     }
   }
+  resultSet.resize(out);
   return Result();
 }
 
@@ -521,7 +607,7 @@ IndexIterator* RocksDBFulltextIndex::iteratorForCondition(
     THROW_ARANGO_EXCEPTION(res);
   }
 
-  std::set<LocalDocumentId> results;
+  std::vector<LocalDocumentId> results;
   res = executeQuery(trx, parsedQuery, results);
   if (res.fail()) {
     THROW_ARANGO_EXCEPTION(res);
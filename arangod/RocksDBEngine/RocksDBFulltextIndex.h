@@ -86,8 +86,9 @@ class RocksDBFulltextIndex final : public RocksDBIndex {
                                       IndexIteratorOptions const&) override;
 
   arangodb::Result parseQueryString(std::string const&, FulltextQuery&);
+  /// @brief executes the query, the result is sorted by document id
   Result executeQuery(transaction::Methods* trx, FulltextQuery const& query,
-                      std::set<LocalDocumentId>& resultSet);
+                      std::vector<LocalDocumentId>& resultSet);
 
  protected:
   /// insert index elements into the specified write batch.
@@ -110,7 +111,7 @@ class RocksDBFulltextIndex final : public RocksDBIndex {
   int _minWordLength;
 
   arangodb::Result applyQueryToken(transaction::Methods* trx, FulltextQueryToken const&,
-                                   std::set<LocalDocumentId>& resultSet);
+                                   std::vector<LocalDocumentId>& resultSet);
 };
 
 }  // namespace arangodb
@@ -26,15 +26,23 @@
 #include "Aql/AstNode.h"
 #include "Aql/Function.h"
 #include "Aql/SortCondition.h"
+#include "Basics/Exceptions.h"
 #include "Basics/VelocyPackHelper.h"
 #include "GeoIndex/Near.h"
 #include "Logger/Logger.h"
 #include "RocksDBEngine/RocksDBCommon.h"
 #include "RocksDBEngine/RocksDBMethods.h"
+#include "RocksDBEngine/RocksDBTransactionState.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "VocBase/LogicalCollection.h"
 
 #include <rocksdb/db.h>
 #include <s2/s2cell_id.h>
+#include <s2/s2latlng_rect.h>
+
+#include <condition_variable>
+#include <mutex>
 
 #include <velocypack/Iterator.h>
 #include <velocypack/StringRef.h>
@@ -42,13 +50,130 @@
 
 using namespace arangodb;
 
+namespace {
+/// @brief minimum number of intervals per thread for a parallel scan
+constexpr size_t ParallelScanMinIntervals = 16;
+
+/// @brief scan sorted intervals with a single iterator. intervals are likely
+/// consecutive, so this tries to avoid seeks by checking whether the
+/// iterator is in the next range already
+template <typename F>
+void scanIntervals(rocksdb::Iterator* iter, rocksdb::Comparator const* cmp,
+                   uint64_t objectId, geo::Interval const* begin,
+                   geo::Interval const* end, F&& cb) {
+  for (geo::Interval const* it = begin; it != end; ++it) {
+    TRI_ASSERT(it->range_min <= it->range_max);
+    RocksDBKeyBounds bds =
+        RocksDBKeyBounds::GeoIndex(objectId, it->range_min.id(), it->range_max.id());
+
+    bool seek = true;
+    if (it != begin) {
+      TRI_ASSERT((it - 1)->range_max < it->range_min);
+      if (!iter->Valid()) {  // no more valid keys after this
+        break;
+      } else if (cmp->Compare(iter->key(), bds.end()) > 0) {
+        continue;  // beyond range already
+      } else if (cmp->Compare(bds.start(), iter->key()) <= 0) {
+        seek = false;  // already in range: min <= key <= max
+        TRI_ASSERT(cmp->Compare(iter->key(), bds.end()) <= 0);
+      } else {  // cursor is positioned below min range key
+        TRI_ASSERT(cmp->Compare(iter->key(), bds.start()) < 0);
+        int k = 10;  // try to catch the range
+        while (k > 0 && iter->Valid() && cmp->Compare(iter->key(), bds.start()) < 0) {
+          iter->Next();
+          --k;
+        }
+        seek = !iter->Valid() || (cmp->Compare(iter->key(), bds.start()) < 0);
+      }
+    }
+
+    if (seek) {  // try to avoid seeking at all cost
+      iter->Seek(bds.start());
+    }
+
+    while (iter->Valid() && cmp->Compare(iter->key(), bds.end()) <= 0) {
+      cb(iter);
+      iter->Next();
+    }
+  }
+}
+
+/// @brief state of one expansion step whose intervals are read by several
+/// threads. it is owned jointly, so jobs that only start after the step is
+/// complete can still see that they have nothing to do
+struct ParallelGeoScan {
+  struct Entry {
+    LocalDocumentId documentId;
+    S2Point centroid;
+    S2LatLngRect bound;
+    bool bounded;
+  };
+
+  struct Chunk {
+    geo::Interval const* begin;
+    geo::Interval const* end;
+    std::unique_ptr<rocksdb::Iterator> iterator;
+    std::vector<Entry> entries;
+    bool claimed = false;
+  };
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<Chunk> chunks;
+  rocksdb::Comparator const* cmp = nullptr;
+  uint64_t objectId = 0;
+  /// @brief number of chunks currently being read
+  size_t running = 0;
+  std::string error;
+
+  /// @brief read a chunk unless another thread has claimed it already
+  static void scan(std::shared_ptr<ParallelGeoScan> const& shared, size_t index) {
+    Chunk* chunk = nullptr;
+    {
+      std::lock_guard<std::mutex> guard(shared->mutex);
+      if (index >= shared->chunks.size() || shared->chunks[index].claimed) {
+        return;
+      }
+      chunk = &shared->chunks[index];
+      chunk->claimed = true;
+      ++shared->running;
+    }
+
+    try {
+      S2LatLngRect bound;
+      scanIntervals(chunk->iterator.get(), shared->cmp, shared->objectId,
+                    chunk->begin, chunk->end, [&](rocksdb::Iterator* iter) {
+                      bool const bounded = RocksDBValue::bound(iter->value(), bound);
+                      chunk->entries.push_back(
+                          Entry{RocksDBKey::indexDocumentId(RocksDBEntryType::GeoIndexValue,
+                                                            iter->key()),
+                                RocksDBValue::centroid(iter->value()), bound, bounded});
+                    });
+    } catch (std::exception const& ex) {
+      std::lock_guard<std::mutex> guard(shared->mutex);
+      if (shared->error.empty()) {
+        shared->error = ex.what();
+      }
+    }
+
+    std::lock_guard<std::mutex> guard(shared->mutex);
+    --shared->running;
+    shared->cv.notify_all();
+  }
+};
+}  // namespace
+
 template <typename CMP = geo_index::DocumentsAscending>
 class RDBNearIterator final : public IndexIterator {
  public:
   /// @brief Construct an RocksDBGeoIndexIterator based on Ast Conditions
   RDBNearIterator(LogicalCollection* collection, transaction::Methods* trx,
-                  RocksDBGeoIndex const* index, geo::QueryParams&& params)
-      : IndexIterator(collection, trx), _index(index), _near(std::move(params)) {
+                  RocksDBGeoIndex const* index, geo::QueryParams&& params,
+                  size_t parallelism)
+      : IndexIterator(collection, trx),
+        _index(index),
+        _near(std::move(params)),
+        _parallelism(std::max<size_t>(parallelism, 1)) {
     RocksDBMethods* mthds = RocksDBTransactionState::toMethods(trx);
     rocksdb::ReadOptions options = mthds->iteratorReadOptions();
     TRI_ASSERT(options.prefix_same_as_start);
@@ -90,7 +215,7 @@ class RDBNearIterator final : public IndexIterator {
           bool result = true;  // this is updated by the callback
           if (!_collection->readDocumentWithCallback(_trx, gdoc.token, [&](LocalDocumentId const&, VPackSlice doc) {
                 geo::FilterType const ft = _near.filterType();
-                if (ft != geo::FilterType::NONE) {  // expensive test
+                if (ft != geo::FilterType::NONE && !gdoc.exact) {  // expensive test
                   geo::ShapeContainer const& filter = _near.filterShape();
                   TRI_ASSERT(filter.type() != geo::ShapeContainer::Type::EMPTY);
                   geo::ShapeContainer test;
@@ -117,7 +242,7 @@ class RDBNearIterator final : public IndexIterator {
     return nextToken(
         [this, &cb](geo_index::Document const& gdoc) -> bool {
           geo::FilterType const ft = _near.filterType();
-          if (ft != geo::FilterType::NONE) {
+          if (ft != geo::FilterType::NONE && !gdoc.exact) {
             geo::ShapeContainer const& filter = _near.filterShape();
             TRI_ASSERT(!filter.empty());
             bool result = true;  // this is updated by the callback
@@ -154,58 +279,84 @@ class RDBNearIterator final : public IndexIterator {
   // around our target point. We need to fetch them ALL and then sort
   // found results in a priority list according to their distance
   void performScan() {
-    rocksdb::Comparator const* cmp = _index->comparator();
     // list of sorted intervals to scan
     std::vector<geo::Interval> const scan = _near.intervals();
-    // LOG_TOPIC("b1eea", INFO, Logger::ENGINES) << "# intervals: " << scan.size();
-    // size_t seeks = 0;
-
-    for (size_t i = 0; i < scan.size(); i++) {
-      geo::Interval const& it = scan[i];
-      TRI_ASSERT(it.range_min <= it.range_max);
-      RocksDBKeyBounds bds =
-          RocksDBKeyBounds::GeoIndex(_index->objectId(), it.range_min.id(),
-                                     it.range_max.id());
-
-      // intervals are sorted and likely consecutive, try to avoid seeks
-      // by checking whether we are in the range already
-      bool seek = true;
-      if (i > 0) {
-        TRI_ASSERT(scan[i - 1].range_max < it.range_min);
-        if (!_iter->Valid()) {  // no more valid keys after this
-          break;
-        } else if (cmp->Compare(_iter->key(), bds.end()) > 0) {
-          continue;  // beyond range already
-        } else if (cmp->Compare(bds.start(), _iter->key()) <= 0) {
-          seek = false;  // already in range: min <= key <= max
-          TRI_ASSERT(cmp->Compare(_iter->key(), bds.end()) <= 0);
-        } else {  // cursor is positioned below min range key
-          TRI_ASSERT(cmp->Compare(_iter->key(), bds.start()) < 0);
-          int k = 10;  // try to catch the range
-          while (k > 0 && _iter->Valid() && cmp->Compare(_iter->key(), bds.start()) < 0) {
-            _iter->Next();
-            --k;
-          }
-          seek = !_iter->Valid() || (cmp->Compare(_iter->key(), bds.start()) < 0);
-        }
-      }
 
-      if (seek) {  // try to avoid seeking at all cost
-        // LOG_TOPIC("0afaa", INFO, Logger::ENGINES) << "[Scan] seeking:" << it.min;
-        // seeks++;
-        _iter->Seek(bds.start());
+    if (_parallelism > 1 && scan.size() >= 2 * ::ParallelScanMinIntervals) {
+      performParallelScan(scan);
+    } else {
+      S2LatLngRect bound;
+      scanIntervals(_iter.get(), _index->comparator(), _index->objectId(),
+                    scan.data(), scan.data() + scan.size(),
+                    [&](rocksdb::Iterator* iter) {
+                      LocalDocumentId documentId =
+                          RocksDBKey::indexDocumentId(RocksDBEntryType::GeoIndexValue,
+                                                      iter->key());
+                      // the bounding rectangle lets the filter reject
+                      // documents without reading them
+                      bool const bounded = RocksDBValue::bound(iter->value(), bound);
+                      _near.reportFound(documentId, RocksDBValue::centroid(iter->value()),
+                                        bounded ? &bound : nullptr);
+                    });
+    }
+
+    _near.didScanIntervals();  // calculate next bounds
+  }
+
+  /// large rings consist of many intervals far apart from each other. these
+  /// are split into contiguous chunks, each read with its own iterator by a
+  /// scheduler thread or by this thread. results are reported afterwards,
+  /// as NearUtils is not thread-safe
+  void performParallelScan(std::vector<geo::Interval> const& scan) {
+    auto shared = std::make_shared<ParallelGeoScan>();
+    shared->cmp = _index->comparator();
+    shared->objectId = _index->objectId();
+
+    size_t const numChunks =
+        std::min(_parallelism, scan.size() / ::ParallelScanMinIntervals);
+    size_t const step = (scan.size() + numChunks - 1) / numChunks;
+    RocksDBMethods* mthds = RocksDBTransactionState::toMethods(_trx);
+    rocksdb::ReadOptions options = mthds->iteratorReadOptions();
+    TRI_ASSERT(options.snapshot != nullptr);
+    shared->chunks.resize((scan.size() + step - 1) / step);
+    for (size_t i = 0; i < shared->chunks.size(); ++i) {
+      auto& chunk = shared->chunks[i];
+      chunk.begin = scan.data() + i * step;
+      chunk.end = scan.data() + std::min(scan.size(), (i + 1) * step);
+      chunk.iterator = mthds->NewIterator(options, _index->columnFamily());
+    }
+
+    auto* scheduler = SchedulerFeature::SCHEDULER;
+    if (scheduler != nullptr) {
+      for (size_t i = 1; i < shared->chunks.size(); ++i) {
+        scheduler->queue(RequestLane::INTERNAL_LOW,
+                         [shared, i]() { ParallelGeoScan::scan(shared, i); });
       }
+    }
+    // chunks not picked up by the scheduler yet are read by this thread
+    for (size_t i = 0; i < shared->chunks.size(); ++i) {
+      ParallelGeoScan::scan(shared, i);
+    }
 
-      while (_iter->Valid() && cmp->Compare(_iter->key(), bds.end()) <= 0) {
-        LocalDocumentId documentId =
-            RocksDBKey::indexDocumentId(RocksDBEntryType::GeoIndexValue, _iter->key());
-        _near.reportFound(documentId, RocksDBValue::centroid(_iter->value()));
-        _iter->Next();
+    std::vector<ParallelGeoScan::Chunk> chunks;
+    {
+      std::unique_lock<std::mutex> guard(shared->mutex);
+      shared->cv.wait(guard, [&shared]() { return shared->running == 0; });
+      // the rocksdb iterators must be gone before the transaction ends, no
+      // matter when outstanding jobs get to run
+      chunks = std::move(shared->chunks);
+      shared->chunks.clear();
+      if (!shared->error.empty()) {
+        THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, shared->error);
       }
     }
 
-    _near.didScanIntervals();  // calculate next bounds
-    // LOG_TOPIC("e82ee", INFO, Logger::ENGINES) << "# seeks: " << seeks;
+    for (auto& chunk : chunks) {
+      for (auto const& entry : chunk.entries) {
+        _near.reportFound(entry.documentId, entry.centroid,
+                          entry.bounded ? &entry.bound : nullptr);
+      }
+    }
   }
 
   /// find the first indexed entry to estimate the # of entries
@@ -228,6 +379,8 @@ class RDBNearIterator final : public IndexIterator {
   RocksDBGeoIndex const* _index;
   geo_index::NearUtils<CMP> _near;
   std::unique_ptr<rocksdb::Iterator> _iter;
+  /// @brief number of threads reading one expansion step
+  size_t const _parallelism;
 };
 
 RocksDBGeoIndex::RocksDBGeoIndex(TRI_idx_iid_t iid, LogicalCollection& collection,
@@ -359,12 +512,21 @@ IndexIterator* RocksDBGeoIndex::iteratorForCondition(
     params.cover.bestIndexedLevel = _coverParams.bestIndexedLevel;
   }
 
+  // parallel reads all use the transaction's snapshot, so they would not
+  // see the transaction's own writes
+  size_t parallelism = 1;
+  if (trx->state()->isReadOnlyTransaction()) {
+    parallelism = opts.parallelism;
+  }
+
   if (params.ascending) {
     return new RDBNearIterator<geo_index::DocumentsAscending>(&_collection, trx, this,
-                                                              std::move(params));
+                                                              std::move(params),
+                                                              parallelism);
   } else {
     return new RDBNearIterator<geo_index::DocumentsDescending>(&_collection, trx, this,
-                                                               std::move(params));
+                                                               std::move(params),
+                                                               parallelism);
   }
 }
 
@@ -379,8 +541,9 @@ Result RocksDBGeoIndex::insert(transaction::Methods& trx, RocksDBMethods* mthd,
   cells.reserve(reserve);
 
   S2Point centroid;
+  S2LatLngRect bound;
 
-  Result res = geo_index::Index::indexCells(doc, cells, centroid);
+  Result res = geo_index::Index::indexCells(doc, cells, centroid, bound);
 
   if (res.fail()) {
     if (res.is(TRI_ERROR_BAD_PARAMETER)) {
@@ -393,7 +556,11 @@ Result RocksDBGeoIndex::insert(transaction::Methods& trx, RocksDBMethods* mthd,
   TRI_ASSERT(!cells.empty());
   TRI_ASSERT(S2::IsUnitLength(centroid));
 
-  RocksDBValue val = RocksDBValue::S2Value(centroid);
+  // indexes of points need the centroid only, the shapes of geojson
+  // indexes are bounded to filter them before reading the documents
+  RocksDBValue val = _variant == Variant::GEOJSON
+                         ? RocksDBValue::S2Value(centroid, bound)
+                         : RocksDBValue::S2Value(centroid);
   RocksDBKeyLeaser key(&trx);
 
   TRI_ASSERT(!_unique);
@@ -30,6 +30,7 @@
 #include "RocksDBEngine/RocksDBIterators.h"
 #include "RocksDBEngine/RocksDBKey.h"
 #include "RocksDBEngine/RocksDBPrimaryIndex.h"
+#include "RocksDBEngine/RocksDBReplicationCommon.h"
 #include "RocksDBEngine/RocksDBTransactionCollection.h"
 #include "SimpleHttpClient/SimpleHttpClient.h"
 #include "SimpleHttpClient/SimpleHttpResult.h"
@@ -217,6 +218,7 @@ Result syncChunkRocksDB(DatabaseInitialSyncer& syncer, SingleCollectionTransacti
     if (replutils::hasFailed(response.get())) {
       return replutils::buildHttpError(response.get(), url, syncer._state.connection);
     }
+    syncer.dataReceived(*response);
   }
 
   TRI_ASSERT(response != nullptr);
@@ -413,6 +415,7 @@ Result syncChunkRocksDB(DatabaseInitialSyncer& syncer, SingleCollectionTransacti
       if (replutils::hasFailed(response.get())) {
         return replutils::buildHttpError(response.get(), url, syncer._state.connection);
       }
+      syncer.dataReceived(*response);
     }
 
     TRI_ASSERT(response != nullptr);
@@ -759,15 +762,7 @@ Result handleSyncKeysRocksDB(DatabaseInitialSyncer& syncer,
             markers.emplace_back(docKey);
             // don't bother hashing if we have't found lower key
             if (foundLowKey) {
-              tempBuilder.clear();
-              tempBuilder.add(VPackValue(docKey));
-              localHash ^= tempBuilder.slice().hashString();
-
-              tempBuilder.clear();
-              // use a temporary char buffer for building to rid string
-              char ridBuffer[21];
-              tempBuilder.add(TRI_RidToValuePair(docRev, &ridBuffer[0]));
-              localHash ^= tempBuilder.slice().hashString();  // revision as string
+              localHash ^= hashKeyAndRevision(arangodb::velocypack::StringRef(docKey), docRev);
 
               if (cmp2 == 0) {  // found highKey
                 rangeUnequal = std::to_string(localHash) != hashString;
@@ -132,6 +132,12 @@ void RocksDBIndex::toVelocyPackFigures(VPackBuilder& builder) const {
     rate = hitRates.second;
     rate = std::isnan(rate) ? 0.0 : rate;
     builder.add("cacheWindowedHitRate", VPackValue(rate));
+    auto stats = _cache->statistics();
+    builder.add("cacheHits", VPackValue(stats.findHits));
+    builder.add("cacheMisses", VPackValue(stats.findMisses));
+    builder.add("cacheInserts", VPackValue(stats.inserts));
+    builder.add("cacheEvictions", VPackValue(stats.evictions));
+    builder.add("cacheInsertRejections", VPackValue(stats.insertRejections));
   } else {
     builder.add("cacheSize", VPackValue(0));
     builder.add("cacheUsage", VPackValue(0));
@@ -73,6 +73,11 @@ class RocksDBIndex : public Index {
 
   virtual void afterTruncate(TRI_voc_tick_t tick) override;
 
+  /// @brief called with the hashes the index tracked for the operations of
+  /// a commit, see RocksDBTransactionState::trackIndexInsert
+  virtual void afterCommit(std::vector<uint64_t> const& /*inserts*/,
+                           std::vector<uint64_t> const& /*removals*/) {}
+
   void load() override;
   void unload() override;
 
@@ -92,6 +97,17 @@ class RocksDBIndex : public Index {
   void createCache();
   void destroyCache();
 
+  /// @brief returns up to maxValues lookup values of the entries currently in
+  /// the index cache, so that warmupCache() can load them again after a
+  /// restart. empty if the index does not support this
+  virtual std::vector<std::string> cachedLookupValues(size_t /*maxValues*/) const {
+    return {};
+  }
+
+  /// @brief fills the index cache with the entries for the given lookup values
+  virtual void warmupCache(transaction::Methods* /*trx*/,
+                           std::vector<std::string> const& /*values*/) {}
+
   /// insert index elements into the specified write batch.
   virtual Result insert(transaction::Methods& trx, RocksDBMethods* methods,
                         LocalDocumentId const& documentId,
@@ -21,20 +21,34 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "RocksDBIterators.h"
+#include "Basics/Exceptions.h"
 #include "Logger/Logger.h"
 #include "Random/RandomGenerator.h"
 #include "RocksDBEngine/RocksDBCollection.h"
 #include "RocksDBEngine/RocksDBColumnFamily.h"
+#include "RocksDBEngine/RocksDBCommon.h"
+#include "RocksDBEngine/RocksDBFormat.h"
 #include "RocksDBEngine/RocksDBMethods.h"
 #include "RocksDBEngine/RocksDBPrimaryIndex.h"
 #include "RocksDBEngine/RocksDBTransactionState.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "VocBase/LogicalCollection.h"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
 using namespace arangodb;
 
 namespace {
 constexpr bool AllIteratorFillBlockCache = true;
 constexpr bool AnyIteratorFillBlockCache = false;
+
+/// @brief number of documents a scheduler thread copies into one batch
+constexpr size_t ParallelScanBatchSize = 1000;
+/// @brief number of batches per thread that may wait for the consumer
+constexpr size_t ParallelScanQueuedBatches = 2;
 }  // namespace
 
 // ================ All Iterator ==================
@@ -45,10 +59,10 @@ RocksDBAllIndexIterator::RocksDBAllIndexIterator(LogicalCollection* col,
       _bounds(RocksDBKeyBounds::CollectionDocuments(
           static_cast<RocksDBCollection*>(col->getPhysical())->objectId())),
       _upperBound(_bounds.end()),
-      _cmp(RocksDBColumnFamily::documents()->GetComparator()) {
+      _cmp(_bounds.columnFamily()->GetComparator()) {
   // acquire rocksdb transaction
   auto* mthds = RocksDBTransactionState::toMethods(trx);
-  rocksdb::ColumnFamilyHandle* cf = RocksDBColumnFamily::documents();
+  rocksdb::ColumnFamilyHandle* cf = _bounds.columnFamily();
 
   rocksdb::ReadOptions options = mthds->iteratorReadOptions();
   TRI_ASSERT(options.snapshot != nullptr);
@@ -140,11 +154,348 @@ void RocksDBAllIndexIterator::reset() {
   _iterator->Seek(_bounds.start());
 }
 
+// ================ Parallel All Iterator ==================
+
+/// @brief documents copied out of a range by a scheduler thread
+struct RocksDBParallelAllIndexIterator::Batch {
+  std::vector<std::pair<LocalDocumentId, size_t>> documents;
+  std::string data;
+};
+
+/// @brief state shared with the scheduler threads. it is owned jointly, so
+/// jobs that only start after the iterator is gone can still see that they
+/// have nothing to do. scheduler threads never wait for the consumer: if
+/// the queue of batches is full, a job hands its range back as pending and
+/// the consumer schedules it again once it has taken a batch
+struct RocksDBParallelAllIndexIterator::Shared {
+  enum class RangeState { Pending, Worker, Inline, Done };
+
+  struct Range {
+    std::string lower;
+    std::string upper;
+    rocksdb::Slice upperBound;  // used for iterate_upper_bound
+    std::unique_ptr<rocksdb::Iterator> iterator;
+    RangeState state = RangeState::Pending;
+    /// @brief whether a scheduler job for the range is waiting to run
+    bool queued = false;
+  };
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<std::unique_ptr<Range>> ranges;
+  std::deque<Batch> batches;
+  size_t maxBatches = 0;
+  /// @brief number of ranges currently read by scheduler threads
+  size_t running = 0;
+  bool stopped = false;
+  std::string error;
+
+  /// @brief queue jobs for the given ranges, which must have been marked
+  /// as queued. ranges the scheduler does not accept are left to the consumer
+  static void schedule(std::shared_ptr<Shared> const& shared,
+                       std::vector<size_t> const& indexes) {
+    auto* scheduler = SchedulerFeature::SCHEDULER;
+    for (size_t i : indexes) {
+      bool queued = scheduler != nullptr &&
+                    scheduler->queue(RequestLane::INTERNAL_LOW,
+                                     [shared, i]() { Shared::scan(shared, i); });
+      if (!queued) {
+        std::lock_guard<std::mutex> guard(shared->mutex);
+        shared->ranges[i]->queued = false;
+      }
+    }
+  }
+
+  /// @brief read a range on a scheduler thread, until it is exhausted or
+  /// the queue of batches is full
+  static void scan(std::shared_ptr<Shared> const& shared, size_t index) {
+    Range* range = nullptr;
+    {
+      std::lock_guard<std::mutex> guard(shared->mutex);
+      shared->ranges[index]->queued = false;
+      if (shared->stopped || shared->ranges[index]->state != RangeState::Pending) {
+        return;
+      }
+      range = shared->ranges[index].get();
+      range->state = RangeState::Worker;
+      ++shared->running;
+    }
+
+    // from here on, the range's iterator is only used by this thread
+    rocksdb::Iterator* it = range->iterator.get();
+    bool done = false;
+    try {
+      while (!done) {
+        {
+          std::lock_guard<std::mutex> guard(shared->mutex);
+          if (shared->stopped || shared->batches.size() >= shared->maxBatches) {
+            break;
+          }
+        }
+
+        Batch batch;
+        while (it->Valid() && batch.documents.size() < ::ParallelScanBatchSize) {
+          batch.documents.emplace_back(RocksDBKey::documentId(it->key()),
+                                       batch.data.size());
+          batch.data.append(it->value().data(), it->value().size());
+          it->Next();
+        }
+        done = !it->Valid();
+        if (done && !it->status().ok()) {
+          THROW_ARANGO_EXCEPTION(rocksutils::convertStatus(it->status()));
+        }
+
+        std::lock_guard<std::mutex> guard(shared->mutex);
+        if (!batch.documents.empty()) {
+          shared->batches.emplace_back(std::move(batch));
+          shared->cv.notify_all();
+        }
+      }
+    } catch (std::exception const& ex) {
+      done = true;
+      std::lock_guard<std::mutex> guard(shared->mutex);
+      if (shared->error.empty()) {
+        shared->error = ex.what();
+      }
+    }
+
+    std::lock_guard<std::mutex> guard(shared->mutex);
+    // a range that is not done yet continues from the iterator's position
+    range->state = done ? RangeState::Done : RangeState::Pending;
+    --shared->running;
+    shared->cv.notify_all();
+  }
+};
+
+RocksDBParallelAllIndexIterator::RocksDBParallelAllIndexIterator(LogicalCollection* col,
+                                                                 transaction::Methods* trx,
+                                                                 size_t parallelism)
+    : IndexIterator(col, trx),
+      _bounds(RocksDBKeyBounds::CollectionDocuments(
+          static_cast<RocksDBCollection*>(col->getPhysical())->objectId())),
+      _parallelism(std::max<size_t>(parallelism, 1)),
+      _started(false),
+      _current(std::make_unique<Batch>()),
+      _position(0),
+      _inlineRange(SIZE_MAX) {
+  // all iterators are created from the same transaction snapshot. this is
+  // only safe for transactions without uncommitted writes
+  TRI_ASSERT(trx->state()->isReadOnlyTransaction());
+}
+
+RocksDBParallelAllIndexIterator::~RocksDBParallelAllIndexIterator() { stop(); }
+
+void RocksDBParallelAllIndexIterator::start() {
+  TRI_ASSERT(!_started);
+  TRI_ASSERT(_shared == nullptr);
+  _started = true;
+  _shared = std::make_shared<Shared>();
+  _shared->maxBatches = _parallelism * ::ParallelScanQueuedBatches;
+
+  auto* mthds = RocksDBTransactionState::toMethods(_trx);
+  rocksdb::ColumnFamilyHandle* cf = _bounds.columnFamily();
+  rocksdb::ReadOptions options = mthds->iteratorReadOptions();
+  TRI_ASSERT(options.snapshot != nullptr);
+  TRI_ASSERT(options.prefix_same_as_start);
+  options.fill_cache = AllIteratorFillBlockCache;
+  options.verify_checksums = false;
+
+  // determine the first and the last document key. the split points are
+  // computed on the bytes of the document id, so the ranges cover the key
+  // space no matter the endianess
+  std::string prefix;
+  uint64_t first;
+  uint64_t last;
+  {
+    rocksdb::Slice end = _bounds.end();
+    options.iterate_upper_bound = &end;
+    std::unique_ptr<rocksdb::Iterator> it = mthds->NewIterator(options, cf);
+    it->Seek(_bounds.start());
+    if (!it->Valid()) {
+      return;
+    }
+    TRI_ASSERT(it->key().size() == 2 * sizeof(uint64_t));
+    prefix.assign(it->key().data(), sizeof(uint64_t));
+    first = rocksutils::uintFromPersistentBigEndian<uint64_t>(it->key().data() +
+                                                              sizeof(uint64_t));
+    it->SeekForPrev(_bounds.end());
+    TRI_ASSERT(it->Valid());
+    last = rocksutils::uintFromPersistentBigEndian<uint64_t>(it->key().data() +
+                                                             sizeof(uint64_t));
+    TRI_ASSERT(first <= last);
+  }
+
+  uint64_t const step = (last - first) / _parallelism + 1;
+  uint64_t lower = first;
+  while (true) {
+    auto range = std::make_unique<Shared::Range>();
+    range->lower = prefix;
+    rocksutils::uintToPersistentBigEndian<uint64_t>(range->lower, lower);
+    bool const isLast = (last - lower < step);
+    if (isLast) {
+      range->upper.assign(_bounds.end().data(), _bounds.end().size());
+    } else {
+      lower += step;
+      range->upper = prefix;
+      rocksutils::uintToPersistentBigEndian<uint64_t>(range->upper, lower);
+    }
+    range->upperBound = rocksdb::Slice(range->upper);
+    options.iterate_upper_bound = &range->upperBound;
+    range->iterator = mthds->NewIterator(options, cf);
+    range->iterator->Seek(range->lower);
+    _shared->ranges.emplace_back(std::move(range));
+    if (isLast) {
+      break;
+    }
+  }
+
+  // the first range is left to this thread. if the scheduler does not pick
+  // up the others in time, they are read by this thread as well
+  std::vector<size_t> indexes;
+  for (size_t i = 1; i < _shared->ranges.size(); ++i) {
+    _shared->ranges[i]->queued = true;
+    indexes.emplace_back(i);
+  }
+  Shared::schedule(_shared, indexes);
+}
+
+void RocksDBParallelAllIndexIterator::stop() {
+  if (_shared != nullptr) {
+    std::unique_lock<std::mutex> guard(_shared->mutex);
+    _shared->stopped = true;
+    _shared->cv.notify_all();
+    _shared->cv.wait(guard, [this]() { return _shared->running == 0; });
+    // the rocksdb iterators must be gone before the transaction ends, no
+    // matter when outstanding jobs get to run
+    for (auto& range : _shared->ranges) {
+      range->state = Shared::RangeState::Done;
+      range->iterator.reset();
+    }
+    _shared->batches.clear();
+  }
+  _shared.reset();
+  _started = false;
+  _current->documents.clear();
+  _current->data.clear();
+  _position = 0;
+  _inlineRange = SIZE_MAX;
+}
+
+bool RocksDBParallelAllIndexIterator::fetch() {
+  TRI_ASSERT(_inlineRange == SIZE_MAX);
+  if (!_started) {
+    start();
+  }
+  if (_shared == nullptr) {
+    // empty collection
+    return false;
+  }
+
+  std::unique_lock<std::mutex> guard(_shared->mutex);
+  while (true) {
+    if (!_shared->error.empty()) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, _shared->error);
+    }
+    if (!_shared->batches.empty()) {
+      *_current = std::move(_shared->batches.front());
+      _shared->batches.pop_front();
+      _position = 0;
+
+      // schedule the ranges handed back while the queue was full
+      std::vector<size_t> indexes;
+      for (size_t i = 0; i < _shared->ranges.size(); ++i) {
+        auto& range = _shared->ranges[i];
+        if (range->state == Shared::RangeState::Pending && !range->queued &&
+            _shared->batches.size() + indexes.size() < _shared->maxBatches) {
+          range->queued = true;
+          indexes.emplace_back(i);
+        }
+      }
+      guard.unlock();
+      Shared::schedule(_shared, indexes);
+      return true;
+    }
+    for (size_t i = 0; i < _shared->ranges.size(); ++i) {
+      if (_shared->ranges[i]->state == Shared::RangeState::Pending) {
+        _shared->ranges[i]->state = Shared::RangeState::Inline;
+        _inlineRange = i;
+        return true;
+      }
+    }
+    if (_shared->running == 0) {
+      return false;
+    }
+    _shared->cv.wait(guard);
+  }
+}
+
+bool RocksDBParallelAllIndexIterator::next(LocalDocumentIdCallback const& cb, size_t limit) {
+  return nextDocument([&cb](LocalDocumentId const& token, VPackSlice) { cb(token); }, limit);
+}
+
+bool RocksDBParallelAllIndexIterator::nextDocument(IndexIterator::DocumentCallback const& cb,
+                                                   size_t limit) {
+  TRI_ASSERT(_trx->state()->isRunning());
+  TRI_ASSERT(limit > 0);  // Someone called with limit == 0. Api broken
+
+  while (limit > 0) {
+    auto const& documents = _current->documents;
+    while (_position < documents.size() && limit > 0) {
+      auto const& it = documents[_position];
+      cb(it.first, VPackSlice(reinterpret_cast<uint8_t const*>(
+                       _current->data.data() + it.second)));
+      ++_position;
+      --limit;
+    }
+    if (limit == 0) {
+      break;
+    }
+
+    if (_inlineRange != SIZE_MAX) {
+      // this range was not picked up by the scheduler, so read it directly.
+      // no other thread touches it
+      rocksdb::Iterator* it = _shared->ranges[_inlineRange]->iterator.get();
+      while (it->Valid() && limit > 0) {
+        cb(RocksDBKey::documentId(it->key()),
+           VPackSlice(reinterpret_cast<uint8_t const*>(it->value().data())));
+        it->Next();
+        --limit;
+      }
+      if (!it->Valid()) {
+        rocksdb::Status status = it->status();
+        {
+          std::lock_guard<std::mutex> guard(_shared->mutex);
+          _shared->ranges[_inlineRange]->state = Shared::RangeState::Done;
+        }
+        _inlineRange = SIZE_MAX;
+        if (!status.ok()) {
+          THROW_ARANGO_EXCEPTION(rocksutils::convertStatus(status));
+        }
+      }
+      continue;
+    }
+
+    if (!fetch()) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void RocksDBParallelAllIndexIterator::reset() {
+  TRI_ASSERT(_trx->state()->isRunning());
+  // the scan is started again lazily
+  stop();
+}
+
 // ================ Any Iterator ================
 RocksDBAnyIndexIterator::RocksDBAnyIndexIterator(LogicalCollection* col,
                                                  transaction::Methods* trx) 
     : IndexIterator(col, trx),
-      _cmp(RocksDBColumnFamily::documents()->GetComparator()),
+      _cmp(toRocksDBCollection(col->getPhysical())
+               ->documentsColumnFamily()
+               ->GetComparator()),
       _objectId(static_cast<RocksDBCollection*>(col->getPhysical())->objectId()),
       _bounds(RocksDBKeyBounds::CollectionDocuments(_objectId)),
       _total(0),
@@ -155,7 +506,7 @@ RocksDBAnyIndexIterator::RocksDBAnyIndexIterator(LogicalCollection* col,
   TRI_ASSERT(options.prefix_same_as_start);
   options.fill_cache = AnyIteratorFillBlockCache;
   options.verify_checksums = false;  // TODO evaluate
-  _iterator = mthds->NewIterator(options, RocksDBColumnFamily::documents());
+  _iterator = mthds->NewIterator(options, _bounds.columnFamily());
   TRI_ASSERT(_iterator);
 
   _total = col->numberDocuments(trx, transaction::CountType::Normal);
@@ -31,6 +31,8 @@
 #include <velocypack/Iterator.h>
 #include <velocypack/Slice.h>
 
+#include <memory>
+
 namespace rocksdb {
 class Iterator;
 class Comparator;
@@ -94,6 +96,50 @@ class RocksDBAnyIndexIterator final : public IndexIterator {
   bool _forward;
 };
 
+/// @brief iterator over all documents in the collection, which splits the
+/// collection's key range into sub-ranges and scans them on scheduler
+/// threads. the documents are returned in no particular order. the scan
+/// only starts with the first call to next() or nextDocument(), and the
+/// iterator reads ranges itself if no scheduler thread picks them up
+class RocksDBParallelAllIndexIterator final : public IndexIterator {
+ public:
+  RocksDBParallelAllIndexIterator(LogicalCollection* collection,
+                                  transaction::Methods* trx, size_t parallelism);
+  ~RocksDBParallelAllIndexIterator();
+
+  char const* typeName() const override { return "parallel-all-index-iterator"; }
+
+  bool next(LocalDocumentIdCallback const& cb, size_t limit) override;
+  bool nextDocument(DocumentCallback const& cb, size_t limit) override;
+
+  void reset() override;
+
+ private:
+  struct Batch;
+  struct Shared;
+
+  /// @brief split the key range and hand the sub-ranges to the scheduler
+  void start();
+
+  /// @brief stop all scans and wait for running ones to finish
+  void stop();
+
+  /// @brief read the next batch, or claim a range to read directly.
+  /// returns false if all ranges are exhausted
+  bool fetch();
+
+ private:
+  RocksDBKeyBounds const _bounds;
+  size_t const _parallelism;
+  bool _started;
+  std::shared_ptr<Shared> _shared;
+  /// @brief the batch currently returned, and the position in it
+  std::unique_ptr<Batch> _current;
+  size_t _position;
+  /// @brief range read directly by this iterator, or SIZE_MAX if none
+  size_t _inlineRange;
+};
+
 class RocksDBGenericIterator {
  public:
   RocksDBGenericIterator(rocksdb::ReadOptions& options,
@@ -156,6 +156,12 @@ class RocksDBKey {
   //////////////////////////////////////////////////////////////////////////////
   void constructKeyGeneratorValue(uint64_t objectId);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Create a fully-specified key for the statistics of the documents
+  ///        of a collection
+  //////////////////////////////////////////////////////////////////////////////
+  void constructCollectionStatisticsValue(uint64_t objectId);
+
  public:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Extracts the type from a key
@@ -297,6 +303,7 @@ class RocksDBKey {
       case RocksDBEntryType::ReplicationApplierConfig:
       case RocksDBEntryType::IndexEstimateValue:
       case RocksDBEntryType::KeyGeneratorValue:
+      case RocksDBEntryType::CollectionStatisticsValue:
       case RocksDBEntryType::View:
         return type;
       default:
@@ -50,6 +50,11 @@ RocksDBKeyBounds RocksDBKeyBounds::CollectionDocuments(uint64_t collectionObject
   return RocksDBKeyBounds(RocksDBEntryType::Document, collectionObjectId);
 }
 
+RocksDBKeyBounds RocksDBKeyBounds::CollectionDocumentRange(uint64_t collectionObjectId,
+                                                           uint64_t lower, uint64_t upper) {
+  return RocksDBKeyBounds(RocksDBEntryType::Document, collectionObjectId, lower, upper);
+}
+
 RocksDBKeyBounds RocksDBKeyBounds::PrimaryIndex(uint64_t indexId) {
   return RocksDBKeyBounds(RocksDBEntryType::PrimaryIndexValue, indexId);
 }
@@ -204,7 +209,7 @@ rocksdb::ColumnFamilyHandle* RocksDBKeyBounds::columnFamily() const {
     case RocksDBEntryType::Placeholder:
       return RocksDBColumnFamily::invalid();
     case RocksDBEntryType::Document:
-      return RocksDBColumnFamily::documents();
+      return RocksDBColumnFamily::documents(objectId());
     case RocksDBEntryType::PrimaryIndexValue:
       return RocksDBColumnFamily::primary();
     case RocksDBEntryType::EdgeIndexValue:
@@ -224,6 +229,7 @@ rocksdb::ColumnFamilyHandle* RocksDBKeyBounds::columnFamily() const {
     case RocksDBEntryType::ReplicationApplierConfig:
     case RocksDBEntryType::IndexEstimateValue:
     case RocksDBEntryType::KeyGeneratorValue:
+    case RocksDBEntryType::CollectionStatisticsValue:
     case RocksDBEntryType::View:
       return RocksDBColumnFamily::definitions();
   }
@@ -280,7 +286,8 @@ RocksDBKeyBounds::RocksDBKeyBounds(RocksDBEntryType type) : _type(type) {
     }
     case RocksDBEntryType::CounterValue:
     case RocksDBEntryType::IndexEstimateValue:
-    case RocksDBEntryType::KeyGeneratorValue: {
+    case RocksDBEntryType::KeyGeneratorValue:
+    case RocksDBEntryType::CollectionStatisticsValue: {
       _internals.reserve(2 * (sizeof(char) + sizeof(uint64_t)));
       _internals.push_back(static_cast<char>(_type));
       uint64ToPersistent(_internals.buffer(), 0);
@@ -491,6 +498,17 @@ RocksDBKeyBounds::RocksDBKeyBounds(RocksDBEntryType type, uint64_t first,
       break;
     }
 
+    case RocksDBEntryType::Document: {
+      // 8-byte object ID of collection + 8-byte document key suffix
+      _internals.reserve(sizeof(uint64_t) * 2 * 2);
+      uint64ToPersistent(_internals.buffer(), first);
+      uintToPersistentBigEndian<uint64_t>(_internals.buffer(), second);
+      _internals.separate();
+      uint64ToPersistent(_internals.buffer(), first);
+      uintToPersistentBigEndian<uint64_t>(_internals.buffer(), third);
+      break;
+    }
+
     default:
       THROW_ARANGO_EXCEPTION(TRI_ERROR_BAD_PARAMETER);
   }
@@ -64,6 +64,15 @@ class RocksDBKeyBounds {
   //////////////////////////////////////////////////////////////////////////////
   static RocksDBKeyBounds CollectionDocuments(uint64_t collectionObjectId);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Bounds for the documents of a collection whose key suffix,
+  /// read as a big-endian number, lies in [lower, upper]. This partitions
+  /// the documents by their position in the keyspace, independent of the
+  /// endianness used for document ids
+  //////////////////////////////////////////////////////////////////////////////
+  static RocksDBKeyBounds CollectionDocumentRange(uint64_t collectionObjectId,
+                                                  uint64_t lower, uint64_t upper);
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Bounds for all index-entries- belonging to a specified primary
   /// index
@@ -162,6 +162,17 @@ rocksdb::Status RocksDBReadOnlyMethods::Get(rocksdb::ColumnFamilyHandle* cf,
   return _db->Get(ro, cf, key, val);
 }
 
+std::vector<rocksdb::Status> RocksDBReadOnlyMethods::MultiGet(
+    rocksdb::ColumnFamilyHandle* cf, std::vector<rocksdb::Slice> const& keys,
+    std::vector<std::string>* values) {
+  TRI_ASSERT(cf != nullptr);
+  rocksdb::ReadOptions const& ro = _state->_rocksReadOptions;
+  TRI_ASSERT(ro.snapshot != nullptr ||
+             (_state->isReadOnlyTransaction() && _state->isSingleOperation()));
+  std::vector<rocksdb::ColumnFamilyHandle*> cfs(keys.size(), cf);
+  return _db->MultiGet(ro, cfs, keys, values);
+}
+
 rocksdb::Status RocksDBReadOnlyMethods::Put(rocksdb::ColumnFamilyHandle* cf,
                                             RocksDBKey const&, rocksdb::Slice const&) {
   THROW_ARANGO_EXCEPTION(TRI_ERROR_ARANGO_READ_ONLY);
@@ -232,6 +243,16 @@ rocksdb::Status RocksDBTrxMethods::Get(rocksdb::ColumnFamilyHandle* cf,
   return _state->_rocksTransaction->Get(ro, cf, key, val);
 }
 
+std::vector<rocksdb::Status> RocksDBTrxMethods::MultiGet(
+    rocksdb::ColumnFamilyHandle* cf, std::vector<rocksdb::Slice> const& keys,
+    std::vector<std::string>* values) {
+  TRI_ASSERT(cf != nullptr);
+  rocksdb::ReadOptions const& ro = _state->_rocksReadOptions;
+  TRI_ASSERT(ro.snapshot != nullptr);
+  std::vector<rocksdb::ColumnFamilyHandle*> cfs(keys.size(), cf);
+  return _state->_rocksTransaction->MultiGet(ro, cfs, keys, values);
+}
+
 rocksdb::Status RocksDBTrxMethods::Put(rocksdb::ColumnFamilyHandle* cf,
                                        RocksDBKey const& key, rocksdb::Slice const& val) {
   TRI_ASSERT(cf != nullptr);
@@ -302,6 +323,13 @@ rocksdb::Status RocksDBBatchedMethods::Get(rocksdb::ColumnFamilyHandle* cf,
                                  "BatchedMethods does not provide Get");
 }
 
+std::vector<rocksdb::Status> RocksDBBatchedMethods::MultiGet(
+    rocksdb::ColumnFamilyHandle*, std::vector<rocksdb::Slice> const&,
+    std::vector<std::string>*) {
+  THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                 "BatchedMethods does not provide MultiGet");
+}
+
 rocksdb::Status RocksDBBatchedMethods::Put(rocksdb::ColumnFamilyHandle* cf,
                                            RocksDBKey const& key,
                                            rocksdb::Slice const& val) {
@@ -361,6 +389,21 @@ rocksdb::Status RocksDBBatchedWithIndexMethods::Get(rocksdb::ColumnFamilyHandle*
   return _wb->GetFromBatchAndDB(_db, ro, cf, key, val);
 }
 
+std::vector<rocksdb::Status> RocksDBBatchedWithIndexMethods::MultiGet(
+    rocksdb::ColumnFamilyHandle* cf, std::vector<rocksdb::Slice> const& keys,
+    std::vector<std::string>* values) {
+  TRI_ASSERT(cf != nullptr);
+  // the write batch does not support batched reads
+  rocksdb::ReadOptions ro;
+  std::vector<rocksdb::Status> statuses;
+  statuses.reserve(keys.size());
+  values->resize(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    statuses.emplace_back(_wb->GetFromBatchAndDB(_db, ro, cf, keys[i], &(*values)[i]));
+  }
+  return statuses;
+}
+
 rocksdb::Status RocksDBBatchedWithIndexMethods::Put(rocksdb::ColumnFamilyHandle* cf,
                                                     RocksDBKey const& key,
                                                     rocksdb::Slice const& val) {
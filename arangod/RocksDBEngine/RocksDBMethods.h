@@ -27,6 +27,8 @@
 #include "RocksDBColumnFamily.h"
 #include "RocksDBCommon.h"
 
+#include <vector>
+
 namespace rocksdb {
 class Transaction;
 class Slice;
@@ -88,6 +90,11 @@ class RocksDBMethods {
                               rocksdb::Slice const&, std::string*) = 0;
   virtual rocksdb::Status Get(rocksdb::ColumnFamilyHandle*,
                               rocksdb::Slice const&, rocksdb::PinnableSlice*) = 0;
+  /// @brief look up multiple keys at once. the i-th status and value
+  /// belong to the i-th key
+  virtual std::vector<rocksdb::Status> MultiGet(rocksdb::ColumnFamilyHandle*,
+                                                std::vector<rocksdb::Slice> const&,
+                                                std::vector<std::string>*) = 0;
   virtual rocksdb::Status Put(rocksdb::ColumnFamilyHandle*, RocksDBKey const&,
                               rocksdb::Slice const&) = 0;
   /// Like Put, but will not perform any write-write conflict checks
@@ -125,6 +132,9 @@ class RocksDBReadOnlyMethods final : public RocksDBMethods {
                       std::string* val) override;
   rocksdb::Status Get(rocksdb::ColumnFamilyHandle*, rocksdb::Slice const& key,
                       rocksdb::PinnableSlice* val) override;
+  std::vector<rocksdb::Status> MultiGet(rocksdb::ColumnFamilyHandle*,
+                                        std::vector<rocksdb::Slice> const& keys,
+                                        std::vector<std::string>* values) override;
   rocksdb::Status Put(rocksdb::ColumnFamilyHandle*, RocksDBKey const& key,
                       rocksdb::Slice const& val) override;
   rocksdb::Status PutUntracked(rocksdb::ColumnFamilyHandle*, RocksDBKey const& key,
@@ -162,6 +172,9 @@ class RocksDBTrxMethods : public RocksDBMethods {
                       std::string* val) override;
   rocksdb::Status Get(rocksdb::ColumnFamilyHandle*, rocksdb::Slice const& key,
                       rocksdb::PinnableSlice* val) override;
+  std::vector<rocksdb::Status> MultiGet(rocksdb::ColumnFamilyHandle*,
+                                        std::vector<rocksdb::Slice> const& keys,
+                                        std::vector<std::string>* values) override;
   rocksdb::Status Put(rocksdb::ColumnFamilyHandle*, RocksDBKey const& key,
                       rocksdb::Slice const& val) override;
   rocksdb::Status PutUntracked(rocksdb::ColumnFamilyHandle*, RocksDBKey const& key,
@@ -190,6 +203,9 @@ class RocksDBBatchedMethods final : public RocksDBMethods {
                       std::string* val) override;
   rocksdb::Status Get(rocksdb::ColumnFamilyHandle*, rocksdb::Slice const& key,
                       rocksdb::PinnableSlice* val) override;
+  std::vector<rocksdb::Status> MultiGet(rocksdb::ColumnFamilyHandle*,
+                                        std::vector<rocksdb::Slice> const& keys,
+                                        std::vector<std::string>* values) override;
   rocksdb::Status Put(rocksdb::ColumnFamilyHandle*, RocksDBKey const& key,
                       rocksdb::Slice const& val) override;
   rocksdb::Status PutUntracked(rocksdb::ColumnFamilyHandle*, RocksDBKey const& key,
@@ -220,6 +236,9 @@ class RocksDBBatchedWithIndexMethods final : public RocksDBMethods {
                       std::string* val) override;
   rocksdb::Status Get(rocksdb::ColumnFamilyHandle*, rocksdb::Slice const& key,
                       rocksdb::PinnableSlice* val) override;
+  std::vector<rocksdb::Status> MultiGet(rocksdb::ColumnFamilyHandle*,
+                                        std::vector<rocksdb::Slice> const& keys,
+                                        std::vector<std::string>* values) override;
   rocksdb::Status Put(rocksdb::ColumnFamilyHandle*, RocksDBKey const& key,
                       rocksdb::Slice const& val) override;
   rocksdb::Status PutUntracked(rocksdb::ColumnFamilyHandle*, RocksDBKey const& key,
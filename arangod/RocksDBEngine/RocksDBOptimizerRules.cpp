@@ -188,10 +188,12 @@ void RocksDBOptimizerRules::reduceExtractionToProjectionRule(
     // projections are currently limited (arbitrarily to 5 attributes)
     if (optimize && !stop && !attributes.empty() && attributes.size() <= 5) {
       if (n->getType() == ExecutionNode::ENUMERATE_COLLECTION &&
+          ExecutionNode::castTo<EnumerateCollectionNode const*>(n)->filter() == nullptr &&
           std::find(attributes.begin(), attributes.end(), StaticStrings::IdString) == attributes.end()) { 
         // the node is still an EnumerateCollection... now check if we should turn it into an index scan
         // we must never have a projection on _id, as producing _id is not supported yet
-        // by the primary index iterator
+        // by the primary index iterator. a node with a filter pushed into it
+        // is not turned into an IndexNode, as the IndexNode would lose the filter
         EnumerateCollectionNode const* en = ExecutionNode::castTo<EnumerateCollectionNode const*>(n);
 
         // now check all indexes if they cover the projection
@@ -207,6 +209,10 @@ void RocksDBOptimizerRules::reduceExtractionToProjectionRule(
             // index doesn't cover the projection
             continue;
           }
+          if (idx->sparse()) {
+            // a full scan of a sparse index would miss documents
+            continue;
+          }
           if (idx->type() != arangodb::Index::IndexType::TRI_IDX_TYPE_PRIMARY_INDEX &&
               idx->type() != arangodb::Index::IndexType::TRI_IDX_TYPE_HASH_INDEX &&
               idx->type() != arangodb::Index::IndexType::TRI_IDX_TYPE_SKIPLIST_INDEX &&
@@ -262,7 +268,8 @@ void RocksDBOptimizerRules::reduceExtractionToProjectionRule(
       }
       
       modified = true;
-    } else if (!stop && attributes.empty() && n->getType() == ExecutionNode::ENUMERATE_COLLECTION) {
+    } else if (!stop && attributes.empty() && n->getType() == ExecutionNode::ENUMERATE_COLLECTION &&
+               ExecutionNode::castTo<EnumerateCollectionNode const*>(n)->filter() == nullptr) {
       // replace collection access with primary index access (which can be faster
       // given the fact that keys and values are stored together in RocksDB, but
       // average values are much bigger in the documents column family than in the
@@ -23,6 +23,7 @@
 
 #include "Aql/Ast.h"
 #include "Aql/AstNode.h"
+#include "ApplicationFeatures/ApplicationServer.h"
 #include "Basics/Exceptions.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/VelocyPackHelper.h"
@@ -63,6 +64,8 @@
 #include <velocypack/Slice.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include <algorithm>
+
 using namespace arangodb;
 
 namespace {
@@ -221,20 +224,26 @@ class RocksDBPrimaryIndexInIterator final : public IndexIterator {
       return false;
     }
 
-    while (limit > 0) {
-      LocalDocumentId documentId =
-          _index->lookupKey(_trx, arangodb::velocypack::StringRef(*_iterator));
+    lookupNextKeys(limit);
+    for (auto const& documentId : _documentIds) {
       if (documentId.isSet()) {
         cb(documentId);
-        --limit;
       }
+    }
+    return _iterator.valid();
+  }
 
-      _iterator.next();
-      if (!_iterator.valid()) {
-        return false;
-      }
+  /// @brief look up the next limit many keys and then read all documents
+  /// found with a single MultiGet each
+  bool nextDocument(DocumentCallback const& cb, size_t limit) override {
+    if (limit == 0 || !_iterator.valid()) {
+      TRI_ASSERT(limit > 0);  // Someone called with limit == 0. Api broken
+      return false;
     }
-    return true;
+
+    lookupNextKeys(limit);
+    toRocksDBCollection(_collection->getPhysical())->readMultiple(_trx, _documentIds, cb);
+    return _iterator.valid();
   }
 
   bool nextCovering(DocumentCallback const& cb, size_t limit) override {
@@ -246,20 +255,13 @@ class RocksDBPrimaryIndexInIterator final : public IndexIterator {
       return false;
     }
 
-    while (limit > 0) {
-      LocalDocumentId documentId =
-          _index->lookupKey(_trx, arangodb::velocypack::StringRef(*_iterator));
-      if (documentId.isSet()) {
-        cb(documentId, *_iterator);
-        --limit;
-      }
-
-      _iterator.next();
-      if (!_iterator.valid()) {
-        return false;
+    lookupNextKeys(limit);
+    for (size_t i = 0; i < _documentIds.size(); ++i) {
+      if (_documentIds[i].isSet()) {
+        cb(_documentIds[i], _lookupKeys[i]);
       }
     }
-    return true;
+    return _iterator.valid();
   }
 
   void reset() override { _iterator.reset(); }
@@ -268,11 +270,25 @@ class RocksDBPrimaryIndexInIterator final : public IndexIterator {
   /// while scanning the index
   bool hasCovering() const override { return _allowCoveringIndexOptimization; }
 
+ private:
+  /// @brief looks up the next limit many keys of the IN list in one batch
+  void lookupNextKeys(size_t limit) {
+    _lookupKeys.clear();
+    while (_lookupKeys.size() < limit && _iterator.valid()) {
+      _lookupKeys.emplace_back(*_iterator);
+      _iterator.next();
+    }
+    _index->lookupKeys(_trx, _lookupKeys, _documentIds);
+  }
+
  private:
   RocksDBPrimaryIndex* _index;
   std::unique_ptr<VPackBuilder> _keys;
   arangodb::velocypack::ArrayIterator _iterator;
   bool const _allowCoveringIndexOptimization;
+  /// @brief the keys and document ids of the current batch
+  std::vector<VPackSlice> _lookupKeys;
+  std::vector<LocalDocumentId> _documentIds;
 };
 
 class RocksDBPrimaryIndexRangeIterator final : public IndexIterator {
@@ -485,6 +501,58 @@ void RocksDBPrimaryIndex::toVelocyPack(VPackBuilder& builder,
   builder.close();
 }
 
+std::vector<std::string> RocksDBPrimaryIndex::cachedLookupValues(size_t maxValues) const {
+  std::vector<std::string> values;
+  if (!useCache()) {
+    return values;
+  }
+  // the cache is keyed by the full primary index key, return the document
+  // keys only
+  for (auto const& key : _cache->keys(maxValues)) {
+    values.emplace_back(RocksDBKey::primaryKey(rocksdb::Slice(key)).toString());
+  }
+  return values;
+}
+
+void RocksDBPrimaryIndex::warmupCache(transaction::Methods* trx,
+                                      std::vector<std::string> const& values) {
+  if (!useCache()) {
+    return;
+  }
+  for (auto const& key : values) {
+    if (application_features::ApplicationServer::isStopping()) {
+      return;
+    }
+    lookupKey(trx, arangodb::velocypack::StringRef(key));
+  }
+}
+
+LocalDocumentId RocksDBPrimaryIndex::lookupKeyLatestCommitted(
+    arangodb::velocypack::StringRef keyRef) const {
+  RocksDBKey key;
+  key.constructPrimaryIndexValue(_objectId, keyRef);
+
+  if (useCache()) {
+    TRI_ASSERT(_cache != nullptr);
+    auto f = _cache->find(key.string().data(),
+                          static_cast<uint32_t>(key.string().size()));
+    if (f.found()) {
+      rocksdb::Slice s(reinterpret_cast<char const*>(f.value()->value()),
+                       f.value()->valueSize());
+      return RocksDBValue::documentId(s);
+    }
+  }
+
+  // no snapshot: we read whatever has been committed last
+  rocksdb::PinnableSlice val;
+  rocksdb::Status s =
+      rocksutils::globalRocksDB()->Get(rocksdb::ReadOptions(), _cf, key.string(), &val);
+  if (!s.ok()) {
+    return LocalDocumentId();
+  }
+  return RocksDBValue::documentId(val);
+}
+
 LocalDocumentId RocksDBPrimaryIndex::lookupKey(transaction::Methods* trx,
                                                arangodb::velocypack::StringRef keyRef) const {
   RocksDBKeyLeaser key(trx);
@@ -538,6 +606,91 @@ LocalDocumentId RocksDBPrimaryIndex::lookupKey(transaction::Methods* trx,
   return RocksDBValue::documentId(val);
 }
 
+void RocksDBPrimaryIndex::lookupKeys(transaction::Methods* trx,
+                                     std::vector<VPackSlice> const& keys,
+                                     std::vector<LocalDocumentId>& result) const {
+  result.clear();
+  result.resize(keys.size());
+
+  if (keys.size() <= 1) {
+    // nothing to batch
+    for (size_t i = 0; i < keys.size(); ++i) {
+      result[i] = lookupKey(trx, arangodb::velocypack::StringRef(keys[i]));
+    }
+    return;
+  }
+
+  bool const withCache = useCache();
+  bool lockTimeout = false;
+
+  std::vector<RocksDBKey> lookupKeys;
+  lookupKeys.reserve(keys.size());
+  std::vector<size_t> lookupPositions;
+
+  for (size_t i = 0; i < keys.size(); ++i) {
+    TRI_ASSERT(keys[i].isString());
+    lookupKeys.emplace_back();
+    RocksDBKey& key = lookupKeys.back();
+    key.constructPrimaryIndexValue(_objectId, arangodb::velocypack::StringRef(keys[i]));
+
+    if (withCache) {
+      TRI_ASSERT(_cache != nullptr);
+      auto f = _cache->find(key.string().data(), static_cast<uint32_t>(key.string().size()));
+      if (f.found()) {
+        rocksdb::Slice s(reinterpret_cast<char const*>(f.value()->value()),
+                         f.value()->valueSize());
+        result[i] = RocksDBValue::documentId(s);
+        continue;
+      }
+      if (f.result().errorNumber() == TRI_ERROR_LOCK_TIMEOUT) {
+        lockTimeout = true;
+      }
+    }
+    lookupPositions.emplace_back(i);
+  }
+
+  if (lookupPositions.empty()) {
+    return;
+  }
+
+  // look up the keys in index order
+  std::sort(lookupPositions.begin(), lookupPositions.end(), [&lookupKeys](size_t lhs, size_t rhs) {
+    return lookupKeys[lhs].string().compare(lookupKeys[rhs].string()) < 0;
+  });
+  std::vector<rocksdb::Slice> slices;
+  slices.reserve(lookupPositions.size());
+  for (size_t i : lookupPositions) {
+    slices.emplace_back(lookupKeys[i].string());
+  }
+
+  std::vector<std::string> values;
+  RocksDBMethods* mthds = RocksDBTransactionState::toMethods(trx);
+  std::vector<rocksdb::Status> statuses = mthds->MultiGet(_cf, slices, &values);
+  TRI_ASSERT(statuses.size() == slices.size());
+  TRI_ASSERT(values.size() == slices.size());
+
+  for (size_t j = 0; j < slices.size(); ++j) {
+    if (!statuses[j].ok()) {
+      continue;
+    }
+    result[lookupPositions[j]] = RocksDBValue::documentId(values[j]);
+
+    if (withCache && !lockTimeout) {
+      // write entry back to cache
+      auto entry = cache::CachedValue::construct(slices[j].data(),
+                                                 static_cast<uint32_t>(slices[j].size()),
+                                                 values[j].data(),
+                                                 static_cast<uint64_t>(values[j].size()));
+      if (entry) {
+        auto status = _cache->insert(entry);
+        if (status.fail()) {
+          delete entry;
+        }
+      }
+    }
+  }
+}
+
 /// @brief reads a revision id from the primary index
 /// if the document does not exist, this function will return false
 /// if the document exists, the function will return true
@@ -74,11 +74,27 @@ class RocksDBPrimaryIndex final : public RocksDBIndex {
 
   void load() override;
 
+  std::vector<std::string> cachedLookupValues(size_t maxValues) const override;
+
+  void warmupCache(transaction::Methods* trx,
+                   std::vector<std::string> const& values) override;
+
   void toVelocyPack(VPackBuilder&, std::underlying_type<Index::Serialize>::type) const override;
 
   LocalDocumentId lookupKey(transaction::Methods* trx,
                             arangodb::velocypack::StringRef key) const;
 
+  /// @brief looks up a key outside of any transaction, in the latest
+  /// committed state
+  LocalDocumentId lookupKeyLatestCommitted(arangodb::velocypack::StringRef key) const;
+
+  /// @brief looks up multiple keys (strings) with a single MultiGet. the
+  /// i-th document id belongs to the i-th key, and is not set if the key
+  /// does not exist
+  void lookupKeys(transaction::Methods* trx,
+                  std::vector<arangodb::velocypack::Slice> const& keys,
+                  std::vector<LocalDocumentId>& result) const;
+
   /// @brief reads a revision id from the primary index
   /// if the document does not exist, this function will return false
   /// if the document exists, the function will return true
@@ -226,7 +226,7 @@ class WBReader final : public rocksdb::WriteBatch::Handler {
     //          - documents - _rev (revision as maxtick)
     //          - databases
 
-    if (column_family_id == RocksDBColumnFamily::documents()->GetID()) {
+    if (RocksDBColumnFamily::isDocuments(column_family_id)) {
       storeMaxHLC(RocksDBKey::documentId(key).id());
     } else if (column_family_id == RocksDBColumnFamily::primary()->GetID()) {
       // document key
@@ -295,7 +295,7 @@ class WBReader final : public rocksdb::WriteBatch::Handler {
     incTick();
 
     updateMaxTick(column_family_id, key, value);
-    if (column_family_id == RocksDBColumnFamily::documents()->GetID()) {
+    if (RocksDBColumnFamily::isDocuments(column_family_id)) {
       auto coll = findCollection(RocksDBKey::objectId(key));
       if (coll && coll->meta().countUnsafe()._committedSeq < _currentSequence) {
         auto& cc = coll->meta().countUnsafe();
@@ -338,7 +338,7 @@ class WBReader final : public rocksdb::WriteBatch::Handler {
   void handleDeleteCF(uint32_t cfId, const rocksdb::Slice& key) {
     incTick();
 
-    if (cfId == RocksDBColumnFamily::documents()->GetID()) {
+    if (RocksDBColumnFamily::isDocuments(cfId)) {
       uint64_t objectId = RocksDBKey::objectId(key);
 
       storeMaxHLC(RocksDBKey::documentId(key).id());
@@ -415,7 +415,7 @@ class WBReader final : public rocksdb::WriteBatch::Handler {
     }
 
     // check for a range-delete of the primary index
-    if (column_family_id == RocksDBColumnFamily::documents()->GetID()) {
+    if (RocksDBColumnFamily::isDocuments(column_family_id)) {
       uint64_t objectId = RocksDBKey::objectId(begin_key);
       TRI_ASSERT(objectId == RocksDBKey::objectId(end_key));
 
@@ -23,8 +23,44 @@
 
 #include "RocksDBEngine/RocksDBReplicationCommon.h"
 
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
 using namespace arangodb;
 
+namespace {
+/// @brief hashString() of a velocypack String value with the given
+/// contents, built on the stack for all lengths keys can have
+uint64_t hashAsString(char const* p, size_t length) {
+  uint8_t buffer[1 + 8 + 256];
+  size_t offset;
+  if (length <= 126) {
+    buffer[0] = static_cast<uint8_t>(0x40 + length);
+    offset = 1;
+  } else if (length <= 256) {
+    buffer[0] = 0xbf;
+    for (size_t i = 0; i < 8; ++i) {
+      buffer[1 + i] = static_cast<uint8_t>((static_cast<uint64_t>(length) >> (8 * i)) & 0xff);
+    }
+    offset = 9;
+  } else {
+    VPackBuilder b;
+    b.add(VPackValuePair(p, length, VPackValueType::String));
+    return b.slice().hashString();
+  }
+  memcpy(&buffer[offset], p, length);
+  return VPackSlice(&buffer[0]).hashString();
+}
+}  // namespace
+
+uint64_t arangodb::hashKeyAndRevision(arangodb::velocypack::StringRef key, TRI_voc_rid_t rid) {
+  char ridBuffer[21];
+  auto positions = TRI_RidToString(rid, &ridBuffer[0]);
+  return ::hashAsString(key.data(), key.size()) ^
+         ::hashAsString(&ridBuffer[0] + positions.first, positions.second);
+}
+
 RocksDBReplicationResult::RocksDBReplicationResult(int errorNumber, uint64_t maxTick)
     : _result(errorNumber), _maxTick(maxTick), _lastScannedTick(0), _minTickIncluded(false) {}
 
@@ -26,9 +26,18 @@
 
 #include "Basics/Common.h"
 #include "Basics/Result.h"
+#include "VocBase/voc-types.h"
+
+#include <velocypack/StringRef.h>
 
 namespace arangodb {
 
+/// @brief hash of a document key and its revision, as used for comparing
+/// chunks of keys in the incremental sync. this is the xor of hashString()
+/// of both as velocypack String values, which is what the chunk hashes have
+/// always been built from, but the values are not built with a Builder
+uint64_t hashKeyAndRevision(arangodb::velocypack::StringRef key, TRI_voc_rid_t rid);
+
 class RocksDBReplicationResult {
  public:
   RocksDBReplicationResult(int errorNumber, uint64_t lastTick);
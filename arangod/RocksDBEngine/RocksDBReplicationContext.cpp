@@ -33,8 +33,10 @@
 #include "RestServer/DatabaseFeature.h"
 #include "RocksDBEngine/RocksDBCollection.h"
 #include "RocksDBEngine/RocksDBCommon.h"
+#include "RocksDBEngine/RocksDBFormat.h"
 #include "RocksDBEngine/RocksDBMethods.h"
 #include "RocksDBEngine/RocksDBPrimaryIndex.h"
+#include "RocksDBEngine/RocksDBReplicationCommon.h"
 #include "RocksDBReplicationContext.h"
 #include "Transaction/Context.h"
 #include "Transaction/Helpers.h"
@@ -126,16 +128,20 @@ void RocksDBReplicationContext::removeVocbase(TRI_vocbase_t& vocbase) {
 /// remove matching iterator
 void RocksDBReplicationContext::releaseIterators(TRI_vocbase_t& vocbase, TRI_voc_cid_t cid) {
   MUTEX_LOCKER(locker, _contextLock);
-  auto it = _iterators.find(cid);
-  if (it != _iterators.end()) {
+  auto it = _iterators.lower_bound(std::make_pair(cid, uint64_t(0)));
+  if (it == _iterators.end() || it->first.first != cid) {
+    LOG_TOPIC("5a0a1", ERR, Logger::REPLICATION)
+        << "trying to delete non-existent iterator";
+    return;
+  }
+  // remove the iterators of all partitions of the collection
+  while (it != _iterators.end() && it->first.first == cid) {
     if (it->second->isUsed()) {
       LOG_TOPIC("74164", ERR, Logger::REPLICATION) << "trying to delete used iterator";
+      ++it;
     } else {
-      _iterators.erase(it);
+      it = _iterators.erase(it);
     }
-  } else {
-    LOG_TOPIC("5a0a1", ERR, Logger::REPLICATION)
-        << "trying to delete non-existent iterator";
   }
 }
 
@@ -151,7 +157,7 @@ std::tuple<Result, TRI_voc_cid_t, uint64_t> RocksDBReplicationContext::bindColle
 
   MUTEX_LOCKER(writeLocker, _contextLock);
 
-  auto it = _iterators.find(cid);
+  auto it = _iterators.find(std::make_pair(cid, uint64_t(0)));
   if (it != _iterators.end()) {  // nothing to do here
     return std::make_tuple(Result{}, it->second->logical->id(), it->second->numberDocuments);
   }
@@ -178,12 +184,12 @@ std::tuple<Result, TRI_voc_cid_t, uint64_t> RocksDBReplicationContext::bindColle
   TRI_ASSERT(_snapshot != nullptr);
 
   auto iter = std::make_unique<CollectionIterator>(vocbase, logical, true, _snapshot);
-  auto result = _iterators.emplace(cid, std::move(iter));
+  auto result = _iterators.emplace(std::make_pair(cid, uint64_t(0)), std::move(iter));
   TRI_ASSERT(result.second);
 
   CollectionIterator* cIter = result.first->second.get();
   if (nullptr == cIter->iter) {
-    _iterators.erase(cid);
+    _iterators.erase(result.first);
     return std::make_tuple(Result(TRI_ERROR_INTERNAL,
                                   "could not create db iterators"),
                            0, 0);
@@ -241,7 +247,8 @@ Result RocksDBReplicationContext::getInventory(TRI_vocbase_t& vocbase, bool incl
 // creating a new iterator if one does not exist for this collection
 RocksDBReplicationContext::DumpResult RocksDBReplicationContext::dumpJson(
     TRI_vocbase_t& vocbase, std::string const& cname,
-    basics::StringBuffer& buff, uint64_t chunkSize) {
+    basics::StringBuffer& buff, uint64_t chunkSize,
+    uint64_t partition, uint64_t numPartitions) {
   TRI_ASSERT(_users > 0);
   CollectionIterator* cIter{nullptr};
   auto guard = scopeGuard([&] { releaseDumpIterator(cIter); });
@@ -253,13 +260,14 @@ RocksDBReplicationContext::DumpResult RocksDBReplicationContext::dumpJson(
     }
 
     MUTEX_LOCKER(writeLocker, _contextLock);
-    cIter = getCollectionIterator(vocbase, cid, /*sorted*/ false, /*create*/ true);
+    cIter = getCollectionIterator(vocbase, cid, /*sorted*/ false, /*create*/ true,
+                                  partition, numPartitions);
     if (!cIter || cIter->sorted() || !cIter->iter) {
       return DumpResult(TRI_ERROR_BAD_PARAMETER);
     }
   }
 
-  TRI_ASSERT(cIter->bounds.columnFamily() == RocksDBColumnFamily::documents());
+  TRI_ASSERT(RocksDBColumnFamily::isDocuments(cIter->bounds.columnFamily()->GetID()));
 
   arangodb::basics::VPackStringBufferAdapter adapter(buff.stringBuffer());
   VPackDumper dumper(&adapter, &cIter->vpackOptions);
@@ -285,7 +293,8 @@ RocksDBReplicationContext::DumpResult RocksDBReplicationContext::dumpJson(
 // creating a new iterator if one does not exist for this collection
 RocksDBReplicationContext::DumpResult RocksDBReplicationContext::dumpVPack(
     TRI_vocbase_t& vocbase, std::string const& cname,
-    VPackBuffer<uint8_t>& buffer, uint64_t chunkSize) {
+    VPackBuffer<uint8_t>& buffer, uint64_t chunkSize,
+    uint64_t partition, uint64_t numPartitions) {
   TRI_ASSERT(_users > 0 && chunkSize > 0);
 
   CollectionIterator* cIter{nullptr};
@@ -298,13 +307,14 @@ RocksDBReplicationContext::DumpResult RocksDBReplicationContext::dumpVPack(
     }
 
     MUTEX_LOCKER(writeLocker, _contextLock);
-    cIter = getCollectionIterator(vocbase, cid, /*sorted*/ false, /*create*/ true);
+    cIter = getCollectionIterator(vocbase, cid, /*sorted*/ false, /*create*/ true,
+                                  partition, numPartitions);
     if (!cIter || cIter->sorted() || !cIter->iter) {
       return DumpResult(TRI_ERROR_BAD_PARAMETER);
     }
   }
 
-  TRI_ASSERT(cIter->bounds.columnFamily() == RocksDBColumnFamily::documents());
+  TRI_ASSERT(RocksDBColumnFamily::isDocuments(cIter->bounds.columnFamily()->GetID()));
 
   VPackBuilder builder(buffer, &cIter->vpackOptions);
   TRI_ASSERT(cIter->iter && !cIter->sorted());
@@ -355,9 +365,7 @@ arangodb::Result RocksDBReplicationContext::dumpKeyChunks(TRI_vocbase_t& vocbase
 
   // reserve some space in the result builder to avoid frequent reallocations
   b.reserve(8192);
-  char ridBuffer[21];  // temporary buffer for stringifying revision ids
   RocksDBKey docKey;
-  VPackBuilder tmpHashBuilder;
   rocksdb::TransactionDB* db = globalRocksDB();
   auto* rcoll = static_cast<RocksDBCollection*>(cIter->logical->getPhysical());
   const uint64_t cObjectId = rcoll->objectId();
@@ -386,7 +394,7 @@ arangodb::Result RocksDBReplicationContext::dumpKeyChunks(TRI_vocbase_t& vocbase
         docKey.constructDocument(cObjectId, docId);
 
         rocksdb::PinnableSlice ps;
-        auto s = db->Get(cIter->readOptions(), RocksDBColumnFamily::documents(),
+        auto s = db->Get(cIter->readOptions(), rcoll->documentsColumnFamily(),
                          docKey.string(), &ps);
         if (s.ok()) {
           TRI_ASSERT(ps.size() > 0);
@@ -403,12 +411,7 @@ arangodb::Result RocksDBReplicationContext::dumpKeyChunks(TRI_vocbase_t& vocbase
 
       // we can get away with the fast hash function here, as key values are
       // restricted to strings
-      tmpHashBuilder.clear();
-      tmpHashBuilder.add(VPackValuePair(key.data(), key.size(), VPackValueType::String));
-      hash ^= tmpHashBuilder.slice().hashString();
-      tmpHashBuilder.clear();
-      tmpHashBuilder.add(TRI_RidToValuePair(docRev, &ridBuffer[0]));
-      hash ^= tmpHashBuilder.slice().hashString();
+      hash ^= hashKeyAndRevision(key, docRev);
 
       cIter->iter->Next();
     };
@@ -532,7 +535,7 @@ arangodb::Result RocksDBReplicationContext::dumpKeys(TRI_vocbase_t& vocbase,
       tmpKey.constructDocument(cObjectId, docId);
 
       rocksdb::PinnableSlice ps;
-      auto s = db->Get(cIter->readOptions(), RocksDBColumnFamily::documents(),
+      auto s = db->Get(cIter->readOptions(), rcoll->documentsColumnFamily(),
                        tmpKey.string(), &ps);
       if (s.ok()) {
         TRI_ASSERT(ps.size() > 0);
@@ -670,7 +673,7 @@ arangodb::Result RocksDBReplicationContext::dumpDocuments(
         tmpKey.constructDocument(cObjectId, docId);
 
         rocksdb::PinnableSlice ps;
-        auto s = db->Get(cIter->readOptions(), RocksDBColumnFamily::documents(),
+        auto s = db->Get(cIter->readOptions(), rcoll->documentsColumnFamily(),
                          tmpKey.string(), &ps);
         if (s.ok()) {
           TRI_ASSERT(ps.size() > 0);
@@ -792,6 +795,7 @@ RocksDBReplicationContext::CollectionIterator::CollectionIterator(
       vpackOptions{Options::Defaults},
       numberDocuments{0},
       isNumberDocumentsExclusive{false},
+      partition{0},
       _resolver(vocbase),
       _cTypeHandler{},
       _readOptions{},
@@ -852,6 +856,50 @@ void RocksDBReplicationContext::CollectionIterator::setSorted(bool sorted) {
   }
 }
 
+void RocksDBReplicationContext::CollectionIterator::setPartition(uint64_t p,
+                                                                 uint64_t numPartitions) {
+  TRI_ASSERT(!_sortedIterator);
+  TRI_ASSERT(numPartitions > 1 && p < numPartitions);
+
+  auto* rcoll = static_cast<RocksDBCollection*>(logical->getPhysical());
+  RocksDBKeyBounds all = RocksDBKeyBounds::CollectionDocuments(rcoll->objectId());
+
+  // determine the key suffixes of the first and the last document in the
+  // snapshot, and split the keyspace between them into equally sized ranges
+  uint64_t lower = 0;
+  uint64_t upper = 0;
+  {
+    rocksdb::Slice const end = all.end();
+    rocksdb::ReadOptions ro = _readOptions;
+    ro.iterate_upper_bound = &end;
+    std::unique_ptr<rocksdb::Iterator> it(
+        rocksutils::globalRocksDB()->NewIterator(ro, all.columnFamily()));
+    it->Seek(all.start());
+    if (it->Valid() && it->key().size() >= 2 * sizeof(uint64_t)) {
+      lower = uintFromPersistentBigEndian<uint64_t>(it->key().data() + sizeof(uint64_t));
+      it->SeekForPrev(end);
+      if (it->Valid() && it->key().size() >= 2 * sizeof(uint64_t)) {
+        upper = uintFromPersistentBigEndian<uint64_t>(it->key().data() + sizeof(uint64_t));
+      }
+    }
+  }
+  TRI_ASSERT(upper >= lower);
+
+  uint64_t const step = (upper - lower) / numPartitions;
+  uint64_t const from = lower + step * p;
+  // the upper bound is exclusive, the last range includes all remaining keys
+  uint64_t const to = (p + 1 == numPartitions) ? UINT64_MAX : lower + step * (p + 1);
+
+  partition = p + 1;
+  bounds = RocksDBKeyBounds::CollectionDocumentRange(rcoll->objectId(), from, to);
+  _upperLimit = bounds.end();
+  _readOptions.iterate_upper_bound = &_upperLimit;
+  iter.reset(rocksutils::globalRocksDB()->NewIterator(_readOptions, bounds.columnFamily()));
+  TRI_ASSERT(iter);
+  iter->Seek(bounds.start());
+  currentTick = 1;
+}
+
 // iterator convenience methods
 
 bool RocksDBReplicationContext::CollectionIterator::hasMore() const {
@@ -877,13 +925,17 @@ void RocksDBReplicationContext::CollectionIterator::resetToStart() {
 }
 
 RocksDBReplicationContext::CollectionIterator* RocksDBReplicationContext::getCollectionIterator(
-    TRI_vocbase_t& vocbase, TRI_voc_cid_t cid, bool sorted, bool allowCreate) {
+    TRI_vocbase_t& vocbase, TRI_voc_cid_t cid, bool sorted, bool allowCreate,
+    uint64_t partition, uint64_t numPartitions) {
   _contextLock.assertLockedByCurrentThread();
   lazyCreateSnapshot();
 
+  TRI_ASSERT(numPartitions <= 1 || !sorted);
+  auto const key = std::make_pair(cid, numPartitions > 1 ? partition + 1 : 0);
+
   CollectionIterator* cIter{nullptr};
   // check if iterator already exists
-  auto it = _iterators.find(cid);
+  auto it = _iterators.find(key);
 
   if (_iterators.end() != it) {
     // exists, check if used
@@ -901,15 +953,18 @@ RocksDBReplicationContext::CollectionIterator* RocksDBReplicationContext::getCol
 
     if (nullptr != logical) {
       auto result =
-          _iterators.emplace(cid, std::make_unique<CollectionIterator>(vocbase, logical, sorted,
+          _iterators.emplace(key, std::make_unique<CollectionIterator>(vocbase, logical, sorted,
                                                                        _snapshot));
 
       if (result.second) {
         cIter = result.first->second.get();
+        if (numPartitions > 1 && cIter->iter) {
+          cIter->setPartition(partition, numPartitions);
+        }
 
         if (nullptr == cIter->iter) {
           cIter = nullptr;
-          _iterators.erase(cid);
+          _iterators.erase(key);
         }
       }
     }
@@ -939,7 +994,7 @@ void RocksDBReplicationContext::releaseDumpIterator(CollectionIterator* it) {
     if (!it->hasMore()) {
       it->vocbase.replicationClients().track(replicationClientId(), _snapshotTick, _ttl);
       MUTEX_LOCKER(locker, _contextLock);
-      _iterators.erase(it->logical->id());
+      _iterators.erase(std::make_pair(it->logical->id(), it->partition));
     } else {  // Context::release() will update the replication client
       it->release();
     }
@@ -81,10 +81,16 @@ class RocksDBReplicationContext {
     uint64_t numberDocuments;
     /// @brief snapshot and number documents were fetched exclusively
     bool isNumberDocumentsExclusive;
+    /// @brief 1-based number of the key range this iterator is restricted
+    /// to, 0 if it covers the whole collection
+    uint64_t partition;
 
     rocksdb::ReadOptions const& readOptions() const { return _readOptions; }
     bool sorted() const { return _sortedIterator; }
     void setSorted(bool);
+    /// restrict an unsorted iterator to one of numPartitions disjoint
+    /// key ranges of the collection
+    void setPartition(uint64_t partition, uint64_t numPartitions);
 
     void use() noexcept {
       TRI_ASSERT(!isUsed());
@@ -163,14 +169,19 @@ class RocksDBReplicationContext {
   };
 
   // iterates over at most 'limit' documents in the collection specified,
-  // creating a new iterator if one does not exist for this collection
+  // creating a new iterator if one does not exist for this collection.
+  // if numPartitions > 1, only the documents of the given key range
+  // (0-based) of the collection are returned, so that several clients can
+  // dump disjoint parts of the collection from the same snapshot
   DumpResult dumpJson(TRI_vocbase_t& vocbase, std::string const& cname,
-                      basics::StringBuffer&, uint64_t chunkSize);
+                      basics::StringBuffer&, uint64_t chunkSize,
+                      uint64_t partition = 0, uint64_t numPartitions = 1);
 
   // iterates over at most 'limit' documents in the collection specified,
   // creating a new iterator if one does not exist for this collection
   DumpResult dumpVPack(TRI_vocbase_t& vocbase, std::string const& cname,
-                       velocypack::Buffer<uint8_t>& buffer, uint64_t chunkSize);
+                       velocypack::Buffer<uint8_t>& buffer, uint64_t chunkSize,
+                       uint64_t partition = 0, uint64_t numPartitions = 1);
 
   // ==================== Incremental Sync ===========================
 
@@ -211,7 +222,9 @@ class RocksDBReplicationContext {
   void lazyCreateSnapshot();
 
   CollectionIterator* getCollectionIterator(TRI_vocbase_t& vocbase, TRI_voc_cid_t cid,
-                                            bool sorted, bool allowCreate);
+                                            bool sorted, bool allowCreate,
+                                            uint64_t partition = 0,
+                                            uint64_t numPartitions = 1);
 
   void releaseDumpIterator(CollectionIterator*);
 
@@ -222,7 +235,8 @@ class RocksDBReplicationContext {
 
   uint64_t _snapshotTick;  // tick in WAL from _snapshot
   rocksdb::Snapshot const* _snapshot;
-  std::map<TRI_voc_cid_t, std::unique_ptr<CollectionIterator>> _iterators;
+  /// iterators by collection id and partition (0 for whole collections)
+  std::map<std::pair<TRI_voc_cid_t, uint64_t>, std::unique_ptr<CollectionIterator>> _iterators;
 
   double const _ttl;
   /// @brief expiration time, updated under lock by ReplicationManager
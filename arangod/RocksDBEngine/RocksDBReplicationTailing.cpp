@@ -111,7 +111,6 @@ class WALParser final : public rocksdb::WriteBatch::Handler {
   WALParser(TRI_vocbase_t* vocbase, bool includeSystem,
             TRI_voc_cid_t collectionId, VPackBuilder& builder)
       : _definitionsCF(RocksDBColumnFamily::definitions()->GetID()),
-        _documentsCF(RocksDBColumnFamily::documents()->GetID()),
         _primaryCF(RocksDBColumnFamily::primary()->GetID()),
 
         _vocbase(vocbase),
@@ -389,7 +388,7 @@ class WALParser final : public rocksdb::WriteBatch::Handler {
       // reset everything immediately after DDL operations
       resetTransientState();
 
-    } else if (column_family_id == _documentsCF) {
+    } else if (RocksDBColumnFamily::isDocuments(column_family_id)) {
       if (_state != TRANSACTION && _state != SINGLE_PUT) {
         resetTransientState();
         return rocksdb::Status();
@@ -600,7 +599,6 @@ class WALParser final : public rocksdb::WriteBatch::Handler {
 
  private:
   uint32_t const _definitionsCF;
-  uint32_t const _documentsCF;
   uint32_t const _primaryCF;
 
   // these parameters are relevant to determine if we can print
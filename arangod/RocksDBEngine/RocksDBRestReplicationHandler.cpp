@@ -669,6 +669,16 @@ void RocksDBRestReplicationHandler::handleCommandDump() {
     return;
   }
 
+  // optionally restrict the dump to one of several disjoint key ranges,
+  // so that multiple clients can dump a collection in parallel
+  uint64_t const numPartitions = _request->parsedValue("partitions", static_cast<uint64_t>(1));
+  uint64_t const partition = _request->parsedValue("partition", static_cast<uint64_t>(0));
+  if (numPartitions == 0 || numPartitions > 1024 || partition >= numPartitions) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                  "invalid partition/partitions values");
+    return;
+  }
+
   uint64_t chunkSize = determineChunkSize();
   size_t reserve = std::max<size_t>(chunkSize, 8192);
 
@@ -677,7 +687,7 @@ void RocksDBRestReplicationHandler::handleCommandDump() {
     VPackBuffer<uint8_t> buffer;
     buffer.reserve(reserve);  // avoid reallocs
 
-    res = ctx->dumpVPack(_vocbase, cname, buffer, chunkSize);
+    res = ctx->dumpVPack(_vocbase, cname, buffer, chunkSize, partition, numPartitions);
     // generate the result
     if (res.fail()) {
       generateError(res.result());
@@ -706,7 +716,7 @@ void RocksDBRestReplicationHandler::handleCommandDump() {
     }
 
     // do the work!
-    res = ctx->dumpJson(_vocbase, cname, dump, determineChunkSize());
+    res = ctx->dumpJson(_vocbase, cname, dump, chunkSize, partition, numPartitions);
 
     if (res.fail()) {
       if (res.is(TRI_ERROR_BAD_PARAMETER)) {
@@ -55,6 +55,11 @@
 #include <velocypack/velocypack-aliases.h>
 
 namespace {
+/// @brief number of bytes of index estimates a regular sync serializes at
+/// most. the estimates of further indexes are written by the next syncs, so
+/// that a single sync does not take too long
+constexpr size_t maxEstimatorBytesPerSync = 16 * 1024 * 1024;
+
 arangodb::Result writeSettings(rocksdb::WriteBatch& batch, VPackBuilder& b, uint64_t seqNumber) {
   using arangodb::EngineSelectorFeature;
   using arangodb::Logger;
@@ -96,7 +101,7 @@ namespace arangodb {
 /// Constructor needs to be called synchrunously,
 /// will load counts from the db and scan the WAL
 RocksDBSettingsManager::RocksDBSettingsManager(rocksdb::TransactionDB* db)
-    : _lastSync(0), _syncing(false), _db(db->GetRootDB()), _initialReleasedTick(0) {}
+    : _syncStart(0), _lastSync(0), _syncing(false), _db(db->GetRootDB()), _initialReleasedTick(0) {}
 
 /// retrieve initial values from the database
 void RocksDBSettingsManager::retrieveInitialValues() {
@@ -161,8 +166,17 @@ Result RocksDBSettingsManager::sync(bool force) {
   TRI_ASSERT(!engine->inRecovery()); // just don't
 
   bool didWork = false;
+  size_t estimatorBudget = ::maxEstimatorBytesPerSync;
   auto mappings = engine->collectionMappings();
-  for (auto const& pair : mappings) {
+  size_t const start = mappings.empty() ? 0 : _syncStart % mappings.size();
+  _syncStart = start;
+  for (size_t i = 0; i < mappings.size(); ++i) {
+    auto const& pair = mappings[(start + i) % mappings.size()];
+    if (estimatorBudget == 0 && _syncStart == start) {
+      // the budget ran out with the previous collection, the next sync
+      // starts here
+      _syncStart = (start + i) % mappings.size();
+    }
     TRI_voc_tick_t dbid = pair.first;
     TRI_voc_cid_t cid = pair.second;
     TRI_vocbase_t* vocbase = dbfeature->useDatabase(dbid);
@@ -184,7 +198,8 @@ Result RocksDBSettingsManager::sync(bool force) {
 
     auto* rcoll = static_cast<RocksDBCollection*>(coll->getPhysical());
     rocksdb::SequenceNumber appliedSeq = maxSeqNr;
-    Result res = rcoll->meta().serializeMeta(batch, *coll, force, _tmpBuilder, appliedSeq);
+    Result res = rcoll->meta().serializeMeta(batch, *coll, force, _tmpBuilder,
+                                             appliedSeq, estimatorBudget);
     minSeqNr = std::min(minSeqNr, appliedSeq);
 
     const std::string err = "could not sync metadata for collection '";
@@ -204,7 +219,10 @@ Result RocksDBSettingsManager::sync(bool force) {
     batch.Clear();
   }
 
-  TRI_ASSERT(_lastSync.load() <= minSeqNr);
+  // indexes with postponed estimates report the sequence number their
+  // estimates were last written at. their changes since then are all newer
+  // than the last sync, so the WAL before it is not needed for them
+  minSeqNr = std::max(minSeqNr, _lastSync.load());
   if (!didWork) {
     _lastSync.store(minSeqNr);
     return Result();  // nothing was written
@@ -71,6 +71,11 @@ class RocksDBSettingsManager {
   /// @brief a reusable builder, used inside sync() to serialize objects
   arangodb::velocypack::Builder _tmpBuilder;
 
+  /// @brief position in the collection mappings the next sync starts at.
+  /// a sync that used up its budget for index estimates continues from
+  /// there, so that all collections get their turn
+  size_t _syncStart;
+
   /// @brief last sync sequence number
   std::atomic<rocksdb::SequenceNumber> _lastSync;
 
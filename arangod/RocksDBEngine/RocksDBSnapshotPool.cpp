@@ -0,0 +1,60 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RocksDBSnapshotPool.h"
+
+#include "Basics/ReadLocker.h"
+#include "Basics/WriteLocker.h"
+
+#include <rocksdb/db.h>
+
+using namespace arangodb;
+
+RocksDBSnapshotPool::RocksDBSnapshotPool(rocksdb::DB* db, std::chrono::microseconds maxAge)
+    : _db(db), _maxAge(maxAge) {
+  TRI_ASSERT(_db != nullptr);
+}
+
+RocksDBSnapshotPool::~RocksDBSnapshotPool() {
+  // transactions still holding the snapshot release it on their own
+  WRITE_LOCKER(locker, _lock);
+  _current.reset();
+}
+
+std::shared_ptr<rocksdb::Snapshot const> RocksDBSnapshotPool::acquire() {
+  auto const now = std::chrono::steady_clock::now();
+
+  {
+    READ_LOCKER(locker, _lock);
+    if (_current != nullptr && now - _created <= _maxAge) {
+      return _current;
+    }
+  }
+
+  WRITE_LOCKER(locker, _lock);
+  // another thread may have refreshed the snapshot in the meantime
+  if (_current == nullptr || now - _created > _maxAge) {
+    rocksdb::DB* db = _db;
+    _current.reset(db->GetSnapshot(),
+                   [db](rocksdb::Snapshot const* snapshot) { db->ReleaseSnapshot(snapshot); });
+    _created = std::chrono::steady_clock::now();
+  }
+  return _current;
+}
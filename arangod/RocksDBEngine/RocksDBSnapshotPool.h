@@ -0,0 +1,66 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_ROCKSDB_ENGINE_ROCKSDB_SNAPSHOT_POOL_H
+#define ARANGOD_ROCKSDB_ENGINE_ROCKSDB_SNAPSHOT_POOL_H 1
+
+#include "Basics/Common.h"
+#include "Basics/ReadWriteSpinLock.h"
+
+#include <chrono>
+#include <memory>
+
+namespace rocksdb {
+class DB;
+class Snapshot;
+}  // namespace rocksdb
+
+namespace arangodb {
+
+/// @brief hands out RocksDB snapshots to read-only transactions that opted
+/// in via transaction::Options::shareReadSnapshot. all transactions starting
+/// within maxAge of each other get the same snapshot, so that RocksDB's
+/// snapshot list (and its mutex) is touched once per interval instead of
+/// twice per transaction. a snapshot is released when the last transaction
+/// using it has finished and the pool has moved on to a newer one
+class RocksDBSnapshotPool {
+ public:
+  RocksDBSnapshotPool(rocksdb::DB* db, std::chrono::microseconds maxAge);
+  ~RocksDBSnapshotPool();
+
+  RocksDBSnapshotPool(RocksDBSnapshotPool const&) = delete;
+  RocksDBSnapshotPool& operator=(RocksDBSnapshotPool const&) = delete;
+
+  /// @brief returns a snapshot which is at most maxAge old
+  std::shared_ptr<rocksdb::Snapshot const> acquire();
+
+ private:
+  rocksdb::DB* _db;
+  std::chrono::microseconds const _maxAge;
+
+  /// @brief protects _current and _created
+  basics::ReadWriteSpinLock _lock;
+  std::shared_ptr<rocksdb::Snapshot const> _current;
+  std::chrono::steady_clock::time_point _created;
+};
+
+}  // namespace arangodb
+
+#endif
@@ -36,17 +36,45 @@ RocksDBSyncThread::RocksDBSyncThread(RocksDBEngine* engine, std::chrono::millise
       _engine(engine),
       _interval(interval),
       _lastSyncTime(std::chrono::steady_clock::now()),
-      _lastSequenceNumber(0) {}
+      _lastSequenceNumber(0),
+      _lastSyncedSequenceNumber(0),
+      _syncing(false) {}
 
 RocksDBSyncThread::~RocksDBSyncThread() { shutdown(); }
 
 Result RocksDBSyncThread::syncWal() {
+  return syncWal(_engine->db()->GetBaseDB()->GetLatestSequenceNumber());
+}
+
+Result RocksDBSyncThread::syncWal(rocksdb::SequenceNumber sequenceNumber) {
   // note the following line in RocksDB documentation (rocksdb/db.h):
   // > Currently only works if allow_mmap_writes = false in Options.
   TRI_ASSERT(!_engine->rocksDBOptions().allow_mmap_writes);
 
   auto db = _engine->db()->GetBaseDB();
 
+  // group commit: while one caller syncs, all others wait for the sync to
+  // finish. if it covered their writes, they are done without syncing again,
+  // otherwise one of them syncs the writes of all that have queued up in
+  // the meantime
+  rocksdb::SequenceNumber target;
+  {
+    CONDITION_LOCKER(guard, _syncCondition);
+
+    while (true) {
+      if (_lastSyncedSequenceNumber >= sequenceNumber) {
+        return Result();
+      }
+      if (!_syncing) {
+        break;
+      }
+      guard.wait();
+    }
+
+    _syncing = true;
+    target = db->GetLatestSequenceNumber();
+  }
+
   // set time of last syncing under the lock
   auto const now = std::chrono::steady_clock::now();
   {
@@ -57,16 +85,30 @@ Result RocksDBSyncThread::syncWal() {
       _lastSyncTime = now;
     }
 
-    auto lastSequenceNumber = db->GetLatestSequenceNumber();
-
-    if (lastSequenceNumber > _lastSequenceNumber) {
+    if (target > _lastSequenceNumber) {
       // update last sequence number
-      _lastSequenceNumber = lastSequenceNumber;
+      _lastSequenceNumber = target;
     }
   }
 
   // actual syncing is done without holding the lock
-  return sync(db);
+  Result res;
+  try {
+    res = sync(db);
+  } catch (...) {
+    CONDITION_LOCKER(guard, _syncCondition);
+    _syncing = false;
+    guard.broadcast();
+    throw;
+  }
+
+  CONDITION_LOCKER(guard, _syncCondition);
+  _syncing = false;
+  if (res.ok()) {
+    _lastSyncedSequenceNumber = std::max(_lastSyncedSequenceNumber, target);
+  }
+  guard.broadcast();
+  return res;
 }
 
 Result RocksDBSyncThread::sync(rocksdb::DB* db) {
@@ -103,6 +145,7 @@ void RocksDBSyncThread::run() {
   while (!isStopping()) {
     try {
       auto const now = std::chrono::steady_clock::now();
+      rocksdb::SequenceNumber target;
 
       {
         // wait for time to elapse, and after that update last sync time
@@ -131,12 +174,16 @@ void RocksDBSyncThread::run() {
         }
 
         _lastSequenceNumber = lastSequenceNumber;
+        target = lastSequenceNumber;
       }
 
       // will update last sync time, and do the actual sync
       Result res = sync(db);
 
-      if (res.fail()) {
+      if (res.ok()) {
+        CONDITION_LOCKER(guard, _syncCondition);
+        _lastSyncedSequenceNumber = std::max(_lastSyncedSequenceNumber, target);
+      } else {
         LOG_TOPIC("5e275", WARN, Logger::ENGINES)
             << "could not sync RocksDB WAL: " << res.errorMessage();
       }
@@ -53,6 +53,10 @@ class RocksDBSyncThread final : public Thread {
   /// syncs by foreground work and the background sync thread
   Result syncWal();
 
+  /// @brief makes sure the WAL is synced up to the given sequence number.
+  /// concurrent callers are served by a single sync
+  Result syncWal(rocksdb::SequenceNumber sequenceNumber);
+
   /// @brief unconditionally syncs the RocksDB WAL, static variant
   static Result sync(rocksdb::DB* db);
 
@@ -73,6 +77,16 @@ class RocksDBSyncThread final : public Thread {
 
   /// @brief protects _lastSyncTime and _lastSequenceNumber
   arangodb::basics::ConditionVariable _condition;
+
+  /// @brief the last sequence number up to which a sync has finished
+  rocksdb::SequenceNumber _lastSyncedSequenceNumber;
+
+  /// @brief whether a caller of syncWal() is currently syncing
+  bool _syncing;
+
+  /// @brief protects _lastSyncedSequenceNumber and _syncing, signaled
+  /// when a sync has finished
+  arangodb::basics::ConditionVariable _syncCondition;
 };
 }  // namespace arangodb
 
@@ -103,7 +103,13 @@ RocksDBThrottle::RocksDBThrottle()
       _threadRunning(false),
       _replaceIdx(2),
       _throttleBps(0),
-      _firstThrottle(true) {
+      _firstThrottle(true),
+      _maxPendingCompactionBytes(0),
+      _baseBackgroundJobs(0),
+      _maxBackgroundJobs(0),
+      _reportedBps(0),
+      _reportedBacklog(0),
+      _currentBackgroundJobs(0) {
   memset(&_throttleData, 0, sizeof(_throttleData));
 }
 
@@ -295,6 +301,9 @@ void RocksDBThrottle::RecalculateThrottle() {
   temp_rate = 0;
 
   compaction_backlog = ComputeBacklog();
+  _reportedBacklog.store(compaction_backlog);
+
+  AdjustBackgroundJobs(compaction_backlog);
 
   {
     MUTEX_LOCKER(mutexLocker, _threadMutex);
@@ -370,12 +379,14 @@ void RocksDBThrottle::RecalculateThrottle() {
           << "RecalculateThrottle(): old " << _throttleBps << ", new " << temp_rate;
 
       _throttleBps = temp_rate;
+      _reportedBps.store(_throttleBps);
 
       // prepare for next interval
       memset(&_throttleData[0], 0, sizeof(_throttleData[0]));
     } else if (1 < new_throttle) {
       // never had a valid throttle, and have first hint now
       _throttleBps = new_throttle;
+      _reportedBps.store(_throttleBps);
 
       LOG_TOPIC("e0bbb", DEBUG, arangodb::Logger::ENGINES)
           << "RecalculateThrottle(): first " << _throttleBps;
@@ -490,9 +501,62 @@ int64_t RocksDBThrottle::ComputeBacklog() {
     compaction_backlog += (imm_backlog - imm_trigger);
   }  // if
 
+  // one more step for every 10% of pending compaction bytes above the limit
+  if (0 != _maxPendingCompactionBytes) {
+    uint64_t pending_bytes = 0;
+    uint64_t value;
+
+    for (auto& cf : _families) {
+      if (_internalRocksDB->GetIntProperty(
+              cf, rocksdb::DB::Properties::kEstimatePendingCompactionBytes, &value)) {
+        pending_bytes += value;
+      }  // if
+    }    // for
+
+    if (_maxPendingCompactionBytes < pending_bytes) {
+      compaction_backlog +=
+          1 + static_cast<int64_t>(((pending_bytes - _maxPendingCompactionBytes) * 10) /
+                                   _maxPendingCompactionBytes);
+    }  // if
+  }    // if
+
   return compaction_backlog;
 }  // RocksDBThrottle::Computebacklog
 
+///
+/// @brief Give compactions one more background job per interval while
+///  they are behind, and take them away again one by one afterwards
+///
+void RocksDBThrottle::AdjustBackgroundJobs(int64_t Backlog) {
+  int current, target;
+
+  if (_maxBackgroundJobs <= _baseBackgroundJobs) {
+    return;
+  }  // if
+
+  current = _currentBackgroundJobs.load();
+  if (0 < Backlog) {
+    target = std::min(current + 1, _maxBackgroundJobs);
+  } else {
+    target = std::max(current - 1, _baseBackgroundJobs);
+  }  // else
+
+  if (target != current) {
+    rocksdb::Status s = _internalRocksDB->SetDBOptions(
+        {{"max_background_jobs", std::to_string(target)}});
+
+    if (s.ok()) {
+      _currentBackgroundJobs.store(target);
+      LOG_TOPIC("2d7a4", DEBUG, arangodb::Logger::ENGINES)
+          << "AdjustBackgroundJobs(): max_background_jobs " << target;
+    } else {
+      LOG_TOPIC("c8e07", WARN, arangodb::Logger::ENGINES)
+          << "AdjustBackgroundJobs(): could not set max_background_jobs: "
+          << s.ToString();
+    }  // else
+  }    // if
+}  // RocksDBThrottle::AdjustBackgroundJobs
+
 /// @brief Adjust the active thread's priority to match the work
 ///  it is performing.  The routine is called HEAVILY.
 void RocksDBThrottle::AdjustThreadPriority(int Adjustment) {
@@ -83,6 +83,23 @@ class RocksDBThrottle : public rocksdb::EventListener {
     _families = Families;
   }
 
+  /// @brief additional goals of the throttle: keep the estimated pending
+  /// compaction bytes below maxPendingCompactionBytes (0 = no limit), and
+  /// raise the number of background jobs from baseBackgroundJobs up to
+  /// maxBackgroundJobs while compactions are behind
+  void SetLimits(uint64_t maxPendingCompactionBytes, int baseBackgroundJobs,
+                 int maxBackgroundJobs) {
+    _maxPendingCompactionBytes = maxPendingCompactionBytes;
+    _baseBackgroundJobs = baseBackgroundJobs;
+    _maxBackgroundJobs = std::max(maxBackgroundJobs, baseBackgroundJobs);
+    _currentBackgroundJobs.store(baseBackgroundJobs);
+  }
+
+  /// @brief the decisions of the throttle, for statistics
+  uint64_t GetThrottleRate() const { return _reportedBps.load(); }
+  int64_t GetBacklog() const { return _reportedBacklog.load(); }
+  int GetBackgroundJobs() const { return _currentBackgroundJobs.load(); }
+
   static void AdjustThreadPriority(int Adjustment);
 
   void StopThread();
@@ -101,6 +118,8 @@ class RocksDBThrottle : public rocksdb::EventListener {
 
   void RecalculateThrottle();
 
+  void AdjustBackgroundJobs(int64_t Backlog);
+
   // I am unable to figure out static initialization of std::chrono::seconds,
   //  using old school unsigned.
   static constexpr unsigned THROTTLE_SECONDS = 60;
@@ -145,6 +164,14 @@ class RocksDBThrottle : public rocksdb::EventListener {
   std::unique_ptr<WriteControllerToken> _delayToken;
   std::vector<rocksdb::ColumnFamilyHandle*> _families;
 
+  uint64_t _maxPendingCompactionBytes;
+  int _baseBackgroundJobs;
+  int _maxBackgroundJobs;
+
+  std::atomic<uint64_t> _reportedBps;
+  std::atomic<int64_t> _reportedBacklog;
+  std::atomic<int> _currentBackgroundJobs;
+
 };  // class RocksDBThrottle
 
 }  // namespace arangodb
@@ -230,6 +230,7 @@ void RocksDBTransactionCollection::commitCounts(TRI_voc_tid_t trxId, uint64_t co
       continue;
     }
     auto ridx = static_cast<RocksDBIndex*>(idx.get());
+    ridx->afterCommit(pair.second.inserts, pair.second.removals);
     auto est = ridx->estimator();
     if (ADB_LIKELY(est != nullptr)) {
       est->bufferUpdates(commitSeq, std::move(pair.second.inserts),
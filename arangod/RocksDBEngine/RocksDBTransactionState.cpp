@@ -34,6 +34,7 @@
 #include "RocksDBEngine/RocksDBEngine.h"
 #include "RocksDBEngine/RocksDBLogValue.h"
 #include "RocksDBEngine/RocksDBMethods.h"
+#include "RocksDBEngine/RocksDBSnapshotPool.h"
 #include "RocksDBEngine/RocksDBSyncThread.h"
 #include "RocksDBEngine/RocksDBTransactionCollection.h"
 #include "StorageEngine/EngineSelectorFeature.h"
@@ -120,7 +121,15 @@ Result RocksDBTransactionState::beginTransaction(transaction::Hints hints) {
     if (isReadOnlyTransaction()) {
       // no need to acquire a snapshot for a single op
       if (!isSingleOperation()) {
-        _readSnapshot = db->GetSnapshot();  // must call ReleaseSnapshot later
+        RocksDBSnapshotPool* pool = _options.shareReadSnapshot
+                                        ? rocksutils::globalRocksEngine()->snapshotPool()
+                                        : nullptr;
+        if (pool != nullptr) {
+          _sharedSnapshot = pool->acquire();
+          _readSnapshot = _sharedSnapshot.get();
+        } else {
+          _readSnapshot = db->GetSnapshot();  // must call ReleaseSnapshot later
+        }
         TRI_ASSERT(_readSnapshot != nullptr);
         _rocksReadOptions.snapshot = _readSnapshot;
       }
@@ -225,7 +234,12 @@ void RocksDBTransactionState::cleanupTransaction() noexcept {
     CacheManagerFeature::MANAGER->endTransaction(_cacheTx);
     _cacheTx = nullptr;
   }
-  if (_readSnapshot != nullptr) {
+  if (_sharedSnapshot != nullptr) {
+    TRI_ASSERT(isReadOnlyTransaction());
+    TRI_ASSERT(_readSnapshot == _sharedSnapshot.get());
+    _sharedSnapshot.reset();  // released by the last user
+    _readSnapshot = nullptr;
+  } else if (_readSnapshot != nullptr) {
     TRI_ASSERT(isReadOnlyTransaction() ||
                hasHint(transaction::Hints::Hint::INTERMEDIATE_COMMITS));
     rocksdb::TransactionDB* db = rocksutils::globalRocksDB();
@@ -343,7 +357,8 @@ arangodb::Result RocksDBTransactionState::internalCommit() {
         TRI_ASSERT(engine != nullptr);
         if (engine->syncThread()) {
           // we do have a sync thread
-          result = engine->syncThread()->syncWal();
+          // concurrent transactions share a sync
+          result = engine->syncThread()->syncWal(postCommitSeq);
         } else {
           // no sync thread present... this may be the case if automatic
           // syncing is completely turned off. in this case, use the
@@ -389,6 +404,10 @@ Result RocksDBTransactionState::commitTransaction(transaction::Methods* activeTr
     }
     if (res.ok()) {
       updateStatus(transaction::Status::COMMITTED);
+      // if a write query, clear the query cache for the modified data
+      if (hasOperations() && arangodb::aql::QueryCache::instance()->mayBeActive()) {
+        clearQueryCache();
+      }
       cleanupTransaction();  // deletes trx
     } else {
       abortTransaction(activeTrx);  // deletes trx
@@ -521,12 +540,8 @@ Result RocksDBTransactionState::addOperation(TRI_voc_cid_t cid, TRI_voc_rid_t re
   // should not fail or fail with exception
   tcoll->addOperation(operationType, revisionId);
 
-  // clear the query cache for this collection
-  auto queryCache = arangodb::aql::QueryCache::instance();
-
-  if (queryCache->mayBeActive() && tcoll->collection()) {
-    queryCache->invalidate(&_vocbase, tcoll->collection()->guid());
-  }
+  // the query cache for this collection is cleared on commit
+  trackOperation(cid);
 
   switch (operationType) {
     case TRI_VOC_DOCUMENT_OPERATION_INSERT:
@@ -593,6 +608,11 @@ Result RocksDBTransactionState::triggerIntermediateCommit(bool& hasPerformedInte
 
   hasPerformedIntermediateCommit = true;
 
+  // the committed data is visible now
+  if (arangodb::aql::QueryCache::instance()->mayBeActive()) {
+    clearQueryCache();
+  }
+
   TRI_IF_FAILURE("FailAfterIntermediateCommit") {
     THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
   }
@@ -172,6 +172,9 @@ class RocksDBTransactionState final : public TransactionState {
   /// @brief used for read-only trx and intermediate commits
   /// For intermediate commits this MUST ONLY be used for iteratos
   rocksdb::Snapshot const* _readSnapshot;
+  /// @brief keeps _readSnapshot alive if it is shared with other read-only
+  /// transactions. must not be released via ReleaseSnapshot then
+  std::shared_ptr<rocksdb::Snapshot const> _sharedSnapshot;
   /// @brief shared read options which can be used by operations
   /// For intermediate commits iterators MUST use the _readSnapshot
   rocksdb::ReadOptions _rocksReadOptions;
@@ -46,6 +46,9 @@ class RocksDBTtlIndex final : public RocksDBSkiplistIndex {
   IndexType type() const override { return Index::TRI_IDX_TYPE_TTL_INDEX; }
 
   char const* typeName() const override { return "rocksdb-ttl"; }
+
+  /// @brief the index stores converted timestamps, not the attribute values
+  bool hasCoveringIterator() const override { return false; }
   
   void toVelocyPack(arangodb::velocypack::Builder& builder,
                     std::underlying_type<Index::Serialize>::type flags) const override;
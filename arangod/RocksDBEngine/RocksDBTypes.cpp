@@ -97,6 +97,10 @@ static rocksdb::Slice IndexEstimateValue(
 static RocksDBEntryType keyGeneratorValue = RocksDBEntryType::KeyGeneratorValue;
 static rocksdb::Slice KeyGeneratorValue(
     reinterpret_cast<std::underlying_type<RocksDBEntryType>::type*>(&keyGeneratorValue), 1);
+
+static RocksDBEntryType collectionStatisticsValue = RocksDBEntryType::CollectionStatisticsValue;
+static rocksdb::Slice CollectionStatisticsValue(
+    reinterpret_cast<std::underlying_type<RocksDBEntryType>::type*>(&collectionStatisticsValue), 1);
 }  // namespace
 
 char const* arangodb::rocksDBEntryTypeName(arangodb::RocksDBEntryType type) {
@@ -135,6 +139,8 @@ char const* arangodb::rocksDBEntryTypeName(arangodb::RocksDBEntryType type) {
       return "IndexEstimateValue";
     case arangodb::RocksDBEntryType::KeyGeneratorValue:
       return "KeyGeneratorValue";
+    case arangodb::RocksDBEntryType::CollectionStatisticsValue:
+      return "CollectionStatisticsValue";
   }
   return "Invalid";
 }
@@ -231,6 +237,8 @@ rocksdb::Slice const& arangodb::rocksDBSlice(RocksDBEntryType const& type) {
       return IndexEstimateValue;
     case RocksDBEntryType::KeyGeneratorValue:
       return KeyGeneratorValue;
+    case RocksDBEntryType::CollectionStatisticsValue:
+      return CollectionStatisticsValue;
   }
 
   return Placeholder;  // avoids warning - errorslice instead ?!
@@ -274,6 +274,17 @@ class RocksDBVPackIndexIterator final : public IndexIterator {
     return true;
   }
 
+  /// @brief collect the document ids of the next limit many elements, and
+  /// read all of the documents with a single MultiGet
+  bool nextDocument(DocumentCallback const& cb, size_t limit) override {
+    _documentIds.clear();
+    bool hasMore = next([this](LocalDocumentId const& documentId) {
+      _documentIds.emplace_back(documentId);
+    }, limit);
+    toRocksDBCollection(_collection->getPhysical())->readMultiple(_trx, _documentIds, cb);
+    return hasMore;
+  }
+
   void skip(uint64_t count, uint64_t& skipped) override {
     TRI_ASSERT(_trx->state()->isRunning());
 
@@ -346,6 +357,8 @@ class RocksDBVPackIndexIterator final : public IndexIterator {
   RocksDBKeyBounds _bounds;
   // used for iterate_upper_bound iterate_lower_bound
   rocksdb::Slice _rangeBound;
+  // document ids of the current batch, for nextDocument
+  std::vector<LocalDocumentId> _documentIds;
 };
 
 } // namespace
@@ -70,8 +70,16 @@ RocksDBValue RocksDBValue::KeyGeneratorValue(VPackSlice const& data) {
   return RocksDBValue(RocksDBEntryType::KeyGeneratorValue, data);
 }
 
+RocksDBValue RocksDBValue::CollectionStatisticsValue(VPackSlice const& data) {
+  return RocksDBValue(RocksDBEntryType::CollectionStatisticsValue, data);
+}
+
 RocksDBValue RocksDBValue::S2Value(S2Point const& p) { return RocksDBValue(p); }
 
+RocksDBValue RocksDBValue::S2Value(S2Point const& p, S2LatLngRect const& bound) {
+  return RocksDBValue(p, bound);
+}
+
 RocksDBValue RocksDBValue::Empty(RocksDBEntryType type) {
   return RocksDBValue(type);
 }
@@ -135,12 +143,27 @@ uint64_t RocksDBValue::keyValue(rocksdb::Slice const& slice) {
 }
 
 S2Point RocksDBValue::centroid(rocksdb::Slice const& s) {
-  TRI_ASSERT(s.size() == sizeof(double) * 3);
+  // may be followed by the bounding rectangle
+  TRI_ASSERT(s.size() == sizeof(double) * 3 || s.size() == sizeof(double) * 7);
   return S2Point(intToDouble(uint64FromPersistent(s.data())),
                  intToDouble(uint64FromPersistent(s.data() + sizeof(uint64_t))),
                  intToDouble(uint64FromPersistent(s.data() + sizeof(uint64_t) * 2)));
 }
 
+bool RocksDBValue::bound(rocksdb::Slice const& s, S2LatLngRect& bound) {
+  // values written before the bounding rectangle was stored have the
+  // centroid only
+  if (s.size() != sizeof(double) * 7) {
+    return false;
+  }
+  char const* data = s.data() + sizeof(uint64_t) * 3;
+  bound = S2LatLngRect(R1Interval(intToDouble(uint64FromPersistent(data)),
+                                  intToDouble(uint64FromPersistent(data + sizeof(uint64_t)))),
+                       S1Interval(intToDouble(uint64FromPersistent(data + sizeof(uint64_t) * 2)),
+                                  intToDouble(uint64FromPersistent(data + sizeof(uint64_t) * 3))));
+  return bound.is_valid();
+}
+
 RocksDBValue::RocksDBValue(RocksDBEntryType type) : _type(type), _buffer() {}
 
 RocksDBValue::RocksDBValue(RocksDBEntryType type, LocalDocumentId const& docId,
@@ -172,6 +195,7 @@ RocksDBValue::RocksDBValue(RocksDBEntryType type, VPackSlice const& data)
     case RocksDBEntryType::Collection:
     case RocksDBEntryType::View:
     case RocksDBEntryType::KeyGeneratorValue:
+    case RocksDBEntryType::CollectionStatisticsValue:
     case RocksDBEntryType::ReplicationApplierConfig: {
       _buffer.reserve(static_cast<size_t>(data.byteSize()));
       _buffer.append(reinterpret_cast<char const*>(data.begin()),
@@ -210,6 +234,15 @@ RocksDBValue::RocksDBValue(S2Point const& p)
   uint64ToPersistent(_buffer, rocksutils::doubleToInt(p.z()));
 }
 
+RocksDBValue::RocksDBValue(S2Point const& p, S2LatLngRect const& bound)
+    : RocksDBValue(p) {
+  _buffer.reserve(sizeof(uint64_t) * 7);
+  uint64ToPersistent(_buffer, rocksutils::doubleToInt(bound.lat().lo()));
+  uint64ToPersistent(_buffer, rocksutils::doubleToInt(bound.lat().hi()));
+  uint64ToPersistent(_buffer, rocksutils::doubleToInt(bound.lng().lo()));
+  uint64ToPersistent(_buffer, rocksutils::doubleToInt(bound.lng().hi()));
+}
+
 LocalDocumentId RocksDBValue::documentId(char const* data, uint64_t size) {
   TRI_ASSERT(data != nullptr && size >= sizeof(LocalDocumentId::BaseType));
   return LocalDocumentId(uint64FromPersistent(data));
@@ -30,6 +30,7 @@
 #include "VocBase/LocalDocumentId.h"
 
 #include <rocksdb/slice.h>
+#include <s2/s2latlng_rect.h>
 #include <s2/s2point.h>
 #include <velocypack/Slice.h>
 #include <velocypack/StringRef.h>
@@ -54,7 +55,9 @@ class RocksDBValue {
   static RocksDBValue View(VPackSlice const& data);
   static RocksDBValue ReplicationApplierConfig(VPackSlice const& data);
   static RocksDBValue KeyGeneratorValue(VPackSlice const& data);
+  static RocksDBValue CollectionStatisticsValue(VPackSlice const& data);
   static RocksDBValue S2Value(S2Point const& c);
+  static RocksDBValue S2Value(S2Point const& c, S2LatLngRect const& bound);
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Used to construct an empty value of the given type for retrieval
@@ -108,6 +111,11 @@ class RocksDBValue {
   //////////////////////////////////////////////////////////////////////////////
   static S2Point centroid(rocksdb::Slice const&);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Bounding rectangle of the shape, if stored with the centroid
+  //////////////////////////////////////////////////////////////////////////////
+  static bool bound(rocksdb::Slice const&, S2LatLngRect&);
+
  public:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Returns a reference to the underlying string buffer.
@@ -140,6 +148,7 @@ class RocksDBValue {
   RocksDBValue(RocksDBEntryType type, VPackSlice const& data);
   RocksDBValue(RocksDBEntryType type, arangodb::velocypack::StringRef const& data);
   explicit RocksDBValue(S2Point const&);
+  RocksDBValue(S2Point const&, S2LatLngRect const&);
 
  private:
   static RocksDBEntryType type(char const* data, size_t size);
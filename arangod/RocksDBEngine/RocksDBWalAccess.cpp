@@ -104,7 +104,6 @@ class MyWALDumper final : public rocksdb::WriteBatch::Handler, public WalAccessC
               size_t maxResponseSize)
       : WalAccessContext(filter, f),
         _definitionsCF(RocksDBColumnFamily::definitions()->GetID()),
-        _documentsCF(RocksDBColumnFamily::documents()->GetID()),
         _primaryCF(RocksDBColumnFamily::primary()->GetID()),
         _maxResponseSize(maxResponseSize),
         _startSequence(0),
@@ -524,7 +523,7 @@ class MyWALDumper final : public rocksdb::WriteBatch::Handler, public WalAccessC
       // reset everything immediately after DDL operations
       resetTransientState();
 
-    } else if (column_family_id == _documentsCF) {
+    } else if (RocksDBColumnFamily::isDocuments(column_family_id)) {
       if (_state != TRANSACTION && _state != SINGLE_PUT) {
         resetTransientState();
         return rocksdb::Status();
@@ -751,7 +750,6 @@ class MyWALDumper final : public rocksdb::WriteBatch::Handler, public WalAccessC
 
  private:
   uint32_t const _definitionsCF;
-  uint32_t const _documentsCF;
   uint32_t const _primaryCF;
   size_t const _maxResponseSize;
 
@@ -29,6 +29,7 @@
 #include <mutex>
 #include <queue>
 
+#include "Futures/function2/function2.hpp"
 #include "GeneralServer/RequestLane.h"
 #include "Logger/Logger.h"
 
@@ -55,8 +56,23 @@ class Scheduler {
   typedef std::chrono::steady_clock clock;
   typedef std::shared_ptr<WorkItem> WorkHandle;
 
+  // Move-only callable with enough inline capacity for the captures of
+  // the usual jobs, so that wrapping them does not allocate
+  typedef fu2::function_base<true, false, 64, true, false, void()> Handler;
+
   // Enqueues a task - this is implemented on the specific scheduler
-  virtual bool queue(RequestLane lane, std::function<void()>) = 0;
+  virtual bool queue(RequestLane lane, Handler) = 0;
+
+  // Enqueues a continuation of the job running on the calling thread.
+  // Schedulers may run it on the same thread, once the current job is done,
+  // to benefit from warm caches. By default this is the same as queue.
+  virtual bool queueLocal(RequestLane lane, Handler handler) {
+    return queue(lane, std::move(handler));
+  }
+
+  // Returns true, if new requests on this lane should be rejected right away,
+  // because queued jobs already wait too long to be picked up
+  virtual bool isOverloaded(RequestLane lane) const { return false; }
 
   // Enqueues a task after delay - this uses the queue functions above.
   // WorkHandle is a shared_ptr to a WorkItem. If all references the WorkItem
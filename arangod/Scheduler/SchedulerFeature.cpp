@@ -110,6 +110,12 @@ void SchedulerFeature::collectOptions(std::shared_ptr<options::ProgramOptions> o
                      new UInt64Parameter(&_fifo1Size),
                      arangodb::options::makeFlags(arangodb::options::Flags::Hidden));
 
+  options->addOption("--server.queue-delay-target",
+                     "reject low priority client requests with HTTP 503, if "
+                     "even the shortest queueing delay of recent jobs exceeds "
+                     "this many seconds (0 = never reject)",
+                     new DoubleParameter(&_queueDelayTarget));
+
   // obsolete options
   options->addObsoleteOption("--server.threads", "number of threads", true);
 
@@ -164,7 +170,8 @@ void SchedulerFeature::prepare() {
   TRI_ASSERT(_nrMinimalThreads <= _nrMaximalThreads);
   _scheduler =
       std::make_unique<SupervisedScheduler>(_nrMinimalThreads, _nrMaximalThreads,
-                                            _queueSize, _fifo1Size, _fifo2Size);
+                                            _queueSize, _fifo1Size, _fifo2Size,
+                                            _queueDelayTarget);
   SCHEDULER = _scheduler.get();
 }
 
@@ -50,6 +50,7 @@ class SchedulerFeature final : public application_features::ApplicationFeature {
   uint64_t _queueSize = 128;
   uint64_t _fifo1Size = 1024 * 1024;
   uint64_t _fifo2Size = 4096;
+  double _queueDelayTarget = 0.0;
 
   std::unique_ptr<Scheduler> _scheduler;
 
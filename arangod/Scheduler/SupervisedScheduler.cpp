@@ -79,14 +79,50 @@ class SupervisedSchedulerWorkerThread final : public SupervisedSchedulerThread {
 
 }  // namespace arangodb
 
+thread_local SupervisedScheduler::LocalQueue* SupervisedScheduler::_threadLocalQueue = nullptr;
+
+SupervisedScheduler::LocalQueue::~LocalQueue() {
+  for (WorkItem* work : _items) {
+    delete work;
+  }
+}
+
+void SupervisedScheduler::LocalQueue::push(WorkItem* work) {
+  std::lock_guard<std::mutex> guard(_mutex);
+  _items.push_back(work);
+  // use memory order release to make sure, pushed item is visible
+  _size.fetch_add(1, std::memory_order_release);
+}
+
+bool SupervisedScheduler::LocalQueue::pop(WorkItem*& work) {
+  if (_size.load(std::memory_order_acquire) == 0) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> guard(_mutex);
+
+  if (_items.empty()) {
+    return false;
+  }
+
+  work = _items.front();
+  _items.pop_front();
+  _size.fetch_sub(1, std::memory_order_relaxed);
+  return true;
+}
+
 SupervisedScheduler::SupervisedScheduler(uint64_t minThreads, uint64_t maxThreads,
                                          uint64_t maxQueueSize,
-                                         uint64_t fifo1Size, uint64_t fifo2Size)
+                                         uint64_t fifo1Size, uint64_t fifo2Size,
+                                         double queueDelayTarget)
     : _numWorker(0),
       _stopping(false),
+      _freeWorkItems(maxThreads * 8),
       _jobsSubmitted(0),
       _jobsDequeued(0),
       _jobsDone(0),
+      _numSleepingWorker(0),
+      _queueDelayTarget_ns(static_cast<uint64_t>(queueDelayTarget * 1000000000.0)),
       _wakeupQueueLength(5),
       _wakeupTime_ns(1000),
       _definitiveWakeupTime_ns(100000),
@@ -95,11 +131,37 @@ SupervisedScheduler::SupervisedScheduler(uint64_t minThreads, uint64_t maxThread
   _queue[0].reserve(maxQueueSize);
   _queue[1].reserve(fifo1Size);
   _queue[2].reserve(fifo2Size);
+  _localQueues.reset(new LocalQueue[_maxNumWorker]);
+}
+
+SupervisedScheduler::~SupervisedScheduler() {
+  WorkItem* work;
+  while (_freeWorkItems.pop(work)) {
+    delete work;
+  }
 }
 
-SupervisedScheduler::~SupervisedScheduler() {}
+SupervisedScheduler::WorkItem* SupervisedScheduler::makeWorkItem(Handler&& handler,
+                                                                 size_t queueNo) {
+  WorkItem* work;
+  if (!_freeWorkItems.pop(work)) {
+    work = new WorkItem();
+  }
+  work->_handler = std::move(handler);
+  work->_queued_ns = getTickCount_ns();
+  work->_queueNo = queueNo;
+  return work;
+}
+
+void SupervisedScheduler::recycleWorkItem(WorkItem* work) {
+  // release whatever the handler has captured right now
+  work->_handler = nullptr;
+  if (!_freeWorkItems.push(work)) {
+    delete work;
+  }
+}
 
-bool SupervisedScheduler::queue(RequestLane lane, std::function<void()> handler) {
+bool SupervisedScheduler::queue(RequestLane lane, Handler handler) {
   size_t queueNo = (size_t)PriorityRequestLane(lane);
 
   TRI_ASSERT(queueNo <= 2);
@@ -108,10 +170,10 @@ bool SupervisedScheduler::queue(RequestLane lane, std::function<void()> handler)
   static thread_local uint64_t lastSubmitTime_ns;
   bool doNotify = false;
 
-  WorkItem* work = new WorkItem(std::move(handler));
+  WorkItem* work = makeWorkItem(std::move(handler), queueNo);
 
   if (!_queue[queueNo].push(work)) {
-    delete work;
+    recycleWorkItem(work);
     return false;
   }
 
@@ -133,12 +195,83 @@ bool SupervisedScheduler::queue(RequestLane lane, std::function<void()> handler)
   }
 
   if (doNotify) {
-    _conditionWork.notify_one();
+    notifyIdleWorker();
   }
 
   return true;
 }
 
+bool SupervisedScheduler::queueLocal(RequestLane lane, Handler handler) {
+  LocalQueue* local = _threadLocalQueue;
+
+  if (local == nullptr || local < _localQueues.get() ||
+      local >= _localQueues.get() + _maxNumWorker ||
+      local->_size.load(std::memory_order_relaxed) >= maxLocalQueueSize) {
+    // not called from one of our workers, or this worker is backed up
+    return queue(lane, std::move(handler));
+  }
+
+  TRI_ASSERT(isStopping() == false);
+
+  WorkItem* work = makeWorkItem(std::move(handler), (size_t)PriorityRequestLane(lane));
+  try {
+    local->push(work);
+  } catch (...) {
+    recycleWorkItem(work);
+    throw;
+  }
+
+  _jobsSubmitted.fetch_add(1, std::memory_order_release);
+
+  // the job is picked up by this thread as soon as its current job is
+  // done. That may take long, so a sleeping worker is woken up to steal it
+  notifyIdleWorker();
+
+  return true;
+}
+
+bool SupervisedScheduler::isOverloaded(RequestLane lane) const {
+  if (!canShedLoad(lane, ServerState::instance()->getRole())) {
+    return false;
+  }
+  size_t queueNo = (size_t)PriorityRequestLane(lane);
+  return _queueDelay[queueNo]._overloaded.load(std::memory_order_relaxed);
+}
+
+bool SupervisedScheduler::canShedLoad(RequestLane lane, ServerState::RoleEnum role) {
+  // DB servers and agents only see requests from other cluster members.
+  // Rejecting them would fail synchronous replication and drop followers,
+  // or abort parts of queries the coordinator already committed to. The
+  // coordinators in front of them shed load instead
+  if (role != ServerState::ROLE_COORDINATOR && role != ServerState::ROLE_SINGLE) {
+    return false;
+  }
+
+  switch (lane) {
+    case RequestLane::CLIENT_AQL:
+    case RequestLane::CLIENT_V8:
+    case RequestLane::CLIENT_SLOW:
+      return true;
+    default:
+      // never reject cluster internal and fast requests, others wait for
+      // them to make progress
+      return false;
+  }
+}
+
+void SupervisedScheduler::notifyIdleWorker() {
+  // spinning workers find the job anyway, only sleeping ones need a notify.
+  // Pairs with the fence in getWork: either we see the worker going to
+  // sleep, or the worker sees the job we have just queued
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (_numSleepingWorker.load(std::memory_order_relaxed) > 0) {
+    // a worker that has announced itself holds the mutex until it waits,
+    // so the notify cannot get lost in between
+    std::lock_guard<std::mutex> guard(_mutex);
+    _conditionWork.notify_one();
+  }
+}
+
 bool SupervisedScheduler::start() {
   _manager.reset(new SupervisedSchedulerManagerThread(*this));
   if (!_manager->start()) {
@@ -209,6 +342,7 @@ void SupervisedScheduler::runWorker() {
 
   state->_sleepTimeout_ms = 20 * (id + 1);
   state->_queueRetryCount = (512 >> id) + 3;
+  _threadLocalQueue = state->_localQueue;
 
   while (true) {
     std::unique_ptr<WorkItem> work = getWork(state);
@@ -217,6 +351,7 @@ void SupervisedScheduler::runWorker() {
     }
 
     _jobsDequeued++;
+    recordQueueDelay(*work);
 
     try {
       state->_lastJobStarted = clock::now();
@@ -231,8 +366,17 @@ void SupervisedScheduler::runWorker() {
           << "scheduler loop caught unknown exception";
     }
 
+    recycleWorkItem(work.release());
+
     _jobsDone.fetch_add(1, std::memory_order_release);
   }
+
+  // getWork has drained the local queue, it can be handed to a new thread
+  _threadLocalQueue = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(_mutexSupervisor);
+    state->_localQueue->_inUse = false;
+  }
 }
 
 void SupervisedScheduler::runSupervisor() {
@@ -242,6 +386,7 @@ void SupervisedScheduler::runSupervisor() {
 
   uint64_t lastJobsDone = 0, lastJobsSubmitted = 0;
   uint64_t jobsStallingTick = 0, lastQueueLength = 0;
+  auto lastQueueDelayCheck = clock::now();
 
   while (!_stopping) {
     uint64_t jobsDone = _jobsDone.load(std::memory_order_acquire);
@@ -280,6 +425,12 @@ void SupervisedScheduler::runSupervisor() {
     cleanupAbandonedThreads();
     sortoutLongRunningThreads();
 
+    auto now = clock::now();
+    if (now - lastQueueDelayCheck >= std::chrono::milliseconds(100)) {
+      lastQueueDelayCheck = now;
+      checkQueueDelays();
+    }
+
     std::unique_lock<std::mutex> guard(_mutexSupervisor);
 
     if (_stopping) {
@@ -290,6 +441,63 @@ void SupervisedScheduler::runSupervisor() {
   }
 }
 
+void SupervisedScheduler::recordQueueDelay(WorkItem const& work) {
+  static uint64_t const cuts_us[numQueueDelayBuckets - 1] = {100, 1000, 10000,
+                                                             100000, 1000000};
+
+  uint64_t now_ns = getTickCount_ns();
+  uint64_t delay_ns = now_ns > work._queued_ns ? now_ns - work._queued_ns : 0;
+  uint64_t delay_us = delay_ns / 1000;
+
+  TRI_ASSERT(work._queueNo <= 2);
+  QueueDelay& delay = _queueDelay[work._queueNo];
+
+  size_t bucket = 0;
+  while (bucket < numQueueDelayBuckets - 1 && delay_us >= cuts_us[bucket]) {
+    ++bucket;
+  }
+
+  delay._count.fetch_add(1, std::memory_order_relaxed);
+  delay._total_us.fetch_add(delay_us, std::memory_order_relaxed);
+  delay._counts[bucket].fetch_add(1, std::memory_order_relaxed);
+
+  uint64_t minDelay = delay._minDelay_ns.load(std::memory_order_relaxed);
+  while (delay_ns < minDelay &&
+         !delay._minDelay_ns.compare_exchange_weak(minDelay, delay_ns,
+                                                   std::memory_order_relaxed)) {
+  }
+}
+
+void SupervisedScheduler::checkQueueDelays() {
+  if (_queueDelayTarget_ns == 0) {
+    return;
+  }
+
+  bool jobsWaiting = _jobsDequeued.load(std::memory_order_relaxed) <
+                     _jobsSubmitted.load(std::memory_order_relaxed);
+
+  for (size_t i = 0; i < 3; ++i) {
+    QueueDelay& delay = _queueDelay[i];
+    uint64_t minDelay = delay._minDelay_ns.exchange(UINT64_MAX, std::memory_order_relaxed);
+
+    bool overloaded;
+    if (minDelay == UINT64_MAX) {
+      // nothing was dequeued in this interval. Either there is nothing to
+      // do, or all workers are stuck - keep the verdict in the latter case
+      overloaded = jobsWaiting && delay._overloaded.load(std::memory_order_relaxed);
+    } else {
+      overloaded = minDelay > _queueDelayTarget_ns;
+    }
+
+    if (overloaded != delay._overloaded.exchange(overloaded, std::memory_order_relaxed)) {
+      LOG_TOPIC("5d0e2", INFO, Logger::THREADS)
+          << "scheduler queue " << i << (overloaded ? " is" : " is no longer")
+          << " overloaded, minimal queueing delay "
+          << (minDelay == UINT64_MAX ? 0 : minDelay / 1000) << "us";
+    }
+  }
+}
+
 bool SupervisedScheduler::cleanupAbandonedThreads() {
   auto i = _abandonedWorkerStates.begin();
 
@@ -348,11 +556,21 @@ std::unique_ptr<SupervisedScheduler::WorkItem> SupervisedScheduler::getWork(
   while (!state->_stop) {
     uint64_t triesCount = 0;
     while (triesCount < state->_queueRetryCount) {
+      // continuations of our own jobs come first
+      if (state->_localQueue->pop(work)) {
+        return std::unique_ptr<WorkItem>(work);
+      }
+
       // access queue via 0 1 2 0 1 2 0 1 ...
       if (_queue[triesCount % 3].pop(work)) {
         return std::unique_ptr<WorkItem>(work);
       }
 
+      // after each round through the global queues, help out other workers
+      if (triesCount % 3 == 2 && stealWork(state->_localQueue, triesCount, work)) {
+        return std::unique_ptr<WorkItem>(work);
+      }
+
       triesCount++;
       cpu_relax();
     }
@@ -363,16 +581,48 @@ std::unique_ptr<SupervisedScheduler::WorkItem> SupervisedScheduler::getWork(
       break;
     }
 
+    _numSleepingWorker.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_jobsSubmitted.load(std::memory_order_relaxed) >
+        _jobsDequeued.load(std::memory_order_relaxed)) {
+      // a job was queued before we announced ourselves, its producer may
+      // not have notified anybody
+      _numSleepingWorker.fetch_sub(1, std::memory_order_relaxed);
+      continue;
+    }
     if (state->_sleepTimeout_ms == 0) {
       _conditionWork.wait(guard);
     } else {
       _conditionWork.wait_for(guard, std::chrono::milliseconds(state->_sleepTimeout_ms));
     }
+    _numSleepingWorker.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  // a stopped worker runs what is left in its local queue first. These are
+  // continuations of its own jobs, and once the last workers are stopped
+  // during shutdown, nobody else would steal them
+  if (state->_localQueue->pop(work)) {
+    return std::unique_ptr<WorkItem>(work);
   }
 
   return nullptr;
 }
 
+bool SupervisedScheduler::stealWork(LocalQueue const* own, uint64_t offset,
+                                    WorkItem*& work) {
+  // start at different queues, so that thieves do not all pick the same victim
+  size_t start = static_cast<size_t>(own - _localQueues.get()) + offset;
+
+  for (size_t i = 0; i < _maxNumWorker; ++i) {
+    LocalQueue& victim = _localQueues[(start + i) % _maxNumWorker];
+    if (&victim != own && victim.pop(work)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 void SupervisedScheduler::startOneThread() {
   // TRI_ASSERT(_numWorker < _maxNumWorker);
   if (_numWorker + _abandonedWorkerStates.size() >= _maxNumWorker) {
@@ -381,10 +631,28 @@ void SupervisedScheduler::startOneThread() {
 
   std::unique_lock<std::mutex> guard(_mutexSupervisor);
 
+  // a thread keeps its local queue until it has finished, so there are
+  // never more queues in use than threads in total
+  LocalQueue* local = nullptr;
+  for (size_t i = 0; i < _maxNumWorker; ++i) {
+    if (!_localQueues[i]._inUse) {
+      local = &_localQueues[i];
+      break;
+    }
+  }
+
+  if (local == nullptr) {
+    return;  // all abandoned threads are still running
+  }
+
   // start a new thread
   _workerStates.emplace_back(std::make_shared<WorkerState>(*this));
+  _workerStates.back()->_localQueue = local;
+  local->_inUse = true;
+
   if (!_workerStates.back()->start()) {
     // failed to start a worker
+    local->_inUse = false;
     _workerStates.pop_back();  // pop_back deletes shared_ptr, which deletes thread
     LOG_TOPIC("913b5", ERR, Logger::THREADS)
         << "could not start additional worker thread";
@@ -429,17 +697,28 @@ SupervisedScheduler::WorkerState::WorkerState(SupervisedScheduler::WorkerState&&
     : _queueRetryCount(that._queueRetryCount),
       _sleepTimeout_ms(that._sleepTimeout_ms),
       _stop(that._stop.load()),
-      _thread(std::move(that._thread)) {}
+      _thread(std::move(that._thread)),
+      _localQueue(that._localQueue) {}
 
 SupervisedScheduler::WorkerState::WorkerState(SupervisedScheduler& scheduler)
     : _queueRetryCount(100),
       _sleepTimeout_ms(100),
       _stop(false),
       _thread(new SupervisedSchedulerWorkerThread(scheduler)),
+      _localQueue(nullptr),
       _padding() {}
 
+SupervisedScheduler::WorkerState::~WorkerState() = default;
+
 bool SupervisedScheduler::WorkerState::start() { return _thread->start(); }
 
+SupervisedScheduler::QueueDelay::QueueDelay()
+    : _count(0), _total_us(0), _minDelay_ns(UINT64_MAX), _overloaded(false) {
+  for (auto& it : _counts) {
+    it.store(0, std::memory_order_relaxed);
+  }
+}
+
 // ---------------------------------------------------------------------------
 // Statistics Stuff
 // ---------------------------------------------------------------------------
@@ -471,4 +750,22 @@ void SupervisedScheduler::addQueueStatistics(velocypack::Builder& b) const {
   // TODO: previous scheduler filled out a lot more fields, relevant?
   b.add("scheduler-threads", VPackValue(static_cast<int32_t>(numWorker)));
   b.add("queued", VPackValue(static_cast<int32_t>(queueLength)));
+
+  // same layout as the request time distributions
+  b.add("queue-delay", VPackValue(VPackValueType::Object));
+  char const* names[] = {"high", "medium", "low"};
+  for (size_t i = 0; i < 3; ++i) {
+    QueueDelay const& delay = _queueDelay[i];
+    b.add(names[i], VPackValue(VPackValueType::Object));
+    b.add("sum", VPackValue(delay._total_us.load(std::memory_order_relaxed) / 1000000.0));
+    b.add("count", VPackValue(delay._count.load(std::memory_order_relaxed)));
+    b.add("counts", VPackValue(VPackValueType::Array));
+    for (auto const& it : delay._counts) {
+      b.add(VPackValue(it.load(std::memory_order_relaxed)));
+    }
+    b.close();
+    b.add("overloaded", VPackValue(delay._overloaded.load(std::memory_order_relaxed)));
+    b.close();
+  }
+  b.close();
 }
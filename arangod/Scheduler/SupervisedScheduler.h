@@ -26,11 +26,14 @@
 #define ARANGOD_SUPERIVSED_SCHEDULER_SCHEDULER_H 1
 
 #include <boost/lockfree/queue.hpp>
+#include <boost/lockfree/stack.hpp>
 #include <condition_variable>
+#include <deque>
 #include <list>
 #include <mutex>
 #include <queue>
 
+#include "Cluster/ServerState.h"
 #include "Scheduler/Scheduler.h"
 
 namespace arangodb {
@@ -41,10 +44,16 @@ class SupervisedSchedulerManagerThread;
 class SupervisedScheduler : public Scheduler {
  public:
   SupervisedScheduler(uint64_t minThreads, uint64_t maxThreads, uint64_t maxQueueSize,
-                      uint64_t fifo1Size, uint64_t fifo2Size);
+                      uint64_t fifo1Size, uint64_t fifo2Size, double queueDelayTarget);
   virtual ~SupervisedScheduler();
 
-  bool queue(RequestLane lane, std::function<void()>) override;
+  bool queue(RequestLane lane, Handler) override;
+  bool queueLocal(RequestLane lane, Handler) override;
+  bool isOverloaded(RequestLane lane) const override;
+
+  // whether requests on the lane may be rejected by a server of the given
+  // role while the lane's queue is overloaded
+  static bool canShedLoad(RequestLane lane, ServerState::RoleEnum role);
 
  private:
   std::atomic<size_t> _numWorker;
@@ -61,31 +70,98 @@ class SupervisedScheduler : public Scheduler {
   Scheduler::QueueStatistics queueStatistics() const override;
   std::string infoStatus() const override;
 
+#ifndef ARANGODB_USE_CATCH_TESTS
  private:
+#else
+ // make the worker internals public, so that tests can run the worker loop
+ // without starting threads
+ public:
+#endif
   friend class SupervisedSchedulerManagerThread;
   friend class SupervisedSchedulerWorkerThread;
 
   struct WorkItem {
-    std::function<void()> _handler;
-
-    explicit WorkItem(std::function<void()> const& handler)
-        : _handler(handler) {}
-    explicit WorkItem(std::function<void()>&& handler)
-        : _handler(std::move(handler)) {}
-    virtual ~WorkItem() {}
+    Handler _handler;
+    uint64_t _queued_ns;
+    size_t _queueNo;
 
-    virtual void operator()() { _handler(); }
+    void operator()() { _handler(); }
   };
 
   // Since the lockfree queue can only handle PODs, one has to wrap lambdas
   // in a container class and store pointers. -- Maybe there is a better way?
   boost::lockfree::queue<WorkItem*> _queue[3];
 
+  // WorkItems are recycled instead of deleted. Together with the inline
+  // storage of Handler, queueing a job does not allocate once the scheduler
+  // has seen its peak queue length.
+  boost::lockfree::stack<WorkItem*> _freeWorkItems;
+
+  WorkItem* makeWorkItem(Handler&& handler, size_t queueNo);
+  void recycleWorkItem(WorkItem* work);
+
+  // Each worker thread owns one local queue. Jobs queued via queueLocal from
+  // a worker thread go to the local queue of that very thread and are picked
+  // up by it as soon as its current job is done. Idle workers steal from the
+  // local queues of others. Only the owner pushes, hence the mutex is
+  // uncontended unless somebody steals. The queues live as long as the
+  // scheduler, a stopping thread drains its queue before it exits.
+  struct LocalQueue {
+    std::mutex _mutex;
+    std::deque<WorkItem*> _items;
+    std::atomic<size_t> _size;
+    bool _inUse;  // protected by _mutexSupervisor
+
+    LocalQueue() : _size(0), _inUse(false) {}
+    ~LocalQueue();
+
+    void push(WorkItem* work);
+    bool pop(WorkItem*& work);
+  };
+
+  // more jobs are queued globally, to not let a single thread hoard them
+  static constexpr size_t maxLocalQueueSize = 64;
+
+  std::unique_ptr<LocalQueue[]> _localQueues;
+
+  // local queue of the calling worker thread, nullptr on other threads
+  static thread_local LocalQueue* _threadLocalQueue;
+
   // aligning required to prevent false sharing - assumes cache line size is 64
   alignas(64) std::atomic<uint64_t> _jobsSubmitted;
   alignas(64) std::atomic<uint64_t> _jobsDequeued;
   alignas(64) std::atomic<uint64_t> _jobsDone;
 
+  // number of workers waiting on _conditionWork, nobody needs to be notified
+  // if all workers are spinning or busy
+  alignas(64) std::atomic<uint64_t> _numSleepingWorker;
+
+  // Histogram of the time jobs spent queued, per priority. The buckets end
+  // at 100us, 1ms, 10ms, 100ms and 1s, the last one takes the rest.
+  //
+  // Following CoDel, a priority is overloaded, if even the shortest delay
+  // of the jobs dequeued during an interval exceeds _queueDelayTarget_ns.
+  // The minimum is reset by the supervisor at the end of each interval.
+  // Long delays alone are no sign of overload, a burst of jobs causes them
+  // as well, but a standing queue that never drains is.
+  static constexpr size_t numQueueDelayBuckets = 6;
+
+  struct alignas(64) QueueDelay {
+    std::atomic<uint64_t> _count;
+    std::atomic<uint64_t> _total_us;
+    std::atomic<uint64_t> _counts[numQueueDelayBuckets];
+    std::atomic<uint64_t> _minDelay_ns;
+    std::atomic<bool> _overloaded;
+
+    QueueDelay();
+  };
+
+  QueueDelay _queueDelay[3];
+  uint64_t const _queueDelayTarget_ns;  // 0 = never overloaded
+
+  void recordQueueDelay(WorkItem const& work);
+  void checkQueueDelays();
+
   // During a queue operation there a two reasons to manually wake up a worker
   //  1. the queue length is bigger than _wakeupQueueLength and the last submit time
   //      is bigger than _wakeupTime_ns.
@@ -116,11 +192,13 @@ class SupervisedScheduler : public Scheduler {
     std::atomic<bool> _stop, _working;
     clock::time_point _lastJobStarted;
     std::unique_ptr<SupervisedSchedulerWorkerThread> _thread;
-    char _padding[40];
+    LocalQueue* _localQueue;
+    char _padding[32];
 
     // initialize with harmless defaults: spin once, sleep forever
     explicit WorkerState(SupervisedScheduler& scheduler);
     WorkerState(WorkerState&& that);
+    ~WorkerState();
 
     bool start();
   };
@@ -141,6 +219,8 @@ class SupervisedScheduler : public Scheduler {
   std::unique_ptr<SupervisedSchedulerManagerThread> _manager;
 
   std::unique_ptr<WorkItem> getWork(std::shared_ptr<WorkerState>& state);
+  bool stealWork(LocalQueue const* own, uint64_t offset, WorkItem*& work);
+  void notifyIdleWorker();
 
   void startOneThread();
   void stopOneThread();
@@ -163,6 +163,14 @@ ShardingInfo::ShardingInfo(arangodb::velocypack::Slice info, LogicalCollection*
         std::string("invalid number of shard keys for collection"));
   }
 
+  VPackSlice shardBoundariesSlice = info.get("shardBoundaries");
+  if (shardBoundariesSlice.isArray()) {
+    _shardBoundaries.add(shardBoundariesSlice);
+  } else if (!shardBoundariesSlice.isNone() && !shardBoundariesSlice.isNull()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                   "invalid shard boundaries");
+  }
+
   auto shardsSlice = info.get("shards");
   if (shardsSlice.isObject()) {
     for (auto const& shardSlice : VPackObjectIterator(shardsSlice)) {
@@ -202,6 +210,10 @@ ShardingInfo::ShardingInfo(ShardingInfo const& other, LogicalCollection* collect
       _shardingStrategy() {
   TRI_ASSERT(_collection != nullptr);
 
+  if (!other._shardBoundaries.isEmpty()) {
+    _shardBoundaries.add(other._shardBoundaries.slice());
+  }
+
   // set the sharding strategy
   _shardingStrategy = application_features::ApplicationServer::getFeature<ShardingFeature>(
                           "Sharding")
@@ -271,6 +283,10 @@ void ShardingInfo::toVelocyPack(VPackBuilder& result, bool translateCids) {
 
   result.close();  // shardKeys
 
+  if (!_shardBoundaries.isEmpty()) {
+    result.add("shardBoundaries", _shardBoundaries.slice());
+  }
+
   if (!_avoidServers.empty()) {
     result.add(VPackValue("avoidServers"));
     result.openArray();
@@ -295,6 +311,12 @@ void ShardingInfo::distributeShardsLike(std::string const& cid, ShardingInfo con
         "a collection with a different number of shard key attributes");
   }
 
+  // the shards must have the same boundaries for range sharding
+  _shardBoundaries.clear();
+  if (!other->_shardBoundaries.isEmpty()) {
+    _shardBoundaries.add(other->_shardBoundaries.slice());
+  }
+
   if (!usesSameShardingStrategy(other)) {
     // other collection has a different sharding strategy
     // adjust our sharding so it uses the same strategy as the other collection
@@ -348,6 +370,13 @@ std::vector<std::string> const& ShardingInfo::shardKeys() const {
   return _shardKeys;
 }
 
+VPackSlice ShardingInfo::shardBoundaries() const {
+  if (_shardBoundaries.isEmpty()) {
+    return VPackSlice::noneSlice();
+  }
+  return _shardBoundaries.slice();
+}
+
 std::shared_ptr<ShardMap> ShardingInfo::shardIds() const { return _shardIds; }
 
 // return a filtered list of the collection's shards
@@ -379,3 +408,14 @@ int ShardingInfo::getResponsibleShard(arangodb::velocypack::Slice slice, bool do
   return _shardingStrategy->getResponsibleShard(slice, docComplete, shardID,
                                                 usesDefaultShardKeys, key);
 }
+
+int ShardingInfo::getResponsibleShards(std::vector<arangodb::velocypack::Slice> const& slices,
+                                       std::vector<ShardID>& shardIDs) {
+  return _shardingStrategy->getResponsibleShards(slices, shardIDs);
+}
+
+bool ShardingInfo::getResponsibleShardForRange(arangodb::velocypack::Slice lower,
+                                               arangodb::velocypack::Slice upper,
+                                               ShardID& shardID) {
+  return _shardingStrategy->getResponsibleShardForRange(lower, upper, shardID);
+}
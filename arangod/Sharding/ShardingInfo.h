@@ -73,6 +73,11 @@ class ShardingInfo {
   bool usesDefaultShardKeys() const;
   std::vector<std::string> const& shardKeys() const;
 
+  /// @brief the values that separate the shards of a range-sharded
+  /// collection, an array with one value less than there are shards.
+  /// returns a none slice if the collection has no boundaries
+  arangodb::velocypack::Slice shardBoundaries() const;
+
   std::shared_ptr<ShardMap> shardIds() const;
 
   // return a filtered list of the collection's shards
@@ -83,6 +88,12 @@ class ShardingInfo {
                           ShardID& shardID, bool& usesDefaultShardKeys,
                           std::string const& key = "");
 
+  int getResponsibleShards(std::vector<arangodb::velocypack::Slice> const& slices,
+                           std::vector<ShardID>& shardIDs);
+
+  bool getResponsibleShardForRange(arangodb::velocypack::Slice lower,
+                                   arangodb::velocypack::Slice upper, ShardID& shardID);
+
  private:
   // @brief the logical collection we are working for
   LogicalCollection* _collection;
@@ -103,6 +114,10 @@ class ShardingInfo {
   // @brief vector of shard keys in use. this is immutable after initial setup
   std::vector<std::string> _shardKeys;
 
+  // @brief boundaries of the shards for range sharding, empty otherwise.
+  // this is immutable after initial setup
+  arangodb::velocypack::Builder _shardBoundaries;
+
   // @brief current shard ids
   std::shared_ptr<ShardMap> _shardIds;
 
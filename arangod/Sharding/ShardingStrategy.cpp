@@ -33,6 +33,23 @@ bool ShardingStrategy::isCompatible(ShardingStrategy const* other) const {
   return name() == other->name();
 }
 
+int ShardingStrategy::getResponsibleShards(std::vector<VPackSlice> const& slices,
+                                           std::vector<ShardID>& shardIDs) {
+  shardIDs.resize(slices.size());
+  bool usesDefaultShardKeys;
+  for (size_t i = 0; i < slices.size(); ++i) {
+    int res = getResponsibleShard(slices[i], true, shardIDs[i], usesDefaultShardKeys);
+    if (res != TRI_ERROR_NO_ERROR) {
+      return res;
+    }
+  }
+  return TRI_ERROR_NO_ERROR;
+}
+
+bool ShardingStrategy::getResponsibleShardForRange(VPackSlice, VPackSlice, ShardID&) {
+  return false;
+}
+
 void ShardingStrategy::toVelocyPack(VPackBuilder& result) {
   // only need to print sharding strategy if we are in a cluster
   if (ServerState::instance()->isRunningInCluster()) {
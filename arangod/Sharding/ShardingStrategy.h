@@ -74,6 +74,22 @@ class ShardingStrategy {
   virtual int getResponsibleShard(arangodb::velocypack::Slice, bool docComplete,
                                   ShardID& shardID, bool& usesDefaultShardKeys,
                                   std::string const& key = "") = 0;
+
+  /// @brief find the responsible shards for multiple complete documents.
+  /// the i-th shard id belongs to the i-th document. stops at the first
+  /// error and returns it. the default implementation calls
+  /// getResponsibleShard for every document
+  virtual int getResponsibleShards(std::vector<arangodb::velocypack::Slice> const& slices,
+                                   std::vector<ShardID>& shardIDs);
+
+  /// @brief find the single shard responsible for all documents whose only
+  /// shard key attribute has a value between lower and upper (inclusive).
+  /// a none slice means that the range is not bounded on that side. returns
+  /// false if there is no such shard, or if the strategy cannot tell, which
+  /// is what the default implementation does
+  virtual bool getResponsibleShardForRange(arangodb::velocypack::Slice lower,
+                                           arangodb::velocypack::Slice upper,
+                                           ShardID& shardID);
 };
 
 }  // namespace arangodb
@@ -234,14 +234,16 @@ ShardingStrategyHashBase::ShardingStrategyHashBase(ShardingInfo* sharding)
   }
 }
 
+namespace {
+constexpr char const* magicPhrase =
+    "Foxx you have stolen the goose, give she back again!";
+constexpr size_t magicLength = 52;
+}  // namespace
+
 int ShardingStrategyHashBase::getResponsibleShard(arangodb::velocypack::Slice slice,
                                                   bool docComplete, ShardID& shardID,
                                                   bool& usesDefaultShardKeys,
                                                   std::string const& key) {
-  static constexpr char const* magicPhrase =
-      "Foxx you have stolen the goose, give she back again!";
-  static constexpr size_t magicLength = 52;
-
   determineShards();
   TRI_ASSERT(!_shards.empty());
 
@@ -253,11 +255,32 @@ int ShardingStrategyHashBase::getResponsibleShard(arangodb::velocypack::Slice sl
 
   uint64_t hash = hashByAttributes(slice, _sharding->shardKeys(), docComplete, res, key);
   // To improve our hash function result:
-  hash = TRI_FnvHashBlock(hash, magicPhrase, magicLength);
+  hash = TRI_FnvHashBlock(hash, ::magicPhrase, ::magicLength);
   shardID = _shards[hash % _shards.size()];
   return res;
 }
 
+int ShardingStrategyHashBase::getResponsibleShards(std::vector<VPackSlice> const& slices,
+                                                   std::vector<ShardID>& shardIDs) {
+  determineShards();
+  TRI_ASSERT(!_shards.empty());
+
+  std::vector<std::string> const& shardKeys = _sharding->shardKeys();
+  TRI_ASSERT(!shardKeys.empty());
+
+  shardIDs.resize(slices.size());
+  int res = TRI_ERROR_NO_ERROR;
+  for (size_t i = 0; i < slices.size(); ++i) {
+    uint64_t hash = hashByAttributes(slices[i], shardKeys, true, res, StaticStrings::Empty);
+    if (res != TRI_ERROR_NO_ERROR) {
+      return res;
+    }
+    hash = TRI_FnvHashBlock(hash, ::magicPhrase, ::magicLength);
+    shardIDs[i] = _shards[hash % _shards.size()];
+  }
+  return TRI_ERROR_NO_ERROR;
+}
+
 void ShardingStrategyHashBase::determineShards() {
   if (_shardsSet) {
     TRI_ASSERT(!_shards.empty());
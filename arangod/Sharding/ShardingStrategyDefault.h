@@ -84,6 +84,11 @@ class ShardingStrategyHashBase : public ShardingStrategy {
                                   ShardID& shardID, bool& usesDefaultShardKeys,
                                   std::string const& key = "") override;
 
+  /// @brief determines the shards once, and then only hashes the documents.
+  /// subclasses that override getResponsibleShard must override this too
+  int getResponsibleShards(std::vector<arangodb::velocypack::Slice> const& slices,
+                           std::vector<ShardID>& shardIDs) override;
+
   /// @brief does not really matter here
   bool usesDefaultShardKeys() override { return _usesDefaultShardKeys; }
 
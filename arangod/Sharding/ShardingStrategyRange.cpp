@@ -0,0 +1,178 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ShardingStrategyRange.h"
+#include "Basics/Exceptions.h"
+#include "Basics/MutexLocker.h"
+#include "Basics/StaticStrings.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Cluster/ClusterInfo.h"
+#include "Cluster/ServerState.h"
+#include "Sharding/ShardingInfo.h"
+#include "VocBase/LogicalCollection.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/StringRef.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+std::string const ShardingStrategyRange::NAME("range");
+
+ShardingStrategyRange::ShardingStrategyRange(ShardingInfo* sharding)
+    : ShardingStrategy(),
+      _sharding(sharding),
+      _usesDefaultShardKeys(false),
+      _shardsSet(false) {
+  LogicalCollection const* collection = _sharding->collection();
+  if (collection->isSmart() && collection->type() == TRI_COL_TYPE_EDGE) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_BAD_PARAMETER, std::string("sharding strategy ") + NAME +
+                                     " cannot be used for smart edge collections");
+  }
+
+  auto const& shardKeys = _sharding->shardKeys();
+  if (shardKeys.size() != 1 || shardKeys[0].empty() || shardKeys[0].front() == ':' ||
+      shardKeys[0].back() == ':') {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                   std::string("sharding strategy ") + NAME +
+                                       " requires exactly one shard key attribute");
+  }
+  _usesDefaultShardKeys = (shardKeys[0] == StaticStrings::KeyString);
+
+  if (ServerState::instance()->isCoordinator()) {
+    validateBoundaries(_sharding->shardBoundaries(), _sharding->numberOfShards());
+  }
+}
+
+void ShardingStrategyRange::validateBoundaries(VPackSlice boundaries, size_t numberOfShards) {
+  if (!boundaries.isArray()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                   std::string("sharding strategy ") + NAME +
+                                       " requires shardBoundaries");
+  }
+  if (numberOfShards == 0 || boundaries.length() != numberOfShards - 1) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_BAD_PARAMETER,
+        "shardBoundaries must have one value less than there are shards");
+  }
+  VPackSlice previous = VPackSlice::noneSlice();
+  for (VPackSlice boundary : VPackArrayIterator(boundaries)) {
+    if (!previous.isNone() &&
+        basics::VelocyPackHelper::compare(previous, boundary, true) >= 0) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                     "shardBoundaries must be sorted in "
+                                     "ascending order without duplicates");
+    }
+    previous = boundary;
+  }
+}
+
+int ShardingStrategyRange::getResponsibleShard(arangodb::velocypack::Slice slice,
+                                               bool docComplete, ShardID& shardID,
+                                               bool& usesDefaultShardKeys,
+                                               std::string const& key) {
+  determineShards();
+  TRI_ASSERT(!_shards.empty());
+
+  usesDefaultShardKeys = _usesDefaultShardKeys;
+
+  int res = TRI_ERROR_NO_ERROR;
+  VPackSlice value = VPackSlice::nullSlice();
+  slice = slice.resolveExternal();
+  if (slice.isObject()) {
+    std::string const& attribute = _sharding->shardKeys()[0];
+    VPackSlice sub = slice.get(attribute).resolveExternal();
+    if (!sub.isNone()) {
+      value = sub;
+    } else if (attribute == StaticStrings::KeyString && !key.empty()) {
+      VPackBuilder temporaryBuilder;
+      temporaryBuilder.add(VPackValue(key));
+      shardID = _shards[shardPosition(temporaryBuilder.slice())];
+      return res;
+    } else if (!docComplete) {
+      res = TRI_ERROR_CLUSTER_NOT_ALL_SHARDING_ATTRIBUTES_GIVEN;
+    }
+  } else if (slice.isString() && _usesDefaultShardKeys) {
+    // a key
+    value = slice;
+  }
+
+  shardID = _shards[shardPosition(value)];
+  return res;
+}
+
+bool ShardingStrategyRange::getResponsibleShardForRange(VPackSlice lower, VPackSlice upper,
+                                                        ShardID& shardID) {
+  determineShards();
+  TRI_ASSERT(!_shards.empty());
+
+  size_t const first = lower.isNone() ? 0 : shardPosition(lower);
+  size_t const last = upper.isNone() ? _shards.size() - 1 : shardPosition(upper);
+  if (first != last) {
+    return false;
+  }
+  shardID = _shards[first];
+  return true;
+}
+
+size_t ShardingStrategyRange::shardPosition(VPackSlice value) const {
+  VPackSlice boundaries = _sharding->shardBoundaries();
+  TRI_ASSERT(boundaries.isArray());
+  TRI_ASSERT(boundaries.length() == _shards.size() - 1);
+
+  // binary search for the number of boundaries less than or equal to the
+  // value
+  size_t low = 0;
+  size_t high = static_cast<size_t>(boundaries.length());
+  while (low < high) {
+    size_t const middle = low + (high - low) / 2;
+    if (basics::VelocyPackHelper::compare(boundaries.at(middle), value, true) <= 0) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+void ShardingStrategyRange::determineShards() {
+  if (_shardsSet) {
+    TRI_ASSERT(!_shards.empty());
+    return;
+  }
+
+  MUTEX_LOCKER(mutex, _shardsSetMutex);
+  if (_shardsSet) {
+    TRI_ASSERT(!_shards.empty());
+    return;
+  }
+
+  // determine all available shards (which will stay const afterwards),
+  // sorted by their ids
+  auto ci = ClusterInfo::instance();
+  auto shards = ci->getShardList(std::to_string(_sharding->collection()->id()));
+
+  validateBoundaries(_sharding->shardBoundaries(), shards->size());
+
+  _shards = *shards;
+  TRI_ASSERT(!_shards.empty());
+  _shardsSet = true;
+}
@@ -0,0 +1,78 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_SHARDING_SHARDING_STRATEGY_RANGE_H
+#define ARANGOD_SHARDING_SHARDING_STRATEGY_RANGE_H 1
+
+#include "Basics/Common.h"
+#include "Basics/Mutex.h"
+#include "Sharding/ShardingStrategy.h"
+
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+class ShardingInfo;
+
+/// @brief range-based sharding strategy, for collections that are mostly
+/// appended to and queried by ranges of a single shard key attribute, for
+/// example a timestamp. the collection's "shardBoundaries" separate the
+/// shards in the order of their ids: the first shard holds all values less
+/// than the first boundary, the i-th shard all values from the (i-1)-th
+/// boundary up to the i-th boundary (exclusive), and the last shard all
+/// values from the last boundary on. values are ordered like in AQL
+class ShardingStrategyRange final : public ShardingStrategy {
+ public:
+  explicit ShardingStrategyRange(ShardingInfo* sharding);
+
+  std::string const& name() const override { return NAME; }
+
+  static std::string const NAME;
+
+  bool usesDefaultShardKeys() override { return _usesDefaultShardKeys; }
+
+  int getResponsibleShard(arangodb::velocypack::Slice, bool docComplete,
+                          ShardID& shardID, bool& usesDefaultShardKeys,
+                          std::string const& key = "") override;
+
+  bool getResponsibleShardForRange(arangodb::velocypack::Slice lower,
+                                   arangodb::velocypack::Slice upper,
+                                   ShardID& shardID) override;
+
+  /// @brief validates the boundaries for the given number of shards, throws
+  /// if they are invalid
+  static void validateBoundaries(arangodb::velocypack::Slice boundaries,
+                                 size_t numberOfShards);
+
+ private:
+  void determineShards();
+
+  /// @brief position of the shard responsible for the value
+  size_t shardPosition(arangodb::velocypack::Slice value) const;
+
+  ShardingInfo* _sharding;
+  std::vector<ShardID> _shards;
+  bool _usesDefaultShardKeys;
+  std::atomic<bool> _shardsSet;
+  Mutex _shardsSetMutex;
+};
+
+}  // namespace arangodb
+
+#endif
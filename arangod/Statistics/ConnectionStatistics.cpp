@@ -23,6 +23,7 @@
 
 #include "ConnectionStatistics.h"
 
+#include "Basics/Metrics.h"
 #include "Basics/MutexLocker.h"
 #include "Rest/CommonDefines.h"
 
@@ -101,6 +102,10 @@ void ConnectionStatistics::release() {
     if (_connStart != 0.0 && _connEnd != 0.0) {
       double totalTime = _connEnd - _connStart;
       TRI_ConnectionTimeDistributionStatistics.addFigure(totalTime);
+
+      if (TRI_StatisticsHistograms.connectionTime != nullptr) {
+        TRI_StatisticsHistograms.connectionTime->count(totalTime);
+      }
     }
   }
 
@@ -22,8 +22,15 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "RequestStatistics.h"
+#include "Basics/Metrics.h"
 #include "Basics/MutexLocker.h"
 #include "Logger/Logger.h"
+#include "Random/RandomGenerator.h"
+#include "Rest/GeneralRequest.h"
+#include "VocBase/ticks.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
 
 #include <iomanip>
 
@@ -94,6 +101,33 @@ RequestStatistics* RequestStatistics::acquire() {
   return statistics;
 }
 
+void RequestStatistics::START_TRACE(RequestStatistics* stat, std::string const* parent) {
+  if (stat == nullptr) {
+    return;
+  }
+
+  if (parent != nullptr && !parent->empty()) {
+    char const* p = parent->c_str();
+    char* end = nullptr;
+    uint64_t traceId = std::strtoull(p, &end, 16);
+    if (traceId != 0 && *end == '-') {
+      stat->_traceId = traceId;
+      stat->_parentSpanId = std::strtoull(end + 1, nullptr, 16);
+    }
+  }
+
+  if (stat->_traceId == 0) {
+    double rate = StatisticsFeature::traceSampleRate();
+    if (rate <= 0.0 ||
+        (rate < 1.0 && RandomGenerator::interval(UINT32_MAX) >= rate * UINT32_MAX)) {
+      return;
+    }
+    stat->_traceId = TRI_NewServerSpecificTick();
+  }
+
+  stat->_spanId = TRI_NewServerSpecificTick();
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                            static private methods
 // -----------------------------------------------------------------------------
@@ -144,9 +178,27 @@ void RequestStatistics::process(RequestStatistics* statistics) {
 
       TRI_BytesSentDistributionStatistics.addFigure(statistics->_sentBytes);
       TRI_BytesReceivedDistributionStatistics.addFigure(statistics->_receivedBytes);
+
+      StatisticsHistograms const& histograms = TRI_StatisticsHistograms;
+      if (histograms.totalTime != nullptr) {
+        histograms.totalTime->count(totalTime);
+        histograms.requestTime->count(requestTime);
+        if (queueTime > 0.0) {
+          histograms.queueTime->count(queueTime);
+        }
+        if (ioTime >= 0.0) {
+          histograms.ioTime->count(ioTime);
+        }
+        histograms.bytesSent->count(statistics->_sentBytes);
+        histograms.bytesReceived->count(statistics->_receivedBytes);
+      }
     }
   }
 
+  if (statistics->_traceId != 0) {
+    statistics->logTrace();
+  }
+
   // clear statistics
   statistics->reset();
 
@@ -202,6 +254,61 @@ void RequestStatistics::fill(StatisticsDistribution& totalTime,
   bytesReceived = TRI_BytesReceivedDistributionStatistics;
 }
 
+std::string RequestStatistics::traceHeader() const {
+  std::stringstream ss;
+  ss << std::hex << _traceId << '-' << _spanId;
+  return ss.str();
+}
+
+void RequestStatistics::logTrace() const {
+  auto nanos = [](double time) {
+    return VPackValue(static_cast<uint64_t>(time * 1000000000.0));
+  };
+  auto hex = [](uint64_t id) {
+    std::stringstream ss;
+    ss << std::hex << std::setw(16) << std::setfill('0') << id;
+    return ss.str();
+  };
+  auto phase = [](VPackBuilder& builder, char const* name, double start, double end) {
+    if (start != 0.0 && end >= start) {
+      builder.add(name, VPackValue(end - start));
+    }
+  };
+
+  double const start = _readStart != 0.0 ? _readStart : _requestStart;
+  double const end = _writeEnd != 0.0 ? _writeEnd : _requestEnd;
+
+  // the layout follows the span of the OpenTelemetry protocol, with the
+  // durations of the phases in seconds as attributes
+  VPackBuilder builder;
+  builder.openObject();
+  builder.add("traceId", VPackValue(hex(_traceId)));
+  builder.add("spanId", VPackValue(hex(_spanId)));
+  if (_parentSpanId != 0) {
+    builder.add("parentSpanId", VPackValue(hex(_parentSpanId)));
+  }
+  builder.add("name", VPackValue(GeneralRequest::translateMethod(_requestType)));
+  builder.add("startTimeUnixNano", nanos(start));
+  builder.add("endTimeUnixNano", nanos(end));
+  builder.add("attributes", VPackValue(VPackValueType::Object));
+  phase(builder, "parse", _readStart, _readEnd);
+  phase(builder, "queue", _queueStart, _queueEnd);
+  phase(builder, "handler", _requestStart, _requestEnd);
+  if (_clusterTime > 0.0) {
+    builder.add("cluster", VPackValue(_clusterTime));
+  }
+  phase(builder, "serialization", _requestEnd, _writeStart);
+  phase(builder, "write", _writeStart, _writeEnd);
+  builder.add("receivedBytes", VPackValue(_receivedBytes));
+  builder.add("sentBytes", VPackValue(_sentBytes));
+  builder.add("async", VPackValue(_async));
+  builder.add("error", VPackValue(_executeError));
+  builder.close();
+  builder.close();
+
+  LOG_TOPIC("7c3e5", INFO, Logger::REQUESTS) << builder.slice().toJson();
+}
+
 std::string RequestStatistics::timingsCsv() {
   std::stringstream ss;
 
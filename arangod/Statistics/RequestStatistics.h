@@ -136,6 +136,17 @@ class RequestStatistics {
     }
   }
 
+  static void ADD_CLUSTER_TIME(RequestStatistics* stat, double time) {
+    if (stat != nullptr) {
+      stat->_clusterTime += time;
+    }
+  }
+
+  /// @brief decides whether the request is traced. requests are traced if
+  /// the calling server traces them (parent is the value of the trace
+  /// header), otherwise they are sampled with the configured rate
+  static void START_TRACE(RequestStatistics* stat, std::string const* parent);
+
   static double ELAPSED_SINCE_READ_START(RequestStatistics* stat) {
     if (stat != nullptr) {
       return StatisticsFeature::time() - stat->_readStart;
@@ -146,6 +157,12 @@ class RequestStatistics {
 
   double requestStart() const { return _requestStart; }
 
+  bool traced() const { return _traceId != 0; }
+
+  /// @brief value of the trace header for requests sent on behalf of this
+  /// request: "<trace id>-<span id>", hexadecimal
+  std::string traceHeader() const;
+
   static void fill(basics::StatisticsDistribution& totalTime,
                    basics::StatisticsDistribution& requestTime,
                    basics::StatisticsDistribution& queueTime,
@@ -168,6 +185,9 @@ class RequestStatistics {
 
   static void process(RequestStatistics*);
 
+  /// @brief logs the phases of a traced request as a span
+  void logTrace() const;
+
   RequestStatistics() { reset(); }
 
   void reset() {
@@ -182,6 +202,10 @@ class RequestStatistics {
     _writeEnd = 0.0;
     _receivedBytes = 0.0;
     _sentBytes = 0.0;
+    _clusterTime = 0.0;
+    _traceId = 0;
+    _spanId = 0;
+    _parentSpanId = 0;
     _requestType = rest::RequestType::ILLEGAL;
     _async = false;
     _tooLarge = false;
@@ -205,6 +229,12 @@ class RequestStatistics {
   double _receivedBytes;
   double _sentBytes;
 
+  double _clusterTime;  // waiting for responses of other servers
+
+  uint64_t _traceId;  // 0 if the request is not traced
+  uint64_t _spanId;
+  uint64_t _parentSpanId;
+
   rest::RequestType _requestType;
 
   bool _async;
@@ -24,6 +24,7 @@
 #include "Logger/Logger.h"
 #include "ProgramOptions/ProgramOptions.h"
 #include "ProgramOptions/Section.h"
+#include "RestServer/MetricsFeature.h"
 #include "RestServer/SystemDatabaseFeature.h"
 #include "Statistics/ConnectionStatistics.h"
 #include "Statistics/Descriptions.h"
@@ -70,6 +71,8 @@ StatisticsDistribution TRI_QueueTimeDistributionStatistics(TRI_RequestTimeDistri
 StatisticsDistribution TRI_RequestTimeDistributionStatistics(TRI_RequestTimeDistributionVectorStatistics);
 StatisticsDistribution TRI_TotalTimeDistributionStatistics(TRI_RequestTimeDistributionVectorStatistics);
 
+StatisticsHistograms TRI_StatisticsHistograms;
+
 }  // namespace basics
 }  // namespace arangodb
 
@@ -126,6 +129,7 @@ StatisticsFeature* StatisticsFeature::STATISTICS = nullptr;
 StatisticsFeature::StatisticsFeature(application_features::ApplicationServer& server)
     : ApplicationFeature(server, "Statistics"),
       _statistics(true),
+      _traceSampleRate(0.0),
       _descriptions(new stats::Descriptions()) {
   startsAfter("AQLPhase");
   setOptional(true);
@@ -140,6 +144,13 @@ void StatisticsFeature::collectOptions(std::shared_ptr<ProgramOptions> options)
                      "turn statistics gathering on or off",
                      new BooleanParameter(&_statistics),
                      arangodb::options::makeFlags(arangodb::options::Flags::Hidden));
+
+  options->addOption("--server.trace-sample-rate",
+                     "share of requests (between 0 and 1) whose phases are "
+                     "logged as spans to the 'requests' log topic at level "
+                     "INFO. requests from other servers are traced if the "
+                     "calling server traces them",
+                     new DoubleParameter(&_traceSampleRate));
 }
 
 void StatisticsFeature::validateOptions(std::shared_ptr<ProgramOptions>) {
@@ -147,6 +158,13 @@ void StatisticsFeature::validateOptions(std::shared_ptr<ProgramOptions>) {
     // turn ourselves off
     disable();
   }
+
+  if (_traceSampleRate < 0.0 || _traceSampleRate > 1.0) {
+    LOG_TOPIC("2e6b8", FATAL, arangodb::Logger::STATISTICS)
+        << "invalid value for --server.trace-sample-rate, expecting a value "
+           "between 0 and 1";
+    FATAL_ERROR_EXIT();
+  }
 }
 
 void StatisticsFeature::prepare() {
@@ -157,6 +175,33 @@ void StatisticsFeature::prepare() {
   ServerStatistics::initialize();
   ConnectionStatistics::initialize();
   RequestStatistics::initialize();
+
+  metrics::Registry* registry = MetricsFeature::registry();
+  if (registry != nullptr) {
+    // times in seconds from 1 microsecond to 100 seconds, sizes in bytes up
+    // to 1 GB
+    TRI_StatisticsHistograms.totalTime =
+        &registry->histogram("arangodb_http_request_total_time_seconds",
+                             "total time of HTTP requests", -6, 2);
+    TRI_StatisticsHistograms.requestTime =
+        &registry->histogram("arangodb_http_request_time_seconds",
+                             "time spent executing HTTP requests", -6, 2);
+    TRI_StatisticsHistograms.queueTime =
+        &registry->histogram("arangodb_http_request_queue_time_seconds",
+                             "time HTTP requests were queued", -6, 2);
+    TRI_StatisticsHistograms.ioTime =
+        &registry->histogram("arangodb_http_request_io_time_seconds",
+                             "time spent reading and writing HTTP requests", -6, 2);
+    TRI_StatisticsHistograms.bytesSent =
+        &registry->histogram("arangodb_http_response_size_bytes",
+                             "size of HTTP responses", 0, 9);
+    TRI_StatisticsHistograms.bytesReceived =
+        &registry->histogram("arangodb_http_request_size_bytes",
+                             "size of HTTP requests", 0, 9);
+    TRI_StatisticsHistograms.connectionTime =
+        &registry->histogram("arangodb_client_connection_time_seconds",
+                             "lifetime of client connections", -3, 4);
+  }
 }
 
 void StatisticsFeature::start() {
@@ -32,6 +32,9 @@
 #include "Statistics/figures.h"
 
 namespace arangodb {
+namespace metrics {
+class Histogram;
+}
 namespace basics {
 
 extern Mutex TRI_RequestsStatisticsMutex;
@@ -56,6 +59,21 @@ extern StatisticsDistribution TRI_IoTimeDistributionStatistics;
 extern StatisticsDistribution TRI_QueueTimeDistributionStatistics;
 extern StatisticsDistribution TRI_RequestTimeDistributionStatistics;
 extern StatisticsDistribution TRI_TotalTimeDistributionStatistics;
+
+/// @brief log-linear histograms of the same figures as the distributions
+/// above, exported via the metrics API. they are registered in
+/// StatisticsFeature::prepare and are nullptr without a metrics registry
+struct StatisticsHistograms {
+  metrics::Histogram* bytesReceived = nullptr;
+  metrics::Histogram* bytesSent = nullptr;
+  metrics::Histogram* connectionTime = nullptr;
+  metrics::Histogram* ioTime = nullptr;
+  metrics::Histogram* queueTime = nullptr;
+  metrics::Histogram* requestTime = nullptr;
+  metrics::Histogram* totalTime = nullptr;
+};
+
+extern StatisticsHistograms TRI_StatisticsHistograms;
 }  // namespace basics
 namespace stats {
 class Descriptions;
@@ -72,6 +90,11 @@ class StatisticsFeature final : public application_features::ApplicationFeature
 
   static double time() { return TRI_microtime(); }
 
+  /// @brief share of requests that are traced, between 0 and 1
+  static double traceSampleRate() {
+    return STATISTICS != nullptr ? STATISTICS->_traceSampleRate : 0.0;
+  }
+
  private:
   static StatisticsFeature* STATISTICS;
 
@@ -93,6 +116,7 @@ class StatisticsFeature final : public application_features::ApplicationFeature
 
  private:
   bool _statistics;
+  double _traceSampleRate;
 
   std::unique_ptr<stats::Descriptions> _descriptions;
   std::unique_ptr<StatisticsThread> _statisticsThread;
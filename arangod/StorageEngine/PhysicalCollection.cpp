@@ -32,6 +32,7 @@
 #include "Indexes/Index.h"
 #include "StorageEngine/TransactionState.h"
 #include "Transaction/Methods.h"
+#include "VocBase/CollectionStatistics.h"
 #include "VocBase/KeyGenerator.h"
 #include "VocBase/LogicalCollection.h"
 #include "VocBase/ticks.h"
@@ -44,6 +45,29 @@
 #include <velocypack/StringRef.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include <limits>
+
+namespace {
+
+/// @brief adds two integers, unless an operand or the sum does not fit into
+/// an int64_t
+bool addIntegers(VPackSlice lhs, VPackSlice rhs, int64_t& result) {
+  uint64_t const max = static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+  if ((lhs.isUInt() && lhs.getUInt() > max) || (rhs.isUInt() && rhs.getUInt() > max)) {
+    return false;
+  }
+  int64_t const a = lhs.getNumber<int64_t>();
+  int64_t const b = rhs.getNumber<int64_t>();
+  if ((b > 0 && a > std::numeric_limits<int64_t>::max() - b) ||
+      (b < 0 && a < std::numeric_limits<int64_t>::min() - b)) {
+    return false;
+  }
+  result = a + b;
+  return true;
+}
+
+}  // namespace
+
 namespace arangodb {
 
 PhysicalCollection::PhysicalCollection(LogicalCollection& collection,
@@ -75,6 +99,19 @@ void PhysicalCollection::flushClusterIndexEstimates() {
   // collections
 }
 
+std::shared_ptr<CollectionStatistics const> PhysicalCollection::statistics() const {
+  READ_LOCKER(guard, _statisticsLock);
+  return _statistics;
+}
+
+/// @brief replaces the statistics of the documents. the default
+/// implementation only keeps them in memory
+Result PhysicalCollection::setStatistics(std::shared_ptr<CollectionStatistics const> statistics) {
+  WRITE_LOCKER(guard, _statisticsLock);
+  _statistics = std::move(statistics);
+  return Result();
+}
+
 void PhysicalCollection::drop() {
   {
     WRITE_LOCKER(guard, _indexesLock);
@@ -88,6 +125,36 @@ void PhysicalCollection::drop() {
   }
 }
 
+void PhysicalCollection::lookupKeys(transaction::Methods* trx,
+                                    std::vector<VPackSlice> const& keys,
+                                    std::vector<LocalDocumentId>& result) const {
+  result.clear();
+  result.reserve(keys.size());
+  for (VPackSlice key : keys) {
+    TRI_ASSERT(key.isString());
+    result.emplace_back(lookupKey(trx, key));
+  }
+}
+
+size_t PhysicalCollection::readMultipleKeys(transaction::Methods* trx,
+                                            std::vector<VPackSlice> const& keys,
+                                            IndexIterator::DocumentCallback const& cb) const {
+  size_t found = 0;
+  for (VPackSlice key : keys) {
+    TRI_ASSERT(key.isString());
+    LocalDocumentId const documentId = lookupKey(trx, key);
+    if (documentId.isSet() && readDocumentWithCallback(trx, documentId, cb)) {
+      ++found;
+    }
+  }
+  return found;
+}
+
+Result PhysicalCollection::readLatestCommitted(arangodb::velocypack::StringRef const&,
+                                               ManagedDocumentResult&) const {
+  return Result(TRI_ERROR_NOT_IMPLEMENTED);
+}
+
 bool PhysicalCollection::isValidEdgeAttribute(VPackSlice const& slice) const {
   if (!slice.isString()) {
     return false;
@@ -173,11 +240,14 @@ TRI_voc_rid_t PhysicalCollection::newRevisionId() const {
 }
 
 /// @brief merge two objects for update, oldValue must have correctly set
-/// _key and _id attributes
+/// _key and _id attributes. if incrementNumbers is set, numeric top-level
+/// attributes of newValue are added to the numeric values in oldValue
+/// instead of replacing them
 Result PhysicalCollection::mergeObjectsForUpdate(
     transaction::Methods* trx, VPackSlice const& oldValue,
     VPackSlice const& newValue, bool isEdgeCollection, bool mergeObjects,
-    bool keepNull, VPackBuilder& b, bool isRestore, TRI_voc_rid_t& revisionId) const {
+    bool keepNull, VPackBuilder& b, bool isRestore, TRI_voc_rid_t& revisionId,
+    bool incrementNumbers) const {
   b.openObject();
 
   VPackSlice keySlice = oldValue.get(StaticStrings::KeyString);
@@ -295,6 +365,22 @@ Result PhysicalCollection::mergeObjectsForUpdate(
         }
         // clear the value in the map so its not added again
         (*found).second = VPackSlice();
+      } else if (incrementNumbers && current.value.isNumber() &&
+                 (*found).second.isNumber()) {
+        // add the delta to the old value. integer sums that do not fit
+        // into an int64_t are computed as doubles
+        auto& value = (*found).second;
+        int64_t sum;
+        if (current.value.isInteger() && value.isInteger() &&
+            ::addIntegers(current.value, value, sum)) {
+          b.addUnchecked(key.data(), key.size(), VPackValue(sum));
+        } else {
+          b.addUnchecked(key.data(), key.size(),
+                         VPackValue(current.value.getNumber<double>() +
+                                    value.getNumber<double>()));
+        }
+        // clear the value in the map so its not added again
+        (*found).second = VPackSlice();
       } else {
         // use new value
         auto& value = (*found).second;
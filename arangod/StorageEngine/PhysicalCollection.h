@@ -38,6 +38,7 @@ namespace transaction {
 class Methods;
 }
 
+class CollectionStatistics;
 struct KeyLockInfo;
 class LocalDocumentId;
 class Index;
@@ -97,6 +98,14 @@ class PhysicalCollection {
 
   virtual void prepareIndexes(arangodb::velocypack::Slice indexesSlice) = 0;
 
+  /// @brief the statistics of the documents from the last analysis,
+  /// nullptr if the collection has not been analyzed
+  std::shared_ptr<CollectionStatistics const> statistics() const;
+
+  /// @brief replaces the statistics of the documents. engines that can
+  /// persist them override this
+  virtual Result setStatistics(std::shared_ptr<CollectionStatistics const> statistics);
+
   bool hasIndexOfType(arangodb::Index::IndexType type) const;
 
   /// @brief find index by definition
@@ -129,6 +138,13 @@ class PhysicalCollection {
 
   virtual std::unique_ptr<IndexIterator> getAllIterator(transaction::Methods* trx) const = 0;
   virtual std::unique_ptr<IndexIterator> getAnyIterator(transaction::Methods* trx) const = 0;
+  /// @brief iterator over all documents that may read the collection with up
+  /// to parallelism threads. the documents are returned in no particular
+  /// order. engines without parallel scans return a regular all-iterator
+  virtual std::unique_ptr<IndexIterator> getParallelAllIterator(transaction::Methods* trx,
+                                                                size_t /*parallelism*/) const {
+    return getAllIterator(trx);
+  }
   virtual void invokeOnAllElements(transaction::Methods* trx,
                                    std::function<bool(LocalDocumentId const&)> callback) = 0;
 
@@ -150,6 +166,13 @@ class PhysicalCollection {
   virtual LocalDocumentId lookupKey(transaction::Methods*,
                                     arangodb::velocypack::Slice const&) const = 0;
 
+  /// @brief looks up multiple keys (strings). the i-th document id belongs
+  /// to the i-th key, and is not set if the key does not exist. the default
+  /// implementation looks up the keys one by one
+  virtual void lookupKeys(transaction::Methods* trx,
+                          std::vector<arangodb::velocypack::Slice> const& keys,
+                          std::vector<LocalDocumentId>& result) const;
+
   virtual Result read(transaction::Methods*, arangodb::velocypack::StringRef const& key,
                       ManagedDocumentResult& result, bool lock) = 0;
 
@@ -164,6 +187,20 @@ class PhysicalCollection {
   virtual bool readDocumentWithCallback(transaction::Methods* trx,
                                         LocalDocumentId const& token,
                                         IndexIterator::DocumentCallback const& cb) const = 0;
+
+  /// @brief read the documents with the given keys (strings), and call the
+  /// callback for every document found, in the order of the keys. returns
+  /// the number of documents found. the default implementation looks up the
+  /// keys one by one
+  virtual size_t readMultipleKeys(transaction::Methods* trx,
+                                  std::vector<arangodb::velocypack::Slice> const& keys,
+                                  IndexIterator::DocumentCallback const& cb) const;
+
+  /// @brief read the latest committed version of a document without a
+  /// transaction. returns TRI_ERROR_NOT_IMPLEMENTED if the engine cannot do
+  /// this or cannot do it right now, callers must then use a transaction
+  virtual Result readLatestCommitted(arangodb::velocypack::StringRef const& key,
+                                     ManagedDocumentResult& result) const;
   /**
    * @brief Perform document insert, may generate a '_key' value
    * If (options.returnNew == false && !options.silent) result might
@@ -225,7 +262,8 @@ class PhysicalCollection {
                                velocypack::Slice const& newValue,
                                bool isEdgeCollection, bool mergeObjects,
                                bool keepNull, velocypack::Builder& builder,
-                               bool isRestore, TRI_voc_rid_t& revisionId) const;
+                               bool isRestore, TRI_voc_rid_t& revisionId,
+                               bool incrementNumbers = false) const;
 
   /// @brief new object for replace
   Result newObjectForReplace(transaction::Methods* trx, velocypack::Slice const& oldValue,
@@ -241,6 +279,9 @@ class PhysicalCollection {
 
   mutable basics::ReadWriteLock _indexesLock;
   std::vector<std::shared_ptr<Index>> _indexes;
+
+  mutable basics::ReadWriteLock _statisticsLock;
+  std::shared_ptr<CollectionStatistics const> _statistics;
 };
 
 }  // namespace arangodb
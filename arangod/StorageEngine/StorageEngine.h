@@ -46,6 +46,7 @@ class LogicalView;
 class PhysicalCollection;
 class PhysicalView;
 class Result;
+struct StoragePerfCounters;
 class TransactionCollection;
 class TransactionState;
 class WalAccess;
@@ -336,6 +337,10 @@ class StorageEngine : public application_features::ApplicationFeature {
   /// @brief Add engine-specific REST handlers
   virtual void addRestHandlers(rest::RestHandlerFactory& handlerFactory) {}
 
+  /// @brief called before documents are loaded in bulk, e.g. by a restore.
+  /// engines can tune themselves for a large amount of incoming writes
+  virtual void prepareBulkLoad() {}
+
   // replication
   virtual void cleanupReplicationContexts() = 0;
 
@@ -393,6 +398,24 @@ class StorageEngine : public application_features::ApplicationFeature {
     builder.close();
   }
 
+  /// @brief bytes read and block cache hits of the current thread since it
+  /// was started. used to account reads to queries. engines that do not
+  /// track this per thread report zeros
+  virtual void threadIOCounters(uint64_t& bytesRead, uint64_t& blockCacheHits) const {
+    bytesRead = 0;
+    blockCacheHits = 0;
+  }
+
+  /// @brief turn the detailed performance counters of the calling thread on
+  /// or off and return the previous setting. collecting them slows down the
+  /// thread, so they are only turned on for sampled operations. engines
+  /// without such counters ignore this
+  virtual bool setThreadPerfCounters(bool /*enabled*/) { return false; }
+
+  /// @brief the detailed performance counters of the calling thread. they
+  /// only advance while turned on
+  virtual void threadPerfCounters(StoragePerfCounters& /*counters*/) const {}
+
   // management methods for synchronizing with external persistent stores
   virtual TRI_voc_tick_t currentTick() const = 0;
   virtual TRI_voc_tick_t releasedTick() const = 0;
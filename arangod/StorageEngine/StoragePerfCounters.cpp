@@ -0,0 +1,210 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "StoragePerfCounters.h"
+
+#include "Basics/Metrics.h"
+#include "Basics/MutexLocker.h"
+#include "StorageEngine/EngineSelectorFeature.h"
+#include "StorageEngine/StorageEngine.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace {
+struct TypeName {
+  char const* attribute;
+  char const* metric;
+  char const* help;
+};
+
+TypeName const typeNames[StoragePerfCounters::NumberOfTypes] = {
+    {"blockReads", "block_reads", "Number of blocks read from disk"},
+    {"blockReadTime", "block_read_time_ns", "Time spent reading blocks"},
+    {"blockCacheHits", "block_cache_hits", "Number of block cache hits"},
+    {"memtableReads", "memtable_reads", "Number of memtables queried"},
+    {"memtableReadTime", "memtable_read_time_ns", "Time spent querying memtables"},
+    {"fileReadTime", "file_read_time_ns", "Time spent reading from files"},
+    {"bloomFilterUseful", "bloom_filter_useful",
+     "Number of file reads avoided by bloom filters"},
+    {"bloomFilterHits", "bloom_filter_hits",
+     "Number of bloom filter checks that did not avoid a file read"},
+    {"walWriteTime", "wal_write_time_ns", "Time spent writing the WAL"},
+    {"memtableWriteTime", "memtable_write_time_ns",
+     "Time spent writing to memtables"},
+    {"writeDelayTime", "write_delay_time_ns",
+     "Time writes were delayed or stalled"},
+};
+
+std::atomic<uint32_t> samplingInterval(0);
+
+StorageEngine* engine() { return EngineSelectorFeature::ENGINE; }
+}  // namespace
+
+StoragePerfCounters& StoragePerfCounters::operator+=(StoragePerfCounters const& other) {
+  for (size_t i = 0; i < NumberOfTypes; ++i) {
+    values[i] += other.values[i];
+  }
+  return *this;
+}
+
+StoragePerfCounters StoragePerfCounters::operator-(StoragePerfCounters const& earlier) const {
+  StoragePerfCounters result;
+  for (size_t i = 0; i < NumberOfTypes; ++i) {
+    // the engine may reset the counters of a thread
+    result.values[i] = values[i] >= earlier.values[i] ? values[i] - earlier.values[i] : 0;
+  }
+  return result;
+}
+
+bool StoragePerfCounters::empty() const {
+  for (size_t i = 0; i < NumberOfTypes; ++i) {
+    if (values[i] != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void StoragePerfCounters::toVelocyPack(VPackBuilder& builder) const {
+  TRI_ASSERT(builder.isOpenObject());
+  for (size_t i = 0; i < NumberOfTypes; ++i) {
+    if (values[i] != 0) {
+      builder.add(typeNames[i].attribute, VPackValue(values[i]));
+    }
+  }
+}
+
+StoragePerfCounters StoragePerfCounters::fromVelocyPack(VPackSlice slice) {
+  StoragePerfCounters result;
+  if (slice.isObject()) {
+    for (size_t i = 0; i < NumberOfTypes; ++i) {
+      VPackSlice value = slice.get(typeNames[i].attribute);
+      if (value.isNumber()) {
+        result.values[i] = value.getNumber<uint64_t>();
+      }
+    }
+  }
+  return result;
+}
+
+char const* StoragePerfCounters::name(Type type) {
+  return typeNames[type].attribute;
+}
+
+StoragePerfScope::StoragePerfScope(bool enabled)
+    : _active(enabled && engine() != nullptr), _previous(false) {
+  if (_active) {
+    _previous = engine()->setThreadPerfCounters(true);
+    engine()->threadPerfCounters(_begin);
+  }
+}
+
+StoragePerfScope::~StoragePerfScope() {
+  if (_active && !_previous) {
+    engine()->setThreadPerfCounters(false);
+  }
+}
+
+StoragePerfCounters StoragePerfScope::elapsed() const {
+  if (!_active) {
+    return StoragePerfCounters();
+  }
+  return current() - _begin;
+}
+
+StoragePerfCounters StoragePerfScope::current() {
+  StoragePerfCounters result;
+  if (engine() != nullptr) {
+    engine()->threadPerfCounters(result);
+  }
+  return result;
+}
+
+Mutex StoragePerfStatistics::_lock;
+std::map<std::pair<std::string, std::string>, StoragePerfStatistics::Entry> StoragePerfStatistics::_entries;
+
+void StoragePerfStatistics::setSamplingInterval(uint32_t interval) {
+  samplingInterval.store(interval, std::memory_order_relaxed);
+}
+
+bool StoragePerfStatistics::sample() {
+  uint32_t const interval = samplingInterval.load(std::memory_order_relaxed);
+  if (interval == 0) {
+    return false;
+  }
+  // a counter per thread is good enough to spread the samples and avoids
+  // contention on a shared one
+  thread_local uint32_t operations = 0;
+  return (++operations % interval) == 0;
+}
+
+void StoragePerfStatistics::add(char const* source, std::string const& name,
+                                StoragePerfCounters const& counters) {
+  MUTEX_LOCKER(locker, _lock);
+  Entry& entry = _entries[std::make_pair(std::string(source), name)];
+  ++entry.operations;
+  entry.counters += counters;
+}
+
+void StoragePerfStatistics::toPrometheus(std::string& result) {
+  using metrics::Registry;
+
+  std::map<std::pair<std::string, std::string>, Entry> entries;
+  {
+    MUTEX_LOCKER(locker, _lock);
+    entries = _entries;
+  }
+  if (entries.empty()) {
+    return;
+  }
+
+  std::vector<std::string> labels;
+  labels.reserve(entries.size());
+  for (auto const& it : entries) {
+    labels.emplace_back("{source=\"" + Registry::sanitize(it.first.first) +
+                        "\",name=\"" + Registry::sanitize(it.first.second) + "\"}");
+  }
+
+  std::string const prefix = "arangodb_storage_perf_";
+
+  Registry::appendHeader(result, prefix + "operations_total",
+                         "Number of sampled operations", "counter");
+  size_t i = 0;
+  for (auto const& it : entries) {
+    Registry::appendSample(result, prefix + "operations_total", labels[i++],
+                           it.second.operations);
+  }
+
+  for (size_t type = 0; type < StoragePerfCounters::NumberOfTypes; ++type) {
+    std::string const name = prefix + typeNames[type].metric + "_total";
+    Registry::appendHeader(result, name,
+                           std::string(typeNames[type].help) +
+                               " by sampled operations",
+                           "counter");
+    i = 0;
+    for (auto const& it : entries) {
+      Registry::appendSample(result, name, labels[i++],
+                             it.second.counters.values[type]);
+    }
+  }
+}
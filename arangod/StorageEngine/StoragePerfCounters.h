@@ -0,0 +1,135 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_STORAGE_ENGINE_STORAGE_PERF_COUNTERS_H
+#define ARANGOD_STORAGE_ENGINE_STORAGE_PERF_COUNTERS_H 1
+
+#include "Basics/Common.h"
+#include "Basics/Mutex.h"
+
+#include <velocypack/Slice.h>
+
+#include <map>
+
+namespace arangodb {
+namespace velocypack {
+class Builder;
+}
+
+/// @brief detailed performance counters of the storage engine, collected
+/// per thread. times are in nanoseconds. the counters are only maintained
+/// while enabled for a thread, see StoragePerfScope
+struct StoragePerfCounters {
+  enum Type : size_t {
+    BlockReads = 0,
+    BlockReadTime,
+    BlockCacheHits,
+    MemtableReads,
+    MemtableReadTime,
+    FileReadTime,
+    BloomFilterUseful,
+    BloomFilterHits,
+    WalWriteTime,
+    MemtableWriteTime,
+    WriteDelayTime,
+    NumberOfTypes
+  };
+
+  uint64_t values[NumberOfTypes] = {};
+
+  uint64_t& operator[](Type type) { return values[type]; }
+  uint64_t operator[](Type type) const { return values[type]; }
+
+  StoragePerfCounters& operator+=(StoragePerfCounters const& other);
+
+  /// @brief the difference to an earlier snapshot of the same thread
+  StoragePerfCounters operator-(StoragePerfCounters const& earlier) const;
+
+  bool empty() const;
+
+  /// @brief adds the non-zero counters as attributes to an open object
+  void toVelocyPack(velocypack::Builder& builder) const;
+
+  /// @brief reads counters written by toVelocyPack, missing ones are zero
+  static StoragePerfCounters fromVelocyPack(velocypack::Slice slice);
+
+  static char const* name(Type type);
+};
+
+/// @brief enables the storage engine's performance counters for the calling
+/// thread while it exists and restores the previous setting afterwards.
+/// scopes may be nested, each one measures the work done during its own
+/// lifetime. a scope constructed with enabled == false does nothing
+class StoragePerfScope {
+ public:
+  explicit StoragePerfScope(bool enabled);
+  ~StoragePerfScope();
+
+  StoragePerfScope(StoragePerfScope const&) = delete;
+  StoragePerfScope& operator=(StoragePerfScope const&) = delete;
+
+  bool active() const { return _active; }
+
+  /// @brief the counters of the work done by the thread since the scope was
+  /// constructed
+  StoragePerfCounters elapsed() const;
+
+  /// @brief the current counters of the calling thread
+  static StoragePerfCounters current();
+
+ private:
+  bool _active;
+  bool _previous;
+  StoragePerfCounters _begin;
+};
+
+/// @brief the performance counters of sampled operations, summed up per
+/// source (e.g. "rest" or "aql") and name (e.g. the handler or the node
+/// type), and exported as metrics
+class StoragePerfStatistics {
+ public:
+  StoragePerfStatistics() = delete;
+
+  /// @brief only every n-th request is sampled, 0 turns sampling off
+  static void setSamplingInterval(uint32_t interval);
+
+  /// @brief whether the calling thread should sample the operation it is
+  /// about to start
+  static bool sample();
+
+  static void add(char const* source, std::string const& name,
+                  StoragePerfCounters const& counters);
+
+  /// @brief append all sums in the Prometheus text format
+  static void toPrometheus(std::string& result);
+
+ private:
+  struct Entry {
+    uint64_t operations = 0;
+    StoragePerfCounters counters;
+  };
+
+  static Mutex _lock;
+  static std::map<std::pair<std::string, std::string>, Entry> _entries;
+};
+
+}  // namespace arangodb
+
+#endif
@@ -38,6 +38,12 @@
 
 using namespace arangodb;
 
+namespace {
+/// @brief maximum number of modified keys tracked per collection. with more
+/// keys, the whole collection is invalidated in the query cache
+constexpr size_t maxTrackedKeys = 1024;
+}  // namespace
+
 /// @brief transaction type
 TransactionState::TransactionState(TRI_vocbase_t& vocbase,
                                    TRI_voc_tid_t tid,
@@ -51,6 +57,7 @@ TransactionState::TransactionState(TRI_vocbase_t& vocbase,
       _serverRole(ServerState::instance()->getRole()),
       _hints(),
       _options(options),
+      _hasModifications(false),
       _nestingLevel(0),
       _registeredTransaction(false) {}
 
@@ -351,28 +358,68 @@ void TransactionState::releaseCollections() {
   }
 }
 
+/// @brief count a document operation on a collection, for the query cache
+void TransactionState::trackOperation(TRI_voc_cid_t cid) {
+  // tracked even without an active query cache, as the cache may be turned
+  // on while the transaction is still running
+  _hasModifications = true;
+  if (!arangodb::aql::QueryCache::instance()->mayBeActive()) {
+    return;
+  }
+  ++_modifiedKeys[cid].operations;
+}
+
+/// @brief remember the key of a document that was modified
+void TransactionState::trackModifiedKey(TRI_voc_cid_t cid,
+                                        arangodb::velocypack::StringRef const& key) {
+  auto it = _modifiedKeys.find(cid);
+  if (it == _modifiedKeys.end()) {
+    // operation was not counted, so the cache was not active
+    return;
+  }
+  auto& modified = (*it).second;
+  if (modified.keyHashes.size() >= ::maxTrackedKeys) {
+    // too many keys. don't track this one, so the whole collection
+    // gets invalidated
+    return;
+  }
+  modified.keyHashes.emplace(arangodb::aql::QueryCache::hashKey(key));
+  ++modified.tracked;
+}
+
 /// @brief clear the query cache for all collections that were modified by
-/// the transaction
+/// the transaction. if the keys of all modifications of a collection are
+/// known, only the results depending on these keys are invalidated
 void TransactionState::clearQueryCache() {
   if (_collections.empty()) {
     return;
   }
 
   try {
+    auto queryCache = arangodb::aql::QueryCache::instance();
     std::vector<std::string> collections;
 
     for (auto& trxCollection : _collections) {
-      if (trxCollection                      // valid instance
-          && trxCollection->collection()     // has a valid collection
-          && trxCollection->hasOperations()  // may have been modified
-      ) {
+      if (trxCollection == nullptr || trxCollection->collection() == nullptr) {
+        continue;
+      }
+      // single operations are not buffered in the transaction collection,
+      // but they are counted in _modifiedKeys
+      auto it = _modifiedKeys.find(trxCollection->id());
+      if (trxCollection->hasOperations() || it != _modifiedKeys.end()) {
         // we're only interested in collections that may have been modified
-        collections.emplace_back(trxCollection->collection()->guid());
+        if (it != _modifiedKeys.end() && !(*it).second.keyHashes.empty() &&
+            (*it).second.tracked == (*it).second.operations) {
+          queryCache->invalidate(&_vocbase, trxCollection->collection()->guid(),
+                                 (*it).second.keyHashes);
+        } else {
+          collections.emplace_back(trxCollection->collection()->guid());
+        }
       }
     }
 
     if (!collections.empty()) {
-      arangodb::aql::QueryCache::instance()->invalidate(&_vocbase, collections);
+      queryCache->invalidate(&_vocbase, collections);
     }
   } catch (...) {
     // in case something goes wrong, we have to remove all queries from the
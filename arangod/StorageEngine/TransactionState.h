@@ -35,6 +35,11 @@
 #include "VocBase/AccessMode.h"
 #include "VocBase/voc-types.h"
 
+#include <velocypack/StringRef.h>
+
+#include <unordered_map>
+#include <unordered_set>
+
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
 
 #define LOG_TRX(logid, llevel, trx, tlevel)                \
@@ -218,6 +223,18 @@ class TransactionState {
     _knownServers.clear();
   }
 
+  /// @brief count a document operation on a collection, for the query cache
+  void trackOperation(TRI_voc_cid_t cid);
+
+  /// @brief remember the key of a document that was modified, so that the
+  /// query cache only needs to invalidate results that depend on this key.
+  /// operations without a tracked key invalidate the whole collection
+  void trackModifiedKey(TRI_voc_cid_t cid, arangodb::velocypack::StringRef const& key);
+
+  /// @brief whether the transaction has modified any document so far.
+  /// queries running inside such a transaction can see uncommitted data
+  bool hasModifications() const { return _hasModifications; }
+
  protected:
   /// @brief find a collection in the transaction's list of collections
   TransactionCollection* findCollection(TRI_voc_cid_t cid, size_t& position) const;
@@ -230,6 +247,16 @@ class TransactionState {
   void clearQueryCache();
 
  private:
+  /// @brief modifications of a collection, as seen by the query cache
+  struct ModifiedKeys {
+    /// @brief number of document operations
+    uint64_t operations = 0;
+    /// @brief number of operations for which the key was tracked
+    uint64_t tracked = 0;
+    /// @brief hashes of the modified keys
+    std::unordered_set<uint64_t> keyHashes;
+  };
+
   /// @brief check if current user can access this collection
   Result checkCollectionPermission(std::string const& cname, AccessMode::Type) const;
 
@@ -258,6 +285,13 @@ class TransactionState {
   
   /// @brief servers we already talked to for this transactions
   arangodb::HashSet<std::string> _knownServers;
+
+  /// @brief modified keys per collection, for partial query cache
+  /// invalidation
+  std::unordered_map<TRI_voc_cid_t, ModifiedKeys> _modifiedKeys;
+
+  /// @brief whether a document operation was tracked
+  bool _hasModifications;
   
   /// @brief reference counter of # of 'Methods' instances using this object
   std::atomic<int> _nestingLevel;
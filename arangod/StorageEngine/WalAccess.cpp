@@ -40,7 +40,7 @@ bool WalAccessContext::shouldHandleView(TRI_voc_tick_t dbid, TRI_voc_cid_t vid)
   }
 
   if (_filter.vocbase == 0 ||
-      (_filter.vocbase == dbid && (_filter.collection == 0 || _filter.collection == vid))) {
+      (_filter.vocbase == dbid && _filter.includesCollection(vid))) {
     return true;
   }
   return false;
@@ -52,7 +52,7 @@ bool WalAccessContext::shouldHandleCollection(TRI_voc_tick_t dbid, TRI_voc_cid_t
     return false;
   }
   if (_filter.vocbase == 0 ||
-      (_filter.vocbase == dbid && (_filter.collection == 0 || _filter.collection == cid))) {
+      (_filter.vocbase == dbid && _filter.includesCollection(cid))) {
     LogicalCollection* collection = loadCollection(dbid, cid);
     if (collection == nullptr) {
       return false;
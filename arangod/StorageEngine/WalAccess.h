@@ -115,9 +115,13 @@ class WalAccess {
 
     /// only output markers from this database
     TRI_voc_tick_t vocbase = 0;
-    /// Only output data from this collection
-    /// FIXME: make a set of collections
-    TRI_voc_cid_t collection = 0;
+    /// Only output data from these collections, all if empty
+    std::unordered_set<TRI_voc_cid_t> collections;
+
+    /// @brief whether or not the data of a collection is requested
+    bool includesCollection(TRI_voc_cid_t cid) const {
+      return collections.empty() || collections.find(cid) != collections.end();
+    }
 
     /// only include these transactions, up to
     /// (not including) firstRegularTick
@@ -23,6 +23,7 @@
 
 #include "Context.h"
 
+#include "Basics/MutexLocker.h"
 #include "Basics/StringBuffer.h"
 #include "Cluster/ClusterInfo.h"
 #include "StorageEngine/EngineSelectorFeature.h"
@@ -72,6 +73,7 @@ transaction::Context::Context(TRI_vocbase_t& vocbase)
       _strings{_strArena},
       _options(arangodb::velocypack::Options::Defaults),
       _dumpOptions(arangodb::velocypack::Options::Defaults),
+      _threadSafe(false),
       _contextData(EngineSelectorFeature::ENGINE->createTransactionContextData()),
       _transaction{0, false},
       _ownsResolver(false) {
@@ -130,6 +132,7 @@ bool transaction::Context::isPinned(TRI_voc_cid_t cid) {
 
 /// @brief temporarily lease a StringBuffer object
 basics::StringBuffer* transaction::Context::leaseStringBuffer(size_t initialSize) {
+  CONDITIONAL_MUTEX_LOCKER(locker, _leaseLock, _threadSafe);
   if (_stringBuffer == nullptr) {
     _stringBuffer.reset(new basics::StringBuffer(initialSize, false));
   } else {
@@ -141,11 +144,13 @@ basics::StringBuffer* transaction::Context::leaseStringBuffer(size_t initialSize
 
 /// @brief return a temporary StringBuffer object
 void transaction::Context::returnStringBuffer(basics::StringBuffer* stringBuffer) {
+  CONDITIONAL_MUTEX_LOCKER(locker, _leaseLock, _threadSafe);
   _stringBuffer.reset(stringBuffer);
 }
 
 /// @brief temporarily lease a std::string
 std::string* transaction::Context::leaseString() {
+  CONDITIONAL_MUTEX_LOCKER(locker, _leaseLock, _threadSafe);
   if (_strings.empty()) {
     // create a new string and return it
     return new std::string();
@@ -160,6 +165,7 @@ std::string* transaction::Context::leaseString() {
 
 /// @brief return a temporary std::string object
 void transaction::Context::returnString(std::string* str) {
+  CONDITIONAL_MUTEX_LOCKER(locker, _leaseLock, _threadSafe);
   try {  // put string back into our vector of strings
     _strings.push_back(str);
   } catch (...) {
@@ -170,6 +176,7 @@ void transaction::Context::returnString(std::string* str) {
 
 /// @brief temporarily lease a Builder object
 VPackBuilder* transaction::Context::leaseBuilder() {
+  CONDITIONAL_MUTEX_LOCKER(locker, _leaseLock, _threadSafe);
   if (_builders.empty()) {
     // create a new builder and return it
     return new VPackBuilder();
@@ -185,6 +192,7 @@ VPackBuilder* transaction::Context::leaseBuilder() {
 
 /// @brief return a temporary Builder object
 void transaction::Context::returnBuilder(VPackBuilder* builder) {
+  CONDITIONAL_MUTEX_LOCKER(locker, _leaseLock, _threadSafe);
   try {
     // put builder back into our vector of builders
     _builders.push_back(builder);
@@ -25,6 +25,7 @@
 #define ARANGOD_TRANSACTION_CONTEXT_H 1
 
 #include "Basics/Common.h"
+#include "Basics/Mutex.h"
 #include "Basics/SmallVector.h"
 #include "VocBase/voc-types.h"
 
@@ -78,6 +79,10 @@ class Context {
   /// @brief whether or not the data for the collection is pinned
   bool isPinned(TRI_voc_cid_t);
 
+  /// @brief synchronize leasing and returning temporary objects from now
+  /// on, so the transaction can be used by more than one thread at a time
+  void setThreadSafe() noexcept { _threadSafe = true; }
+
   /// @brief temporarily lease a StringBuffer object
   basics::StringBuffer* leaseStringBuffer(size_t initialSize);
 
@@ -149,6 +154,10 @@ class Context {
 
   arangodb::velocypack::Options _options;
   arangodb::velocypack::Options _dumpOptions;
+
+  /// @brief protects the leased objects, only used if _threadSafe is set
+  Mutex _leaseLock;
+  bool _threadSafe;
   
  private:
   std::unique_ptr<transaction::ContextData> _contextData;
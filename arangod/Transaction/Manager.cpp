@@ -37,6 +37,7 @@
 #include <velocypack/Iterator.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include <thread>
 
 namespace arangodb {
 namespace transaction {
@@ -51,6 +52,12 @@ namespace {
   };
 }
 
+size_t Manager::getCounterSlot() noexcept {
+  static thread_local size_t const slot =
+      std::hash<std::thread::id>()(std::this_thread::get_id()) % numCounterSlots;
+  return slot;
+}
+
 // register a list of failed transactions
 void Manager::registerFailedTransactions(std::unordered_set<TRI_voc_tid_t> const& failedTransactions) {
   TRI_ASSERT(_keepTransactionData);
@@ -76,19 +83,21 @@ void Manager::unregisterFailedTransactions(std::unordered_set<TRI_voc_tid_t> con
 
 void Manager::registerTransaction(TRI_voc_tid_t transactionId,
                                   std::unique_ptr<TransactionData> data) {
-  _nrRunning.fetch_add(1, std::memory_order_relaxed);
+  auto& counter = _nrRunning[getCounterSlot()].value;
+  counter.fetch_add(1, std::memory_order_relaxed);
 
+  // only engines that need to inspect running transactions pay for
+  // registering them
   if (_keepTransactionData) {
     TRI_ASSERT(data != nullptr);
     const size_t bucket = getBucket(transactionId);
-    READ_LOCKER(allTransactionsLocker, _allTransactionsLock);
     WRITE_LOCKER(writeLocker, _transactions[bucket]._lock);
 
     try {
       // insert into currently running list of transactions
       _transactions[bucket]._activeTransactions.emplace(transactionId, std::move(data));
     } catch (...) {
-      _nrRunning.fetch_sub(1, std::memory_order_relaxed);
+      counter.fetch_sub(1, std::memory_order_relaxed);
       throw;
     }
   }
@@ -96,13 +105,10 @@ void Manager::registerTransaction(TRI_voc_tid_t transactionId,
 
 // unregisters a transaction
 void Manager::unregisterTransaction(TRI_voc_tid_t transactionId, bool markAsFailed) {
-  uint64_t r = _nrRunning.fetch_sub(1, std::memory_order_relaxed);
-  TRI_ASSERT(r > 0);
+  _nrRunning[getCounterSlot()].value.fetch_sub(1, std::memory_order_relaxed);
 
   if (_keepTransactionData) {
     const size_t bucket = getBucket(transactionId);
-    READ_LOCKER(allTransactionsLocker, _allTransactionsLock);
-
     WRITE_LOCKER(writeLocker, _transactions[bucket]._lock);
 
     _transactions[bucket]._activeTransactions.erase(transactionId);
@@ -136,9 +142,9 @@ void Manager::iterateActiveTransactions(
   if (!_keepTransactionData) {
     return;
   }
-  WRITE_LOCKER(allTransactionsLocker, _allTransactionsLock);
 
-  // iterate over all active transactions
+  // iterate over all active transactions. callers only look for minimum
+  // values, so there is no need to freeze all buckets at once
   for (size_t bucket = 0; bucket < numBuckets; ++bucket) {
     READ_LOCKER(locker, _transactions[bucket]._lock);
 
@@ -150,7 +156,11 @@ void Manager::iterateActiveTransactions(
 }
 
 uint64_t Manager::getActiveTransactionCount() {
-  return _nrRunning.load(std::memory_order_relaxed);
+  int64_t count = 0;
+  for (auto const& slot : _nrRunning) {
+    count += slot.value.load(std::memory_order_relaxed);
+  }
+  return count > 0 ? static_cast<uint64_t>(count) : 0;
 }
 
 Manager::ManagedTrx::~ManagedTrx() {
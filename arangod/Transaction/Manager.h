@@ -50,14 +50,14 @@ struct Options;
 
 /// @bried Tracks TransasctionState instances 
 class Manager final {
-  static constexpr size_t numBuckets = 16;
+  static constexpr size_t numBuckets = 64;
+  static constexpr size_t numCounterSlots = 16;
   static constexpr double defaultTTL = 10.0 * 60.0;   // 10 minutes
   static constexpr double tombstoneTTL = 5.0 * 60.0;  // 5 minutes
 
  public:
   explicit Manager(bool keepData)
     : _keepTransactionData(keepData),
-      _nrRunning(0),
       _disallowInserts(false) {}
 
  public:
@@ -127,6 +127,9 @@ class Manager final {
   inline size_t getBucket(TRI_voc_tid_t tid) const {
     return std::hash<TRI_voc_cid_t>()(tid) % numBuckets;
   }
+
+  // slot of _nrRunning used by the current thread
+  static size_t getCounterSlot() noexcept;
   
   Result updateTransaction(TRI_voc_tid_t tid, transaction::Status status,
                            bool clearServers);
@@ -159,10 +162,14 @@ private:
   
   const bool _keepTransactionData;
 
-  // a lock protecting ALL buckets in _transactions
+  // a lock protecting ALL buckets in _transactions. not needed for
+  // _activeTransactions and _failedTransactions, which are only ever
+  // inspected bucket by bucket
   mutable basics::ReadWriteLock _allTransactionsLock;
 
-  struct {
+  // buckets are cache line aligned, so that threads working on different
+  // buckets do not contend on the same cache line
+  struct alignas(64) {
     // a lock protecting _activeTransactions and _failedTransactions
     mutable basics::ReadWriteLock _lock;
 
@@ -176,8 +183,13 @@ private:
     std::unordered_map<TRI_voc_tid_t, ManagedTrx> _managed;
   } _transactions[numBuckets];
 
-  /// Nr of running transactions
-  std::atomic<uint64_t> _nrRunning;
+  /// Nr of running transactions, striped so that registering threads do not
+  /// all modify the same cache line. a single slot may become negative if a
+  /// transaction ends on another thread than it started, only the sum counts
+  struct alignas(64) CounterSlot {
+    std::atomic<int64_t> value{0};
+  };
+  CounterSlot _nrRunning[numCounterSlots];
   
   std::atomic<bool> _disallowInserts;
 };
@@ -40,6 +40,7 @@
 #include "Cluster/ClusterFeature.h"
 #include "Cluster/ClusterMethods.h"
 #include "Cluster/ClusterTrxMethods.h"
+#include "Cluster/DocumentBatcher.h"
 #include "Cluster/FollowerInfo.h"
 #include "Cluster/ReplicationTimeoutFeature.h"
 #include "Cluster/ServerState.h"
@@ -60,6 +61,7 @@
 #include "Utils/ExecContext.h"
 #include "Utils/OperationCursor.h"
 #include "Utils/OperationOptions.h"
+#include "VocBase/KeyGenerator.h"
 #include "VocBase/KeyLockInfo.h"
 #include "VocBase/LogicalCollection.h"
 #include "VocBase/ManagedDocumentResult.h"
@@ -68,6 +70,7 @@
 
 #include <velocypack/Builder.h>
 #include <velocypack/Collection.h>
+#include <velocypack/Iterator.h>
 #include <velocypack/Options.h>
 #include <velocypack/Slice.h>
 #include <velocypack/velocypack-aliases.h>
@@ -1347,6 +1350,45 @@ Result transaction::Methods::documentFastPath(std::string const& collectionName,
   return Result(TRI_ERROR_NO_ERROR);
 }
 
+/// @brief return multiple documents from a collection, fast path
+Result transaction::Methods::documentsFastPath(std::string const& collectionName,
+                                               VPackSlice const keys,
+                                               VPackBuilder& result) {
+  TRI_ASSERT(_state->status() == transaction::Status::RUNNING);
+  TRI_ASSERT(keys.isArray());
+  TRI_ASSERT(result.isOpenArray());
+
+  if (_state->isCoordinator()) {
+    for (VPackSlice key : VPackArrayIterator(keys)) {
+      Result res = documentFastPath(collectionName, nullptr, key, result, true);
+      if (res.fail() && !res.is(TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND)) {
+        return res;
+      }
+    }
+    return Result();
+  }
+
+  TRI_voc_cid_t cid = addCollectionAtRuntime(collectionName);
+  LogicalCollection* collection = documentCollection(trxCollection(cid));
+
+  pinData(cid);  // will throw when it fails
+
+  std::vector<VPackSlice> lookup;
+  lookup.reserve(static_cast<size_t>(keys.length()));
+  for (VPackSlice key : VPackArrayIterator(keys)) {
+    if (!key.isString() || key.getStringLength() == 0) {
+      return Result(TRI_ERROR_ARANGO_DOCUMENT_HANDLE_BAD);
+    }
+    lookup.emplace_back(key);
+  }
+
+  collection->getPhysical()->readMultipleKeys(this, lookup,
+                                              [&result](LocalDocumentId const&, VPackSlice doc) {
+                                                result.add(doc);
+                                              });
+  return Result();
+}
+
 /// @brief return one document from a collection, fast path
 ///        If everything went well the result will contain the found document
 ///        (as an external on single_server) and this function will return
@@ -1720,25 +1762,6 @@ OperationResult transaction::Methods::insertCoordinator(std::string const& colle
 }
 #endif
 
-/// @brief choose a timeout for synchronous replication, based on the
-/// number of documents we ship over
-static double chooseTimeout(size_t count, size_t totalBytes) {
-  // We usually assume that a server can process at least 2500 documents
-  // per second (this is a low estimate), and use a low limit of 0.5s
-  // and a high timeout of 120s
-  double timeout = count / 2500.0;
-
-  // Really big documents need additional adjustment. Using total size
-  // of all messages to handle worst case scenario of constrained resource
-  // processing all
-  timeout += (totalBytes / 4096) * ReplicationTimeoutFeature::timeoutPer4k;
-
-  if (timeout < ReplicationTimeoutFeature::lowerLimit) {
-    return ReplicationTimeoutFeature::lowerLimit * ReplicationTimeoutFeature::timeoutFactor;
-  }
-  return (std::min)(120.0, timeout) * ReplicationTimeoutFeature::timeoutFactor;
-}
-
 /// @brief create one or multiple documents in a collection, local
 /// the single-document variant of this operation will either succeed or,
 /// if it fails, clean up after itself
@@ -1857,7 +1880,7 @@ OperationResult transaction::Methods::insertLocal(std::string const& collectionN
   ManagedDocumentResult docResult;
   ManagedDocumentResult prevDocResult;  // return OLD (with override option)
 
-  auto workForOneDocument = [&](VPackSlice const value) -> Result {
+  auto workForOneDocument = [&](VPackSlice const value, bool exists) -> Result {
     if (!value.isObject()) {
       return Result(TRI_ERROR_ARANGO_DOCUMENT_TYPE_INVALID);
     }
@@ -1876,9 +1899,20 @@ OperationResult transaction::Methods::insertLocal(std::string const& collectionN
     TRI_ASSERT(!(options.overwrite && needsLock));
 
     TRI_ASSERT(needsLock == !isLocked(collection, AccessMode::Type::WRITE));
-    Result res =
-        collection->insert(this, value, docResult, options,
-                           needsLock, &keyLockInfo, updateFollowers);
+    Result res;
+    if (exists) {
+      // the key is known to exist, so the insert would fail anyway. the
+      // key must still pass the checks of the insert, so that the result
+      // is the same as for a single document
+      TRI_ASSERT(options.overwrite);
+      VPackValueLength l;
+      char const* p = value.get(StaticStrings::KeyString).getString(l);
+      r = collection->keyGenerator()->validate(p, l, options.isRestore);
+      res.reset(r != TRI_ERROR_NO_ERROR ? r : TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED);
+    } else {
+      res = collection->insert(this, value, docResult, options,
+                               needsLock, &keyLockInfo, updateFollowers);
+    }
 
     bool didReplace = false;
     if (options.overwrite && res.is(TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED)) {
@@ -1900,6 +1934,17 @@ OperationResult transaction::Methods::insertLocal(std::string const& collectionN
       return res;
     }
 
+    {
+      // the key may have been generated by the insert
+      VPackSlice keySlice = value.get(StaticStrings::KeyString);
+      if (!keySlice.isString() && !docResult.empty()) {
+        keySlice = transaction::helpers::extractKeyFromDocument(VPackSlice(docResult.vpack()));
+      }
+      if (keySlice.isString()) {
+        _state->trackModifiedKey(cid, arangodb::velocypack::StringRef(keySlice));
+      }
+    }
+
     if (!options.silent) {
       const bool showReplaced = (options.returnOld && didReplace);
       TRI_ASSERT(!options.returnNew || !docResult.empty());
@@ -1924,17 +1969,50 @@ OperationResult transaction::Methods::insertLocal(std::string const& collectionN
   Result res;
   std::unordered_map<int, size_t> countErrorCodes;
   if (value.isArray()) {
+    // with overwrite, look up all given keys at once, so that documents
+    // that already exist go straight to the replace instead of failing
+    // an insert first. keys of documents inserted by this operation are
+    // not known here, these are still handled by the failing insert
+    std::vector<VPackSlice> keys;
+    std::vector<size_t> positions;
+    std::vector<LocalDocumentId> documentIds;
+    if (options.overwrite) {
+      size_t i = 0;
+      for (VPackSlice s : VPackArrayIterator(value)) {
+        if (s.isObject()) {
+          VPackSlice key = s.get(StaticStrings::KeyString);
+          if (key.isString()) {
+            keys.emplace_back(key);
+            positions.emplace_back(i);
+          }
+        }
+        ++i;
+      }
+      if (!keys.empty()) {
+        collection->getPhysical()->lookupKeys(this, keys, documentIds);
+        TRI_ASSERT(documentIds.size() == keys.size());
+      }
+    }
+
     VPackArrayBuilder b(&resultBuilder);
+    size_t i = 0;
+    size_t next = 0;
     for (auto const& s : VPackArrayIterator(value)) {
-      res = workForOneDocument(s);
+      bool exists = false;
+      if (next < positions.size() && positions[next] == i) {
+        exists = documentIds[next].isSet();
+        ++next;
+      }
+      res = workForOneDocument(s, exists);
       if (res.fail()) {
         createBabiesError(resultBuilder, countErrorCodes, res);
       }
+      ++i;
     }
     // With babies the reporting is handled in the body of the result
     res = Result(TRI_ERROR_NO_ERROR);
   } else {
-    res = workForOneDocument(value);
+    res = workForOneDocument(value, false);
   }
 
   if (res.ok() && replicationType == ReplicationType::LEADER) {
@@ -2215,6 +2293,10 @@ OperationResult transaction::Methods::modifyLocal(std::string const& collectionN
       return res;
     }
 
+    TRI_ASSERT(newVal.get(StaticStrings::KeyString).isString());
+    _state->trackModifiedKey(cid, arangodb::velocypack::StringRef(
+                                      newVal.get(StaticStrings::KeyString)));
+
     if (!options.silent) {
       TRI_ASSERT(!options.returnOld || !previous.empty());
       TRI_ASSERT(!options.returnNew || !result.empty());
@@ -2480,6 +2562,8 @@ OperationResult transaction::Methods::removeLocal(std::string const& collectionN
       return res;
     }
 
+    _state->trackModifiedKey(cid, key);
+
     if (!options.silent) {
       TRI_ASSERT(!options.returnOld || !previous.empty());
       TRI_ASSERT(previous.revisionId() != 0);
@@ -3076,7 +3160,8 @@ std::unique_ptr<IndexIterator> transaction::Methods::indexScanForCondition(
 /// note: the caller must have read-locked the underlying collection when
 /// calling this method
 std::unique_ptr<IndexIterator> transaction::Methods::indexScan(std::string const& collectionName,
-                                                               CursorType cursorType) {
+                                                               CursorType cursorType,
+                                                               size_t parallelism) {
   // For now we assume indexId is the iid part of the index.
 
   if (_state->isCoordinator()) {
@@ -3103,7 +3188,11 @@ std::unique_ptr<IndexIterator> transaction::Methods::indexScan(std::string const
       break;
     }
     case CursorType::ALL: {
-      iterator = logical->getAllIterator(this);
+      if (parallelism > 1) {
+        iterator = logical->getParallelAllIterator(this, parallelism);
+      } else {
+        iterator = logical->getAllIterator(this);
+      }
       break;
     }
   }
@@ -3398,20 +3487,31 @@ Result Methods::replicateOperations(LogicalCollection const& collection,
     return res.reset(TRI_ERROR_SHUTTING_DOWN);
   };
 
+  // the single-document operation of a single-operation transaction can be
+  // replicated together with concurrent ones on the same shard, as such
+  // transactions do not send transaction headers to the followers. batches
+  // are multi-document operations
+  DocumentBatcher* batcher = DocumentBatcher::instance();
+  bool const batched = batcher != nullptr && !value.isArray() &&
+                       _state->hasHint(transaction::Hints::Hint::SINGLE_OPERATION);
+
   // path and requestType are different for insert/remove/modify.
 
   std::stringstream pathStream;
   pathStream << "/_db/" << arangodb::basics::StringUtils::urlEncode(vocbase().name())
              << "/_api/document/"
              << arangodb::basics::StringUtils::urlEncode(collection.name());
-  if (operation != TRI_VOC_DOCUMENT_OPERATION_INSERT && !value.isArray()) {
+  if (operation != TRI_VOC_DOCUMENT_OPERATION_INSERT && !value.isArray() && !batched) {
     TRI_ASSERT(value.isObject());
     TRI_ASSERT(value.hasKey(StaticStrings::KeyString));
     pathStream << "/" << value.get(StaticStrings::KeyString).copyString();
   }
   pathStream << "?isRestore=true&isSynchronousReplication="
-             << ServerState::instance()->getId() << "&"
-             << StaticStrings::SilentString << "=true";
+             << ServerState::instance()->getId();
+  if (!batched) {
+    // a batch needs the individual results to tell which operations failed
+    pathStream << "&" << StaticStrings::SilentString << "=true";
+  }
 
   arangodb::rest::RequestType requestType = RequestType::ILLEGAL;
 
@@ -3475,22 +3575,61 @@ Result Methods::replicateOperations(LogicalCollection const& collection,
     return res;
   }
 
-  auto body = std::make_shared<std::string>();
-  *body = payload->slice().toJson();
-
-  // Now prepare the requests:
-  std::vector<ClusterCommRequest> requests;
-  requests.reserve(followers->size());
-
-  for (auto const& f : *followers) {
-    auto headers = std::make_unique<std::unordered_map<std::string, std::string>>();
-    ClusterTrxMethods::addTransactionHeader(*this, f, *headers);
-    requests.emplace_back("server:" + f, requestType, path, body, std::move(headers));
+  std::vector<bool> replicationWorked(followers->size(), false);
+  bool refused = false;
+
+  if (batched) {
+    // the result maps each follower to the response code for our document
+    auto r = batcher->execute(requestType, basics::StringUtils::join(*followers, ','),
+                              path, payload->slice());
+    VPackSlice codes;
+    if (r.error == TRI_ERROR_NO_ERROR && r.body != nullptr) {
+      codes = r.body->slice();
+    }
+    for (size_t i = 0; i < followers->size(); ++i) {
+      VPackSlice code = codes.isObject() ? codes.get((*followers)[i]) : VPackSlice();
+      if (code.isNumber()) {
+        auto answerCode = static_cast<rest::ResponseCode>(code.getNumber<int>());
+        replicationWorked[i] = answerCode == rest::ResponseCode::ACCEPTED ||
+                               answerCode == rest::ResponseCode::CREATED ||
+                               answerCode == rest::ResponseCode::OK;
+        refused |= answerCode == rest::ResponseCode::NOT_ACCEPTABLE;
+      }
+    }
+  } else {
+    auto body = std::make_shared<std::string>();
+    *body = payload->slice().toJson();
+
+    // Now prepare the requests:
+    std::vector<ClusterCommRequest> requests;
+    requests.reserve(followers->size());
+
+    for (auto const& f : *followers) {
+      auto headers = std::make_unique<std::unordered_map<std::string, std::string>>();
+      ClusterTrxMethods::addTransactionHeader(*this, f, *headers);
+      requests.emplace_back("server:" + f, requestType, path, body, std::move(headers));
+    }
+
+    double const timeout =
+        ReplicationTimeoutFeature::chooseTimeout(count, body->size() * followers->size());
+
+    cc->performRequests(requests, timeout, Logger::REPLICATION, false);
+
+    for (size_t i = 0; i < followers->size(); ++i) {
+      replicationWorked[i] =
+          requests[i].done && requests[i].result.status == CL_COMM_RECEIVED &&
+          (requests[i].result.answer_code == rest::ResponseCode::ACCEPTED ||
+           requests[i].result.answer_code == rest::ResponseCode::CREATED ||
+           requests[i].result.answer_code == rest::ResponseCode::OK);
+      if (replicationWorked[i]) {
+        bool found;
+        requests[i].result.answer->header(StaticStrings::ErrorCodes, found);
+        replicationWorked[i] = !found;
+      }
+    }
+    refused = findRefusal(requests);
   }
 
-  double const timeout = chooseTimeout(count, body->size() * followers->size());
-
-  cc->performRequests(requests, timeout, Logger::REPLICATION, false);
   // If any would-be-follower refused to follow there are two possiblities:
   // (1) there is a new leader in the meantime, or
   // (2) the follower was restarted and forgot that it is a follower.
@@ -3505,17 +3644,7 @@ Result Methods::replicateOperations(LogicalCollection const& collection,
 
   // We drop all followers that were not successful:
   for (size_t i = 0; i < followers->size(); ++i) {
-    bool replicationWorked =
-        requests[i].done && requests[i].result.status == CL_COMM_RECEIVED &&
-        (requests[i].result.answer_code == rest::ResponseCode::ACCEPTED ||
-         requests[i].result.answer_code == rest::ResponseCode::CREATED ||
-         requests[i].result.answer_code == rest::ResponseCode::OK);
-    if (replicationWorked) {
-      bool found;
-      requests[i].result.answer->header(StaticStrings::ErrorCodes, found);
-      replicationWorked = !found;
-    }
-    if (!replicationWorked) {
+    if (!replicationWorked[i]) {
       auto const& followerInfo = collection.followers();
       if (followerInfo->remove((*followers)[i])) {
         // TODO: what happens if a server is re-added during a transaction ?
@@ -3532,7 +3661,7 @@ Result Methods::replicateOperations(LogicalCollection const& collection,
     }
   }
 
-  if (findRefusal(requests)) {  // case (1), caller may abort this transaction
+  if (refused) {  // case (1), caller may abort this transaction
     return res.reset(TRI_ERROR_CLUSTER_SHARD_LEADER_RESIGNED);
   }
 
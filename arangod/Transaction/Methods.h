@@ -287,6 +287,15 @@ class Methods {
                                                ManagedDocumentResult& result,
                                                bool shouldLock);
 
+  /// @brief return multiple documents from a collection, fast path.
+  ///        keys must be an array of key strings. All documents found are
+  ///        appended to the open array in result, in the order of the keys,
+  ///        and keys that do not exist are left out. On a single server the
+  ///        lookups are batched. Does not care for revision handling!
+  Result documentsFastPath(std::string const& collectionName,
+                           arangodb::velocypack::Slice const keys,
+                           arangodb::velocypack::Builder& result);
+
   /// @brief return one or multiple documents from a collection
   ENTERPRISE_VIRT OperationResult document(std::string const& collectionName,
                                            VPackSlice const value,
@@ -376,10 +385,12 @@ class Methods {
 
   /// @brief factory for IndexIterator objects
   /// note: the caller must have read-locked the underlying collection when
-  /// calling this method
+  /// calling this method. a parallelism > 1 allows the storage engine to
+  /// scan a collection with multiple threads, returning documents in no
+  /// particular order. it is ignored for CursorType::ANY
   ENTERPRISE_VIRT
   std::unique_ptr<IndexIterator> indexScan(std::string const& collectionName,
-                                           CursorType cursorType);
+                                           CursorType cursorType, size_t parallelism = 1);
 
   /// @brief test if a collection is already locked
   ENTERPRISE_VIRT bool isLocked(arangodb::LogicalCollection*, AccessMode::Type) const;
@@ -39,7 +39,8 @@ Options::Options()
       intermediateCommitSize(defaultIntermediateCommitSize),
       intermediateCommitCount(defaultIntermediateCommitCount),
       allowImplicitCollections(true),
-      waitForSync(false)
+      waitForSync(false),
+      shareReadSnapshot(false)
 #ifdef USE_ENTERPRISE
       ,
       skipInaccessibleCollections(false)
@@ -82,6 +83,10 @@ void Options::fromVelocyPack(arangodb::velocypack::Slice const& slice) {
   if (value.isBool()) {
     waitForSync = value.getBool();
   }
+  value = slice.get("shareReadSnapshot");
+  if (value.isBool()) {
+    shareReadSnapshot = value.getBool();
+  }
 #ifdef USE_ENTERPRISE
   value = slice.get("skipInaccessibleCollections");
   if (value.isBool()) {
@@ -100,6 +105,7 @@ void Options::toVelocyPack(arangodb::velocypack::Builder& builder) const {
   builder.add("intermediateCommitCount", VPackValue(intermediateCommitCount));
   builder.add("allowImplicit", VPackValue(allowImplicitCollections));
   builder.add("waitForSync", VPackValue(waitForSync));
+  builder.add("shareReadSnapshot", VPackValue(shareReadSnapshot));
 #ifdef USE_ENTERPRISE
   builder.add("skipInaccessibleCollections", VPackValue(skipInaccessibleCollections));
 #endif
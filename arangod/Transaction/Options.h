@@ -59,6 +59,9 @@ struct Options {
   uint64_t intermediateCommitCount;
   bool allowImplicitCollections;
   bool waitForSync;
+  /// @brief read-only transactions may share a slightly older snapshot
+  /// with other read-only transactions instead of acquiring their own
+  bool shareReadSnapshot;
 #ifdef USE_ENTERPRISE
   bool skipInaccessibleCollections;
 #endif
@@ -35,12 +35,14 @@ struct OperationOptions {
         waitForSync(false),
         keepNull(true),
         mergeObjects(true),
+        incrementNumbers(false),
         silent(false),
         ignoreRevs(true),
         returnOld(false),
         returnNew(false),
         isRestore(false),
         overwrite(false),
+        allowDirtyReads(false),
         indexOperationMode(Index::OperationMode::normal) {}
 
   // original marker, set by an engine's recovery procedure only!
@@ -56,6 +58,10 @@ struct OperationOptions {
   // merge objects. only used for update operations
   bool mergeObjects;
 
+  // add numeric values to the existing numeric values of the document
+  // instead of replacing them. only used for update operations
+  bool incrementNumbers;
+
   // be silent. this will build smaller results and thus may speed up operations
   bool silent;
 
@@ -76,6 +82,10 @@ struct OperationOptions {
   // for insert operations: do not fail if _key exists but replace the document
   bool overwrite;
 
+  // for read operations in a cluster: allow reading from any in-sync
+  // follower of a shard, not only from its leader
+  bool allowDirtyReads;
+
   // for synchronous replication operations, we have to mark them such that
   // we can deny them if we are a (new) leader, and that we can deny other
   // operation if we are merely a follower. Finally, we must deny replications
@@ -45,7 +45,8 @@ V8Context::V8Context(size_t id, v8::Isolate* isolate)
       _lastGcStamp(0.0),
       _invocations(0),
       _invocationsSinceLastGc(0),
-      _hasActiveExternals(false) {}
+      _hasActiveExternals(false),
+      _restAction(false) {}
 
 void V8Context::lockAndEnter() {
   TRI_ASSERT(_isolate != nullptr);
@@ -106,6 +106,9 @@ class V8Context {
   uint64_t _invocations;
   uint64_t _invocationsSinceLastGc;
   bool _hasActiveExternals;
+  // whether the context is entered for a user-defined REST action. only
+  // accessed under the context condition of the dealer
+  bool _restAction;
 
   Mutex _globalMethodsLock;
   std::vector<GlobalContextMethods::MethodType> _globalMethods;
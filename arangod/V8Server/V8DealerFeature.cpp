@@ -31,8 +31,10 @@
 #include "Basics/ArangoGlobalContext.h"
 #include "Basics/ConditionLocker.h"
 #include "Basics/FileUtils.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/StringUtils.h"
 #include "Basics/TimedAction.h"
+#include "Basics/system-functions.h"
 #include "Cluster/ClusterFeature.h"
 #include "Cluster/ServerState.h"
 #include "Logger/Logger.h"
@@ -100,6 +102,8 @@ V8DealerFeature::V8DealerFeature(application_features::ApplicationServer& server
       _nrMaxContexts(0),
       _nrMinContexts(0),
       _nrInflightContexts(0),
+      _nrReservedContexts(0),
+      _nrBusyRestActionContexts(0),
       _maxContextInvocations(0),
       _allowAdminExecute(false),
       _enableJS(true),
@@ -158,6 +162,12 @@ void V8DealerFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
                      "executing JavaScript actions",
                      new UInt64Parameter(&_nrMinContexts));
 
+  options->addOption("--javascript.v8-contexts-reserved",
+                     "number of V8 contexts that user-defined REST actions "
+                     "(e.g. Foxx services) cannot use, so that they remain "
+                     "available for queries, tasks and internal operations",
+                     new UInt64Parameter(&_nrReservedContexts));
+
   options->addOption(
       "--javascript.v8-contexts-max-invocations",
       "maximum number of invocations for each V8 context before it is disposed",
@@ -371,8 +381,14 @@ void V8DealerFeature::start() {
     _nrMaxContexts = _nrMinContexts;
   }
 
+  if (_nrReservedContexts >= _nrMaxContexts) {
+    // REST actions must be able to use at least one context
+    _nrReservedContexts = _nrMaxContexts - 1;
+  }
+
   LOG_TOPIC("09e14", DEBUG, Logger::V8) << "number of V8 contexts: min: " << _nrMinContexts
-                               << ", max: " << _nrMaxContexts;
+                               << ", max: " << _nrMaxContexts
+                               << ", reserved: " << _nrReservedContexts;
 
   defineDouble("V8_CONTEXTS", static_cast<double>(_nrMaxContexts));
 
@@ -383,37 +399,69 @@ void V8DealerFeature::start() {
     _busyContexts.reserve(static_cast<size_t>(_nrMaxContexts));
     _idleContexts.reserve(static_cast<size_t>(_nrMaxContexts));
     _dirtyContexts.reserve(static_cast<size_t>(_nrMaxContexts));
+  }
 
-    for (size_t i = 0; i < _nrMinContexts; ++i) {
-      guard.unlock();  // avoid lock order inversion in buildContext
-      V8Context* context = buildContext(nextId());
-      guard.lock();
-      TRI_ASSERT(context != nullptr);
+  // setting up a context runs the startup scripts in it, which takes a
+  // while. contexts are independent of each other, so they are set up in
+  // parallel. the first one is set up on its own, so that whatever the
+  // startup scripts do only once has happened before the others start
+  std::vector<V8Context*> contexts(static_cast<size_t>(_nrMinContexts), nullptr);
+  TRI_DEFER(for (auto& context : contexts) { delete context; });
+
+  // cache the startup script before it is loaded concurrently
+  _startupLoader.findScript("server/initialize.js");
+
+  contexts[0] = addContext();
+
+  std::atomic<size_t> next(1);
+  Mutex errorLock;
+  std::exception_ptr error;
+  auto setup = [&]() {
+    size_t i;
+    while ((i = next.fetch_add(1)) < contexts.size()) {
       try {
-        _contexts.push_back(context);
+        contexts[i] = addContext();
       } catch (...) {
-        delete context;
-        throw;
+        MUTEX_LOCKER(locker, errorLock);
+        if (!error) {
+          error = std::current_exception();
+        }
       }
     }
+  };
 
-    TRI_ASSERT(_contexts.size() > 0);
-    TRI_ASSERT(_contexts.size() <= _nrMaxContexts);
-    for (auto& context : _contexts) {
-      // apply context update is only run on contexts that no other
-      // threads can see (yet)
-      guard.unlock();
-      applyContextUpdate(context);
-      guard.lock();
-      _idleContexts.push_back(context);
+  size_t const numThreads =
+      (std::min)(contexts.size() - 1, (std::max)(TRI_numberProcessors(), size_t(1)));
+  {
+    std::vector<std::thread> threads;
+    TRI_DEFER(for (auto& thread : threads) { thread.join(); });
+    for (size_t i = 1; i < numThreads; ++i) {
+      threads.emplace_back(setup);
     }
+    setup();
   }
 
-  auto* sysDbFeature =
-      arangodb::application_features::ApplicationServer::getFeature<arangodb::SystemDatabaseFeature>();
-  auto database = sysDbFeature->use();
+  if (error) {
+    std::rethrow_exception(error);
+  }
+
+  LOG_TOPIC("c8b9f", DEBUG, Logger::V8)
+      << "set up " << contexts.size() << " V8 context(s) using " << (std::max)(numThreads, size_t(1))
+      << " thread(s)";
+
+  {
+    CONDITION_LOCKER(guard, _contextCondition);
+    for (auto& context : contexts) {
+      TRI_ASSERT(context != nullptr);
+      // should not fail because we reserved enough space beforehand
+      _contexts.push_back(context);
+      _idleContexts.push_back(context);
+      context = nullptr;
+    }
+    TRI_ASSERT(_contexts.size() > 0);
+    TRI_ASSERT(_contexts.size() <= _nrMaxContexts);
+  }
 
-  loadJavaScriptFileInAllContexts(database.get(), "server/initialize.js", nullptr);
   startGarbageCollection();
 }
 
@@ -896,16 +944,25 @@ V8Context* V8DealerFeature::enterContext(TRI_vocbase_t* vocbase, JavaScriptSecur
 
   V8Context* context = nullptr;
 
+  // user-defined REST actions must leave the reserved contexts alone
+  bool const restAction = securityContext.isRestAction() && _nrReservedContexts > 0;
+  auto restActionLimitReached = [&]() -> bool {
+    return restAction &&
+           _nrBusyRestActionContexts >= _nrMaxContexts - _nrReservedContexts;
+  };
+
   // look for a free context
   {
     CONDITION_LOCKER(guard, _contextCondition);
 
-    while (_idleContexts.empty() && !_stopping) {
+    while ((_idleContexts.empty() || restActionLimitReached()) && !_stopping) {
       TRI_ASSERT(guard.isLocked());
 
       LOG_TOPIC("619ab", TRACE, arangodb::Logger::V8) << "waiting for unused V8 context";
 
-      if (!_dirtyContexts.empty()) {
+      if (restActionLimitReached()) {
+        // wait until one of the other REST actions is done
+      } else if (!_dirtyContexts.empty()) {
         // we'll use a dirty context in this case
         _idleContexts.push_back(_dirtyContexts.back());
         _dirtyContexts.pop_back();
@@ -915,7 +972,8 @@ V8Context* V8DealerFeature::enterContext(TRI_vocbase_t* vocbase, JavaScriptSecur
       bool const contextLimitNotExceeded =
           (_contexts.size() + _nrInflightContexts < _nrMaxContexts);
 
-      if (contextLimitNotExceeded && _dynamicContextCreationBlockers == 0) {
+      if (!restActionLimitReached() && contextLimitNotExceeded &&
+          _dynamicContextCreationBlockers == 0) {
         ++_nrInflightContexts;
 
         TRI_ASSERT(guard.isLocked());
@@ -992,6 +1050,11 @@ V8Context* V8DealerFeature::enterContext(TRI_vocbase_t* vocbase, JavaScriptSecur
 
     // should not fail because we reserved enough space beforehand
     _busyContexts.emplace(context);
+
+    if (restAction) {
+      context->_restAction = true;
+      ++_nrBusyRestActionContexts;
+    }
   }
 
   TRI_ASSERT(context != nullptr);
@@ -1002,6 +1065,14 @@ V8Context* V8DealerFeature::enterContext(TRI_vocbase_t* vocbase, JavaScriptSecur
   return context;
 }
 
+void V8DealerFeature::releaseRestActionContext(V8Context* context) {
+  if (context->_restAction) {
+    TRI_ASSERT(_nrBusyRestActionContexts > 0);
+    context->_restAction = false;
+    --_nrBusyRestActionContexts;
+  }
+}
+
 void V8DealerFeature::exitContextInternal(V8Context* context) {
   TRI_DEFER(context->unlockAndExit());
   cleanupLockedContext(context);
@@ -1137,6 +1208,7 @@ void V8DealerFeature::exitContext(V8Context* context) {
     }
 
     _busyContexts.erase(context);
+    releaseRestActionContext(context);
 
     LOG_TOPIC("fc763", TRACE, arangodb::Logger::V8)
         << "returned dirty V8 context #" << context->id();
@@ -1146,6 +1218,7 @@ void V8DealerFeature::exitContext(V8Context* context) {
     CONDITION_LOCKER(guard, _contextCondition);
 
     _busyContexts.erase(context);
+    releaseRestActionContext(context);
     // note that re-adding the context here should not fail as we reserved
     // enough room for all contexts during startup
     _idleContexts.emplace_back(context);
@@ -71,6 +71,8 @@ class V8DealerFeature final : public application_features::ApplicationFeature {
   uint64_t _nrMaxContexts;          // maximum number of contexts to create
   uint64_t _nrMinContexts;          // minimum number of contexts to keep
   uint64_t _nrInflightContexts;     // number of contexts currently in creation
+  uint64_t _nrReservedContexts;     // number of contexts not used for REST actions
+  uint64_t _nrBusyRestActionContexts;  // number of contexts used by REST actions
   uint64_t _maxContextInvocations;  // maximum number of V8 context invocations
   bool _allowAdminExecute;
   bool _enableJS;
@@ -132,6 +134,8 @@ class V8DealerFeature final : public application_features::ApplicationFeature {
                                    V8Context* context, VPackBuilder* builder);
   void prepareLockedContext(TRI_vocbase_t*, V8Context*, JavaScriptSecurityContext const&);
   void exitContextInternal(V8Context*);
+  // must be called with the context condition locked
+  void releaseRestActionContext(V8Context*);
   void cleanupLockedContext(V8Context*);
   void applyContextUpdate(V8Context* context);
   void shutdownContexts();
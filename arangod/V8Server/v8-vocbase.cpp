@@ -921,6 +921,13 @@ static void JS_QueriesCurrentAql(v8::FunctionCallbackInfo<v8::Value> const& args
       obj->Set(TRI_V8_ASCII_STRING(isolate, "state"),
                TRI_V8_STD_STRING(isolate, aql::QueryExecutionState::toString(q.state)));
       obj->Set(TRI_V8_ASCII_STRING(isolate, "stream"), v8::Boolean::New(isolate, q.stream));
+      obj->Set(TRI_V8_ASCII_STRING(isolate, "user"), TRI_V8_STD_STRING(isolate, q.user));
+      VPackBuilder resources;
+      resources.openObject();
+      q.resources.toVelocyPack(resources);
+      resources.close();
+      obj->Set(TRI_V8_ASCII_STRING(isolate, "resources"),
+               TRI_VPackToV8(isolate, resources.slice()));
       result->Set(i++, obj);
     }
 
@@ -977,6 +984,13 @@ static void JS_QueriesSlowAql(v8::FunctionCallbackInfo<v8::Value> const& args) {
       obj->Set(TRI_V8_ASCII_STRING(isolate, "state"),
                TRI_V8_STD_STRING(isolate, aql::QueryExecutionState::toString(q.state)));
       obj->Set(TRI_V8_ASCII_STRING(isolate, "stream"), v8::Boolean::New(isolate, q.stream));
+      obj->Set(TRI_V8_ASCII_STRING(isolate, "user"), TRI_V8_STD_STRING(isolate, q.user));
+      VPackBuilder resources;
+      resources.openObject();
+      q.resources.toVelocyPack(resources);
+      resources.close();
+      obj->Set(TRI_V8_ASCII_STRING(isolate, "resources"),
+               TRI_VPackToV8(isolate, resources.slice()));
       result->Set(i++, obj);
     }
 
@@ -0,0 +1,362 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "CollectionStatistics.h"
+
+#include "Basics/Exceptions.h"
+#include "Basics/StaticStrings.h"
+#include "Basics/VelocyPackHelper.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <algorithm>
+
+using namespace arangodb;
+
+namespace {
+/// @brief a value of the sample, and how often it occurs
+struct ValueGroup {
+  VPackSlice value;
+  size_t count;
+  bool mostCommon;
+};
+
+int compare(VPackSlice lhs, VPackSlice rhs, VPackOptions const* options) {
+  return basics::VelocyPackHelper::compare(lhs, rhs, true, options);
+}
+
+/// @brief statistics of an attribute, from its non-null values in a sample
+/// of sampleSize documents
+CollectionStatistics::Attribute analyze(std::vector<VPackSlice>& values, size_t sampleSize,
+                                        uint64_t numberDocuments, VPackOptions const* options) {
+  TRI_ASSERT(sampleSize > 0);
+  TRI_ASSERT(values.size() <= sampleSize);
+  CollectionStatistics::Attribute result;
+  double const sampled = static_cast<double>(sampleSize);
+  double const present = static_cast<double>(values.size());
+  result.nullFraction = 1.0 - present / sampled;
+
+  std::sort(values.begin(), values.end(), [options](VPackSlice lhs, VPackSlice rhs) {
+    return ::compare(lhs, rhs, options) < 0;
+  });
+  std::vector<ValueGroup> groups;
+  for (auto const& it : values) {
+    if (groups.empty() || ::compare(groups.back().value, it, options) != 0) {
+      groups.emplace_back(ValueGroup{it, 0, false});
+    }
+    ++groups.back().count;
+  }
+
+  // estimate the number of distinct values with the Duj1 estimator of Haas
+  // and Stokes, which relies on the values that occur only once
+  double const distinct = static_cast<double>(groups.size());
+  if (sampleSize >= numberDocuments) {
+    result.distinctValues = distinct;
+  } else if (!values.empty()) {
+    double const total = present * static_cast<double>(numberDocuments) / sampled;
+    double const once = static_cast<double>(std::count_if(
+        groups.begin(), groups.end(), [](ValueGroup const& g) { return g.count == 1; }));
+    result.distinctValues = present * distinct / (present - once + once * present / total);
+    result.distinctValues = (std::max)((std::min)(result.distinctValues, total), distinct);
+  }
+
+  // all values are most common values if there are only few of them.
+  // otherwise only those that are considerably more common than the average
+  std::vector<size_t> byCount;
+  for (size_t i = 0; i < groups.size(); ++i) {
+    byCount.emplace_back(i);
+  }
+  std::stable_sort(byCount.begin(), byCount.end(), [&groups](size_t lhs, size_t rhs) {
+    return groups[lhs].count > groups[rhs].count;
+  });
+  bool const complete = groups.size() <= CollectionStatistics::maxMostCommonValues;
+  double const average = present / (std::max)(distinct, 1.0);
+  result.mostCommonValues.openArray();
+  for (size_t i = 0; i < byCount.size() && i < CollectionStatistics::maxMostCommonValues; ++i) {
+    ValueGroup& group = groups[byCount[i]];
+    if (!complete && (group.count < 2 || static_cast<double>(group.count) < 1.25 * average)) {
+      break;
+    }
+    group.mostCommon = true;
+    result.mostCommonValues.add(group.value);
+    result.mostCommonFrequencies.emplace_back(static_cast<double>(group.count) / sampled);
+  }
+  result.mostCommonValues.close();
+
+  std::vector<VPackSlice> others;
+  for (auto const& it : groups) {
+    if (!it.mostCommon) {
+      others.insert(others.end(), it.count, it.value);
+    }
+  }
+  result.histogramFraction = static_cast<double>(others.size()) / sampled;
+  result.histogramBounds.openArray();
+  if (!others.empty()) {
+    size_t const buckets = (std::min)(CollectionStatistics::histogramBuckets, others.size());
+    for (size_t i = 0; i <= buckets; ++i) {
+      result.histogramBounds.add(others[i * (others.size() - 1) / buckets]);
+    }
+  }
+  result.histogramBounds.close();
+  return result;
+}
+
+double number(VPackSlice slice, char const* name) {
+  VPackSlice value = slice.get(name);
+  if (!value.isNumber()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                   std::string("invalid collection statistics, expecting number for '") +
+                                       name + "'");
+  }
+  return value.getNumber<double>();
+}
+
+VPackSlice array(VPackSlice slice, char const* name) {
+  VPackSlice value = slice.get(name);
+  if (!value.isArray()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                   std::string("invalid collection statistics, expecting array for '") +
+                                       name + "'");
+  }
+  return value;
+}
+}  // namespace
+
+CollectionStatistics::Attribute::Attribute()
+    : nullFraction(0.0), distinctValues(0.0), histogramFraction(0.0) {}
+
+double CollectionStatistics::Attribute::equalitySelectivity(VPackSlice value,
+                                                            VPackOptions const* options) const {
+  if (value.isNone() || value.isNull()) {
+    return nullFraction;
+  }
+  size_t i = 0;
+  for (VPackSlice it : VPackArrayIterator(mostCommonValues.slice())) {
+    if (::compare(it, value, options) == 0) {
+      return mostCommonFrequencies[i];
+    }
+    ++i;
+  }
+  // the other values are assumed to be equally frequent
+  double const others = distinctValues - static_cast<double>(mostCommonFrequencies.size());
+  return histogramFraction / (std::max)(others, 1.0);
+}
+
+double CollectionStatistics::Attribute::rangeSelectivity(VPackSlice lower, bool includeLower,
+                                                         VPackSlice upper, bool includeUpper,
+                                                         VPackOptions const* options) const {
+  auto inRange = [&](VPackSlice value) {
+    if (!lower.isNone()) {
+      int const cmp = ::compare(value, lower, options);
+      if (cmp < 0 || (cmp == 0 && !includeLower)) {
+        return false;
+      }
+    }
+    if (!upper.isNone()) {
+      int const cmp = ::compare(value, upper, options);
+      if (cmp > 0 || (cmp == 0 && !includeUpper)) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  double result = 0.0;
+  if (inRange(VPackSlice::nullSlice())) {
+    result += nullFraction;
+  }
+  size_t i = 0;
+  for (VPackSlice it : VPackArrayIterator(mostCommonValues.slice())) {
+    if (inRange(it)) {
+      result += mostCommonFrequencies[i];
+    }
+    ++i;
+  }
+  if (histogramFraction > 0.0) {
+    double const from = lower.isNone() ? 0.0 : histogramPosition(lower, options);
+    double const to = upper.isNone() ? 1.0 : histogramPosition(upper, options);
+    if (to > from) {
+      result += (to - from) * histogramFraction;
+    }
+  }
+  return (std::min)(result, 1.0);
+}
+
+double CollectionStatistics::Attribute::histogramPosition(VPackSlice value,
+                                                          VPackOptions const* options) const {
+  VPackSlice bounds = histogramBounds.slice();
+  size_t const n = static_cast<size_t>(bounds.length());
+  if (n < 2 || ::compare(value, bounds.at(0), options) <= 0) {
+    return 0.0;
+  }
+  if (::compare(value, bounds.at(n - 1), options) >= 0) {
+    return 1.0;
+  }
+  size_t const buckets = n - 1;
+  for (size_t i = 0; i < buckets; ++i) {
+    VPackSlice to = bounds.at(i + 1);
+    if (::compare(value, to, options) >= 0) {
+      continue;
+    }
+    // within the bucket, numbers are assumed to be evenly distributed
+    VPackSlice from = bounds.at(i);
+    double fraction = 0.5;
+    if (value.isNumber() && from.isNumber() && to.isNumber()) {
+      double const low = from.getNumber<double>();
+      double const high = to.getNumber<double>();
+      if (high > low) {
+        fraction = (value.getNumber<double>() - low) / (high - low);
+        fraction = (std::max)((std::min)(fraction, 1.0), 0.0);
+      }
+    }
+    return (static_cast<double>(i) + fraction) / static_cast<double>(buckets);
+  }
+  return 1.0;
+}
+
+void CollectionStatistics::Attribute::toVelocyPack(VPackBuilder& builder) const {
+  builder.openObject();
+  builder.add("nullFraction", VPackValue(nullFraction));
+  builder.add("distinctValues", VPackValue(distinctValues));
+  builder.add("mostCommonValues", mostCommonValues.slice());
+  builder.add("mostCommonFrequencies", VPackValue(VPackValueType::Array));
+  for (double it : mostCommonFrequencies) {
+    builder.add(VPackValue(it));
+  }
+  builder.close();
+  builder.add("histogramBounds", histogramBounds.slice());
+  builder.add("histogramFraction", VPackValue(histogramFraction));
+  builder.close();
+}
+
+CollectionStatistics::CollectionStatistics(std::vector<VPackSlice> const& sample,
+                                           uint64_t numberDocuments, VPackOptions const* options)
+    : _numberDocuments((std::max)(numberDocuments, static_cast<uint64_t>(sample.size()))),
+      _sampleSize(sample.size()) {
+  if (sample.empty()) {
+    return;
+  }
+
+  // only keep the attributes that occur most often
+  std::unordered_map<std::string, size_t> occurrences;
+  for (auto const& document : sample) {
+    if (!document.isObject()) {
+      continue;
+    }
+    for (auto const& it : VPackObjectIterator(document, true)) {
+      std::string name = it.key.copyString();
+      if (name == StaticStrings::KeyString || name == StaticStrings::IdString ||
+          name == StaticStrings::RevString) {
+        // the primary index knows everything about these
+        continue;
+      }
+      ++occurrences[name];
+    }
+  }
+  std::vector<std::pair<std::string, size_t>> names(occurrences.begin(), occurrences.end());
+  std::sort(names.begin(), names.end(), [](std::pair<std::string, size_t> const& lhs,
+                                           std::pair<std::string, size_t> const& rhs) {
+    return lhs.second > rhs.second || (lhs.second == rhs.second && lhs.first < rhs.first);
+  });
+  if (names.size() > maxAttributes) {
+    names.resize(maxAttributes);
+  }
+
+  std::vector<VPackSlice> values;
+  for (auto const& name : names) {
+    values.clear();
+    for (auto const& document : sample) {
+      if (!document.isObject()) {
+        continue;
+      }
+      VPackSlice value = document.get(name.first);
+      if (!value.isNone() && !value.isNull()) {
+        values.emplace_back(value);
+      }
+    }
+    _attributes.emplace(name.first, ::analyze(values, sample.size(), _numberDocuments, options));
+  }
+}
+
+CollectionStatistics::CollectionStatistics(VPackSlice slice)
+    : _numberDocuments(0), _sampleSize(0) {
+  if (!slice.isObject()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                   "invalid collection statistics, expecting object");
+  }
+  _numberDocuments = static_cast<uint64_t>(::number(slice, "numberDocuments"));
+  _sampleSize = static_cast<uint64_t>(::number(slice, "sampleSize"));
+
+  VPackSlice attributes = slice.get("attributes");
+  if (!attributes.isObject()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                   "invalid collection statistics, expecting object for "
+                                   "'attributes'");
+  }
+  for (auto const& it : VPackObjectIterator(attributes)) {
+    if (!it.value.isObject()) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                     "invalid collection statistics, expecting object for "
+                                     "attribute");
+    }
+    Attribute attribute;
+    attribute.nullFraction = ::number(it.value, "nullFraction");
+    attribute.distinctValues = ::number(it.value, "distinctValues");
+    attribute.histogramFraction = ::number(it.value, "histogramFraction");
+    attribute.mostCommonValues.add(::array(it.value, "mostCommonValues"));
+    for (VPackSlice frequency : VPackArrayIterator(::array(it.value, "mostCommonFrequencies"))) {
+      if (!frequency.isNumber()) {
+        THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                       "invalid collection statistics, expecting number "
+                                       "for frequency");
+      }
+      attribute.mostCommonFrequencies.emplace_back(frequency.getNumber<double>());
+    }
+    if (attribute.mostCommonFrequencies.size() != attribute.mostCommonValues.slice().length()) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                     "invalid collection statistics, number of frequencies "
+                                     "does not match number of values");
+    }
+    attribute.histogramBounds.add(::array(it.value, "histogramBounds"));
+    _attributes.emplace(it.key.copyString(), std::move(attribute));
+  }
+}
+
+CollectionStatistics::Attribute const* CollectionStatistics::attribute(std::string const& name) const {
+  auto it = _attributes.find(name);
+  if (it == _attributes.end()) {
+    return nullptr;
+  }
+  return &(it->second);
+}
+
+void CollectionStatistics::toVelocyPack(VPackBuilder& builder) const {
+  builder.openObject();
+  builder.add("numberDocuments", VPackValue(_numberDocuments));
+  builder.add("sampleSize", VPackValue(_sampleSize));
+  builder.add("attributes", VPackValue(VPackValueType::Object));
+  for (auto const& it : _attributes) {
+    builder.add(VPackValue(it.first));
+    it.second.toVelocyPack(builder);
+  }
+  builder.close();
+  builder.close();
+}
@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_VOCBASE_COLLECTION_STATISTICS_H
+#define ARANGOD_VOCBASE_COLLECTION_STATISTICS_H 1
+
+#include "Basics/Common.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <unordered_map>
+#include <vector>
+
+namespace arangodb {
+namespace velocypack {
+struct Options;
+}
+
+/// @brief statistics about the values of the top-level attributes of a
+/// collection, computed from a sample of its documents. the optimizer uses
+/// them to estimate the selectivity of equality and range conditions.
+///
+/// for every attribute, the most common values are kept together with
+/// their frequencies. the other values are summarized by an equi-depth
+/// histogram, in which every bucket holds the same share of them. all
+/// frequencies are shares of the documents, documents without the
+/// attribute count as null, like in AQL.
+class CollectionStatistics {
+ public:
+  /// @brief maximum number of documents that are sampled
+  static constexpr size_t maxSampleSize = 10000;
+  /// @brief maximum number of attributes, the most frequent ones are kept
+  static constexpr size_t maxAttributes = 64;
+  static constexpr size_t maxMostCommonValues = 16;
+  static constexpr size_t histogramBuckets = 32;
+
+  struct Attribute {
+    Attribute();
+
+    /// @brief share of the documents with a null value
+    double nullFraction;
+    /// @brief estimated number of distinct non-null values in the collection
+    double distinctValues;
+    /// @brief array of the most common values
+    velocypack::Builder mostCommonValues;
+    /// @brief share of the documents with each of the most common values
+    std::vector<double> mostCommonFrequencies;
+    /// @brief array of the bounds of the histogram over all other non-null
+    /// values, in ascending order. bucket i holds the values between bounds
+    /// i and i + 1. empty if there are no other values
+    velocypack::Builder histogramBounds;
+    /// @brief share of the documents whose value is in the histogram
+    double histogramFraction;
+
+    /// @brief estimated share of the documents with the value
+    double equalitySelectivity(velocypack::Slice value,
+                               velocypack::Options const* options) const;
+
+    /// @brief estimated share of the documents with a value in the range.
+    /// a none slice stands for an open end
+    double rangeSelectivity(velocypack::Slice lower, bool includeLower,
+                            velocypack::Slice upper, bool includeUpper,
+                            velocypack::Options const* options) const;
+
+    void toVelocyPack(velocypack::Builder& builder) const;
+
+   private:
+    /// @brief estimated share of the histogram values lower than the value
+    double histogramPosition(velocypack::Slice value,
+                             velocypack::Options const* options) const;
+  };
+
+  /// @brief compute the statistics from a sample of the documents of a
+  /// collection with the given number of documents
+  CollectionStatistics(std::vector<velocypack::Slice> const& sample,
+                       uint64_t numberDocuments, velocypack::Options const* options);
+
+  /// @brief restore statistics from toVelocyPack(). throws if the slice
+  /// does not contain valid statistics
+  explicit CollectionStatistics(velocypack::Slice slice);
+
+  /// @brief number of documents in the collection at the time of sampling
+  uint64_t numberDocuments() const { return _numberDocuments; }
+
+  uint64_t sampleSize() const { return _sampleSize; }
+
+  /// @brief the statistics of a top-level attribute, nullptr if it has not
+  /// been in the sample or there are too many attributes
+  Attribute const* attribute(std::string const& name) const;
+
+  void toVelocyPack(velocypack::Builder& builder) const;
+
+ private:
+  uint64_t _numberDocuments;
+  uint64_t _sampleSize;
+  std::unordered_map<std::string, Attribute> _attributes;
+};
+
+}  // namespace arangodb
+
+#endif
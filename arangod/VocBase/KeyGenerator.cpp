@@ -191,6 +191,29 @@ enum class GeneratorType : int {
 /// @brief for older compilers
 typedef std::underlying_type<GeneratorType>::type GeneratorMapType;
 
+/// @brief number of cluster-wide unique ids a thread reserves at once
+constexpr uint64_t clusterIdsPerThread = 256;
+
+/// @brief returns a cluster-wide unique id for a traditional key. every
+/// thread reserves a block of ids, so that most keys can be generated
+/// without touching ClusterInfo's shared id state. ids left in a block when
+/// a thread ends are simply never used. the ids are not monotonic across
+/// threads, so this must not be used for the padded key generator
+uint64_t clusterKeyValue() {
+  struct IdBlock {
+    uint64_t next = 0;
+    uint64_t end = 0;
+  };
+  static thread_local IdBlock block;
+
+  if (block.next == block.end) {
+    ClusterInfo* ci = ClusterInfo::instance();
+    block.next = ci->uniqid(clusterIdsPerThread);
+    block.end = block.next + clusterIdsPerThread;
+  }
+  return block.next++;
+}
+
 /// Actual key generators following...
 
 /// @brief base class for traditional key generators
@@ -332,10 +355,7 @@ class TraditionalKeyGeneratorCluster final : public TraditionalKeyGenerator {
 
  private:
   /// @brief generate a key value (internal)
-  uint64_t generateValue() override {
-    ClusterInfo* ci = ClusterInfo::instance();
-    return ci->uniqid();
-  }
+  uint64_t generateValue() override { return clusterKeyValue(); }
 
   /// @brief track a key value (internal)
   void track(uint64_t /* value */) override {}
@@ -527,7 +547,9 @@ class PaddedKeyGeneratorCluster final : public PaddedKeyGenerator {
   }
 
  private:
-  /// @brief generate a key value (internal)
+  /// @brief generate a key value (internal). padded keys promise to be
+  /// ascending in creation order, so they are not taken from per-thread
+  /// blocks
   uint64_t generateValue() override {
     ClusterInfo* ci = ClusterInfo::instance();
     return ci->uniqid();
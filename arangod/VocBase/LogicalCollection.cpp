@@ -24,6 +24,7 @@
 
 #include "LogicalCollection.h"
 
+#include "Aql/PlanCache.h"
 #include "Aql/QueryCache.h"
 #include "Basics/Mutex.h"
 #include "Basics/ReadLocker.h"
@@ -317,6 +318,12 @@ int LogicalCollection::getResponsibleShard(arangodb::velocypack::Slice slice,
                                         usesDefaultShardKeys, key);
 }
 
+int LogicalCollection::getResponsibleShards(std::vector<arangodb::velocypack::Slice> const& slices,
+                                            std::vector<std::string>& shardIDs) {
+  TRI_ASSERT(_sharding != nullptr);
+  return _sharding->getResponsibleShards(slices, shardIDs);
+}
+
 /// @briefs creates a new document key, the input slice is ignored here
 std::string LogicalCollection::createKey(VPackSlice) {
   return keyGenerator()->generate();
@@ -341,6 +348,11 @@ std::unique_ptr<IndexIterator> LogicalCollection::getAnyIterator(transaction::Me
   return _physical->getAnyIterator(trx);
 }
 
+std::unique_ptr<IndexIterator> LogicalCollection::getParallelAllIterator(transaction::Methods* trx,
+                                                                         size_t parallelism) {
+  return _physical->getParallelAllIterator(trx, parallelism);
+}
+
 void LogicalCollection::invokeOnAllElements(transaction::Methods* trx,
                                             std::function<bool(LocalDocumentId const&)> callback) {
   _physical->invokeOnAllElements(trx, callback);
@@ -862,9 +874,7 @@ std::shared_ptr<Index> LogicalCollection::createIndex(VPackSlice const& info, bo
 /// @brief drops an index, including index file removal and replication
 bool LogicalCollection::dropIndex(TRI_idx_iid_t iid) {
   TRI_ASSERT(!ServerState::instance()->isCoordinator());
-#if USE_PLAN_CACHE
-  arangodb::aql::PlanCache::instance()->invalidate(_vocbase);
-#endif
+  arangodb::aql::PlanCache::instance()->invalidate(&vocbase());
 
   arangodb::aql::QueryCache::instance()->invalidate(&vocbase(), guid());
 
@@ -196,6 +196,10 @@ class LogicalCollection : public LogicalDataSource {
                           std::string& shardID, bool& usesDefaultShardKeys,
                           std::string const& key = "");
 
+  // query shards for multiple complete documents
+  int getResponsibleShards(std::vector<arangodb::velocypack::Slice> const& slices,
+                           std::vector<std::string>& shardIDs);
+
   /// @briefs creates a new document key, the input slice is ignored here
   /// this method is overriden in derived classes
   virtual std::string createKey(arangodb::velocypack::Slice input);
@@ -204,6 +208,8 @@ class LogicalCollection : public LogicalDataSource {
 
   std::unique_ptr<IndexIterator> getAllIterator(transaction::Methods* trx);
   std::unique_ptr<IndexIterator> getAnyIterator(transaction::Methods* trx);
+  std::unique_ptr<IndexIterator> getParallelAllIterator(transaction::Methods* trx,
+                                                        size_t parallelism);
 
   void invokeOnAllElements(transaction::Methods* trx,
                            std::function<bool(LocalDocumentId const&)> callback);
@@ -34,6 +34,7 @@
 #include "Cluster/ClusterInfo.h"
 #include "Cluster/ClusterMethods.h"
 #include "Cluster/ServerState.h"
+#include "Futures/Utilities.h"
 #include "GeneralServer/AuthenticationFeature.h"
 #include "RestServer/DatabaseFeature.h"
 #include "RestServer/QueryRegistryFeature.h"
@@ -41,6 +42,7 @@
 #include "Scheduler/SchedulerFeature.h"
 #include "Sharding/ShardingFeature.h"
 #include "StorageEngine/PhysicalCollection.h"
+#include "Transaction/Context.h"
 #include "Transaction/V8Context.h"
 #include "Utils/Events.h"
 #include "Utils/ExecContext.h"
@@ -51,6 +53,7 @@
 #include "V8/v8-utils.h"
 #include "V8Server/V8Context.h"
 #include "V8Server/V8DealerFeature.h"
+#include "VocBase/CollectionStatistics.h"
 #include "VocBase/LogicalCollection.h"
 #include "VocBase/vocbase.h"
 
@@ -685,7 +688,7 @@ Result Collections::warmup(TRI_vocbase_t& vocbase, LogicalCollection const& coll
 
   if (ServerState::instance()->isCoordinator()) {
     auto cid = std::to_string(coll.id());
-    return warmupOnCoordinator(vocbase.name(), cid);
+    return warmupOnCoordinator(vocbase.name(), cid).get();
   }
 
   auto ctx = transaction::V8Context::CreateWhenRequired(vocbase, false);
@@ -717,6 +720,86 @@ Result Collections::warmup(TRI_vocbase_t& vocbase, LogicalCollection const& coll
   return res;
 }
 
+futures::Future<Result> Collections::warmupAsync(TRI_vocbase_t& vocbase,
+                                                 LogicalCollection const& coll) {
+  if (!ServerState::instance()->isCoordinator()) {
+    return futures::makeFuture(warmup(vocbase, coll));
+  }
+
+  ExecContext const* exec = ExecContext::CURRENT;  // disallow expensive ops
+  if (exec != nullptr && !exec->canUseCollection(coll.name(), auth::Level::RO)) {
+    return futures::makeFuture(Result(TRI_ERROR_FORBIDDEN));
+  }
+
+  return warmupOnCoordinator(vocbase.name(), std::to_string(coll.id()));
+}
+
+Result Collections::analyze(TRI_vocbase_t& vocbase, LogicalCollection& coll,
+                            VPackBuilder& builder) {
+  ExecContext const* exec = ExecContext::CURRENT;  // disallow expensive ops
+  if (exec != nullptr && !exec->canUseCollection(coll.name(), auth::Level::RW)) {
+    return Result(TRI_ERROR_FORBIDDEN);
+  }
+
+  if (ServerState::instance()->isCoordinator()) {
+    // the statistics are kept by the shards
+    return Result(TRI_ERROR_CLUSTER_ONLY_ON_DBSERVER);
+  }
+
+  auto ctx = transaction::V8Context::CreateWhenRequired(vocbase, false);
+  SingleCollectionTransaction trx(ctx, coll, AccessMode::Type::READ);
+  Result res = trx.begin();
+
+  if (res.fail()) {
+    return res;
+  }
+
+  uint64_t const total = coll.numberDocuments(&trx, transaction::CountType::Normal);
+  size_t sampled = 0;
+  VPackBuilder documents;
+  documents.openArray();
+  auto cb = [&](LocalDocumentId const&, VPackSlice doc) {
+    documents.add(doc.resolveExternal());
+    ++sampled;
+  };
+
+  if (total <= CollectionStatistics::maxSampleSize) {
+    OperationCursor cursor(trx.indexScan(coll.name(), transaction::Methods::CursorType::ALL));
+    cursor.allDocuments(cb, 1000);
+  } else {
+    // every any-cursor starts at a random document and continues in
+    // storage order, so the sample is read in many small chunks
+    while (sampled < CollectionStatistics::maxSampleSize) {
+      size_t const before = sampled;
+      OperationCursor cursor(trx.indexScan(coll.name(), transaction::Methods::CursorType::ANY));
+      cursor.nextDocument(cb, (std::min)(CollectionStatistics::maxSampleSize - sampled, size_t(100)));
+      if (sampled == before) {
+        break;
+      }
+    }
+  }
+  documents.close();
+
+  std::vector<VPackSlice> sample;
+  sample.reserve(sampled);
+  for (VPackSlice it : VPackArrayIterator(documents.slice())) {
+    sample.emplace_back(it);
+  }
+  auto statistics = std::make_shared<CollectionStatistics>(
+      sample, total, trx.transactionContextPtr()->getVPackOptions());
+
+  res = trx.finish(res);
+  if (res.fail()) {
+    return res;
+  }
+
+  res = coll.getPhysical()->setStatistics(statistics);
+  if (res.ok()) {
+    statistics->toVelocyPack(builder);
+  }
+  return res;
+}
+
 Result Collections::revisionId(Context& ctxt, TRI_voc_rid_t& rid) {
   if (ServerState::instance()->isCoordinator()) {
     auto& databaseName = ctxt.coll()->vocbase().name();
@@ -24,6 +24,7 @@
 #define ARANGOD_VOC_BASE_API_COLLECTIONS_H 1
 
 #include "Basics/Result.h"
+#include "Futures/Future.h"
 #include "VocBase/AccessMode.h"
 #include "VocBase/voc-types.h"
 #include "VocBase/vocbase.h"
@@ -106,6 +107,16 @@ struct Collections {
 
   static Result warmup(TRI_vocbase_t& vocbase, LogicalCollection const& coll);
 
+  /// @brief like warmup, but does not block while the shards of a cluster
+  /// collection load their indexes
+  static futures::Future<Result> warmupAsync(TRI_vocbase_t& vocbase,
+                                             LogicalCollection const& coll);
+
+  /// @brief compute the statistics of the documents from a sample, and keep
+  /// them for the optimizer. the statistics are written into the builder
+  static Result analyze(TRI_vocbase_t& vocbase, LogicalCollection& coll,
+                        velocypack::Builder& builder);
+
   static Result revisionId(Context& ctxt, TRI_voc_rid_t& rid);
 
   /// @brief Helper implementation similar to ArangoCollection.all() in v8
@@ -53,6 +53,7 @@
 #include <velocypack/Collection.h>
 #include <velocypack/Iterator.h>
 #include <velocypack/velocypack-aliases.h>
+#include <array>
 #include <regex>
 
 using namespace arangodb;
@@ -177,6 +178,11 @@ arangodb::Result Indexes::getAll(LogicalCollection const* collection,
   
   double selectivity = 0, memory = 0, cacheSize = 0, cacheUsage = 0,
          cacheLifeTimeHitRate = 0, cacheWindowedHitRate = 0;
+  // cache counters, summed up for the merged edge index
+  static std::array<char const*, 5> const cacheCounters{
+      {"cacheHits", "cacheMisses", "cacheInserts", "cacheEvictions",
+       "cacheInsertRejections"}};
+  std::array<uint64_t, 5> cacheCounterValues{};
 
   VPackArrayBuilder a(&result);
   for (VPackSlice const& index : VPackArrayIterator(tmp.slice())) {
@@ -226,6 +232,12 @@ arangodb::Result Indexes::getAll(LogicalCollection const* collection,
           if ((val = figures.get("cacheWindowedHitRate")).isNumber()) {
             cacheWindowedHitRate += val.getNumber<double>();
           }
+
+          for (size_t i = 0; i < cacheCounters.size(); ++i) {
+            if ((val = figures.get(cacheCounters[i])).isNumber()) {
+              cacheCounterValues[i] += val.getNumber<uint64_t>();
+            }
+          }
         }
 
         if (fields[0].compareString(StaticStrings::FromString) == 0) {
@@ -245,6 +257,9 @@ arangodb::Result Indexes::getAll(LogicalCollection const* collection,
               merge.add("cacheUsage", VPackValue(cacheUsage));
               merge.add("cacheLifeTimeHitRate", VPackValue(cacheLifeTimeHitRate / 2));
               merge.add("cacheWindowedHitRate", VPackValue(cacheWindowedHitRate / 2));
+              for (size_t i = 0; i < cacheCounters.size(); ++i) {
+                merge.add(cacheCounters[i], VPackValue(cacheCounterValues[i]));
+              }
             }
             merge.close();
           }
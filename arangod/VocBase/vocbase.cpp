@@ -53,6 +53,7 @@
 #include "Replication/DatabaseReplicationApplier.h"
 #include "Replication/utilities.h"
 #include "RestServer/DatabaseFeature.h"
+#include "RestServer/DatabasePathFeature.h"
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "StorageEngine/PhysicalCollection.h"
 #include "StorageEngine/StorageEngine.h"
@@ -651,9 +652,7 @@ int TRI_vocbase_t::dropCollectionWorker(arangodb::LogicalCollection* collection,
   TRI_ASSERT(writeLocker.isLocked());
   TRI_ASSERT(locker.isLocked());
 
-#if USE_PLAN_CACHE
   arangodb::aql::PlanCache::instance()->invalidate(this);
-#endif
   arangodb::aql::QueryCache::instance()->invalidate(this);
 
   switch (collection->status()) {
@@ -1654,9 +1653,7 @@ arangodb::Result TRI_vocbase_t::dropView(TRI_voc_cid_t cid, bool allowDropSystem
   }
 
   // invalidate all entries in the plan and query cache now
-#if USE_PLAN_CACHE
   arangodb::aql::PlanCache::instance()->invalidate(this);
-#endif
   arangodb::aql::QueryCache::instance()->invalidate(this);
 
   unregisterView(*view);
@@ -1767,6 +1764,17 @@ void TRI_vocbase_t::addReplicationApplier() {
   TRI_ASSERT(_type != TRI_VOCBASE_TYPE_COORDINATOR);
   auto* applier = DatabaseReplicationApplier::create(*this);
   _replicationApplier.reset(applier);
+
+  // WAL subscriptions are stored next to the other per-server files
+  auto* dbPathFeature =
+      application_features::ApplicationServer::getFeature<DatabasePathFeature>(
+          "DatabasePath");
+  std::string const path = dbPathFeature->subdirectoryName("subscriptions");
+  if (!basics::FileUtils::isDirectory(path)) {
+    basics::FileUtils::createDirectory(path);
+  }
+  _replicationClients.loadSubscriptions(
+      basics::FileUtils::buildFilename(path, std::to_string(_id) + ".json"));
 }
 
 std::vector<std::shared_ptr<arangodb::LogicalView>> TRI_vocbase_t::views() {
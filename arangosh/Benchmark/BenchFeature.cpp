@@ -23,8 +23,10 @@
 #include "BenchFeature.h"
 
 #include <ctime>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
 
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Basics/StringUtils.h"
@@ -37,6 +39,8 @@
 #include "SimpleHttpClient/SimpleHttpClient.h"
 #include "SimpleHttpClient/SimpleHttpResult.h"
 
+#include <fuerte/loop.h>
+
 using namespace arangodb;
 using namespace arangodb::arangobench;
 using namespace arangodb::basics;
@@ -53,6 +57,53 @@ using namespace arangodb::rest;
 BenchFeature* ARANGOBENCH;
 #include "Benchmark/test-cases.h"
 
+namespace {
+
+/// @brief state of the periodic throughput and latency reports of a run
+struct TimeSeries {
+  double start;
+  size_t done;
+  size_t failures;
+  std::ofstream* file;
+};
+
+/// @brief print (and optionally write) the numbers since the last report
+void printIntervalReport(uint64_t run, TimeSeries& series,
+                         std::vector<BenchmarkThread*> const& threads,
+                         BenchmarkCounter<unsigned long>& counter, double interval) {
+  LatencyHistogram latencies;
+  for (auto* thread : threads) {
+    thread->takeIntervalHistogram(latencies);
+  }
+
+  size_t const done = counter.getDone();
+  size_t const failures = counter.failures();
+  size_t const operations = done - series.done;
+  double const rate = interval > 0.0 ? static_cast<double>(operations) / interval : 0.0;
+  series.done = done;
+
+  auto ms = [&latencies](double p) { return latencies.percentile(p) / 1000.0; };
+
+  std::ostringstream line;
+  line << std::fixed << std::setprecision(3) << (TRI_microtime() - series.start)
+       << " s: " << operations << " operations, " << rate << " ops/s, "
+       << (failures - series.failures) << " failures, latency (ms) p50: " << ms(50)
+       << ", p90: " << ms(90) << ", p99: " << ms(99) << ", p99.9: " << ms(99.9)
+       << ", max: " << (latencies.max() / 1000.0);
+  std::cout << line.str() << std::endl;
+
+  if (series.file != nullptr) {
+    *series.file << std::fixed << std::setprecision(3) << run << ','
+                 << (TRI_microtime() - series.start) << ',' << operations << ','
+                 << rate << ',' << (failures - series.failures) << ',' << ms(50)
+                 << ',' << ms(90) << ',' << ms(99) << ',' << ms(99.9) << ','
+                 << (latencies.max() / 1000.0) << '\n';
+  }
+  series.failures = failures;
+}
+
+}  // namespace
+
 BenchFeature::BenchFeature(application_features::ApplicationServer& server, int* result)
     : ApplicationFeature(server, "Bench"),
       _async(false),
@@ -63,6 +114,7 @@ BenchFeature::BenchFeature(application_features::ApplicationServer& server, int*
       _collection("ArangoBenchmark"),
       _testCase("version"),
       _complexity(1),
+      _scaleFactor(1),
       _delay(false),
       _progress(true),
       _verbose(false),
@@ -72,6 +124,11 @@ BenchFeature::BenchFeature(application_features::ApplicationServer& server, int*
       _replicationFactor(1),
       _numberOfShards(1),
       _waitForSync(false),
+      _rate(0.0),
+      _inFlight(0),
+      _connectionsPerThread(1),
+      _ioThreads(1),
+      _reportInterval(0.0),
       _result(result) {
   requiresElevatedPrivileges(false);
   setOptional(false);
@@ -95,6 +152,22 @@ void BenchFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
   options->addOption("--keep-alive", "use HTTP keep-alive",
                      new BooleanParameter(&_keepAlive));
 
+  options->addOption("--in-flight",
+                     "number of requests each thread keeps outstanding, sent "
+                     "asynchronously over --connections-per-thread connections "
+                     "(HTTP or VST, depending on the endpoint). 0 sends one "
+                     "blocking request at a time",
+                     new UInt64Parameter(&_inFlight));
+
+  options->addOption("--connections-per-thread",
+                     "number of connections per thread if --in-flight is used",
+                     new UInt64Parameter(&_connectionsPerThread));
+
+  options->addOption("--io-threads",
+                     "number of event loop threads handling the connections if "
+                     "--in-flight is used",
+                     new UInt64Parameter(&_ioThreads));
+
   options->addOption(
       "--collection",
       "collection name to use in tests (if they involve collections)",
@@ -122,16 +195,45 @@ void BenchFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
       "crud-append",     "crud-write-read",
       "aqltrx",          "counttrx",
       "multitrx",        "multi-collection",
-      "aqlinsert",       "aqlv8"};
+      "aqlinsert",       "aqlv8",
+      "traversal",       "shortest-path",
+      "join",            "collect",
+      "search",          "geo"};
 
   options->addOption("--test-case", "test case to use",
                      new DiscreteValuesParameter<StringParameter>(&_testCase, cases));
 
+  options->addOption("--test-case-mix",
+                     "weighted mix of test cases to run instead of --test-case, "
+                     "e.g. 'crud:3,document:1'",
+                     new StringParameter(&_testCaseMix));
+
+  options->addOption("--rate",
+                     "send requests at this total rate (requests per second) "
+                     "regardless of the response times and measure latencies "
+                     "from the scheduled send times (0 = send as fast as possible)",
+                     new DoubleParameter(&_rate));
+
+  options->addOption("--report-interval",
+                     "print throughput and latency percentiles every n seconds "
+                     "(0 = disabled)",
+                     new DoubleParameter(&_reportInterval));
+
+  options->addOption("--time-series-file",
+                     "filename to write the periodic reports to (CSV)",
+                     new StringParameter(&_timeSeriesFile));
+
   options->addOption(
       "--complexity",
       "complexity parameter for the test (meaning depends on test case)",
       new UInt64Parameter(&_complexity));
 
+  options->addOption("--scale-factor",
+                     "size of the generated data sets of the traversal, "
+                     "shortest-path, join, collect, search and geo test cases "
+                     "(multiples of 10,000 base documents)",
+                     new UInt64Parameter(&_scaleFactor));
+
   options->addOption("--delay",
                      "use a startup delay (necessary only when run in series)",
                      new BooleanParameter(&_delay));
@@ -177,13 +279,72 @@ void BenchFeature::start() {
   *_result = ret;
   ARANGOBENCH = this;
 
-  std::unique_ptr<BenchmarkOperation> benchmark(GetTestCase(_testCase));
+  std::vector<std::unique_ptr<BenchmarkOperation>> operations;
+  std::vector<BenchmarkCase> cases;
+
+  if (_testCaseMix.empty()) {
+    operations.emplace_back(GetTestCase(_testCase));
+
+    if (operations.back() == nullptr) {
+      ARANGOBENCH = nullptr;
+      LOG_TOPIC("ee2a5", FATAL, arangodb::Logger::FIXME)
+          << "invalid test case name '" << _testCase << "'";
+      FATAL_ERROR_EXIT();
+    }
+    cases.push_back({_testCase, operations.back().get(), 1});
+  } else {
+    for (std::string const& part : StringUtils::split(_testCaseMix, ',')) {
+      std::string name = StringUtils::trim(part);
+      uint64_t weight = 1;
+      size_t pos = name.find(':');
+      if (pos != std::string::npos) {
+        weight = StringUtils::uint64(StringUtils::trim(name.substr(pos + 1)));
+        name = StringUtils::trim(name.substr(0, pos));
+      }
+
+      bool const duplicate =
+          std::find_if(cases.begin(), cases.end(), [&name](BenchmarkCase const& c) {
+            return c.name == name;
+          }) != cases.end();
+      operations.emplace_back(GetTestCase(name));
+
+      if (operations.back() == nullptr || weight == 0 || duplicate) {
+        ARANGOBENCH = nullptr;
+        LOG_TOPIC("5b9e2", FATAL, arangodb::Logger::FIXME)
+            << "invalid test case mix entry '" << part << "'";
+        FATAL_ERROR_EXIT();
+      }
+      cases.push_back({name, operations.back().get(), weight});
+    }
+  }
+
+  _caseNames.clear();
+  for (auto const& c : cases) {
+    _caseNames.push_back(c.name);
+  }
+
+  std::unique_ptr<fuerte::EventLoopService> loop;
+  if (_inFlight > 0) {
+    if (_batchSize > 0) {
+      ARANGOBENCH = nullptr;
+      LOG_TOPIC("0c0f2", FATAL, arangodb::Logger::FIXME)
+          << "--batch-size cannot be used together with --in-flight";
+      FATAL_ERROR_EXIT();
+    }
+    loop = std::make_unique<fuerte::EventLoopService>(
+        static_cast<unsigned int>((std::max)(_ioThreads, uint64_t(1))));
+  }
 
-  if (benchmark == nullptr) {
-    ARANGOBENCH = nullptr;
-    LOG_TOPIC("ee2a5", FATAL, arangodb::Logger::FIXME)
-        << "invalid test case name '" << _testCase << "'";
-    FATAL_ERROR_EXIT();
+  std::ofstream timeSeriesFile;
+  if (!_timeSeriesFile.empty()) {
+    timeSeriesFile.open(_timeSeriesFile, std::ofstream::binary);
+    if (!timeSeriesFile.is_open()) {
+      ARANGOBENCH = nullptr;
+      LOG_TOPIC("0d7f4", FATAL, arangodb::Logger::FIXME)
+          << "cannot open time series file '" << _timeSeriesFile << "'";
+      FATAL_ERROR_EXIT();
+    }
+    timeSeriesFile << "run,time,operations,rate,failures,p50,p90,p99,p999,max\n";
   }
 
   double const stepSize = (double)_operations / (double)_concurreny;
@@ -213,9 +374,12 @@ void BenchFeature::start() {
     _started = 0;
     for (uint64_t i = 0; i < _concurreny; ++i) {
       BenchmarkThread* thread =
-          new BenchmarkThread(benchmark.get(), &startCondition, &BenchFeature::updateStartCounter,
+          new BenchmarkThread(cases, &startCondition, &BenchFeature::updateStartCounter,
                               static_cast<int>(i), (unsigned long)_batchSize,
-                              &operationsCounter, client, _keepAlive, _async, _verbose);
+                              &operationsCounter, client, _keepAlive, _async, _verbose,
+                              _rate / (double)_concurreny, loop.get(),
+                              static_cast<size_t>(_connectionsPerThread),
+                              static_cast<size_t>(_inFlight));
       thread->setOffset((size_t)(i * realStep));
       thread->start();
       threads.push_back(thread);
@@ -247,6 +411,9 @@ void BenchFeature::start() {
       nextReportValue = 100;
     }
 
+    TimeSeries series{start, 0, 0, timeSeriesFile.is_open() ? &timeSeriesFile : nullptr};
+    double lastInterval = start;
+
     while (true) {
       size_t const numOperations = operationsCounter.getDone();
 
@@ -259,14 +426,29 @@ void BenchFeature::start() {
         nextReportValue += stepValue;
       }
 
+      if (_reportInterval > 0.0) {
+        double const now = TRI_microtime();
+        if (now - lastInterval >= _reportInterval) {
+          printIntervalReport(j, series, threads, operationsCounter, now - lastInterval);
+          lastInterval = now;
+        }
+      }
+
       std::this_thread::sleep_for(std::chrono::microseconds(10000));
     }
 
     double time = TRI_microtime() - start;
     double requestTime = 0.0;
 
+    if (_reportInterval > 0.0) {
+      // the last, possibly shorter, interval
+      printIntervalReport(j, series, threads, operationsCounter, TRI_microtime() - lastInterval);
+    }
+
+    std::vector<LatencyHistogram> latencies(cases.size());
     for (size_t i = 0; i < static_cast<size_t>(_concurreny); ++i) {
       requestTime += threads[i]->getTime();
+      threads[i]->mergeHistograms(latencies);
     }
 
     if (operationsCounter.failures() > 0) {
@@ -278,6 +460,7 @@ void BenchFeature::start() {
         operationsCounter.failures(),
         operationsCounter.incompleteFailures(),
         requestTime,
+        std::move(latencies),
     });
     for (size_t i = 0; i < static_cast<size_t>(_concurreny); ++i) {
       delete threads[i];
@@ -290,7 +473,9 @@ void BenchFeature::start() {
   if (!ok) {
     std::cout << "At least one of the runs produced failures!" << std::endl;
   }
-  benchmark->tearDown();
+  for (auto const& c : cases) {
+    c.operation->tearDown();
+  }
 
   if (!ok) {
     ret = EXIT_FAILURE;
@@ -308,16 +493,26 @@ bool BenchFeature::report(ClientFeature* client, std::vector<BenchRunResult> res
             << ", replication factor: " << _replicationFactor
             << ", number of shards: " << _numberOfShards
             << ", wait for sync: " << (_waitForSync ? "true" : "false")
-            << ", concurrency level (threads): " << _concurreny << std::endl;
+            << ", concurrency level (threads): " << _concurreny;
+  if (_rate > 0.0) {
+    std::cout << ", rate: " << _rate << " requests/s";
+  }
+  if (_inFlight > 0) {
+    std::cout << ", requests in flight per thread: " << _inFlight
+              << ", connections per thread: " << _connectionsPerThread
+              << ", io threads: " << _ioThreads;
+  }
+  std::cout << std::endl;
 
-  std::cout << "Test case: " << _testCase << ", complexity: " << _complexity
+  std::cout << "Test case: " << (_testCaseMix.empty() ? _testCase : _testCaseMix)
+            << ", complexity: " << _complexity << ", scale factor: " << _scaleFactor
             << ", database: '" << client->databaseName() << "', collection: '"
             << _collection << "'" << std::endl;
 
   std::sort(results.begin(), results.end(),
-            [](BenchRunResult a, BenchRunResult b) { return a.time < b.time; });
+            [](BenchRunResult const& a, BenchRunResult const& b) { return a.time < b.time; });
 
-  BenchRunResult output{0, 0, 0, 0};
+  BenchRunResult output{};
   if (_runs > 1) {
     size_t size = results.size();
     std::cout << std::endl;
@@ -337,6 +532,10 @@ bool BenchFeature::report(ClientFeature* client, std::vector<BenchRunResult> res
                     (results[mid - 1].failures + results[mid].failures) / 2,
                     (results[mid - 1].incomplete + results[mid].incomplete) / 2,
                     (results[mid - 1].requestTime + results[mid].requestTime) / 2);
+      output.latencies = results[mid - 1].latencies;
+      for (size_t i = 0; i < output.latencies.size(); ++i) {
+        output.latencies[i].merge(results[mid].latencies[i]);
+      }
     } else {
       output = results[mid];
     }
@@ -411,9 +610,11 @@ void BenchFeature::printResult(BenchRunResult const& result) {
             << ((double)_operations / result.time) << std::endl;
 
   std::cout << "Elapsed time since start: " << std::fixed << result.time << " s"
-            << std::endl
             << std::endl;
 
+  printLatencies(result);
+  std::cout << std::endl;
+
   if (result.failures > 0) {
     LOG_TOPIC("a826b", WARN, arangodb::Logger::FIXME)
         << result.failures << " arangobench request(s) failed!";
@@ -424,4 +625,26 @@ void BenchFeature::printResult(BenchRunResult const& result) {
   }
 }
 
+void BenchFeature::printLatencies(BenchRunResult const& result) {
+  if (result.latencies.empty()) {
+    return;
+  }
+
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(3) << "Request latencies (ms)"
+      << (_rate > 0.0 ? ", measured from the scheduled send time" : "") << ":\n";
+
+  for (size_t i = 0; i < result.latencies.size(); ++i) {
+    LatencyHistogram const& h = result.latencies[i];
+    out << "  " << (i < _caseNames.size() ? _caseNames[i] : std::to_string(i))
+        << ": requests: " << h.count() << ", mean: " << (h.mean() / 1000.0)
+        << ", min: " << (h.min() / 1000.0) << ", p50: " << (h.percentile(50) / 1000.0)
+        << ", p90: " << (h.percentile(90) / 1000.0)
+        << ", p99: " << (h.percentile(99) / 1000.0)
+        << ", p99.9: " << (h.percentile(99.9) / 1000.0)
+        << ", max: " << (h.max() / 1000.0) << "\n";
+  }
+  std::cout << out.str();
+}
+
 void BenchFeature::unprepare() { ARANGOBENCH = nullptr; }
@@ -24,6 +24,7 @@
 #define ARANGODB_BENCHMARK_BENCH_FEATURE_H 1
 
 #include "ApplicationFeatures/ApplicationFeature.h"
+#include "Benchmark/LatencyHistogram.h"
 
 namespace arangodb {
 
@@ -34,6 +35,7 @@ struct BenchRunResult {
   size_t failures;
   size_t incomplete;
   double requestTime;
+  std::vector<arangobench::LatencyHistogram> latencies;
 
   void update(double _time, size_t _failures, size_t _incomplete, double _requestTime) {
     time = _time;
@@ -58,7 +60,9 @@ class BenchFeature final : public application_features::ApplicationFeature {
   bool keepAlive() const { return _keepAlive; }
   std::string const& collection() const { return _collection; }
   std::string const& testCase() const { return _testCase; }
+  std::string const& testCaseMix() const { return _testCaseMix; }
   uint64_t complexity() const { return _complexity; }
+  uint64_t scaleFactor() const { return _scaleFactor; }
   bool delay() const { return _delay; }
   bool progress() const { return _progress; }
   bool verbose() const { return _verbose; }
@@ -68,11 +72,15 @@ class BenchFeature final : public application_features::ApplicationFeature {
   uint64_t replicationFactor() const { return _replicationFactor; }
   uint64_t numberOfShards() const { return _numberOfShards; }
   bool waitForSync() const { return _waitForSync; }
+  double rate() const { return _rate; }
+  uint64_t inFlight() const { return _inFlight; }
+  double reportInterval() const { return _reportInterval; }
 
  private:
   void status(std::string const& value);
   bool report(ClientFeature*, std::vector<BenchRunResult>);
   void printResult(BenchRunResult const& result);
+  void printLatencies(BenchRunResult const& result);
   bool writeJunitReport(BenchRunResult const& result);
 
   bool _async;
@@ -82,7 +90,9 @@ class BenchFeature final : public application_features::ApplicationFeature {
   bool _keepAlive;
   std::string _collection;
   std::string _testCase;
+  std::string _testCaseMix;
   uint64_t _complexity;
+  uint64_t _scaleFactor;
   bool _delay;
   bool _progress;
   bool _verbose;
@@ -92,6 +102,13 @@ class BenchFeature final : public application_features::ApplicationFeature {
   uint64_t _replicationFactor;
   uint64_t _numberOfShards;
   bool _waitForSync;
+  double _rate;
+  uint64_t _inFlight;
+  uint64_t _connectionsPerThread;
+  uint64_t _ioThreads;
+  double _reportInterval;
+  std::string _timeSeriesFile;
+  std::vector<std::string> _caseNames;
 
   int* _result;
 
@@ -77,6 +77,18 @@ struct BenchmarkOperation {
 
   virtual char const* payload(size_t*, int const, size_t const, size_t const, bool*) = 0;
 };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a test case taking part in a benchmark run. when several cases are
+/// mixed, each request picks a case with a probability proportional to its
+/// weight
+////////////////////////////////////////////////////////////////////////////////
+
+struct BenchmarkCase {
+  std::string name;
+  BenchmarkOperation* operation;
+  uint64_t weight;
+};
 }  // namespace arangobench
 }  // namespace arangodb
 
@@ -29,10 +29,13 @@
 #include "Basics/ConditionLocker.h"
 #include "Basics/ConditionVariable.h"
 #include "Basics/Exceptions.h"
+#include "Basics/Mutex.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/Thread.h"
 #include "Basics/hashes.h"
 #include "Benchmark/BenchmarkCounter.h"
 #include "Benchmark/BenchmarkOperation.h"
+#include "Benchmark/LatencyHistogram.h"
 #include "Logger/Logger.h"
 #include "Rest/HttpResponse.h"
 #include "Shell/ClientFeature.h"
@@ -40,17 +43,27 @@
 #include "SimpleHttpClient/SimpleHttpClient.h"
 #include "SimpleHttpClient/SimpleHttpResult.h"
 
+#include <fuerte/connection.h>
+#include <fuerte/jwt.h>
+#include <fuerte/loop.h>
+#include <fuerte/requests.h>
+
+#include <random>
+
 namespace arangodb {
 namespace arangobench {
 
 class BenchmarkThread : public arangodb::Thread {
  public:
-  BenchmarkThread(BenchmarkOperation* operation, basics::ConditionVariable* condition,
+  BenchmarkThread(std::vector<BenchmarkCase> const& cases, basics::ConditionVariable* condition,
                   void (*callback)(), int threadNumber, const unsigned long batchSize,
                   BenchmarkCounter<unsigned long>* operationsCounter,
-                  ClientFeature* client, bool keepAlive, bool async, bool verbose)
+                  ClientFeature* client, bool keepAlive, bool async, bool verbose,
+                  double rate, fuerte::EventLoopService* loop, size_t connections,
+                  size_t inFlight)
       : Thread("BenchmarkThread"),
-        _operation(operation),
+        _cases(cases),
+        _totalWeight(0),
         _startCondition(condition),
         _callback(callback),
         _threadNumber(threadNumber),
@@ -66,10 +79,24 @@ class BenchmarkThread : public arangodb::Thread {
         _async(async),
         _httpClient(nullptr),
         _offset(0),
-        _counter(0),
+        _counters(cases.size(), 0),
         _time(0.0),
+        _interval(rate > 0.0 ? 1.0 / rate : 0.0),
+        _nextSendTime(0.0),
+        _random(static_cast<std::mt19937_64::result_type>(threadNumber) + 1),
+        _histograms(cases.size()),
+        _loop(loop),
+        _numConnections((std::max)(connections, size_t(1))),
+        _nextConnection(0),
+        _maxInFlight((std::max)(inFlight, size_t(1))),
+        _inFlight(0),
         _verbose(verbose) {
+    TRI_ASSERT(!_cases.empty());
     _errorHeader = basics::StringUtils::tolower(StaticStrings::Errors);
+    for (auto const& c : _cases) {
+      _totalWeight += c.weight;
+      _cumulativeWeights.push_back(_totalWeight);
+    }
   }
 
   ~BenchmarkThread() { shutdown(); }
@@ -111,10 +138,12 @@ class BenchmarkThread : public arangodb::Thread {
 
     // if we're the first thread, set up the test
     if (_threadNumber == 0) {
-      if (!_operation->setUp(_httpClient.get())) {
-        LOG_TOPIC("528b6", FATAL, arangodb::Logger::FIXME)
-            << "could not set up the test";
-        FATAL_ERROR_EXIT();
+      for (auto const& c : _cases) {
+        if (!c.operation->setUp(_httpClient.get())) {
+          LOG_TOPIC("528b6", FATAL, arangodb::Logger::FIXME)
+              << "could not set up the test '" << c.name << "'";
+          FATAL_ERROR_EXIT();
+        }
       }
     }
 
@@ -122,6 +151,10 @@ class BenchmarkThread : public arangodb::Thread {
       _headers["x-arango-async"] = "true";
     }
 
+    if (_loop != nullptr) {
+      connectMultiplexed();
+    }
+
     _callback();
 
     // wait for start condition to be broadcasted
@@ -130,6 +163,13 @@ class BenchmarkThread : public arangodb::Thread {
       guard.wait();
     }
 
+    _nextSendTime = TRI_microtime();
+
+    if (_loop != nullptr) {
+      runMultiplexed();
+      return;
+    }
+
     while (!isStopping()) {
       unsigned long numOps = _operationsCounter->next(_batchSize);
 
@@ -137,11 +177,14 @@ class BenchmarkThread : public arangodb::Thread {
         break;
       }
 
+      size_t const caseIndex = nextCase();
+      double const scheduled = waitForSendTime();
+
       if (_batchSize < 1) {
-        executeSingleRequest();
+        executeSingleRequest(caseIndex, scheduled);
       } else {
         try {
-          executeBatchRequest(numOps);
+          executeBatchRequest(caseIndex, numOps, scheduled);
         } catch (arangodb::basics::Exception const& ex) {
           LOG_TOPIC("bd1d1", FATAL, arangodb::Logger::FIXME)
               << "Caught exception during test execution: " << ex.code() << " "
@@ -187,11 +230,237 @@ class BenchmarkThread : public arangodb::Thread {
     return std::string("/_db/" + t->_databaseName + "/" + location);
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief open the fuerte connections used in multiplexed mode
+  //////////////////////////////////////////////////////////////////////////////
+
+  void connectMultiplexed() {
+    _builder.endpoint(_client->endpoint());
+    if (!_client->jwtSecret().empty()) {
+      _builder.jwtToken(fuerte::jwt::generateInternalToken(_client->jwtSecret(), "arangobench"));
+      _builder.authenticationType(fuerte::AuthenticationType::Jwt);
+    } else {
+      _builder.user(_username).password(_password);
+      _builder.authenticationType(fuerte::AuthenticationType::Basic);
+    }
+
+    for (size_t i = 0; i < _numConnections; ++i) {
+      auto connection = _builder.connect(*_loop);
+
+      // make sure the connection is usable before the benchmark starts
+      auto req = fuerte::createRequest(fuerte::RestVerb::Get, "/_api/version");
+      req->header.database = _databaseName;
+      req->timeout(std::chrono::seconds(30));
+      std::unique_ptr<fuerte::Response> res;
+      try {
+        res = connection->sendRequest(std::move(req));
+      } catch (fuerte::ErrorCondition const& ec) {
+        LOG_TOPIC("8e4c1", FATAL, arangodb::Logger::FIXME)
+            << "could not connect to server: " << fuerte::to_string(ec);
+        FATAL_ERROR_EXIT();
+      }
+      if (res == nullptr || res->statusCode() != fuerte::StatusOK) {
+        LOG_TOPIC("d25a0", FATAL, arangodb::Logger::FIXME)
+            << "could not connect to server";
+        FATAL_ERROR_EXIT();
+      }
+      _connections.emplace_back(std::move(connection));
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the thread program in multiplexed mode. requests are sent
+  /// asynchronously over the fuerte connections, keeping up to _maxInFlight
+  /// of them outstanding. responses are handled on the event loop threads
+  //////////////////////////////////////////////////////////////////////////////
+
+  void runMultiplexed() {
+    while (!isStopping()) {
+      if (_operationsCounter->next(1) == 0) {
+        break;
+      }
+
+      size_t const caseIndex = nextCase();
+      double const scheduled = waitForSendTime();
+
+      {
+        CONDITION_LOCKER(guard, _slotCondition);
+        while (_inFlight >= _maxInFlight) {
+          guard.wait();
+        }
+        ++_inFlight;
+      }
+
+      sendMultiplexedRequest(caseIndex, scheduled);
+    }
+
+    // wait for the outstanding responses, the callbacks reference this object
+    {
+      CONDITION_LOCKER(guard, _slotCondition);
+      while (_inFlight > 0) {
+        guard.wait();
+      }
+    }
+
+    for (auto& connection : _connections) {
+      connection->cancel();
+    }
+    _connections.clear();
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief send a single request asynchronously
+  //////////////////////////////////////////////////////////////////////////////
+
+  void sendMultiplexedRequest(size_t caseIndex, double scheduled) {
+    BenchmarkOperation* operation = _cases[caseIndex].operation;
+    size_t const threadCounter = _counters[caseIndex]++;
+    size_t const globalCounter = _offset + threadCounter;
+    rest::RequestType const type =
+        operation->type(_threadNumber, threadCounter, globalCounter);
+    std::string url = operation->url(_threadNumber, threadCounter, globalCounter);
+    size_t payloadLength = 0;
+    bool mustFree = false;
+    char const* payload = operation->payload(&payloadLength, _threadNumber,
+                                             threadCounter, globalCounter, &mustFree);
+
+    auto req = std::make_unique<fuerte::Request>();
+    req->header.restVerb = toRestVerb(type);
+    req->header.database = _databaseName;
+    req->header.parseArangoPath(url);
+    for (auto const& it : _headers) {
+      req->header.meta.emplace(it.first, it.second);
+    }
+    req->header.contentType(fuerte::ContentType::Json);
+    if (payloadLength > 0) {
+      req->addBinary(reinterpret_cast<uint8_t const*>(payload), payloadLength);
+    }
+    req->timeout(std::chrono::milliseconds(
+        static_cast<int64_t>(_client->requestTimeout() * 1000.0)));
+
+    if (mustFree) {
+      TRI_Free((void*)payload);
+    }
+
+    std::shared_ptr<fuerte::Connection>& connection =
+        _connections[_nextConnection++ % _connections.size()];
+    if (connection->state() == fuerte::Connection::State::Failed) {
+      connection = _builder.connect(*_loop);
+    }
+
+    double const start = TRI_microtime();
+    connection->sendRequest(std::move(req), [this, caseIndex, scheduled, start,
+                                             url = std::move(url)](
+                                                fuerte::Error error,
+                                                std::unique_ptr<fuerte::Request>,
+                                                std::unique_ptr<fuerte::Response> response) {
+      recordRequest(caseIndex, scheduled, start, TRI_microtime());
+
+      if (error != 0 || response == nullptr) {
+        _operationsCounter->incFailures(1);
+        if (++_warningCount < MaxWarnings) {
+          LOG_TOPIC("2ce4a", WARN, arangodb::Logger::FIXME)
+              << "request for URL '" << url << "' failed: "
+              << fuerte::to_string(fuerte::intToError(error));
+        }
+      } else if (response->statusCode() >= 400) {
+        _operationsCounter->incFailures(1);
+        if (++_warningCount < MaxWarnings) {
+          LOG_TOPIC("a7f1b", WARN, arangodb::Logger::FIXME)
+              << "request for URL '" << url << "' failed with HTTP code "
+              << response->statusCode();
+        } else if (_warningCount == MaxWarnings) {
+          LOG_TOPIC("16e3d", WARN, arangodb::Logger::FIXME) << "...more warnings...";
+        }
+      }
+
+      _operationsCounter->done(1);
+
+      CONDITION_LOCKER(guard, _slotCondition);
+      --_inFlight;
+      guard.signal();
+    });
+  }
+
+  static fuerte::RestVerb toRestVerb(rest::RequestType type) {
+    switch (type) {
+      case rest::RequestType::DELETE_REQ:
+        return fuerte::RestVerb::Delete;
+      case rest::RequestType::GET:
+        return fuerte::RestVerb::Get;
+      case rest::RequestType::POST:
+        return fuerte::RestVerb::Post;
+      case rest::RequestType::PUT:
+        return fuerte::RestVerb::Put;
+      case rest::RequestType::HEAD:
+        return fuerte::RestVerb::Head;
+      case rest::RequestType::PATCH:
+        return fuerte::RestVerb::Patch;
+      case rest::RequestType::OPTIONS:
+        return fuerte::RestVerb::Options;
+      default:
+        return fuerte::RestVerb::Illegal;
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief pick the test case for the next request according to the weights
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t nextCase() {
+    if (_cases.size() == 1) {
+      return 0;
+    }
+    uint64_t const value = std::uniform_int_distribution<uint64_t>(0, _totalWeight - 1)(_random);
+    return std::upper_bound(_cumulativeWeights.begin(), _cumulativeWeights.end(), value) -
+           _cumulativeWeights.begin();
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief in open-loop mode, wait until the scheduled send time of the next
+  /// request and return it. the schedule does not depend on how long earlier
+  /// requests took, so a slow response delays the following requests and
+  /// their waiting time is included in their latency (no coordinated
+  /// omission). returns 0 in closed-loop mode
+  //////////////////////////////////////////////////////////////////////////////
+
+  double waitForSendTime() {
+    if (_interval <= 0.0) {
+      return 0.0;
+    }
+    double const scheduled = _nextSendTime;
+    _nextSendTime += _interval;
+
+    double const now = TRI_microtime();
+    if (scheduled > now) {
+      std::this_thread::sleep_for(std::chrono::microseconds(
+          static_cast<int64_t>((scheduled - now) * 1000000.0)));
+    }
+    return scheduled;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief account the duration of a request. the latency is measured from
+  /// the scheduled send time in open-loop mode
+  //////////////////////////////////////////////////////////////////////////////
+
+  void recordRequest(size_t caseIndex, double scheduled, double start, double end) {
+    double const latency = end - (scheduled > 0.0 ? scheduled : start);
+    uint64_t const micros = static_cast<uint64_t>((std::max)(latency, 0.0) * 1000000.0);
+
+    MUTEX_LOCKER(guard, _histogramLock);
+    _time += end - start;
+    _histograms[caseIndex].record(micros);
+    _intervalHistogram.record(micros);
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief execute a batch request with numOperations parts
   //////////////////////////////////////////////////////////////////////////////
 
-  void executeBatchRequest(const unsigned long numOperations) {
+  void executeBatchRequest(size_t caseIndex, const unsigned long numOperations,
+                           double scheduled) {
+    BenchmarkOperation* operation = _cases[caseIndex].operation;
     static char const boundary[] = "XXXarangobench-benchmarkXXX";
     size_t blen = strlen(boundary);
 
@@ -215,15 +484,15 @@ class BenchmarkThread : public arangodb::Thread {
 
       // everything else (i.e. part request header & body) will get into the
       // body
-      size_t const threadCounter = _counter++;
+      size_t const threadCounter = _counters[caseIndex]++;
       size_t const globalCounter = _offset + threadCounter;
-      std::string const url = _operation->url(_threadNumber, threadCounter, globalCounter);
+      std::string const url = operation->url(_threadNumber, threadCounter, globalCounter);
       size_t payloadLength = 0;
       bool mustFree = false;
-      char const* payload = _operation->payload(&payloadLength, _threadNumber,
-                                                threadCounter, globalCounter, &mustFree);
+      char const* payload = operation->payload(&payloadLength, _threadNumber,
+                                               threadCounter, globalCounter, &mustFree);
       const rest::RequestType type =
-          _operation->type(_threadNumber, threadCounter, globalCounter);
+          operation->type(_threadNumber, threadCounter, globalCounter);
       if (url.empty()) {
         LOG_TOPIC("65da1", WARN, arangodb::Logger::FIXME) << "URL is empty!";
       }
@@ -255,7 +524,7 @@ class BenchmarkThread : public arangodb::Thread {
     httpclient::SimpleHttpResult* result =
         _httpClient->request(rest::RequestType::POST, "/_api/batch",
                              batchPayload.c_str(), batchPayload.length(), _headers);
-    _time += TRI_microtime() - start;
+    recordRequest(caseIndex, scheduled, start, TRI_microtime());
 
     if (result == nullptr || !result->isComplete()) {
       if (result != nullptr) {
@@ -322,24 +591,25 @@ class BenchmarkThread : public arangodb::Thread {
   /// @brief execute a single request
   //////////////////////////////////////////////////////////////////////////////
 
-  void executeSingleRequest() {
-    size_t const threadCounter = _counter++;
+  void executeSingleRequest(size_t caseIndex, double scheduled) {
+    BenchmarkOperation* operation = _cases[caseIndex].operation;
+    size_t const threadCounter = _counters[caseIndex]++;
     size_t const globalCounter = _offset + threadCounter;
     rest::RequestType const type =
-        _operation->type(_threadNumber, threadCounter, globalCounter);
-    std::string const url = _operation->url(_threadNumber, threadCounter, globalCounter);
+        operation->type(_threadNumber, threadCounter, globalCounter);
+    std::string const url = operation->url(_threadNumber, threadCounter, globalCounter);
     size_t payloadLength = 0;
     bool mustFree = false;
 
     // std::cout << "thread number #" << _threadNumber << ", threadCounter " <<
     // threadCounter << ", globalCounter " << globalCounter << "\n";
-    char const* payload = _operation->payload(&payloadLength, _threadNumber,
-                                              threadCounter, globalCounter, &mustFree);
+    char const* payload = operation->payload(&payloadLength, _threadNumber,
+                                             threadCounter, globalCounter, &mustFree);
 
     double start = TRI_microtime();
     httpclient::SimpleHttpResult* result =
         _httpClient->request(type, url, payload, payloadLength, _headers);
-    _time += TRI_microtime() - start;
+    recordRequest(caseIndex, scheduled, start, TRI_microtime());
 
     if (mustFree) {
       TRI_Free((void*)payload);
@@ -386,14 +656,47 @@ class BenchmarkThread : public arangodb::Thread {
   /// @brief return the total time accumulated by the thread
   //////////////////////////////////////////////////////////////////////////////
 
-  double getTime() const { return _time; }
+  double getTime() {
+    MUTEX_LOCKER(guard, _histogramLock);
+    return _time;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief add the latencies recorded so far to result, one histogram per
+  /// test case
+  //////////////////////////////////////////////////////////////////////////////
+
+  void mergeHistograms(std::vector<LatencyHistogram>& result) {
+    MUTEX_LOCKER(guard, _histogramLock);
+    TRI_ASSERT(result.size() == _histograms.size());
+    for (size_t i = 0; i < _histograms.size(); ++i) {
+      result[i].merge(_histograms[i]);
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief add the latencies recorded since the last call to result
+  //////////////////////////////////////////////////////////////////////////////
+
+  void takeIntervalHistogram(LatencyHistogram& result) {
+    MUTEX_LOCKER(guard, _histogramLock);
+    result.merge(_intervalHistogram);
+    _intervalHistogram.reset();
+  }
 
  private:
   //////////////////////////////////////////////////////////////////////////////
-  /// @brief the operation to benchmark
+  /// @brief the test cases to benchmark
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<BenchmarkCase> const _cases;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief sum of all test case weights, and the running sums per case
   //////////////////////////////////////////////////////////////////////////////
 
-  arangobench::BenchmarkOperation* _operation;
+  uint64_t _totalWeight;
+  std::vector<uint64_t> _cumulativeWeights;
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief condition variable
@@ -423,7 +726,7 @@ class BenchmarkThread : public arangodb::Thread {
   /// @brief warning counter
   //////////////////////////////////////////////////////////////////////////////
 
-  int _warningCount;
+  std::atomic<int> _warningCount;
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief benchmark counter
@@ -486,10 +789,10 @@ class BenchmarkThread : public arangodb::Thread {
   size_t _offset;
 
   //////////////////////////////////////////////////////////////////////////////
-  /// @brief thread counter value
+  /// @brief thread counter values, one per test case
   //////////////////////////////////////////////////////////////////////////////
 
-  size_t _counter;
+  std::vector<size_t> _counters;
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief time
@@ -497,6 +800,66 @@ class BenchmarkThread : public arangodb::Thread {
 
   double _time;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief time between two requests in open-loop mode, 0 for closed-loop
+  //////////////////////////////////////////////////////////////////////////////
+
+  double const _interval;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief scheduled send time of the next request in open-loop mode
+  //////////////////////////////////////////////////////////////////////////////
+
+  double _nextSendTime;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief random generator for picking test cases
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::mt19937_64 _random;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief protects the histograms, which are read by the main thread
+  //////////////////////////////////////////////////////////////////////////////
+
+  arangodb::Mutex _histogramLock;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief request latencies per test case
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<LatencyHistogram> _histograms;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief request latencies since the last interval report
+  //////////////////////////////////////////////////////////////////////////////
+
+  LatencyHistogram _intervalHistogram;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief event loop for multiplexed mode, nullptr for blocking requests
+  //////////////////////////////////////////////////////////////////////////////
+
+  fuerte::EventLoopService* _loop;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief connections used in multiplexed mode, in round robin order
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t const _numConnections;
+  fuerte::ConnectionBuilder _builder;
+  std::vector<std::shared_ptr<fuerte::Connection>> _connections;
+  size_t _nextConnection;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of outstanding requests in multiplexed mode, protected by
+  /// _slotCondition
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t const _maxInFlight;
+  size_t _inFlight;
+  basics::ConditionVariable _slotCondition;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief lower-case error header we look for
   //////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,138 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_BENCHMARK_LATENCY_HISTOGRAM_H
+#define ARANGODB_BENCHMARK_LATENCY_HISTOGRAM_H 1
+
+#include "Basics/Common.h"
+
+#include <cmath>
+
+namespace arangodb {
+namespace arangobench {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief latency histogram with logarithmic buckets and linear sub-buckets
+///
+/// Values are microseconds. Values below SubBuckets are counted exactly,
+/// above that every power of two range is split into SubBuckets / 2 linear
+/// buckets, so the relative error of a reported percentile is below 1%
+/// independent of the magnitude (the same layout as an HDR histogram).
+/// Recording is O(1) and histograms of different threads or intervals can
+/// be merged by adding up their buckets.
+////////////////////////////////////////////////////////////////////////////////
+
+class LatencyHistogram {
+ public:
+  static constexpr uint64_t SubBuckets = 128;
+
+  /// @brief values above this are counted as this value (about 19 hours)
+  static constexpr uint64_t MaxValue = (uint64_t(1) << 36) - 1;
+
+  LatencyHistogram() : _buckets(bucketIndex(MaxValue) + 1, 0) { reset(); }
+
+  void reset() {
+    std::fill(_buckets.begin(), _buckets.end(), 0);
+    _count = 0;
+    _sum = 0;
+    _min = UINT64_MAX;
+    _max = 0;
+  }
+
+  void record(uint64_t value) {
+    if (value > MaxValue) {
+      value = MaxValue;
+    }
+    ++_buckets[bucketIndex(value)];
+    ++_count;
+    _sum += value;
+    _min = (std::min)(_min, value);
+    _max = (std::max)(_max, value);
+  }
+
+  void merge(LatencyHistogram const& other) {
+    TRI_ASSERT(_buckets.size() == other._buckets.size());
+    for (size_t i = 0; i < _buckets.size(); ++i) {
+      _buckets[i] += other._buckets[i];
+    }
+    _count += other._count;
+    _sum += other._sum;
+    _min = (std::min)(_min, other._min);
+    _max = (std::max)(_max, other._max);
+  }
+
+  uint64_t count() const { return _count; }
+  uint64_t min() const { return _count == 0 ? 0 : _min; }
+  uint64_t max() const { return _max; }
+
+  double mean() const {
+    return _count == 0 ? 0.0 : static_cast<double>(_sum) / static_cast<double>(_count);
+  }
+
+  /// @brief the value below or at which the given percentage (0 - 100) of
+  /// all recorded values lie. returns the highest value of the bucket
+  /// containing the percentile, capped by the largest recorded value
+  uint64_t percentile(double p) const {
+    if (_count == 0) {
+      return 0;
+    }
+    uint64_t target = static_cast<uint64_t>(std::ceil(p / 100.0 * static_cast<double>(_count)));
+    target = (std::max)(target, uint64_t(1));
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < _buckets.size(); ++i) {
+      seen += _buckets[i];
+      if (seen >= target) {
+        return (std::min)(highestValue(i), _max);
+      }
+    }
+    return _max;
+  }
+
+ private:
+  static size_t bucketIndex(uint64_t value) {
+    unsigned shift = 0;
+    while ((value >> shift) >= SubBuckets) {
+      ++shift;
+    }
+    // for shift > 0 the remaining value is in [SubBuckets / 2, SubBuckets)
+    return static_cast<size_t>(shift * (SubBuckets / 2) + (value >> shift));
+  }
+
+  static uint64_t highestValue(size_t index) {
+    if (index < SubBuckets) {
+      return index;
+    }
+    uint64_t const shift = index / (SubBuckets / 2) - 1;
+    uint64_t const sub = index - shift * (SubBuckets / 2);
+    return ((sub + 1) << shift) - 1;
+  }
+
+  std::vector<uint64_t> _buckets;
+  uint64_t _count;
+  uint64_t _sum;
+  uint64_t _min;
+  uint64_t _max;
+};
+
+}  // namespace arangobench
+}  // namespace arangodb
+
+#endif
@@ -34,6 +34,34 @@ static bool CreateDocument(SimpleHttpClient*, std::string const&, std::string co
 static bool CreateIndex(SimpleHttpClient*, std::string const&,
                         std::string const&, std::string const&);
 
+static bool SendRequest(SimpleHttpClient*, rest::RequestType, std::string const&,
+                        std::string const&);
+
+static bool ImportDocuments(SimpleHttpClient*, std::string const&, uint64_t,
+                            std::function<void(uint64_t, std::string&)> const&);
+
+static bool DeleteView(SimpleHttpClient*, std::string const&);
+
+static char const* QueryPayload(std::string const&, std::string const&, size_t*, bool*);
+
+static uint64_t BenchRandom(uint64_t);
+
+static uint64_t PowerLawValue(uint64_t, uint64_t);
+
+static uint64_t ScaledCount(uint64_t);
+
+static std::string TextWord(uint64_t);
+
+static void GeoPoint(uint64_t, double&, double&);
+
+static bool SetUpGraph(SimpleHttpClient*);
+
+static bool SetUpOrders(SimpleHttpClient*);
+
+static bool SetUpTexts(SimpleHttpClient*);
+
+static bool SetUpPlaces(SimpleHttpClient*);
+
 struct VersionTest : public BenchmarkOperation {
   VersionTest() : BenchmarkOperation() { _url = "/_api/version"; }
 
@@ -1512,6 +1540,154 @@ struct AqlV8Test : public BenchmarkOperation {
   }
 };
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief base for test cases that run a single AQL query per request
+///
+/// The data sets of these test cases are generated deterministically in
+/// setUp, their size is 10,000 base documents times --scale-factor. Every
+/// data set uses its own collections (prefixed with --collection), so the
+/// test cases can be combined in a --test-case-mix.
+////////////////////////////////////////////////////////////////////////////////
+
+struct AqlQueryTest : public BenchmarkOperation {
+  AqlQueryTest() : BenchmarkOperation() {}
+
+  void tearDown() override {}
+
+  std::string url(int const threadNumber, size_t const threadCounter,
+                  size_t const globalCounter) override {
+    return std::string("/_api/cursor");
+  }
+
+  rest::RequestType type(int const threadNumber, size_t const threadCounter,
+                         size_t const globalCounter) override {
+    return rest::RequestType::POST;
+  }
+};
+
+struct TraversalTest : public AqlQueryTest {
+  bool setUp(SimpleHttpClient* client) override { return SetUpGraph(client); }
+
+  char const* payload(size_t* length, int const threadNumber, size_t const threadCounter,
+                      size_t const globalCounter, bool* mustFree) override {
+    std::string const& c = ARANGOBENCH->collection();
+    uint64_t const start = BenchRandom(globalCounter) % ScaledCount(10000);
+
+    return QueryPayload(
+        "FOR v IN 1..3 OUTBOUND @start @@edges OPTIONS { bfs: true, "
+        "uniqueVertices: 'global' } LIMIT 1000 RETURN v._key",
+        "\"start\":\"" + c + "Vertices/v" + std::to_string(start) +
+            "\",\"@edges\":\"" + c + "Edges\"",
+        length, mustFree);
+  }
+};
+
+struct ShortestPathTest : public AqlQueryTest {
+  bool setUp(SimpleHttpClient* client) override { return SetUpGraph(client); }
+
+  char const* payload(size_t* length, int const threadNumber, size_t const threadCounter,
+                      size_t const globalCounter, bool* mustFree) override {
+    std::string const& c = ARANGOBENCH->collection();
+    uint64_t const n = ScaledCount(10000);
+    uint64_t const from = BenchRandom(2 * globalCounter) % n;
+    uint64_t const to = BenchRandom(2 * globalCounter + 1) % n;
+
+    return QueryPayload("FOR v IN ANY SHORTEST_PATH @from TO @to @@edges RETURN v._key",
+                        "\"from\":\"" + c + "Vertices/v" + std::to_string(from) +
+                            "\",\"to\":\"" + c + "Vertices/v" + std::to_string(to) +
+                            "\",\"@edges\":\"" + c + "Edges\"",
+                        length, mustFree);
+  }
+};
+
+struct JoinTest : public AqlQueryTest {
+  bool setUp(SimpleHttpClient* client) override { return SetUpOrders(client); }
+
+  char const* payload(size_t* length, int const threadNumber, size_t const threadCounter,
+                      size_t const globalCounter, bool* mustFree) override {
+    std::string const& c = ARANGOBENCH->collection();
+    uint64_t const group = BenchRandom(globalCounter) % (ScaledCount(10000) / 10);
+
+    return QueryPayload(
+        "FOR u IN @@users FILTER u.group == @group FOR o IN @@orders FILTER "
+        "o.user == u._key RETURN { user: u.name, amount: o.amount }",
+        "\"group\":" + std::to_string(group) + ",\"@users\":\"" + c +
+            "Users\",\"@orders\":\"" + c + "Orders\"",
+        length, mustFree);
+  }
+};
+
+struct CollectTest : public AqlQueryTest {
+  bool setUp(SimpleHttpClient* client) override { return SetUpOrders(client); }
+
+  char const* payload(size_t* length, int const threadNumber, size_t const threadCounter,
+                      size_t const globalCounter, bool* mustFree) override {
+    std::string const orders = "\"@orders\":\"" + ARANGOBENCH->collection() + "Orders\"";
+
+    if (globalCounter % 2 == 0) {
+      return QueryPayload(
+          "FOR o IN @@orders FILTER o.amount >= @min COLLECT status = o.status "
+          "AGGREGATE count = COUNT(1), total = SUM(o.amount), maxAmount = "
+          "MAX(o.amount) RETURN { status, count, total, maxAmount }",
+          "\"min\":" + std::to_string(BenchRandom(globalCounter) % 1000) + "," + orders,
+          length, mustFree);
+    }
+    return QueryPayload(
+        "FOR o IN @@orders COLLECT user = o.user WITH COUNT INTO n SORT n DESC "
+        "LIMIT 10 RETURN { user, n }",
+        orders, length, mustFree);
+  }
+};
+
+struct SearchTest : public AqlQueryTest {
+  bool setUp(SimpleHttpClient* client) override { return SetUpTexts(client); }
+
+  char const* payload(size_t* length, int const threadNumber, size_t const threadCounter,
+                      size_t const globalCounter, bool* mustFree) override {
+    std::string const view = ARANGOBENCH->collection() + "View";
+
+    if (globalCounter % 2 == 0) {
+      return QueryPayload("FOR d IN " + view +
+                              " SEARCH ANALYZER(PHRASE(d.text, @word), 'text_en') "
+                              "SORT BM25(d) DESC LIMIT 10 RETURN d._key",
+                          "\"word\":\"" + TextWord(globalCounter) + "\"", length, mustFree);
+    }
+    return QueryPayload(
+        "FOR d IN " + view +
+            " SEARCH ANALYZER(d.text IN TOKENS(@words, 'text_en'), 'text_en') "
+            "SORT TFIDF(d) DESC LIMIT 10 RETURN d._key",
+        "\"words\":\"" + TextWord(2 * globalCounter) + " " +
+            TextWord(2 * globalCounter + 1) + "\"",
+        length, mustFree);
+  }
+};
+
+struct GeoTest : public AqlQueryTest {
+  bool setUp(SimpleHttpClient* client) override { return SetUpPlaces(client); }
+
+  char const* payload(size_t* length, int const threadNumber, size_t const threadCounter,
+                      size_t const globalCounter, bool* mustFree) override {
+    double lat;
+    double lon;
+    GeoPoint(globalCounter, lat, lon);
+    std::string const bindVars = "\"lat\":" + StringUtils::ftoa(lat) +
+                                 ",\"lon\":" + StringUtils::ftoa(lon) +
+                                 ",\"@places\":\"" + ARANGOBENCH->collection() +
+                                 "Places\"";
+
+    if (globalCounter % 2 == 0) {
+      return QueryPayload(
+          "FOR p IN @@places FILTER DISTANCE(p.lat, p.lon, @lat, @lon) <= 5000 "
+          "RETURN p._key",
+          bindVars, length, mustFree);
+    }
+    return QueryPayload(
+        "FOR p IN @@places SORT DISTANCE(p.lat, p.lon, @lat, @lon) LIMIT 10 "
+        "RETURN p._key",
+        bindVars, length, mustFree);
+  }
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief delete a collection
 ////////////////////////////////////////////////////////////////////////////////
@@ -1623,6 +1799,284 @@ static bool CreateDocument(SimpleHttpClient* client, std::string const& collecti
   return !failed;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief send a request during test setup, returns true on success
+////////////////////////////////////////////////////////////////////////////////
+
+static bool SendRequest(SimpleHttpClient* client, rest::RequestType type,
+                        std::string const& url, std::string const& payload) {
+  std::unordered_map<std::string, std::string> headerFields;
+  SimpleHttpResult* result =
+      client->request(type, url, payload.c_str(), payload.size(), headerFields);
+
+  bool failed = true;
+
+  if (result != nullptr) {
+    if (result->isComplete() && !result->wasHttpError()) {
+      failed = false;
+    }
+
+    delete result;
+  }
+
+  return !failed;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief import count generated documents into a collection
+////////////////////////////////////////////////////////////////////////////////
+
+static bool ImportDocuments(SimpleHttpClient* client, std::string const& collection,
+                            uint64_t count,
+                            std::function<void(uint64_t, std::string&)> const& generate) {
+  std::string const url =
+      "/_api/import?type=documents&complete=true&collection=" + collection;
+  std::string body;
+
+  for (uint64_t i = 0; i < count; ++i) {
+    generate(i, body);
+    body.push_back('\n');
+
+    if ((i + 1) % 10000 == 0 || i + 1 == count) {
+      if (!SendRequest(client, rest::RequestType::POST, url, body)) {
+        return false;
+      }
+      body.clear();
+    }
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief delete an ArangoSearch view
+////////////////////////////////////////////////////////////////////////////////
+
+static bool DeleteView(SimpleHttpClient* client, std::string const& name) {
+  std::unordered_map<std::string, std::string> headerFields;
+  SimpleHttpResult* result = nullptr;
+
+  result = client->request(rest::RequestType::DELETE_REQ, "/_api/view/" + name,
+                           "", 0, headerFields);
+
+  bool failed = true;
+  if (result != nullptr) {
+    int statusCode = result->getHttpReturnCode();
+    if (statusCode == 200 || statusCode == 202 || statusCode == 404) {
+      failed = false;
+    }
+
+    delete result;
+  }
+
+  return !failed;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build the body of a cursor request. bindVars are the members of
+/// the bind parameter object, already JSON-encoded
+////////////////////////////////////////////////////////////////////////////////
+
+static char const* QueryPayload(std::string const& query, std::string const& bindVars,
+                                size_t* length, bool* mustFree) {
+  TRI_string_buffer_t* buffer =
+      TRI_CreateSizedStringBuffer(64 + query.size() + bindVars.size());
+
+  TRI_AppendStringStringBuffer(buffer, "{\"query\":");
+  TRI_AppendJsonEncodedStringStringBuffer(buffer, query.c_str(), query.size(), false);
+  TRI_AppendStringStringBuffer(buffer, ",\"bindVars\":{");
+  TRI_AppendString2StringBuffer(buffer, bindVars.c_str(), bindVars.size());
+  TRI_AppendStringStringBuffer(buffer, "}}");
+
+  *length = TRI_LengthStringBuffer(buffer);
+  *mustFree = true;
+  char* ptr = TRI_StealStringBuffer(buffer);
+  TRI_FreeStringBuffer(buffer);
+
+  return (char const*)ptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief deterministic pseudo-random number for a seed (splitmix64), so the
+/// generated data and queries are the same in every run and release
+////////////////////////////////////////////////////////////////////////////////
+
+static uint64_t BenchRandom(uint64_t seed) {
+  uint64_t z = seed + 0x9e3779b97f4a7c15ULL;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief value in [0, n) with a power-law distribution: small values are
+/// much more likely than large ones (density proportional to x^(-2/3))
+////////////////////////////////////////////////////////////////////////////////
+
+static uint64_t PowerLawValue(uint64_t seed, uint64_t n) {
+  if (n <= 1) {
+    return 0;
+  }
+  double const u = static_cast<double>(BenchRandom(seed) >> 11) / 9007199254740992.0;
+  return (std::min)(static_cast<uint64_t>(u * u * u * static_cast<double>(n)), n - 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of documents of a generated data set
+////////////////////////////////////////////////////////////////////////////////
+
+static uint64_t ScaledCount(uint64_t base) {
+  return base * (std::max)(ARANGOBENCH->scaleFactor(), uint64_t(1));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief word of the synthetic text corpus. the 4096 words are built from
+/// syllables and used with power-law frequencies, like in natural language
+////////////////////////////////////////////////////////////////////////////////
+
+static std::string TextWord(uint64_t seed) {
+  static char const* syllables[] = {"ka", "lo", "mi", "ne", "ru", "sa",
+                                    "ti", "vo", "be", "da", "fe", "go",
+                                    "hu", "ji", "pe", "zo"};
+  uint64_t index = PowerLawValue(seed, 4096);
+  std::string word;
+  for (int i = 0; i < 3; ++i) {
+    word.append(syllables[index % 16]);
+    index /= 16;
+  }
+  return word;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief generated location. points are clustered around 20 cities of
+/// power-law distributed size, each spread over about one degree
+////////////////////////////////////////////////////////////////////////////////
+
+static void GeoPoint(uint64_t seed, double& lat, double& lon) {
+  uint64_t const city = PowerLawValue(seed, 20);
+  uint64_t const r = BenchRandom(seed + 1);
+
+  lat = -60.0 + static_cast<double>(BenchRandom(city) % 12000) / 100.0 +
+        static_cast<double>(r & 0xffff) / 65536.0 - 0.5;
+  lon = -179.0 + static_cast<double>(BenchRandom(city + 100) % 35800) / 100.0 +
+        static_cast<double>((r >> 16) & 0xffff) / 65536.0 - 0.5;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief generate the graph data set: every vertex links to 4 older
+/// vertices, picked with a power-law distribution, so the oldest vertices
+/// become hubs with a very high in-degree
+////////////////////////////////////////////////////////////////////////////////
+
+static bool SetUpGraph(SimpleHttpClient* client) {
+  std::string const vertices = ARANGOBENCH->collection() + "Vertices";
+  std::string const edges = ARANGOBENCH->collection() + "Edges";
+  uint64_t const n = ScaledCount(10000);
+
+  return DeleteCollection(client, vertices) && DeleteCollection(client, edges) &&
+         CreateCollection(client, vertices, 2) && CreateCollection(client, edges, 3) &&
+         ImportDocuments(client, vertices, n,
+                         [](uint64_t i, std::string& out) {
+                           out += "{\"_key\":\"v" + std::to_string(i) +
+                                  "\",\"value\":" + std::to_string(i) + "}";
+                         }) &&
+         ImportDocuments(client, edges, (n - 1) * 4, [&vertices](uint64_t i, std::string& out) {
+           uint64_t const from = i / 4 + 1;
+           uint64_t const to = PowerLawValue(i, from);
+           out += "{\"_from\":\"" + vertices + "/v" + std::to_string(from) +
+                  "\",\"_to\":\"" + vertices + "/v" + std::to_string(to) +
+                  "\",\"weight\":" + std::to_string(i % 4) + "}";
+         });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief generate the users and orders data set. group sizes and the
+/// number of orders per user follow a power-law distribution
+////////////////////////////////////////////////////////////////////////////////
+
+static bool SetUpOrders(SimpleHttpClient* client) {
+  static char const* statuses[] = {"new", "paid", "shipped", "returned"};
+
+  std::string const users = ARANGOBENCH->collection() + "Users";
+  std::string const orders = ARANGOBENCH->collection() + "Orders";
+  uint64_t const n = ScaledCount(10000);
+
+  return DeleteCollection(client, users) && DeleteCollection(client, orders) &&
+         CreateCollection(client, users, 2) && CreateCollection(client, orders, 2) &&
+         ImportDocuments(client, users, n,
+                         [n](uint64_t i, std::string& out) {
+                           out += "{\"_key\":\"u" + std::to_string(i) + "\",\"name\":\"user" +
+                                  std::to_string(i) + "\",\"group\":" +
+                                  std::to_string(PowerLawValue(i, n / 10)) + ",\"age\":" +
+                                  std::to_string(18 + BenchRandom(i) % 60) + "}";
+                         }) &&
+         ImportDocuments(client, orders, n * 10,
+                         [n](uint64_t i, std::string& out) {
+                           out += "{\"user\":\"u" + std::to_string(PowerLawValue(i, n)) +
+                                  "\",\"amount\":" + std::to_string(BenchRandom(i) % 1000) +
+                                  ",\"status\":\"" + statuses[PowerLawValue(i + 1, 4)] + "\"}";
+                         }) &&
+         CreateIndex(client, users, "hash", "[\"group\"]") &&
+         CreateIndex(client, orders, "hash", "[\"user\"]");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief generate the text corpus and an ArangoSearch view on it
+////////////////////////////////////////////////////////////////////////////////
+
+static bool SetUpTexts(SimpleHttpClient* client) {
+  std::string const texts = ARANGOBENCH->collection() + "Texts";
+  std::string const view = ARANGOBENCH->collection() + "View";
+  uint64_t const n = ScaledCount(10000);
+
+  std::string const viewDefinition =
+      "{\"name\":\"" + view + "\",\"type\":\"arangosearch\",\"links\":{\"" +
+      texts + "\":{\"fields\":{\"text\":{\"analyzers\":[\"text_en\"]}}}}}";
+
+  // wait until the view has picked up all documents
+  std::string const sync =
+      "{\"query\":\"FOR d IN " + view +
+      " SEARCH true OPTIONS { waitForSync: true } LIMIT 1 RETURN d._key\"}";
+
+  return DeleteView(client, view) && DeleteCollection(client, texts) &&
+         CreateCollection(client, texts, 2) &&
+         ImportDocuments(client, texts, n,
+                         [](uint64_t i, std::string& out) {
+                           out += "{\"_key\":\"t" + std::to_string(i) + "\",\"text\":\"";
+                           for (uint64_t w = 0; w < 20; ++w) {
+                             if (w > 0) {
+                               out.push_back(' ');
+                             }
+                             out += TextWord(i * 20 + w);
+                           }
+                           out += "\"}";
+                         }) &&
+         SendRequest(client, rest::RequestType::POST, "/_api/view", viewDefinition) &&
+         SendRequest(client, rest::RequestType::POST, "/_api/cursor", sync);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief generate the places data set with a geo index
+////////////////////////////////////////////////////////////////////////////////
+
+static bool SetUpPlaces(SimpleHttpClient* client) {
+  std::string const places = ARANGOBENCH->collection() + "Places";
+  uint64_t const n = ScaledCount(10000);
+
+  return DeleteCollection(client, places) && CreateCollection(client, places, 2) &&
+         ImportDocuments(client, places, n,
+                         [](uint64_t i, std::string& out) {
+                           double lat;
+                           double lon;
+                           // use other seeds than the queries
+                           GeoPoint(i + (uint64_t(1) << 32), lat, lon);
+                           out += "{\"_key\":\"p" + std::to_string(i) +
+                                  "\",\"lat\":" + StringUtils::ftoa(lat) +
+                                  ",\"lon\":" + StringUtils::ftoa(lon) + "}";
+                         }) &&
+         CreateIndex(client, places, "geo", "[\"lat\",\"lon\"]");
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief return the test case for a name
 ////////////////////////////////////////////////////////////////////////////////
@@ -1691,6 +2145,24 @@ static BenchmarkOperation* GetTestCase(std::string const& name) {
   if (name == "stream-cursor") {
     return new StreamCursorTest();
   }
+  if (name == "traversal") {
+    return new TraversalTest();
+  }
+  if (name == "shortest-path") {
+    return new ShortestPathTest();
+  }
+  if (name == "join") {
+    return new JoinTest();
+  }
+  if (name == "collect") {
+    return new CollectTest();
+  }
+  if (name == "search") {
+    return new SearchTest();
+  }
+  if (name == "geo") {
+    return new GeoTest();
+  }
 
   return nullptr;
 }
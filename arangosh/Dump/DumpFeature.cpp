@@ -29,6 +29,7 @@
 #include <velocypack/Builder.h>
 #include <velocypack/Collection.h>
 #include <velocypack/Iterator.h>
+#include <velocypack/Parser.h>
 #include <velocypack/velocypack-aliases.h>
 #include <boost/algorithm/clamp.hpp>
 
@@ -46,6 +47,7 @@
 #include "SimpleHttpClient/SimpleHttpClient.h"
 #include "SimpleHttpClient/SimpleHttpResult.h"
 #include "Ssl/SslInterface.h"
+#include "Utils/DumpChunkFile.h"
 #include "Utils/ManagedDirectory.h"
 
 #ifdef USE_ENTERPRISE
@@ -68,6 +70,12 @@ constexpr uint64_t MinChunkSize = 1024 * 128;
 // NB: larger value may cause tcp issues (check exact limits)
 constexpr uint64_t MaxChunkSize = 1024 * 1024 * 96;
 
+/// @brief WAL marker types handled by incremental dumps
+constexpr int MarkerTransactionCommit = 2201;
+constexpr int MarkerTransactionAbort = 2202;
+constexpr int MarkerDocument = 2300;
+constexpr int MarkerRemove = 2302;
+
 /// @brief generic error for if server returns bad/unexpected json
 const arangodb::Result ErrorMalformedJsonResponse = {
     TRI_ERROR_INTERNAL, "got malformed JSON response from server"};
@@ -251,6 +259,93 @@ void flushWal(arangodb::httpclient::SimpleHttpClient& client) {
   }
 }
 
+/// @brief whether the server can dump key ranges of a collection separately
+/// and return dump data as VelocyPack
+bool supportsPartitionedDump(arangodb::httpclient::SimpleHttpClient& client) {
+  std::unique_ptr<arangodb::httpclient::SimpleHttpResult> response(
+      client.request(arangodb::rest::RequestType::GET, "/_api/engine", nullptr, 0));
+  if (::checkHttpResponse(client, response).fail()) {
+    return false;
+  }
+  try {
+    std::shared_ptr<VPackBuilder> parsedBody = response->getBodyVelocyPack();
+    return arangodb::basics::VelocyPackHelper::getStringValue(parsedBody->slice(), "name",
+                                                              "") == "rocksdb";
+  } catch (...) {
+    return false;
+  }
+}
+
+/// @brief writes the document changes of an incremental dump into one
+/// change log file per collection
+class ChangeLogWriter {
+ public:
+  ChangeLogWriter(arangodb::ManagedDirectory& directory, arangodb::DumpFeature::Stats& stats)
+      : _directory(directory), _stats(stats) {}
+
+  /// @brief append a document or removal marker to the collection's log
+  arangodb::Result write(std::string const& name, std::string const& type,
+                         VPackSlice marker) {
+    auto it = _logs.find(name);
+    if (it == _logs.end()) {
+      std::string const hexString(arangodb::rest::SslInterface::sslMD5(name));
+      Log log;
+      log.filename = name + "_" + hexString + ".changes.json";
+      log.type = type;
+      log.file = _directory.writableFile(log.filename, true);
+      if (!::fileOk(log.file.get())) {
+        return ::fileError(log.file.get(), true);
+      }
+      it = _logs.emplace(name, std::move(log)).first;
+    }
+
+    // restore-data only needs the operation type and the document
+    _builder.clear();
+    _builder.openObject();
+    _builder.add("type", marker.get("type"));
+    _builder.add("data", marker.get("data"));
+    _builder.close();
+    std::string line = _builder.slice().toJson();
+    line.push_back('\n');
+
+    Log& log = it->second;
+    log.file->write(line.data(), line.size());
+    if (log.file->status().fail()) {
+      return log.file->status();
+    }
+    ++log.count;
+    _stats.totalWritten += line.size();
+    return {};
+  }
+
+  /// @brief describe the written change logs, for dump.json
+  void toVelocyPack(VPackBuilder& builder) const {
+    builder.openArray();
+    for (auto const& it : _logs) {
+      builder.openObject();
+      builder.add("collection", VPackValue(it.first));
+      builder.add("type", VPackValue(it.second.type));
+      builder.add("file", VPackValue(it.second.filename));
+      builder.add("count", VPackValue(it.second.count));
+      builder.close();
+    }
+    builder.close();
+  }
+
+ private:
+  struct Log {
+    std::unique_ptr<arangodb::ManagedDirectory::File> file;
+    std::string filename;
+    std::string type;
+    uint64_t count = 0;
+  };
+
+  arangodb::ManagedDirectory& _directory;
+  arangodb::DumpFeature::Stats& _stats;
+  std::map<std::string, Log> _logs;
+  VPackBuilder _builder;
+};
+
 bool isIgnoredHiddenEnterpriseCollection(arangodb::DumpFeature::Options const& options,
                                          std::string const& name) {
 #ifdef USE_ENTERPRISE
@@ -294,10 +389,13 @@ arangodb::Result dumpJsonObjects(arangodb::DumpFeature::JobData& jobData,
   return {TRI_ERROR_NO_ERROR};
 }
 
-/// @brief dump the actual data from an individual collection
+/// @brief dump the actual data from an individual collection. if a chunk
+/// writer is given, the data is fetched as VelocyPack and written as
+/// compressed chunks, otherwise it is written as JSON lines
 arangodb::Result dumpCollection(arangodb::httpclient::SimpleHttpClient& client,
                                 arangodb::DumpFeature::JobData& jobData,
                                 arangodb::ManagedDirectory::File& file,
+                                arangodb::dumpchunks::Writer* writer,
                                 std::string const& name, std::string const& server,
                                 uint64_t batchId, uint64_t minTick, uint64_t maxTick) {
   using arangodb::basics::StringUtils::boolean;
@@ -316,6 +414,11 @@ arangodb::Result dumpCollection(arangodb::httpclient::SimpleHttpClient& client,
     // we are in single-server mode, we already flushed the wal
     baseUrl += "&flush=false";
   }
+  if (jobData.numPartitions > 1) {
+    // only fetch our key range of the collection
+    baseUrl += "&partition=" + itoa(jobData.partition) +
+               "&partitions=" + itoa(jobData.numPartitions);
+  }
 
   while (true) {
     std::string url = baseUrl + "&from=" + itoa(fromTick) + "&chunkSize=" + itoa(chunkSize);
@@ -326,8 +429,12 @@ arangodb::Result dumpCollection(arangodb::httpclient::SimpleHttpClient& client,
     ++(jobData.stats.totalBatches);  // count how many chunks we are fetching
 
     // make the actual request for data
+    std::unordered_map<std::string, std::string> headers;
+    if (writer != nullptr) {
+      headers.emplace(arangodb::StaticStrings::Accept, arangodb::StaticStrings::MimeTypeVPack);
+    }
     std::unique_ptr<arangodb::httpclient::SimpleHttpResult> response(
-        client.request(arangodb::rest::RequestType::GET, url, nullptr, 0));
+        client.request(arangodb::rest::RequestType::GET, url, nullptr, 0, headers));
     auto check = ::checkHttpResponse(client, response);
     if (check.fail()) {
       LOG_TOPIC("ac972", ERR, arangodb::Logger::DUMP)
@@ -369,7 +476,14 @@ arangodb::Result dumpCollection(arangodb::httpclient::SimpleHttpClient& client,
 
     // now actually write retrieved data to dump file
     arangodb::basics::StringBuffer const& body = response->getBody();
-    arangodb::Result result = dumpJsonObjects(jobData, file, body);
+    arangodb::Result result;
+    if (writer != nullptr) {
+      uint64_t const before = writer->bytesWritten();
+      result = writer->write(body.c_str(), body.length());
+      jobData.stats.totalWritten += writer->bytesWritten() - before;
+    } else {
+      result = dumpJsonObjects(jobData, file, body);
+    }
 
     if (result.fail()) {
       return result;
@@ -397,15 +511,50 @@ arangodb::Result dumpCollection(arangodb::httpclient::SimpleHttpClient& client,
 /// @brief processes a single collection dumping job in single-server mode
 arangodb::Result handleCollection(arangodb::httpclient::SimpleHttpClient& client,
                                   arangodb::DumpFeature::JobData& jobData,
-                                  arangodb::ManagedDirectory::File& file) {
+                                  arangodb::ManagedDirectory::File& file,
+                                  arangodb::dumpchunks::Writer* writer) {
   // keep the batch alive
   ::extendBatch(client, "", jobData.batchId);
 
   // do the hard work in another function...
-  return ::dumpCollection(client, jobData, file, jobData.name, "", jobData.batchId,
+  return ::dumpCollection(client, jobData, file, writer, jobData.name, "", jobData.batchId,
                           jobData.options.tickStart, jobData.options.tickEnd);
 }
 
+/// @brief create the data file <baseName>.data.json or <baseName>.data.vpack
+/// and dump the collection data into it in single-server mode
+arangodb::Result dumpDataFile(arangodb::httpclient::SimpleHttpClient& client,
+                              arangodb::DumpFeature::JobData& jobData,
+                              std::string const& baseName, bool dumpData) {
+  if (!jobData.options.binaryOutput) {
+    auto file = jobData.directory.writableFile(baseName + ".data.json", true);
+    if (!::fileOk(file.get())) {
+      return ::fileError(file.get(), true);
+    }
+    if (!dumpData) {
+      return {TRI_ERROR_NO_ERROR};
+    }
+    return ::handleCollection(client, jobData, *file, nullptr);
+  }
+
+  // the chunks are compressed already, so never gzip the file
+  auto file = jobData.directory.writableFile(
+      baseName + arangodb::dumpchunks::DataFileSuffix, true, 0, false);
+  if (!::fileOk(file.get())) {
+    return ::fileError(file.get(), true);
+  }
+  arangodb::dumpchunks::Writer writer(*file);
+  if (dumpData) {
+    arangodb::Result result = ::handleCollection(client, jobData, *file, &writer);
+    if (result.fail()) {
+      return result;
+    }
+  }
+  jobData.directory.spitFile(baseName + arangodb::dumpchunks::IndexFileSuffix,
+                             writer.index().slice().toJson());
+  return jobData.directory.status();
+}
+
 /// @brief handle a single collection dumping job in cluster mode
 arangodb::Result handleCollectionCluster(arangodb::httpclient::SimpleHttpClient& client,
                                          arangodb::DumpFeature::JobData& jobData,
@@ -440,7 +589,7 @@ arangodb::Result handleCollectionCluster(arangodb::httpclient::SimpleHttpClient&
     std::tie(result, batchId) = ::startBatch(client, DBserver);
     if (result.ok()) {
       // do the hard work elsewhere
-      result = ::dumpCollection(client, jobData, file, shardName, DBserver,
+      result = ::dumpCollection(client, jobData, file, nullptr, shardName, DBserver,
                                 batchId, 0, UINT64_MAX);
       ::endBatch(client, DBserver, batchId);
     }
@@ -454,11 +603,35 @@ arangodb::Result handleCollectionCluster(arangodb::httpclient::SimpleHttpClient&
   return result;
 }
 
+/// @brief dump an additional key range of a collection into its own data
+/// file. the structure and the first key range are handled by the job for
+/// partition 0
+arangodb::Result processPartitionJob(arangodb::httpclient::SimpleHttpClient& client,
+                                     arangodb::DumpFeature::JobData& jobData) {
+  TRI_ASSERT(jobData.partition > 0 && !jobData.options.clusterMode);
+
+  if (jobData.maskings != nullptr &&
+      (!jobData.maskings->shouldDumpStructure(jobData.name) ||
+       !jobData.maskings->shouldDumpData(jobData.name))) {
+    return {TRI_ERROR_NO_ERROR};
+  }
+
+  std::string const hexString(arangodb::rest::SslInterface::sslMD5(jobData.name));
+  return ::dumpDataFile(client, jobData,
+                        jobData.name + "_" + hexString + "." +
+                            std::to_string(jobData.partition),
+                        true);
+}
+
 /// @brief process a single job from the queue
 arangodb::Result processJob(arangodb::httpclient::SimpleHttpClient& client,
                             arangodb::DumpFeature::JobData& jobData) {
   using arangodb::velocypack::ObjectBuilder;
 
+  if (jobData.partition > 0) {
+    return ::processPartitionJob(client, jobData);
+  }
+
   arangodb::Result result{TRI_ERROR_NO_ERROR};
 
   bool dumpStructure = true;
@@ -525,21 +698,22 @@ arangodb::Result processJob(arangodb::httpclient::SimpleHttpClient& client,
       dumpData = jobData.maskings->shouldDumpData(jobData.name);
     }
 
-    // always create the file so that arangorestore does not complain
-    auto file = jobData.directory.writableFile(jobData.name + "_" + hexString +
-                                                   ".data.json",
-                                               true);
-    if (!::fileOk(file.get())) {
-      return ::fileError(file.get(), true);
-    }
+    if (jobData.options.clusterMode) {
+      // always create the file so that arangorestore does not complain
+      auto file = jobData.directory.writableFile(jobData.name + "_" + hexString +
+                                                     ".data.json",
+                                                 true);
+      if (!::fileOk(file.get())) {
+        return ::fileError(file.get(), true);
+      }
 
-    if (dumpData) {
-      // save the actual data
-      if (jobData.options.clusterMode) {
+      if (dumpData) {
+        // save the actual data
         result = ::handleCollectionCluster(client, jobData, *file);
-      } else {
-        result = ::handleCollection(client, jobData, *file);
       }
+    } else {
+      // always creates the file so that arangorestore does not complain
+      result = ::dumpDataFile(client, jobData, jobData.name + "_" + hexString, dumpData);
     }
   }
 
@@ -562,8 +736,9 @@ DumpFeature::JobData::JobData(ManagedDirectory& dir, DumpFeature& feat,
                               Options const& opts, maskings::Maskings* maskings,
                               Stats& stat, VPackSlice const& info,
                               uint64_t const batch, std::string const& c,
-                              std::string const& n, std::string const& t)
-    : directory{dir}, feature{feat}, options{opts}, maskings{maskings}, stats{stat}, collectionInfo{info}, batchId{batch}, cid{c}, name{n}, type{t} {}
+                              std::string const& n, std::string const& t,
+                              uint64_t partition, uint64_t numPartitions)
+    : directory{dir}, feature{feat}, options{opts}, maskings{maskings}, stats{stat}, collectionInfo{info}, batchId{batch}, cid{c}, name{n}, type{t}, partition{partition}, numPartitions{numPartitions} {}
 
 DumpFeature::DumpFeature(application_features::ApplicationServer& server, int& exitCode)
     : ApplicationFeature(server, DumpFeature::featureName()),
@@ -606,9 +781,21 @@ void DumpFeature::collectOptions(std::shared_ptr<options::ProgramOptions> option
       "maximum number of collections to process in parallel. From v3.4.0",
       new UInt32Parameter(&_options.threadCount));
 
+  options->addOption(
+      "--partitions",
+      "number of key ranges each collection's data is split into. The ranges "
+      "are dumped in parallel into separate files (RocksDB single server only)",
+      new UInt32Parameter(&_options.partitions));
+
   options->addOption("--dump-data", "dump collection data",
                      new BooleanParameter(&_options.dumpData));
 
+  options->addOption(
+      "--binary-output",
+      "write collection data as compressed VelocyPack chunks instead of JSON "
+      "(RocksDB single server only, not combinable with maskings)",
+      new BooleanParameter(&_options.binaryOutput));
+
   options->addOption(
       "--all-databases", "dump data of all databases",
       new BooleanParameter(&_options.allDatabases))
@@ -642,6 +829,12 @@ void DumpFeature::collectOptions(std::shared_ptr<options::ProgramOptions> option
   options->addOption("--tick-end", "last tick to be included in data dump",
                      new UInt64Parameter(&_options.tickEnd));
 
+  options->addOption(
+      "--incremental-from",
+      "directory of a previous dump. only the document changes since that "
+      "dump are written, as change logs (single server only)",
+      new StringParameter(&_options.incrementalFrom));
+
   options
       ->addOption("--maskings", "file with maskings definition",
                   new StringParameter(&_options.maskingsFile))
@@ -701,6 +894,24 @@ void DumpFeature::validateOptions(std::shared_ptr<options::ProgramOptions> optio
     LOG_TOPIC("0460e", WARN, Logger::DUMP) << "capping --threads value to " << clamped;
     _options.threadCount = clamped;
   }
+
+  if (!_options.incrementalFrom.empty() && !_options.maskingsFile.empty()) {
+    LOG_TOPIC("e03f2", FATAL, arangodb::Logger::DUMP)
+        << "cannot use --incremental-from and --maskings at the same time";
+    FATAL_ERROR_EXIT();
+  }
+
+  if (_options.binaryOutput && !_options.maskingsFile.empty()) {
+    LOG_TOPIC("7b2f4", WARN, Logger::DUMP)
+        << "maskings require JSON output, ignoring --binary-output";
+    _options.binaryOutput = false;
+  }
+
+  clamped = boost::algorithm::clamp(_options.partitions, 1, 64);
+  if (_options.partitions != clamped) {
+    LOG_TOPIC("c9f0e", WARN, Logger::DUMP) << "capping --partitions value to " << clamped;
+    _options.partitions = clamped;
+  }
 }
 
 // dump data from server
@@ -777,6 +988,22 @@ Result DumpFeature::runDump(httpclient::SimpleHttpClient& client, std::string co
     restrictList.insert(std::pair<std::string, bool>(_options.collections[i], true));
   }
 
+  // splitting collections into key ranges and binary output require
+  // server support
+  uint64_t numPartitions = _options.dumpData ? _options.partitions : 1;
+  if ((numPartitions > 1 || _options.binaryOutput) && !::supportsPartitionedDump(client)) {
+    if (numPartitions > 1) {
+      LOG_TOPIC("0a7e1", WARN, arangodb::Logger::DUMP)
+          << "server does not support partitioned dumps, ignoring --partitions";
+      numPartitions = 1;
+    }
+    if (_options.binaryOutput) {
+      LOG_TOPIC("d5a7e", WARN, arangodb::Logger::DUMP)
+          << "server does not support binary dumps, ignoring --binary-output";
+      _options.binaryOutput = false;
+    }
+  }
+
   // Step 3. iterate over collections, queue dump jobs
   for (VPackSlice const& collection : VPackArrayIterator(collections)) {
     // extract parameters about the individual collection
@@ -818,12 +1045,15 @@ Result DumpFeature::runDump(httpclient::SimpleHttpClient& client, std::string co
       continue;
     }
 
-    // queue job to actually dump collection
-    auto jobData =
-        std::make_unique<JobData>(*_directory, *this, _options, _maskings.get(),
-                                  _stats, collection, batchId,
-                                  std::to_string(cid), name, collectionType);
-    _clientTaskQueue.queueJob(std::move(jobData));
+    // queue jobs to actually dump collection, one per key range
+    for (uint64_t partition = 0; partition < numPartitions; ++partition) {
+      auto jobData =
+          std::make_unique<JobData>(*_directory, *this, _options, _maskings.get(),
+                                    _stats, collection, batchId,
+                                    std::to_string(cid), name, collectionType,
+                                    partition, numPartitions);
+      _clientTaskQueue.queueJob(std::move(jobData));
+    }
   }
 
   // wait for all jobs to finish, then check for errors
@@ -976,6 +1206,287 @@ Result DumpFeature::runClusterDump(httpclient::SimpleHttpClient& client,
   return {TRI_ERROR_NO_ERROR};
 }
 
+// dump the changes since a previous dump by tailing the server's WAL
+Result DumpFeature::runIncrementalDump(httpclient::SimpleHttpClient& client,
+                                       std::string const& dbName) {
+  using basics::StringUtils::boolean;
+  using basics::StringUtils::itoa;
+  using basics::StringUtils::uint64;
+  using basics::VelocyPackHelper;
+
+  // the previous dump in the chain determines where we start
+  std::string const previousPath =
+      _options.allDatabases
+          ? basics::FileUtils::buildFilename(_options.incrementalFrom, dbName)
+          : _options.incrementalFrom;
+  uint64_t tickStart = 0;
+  {
+    ManagedDirectory previous(previousPath, false, false);
+    if (previous.status().fail()) {
+      return previous.status();
+    }
+    try {
+      VPackBuilder meta = previous.vpackFromJsonFile("dump.json");
+      tickStart = VelocyPackHelper::stringUInt64(meta.slice(), "lastTickAtDumpStart");
+    } catch (...) {
+      // handled below
+    }
+    if (tickStart == 0) {
+      return {TRI_ERROR_BAD_PARAMETER,
+              "unable to determine the last tick of the previous dump in '" +
+                  previousPath + "'"};
+    }
+  }
+
+  Result result;
+  uint64_t batchId;
+  std::tie(result, batchId) = ::startBatch(client, "");
+  if (result.fail()) {
+    return result;
+  }
+  TRI_DEFER(::endBatch(client, "", batchId));
+
+  // flush the wal and so we know we are getting everything
+  flushWal(client);
+
+  // the inventory provides the end tick and the names of the collections
+  std::string const url = "/_api/replication/inventory?includeSystem=" +
+                          std::string(_options.includeSystemCollections ? "true" : "false") +
+                          "&batchId=" + itoa(batchId);
+  std::unique_ptr<httpclient::SimpleHttpResult> response(
+      client.request(rest::RequestType::GET, url, nullptr, 0));
+  auto check = ::checkHttpResponse(client, response);
+  if (check.fail()) {
+    LOG_TOPIC("5e2d1", ERR, arangodb::Logger::DUMP)
+        << "An error occurred while fetching inventory: " << check.errorMessage();
+    return check;
+  }
+
+  std::shared_ptr<VPackBuilder> parsedBody;
+  try {
+    parsedBody = response->getBodyVelocyPack();
+  } catch (...) {
+    return ::ErrorMalformedJsonResponse;
+  }
+  VPackSlice const body = parsedBody->slice();
+  if (!body.isObject() || !body.get("collections").isArray()) {
+    return ::ErrorMalformedJsonResponse;
+  }
+
+  uint64_t const tickEnd = _options.tickEnd > 0 ? _options.tickEnd
+                                                : VelocyPackHelper::stringUInt64(body, "tick");
+  if (tickEnd < tickStart) {
+    return {TRI_ERROR_BAD_PARAMETER,
+            "previous dump in '" + previousPath + "' is newer than the server's data"};
+  }
+
+  // WAL markers reference collections by their globally unique id
+  std::map<std::string, bool> restrictList;
+  for (auto const& it : _options.collections) {
+    restrictList.emplace(it, true);
+  }
+  std::unordered_map<std::string, std::pair<std::string, std::string>> collections;
+  for (VPackSlice collection : VPackArrayIterator(body.get("collections"))) {
+    VPackSlice const parameters = collection.get("parameters");
+    if (!parameters.isObject()) {
+      return ::ErrorMalformedJsonResponse;
+    }
+    std::string const name =
+        VelocyPackHelper::getStringValue(parameters, StaticStrings::DataSourceName, "");
+    std::string const guid =
+        VelocyPackHelper::getStringValue(parameters, StaticStrings::DataSourceGuid, "");
+    int type = VelocyPackHelper::getNumericValue<int>(parameters,
+                                                      StaticStrings::DataSourceType.c_str(), 2);
+    if (name.empty() || guid.empty() ||
+        VelocyPackHelper::getBooleanValue(parameters,
+                                          StaticStrings::DataSourceDeleted.c_str(), false) ||
+        (name[0] == '_' && !_options.includeSystemCollections) ||
+        (!restrictList.empty() && restrictList.find(name) == restrictList.end())) {
+      continue;
+    }
+    collections.emplace(guid, std::make_pair(name, type == 2 ? "document" : "edge"));
+  }
+
+  if (_options.progress) {
+    LOG_TOPIC("0c6a3", INFO, Logger::DUMP)
+        << "Dumping changes between tick " << tickStart << " and tick " << tickEnd;
+  }
+
+  // operations of transactions are only written once the transaction
+  // has committed
+  struct PendingOperation {
+    std::string name;
+    std::string type;
+    uint64_t tick;
+    VPackBuilder marker;
+  };
+  std::unordered_map<std::string, std::vector<PendingOperation>> pending;
+  ::ChangeLogWriter changes(*_directory, _stats);
+  uint64_t numChanges = 0;
+  uint64_t numIgnored = 0;
+  uint64_t fromTick = tickStart;
+  bool first = true;
+
+  while (true) {
+    std::string const tailUrl = "/_api/wal/tail?from=" + itoa(fromTick) +
+                                "&to=" + itoa(tickEnd) +
+                                "&chunkSize=" + itoa(_options.maxChunkSize) +
+                                "&serverId=" + ::clientId;
+    ++(_stats.totalBatches);
+    response.reset(client.request(rest::RequestType::GET, tailUrl, nullptr, 0));
+    check = ::checkHttpResponse(client, response);
+    if (check.fail()) {
+      LOG_TOPIC("8f1e4", ERR, arangodb::Logger::DUMP)
+          << "An error occurred while tailing the WAL: " << check.errorMessage();
+      return check;
+    }
+
+    bool found;
+    if (first) {
+      // without the start tick the chain would silently miss changes
+      std::string const header =
+          response->getHeaderField(StaticStrings::ReplicationHeaderFromPresent, found);
+      if (found && !boolean(header)) {
+        return {TRI_ERROR_REPLICATION_START_TICK_NOT_PRESENT,
+                "the server's WAL does not contain tick " + itoa(tickStart) +
+                    " of the previous dump anymore, a full dump is required"};
+      }
+      first = false;
+    }
+
+    std::string const checkMore =
+        response->getHeaderField(StaticStrings::ReplicationHeaderCheckMore, found);
+    if (!found) {
+      return {TRI_ERROR_REPLICATION_INVALID_RESPONSE,
+              "got invalid response from server: required header is missing "
+              "while tailing the WAL"};
+    }
+    uint64_t const lastIncluded = uint64(
+        response->getHeaderField(StaticStrings::ReplicationHeaderLastIncluded, found));
+    uint64_t const lastScanned = uint64(
+        response->getHeaderField(StaticStrings::ReplicationHeaderLastScanned, found));
+
+    basics::StringBuffer const& markers = response->getBody();
+    char const* p = markers.c_str();
+    char const* e = p + markers.length();
+    while (p < e) {
+      char const* nl = static_cast<char const*>(memchr(p, '\n', e - p));
+      if (nl == nullptr) {
+        nl = e;
+      }
+      if (nl - p > 1) {
+        std::shared_ptr<VPackBuilder> marker;
+        try {
+          marker = VPackParser::fromJson(p, nl - p);
+        } catch (...) {
+          return ::ErrorMalformedJsonResponse;
+        }
+        VPackSlice const slice = marker->slice();
+        int const type = VelocyPackHelper::getNumericValue<int>(slice, "type", 0);
+        std::string const tid = VelocyPackHelper::getStringValue(slice, "tid", "0");
+
+        if (type == ::MarkerDocument || type == ::MarkerRemove) {
+          auto it = collections.find(VelocyPackHelper::getStringValue(slice, "cuid", ""));
+          if (it != collections.end()) {
+            if (tid == "0") {
+              result = changes.write(it->second.first, it->second.second, slice);
+              if (result.fail()) {
+                return result;
+              }
+              ++numChanges;
+            } else {
+              pending[tid].emplace_back(PendingOperation{
+                  it->second.first, it->second.second,
+                  VelocyPackHelper::stringUInt64(slice, "tick"), *marker});
+            }
+          }
+        } else if (type == ::MarkerTransactionCommit) {
+          auto it = pending.find(tid);
+          if (it != pending.end()) {
+            for (auto const& op : it->second) {
+              result = changes.write(op.name, op.type, op.marker.slice());
+              if (result.fail()) {
+                return result;
+              }
+              ++numChanges;
+            }
+            pending.erase(it);
+          }
+        } else if (type == ::MarkerTransactionAbort) {
+          pending.erase(tid);
+        } else if (type < 2200 || type > 2202) {
+          // structural changes have to be picked up by a full dump
+          ++numIgnored;
+        }
+      }
+      p = nl + 1;
+    }
+
+    uint64_t const next = std::max(lastIncluded, lastScanned);
+    if (!boolean(checkMore) || next <= fromTick || next >= tickEnd) {
+      break;
+    }
+    fromTick = next;
+  }
+
+  // transactions still running at the end tick are picked up by the next
+  // incremental dump, which therefore has to start before their first
+  // operation
+  uint64_t resumeTick = tickEnd;
+  for (auto const& it : pending) {
+    for (auto const& op : it.second) {
+      if (op.tick > 0 && op.tick - 1 < resumeTick) {
+        resumeTick = op.tick - 1;
+      }
+    }
+  }
+
+  if (numIgnored > 0) {
+    LOG_TOPIC("4a0b7", WARN, Logger::DUMP)
+        << "ignored " << numIgnored
+        << " structural change(s) in the WAL, collection and index changes "
+           "require a full dump";
+  }
+  if (_options.progress) {
+    LOG_TOPIC("b0e83", INFO, Logger::DUMP)
+        << "Dumped " << numChanges << " document change(s)";
+  }
+
+  try {
+    VPackBuilder meta;
+    meta.openObject();
+    meta.add("database", VPackValue(dbName));
+    meta.add("lastTickAtDumpStart", VPackValue(itoa(resumeTick)));
+    meta.add(VPackValue("incremental"));
+    meta.openObject();
+    meta.add("previous", VPackValue(previousPath));
+    meta.add("tickStart", VPackValue(itoa(tickStart)));
+    meta.add("tickEnd", VPackValue(itoa(tickEnd)));
+    meta.add(VPackValue("changes"));
+    changes.toVelocyPack(meta);
+    meta.close();
+    meta.close();
+
+    auto file = _directory->writableFile("dump.json", true, 0, false);
+    if (!::fileOk(file.get())) {
+      return ::fileError(file.get(), true);
+    }
+    std::string const metaString = meta.slice().toJson();
+    file->write(metaString.c_str(), metaString.size());
+    if (file->status().fail()) {
+      return file->status();
+    }
+  } catch (basics::Exception const& ex) {
+    return {ex.code(), ex.what()};
+  } catch (std::exception const& ex) {
+    return {TRI_ERROR_INTERNAL, ex.what()};
+  } catch (...) {
+    return {TRI_ERROR_OUT_OF_MEMORY, "out of memory"};
+  }
+
+  return {TRI_ERROR_NO_ERROR};
+}
+
 Result DumpFeature::storeDumpJson(VPackSlice const& body, std::string const& dbName) const {
   // read the server's max tick value
   std::string const tickString =
@@ -1130,6 +1641,11 @@ void DumpFeature::start() {
           << "Error: cannot use tick-start or tick-end on a cluster";
       FATAL_ERROR_EXIT();
     }
+    if (!_options.incrementalFrom.empty()) {
+      LOG_TOPIC("69d0b", ERR, Logger::DUMP)
+          << "Error: cannot use incremental-from on a cluster";
+      FATAL_ERROR_EXIT();
+    }
   }
 
   // set up threads and workers
@@ -1176,7 +1692,9 @@ void DumpFeature::start() {
       }
 
       try {
-        if (!_options.clusterMode) {
+        if (!_options.incrementalFrom.empty()) {
+          res = runIncrementalDump(*httpClient, db);
+        } else if (!_options.clusterMode) {
           res = runDump(*httpClient, db);
         } else {
           res = runClusterDump(*httpClient, db);
@@ -67,12 +67,15 @@ class DumpFeature : public application_features::ApplicationFeature {
     std::vector<std::string> collections{};
     std::string outputPath{};
     std::string maskingsFile{};
+    std::string incrementalFrom{};
     uint64_t initialChunkSize{1024 * 1024 * 8};
     uint64_t maxChunkSize{1024 * 1024 * 64};
     uint32_t threadCount{2};
+    uint32_t partitions{1};
     uint64_t tickStart{0};
     uint64_t tickEnd{0};
     bool allDatabases{false};
+    bool binaryOutput{false};
     bool clusterMode{false};
     bool dumpData{true};
     bool force{false};
@@ -94,7 +97,8 @@ class DumpFeature : public application_features::ApplicationFeature {
   struct JobData {
     JobData(ManagedDirectory&, DumpFeature&, Options const&,
             maskings::Maskings* maskings, Stats&, VPackSlice const&, uint64_t const,
-            std::string const&, std::string const&, std::string const&);
+            std::string const&, std::string const&, std::string const&,
+            uint64_t partition = 0, uint64_t numPartitions = 1);
 
     ManagedDirectory& directory;
     DumpFeature& feature;
@@ -107,6 +111,10 @@ class DumpFeature : public application_features::ApplicationFeature {
     std::string const cid;
     std::string const name;
     std::string const type;
+    /// key range of the collection to dump (0-based), only used if
+    /// numPartitions is greater than 1
+    uint64_t const partition;
+    uint64_t const numPartitions;
   };
 
  private:
@@ -122,6 +130,7 @@ class DumpFeature : public application_features::ApplicationFeature {
 
   Result runDump(httpclient::SimpleHttpClient& client, std::string const& dbName);
   Result runClusterDump(httpclient::SimpleHttpClient& client, std::string const& dbName);
+  Result runIncrementalDump(httpclient::SimpleHttpClient& client, std::string const& dbName);
   Result storeDumpJson(VPackSlice const& body, std::string const& dbName) const;
   Result storeViews(velocypack::Slice const&) const;
 };
@@ -24,14 +24,20 @@
 
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Basics/FileUtils.h"
+#include "Basics/MutexLocker.h"
+#include "Basics/ScopeGuard.h"
+#include "Basics/StaticStrings.h"
 #include "Basics/StringUtils.h"
+#include "Basics/VelocyPackHelper.h"
 #include "Logger/Logger.h"
 #include "ProgramOptions/ProgramOptions.h"
+#include "Random/RandomGenerator.h"
 #include "Shell/ClientFeature.h"
 #include "SimpleHttpClient/GeneralClientConnection.h"
 #include "SimpleHttpClient/SimpleHttpClient.h"
 #include "SimpleHttpClient/SimpleHttpResult.h"
 
+#include <boost/algorithm/clamp.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/property_tree/detail/xml_parser_utils.hpp>
 #include <iostream>
@@ -42,8 +48,61 @@ using namespace arangodb::httpclient;
 using namespace arangodb::options;
 using namespace boost::property_tree::xml_parser;
 
+namespace {
+
+/// @brief type of document markers in replication dumps
+constexpr int MarkerDocument = 2300;
+
+/// @brief size of the chunks fetched from the replication dump
+constexpr uint64_t DumpChunkSize = 16 * 1024 * 1024;
+
+/// @brief body for creating and prolonging a replication batch
+std::string const BatchTtlBody("{\"ttl\":600}");
+
+/// @brief server id used for the replication batch
+std::string clientId;
+
+/// @brief prolong (PUT) or finish (DELETE) a replication batch
+void batchRequest(arangodb::httpclient::SimpleHttpClient& client,
+                  arangodb::rest::RequestType type, uint64_t batchId) {
+  if (batchId == 0) {
+    return;
+  }
+
+  std::string const url = "/_api/replication/batch/" +
+                          arangodb::basics::StringUtils::itoa(batchId) +
+                          "?serverId=" + clientId;
+  std::string const body = (type == arangodb::rest::RequestType::PUT) ? BatchTtlBody : "";
+
+  std::unique_ptr<arangodb::httpclient::SimpleHttpResult> response(
+      client.request(type, url, body.c_str(), body.size()));
+  // ignore any return value
+}
+
+arangodb::Result processJob(arangodb::httpclient::SimpleHttpClient& client,
+                            arangodb::ExportFeature::JobData& jobData) {
+  return jobData.feature.exportCollection(client, jobData);
+}
+
+void handleJobResult(std::unique_ptr<arangodb::ExportFeature::JobData>&& jobData,
+                     arangodb::Result const& result) {
+  if (result.fail()) {
+    jobData->feature.reportError(result);
+  }
+}
+
+}  // namespace
+
 namespace arangodb {
 
+ExportFeature::JobData::JobData(ExportFeature& feature, std::string const& collection,
+                                uint64_t batchId, uint64_t partition, uint64_t numPartitions)
+    : feature{feature},
+      collection{collection},
+      batchId{batchId},
+      partition{partition},
+      numPartitions{numPartitions} {}
+
 ExportFeature::ExportFeature(application_features::ApplicationServer& server, int* result)
     : ApplicationFeature(server, "Export"),
       _collections(),
@@ -56,11 +115,14 @@ ExportFeature::ExportFeature(application_features::ApplicationServer& server, in
       _outputDirectory(),
       _overwrite(false),
       _progress(true),
-      _firstLine(true),
+      _threadCount(2),
+      _partitions(1),
       _skippedDeepNested(0),
       _httpRequestsDone(0),
-      _currentCollection(),
       _currentGraph(),
+      _exportedPartitions(1),
+      _clientManager{Logger::COMMUNICATION},
+      _clientTaskQueue{::processJob, ::handleJobResult},
       _result(result) {
   requiresElevatedPrivileges(false);
   setOptional(false);
@@ -100,10 +162,22 @@ void ExportFeature::collectOptions(std::shared_ptr<options::ProgramOptions> opti
                      "comma separated list of fileds to export into a csv file",
                      new StringParameter(&_csvFieldOptions));
 
-  std::unordered_set<std::string> exports = {"csv", "json", "jsonl", "xgmml",
-                                             "xml"};
+  std::unordered_set<std::string> exports = {"csv", "json", "jsonl", "vpack",
+                                             "xgmml", "xml"};
   options->addOption("--type", "type of export",
                      new DiscreteValuesParameter<StringParameter>(&_typeExport, exports));
+
+  options->addOption("--threads",
+                     "maximum number of collections (or key ranges of "
+                     "collections) to export in parallel",
+                     new UInt32Parameter(&_threadCount));
+
+  options->addOption(
+      "--partitions",
+      "number of key ranges each collection is split into for parallel "
+      "export (RocksDB single server only). key range N > 0 is written to "
+      "<collection>.<N>.<type>",
+      new UInt32Parameter(&_partitions));
 }
 
 void ExportFeature::validateOptions(std::shared_ptr<options::ProgramOptions> options) {
@@ -144,7 +218,8 @@ void ExportFeature::validateOptions(std::shared_ptr<options::ProgramOptions> opt
     FATAL_ERROR_EXIT();
   }
 
-  if ((_typeExport == "json" || _typeExport == "jsonl" || _typeExport == "csv") &&
+  if ((_typeExport == "json" || _typeExport == "jsonl" || _typeExport == "csv" ||
+       _typeExport == "vpack") &&
       _collections.empty() && _query.empty()) {
     LOG_TOPIC("cdcf7", FATAL, Logger::CONFIG)
         << "expecting at least one collection or an AQL query";
@@ -160,6 +235,18 @@ void ExportFeature::validateOptions(std::shared_ptr<options::ProgramOptions> opt
 
     boost::split(_csvFields, _csvFieldOptions, boost::is_any_of(","));
   }
+
+  uint32_t clamped = boost::algorithm::clamp(_threadCount, 1, 64);
+  if (_threadCount != clamped) {
+    LOG_TOPIC("5d3e8", WARN, Logger::CONFIG) << "capping --threads value to " << clamped;
+    _threadCount = clamped;
+  }
+
+  clamped = boost::algorithm::clamp(_partitions, 1, 64);
+  if (_partitions != clamped) {
+    LOG_TOPIC("e2c47", WARN, Logger::CONFIG) << "capping --partitions value to " << clamped;
+    _partitions = clamped;
+  }
 }
 
 void ExportFeature::prepare() {
@@ -242,17 +329,18 @@ void ExportFeature::start() {
   uint64_t exportedSize = 0;
 
   if (_typeExport == "json" || _typeExport == "jsonl" || _typeExport == "xml" ||
-      _typeExport == "csv") {
+      _typeExport == "csv" || _typeExport == "vpack") {
     if (_collections.size()) {
       collectionExport(httpClient.get());
 
       for (auto const& collection : _collections) {
-        std::string filePath =
-            _outputDirectory + TRI_DIR_SEPARATOR_STR + collection + "." + _typeExport;
-        int64_t fileSize = TRI_SizeFile(filePath.c_str());
+        for (uint64_t partition = 0; partition < _exportedPartitions; ++partition) {
+          std::string filePath = collectionFileName(collection, partition);
+          int64_t fileSize = TRI_SizeFile(filePath.c_str());
 
-        if (0 < fileSize) {
-          exportedSize += fileSize;
+          if (0 < fileSize) {
+            exportedSize += fileSize;
+          }
         }
       }
     } else if (!_query.empty()) {
@@ -280,70 +368,223 @@ void ExportFeature::start() {
 }
 
 void ExportFeature::collectionExport(SimpleHttpClient* httpClient) {
-  std::string errorMsg;
+  uint64_t numPartitions = _partitions;
+  uint64_t batchId = 0;
+
+  if (numPartitions > 1) {
+    // key ranges of a collection can only be exported from a RocksDB single
+    // server, which keeps a snapshot for all of them in a replication batch
+    std::shared_ptr<VPackBuilder> engine =
+        httpCall(httpClient, "/_api/engine", rest::RequestType::GET);
+    std::shared_ptr<VPackBuilder> role =
+        httpCall(httpClient, "/_admin/server/role", rest::RequestType::GET);
+
+    if (VelocyPackHelper::getStringValue(engine->slice(), "name", "") != "rocksdb" ||
+        VelocyPackHelper::getStringValue(role->slice(), "role", "") != "SINGLE") {
+      LOG_TOPIC("3d4c1", WARN, Logger::CONFIG)
+          << "server does not support exporting key ranges, ignoring --partitions";
+      numPartitions = 1;
+    } else {
+      ::clientId = std::to_string(
+          RandomGenerator::interval(static_cast<uint64_t>(0x0000FFFFFFFFFFFFULL)));
+      std::shared_ptr<VPackBuilder> batch =
+          httpCall(httpClient, "/_api/replication/batch?serverId=" + ::clientId,
+                   rest::RequestType::POST, ::BatchTtlBody);
+      batchId = StringUtils::uint64(
+          VelocyPackHelper::getStringValue(batch->slice(), "id", ""));
+    }
+  }
+
+  TRI_DEFER(::batchRequest(*httpClient, rest::RequestType::DELETE_REQ, batchId));
+
+  _exportedPartitions = numPartitions;
+
+  if (!_clientTaskQueue.spawnWorkers(_clientManager, _threadCount)) {
+    LOG_TOPIC("a2b5e", FATAL, Logger::COMMUNICATION)
+        << "cannot create server connections, giving up!";
+    FATAL_ERROR_EXIT();
+  }
 
   for (auto const& collection : _collections) {
     if (_progress) {
       std::cout << "# Exporting collection '" << collection << "'..." << std::endl;
     }
 
-    _currentCollection = collection;
-
-    std::string fileName =
-        _outputDirectory + TRI_DIR_SEPARATOR_STR + collection + "." + _typeExport;
-
-    // remove an existing file first
-    if (TRI_ExistsFile(fileName.c_str())) {
-      TRI_UnlinkFile(fileName.c_str());
+    for (uint64_t partition = 0; partition < numPartitions; ++partition) {
+      auto jobData = std::make_unique<JobData>(*this, collection, batchId,
+                                               partition, numPartitions);
+      _clientTaskQueue.queueJob(std::move(jobData));
     }
+  }
 
-    std::string const url = "_api/cursor";
+  _clientTaskQueue.waitForIdle();
 
-    VPackBuilder post;
-    post.openObject();
-    post.add("query", VPackValue("FOR doc IN @@collection RETURN doc"));
-    post.add("bindVars", VPackValue(VPackValueType::Object));
-    post.add("@collection", VPackValue(collection));
-    post.close();
-    post.add("options", VPackValue(VPackValueType::Object));
-    post.add("stream", VPackSlice::trueSlice());
-    post.close();
-    post.close();
+  MUTEX_LOCKER(lock, _workerErrorLock);
+  if (_workerError.fail()) {
+    LOG_TOPIC("c590f", FATAL, Logger::CONFIG) << _workerError.errorMessage();
+    FATAL_ERROR_EXIT();
+  }
+}
 
-    std::shared_ptr<VPackBuilder> parsedBody =
-        httpCall(httpClient, url, rest::RequestType::POST, post.toJson());
-    VPackSlice body = parsedBody->slice();
+Result ExportFeature::exportCollection(SimpleHttpClient& client, JobData const& jobData) {
+  std::string const fileName = collectionFileName(jobData.collection, jobData.partition);
+
+  // remove an existing file first
+  if (TRI_ExistsFile(fileName.c_str())) {
+    TRI_UnlinkFile(fileName.c_str());
+  }
 
+  try {
     int fd = TRI_CREATE(fileName.c_str(), O_CREAT | O_EXCL | O_RDWR | TRI_O_CLOEXEC,
                         S_IRUSR | S_IWUSR);
 
     if (fd < 0) {
-      errorMsg = "cannot write to file '" + fileName + "'";
-      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CANNOT_WRITE_FILE, errorMsg);
+      return {TRI_ERROR_CANNOT_WRITE_FILE, "cannot write to file '" + fileName + "'"};
     }
 
     TRI_DEFER(TRI_CLOSE(fd));
 
-    writeFirstLine(fd, fileName, collection);
+    writeFirstLine(fd, fileName, jobData.collection);
+    bool firstLine = true;
 
-    writeBatch(fd, VPackArrayIterator(body.get("result")), fileName);
+    if (jobData.numPartitions > 1) {
+      exportKeyRange(client, jobData, fd, fileName, firstLine);
+    } else {
+      std::string const url = "_api/cursor";
+
+      VPackBuilder post;
+      post.openObject();
+      post.add("query", VPackValue("FOR doc IN @@collection RETURN doc"));
+      post.add("bindVars", VPackValue(VPackValueType::Object));
+      post.add("@collection", VPackValue(jobData.collection));
+      post.close();
+      post.add("options", VPackValue(VPackValueType::Object));
+      post.add("stream", VPackSlice::trueSlice());
+      post.close();
+      post.close();
+
+      std::shared_ptr<VPackBuilder> parsedBody =
+          httpCall(&client, url, rest::RequestType::POST, post.toJson());
+      VPackSlice body = parsedBody->slice();
+
+      writeBatch(fd, VPackArrayIterator(body.get("result")), fileName, firstLine);
+
+      while (body.hasKey("id")) {
+        std::string const url = "/_api/cursor/" + body.get("id").copyString();
+        parsedBody = httpCall(&client, url, rest::RequestType::PUT);
+        body = parsedBody->slice();
+
+        writeBatch(fd, VPackArrayIterator(body.get("result")), fileName, firstLine);
+      }
+    }
 
-    while (body.hasKey("id")) {
-      std::string const url = "/_api/cursor/" + body.get("id").copyString();
-      parsedBody = httpCall(httpClient, url, rest::RequestType::PUT);
-      body = parsedBody->slice();
+    writeLastLine(fd, fileName);
+  } catch (basics::Exception const& ex) {
+    if (ex.code() == TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND) {
+      return {ex.code(), "Collection " + jobData.collection + " not found."};
+    }
+    return {ex.code(), ex.what()};
+  } catch (std::exception const& ex) {
+    return {TRI_ERROR_INTERNAL, ex.what()};
+  }
+
+  return {};
+}
+
+void ExportFeature::exportKeyRange(SimpleHttpClient& client, JobData const& jobData,
+                                   int fd, std::string const& fileName, bool& firstLine) {
+  // keep the snapshot alive
+  ::batchRequest(client, rest::RequestType::PUT, jobData.batchId);
+
+  std::string const baseUrl =
+      "/_api/replication/dump?collection=" + StringUtils::urlEncode(jobData.collection) +
+      "&batchId=" + StringUtils::itoa(jobData.batchId) + "&ticks=false&flush=false" +
+      "&partition=" + StringUtils::itoa(jobData.partition) +
+      "&partitions=" + StringUtils::itoa(jobData.numPartitions) +
+      "&chunkSize=" + StringUtils::itoa(::DumpChunkSize);
 
-      writeBatch(fd, VPackArrayIterator(body.get("result")), fileName);
+  // fetch VelocyPack, so the documents can be written without parsing them
+  std::unordered_map<std::string, std::string> headers;
+  headers.emplace(StaticStrings::Accept, StaticStrings::MimeTypeVPack);
+
+  std::string line;
+  uint64_t fromTick = 0;
+
+  while (true) {
+    std::unique_ptr<SimpleHttpResult> response(
+        client.request(rest::RequestType::GET, baseUrl + "&from=" + StringUtils::itoa(fromTick),
+                       nullptr, 0, headers));
+    _httpRequestsDone++;
+
+    if (response == nullptr || !response->isComplete()) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                     "got invalid response from server: " +
+                                         client.getErrorMessage());
+    }
+    if (response->wasHttpError()) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(response->getHttpReturnCode() == 404
+                                         ? TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND
+                                         : TRI_ERROR_INTERNAL,
+                                     "got invalid response from server: HTTP " +
+                                         StringUtils::itoa(response->getHttpReturnCode()) +
+                                         ": " + response->getHttpReturnMessage());
     }
 
-    if (_typeExport == "json") {
-      std::string closingBracket = "\n]";
-      writeToFile(fd, closingBracket, fileName);
-    } else if (_typeExport == "xml") {
-      std::string xmlFooter = "</collection>";
-      writeToFile(fd, xmlFooter, fileName);
+    // find out whether there are more results to fetch
+    bool found = false;
+    bool checkMore = StringUtils::boolean(
+        response->getHeaderField(StaticStrings::ReplicationHeaderCheckMore, found));
+    if (!found) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_REPLICATION_INVALID_RESPONSE,
+                                     "got invalid response from server: required "
+                                     "header is missing");
+    }
+    if (checkMore) {
+      uint64_t tick = StringUtils::uint64(
+          response->getHeaderField(StaticStrings::ReplicationHeaderLastIncluded, found));
+      if (found && tick > fromTick) {
+        fromTick = tick;
+      } else {
+        // we got the same tick again, this indicates we're at the end
+        checkMore = false;
+      }
     }
+
+    StringBuffer const& body = response->getBody();
+    uint8_t const* p = reinterpret_cast<uint8_t const*>(body.c_str());
+    uint8_t const* e = p + body.length();
+
+    while (p < e) {
+      VPackSlice marker(p);
+      p += marker.byteSize();
+
+      if (marker.isObject() &&
+          VelocyPackHelper::getNumericValue<int>(marker, "type", 0) == ::MarkerDocument) {
+        writeDocument(fd, marker.get("data"), fileName, firstLine, line);
+      }
+    }
+
+    if (!checkMore || fromTick == 0) {
+      break;
+    }
+  }
+}
+
+std::string ExportFeature::collectionFileName(std::string const& collection,
+                                              uint64_t partition) const {
+  std::string fileName = _outputDirectory + TRI_DIR_SEPARATOR_STR + collection;
+  if (partition > 0) {
+    fileName += "." + StringUtils::itoa(partition);
   }
+  return fileName + "." + _typeExport;
+}
+
+void ExportFeature::reportError(Result const& error) {
+  MUTEX_LOCKER(lock, _workerErrorLock);
+  if (_workerError.ok()) {
+    _workerError = error;
+  }
+  _clientTaskQueue.clearQueue();
 }
 
 void ExportFeature::queryExport(SimpleHttpClient* httpClient) {
@@ -385,29 +626,23 @@ void ExportFeature::queryExport(SimpleHttpClient* httpClient) {
   TRI_DEFER(TRI_CLOSE(fd));
 
   writeFirstLine(fd, fileName, "");
+  bool firstLine = true;
 
-  writeBatch(fd, VPackArrayIterator(body.get("result")), fileName);
+  writeBatch(fd, VPackArrayIterator(body.get("result")), fileName, firstLine);
 
   while (body.hasKey("id")) {
     std::string const url = "/_api/cursor/" + body.get("id").copyString();
     parsedBody = httpCall(httpClient, url, rest::RequestType::PUT);
     body = parsedBody->slice();
 
-    writeBatch(fd, VPackArrayIterator(body.get("result")), fileName);
+    writeBatch(fd, VPackArrayIterator(body.get("result")), fileName, firstLine);
   }
 
-  if (_typeExport == "json") {
-    std::string closingBracket = "\n]";
-    writeToFile(fd, closingBracket, fileName);
-  } else if (_typeExport == "xml") {
-    std::string xmlFooter = "</collection>";
-    writeToFile(fd, xmlFooter, fileName);
-  }
+  writeLastLine(fd, fileName);
 }
 
 void ExportFeature::writeFirstLine(int fd, std::string const& fileName,
                                    std::string const& collection) {
-  _firstLine = true;
   if (_typeExport == "json") {
     std::string openingBracket = "[";
     writeToFile(fd, openingBracket, fileName);
@@ -436,83 +671,99 @@ void ExportFeature::writeFirstLine(int fd, std::string const& fileName,
   }
 }
 
-void ExportFeature::writeBatch(int fd, VPackArrayIterator it, std::string const& fileName) {
+void ExportFeature::writeLastLine(int fd, std::string const& fileName) {
+  if (_typeExport == "json") {
+    std::string closingBracket = "\n]";
+    writeToFile(fd, closingBracket, fileName);
+  } else if (_typeExport == "xml") {
+    std::string xmlFooter = "</collection>";
+    writeToFile(fd, xmlFooter, fileName);
+  }
+}
+
+void ExportFeature::writeBatch(int fd, VPackArrayIterator it,
+                               std::string const& fileName, bool& firstLine) {
   std::string line;
   line.reserve(1024);
 
+  for (auto const& doc : it) {
+    writeDocument(fd, doc, fileName, firstLine, line);
+  }
+}
+
+void ExportFeature::writeDocument(int fd, VPackSlice const& doc, std::string const& fileName,
+                                  bool& firstLine, std::string& line) {
   if (_typeExport == "jsonl") {
-    for (auto const& doc : it) {
-      line.clear();
-      line += doc.toJson();
-      line.push_back('\n');
-      writeToFile(fd, line, fileName);
-    }
+    line.clear();
+    line += doc.toJson();
+    line.push_back('\n');
+    writeToFile(fd, line, fileName);
   } else if (_typeExport == "json") {
-    for (auto const& doc : it) {
-      line.clear();
-      if (!_firstLine) {
-        line.append(",\n  ", 4);
-      } else {
-        line.append("\n  ", 3);
-        _firstLine = false;
-      }
-      line += doc.toJson();
-      writeToFile(fd, line, fileName);
+    line.clear();
+    if (!firstLine) {
+      line.append(",\n  ", 4);
+    } else {
+      line.append("\n  ", 3);
+      firstLine = false;
+    }
+    line += doc.toJson();
+    writeToFile(fd, line, fileName);
+  } else if (_typeExport == "vpack") {
+    // documents are written as they are, one VelocyPack value after the other
+    if (!TRI_WritePointer(fd, doc.start(), static_cast<size_t>(doc.byteSize()))) {
+      std::string errorMsg = "cannot write to file '" + fileName + "'";
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CANNOT_WRITE_FILE, errorMsg);
     }
   } else if (_typeExport == "csv") {
-    for (auto const& doc : it) {
-      line.clear();
-      bool isFirstValue = true;
+    line.clear();
+    bool isFirstValue = true;
 
-      for (auto const& key : _csvFields) {
-        std::string value = "";
+    for (auto const& key : _csvFields) {
+      std::string value = "";
 
-        if (isFirstValue) {
-          isFirstValue = false;
-        } else {
-          line.append(",");
-        }
+      if (isFirstValue) {
+        isFirstValue = false;
+      } else {
+        line.append(",");
+      }
 
-        if (doc.hasKey(key)) {
-          VPackSlice val = doc.get(key);
+      if (doc.hasKey(key)) {
+        VPackSlice val = doc.get(key);
 
-          if (val.isArray() || val.isObject()) {
-            value = val.toJson();
+        if (val.isArray() || val.isObject()) {
+          value = val.toJson();
+        } else {
+          if (val.isString()) {
+            value = val.copyString();
           } else {
-            if (val.isString()) {
-              value = val.copyString();
-            } else {
-              value = val.toString();
-            }
+            value = val.toString();
           }
+        }
 
-          value = std::regex_replace(value, std::regex("\""), "\"\"");
+        value = std::regex_replace(value, std::regex("\""), "\"\"");
 
-          if (value.find(",") != std::string::npos ||
-              value.find("\"\"") != std::string::npos) {
-            value = "\"" + value;
-            value.append("\"");
-          }
+        if (value.find(",") != std::string::npos ||
+            value.find("\"\"") != std::string::npos) {
+          value = "\"" + value;
+          value.append("\"");
         }
-        line.append(value);
       }
-      line.append("\n");
-      writeToFile(fd, line, fileName);
+      line.append(value);
     }
+    line.append("\n");
+    writeToFile(fd, line, fileName);
   } else if (_typeExport == "xml") {
-    for (auto const& doc : it) {
-      line.clear();
-      line.append("<doc key=\"");
-      line.append(encode_char_entities(doc.get("_key").copyString()));
-      line.append("\">\n");
-      writeToFile(fd, line, fileName);
-      for (auto const& att : VPackObjectIterator(doc)) {
-        xgmmlWriteOneAtt(fd, fileName, att.value, att.key.copyString(), 2);
-      }
-      line.clear();
-      line.append("</doc>\n");
-      writeToFile(fd, line, fileName);
+    line.clear();
+    line.append("<doc key=\"");
+    line.append(encode_char_entities(doc.get("_key").copyString()));
+    line.append("\">\n");
+    writeToFile(fd, line, fileName);
+    for (auto const& att : VPackObjectIterator(doc)) {
+      xgmmlWriteOneAtt(fd, fileName, att.value, att.key.copyString(), 2);
     }
+    line.clear();
+    line.append("</doc>\n");
+    writeToFile(fd, line, fileName);
   }
 }
 
@@ -544,11 +795,12 @@ std::shared_ptr<VPackBuilder> ExportFeature::httpCall(SimpleHttpClient* httpClie
     if (response->getHttpReturnCode() == 404) {
       if (_currentGraph.size()) {
         LOG_TOPIC("bf53d", FATAL, Logger::CONFIG) << "Graph '" << _currentGraph << "' not found.";
-      } else if (_currentCollection.size()) {
-        LOG_TOPIC("c590f", FATAL, Logger::CONFIG) << "Collection " << _currentCollection << " not found.";
+        FATAL_ERROR_EXIT();
       }
 
-      FATAL_ERROR_EXIT();
+      // collection exports run in worker threads and report the error
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND,
+                                     "got invalid response from server: HTTP 404");
     } else {
       parsedBody = response->getBodyVelocyPack();
       std::cout << parsedBody->toJson() << std::endl;
@@ -680,8 +932,8 @@ directed="1">
   std::string closingGraphTag = "</graph>\n";
   writeToFile(fd, closingGraphTag, fileName);
 
-  if (_skippedDeepNested) {
-    std::cout << "skipped " << _skippedDeepNested
+  if (_skippedDeepNested > 0) {
+    std::cout << "skipped " << _skippedDeepNested.load()
               << " deep nested objects / arrays" << std::endl;
   }
 }
@@ -772,10 +1024,9 @@ void ExportFeature::xgmmlWriteOneAtt(int fd, std::string const& fileName,
 
   } else if (slice.isArray() || slice.isObject()) {
     if (0 < deep) {
-      if (_skippedDeepNested == 0) {
+      if (_skippedDeepNested++ == 0) {
         std::cout << "Warning: skip deep nested objects / arrays" << std::endl;
       }
-      _skippedDeepNested++;
       return;
     }
 
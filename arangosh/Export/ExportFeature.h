@@ -26,9 +26,15 @@
 #include <velocypack/Iterator.h>
 #include <velocypack/velocypack-aliases.h>
 #include "ApplicationFeatures/ApplicationFeature.h"
+#include "Basics/Mutex.h"
+#include "Basics/Result.h"
+#include "Utils/ClientManager.h"
+#include "Utils/ClientTaskQueue.h"
 #include "V8Client/ArangoClientHelper.h"
 #include "lib/Rest/CommonDefines.h"
 
+#include <atomic>
+
 namespace arangodb {
 
 namespace httpclient {
@@ -49,11 +55,38 @@ class ExportFeature final : public application_features::ApplicationFeature,
   void prepare() override final;
   void start() override final;
 
+  /// @brief export of a single collection, or of one of its key ranges
+  struct JobData {
+    JobData(ExportFeature& feature, std::string const& collection,
+            uint64_t batchId, uint64_t partition, uint64_t numPartitions);
+
+    ExportFeature& feature;
+    std::string const collection;
+    /// @brief replication batch holding the snapshot, only used if
+    /// numPartitions > 1
+    uint64_t const batchId;
+    /// @brief key range of the collection to export (0-based)
+    uint64_t const partition;
+    uint64_t const numPartitions;
+  };
+
+  /// @brief export a collection or key range into its own file
+  Result exportCollection(httpclient::SimpleHttpClient& client, JobData const& jobData);
+
+  /// @brief store the error of a failed job and stop processing further jobs
+  void reportError(Result const& error);
+
  private:
   void collectionExport(httpclient::SimpleHttpClient* httpClient);
+  void exportKeyRange(httpclient::SimpleHttpClient& client, JobData const& jobData,
+                      int fd, std::string const& fileName, bool& firstLine);
+  std::string collectionFileName(std::string const& collection, uint64_t partition) const;
   void queryExport(httpclient::SimpleHttpClient* httpClient);
   void writeFirstLine(int fd, std::string const& fileName, std::string const& collection);
-  void writeBatch(int fd, VPackArrayIterator it, std::string const& fileName);
+  void writeLastLine(int fd, std::string const& fileName);
+  void writeBatch(int fd, VPackArrayIterator it, std::string const& fileName, bool& firstLine);
+  void writeDocument(int fd, VPackSlice const& doc, std::string const& fileName,
+                     bool& firstLine, std::string& line);
   void graphExport(httpclient::SimpleHttpClient* httpClient);
   void writeGraphBatch(int fd, VPackArrayIterator it, std::string const& fileName);
   void xgmmlWriteOneAtt(int fd, std::string const& fileName, VPackSlice const& slice,
@@ -76,12 +109,18 @@ class ExportFeature final : public application_features::ApplicationFeature,
   std::string _outputDirectory;
   bool _overwrite;
   bool _progress;
+  uint32_t _threadCount;
+  uint32_t _partitions;
 
-  bool _firstLine;
-  uint64_t _skippedDeepNested;
-  uint64_t _httpRequestsDone;
-  std::string _currentCollection;
+  std::atomic<uint64_t> _skippedDeepNested;
+  std::atomic<uint64_t> _httpRequestsDone;
   std::string _currentGraph;
+  uint64_t _exportedPartitions;
+
+  ClientManager _clientManager;
+  ClientTaskQueue<JobData> _clientTaskQueue;
+  Mutex _workerErrorLock;
+  Result _workerError;
 
   int* _result;
 };
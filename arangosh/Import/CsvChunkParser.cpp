@@ -0,0 +1,359 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "CsvChunkParser.h"
+
+#include "Basics/NumberUtils.h"
+#include "Basics/csv.h"
+
+#include <cerrno>
+#include <cmath>
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::import;
+
+namespace {
+
+/// @brief fields of the record currently being parsed. the strings are
+/// reused from record to record to avoid allocations
+struct RecordState {
+  std::vector<std::string> fields;
+  std::vector<bool> escaped;
+  size_t numFields = 0;
+  size_t numRecords = 0;
+  std::function<void(RecordState&)> onRecord;
+
+  void add(char const* field, size_t fieldLength, bool isEscaped) {
+    if (numFields < fields.size()) {
+      fields[numFields].assign(field, fieldLength);
+      escaped[numFields] = isEscaped;
+    } else {
+      fields.emplace_back(field, fieldLength);
+      escaped.push_back(isEscaped);
+    }
+    ++numFields;
+  }
+};
+
+void recordBegin(TRI_csv_parser_t* parser, size_t) {
+  static_cast<RecordState*>(parser->_dataAdd)->numFields = 0;
+}
+
+void recordAdd(TRI_csv_parser_t* parser, char const* field, size_t fieldLength,
+               size_t, size_t, bool escaped) {
+  static_cast<RecordState*>(parser->_dataAdd)->add(field, fieldLength, escaped);
+}
+
+void recordEnd(TRI_csv_parser_t* parser, char const* field, size_t fieldLength,
+               size_t, size_t, bool escaped) {
+  auto state = static_cast<RecordState*>(parser->_dataAdd);
+  state->add(field, fieldLength, escaped);
+  state->onRecord(*state);
+  ++state->numRecords;
+}
+
+/// @brief run the CSV parser over complete records, calling state.onRecord
+/// for each of them
+void parseRecords(CsvChunkParser::Options const& options, char const* data,
+                  size_t length, RecordState& state) {
+  TRI_csv_parser_t parser;
+  TRI_InitCsvParser(&parser, recordBegin, recordAdd, recordEnd, nullptr);
+  TRI_SetSeparatorCsvParser(&parser, options.separator);
+  TRI_SetQuoteCsvParser(&parser, options.quote, options.useQuote);
+  TRI_UseBackslashCsvParser(&parser, options.useBackslash);
+  parser._dataAdd = &state;
+
+  try {
+    TRI_ParseCsvString(&parser, data, length);
+    if (length > 0 && data[length - 1] != '\n') {
+      // terminate the last record
+      TRI_ParseCsvString(&parser, "\n", 1);
+    }
+  } catch (...) {
+    TRI_DestroyCsvParser(&parser);
+    throw;
+  }
+  TRI_DestroyCsvParser(&parser);
+}
+
+}  // namespace
+
+CsvChunkParser::RecordScanner::RecordScanner(Options const& options)
+    : _options(options), _state(State::FieldStart), _position(0), _boundary(0), _records(0) {}
+
+void CsvChunkParser::RecordScanner::scan(char const* data, size_t length, size_t maxRecords) {
+  while (_position < length && _records < maxRecords) {
+    char const c = data[_position];
+
+    switch (_state) {
+      case State::FieldStart:
+      case State::WithinField:
+        if (c == '\n') {
+          _boundary = _position + 1;
+          ++_records;
+          _state = State::FieldStart;
+        } else if (c == _options.separator) {
+          _state = State::FieldStart;
+        } else if (_state == State::FieldStart && _options.useQuote && c == _options.quote) {
+          _state = State::WithinQuotedField;
+        } else {
+          _state = State::WithinField;
+        }
+        break;
+
+      case State::WithinQuotedField:
+        if (c == _options.quote) {
+          _state = State::QuoteInQuotedField;
+        } else if (c == '\\' && _options.useBackslash) {
+          // skip over the escaped character. if it is not available yet,
+          // the backslash is looked at again in the next call
+          if (_position + 1 >= length) {
+            return;
+          }
+          ++_position;
+        }
+        break;
+
+      case State::QuoteInQuotedField:
+        if (c == _options.quote) {
+          // doubled quote character
+          _state = State::WithinQuotedField;
+        } else {
+          // end of the quoted field, look at the character again
+          _state = State::WithinField;
+          continue;
+        }
+        break;
+    }
+
+    ++_position;
+  }
+}
+
+void CsvChunkParser::RecordScanner::consume() {
+  TRI_ASSERT(_position >= _boundary);
+  _position -= _boundary;
+  _boundary = 0;
+  _records = 0;
+}
+
+CsvChunkParser::CsvChunkParser(Options const& options, std::vector<std::string> const& header,
+                               std::unordered_map<std::string, std::string> const& translations,
+                               std::unordered_set<std::string> const& removeAttributes)
+    : _options(options), _keyColumn(SIZE_MAX) {
+  _columns.reserve(header.size());
+
+  for (std::string const& name : header) {
+    Column column{name, removeAttributes.find(name) != removeAttributes.end()};
+    if (!name.empty()) {
+      auto it = translations.find(name);
+      if (it != translations.end()) {
+        column.name = (*it).second;
+      }
+    }
+    if (_keyColumn == SIZE_MAX && column.name == "_key") {
+      _keyColumn = _columns.size();
+    }
+    _columns.emplace_back(std::move(column));
+  }
+}
+
+std::vector<std::string> CsvChunkParser::splitRecord(Options const& options,
+                                                     char const* data, size_t length) {
+  std::vector<std::string> result;
+  RecordState state;
+  state.onRecord = [&result](RecordState& record) {
+    if (result.empty()) {
+      result.assign(record.fields.begin(), record.fields.begin() + record.numFields);
+    }
+  };
+  parseRecords(options, data, length, state);
+  return result;
+}
+
+size_t CsvChunkParser::parse(char const* data, size_t length, size_t firstLine,
+                             VPackBuilder& result, std::vector<std::string>& errors) const {
+  size_t failed = 0;
+
+  RecordState state;
+  state.onRecord = [&](RecordState& record) {
+    if (record.numFields == 1 && record.fields[0].empty()) {
+      // ignore empty line
+      return;
+    }
+
+    if (!_options.ignoreMissing && record.numFields != _columns.size()) {
+      errors.emplace_back("at position " + std::to_string(firstLine + record.numRecords + 1) +
+                          ": wrong number of JSON values (got " + std::to_string(record.numFields) +
+                          ", expected " + std::to_string(_columns.size()) + ")");
+      ++failed;
+      return;
+    }
+
+    result.openObject();
+    size_t const n = (std::min)(record.numFields, _columns.size());
+    for (size_t i = 0; i < n; ++i) {
+      if (!_columns[i].removed) {
+        addValue(result, i, record.fields[i], record.escaped[i]);
+      }
+    }
+    result.close();
+  };
+
+  result.openArray();
+  parseRecords(_options, data, length, state);
+  result.close();
+
+  return failed;
+}
+
+void CsvChunkParser::addValue(VPackBuilder& result, size_t column,
+                              std::string const& field, bool escaped) const {
+  std::string const& name = _columns[column].name;
+  char const* p = field.data();
+  size_t const fieldLength = field.size();
+
+  if (escaped || column == _keyColumn) {
+    result.add(name, VPackValue(field));
+    return;
+  }
+
+  if (fieldLength == 0 || (fieldLength == 4 && memcmp(p, "null", 4) == 0)) {
+    // null values are not stored in the documents
+    return;
+  }
+
+  // check for literals false and true
+  if (fieldLength == 4 && memcmp(p, "true", 4) == 0) {
+    result.add(name, VPackValue(true));
+    return;
+  } else if (fieldLength == 5 && memcmp(p, "false", 5) == 0) {
+    result.add(name, VPackValue(false));
+    return;
+  }
+
+  if (_options.convert) {
+    // conversion might fail with out-of-range error. in this case, fall
+    // through to adding the value as a string
+    if (isInteger(p, fieldLength)) {
+      int64_t num;
+      if (toInteger(p, fieldLength, num)) {
+        result.add(name, VPackValue(num));
+        return;
+      }
+    } else if (isDecimal(p, fieldLength)) {
+      double num;
+      if (toDouble(p, fieldLength, num)) {
+        result.add(name, VPackValue(num));
+        return;
+      }
+    }
+  }
+
+  result.add(name, VPackValue(field));
+}
+
+bool CsvChunkParser::toInteger(char const* field, size_t fieldLength, int64_t& result) {
+  bool valid = false;
+  result = NumberUtils::atoi<int64_t>(field, field + fieldLength, valid);
+  return valid;
+}
+
+bool CsvChunkParser::toDouble(char const* field, size_t fieldLength, double& result) {
+  TRI_ASSERT(field[fieldLength] == '\0');
+  char* end = nullptr;
+  errno = 0;
+  result = strtod(field, &end);
+  // reject partial conversions, NaN, +inf, -inf and out of range values
+  return end == field + fieldLength && errno != ERANGE && result == result &&
+         result != HUGE_VAL && result != -HUGE_VAL;
+}
+
+bool CsvChunkParser::isInteger(char const* field, size_t fieldLength) {
+  char const* end = field + fieldLength;
+
+  if (*field == '+' || *field == '-') {
+    ++field;
+  }
+
+  while (field < end) {
+    if (*field < '0' || *field > '9') {
+      return false;
+    }
+    ++field;
+  }
+
+  return true;
+}
+
+bool CsvChunkParser::isDecimal(char const* field, size_t fieldLength) {
+  char const* ptr = field;
+  char const* end = ptr + fieldLength;
+
+  if (*ptr == '+' || *ptr == '-') {
+    ++ptr;
+  }
+
+  bool nextMustBeNumber = false;
+
+  while (ptr < end) {
+    if (*ptr == '.') {
+      if (nextMustBeNumber) {
+        return false;
+      }
+      // expect a number after the .
+      nextMustBeNumber = true;
+    } else if (*ptr == 'e' || *ptr == 'E') {
+      if (nextMustBeNumber) {
+        return false;
+      }
+      // expect a number after the exponent
+      nextMustBeNumber = true;
+
+      ++ptr;
+      if (ptr >= end) {
+        return false;
+      }
+      // skip over optional + or -
+      if (*ptr == '+' || *ptr == '-') {
+        ++ptr;
+      }
+      // do not advance ptr anymore
+      continue;
+    } else if (*ptr >= '0' && *ptr <= '9') {
+      // found a number
+      nextMustBeNumber = false;
+    } else {
+      // something else
+      return false;
+    }
+
+    ++ptr;
+  }
+
+  if (nextMustBeNumber) {
+    return false;
+  }
+
+  return true;
+}
@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_IMPORT_CSV_CHUNK_PARSER_H
+#define ARANGODB_IMPORT_CSV_CHUNK_PARSER_H 1
+
+#include "Basics/Common.h"
+
+namespace arangodb {
+namespace velocypack {
+class Builder;
+}
+
+namespace import {
+
+/// @brief converts chunks of complete CSV/TSV records into VelocyPack arrays
+/// of documents, applying the same conversion rules as the single-threaded
+/// import. The column names are determined once from the header line, after
+/// that a single instance is shared by all sender threads, so parse() must
+/// not modify any state.
+class CsvChunkParser {
+ public:
+  struct Options {
+    char separator = ',';
+    char quote = '"';
+    bool useQuote = true;
+    bool useBackslash = false;
+    bool convert = true;
+    bool ignoreMissing = false;
+  };
+
+  /// @brief finds the ends of complete records in the input, honoring
+  /// quoted fields. scanning is incremental, so data can be appended and
+  /// scanned again without looking at the same bytes twice
+  class RecordScanner {
+   public:
+    explicit RecordScanner(Options const& options);
+
+    /// @brief scan data from the current position up to length, stopping
+    /// after maxRecords complete records
+    void scan(char const* data, size_t length, size_t maxRecords = SIZE_MAX);
+
+    /// @brief offset behind the last complete record found
+    size_t boundary() const { return _boundary; }
+
+    /// @brief number of complete records before boundary()
+    size_t records() const { return _records; }
+
+    /// @brief must be called after the caller has removed the first
+    /// boundary() bytes from the scanned data
+    void consume();
+
+   private:
+    enum class State { FieldStart, WithinField, WithinQuotedField, QuoteInQuotedField };
+
+    Options const _options;
+    State _state;
+    size_t _position;
+    size_t _boundary;
+    size_t _records;
+  };
+
+  CsvChunkParser(Options const& options, std::vector<std::string> const& header,
+                 std::unordered_map<std::string, std::string> const& translations,
+                 std::unordered_set<std::string> const& removeAttributes);
+
+  /// @brief split a single record into its (unescaped) fields
+  static std::vector<std::string> splitRecord(Options const& options,
+                                              char const* data, size_t length);
+
+  /// @brief parse a chunk of complete records into an array of objects.
+  /// firstLine is the number of input lines before the chunk and is only used
+  /// for error messages. returns the number of records that were rejected
+  size_t parse(char const* data, size_t length, size_t firstLine,
+               velocypack::Builder& result, std::vector<std::string>& errors) const;
+
+  /// @brief convert an integer field without allocating memory. returns
+  /// false if the value is out of range
+  static bool toInteger(char const* field, size_t fieldLength, int64_t& result);
+
+  /// @brief convert a decimal field without allocating memory. the field
+  /// must be NUL-terminated. returns false if the value cannot be represented
+  static bool toDouble(char const* field, size_t fieldLength, double& result);
+
+  /// @brief helper function to determine if a field value is an integer
+  static bool isInteger(char const* field, size_t fieldLength);
+
+  /// @brief helper function to determine if a field value maybe is a decimal
+  static bool isDecimal(char const* field, size_t fieldLength);
+
+ private:
+  struct Column {
+    std::string name;
+    bool removed;
+  };
+
+  /// @brief add a single converted field value to the open object in result
+  void addValue(velocypack::Builder& result, size_t column, std::string const& field,
+                bool escaped) const;
+
+  Options const _options;
+  std::vector<Column> _columns;
+  size_t _keyColumn;
+};
+
+}  // namespace import
+}  // namespace arangodb
+
+#endif
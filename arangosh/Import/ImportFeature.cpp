@@ -62,6 +62,7 @@ ImportFeature::ImportFeature(application_features::ApplicationServer& server, in
       _separator(""),
       _progress(true),
       _ignoreMissing(false),
+      _parallelParsing(false),
       _onDuplicateAction("error"),
       _rowsToSkip(0),
       _result(result),
@@ -161,6 +162,11 @@ void ImportFeature::collectOptions(std::shared_ptr<options::ProgramOptions> opti
   options->addOption("--ignore-missing", "ignore missing columns in csv input",
                      new BooleanParameter(&_ignoreMissing));
 
+  options->addOption("--parallel-parsing",
+                     "convert csv and tsv input to VelocyPack in the sender "
+                     "threads instead of the reading thread",
+                     new BooleanParameter(&_parallelParsing));
+
   std::unordered_set<std::string> actions = {"error", "update", "replace",
                                              "ignore"};
   std::vector<std::string> actionsVector(actions.begin(), actions.end());
@@ -378,6 +384,7 @@ void ImportFeature::start() {
   ih.setOverwrite(_overwrite);
   ih.useBackslash(_useBackslash);
   ih.ignoreMissing(_ignoreMissing);
+  ih.setParallelParsing(_parallelParsing);
 
   std::unordered_map<std::string, std::string> translations;
   for (auto const& it : _translations) {
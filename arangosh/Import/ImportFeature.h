@@ -69,6 +69,7 @@ class ImportFeature final : public application_features::ApplicationFeature,
   std::string _separator;
   bool _progress;
   bool _ignoreMissing;
+  bool _parallelParsing;
   std::string _onDuplicateAction;
   uint64_t _rowsToSkip;
   int* _result;
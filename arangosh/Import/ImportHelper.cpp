@@ -29,6 +29,7 @@
 #include "Basics/VelocyPackHelper.h"
 #include "Basics/files.h"
 #include "Basics/tri-strings.h"
+#include "Import/CsvChunkParser.h"
 #include "Import/SenderThread.h"
 #include "Logger/Logger.h"
 #include "Rest/GeneralResponse.h"
@@ -45,86 +46,6 @@ using namespace arangodb;
 using namespace arangodb::basics;
 using namespace arangodb::httpclient;
 
-////////////////////////////////////////////////////////////////////////////////
-/// @brief helper function to determine if a field value is an integer
-/// this function is here to avoid usage of regexes, which are too slow
-////////////////////////////////////////////////////////////////////////////////
-
-static bool IsInteger(char const* field, size_t fieldLength) {
-  char const* end = field + fieldLength;
-
-  if (*field == '+' || *field == '-') {
-    ++field;
-  }
-
-  while (field < end) {
-    if (*field < '0' || *field > '9') {
-      return false;
-    }
-    ++field;
-  }
-
-  return true;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-/// @brief helper function to determine if a field value maybe is a decimal
-/// value. this function peeks into the first few bytes of the value only
-/// this function is here to avoid usage of regexes, which are too slow
-////////////////////////////////////////////////////////////////////////////////
-
-static bool IsDecimal(char const* field, size_t fieldLength) {
-  char const* ptr = field;
-  char const* end = ptr + fieldLength;
-
-  if (*ptr == '+' || *ptr == '-') {
-    ++ptr;
-  }
-
-  bool nextMustBeNumber = false;
-
-  while (ptr < end) {
-    if (*ptr == '.') {
-      if (nextMustBeNumber) {
-        return false;
-      }
-      // expect a number after the .
-      nextMustBeNumber = true;
-    } else if (*ptr == 'e' || *ptr == 'E') {
-      if (nextMustBeNumber) {
-        return false;
-      }
-      // expect a number after the exponent
-      nextMustBeNumber = true;
-
-      ++ptr;
-      if (ptr >= end) {
-        return false;
-      }
-      // skip over optional + or -
-      if (*ptr == '+' || *ptr == '-') {
-        ++ptr;
-      }
-      // do not advance ptr anymore
-      continue;
-    } else if (*ptr >= '0' && *ptr <= '9') {
-      // found a number
-      nextMustBeNumber = false;
-    } else {
-      // something else
-      return false;
-    }
-
-    ++ptr;
-  }
-
-  if (nextMustBeNumber) {
-    return false;
-  }
-
-  return true;
-}
-
 namespace arangodb {
 namespace import {
 
@@ -164,6 +85,7 @@ ImportHelper::ImportHelper(ClientFeature const* client, std::string const& endpo
       _progress(false),
       _firstChunk(true),
       _ignoreMissing(false),
+      _parallelParsing(false),
       _numberLines(0),
       _rowsRead(0),
       _rowOffset(0),
@@ -267,6 +189,15 @@ bool ImportHelper::importDelimited(std::string const& collectionName,
     return false;
   }
 
+  if (_parallelParsing) {
+    bool ok = importDelimitedParallel(fd, totalLength, separator[0], typeImport);
+    TRI_Free(separator);
+    if (fd != STDIN_FILENO) {
+      TRI_CLOSE(fd);
+    }
+    return ok;
+  }
+
   TRI_csv_parser_t parser;
 
   TRI_InitCsvParser(&parser, ProcessCsvBegin, ProcessCsvAdd, ProcessCsvEnd, nullptr);
@@ -331,6 +262,106 @@ bool ImportHelper::importDelimited(std::string const& collectionName,
   return !_hasError;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief imports a delimited file, leaving the conversion of the records to
+/// the sender threads. the input is only cut into chunks of complete records
+/// here, so parsing scales with the number of threads
+////////////////////////////////////////////////////////////////////////////////
+
+bool ImportHelper::importDelimitedParallel(int fd, int64_t totalLength, char separator,
+                                           DelimitedImportType typeImport) {
+  CsvChunkParser::Options options;
+  options.separator = separator;
+  // in csv, we'll use the quote char if set
+  // in tsv, we do not use the quote char
+  options.useQuote = (typeImport == ImportHelper::CSV && _quote.size() > 0);
+  options.quote = options.useQuote ? _quote[0] : '\0';
+  options.useBackslash = _useBackslash;
+  options.convert = _convert;
+  options.ignoreMissing = _ignoreMissing;
+
+  CsvChunkParser::RecordScanner scanner(options);
+  _csvParser.reset();
+  _rowOffset = 0;
+  _rowsRead = 0;
+
+  // progress display control variables
+  int64_t totalRead = 0;
+  double nextProgress = ProgressStep;
+
+  char buffer[32768];
+  bool eof = false;
+
+  while (!_hasError && !eof) {
+    ssize_t n = TRI_READ(fd, buffer, sizeof(buffer));
+
+    if (n < 0) {
+      _errorMessages.push_back(TRI_LAST_ERROR_STR);
+      // the sender threads may still use the parser
+      waitForSenders();
+      return false;
+    } else if (n == 0) {
+      eof = true;
+      // make sure the last record is terminated
+      if (_outputBuffer.length() > 0 &&
+          _outputBuffer.c_str()[_outputBuffer.length() - 1] != '\n') {
+        _outputBuffer.appendChar('\n');
+      }
+    } else {
+      totalRead += static_cast<int64_t>(n);
+      reportProgress(totalLength, totalRead, nextProgress);
+      _outputBuffer.appendText(buffer, static_cast<size_t>(n));
+    }
+
+    // skip leading rows and read the header line, one record at a time
+    while (_csvParser == nullptr) {
+      scanner.scan(_outputBuffer.c_str(), _outputBuffer.length(), 1);
+      if (scanner.records() == 0) {
+        break;
+      }
+
+      if (_rowsRead >= _rowsToSkip) {
+        _columnNames = CsvChunkParser::splitRecord(options, _outputBuffer.c_str(),
+                                                   scanner.boundary());
+        _csvParser.reset(new CsvChunkParser(options, _columnNames,
+                                            _translations, _removeAttributes));
+      }
+      _outputBuffer.move_front(scanner.boundary());
+      scanner.consume();
+      ++_numberLines;
+      ++_rowsRead;
+      _rowOffset = _rowsRead;
+    }
+
+    if (_csvParser == nullptr) {
+      continue;
+    }
+
+    scanner.scan(_outputBuffer.c_str(), _outputBuffer.length());
+    if (scanner.records() > 0 && (eof || _outputBuffer.length() > _maxUploadSize)) {
+      sendCsvChunk(_outputBuffer.c_str(), scanner.boundary(), scanner.records());
+      _outputBuffer.move_front(scanner.boundary());
+      scanner.consume();
+    } else if (_outputBuffer.length() > MaxBatchSize) {
+      _errorMessages.push_back("unable to find the end of a record within " +
+                               std::to_string(MaxBatchSize) + " bytes of input");
+      _hasError = true;
+    }
+  }
+
+  if (!_hasError && eof && _outputBuffer.length() > 0) {
+    // unterminated quoted field at the end of the input
+    MUTEX_LOCKER(guard, _stats._mutex);
+    ++_stats._numberErrors;
+  }
+
+  waitForSenders();
+  reportProgress(totalLength, totalRead, nextProgress);
+
+  _outputBuffer.clear();
+  return !_hasError;
+}
+
 bool ImportHelper::importJson(std::string const& collectionName,
                               std::string const& fileName, bool assumeLinewise) {
   _collectionName = collectionName;
@@ -598,46 +629,26 @@ void ImportHelper::addField(char const* field, size_t fieldLength, size_t row,
   }
 
   if (_convert) {
-    if (IsInteger(field, fieldLength)) {
+    if (CsvChunkParser::isInteger(field, fieldLength)) {
       // integer value
       // conversion might fail with out-of-range error
-      try {
-        if (fieldLength > 8) {
-          // long integer numbers might be problematic. check if we get out of
-          // range
-          (void)std::stoll(std::string(field,
-                                       fieldLength));  // this will fail if the
-                                                       // number cannot be
-                                                       // converted
-        }
-
-        int64_t num = StringUtils::int64(field, fieldLength);
+      int64_t num;
+      if (CsvChunkParser::toInteger(field, fieldLength, num)) {
         _lineBuffer.appendInteger(num);
-      } catch (...) {
+      } else {
         // conversion failed
         _lineBuffer.appendJsonEncoded(field, fieldLength);
       }
-    } else if (IsDecimal(field, fieldLength)) {
+    } else if (CsvChunkParser::isDecimal(field, fieldLength)) {
       // double value
       // conversion might fail with out-of-range error
-      try {
-        std::string tmp(field, fieldLength);
-        size_t pos = 0;
-        double num = std::stod(tmp, &pos);
-        if (pos == fieldLength) {
-          bool failed = (num != num || num == HUGE_VAL || num == -HUGE_VAL);
-          if (!failed) {
-            _lineBuffer.appendDecimal(num);
-            return;
-          }
-        }
-        // NaN, +inf, -inf
-        // fall-through to appending the number as a string
-      } catch (...) {
-        // conversion failed
-        // fall-through to appending the number as a string
+      double num;
+      if (CsvChunkParser::toDouble(field, fieldLength, num)) {
+        _lineBuffer.appendDecimal(num);
+        return;
       }
-
+      // NaN, +inf, -inf or conversion failed
+      // fall-through to appending the number as a string
       _lineBuffer.appendChar('"');
       _lineBuffer.appendText(field, fieldLength);
       _lineBuffer.appendChar('"');
@@ -645,7 +656,8 @@ void ImportHelper::addField(char const* field, size_t fieldLength, size_t row,
       _lineBuffer.appendJsonEncoded(field, fieldLength);
     }
   } else {
-    if (IsInteger(field, fieldLength) || IsDecimal(field, fieldLength)) {
+    if (CsvChunkParser::isInteger(field, fieldLength) ||
+        CsvChunkParser::isDecimal(field, fieldLength)) {
       // numeric value. don't convert
       _lineBuffer.appendChar('"');
       _lineBuffer.appendText(field, fieldLength);
@@ -865,6 +877,40 @@ void ImportHelper::sendCsvBuffer() {
   _rowOffset = _rowsRead;
 }
 
+void ImportHelper::sendCsvChunk(char const* data, size_t length, size_t records) {
+  if (_hasError) {
+    return;
+  }
+
+  // no type parameter: the request body is a VelocyPack array of documents
+  std::string url("/_api/import?" + getCollectionUrlPart() +
+                  "&line=" + StringUtils::itoa(_rowOffset) +
+                  "&details=true&onDuplicate=" + StringUtils::urlEncode(_onDuplicateAction));
+
+  if (!_fromCollectionPrefix.empty()) {
+    url += "&fromPrefix=" + StringUtils::urlEncode(_fromCollectionPrefix);
+  }
+  if (!_toCollectionPrefix.empty()) {
+    url += "&toPrefix=" + StringUtils::urlEncode(_toCollectionPrefix);
+  }
+  if (_firstChunk && _overwrite) {
+    truncateCollection();
+  }
+  _firstChunk = false;
+
+  SenderThread* t = findIdleSender();
+  if (t != nullptr) {
+    _tempBuffer.reset();
+    _tempBuffer.appendText(data, length);
+    t->sendChunk(url, &_tempBuffer, _csvParser.get(), _rowOffset);
+    addPeriodByteCount(length + url.length());
+  }
+
+  _numberLines += records;
+  _rowsRead += records;
+  _rowOffset = _rowsRead;
+}
+
 void ImportHelper::sendJsonBuffer(char const* str, size_t len, bool isObject) {
   if (_hasError) {
     return;
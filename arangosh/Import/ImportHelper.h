@@ -55,6 +55,7 @@ struct SimpleHttpClientParams;
 
 namespace arangodb {
 namespace import {
+class CsvChunkParser;
 class SenderThread;
 
 struct ImportStatistics {
@@ -192,6 +193,13 @@ class ImportHelper {
 
   void setConversion(bool value) { _convert = value; }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether or not CSV/TSV input is converted to VelocyPack in the
+  /// sender threads instead of the reading thread
+  //////////////////////////////////////////////////////////////////////////////
+
+  void setParallelParsing(bool value) { _parallelParsing = value; }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief set the progress indicator
   //////////////////////////////////////////////////////////////////////////////
@@ -279,7 +287,11 @@ class ImportHelper {
   bool checkCreateCollection();
   bool truncateCollection();
 
+  bool importDelimitedParallel(int fd, int64_t totalLength, char separator,
+                               DelimitedImportType typeImport);
+
   void sendCsvBuffer();
+  void sendCsvChunk(char const* data, size_t length, size_t records);
   void sendJsonBuffer(char const* str, size_t len, bool isObject);
   SenderThread* findIdleSender();
   void waitForSenders();
@@ -305,6 +317,7 @@ class ImportHelper {
   bool _progress;
   bool _firstChunk;
   bool _ignoreMissing;
+  bool _parallelParsing;
 
   size_t _numberLines;
   ImportStatistics _stats;
@@ -323,6 +336,7 @@ class ImportHelper {
   arangodb::basics::StringBuffer _outputBuffer;
   std::string _firstLine;
   std::vector<std::string> _columnNames;
+  std::unique_ptr<CsvChunkParser> _csvParser;
 
   std::unordered_map<std::string, std::string> _translations;
   std::unordered_set<std::string> _removeAttributes;
@@ -27,7 +27,9 @@
 #include "Basics/MutexLocker.h"
 #include "Basics/StringBuffer.h"
 #include "Basics/StringUtils.h"
+#include "Basics/StaticStrings.h"
 #include "Basics/VelocyPackHelper.h"
+#include "CsvChunkParser.h"
 #include "ImportHelper.h"
 #include "SimpleHttpClient/SimpleHttpClient.h"
 #include "SimpleHttpClient/SimpleHttpResult.h"
@@ -47,6 +49,8 @@ SenderThread::SenderThread(std::unique_ptr<httpclient::SimpleHttpClient> client,
       _client(std::move(client)),
       _wakeup(wakeup),
       _data(false),
+      _parser(nullptr),
+      _firstLine(0),
       _hasError(false),
       _idle(true),
       _ready(false),
@@ -73,6 +77,20 @@ void SenderThread::sendData(std::string const& url, arangodb::basics::StringBuff
   guard.broadcast();
 }
 
+void SenderThread::sendChunk(std::string const& url, arangodb::basics::StringBuffer* data,
+                             CsvChunkParser const* parser, size_t firstLine) {
+  TRI_ASSERT(_idle && !_hasError);
+  _url = url;
+  _data.swap(data);
+  _parser = parser;
+  _firstLine = firstLine;
+
+  // wake up the thread that may be waiting in run()
+  CONDITION_LOCKER(guard, _condition);
+  _idle = false;
+  guard.broadcast();
+}
+
 bool SenderThread::hasError() {
   CONDITION_LOCKER(guard, _condition);
   return _hasError;
@@ -109,7 +127,9 @@ void SenderThread::run() {
       if (_data.length() > 0) {
         TRI_ASSERT(!_idle && !_url.empty());
 
-        {
+        if (_parser != nullptr) {
+          sendChunkData();
+        } else {
           QuickHistogramTimer timer(_stats->_histogram);
           std::unique_ptr<httpclient::SimpleHttpResult> result(
               _client->request(rest::RequestType::POST, _url, _data.c_str(),
@@ -120,6 +140,7 @@ void SenderThread::run() {
 
         _url.clear();
         _data.reset();
+        _parser = nullptr;
       }
 
       CONDITION_LOCKER(guard, _condition);
@@ -137,6 +158,35 @@ void SenderThread::run() {
   TRI_ASSERT(_idle);
 }
 
+void SenderThread::sendChunkData() {
+  std::vector<std::string> errors;
+  _builder.clear();
+  size_t const failed = _parser->parse(_data.c_str(), _data.length(), _firstLine, _builder, errors);
+
+  for (auto const& error : errors) {
+    LOG_TOPIC("4b2d7", WARN, arangodb::Logger::FIXME) << error;
+  }
+  if (failed > 0) {
+    MUTEX_LOCKER(guard, _stats->_mutex);
+    _stats->_numberErrors += failed;
+  }
+
+  VPackSlice const documents = _builder.slice();
+  if (documents.length() == 0) {
+    return;
+  }
+
+  std::unordered_map<std::string, std::string> headers;
+  headers.emplace(StaticStrings::ContentTypeHeader, StaticStrings::MimeTypeVPack);
+
+  QuickHistogramTimer timer(_stats->_histogram);
+  std::unique_ptr<httpclient::SimpleHttpResult> result(
+      _client->request(rest::RequestType::POST, _url, documents.startAs<char>(),
+                       documents.byteSize(), headers));
+
+  handleResult(result.get());
+}
+
 void SenderThread::handleResult(httpclient::SimpleHttpResult* result) {
   if (result == nullptr) {
     return;
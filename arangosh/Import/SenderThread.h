@@ -28,6 +28,8 @@
 #include "Basics/Thread.h"
 #include "SimpleHttpClient/SimpleHttpClient.h"
 
+#include <velocypack/Builder.h>
+
 namespace arangodb {
 namespace basics {
 class StringBuffer;
@@ -38,6 +40,7 @@ class SimpleHttpResult;
 }  // namespace httpclient
 
 namespace import {
+class CsvChunkParser;
 struct ImportStatistics;
 
 class SenderThread final : public arangodb::Thread {
@@ -57,6 +60,11 @@ class SenderThread final : public arangodb::Thread {
 
   void sendData(std::string const& url, basics::StringBuffer* sender);
 
+  /// @brief converts a chunk of CSV records with the given parser in this
+  /// thread and sends the documents as VelocyPack
+  void sendChunk(std::string const& url, basics::StringBuffer* data,
+                 CsvChunkParser const* parser, size_t firstLine);
+
   bool hasError();
   /// Ready to start sending
   bool isReady();
@@ -77,6 +85,9 @@ class SenderThread final : public arangodb::Thread {
   std::function<void()> _wakeup;
   std::string _url;
   basics::StringBuffer _data;
+  CsvChunkParser const* _parser;
+  size_t _firstLine;
+  velocypack::Builder _builder;
   bool _hasError;
   bool _idle;
   bool _ready;
@@ -84,6 +95,7 @@ class SenderThread final : public arangodb::Thread {
   ImportStatistics* _stats;
   std::string _errorMessage;
   void handleResult(httpclient::SimpleHttpResult* result);
+  void sendChunkData();
 };
 }  // namespace import
 }  // namespace arangodb
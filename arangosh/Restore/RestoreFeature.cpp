@@ -34,8 +34,10 @@
 #include <thread>
 
 #include "ApplicationFeatures/ApplicationServer.h"
+#include "Basics/ConditionLocker.h"
 #include "Basics/FileUtils.h"
 #include "Basics/Result.h"
+#include "Basics/ScopeGuard.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/StringUtils.h"
 #include "Basics/VelocyPackHelper.h"
@@ -46,6 +48,7 @@
 #include "SimpleHttpClient/SimpleHttpClient.h"
 #include "SimpleHttpClient/SimpleHttpResult.h"
 #include "Ssl/SslInterface.h"
+#include "Utils/DumpChunkFile.h"
 
 #ifdef USE_ENTERPRISE
 #include "Enterprise/Encryption/EncryptionFeature.h"
@@ -56,6 +59,10 @@ namespace {
 /// @brief name of the feature to report to application server
 constexpr auto FeatureName = "Restore";
 
+/// @brief bounds for the batch size when auto-tuning is enabled
+constexpr uint64_t MinAutoTuneBatchSize = 1024 * 128;
+constexpr uint64_t MaxAutoTuneBatchSize = 1024 * 1024 * 64;
+
 /// @brief return the target replication factor for the specified collection
 uint64_t getReplicationFactor(arangodb::RestoreFeature::Options const& options,
                               arangodb::velocypack::Slice const& slice, bool& isSatellite) {
@@ -438,7 +445,8 @@ arangodb::Result sendRestoreIndexes(arangodb::httpclient::SimpleHttpClient& http
 arangodb::Result sendRestoreData(arangodb::httpclient::SimpleHttpClient& httpClient,
                                  arangodb::RestoreFeature::Options const& options,
                                  std::string const& cname, char const* buffer,
-                                 size_t bufferSize) {
+                                 size_t bufferSize, bool isVPack = false,
+                                 bool bulk = false) {
   using arangodb::basics::StringUtils::urlEncode;
   using arangodb::httpclient::SimpleHttpResult;
 
@@ -446,7 +454,9 @@ arangodb::Result sendRestoreData(arangodb::httpclient::SimpleHttpClient& httpCli
   arangodb::velocypack::Builder result;
   arangodb::basics::StringBuffer cleaned;
 
-  if (options.cleanupDuplicateAttributes) {
+  // binary dumps were created from the stored documents, which cannot
+  // contain duplicate attributes
+  if (options.cleanupDuplicateAttributes && !isVPack) {
     int res = cleaned.reserve(bufferSize);
 
     if (res != TRI_ERROR_NO_ERROR) {
@@ -511,14 +521,98 @@ arangodb::Result sendRestoreData(arangodb::httpclient::SimpleHttpClient& httpCli
     bufferSize = cleaned.length();
   }
 
-  std::string const url = "/_api/replication/restore-data?collection=" + urlEncode(cname) +
-                          "&force=" + (options.force ? "true" : "false");
+  std::string url = "/_api/replication/restore-data?collection=" + urlEncode(cname) +
+                    "&force=" + (options.force ? "true" : "false");
+  if (bulk) {
+    url += "&bulk=true";
+  }
 
+  std::unordered_map<std::string, std::string> headers;
+  if (isVPack) {
+    headers.emplace(arangodb::StaticStrings::ContentTypeHeader,
+                    arangodb::StaticStrings::MimeTypeVPack);
+  }
   std::unique_ptr<SimpleHttpResult> response(
-      httpClient.request(arangodb::rest::RequestType::PUT, url, buffer, bufferSize));
+      httpClient.request(arangodb::rest::RequestType::PUT, url, buffer, bufferSize, headers));
   return ::checkHttpResponse(httpClient, response, "restoring data", "");
 }
 
+/// @brief Send a batch of data, and adjust the batch size of the data file
+/// to keep the server's response times between 0.5 and 2 seconds if
+/// auto-tuning is enabled
+arangodb::Result sendBatch(arangodb::httpclient::SimpleHttpClient& httpClient,
+                           arangodb::RestoreFeature::Options const& options,
+                           arangodb::RestoreFeature::Stats& stats,
+                           arangodb::RestoreFeature::SendState& state,
+                           std::string const& cname, char const* buffer,
+                           size_t bufferSize, bool isVPack, bool bulk) {
+  stats.totalBatches++;
+  double const start = TRI_microtime();
+  arangodb::Result result =
+      ::sendRestoreData(httpClient, options, cname, buffer, bufferSize, isVPack, bulk);
+  if (bulk && result.is(TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED)) {
+    // the data file contains a key more than once (e.g. an MMFiles dump).
+    // nothing of the batch was written, so send it again the regular way
+    result = ::sendRestoreData(httpClient, options, cname, buffer, bufferSize, isVPack, false);
+  }
+  stats.totalSent += bufferSize;
+
+  if (options.autoTuneBatchSize && result.ok()) {
+    double const duration = TRI_microtime() - start;
+    uint64_t current = state.chunkSize.load();
+    uint64_t next = current;
+    if (duration < 0.5) {
+      next = std::min(current + current / 2, ::MaxAutoTuneBatchSize);
+    } else if (duration > 2.0) {
+      next = std::max(current / 2, ::MinAutoTuneBatchSize);
+    }
+    // another sender may have adjusted the size in the meantime, which is
+    // just as good
+    state.chunkSize.compare_exchange_strong(current, next);
+  }
+  return result;
+}
+
+/// @brief Send a batch of a data file. with multiple senders per collection,
+/// the batch is queued for the senders, and the caller only waits if too
+/// many batches of the file are in flight already
+arangodb::Result dispatchBatch(arangodb::httpclient::SimpleHttpClient& httpClient,
+                               arangodb::RestoreFeature::JobData& jobData,
+                               arangodb::RestoreFeature::SendState& state,
+                               std::string const& cname, char const* buffer,
+                               size_t bufferSize, bool isVPack, bool bulk, bool concurrent) {
+  if (!concurrent) {
+    return ::sendBatch(httpClient, jobData.options, jobData.stats, state, cname,
+                       buffer, bufferSize, isVPack, bulk);
+  }
+
+  {
+    CONDITION_LOCKER(guard, state.condition);
+    while (state.inFlight >= jobData.options.sendersPerCollection && state.error.ok()) {
+      guard.wait(std::chrono::milliseconds(100));
+    }
+    if (state.error.fail()) {
+      return state.error;
+    }
+    ++state.inFlight;
+  }
+
+  using BatchData = arangodb::RestoreFeature::BatchData;
+  jobData.feature.queueBatch(std::unique_ptr<BatchData>(
+      new BatchData{jobData.options, jobData.stats, state, cname,
+                    std::string(buffer, bufferSize), isVPack, bulk}));
+  return {};
+}
+
+/// @brief Wait until all queued batches of a data file have been sent
+arangodb::Result waitForBatches(arangodb::RestoreFeature::SendState& state) {
+  CONDITION_LOCKER(guard, state.condition);
+  while (state.inFlight > 0) {
+    guard.wait(std::chrono::milliseconds(100));
+  }
+  return state.error;
+}
+
 /// @brief Recreate a collection given its description
 arangodb::Result recreateCollection(arangodb::httpclient::SimpleHttpClient& httpClient,
                                     arangodb::RestoreFeature::JobData& jobData) {
@@ -601,41 +695,24 @@ arangodb::Result restoreIndexes(arangodb::httpclient::SimpleHttpClient& httpClie
   return result;
 }
 
-/// @brief Restore the data for a given collection
-arangodb::Result restoreData(arangodb::httpclient::SimpleHttpClient& httpClient,
-                             arangodb::RestoreFeature::JobData& jobData) {
+/// @brief Restore the data of a single data file into a collection
+arangodb::Result restoreDataFile(arangodb::httpclient::SimpleHttpClient& httpClient,
+                                 arangodb::RestoreFeature::JobData& jobData,
+                                 std::string const& cname, std::string const& collectionType,
+                                 arangodb::ManagedDirectory::File* datafile,
+                                 bool bulk = false, bool ordered = false) {
   using arangodb::Logger;
   using arangodb::basics::StringBuffer;
 
   arangodb::Result result;
   StringBuffer buffer(true);
 
-  VPackSlice const parameters = jobData.collection.get("parameters");
-  std::string const cname =
-      arangodb::basics::VelocyPackHelper::getStringValue(parameters, "name", "");
-  int type = arangodb::basics::VelocyPackHelper::getNumericValue<int>(parameters,
-                                                                      "type", 2);
-  std::string const collectionType(type == 2 ? "document" : "edge");
+  // batches of a file can be sent concurrently unless they have to be
+  // applied in order
+  bool const concurrent = !ordered && jobData.options.sendersPerCollection > 1;
+  arangodb::RestoreFeature::SendState state(jobData.options.chunkSize);
+  TRI_DEFER(::waitForBatches(state));
 
-  // import data. check if we have a datafile
-  //  ... there are 4 possible names
-  auto datafile = jobData.directory.readableFile(
-      cname + "_" + arangodb::rest::SslInterface::sslMD5(cname) + ".data.json");
-  if (!datafile || datafile->status().fail()) {
-    datafile = jobData.directory.readableFile(
-      cname + "_" + arangodb::rest::SslInterface::sslMD5(cname) + ".data.json.gz");
-  }
-  if (!datafile || datafile->status().fail()) {
-    datafile = jobData.directory.readableFile(cname + ".data.json.gz");
-  } 
-  if (!datafile || datafile->status().fail()) {
-    datafile = jobData.directory.readableFile(cname + ".data.json");
-  }
-  if (!datafile || datafile->status().fail()) {
-    result = {TRI_ERROR_CANNOT_READ_FILE, "could not open data file for collection '" + cname + "'"};
-    return result;
-  }
-  
   int64_t const fileSize = TRI_SizeFile(datafile->path().c_str());
 
   if (jobData.options.progress) {
@@ -667,7 +744,7 @@ arangodb::Result restoreData(arangodb::httpclient::SimpleHttpClient& httpClient,
     numReadForThisCollection += numRead;
     numReadSinceLastReport += numRead;
 
-    if (buffer.length() < jobData.options.chunkSize && numRead > 0) {
+    if (buffer.length() < state.chunkSize.load() && numRead > 0) {
       continue;  // still continue reading
     }
 
@@ -688,12 +765,11 @@ arangodb::Result restoreData(arangodb::httpclient::SimpleHttpClient& httpClient,
         length = found - buffer.begin();  // found a \n somewhere; break at line
       }
 
-      jobData.stats.totalBatches++;
-      result = ::sendRestoreData(httpClient, jobData.options, cname, buffer.begin(), length);
-      jobData.stats.totalSent += length;
+      result = ::dispatchBatch(httpClient, jobData, state, cname, buffer.begin(),
+                               length, false, bulk, concurrent);
 
       if (result.fail()) {
-        if (jobData.options.force) {
+        if (jobData.options.force && !concurrent) {
           LOG_TOPIC("a595a", WARN, Logger::RESTORE)
               << "Error while restoring data into collection '" << cname
               << "': " << result.errorMessage();
@@ -736,9 +812,265 @@ arangodb::Result restoreData(arangodb::httpclient::SimpleHttpClient& httpClient,
     }
   }
 
+  if (concurrent) {
+    result = ::waitForBatches(state);
+  }
   return result;
 }
 
+/// @brief Restore the data of a binary data file into a collection. the
+/// decompressed chunks are sent to the server as VelocyPack, without
+/// parsing them on the client
+arangodb::Result restoreBinaryDataFile(arangodb::httpclient::SimpleHttpClient& httpClient,
+                                       arangodb::RestoreFeature::JobData& jobData,
+                                       std::string const& cname,
+                                       std::string const& collectionType,
+                                       arangodb::ManagedDirectory::File* datafile,
+                                       bool bulk) {
+  using arangodb::Logger;
+
+  int64_t const fileSize = TRI_SizeFile(datafile->path().c_str());
+
+  bool const concurrent = jobData.options.sendersPerCollection > 1;
+  arangodb::RestoreFeature::SendState state(jobData.options.chunkSize);
+  TRI_DEFER(::waitForBatches(state));
+
+  if (jobData.options.progress) {
+    LOG_TOPIC("1f3a9", INFO, Logger::RESTORE)
+        << "# Loading data into " << collectionType << " collection '" << cname
+        << "', data size: " << fileSize << " byte(s)";
+  }
+
+  arangodb::dumpchunks::Reader reader(*datafile);
+  std::string buffer;
+  std::string chunk;
+  uint64_t lastReport = 0;
+
+  while (true) {
+    arangodb::Result result = reader.next(chunk);
+    if (result.fail()) {
+      return result;
+    }
+    jobData.stats.totalRead += chunk.size();
+    buffer.append(chunk);
+
+    if (buffer.empty() || (buffer.size() < state.chunkSize.load() && !chunk.empty())) {
+      if (chunk.empty()) {
+        break;  // EOF
+      }
+      continue;
+    }
+
+    result = ::dispatchBatch(httpClient, jobData, state, cname, buffer.data(),
+                             buffer.size(), /*isVPack*/ true, bulk, concurrent);
+    buffer.clear();
+
+    if (result.fail()) {
+      if (jobData.options.force && !concurrent) {
+        LOG_TOPIC("2a1c7", WARN, Logger::RESTORE)
+            << "Error while restoring data into collection '" << cname
+            << "': " << result.errorMessage();
+      } else {
+        LOG_TOPIC("c8b40", ERR, Logger::RESTORE)
+            << "Error while restoring data into collection '" << cname
+            << "': " << result.errorMessage();
+        return result;
+      }
+    }
+
+    if (jobData.options.progress && fileSize > 0 &&
+        reader.bytesRead() - lastReport > 1024 * 1024 * 8) {
+      // report every 8MB of processed data
+      LOG_TOPIC("b9e3d", INFO, Logger::RESTORE)
+          << "# Still loading data into " << collectionType << " collection '"
+          << cname << "', " << reader.bytesRead() << " of " << fileSize
+          << " byte(s) restored ("
+          << int(100. * double(reader.bytesRead()) / double(fileSize)) << " %)";
+      lastReport = reader.bytesRead();
+    }
+
+    if (chunk.empty()) {
+      break;  // EOF
+    }
+  }
+
+  if (concurrent) {
+    return ::waitForBatches(state);
+  }
+  return {};
+}
+
+/// @brief Restore the data for a given collection
+arangodb::Result restoreData(arangodb::httpclient::SimpleHttpClient& httpClient,
+                             arangodb::RestoreFeature::JobData& jobData) {
+  VPackSlice const parameters = jobData.collection.get("parameters");
+  std::string const cname =
+      arangodb::basics::VelocyPackHelper::getStringValue(parameters, "name", "");
+  int type = arangodb::basics::VelocyPackHelper::getNumericValue<int>(parameters,
+                                                                      "type", 2);
+  std::string const collectionType(type == 2 ? "document" : "edge");
+
+  std::string const baseName = cname + "_" + arangodb::rest::SslInterface::sslMD5(cname);
+
+  // collections created by this restore are empty, and the data files of a
+  // dump contain every key once, so the server can take the bulk path
+  bool const bulk = jobData.options.importStructure;
+
+  // binary data files are written by arangodump --binary-output, a
+  // partitioned dump has one file per key range
+  if (TRI_ExistsFile(arangodb::basics::FileUtils::buildFilename(
+                         jobData.directory.path(), baseName + arangodb::dumpchunks::DataFileSuffix)
+                         .c_str())) {
+    arangodb::Result result;
+    for (uint64_t partition = 0; result.ok(); ++partition) {
+      std::string const name =
+          (partition == 0 ? baseName : baseName + "." + std::to_string(partition)) +
+          arangodb::dumpchunks::DataFileSuffix;
+      if (partition > 0 &&
+          !TRI_ExistsFile(arangodb::basics::FileUtils::buildFilename(jobData.directory.path(), name)
+                              .c_str())) {
+        break;
+      }
+      auto datafile = jobData.directory.readableFile(name);
+      if (!datafile || datafile->status().fail()) {
+        return {TRI_ERROR_CANNOT_READ_FILE,
+                "could not open data file '" + name + "' for collection '" + cname + "'"};
+      }
+      result = ::restoreBinaryDataFile(httpClient, jobData, cname, collectionType,
+                                       datafile.get(), bulk);
+    }
+    return result;
+  }
+
+  // import data. check if we have a datafile
+  //  ... there are 4 possible names
+  auto datafile = jobData.directory.readableFile(
+      cname + "_" + arangodb::rest::SslInterface::sslMD5(cname) + ".data.json");
+  if (!datafile || datafile->status().fail()) {
+    datafile = jobData.directory.readableFile(
+      cname + "_" + arangodb::rest::SslInterface::sslMD5(cname) + ".data.json.gz");
+  }
+  if (!datafile || datafile->status().fail()) {
+    datafile = jobData.directory.readableFile(cname + ".data.json.gz");
+  } 
+  if (!datafile || datafile->status().fail()) {
+    datafile = jobData.directory.readableFile(cname + ".data.json");
+  }
+  if (!datafile || datafile->status().fail()) {
+    return {TRI_ERROR_CANNOT_READ_FILE, "could not open data file for collection '" + cname + "'"};
+  }
+
+  arangodb::Result result =
+      ::restoreDataFile(httpClient, jobData, cname, collectionType, datafile.get(), bulk);
+
+  // arangodump may have written additional key ranges of the collection
+  // into separate files, named <collection>_<hash>.<partition>.data.json
+  for (uint64_t partition = 1; result.ok(); ++partition) {
+    std::string const name = cname + "_" + arangodb::rest::SslInterface::sslMD5(cname) +
+                             "." + std::to_string(partition) + ".data.json";
+    std::string const path =
+        arangodb::basics::FileUtils::buildFilename(jobData.directory.path(), name);
+    if (TRI_ExistsFile(path.c_str())) {
+      datafile = jobData.directory.readableFile(name);
+    } else if (TRI_ExistsFile((path + ".gz").c_str())) {
+      datafile = jobData.directory.readableFile(name + ".gz");
+    } else {
+      break;
+    }
+    if (!datafile || datafile->status().fail()) {
+      return {TRI_ERROR_CANNOT_READ_FILE,
+              "could not open data file '" + name + "' for collection '" + cname + "'"};
+    }
+    result = ::restoreDataFile(httpClient, jobData, cname, collectionType,
+                               datafile.get(), bulk);
+  }
+
+  return result;
+}
+
+/// @brief Read the tick up to which a dump directory contains data
+uint64_t lastDumpTick(arangodb::ManagedDirectory& directory) {
+  try {
+    VPackBuilder meta = directory.vpackFromJsonFile("dump.json");
+    return arangodb::basics::VelocyPackHelper::stringUInt64(meta.slice(),
+                                                            "lastTickAtDumpStart");
+  } catch (...) {
+    return 0;
+  }
+}
+
+/// @brief Apply the change logs of an incremental dump on top of previously
+/// restored data. lastTick is the tick of the previous dump in the chain and
+/// is advanced to the tick of this dump
+arangodb::Result restoreIncrementalDump(arangodb::httpclient::SimpleHttpClient& httpClient,
+                                        arangodb::RestoreFeature& feature,
+                                        arangodb::RestoreFeature::Options const& options,
+                                        arangodb::RestoreFeature::Stats& stats,
+                                        arangodb::ManagedDirectory& directory,
+                                        uint64_t& lastTick) {
+  using arangodb::Logger;
+  using arangodb::basics::VelocyPackHelper;
+
+  VPackBuilder meta;
+  try {
+    meta = directory.vpackFromJsonFile("dump.json");
+  } catch (...) {
+  }
+  VPackSlice const incremental =
+      meta.slice().isObject() ? meta.slice().get("incremental") : VPackSlice::noneSlice();
+  if (!incremental.isObject() || !incremental.get("changes").isArray()) {
+    return {TRI_ERROR_BAD_PARAMETER,
+            "'" + directory.path() + "' does not contain an incremental dump"};
+  }
+
+  // the dumps of a chain have to follow each other without gaps
+  uint64_t const tickStart = VelocyPackHelper::stringUInt64(incremental, "tickStart");
+  if (tickStart != lastTick) {
+    arangodb::Result res{TRI_ERROR_BAD_PARAMETER,
+                         "incremental dump in '" + directory.path() + "' starts at tick " +
+                             std::to_string(tickStart) + ", but the previous dump ends at tick " +
+                             std::to_string(lastTick)};
+    if (!options.force) {
+      return res;
+    }
+    LOG_TOPIC("ec6a9", WARN, Logger::RESTORE) << res.errorMessage();
+  }
+
+  if (options.progress) {
+    LOG_TOPIC("7a1d2", INFO, Logger::RESTORE)
+        << "# Applying incremental dump '" << directory.path() << "'...";
+  }
+
+  for (VPackSlice changes : VPackArrayIterator(incremental.get("changes"))) {
+    std::string const name = VelocyPackHelper::getStringValue(changes, "collection", "");
+    if (!options.collections.empty() &&
+        std::find(options.collections.begin(), options.collections.end(),
+                  name) == options.collections.end()) {
+      continue;
+    }
+
+    std::string const filename = VelocyPackHelper::getStringValue(changes, "file", "");
+    auto datafile = directory.readableFile(filename);
+    if (!datafile || datafile->status().fail()) {
+      return {TRI_ERROR_CANNOT_READ_FILE,
+              "cannot read change log '" + filename + "' of collection '" + name + "'"};
+    }
+
+    // the change logs use the same format as regular data files
+    arangodb::RestoreFeature::JobData jobData(directory, feature, options, stats, changes);
+    arangodb::Result res =
+        ::restoreDataFile(httpClient, jobData, name,
+                          VelocyPackHelper::getStringValue(changes, "type", "document"),
+                          datafile.get(), /*bulk*/ false, /*ordered*/ true);
+    if (res.fail()) {
+      return res;
+    }
+  }
+
+  lastTick = ::lastDumpTick(directory);
+  return {};
+}
+
 /// @brief Restore the data for a given view
 arangodb::Result restoreView(arangodb::httpclient::SimpleHttpClient& httpClient,
                              arangodb::RestoreFeature::Options const& options,
@@ -1055,6 +1387,51 @@ arangodb::Result processJob(arangodb::httpclient::SimpleHttpClient& httpClient,
   return result;
 }
 
+/// @brief send a single batch queued by a restore job
+arangodb::Result processBatch(arangodb::httpclient::SimpleHttpClient& httpClient,
+                              arangodb::RestoreFeature::BatchData& batch) {
+  using arangodb::Logger;
+
+  arangodb::Result result;
+  try {
+    result = ::sendBatch(httpClient, batch.options, batch.stats, batch.state,
+                         batch.cname, batch.payload.data(), batch.payload.size(),
+                         batch.isVPack, batch.bulk);
+  } catch (arangodb::basics::Exception const& ex) {
+    result = {ex.code(), ex.what()};
+  } catch (std::exception const& ex) {
+    result = {TRI_ERROR_INTERNAL, ex.what()};
+  } catch (...) {
+    result = {TRI_ERROR_INTERNAL};
+  }
+
+  if (result.fail()) {
+    if (batch.options.force) {
+      LOG_TOPIC("d71c0", WARN, Logger::RESTORE)
+          << "Error while restoring data into collection '" << batch.cname
+          << "': " << result.errorMessage();
+      result.reset();
+    } else {
+      LOG_TOPIC("3c5f2", ERR, Logger::RESTORE)
+          << "Error while restoring data into collection '" << batch.cname
+          << "': " << result.errorMessage();
+    }
+  }
+
+  // the job waiting for its batches is notified via the send state
+  CONDITION_LOCKER(guard, batch.state.condition);
+  if (result.fail() && batch.state.error.ok()) {
+    batch.state.error = result;
+  }
+  --batch.state.inFlight;
+  guard.broadcast();
+  return result;
+}
+
+/// @brief batch errors are handled by the job that queued the batch
+void handleBatchResult(std::unique_ptr<arangodb::RestoreFeature::BatchData>&&,
+                       arangodb::Result const&) {}
+
 /// @brief handle the result of a single job
 void handleJobResult(std::unique_ptr<arangodb::RestoreFeature::JobData>&& jobData,
                      arangodb::Result const& result) {
@@ -1076,6 +1453,7 @@ RestoreFeature::RestoreFeature(application_features::ApplicationServer& server,
     : ApplicationFeature(server, RestoreFeature::featureName()),
       _clientManager{Logger::RESTORE},
       _clientTaskQueue{::processJob, ::handleJobResult},
+      _batchQueue{::processBatch, ::handleBatchResult},
       _exitCode{exitCode} {
   requiresElevatedPrivileges(false);
   setOptional(false);
@@ -1115,6 +1493,17 @@ void RestoreFeature::collectOptions(std::shared_ptr<options::ProgramOptions> opt
                   new UInt32Parameter(&_options.threadCount))
       .setIntroducedIn(30400);
 
+  options->addOption(
+      "--senders-per-collection",
+      "number of data batches of a single collection to send in parallel",
+      new UInt32Parameter(&_options.sendersPerCollection));
+
+  options->addOption(
+      "--auto-tune-batch-size",
+      "adjust the batch size to the server's response times, starting with "
+      "--batch-size",
+      new BooleanParameter(&_options.autoTuneBatchSize));
+
   options->addOption("--include-system-collections",
                      "include system collections",
                      new BooleanParameter(&_options.includeSystemCollections));
@@ -1136,6 +1525,12 @@ void RestoreFeature::collectOptions(std::shared_ptr<options::ProgramOptions> opt
   options->addOption("--input-directory", "input directory",
                      new StringParameter(&_options.inputPath));
 
+  options->addOption(
+      "--incremental-input-directory",
+      "directory of an incremental dump to apply after restoring the input "
+      "directory (can be specified multiple times, in dump order)",
+      new VectorParameter<StringParameter>(&_options.incrementalPaths));
+
   options
       ->addOption(
           "--cleanup-duplicate-attributes",
@@ -1244,6 +1639,13 @@ void RestoreFeature::validateOptions(std::shared_ptr<options::ProgramOptions> op
     _options.threadCount = clamped;
   }
 
+  clamped = boost::algorithm::clamp(_options.sendersPerCollection, uint32_t(1), uint32_t(16));
+  if (_options.sendersPerCollection != clamped) {
+    LOG_TOPIC("9d3b8", WARN, Logger::RESTORE)
+        << "capping --senders-per-collection value to " << clamped;
+    _options.sendersPerCollection = clamped;
+  }
+
   // validate shards and replication factor
   if (_options.defaultNumberOfShards == 0) {
     LOG_TOPIC("248ee", FATAL, arangodb::Logger::RESTORE)
@@ -1437,6 +1839,10 @@ void RestoreFeature::start() {
 
   // set up threads and workers
   _clientTaskQueue.spawnWorkers(_clientManager, _options.threadCount);
+  if (_options.sendersPerCollection > 1) {
+    _batchQueue.spawnWorkers(_clientManager,
+                             _options.threadCount * _options.sendersPerCollection);
+  }
 
   LOG_TOPIC("6bb3c", DEBUG, Logger::RESTORE) << "Using " << _options.threadCount << " worker thread(s)";
 
@@ -1511,6 +1917,23 @@ void RestoreFeature::start() {
     try {
       result = ::processInputDirectory(*httpClient, _clientTaskQueue, *this,
                                       _options, *_directory, _stats);
+
+      // then apply the chain of incremental dumps on top of it
+      uint64_t lastTick = ::lastDumpTick(*_directory);
+      for (auto const& path : _options.incrementalPaths) {
+        if (result.fail() || !_options.importData) {
+          break;
+        }
+        ManagedDirectory incremental(_options.allDatabases
+                                         ? basics::FileUtils::buildFilename(path, db)
+                                         : path,
+                                     false, false);
+        result = incremental.status();
+        if (result.ok()) {
+          result = ::restoreIncrementalDump(*httpClient, *this, _options, _stats,
+                                            incremental, lastTick);
+        }
+      }
     } catch (basics::Exception const& ex) {
       LOG_TOPIC("52b22", ERR, arangodb::Logger::RESTORE) << "caught exception: " << ex.what();
       result = {ex.code(), ex.what()};
@@ -1552,6 +1975,18 @@ void RestoreFeature::start() {
 
 std::string RestoreFeature::featureName() { return ::FeatureName; }
 
+void RestoreFeature::queueBatch(std::unique_ptr<BatchData>&& batch) {
+  SendState& state = batch->state;
+  if (!_batchQueue.queueJob(std::move(batch))) {
+    CONDITION_LOCKER(guard, state.condition);
+    if (state.error.ok()) {
+      state.error = {TRI_ERROR_OUT_OF_MEMORY, "unable to queue data batch"};
+    }
+    --state.inFlight;
+    guard.broadcast();
+  }
+}
+
 void RestoreFeature::reportError(Result const& error) {
   try {
     MUTEX_LOCKER(lock, _workerErrorLock);
@@ -68,22 +68,33 @@ class RestoreFeature final : public application_features::ApplicationFeature {
    */
   Result getFirstError() const;
 
+  struct BatchData;
+
+  /**
+   * @brief Queues a data batch, to be sent by one of the batch senders
+   * @param batch The batch to send
+   */
+  void queueBatch(std::unique_ptr<BatchData>&& batch);
+
   /// @brief Holds configuration data to pass between methods
   struct Options {
     std::vector<std::string> collections{};
     std::vector<std::string> views{};
     std::string inputPath{};
+    std::vector<std::string> incrementalPaths{};
     uint64_t chunkSize{1024 * 1024 * 8};
     uint64_t defaultNumberOfShards{1};     // deprecated
     uint64_t defaultReplicationFactor{1};  // deprecated
     std::vector<std::string> numberOfShards;
     std::vector<std::string> replicationFactor;
     uint32_t threadCount{2};
+    uint32_t sendersPerCollection{1};
     bool clusterMode{false};
     bool createDatabase{false};
     bool force{false};
     bool forceSameDatabase{false};
     bool allDatabases{false};
+    bool autoTuneBatchSize{false};
     bool ignoreDistributeShardsLikeErrors{false};
     bool importData{true};
     bool importStructure{true};
@@ -115,9 +126,38 @@ class RestoreFeature final : public application_features::ApplicationFeature {
     JobData(ManagedDirectory&, RestoreFeature&, Options const&, Stats&, VPackSlice const&);
   };
 
+  /// @brief Progress of sending the batches of a single data file
+  struct SendState {
+    explicit SendState(uint64_t chunkSize) : chunkSize(chunkSize) {}
+
+    Mutex lock;
+    basics::ConditionVariable condition;
+    /// @brief number of batches queued or being sent
+    size_t inFlight{0};
+    /// @brief first error reported by a sender
+    Result error;
+    /// @brief current batch size, adjusted by the senders if auto-tuning
+    /// is enabled
+    std::atomic<uint64_t> chunkSize;
+  };
+
+  /// @brief A batch of data to send to the server by one of the senders
+  struct BatchData {
+    Options const& options;
+    Stats& stats;
+    SendState& state;
+    std::string const cname;
+    std::string payload;
+    /// @brief payload consists of VelocyPack markers instead of JSON lines
+    bool const isVPack;
+    /// @brief the collection was empty and the markers have distinct keys
+    bool const bulk;
+  };
+
  private:
   ClientManager _clientManager;
   ClientTaskQueue<JobData> _clientTaskQueue;
+  ClientTaskQueue<BatchData> _batchQueue;
   std::unique_ptr<ManagedDirectory> _directory;
   int& _exitCode;
   Options _options;
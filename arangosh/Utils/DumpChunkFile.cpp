@@ -0,0 +1,182 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "DumpChunkFile.h"
+
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include "zlib.h"
+
+namespace {
+
+/// @brief marks the start of every chunk header ("VPC1")
+constexpr uint32_t ChunkMagic = 0x31435056;
+
+/// @brief upper bound for a single chunk, protects against corrupted headers
+constexpr uint32_t MaxChunkSize = 1024 * 1024 * 512;
+
+void appendUInt32(std::string& out, uint32_t value) {
+  for (size_t i = 0; i < sizeof(uint32_t); ++i) {
+    out.push_back(static_cast<char>(value & 0xffU));
+    value >>= 8;
+  }
+}
+
+uint32_t readUInt32(char const* p) {
+  uint32_t value = 0;
+  for (size_t i = sizeof(uint32_t); i > 0; --i) {
+    value = (value << 8) | static_cast<uint8_t>(p[i - 1]);
+  }
+  return value;
+}
+
+/// @brief read exactly length bytes, returns the number of bytes read
+size_t readFully(arangodb::ManagedDirectory::File& file, char* buffer, size_t length) {
+  size_t total = 0;
+  while (total < length) {
+    ssize_t n = file.read(buffer + total, length - total);
+    if (n <= 0 || file.status().fail()) {
+      break;
+    }
+    total += static_cast<size_t>(n);
+  }
+  return total;
+}
+
+}  // namespace
+
+namespace arangodb {
+namespace dumpchunks {
+
+std::string const DataFileSuffix(".data.vpack");
+std::string const IndexFileSuffix(".data.vpack.index");
+
+Writer::Writer(ManagedDirectory::File& file) : _file(file), _offset(0) {
+  _index.openArray();
+}
+
+Result Writer::write(char const* data, size_t length) {
+  if (length == 0) {
+    return {};
+  }
+  if (length > MaxChunkSize) {
+    return {TRI_ERROR_BAD_PARAMETER, "dump chunk is too big"};
+  }
+
+  // count the values in the chunk, so restore can report progress
+  uint32_t count = 0;
+  try {
+    char const* p = data;
+    char const* e = data + length;
+    while (p < e) {
+      VPackSlice s(reinterpret_cast<uint8_t const*>(p));
+      p += s.byteSize();
+      ++count;
+    }
+  } catch (...) {
+    return {TRI_ERROR_REPLICATION_INVALID_RESPONSE, "invalid VelocyPack in dump chunk"};
+  }
+
+  uLongf compressedLength = compressBound(static_cast<uLong>(length));
+  _compressed.clear();
+  appendUInt32(_compressed, ChunkMagic);
+  appendUInt32(_compressed, 0);  // compressed length, patched below
+  appendUInt32(_compressed, static_cast<uint32_t>(length));
+  appendUInt32(_compressed, count);
+  _compressed.resize(HeaderSize + compressedLength);
+
+  // favor speed over compression ratio, dumps are I/O bound on restore
+  int res = compress2(reinterpret_cast<Bytef*>(&_compressed[HeaderSize]), &compressedLength,
+                      reinterpret_cast<Bytef const*>(data), static_cast<uLong>(length), 1);
+  if (res != Z_OK) {
+    return {TRI_ERROR_INTERNAL, "unable to compress dump chunk"};
+  }
+  _compressed.resize(HeaderSize + compressedLength);
+  std::string length32;
+  appendUInt32(length32, static_cast<uint32_t>(compressedLength));
+  _compressed.replace(sizeof(uint32_t), sizeof(uint32_t), length32);
+
+  _file.write(_compressed.data(), _compressed.size());
+  if (_file.status().fail()) {
+    return _file.status();
+  }
+
+  _index.openArray();
+  _index.add(VPackValue(_offset));
+  _index.add(VPackValue(static_cast<uint64_t>(compressedLength)));
+  _index.add(VPackValue(static_cast<uint64_t>(length)));
+  _index.add(VPackValue(static_cast<uint64_t>(count)));
+  _index.close();
+
+  _offset += _compressed.size();
+  return {};
+}
+
+velocypack::Builder& Writer::index() {
+  if (_index.isOpenArray()) {
+    _index.close();
+  }
+  return _index;
+}
+
+Reader::Reader(ManagedDirectory::File& file) : _file(file), _offset(0) {}
+
+Result Reader::next(std::string& out) {
+  out.clear();
+
+  char header[HeaderSize];
+  size_t n = readFully(_file, &header[0], HeaderSize);
+  if (_file.status().fail()) {
+    return _file.status();
+  }
+  if (n == 0) {
+    // end of file
+    return {};
+  }
+  if (n != HeaderSize || readUInt32(&header[0]) != ChunkMagic) {
+    return {TRI_ERROR_ARANGO_CORRUPTED_DATAFILE, "invalid chunk header in '" + _file.path() + "'"};
+  }
+
+  uint32_t const compressedLength = readUInt32(&header[sizeof(uint32_t)]);
+  uint32_t const length = readUInt32(&header[2 * sizeof(uint32_t)]);
+  if (compressedLength > MaxChunkSize || length > MaxChunkSize) {
+    return {TRI_ERROR_ARANGO_CORRUPTED_DATAFILE, "invalid chunk size in '" + _file.path() + "'"};
+  }
+
+  _compressed.resize(compressedLength);
+  if (readFully(_file, &_compressed[0], compressedLength) != compressedLength) {
+    return {TRI_ERROR_ARANGO_CORRUPTED_DATAFILE, "truncated chunk in '" + _file.path() + "'"};
+  }
+  _offset += HeaderSize + compressedLength;
+
+  out.resize(length);
+  uLongf outLength = length;
+  int res = uncompress(reinterpret_cast<Bytef*>(&out[0]), &outLength,
+                       reinterpret_cast<Bytef const*>(_compressed.data()), compressedLength);
+  if (res != Z_OK || outLength != length) {
+    out.clear();
+    return {TRI_ERROR_ARANGO_CORRUPTED_DATAFILE, "unable to decompress chunk in '" + _file.path() + "'"};
+  }
+  return {};
+}
+
+}  // namespace dumpchunks
+}  // namespace arangodb
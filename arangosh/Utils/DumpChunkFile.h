@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOSH_UTILS_DUMP_CHUNK_FILE_H
+#define ARANGOSH_UTILS_DUMP_CHUNK_FILE_H 1
+
+#include "Basics/Common.h"
+#include "Basics/Result.h"
+#include "Utils/ManagedDirectory.h"
+
+#include <velocypack/Builder.h>
+
+namespace arangodb {
+
+/// @brief Binary dump data files
+///
+/// A binary data file is a sequence of chunks. Each chunk starts with a
+/// 16 byte header (magic, compressed length, uncompressed length and number
+/// of values, all little-endian uint32), followed by the deflate-compressed
+/// payload. The payload is a sequence of VelocyPack replication markers, as
+/// returned by the replication dump API. Chunks are independent of each
+/// other, so they can be located via the chunk index and processed
+/// separately.
+namespace dumpchunks {
+
+/// @brief suffix of binary data files
+extern std::string const DataFileSuffix;
+
+/// @brief suffix of the chunk index belonging to a binary data file
+extern std::string const IndexFileSuffix;
+
+/// @brief size of a chunk header in bytes
+constexpr size_t HeaderSize = 4 * sizeof(uint32_t);
+
+/// @brief writes compressed chunks to a data file and keeps track of the
+/// chunk index
+class Writer {
+ public:
+  explicit Writer(ManagedDirectory::File& file);
+
+  /// @brief compress and append a sequence of VelocyPack values
+  Result write(char const* data, size_t length);
+
+  /// @brief the chunk index, an array of [offset, compressed length,
+  /// uncompressed length, number of values] arrays
+  velocypack::Builder& index();
+
+  /// @brief number of bytes written to the file so far
+  uint64_t bytesWritten() const { return _offset; }
+
+ private:
+  ManagedDirectory::File& _file;
+  uint64_t _offset;
+  std::string _compressed;
+  velocypack::Builder _index;
+};
+
+/// @brief reads and decompresses the chunks of a data file sequentially
+class Reader {
+ public:
+  explicit Reader(ManagedDirectory::File& file);
+
+  /// @brief read and decompress the next chunk into out. returns an empty
+  /// out value at the end of the file
+  Result next(std::string& out);
+
+  /// @brief number of bytes read from the file so far
+  uint64_t bytesRead() const { return _offset; }
+
+ private:
+  ManagedDirectory::File& _file;
+  uint64_t _offset;
+  std::string _compressed;
+};
+
+}  // namespace dumpchunks
+}  // namespace arangodb
+
+#endif
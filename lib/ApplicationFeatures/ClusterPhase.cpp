@@ -32,6 +32,7 @@ ClusterFeaturePhase::ClusterFeaturePhase(ApplicationServer& server)
 
   startsAfter("Cluster");
   startsAfter("Maintenance");
+  startsAfter("Network");
   startsAfter("ReplicationTimeout");
 }
 
@@ -60,7 +60,8 @@ class AssocUnique {
  public:
   typedef std::function<bool(Element&)> CallbackElementFuncType;
 
-  typedef arangodb::basics::IndexBucket<Element, uint64_t> Bucket;
+  /// @brief buckets carry a hash tag per slot, see IndexBucketTags
+  typedef arangodb::basics::IndexBucket<Element, uint64_t, true> Bucket;
 
  private:
   AssocUniqueHelper _helper;
@@ -146,6 +147,7 @@ class AssocUnique {
 
     if (b._nrUsed > 0) {
       Element* oldTable = b._table;
+      uint8_t const* oldTags = b._tags;
       uint64_t const oldAlloc = b._nrAlloc;
       TRI_ASSERT(oldAlloc > 0);
 
@@ -159,14 +161,15 @@ class AssocUnique {
           uint64_t i, k;
           i = k = _helper.HashElement(element, true) % n;
 
-          for (; i < n && copy._table[i]; ++i)
+          for (; i < n && copy._tags[i]; ++i)
             ;
           if (i == n) {
-            for (i = 0; i < k && copy._table[i]; ++i)
+            for (i = 0; i < k && copy._tags[i]; ++i)
               ;
           }
 
           copy._table[i] = element;
+          copy._tags[i] = oldTags[j];
           ++copy._nrUsed;
         }
       }
@@ -190,6 +193,52 @@ class AssocUnique {
     return true;
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief returns the position of the element in the bucket for which
+  /// isEqual returns true, or of the empty slot ending the probe sequence if
+  /// there is none. the tags of GroupSize slots are compared at once, and
+  /// isEqual is only called for slots whose tag matches the hash
+  //////////////////////////////////////////////////////////////////////////////
+
+  template <typename F>
+  static uint64_t probe(Bucket const& b, uint64_t hash, F const& isEqual) {
+    uint64_t const n = b._nrAlloc;
+    uint8_t const tag = IndexBucketTags::tag(hash);
+    uint64_t const start = hash % n;
+    uint64_t i = start;
+    uint64_t probed = 0;
+
+    while (probed < n) {
+      if (i + IndexBucketTags::GroupSize <= n) {
+        uint32_t mask = IndexBucketTags::matchGroup(b._tags + i, tag);
+        while (mask != 0) {
+          uint64_t const pos = i + IndexBucketTags::lowestBit(mask);
+          if (b._tags[pos] == 0 || isEqual(b._table[pos])) {
+            return pos;
+          }
+          mask &= mask - 1;
+        }
+        i += IndexBucketTags::GroupSize;
+        probed += IndexBucketTags::GroupSize;
+      } else {
+        uint8_t const t = b._tags[i];
+        if (t == 0 || (t == tag && isEqual(b._table[i]))) {
+          return i;
+        }
+        ++i;
+        ++probed;
+      }
+      if (i == n) {
+        i = 0;
+      }
+    }
+
+    // completely full bucket without a match. this cannot happen as long as
+    // the resizing keeps up, return the start position like a failed
+    // linear probe would
+    return start;
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Finds the element at the given position in the buckets.
   ///        Iterates using the given step size
@@ -222,20 +271,9 @@ class AssocUnique {
   //////////////////////////////////////////////////////////////////////////////
 
   int doInsert(UserData* userData, Element const& element, Bucket& b, uint64_t hash) {
-    uint64_t const n = b._nrAlloc;
-    uint64_t i = hash % n;
-    uint64_t k = i;
-
-    for (; i < n && b._table[i] &&
-           !_helper.IsEqualElementElementByKey(userData, element, b._table[i]);
-         ++i)
-      ;
-    if (i == n) {
-      for (i = 0; i < k && b._table[i] &&
-                  !_helper.IsEqualElementElementByKey(userData, element, b._table[i]);
-           ++i)
-        ;
-    }
+    uint64_t const i = probe(b, hash, [&](Element const& other) {
+      return _helper.IsEqualElementElementByKey(userData, element, other);
+    });
 
     Element const& arrayElement = b._table[i];
 
@@ -244,6 +282,7 @@ class AssocUnique {
     }
 
     b._table[i] = element;
+    b._tags[i] = IndexBucketTags::tag(hash);
     b._nrUsed++;
 
     return TRI_ERROR_NO_ERROR;
@@ -262,6 +301,16 @@ class AssocUnique {
 
   size_t buckets() const { return _buckets.size(); }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief returns the id of the bucket a key belongs to. the buckets are
+  /// independent of each other, so different threads may modify disjoint sets
+  /// of buckets concurrently as long as nobody else accesses the hash
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t bucketId(Key const* key) const {
+    return static_cast<size_t>(_helper.HashKey(key) & _bucketsMask);
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief checks if this index is empty
   //////////////////////////////////////////////////////////////////////////////
@@ -350,23 +399,12 @@ class AssocUnique {
   //////////////////////////////////////////////////////////////////////////////
 
   Element find(UserData* userData, Element const& element) const {
-    uint64_t i = _helper.HashElement(element, true);
-    Bucket const& b = _buckets[i & _bucketsMask];
+    uint64_t const hash = _helper.HashElement(element, true);
+    Bucket const& b = _buckets[hash & _bucketsMask];
 
-    uint64_t const n = b._nrAlloc;
-    i = i % n;
-    uint64_t k = i;
-
-    for (; i < n && b._table[i] &&
-           !_helper.IsEqualElementElementByKey(userData, element, b._table[i]);
-         ++i)
-      ;
-    if (i == n) {
-      for (i = 0; i < k && b._table[i] &&
-                  !_helper.IsEqualElementElementByKey(userData, element, b._table[i]);
-           ++i)
-        ;
-    }
+    uint64_t const i = probe(b, hash, [&](Element const& other) {
+      return _helper.IsEqualElementElementByKey(userData, element, other);
+    });
 
     // ...........................................................................
     // return whatever we found, this is nullptr if the thing was not found
@@ -382,23 +420,13 @@ class AssocUnique {
   //////////////////////////////////////////////////////////////////////////////
 
   Element findByKey(UserData* userData, Key const* key) const {
-    uint64_t hash = _helper.HashKey(key);
-    uint64_t i = hash;
-    uint64_t bucketId = i & _bucketsMask;
+    uint64_t const hash = _helper.HashKey(key);
+    uint64_t const bucketId = hash & _bucketsMask;
     Bucket const& b = _buckets[static_cast<size_t>(bucketId)];
 
-    uint64_t const n = b._nrAlloc;
-    i = i % n;
-    uint64_t k = i;
-
-    for (; i < n && b._table[i] && !_helper.IsEqualKeyElement(userData, key, b._table[i]); ++i)
-      ;
-    if (i == n) {
-      for (i = 0; i < k && b._table[i] &&
-                  !_helper.IsEqualKeyElement(userData, key, b._table[i]);
-           ++i)
-        ;
-    }
+    uint64_t const i = probe(b, hash, [&](Element const& other) {
+      return _helper.IsEqualKeyElement(userData, key, other);
+    });
 
     // ...........................................................................
     // return whatever we found, this is nullptr if the thing was not found
@@ -409,23 +437,13 @@ class AssocUnique {
   }
 
   Element* findByKeyRef(UserData* userData, Key const* key) const {
-    uint64_t hash = _helper.HashKey(key);
-    uint64_t i = hash;
-    uint64_t bucketId = i & _bucketsMask;
+    uint64_t const hash = _helper.HashKey(key);
+    uint64_t const bucketId = hash & _bucketsMask;
     Bucket const& b = _buckets[static_cast<size_t>(bucketId)];
 
-    uint64_t const n = b._nrAlloc;
-    i = i % n;
-    uint64_t k = i;
-
-    for (; i < n && b._table[i] && !_helper.IsEqualKeyElement(userData, key, b._table[i]); ++i)
-      ;
-    if (i == n) {
-      for (i = 0; i < k && b._table[i] &&
-                  !_helper.IsEqualKeyElement(userData, key, b._table[i]);
-           ++i)
-        ;
-    }
+    uint64_t const i = probe(b, hash, [&](Element const& other) {
+      return _helper.IsEqualKeyElement(userData, key, other);
+    });
 
     // ...........................................................................
     // return whatever we found, this is nullptr if the thing was not found
@@ -445,22 +463,12 @@ class AssocUnique {
   Element findByKey(UserData* userData, Key const* key,
                     BucketPosition& position, uint64_t& hash) const {
     hash = _helper.HashKey(key);
-    uint64_t i = hash;
-    uint64_t bucketId = i & _bucketsMask;
+    uint64_t const bucketId = hash & _bucketsMask;
     Bucket const& b = _buckets[static_cast<size_t>(bucketId)];
 
-    uint64_t const n = b._nrAlloc;
-    i = i % n;
-    uint64_t k = i;
-
-    for (; i < n && b._table[i] && !_helper.IsEqualKeyElement(userData, key, b._table[i]); ++i)
-      ;
-    if (i == n) {
-      for (i = 0; i < k && b._table[i] &&
-                  !_helper.IsEqualKeyElement(userData, key, b._table[i]);
-           ++i)
-        ;
-    }
+    uint64_t const i = probe(b, hash, [&](Element const& other) {
+      return _helper.IsEqualKeyElement(userData, key, other);
+    });
 
     // if requested, pass the position of the found element back
     // to the caller
@@ -510,6 +518,7 @@ class AssocUnique {
     }
 
     b._table[position.position] = element;
+    b._tags[position.position] = IndexBucketTags::tag(_helper.HashElement(element, true));
     b._nrUsed++;
 
     if (!checkResize(userData, b, 0)) {
@@ -614,6 +623,7 @@ class AssocUnique {
     //
 
     b._table[i] = Element();
+    b._tags[i] = 0;
     b._nrUsed--;
 
     uint64_t const n = b._nrAlloc;
@@ -625,12 +635,14 @@ class AssocUnique {
 
     uint64_t k = TRI_IncModU64(i, n);
 
-    while (b._table[k]) {
+    while (b._tags[k]) {
       uint64_t j = _helper.HashElement(b._table[k], true) % n;
 
       if ((i < k && !(i < j && j <= k)) || (k < i && !(i < j || j <= k))) {
         b._table[i] = b._table[k];
+        b._tags[i] = b._tags[k];
         b._table[k] = Element();
+        b._tags[k] = 0;
         i = k;
       }
 
@@ -649,22 +661,12 @@ class AssocUnique {
   //////////////////////////////////////////////////////////////////////////////
 
   Element removeByKey(UserData* userData, Key const* key) {
-    uint64_t hash = _helper.HashKey(key);
-    uint64_t i = hash;
-    Bucket& b = _buckets[i & _bucketsMask];
+    uint64_t const hash = _helper.HashKey(key);
+    Bucket& b = _buckets[hash & _bucketsMask];
 
-    uint64_t const n = b._nrAlloc;
-    i = i % n;
-    uint64_t k = i;
-
-    for (; i < n && b._table[i] && !_helper.IsEqualKeyElement(userData, key, b._table[i]); ++i)
-      ;
-    if (i == n) {
-      for (i = 0; i < k && b._table[i] &&
-                  !_helper.IsEqualKeyElement(userData, key, b._table[i]);
-           ++i)
-        ;
-    }
+    uint64_t const i = probe(b, hash, [&](Element const& other) {
+      return _helper.IsEqualKeyElement(userData, key, other);
+    });
 
     Element old = b._table[i];
 
@@ -680,23 +682,12 @@ class AssocUnique {
   //////////////////////////////////////////////////////////////////////////////
 
   Element remove(UserData* userData, Element const& element) {
-    uint64_t i = _helper.HashElement(element, true);
-    Bucket& b = _buckets[i & _bucketsMask];
+    uint64_t const hash = _helper.HashElement(element, true);
+    Bucket& b = _buckets[hash & _bucketsMask];
 
-    uint64_t const n = b._nrAlloc;
-    i = i % n;
-    uint64_t k = i;
-
-    for (; i < n && b._table[i] &&
-           !_helper.IsEqualElementElement(userData, element, b._table[i]);
-         ++i)
-      ;
-    if (i == n) {
-      for (i = 0; i < k && b._table[i] &&
-                  !_helper.IsEqualElementElement(userData, element, b._table[i]);
-           ++i)
-        ;
-    }
+    uint64_t const i = probe(b, hash, [&](Element const& other) {
+      return _helper.IsEqualElementElement(userData, element, other);
+    });
 
     Element old = b._table[i];
 
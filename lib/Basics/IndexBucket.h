@@ -30,22 +30,83 @@
 #include "Basics/memory-map.h"
 #include "Logger/Logger.h"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 namespace arangodb {
 namespace basics {
 
-template <class EntryType, class IndexType>
+////////////////////////////////////////////////////////////////////////////////
+/// @brief hash tags for buckets using them
+///
+/// A tagged bucket keeps one byte per slot next to the table. 0 marks an
+/// empty slot, an occupied slot stores the 7 highest bits of the element's
+/// hash with the top bit set. Probing compares the tags of a whole group of
+/// slots at once and only looks at the elements whose tag matches, so most
+/// slots holding other keys are skipped without dereferencing the element.
+////////////////////////////////////////////////////////////////////////////////
+
+struct IndexBucketTags {
+  /// @brief number of tags compared at once by matchGroup()
+  static constexpr uint64_t GroupSize = 16;
+
+  static inline uint8_t tag(uint64_t hash) {
+    return static_cast<uint8_t>((hash >> 57) | 0x80);
+  }
+
+  /// @brief returns a bit mask of the slots in the group of GroupSize tags
+  /// starting at tags that are either empty or carry the given tag. bit i
+  /// stands for slot i of the group
+  static inline uint32_t matchGroup(uint8_t const* tags, uint8_t tag) {
+#ifdef __SSE2__
+    __m128i const group = _mm_loadu_si128(reinterpret_cast<__m128i const*>(tags));
+    __m128i const hits =
+        _mm_or_si128(_mm_cmpeq_epi8(group, _mm_set1_epi8(static_cast<char>(tag))),
+                     _mm_cmpeq_epi8(group, _mm_setzero_si128()));
+    return static_cast<uint32_t>(_mm_movemask_epi8(hits));
+#else
+    uint32_t mask = 0;
+    for (uint64_t i = 0; i < GroupSize; ++i) {
+      if (tags[i] == tag || tags[i] == 0) {
+        mask |= (uint32_t(1) << i);
+      }
+    }
+    return mask;
+#endif
+  }
+
+  /// @brief position of the lowest bit set in a non-zero mask
+  static inline unsigned lowestBit(uint32_t mask) {
+    TRI_ASSERT(mask != 0);
+#ifdef __GNUC__
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#else
+    unsigned i = 0;
+    while ((mask & 1) == 0) {
+      mask >>= 1;
+      ++i;
+    }
+    return i;
+#endif
+  }
+};
+
+template <class EntryType, class IndexType, bool useTags = false>
 struct IndexBucket {
   IndexType _nrAlloc;       // the size of the table
   IndexType _nrUsed;        // the number of used entries
   IndexType _nrCollisions;  // the number of entries that have
                             // a key that was previously in the table
   EntryType* _table;        // the table itself
+  uint8_t* _tags;           // hash tags of the slots, only if useTags
 
   IndexBucket()
       : _nrAlloc(0),
         _nrUsed(0),
         _nrCollisions(0),
-        _table(nullptr) {}
+        _table(nullptr),
+        _tags(nullptr) {}
   IndexBucket(IndexBucket const&) = delete;
   IndexBucket& operator=(IndexBucket const&) = delete;
 
@@ -54,11 +115,13 @@ struct IndexBucket {
       : _nrAlloc(other._nrAlloc),
         _nrUsed(other._nrUsed),
         _nrCollisions(other._nrCollisions),
-        _table(other._table) {
+        _table(other._table),
+        _tags(other._tags) {
     other._nrAlloc = 0;
     other._nrUsed = 0;
     other._nrCollisions = 0;
     other._table = nullptr;
+    other._tags = nullptr;
   }
 
   IndexBucket& operator=(IndexBucket&& other) {
@@ -68,11 +131,13 @@ struct IndexBucket {
     _nrUsed = other._nrUsed;
     _nrCollisions = other._nrCollisions;
     _table = other._table;
+    _tags = other._tags;
 
     other._nrAlloc = 0;
     other._nrUsed = 0;
     other._nrCollisions = 0;
     other._table = nullptr;
+    other._tags = nullptr;
 
     return *this;
   }
@@ -83,7 +148,7 @@ struct IndexBucket {
   size_t memoryUsage() const { return requiredSize(_nrAlloc); }
 
   size_t requiredSize(size_t numberElements) const {
-    return numberElements * sizeof(EntryType);
+    return numberElements * (sizeof(EntryType) + (useTags ? sizeof(uint8_t) : 0));
   }
 
   void allocate(size_t numberElements) {
@@ -91,12 +156,21 @@ struct IndexBucket {
     TRI_ASSERT(_nrUsed == 0);
     TRI_ASSERT(_table == nullptr);
 
-    _table = allocateMemory(numberElements);
+    if (useTags) {
+      _tags = new uint8_t[numberElements]();
+    }
+    try {
+      _table = allocateMemory(numberElements);
+    } catch (...) {
+      delete[] _tags;
+      _tags = nullptr;
+      throw;
+    }
     TRI_ASSERT(_table != nullptr);
 
 #ifdef __linux__
     if (numberElements > 1000000) {
-      size_t const totalSize = requiredSize(numberElements);
+      size_t const totalSize = numberElements * sizeof(EntryType);
       uintptr_t mem = reinterpret_cast<uintptr_t>(_table);
       uintptr_t pageSize = getpagesize();
       mem = (mem / pageSize) * pageSize;
@@ -130,6 +204,8 @@ struct IndexBucket {
 
     delete[] _table;
     _table = nullptr;
+    delete[] _tags;
+    _tags = nullptr;
     _nrAlloc = 0;
     _nrUsed = 0;
     _nrCollisions = 0;
@@ -0,0 +1,278 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Metrics.h"
+
+#include "Basics/Exceptions.h"
+#include "Basics/MutexLocker.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+using namespace arangodb;
+using namespace arangodb::metrics;
+
+namespace {
+std::atomic<size_t> nextShard(0);
+
+void appendNumber(std::string& result, double value) {
+  if (std::isnan(value)) {
+    result.append("NaN");
+  } else if (std::isinf(value)) {
+    result.append(value > 0 ? "+Inf" : "-Inf");
+  } else {
+    char buffer[32];
+    int length = snprintf(buffer, sizeof(buffer), "%.15g", value);
+    result.append(buffer, static_cast<size_t>(length));
+  }
+}
+}  // namespace
+
+size_t arangodb::metrics::threadShard() {
+  thread_local size_t const shard =
+      nextShard.fetch_add(1, std::memory_order_relaxed) % NumberOfShards;
+  return shard;
+}
+
+Counter::Counter() {
+  for (auto& shard : _shards) {
+    shard.value.store(0, std::memory_order_relaxed);
+  }
+}
+
+uint64_t Counter::load() const {
+  uint64_t result = 0;
+  for (auto const& shard : _shards) {
+    result += shard.value.load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
+Gauge::Gauge() {
+  for (auto& shard : _shards) {
+    shard.value.store(0, std::memory_order_relaxed);
+  }
+}
+
+void Gauge::set(int64_t value) {
+  for (size_t i = 1; i < NumberOfShards; ++i) {
+    _shards[i].value.store(0, std::memory_order_relaxed);
+  }
+  _shards[0].value.store(value, std::memory_order_relaxed);
+}
+
+int64_t Gauge::load() const {
+  int64_t result = 0;
+  for (auto const& shard : _shards) {
+    result += shard.value.load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
+Histogram::Histogram(int lowExponent, int highExponent) : _sum(0.0) {
+  TRI_ASSERT(lowExponent < highExponent);
+  for (int e = lowExponent; e < highExponent; ++e) {
+    double const power = std::pow(10.0, e);
+    for (int m = 1; m <= 9; ++m) {
+      _bounds.push_back(m * power);
+    }
+  }
+  _bounds.push_back(std::pow(10.0, highExponent));
+
+  _counts.reset(new std::atomic<uint64_t>[_bounds.size() + 1]);
+  for (size_t i = 0; i <= _bounds.size(); ++i) {
+    _counts[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+void Histogram::count(double value) {
+  // the first bucket whose upper bound is not below the value
+  size_t const i = static_cast<size_t>(
+      std::lower_bound(_bounds.begin(), _bounds.end(), value) - _bounds.begin());
+  _counts[i].fetch_add(1, std::memory_order_relaxed);
+
+  double sum = _sum.load(std::memory_order_relaxed);
+  while (!_sum.compare_exchange_weak(sum, sum + value, std::memory_order_relaxed)) {
+  }
+}
+
+uint64_t Histogram::total() const {
+  uint64_t result = 0;
+  for (size_t i = 0; i <= _bounds.size(); ++i) {
+    result += _counts[i].load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
+Registry::Metric& Registry::lookup(std::string const& name,
+                                   std::string const& help, Type type) {
+  auto it = _metrics.find(name);
+  if (it != _metrics.end()) {
+    if ((*it).second.type != type) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                     "metric '" + name +
+                                         "' is already registered with a "
+                                         "different type");
+    }
+    return (*it).second;
+  }
+
+  Metric& metric = _metrics[name];
+  metric.type = type;
+  metric.help = help;
+  return metric;
+}
+
+Counter& Registry::counter(std::string const& name, std::string const& help) {
+  MUTEX_LOCKER(locker, _lock);
+  Metric& metric = lookup(name, help, Type::Counter);
+  if (metric.counter == nullptr) {
+    metric.counter = std::make_unique<Counter>();
+  }
+  return *metric.counter;
+}
+
+Gauge& Registry::gauge(std::string const& name, std::string const& help) {
+  MUTEX_LOCKER(locker, _lock);
+  Metric& metric = lookup(name, help, Type::Gauge);
+  if (metric.gauge == nullptr) {
+    metric.gauge = std::make_unique<Gauge>();
+  }
+  return *metric.gauge;
+}
+
+Histogram& Registry::histogram(std::string const& name, std::string const& help,
+                               int lowExponent, int highExponent) {
+  MUTEX_LOCKER(locker, _lock);
+  Metric& metric = lookup(name, help, Type::Histogram);
+  if (metric.histogram == nullptr) {
+    metric.histogram = std::make_unique<Histogram>(lowExponent, highExponent);
+  }
+  return *metric.histogram;
+}
+
+void Registry::addCollector(std::string const& name, Collector collector) {
+  MUTEX_LOCKER(locker, _lock);
+  _collectors[name] = std::move(collector);
+}
+
+void Registry::removeCollector(std::string const& name) {
+  MUTEX_LOCKER(locker, _lock);
+  _collectors.erase(name);
+}
+
+void Registry::toPrometheus(std::string& result) const {
+  MUTEX_LOCKER(locker, _lock);
+
+  for (auto const& it : _metrics) {
+    std::string const& name = it.first;
+    Metric const& metric = it.second;
+
+    switch (metric.type) {
+      case Type::Counter:
+        appendHeader(result, name, metric.help, "counter");
+        appendSample(result, name, "", metric.counter->load());
+        break;
+
+      case Type::Gauge:
+        appendHeader(result, name, metric.help, "gauge");
+        appendSample(result, name, "", metric.gauge->load());
+        break;
+
+      case Type::Histogram: {
+        Histogram const& histogram = *metric.histogram;
+        std::vector<uint64_t> counts;
+        counts.reserve(histogram.bounds().size() + 1);
+        for (size_t i = 0; i <= histogram.bounds().size(); ++i) {
+          counts.push_back(histogram.bucket(i));
+        }
+        appendHistogram(result, name, metric.help, histogram.bounds(), counts,
+                        histogram.sum());
+        break;
+      }
+    }
+  }
+
+  for (auto const& it : _collectors) {
+    it.second(result);
+  }
+}
+
+std::string Registry::sanitize(std::string const& name) {
+  std::string result(name);
+  for (size_t i = 0; i < result.size(); ++i) {
+    char& c = result[i];
+    if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' ||
+          c == ':' || (i > 0 && c >= '0' && c <= '9'))) {
+      c = '_';
+    }
+  }
+  return result;
+}
+
+void Registry::appendHeader(std::string& result, std::string const& name,
+                            std::string const& help, char const* type) {
+  result.append("# HELP ").append(name).push_back(' ');
+  result.append(help).push_back('\n');
+  result.append("# TYPE ").append(name).push_back(' ');
+  result.append(type).push_back('\n');
+}
+
+void Registry::appendSample(std::string& result, std::string const& name,
+                            std::string const& labels, double value) {
+  result.append(name).append(labels).push_back(' ');
+  appendNumber(result, value);
+  result.push_back('\n');
+}
+
+void Registry::appendSample(std::string& result, std::string const& name,
+                            std::string const& labels, uint64_t value) {
+  result.append(name).append(labels).push_back(' ');
+  result.append(std::to_string(value)).push_back('\n');
+}
+
+void Registry::appendSample(std::string& result, std::string const& name,
+                            std::string const& labels, int64_t value) {
+  result.append(name).append(labels).push_back(' ');
+  result.append(std::to_string(value)).push_back('\n');
+}
+
+void Registry::appendHistogram(std::string& result, std::string const& name,
+                               std::string const& help, std::vector<double> const& bounds,
+                               std::vector<uint64_t> const& counts, double sum) {
+  TRI_ASSERT(counts.size() == bounds.size() + 1);
+
+  appendHeader(result, name, help, "histogram");
+
+  std::string const bucket = name + "_bucket";
+  uint64_t cumulative = 0;
+  for (size_t i = 0; i < bounds.size(); ++i) {
+    cumulative += counts[i];
+    std::string label("{le=\"");
+    appendNumber(label, bounds[i]);
+    label.append("\"}");
+    appendSample(result, bucket, label, cumulative);
+  }
+  cumulative += counts[bounds.size()];
+  appendSample(result, bucket, "{le=\"+Inf\"}", cumulative);
+  appendSample(result, name + "_sum", "", sum);
+  appendSample(result, name + "_count", "", cumulative);
+}
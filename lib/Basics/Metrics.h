@@ -0,0 +1,198 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_BASICS_METRICS_H
+#define ARANGODB_BASICS_METRICS_H 1
+
+#include "Basics/Common.h"
+#include "Basics/Mutex.h"
+
+#include <atomic>
+#include <map>
+
+namespace arangodb {
+namespace metrics {
+
+/// @brief number of shards of counters and gauges. threads are spread over
+/// the shards, so that concurrent updates rarely touch the same cache line
+constexpr size_t NumberOfShards = 16;
+
+/// @brief the shard used by the calling thread
+size_t threadShard();
+
+/// @brief a monotonically increasing counter. increments are relaxed
+/// atomic additions on a per-thread shard, reading sums up all shards
+class Counter {
+ public:
+  Counter();
+  Counter(Counter const&) = delete;
+  Counter& operator=(Counter const&) = delete;
+
+  void count(uint64_t n = 1) {
+    _shards[threadShard()].value.fetch_add(n, std::memory_order_relaxed);
+  }
+
+  uint64_t load() const;
+
+ private:
+  struct Shard {
+    std::atomic<uint64_t> value;
+    char padding[64 - sizeof(std::atomic<uint64_t>)];
+  };
+
+  Shard _shards[NumberOfShards];
+};
+
+/// @brief a value that can go up and down. add() works like a counter
+/// increment, set() replaces the value and must not be mixed with
+/// concurrent calls to add()
+class Gauge {
+ public:
+  Gauge();
+  Gauge(Gauge const&) = delete;
+  Gauge& operator=(Gauge const&) = delete;
+
+  void add(int64_t n) {
+    _shards[threadShard()].value.fetch_add(n, std::memory_order_relaxed);
+  }
+
+  void sub(int64_t n) { add(-n); }
+
+  void set(int64_t value);
+
+  int64_t load() const;
+
+ private:
+  struct Shard {
+    std::atomic<int64_t> value;
+    char padding[64 - sizeof(std::atomic<int64_t>)];
+  };
+
+  Shard _shards[NumberOfShards];
+};
+
+/// @brief a histogram with log-linear buckets. every power of ten between
+/// 10^lowExponent and 10^highExponent is divided into nine buckets with the
+/// upper bounds 1, 2, ..., 9 times the power, so that the relative error of
+/// a quantile estimate is bounded independent of the magnitude. values above
+/// the highest bound are counted in an overflow bucket
+class Histogram {
+ public:
+  Histogram(int lowExponent, int highExponent);
+  Histogram(Histogram const&) = delete;
+  Histogram& operator=(Histogram const&) = delete;
+
+  void count(double value);
+
+  /// @brief upper bounds of all buckets but the overflow bucket
+  std::vector<double> const& bounds() const { return _bounds; }
+
+  /// @brief number of values in bucket i (not cumulative). bucket
+  /// bounds().size() is the overflow bucket
+  uint64_t bucket(size_t i) const {
+    return _counts[i].load(std::memory_order_relaxed);
+  }
+
+  /// @brief number of values counted
+  uint64_t total() const;
+
+  /// @brief sum of all values counted
+  double sum() const { return _sum.load(std::memory_order_relaxed); }
+
+ private:
+  std::vector<double> _bounds;
+  std::unique_ptr<std::atomic<uint64_t>[]> _counts;
+  std::atomic<double> _sum;
+};
+
+/// @brief all metrics of the server, formatted in the Prometheus text
+/// exposition format on request. metrics that are kept elsewhere are exposed
+/// via collectors, which append their samples when the metrics are read
+class Registry {
+ public:
+  typedef std::function<void(std::string&)> Collector;
+
+  Registry() = default;
+  Registry(Registry const&) = delete;
+  Registry& operator=(Registry const&) = delete;
+
+  /// @brief get or create a metric. the returned reference stays valid for
+  /// the lifetime of the registry. throws if a metric with the same name but
+  /// a different type exists
+  Counter& counter(std::string const& name, std::string const& help);
+  Gauge& gauge(std::string const& name, std::string const& help);
+  Histogram& histogram(std::string const& name, std::string const& help,
+                       int lowExponent, int highExponent);
+
+  /// @brief add or replace a collector
+  void addCollector(std::string const& name, Collector collector);
+
+  /// @brief remove a collector. when this returns, the collector is not
+  /// running and will not be called again
+  void removeCollector(std::string const& name);
+
+  /// @brief append all metrics to result
+  void toPrometheus(std::string& result) const;
+
+  /// @brief the name with all characters that are not allowed in metric
+  /// names replaced by underscores
+  static std::string sanitize(std::string const& name);
+
+  /// @brief append the help and type lines of a metric
+  static void appendHeader(std::string& result, std::string const& name,
+                           std::string const& help, char const* type);
+
+  /// @brief append a single sample. labels is either empty or a list of
+  /// label pairs in curly braces
+  static void appendSample(std::string& result, std::string const& name,
+                           std::string const& labels, double value);
+  static void appendSample(std::string& result, std::string const& name,
+                           std::string const& labels, uint64_t value);
+  static void appendSample(std::string& result, std::string const& name,
+                           std::string const& labels, int64_t value);
+
+  /// @brief append a histogram from its non-cumulative bucket counts.
+  /// counts has one more entry than bounds, for the overflow bucket
+  static void appendHistogram(std::string& result, std::string const& name,
+                              std::string const& help, std::vector<double> const& bounds,
+                              std::vector<uint64_t> const& counts, double sum);
+
+ private:
+  enum class Type { Counter, Gauge, Histogram };
+
+  struct Metric {
+    Type type;
+    std::string help;
+    std::unique_ptr<Counter> counter;
+    std::unique_ptr<Gauge> gauge;
+    std::unique_ptr<Histogram> histogram;
+  };
+
+  Metric& lookup(std::string const& name, std::string const& help, Type type);
+
+  mutable Mutex _lock;
+  std::map<std::string, Metric> _metrics;
+  std::map<std::string, Collector> _collectors;
+};
+
+}  // namespace metrics
+}  // namespace arangodb
+
+#endif
@@ -0,0 +1,332 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "SamplingProfiler.h"
+
+#include "Basics/Mutex.h"
+#include "Basics/MutexLocker.h"
+#include "Basics/Thread.h"
+
+#include <atomic>
+#include <cstring>
+#include <map>
+#include <thread>
+
+#ifdef __linux__
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <signal.h>
+#include <sys/prctl.h>
+#include <sys/time.h>
+#endif
+
+using namespace arangodb;
+using namespace arangodb::basics;
+
+namespace {
+
+/// @brief frames of the signal handler and the signal trampoline
+constexpr int skippedFrames = 2;
+
+struct Sample {
+  char thread[16];
+  uint32_t depth;
+  void* frames[SamplingProfiler::MaxFrames];
+};
+
+struct SampleBuffer {
+  std::unique_ptr<Sample[]> samples;
+  size_t capacity = 0;
+  std::atomic<size_t> position{0};
+  std::atomic<uint32_t> writers{0};
+};
+
+arangodb::Mutex profilerLock;
+bool running = false;
+
+/// @brief the two buffers, samples are written into buffers[current]
+SampleBuffer buffers[2];
+size_t current = 0;
+
+/// @brief the buffer the signal handler writes to, nullptr when stopped
+std::atomic<SampleBuffer*> active{nullptr};
+
+std::atomic<uint64_t> samplesRecorded{0};
+std::atomic<uint64_t> samplesDropped{0};
+
+bool startsWith(char const* value, char const* prefix) {
+  return strncmp(value, prefix, strlen(prefix)) == 0;
+}
+
+/// @brief wait until no signal handler writes into the buffer anymore. the
+/// buffer must not be active anymore
+void waitForWriters(SampleBuffer& buffer) {
+  while (buffer.writers.load() != 0) {
+    std::this_thread::yield();
+  }
+}
+
+#ifdef __linux__
+
+/// @brief records a sample. only uses async-signal-safe functions. the
+/// writers counter is incremented before the active buffer is checked
+/// again, so that collect() either sees the writer or the writer sees the
+/// buffer switch
+void profileSignalHandler(int, siginfo_t*, void*) {
+  int const savedErrno = errno;
+
+  SampleBuffer* buffer = active.load();
+  if (buffer != nullptr) {
+    buffer->writers.fetch_add(1);
+    if (active.load() == buffer) {
+      size_t const position = buffer->position.fetch_add(1);
+      if (position < buffer->capacity) {
+        Sample& sample = buffer->samples[position];
+
+        void* frames[SamplingProfiler::MaxFrames + skippedFrames];
+        int depth = backtrace(frames, static_cast<int>(SamplingProfiler::MaxFrames) + skippedFrames);
+        depth = (std::max)(depth - skippedFrames, 0);
+        memcpy(&sample.frames[0], &frames[skippedFrames], depth * sizeof(void*));
+        sample.depth = static_cast<uint32_t>(depth);
+
+        char const* name = Thread::currentThreadName();
+        if (name != nullptr) {
+          size_t i = 0;
+          for (; i < sizeof(sample.thread) - 1 && name[i] != '\0'; ++i) {
+            sample.thread[i] = name[i];
+          }
+          sample.thread[i] = '\0';
+        } else if (prctl(PR_GET_NAME, sample.thread) != 0) {
+          sample.thread[0] = '\0';
+        }
+
+        samplesRecorded.fetch_add(1, std::memory_order_relaxed);
+      } else {
+        samplesDropped.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+    buffer->writers.fetch_sub(1);
+  }
+
+  errno = savedErrno;
+}
+
+/// @brief the name of the function containing the address
+std::string symbolize(void* address) {
+  Dl_info info;
+  if (dladdr(address, &info) != 0) {
+    if (info.dli_sname != nullptr) {
+      int status = 0;
+      char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+      if (demangled != nullptr) {
+        std::string result(status == 0 ? demangled : info.dli_sname);
+        free(demangled);
+        return result;
+      }
+      return info.dli_sname;
+    }
+    if (info.dli_fname != nullptr) {
+      char const* file = strrchr(info.dli_fname, '/');
+      char offset[32];
+      snprintf(offset, sizeof(offset), "+0x%llx",
+               static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(address) -
+                                               reinterpret_cast<uintptr_t>(info.dli_fbase)));
+      return std::string(file != nullptr ? file + 1 : info.dli_fname) + offset;
+    }
+  }
+
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), "0x%llx",
+           static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(address)));
+  return buffer;
+}
+
+#endif
+
+}  // namespace
+
+Result SamplingProfiler::start(uint32_t frequency, size_t maxSamples) {
+#ifdef __linux__
+  if (frequency == 0 || frequency > 1000) {
+    return Result(TRI_ERROR_BAD_PARAMETER,
+                  "sampling frequency must be between 1 and 1000");
+  }
+  if (maxSamples == 0 || maxSamples > (size_t(1) << 22)) {
+    return Result(TRI_ERROR_BAD_PARAMETER,
+                  "maximum number of samples must be between 1 and 4194304");
+  }
+
+  MUTEX_LOCKER(locker, profilerLock);
+
+  if (running) {
+    return Result(TRI_ERROR_BAD_PARAMETER, "profiler is already running");
+  }
+
+  // the first call of backtrace() may load libgcc and allocate, which must
+  // not happen in the signal handler
+  void* frames[4];
+  backtrace(frames, 4);
+
+  for (auto& buffer : buffers) {
+    TRI_ASSERT(buffer.writers.load() == 0);
+    buffer.samples.reset(new Sample[maxSamples]);
+    buffer.capacity = maxSamples;
+    buffer.position.store(0);
+  }
+  current = 0;
+  samplesRecorded.store(0);
+  samplesDropped.store(0);
+
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  action.sa_sigaction = profileSignalHandler;
+  action.sa_flags = SA_RESTART | SA_SIGINFO;
+  sigemptyset(&action.sa_mask);
+  if (sigaction(SIGPROF, &action, nullptr) != 0) {
+    return Result(TRI_ERROR_SYS_ERROR, "cannot install SIGPROF handler");
+  }
+
+  active.store(&buffers[current]);
+
+  struct itimerval timer;
+  timer.it_interval.tv_sec = 0;
+  timer.it_interval.tv_usec = static_cast<suseconds_t>(1000000 / frequency);
+  timer.it_value = timer.it_interval;
+  if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+    active.store(nullptr);
+    return Result(TRI_ERROR_SYS_ERROR, "cannot start profiling timer");
+  }
+
+  running = true;
+  return Result();
+#else
+  return Result(TRI_ERROR_NOT_IMPLEMENTED,
+                "sampling profiler is not available on this platform");
+#endif
+}
+
+Result SamplingProfiler::stop() {
+#ifdef __linux__
+  MUTEX_LOCKER(locker, profilerLock);
+
+  if (!running) {
+    return Result(TRI_ERROR_BAD_PARAMETER, "profiler is not running");
+  }
+
+  struct itimerval timer;
+  memset(&timer, 0, sizeof(timer));
+  setitimer(ITIMER_PROF, &timer, nullptr);
+
+  // the handler stays installed, so that a signal still pending is ignored
+  // instead of terminating the process
+  active.store(nullptr);
+  waitForWriters(buffers[current]);
+
+  running = false;
+  return Result();
+#else
+  return Result(TRI_ERROR_NOT_IMPLEMENTED,
+                "sampling profiler is not available on this platform");
+#endif
+}
+
+void SamplingProfiler::collect(std::string& result) {
+#ifdef __linux__
+  MUTEX_LOCKER(locker, profilerLock);
+
+  SampleBuffer& buffer = buffers[current];
+  if (buffer.capacity == 0) {
+    // never started
+    return;
+  }
+
+  if (running) {
+    current = 1 - current;
+    active.store(&buffers[current]);
+  }
+  waitForWriters(buffer);
+
+  size_t const n = (std::min)(buffer.position.load(), buffer.capacity);
+
+  std::unordered_map<void*, std::string> symbols;
+  std::map<std::string, uint64_t> stacks;
+  std::string stack;
+
+  for (size_t i = 0; i < n; ++i) {
+    Sample const& sample = buffer.samples[i];
+
+    stack.clear();
+    stack.append(threadRole(sample.thread)).push_back(';');
+    stack.append(sample.thread[0] != '\0' ? sample.thread : "unknown");
+
+    // outermost frame first
+    for (uint32_t j = sample.depth; j > 0; --j) {
+      void* address = sample.frames[j - 1];
+      auto it = symbols.find(address);
+      if (it == symbols.end()) {
+        it = symbols.emplace(address, symbolize(address)).first;
+      }
+      stack.push_back(';');
+      stack.append((*it).second);
+    }
+
+    ++stacks[stack];
+  }
+
+  buffer.position.store(0);
+
+  for (auto const& it : stacks) {
+    result.append(it.first).push_back(' ');
+    result.append(std::to_string(it.second)).push_back('\n');
+  }
+#endif
+}
+
+bool SamplingProfiler::isRunning() {
+  MUTEX_LOCKER(locker, profilerLock);
+  return running;
+}
+
+uint64_t SamplingProfiler::numSamples() { return samplesRecorded.load(); }
+
+uint64_t SamplingProfiler::numDropped() { return samplesDropped.load(); }
+
+char const* SamplingProfiler::threadRole(char const* name) {
+  if (name == nullptr || *name == '\0') {
+    return "unknown";
+  }
+  if (startsWith(name, "Sched")) {
+    return "scheduler";
+  }
+  if (strcmp(name, "Io") == 0) {
+    return "io";
+  }
+  if (startsWith(name, "rocksdb") || startsWith(name, "RocksDB")) {
+    return "rocksdb";
+  }
+  if (startsWith(name, "Maintenance")) {
+    return "maintenance";
+  }
+  if (startsWith(name, "V8")) {
+    return "v8";
+  }
+  return "other";
+}
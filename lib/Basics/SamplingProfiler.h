@@ -0,0 +1,75 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_BASICS_SAMPLING_PROFILER_H
+#define ARANGODB_BASICS_SAMPLING_PROFILER_H 1
+
+#include "Basics/Common.h"
+#include "Basics/Result.h"
+
+namespace arangodb {
+namespace basics {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief process-wide CPU sampling profiler
+///
+/// While running, a profiling timer delivers SIGPROF to the threads in
+/// proportion to the CPU time they consume. The signal handler records the
+/// stack and the name of the interrupted thread into a preallocated buffer,
+/// without taking locks or allocating memory. Collecting the samples swaps
+/// the buffer, so that a profile can be read repeatedly while sampling
+/// continues. Samples are returned as folded stacks, one line per distinct
+/// stack with the number of samples, which is the input format of the usual
+/// flame graph tools. The first two frames of each stack are the role and
+/// the name of the thread. Only available on Linux.
+////////////////////////////////////////////////////////////////////////////////
+
+class SamplingProfiler {
+ public:
+  /// @brief maximum number of frames recorded per sample
+  static constexpr size_t MaxFrames = 48;
+
+  SamplingProfiler() = delete;
+
+  /// @brief start sampling with the given frequency in Hz. samples beyond
+  /// maxSamples between two calls to collect() are dropped
+  static Result start(uint32_t frequency, size_t maxSamples);
+
+  /// @brief stop sampling. samples not yet collected are kept
+  static Result stop();
+
+  /// @brief append the folded stacks of all samples recorded since the last
+  /// call to result, and forget them
+  static void collect(std::string& result);
+
+  static bool isRunning();
+
+  /// @brief number of samples recorded and dropped since start()
+  static uint64_t numSamples();
+  static uint64_t numDropped();
+
+  /// @brief the role of a thread, derived from its name
+  static char const* threadRole(char const* name);
+};
+
+}  // namespace basics
+}  // namespace arangodb
+
+#endif
@@ -0,0 +1,163 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ScalableReadWriteLock.h"
+
+#include "Basics/cpu-relax.h"
+
+#include <thread>
+
+using namespace arangodb::basics;
+
+/// @brief locks for writing
+void ScalableReadWriteLock::writeLock() {
+  if (tryWriteLock()) {
+    return;
+  }
+
+  // the lock is either hold by another writer or we have active readers
+  // -> announce that we want to write. this keeps new readers out
+  _state.fetch_add(QUEUED_WRITER_INC, std::memory_order_seq_cst);
+
+  {
+    std::unique_lock<std::mutex> guard(_mutex);
+    while (true) {
+      auto state = _state.load(std::memory_order_relaxed);
+      if ((state & (WRITE_LOCK | WRITE_PENDING)) == 0) {
+        // claim the lock and perform queued writer decrement in one step
+        if (_state.compare_exchange_weak(state, (state - QUEUED_WRITER_INC) | WRITE_PENDING,
+                                         std::memory_order_seq_cst)) {
+          break;
+        }
+        continue;
+      }
+      _writersBell.wait(guard);
+    }
+  }
+
+  waitForReaders();
+}
+
+/// @brief locks for writing, but only tries
+bool ScalableReadWriteLock::tryWriteLock() {
+  auto state = _state.load(std::memory_order_relaxed);
+  // we might "overtake" other queued writers
+  while ((state & (WRITE_LOCK | WRITE_PENDING)) == 0) {
+    if (_state.compare_exchange_weak(state, state | WRITE_PENDING,
+                                     std::memory_order_seq_cst)) {
+      if (_readers.nonZero()) {
+        // there are active readers, don't wait for them
+        releaseWriter(WRITE_PENDING);
+        return false;
+      }
+      _state.fetch_sub(WRITE_PENDING - WRITE_LOCK, std::memory_order_acquire);
+      return true;
+    }
+  }
+  return false;
+}
+
+/// @brief locks for reading
+void ScalableReadWriteLock::readLock() {
+  if (tryReadLock()) {
+    return;
+  }
+
+  std::unique_lock<std::mutex> guard(_mutex);
+  while (true) {
+    if (tryReadLock()) {
+      return;
+    }
+
+    _readersBell.wait(guard);
+  }
+}
+
+/// @brief locks for reading, tries only
+bool ScalableReadWriteLock::tryReadLock() {
+  if (_state.load(std::memory_order_relaxed) != 0) {
+    // writers are active or queued
+    return false;
+  }
+
+  _readers.add(1, std::memory_order_seq_cst);
+
+  // a writer that has announced itself before our increment is visible
+  // has to be let in first. any later writer sees the increment and waits
+  // for us
+  if (_state.load(std::memory_order_seq_cst) != 0) {
+    _readers.sub(1, std::memory_order_release);
+    return false;
+  }
+  return true;
+}
+
+/// @brief releases the read-lock or write-lock
+void ScalableReadWriteLock::unlock() {
+  if (_state.load(std::memory_order_relaxed) & WRITE_LOCK) {
+    // we were holding the write-lock. no reader can be active while
+    // WRITE_LOCK is set
+    unlockWrite();
+  } else {
+    // we were holding a read-lock
+    unlockRead();
+  }
+}
+
+/// @brief releases the write-lock
+void ScalableReadWriteLock::unlockWrite() {
+  TRI_ASSERT((_state.load() & WRITE_LOCK) != 0);
+  releaseWriter(WRITE_LOCK);
+}
+
+/// @brief releases the read-lock
+void ScalableReadWriteLock::unlockRead() {
+  // a waiting writer polls the readers, so there is no one to wake up
+  _readers.sub(1, std::memory_order_release);
+}
+
+void ScalableReadWriteLock::waitForReaders() {
+  TRI_ASSERT((_state.load() & WRITE_PENDING) != 0);
+
+  uint64_t attempts = 0;
+  while (_readers.nonZero()) {
+    // read locks are usually held only briefly
+    if (++attempts < 256) {
+      cpu_relax();
+    } else {
+      std::this_thread::yield();
+    }
+  }
+
+  _state.fetch_sub(WRITE_PENDING - WRITE_LOCK, std::memory_order_acquire);
+}
+
+void ScalableReadWriteLock::releaseWriter(uint32_t bits) {
+  auto state = _state.fetch_sub(bits, std::memory_order_release) - bits;
+
+  std::unique_lock<std::mutex> guard(_mutex);
+  if ((state & QUEUED_WRITER_MASK) != 0) {
+    // there are other writers waiting -> wake up one of them
+    _writersBell.notify_one();
+  } else {
+    // no more writers -> wake up any waiting readers
+    _readersBell.notify_all();
+  }
+}
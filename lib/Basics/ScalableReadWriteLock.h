@@ -0,0 +1,102 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_BASICS_SCALABLE_READ_WRITE_LOCK_H
+#define ARANGODB_BASICS_SCALABLE_READ_WRITE_LOCK_H 1
+
+#include "Basics/Common.h"
+#include "Basics/SharedCounter.h"
+
+#include <condition_variable>
+#include <mutex>
+
+namespace arangodb {
+namespace basics {
+
+/// @brief read-write lock for read-mostly data, usable in place of
+/// ReadWriteLock. Readers only touch a counter stripe that is picked by
+/// their thread, so concurrent readers do not write to a shared cache line.
+/// In turn writers are more expensive: a writer has to wait until the sum
+/// of all stripes drops to zero.
+/// Like ReadWriteLock, write locks have a preference over read locks: as
+/// long as a writer wants the lock, no new read locks are handed out. A
+/// thread can acquire a read lock it already holds as long as no writer is
+/// waiting.
+class ScalableReadWriteLock {
+ public:
+  ScalableReadWriteLock() : _state(0) {}
+
+  /// @brief locks for writing
+  void writeLock();
+
+  /// @brief locks for writing, but only tries
+  bool tryWriteLock();
+
+  /// @brief locks for reading
+  void readLock();
+
+  /// @brief locks for reading, tries only
+  bool tryReadLock();
+
+  /// @brief releases the read-lock or write-lock
+  void unlock();
+
+  /// @brief releases the read-lock
+  void unlockRead();
+
+  /// @brief releases the write-lock
+  void unlockWrite();
+
+ private:
+  /// @brief waits until all readers are gone. must be called by the writer
+  /// that holds WRITE_PENDING
+  void waitForReaders();
+
+  /// @brief clears the given bits of _state and wakes up whoever can make
+  /// progress now
+  void releaseWriter(uint32_t bits);
+
+ private:
+  /// @brief number of active readers, striped by thread
+  SharedCounter<16> _readers;
+
+  /// @brief mutex for the condition variables
+  std::mutex _mutex;
+
+  /// @brief a condition variable to wake up all reader threads
+  std::condition_variable _readersBell;
+
+  /// @brief a condition variable to wake up one writer thread
+  std::condition_variable _writersBell;
+
+  /// @brief _state, lowest bit is write_lock, the next bit is set while a
+  /// writer waits for the readers to leave, the rest is the number of
+  /// queued writers. readers only enter while _state is 0
+  std::atomic<uint32_t> _state;
+
+  static constexpr uint32_t WRITE_LOCK = 1;
+  static constexpr uint32_t WRITE_PENDING = 2;
+  static constexpr uint32_t QUEUED_WRITER_INC = 4;
+  static constexpr uint32_t QUEUED_WRITER_MASK = ~(QUEUED_WRITER_INC - 1);
+};
+}  // namespace basics
+}  // namespace arangodb
+
+#endif
@@ -0,0 +1,240 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_BASICS_SHARDED_LRU_CACHE_H
+#define ARANGODB_BASICS_SHARDED_LRU_CACHE_H 1
+
+#include "Basics/Common.h"
+#include "Basics/ReadLocker.h"
+#include "Basics/ReadWriteLock.h"
+#include "Basics/WriteLocker.h"
+#include "Basics/fasthash.h"
+
+#include <atomic>
+#include <list>
+#include <unordered_map>
+
+namespace arangodb {
+namespace basics {
+
+/// @brief a size-bounded cache that can be used by many threads at once.
+/// The keys are spread over a number of shards, each with its own lock.
+/// Eviction within a shard follows the CLOCK algorithm, an approximation
+/// of LRU that only needs to set a flag when an entry is read. So unlike
+/// LruCache, lookups only need a read lock.
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class ShardedLruCache {
+ public:
+  struct Statistics {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    size_t size = 0;
+  };
+
+  /// @brief create a cache that keeps at most maxSize entries. numShards
+  /// is rounded up to a power of two
+  explicit ShardedLruCache(size_t maxSize, size_t numShards = 16)
+      : _numShards(1), _maxPerShard(0) {
+    while (_numShards < numShards) {
+      _numShards <<= 1;
+    }
+    _maxPerShard = (std::max)(size_t(1), (maxSize + _numShards - 1) / _numShards);
+    _shards.reset(new Shard[_numShards]);
+  }
+
+  ShardedLruCache(ShardedLruCache const&) = delete;
+  ShardedLruCache& operator=(ShardedLruCache const&) = delete;
+
+  /// @brief inserts or replaces the value for the key
+  void put(Key const& key, Value const& value) {
+    Shard& shard = shardFor(key);
+    WRITE_LOCKER(guard, shard.lock);
+
+    auto it = shard.items.find(key);
+    if (it != shard.items.end()) {
+      it->second.value = value;
+      it->second.referenced.store(true, std::memory_order_relaxed);
+      return;
+    }
+
+    // new keys are placed right behind the hand, so they are the last ones
+    // to be looked at by it
+    auto position = shard.clock.insert(shard.hand, key);
+    try {
+      it = shard.items.emplace(std::piecewise_construct, std::forward_as_tuple(key),
+                               std::forward_as_tuple(value, position))
+               .first;
+    } catch (...) {
+      shard.clock.erase(position);
+      throw;
+    }
+
+    while (shard.items.size() > _maxPerShard) {
+      evictOne(shard);
+    }
+  }
+
+  /// @brief copies the value for the key into result. returns false if
+  /// the key is not in the cache
+  bool get(Key const& key, Value& result) {
+    Shard& shard = shardFor(key);
+    READ_LOCKER(guard, shard.lock);
+
+    auto it = shard.items.find(key);
+    if (it == shard.items.end()) {
+      shard.misses.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    result = it->second.value;
+    // avoid writing to the entry if it is read often
+    if (!it->second.referenced.load(std::memory_order_relaxed)) {
+      it->second.referenced.store(true, std::memory_order_relaxed);
+    }
+    shard.hits.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /// @brief removes the key, returns false if it was not in the cache
+  bool remove(Key const& key) {
+    Shard& shard = shardFor(key);
+    WRITE_LOCKER(guard, shard.lock);
+
+    auto it = shard.items.find(key);
+    if (it == shard.items.end()) {
+      return false;
+    }
+    erase(shard, it);
+    return true;
+  }
+
+  /// @brief removes all entries. the statistics are kept
+  void clear() {
+    for (size_t i = 0; i < _numShards; ++i) {
+      Shard& shard = _shards[i];
+      WRITE_LOCKER(guard, shard.lock);
+      shard.items.clear();
+      shard.clock.clear();
+      shard.hand = shard.clock.end();
+    }
+  }
+
+  size_t size() const {
+    size_t result = 0;
+    for (size_t i = 0; i < _numShards; ++i) {
+      Shard const& shard = _shards[i];
+      READ_LOCKER(guard, shard.lock);
+      result += shard.items.size();
+    }
+    return result;
+  }
+
+  Statistics statistics() const {
+    Statistics result;
+    for (size_t i = 0; i < _numShards; ++i) {
+      Shard const& shard = _shards[i];
+      READ_LOCKER(guard, shard.lock);
+      result.hits += shard.hits.load(std::memory_order_relaxed);
+      result.misses += shard.misses.load(std::memory_order_relaxed);
+      result.evictions += shard.evictions;
+      result.size += shard.items.size();
+    }
+    return result;
+  }
+
+ private:
+  typedef std::list<Key> Clock;
+
+  struct Node {
+    Node(Value const& v, typename Clock::iterator p)
+        : value(v), referenced(false), position(p) {}
+
+    Value value;
+    /// @brief set when the entry is read, cleared when the hand passes
+    std::atomic<bool> referenced;
+    typename Clock::iterator position;
+  };
+
+  typedef std::unordered_map<Key, Node, Hash, KeyEqual> Items;
+
+  struct Shard {
+    Shard() : hand(clock.end()), hits(0), misses(0), evictions(0) {}
+
+    mutable ReadWriteLock lock;
+    Items items;
+    /// @brief the keys in the order the hand visits them
+    Clock clock;
+    /// @brief the next key to look at, end() means the front
+    typename Clock::iterator hand;
+    std::atomic<uint64_t> hits;
+    std::atomic<uint64_t> misses;
+    /// @brief only modified under the write lock
+    uint64_t evictions;
+  };
+
+  Shard& shardFor(Key const& key) {
+    // the maps use the hash as well, so mix it before taking the low bits
+    uint64_t h = fasthash64_uint64(static_cast<uint64_t>(Hash()(key)), 0xdeadbeefdeadbeefULL);
+    return _shards[h & (_numShards - 1)];
+  }
+
+  /// @brief evicts the first entry the hand finds without its referenced
+  /// flag, clearing the flags it passes. must hold the write lock
+  void evictOne(Shard& shard) {
+    TRI_ASSERT(!shard.items.empty());
+    while (true) {
+      if (shard.hand == shard.clock.end()) {
+        shard.hand = shard.clock.begin();
+      }
+      auto it = shard.items.find(*shard.hand);
+      TRI_ASSERT(it != shard.items.end());
+      if (it->second.referenced.exchange(false, std::memory_order_relaxed)) {
+        ++shard.hand;
+        continue;
+      }
+      erase(shard, it);
+      ++shard.evictions;
+      return;
+    }
+  }
+
+  /// @brief must hold the write lock
+  void erase(Shard& shard, typename Items::iterator it) {
+    auto position = it->second.position;
+    if (position == shard.hand) {
+      shard.hand = shard.clock.erase(position);
+    } else {
+      shard.clock.erase(position);
+    }
+    shard.items.erase(it);
+  }
+
+ private:
+  size_t _numShards;
+  size_t _maxPerShard;
+  std::unique_ptr<Shard[]> _shards;
+};
+
+}  // namespace basics
+}  // namespace arangodb
+
+#endif
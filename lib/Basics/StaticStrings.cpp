@@ -48,6 +48,7 @@ std::string const StaticStrings::ToString("_to");
 
 // URL parameter names
 std::string const StaticStrings::IgnoreRevsString("ignoreRevs");
+std::string const StaticStrings::IncrementNumbersString("incrementNumbers");
 std::string const StaticStrings::IsRestoreString("isRestore");
 std::string const StaticStrings::KeepNullString("keepNull");
 std::string const StaticStrings::MergeObjectsString("mergeObjects");
@@ -172,11 +173,14 @@ std::string const StaticStrings::PotentialDirtyRead(
 std::string const StaticStrings::RequestForwardedTo(
     "x-arango-request-forwarded-to");
 std::string const StaticStrings::ResponseCode("x-arango-response-code");
+std::string const StaticStrings::RetryAfter("retry-after");
 std::string const StaticStrings::Server("server");
+std::string const StaticStrings::Trace("x-arango-trace");
 std::string const StaticStrings::TransactionBody("x-arango-trx-body");
 std::string const StaticStrings::TransactionId("x-arango-trx-id");
 
 std::string const StaticStrings::Unlimited = "unlimited";
+std::string const StaticStrings::Vary("vary");
 std::string const StaticStrings::WwwAuthenticate("www-authenticate");
 std::string const StaticStrings::XContentTypeOptions("x-content-type-options");
 std::string const StaticStrings::XArangoNoLock("x-arango-nolock");
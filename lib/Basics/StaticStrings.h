@@ -54,6 +54,7 @@ class StaticStrings {
 
   // URL parameter names
   static std::string const IgnoreRevsString;
+  static std::string const IncrementNumbersString;
   static std::string const IsRestoreString;
   static std::string const KeepNullString;
   static std::string const MergeObjectsString;
@@ -159,10 +160,13 @@ class StaticStrings {
   static std::string const PotentialDirtyRead;
   static std::string const RequestForwardedTo;
   static std::string const ResponseCode;
+  static std::string const RetryAfter;
   static std::string const Server;
+  static std::string const Trace;
   static std::string const TransactionBody;
   static std::string const TransactionId;
   static std::string const Unlimited;
+  static std::string const Vary;
   static std::string const WwwAuthenticate;
   static std::string const XContentTypeOptions;
   static std::string const XArangoNoLock;
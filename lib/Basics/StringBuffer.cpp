@@ -245,6 +245,76 @@ int TRI_DeflateStringBuffer(TRI_string_buffer_t* self, size_t bufferSize) {
   return TRI_ERROR_NO_ERROR;
 }
 
+/// @brief compress the string buffer using deflate and append the result to
+/// another string buffer
+int TRI_CompressStringBuffer(TRI_string_buffer_t const* self, TRI_string_buffer_t* out,
+                             bool gzip, int level) {
+  z_stream strm;
+  strm.zalloc = Z_NULL;
+  strm.zfree = Z_NULL;
+  strm.opaque = Z_NULL;
+
+  // window bits 15 plus 16 selects the gzip wrapper
+  int res = deflateInit2(&strm, level, Z_DEFLATED, gzip ? 15 + 16 : 15, 8,
+                         Z_DEFAULT_STRATEGY);
+
+  if (res != Z_OK) {
+    return TRI_ERROR_OUT_OF_MEMORY;
+  }
+
+  char const* ptr = TRI_BeginStringBuffer(self);
+  char const* end = ptr + TRI_LengthStringBuffer(self);
+
+  // zlib counts in uInt, so feed huge buffers in pieces
+  size_t const maxChunk = static_cast<size_t>(1) << 30;
+
+  // the output is written into the target buffer directly. deflateBound
+  // is an upper bound for the whole input, so there is usually no need to
+  // grow the buffer again
+  res = Reserve(out, static_cast<size_t>(
+                         deflateBound(&strm, static_cast<uLong>((std::min)(
+                                                 static_cast<size_t>(end - ptr), maxChunk)))));
+
+  while (res == TRI_ERROR_NO_ERROR) {
+    size_t n = (std::min)(static_cast<size_t>(end - ptr), maxChunk);
+    int flush = (ptr + n == end) ? Z_FINISH : Z_NO_FLUSH;
+
+    strm.next_in = (unsigned char*)ptr;
+    strm.avail_in = static_cast<uInt>(n);
+    ptr += n;
+
+    int rc;
+    do {
+      if (Remaining(out) == 0) {
+        res = Reserve(out, 16384);
+        if (res != TRI_ERROR_NO_ERROR) {
+          break;
+        }
+      }
+
+      size_t avail = (std::min)(Remaining(out), maxChunk);
+      strm.next_out = (unsigned char*)out->_current;
+      strm.avail_out = static_cast<uInt>(avail);
+
+      rc = deflate(&strm, flush);
+
+      if (rc == Z_STREAM_ERROR) {
+        res = TRI_ERROR_INTERNAL;
+        break;
+      }
+      out->_current += avail - strm.avail_out;
+    } while (strm.avail_out == 0 || (flush == Z_FINISH && rc != Z_STREAM_END));
+
+    if (flush == Z_FINISH) {
+      break;
+    }
+  }
+
+  (void)deflateEnd(&strm);
+
+  return res;
+}
+
 /// @brief ensure the string buffer has a specific capacity
 int TRI_ReserveStringBuffer(TRI_string_buffer_t* self, size_t const length) {
   if (length > 0) {
@@ -72,6 +72,12 @@ void TRI_FreeStringBuffer(TRI_string_buffer_t*);
 /// @brief compress the string buffer using deflate
 int TRI_DeflateStringBuffer(TRI_string_buffer_t*, size_t);
 
+/// @brief compress the string buffer using deflate and append the result to
+/// another string buffer. with gzip, the output has a gzip wrapper (RFC 1952),
+/// otherwise a zlib wrapper (RFC 1950)
+int TRI_CompressStringBuffer(TRI_string_buffer_t const*, TRI_string_buffer_t* out,
+                             bool gzip, int level);
+
 /// @brief ensure the string buffer has a specific capacity
 int TRI_ReserveStringBuffer(TRI_string_buffer_t*, size_t const);
 
@@ -290,6 +296,13 @@ class StringBuffer {
     return TRI_DeflateStringBuffer(&_buffer, bufferSize);
   }
 
+  /// @brief compress the buffer into StringBuffer out, using gzip or zlib
+  /// format. the buffer itself is left unchanged
+  int compress(arangodb::basics::StringBuffer& out, bool gzip,
+               int level = Z_DEFAULT_COMPRESSION) const {
+    return TRI_CompressStringBuffer(&_buffer, &out._buffer, gzip, level);
+  }
+
   /// @brief uncompress the buffer into stringstream out, using zlib-inflate
   int inflate(std::stringstream& out, size_t bufferSize = 16384, size_t skip = 0) {
     z_stream strm;
@@ -345,10 +358,11 @@ class StringBuffer {
       } while (strm.avail_out == 0);
     } while (res != Z_STREAM_END);
 
-    if (res != Z_STREAM_END) {
+    if (res == Z_STREAM_END) {
       return TRI_ERROR_NO_ERROR;
     }
 
+    // input ended before the end of the stream
     return TRI_ERROR_INTERNAL;
   }
 
@@ -422,10 +436,11 @@ class StringBuffer {
       } while (strm.avail_out == 0);
     } while (res != Z_STREAM_END);
 
-    if (res != Z_STREAM_END) {
+    if (res == Z_STREAM_END) {
       return TRI_ERROR_NO_ERROR;
     }
 
+    // input ended before the end of the stream
     return TRI_ERROR_INTERNAL;
   }
 
@@ -117,6 +117,27 @@ int Utf8Helper::compareUtf16(uint16_t const* left, size_t leftLength,
                         (const UChar*)right, (int32_t)rightLength);
 }
 
+void Utf8Helper::sortKeyUtf8(char const* value, size_t length, std::string& result) const {
+  TRI_ASSERT(value != nullptr);
+  TRI_ASSERT(_coll);
+
+  icu::UnicodeString str =
+      icu::UnicodeString::fromUTF8(icu::StringPiece(value, (int32_t)length));
+
+  result.resize(2 * length + 16);
+  int32_t size = _coll->getSortKey(str, reinterpret_cast<uint8_t*>(&result[0]),
+                                   (int32_t)result.size());
+  if (size > (int32_t)result.size()) {
+    result.resize(size);
+    size = _coll->getSortKey(str, reinterpret_cast<uint8_t*>(&result[0]),
+                             (int32_t)result.size());
+  }
+  // the sort key is terminated by a zero byte, which does not change the
+  // order
+  TRI_ASSERT(size > 0);
+  result.resize(size > 0 ? size - 1 : 0);
+}
+
 bool Utf8Helper::setCollatorLanguage(std::string const& lang, void* icuDataPointer) {
   if (icuDataPointer == nullptr) {
     return false;
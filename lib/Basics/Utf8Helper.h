@@ -88,6 +88,14 @@ class Utf8Helper {
   int compareUtf16(uint16_t const* left, size_t leftLength,
                    uint16_t const* right, size_t rightLength) const;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief computes the collation sort key of an utf8 string. comparing
+  /// the sort keys of two strings bytewise gives the same result as
+  /// compareUtf8 on the strings
+  //////////////////////////////////////////////////////////////////////////////
+
+  void sortKeyUtf8(char const* value, size_t length, std::string& result) const;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief set collator by language
   /// @param lang   Lowercase two-letter or three-letter ISO-639 code.
@@ -0,0 +1,74 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "VelocyPackBuilderPool.h"
+
+#include <velocypack/Buffer.h>
+
+using namespace arangodb;
+using namespace arangodb::basics;
+
+constexpr size_t VelocyPackBuilderPool::InitialCapacity;
+constexpr size_t VelocyPackBuilderPool::MaxRetainedCapacity;
+constexpr size_t VelocyPackBuilderPool::MaxPooled;
+
+namespace {
+thread_local std::vector<std::unique_ptr<velocypack::Builder>> pooled;
+}
+
+std::unique_ptr<velocypack::Builder> VelocyPackBuilderPool::lease(velocypack::Options const* options) {
+  TRI_ASSERT(options != nullptr);
+
+  std::unique_ptr<velocypack::Builder> builder;
+  if (!::pooled.empty()) {
+    builder = std::move(::pooled.back());
+    ::pooled.pop_back();
+    builder->options = options;
+  } else {
+    builder = std::make_unique<velocypack::Builder>(options);
+    builder->reserve(InitialCapacity);
+  }
+
+  TRI_ASSERT(builder->isEmpty());
+  return builder;
+}
+
+void VelocyPackBuilderPool::release(std::unique_ptr<velocypack::Builder> builder) noexcept {
+  if (builder == nullptr || builder->buffer() == nullptr) {
+    // the buffer has been stolen
+    return;
+  }
+
+  if (builder->buffer()->capacity() > MaxRetainedCapacity) {
+    // do not keep the memory of exceptionally large results around
+    return;
+  }
+  builder->clear();
+
+  if (::pooled.size() < MaxPooled) {
+    try {
+      ::pooled.emplace_back(std::move(builder));
+    } catch (...) {
+      // the builder is freed instead
+    }
+  }
+}
+
+size_t VelocyPackBuilderPool::numPooled() noexcept { return ::pooled.size(); }
@@ -0,0 +1,89 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_BASICS_VELOCY_PACK_BUILDER_POOL_H
+#define ARANGODB_BASICS_VELOCY_PACK_BUILDER_POOL_H 1
+
+#include "Basics/Common.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Options.h>
+
+namespace arangodb {
+namespace basics {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief per-thread pool of builders
+///
+/// Builders returned to the pool keep the memory of their buffers, so that
+/// the next lease on the same thread can build a result of similar size
+/// without growing the buffer again. Builders whose buffers have grown
+/// beyond MaxRetainedCapacity are freed when returned, and at most
+/// MaxPooled builders are kept per thread.
+////////////////////////////////////////////////////////////////////////////////
+
+class VelocyPackBuilderPool {
+ public:
+  /// @brief initial capacity of newly created builders
+  static constexpr size_t InitialCapacity = 4096;
+
+  /// @brief largest buffer capacity kept by a pooled builder
+  static constexpr size_t MaxRetainedCapacity = 4 * 1024 * 1024;
+
+  /// @brief number of builders kept per thread
+  static constexpr size_t MaxPooled = 8;
+
+  VelocyPackBuilderPool() = delete;
+
+  /// @brief lease an empty builder using the given options
+  static std::unique_ptr<velocypack::Builder> lease(
+      velocypack::Options const* options = &velocypack::Options::Defaults);
+
+  /// @brief return a builder to the pool of the calling thread
+  static void release(std::unique_ptr<velocypack::Builder> builder) noexcept;
+
+  /// @brief number of builders currently pooled by the calling thread
+  static size_t numPooled() noexcept;
+};
+
+/// @brief leases a builder from the pool of the current thread and returns
+/// it when going out of scope
+class PooledBuilder {
+ public:
+  explicit PooledBuilder(velocypack::Options const* options = &velocypack::Options::Defaults)
+      : _builder(VelocyPackBuilderPool::lease(options)) {}
+
+  ~PooledBuilder() { VelocyPackBuilderPool::release(std::move(_builder)); }
+
+  PooledBuilder(PooledBuilder const&) = delete;
+  PooledBuilder& operator=(PooledBuilder const&) = delete;
+
+  inline velocypack::Builder* builder() const { return _builder.get(); }
+  inline velocypack::Builder* operator->() const { return _builder.get(); }
+  inline velocypack::Builder& operator*() const { return *_builder; }
+
+ private:
+  std::unique_ptr<velocypack::Builder> _builder;
+};
+
+}  // namespace basics
+}  // namespace arangodb
+
+#endif
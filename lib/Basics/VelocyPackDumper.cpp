@@ -36,6 +36,11 @@
 
 #include <velocypack/velocypack-aliases.h>
 
+#if defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+#include <emmintrin.h>
+#define ARANGODB_DUMPER_SSE2 1
+#endif
+
 using namespace arangodb::basics;
 
 static size_t const MinReserveValue = 32;
@@ -264,6 +269,50 @@ void VelocyPackDumper::appendUnicodeCharacter(uint16_t value) {
   TRI_AppendCharUnsafeStringBuffer(buffer, (p < 10) ? ('0' + p) : ('A' + p - 10));
 }
 
+namespace {
+
+/// @brief whether a byte can be copied into a JSON string unchanged.
+/// forward slashes are handled by the slow path, as they are only escaped
+/// on request
+inline bool isPlainCharacter(uint8_t c) {
+  return c >= 0x20U && c < 0x80U && c != '"' && c != '\\' && c != '/';
+}
+
+/// @brief length of the longest prefix of [p, e) that consists of plain
+/// characters only. with SSE2, 16 bytes are checked at once
+inline size_t plainPrefixLength(uint8_t const* p, uint8_t const* e) {
+  uint8_t const* start = p;
+
+#ifdef ARANGODB_DUMPER_SSE2
+  __m128i const controls = _mm_set1_epi8(0x20);
+  __m128i const quote = _mm_set1_epi8('"');
+  __m128i const backslash = _mm_set1_epi8('\\');
+  __m128i const slash = _mm_set1_epi8('/');
+
+  while (e - p >= 16) {
+    __m128i const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+    // the signed comparison catches control characters as well as all
+    // bytes >= 0x80
+    __m128i special = _mm_cmplt_epi8(v, controls);
+    special = _mm_or_si128(special, _mm_cmpeq_epi8(v, quote));
+    special = _mm_or_si128(special, _mm_cmpeq_epi8(v, backslash));
+    special = _mm_or_si128(special, _mm_cmpeq_epi8(v, slash));
+    int const mask = _mm_movemask_epi8(special);
+    if (mask != 0) {
+      return static_cast<size_t>(p - start) + __builtin_ctz(mask);
+    }
+    p += 16;
+  }
+#endif
+
+  while (p < e && isPlainCharacter(*p)) {
+    ++p;
+  }
+  return static_cast<size_t>(p - start);
+}
+
+}  // namespace
+
 void VelocyPackDumper::appendString(char const* src, VPackValueLength len) {
   static char const EscapeTable[256] = {
       // 0    1    2    3    4    5    6    7    8    9    A    B    C    D    E
@@ -313,6 +362,16 @@ void VelocyPackDumper::appendString(char const* src, VPackValueLength len) {
   uint8_t const* p = reinterpret_cast<uint8_t const*>(src);
   uint8_t const* e = p + len;
   while (p < e) {
+    // copy runs of characters that need no escaping in one go
+    size_t const plain = plainPrefixLength(p, e);
+    if (plain > 0) {
+      TRI_AppendStringUnsafeStringBuffer(buffer, reinterpret_cast<char const*>(p), plain);
+      p += plain;
+      if (p == e) {
+        break;
+      }
+    }
+
     uint8_t c = *p;
 
     if ((c & 0x80U) == 0) {
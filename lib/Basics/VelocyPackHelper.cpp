@@ -175,7 +175,12 @@ void VelocyPackHelper::initialize() {
   // initialize attribute translator
   ::translator.reset(new VPackAttributeTranslator);
 
-  // these attribute names will be translated into short integer values
+  // these attribute names will be translated into short integer values.
+  // the translated values are stored in documents on disk, sent to
+  // replication followers and read by other servers of the cluster, which
+  // all resolve them through this one process-wide translator. new names
+  // can thus not be added without breaking the data format, and there can
+  // be no per-collection translations
   ::translator->add(StaticStrings::KeyString, KeyAttribute - AttributeBase);
   ::translator->add(StaticStrings::RevString, RevAttribute - AttributeBase);
   ::translator->add(StaticStrings::IdString, IdAttribute - AttributeBase);
@@ -23,6 +23,65 @@
 
 #include "csv.h"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the number of bytes at the start of [ptr, end) that are
+/// none of c1, c2 and c3. with SSE2, 32 bytes are classified at once, so
+/// long fields are skipped without looking at each byte individually
+////////////////////////////////////////////////////////////////////////////////
+
+inline size_t plainLength(char const* ptr, char const* end, char c1, char c2, char c3) {
+  char const* p = ptr;
+
+#ifdef __SSE2__
+  __m128i const v1 = _mm_set1_epi8(c1);
+  __m128i const v2 = _mm_set1_epi8(c2);
+  __m128i const v3 = _mm_set1_epi8(c3);
+
+  while (end - p >= 32) {
+    __m128i const lo = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+    __m128i const hi = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p + 16));
+    __m128i const mlo =
+        _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(lo, v1), _mm_cmpeq_epi8(lo, v2)),
+                     _mm_cmpeq_epi8(lo, v3));
+    __m128i const mhi =
+        _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(hi, v1), _mm_cmpeq_epi8(hi, v2)),
+                     _mm_cmpeq_epi8(hi, v3));
+    uint32_t const mask = static_cast<uint32_t>(_mm_movemask_epi8(mlo)) |
+                          (static_cast<uint32_t>(_mm_movemask_epi8(mhi)) << 16);
+    if (mask != 0) {
+      return static_cast<size_t>(p - ptr) + __builtin_ctz(mask);
+    }
+    p += 32;
+  }
+#endif
+
+  while (p < end && *p != c1 && *p != c2 && *p != c3) {
+    ++p;
+  }
+  return static_cast<size_t>(p - ptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief moves the plain bytes of a field to the written position. for
+/// unquoted fields both positions are the same and nothing is copied
+////////////////////////////////////////////////////////////////////////////////
+
+inline void copyPlain(char*& qtr, char*& ptr, size_t length) {
+  if (qtr != ptr) {
+    memmove(qtr, ptr, length);
+  }
+  qtr += length;
+  ptr += length;
+}
+
+}  // namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief inits a CSV parser
 ////////////////////////////////////////////////////////////////////////////////
@@ -274,10 +333,8 @@ int TRI_ParseCsvString(TRI_csv_parser_t* parser, char const* line, size_t length
           break;
 
         case TRI_CSV_PARSER_WITHIN_FIELD:
-          while (ptr < parser->_stop && *ptr != parser->_separator &&
-                 *ptr != '\r' && *ptr != '\n') {
-            *qtr++ = *ptr++;
-          }
+          copyPlain(qtr, ptr, plainLength(ptr, parser->_stop,
+                                          parser->_separator, '\r', '\n'));
 
           // found separator or eol
           if (ptr < parser->_stop) {
@@ -323,10 +380,10 @@ int TRI_ParseCsvString(TRI_csv_parser_t* parser, char const* line, size_t length
         case TRI_CSV_PARSER_WITHIN_QUOTED_FIELD:
           TRI_ASSERT(parser->_useQuote);
 
-          while (ptr < parser->_stop && *ptr != parser->_quote &&
-                 (!parser->_useBackslash || *ptr != '\\')) {
-            *qtr++ = *ptr++;
-          }
+          copyPlain(qtr, ptr,
+                    plainLength(ptr, parser->_stop, parser->_quote,
+                                parser->_useBackslash ? '\\' : parser->_quote,
+                                parser->_quote));
 
           // found quote or a backslash, need at least another quote, a
           // separator, or an eol
@@ -408,13 +408,19 @@ static const uint32_t Crc32Lookup[8][256] = {
      0x14124958, 0x5d2e347f, 0xe54c35a1, 0xac704886, 0x7734cfef, 0x3e08b2c8,
      0xc451b7cc, 0x8d6dcaeb, 0x56294d82, 0x1f1530a5}};
 
-/// @brief Detection of Intel SSE4.2 extensions at runtime:
-#if ENABLE_ASM_CRC32 == 1
+/// @brief hardware support for CRC32C, which is the CRC32 variant
+/// computed here. on x86-64, the SSE4.2 extensions are detected at runtime.
+/// the hand-optimized assembler version is preferred if it was compiled in,
+/// the intrinsics are used otherwise. on ARMv8, the CRC32 extension must
+/// have been enabled at compile time
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+
+#define TRI_CRC32_HARDWARE 1
 
 #include <cpuid.h>
 #include <x86intrin.h>
 
-static bool HasSSE42() {
+static bool HasHardwareCrc32() {
   unsigned int eax, ebx, ecx, edx;
   if (__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
     if ((ecx & 0x100000) != 0) {
@@ -427,29 +433,47 @@ static bool HasSSE42() {
   }
 }
 
-// The following is currently not used, it is a fallback for the case
-// that the pure assembler source cannot be assembled or linked for
-// some reason.
-
-#if 0
-extern "C" uint32_t TRI_BlockCrc32_intrinsics(uint32_t value,
-                                              char const* data,
-                                              size_t length) {
+#if ENABLE_ASM_CRC32 != 1
+__attribute__((target("sse4.2"))) static uint32_t TRI_BlockCrc32_Hardware(
+    uint32_t value, char const* data, size_t length) {
   uint64_t tmp = value;
-  auto p = reinterpret_cast<uint64_t const*>(data);
   while (length >= 8) {
-    tmp = _mm_crc32_u64(tmp, *p++);
+    uint64_t word;
+    memcpy(&word, data, sizeof(word));
+    tmp = _mm_crc32_u64(tmp, word);
+    data += 8;
     length -= 8;
   }
-  auto p2 = reinterpret_cast<unsigned char const*>(p);
   value = static_cast<uint32_t>(tmp);
   while (length-- > 0) {
-    value = _mm_crc32_u8(value, *p2++);
+    value = _mm_crc32_u8(value, static_cast<unsigned char>(*data++));
   }
   return value;
 }
 #endif
 
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+
+#define TRI_CRC32_HARDWARE 1
+
+#include <arm_acle.h>
+
+static bool HasHardwareCrc32() { return true; }
+
+static uint32_t TRI_BlockCrc32_Hardware(uint32_t value, char const* data, size_t length) {
+  while (length >= 8) {
+    uint64_t word;
+    memcpy(&word, data, sizeof(word));
+    value = __crc32cd(value, word);
+    data += 8;
+    length -= 8;
+  }
+  while (length-- > 0) {
+    value = __crc32cb(value, static_cast<uint8_t>(*data++));
+  }
+  return value;
+}
+
 #endif
 
 /// @brief CRC32 value of data block
@@ -495,11 +519,14 @@ uint32_t TRI_BlockCrc32_C(uint32_t value, char const* data, size_t length) {
 #endif
 }
 
-#if ENABLE_ASM_CRC32 == 1
+#ifdef TRI_CRC32_HARDWARE
 static uint32_t TRI_BlockCrc32_Detect(uint32_t hash, char const* data, size_t length) {
-  if (HasSSE42()) {
+  if (HasHardwareCrc32()) {
+#if ENABLE_ASM_CRC32 == 1
     TRI_BlockCrc32 = TRI_BlockCrc32_SSE42;
-    // TRI_BlockCrc32 = TRI_BlockCrc32_intrinsics;
+#else
+    TRI_BlockCrc32 = TRI_BlockCrc32_Hardware;
+#endif
   } else {
     TRI_BlockCrc32 = TRI_BlockCrc32_C;
   }
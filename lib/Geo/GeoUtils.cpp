@@ -117,6 +117,21 @@ void GeoUtils::scanIntervals(QueryParams const& params, std::vector<S2CellId> co
   // sort these disjunct intervals
   std::sort(sortedIntervals.begin(), sortedIntervals.end(), Interval::compare);
 
+  // merge the intervals of adjacent cells, so that they are scanned as one
+  // sequential range instead of seeking to each of them
+  size_t last = 0;
+  for (size_t i = 1; i < sortedIntervals.size(); i++) {
+    Interval& prev = sortedIntervals[last];
+    Interval const& next = sortedIntervals[i];
+    if (prev.range_max.is_leaf() && next.range_min.is_leaf() &&
+        prev.range_max.next() == next.range_min) {
+      prev.range_max = next.range_max;
+    } else {
+      sortedIntervals[++last] = next;
+    }
+  }
+  sortedIntervals.erase(sortedIntervals.begin() + last + 1, sortedIntervals.end());
+
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
   //  constexpr size_t diff = 64;
   for (size_t i = 0; i < sortedIntervals.size() - 1; i++) {
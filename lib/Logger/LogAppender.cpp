@@ -36,7 +36,7 @@ using namespace arangodb::basics;
 
 arangodb::Mutex LogAppender::_appendersLock;
 
-std::map<size_t, std::vector<std::shared_ptr<LogAppender>>> LogAppender::_topics2appenders;
+std::array<std::vector<std::shared_ptr<LogAppender>>, LogTopic::MAX_LOG_TOPICS + 1> LogAppender::_topics2appenders;
 
 std::map<std::pair<std::string, std::string>, std::shared_ptr<LogAppender>> LogAppender::_definition2appenders;
 
@@ -177,28 +177,46 @@ std::pair<std::shared_ptr<LogAppender>, LogTopic*> LogAppender::buildAppender(
 }
 
 void LogAppender::log(LogMessage* message) {
+  MUTEX_LOCKER(guard, _appendersLock);
+  dispatch(message);
+}
+
+void LogAppender::logBatch(std::vector<LogMessage*> const& messages) {
+  MUTEX_LOCKER(guard, _appendersLock);
+
+  for (auto const& it : _definition2appenders) {
+    it.second->startBatch();
+  }
+
+  for (LogMessage* message : messages) {
+    try {
+      dispatch(message);
+    } catch (...) {
+    }
+  }
+
+  for (auto const& it : _definition2appenders) {
+    it.second->finishBatch();
+  }
+}
+
+void LogAppender::dispatch(LogMessage* message) {
   LogLevel level = message->_level;
   size_t topicId = message->_topicId;
   std::string const& m = message->_message;
   size_t offset = message->_offset;
 
-  MUTEX_LOCKER(guard, _appendersLock);
-
   // output to appender
   auto output = [&level, &m, &offset](size_t n) -> bool {
-    auto const& it = _topics2appenders.find(n);
+    auto const& appenders = _topics2appenders[n];
     bool shown = false;
 
-    if (it != _topics2appenders.end()) {
-      auto const& appenders = it->second;
-
-      for (auto const& appender : appenders) {
-        if (appender->checkContent(m)) {
-          appender->logMessage(level, m, offset);
-        }
-
-        shown = true;
+    for (auto const& appender : appenders) {
+      if (appender->checkContent(m)) {
+        appender->logMessage(level, m, offset);
       }
+
+      shown = true;
     }
 
     return shown;
@@ -227,7 +245,9 @@ void LogAppender::shutdown() {
   LogAppenderSyslog::close();
   LogAppenderFile::closeAll();
 
-  _topics2appenders.clear();
+  for (auto& appenders : _topics2appenders) {
+    appenders.clear();
+  }
   _definition2appenders.clear();
 }
 
@@ -28,9 +28,11 @@
 
 #include "Basics/Mutex.h"
 #include "Logger/LogLevel.h"
+#include "Logger/LogTopic.h"
+
+#include <array>
 
 namespace arangodb {
-class LogTopic;
 struct LogMessage;
 
 class LogAppender {
@@ -45,6 +47,10 @@ class LogAppender {
 
   static void log(LogMessage*);
 
+  /// @brief output a batch of messages. appenders may combine the writes of
+  /// the batch
+  static void logBatch(std::vector<LogMessage*> const&);
+
   static void reopen();
   static void shutdown();
 
@@ -57,6 +63,10 @@ class LogAppender {
 
   virtual std::string details() = 0;
 
+  /// @brief called around the messages of a batch
+  virtual void startBatch() {}
+  virtual void finishBatch() {}
+
  public:
   void logMessage(LogLevel level, std::string const& message) {
     logMessage(level, message, 0);
@@ -73,8 +83,13 @@ class LogAppender {
   std::string const _filter;  // an optional content filter for log messages
 
  private:
+  /// @brief output a message to its appenders, _appendersLock must be held
+  static void dispatch(LogMessage*);
+
   static Mutex _appendersLock;
-  static std::map<size_t, std::vector<std::shared_ptr<LogAppender>>> _topics2appenders;
+  /// @brief the appenders of each topic, the general appenders are at index
+  /// MAX_LOG_TOPICS
+  static std::array<std::vector<std::shared_ptr<LogAppender>>, LogTopic::MAX_LOG_TOPICS + 1> _topics2appenders;
   static std::map<std::pair<std::string, std::string>, std::shared_ptr<LogAppender>> _definition2appenders;
   static std::vector<std::function<void(LogMessage*)>> _loggers;
   static bool _allowStdLogging;
@@ -112,7 +112,7 @@ void LogAppenderStream::logMessage(LogLevel level, std::string const& message, s
 }
 
 LogAppenderFile::LogAppenderFile(std::string const& filename, std::string const& filter)
-    : LogAppenderStream(filename, filter, -1), _filename(filename) {
+    : LogAppenderStream(filename, filter, -1), _filename(filename), _batching(false) {
   if (_filename != "+" && _filename != "-") {
     // logging to an actual file
     size_t pos = 0;
@@ -159,6 +159,46 @@ LogAppenderFile::LogAppenderFile(std::string const& filename, std::string const&
 }
 
 void LogAppenderFile::writeLogMessage(LogLevel level, char const* buffer, size_t len) {
+  if (_batching && level != LogLevel::FATAL) {
+    // the log thread writes the messages of a batch with as few system
+    // calls as possible
+    _pending.append(buffer, len);
+    if (_pending.size() >= maxPendingSize) {
+      writeBuffer(_pending.data(), _pending.size());
+      _pending.clear();
+    }
+    return;
+  }
+
+  if (!_pending.empty()) {
+    writeBuffer(_pending.data(), _pending.size());
+    _pending.clear();
+  }
+  writeBuffer(buffer, len);
+
+  if (level == LogLevel::FATAL) {
+    FILE* f = TRI_FDOPEN(_fd, "a");
+    if (f != nullptr) {
+      // valid file pointer...
+      // now flush the file one last time before we shut down
+      fflush(f);
+    }
+  }
+}
+
+void LogAppenderFile::finishBatch() {
+  _batching = false;
+  if (!_pending.empty()) {
+    writeBuffer(_pending.data(), _pending.size());
+    _pending.clear();
+    if (_pending.capacity() > maxPendingSize) {
+      // do not keep the memory of an unusually large batch
+      _pending.shrink_to_fit();
+    }
+  }
+}
+
+void LogAppenderFile::writeBuffer(char const* buffer, size_t len) {
   bool giveUp = false;
 
   while (len > 0) {
@@ -180,15 +220,6 @@ void LogAppenderFile::writeLogMessage(LogLevel level, char const* buffer, size_t
     buffer += n;
     len -= n;
   }
-
-  if (level == LogLevel::FATAL) {
-    FILE* f = TRI_FDOPEN(_fd, "a");
-    if (f != nullptr) {
-      // valid file pointer...
-      // now flush the file one last time before we shut down
-      fflush(f);
-    }
-  }
 }
 
 std::string LogAppenderFile::details() {
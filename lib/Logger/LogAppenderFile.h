@@ -80,6 +80,9 @@ class LogAppenderFile : public LogAppenderStream {
 
   std::string details() override final;
 
+  void startBatch() override final { _batching = true; }
+  void finishBatch() override final;
+
  public:
   static void reopenAll();
   static void closeAll();
@@ -95,11 +98,21 @@ class LogAppenderFile : public LogAppenderStream {
   static void setFileGroup(int group) { _fileGroup = group; }
 
  private:
+  void writeBuffer(char const* buffer, size_t len);
+
+  /// @brief maximum size of the messages of a batch that are written at
+  /// once
+  static constexpr size_t maxPendingSize = 256 * 1024;
+
   static std::vector<std::tuple<int, std::string, LogAppenderFile*>> _fds;
   static int _fileMode;
   static int _fileGroup;
 
   std::string _filename;
+
+  /// @brief messages of the current batch that are not written yet
+  std::string _pending;
+  bool _batching;
 };
 
 class LogAppenderStdStream : public LogAppenderStream {
@@ -23,16 +23,98 @@
 
 #include "LogThread.h"
 #include "Basics/ConditionLocker.h"
+#include "Basics/MutexLocker.h"
 #include "Logger/LogAppender.h"
 #include "Logger/Logger.h"
 
+#include <algorithm>
+#include <chrono>
+
 using namespace arangodb;
 
+namespace {
+
+/// @brief a bounded single-producer single-consumer queue of messages. the
+/// producer is the thread owning the ring, the consumer the log thread
+struct LogRing {
+  static_assert((LogThread::RingSize & (LogThread::RingSize - 1)) == 0,
+                "ring size must be a power of two");
+
+  LogRing() : slots(new LogMessage*[LogThread::RingSize]), head(0), tail(0), orphaned(false) {}
+
+  ~LogRing() {
+    LogMessage* message;
+    while ((message = pop()) != nullptr) {
+      delete message;
+    }
+  }
+
+  bool push(LogMessage* message) {
+    size_t const t = tail.load(std::memory_order_relaxed);
+    if (t - head.load(std::memory_order_acquire) >= LogThread::RingSize) {
+      return false;
+    }
+    slots[t & (LogThread::RingSize - 1)] = message;
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+
+  LogMessage* pop() {
+    size_t const h = head.load(std::memory_order_relaxed);
+    if (h == tail.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    LogMessage* message = slots[h & (LogThread::RingSize - 1)];
+    head.store(h + 1, std::memory_order_release);
+    return message;
+  }
+
+  bool empty() const {
+    return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+  }
+
+  std::unique_ptr<LogMessage*[]> slots;
+  // head and tail are written by different threads
+  std::atomic<size_t> head;
+  char padding[64 - sizeof(std::atomic<size_t>)];
+  std::atomic<size_t> tail;
+  // set when the owning thread has exited
+  std::atomic<bool> orphaned;
+};
+
+/// @brief the rings of all threads that have logged. only modified when a
+/// thread logs for the first time and when the log thread removes the rings
+/// of exited threads
+arangodb::Mutex ringsLock;
+std::vector<std::shared_ptr<LogRing>> rings;
+
+std::atomic<uint64_t> dropped(0);
+
+/// @brief the ring of the calling thread, registered on first use
+struct RingHolder {
+  RingHolder() : ring(std::make_shared<LogRing>()) {
+    MUTEX_LOCKER(locker, ringsLock);
+    rings.emplace_back(ring);
+  }
+
+  ~RingHolder() {
+    // the log thread writes the remaining messages and frees the ring
+    ring->orphaned.store(true, std::memory_order_release);
+  }
+
+  std::shared_ptr<LogRing> ring;
+};
+
+LogRing& threadRing() {
+  thread_local RingHolder holder;
+  return *holder.ring;
+}
+
+}  // namespace
+
 arangodb::basics::ConditionVariable* LogThread::CONDITION = nullptr;
-boost::lockfree::queue<LogMessage*>* LogThread::MESSAGES = nullptr;
 
-LogThread::LogThread(std::string const& name) : Thread(name), _messages(0) {
-  MESSAGES = &_messages;
+LogThread::LogThread(std::string const& name) : Thread(name) {
   CONDITION = &_condition;
 }
 
@@ -43,19 +125,38 @@ LogThread::~LogThread() {
   shutdown();
 }
 
-void LogThread::log(std::unique_ptr<LogMessage>& message) {
-  if (MESSAGES->push(message.get())) {
+bool LogThread::log(std::unique_ptr<LogMessage>& message) {
+  // the monotonic clock is consistent across threads, and unlike a shared
+  // counter it does not make all logging threads write the same cache line
+  message->_timestamp = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+
+  if (::threadRing().push(message.get())) {
     // only release message if adding to the queue succeeded
     // otherwise we would leak here
     message.release();
+    return true;
   }
+  return false;
 }
 
 void LogThread::flush() {
   int tries = 0;
 
   while (++tries < 500) {
-    if (MESSAGES->empty()) {
+    bool empty = true;
+    {
+      MUTEX_LOCKER(locker, ::ringsLock);
+      for (auto const& ring : ::rings) {
+        if (!ring->empty()) {
+          empty = false;
+          break;
+        }
+      }
+    }
+    if (empty) {
       break;
     }
 
@@ -64,35 +165,96 @@ void LogThread::flush() {
   }
 }
 
+uint64_t LogThread::numDropped() {
+  return ::dropped.load(std::memory_order_relaxed);
+}
+
+void LogThread::countDropped() {
+  ::dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
 void LogThread::wakeup() {
   CONDITION_LOCKER(guard, *CONDITION);
   guard.signal();
 }
 
-bool LogThread::hasMessages() { return (!MESSAGES->empty()); }
+bool LogThread::hasMessages() {
+  MUTEX_LOCKER(locker, ::ringsLock);
+  for (auto const& ring : ::rings) {
+    if (!ring->empty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool LogThread::processMessages(std::vector<LogMessage*>& batch) {
+  {
+    MUTEX_LOCKER(locker, ::ringsLock);
+    for (auto it = ::rings.begin(); it != ::rings.end();) {
+      LogRing& ring = *(*it);
+      // check before draining, so that no message of an exited thread is
+      // left behind
+      bool const orphaned = ring.orphaned.load(std::memory_order_acquire);
+      LogMessage* message;
+      while ((message = ring.pop()) != nullptr) {
+        try {
+          batch.emplace_back(message);
+        } catch (...) {
+          delete message;
+        }
+      }
+      if (orphaned) {
+        it = ::rings.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  if (batch.empty()) {
+    return false;
+  }
+
+  // messages of different threads are interleaved as they were queued. the
+  // messages of one ring are already in order, and a stable sort keeps them
+  // so even if two of them got the same timestamp
+  std::stable_sort(batch.begin(), batch.end(), [](LogMessage const* lhs, LogMessage const* rhs) {
+    return lhs->_timestamp < rhs->_timestamp;
+  });
+
+  try {
+    LogAppender::logBatch(batch);
+  } catch (...) {
+  }
+
+  for (LogMessage* message : batch) {
+    delete message;
+  }
+  batch.clear();
+  return true;
+}
 
 void LogThread::run() {
-  LogMessage* msg;
+  std::vector<LogMessage*> batch;
+  uint64_t reportedDropped = 0;
 
   while (!isStopping() && Logger::_active.load()) {
-    while (_messages.pop(msg)) {
-      try {
-        LogAppender::log(msg);
-      } catch (...) {
-      }
+    processMessages(batch);
 
-      delete msg;
+    uint64_t const numDropped = ::dropped.load(std::memory_order_relaxed);
+    if (numDropped != reportedDropped) {
+      LOG_TOPIC("93a6f", INFO, arangodb::Logger::FIXME)
+          << (numDropped - reportedDropped)
+          << " log message(s) were dropped because too many messages were "
+             "queued";
+      reportedDropped = numDropped;
     }
 
     CONDITION_LOCKER(guard, *CONDITION);
     guard.wait(25 * 1000);
   }
 
-  while (_messages.pop(msg)) {
-    try {
-      LogAppender::log(msg);
-    } catch (...) {
-    }
-    delete msg;
+  while (processMessages(batch)) {
   }
 }
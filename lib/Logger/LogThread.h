@@ -27,8 +27,6 @@
 #include "Basics/ConditionVariable.h"
 #include "Basics/Thread.h"
 
-#include <boost/lockfree/queue.hpp>
-
 namespace arangodb {
 namespace basics {
 class ConditionVariable;
@@ -36,12 +34,34 @@ class ConditionVariable;
 
 struct LogMessage;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the thread writing the log messages
+///
+/// Every thread that logs queues its messages in a ring of its own, so that
+/// logging threads never wait for each other or for the log thread. The log
+/// thread collects the messages of all rings, restores the order in which
+/// they were queued and hands them to the appenders as one batch. When the
+/// ring of a thread is full, the message is not queued; the caller then
+/// either drops it or writes it directly.
+////////////////////////////////////////////////////////////////////////////////
+
 class LogThread final : public Thread {
  public:
-  static void log(std::unique_ptr<LogMessage>&);
+  /// @brief number of messages a thread can have queued
+  static constexpr size_t RingSize = 4096;
+
+  /// @brief queue a message. returns false and leaves the message to the
+  /// caller if the ring of the calling thread is full
+  static bool log(std::unique_ptr<LogMessage>&);
   // flush all pending log messages
   static void flush();
 
+  /// @brief number of messages that could not be queued
+  static uint64_t numDropped();
+
+  /// @brief count a message that could not be queued and was dropped
+  static void countDropped();
+
  public:
   explicit LogThread(std::string const& name);
   ~LogThread();
@@ -57,11 +77,12 @@ class LogThread final : public Thread {
   void wakeup();
 
  private:
+  /// @brief write all queued messages, returns whether there were any
+  bool processMessages(std::vector<LogMessage*>& batch);
+
   static arangodb::basics::ConditionVariable* CONDITION;
-  static boost::lockfree::queue<LogMessage*>* MESSAGES;
 
   arangodb::basics::ConditionVariable _condition;
-  boost::lockfree::queue<LogMessage*> _messages;
 };
 }  // namespace arangodb
 
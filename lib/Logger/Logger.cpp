@@ -373,14 +373,21 @@ void Logger::log(char const* function, char const* file, int line,
 
   // now either queue or output the message
   if (_threaded) {
+    bool const isDirectLogLevel =
+        (level == LogLevel::FATAL || level == LogLevel::ERR || level == LogLevel::WARN);
     try {
-      _loggingThread->log(msg);
-      bool const isDirectLogLevel =
-          (level == LogLevel::FATAL || level == LogLevel::ERR || level == LogLevel::WARN);
-      if (isDirectLogLevel) {
-        _loggingThread->flush();
+      if (_loggingThread->log(msg)) {
+        if (isDirectLogLevel) {
+          _loggingThread->flush();
+        }
+        return;
+      }
+      // the queue of this thread is full. rather than waiting for the log
+      // thread, less important messages are dropped
+      if (!isDirectLogLevel) {
+        LogThread::countDropped();
+        return;
       }
-      return;
     } catch (...) {
       // fall-through to non-threaded logging
     }
@@ -80,12 +80,16 @@ struct LogMessage {
   LogMessage& operator=(LogMessage const&) = delete;
 
   LogMessage(LogLevel level, size_t topicId, std::string&& message, size_t offset)
-      : _level(level), _topicId(topicId), _message(std::move(message)), _offset(offset) {}
+      : _level(level), _topicId(topicId), _message(std::move(message)), _offset(offset), _timestamp(0) {}
 
   LogLevel _level;
   size_t _topicId;
   std::string const _message;
   size_t _offset;
+  /// @brief monotonic time the message was queued at, in nanoseconds.
+  /// assigned by the LogThread to restore the order of the messages of
+  /// different threads
+  uint64_t _timestamp;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
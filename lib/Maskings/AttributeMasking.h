@@ -55,6 +55,8 @@ class AttributeMasking {
 
   bool match(std::vector<std::string> const&) const;
 
+  Path const& path() const { return _path; }
+
   MaskingFunction* func() const { return _func.get(); }
 
  private:
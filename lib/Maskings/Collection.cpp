@@ -88,12 +88,69 @@ ParseResult<Collection> Collection::parse(Maskings* maskings, VPackSlice const&
   return ParseResult<Collection>(Collection(selection, attributes));
 }
 
+constexpr size_t Collection::NoMasking;
+
+void Collection::buildMatcher() {
+  _matcher.clear();
+  _matcher.emplace_back();
+  _anyMasking = NoMasking;
+
+  for (size_t i = 0; i < _maskings.size(); ++i) {
+    Path const& path = _maskings[i].path();
+
+    if (path.any()) {
+      _anyMasking = std::min(_anyMasking, i);
+      continue;
+    }
+
+    size_t node = 0;
+    auto const& components = path.components();
+
+    for (auto it = components.rbegin(); it != components.rend(); ++it) {
+      auto child = _matcher[node].children.find(*it);
+
+      if (child == _matcher[node].children.end()) {
+        size_t next = _matcher.size();
+        _matcher[node].children.emplace(*it, next);
+        _matcher.emplace_back();
+        node = next;
+      } else {
+        node = child->second;
+      }
+    }
+
+    size_t& masking =
+        path.wildcard() ? _matcher[node].suffixMasking : _matcher[node].exactMasking;
+    masking = std::min(masking, i);
+  }
+}
+
 MaskingFunction* Collection::masking(std::vector<std::string> const& path) {
-  for (auto const& m : _maskings) {
-    if (m.match(path)) {
-      return m.func();
+  // the first masking in the definition matching the path wins
+  size_t found = _anyMasking;
+
+  if (!_matcher.empty()) {
+    size_t node = 0;
+
+    for (size_t i = path.size(); i > 0 && found > 0; --i) {
+      auto child = _matcher[node].children.find(path[i - 1]);
+
+      if (child == _matcher[node].children.end()) {
+        break;
+      }
+
+      node = child->second;
+      found = std::min(found, _matcher[node].suffixMasking);
+
+      if (i == 1) {
+        found = std::min(found, _matcher[node].exactMasking);
+      }
     }
   }
 
-  return nullptr;
+  if (found == NoMasking) {
+    return nullptr;
+  }
+
+  return _maskings[found].func();
 }
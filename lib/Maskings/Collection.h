@@ -25,6 +25,8 @@
 
 #include "Basics/Common.h"
 
+#include <limits>
+
 #include <velocypack/Builder.h>
 #include <velocypack/Iterator.h>
 #include <velocypack/Parser.h>
@@ -46,16 +48,37 @@ class Collection {
   Collection() {}
 
   Collection(CollectionSelection selection, std::vector<AttributeMasking> const& maskings)
-      : _selection(selection), _maskings(maskings) {}
+      : _selection(selection), _maskings(maskings) {
+    buildMatcher();
+  }
 
   CollectionSelection selection() const noexcept { return _selection; }
 
   MaskingFunction* masking(std::vector<std::string> const& path);
 
+ private:
+  static constexpr size_t NoMasking = std::numeric_limits<size_t>::max();
+
+  /// @brief node of the path matcher. the paths of the maskings are added
+  /// starting with their last component, so that exact and wildcard paths
+  /// are both matched by walking from an attribute towards the document
+  struct MatcherNode {
+    std::unordered_map<std::string, size_t> children;
+    /// @brief first masking with a wildcard path ending here
+    size_t suffixMasking = NoMasking;
+    /// @brief first masking with a complete path ending here
+    size_t exactMasking = NoMasking;
+  };
+
+  void buildMatcher();
+
  private:
   CollectionSelection _selection;
   // LATER: CollectionFilter _filter;
   std::vector<AttributeMasking> _maskings;
+  std::vector<MatcherNode> _matcher;
+  /// @brief first masking matching all paths
+  size_t _anyMasking = NoMasking;
 };
 }  // namespace maskings
 }  // namespace arangodb
@@ -25,9 +25,11 @@
 #include <iostream>
 
 #include "Basics/FileUtils.h"
+#include "Basics/VPackStringBufferAdapter.h"
 #include "Logger/Logger.h"
 #include "Random/RandomGenerator.h"
 
+#include <velocypack/Dumper.h>
 #include <velocypack/Iterator.h>
 #include <velocypack/Parser.h>
 #include <velocypack/velocypack-aliases.h>
@@ -176,55 +178,40 @@ bool Maskings::shouldDumpData(std::string const& name) {
   return false;
 }
 
-VPackValue Maskings::maskedItem(Collection& collection, std::vector<std::string>& path,
-                                std::string& buffer, VPackSlice const& data) {
-  static std::string xxxx("xxxx");
-
+void Maskings::addMaskedItem(Collection& collection, VPackBuilder& builder,
+                             std::vector<std::string>& path, VPackSlice const& data) {
   if (path.size() == 1 && path[0].size() >= 1 && path[0][0] == '_') {
-    if (data.isString()) {
-      velocypack::ValueLength length;
-      char const* c = data.getString(length);
-      buffer = std::string(c, length);
-      return VPackValue(buffer);
-    } else if (data.isInteger()) {
-      return VPackValue(data.getInt());
+    if (data.isString() || data.isInteger()) {
+      builder.add(data);
+      return;
     }
   }
 
   MaskingFunction* func = collection.masking(path);
 
   if (func == nullptr) {
-    if (data.isBool()) {
-      return VPackValue(data.getBool());
-    } else if (data.isString()) {
-      velocypack::ValueLength length;
-      char const* c = data.getString(length);
-      buffer = std::string(c, length);
-      return VPackValue(buffer);
-    } else if (data.isInteger()) {
-      return VPackValue(data.getInt());
-    } else if (data.isDouble()) {
-      return VPackValue(data.getDouble());
+    if (data.isBool() || data.isString() || data.isInteger() || data.isDouble()) {
+      builder.add(data);
     } else {
-      return VPackValue(VPackValueType::Null);
+      builder.add(VPackValue(VPackValueType::Null));
     }
   } else {
+    std::string buffer;
+
     if (data.isBool()) {
-      return func->mask(data.getBool(), buffer);
+      builder.add(func->mask(data.getBool(), buffer));
     } else if (data.isString()) {
       velocypack::ValueLength length;
       char const* c = data.getString(length);
-      return func->mask(std::string(c, length), buffer);
+      builder.add(func->mask(std::string(c, length), buffer));
     } else if (data.isInteger()) {
-      return func->mask(data.getInt(), buffer);
+      builder.add(func->mask(data.getInt(), buffer));
     } else if (data.isDouble()) {
-      return func->mask(data.getDouble(), buffer);
+      builder.add(func->mask(data.getDouble(), buffer));
     } else {
-      return VPackValue(VPackValueType::Null);
+      builder.add(VPackValue(VPackValueType::Null));
     }
   }
-
-  return VPackValue(xxxx);
 }
 
 void Maskings::addMaskedArray(Collection& collection, VPackBuilder& builder,
@@ -237,8 +224,7 @@ void Maskings::addMaskedArray(Collection& collection, VPackBuilder& builder,
       VPackArrayBuilder ap(&builder);
       addMaskedArray(collection, builder, path, entry);
     } else {
-      std::string buffer;
-      builder.add(maskedItem(collection, path, buffer, entry));
+      addMaskedItem(collection, builder, path, entry);
     }
   }
 }
@@ -258,8 +244,8 @@ void Maskings::addMaskedObject(Collection& collection, VPackBuilder& builder,
       VPackArrayBuilder ap(&builder, key);
       addMaskedArray(collection, builder, path, value);
     } else {
-      std::string buffer;
-      builder.add(key, maskedItem(collection, path, buffer, value));
+      builder.add(VPackValue(key));
+      addMaskedItem(collection, builder, path, value);
     }
 
     path.pop_back();
@@ -280,14 +266,14 @@ void Maskings::addMasked(Collection& collection, VPackBuilder& builder,
 }
 
 void Maskings::addMasked(Collection& collection, basics::StringBuffer& data,
-                         VPackSlice const& slice) {
+                         VPackBuilder& builder, VPackSlice const& slice) {
   if (!slice.isObject()) {
     return;
   }
 
   velocypack::StringRef dataStrRef("data");
 
-  VPackBuilder builder;
+  builder.clear();
 
   {
     VPackObjectBuilder ob(&builder);
@@ -303,9 +289,11 @@ void Maskings::addMasked(Collection& collection, basics::StringBuffer& data,
     }
   }
 
-  std::string masked = builder.toJson();
-  data.appendText(masked);
-  data.appendText("\n");
+  // dump straight into the result instead of going through a string
+  basics::VPackStringBufferAdapter adapter(data.stringBuffer());
+  VPackDumper dumper(&adapter);
+  dumper.dump(builder.slice());
+  data.appendChar('\n');
 }
 
 void Maskings::mask(std::string const& name, basics::StringBuffer const& data,
@@ -333,6 +321,11 @@ void Maskings::mask(std::string const& name, basics::StringBuffer const& data,
 
   result.reserve(data.length());
 
+  // the parser and the builder are reused for all documents, so that
+  // their buffers do not have to be allocated for each one again
+  VPackParser parser;
+  VPackBuilder builder;
+
   char const* p = data.c_str();
   char const* e = p + data.length();
   char const* q = p;
@@ -342,9 +335,10 @@ void Maskings::mask(std::string const& name, basics::StringBuffer const& data,
       ++p;
     }
 
-    std::shared_ptr<VPackBuilder> builder = VPackParser::fromJson(q, p - q);
-
-    addMasked(*collection, result, builder->slice());
+    if (p > q) {
+      parser.parse(q, p - q);
+      addMasked(*collection, result, builder, parser.builder().slice());
+    }
 
     while (p < e && (*p == '\n' || *p == '\r')) {
       ++p;
@@ -40,6 +40,8 @@ std::string GeneralRequest::translateVersion(ProtocolVersion version) {
       return "VST/1.1";
     case ProtocolVersion::VST_1_0:
       return "VST/1.0";
+    case ProtocolVersion::HTTP_2:
+      return "HTTP/2";
     case ProtocolVersion::HTTP_1_1:
       return "HTTP/1.1";
     case ProtocolVersion::HTTP_1_0:
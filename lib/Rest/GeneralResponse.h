@@ -153,6 +153,9 @@ class GeneralResponse {
 
   virtual int reservePayload(std::size_t size) { return TRI_ERROR_NO_ERROR; }
 
+  /// @brief size of the response body in bytes
+  virtual size_t bodySize() const = 0;
+
   /// used for head
   bool generateBody() const { return _generateBody; };
   /// used for head
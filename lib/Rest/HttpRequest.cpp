@@ -40,21 +40,35 @@
 using namespace arangodb;
 using namespace arangodb::basics;
 
+namespace {
+// headers up to this size are parsed in a copy on the stack, larger ones
+// in a copy on the heap
+constexpr size_t SmallHeaderSize = 4096;
+}  // namespace
+
 HttpRequest::HttpRequest(ConnectionInfo const& connectionInfo, char const* header,
                          size_t length, bool allowMethodOverride)
     : GeneralRequest(connectionInfo),
       _contentLength(0),
-      _header(nullptr),
+      _messageId(1),
       _allowMethodOverride(allowMethodOverride),
       _vpackBuilder(nullptr) {
   if (0 < length) {
     _contentType = ContentType::JSON;
     _contentTypeResponse = ContentType::JSON;
-    _header = std::unique_ptr<char[]>(new char[length + 1]);
-    memcpy(_header.get(), header, length);
 
-    (_header.get())[length] = 0;
-    parseHeader(length);
+    // parsing modifies the header, and everything it finds is copied into
+    // the request, so the header copy is not needed afterwards
+    char small[SmallHeaderSize];
+    std::unique_ptr<char[]> large;
+    char* copy = small;
+    if (length >= sizeof(small)) {
+      large.reset(new char[length + 1]);
+      copy = large.get();
+    }
+    memcpy(copy, header, length);
+    copy[length] = 0;
+    parseHeader(copy, length);
   }
 }
 
@@ -62,8 +76,8 @@ HttpRequest::HttpRequest(ContentType contentType, char const* body, int64_t cont
                          std::unordered_map<std::string, std::string> const& headers)
     : GeneralRequest(ConnectionInfo()),
       _contentLength(contentLength),
-      _header(nullptr),
       _body(body, contentLength),
+      _messageId(1),
       _allowMethodOverride(false),
       _vpackBuilder(nullptr) {
   _contentType = contentType;
@@ -71,8 +85,7 @@ HttpRequest::HttpRequest(ContentType contentType, char const* body, int64_t cont
   GeneralRequest::_headers = headers;
 }
 
-void HttpRequest::parseHeader(size_t length) {
-  char* start = _header.get();
+void HttpRequest::parseHeader(char* start, size_t length) {
   char* end = start + length;
   size_t const versionLength = strlen("http/1.x");
 
@@ -732,7 +745,12 @@ VPackSlice HttpRequest::payload(VPackOptions const* options) {
   if (_contentType == ContentType::JSON) {
     if (!_body.empty()) {
       if (!_vpackBuilder) {
-        VPackParser parser(options);
+        // the VelocyPack representation of a document is usually smaller
+        // than its JSON, so reserving the body size up front saves the
+        // repeated reallocations while parsing
+        auto builder = std::make_shared<VPackBuilder>(options);
+        builder->reserve(_body.size());
+        VPackParser parser(builder, options);
         parser.parse(_body);
         _vpackBuilder = parser.steal();
       }
@@ -33,6 +33,7 @@ class RestBatchHandler;
 
 namespace rest {
 class GeneralCommTask;
+class H2CommTask;
 class HttpCommTask;
 }  // namespace rest
 
@@ -42,6 +43,7 @@ struct Options;
 }  // namespace velocypack
 
 class HttpRequest final : public GeneralRequest {
+  friend class rest::H2CommTask;
   friend class rest::HttpCommTask;
   friend class rest::GeneralCommTask;
   friend class RestBatchHandler;  // TODO must be removed
@@ -72,6 +74,9 @@ class HttpRequest final : public GeneralRequest {
     return arangodb::Endpoint::TransportType::HTTP;
   }
 
+  // the HTTP/2 stream id, 1 for HTTP/1.x
+  uint64_t messageId() const override { return _messageId; }
+
   std::string const& cookieValue(std::string const& key) const;
   std::string const& cookieValue(std::string const& key, bool& found) const;
   std::unordered_map<std::string, std::string> cookieValues() const {
@@ -110,7 +115,8 @@ class HttpRequest final : public GeneralRequest {
   void setArrayValue(std::string const&& key, std::string const&& value);
 
  private:
-  void parseHeader(size_t length);
+  // parses the header in place, the buffer must be null-terminated
+  void parseHeader(char* start, size_t length);
   void setValues(char* buffer, char* end);
   void setCookie(char* key, size_t length, char const* value);
   void parseCookies(char const* buffer, size_t length);
@@ -118,8 +124,8 @@ class HttpRequest final : public GeneralRequest {
  private:
   std::unordered_map<std::string, std::string> _cookies;
   int64_t _contentLength;
-  std::unique_ptr<char[]> _header;
   std::string _body;
+  uint64_t _messageId;
 
   //  whether or not overriding the HTTP method via custom headers
   // (x-http-method, x-method-override or x-http-method-override) is allowed
@@ -45,7 +45,7 @@ using namespace arangodb::basics;
 bool HttpResponse::HIDE_PRODUCT_HEADER = false;
 
 HttpResponse::HttpResponse(ResponseCode code, basics::StringBuffer* buffer)
-    : GeneralResponse(code), _isHeadResponse(false), _body(buffer), _bodySize(0) {
+    : GeneralResponse(code), _isHeadResponse(false), _body(buffer), _bodySize(0), _messageId(1) {
   TRI_ASSERT(buffer != nullptr);
   _generateBody = false;
   _contentType = ContentType::TEXT;
@@ -33,11 +33,13 @@ namespace arangodb {
 class RestBatchHandler;
 
 namespace rest {
+class H2CommTask;
 class HttpCommTask;
 class GeneralCommTask;
 }  // namespace rest
 
 class HttpResponse : public GeneralResponse {
+  friend class rest::H2CommTask;
   friend class rest::HttpCommTask;
   friend class rest::GeneralCommTask;
   friend class RestBatchHandler;  // TODO must be removed
@@ -70,7 +72,7 @@ class HttpResponse : public GeneralResponse {
     TRI_ASSERT(_body);
     return *_body;
   }
-  size_t bodySize() const;
+  size_t bodySize() const override;
 
   // you should call writeHeader only after the body has been created
   void writeHeader(basics::StringBuffer*);  // override;
@@ -94,6 +96,9 @@ class HttpResponse : public GeneralResponse {
     return arangodb::Endpoint::TransportType::HTTP;
   }
 
+  // the HTTP/2 stream id, 1 for HTTP/1.x
+  uint64_t messageId() const override { return _messageId; }
+
  private:
   // the body must already be set. deflate is then run on the existing body
   int deflate(size_t = 16384);
@@ -109,6 +114,7 @@ class HttpResponse : public GeneralResponse {
   std::vector<std::string> _cookies;
   basics::StringBuffer* _body;
   size_t _bodySize;
+  uint64_t _messageId;
 
   void addPayloadInternal(velocypack::Slice, size_t, velocypack::Options const*, bool);
 };
@@ -61,6 +61,14 @@ class VstResponse : public GeneralResponse {
   void addPayload(VPackBuffer<uint8_t>&&, arangodb::velocypack::Options const* = nullptr,
                   bool resolveExternals = true) override;
 
+  size_t bodySize() const override {
+    size_t size = 0;
+    for (auto const& payload : _vpackPayloads) {
+      size += payload.size();
+    }
+    return size;
+  }
+
  private:
   //_responseCode   - from Base
   //_headers        - from Base
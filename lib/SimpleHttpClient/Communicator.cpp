@@ -24,6 +24,8 @@
 #include "Communicator.h"
 
 #include "Basics/MutexLocker.h"
+#include "Basics/StaticStrings.h"
+#include "Basics/StringBuffer.h"
 #include "Basics/socket-utils.h"
 #include "Logger/Logger.h"
 #include "Rest/HttpRequest.h"
@@ -325,8 +327,16 @@ void Communicator::createRequestInProgress(std::unique_ptr<NewRequest> newReques
     requestHeaders = curl_slist_append(requestHeaders, "Expect:");
   }
 
+  // bodies of large responses may be compressed by the peer, they are
+  // inflated again before they are handed out. headers of forwarded client
+  // requests must not ask for anything else
+  requestHeaders = curl_slist_append(requestHeaders, "Accept-Encoding: deflate");
+
   std::string thisHeader;
   for (auto const& header : request->headers()) {
+    if (header.first == StaticStrings::AcceptEncoding) {
+      continue;
+    }
     thisHeader.reserve(header.first.size() + header.second.size() + 2);
     thisHeader.append(header.first);
     thisHeader.append(": ", 2);
@@ -515,6 +525,23 @@ void Communicator::handleResult(CURL* handle, CURLcode rc) {
         long httpStatusCode = 200;
         curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, &httpStatusCode);
 
+        auto encoding = rip->_responseHeaders.find(StaticStrings::ContentEncoding);
+        if (encoding != rip->_responseHeaders.end() && encoding->second == "deflate") {
+          auto inflated = std::make_unique<basics::StringBuffer>(
+              rip->_responseBody->length() * 4, false);
+          if (rip->_responseBody->inflate(*inflated) != TRI_ERROR_NO_ERROR) {
+            LOG_TOPIC("3e1f7", ERR, Logger::COMMUNICATION)
+                << ::buildPrefix(rip->_newRequest->_ticketId)
+                << "cannot inflate response body";
+            callErrorFn(rip, TRI_ERROR_INTERNAL, {nullptr});
+            break;
+          }
+          rip->_responseBody = std::move(inflated);
+          rip->_responseHeaders.erase(encoding);
+          rip->_responseHeaders[StaticStrings::ContentLength] =
+              std::to_string(rip->_responseBody->length());
+        }
+
         // take over ownership for _responseBody
         auto response = std::make_unique<HttpResponse>(static_cast<ResponseCode>(httpStatusCode), rip->_responseBody.get());
         rip->_responseBody.release();
@@ -23,6 +23,7 @@
 #include "SslServerFeature.h"
 
 #include "Basics/FileUtils.h"
+#include "Basics/MutexLocker.h"
 #include "Logger/Logger.h"
 #include "ProgramOptions/ProgramOptions.h"
 #include "ProgramOptions/Section.h"
@@ -116,6 +117,9 @@ void SslServerFeature::prepare() {
 void SslServerFeature::unprepare() {
   LOG_TOPIC("7093e", TRACE, arangodb::Logger::SSL)
       << "unpreparing ssl: " << stringifySslOptions(_sslOptions);
+
+  MUTEX_LOCKER(guard, _sslContextLock);
+  _sslContext.reset();
 }
 
 void SslServerFeature::verifySslOptions() {
@@ -164,6 +168,15 @@ class BIOGuard {
 };
 }  // namespace
 
+std::shared_ptr<asio_ns::ssl::context> SslServerFeature::sslContext() {
+  MUTEX_LOCKER(guard, _sslContextLock);
+
+  if (_sslContext == nullptr) {
+    _sslContext = std::make_shared<asio_ns::ssl::context>(createSslContext());
+  }
+  return _sslContext;
+}
+
 asio_ns::ssl::context SslServerFeature::createSslContext() const {
   try {
     // create context
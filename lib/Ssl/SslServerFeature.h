@@ -31,6 +31,8 @@
 // needs to come second in order to recognize ssl
 #include "Basics/asio_ns.h"
 
+#include "Basics/Mutex.h"
+
 namespace arangodb {
 
 class SslServerFeature : public application_features::ApplicationFeature {
@@ -47,6 +49,11 @@ class SslServerFeature : public application_features::ApplicationFeature {
 
   virtual asio_ns::ssl::context createSslContext() const;
 
+  // the context of all server connections, created on first use. TLS
+  // sessions and session tickets can only be resumed on the context that
+  // created them
+  std::shared_ptr<asio_ns::ssl::context> sslContext();
+
  protected:
   std::string _cafile;
   std::string _keyfile;
@@ -60,6 +67,9 @@ class SslServerFeature : public application_features::ApplicationFeature {
   std::string stringifySslOptions(uint64_t opts) const;
 
   std::string _rctx;
+
+  Mutex _sslContextLock;
+  std::shared_ptr<asio_ns::ssl::context> _sslContext;
 };
 
 }  // namespace arangodb
@@ -51,6 +51,10 @@ class JavaScriptSecurityContext {
   /// @brief whether or not the context is an internal context
   bool isInternal() const { return _type == Type::Internal; }
 
+  /// @brief whether or not the context runs a user-defined REST action,
+  /// e.g. a Foxx route
+  bool isRestAction() const { return _type == Type::RestAction; }
+
   /// @brief whether or not db._useDatabase(...) is allowed
   bool canUseDatabase() const { return _canUseDatabase; }
 
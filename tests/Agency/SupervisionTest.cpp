@@ -26,11 +26,13 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "Agency/Job.h"
+#include "Agency/Node.h"
 #include "Agency/Supervision.h"
 
 #include "catch.hpp"
 
 #include <velocypack/Iterator.h>
+#include <velocypack/Parser.h>
 #include <velocypack/velocypack-aliases.h>
 
 #include <iostream>
@@ -41,6 +43,57 @@ using namespace arangodb::consensus;
 
 std::vector<std::string> servers {"XXX-XXX-XXX", "XXX-XXX-XXY"};
 
+static Node createNode(std::string const& json) {
+  VPackBuilder builder;
+  {
+    VPackObjectBuilder guard(&builder);
+    builder.add("new", VPackParser::fromJson(json)->slice());
+  }
+  Node node("ROOT");
+  node.handle<SET>(builder.slice());
+  return node;
+}
+
+// all shard leaders on A
+static char const* unbalancedLeaders = R"=(
+{
+  "Plan": {
+    "DBServers": {"A": "none", "B": "none"},
+    "Collections": {"db": {"c": {"shards": {
+      "s1": ["A", "B"], "s2": ["A", "B"], "s3": ["A", "B"]}}}}
+  },
+  "Current": {
+    "Collections": {"db": {"c": {
+      "s1": {"servers": ["A", "B"]},
+      "s2": {"servers": ["A", "B"]},
+      "s3": {"servers": ["A", "B"]}}}}
+  },
+  "Supervision": {
+    "Health": {"A": {"Status": "GOOD"}, "B": {"Status": "GOOD"}}
+  }
+}
+)=";
+
+// shard leaders spread over A and B
+static char const* balancedLeaders = R"=(
+{
+  "Plan": {
+    "DBServers": {"A": "none", "B": "none"},
+    "Collections": {"db": {"c": {"shards": {
+      "s1": ["A", "B"], "s2": ["B", "A"], "s3": ["A", "B"]}}}}
+  },
+  "Current": {
+    "Collections": {"db": {"c": {
+      "s1": {"servers": ["A", "B"]},
+      "s2": {"servers": ["B", "A"]},
+      "s3": {"servers": ["A", "B"]}}}}
+  },
+  "Supervision": {
+    "Health": {"A": {"Status": "GOOD"}, "B": {"Status": "GOOD"}}
+  }
+}
+)=";
+
 TEST_CASE("Supervision", "[agency][supervision]") {
 
   SECTION("Checking for the delete transaction 0 servers") {
@@ -105,6 +158,26 @@ TEST_CASE("Supervision", "[agency][supervision]") {
     
   }
 
+  SECTION("Shard leadership is moved to the server with fewer leaders") {
+
+    Node snapshot = createNode(unbalancedLeaders);
+    Supervision::LeaderMove move;
+    REQUIRE(Supervision::findLeaderMove(snapshot, move));
+    REQUIRE(move.database == "db");
+    REQUIRE(move.collection == "c");
+    REQUIRE(move.from == "A");
+    REQUIRE(move.to == "B");
+
+  }
+
+  SECTION("Balanced shard leaders are not moved") {
+
+    Node snapshot = createNode(balancedLeaders);
+    Supervision::LeaderMove move;
+    REQUIRE(!Supervision::findLeaderMove(snapshot, move));
+
+  }
+
 }
 
 
@@ -307,6 +307,53 @@ SCENARIO("AqlItemRows", "[AQL][EXECUTOR][ITEMROW]") {
   }
 }
 
+SCENARIO("AqlItemRows with column-major blocks", "[AQL][EXECUTOR][ITEMROW]") {
+  ResourceMonitor monitor;
+  AqlItemBlockManager itemBlockManager{&monitor};
+  itemBlockManager.setLayout(AqlItemBlockLayout::ColumnMajor);
+
+  WHEN("copying from source to target") {
+    SharedAqlItemBlockPtr outputBlock{new AqlItemBlock(itemBlockManager, 4, 3)};
+    REQUIRE(outputBlock->layout() == AqlItemBlockLayout::ColumnMajor);
+    ExecutorInfos executorInfos{{}, {}, 3, 3, {}, {0, 1, 2}};
+    auto outputRegisters = executorInfos.getOutputRegisters();
+    auto registersToKeep = executorInfos.registersToKeep();
+
+    OutputAqlItemRow testee(std::move(outputBlock), outputRegisters,
+                            registersToKeep, executorInfos.registersToClear());
+    {
+      auto inputBlock = buildBlock<3>(itemBlockManager, {{{{1}, {2}, {3}}},
+                                                 {{{4}, {5}, {6}}},
+                                                 {{{"\"a\""}, {"\"b\""}, {"\"c\""}}}});
+      REQUIRE(inputBlock->hasContiguousRegisters());
+
+      for (size_t i = 0; i < 3; ++i) {
+        InputAqlItemRow source{inputBlock, i};
+        testee.copyRow(source);
+        REQUIRE(testee.produced());
+        if (i < 2) {
+          testee.advanceRow();
+        }
+      }
+    }
+
+    THEN("the values are readable by row and by column") {
+      // stealing shrinks the block to the three written rows, which has
+      // to move the columns
+      outputBlock = testee.stealBlock();
+      REQUIRE(outputBlock->size() == 3);
+      auto expected =
+          VPackParser::fromJson("[[1,2,3],[4,5,6],[\"a\",\"b\",\"c\"]]");
+      AssertResultMatrix(outputBlock.get(), expected->slice(), *registersToKeep);
+
+      AqlValue const* column = outputBlock->getColumn(1);
+      REQUIRE(column[0].slice().getNumber<int64_t>() == 2);
+      REQUIRE(column[1].slice().getNumber<int64_t>() == 5);
+      REQUIRE(column[2].slice().copyString() == "b");
+    }
+  }
+}
+
 }  // namespace aql
 }  // namespace tests
 }  // namespace arangodb
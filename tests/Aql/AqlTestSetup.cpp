@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "AqlTestSetup.h"
+
+#include "IResearch/common.h"
+
+#include "Aql/AqlFunctionFeature.h"
+#include "Aql/OptimizerRulesFeature.h"
+#include "ClusterEngine/ClusterEngine.h"
+#include "Logger/LogTopic.h"
+#include "Logger/Logger.h"
+#include "Random/RandomGenerator.h"
+#include "RestServer/AqlFeature.h"
+#include "RestServer/DatabaseFeature.h"
+#include "RestServer/DatabasePathFeature.h"
+#include "RestServer/QueryRegistryFeature.h"
+#include "RestServer/SystemDatabaseFeature.h"
+#include "RestServer/TraverserEngineRegistryFeature.h"
+#include "StorageEngine/EngineSelectorFeature.h"
+#include "Transaction/Methods.h"
+#include "VocBase/vocbase.h"
+
+using namespace arangodb;
+using namespace arangodb::tests::aql;
+
+AqlTestFeatures::AqlTestFeatures(application_features::ApplicationServer& server,
+                                 StorageEngine& engine)
+    : _server(server) {
+  EngineSelectorFeature::ENGINE = &engine;
+  transaction::Methods::clearDataSourceRegistrationCallbacks();
+  ClusterEngine::Mocking = true;
+  RandomGenerator::initialize(RandomGenerator::RandomType::MERSENNE);
+
+  // suppress log messages since tests check error conditions
+  LogTopic::setLogLevel(Logger::FIXME.name(), LogLevel::ERR);  // suppress WARNING DefaultCustomTypeHandler called
+
+  // setup required application features
+  _features.emplace_back(new DatabasePathFeature(server), false);
+  _features.emplace_back(new DatabaseFeature(server), false);
+  _features.emplace_back(new QueryRegistryFeature(server), false);  // must be first
+  application_features::ApplicationServer::server->addFeature(
+      _features.back().first);  // need QueryRegistryFeature feature to be added now in order to create the system database
+  _system = std::make_unique<TRI_vocbase_t>(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL,
+                                            0, TRI_VOC_SYSTEM_DATABASE);
+  _features.emplace_back(new SystemDatabaseFeature(server, _system.get()), false);
+  _features.emplace_back(new TraverserEngineRegistryFeature(server), false);  // must be before AqlFeature
+  _features.emplace_back(new AqlFeature(server), true);
+  _features.emplace_back(new arangodb::aql::OptimizerRulesFeature(server), true);
+  _features.emplace_back(new arangodb::aql::AqlFunctionFeature(server), true);
+
+  for (auto& f : _features) {
+    application_features::ApplicationServer::server->addFeature(f.first);
+  }
+
+  for (auto& f : _features) {
+    f.first->prepare();
+  }
+
+  for (auto& f : _features) {
+    if (f.second) {
+      f.first->start();
+    }
+  }
+
+  auto* dbPathFeature =
+      application_features::ApplicationServer::getFeature<DatabasePathFeature>(
+          "DatabasePath");
+  tests::setDatabasePath(*dbPathFeature);  // ensure test data is stored in a unique directory
+}
+
+AqlTestFeatures::~AqlTestFeatures() {
+  _system.reset();  // destroy before reseting the 'ENGINE'
+  AqlFeature(_server).stop();  // unset singleton instance
+  LogTopic::setLogLevel(Logger::FIXME.name(), LogLevel::DEFAULT);
+  application_features::ApplicationServer::server = nullptr;
+  EngineSelectorFeature::ENGINE = nullptr;
+
+  // destroy application features
+  for (auto& f : _features) {
+    if (f.second) {
+      f.first->stop();
+    }
+  }
+
+  for (auto& f : _features) {
+    f.first->unprepare();
+  }
+}
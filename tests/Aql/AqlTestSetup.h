@@ -0,0 +1,76 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_TESTS_AQL_TEST_SETUP_H
+#define ARANGOD_AQL_TESTS_AQL_TEST_SETUP_H
+
+#include "ApplicationFeatures/ApplicationServer.h"
+#include "Mocks/StorageEngineMock.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+struct TRI_vocbase_t;
+
+namespace arangodb {
+class StorageEngine;
+
+namespace application_features {
+class ApplicationFeature;
+}
+
+namespace tests {
+namespace aql {
+
+/// @brief the application features needed to run AQL queries, started on
+/// construction and stopped on destruction. The storage engine must outlive
+/// the features
+class AqlTestFeatures {
+ public:
+  AqlTestFeatures(application_features::ApplicationServer& server, StorageEngine& engine);
+  ~AqlTestFeatures();
+
+  AqlTestFeatures(AqlTestFeatures const&) = delete;
+  AqlTestFeatures& operator=(AqlTestFeatures const&) = delete;
+
+ private:
+  application_features::ApplicationServer& _server;
+  std::unique_ptr<TRI_vocbase_t> _system;
+  std::vector<std::pair<application_features::ApplicationFeature*, bool>> _features;
+};
+
+/// @brief an application server with a mock storage engine and the features
+/// needed to run AQL queries. The server is declared first, as the engine is
+/// constructed with it
+template <typename Engine = StorageEngineMock>
+struct AqlTestSetup {
+  application_features::ApplicationServer server;
+  Engine engine;
+  AqlTestFeatures features;
+
+  AqlTestSetup() : server(nullptr, nullptr), engine(server), features(server, engine) {}
+};
+
+}  // namespace aql
+}  // namespace tests
+}  // namespace arangodb
+
+#endif
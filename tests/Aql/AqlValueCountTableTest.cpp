@@ -0,0 +1,137 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "catch.hpp"
+
+#include "Aql/AqlValue.h"
+#include "Aql/AqlValueCountTable.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <string>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace arangodb {
+namespace tests {
+namespace aql {
+
+static AqlValue makeDynamicValue(size_t i) {
+  VPackBuilder builder;
+  // long enough to not be inlined
+  builder.add(VPackValue("a value that is stored outside, number " + std::to_string(i)));
+  AqlValue value{builder.slice()};
+  REQUIRE(value.requiresDestruction());
+  return value;
+}
+
+SCENARIO("AqlValueCountTable", "[AQL][VALUECOUNT]") {
+  AqlValueCountTable table;
+  std::vector<AqlValue> values;
+  for (size_t i = 0; i < 1000; ++i) {
+    values.emplace_back(makeDynamicValue(i));
+  }
+
+  GIVEN("an empty table") {
+    THEN("no value is found") {
+      REQUIRE(table.empty());
+      REQUIRE(table.find(values[0]) == nullptr);
+      REQUIRE_FALSE(table.erase(values[0]));
+    }
+  }
+
+  GIVEN("a table with counted values") {
+    // count value i (i % 3) + 1 times, so the table has to grow
+    for (size_t i = 0; i < values.size(); ++i) {
+      for (size_t j = 0; j <= i % 3; ++j) {
+        REQUIRE(table.increase(values[i]) == j + 1);
+      }
+    }
+    REQUIRE(table.size() == values.size());
+
+    THEN("all counts are found") {
+      for (size_t i = 0; i < values.size(); ++i) {
+        auto entry = table.find(values[i]);
+        REQUIRE(entry != nullptr);
+        REQUIRE(entry->count == i % 3 + 1);
+      }
+    }
+
+    THEN("erased values are gone while the others are still found") {
+      for (size_t i = 0; i < values.size(); i += 2) {
+        REQUIRE(table.erase(values[i]));
+      }
+      REQUIRE(table.size() == values.size() / 2);
+      for (size_t i = 0; i < values.size(); ++i) {
+        auto entry = table.find(values[i]);
+        if (i % 2 == 0) {
+          REQUIRE(entry == nullptr);
+        } else {
+          REQUIRE(entry != nullptr);
+          REQUIRE(entry->count == i % 3 + 1);
+        }
+      }
+    }
+
+    THEN("entries can be erased after decreasing their count") {
+      for (auto const& it : values) {
+        auto entry = table.find(it);
+        REQUIRE(entry != nullptr);
+        entry->count = 0;
+        table.erase(entry);
+      }
+      REQUIRE(table.empty());
+    }
+
+    THEN("forEach visits every value once") {
+      size_t visited = 0;
+      size_t total = 0;
+      table.forEach([&](AqlValue const&, uint32_t count) {
+        ++visited;
+        total += count;
+      });
+      REQUIRE(visited == values.size());
+      size_t expected = 0;
+      for (size_t i = 0; i < values.size(); ++i) {
+        expected += i % 3 + 1;
+      }
+      REQUIRE(total == expected);
+    }
+
+    THEN("clear removes all values") {
+      table.clear();
+      REQUIRE(table.empty());
+      REQUIRE(table.find(values[1]) == nullptr);
+      REQUIRE(table.increase(values[1]) == 1);
+    }
+  }
+
+  for (auto& it : values) {
+    it.destroy();
+  }
+}
+
+}  // namespace aql
+}  // namespace tests
+}  // namespace arangodb
@@ -0,0 +1,110 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "catch.hpp"
+#include "fakeit.hpp"
+
+#include "Aql/AqlValue.h"
+#include "Aql/ExpressionContext.h"
+#include "Aql/Functions.h"
+#include "Basics/SmallVector.h"
+#include "Transaction/Methods.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <functional>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace arangodb {
+namespace tests {
+namespace array_functions_aql {
+
+using Function = AqlValue (*)(ExpressionContext*, transaction::Methods*,
+                              VPackFunctionParameters const&);
+
+template <typename T>
+static T evaluate(Function function, std::string const& json,
+                  std::function<T(VPackSlice)> const& callback) {
+  fakeit::Mock<ExpressionContext> expressionContextMock;
+  ExpressionContext& expressionContext = expressionContextMock.get();
+  fakeit::Mock<transaction::Methods> trxMock;
+  transaction::Methods& trx = trxMock.get();
+
+  auto input = VPackParser::fromJson(json);
+  SmallVector<AqlValue>::allocator_type::arena_type arena;
+  SmallVector<AqlValue> params{arena};
+  params.emplace_back(input->slice());
+
+  AqlValue result = function(&expressionContext, &trx, params);
+  AqlValueGuard guard{result, true};
+  return callback(result.slice());
+}
+
+static std::string evaluate(Function function, std::string const& json) {
+  return evaluate<std::string>(function, json,
+                               [](VPackSlice result) { return result.toJson(); });
+}
+
+static VPackValueType evaluateType(Function function, std::string const& json) {
+  return evaluate<VPackValueType>(function, json,
+                                  [](VPackSlice result) { return result.type(); });
+}
+
+// only arrays of numbers (and nulls) are tested here. these are evaluated
+// without comparing VelocyPack values, so no transaction is needed
+SCENARIO("Testing MIN and MAX on numeric arrays", "[AQL][ARRAY]") {
+  WHEN("the array is empty or contains only nulls") {
+    REQUIRE(evaluate(&Functions::Min, "[]") == "null");
+    REQUIRE(evaluate(&Functions::Max, "[]") == "null");
+    REQUIRE(evaluate(&Functions::Min, "[null, null]") == "null");
+    REQUIRE(evaluate(&Functions::Max, "[null, null]") == "null");
+  }
+
+  WHEN("the array contains numbers") {
+    std::string const json = "[3, null, -1.5, 17, 2, -1.5, 9, 17, 0, 4]";
+    REQUIRE(evaluate(&Functions::Min, json) == "-1.5");
+    REQUIRE(evaluate(&Functions::Max, json) == "17");
+  }
+
+  WHEN("equal values have different types") {
+    // the first of the equal values is returned
+    REQUIRE(evaluateType(&Functions::Min, "[1.5, 2, 1.0, 1]") == VPackValueType::Double);
+    REQUIRE(evaluateType(&Functions::Min, "[1, 2, 1.0]") == VPackValueType::SmallInt);
+    REQUIRE(evaluateType(&Functions::Max, "[5, 5.0, 2]") == VPackValueType::SmallInt);
+    REQUIRE(evaluateType(&Functions::Max, "[5.0, 5, 2]") == VPackValueType::Double);
+  }
+}
+
+SCENARIO("Testing COUNT_DISTINCT on numeric arrays", "[AQL][ARRAY]") {
+  REQUIRE(evaluate(&Functions::CountDistinct, "[]") == "0");
+  REQUIRE(evaluate(&Functions::CountDistinct, "[1, 2, 1, 3, 2]") == "3");
+  REQUIRE(evaluate(&Functions::CountDistinct, "[1, 1.0, -0.0, 0]") == "2");
+  REQUIRE(evaluate(&Functions::CountDistinct, "[null, 4, null, 5]") == "3");
+}
+
+}  // namespace array_functions_aql
+}  // namespace tests
+}  // namespace arangodb
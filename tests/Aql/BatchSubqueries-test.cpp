@@ -0,0 +1,239 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+// test setup
+#include "AqlTestSetup.h"
+
+#include "Aql/Query.h"
+#include "Aql/QueryRegistry.h"
+#include "Aql/SharedQueryState.h"
+#include "Basics/VelocyPackHelper.h"
+#include "RestServer/QueryRegistryFeature.h"
+#include "Transaction/Methods.h"
+#include "Transaction/StandaloneContext.h"
+#include "Utils/OperationOptions.h"
+#include "Utils/SingleCollectionTransaction.h"
+#include "VocBase/LogicalCollection.h"
+
+namespace {
+
+/// @brief runs the query with the given options and returns its result
+std::shared_ptr<VPackBuilder> executeQuery(TRI_vocbase_t& vocbase, std::string const& queryString,
+                                           std::string const& options = "{}") {
+  arangodb::aql::Query query(false, vocbase, arangodb::aql::QueryString(queryString),
+                             nullptr, arangodb::velocypack::Parser::fromJson(options),
+                             arangodb::aql::PART_MAIN);
+  std::shared_ptr<arangodb::aql::SharedQueryState> ss = query.sharedState();
+  arangodb::aql::QueryResult result;
+
+  while (true) {
+    auto state = query.execute(arangodb::QueryRegistryFeature::registry(), result);
+    if (state == arangodb::aql::ExecutionState::WAITING) {
+      ss->waitForAsyncResponse();
+    } else {
+      break;
+    }
+  }
+
+  REQUIRE(result.result.ok());
+  REQUIRE(result.data->slice().isArray());
+  return result.data;
+}
+
+/// @brief whether the plan of the query contains a node of the given type
+bool usesNode(TRI_vocbase_t& vocbase, std::string const& queryString,
+              std::string const& type, std::string const& options = "{}") {
+  arangodb::aql::Query query(false, vocbase, arangodb::aql::QueryString(queryString),
+                             nullptr, arangodb::velocypack::Parser::fromJson(options),
+                             arangodb::aql::PART_MAIN);
+  auto result = query.explain();
+  REQUIRE(result.result.ok());
+  VPackSlice nodes = result.data->slice().get("nodes");
+  REQUIRE(nodes.isArray());
+
+  for (auto const& it : VPackArrayIterator(nodes)) {
+    if (it.get("type").isEqualString(type)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/// @brief inserts the given documents into the collection
+void insertDocuments(TRI_vocbase_t& vocbase, arangodb::LogicalCollection& collection,
+                     std::vector<std::string> const& documents) {
+  arangodb::OperationOptions options;
+  arangodb::SingleCollectionTransaction trx(
+      arangodb::transaction::StandaloneContext::Create(vocbase), collection,
+      arangodb::AccessMode::Type::WRITE);
+  REQUIRE((trx.begin().ok()));
+  for (auto const& it : documents) {
+    auto doc = arangodb::velocypack::Parser::fromJson(it);
+    REQUIRE((trx.insert(collection.name(), doc->slice(), options).ok()));
+  }
+  REQUIRE((trx.commit().ok()));
+}
+
+/// @brief whether the optimizer batches the (outermost) subquery of the query
+bool isBatched(TRI_vocbase_t& vocbase, std::string const& queryString,
+               std::string const& options = "{}") {
+  arangodb::aql::Query query(false, vocbase, arangodb::aql::QueryString(queryString),
+                             nullptr, arangodb::velocypack::Parser::fromJson(options),
+                             arangodb::aql::PART_MAIN);
+  auto result = query.explain();
+  REQUIRE((result.result.ok()));
+  VPackSlice nodes = result.data->slice().get("nodes");
+  REQUIRE((nodes.isArray()));
+
+  for (auto const& it : VPackArrayIterator(nodes)) {
+    if (it.get("type").isEqualString("SubqueryNode")) {
+      return it.hasKey("rowIdVariable");
+    }
+  }
+  FAIL("query has no subquery");
+  return false;
+}
+
+/// @brief runs the query with and without batched subqueries, and checks
+/// that both return the same result
+std::shared_ptr<VPackBuilder> compareResults(TRI_vocbase_t& vocbase,
+                                             std::string const& queryString) {
+  auto batched = executeQuery(vocbase, queryString);
+  auto unbatched = executeQuery(vocbase, queryString,
+                                "{ \"optimizer\": { \"rules\": [ \"-batch-subqueries\" ] } }");
+  CHECK((0 == arangodb::basics::VelocyPackHelper::compare(batched->slice(),
+                                                          unbatched->slice(), true)));
+  return batched;
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+TEST_CASE("BatchSubqueries", "[aql][subquery]") {
+  arangodb::tests::aql::AqlTestSetup<> s;
+  (void)(s);
+
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1,
+                        "testVocbase");
+  auto createJson = arangodb::velocypack::Parser::fromJson(
+      "{ \"name\": \"testCollection\" }");
+  auto collection = vocbase.createCollection(createJson->slice());
+  REQUIRE((nullptr != collection));
+
+  std::vector<std::string> documents;
+  for (int i = 0; i < 20; ++i) {
+    documents.emplace_back("{ \"value\": " + std::to_string(i % 5) + " }");
+  }
+  insertDocuments(vocbase, *collection, documents);
+
+  SECTION("row-local subqueries are batched") {
+    std::string const query =
+        "FOR i IN 1..10 LET s = (FOR j IN 1..i FILTER j % 2 == 0 RETURN j) "
+        "RETURN LENGTH(s)";
+    CHECK((isBatched(vocbase, query)));
+    CHECK((!isBatched(vocbase, query,
+                      "{ \"optimizer\": { \"rules\": [ \"-batch-subqueries\" ] } }")));
+
+    auto result = compareResults(vocbase, query);
+    auto expected = arangodb::velocypack::Parser::fromJson(
+        "[ 0, 1, 1, 2, 2, 3, 3, 4, 4, 5 ]");
+    CHECK((0 == arangodb::basics::VelocyPackHelper::compare(expected->slice(),
+                                                            result->slice(), true)));
+  }
+
+  SECTION("subqueries with empty results for some rows") {
+    std::string const query =
+        "FOR i IN 1..10 LET s = (FILTER i > 5 RETURN i) RETURN s";
+    CHECK((isBatched(vocbase, query)));
+
+    auto result = compareResults(vocbase, query);
+    auto expected = arangodb::velocypack::Parser::fromJson(
+        "[ [], [], [], [], [], [6], [7], [8], [9], [10] ]");
+    CHECK((0 == arangodb::basics::VelocyPackHelper::compare(expected->slice(),
+                                                            result->slice(), true)));
+  }
+
+  SECTION("subqueries over more input rows than fit into a block") {
+    std::string const query =
+        "FOR i IN 1..2500 LET s = (FOR j IN [i, i * 2] RETURN j) RETURN SUM(s)";
+    CHECK((isBatched(vocbase, query)));
+
+    auto result = compareResults(vocbase, query);
+    REQUIRE((2500 == result->slice().length()));
+    for (int64_t i = 1; i <= 2500; ++i) {
+      CHECK((3 * i == result->slice().at(i - 1).getNumber<int64_t>()));
+    }
+  }
+
+  SECTION("subqueries over a collection") {
+    std::string const query =
+        "FOR i IN 0..5 LET s = (FOR d IN testCollection FILTER d.value == i "
+        "RETURN 1) RETURN LENGTH(s)";
+    CHECK((isBatched(vocbase, query)));
+
+    auto result = compareResults(vocbase, query);
+    auto expected = arangodb::velocypack::Parser::fromJson("[ 4, 4, 4, 4, 4, 0 ]");
+    CHECK((0 == arangodb::basics::VelocyPackHelper::compare(expected->slice(),
+                                                            result->slice(), true)));
+  }
+
+  SECTION("nested subqueries") {
+    std::string const query =
+        "FOR i IN 1..4 LET s = (FOR j IN 1..i LET t = (FOR k IN 1..j RETURN k) "
+        "RETURN SUM(t)) RETURN s";
+    CHECK((isBatched(vocbase, query)));
+
+    auto result = compareResults(vocbase, query);
+    auto expected = arangodb::velocypack::Parser::fromJson(
+        "[ [1], [1, 3], [1, 3, 6], [1, 3, 6, 10] ]");
+    CHECK((0 == arangodb::basics::VelocyPackHelper::compare(expected->slice(),
+                                                            result->slice(), true)));
+  }
+
+  SECTION("subqueries working on all of their input rows are not batched") {
+    for (auto const& query :
+         {"FOR i IN 1..10 LET s = (FOR j IN 1..10 LIMIT 3 RETURN i + j) RETURN s",
+          "FOR i IN 1..10 LET s = (FOR j IN [3, 1, i] SORT j RETURN j) RETURN s",
+          "FOR i IN 1..10 LET s = (FOR j IN [i, i] COLLECT v = j RETURN v) RETURN s"}) {
+      CHECK((!isBatched(vocbase, query)));
+      compareResults(vocbase, query);
+    }
+  }
+
+  SECTION("modification subqueries are not batched") {
+    std::string const query =
+        "FOR i IN 1..3 LET s = (INSERT { value: i } INTO testCollection) RETURN s";
+    CHECK((!isBatched(vocbase, query)));
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
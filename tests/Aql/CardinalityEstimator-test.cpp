@@ -0,0 +1,157 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+// test setup
+#include "AqlTestSetup.h"
+
+#include "Aql/CardinalityEstimator.h"
+#include "Aql/ExecutionNode.h"
+#include "Aql/ExecutionPlan.h"
+#include "Aql/Expression.h"
+#include "Aql/Query.h"
+#include "Basics/SmallVector.h"
+#include "RestServer/QueryRegistryFeature.h"
+#include "Transaction/Methods.h"
+
+namespace {
+
+/// @brief prepares the query without optimizer rules, so its FILTER
+/// conditions stay as written
+std::unique_ptr<arangodb::aql::Query> prepareQuery(TRI_vocbase_t& vocbase,
+                                                   std::string const& queryString) {
+  auto query = std::make_unique<arangodb::aql::Query>(
+      false, vocbase, arangodb::aql::QueryString(queryString), nullptr,
+      arangodb::velocypack::Parser::fromJson(
+          "{ \"optimizer\": { \"rules\": [ \"-all\" ] } }"),
+      arangodb::aql::PART_MAIN);
+  query->prepare(arangodb::QueryRegistryFeature::registry());
+  REQUIRE((nullptr != query->plan()));
+  return query;
+}
+
+/// @brief the condition of the only FILTER of the plan
+arangodb::aql::AstNode const* filterCondition(arangodb::aql::ExecutionPlan* plan) {
+  arangodb::SmallVector<arangodb::aql::ExecutionNode*>::allocator_type::arena_type a;
+  arangodb::SmallVector<arangodb::aql::ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, arangodb::aql::ExecutionNode::FILTER, true);
+  REQUIRE((1 == nodes.size()));
+  auto filter = arangodb::aql::ExecutionNode::castTo<arangodb::aql::FilterNode const*>(
+      nodes.front());
+  auto setter = plan->getVarSetBy(filter->inVariable()->id);
+  REQUIRE((nullptr != setter));
+  REQUIRE((arangodb::aql::ExecutionNode::CALCULATION == setter->getType()));
+  return arangodb::aql::ExecutionNode::castTo<arangodb::aql::CalculationNode const*>(setter)
+      ->expression()
+      ->node();
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+TEST_CASE("CardinalityEstimator", "[aql][optimizer]") {
+  arangodb::tests::aql::AqlTestSetup<> s;
+  (void)(s);
+
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1,
+                        "testVocbase");
+  for (auto const& name : {"testCollection0", "testCollection1"}) {
+    auto createJson = arangodb::velocypack::Parser::fromJson(
+        std::string("{ \"name\": \"") + name + "\" }");
+    REQUIRE((nullptr != vocbase.createCollection(createJson->slice())));
+  }
+
+  // the selectivity of the FILTER condition of the query
+  auto selectivity = [&vocbase](std::string const& filter) -> double {
+    auto query = prepareQuery(vocbase, "FOR d IN testCollection0 FILTER " +
+                                           filter + " RETURN d");
+    arangodb::aql::CardinalityEstimator estimator(query->plan());
+    return estimator.selectivity(filterCondition(query->plan()));
+  };
+
+  // without indexes or statistics, the estimator falls back to its defaults
+  SECTION("comparisons") {
+    CHECK((0.1 == Approx(selectivity("d.a == 1"))));
+    CHECK((0.1 == Approx(selectivity("1 == d.a"))));
+    CHECK((0.9 == Approx(selectivity("d.a != 1"))));
+    CHECK((1.0 / 3.0 == Approx(selectivity("d.a < 1"))));
+    CHECK((1.0 / 3.0 == Approx(selectivity("d.a >= 1"))));
+  }
+
+  SECTION("arrays") {
+    CHECK((0.3 == Approx(selectivity("d.a IN [1, 2, 3]"))));
+    CHECK((0.7 == Approx(selectivity("d.a NOT IN [1, 2, 3]"))));
+  }
+
+  SECTION("logical operators") {
+    CHECK((0.1 / 3.0 == Approx(selectivity("d.a == 1 && d.b > 1"))));
+    CHECK((0.2 == Approx(selectivity("d.a == 1 || d.b == 2"))));
+    CHECK((0.9 == Approx(selectivity("NOT (d.a == 1)"))));
+  }
+
+  SECTION("the sum of alternatives is capped") {
+    CHECK((1.0 == Approx(selectivity("d.a < 1 || d.b < 1 || d.c < 1 || d.e < 1"))));
+  }
+
+  SECTION("unknown conditions") {
+    CHECK((0.5 == Approx(selectivity("LENGTH(d.a)"))));
+
+    auto query = prepareQuery(vocbase, "FOR d IN testCollection0 RETURN d");
+    arangodb::aql::CardinalityEstimator estimator(query->plan());
+    CHECK((0.5 == Approx(estimator.selectivity(nullptr))));
+  }
+
+  SECTION("join orders") {
+    auto loops = [](arangodb::aql::ExecutionPlan* plan) {
+      arangodb::SmallVector<arangodb::aql::ExecutionNode*>::allocator_type::arena_type a;
+      arangodb::SmallVector<arangodb::aql::ExecutionNode*> nodes{a};
+      plan->findNodesOfType(nodes, arangodb::aql::ExecutionNode::ENUMERATE_COLLECTION, true);
+      // findNodesOfType returns the innermost loop first
+      return std::vector<arangodb::aql::ExecutionNode*>(nodes.rbegin(), nodes.rend());
+    };
+
+    // a single loop keeps its place
+    {
+      auto query = prepareQuery(vocbase, "FOR d IN testCollection0 RETURN d");
+      arangodb::aql::CardinalityEstimator estimator(query->plan());
+      CHECK((std::vector<size_t>{0} == estimator.bestJoinOrder(loops(query->plan()))));
+    }
+
+    // loops the estimates cannot tell apart keep their order
+    {
+      auto query = prepareQuery(vocbase,
+                                "FOR a IN testCollection0 FOR b IN testCollection1 "
+                                "RETURN [a, b]");
+      arangodb::aql::CardinalityEstimator estimator(query->plan());
+      CHECK((std::vector<size_t>{0, 1} == estimator.bestJoinOrder(loops(query->plan()))));
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
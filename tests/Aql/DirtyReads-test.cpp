@@ -0,0 +1,155 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+// test setup
+#include "AqlTestSetup.h"
+
+#include "Aql/Query.h"
+#include "Aql/QueryOptions.h"
+#include "Basics/VelocyPackHelper.h"
+#include "RestServer/QueryRegistryFeature.h"
+#include "Transaction/Methods.h"
+#include "Transaction/StandaloneContext.h"
+#include "Utils/OperationOptions.h"
+#include "Utils/OperationResult.h"
+#include "Utils/SingleCollectionTransaction.h"
+#include "VocBase/LogicalCollection.h"
+
+namespace {
+
+/// @brief runs the query with the given options and returns its result
+std::shared_ptr<VPackBuilder> executeQuery(TRI_vocbase_t& vocbase, std::string const& queryString,
+                                           std::string const& options = "{}") {
+  arangodb::aql::Query query(false, vocbase, arangodb::aql::QueryString(queryString),
+                             nullptr, arangodb::velocypack::Parser::fromJson(options),
+                             arangodb::aql::PART_MAIN);
+  std::shared_ptr<arangodb::aql::SharedQueryState> ss = query.sharedState();
+  arangodb::aql::QueryResult result;
+
+  while (true) {
+    auto state = query.execute(arangodb::QueryRegistryFeature::registry(), result);
+    if (state == arangodb::aql::ExecutionState::WAITING) {
+      ss->waitForAsyncResponse();
+    } else {
+      break;
+    }
+  }
+
+  REQUIRE(result.result.ok());
+  REQUIRE(result.data->slice().isArray());
+  return result.data;
+}
+
+/// @brief inserts the given documents into the collection
+void insertDocuments(TRI_vocbase_t& vocbase, arangodb::LogicalCollection& collection,
+                     std::vector<std::string> const& documents) {
+  arangodb::OperationOptions options;
+  arangodb::SingleCollectionTransaction trx(
+      arangodb::transaction::StandaloneContext::Create(vocbase), collection,
+      arangodb::AccessMode::Type::WRITE);
+  REQUIRE((trx.begin().ok()));
+  for (auto const& it : documents) {
+    auto doc = arangodb::velocypack::Parser::fromJson(it);
+    REQUIRE((trx.insert(collection.name(), doc->slice(), options).ok()));
+  }
+  REQUIRE((trx.commit().ok()));
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+TEST_CASE("DirtyReads", "[aql][cluster]") {
+  arangodb::tests::aql::AqlTestSetup<> s;
+  (void)(s);
+
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1,
+                        "testVocbase");
+  auto createJson = arangodb::velocypack::Parser::fromJson(
+      "{ \"name\": \"testCollection\" }");
+  auto collection = vocbase.createCollection(createJson->slice());
+  REQUIRE((nullptr != collection));
+  insertDocuments(vocbase, *collection,
+                  {"{ \"_key\": \"a\", \"value\": 1 }", "{ \"_key\": \"b\", \"value\": 2 }"});
+
+  SECTION("queries read from the leaders by default") {
+    arangodb::aql::QueryOptions options;
+    CHECK((!options.allowDirtyReads));
+
+    arangodb::OperationOptions operationOptions;
+    CHECK((!operationOptions.allowDirtyReads));
+  }
+
+  SECTION("the query option is parsed and passed on") {
+    arangodb::aql::QueryOptions options;
+    options.fromVelocyPack(
+        arangodb::velocypack::Parser::fromJson("{ \"allowDirtyReads\": true }")->slice());
+    CHECK((options.allowDirtyReads));
+
+    // the options are sent to the DB servers along with the snippets
+    VPackBuilder builder;
+    options.toVelocyPack(builder, false);
+    CHECK((builder.slice().get("allowDirtyReads").isTrue()));
+
+    arangodb::aql::QueryOptions received;
+    received.fromVelocyPack(builder.slice());
+    CHECK((received.allowDirtyReads));
+  }
+
+  SECTION("values other than booleans are ignored") {
+    arangodb::aql::QueryOptions options;
+    options.fromVelocyPack(
+        arangodb::velocypack::Parser::fromJson("{ \"allowDirtyReads\": \"yes\" }")->slice());
+    CHECK((!options.allowDirtyReads));
+  }
+
+  SECTION("a single server ignores the option") {
+    std::string const queryString =
+        "FOR d IN testCollection SORT d.value RETURN d.value";
+    auto expected = executeQuery(vocbase, queryString);
+    auto actual = executeQuery(vocbase, queryString, "{ \"allowDirtyReads\": true }");
+    CHECK((0 == arangodb::basics::VelocyPackHelper::compare(expected->slice(),
+                                                            actual->slice(), true)));
+    CHECK((2 == actual->slice().length()));
+
+    auto search = arangodb::velocypack::Parser::fromJson("{ \"_key\": \"b\" }");
+    arangodb::OperationOptions options;
+    options.allowDirtyReads = true;
+    arangodb::SingleCollectionTransaction trx(
+        arangodb::transaction::StandaloneContext::Create(vocbase), *collection,
+        arangodb::AccessMode::Type::READ);
+    REQUIRE((trx.begin().ok()));
+    auto result = trx.document(collection->name(), search->slice(), options);
+    REQUIRE((result.ok()));
+    CHECK((2 == result.slice().get("value").getNumber<int>()));
+    CHECK((trx.commit().ok()));
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
@@ -0,0 +1,205 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+// test setup
+#include "AqlTestSetup.h"
+
+#include "Aql/Query.h"
+#include "Aql/QueryRegistry.h"
+#include "Aql/SharedQueryState.h"
+#include "RestServer/QueryRegistryFeature.h"
+#include "Transaction/Methods.h"
+#include "Transaction/StandaloneContext.h"
+#include "Utils/OperationOptions.h"
+#include "Utils/SingleCollectionTransaction.h"
+#include "VocBase/LogicalCollection.h"
+
+namespace {
+
+/// @brief runs the query with the given options and returns its result
+std::shared_ptr<VPackBuilder> executeQuery(TRI_vocbase_t& vocbase, std::string const& queryString,
+                                           std::string const& options = "{}") {
+  arangodb::aql::Query query(false, vocbase, arangodb::aql::QueryString(queryString),
+                             nullptr, arangodb::velocypack::Parser::fromJson(options),
+                             arangodb::aql::PART_MAIN);
+  std::shared_ptr<arangodb::aql::SharedQueryState> ss = query.sharedState();
+  arangodb::aql::QueryResult result;
+
+  while (true) {
+    auto state = query.execute(arangodb::QueryRegistryFeature::registry(), result);
+    if (state == arangodb::aql::ExecutionState::WAITING) {
+      ss->waitForAsyncResponse();
+    } else {
+      break;
+    }
+  }
+
+  REQUIRE(result.result.ok());
+  REQUIRE(result.data->slice().isArray());
+  return result.data;
+}
+
+/// @brief whether the plan of the query contains a node of the given type
+bool usesNode(TRI_vocbase_t& vocbase, std::string const& queryString,
+              std::string const& type, std::string const& options = "{}") {
+  arangodb::aql::Query query(false, vocbase, arangodb::aql::QueryString(queryString),
+                             nullptr, arangodb::velocypack::Parser::fromJson(options),
+                             arangodb::aql::PART_MAIN);
+  auto result = query.explain();
+  REQUIRE(result.result.ok());
+  VPackSlice nodes = result.data->slice().get("nodes");
+  REQUIRE(nodes.isArray());
+
+  for (auto const& it : VPackArrayIterator(nodes)) {
+    if (it.get("type").isEqualString(type)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/// @brief inserts the given documents into the collection
+void insertDocuments(TRI_vocbase_t& vocbase, arangodb::LogicalCollection& collection,
+                     std::vector<std::string> const& documents) {
+  arangodb::OperationOptions options;
+  arangodb::SingleCollectionTransaction trx(
+      arangodb::transaction::StandaloneContext::Create(vocbase), collection,
+      arangodb::AccessMode::Type::WRITE);
+  REQUIRE((trx.begin().ok()));
+  for (auto const& it : documents) {
+    auto doc = arangodb::velocypack::Parser::fromJson(it);
+    REQUIRE((trx.insert(collection.name(), doc->slice(), options).ok()));
+  }
+  REQUIRE((trx.commit().ok()));
+}
+
+/// @brief returns the result of the query as JSON
+std::string queryJson(TRI_vocbase_t& vocbase, std::string const& queryString) {
+  auto result = executeQuery(vocbase, queryString);
+  REQUIRE((1 == result->slice().length()));
+  return result->slice().at(0).toJson();
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+TEST_CASE("DocumentFunction", "[aql][document]") {
+  arangodb::tests::aql::AqlTestSetup<> s;
+  (void)(s);
+
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1,
+                        "testVocbase");
+  auto createJson = arangodb::velocypack::Parser::fromJson(
+      "{ \"name\": \"testCollection\" }");
+  auto collection = vocbase.createCollection(createJson->slice());
+  REQUIRE((nullptr != collection));
+  createJson = arangodb::velocypack::Parser::fromJson(
+      "{ \"name\": \"otherCollection\" }");
+  auto other = vocbase.createCollection(createJson->slice());
+  REQUIRE((nullptr != other));
+
+  insertDocuments(vocbase, *collection,
+                  {"{ \"_key\": \"a\", \"value\": 1 }", "{ \"_key\": \"b\", \"value\": 2 }",
+                   "{ \"_key\": \"c\", \"value\": 3 }"});
+  insertDocuments(vocbase, *other, {"{ \"_key\": \"a\", \"value\": 10 }"});
+
+  SECTION("keys are returned in their order, leaving out missing ones") {
+    CHECK(("[3,1,2]" ==
+           queryJson(vocbase,
+                     "RETURN DOCUMENT('testCollection', ['c', 'missing', 'a', "
+                     "'b'])[*].value")));
+  }
+
+  SECTION("keys may be repeated") {
+    CHECK(("[1,1]" ==
+           queryJson(vocbase, "RETURN DOCUMENT('testCollection', ['a', 'a'])[*].value")));
+  }
+
+  SECTION("no keys") {
+    CHECK(("[]" == queryJson(vocbase, "RETURN DOCUMENT('testCollection', [])")));
+  }
+
+  SECTION("ids and invalid identifiers for a given collection") {
+    // ids of other collections and values that are not strings are left out
+    CHECK(("[3,2]" ==
+           queryJson(vocbase,
+                     "RETURN DOCUMENT('testCollection', ['otherCollection/a', "
+                     "'testCollection/c', 1, null, 'b'])[*].value")));
+  }
+
+  SECTION("ids of a single collection") {
+    CHECK(("[2,1]" ==
+           queryJson(vocbase,
+                     "RETURN DOCUMENT(['testCollection/b', 'testCollection/a', "
+                     "'testCollection/missing'])[*].value")));
+  }
+
+  SECTION("ids of multiple collections") {
+    CHECK(("[2,10,1]" ==
+           queryJson(vocbase,
+                     "RETURN DOCUMENT(['testCollection/b', 'otherCollection/a', "
+                     "'testCollection/a'])[*].value")));
+  }
+
+  SECTION("keys without a collection are left out") {
+    CHECK(("[2]" == queryJson(vocbase,
+                              "RETURN DOCUMENT(['a', 'testCollection/b'])[*].value")));
+  }
+
+  SECTION("the transaction returns the documents in the order of the keys") {
+    arangodb::SingleCollectionTransaction trx(
+        arangodb::transaction::StandaloneContext::Create(vocbase), *collection,
+        arangodb::AccessMode::Type::READ);
+    REQUIRE((trx.begin().ok()));
+
+    auto keys = arangodb::velocypack::Parser::fromJson("[\"b\", \"missing\", \"a\"]");
+    VPackBuilder result;
+    result.openArray();
+    CHECK((trx.documentsFastPath(collection->name(), keys->slice(), result).ok()));
+    result.close();
+    REQUIRE((2 == result.slice().length()));
+    CHECK((2 == result.slice().at(0).get("value").getNumber<int>()));
+    CHECK((1 == result.slice().at(1).get("value").getNumber<int>()));
+
+    keys = arangodb::velocypack::Parser::fromJson("[\"a\", \"\"]");
+    VPackBuilder invalid;
+    invalid.openArray();
+    CHECK((trx.documentsFastPath(collection->name(), keys->slice(), invalid)
+               .is(TRI_ERROR_ARANGO_DOCUMENT_HANDLE_BAD)));
+    invalid.close();
+    CHECK((invalid.slice().isEmptyArray()));
+
+    CHECK((trx.commit().ok()));
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
@@ -89,8 +89,8 @@ SCENARIO("EnumerateCollectionExecutor",
     fakeit::Mock<transaction::Methods> mockTrx;
     // fake indexScan
     fakeit::When(Method(mockTrx, indexScan))
-        .AlwaysDo(std::function<std::unique_ptr<IndexIterator>(std::string const&, CursorType&)>(
-            [&mockTrx, &collection](std::string const&, CursorType&) -> std::unique_ptr<IndexIterator> {
+        .AlwaysDo(std::function<std::unique_ptr<IndexIterator>(std::string const&, CursorType&, size_t&)>(
+            [&mockTrx, &collection](std::string const&, CursorType&, size_t&) -> std::unique_ptr<IndexIterator> {
               return std::make_unique<EmptyIndexIterator>(&collection, &(mockTrx.get()));
             }));
     // fake transaction::Methods - end
@@ -112,7 +112,7 @@ SCENARIO("EnumerateCollectionExecutor",
                                            regToClear, regToKeep, &engine, &abc,
                                            &outVariable, varUsedLater, projections,
                                            &trx, coveringIndexAttributePositions,
-                                           useRawPointers, random);
+                                           useRawPointers, random, 1 /*parallelism*/);
 
     SharedAqlItemBlockPtr block{new AqlItemBlock(itemBlockManager, 1000, 2)};
     VPackBuilder input;
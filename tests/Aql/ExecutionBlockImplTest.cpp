@@ -348,6 +348,57 @@ SCENARIO("ExecutionBlockImpl", "[AQL][EXECUTOR][EXECBLOCKIMPL]") {
     }
   }
 
+  GIVEN("there is a big block in the upstream") {
+    std::deque<SharedAqlItemBlockPtr> blockDeque;
+    SharedAqlItemBlockPtr block{new AqlItemBlock(itemBlockManager, 300, 1)};
+    for (size_t i = 0; i < block->size(); ++i) {
+      block->emplaceValue(i, 0, AqlValueHintInt(static_cast<int64_t>(i)));
+    }
+    blockDeque.push_back(std::move(block));
+
+    WHEN("the rows are fetched") {
+      WaitingExecutionBlockMock dependency{&engine, node, std::move(blockDeque)};
+      ExecutionBlockImpl<TestExecutorHelper> testee(&engine, node, std::move(infos));
+      testee.addDependency(&dependency);
+
+      THEN("the output blocks start small and grow") {
+        size_t atMost = 1000;
+        std::tie(state, block) = testee.getSome(atMost);
+        REQUIRE(state == ExecutionState::WAITING);
+        std::tie(state, block) = testee.getSome(atMost);
+        REQUIRE(state == ExecutionState::HASMORE);
+        REQUIRE(block->size() == 64);
+        std::tie(state, block) = testee.getSome(atMost);
+        REQUIRE(state == ExecutionState::HASMORE);
+        REQUIRE(block->size() == 128);
+        std::tie(state, block) = testee.getSome(atMost);
+        REQUIRE(state == ExecutionState::DONE);
+        REQUIRE(block->size() == 108);
+        REQUIRE(block->getValueReference(107, 0).toInt64() == 299);
+      }
+    }
+
+    WHEN("the query has a small memory limit") {
+      // a single block may take a sixteenth of the limit
+      lqueryOptions.memoryLimit = 16 * 32 * sizeof(AqlValue);
+      WaitingExecutionBlockMock dependency{&engine, node, std::move(blockDeque)};
+      ExecutionBlockImpl<TestExecutorHelper> testee(&engine, node, std::move(infos));
+      testee.addDependency(&dependency);
+
+      THEN("the output blocks do not grow beyond it") {
+        size_t atMost = 1000;
+        std::tie(state, block) = testee.getSome(atMost);
+        REQUIRE(state == ExecutionState::WAITING);
+        std::tie(state, block) = testee.getSome(atMost);
+        REQUIRE(state == ExecutionState::HASMORE);
+        REQUIRE(block->size() == 32);
+        std::tie(state, block) = testee.getSome(atMost);
+        REQUIRE(state == ExecutionState::HASMORE);
+        REQUIRE(block->size() == 32);
+      }
+    }
+  }
+
   GIVEN("there is an invalid/empty block in the upstream") {
     WHEN("the executor does wait, using getSome") {
       std::deque<SharedAqlItemBlockPtr> blockDeque;
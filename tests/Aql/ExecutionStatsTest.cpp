@@ -0,0 +1,125 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "catch.hpp"
+
+#include "Aql/ExecutionStats.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace arangodb {
+namespace tests {
+namespace aql {
+
+static ExecutionStats::Node makeNode(size_t factor) {
+  ExecutionStats::Node node;
+  node.calls = 1 * factor;
+  node.items = 2 * factor;
+  node.itemsIn = 3 * factor;
+  node.waiting = 4 * factor;
+  node.runtime = 0.5 * factor;
+  node.cpuTime = 0.25 * factor;
+  node.peakMemoryGrowth = 1000 * factor;
+  node.batchSize = 10 * factor;
+  return node;
+}
+
+SCENARIO("ExecutionStats node profile", "[AQL][STATS]") {
+  GIVEN("statistics of a node") {
+    ExecutionStats stats;
+    stats.nodes.emplace(7, makeNode(1));
+
+    THEN("they survive serialization") {
+      VPackBuilder builder;
+      stats.toVelocyPack(builder, false);
+      ExecutionStats other(builder.slice());
+
+      REQUIRE(other.nodes.size() == 1);
+      ExecutionStats::Node const& node = other.nodes.at(7);
+      REQUIRE(node.calls == 1);
+      REQUIRE(node.items == 2);
+      REQUIRE(node.itemsIn == 3);
+      REQUIRE(node.waiting == 4);
+      REQUIRE(node.runtime == 0.5);
+      REQUIRE(node.cpuTime == 0.25);
+      REQUIRE(node.peakMemoryGrowth == 1000);
+      REQUIRE(node.batchSize == 10);
+    }
+
+    THEN("they are summed up, except for the maximums") {
+      ExecutionStats other;
+      other.nodes.emplace(7, makeNode(2));
+      other.nodes.emplace(8, makeNode(3));
+      stats.add(other);
+
+      REQUIRE(stats.nodes.size() == 2);
+      ExecutionStats::Node const& node = stats.nodes.at(7);
+      REQUIRE(node.calls == 3);
+      REQUIRE(node.items == 6);
+      REQUIRE(node.itemsIn == 9);
+      REQUIRE(node.waiting == 12);
+      REQUIRE(node.runtime == 1.5);
+      REQUIRE(node.cpuTime == 0.75);
+      REQUIRE(node.peakMemoryGrowth == 2000);
+      REQUIRE(node.batchSize == 20);
+      REQUIRE(stats.nodes.at(8).peakMemoryGrowth == 3000);
+    }
+  }
+
+  GIVEN("statistics without the detailed values") {
+    VPackBuilder builder;
+    builder.openObject();
+    builder.add("writesExecuted", VPackValue(0));
+    builder.add("writesIgnored", VPackValue(0));
+    builder.add("scannedFull", VPackValue(0));
+    builder.add("scannedIndex", VPackValue(0));
+    builder.add("filtered", VPackValue(0));
+    builder.add("nodes", VPackValue(VPackValueType::Array));
+    builder.openObject();
+    builder.add("id", VPackValue(3));
+    builder.add("calls", VPackValue(5));
+    builder.add("items", VPackValue(10));
+    builder.add("runtime", VPackValue(1.0));
+    builder.close();
+    builder.close();
+    builder.close();
+
+    THEN("the detailed values are zero") {
+      ExecutionStats stats(builder.slice());
+      ExecutionStats::Node const& node = stats.nodes.at(3);
+      REQUIRE(node.calls == 5);
+      REQUIRE(node.items == 10);
+      REQUIRE(node.itemsIn == 0);
+      REQUIRE(node.waiting == 0);
+      REQUIRE(node.cpuTime == 0.0);
+      REQUIRE(node.peakMemoryGrowth == 0);
+    }
+  }
+}
+
+}  // namespace aql
+}  // namespace tests
+}  // namespace arangodb
@@ -0,0 +1,186 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+// test setup
+#include "AqlTestSetup.h"
+
+#include "Aql/ExecutionPlan.h"
+#include "Aql/Query.h"
+#include "Basics/VelocyPackHelper.h"
+#include "RestServer/QueryRegistryFeature.h"
+#include "Transaction/Methods.h"
+#include "Transaction/StandaloneContext.h"
+#include "Utils/SingleCollectionTransaction.h"
+#include "VocBase/LogicalCollection.h"
+
+extern const char* ARGV0;  // defined in main.cpp
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+
+TEST_CASE("HashJoin", "[aql][hash-join]") {
+  arangodb::tests::aql::AqlTestSetup<> s;
+  (void)(s);
+
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1,
+                        "testVocbase");
+
+  auto usesHashJoin = [](TRI_vocbase_t& vocbase, std::string const& queryString,
+                         std::string rules = "") -> bool {
+    auto options = arangodb::velocypack::Parser::fromJson(
+        "{\"optimizer\": {\"rules\": [" + rules + "]}}");
+    arangodb::aql::Query query(false, vocbase, arangodb::aql::QueryString(queryString),
+                               nullptr, options, arangodb::aql::PART_MAIN);
+
+    auto result = query.explain();
+    VPackSlice nodes = result.data->slice().get("nodes");
+    CHECK(nodes.isArray());
+
+    bool found = false;
+    for (auto const& it : VPackArrayIterator(nodes)) {
+      if (it.get("type").isEqualString("HashJoinNode")) {
+        found = true;
+      }
+    }
+    return found;
+  };
+
+  auto executeQuery = [](TRI_vocbase_t& vocbase, std::string const& queryString,
+                         std::string const& options) -> std::shared_ptr<VPackBuilder> {
+    arangodb::aql::Query query(false, vocbase, arangodb::aql::QueryString(queryString),
+                               nullptr, arangodb::velocypack::Parser::fromJson(options),
+                               arangodb::aql::PART_MAIN);
+    std::shared_ptr<arangodb::aql::SharedQueryState> ss = query.sharedState();
+    arangodb::aql::QueryResult result;
+
+    while (true) {
+      auto state = query.execute(arangodb::QueryRegistryFeature::registry(), result);
+      if (state == arangodb::aql::ExecutionState::WAITING) {
+        ss->waitForAsyncResponse();
+      } else {
+        break;
+      }
+    }
+
+    REQUIRE(result.result.ok());
+    REQUIRE(result.data->slice().isArray());
+    return result.data;
+  };
+
+  // create collections
+  {
+    auto createJson = arangodb::velocypack::Parser::fromJson(
+        "{ \"name\": \"testCollection0\" }");
+    auto collection0 = vocbase.createCollection(createJson->slice());
+    REQUIRE((nullptr != collection0));
+    createJson = arangodb::velocypack::Parser::fromJson(
+        "{ \"name\": \"testCollection1\" }");
+    auto collection1 = vocbase.createCollection(createJson->slice());
+    REQUIRE((nullptr != collection1));
+
+    std::vector<std::shared_ptr<arangodb::velocypack::Builder>> docs0;
+    for (size_t i = 0; i < 20; i++) {
+      docs0.emplace_back(arangodb::velocypack::Parser::fromJson(
+          "{ \"val\": " + std::to_string(i) + " }"));
+    }
+    // joins with all documents without the attribute
+    docs0.emplace_back(arangodb::velocypack::Parser::fromJson("{ \"val\": null }"));
+
+    std::vector<std::shared_ptr<arangodb::velocypack::Builder>> docs1;
+    for (size_t i = 0; i < 30; i++) {
+      docs1.emplace_back(arangodb::velocypack::Parser::fromJson(
+          "{ \"pos\": " + std::to_string(i) +
+          ", \"sub\": { \"ref\": " + std::to_string(i % 10) + " } }"));
+    }
+    docs1.emplace_back(arangodb::velocypack::Parser::fromJson("{ \"pos\": 30 }"));
+
+    arangodb::OperationOptions options;
+    for (auto const& it : std::vector<std::pair<std::shared_ptr<arangodb::LogicalCollection>,
+                                                std::vector<std::shared_ptr<arangodb::velocypack::Builder>>*>>{
+             {collection0, &docs0}, {collection1, &docs1}}) {
+      arangodb::SingleCollectionTransaction trx(
+          arangodb::transaction::StandaloneContext::Create(vocbase), *it.first,
+          arangodb::AccessMode::Type::WRITE);
+      CHECK((trx.begin().ok()));
+
+      for (auto& entry : *it.second) {
+        auto res = trx.insert(it.first->name(), entry->slice(), options);
+        CHECK((res.ok()));
+      }
+
+      CHECK((trx.commit().ok()));
+    }
+  }
+
+  std::string const query =
+      "FOR a IN testCollection0 FOR b IN testCollection1 FILTER b.sub.ref == "
+      "a.val SORT a.val, b.pos RETURN [a.val, b.pos]";
+  auto expected = executeQuery(vocbase, query,
+                               "{\"optimizer\": {\"rules\": [\"-hash-join\"]}}");
+  // 10 values with 3 matches each, plus the null value
+  CHECK(expected->slice().length() == 31);
+
+  // check the rule is applied
+  {
+    CHECK(usesHashJoin(vocbase, query));
+    CHECK(!usesHashJoin(vocbase, query, "\"-hash-join\""));
+  }
+
+  // check the results of the hash join
+  {
+    auto actual = executeQuery(vocbase, query, "{}");
+    CHECK(0 == arangodb::basics::VelocyPackHelper::compare(expected->slice(),
+                                                           actual->slice(), true));
+  }
+
+  // check the results if the hash table exceeds its memory budget
+  {
+    auto actual = executeQuery(vocbase, query, "{\"spillMemoryThreshold\": 1}");
+    CHECK(0 == arangodb::basics::VelocyPackHelper::compare(expected->slice(),
+                                                           actual->slice(), true));
+  }
+
+  // check the filter is not replaced if the probe value depends on the
+  // inner loop
+  {
+    std::string const other =
+        "FOR a IN testCollection0 FOR b IN testCollection1 FILTER b.sub.ref == "
+        "b.pos RETURN b";
+    CHECK(!usesHashJoin(vocbase, other));
+  }
+
+  // check the rule is not applied with a single outer row
+  {
+    std::string const other =
+        "FOR b IN testCollection1 FILTER b.sub.ref == 3 RETURN b";
+    CHECK(!usesHashJoin(vocbase, other));
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
@@ -42,6 +42,7 @@
 #include <velocypack/Builder.h>
 #include <velocypack/velocypack-aliases.h>
 #include <functional>
+#include <map>
 
 using namespace arangodb;
 using namespace arangodb::aql;
@@ -81,7 +82,8 @@ SCENARIO("HashedCollectExecutor", "[AQL][EXECUTOR][HASHEDCOLLECTEXECUTOR]") {
                                      std::move(writeableOutputRegisters),
                                      std::move(groupRegisters), collectRegister,
                                      std::move(aggregateTypes),
-                                     std::move(aggregateRegisters), trx, count);
+                                     std::move(aggregateRegisters), trx, count,
+                                     /*spillMemoryThreshold*/ 0);
 
     SharedAqlItemBlockPtr block{new AqlItemBlock(itemBlockManager, 1000, 2)};
     VPackBuilder input;
@@ -150,7 +152,8 @@ SCENARIO("HashedCollectExecutor", "[AQL][EXECUTOR][HASHEDCOLLECTEXECUTOR]") {
                                      std::move(writeableOutputRegisters),
                                      std::move(groupRegisters), collectRegister,
                                      std::move(aggregateTypes),
-                                     std::move(aggregateRegisters), trx, count);
+                                     std::move(aggregateRegisters), trx, count,
+                                     /*spillMemoryThreshold*/ 0);
 
     SharedAqlItemBlockPtr block{new AqlItemBlock(itemBlockManager, 1000, nrOutputRegister)};
     NoStats stats{};
@@ -427,7 +430,8 @@ SCENARIO("HashedCollectExecutor", "[AQL][EXECUTOR][HASHEDCOLLECTEXECUTOR]") {
                                      std::move(writeableOutputRegisters),
                                      std::move(groupRegisters), collectRegister,
                                      std::move(aggregateTypes),
-                                     std::move(aggregateRegisters), trx, count);
+                                     std::move(aggregateRegisters), trx, count,
+                                     /*spillMemoryThreshold*/ 0);
 
     SharedAqlItemBlockPtr block{new AqlItemBlock(itemBlockManager, 1000, nrOutputRegister)};
     NoStats stats{};
@@ -524,7 +528,8 @@ SCENARIO("HashedCollectExecutor", "[AQL][EXECUTOR][HASHEDCOLLECTEXECUTOR]") {
                                      std::move(writeableOutputRegisters),
                                      std::move(groupRegisters), collectRegister,
                                      std::move(aggregateTypes),
-                                     std::move(aggregateRegisters), trx, count);
+                                     std::move(aggregateRegisters), trx, count,
+                                     /*spillMemoryThreshold*/ 0);
 
     SharedAqlItemBlockPtr block{new AqlItemBlock(itemBlockManager, 1000, nrOutputRegister)};
     NoStats stats{};
@@ -637,7 +642,8 @@ SCENARIO("HashedCollectExecutor", "[AQL][EXECUTOR][HASHEDCOLLECTEXECUTOR]") {
                                      std::move(writeableOutputRegisters),
                                      std::move(groupRegisters), collectRegister,
                                      std::move(aggregateTypes),
-                                     std::move(aggregateRegisters), trx, count);
+                                     std::move(aggregateRegisters), trx, count,
+                                     /*spillMemoryThreshold*/ 0);
 
     SharedAqlItemBlockPtr block{new AqlItemBlock(itemBlockManager, 1000, nrOutputRegister)};
     NoStats stats{};
@@ -717,6 +723,89 @@ SCENARIO("HashedCollectExecutor", "[AQL][EXECUTOR][HASHEDCOLLECTEXECUTOR]") {
   }
 }
 
+SCENARIO("HashedCollectExecutor spilling to disk",
+         "[AQL][EXECUTOR][HASHEDCOLLECTEXECUTOR][SPILL]") {
+  ExecutionState state;
+  ResourceMonitor monitor;
+  AqlItemBlockManager itemBlockManager{&monitor};
+
+  GIVEN("there are more groups than fit into memory") {
+    mocks::MockAqlServer server{};
+    std::unique_ptr<arangodb::aql::Query> fakedQuery = server.createFakeQuery();
+    arangodb::transaction::Methods* trx = fakedQuery->trx();
+
+    std::unordered_set<RegisterId> regToClear;
+    std::unordered_set<RegisterId> regToKeep;
+    std::vector<std::pair<RegisterId, RegisterId>> groupRegisters;
+    groupRegisters.emplace_back(std::make_pair<RegisterId, RegisterId>(1, 0));
+
+    std::unordered_set<RegisterId> readableInputRegisters;
+    readableInputRegisters.insert(0);
+
+    std::unordered_set<RegisterId> writeableOutputRegisters;
+    writeableOutputRegisters.insert(1);
+    writeableOutputRegisters.insert(2);
+
+    RegisterId nrOutputRegister = 3;
+
+    // SUM of the group values
+    std::vector<std::pair<RegisterId, RegisterId>> aggregateRegisters;
+    aggregateRegisters.emplace_back(std::make_pair<RegisterId, RegisterId>(2, 0));
+
+    std::vector<std::string> aggregateTypes;
+    aggregateTypes.emplace_back("SUM");
+
+    RegisterId collectRegister = ExecutionNode::MaxRegisterId;
+    bool count = false;
+
+    // the first group exceeds the budget, so all other groups are spilled
+    HashedCollectExecutorInfos infos(1, nrOutputRegister, regToClear, regToKeep,
+                                     std::move(readableInputRegisters),
+                                     std::move(writeableOutputRegisters),
+                                     std::move(groupRegisters), collectRegister,
+                                     std::move(aggregateTypes),
+                                     std::move(aggregateRegisters), trx, count,
+                                     /*spillMemoryThreshold*/ 1);
+
+    SharedAqlItemBlockPtr block{new AqlItemBlock(itemBlockManager, 1000, nrOutputRegister)};
+    NoStats stats{};
+
+    WHEN("the producer does not wait") {
+      auto input = VPackParser::fromJson(
+          "[ [1], [2], [1], [3], [2], [1], [4], [3], [5], [2] ]");
+      SingleRowFetcherHelper<false> fetcher(input->steal(), false);
+      HashedCollectExecutor testee(fetcher, infos);
+
+      THEN("all groups are aggregated correctly") {
+        OutputAqlItemRow result(std::move(block), infos.getOutputRegisters(),
+                                infos.registersToKeep(), infos.registersToClear());
+
+        size_t produced = 0;
+        do {
+          std::tie(state, stats) = testee.produceRows(result);
+          REQUIRE(result.produced());
+          result.advanceRow();
+          ++produced;
+        } while (state == ExecutionState::HASMORE);
+        REQUIRE(state == ExecutionState::DONE);
+        REQUIRE(produced == 5);
+
+        auto block = result.stealBlock();
+        std::map<int64_t, int64_t> sums;
+        for (size_t i = 0; i < produced; ++i) {
+          AqlValue key = block->getValue(i, 1);
+          REQUIRE(key.isNumber());
+          AqlValue sum = block->getValue(i, 2);
+          REQUIRE(sum.isNumber());
+          REQUIRE(sums.emplace(key.toInt64(), sum.toInt64()).second);
+        }
+        std::map<int64_t, int64_t> expected{{1, 3}, {2, 6}, {3, 6}, {4, 4}, {5, 5}};
+        REQUIRE((sums == expected));
+      }
+    }
+  }
+}
+
 }  // namespace aql
 }  // namespace tests
 }  // namespace arangodb
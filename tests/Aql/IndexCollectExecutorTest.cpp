@@ -0,0 +1,250 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RowFetcherHelper.h"
+#include "catch.hpp"
+
+#include "Aql/AqlItemBlock.h"
+#include "Aql/ExecutionNode.h"
+#include "Aql/IndexCollectExecutor.h"
+#include "Aql/OutputAqlItemRow.h"
+#include "Aql/ResourceUsage.h"
+#include "Aql/SingleRowFetcher.h"
+#include "Indexes/Index.h"
+#include "Indexes/IndexIterator.h"
+#include "Mocks/StorageEngineMock.h"
+#include "RestServer/DatabaseFeature.h"
+#include "RestServer/QueryRegistryFeature.h"
+#include "StorageEngine/EngineSelectorFeature.h"
+#include "Transaction/StandaloneContext.h"
+#include "Utils/SingleCollectionTransaction.h"
+#include "VocBase/LogicalCollection.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace arangodb {
+namespace tests {
+namespace aql {
+
+namespace {
+
+/// @brief returns the given index entries in their order, covering the
+/// single index field
+class CoveringIteratorMock final : public IndexIterator {
+ public:
+  CoveringIteratorMock(LogicalCollection* collection, transaction::Methods* trx,
+                       std::vector<int64_t> const& values)
+      : IndexIterator(collection, trx), _values(values), _position(0) {}
+
+  char const* typeName() const override { return "CoveringIteratorMock"; }
+
+  void reset() override { _position = 0; }
+
+  bool hasCovering() const override { return true; }
+
+  bool next(LocalDocumentIdCallback const& cb, size_t limit) override {
+    return nextCovering([&cb](LocalDocumentId const& id, VPackSlice) { cb(id); }, limit);
+  }
+
+  bool nextCovering(DocumentCallback const& cb, size_t limit) override {
+    while (_position < _values.size() && limit > 0) {
+      VPackBuilder entry;
+      entry.openArray();
+      entry.add(VPackValue(_values[_position]));
+      entry.close();
+      ++_position;
+      cb(LocalDocumentId(_position), entry.slice());
+      --limit;
+    }
+    return _position < _values.size();
+  }
+
+ private:
+  std::vector<int64_t> const& _values;
+  size_t _position;
+};
+
+/// @brief a sorted index on "value" with the given entries
+class SortedIndexMock final : public Index {
+ public:
+  SortedIndexMock(LogicalCollection& collection, std::vector<int64_t> const& values)
+      : Index(1, collection, "sorted",
+              {{basics::AttributeName("value", false)}}, false, false),
+        _values(values) {}
+
+  IndexType type() const override { return Index::TRI_IDX_TYPE_SKIPLIST_INDEX; }
+  char const* typeName() const override { return "skiplist"; }
+  bool isPersistent() const override { return false; }
+  bool canBeDropped() const override { return true; }
+  bool isHidden() const override { return false; }
+  bool isSorted() const override { return true; }
+  bool hasSelectivityEstimate() const override { return false; }
+  bool hasCoveringIterator() const override { return true; }
+  size_t memory() const override { return sizeof(SortedIndexMock); }
+  void load() override {}
+  void unload() override {}
+
+  IndexIterator* iteratorForCondition(transaction::Methods* trx, AstNode const*,
+                                      Variable const*, IndexIteratorOptions const&) override {
+    return new CoveringIteratorMock(&_collection, trx, _values);
+  }
+
+ private:
+  std::vector<int64_t> const& _values;
+};
+
+struct IndexCollectExecutorSetup {
+  application_features::ApplicationServer server;
+  StorageEngineMock engine;
+  std::vector<std::pair<application_features::ApplicationFeature*, bool>> features;
+
+  IndexCollectExecutorSetup() : server(nullptr, nullptr), engine(server) {
+    EngineSelectorFeature::ENGINE = &engine;
+
+    // setup required application features
+    features.emplace_back(new DatabaseFeature(server), false);  // required for TRI_vocbase_t
+    features.emplace_back(new QueryRegistryFeature(server), false);  // required for TRI_vocbase_t
+
+    for (auto& f : features) {
+      application_features::ApplicationServer::server->addFeature(f.first);
+    }
+
+    for (auto& f : features) {
+      f.first->prepare();
+    }
+
+    for (auto& f : features) {
+      if (f.second) {
+        f.first->start();
+      }
+    }
+  }
+
+  ~IndexCollectExecutorSetup() {
+    application_features::ApplicationServer::server = nullptr;
+    EngineSelectorFeature::ENGINE = nullptr;
+
+    // destroy application features
+    for (auto& f : features) {
+      if (f.second) {
+        f.first->stop();
+      }
+    }
+
+    for (auto& f : features) {
+      f.first->unprepare();
+    }
+  }
+};
+
+}  // namespace
+
+TEST_CASE("IndexCollectExecutor", "[aql][index-collect]") {
+  IndexCollectExecutorSetup s;
+  (void)(s);
+
+  ResourceMonitor monitor;
+  AqlItemBlockManager itemBlockManager{&monitor};
+
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1, "testVocbase");
+  auto createJson = VPackParser::fromJson("{ \"name\": \"testCollection\" }");
+  auto collection = vocbase.createCollection(createJson->slice());
+  REQUIRE((nullptr != collection));
+
+  // the last group spans more entries than are read from the index at once
+  std::vector<int64_t> values{1, 1, 2, 3, 3, 3};
+  values.insert(values.end(), 2500, 4);
+  auto index = std::make_shared<SortedIndexMock>(*collection, values);
+
+  SingleCollectionTransaction trx(transaction::StandaloneContext::Create(vocbase),
+                                  *collection, AccessMode::Type::READ);
+  REQUIRE((trx.begin().ok()));
+
+  // runs the executor for the given input rows, and returns the group
+  // values and counts (or -1 without a count register)
+  auto collect = [&](std::string const& input, bool withCount)
+      -> std::vector<std::pair<int64_t, int64_t>> {
+    RegisterId const countRegister = withCount ? 2 : ExecutionNode::MaxRegisterId;
+    IndexCollectExecutorInfos infos(1 /*groupReg*/, countRegister, 1 /*nrIn*/,
+                                    3 /*nrOut*/, {}, {0},
+                                    transaction::Methods::IndexHandle(index), &trx);
+    SingleRowFetcherHelper<false> fetcher(VPackParser::fromJson(input)->steal(), false);
+    IndexCollectExecutor testee(fetcher, infos);
+    SharedAqlItemBlockPtr block{new AqlItemBlock(itemBlockManager, 1000, 3)};
+    OutputAqlItemRow result{std::move(block), infos.getOutputRegisters(),
+                            infos.registersToKeep(), infos.registersToClear()};
+
+    ExecutionState state = ExecutionState::HASMORE;
+    while (state != ExecutionState::DONE) {
+      IndexStats stats{};
+      std::tie(state, stats) = testee.produceRows(result);
+      REQUIRE((state != ExecutionState::WAITING));
+    }
+
+    std::vector<std::pair<int64_t, int64_t>> rows;
+    size_t const produced = result.numRowsWritten();
+    block = result.stealBlock();
+    for (size_t i = 0; i < produced; ++i) {
+      int64_t count = -1;
+      if (withCount) {
+        count = block->getValueReference(i, 2).toInt64();
+      } else {
+        CHECK((block->getValueReference(i, 2).isEmpty()));
+      }
+      rows.emplace_back(block->getValueReference(i, 1).toInt64(), count);
+    }
+    return rows;
+  };
+
+  SECTION("groups with counts") {
+    auto rows = collect("[ [0] ]", true);
+    std::vector<std::pair<int64_t, int64_t>> expected{{1, 2}, {2, 1}, {3, 3}, {4, 2500}};
+    CHECK((expected == rows));
+  }
+
+  SECTION("groups without counts") {
+    auto rows = collect("[ [0] ]", false);
+    std::vector<std::pair<int64_t, int64_t>> expected{{1, -1}, {2, -1}, {3, -1}, {4, -1}};
+    CHECK((expected == rows));
+  }
+
+  SECTION("the index is read again for every input row") {
+    auto rows = collect("[ [0], [1] ]", true);
+    std::vector<std::pair<int64_t, int64_t>> expected{{1, 2}, {2, 1}, {3, 3}, {4, 2500},
+                                                      {1, 2}, {2, 1}, {3, 3}, {4, 2500}};
+    CHECK((expected == rows));
+  }
+
+  SECTION("no input rows") {
+    auto rows = collect("[ ]", true);
+    CHECK((rows.empty()));
+  }
+
+  CHECK((trx.commit().ok()));
+}
+
+}  // namespace aql
+}  // namespace tests
+}  // namespace arangodb
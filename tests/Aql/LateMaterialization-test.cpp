@@ -0,0 +1,163 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+// test setup
+#include "AqlTestSetup.h"
+
+#include "Aql/Query.h"
+#include "Basics/VelocyPackHelper.h"
+#include "RestServer/QueryRegistryFeature.h"
+#include "Transaction/Methods.h"
+#include "Transaction/StandaloneContext.h"
+#include "Utils/SingleCollectionTransaction.h"
+#include "VocBase/LogicalCollection.h"
+
+namespace {
+
+/// @brief runs the query with the given options and returns its result
+std::shared_ptr<VPackBuilder> executeQuery(TRI_vocbase_t& vocbase, std::string const& queryString,
+                                           std::string const& options = "{}") {
+  arangodb::aql::Query query(false, vocbase, arangodb::aql::QueryString(queryString),
+                             nullptr, arangodb::velocypack::Parser::fromJson(options),
+                             arangodb::aql::PART_MAIN);
+  std::shared_ptr<arangodb::aql::SharedQueryState> ss = query.sharedState();
+  arangodb::aql::QueryResult result;
+
+  while (true) {
+    auto state = query.execute(arangodb::QueryRegistryFeature::registry(), result);
+    if (state == arangodb::aql::ExecutionState::WAITING) {
+      ss->waitForAsyncResponse();
+    } else {
+      break;
+    }
+  }
+
+  REQUIRE(result.result.ok());
+  REQUIRE(result.data->slice().isArray());
+  return result.data;
+}
+
+/// @brief whether the plan of the query contains a node of the given type
+bool usesNode(TRI_vocbase_t& vocbase, std::string const& queryString,
+              std::string const& type, std::string const& options = "{}") {
+  arangodb::aql::Query query(false, vocbase, arangodb::aql::QueryString(queryString),
+                             nullptr, arangodb::velocypack::Parser::fromJson(options),
+                             arangodb::aql::PART_MAIN);
+  auto result = query.explain();
+  REQUIRE(result.result.ok());
+  VPackSlice nodes = result.data->slice().get("nodes");
+  REQUIRE(nodes.isArray());
+
+  for (auto const& it : VPackArrayIterator(nodes)) {
+    if (it.get("type").isEqualString(type)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/// @brief inserts the given documents into the collection
+void insertDocuments(TRI_vocbase_t& vocbase, arangodb::LogicalCollection& collection,
+                     std::vector<std::string> const& documents) {
+  arangodb::OperationOptions options;
+  arangodb::SingleCollectionTransaction trx(
+      arangodb::transaction::StandaloneContext::Create(vocbase), collection,
+      arangodb::AccessMode::Type::WRITE);
+  REQUIRE((trx.begin().ok()));
+  for (auto const& it : documents) {
+    auto doc = arangodb::velocypack::Parser::fromJson(it);
+    REQUIRE((trx.insert(collection.name(), doc->slice(), options).ok()));
+  }
+  REQUIRE((trx.commit().ok()));
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+TEST_CASE("LateMaterialization", "[aql][late-materialization]") {
+  arangodb::tests::aql::AqlTestSetup<> s;
+  (void)(s);
+
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1,
+                        "testVocbase");
+  auto createJson = arangodb::velocypack::Parser::fromJson(
+      "{ \"name\": \"testCollection\" }");
+  auto collection = vocbase.createCollection(createJson->slice());
+  REQUIRE((nullptr != collection));
+
+  // "x" is unique, so the sort order is well-defined
+  std::vector<std::string> documents;
+  for (size_t i = 0; i < 20; ++i) {
+    documents.emplace_back("{ \"x\": " + std::to_string((i * 7) % 20) +
+                           ", \"y\": \"value" + std::to_string(i) + "\" }");
+  }
+  insertDocuments(vocbase, *collection, documents);
+
+  std::string const disabled = "{\"optimizer\": {\"rules\": [\"-late-document-materialization\"]}}";
+
+  SECTION("documents are materialized after the limit") {
+    std::string const query =
+        "FOR d IN testCollection SORT d.x DESC LIMIT 2, 5 RETURN UNSET(d, '_key', '_id', '_rev')";
+    CHECK((usesNode(vocbase, query, "MaterializeNode")));
+    CHECK((!usesNode(vocbase, query, "MaterializeNode", disabled)));
+
+    auto expected = executeQuery(vocbase, query, disabled);
+    CHECK((5 == expected->slice().length()));
+    auto actual = executeQuery(vocbase, query);
+    CHECK((0 == arangodb::basics::VelocyPackHelper::compare(expected->slice(),
+                                                            actual->slice(), true)));
+  }
+
+  SECTION("filters below the limit use the projection") {
+    std::string const query =
+        "FOR d IN testCollection FILTER d.x >= 10 SORT d.x LIMIT 3 RETURN d.y";
+    CHECK((usesNode(vocbase, query, "MaterializeNode")));
+
+    auto expected = executeQuery(vocbase, query, disabled);
+    CHECK((3 == expected->slice().length()));
+    auto actual = executeQuery(vocbase, query);
+    CHECK((0 == arangodb::basics::VelocyPackHelper::compare(expected->slice(),
+                                                            actual->slice(), true)));
+  }
+
+  SECTION("no materialization without a sort") {
+    CHECK((!usesNode(vocbase, "FOR d IN testCollection LIMIT 3 RETURN d",
+                     "MaterializeNode")));
+  }
+
+  SECTION("no materialization if the full document is used below the limit") {
+    CHECK((!usesNode(vocbase,
+                     "FOR d IN testCollection SORT HASH(d) LIMIT 3 RETURN d",
+                     "MaterializeNode")));
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
@@ -0,0 +1,250 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RowFetcherHelper.h"
+#include "catch.hpp"
+
+#include "Aql/AqlItemBlock.h"
+#include "Aql/MergeJoinExecutor.h"
+#include "Aql/OutputAqlItemRow.h"
+#include "Aql/ResourceUsage.h"
+#include "Aql/SingleRowFetcher.h"
+#include "Aql/Variable.h"
+#include "Indexes/Index.h"
+#include "Indexes/IndexIterator.h"
+#include "Mocks/StorageEngineMock.h"
+#include "RestServer/DatabaseFeature.h"
+#include "RestServer/QueryRegistryFeature.h"
+#include "StorageEngine/EngineSelectorFeature.h"
+#include "Transaction/StandaloneContext.h"
+#include "Utils/SingleCollectionTransaction.h"
+#include "VocBase/LogicalCollection.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace arangodb {
+namespace tests {
+namespace aql {
+
+namespace {
+
+/// @brief returns the given documents in their order
+class SortedIteratorMock final : public IndexIterator {
+ public:
+  SortedIteratorMock(LogicalCollection* collection, transaction::Methods* trx,
+                     std::vector<std::shared_ptr<VPackBuilder>> const& documents)
+      : IndexIterator(collection, trx), _documents(documents), _position(0) {}
+
+  char const* typeName() const override { return "SortedIteratorMock"; }
+
+  void reset() override { _position = 0; }
+
+  bool next(LocalDocumentIdCallback const& cb, size_t limit) override {
+    return nextDocument([&cb](LocalDocumentId const& id, VPackSlice) { cb(id); }, limit);
+  }
+
+  bool nextDocument(DocumentCallback const& cb, size_t limit) override {
+    while (_position < _documents.size() && limit > 0) {
+      ++_position;
+      cb(LocalDocumentId(_position), _documents[_position - 1]->slice());
+      --limit;
+    }
+    return _position < _documents.size();
+  }
+
+ private:
+  std::vector<std::shared_ptr<VPackBuilder>> const& _documents;
+  size_t _position;
+};
+
+/// @brief a sorted index on "value" over a fixed list of documents
+class SortedIndexMock final : public Index {
+ public:
+  SortedIndexMock(LogicalCollection& collection,
+                  std::vector<std::shared_ptr<VPackBuilder>> const& documents)
+      : Index(1, collection, "sorted",
+              {{basics::AttributeName("value", false)}}, false, false),
+        _documents(documents) {}
+
+  IndexType type() const override { return Index::TRI_IDX_TYPE_SKIPLIST_INDEX; }
+  char const* typeName() const override { return "skiplist"; }
+  bool isPersistent() const override { return false; }
+  bool canBeDropped() const override { return true; }
+  bool isHidden() const override { return false; }
+  bool isSorted() const override { return true; }
+  bool hasSelectivityEstimate() const override { return false; }
+  size_t memory() const override { return sizeof(SortedIndexMock); }
+  void load() override {}
+  void unload() override {}
+
+  IndexIterator* iteratorForCondition(transaction::Methods* trx, AstNode const*,
+                                      Variable const*, IndexIteratorOptions const&) override {
+    return new SortedIteratorMock(&_collection, trx, _documents);
+  }
+
+ private:
+  std::vector<std::shared_ptr<VPackBuilder>> const& _documents;
+};
+
+struct MergeJoinExecutorSetup {
+  application_features::ApplicationServer server;
+  StorageEngineMock engine;
+  std::vector<std::pair<application_features::ApplicationFeature*, bool>> features;
+
+  MergeJoinExecutorSetup() : server(nullptr, nullptr), engine(server) {
+    EngineSelectorFeature::ENGINE = &engine;
+
+    // setup required application features
+    features.emplace_back(new DatabaseFeature(server), false);  // required for TRI_vocbase_t
+    features.emplace_back(new QueryRegistryFeature(server), false);  // required for TRI_vocbase_t
+
+    for (auto& f : features) {
+      application_features::ApplicationServer::server->addFeature(f.first);
+    }
+
+    for (auto& f : features) {
+      f.first->prepare();
+    }
+
+    for (auto& f : features) {
+      if (f.second) {
+        f.first->start();
+      }
+    }
+  }
+
+  ~MergeJoinExecutorSetup() {
+    application_features::ApplicationServer::server = nullptr;
+    EngineSelectorFeature::ENGINE = nullptr;
+
+    // destroy application features
+    for (auto& f : features) {
+      if (f.second) {
+        f.first->stop();
+      }
+    }
+
+    for (auto& f : features) {
+      f.first->unprepare();
+    }
+  }
+};
+
+}  // namespace
+
+TEST_CASE("MergeJoinExecutor", "[aql][merge-join]") {
+  MergeJoinExecutorSetup s;
+  (void)(s);
+
+  ResourceMonitor monitor;
+  AqlItemBlockManager itemBlockManager{&monitor};
+
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1, "testVocbase");
+  auto createJson = VPackParser::fromJson("{ \"name\": \"testCollection\" }");
+  auto collection = vocbase.createCollection(createJson->slice());
+  REQUIRE((nullptr != collection));
+
+  // the index documents, sorted by "value". the document without the
+  // attribute joins as null
+  std::vector<std::shared_ptr<VPackBuilder>> documents;
+  documents.emplace_back(VPackParser::fromJson("{ \"pos\": 0 }"));
+  for (auto const& it : {"{ \"value\": 1, \"pos\": 1 }", "{ \"value\": 2, \"pos\": 2 }",
+                         "{ \"value\": 2, \"pos\": 3 }", "{ \"value\": 3, \"pos\": 4 }",
+                         "{ \"value\": 5, \"pos\": 5 }"}) {
+    documents.emplace_back(VPackParser::fromJson(it));
+  }
+  auto index = std::make_shared<SortedIndexMock>(*collection, documents);
+
+  SingleCollectionTransaction trx(transaction::StandaloneContext::Create(vocbase),
+                                  *collection, AccessMode::Type::READ);
+  REQUIRE((trx.begin().ok()));
+
+  Variable outVariable("b", 1);
+  // the infos own the attribute path, so a temporary is fine here
+  MergeJoinExecutorInfos infos(0 /*inReg*/, 1 /*outReg*/, 1 /*nrIn*/, 2 /*nrOut*/,
+                               {}, {0}, nullptr, nullptr, &outVariable,
+                               std::vector<std::string>{"value"},
+                               transaction::Methods::IndexHandle(index), &trx);
+  CHECK((std::vector<std::string>{"value"} == infos.getAttribute()));
+
+  // runs the executor on the given probe values and returns the pairs of
+  // probe value and document position
+  auto join = [&](std::string const& input) -> std::vector<std::pair<int64_t, int64_t>> {
+    SingleRowFetcherHelper<false> fetcher(VPackParser::fromJson(input)->steal(), false);
+    MergeJoinExecutor testee(fetcher, infos);
+    SharedAqlItemBlockPtr block{new AqlItemBlock(itemBlockManager, 1000, 2)};
+    OutputAqlItemRow result{std::move(block), infos.getOutputRegisters(),
+                            infos.registersToKeep(), infos.registersToClear()};
+
+    ExecutionState state = ExecutionState::HASMORE;
+    while (state != ExecutionState::DONE) {
+      IndexStats stats{};
+      std::tie(state, stats) = testee.produceRows(result);
+      REQUIRE((state != ExecutionState::WAITING));
+    }
+
+    std::vector<std::pair<int64_t, int64_t>> rows;
+    size_t const produced = result.numRowsWritten();
+    block = result.stealBlock();
+    for (size_t i = 0; i < produced; ++i) {
+      AqlValue const& probe = block->getValueReference(i, 0);
+      AqlValue const& document = block->getValueReference(i, 1);
+      rows.emplace_back(probe.isNull(false) ? -1 : probe.toInt64(),
+                        document.slice().get("pos").getNumber<int64_t>());
+    }
+    return rows;
+  };
+
+  SECTION("sorted probe values") {
+    auto rows = join("[ [1], [2], [2], [4], [5] ]");
+    std::vector<std::pair<int64_t, int64_t>> expected{{1, 1}, {2, 2}, {2, 3},
+                                                      {2, 2}, {2, 3}, {5, 5}};
+    CHECK((expected == rows));
+  }
+
+  SECTION("null joins documents without the attribute") {
+    auto rows = join("[ [null], [3] ]");
+    std::vector<std::pair<int64_t, int64_t>> expected{{-1, 0}, {3, 4}};
+    CHECK((expected == rows));
+  }
+
+  SECTION("unsorted probe values restart the index scan") {
+    auto rows = join("[ [3], [1], [5], [2] ]");
+    std::vector<std::pair<int64_t, int64_t>> expected{{3, 4}, {1, 1}, {5, 5},
+                                                      {2, 2}, {2, 3}};
+    CHECK((expected == rows));
+  }
+
+  SECTION("probe values without matches") {
+    auto rows = join("[ [0], [4], [6] ]");
+    CHECK((rows.empty()));
+  }
+
+  CHECK((trx.commit().ok()));
+}
+
+}  // namespace aql
+}  // namespace tests
+}  // namespace arangodb
@@ -903,6 +903,43 @@ SCENARIO("MultiDependencySingleRowFetcher", "[AQL][EXECUTOR][FETCHER]") {
       REQUIRE(dependencyProxyMock.numFetchBlockCalls() == 15);
     }
   }
+
+  GIVEN("multiple dependencies that wait") {
+    MultiDependencyProxyMock<false> dependencyProxyMock{monitor, 1, 3};
+
+    WHEN("prefetching the number of rows") {
+      for (size_t i = 0; i < 3; ++i) {
+        dependencyProxyMock.getDependencyMock(i)
+            .shouldReturn(ExecutionState::WAITING, nullptr)
+            .andThenReturn(ExecutionState::DONE,
+                           buildBlock<1>(itemBlockManager, {{static_cast<int>(i)}}));
+      }
+
+      {
+        MultiDependencySingleRowFetcher testee(dependencyProxyMock);
+        size_t count;
+
+        THEN("all dependencies should be asked before waiting") {
+          std::tie(state, count) = testee.preFetchNumberOfRows(1000);
+          REQUIRE(state == ExecutionState::WAITING);
+          REQUIRE(count == 0);
+          for (size_t i = 0; i < 3; ++i) {
+            REQUIRE(dependencyProxyMock.getDependencyMock(i).numFetchBlockCalls() == 1);
+          }
+
+          AND_THEN("all rows should be available afterwards") {
+            std::tie(state, count) = testee.preFetchNumberOfRows(1000);
+            REQUIRE(state == ExecutionState::DONE);
+            REQUIRE(count == 3);
+          }
+        }
+      }  // testee is destroyed here
+      // testee must be destroyed before verify, because it may call returnBlock
+      // in the destructor
+      REQUIRE(dependencyProxyMock.allBlocksFetched());
+      REQUIRE(dependencyProxyMock.numFetchBlockCalls() == 6);
+    }
+  }
 }
 }  // namespace aql
 }  // namespace tests
@@ -0,0 +1,99 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+// test setup
+#include "AqlTestSetup.h"
+
+#include "Aql/Query.h"
+#include "Aql/QueryOptions.h"
+#include "RestServer/QueryRegistryFeature.h"
+#include "Transaction/Methods.h"
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+TEST_CASE("OptimizerTimeBudget", "[aql][optimizer]") {
+  arangodb::tests::aql::AqlTestSetup<> s;
+  (void)(s);
+
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1,
+                        "testVocbase");
+  for (auto const& name : {"testCollection0", "testCollection1"}) {
+    auto createJson = arangodb::velocypack::Parser::fromJson(
+        std::string("{ \"name\": \"") + name + "\" }");
+    REQUIRE((nullptr != vocbase.createCollection(createJson->slice())));
+  }
+
+  // the two loops can be interchanged, which creates a second plan
+  std::string const queryString =
+      "FOR a IN testCollection0 FOR b IN testCollection1 RETURN [a, b]";
+
+  // returns the optimizer statistics of explaining the query
+  auto explain = [&](std::string const& options) -> std::shared_ptr<VPackBuilder> {
+    arangodb::aql::Query query(false, vocbase, arangodb::aql::QueryString(queryString),
+                               nullptr, arangodb::velocypack::Parser::fromJson(options),
+                               arangodb::aql::PART_MAIN);
+    auto result = query.explain();
+    REQUIRE((result.result.ok()));
+    REQUIRE((nullptr != result.extra));
+    auto stats = std::make_shared<VPackBuilder>();
+    stats->add(result.extra->slice().get("stats"));
+    return stats;
+  };
+
+  SECTION("the time budget is off by default") {
+    arangodb::aql::QueryOptions options;
+    CHECK((0.0 == options.maxOptimizationTime));
+
+    auto stats = explain("{}");
+    CHECK((2 == stats->slice().get("plansCreated").getNumber<int64_t>()));
+    CHECK((0 == stats->slice().get("plansDiscarded").getNumber<int64_t>()));
+  }
+
+  SECTION("a generous time budget creates all plans") {
+    auto stats = explain("{ \"maxOptimizationTime\": 3600 }");
+    CHECK((2 == stats->slice().get("plansCreated").getNumber<int64_t>()));
+    CHECK((0 == stats->slice().get("plansDiscarded").getNumber<int64_t>()));
+  }
+
+  SECTION("a used up time budget stops creating plans") {
+    // the first round of rules takes longer than this
+    auto stats = explain("{ \"maxOptimizationTime\": 0.000000001 }");
+    CHECK((1 == stats->slice().get("plansCreated").getNumber<int64_t>()));
+    CHECK((0 < stats->slice().get("rulesSkipped").getNumber<int64_t>()));
+  }
+
+  SECTION("negative time budgets are ignored") {
+    arangodb::aql::QueryOptions options;
+    options.fromVelocyPack(
+        arangodb::velocypack::Parser::fromJson("{ \"maxOptimizationTime\": -1 }")->slice());
+    CHECK((0.0 == options.maxOptimizationTime));
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
@@ -0,0 +1,285 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "AqlItemBlockHelper.h"
+#include "DependencyProxyMock.h"
+#include "catch.hpp"
+#include "fakeit.hpp"
+
+#include "Aql/AqlItemBlock.h"
+#include "Aql/ClusterNodes.h"
+#include "Aql/DependencyProxy.h"
+#include "Aql/ExecutionEngine.h"
+#include "Aql/InputAqlItemRow.h"
+#include "Aql/MultiDependencySingleRowFetcher.h"
+#include "Aql/OutputAqlItemRow.h"
+#include "Aql/Query.h"
+#include "Aql/ResourceUsage.h"
+#include "Aql/SortRegister.h"
+#include "Aql/SortingGatherExecutor.h"
+#include "Aql/Stats.h"
+#include "Aql/Variable.h"
+#include "Transaction/Context.h"
+#include "Transaction/Methods.h"
+
+#include <deque>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace arangodb {
+namespace tests {
+namespace aql {
+
+namespace {
+
+/// @brief returns the given answers to getSome in their order, and counts
+/// the calls
+class ScriptedBlockMock final : public ExecutionBlock {
+ public:
+  ScriptedBlockMock(ExecutionEngine* engine,
+                    std::deque<std::pair<ExecutionState, SharedAqlItemBlockPtr>>&& answers)
+      : ExecutionBlock(engine, nullptr), _answers(std::move(answers)), calls(0) {}
+
+  std::pair<ExecutionState, Result> initializeCursor(InputAqlItemRow const&) override {
+    return {ExecutionState::DONE, TRI_ERROR_NO_ERROR};
+  }
+
+  std::pair<ExecutionState, Result> shutdown(int) override {
+    return {ExecutionState::DONE, TRI_ERROR_NO_ERROR};
+  }
+
+  std::pair<ExecutionState, SharedAqlItemBlockPtr> getSome(size_t) override {
+    ++calls;
+    REQUIRE((!_answers.empty()));
+    auto answer = std::move(_answers.front());
+    _answers.pop_front();
+    return answer;
+  }
+
+  std::pair<ExecutionState, size_t> skipSome(size_t) override {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_NOT_IMPLEMENTED);
+  }
+
+ private:
+  std::deque<std::pair<ExecutionState, SharedAqlItemBlockPtr>> _answers;
+
+ public:
+  size_t calls;
+};
+
+int64_t valueAt(SharedAqlItemBlockPtr const& block, size_t row) {
+  return block->getValueReference(row, 0).toInt64();
+}
+
+}  // namespace
+
+TEST_CASE("ParallelGather", "[aql][gather]") {
+  ResourceMonitor monitor;
+  AqlItemBlockManager itemBlockManager{&monitor};
+  ExecutionState state;
+
+  SECTION("the fetcher asks all dependencies before waiting") {
+    MultiDependencyProxyMock<false> dependencyProxyMock{monitor, 1, 2};
+    dependencyProxyMock.getDependencyMock(0)
+        .shouldReturn(ExecutionState::WAITING, nullptr)
+        .andThenReturn(ExecutionState::DONE, buildBlock<1>(itemBlockManager, {{1}, {2}}));
+    dependencyProxyMock.getDependencyMock(1).shouldReturn(
+        ExecutionState::DONE, buildBlock<1>(itemBlockManager, {{3}}));
+
+    {
+      MultiDependencySingleRowFetcher testee(dependencyProxyMock);
+      size_t available;
+
+      std::tie(state, available) = testee.preFetchNumberOfRows(1000);
+      CHECK((ExecutionState::WAITING == state));
+      CHECK((1 == dependencyProxyMock.getDependencyMock(0).numFetchBlockCalls()));
+      CHECK((1 == dependencyProxyMock.getDependencyMock(1).numFetchBlockCalls()));
+
+      std::tie(state, available) = testee.preFetchNumberOfRows(1000);
+      CHECK((ExecutionState::DONE == state));
+      CHECK((3 == available));
+      // the second dependency is not asked again
+      CHECK((1 == dependencyProxyMock.getDependencyMock(1).numFetchBlockCalls()));
+    }
+    CHECK((dependencyProxyMock.allBlocksFetched()));
+  }
+
+  SECTION("the sorting gather asks all dependencies before waiting") {
+    fakeit::Mock<transaction::Methods> mockTrx;
+    transaction::Methods& trx = mockTrx.get();
+    fakeit::Mock<transaction::Context> mockContext;
+    transaction::Context& ctxt = mockContext.get();
+    fakeit::When(Method(mockTrx, transactionContextPtr)).AlwaysReturn(&ctxt);
+    fakeit::When(Method(mockContext, getVPackOptions))
+        .AlwaysReturn(&arangodb::velocypack::Options::Defaults);
+
+    Variable sortVar("mySortVar", 0);
+    SortElement sortElement{&sortVar, true};
+
+    for (auto sortMode : {GatherNode::SortMode::MinElement, GatherNode::SortMode::Heap}) {
+      std::vector<SortRegister> sortRegisters;
+      sortRegisters.emplace_back(0, sortElement);
+      SortingGatherExecutorInfos infos(std::make_shared<std::unordered_set<RegisterId>>(
+                                           std::initializer_list<RegisterId>{0}),
+                                       std::make_shared<std::unordered_set<RegisterId>>(),
+                                       1, 1, {}, {0}, std::move(sortRegisters),
+                                       &trx, sortMode);
+
+      MultiDependencyProxyMock<false> dependencyProxyMock{monitor, 1, 3};
+      dependencyProxyMock.getDependencyMock(0)
+          .shouldReturn(ExecutionState::WAITING, nullptr)
+          .andThenReturn(ExecutionState::DONE,
+                         buildBlock<1>(itemBlockManager, {{1}, {4}, {7}}));
+      dependencyProxyMock.getDependencyMock(1)
+          .shouldReturn(ExecutionState::WAITING, nullptr)
+          .andThenReturn(ExecutionState::DONE,
+                         buildBlock<1>(itemBlockManager, {{2}, {5}, {8}}));
+      dependencyProxyMock.getDependencyMock(2)
+          .shouldReturn(ExecutionState::WAITING, nullptr)
+          .andThenReturn(ExecutionState::DONE,
+                         buildBlock<1>(itemBlockManager, {{3}, {6}, {9}}));
+
+      {
+        MultiDependencySingleRowFetcher fetcher(dependencyProxyMock);
+        SortingGatherExecutor testee(fetcher, infos);
+        SharedAqlItemBlockPtr block{new AqlItemBlock(itemBlockManager, 1000, 1)};
+        OutputAqlItemRow output{std::move(block), infos.getOutputRegisters(),
+                                infos.registersToKeep(), infos.registersToClear()};
+        NoStats stats{};
+
+        // all requests are in flight after the first call
+        std::tie(state, stats) = testee.produceRows(output);
+        CHECK((ExecutionState::WAITING == state));
+        CHECK((!output.produced()));
+        for (size_t i = 0; i < 3; ++i) {
+          CHECK((1 == dependencyProxyMock.getDependencyMock(i).numFetchBlockCalls()));
+        }
+
+        do {
+          std::tie(state, stats) = testee.produceRows(output);
+          REQUIRE((ExecutionState::WAITING != state));
+          if (output.produced()) {
+            output.advanceRow();
+          }
+        } while (state != ExecutionState::DONE);
+
+        block = output.stealBlock();
+        REQUIRE((block != nullptr));
+        REQUIRE((9 == block->size()));
+        for (size_t i = 0; i < 9; ++i) {
+          CHECK((static_cast<int64_t>(i + 1) == valueAt(block, i)));
+        }
+      }
+      CHECK((dependencyProxyMock.allBlocksFetched()));
+    }
+  }
+
+  SECTION("the unsorted gather continues with a dependency that does not wait") {
+    fakeit::Mock<ExecutionEngine> mockEngine;
+    ExecutionEngine& engine = mockEngine.get();
+    fakeit::Mock<transaction::Methods> mockTrx;
+    transaction::Methods& trx = mockTrx.get();
+    fakeit::Mock<Query> mockQuery;
+    Query& query = mockQuery.get();
+    fakeit::Mock<QueryOptions> mockQueryOptions;
+    QueryOptions& queryOptions = mockQueryOptions.get();
+
+    fakeit::When(Method(mockEngine, itemBlockManager)).AlwaysReturn(itemBlockManager);
+    fakeit::When(Method(mockEngine, getQuery)).AlwaysReturn(&query);
+    fakeit::When(ConstOverloadedMethod(mockQuery, queryOptions, QueryOptions const&()))
+        .AlwaysDo([&]() -> QueryOptions const& { return queryOptions; });
+    fakeit::When(OverloadedMethod(mockQuery, queryOptions, QueryOptions & ()))
+        .AlwaysDo([&]() -> QueryOptions& { return queryOptions; });
+    fakeit::When(Method(mockQuery, trx)).AlwaysReturn(&trx);
+    fakeit::When(Method(mockQueryOptions, getProfileLevel))
+        .AlwaysReturn(ProfileLevel(PROFILE_LEVEL_NONE));
+
+    auto inputRegisters = std::make_shared<std::unordered_set<RegisterId> const>(
+        std::initializer_list<RegisterId>{0});
+    SharedAqlItemBlockPtr block;
+
+    SECTION("blocks are passed on in the order they arrive") {
+      ScriptedBlockMock dep0(&engine, {{ExecutionState::WAITING, nullptr},
+                                       {ExecutionState::DONE,
+                                        buildBlock<1>(itemBlockManager, {{1}})}});
+      ScriptedBlockMock dep1(&engine, {{ExecutionState::DONE,
+                                        buildBlock<1>(itemBlockManager, {{2}})}});
+      ScriptedBlockMock dep2(&engine, {{ExecutionState::DONE,
+                                        buildBlock<1>(itemBlockManager, {{3}})}});
+      DependencyProxy<false> testee({&dep0, &dep1, &dep2}, itemBlockManager,
+                                    inputRegisters, 1);
+
+      // the first dependency waits, so the second one is used meanwhile
+      std::tie(state, block) = testee.fetchBlock(1000);
+      CHECK((ExecutionState::HASMORE == state));
+      REQUIRE((block != nullptr));
+      CHECK((2 == valueAt(block, 0)));
+      CHECK((1 == dep0.calls));
+      CHECK((1 == dep1.calls));
+      CHECK((0 == dep2.calls));
+
+      std::tie(state, block) = testee.fetchBlock(1000);
+      CHECK((ExecutionState::HASMORE == state));
+      REQUIRE((block != nullptr));
+      CHECK((1 == valueAt(block, 0)));
+
+      std::tie(state, block) = testee.fetchBlock(1000);
+      CHECK((ExecutionState::DONE == state));
+      REQUIRE((block != nullptr));
+      CHECK((3 == valueAt(block, 0)));
+
+      CHECK((2 == dep0.calls));
+      CHECK((1 == dep1.calls));
+      CHECK((1 == dep2.calls));
+    }
+
+    SECTION("all dependencies are asked before waiting") {
+      ScriptedBlockMock dep0(&engine, {{ExecutionState::WAITING, nullptr},
+                                       {ExecutionState::DONE,
+                                        buildBlock<1>(itemBlockManager, {{1}})}});
+      ScriptedBlockMock dep1(&engine, {{ExecutionState::WAITING, nullptr},
+                                       {ExecutionState::DONE,
+                                        buildBlock<1>(itemBlockManager, {{2}})}});
+      DependencyProxy<false> testee({&dep0, &dep1}, itemBlockManager, inputRegisters, 1);
+
+      std::tie(state, block) = testee.fetchBlock(1000);
+      CHECK((ExecutionState::WAITING == state));
+      CHECK((block == nullptr));
+      CHECK((1 == dep0.calls));
+      CHECK((1 == dep1.calls));
+
+      std::tie(state, block) = testee.fetchBlock(1000);
+      CHECK((ExecutionState::HASMORE == state));
+      REQUIRE((block != nullptr));
+      CHECK((1 == valueAt(block, 0)));
+
+      std::tie(state, block) = testee.fetchBlock(1000);
+      CHECK((ExecutionState::DONE == state));
+      REQUIRE((block != nullptr));
+      CHECK((2 == valueAt(block, 0)));
+    }
+  }
+}
+
+}  // namespace aql
+}  // namespace tests
+}  // namespace arangodb
@@ -0,0 +1,285 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+// test setup
+#include "AqlTestSetup.h"
+
+#include "Aql/ExecutionPlan.h"
+#include "Aql/PlanCache.h"
+#include "Aql/PreparedStatement.h"
+#include "Aql/Query.h"
+#include "Aql/QueryString.h"
+#include "Basics/VelocyPackHelper.h"
+#include "RestServer/QueryRegistryFeature.h"
+#include "Transaction/Methods.h"
+#include "Transaction/StandaloneContext.h"
+#include "Utils/SingleCollectionTransaction.h"
+#include "VocBase/LogicalCollection.h"
+
+extern const char* ARGV0;  // defined in main.cpp
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+TEST_CASE("PlanCache", "[aql][plan-cache]") {
+  arangodb::tests::aql::AqlTestSetup<> s;
+  (void)(s);
+
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1,
+                        "testVocbase");
+
+  auto options = arangodb::velocypack::Parser::fromJson("{\"usePlanCache\": true}");
+
+  auto executeQuery = [&vocbase, &options](std::string const& queryString,
+                                           std::string const& bindParameters) -> std::shared_ptr<VPackBuilder> {
+    arangodb::aql::Query query(false, vocbase, arangodb::aql::QueryString(queryString),
+                               arangodb::velocypack::Parser::fromJson(bindParameters),
+                               options, arangodb::aql::PART_MAIN);
+    std::shared_ptr<arangodb::aql::SharedQueryState> ss = query.sharedState();
+    arangodb::aql::QueryResult result;
+
+    while (true) {
+      auto state = query.execute(arangodb::QueryRegistryFeature::registry(), result);
+      if (state == arangodb::aql::ExecutionState::WAITING) {
+        ss->waitForAsyncResponse();
+      } else {
+        break;
+      }
+    }
+
+    REQUIRE(result.result.ok());
+    REQUIRE(result.data->slice().isArray());
+    return result.data;
+  };
+
+  auto lookup = [&vocbase, &options](std::string const& queryString,
+                                     std::string const& bindParameters) {
+    auto parameters = arangodb::velocypack::Parser::fromJson(bindParameters);
+    std::string key =
+        arangodb::aql::PlanCache::buildKey(arangodb::aql::QueryString(queryString),
+                                           options->slice(), parameters->slice());
+    return arangodb::aql::PlanCache::instance()->lookup(&vocbase, key);
+  };
+
+  // create collections
+  {
+    auto createJson = arangodb::velocypack::Parser::fromJson(
+        "{ \"name\": \"testCollection0\" }");
+    auto collection = vocbase.createCollection(createJson->slice());
+    REQUIRE((nullptr != collection));
+    createJson = arangodb::velocypack::Parser::fromJson(
+        "{ \"name\": \"testCollection1\" }");
+    REQUIRE((nullptr != vocbase.createCollection(createJson->slice())));
+
+    arangodb::OperationOptions opOptions;
+    arangodb::SingleCollectionTransaction trx(
+        arangodb::transaction::StandaloneContext::Create(vocbase), *collection,
+        arangodb::AccessMode::Type::WRITE);
+    CHECK((trx.begin().ok()));
+
+    for (size_t i = 0; i < 20; i++) {
+      auto doc = arangodb::velocypack::Parser::fromJson(
+          "{ \"val\": " + std::to_string(i) + " }");
+      CHECK((trx.insert(collection->name(), doc->slice(), opOptions).ok()));
+    }
+
+    CHECK((trx.commit().ok()));
+  }
+
+  // the plan does not depend on the value of the parameter
+  {
+    std::string const query =
+        "FOR d IN testCollection0 FILTER d.val == @val RETURN d.val";
+    CHECK(lookup(query, "{\"val\": 3}") == nullptr);
+
+    for (int i = 0; i < 5; ++i) {
+      auto result = executeQuery(query, "{\"val\": " + std::to_string(i) + "}");
+      REQUIRE(result->slice().length() == 1);
+      CHECK(result->slice().at(0).getNumber<int>() == i);
+    }
+
+    auto entry = lookup(query, "{\"val\": 3}");
+    REQUIRE(entry != nullptr);
+    CHECK(entry->fixedParameters->slice().length() == 0);
+    CHECK(entry->plan->slice().toJson().find("\"bindParameter\":\"val\"") != std::string::npos);
+
+    // values of another type get a different entry
+    auto result = executeQuery(query, "{\"val\": \"3\"}");
+    CHECK(result->slice().length() == 0);
+    CHECK(lookup(query, "{\"val\": 3}") == entry);
+    CHECK(lookup(query, "{\"val\": \"3\"}") != nullptr);
+  }
+
+  // parameters with other usages are baked into the plan
+  {
+    std::string const query =
+        "FOR d IN testCollection0 SORT d.val LIMIT @limit RETURN d.val";
+    auto result = executeQuery(query, "{\"limit\": 2}");
+    CHECK(result->slice().length() == 2);
+
+    auto entry = lookup(query, "{\"limit\": 2}");
+    REQUIRE(entry != nullptr);
+    CHECK(entry->matches(arangodb::velocypack::Parser::fromJson("{\"limit\": 2}")->slice()));
+    CHECK(!entry->matches(arangodb::velocypack::Parser::fromJson("{\"limit\": 3}")->slice()));
+
+    // not served from the cache, and the entry is kept
+    result = executeQuery(query, "{\"limit\": 3}");
+    CHECK(result->slice().length() == 3);
+    CHECK(lookup(query, "{\"limit\": 3}") == entry);
+  }
+
+  // DDL operations invalidate the cache
+  {
+    std::string const query =
+        "FOR d IN testCollection0 FILTER d.val == @val RETURN d.val";
+    auto collection = vocbase.lookupCollection("testCollection1");
+    REQUIRE(collection != nullptr);
+    CHECK(vocbase.dropCollection(collection->id(), false, 0.0).ok());
+    CHECK(lookup(query, "{\"val\": 3}") == nullptr);
+
+    auto result = executeQuery(query, "{\"val\": 7}");
+    REQUIRE(result->slice().length() == 1);
+    CHECK(result->slice().at(0).getNumber<int>() == 7);
+  }
+
+  arangodb::aql::PlanCache::instance()->invalidate(&vocbase);
+}
+
+TEST_CASE("PreparedStatement", "[aql][plan-cache]") {
+  arangodb::tests::aql::AqlTestSetup<> s;
+  (void)(s);
+
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1,
+                        "testVocbase");
+  auto* registry = arangodb::aql::PreparedStatementRegistry::instance();
+
+  {
+    auto createJson = arangodb::velocypack::Parser::fromJson(
+        "{ \"name\": \"testCollection0\" }");
+    auto collection = vocbase.createCollection(createJson->slice());
+    REQUIRE((nullptr != collection));
+    createJson = arangodb::velocypack::Parser::fromJson(
+        "{ \"name\": \"testCollection1\" }");
+    REQUIRE((nullptr != vocbase.createCollection(createJson->slice())));
+
+    arangodb::OperationOptions opOptions;
+    arangodb::SingleCollectionTransaction trx(
+        arangodb::transaction::StandaloneContext::Create(vocbase), *collection,
+        arangodb::AccessMode::Type::WRITE);
+    CHECK((trx.begin().ok()));
+
+    for (size_t i = 0; i < 20; i++) {
+      auto doc = arangodb::velocypack::Parser::fromJson(
+          "{ \"val\": " + std::to_string(i) + " }");
+      CHECK((trx.insert(collection->name(), doc->slice(), opOptions).ok()));
+    }
+
+    CHECK((trx.commit().ok()));
+  }
+
+  std::string const queryString =
+      "FOR d IN testCollection0 FILTER d.val == @val RETURN d.val";
+  auto statement = registry->create(&vocbase, std::string(queryString),
+                                    arangodb::velocypack::Parser::fromJson(
+                                        "{\"fullCount\": false}")
+                                        ->slice(),
+                                    0.0);
+  REQUIRE(statement != nullptr);
+  CHECK(statement->ttl() == arangodb::aql::PreparedStatementRegistry::defaultTTL);
+  CHECK(registry->lookup(&vocbase, statement->id()) == statement);
+
+  auto options = statement->executionOptions(
+      arangodb::velocypack::Parser::fromJson("{\"fullCount\": true}")->slice());
+  CHECK(options->slice().get("fullCount").getBool());
+  CHECK(options->slice().get("usePlanCache").getBool());
+  CHECK(options->slice().get("preparedStatement").getNumber<uint64_t>() == statement->id());
+
+  auto executeQuery = [&](std::string const& bindParameters) -> std::shared_ptr<VPackBuilder> {
+    arangodb::aql::Query query(false, vocbase, arangodb::aql::QueryString(queryString),
+                               arangodb::velocypack::Parser::fromJson(bindParameters),
+                               options, arangodb::aql::PART_MAIN);
+    std::shared_ptr<arangodb::aql::SharedQueryState> ss = query.sharedState();
+    arangodb::aql::QueryResult result;
+
+    while (true) {
+      auto state = query.execute(arangodb::QueryRegistryFeature::registry(), result);
+      if (state == arangodb::aql::ExecutionState::WAITING) {
+        ss->waitForAsyncResponse();
+      } else {
+        break;
+      }
+    }
+
+    REQUIRE(result.result.ok());
+    REQUIRE(result.data->slice().isArray());
+    return result.data;
+  };
+
+  std::string const key = arangodb::aql::PlanCache::buildKey(
+      arangodb::aql::QueryString(queryString), options->slice(),
+      arangodb::velocypack::Parser::fromJson("{\"val\": 1}")->slice());
+
+  // the plan is kept with the statement, not in the plan cache
+  {
+    auto result = executeQuery("{\"val\": 4}");
+    REQUIRE(result->slice().length() == 1);
+    CHECK(result->slice().at(0).getNumber<int>() == 4);
+
+    auto generation = arangodb::aql::PlanCache::instance()->generation();
+    auto plan = statement->plan(key, generation);
+    REQUIRE(plan != nullptr);
+    CHECK(arangodb::aql::PlanCache::instance()->lookup(&vocbase, key) == nullptr);
+
+    result = executeQuery("{\"val\": 5}");
+    REQUIRE(result->slice().length() == 1);
+    CHECK(result->slice().at(0).getNumber<int>() == 5);
+    CHECK(statement->plan(key, generation) == plan);
+  }
+
+  // DDL operations invalidate the plan
+  {
+    auto collection = vocbase.lookupCollection("testCollection1");
+    REQUIRE(collection != nullptr);
+    CHECK(vocbase.dropCollection(collection->id(), false, 0.0).ok());
+    auto generation = arangodb::aql::PlanCache::instance()->generation();
+    CHECK(statement->plan(key, generation) == nullptr);
+
+    auto result = executeQuery("{\"val\": 6}");
+    REQUIRE(result->slice().length() == 1);
+    CHECK(statement->plan(key, generation) != nullptr);
+  }
+
+  CHECK(registry->remove(&vocbase, statement->id()));
+  CHECK(!registry->remove(&vocbase, statement->id()));
+  CHECK(registry->lookup(&vocbase, statement->id()) == nullptr);
+
+  registry->drop(&vocbase);
+  arangodb::aql::PlanCache::instance()->invalidate(&vocbase);
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
@@ -0,0 +1,306 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "AqlItemBlockHelper.h"
+#include "WaitingExecutionBlockMock.h"
+#include "catch.hpp"
+#include "fakeit.hpp"
+
+#include "Aql/AqlItemBlock.h"
+#include "Aql/AqlItemBlockManager.h"
+#include "Aql/ExecutionEngine.h"
+#include "Aql/InputAqlItemRow.h"
+#include "Aql/PrefetchBlock.h"
+#include "Aql/Query.h"
+#include "Aql/ResourceUsage.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
+#include "Transaction/Methods.h"
+
+#include <deque>
+#include <functional>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace arangodb {
+namespace tests {
+namespace aql {
+
+namespace {
+
+/// @brief returns the given blocks without ever waiting, and counts the
+/// calls of getSome
+class BlockQueueMock final : public ExecutionBlock {
+ public:
+  BlockQueueMock(ExecutionEngine* engine, std::deque<SharedAqlItemBlockPtr>&& data)
+      : ExecutionBlock(engine, nullptr), _data(std::move(data)), calls(0) {}
+
+  std::pair<ExecutionState, Result> initializeCursor(InputAqlItemRow const&) override {
+    return {ExecutionState::DONE, TRI_ERROR_NO_ERROR};
+  }
+
+  std::pair<ExecutionState, Result> shutdown(int) override {
+    return {ExecutionState::DONE, TRI_ERROR_NO_ERROR};
+  }
+
+  std::pair<ExecutionState, SharedAqlItemBlockPtr> getSome(size_t) override {
+    ++calls;
+    if (_data.empty()) {
+      return {ExecutionState::DONE, nullptr};
+    }
+    SharedAqlItemBlockPtr result = std::move(_data.front());
+    _data.pop_front();
+    return {_data.empty() ? ExecutionState::DONE : ExecutionState::HASMORE,
+            std::move(result)};
+  }
+
+  std::pair<ExecutionState, size_t> skipSome(size_t) override {
+    ++calls;
+    if (_data.empty()) {
+      return {ExecutionState::DONE, 0};
+    }
+    size_t skipped = _data.front()->size();
+    _data.pop_front();
+    return {_data.empty() ? ExecutionState::DONE : ExecutionState::HASMORE, skipped};
+  }
+
+ private:
+  std::deque<SharedAqlItemBlockPtr> _data;
+
+ public:
+  size_t calls;
+};
+
+/// @brief keeps all queued functions, they are only executed on request
+class CollectingScheduler final : public Scheduler {
+ public:
+  CollectingScheduler() : _previous(SchedulerFeature::SCHEDULER) {
+    SchedulerFeature::SCHEDULER = this;
+  }
+
+  ~CollectingScheduler() { SchedulerFeature::SCHEDULER = _previous; }
+
+  bool queue(RequestLane, Handler fn) override {
+    queued.emplace_back(std::move(fn));
+    return true;
+  }
+
+  void runAll() {
+    auto fns = std::move(queued);
+    queued.clear();
+    for (auto& fn : fns) {
+      fn();
+    }
+  }
+
+  void addQueueStatistics(velocypack::Builder&) const override {}
+  QueueStatistics queueStatistics() const override {
+    return QueueStatistics{0, 0, 0, 0, 0, 0};
+  }
+  std::string infoStatus() const override { return ""; }
+  bool isStopping() override { return false; }
+
+  std::vector<Handler> queued;
+
+ private:
+  Scheduler* _previous;
+};
+
+int64_t valueAt(SharedAqlItemBlockPtr const& block, size_t row) {
+  return block->getValueReference(row, 0).toInt64();
+}
+
+}  // namespace
+
+TEST_CASE("PrefetchBlock", "[aql][prefetch]") {
+  fakeit::Mock<ExecutionEngine> mockEngine;
+  ExecutionEngine& engine = mockEngine.get();
+
+  fakeit::Mock<transaction::Methods> mockTrx;
+  transaction::Methods& trx = mockTrx.get();
+
+  fakeit::Mock<Query> mockQuery;
+  Query& query = mockQuery.get();
+
+  fakeit::Mock<QueryOptions> mockQueryOptions;
+  QueryOptions& queryOptions = mockQueryOptions.get();
+
+  ResourceMonitor monitor;
+  AqlItemBlockManager itemBlockManager(&monitor);
+
+  fakeit::When(Method(mockEngine, itemBlockManager)).AlwaysReturn(itemBlockManager);
+  fakeit::When(Method(mockEngine, getQuery)).AlwaysReturn(&query);
+  fakeit::When(ConstOverloadedMethod(mockQuery, queryOptions, QueryOptions const&()))
+      .AlwaysDo([&]() -> QueryOptions const& { return queryOptions; });
+  fakeit::When(OverloadedMethod(mockQuery, queryOptions, QueryOptions & ()))
+      .AlwaysDo([&]() -> QueryOptions& { return queryOptions; });
+  fakeit::When(Method(mockQuery, trx)).AlwaysReturn(&trx);
+  fakeit::When(Method(mockQueryOptions, getProfileLevel))
+      .AlwaysReturn(ProfileLevel(PROFILE_LEVEL_NONE));
+
+  std::deque<SharedAqlItemBlockPtr> data;
+  data.emplace_back(buildBlock<1>(itemBlockManager, {{1}, {2}, {3}}));
+  data.emplace_back(buildBlock<1>(itemBlockManager, {{4}, {5}}));
+
+  ExecutionState state;
+  SharedAqlItemBlockPtr block;
+
+  SECTION("without a scheduler, blocks are fetched directly") {
+    Scheduler* previous = SchedulerFeature::SCHEDULER;
+    SchedulerFeature::SCHEDULER = nullptr;
+
+    BlockQueueMock dependency(&engine, std::move(data));
+    PrefetchBlock testee(&engine, nullptr);
+    testee.addDependency(&dependency);
+
+    // more rows than requested are kept for the next call
+    std::tie(state, block) = testee.getSome(2);
+    CHECK(state == ExecutionState::HASMORE);
+    REQUIRE(block != nullptr);
+    REQUIRE(block->size() == 2);
+    CHECK(valueAt(block, 0) == 1);
+    CHECK(valueAt(block, 1) == 2);
+
+    std::tie(state, block) = testee.getSome(2);
+    CHECK(state == ExecutionState::HASMORE);
+    REQUIRE(block != nullptr);
+    REQUIRE(block->size() == 1);
+    CHECK(valueAt(block, 0) == 3);
+    CHECK(dependency.calls == 1);
+
+    std::tie(state, block) = testee.getSome(1000);
+    CHECK(state == ExecutionState::DONE);
+    REQUIRE(block != nullptr);
+    REQUIRE(block->size() == 2);
+    CHECK(valueAt(block, 0) == 4);
+    CHECK(valueAt(block, 1) == 5);
+
+    std::tie(state, block) = testee.getSome(1000);
+    CHECK(state == ExecutionState::DONE);
+    CHECK(block == nullptr);
+    CHECK(dependency.calls == 2);
+
+    SchedulerFeature::SCHEDULER = previous;
+  }
+
+  SECTION("a finished prefetch is returned without asking the dependency") {
+    CollectingScheduler scheduler;
+    BlockQueueMock dependency(&engine, std::move(data));
+    PrefetchBlock testee(&engine, nullptr);
+    testee.addDependency(&dependency);
+
+    std::tie(state, block) = testee.getSome(1000);
+    CHECK(state == ExecutionState::HASMORE);
+    REQUIRE(block != nullptr);
+    REQUIRE(block->size() == 3);
+    CHECK(dependency.calls == 1);
+    REQUIRE(scheduler.queued.size() == 1);
+
+    // executes the dependency, as a scheduler thread would
+    scheduler.runAll();
+    CHECK(dependency.calls == 2);
+
+    std::tie(state, block) = testee.getSome(1000);
+    CHECK(state == ExecutionState::DONE);
+    REQUIRE(block != nullptr);
+    REQUIRE(block->size() == 2);
+    CHECK(valueAt(block, 0) == 4);
+    CHECK(dependency.calls == 2);
+    // nothing is prefetched after DONE
+    CHECK(scheduler.queued.empty());
+  }
+
+  SECTION("a prefetch that has not been started is executed by the query") {
+    CollectingScheduler scheduler;
+    BlockQueueMock dependency(&engine, std::move(data));
+    PrefetchBlock testee(&engine, nullptr);
+    testee.addDependency(&dependency);
+
+    std::tie(state, block) = testee.getSome(1000);
+    CHECK(state == ExecutionState::HASMORE);
+    REQUIRE(scheduler.queued.size() == 1);
+
+    std::tie(state, block) = testee.getSome(1000);
+    CHECK(state == ExecutionState::DONE);
+    REQUIRE(block != nullptr);
+    REQUIRE(block->size() == 2);
+    CHECK(dependency.calls == 2);
+
+    // the cancelled prefetch must not touch the dependency anymore
+    scheduler.runAll();
+    CHECK(dependency.calls == 2);
+  }
+
+  SECTION("skipping uses up the prefetched block first") {
+    CollectingScheduler scheduler;
+    BlockQueueMock dependency(&engine, std::move(data));
+    PrefetchBlock testee(&engine, nullptr);
+    testee.addDependency(&dependency);
+
+    std::tie(state, block) = testee.getSome(1);
+    CHECK(state == ExecutionState::HASMORE);
+    REQUIRE(block != nullptr);
+    CHECK(valueAt(block, 0) == 1);
+
+    size_t skipped;
+    std::tie(state, skipped) = testee.skipSome(1000);
+    CHECK(state == ExecutionState::HASMORE);
+    CHECK(skipped == 2);
+
+    scheduler.runAll();
+    std::tie(state, skipped) = testee.skipSome(1);
+    CHECK(state == ExecutionState::HASMORE);
+    CHECK(skipped == 1);
+
+    std::tie(state, block) = testee.getSome(1000);
+    CHECK(state == ExecutionState::DONE);
+    REQUIRE(block != nullptr);
+    REQUIRE(block->size() == 1);
+    CHECK(valueAt(block, 0) == 5);
+    CHECK(dependency.calls == 2);
+  }
+
+  SECTION("WAITING of the dependency is passed through") {
+    Scheduler* previous = SchedulerFeature::SCHEDULER;
+    SchedulerFeature::SCHEDULER = nullptr;
+
+    WaitingExecutionBlockMock dependency(&engine, nullptr, std::move(data));
+    PrefetchBlock testee(&engine, nullptr);
+    testee.addDependency(&dependency);
+
+    std::tie(state, block) = testee.getSome(1000);
+    CHECK(state == ExecutionState::WAITING);
+    CHECK(block == nullptr);
+
+    std::tie(state, block) = testee.getSome(1000);
+    CHECK(state == ExecutionState::HASMORE);
+    REQUIRE(block != nullptr);
+    REQUIRE(block->size() == 3);
+
+    SchedulerFeature::SCHEDULER = previous;
+  }
+}
+
+}  // namespace aql
+}  // namespace tests
+}  // namespace arangodb
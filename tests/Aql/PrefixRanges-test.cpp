@@ -0,0 +1,204 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+// test setup
+#include "AqlTestSetup.h"
+
+#include "Aql/Query.h"
+#include "Basics/VelocyPackHelper.h"
+#include "RestServer/QueryRegistryFeature.h"
+#include "Transaction/Methods.h"
+#include "Transaction/StandaloneContext.h"
+#include "Utils/SingleCollectionTransaction.h"
+#include "VocBase/LogicalCollection.h"
+
+extern const char* ARGV0;  // defined in main.cpp
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+TEST_CASE("PrefixRanges", "[aql][prefix-ranges]") {
+  arangodb::tests::aql::AqlTestSetup<> s;
+  (void)(s);
+
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1,
+                        "testVocbase");
+
+  auto makeBindParameters = [](std::string const& pattern) {
+    auto bindParameters = std::make_shared<VPackBuilder>();
+    bindParameters->openObject();
+    bindParameters->add("pattern", VPackValue(pattern));
+    bindParameters->close();
+    return bindParameters;
+  };
+
+  auto appliedRules = [&makeBindParameters](TRI_vocbase_t& vocbase,
+                                            std::string const& queryString,
+                                            std::string const& pattern) {
+    auto options = arangodb::velocypack::Parser::fromJson("{}");
+    arangodb::aql::Query query(false, vocbase, arangodb::aql::QueryString(queryString),
+                               makeBindParameters(pattern), options,
+                               arangodb::aql::PART_MAIN);
+
+    auto result = query.explain();
+    REQUIRE(result.result.ok());
+    VPackSlice rules = result.data->slice().get("rules");
+    REQUIRE(rules.isArray());
+
+    std::set<std::string> names;
+    for (auto const& it : VPackArrayIterator(rules)) {
+      names.emplace(it.copyString());
+    }
+    return names;
+  };
+
+  auto executeQuery = [&makeBindParameters](TRI_vocbase_t& vocbase,
+                                            std::string const& queryString,
+                                            std::string const& pattern,
+                                            std::string rules = "") {
+    auto options = arangodb::velocypack::Parser::fromJson(
+        "{\"optimizer\": {\"rules\": [" + rules + "]}}");
+    arangodb::aql::Query query(false, vocbase, arangodb::aql::QueryString(queryString),
+                               makeBindParameters(pattern), options,
+                               arangodb::aql::PART_MAIN);
+    std::shared_ptr<arangodb::aql::SharedQueryState> ss = query.sharedState();
+    arangodb::aql::QueryResult result;
+
+    while (true) {
+      auto state = query.execute(arangodb::QueryRegistryFeature::registry(), result);
+      if (state == arangodb::aql::ExecutionState::WAITING) {
+        ss->waitForAsyncResponse();
+      } else {
+        break;
+      }
+    }
+
+    REQUIRE(result.result.ok());
+    REQUIRE(result.data->slice().isArray());
+
+    std::set<std::string> values;
+    for (auto const& it : VPackArrayIterator(result.data->slice())) {
+      values.emplace(it.copyString());
+    }
+    return values;
+  };
+
+  // values around the prefix "abc", with line terminators in all places
+  std::vector<std::string> const values = {
+      "abc",          "abcdef",           "ab",
+      "abd",          "ABC",              "xabc",
+      "abc\n",        "abc\r\n",          "\nabc",
+      "x\nabc",       "ab\nc",            "abc\x0b",
+      "abc\x0c" "d",  "abc\xc2\x85",      "abc\xe2\x80\xa8",
+      "\xe2\x80\xa9" "abc"};
+
+  {
+    auto createJson = arangodb::velocypack::Parser::fromJson(
+        "{ \"name\": \"testCollection0\" }");
+    auto collection = vocbase.createCollection(createJson->slice());
+    REQUIRE((nullptr != collection));
+
+    arangodb::OperationOptions options;
+    arangodb::SingleCollectionTransaction trx(arangodb::transaction::StandaloneContext::Create(vocbase),
+                                              *collection,
+                                              arangodb::AccessMode::Type::WRITE);
+    CHECK((trx.begin().ok()));
+
+    for (auto const& value : values) {
+      VPackBuilder doc;
+      doc.openObject();
+      doc.add("value", VPackValue(value));
+      doc.close();
+      auto res = trx.insert(collection->name(), doc.slice(), options);
+      CHECK((res.ok()));
+    }
+
+    CHECK((trx.commit().ok()));
+  }
+
+  std::string const regexQuery =
+      "FOR d IN testCollection0 FILTER REGEX_TEST(d.value, @pattern) RETURN d.value";
+  std::string const likeQuery =
+      "FOR d IN testCollection0 FILTER LIKE(d.value, @pattern) RETURN d.value";
+
+  // the ranges are only a pre-filter, the results must not change
+  auto checkSameResults = [&](std::string const& query, std::string const& pattern) {
+    auto expected = executeQuery(vocbase, query, pattern, "\"-add-prefix-ranges\"");
+    auto actual = executeQuery(vocbase, query, pattern);
+    CHECK((expected == actual));
+    return actual;
+  };
+
+  SECTION("anchored regexes get a range") {
+    for (std::string const pattern :
+         {"^abc", "^abc$", "^abc.*$", "^abc\\n?$", "^abc[\\s\\S]*$", "^ab$"}) {
+      CAPTURE(pattern);
+      CHECK((1 == appliedRules(vocbase, regexQuery, pattern).count("add-prefix-ranges")));
+      checkSameResults(regexQuery, pattern);
+    }
+
+    // "$" matches before a line terminator at the end of the value
+    auto result = checkSameResults(regexQuery, "^abc$");
+    CHECK((1 == result.count("abc")));
+    CHECK((1 == result.count("abc\n")));
+    CHECK((0 == result.count("abcdef")));
+  }
+
+  SECTION("regexes without a usable anchor get no range") {
+    // without UREGEX_MULTILINE, "^" only matches at the start of the value,
+    // but these regexes may match anywhere
+    for (std::string const pattern :
+         {"abc", "(?m)^abc", "^abc|^x", "x|^abc", "\\Aabc", "^\\nabc", "^(?i)abc"}) {
+      CAPTURE(pattern);
+      CHECK((0 == appliedRules(vocbase, regexQuery, pattern).count("add-prefix-ranges")));
+      checkSameResults(regexQuery, pattern);
+    }
+
+    // the line terminator before "abc" does not start a new match
+    auto result = checkSameResults(regexQuery, "(?m)^abc");
+    CHECK((1 == result.count("x\nabc")));
+  }
+
+  SECTION("LIKE prefix searches get a range") {
+    for (std::string const pattern : {"abc%", "abc_", "ab%c", "abc%\\%"}) {
+      CAPTURE(pattern);
+      CHECK((1 == appliedRules(vocbase, likeQuery, pattern).count("add-prefix-ranges")));
+      checkSameResults(likeQuery, pattern);
+    }
+
+    for (std::string const pattern : {"%abc", "abc", "_bc"}) {
+      CAPTURE(pattern);
+      CHECK((0 == appliedRules(vocbase, likeQuery, pattern).count("add-prefix-ranges")));
+      checkSameResults(likeQuery, pattern);
+    }
+
+    // the wildcards do not match all line terminators
+    auto result = checkSameResults(likeQuery, "abc%");
+    CHECK((1 == result.count("abc\r\n")));
+    CHECK((0 == result.count("abc\x0b")));
+    CHECK((0 == result.count("abc\xe2\x80\xa8")));
+  }
+}
@@ -0,0 +1,199 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017-2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+// test setup
+#include "AqlTestSetup.h"
+
+#include "Aql/ExecutionPlan.h"
+#include "Aql/Query.h"
+#include "Basics/VelocyPackHelper.h"
+#include "RestServer/QueryRegistryFeature.h"
+#include "RocksDBEngine/RocksDBOptimizerRules.h"
+#include "Transaction/Methods.h"
+#include "Transaction/StandaloneContext.h"
+#include "Utils/SingleCollectionTransaction.h"
+#include "VocBase/LogicalCollection.h"
+
+extern const char* ARGV0;  // defined in main.cpp
+
+namespace {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 setup / tear-down
+// -----------------------------------------------------------------------------
+
+struct ProjectionFilterSetup : arangodb::tests::aql::AqlTestSetup<> {
+  ProjectionFilterSetup() {
+    // the mock engine does not register any rules of its own, but the
+    // rules under test are the ones of the RocksDB engine
+    arangodb::RocksDBOptimizerRules::registerResources();
+  }
+};
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+TEST_CASE("ProjectionFilter", "[aql][projection-filter]") {
+  ProjectionFilterSetup s;
+  (void)(s);
+
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1,
+                        "testVocbase");
+
+  auto nodeTypes = [](TRI_vocbase_t& vocbase, std::string const& queryString,
+                      std::string rules = "") -> std::vector<std::string> {
+    auto options = arangodb::velocypack::Parser::fromJson(
+        "{\"optimizer\": {\"rules\": [" + rules + "]}}");
+    arangodb::aql::Query query(false, vocbase, arangodb::aql::QueryString(queryString),
+                               nullptr, options, arangodb::aql::PART_MAIN);
+
+    auto result = query.explain();
+    VPackSlice nodes = result.data->slice().get("nodes");
+    CHECK(nodes.isArray());
+
+    std::vector<std::string> types;
+    for (auto const& it : VPackArrayIterator(nodes)) {
+      types.emplace_back(it.get("type").copyString());
+    }
+    return types;
+  };
+
+  auto executeQuery = [](TRI_vocbase_t& vocbase, std::string const& queryString,
+                         std::string rules = "") -> std::shared_ptr<VPackBuilder> {
+    auto options = arangodb::velocypack::Parser::fromJson(
+        "{\"optimizer\": {\"rules\": [" + rules + "]}}");
+    arangodb::aql::Query query(false, vocbase, arangodb::aql::QueryString(queryString),
+                               nullptr, options, arangodb::aql::PART_MAIN);
+    std::shared_ptr<arangodb::aql::SharedQueryState> ss = query.sharedState();
+    arangodb::aql::QueryResult result;
+
+    while (true) {
+      auto state = query.execute(arangodb::QueryRegistryFeature::registry(), result);
+      if (state == arangodb::aql::ExecutionState::WAITING) {
+        ss->waitForAsyncResponse();
+      } else {
+        break;
+      }
+    }
+
+    REQUIRE(result.result.ok());
+    REQUIRE(result.data->slice().isArray());
+    return result.data;
+  };
+
+  auto contains = [](std::vector<std::string> const& types, std::string const& type) {
+    return std::find(types.begin(), types.end(), type) != types.end();
+  };
+
+  // create the collection with a primary index covering _key
+  {
+    auto createJson = arangodb::velocypack::Parser::fromJson(
+        "{ \"name\": \"testCollection0\" }");
+    auto collection = vocbase.createCollection(createJson->slice());
+    REQUIRE((nullptr != collection));
+
+    arangodb::OperationOptions options;
+    arangodb::SingleCollectionTransaction trx(arangodb::transaction::StandaloneContext::Create(vocbase),
+                                              *collection,
+                                              arangodb::AccessMode::Type::WRITE);
+    CHECK((trx.begin().ok()));
+
+    for (size_t i = 0; i < 30; i++) {
+      auto doc = arangodb::velocypack::Parser::fromJson(
+          "{ \"_key\": \"test" + std::to_string(i) +
+          "\", \"a\": " + std::to_string(i % 3) + " }");
+      auto res = trx.insert(collection->name(), doc->slice(), options);
+      CHECK((res.ok()));
+    }
+
+    CHECK((trx.commit().ok()));
+
+    bool created = false;
+    auto indexJson = arangodb::velocypack::Parser::fromJson(
+        "{ \"type\": \"primary\", \"fields\": [\"_key\"] }");
+    auto index = collection->getPhysical()->createIndex(indexJson->slice(), false, created);
+    REQUIRE((nullptr != index));
+    CHECK(created);
+  }
+
+  // a projection on a scan with a filter pushed into it must keep the filter
+  {
+    std::string const query =
+        "FOR d IN testCollection0 FILTER d.a == 1 RETURN d._key";
+
+    auto types = nodeTypes(vocbase, query);
+    CHECK(contains(types, "EnumerateCollectionNode"));
+    CHECK(!contains(types, "IndexNode"));
+    CHECK(!contains(types, "FilterNode"));
+
+    // the filter is evaluated by the FilterNode without the pushdown
+    auto expected = executeQuery(vocbase, query,
+                                 "\"-push-filters-into-enumerate-collection\"");
+    auto actual = executeQuery(vocbase, query);
+    CHECK(expected->slice().length() == 10);
+    CHECK(actual->slice().length() == 10);
+
+    std::set<std::string> expectedKeys;
+    for (auto const& it : VPackArrayIterator(expected->slice())) {
+      expectedKeys.emplace(it.copyString());
+    }
+    std::set<std::string> actualKeys;
+    for (auto const& it : VPackArrayIterator(actual->slice())) {
+      actualKeys.emplace(it.copyString());
+    }
+    CHECK(expectedKeys == actualKeys);
+  }
+
+  // without the filter the scan is still turned into an index scan
+  {
+    std::string const query = "FOR d IN testCollection0 RETURN d._key";
+
+    auto types = nodeTypes(vocbase, query);
+    CHECK(contains(types, "IndexNode"));
+    CHECK(executeQuery(vocbase, query)->slice().length() == 30);
+  }
+
+  // counting documents with a filter pushed into the scan
+  {
+    std::string const query =
+        "FOR d IN testCollection0 FILTER d.a == 1 COLLECT WITH COUNT INTO n RETURN n";
+
+    auto types = nodeTypes(vocbase, query);
+    CHECK(contains(types, "EnumerateCollectionNode"));
+    CHECK(!contains(types, "IndexNode"));
+
+    auto expected = executeQuery(vocbase, query,
+                                 "\"-push-filters-into-enumerate-collection\"");
+    auto actual = executeQuery(vocbase, query);
+    REQUIRE(expected->slice().length() == 1);
+    REQUIRE(actual->slice().length() == 1);
+    CHECK(expected->slice().at(0).getNumber<uint64_t>() == 10);
+    CHECK(actual->slice().at(0).getNumber<uint64_t>() == 10);
+  }
+}
@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "catch.hpp"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include "Aql/QueryCache.h"
+#include "Aql/QueryString.h"
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+
+std::shared_ptr<QueryCacheResultEntry> makeEntry(
+    uint64_t hash, std::string const& query, std::unordered_map<std::string, std::string>&& dataSources) {
+  auto result = VPackParser::fromJson("[1, 2, 3]");
+  return std::make_shared<QueryCacheResultEntry>(hash, QueryString(query), result,
+                                                 nullptr, std::move(dataSources));
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+TEST_CASE("QueryCache", "[aql][query-cache]") {
+  QueryCacheDatabaseEntry cache;
+
+  // depends on the whole collection
+  auto whole = makeEntry(1, "FOR d IN c RETURN d", {{"guid-c", "c"}});
+  // depends on two keys
+  auto keys = makeEntry(2, "FOR d IN c FILTER d._key IN ['a', 'b'] RETURN d",
+                        {{"guid-c", "c"}});
+  keys->_keyDependencies["guid-c"] = {QueryCache::hashKey(velocypack::StringRef("a")),
+                                      QueryCache::hashKey(velocypack::StringRef("b"))};
+  // key lookup in c and a scan of another collection
+  auto other = makeEntry(3, "FOR d IN c FILTER d._key == 'a' FOR e IN e RETURN e",
+                         {{"guid-c", "c"}, {"guid-e", "e"}});
+  other->_keyDependencies["guid-c"] = {QueryCache::hashKey(velocypack::StringRef("a"))};
+
+  cache.store(std::move(whole), 100, 1024 * 1024);
+  cache.store(std::move(keys), 100, 1024 * 1024);
+  cache.store(std::move(other), 100, 1024 * 1024);
+  REQUIRE(cache._entriesByHash.size() == 3);
+
+  SECTION("modifying another key only invalidates whole-collection entries") {
+    cache.invalidate("guid-c", {QueryCache::hashKey(velocypack::StringRef("z"))});
+    CHECK(cache._entriesByHash.size() == 2);
+    CHECK(cache._entriesByHash.find(1) == cache._entriesByHash.end());
+    CHECK(cache._entriesByHash.find(2) != cache._entriesByHash.end());
+    CHECK(cache._entriesByHash.find(3) != cache._entriesByHash.end());
+  }
+
+  SECTION("modifying a read key invalidates the depending entries") {
+    cache.invalidate("guid-c", {QueryCache::hashKey(velocypack::StringRef("b"))});
+    CHECK(cache._entriesByHash.size() == 1);
+    CHECK(cache._entriesByHash.find(3) != cache._entriesByHash.end());
+
+    cache.invalidate("guid-c", {QueryCache::hashKey(velocypack::StringRef("a"))});
+    CHECK(cache._entriesByHash.empty());
+    // the entry was also removed from the other data source
+    CHECK(cache._entriesByDataSourceGuid["guid-e"].second.empty());
+  }
+
+  SECTION("key-level dependencies are per data source") {
+    cache.invalidate("guid-e", {QueryCache::hashKey(velocypack::StringRef("z"))});
+    CHECK(cache._entriesByHash.size() == 2);
+    CHECK(cache._entriesByHash.find(3) == cache._entriesByHash.end());
+  }
+
+  SECTION("invalidating without keys removes all entries of the data source") {
+    cache.invalidate(std::string("guid-c"));
+    CHECK(cache._entriesByHash.empty());
+  }
+}
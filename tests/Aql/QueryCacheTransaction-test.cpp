@@ -0,0 +1,161 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include "AqlTestSetup.h"
+
+#include "Aql/Query.h"
+#include "Aql/QueryCache.h"
+#include "RestServer/QueryRegistryFeature.h"
+#include "StorageEngine/TransactionState.h"
+#include "Transaction/Methods.h"
+#include "Transaction/SmartContext.h"
+#include "Transaction/StandaloneContext.h"
+#include "Utils/SingleCollectionTransaction.h"
+#include "VocBase/LogicalCollection.h"
+
+namespace {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 setup / tear-down
+// -----------------------------------------------------------------------------
+
+struct QueryCacheTransactionSetup : arangodb::tests::aql::AqlTestSetup<> {
+  arangodb::aql::QueryCacheProperties oldProperties;
+
+  QueryCacheTransactionSetup() {
+    // turn the query cache on for all queries
+    oldProperties = arangodb::aql::QueryCache::instance()->properties();
+    auto properties = oldProperties;
+    properties.mode = arangodb::aql::CACHE_ALWAYS_ON;
+    arangodb::aql::QueryCache::instance()->properties(properties);
+  }
+
+  ~QueryCacheTransactionSetup() {
+    arangodb::aql::QueryCache::instance()->invalidate();
+    arangodb::aql::QueryCache::instance()->properties(oldProperties);
+  }
+};
+
+std::string const queryString = "FOR d IN testCollection SORT d.value RETURN d.value";
+
+/// @brief runs the query, optionally inside the given transaction context,
+/// and returns the number of results
+size_t runQuery(TRI_vocbase_t& vocbase,
+                std::shared_ptr<arangodb::transaction::Context> const& ctx) {
+  auto options = arangodb::velocypack::Parser::fromJson("{}");
+  arangodb::aql::Query query(false, vocbase, arangodb::aql::QueryString(queryString),
+                             nullptr, options, arangodb::aql::PART_MAIN);
+  if (ctx != nullptr) {
+    query.setTransactionContext(ctx);
+  }
+  std::shared_ptr<arangodb::aql::SharedQueryState> ss = query.sharedState();
+  arangodb::aql::QueryResult result;
+
+  while (true) {
+    auto state = query.execute(arangodb::QueryRegistryFeature::registry(), result);
+    if (state == arangodb::aql::ExecutionState::WAITING) {
+      ss->waitForAsyncResponse();
+    } else {
+      break;
+    }
+  }
+
+  REQUIRE(result.result.ok());
+  REQUIRE(result.data->slice().isArray());
+  return result.data->slice().length();
+}
+
+/// @brief whether the query cache holds a result for the query
+bool isCached(TRI_vocbase_t& vocbase) {
+  arangodb::velocypack::Builder builder;
+  arangodb::aql::QueryCache::instance()->queriesToVelocyPack(&vocbase, builder);
+  REQUIRE(builder.slice().isArray());
+  return 0 != builder.slice().length();
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+TEST_CASE("QueryCacheTransaction", "[aql][query-cache]") {
+  QueryCacheTransactionSetup s;
+  (void)(s);
+
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1,
+                        "testVocbase");
+  auto createJson = arangodb::velocypack::Parser::fromJson(
+      "{ \"name\": \"testCollection\" }");
+  auto collection = vocbase.createCollection(createJson->slice());
+  REQUIRE((nullptr != collection));
+
+  {
+    auto doc = arangodb::velocypack::Parser::fromJson("{ \"value\": 1 }");
+    arangodb::OperationOptions options;
+    arangodb::SingleCollectionTransaction trx(arangodb::transaction::StandaloneContext::Create(vocbase),
+                                              *collection,
+                                              arangodb::AccessMode::Type::WRITE);
+    REQUIRE((trx.begin().ok()));
+    REQUIRE((trx.insert(collection->name(), doc->slice(), options).ok()));
+    REQUIRE((trx.commit().ok()));
+  }
+
+  SECTION("results outside of transactions are cached") {
+    CHECK((!isCached(vocbase)));
+    CHECK((1 == runQuery(vocbase, nullptr)));
+    CHECK((isCached(vocbase)));
+  }
+
+  SECTION("no cache lookup or store inside a transaction with modifications") {
+    // populate the cache with the committed state
+    CHECK((1 == runQuery(vocbase, nullptr)));
+    CHECK((isCached(vocbase)));
+
+    auto ctx = std::make_shared<arangodb::transaction::StandaloneSmartContext>(vocbase);
+    auto doc = arangodb::velocypack::Parser::fromJson("{ \"value\": 2 }");
+    arangodb::OperationOptions options;
+    arangodb::SingleCollectionTransaction trx(ctx, *collection,
+                                              arangodb::AccessMode::Type::WRITE);
+    REQUIRE((trx.begin().ok()));
+
+    // reads before the first modification may still use the cache
+    CHECK((!trx.state()->hasModifications()));
+    CHECK((1 == runQuery(vocbase, ctx)));
+
+    REQUIRE((trx.insert(collection->name(), doc->slice(), options).ok()));
+    CHECK((trx.state()->hasModifications()));
+
+    // the cached result lacks the uncommitted document
+    CHECK((2 == runQuery(vocbase, ctx)));
+
+    // a result containing uncommitted data must not be stored
+    arangodb::aql::QueryCache::instance()->invalidate(&vocbase);
+    CHECK((2 == runQuery(vocbase, ctx)));
+    CHECK((!isCached(vocbase)));
+
+    CHECK((trx.abort().ok()));
+  }
+}
@@ -0,0 +1,233 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+// test setup
+#include "AqlTestSetup.h"
+#include "Mocks/StorageEngineMock.h"
+
+#include "Aql/Query.h"
+#include "Aql/QueryList.h"
+#include "Aql/QueryRegistry.h"
+#include "Aql/QueryResourceUsage.h"
+#include "Aql/SharedQueryState.h"
+#include "Logger/LogTopic.h"
+#include "Logger/Logger.h"
+#include "RestServer/QueryRegistryFeature.h"
+#include "Transaction/Methods.h"
+
+namespace {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 setup / tear-down
+// -----------------------------------------------------------------------------
+
+/// @brief reports the same, settable read counters for every thread
+class IOCountingEngineMock final : public StorageEngineMock {
+ public:
+  explicit IOCountingEngineMock(arangodb::application_features::ApplicationServer& server)
+      : StorageEngineMock(server), bytesRead(0), blockCacheHits(0) {}
+
+  void threadIOCounters(uint64_t& bytesRead, uint64_t& blockCacheHits) const override {
+    bytesRead = this->bytesRead;
+    blockCacheHits = this->blockCacheHits;
+  }
+
+  uint64_t bytesRead;
+  uint64_t blockCacheHits;
+};
+
+struct QueryResourceUsageSetup : arangodb::tests::aql::AqlTestSetup<IOCountingEngineMock> {
+  QueryResourceUsageSetup() {
+    arangodb::LogTopic::setLogLevel(arangodb::Logger::QUERIES.name(), arangodb::LogLevel::ERR);  // suppress WARNING slow query
+  }
+
+  ~QueryResourceUsageSetup() {
+    arangodb::LogTopic::setLogLevel(arangodb::Logger::QUERIES.name(),
+                                    arangodb::LogLevel::DEFAULT);
+  }
+};
+
+/// @brief runs the query to completion
+void executeQuery(TRI_vocbase_t& vocbase, std::string const& queryString) {
+  arangodb::aql::Query query(false, vocbase, arangodb::aql::QueryString(queryString),
+                             nullptr, arangodb::velocypack::Parser::fromJson("{}"),
+                             arangodb::aql::PART_MAIN);
+  std::shared_ptr<arangodb::aql::SharedQueryState> ss = query.sharedState();
+  arangodb::aql::QueryResult result;
+
+  while (true) {
+    auto state = query.execute(arangodb::QueryRegistryFeature::registry(), result);
+    if (state == arangodb::aql::ExecutionState::WAITING) {
+      ss->waitForAsyncResponse();
+    } else {
+      break;
+    }
+  }
+
+  REQUIRE((result.result.ok()));
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+TEST_CASE("QueryResourceUsage", "[aql][resources]") {
+  QueryResourceUsageSetup s;
+  (void)(s);
+
+  SECTION("values are summed up, keeping the highest peak memory usage") {
+    arangodb::aql::QueryResourceValues values;
+    values.cpuTime = 1.5;
+    values.bytesRead = 100;
+    values.blockCacheHits = 3;
+    values.networkBytes = 10;
+    values.peakMemoryUsage = 4096;
+
+    arangodb::aql::QueryResourceValues other;
+    other.cpuTime = 0.5;
+    other.bytesRead = 50;
+    other.blockCacheHits = 2;
+    other.networkBytes = 5;
+    other.peakMemoryUsage = 1024;
+
+    values.add(other);
+    CHECK((2.0 == values.cpuTime));
+    CHECK((150 == values.bytesRead));
+    CHECK((5 == values.blockCacheHits));
+    CHECK((15 == values.networkBytes));
+    CHECK((4096 == values.peakMemoryUsage));
+
+    VPackBuilder builder;
+    builder.openObject();
+    values.toVelocyPack(builder);
+    builder.close();
+    VPackSlice slice = builder.slice();
+    CHECK((2.0 == slice.get("cpuTime").getNumber<double>()));
+    CHECK((4096 == slice.get("peakMemoryUsage").getNumber<size_t>()));
+    CHECK((150 == slice.get("bytesRead").getNumber<uint64_t>()));
+    CHECK((5 == slice.get("blockCacheHits").getNumber<uint64_t>()));
+    CHECK((15 == slice.get("networkBytes").getNumber<uint64_t>()));
+  }
+
+  SECTION("a scope accounts the reads of the thread") {
+    arangodb::aql::QueryResourceUsage usage;
+    s.engine.bytesRead = 1000;
+    s.engine.blockCacheHits = 10;
+    {
+      arangodb::aql::QueryResourceScope scope(usage);
+      s.engine.bytesRead += 250;
+      s.engine.blockCacheHits += 4;
+    }
+    // reads outside of a scope are not accounted
+    s.engine.bytesRead += 1000;
+
+    auto values = usage.values(123);
+    CHECK((250 == values.bytesRead));
+    CHECK((4 == values.blockCacheHits));
+    CHECK((123 == values.peakMemoryUsage));
+  }
+
+  SECTION("nested scopes for the same query account the reads once") {
+    arangodb::aql::QueryResourceUsage usage;
+    arangodb::aql::QueryResourceUsage other;
+    {
+      arangodb::aql::QueryResourceScope scope(usage);
+      s.engine.bytesRead += 100;
+      {
+        arangodb::aql::QueryResourceScope nested(usage);
+        s.engine.bytesRead += 10;
+      }
+      {
+        // work for another query is accounted to both
+        arangodb::aql::QueryResourceScope nested(other);
+        s.engine.bytesRead += 1;
+      }
+    }
+
+    CHECK((111 == usage.values(0).bytesRead));
+    CHECK((1 == other.values(0).bytesRead));
+  }
+
+  SECTION("network bytes are added up") {
+    arangodb::aql::QueryResourceUsage usage;
+    usage.addNetworkBytes(100);
+    usage.addNetworkBytes(28);
+    CHECK((128 == usage.values(0).networkBytes));
+  }
+
+#ifndef _WIN32
+  SECTION("a scope accounts the CPU time of the thread") {
+    arangodb::aql::QueryResourceUsage usage;
+    {
+      arangodb::aql::QueryResourceScope scope(usage);
+      uint64_t const start = arangodb::aql::QueryResourceScope::threadCpuTime();
+      while (arangodb::aql::QueryResourceScope::threadCpuTime() < start + 1000000) {
+        // burn at least a millisecond
+      }
+    }
+    CHECK((0.001 <= usage.values(0).cpuTime));
+  }
+#endif
+
+  SECTION("finished queries are summed up per user") {
+    TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1,
+                          "testVocbase");
+    REQUIRE((nullptr != vocbase.queryList()));
+    CHECK((vocbase.queryList()->listUsage().empty()));
+
+    executeQuery(vocbase, "FOR i IN 1..1000 RETURN i");
+    executeQuery(vocbase, "RETURN 1");
+
+    // without authentication there is no user
+    auto usage = vocbase.queryList()->listUsage();
+    REQUIRE((1 == usage.size()));
+    CHECK((usage[0].first.empty()));
+    CHECK((2 == usage[0].second.queries));
+    CHECK((0 < usage[0].second.resources.peakMemoryUsage));
+  }
+
+  SECTION("slow queries keep their resources") {
+    TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1,
+                          "testVocbase");
+    auto* queryList = vocbase.queryList();
+    REQUIRE((nullptr != queryList));
+    queryList->slowQueryThreshold(0.0);
+
+    executeQuery(vocbase, "FOR i IN 1..1000 RETURN i");
+
+    auto slow = queryList->listSlow();
+    REQUIRE((1 == slow.size()));
+    CHECK((slow[0].user.empty()));
+    CHECK((0 < slow[0].resources.peakMemoryUsage));
+    CHECK((0.0 <= slow[0].resources.cpuTime));
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
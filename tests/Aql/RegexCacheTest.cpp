@@ -0,0 +1,152 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "catch.hpp"
+
+#include "Aql/RegexCache.h"
+
+#include <string>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace arangodb {
+namespace tests {
+namespace aql {
+
+static bool likeMatches(std::string const& pattern, std::string const& value,
+                        bool expectHandled = true) {
+  bool handled = false;
+  bool result = RegexCache::matchesLikePattern(pattern.data(), pattern.size(),
+                                               value.data(), value.size(), handled);
+  REQUIRE(handled == expectHandled);
+  return result;
+}
+
+static std::string regexPrefix(std::string const& pattern) {
+  std::string prefix;
+  if (!RegexCache::inspectRegexPrefix(prefix, pattern.data(), pattern.size())) {
+    REQUIRE(prefix.empty());
+    return "<none>";
+  }
+  return prefix;
+}
+
+SCENARIO("Matching LIKE patterns without ICU", "[AQL][LIKE]") {
+  WHEN("the pattern has no wildcards") {
+    REQUIRE(likeMatches("abc", "abc"));
+    REQUIRE_FALSE(likeMatches("abc", "abcd"));
+    REQUIRE_FALSE(likeMatches("abc", "ab"));
+    REQUIRE(likeMatches("", ""));
+    REQUIRE_FALSE(likeMatches("", "a"));
+  }
+
+  WHEN("the pattern has % wildcards") {
+    REQUIRE(likeMatches("abc%", "abc"));
+    REQUIRE(likeMatches("abc%", "abcdef"));
+    REQUIRE_FALSE(likeMatches("abc%", "xabc"));
+    REQUIRE(likeMatches("%abc", "xyzabc"));
+    REQUIRE(likeMatches("%b%", "abc"));
+    REQUIRE(likeMatches("a%c%e", "abcdcde"));
+    REQUIRE_FALSE(likeMatches("a%c%e", "abcdcd"));
+    REQUIRE(likeMatches("%", ""));
+    REQUIRE(likeMatches("%%", "line\nbreak"));
+  }
+
+  WHEN("the pattern has _ wildcards") {
+    REQUIRE(likeMatches("a_c", "abc"));
+    REQUIRE_FALSE(likeMatches("a_c", "ac"));
+    REQUIRE_FALSE(likeMatches("a_c", "abbc"));
+    // _ matches a single character, not a single byte
+    REQUIRE(likeMatches("a_c", "a\xc3\xa4" "c"));
+    REQUIRE(likeMatches("_%_", "\xe2\x82\xac\xe2\x82\xac"));
+    REQUIRE_FALSE(likeMatches("__", "\xe2\x82\xac"));
+  }
+
+  WHEN("the pattern has escapes") {
+    REQUIRE(likeMatches("100\\%", "100%"));
+    REQUIRE_FALSE(likeMatches("100\\%", "1000"));
+    REQUIRE(likeMatches("a\\_b", "a_b"));
+    REQUIRE_FALSE(likeMatches("a\\_b", "axb"));
+    REQUIRE(likeMatches("a\\\\b", "a\\b"));
+    REQUIRE(likeMatches("a\\.b", "a.b"));
+    // a backslash followed by no special character is taken literally
+    REQUIRE(likeMatches("a\\b", "a\\b"));
+    // regex characters have no special meaning
+    REQUIRE(likeMatches("a.*[b]", "a.*[b]"));
+    REQUIRE_FALSE(likeMatches("a.*", "abc"));
+  }
+
+  WHEN("the values contain characters that ICU treats specially") {
+    // non-ASCII patterns and line terminators are left to ICU
+    likeMatches("\xc3\xa4%", "\xc3\xa4", false);
+    likeMatches("a%", "a\x0b", false);
+    likeMatches("a_", "a\x0c", false);
+    likeMatches("a%", "a\xc2\x85", false);
+    likeMatches("a%", "a\xe2\x80\xa8", false);
+    likeMatches("%a", "\xe2\x80\xa9" "a", false);
+    // the wildcards match \r and \n
+    REQUIRE(likeMatches("a%", "a\r\n"));
+    REQUIRE(likeMatches("a__", "a\r\n"));
+    REQUIRE_FALSE(likeMatches("a_", "a\r\n"));
+    // without wildcards the match is exact anyway
+    REQUIRE(likeMatches("a", "a"));
+    REQUIRE_FALSE(likeMatches("a", "a\x0b"));
+  }
+
+  WHEN("the value ends with a line terminator") {
+    // the end of the pattern only matches at the end of the value, unlike
+    // a "$" in a partial regex match
+    REQUIRE_FALSE(likeMatches("abc", "abc\n"));
+    REQUIRE_FALSE(likeMatches("%abc", "xabc\n"));
+    REQUIRE_FALSE(likeMatches("a_c", "abc\r\n"));
+    REQUIRE(likeMatches("abc\n", "abc\n"));
+    REQUIRE(likeMatches("abc%", "abc\n"));
+  }
+}
+
+SCENARIO("Extracting the prefix of anchored regexes", "[AQL][REGEX]") {
+  REQUIRE(regexPrefix("^abc") == "abc");
+  REQUIRE(regexPrefix("^abc.*") == "abc");
+  REQUIRE(regexPrefix("^abc+") == "abc");
+  REQUIRE(regexPrefix("^abc*") == "ab");
+  REQUIRE(regexPrefix("^abc?d") == "ab");
+  REQUIRE(regexPrefix("^abc{2}") == "ab");
+  REQUIRE(regexPrefix("^ab[cd]") == "ab");
+  REQUIRE(regexPrefix("^ab\\d") == "ab");
+  REQUIRE(regexPrefix("abc") == "<none>");
+  REQUIRE(regexPrefix("^") == "<none>");
+  REQUIRE(regexPrefix("^a*") == "<none>");
+  REQUIRE(regexPrefix("^(?i)abc") == "<none>");
+  REQUIRE(regexPrefix("^abc|^xyz") == "<none>");
+  // the prefix ends at anchors and line terminators
+  REQUIRE(regexPrefix("^abc$") == "abc");
+  REQUIRE(regexPrefix("^ab^c") == "ab");
+  REQUIRE(regexPrefix("^ab\ncd") == "ab");
+  REQUIRE(regexPrefix("^ab\x0b" "cd") == "ab");
+  REQUIRE(regexPrefix("^ab\xe2\x80\xa8" "cd") == "ab");
+  REQUIRE(regexPrefix("^\n") == "<none>");
+  REQUIRE(regexPrefix("\\Aabc") == "<none>");
+}
+
+}  // namespace aql
+}  // namespace tests
+}  // namespace arangodb
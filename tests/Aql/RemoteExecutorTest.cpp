@@ -0,0 +1,310 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "AqlItemBlockHelper.h"
+#include "catch.hpp"
+
+#include "../IResearch/ClusterCommMock.h"
+#include "../Mocks/StorageEngineMock.h"
+
+#include "Aql/AqlFunctionFeature.h"
+#include "Aql/AqlItemBlock.h"
+#include "Aql/ClusterNodes.h"
+#include "Aql/ExecutionEngine.h"
+#include "Aql/ExecutorInfos.h"
+#include "Aql/InputAqlItemRow.h"
+#include "Aql/OptimizerRulesFeature.h"
+#include "Aql/Query.h"
+#include "Aql/QueryRegistry.h"
+#include "Aql/RemoteExecutor.h"
+#include "GeneralServer/AuthenticationFeature.h"
+#include "RestServer/AqlFeature.h"
+#include "RestServer/DatabaseFeature.h"
+#include "RestServer/QueryRegistryFeature.h"
+#include "RestServer/TraverserEngineRegistryFeature.h"
+#include "SimpleHttpClient/SimpleHttpResult.h"
+#include "StorageEngine/EngineSelectorFeature.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace arangodb {
+namespace tests {
+namespace aql {
+
+namespace {
+
+/// @brief keeps all requests in flight until the test answers them
+class DeferredClusterCommMock final : public ClusterCommMock {
+ public:
+  OperationID asyncRequest(CoordTransactionID const coordTransactionID,
+                           std::string const& destination, rest::RequestType reqtype,
+                           std::string const& path, std::shared_ptr<std::string const> body,
+                           std::unordered_map<std::string, std::string> const& headerFields,
+                           std::shared_ptr<ClusterCommCallback> const& callback,
+                           ClusterCommTimeout, bool singleRequest, ClusterCommTimeout) override {
+    _requests.emplace_back(coordTransactionID, destination, reqtype, path, body,
+                           headerFields, callback, singleRequest);
+    // operation ids start with 1, 0 means no request
+    return _requests.size();
+  }
+
+  void drop(CoordTransactionID const, OperationID const, ShardID const&) override {}
+
+  /// @brief delivers the answer to the request with the given index
+  void answer(size_t index, std::string const& body) {
+    REQUIRE((index < _requests.size()));
+    ClusterCommResult result;
+    result.operationID = index + 1;
+    result.status = CL_COMM_SENT;
+    result.result = std::make_shared<httpclient::SimpleHttpResult>();
+    result.result->getBody().appendText(body);
+    (*_requests[index]._callback)(&result);
+  }
+};
+
+struct RemoteExecutorSetup {
+  application_features::ApplicationServer server;
+  StorageEngineMock engine;
+  std::vector<std::pair<application_features::ApplicationFeature*, bool>> features;
+
+  RemoteExecutorSetup() : server(nullptr, nullptr), engine(server) {
+    EngineSelectorFeature::ENGINE = &engine;
+
+    // suppress INFO {authentication} Authentication is turned on (system only), authentication for unix sockets is turned on
+    LogTopic::setLogLevel(Logger::AUTHENTICATION.name(), LogLevel::ERR);
+
+    // setup required application features
+    features.emplace_back(new AuthenticationFeature(server), false);  // required for VocbaseContext
+    features.emplace_back(new DatabaseFeature(server), false);  // required for TRI_vocbase_t
+    features.emplace_back(new QueryRegistryFeature(server), false);  // required for TRI_vocbase_t
+    features.emplace_back(new TraverserEngineRegistryFeature(server), false);  // must be before AqlFeature
+    features.emplace_back(new AqlFeature(server), true);
+    features.emplace_back(new OptimizerRulesFeature(server), true);
+    features.emplace_back(new AqlFunctionFeature(server), true);
+
+    for (auto& f : features) {
+      application_features::ApplicationServer::server->addFeature(f.first);
+    }
+
+    for (auto& f : features) {
+      f.first->prepare();
+    }
+
+    for (auto& f : features) {
+      if (f.second) {
+        f.first->start();
+      }
+    }
+  }
+
+  ~RemoteExecutorSetup() {
+    AqlFeature(server).stop();  // unset singleton instance
+    application_features::ApplicationServer::server = nullptr;
+    EngineSelectorFeature::ENGINE = nullptr;
+
+    // destroy application features
+    for (auto& f : features) {
+      if (f.second) {
+        f.first->stop();
+      }
+    }
+
+    for (auto& f : features) {
+      f.first->unprepare();
+    }
+
+    LogTopic::setLogLevel(Logger::AUTHENTICATION.name(), LogLevel::DEFAULT);
+  }
+};
+
+int64_t valueAt(SharedAqlItemBlockPtr const& block, size_t row) {
+  return block->getValueReference(row, 0).toInt64();
+}
+
+}  // namespace
+
+TEST_CASE("RemoteExecutor", "[aql][remote]") {
+  RemoteExecutorSetup s;
+  (void)(s);
+
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1, "testVocbase");
+
+  // the remote block needs a prepared query for its engine and transaction
+  auto query = std::make_unique<Query>(false, vocbase, QueryString("RETURN 1"), nullptr,
+                                       velocypack::Parser::fromJson("{}"), PART_MAIN);
+  query->prepare(QueryRegistryFeature::registry());
+  ExecutionEngine* engine = query->engine();
+  REQUIRE((nullptr != engine));
+  AqlItemBlockManager& itemBlockManager = engine->itemBlockManager();
+
+  DeferredClusterCommMock clusterComm;
+  auto clusterCommGuard = ClusterCommMock::setInstance(clusterComm);
+
+  RemoteNode node(query->plan(), 1000, &vocbase, "PRMR-1", "s100", "123");
+  ExecutorInfos infos(std::make_shared<std::unordered_set<RegisterId>>(),
+                      std::make_shared<std::unordered_set<RegisterId>>(), 1, 1, {}, {0});
+  ExecutionBlockImpl<RemoteExecutor> testee(engine, &node, std::move(infos), "PRMR-1",
+                                            "s100", "123");
+
+  // serializes a getSome answer. blocks after the first one are the blocks
+  // produced ahead with the credit of the request
+  auto getSomeAnswer = [&](std::vector<SharedAqlItemBlockPtr> const& blocks,
+                           bool done) -> std::string {
+    VPackBuilder builder;
+    builder.openObject();
+    builder.add("done", VPackValue(done));
+    blocks[0]->toVelocyPack(query->trx(), builder);
+    if (blocks.size() > 1) {
+      builder.add(VPackValue("next"));
+      VPackArrayBuilder nextGuard(&builder);
+      for (size_t i = 1; i < blocks.size(); ++i) {
+        VPackObjectBuilder blockGuard(&builder);
+        blocks[i]->toVelocyPack(query->trx(), builder);
+      }
+    }
+    builder.close();
+    return builder.slice().toJson();
+  };
+
+  ExecutionState state;
+  SharedAqlItemBlockPtr block;
+
+  SECTION("a getSome waits for its response without sending another request") {
+    std::tie(state, block) = testee.getSome(1000);
+    CHECK((ExecutionState::WAITING == state));
+    REQUIRE((1 == clusterComm._requests.size()));
+    CHECK(("/_db/testVocbase/_api/aql/getSome/123" == clusterComm._requests[0]._path));
+    CHECK(("s100" == clusterComm._requests[0]._headerFields["Shard-Id"]));
+
+    // e.g. woken up by the response for another shard
+    std::tie(state, block) = testee.getSome(1000);
+    CHECK((ExecutionState::WAITING == state));
+    CHECK((1 == clusterComm._requests.size()));
+
+    clusterComm.answer(0, getSomeAnswer({buildBlock<1>(itemBlockManager, {{1}, {2}})}, true));
+
+    std::tie(state, block) = testee.getSome(1000);
+    CHECK((ExecutionState::DONE == state));
+    REQUIRE((block != nullptr));
+    REQUIRE((2 == block->size()));
+    CHECK((1 == valueAt(block, 0)));
+    CHECK((2 == valueAt(block, 1)));
+    CHECK((1 == clusterComm._requests.size()));
+  }
+
+  SECTION("blocks produced ahead are returned without another request") {
+    std::tie(state, block) = testee.getSome(1000);
+    CHECK((ExecutionState::WAITING == state));
+    clusterComm.answer(0, getSomeAnswer({buildBlock<1>(itemBlockManager, {{1}, {2}}),
+                                         buildBlock<1>(itemBlockManager, {{3}}),
+                                         buildBlock<1>(itemBlockManager, {{4}, {5}})},
+                                        false));
+
+    // blocks larger than requested are split up
+    std::tie(state, block) = testee.getSome(1);
+    CHECK((ExecutionState::HASMORE == state));
+    REQUIRE((block != nullptr));
+    REQUIRE((1 == block->size()));
+    CHECK((1 == valueAt(block, 0)));
+
+    for (int64_t expected : {2, 3}) {
+      std::tie(state, block) = testee.getSome(1000);
+      CHECK((ExecutionState::HASMORE == state));
+      REQUIRE((block != nullptr));
+      REQUIRE((1 == block->size()));
+      CHECK((expected == valueAt(block, 0)));
+    }
+
+    std::tie(state, block) = testee.getSome(1000);
+    CHECK((ExecutionState::HASMORE == state));
+    REQUIRE((block != nullptr));
+    REQUIRE((2 == block->size()));
+    CHECK((4 == valueAt(block, 0)));
+    CHECK((1 == clusterComm._requests.size()));
+
+    // the remote side is not done yet, so it is asked again
+    std::tie(state, block) = testee.getSome(1000);
+    CHECK((ExecutionState::WAITING == state));
+    CHECK((2 == clusterComm._requests.size()));
+  }
+
+  SECTION("a skipSome uses the response of a getSome sent before") {
+    std::tie(state, block) = testee.getSome(1000);
+    CHECK((ExecutionState::WAITING == state));
+
+    size_t skipped;
+    std::tie(state, skipped) = testee.skipSome(2);
+    CHECK((ExecutionState::WAITING == state));
+    CHECK((0 == skipped));
+    CHECK((1 == clusterComm._requests.size()));
+
+    clusterComm.answer(0, getSomeAnswer({buildBlock<1>(itemBlockManager, {{1}, {2}, {3}})}, true));
+
+    std::tie(state, skipped) = testee.skipSome(2);
+    CHECK((ExecutionState::HASMORE == state));
+    CHECK((2 == skipped));
+
+    std::tie(state, block) = testee.getSome(1000);
+    CHECK((ExecutionState::DONE == state));
+    REQUIRE((block != nullptr));
+    REQUIRE((1 == block->size()));
+    CHECK((3 == valueAt(block, 0)));
+    CHECK((1 == clusterComm._requests.size()));
+  }
+
+  SECTION("initializeCursor discards the response of a getSome sent before") {
+    std::tie(state, block) = testee.getSome(1000);
+    CHECK((ExecutionState::WAITING == state));
+
+    InputAqlItemRow input{buildBlock<1>(itemBlockManager, {{42}}), 0};
+    Result res;
+    std::tie(state, res) = testee.initializeCursor(input);
+    CHECK((ExecutionState::WAITING == state));
+    CHECK((1 == clusterComm._requests.size()));
+
+    clusterComm.answer(0, getSomeAnswer({buildBlock<1>(itemBlockManager, {{1}})}, false));
+
+    std::tie(state, res) = testee.initializeCursor(input);
+    CHECK((ExecutionState::WAITING == state));
+    REQUIRE((2 == clusterComm._requests.size()));
+    CHECK(("/_db/testVocbase/_api/aql/initializeCursor/123" ==
+           clusterComm._requests[1]._path));
+
+    clusterComm.answer(1, "{ \"code\": 0, \"error\": false }");
+
+    std::tie(state, res) = testee.initializeCursor(input);
+    CHECK((ExecutionState::DONE == state));
+    CHECK((res.ok()));
+
+    // the rows of the discarded response are not returned
+    std::tie(state, block) = testee.getSome(1000);
+    CHECK((ExecutionState::WAITING == state));
+    CHECK((3 == clusterComm._requests.size()));
+  }
+}
+
+}  // namespace aql
+}  // namespace tests
+}  // namespace arangodb
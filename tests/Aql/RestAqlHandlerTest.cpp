@@ -28,10 +28,27 @@
 #include "catch.hpp"
 #include "fakeit.hpp"
 
+#include "../IResearch/RestHandlerMock.h"
+#include "../Mocks/StorageEngineMock.h"
+
+#include "Aql/AqlFunctionFeature.h"
+#include "Aql/OptimizerRulesFeature.h"
+#include "Aql/Query.h"
 #include "Aql/RestAqlHandler.h"
 #include "Aql/QueryRegistry.h"
 #include "Cluster/TraverserEngineRegistry.h"
 #include "Cluster/ServerState.h"
+#include "GeneralServer/AuthenticationFeature.h"
+#include "RestServer/AqlFeature.h"
+#include "RestServer/DatabaseFeature.h"
+#include "RestServer/QueryRegistryFeature.h"
+#include "RestServer/TraverserEngineRegistryFeature.h"
+#include "StorageEngine/EngineSelectorFeature.h"
+#include "VocBase/ticks.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
 
 using namespace arangodb;
 using namespace arangodb::aql;
@@ -72,6 +89,8 @@ class FakeResponse : public GeneralResponse {
     // TODO
   };
 
+  size_t bodySize() const override { return 0; }
+
   private:
     arangodb::Endpoint::TransportType const _transport;
 };
@@ -212,6 +231,145 @@ SCENARIO("Successful query setup", "[aql][restaqlhandler]") {
 }
 */
 
+struct RestAqlHandlerSetup {
+  StorageEngineMock engine;
+  arangodb::application_features::ApplicationServer server;
+  std::vector<std::pair<arangodb::application_features::ApplicationFeature*, bool>> features;
+
+  RestAqlHandlerSetup() : engine(server), server(nullptr, nullptr) {
+    arangodb::EngineSelectorFeature::ENGINE = &engine;
+
+    // suppress INFO {authentication} Authentication is turned on (system only), authentication for unix sockets is turned on
+    arangodb::LogTopic::setLogLevel(arangodb::Logger::AUTHENTICATION.name(), arangodb::LogLevel::ERR);
+
+    // setup required application features
+    features.emplace_back(new arangodb::AuthenticationFeature(server), false);  // required for VocbaseContext
+    features.emplace_back(new arangodb::DatabaseFeature(server), false);  // required for TRI_vocbase_t
+    features.emplace_back(new arangodb::QueryRegistryFeature(server), false);  // required for TRI_vocbase_t
+    features.emplace_back(new arangodb::TraverserEngineRegistryFeature(server), false);  // must be before AqlFeature
+    features.emplace_back(new arangodb::AqlFeature(server), true);
+    features.emplace_back(new arangodb::aql::OptimizerRulesFeature(server), true);
+    features.emplace_back(new arangodb::aql::AqlFunctionFeature(server), true);
+
+    for (auto& f : features) {
+      arangodb::application_features::ApplicationServer::server->addFeature(f.first);
+    }
+
+    for (auto& f : features) {
+      f.first->prepare();
+    }
+
+    for (auto& f : features) {
+      if (f.second) {
+        f.first->start();
+      }
+    }
+  }
+
+  ~RestAqlHandlerSetup() {
+    arangodb::AqlFeature(server).stop();  // unset singleton instance
+    arangodb::application_features::ApplicationServer::server = nullptr;
+    arangodb::EngineSelectorFeature::ENGINE = nullptr;
+
+    // destroy application features
+    for (auto& f : features) {
+      if (f.second) {
+        f.first->stop();
+      }
+    }
+
+    for (auto& f : features) {
+      f.first->unprepare();
+    }
+
+    arangodb::LogTopic::setLogLevel(arangodb::Logger::AUTHENTICATION.name(), arangodb::LogLevel::DEFAULT);
+  }
+};
+
+TEST_CASE("RestAqlHandlerGetSome", "[aql][restaqlhandler]") {
+  RestAqlHandlerSetup s;
+  (void)(s);
+
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1, "testVocbase");
+  std::pair<QueryRegistry*, TraverserEngineRegistry*> registries{
+      QueryRegistryFeature::registry(), TraverserEngineRegistryFeature::registry()};
+  REQUIRE((nullptr != registries.first));
+  REQUIRE((nullptr != registries.second));
+
+  // a snippet without remote dependencies, producing 10 rows
+  auto query = std::make_unique<Query>(false, vocbase, QueryString("FOR i IN 1..10 RETURN i"),
+                                       nullptr, velocypack::Parser::fromJson("{}"),
+                                       PART_MAIN);
+  query->prepare(registries.first);
+  QueryId qId = TRI_NewTickServer();
+  registries.first->insert(qId, query.get(), 600.0, true, false);
+  query.release();
+
+  // sends a getSome with the given body and returns the answer
+  auto getSome = [&](std::string const& body) -> VPackBuilder {
+    auto requestPtr = std::make_unique<GeneralRequestMock>(vocbase);
+    auto responsePtr = std::make_unique<GeneralResponseMock>();
+    auto* response = responsePtr.get();
+    requestPtr->setRequestType(rest::RequestType::PUT);
+    requestPtr->addSuffix("getSome");
+    requestPtr->addSuffix(std::to_string(qId));
+    requestPtr->_payload = *velocypack::Parser::fromJson(body);
+    auto handler = std::make_shared<RestAqlHandler>(requestPtr.release(),
+                                                    responsePtr.release(), &registries);
+    CHECK((RestStatus::DONE == handler->execute()));
+    CHECK((rest::ResponseCode::OK == response->responseCode()));
+    return response->_payload;
+  };
+
+  // sums up the rows of the first block and of all blocks produced ahead
+  auto countRows = [](VPackSlice answer) -> size_t {
+    size_t rows = 0;
+    if (answer.get("nrItems").isNumber()) {
+      rows += answer.get("nrItems").getNumber<size_t>();
+    }
+    VPackSlice next = answer.get("next");
+    if (next.isArray()) {
+      for (auto block : VPackArrayIterator(next)) {
+        rows += block.get("nrItems").getNumber<size_t>();
+      }
+    }
+    return rows;
+  };
+
+  SECTION("without credit only a single block is returned") {
+    auto answer = getSome("{ \"atMost\": 2 }");
+    auto slice = answer.slice();
+    REQUIRE((slice.isObject()));
+    CHECK((slice.get("next").isNone()));
+    CHECK((false == slice.get("done").getBoolean()));
+    CHECK((2 == countRows(slice)));
+  }
+
+  SECTION("the credit is used to produce blocks ahead") {
+    auto answer = getSome("{ \"atMost\": 2, \"credit\": 3 }");
+    auto slice = answer.slice();
+    REQUIRE((slice.isObject()));
+    REQUIRE((slice.get("next").isArray()));
+    CHECK((2 == slice.get("next").length()));
+    CHECK((false == slice.get("done").getBoolean()));
+    CHECK((6 == countRows(slice)));
+
+    // the next call continues after the blocks produced ahead
+    answer = getSome("{ \"atMost\": 2 }");
+    CHECK((2 == countRows(answer.slice())));
+  }
+
+  SECTION("producing ahead stops when the snippet is done") {
+    auto answer = getSome("{ \"atMost\": 2, \"credit\": 100 }");
+    auto slice = answer.slice();
+    REQUIRE((slice.isObject()));
+    CHECK((true == slice.get("done").getBoolean()));
+    CHECK((10 == countRows(slice)));
+  }
+
+  registries.first->destroy(vocbase.name(), qId, TRI_ERROR_NO_ERROR, false);
+}
+
 SCENARIO("Error in query setup", "[aql][restaqlhandler]") {
 GIVEN("A single query snippet") {
 }
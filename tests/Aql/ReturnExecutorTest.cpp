@@ -214,6 +214,47 @@ SCENARIO("ReturnExecutor", "[AQL][EXECUTOR][RETURN]") {
 
 }  // SCENARIO
 
+SCENARIO("ReturnExecutor in a batched subquery", "[AQL][EXECUTOR][RETURN]") {
+  ExecutionState state;
+
+  ResourceMonitor monitor;
+  AqlItemBlockManager itemBlockManager(&monitor);
+  SharedAqlItemBlockPtr block{new AqlItemBlock(itemBlockManager, 1000, 2)};
+  auto registersToKeep = make_shared_unordered_set();
+
+  // the value is in register 0, the row id in register 1
+  ReturnExecutorInfos infos(0 /*input*/, 2 /*nr in*/, 2 /*nr out*/, false /*do count*/,
+                            false /*return inherit*/, 1 /*row id*/);
+  auto& outputRegisters = infos.getOutputRegisters();
+
+  GIVEN("there are rows in the upstream") {
+    auto input = VPackParser::fromJson("[ [\"a\", 0], [\"b\", 0], [\"c\", 1] ]");
+    SingleRowFetcherHelper<false> fetcher(input->buffer(), false);
+    ReturnExecutor<false> testee(fetcher, infos);
+    CountStats stats{};
+
+    THEN("the executor should return the values with their row ids") {
+      OutputAqlItemRow row(std::move(block), outputRegisters, registersToKeep,
+                           infos.registersToClear());
+
+      for (size_t i = 0; i < 3; ++i) {
+        std::tie(state, stats) = testee.produceRows(row);
+        REQUIRE(state == (i < 2 ? ExecutionState::HASMORE : ExecutionState::DONE));
+        REQUIRE(row.produced());
+        row.advanceRow();
+      }
+
+      auto result = row.stealBlock();
+      for (std::size_t index = 0; index < 3; index++) {
+        AqlValue value = result->getValue(index, 0);
+        REQUIRE(value.slice().isEqualString(input->slice().at(index).at(0).copyString()));
+        AqlValue rowId = result->getValue(index, ReturnExecutorInfos::rowIdOutputRegisterId());
+        REQUIRE(rowId.toInt64() == input->slice().at(index).at(1).getInt());
+      }
+    }
+  }
+}
+
 }  // namespace aql
 }  // namespace tests
 }  // namespace arangodb
@@ -225,6 +225,28 @@ std::pair<ExecutionState, AqlItemMatrix const*> AllRowsFetcherHelper::fetchAllRo
   return {ExecutionState::DONE, _matrix.get()};
 };
 
+std::pair<ExecutionState, SharedAqlItemBlockPtr> AllRowsFetcherHelper::fetchBlockForSpilling() {
+  // If this REQUIRE fails, a the Executor has fetched more blocks after DONE.
+  REQUIRE(!_returnedDone);
+  if (_returnsWaiting && !_waited) {
+    _waited = true;
+    return {ExecutionState::WAITING, nullptr};
+  }
+  _waited = false;
+  if (_nrBlocksReturned >= _nrItems) {
+    _returnedDone = true;
+    return {ExecutionState::DONE, nullptr};
+  }
+  SharedAqlItemBlockPtr block =
+      _matrix->getBlock(0)->slice(_nrBlocksReturned, _nrBlocksReturned + 1);
+  _nrBlocksReturned++;
+  if (_nrBlocksReturned == _nrItems) {
+    _returnedDone = true;
+    return {ExecutionState::DONE, std::move(block)};
+  }
+  return {ExecutionState::HASMORE, std::move(block)};
+}
+
 // -----------------------------------------
 // - SECTION CONSTFETCHER              -
 // -----------------------------------------
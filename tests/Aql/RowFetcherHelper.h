@@ -99,6 +99,10 @@ class AllRowsFetcherHelper : public ::arangodb::aql::AllRowsFetcher {
 
   std::pair<::arangodb::aql::ExecutionState, ::arangodb::aql::AqlItemMatrix const*> fetchAllRows() override;
 
+  // returns one single-row block per call, waiting before each block if
+  // returnsWaiting is set
+  std::pair<::arangodb::aql::ExecutionState, ::arangodb::aql::SharedAqlItemBlockPtr> fetchBlockForSpilling() override;
+
  private:
   std::shared_ptr<arangodb::velocypack::Buffer<uint8_t>> _vPackBuffer;
   arangodb::velocypack::Slice _data;
@@ -107,6 +111,8 @@ class AllRowsFetcherHelper : public ::arangodb::aql::AllRowsFetcher {
   uint64_t _nrItems;
   uint64_t _nrRegs;
   uint64_t _nrCalled;
+  uint64_t _nrBlocksReturned = 0;
+  bool _waited = false;
   arangodb::aql::ResourceMonitor _resourceMonitor;
   arangodb::aql::AqlItemBlockManager _itemBlockManager;
   std::unique_ptr<arangodb::aql::AqlItemMatrix> _matrix;
@@ -0,0 +1,148 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Aql/Ast.h"
+#include "Aql/Query.h"
+#include "Aql/ScanFilter.h"
+#include "Aql/Variable.h"
+
+#include <velocypack/Options.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+// required for QuerySetup
+#include "../Mocks/Servers.h"
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace arangodb {
+namespace tests {
+namespace aql {
+
+SCENARIO("ScanFilter", "[AQL][SCANFILTER]") {
+  mocks::MockAqlServer server{};
+  std::unique_ptr<arangodb::aql::Query> fakedQuery = server.createFakeQuery();
+
+  Ast ast{fakedQuery.get()};
+  Variable var{"a", 0};
+  Variable other{"b", 1};
+  ast.scopes()->start(ScopeType::AQL_SCOPE_MAIN);
+  ast.scopes()->addVariable(&var);
+  ast.scopes()->addVariable(&other);
+  AstNode* a = ast.createNodeReference("a");
+  AstNode* b = ast.createNodeReference("b");
+  ast.scopes()->endCurrent();
+
+  VPackOptions const* options = &VPackOptions::Defaults;
+  auto matches = [options](ScanFilter const& filter, char const* json) {
+    auto document = VPackParser::fromJson(json);
+    return filter.matches(document->slice());
+  };
+
+  WHEN("filtering by a conjunction of comparisons") {
+    // a.x > 1 && "foo" == a.y.z
+    AstNode* gt = ast.createNodeBinaryOperator(
+        NODE_TYPE_OPERATOR_BINARY_GT, ast.createNodeAttributeAccess(a, "x", 1),
+        ast.createNodeValueInt(1));
+    AstNode* eq = ast.createNodeBinaryOperator(
+        NODE_TYPE_OPERATOR_BINARY_EQ, ast.createNodeValueString("foo", 3),
+        ast.createNodeAttributeAccess(ast.createNodeAttributeAccess(a, "y", 1), "z", 1));
+    AstNode* node = ast.createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_AND, gt, eq);
+
+    REQUIRE(ScanFilter::supports(node, &var));
+    ScanFilter filter(node, &var, options);
+    CHECK(matches(filter, R"({"x": 2, "y": {"z": "foo"}})"));
+    CHECK(!matches(filter, R"({"x": 1, "y": {"z": "foo"}})"));
+    CHECK(!matches(filter, R"({"x": 2, "y": {"z": "bar"}})"));
+    CHECK(!matches(filter, R"({"x": 2, "y": "foo"})"));
+    // strings are greater than numbers
+    CHECK(matches(filter, R"({"x": "0", "y": {"z": "foo"}})"));
+  }
+
+  WHEN("the constant is on the left side of a range") {
+    // 3 > a.x, missing attributes are null and smaller than any number
+    AstNode* node = ast.createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_GT,
+                                                 ast.createNodeValueInt(3),
+                                                 ast.createNodeAttributeAccess(a, "x", 1));
+    ScanFilter filter(node, &var, options);
+    CHECK(matches(filter, R"({"x": 2})"));
+    CHECK(!matches(filter, R"({"x": 3})"));
+    CHECK(matches(filter, R"({"y": 4})"));
+  }
+
+  WHEN("filtering by a list of values") {
+    // a.x IN [3, 1, 2, 1]
+    AstNode* array = ast.createNodeArray();
+    for (int64_t value : {3, 1, 2, 1}) {
+      array->addMember(ast.createNodeValueInt(value));
+    }
+    AstNode* in = ast.createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_IN,
+                                               ast.createNodeAttributeAccess(a, "x", 1), array);
+    ScanFilter filter(in, &var, options);
+    CHECK(matches(filter, R"({"x": 1})"));
+    CHECK(matches(filter, R"({"x": 3})"));
+    CHECK(!matches(filter, R"({"x": 4})"));
+    CHECK(!matches(filter, R"({"x": "1"})"));
+
+    AstNode* nin = ast.createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_NIN,
+                                                ast.createNodeAttributeAccess(a, "x", 1), array);
+    ScanFilter negated(nin, &var, options);
+    CHECK(!matches(negated, R"({"x": 2})"));
+    CHECK(matches(negated, R"({})"));
+  }
+
+  WHEN("the condition is not supported") {
+    // a.x == b.x
+    AstNode* node = ast.createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_EQ,
+                                                 ast.createNodeAttributeAccess(a, "x", 1),
+                                                 ast.createNodeAttributeAccess(b, "x", 1));
+    CHECK(!ScanFilter::supports(node, &var));
+
+    // b.x == 1
+    node = ast.createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_EQ,
+                                        ast.createNodeAttributeAccess(b, "x", 1),
+                                        ast.createNodeValueInt(1));
+    CHECK(!ScanFilter::supports(node, &var));
+
+    // a.x == 1 || a.y == 1
+    node = ast.createNodeBinaryOperator(
+        NODE_TYPE_OPERATOR_BINARY_OR,
+        ast.createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_EQ,
+                                     ast.createNodeAttributeAccess(a, "x", 1),
+                                     ast.createNodeValueInt(1)),
+        ast.createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_EQ,
+                                     ast.createNodeAttributeAccess(a, "y", 1),
+                                     ast.createNodeValueInt(1)));
+    CHECK(!ScanFilter::supports(node, &var));
+
+    // a._id == "test/1"
+    node = ast.createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_EQ,
+                                        ast.createNodeAttributeAccess(a, "_id", 3),
+                                        ast.createNodeValueString("test/1", 6));
+    CHECK(!ScanFilter::supports(node, &var));
+  }
+}
+
+}  // namespace aql
+}  // namespace tests
+}  // namespace arangodb
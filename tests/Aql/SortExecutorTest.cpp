@@ -88,7 +88,8 @@ SCENARIO("SortExecutor", "[AQL][EXECUTOR]") {
 
   SortExecutorInfos infos(std::move(sortRegisters),
                           /*limit (ignored for default sort)*/ 0,
-                          itemBlockManager, 1, 1, {}, {0}, &trx, false);
+                          itemBlockManager, 1, 1, {}, {0}, &trx, false,
+                          /*spillMemoryThreshold*/ 0);
 
   GIVEN("there are no rows upstream") {
     VPackBuilder input;
@@ -215,6 +216,167 @@ SCENARIO("SortExecutor", "[AQL][EXECUTOR]") {
     }
   }
 }
+SCENARIO("SortExecutor string order", "[AQL][EXECUTOR]") {
+  ExecutionState state;
+
+  ResourceMonitor monitor;
+  AqlItemBlockManager itemBlockManager{&monitor};
+  SharedAqlItemBlockPtr block{new AqlItemBlock(itemBlockManager, 1000, 1)};
+
+  fakeit::Mock<transaction::Methods> mockTrx;
+  transaction::Methods& trx = mockTrx.get();
+
+  fakeit::Mock<transaction::Context> mockContext;
+  transaction::Context& ctxt = mockContext.get();
+
+  fakeit::When(Method(mockTrx, transactionContextPtr)).AlwaysReturn(&ctxt);
+  fakeit::When(Method(mockContext, getVPackOptions)).AlwaysReturn(&arangodb::velocypack::Options::Defaults);
+
+  Variable sortVar("mySortVar", 0);
+  std::vector<SortRegister> sortRegisters;
+  SortElement sl{&sortVar, true};
+
+  SortRegister sortReg(0, sl);
+
+  sortRegisters.emplace_back(std::move(sortReg));
+
+  SortExecutorInfos infos(std::move(sortRegisters),
+                          /*limit (ignored for default sort)*/ 0,
+                          itemBlockManager, 1, 1, {}, {0}, &trx, false,
+                          /*spillMemoryThreshold*/ 0);
+
+  GIVEN("strings that collate equal but differ in their bytes") {
+    // NFD before NFC forms of the same texts, mixed with other strings
+    auto input = VPackParser::fromJson(
+        R"([["cafe\u0301"], ["b"], ["caf\u00e9"], ["A"], ["e\u0301"], ["a"], ["\u00e9"], [1]])");
+    size_t const n = input->slice().length();
+
+    WHEN("the producer does not wait") {
+      AllRowsFetcherHelper fetcher(input->steal(), false);
+      SortExecutor testee(fetcher, infos);
+      NoStats stats{};
+
+      THEN("the rows are produced in the order of AqlValue::Compare") {
+        OutputAqlItemRow result{std::move(block), infos.getOutputRegisters(),
+                                infos.registersToKeep(), infos.registersToClear()};
+        size_t produced = 0;
+        do {
+          std::tie(state, stats) = testee.produceRows(result);
+          REQUIRE(result.produced());
+          ++produced;
+          result.advanceRow();
+        } while (state != ExecutionState::DONE);
+        REQUIRE(produced == n);
+
+        block = result.stealBlock();
+        for (size_t i = 1; i < n; ++i) {
+          CHECK(AqlValue::Compare(&trx, block->getValue(i - 1, 0),
+                                  block->getValue(i, 0), true) < 0);
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("SortExecutor spilling to disk", "[AQL][EXECUTOR][SPILL]") {
+  ExecutionState state;
+
+  ResourceMonitor monitor;
+  AqlItemBlockManager itemBlockManager{&monitor};
+  SharedAqlItemBlockPtr block{new AqlItemBlock(itemBlockManager, 1000, 2)};
+
+  fakeit::Mock<transaction::Methods> mockTrx;
+  transaction::Methods& trx = mockTrx.get();
+
+  fakeit::Mock<transaction::Context> mockContext;
+  transaction::Context& ctxt = mockContext.get();
+
+  fakeit::When(Method(mockTrx, transactionContextPtr)).AlwaysReturn(&ctxt);
+  fakeit::When(Method(mockContext, getVPackOptions)).AlwaysReturn(&arangodb::velocypack::Options::Defaults);
+
+  Variable sortVar("mySortVar", 0);
+  std::vector<SortRegister> sortRegisters;
+  SortElement sl{&sortVar, true};
+
+  SortRegister sortReg(0, sl);
+
+  sortRegisters.emplace_back(std::move(sortReg));
+
+  // every input block alone exceeds the threshold, so each of them is
+  // spilled as a separate run
+  SortExecutorInfos infos(std::move(sortRegisters),
+                          /*limit (ignored for default sort)*/ 0,
+                          itemBlockManager, 2, 2, {}, {0, 1}, &trx, true,
+                          /*spillMemoryThreshold*/ 1);
+
+  GIVEN("there are rows from upstream") {
+    // second column records the input position, to verify stability
+    auto input = VPackParser::fromJson(
+        R"([[5, 0], [3, 1], [1, 2], ["a", 3], [3, 4], [2, 5], [4, 6]])");
+
+    WHEN("the producer waits") {
+      AllRowsFetcherHelper fetcher(input->steal(), true);
+      SortExecutor testee(fetcher, infos);
+      NoStats stats{};
+
+      THEN("the rows are produced in stable order") {
+        OutputAqlItemRow result{std::move(block), infos.getOutputRegisters(),
+                                infos.registersToKeep(), infos.registersToClear()};
+        size_t waited = 0;
+        size_t produced = 0;
+        do {
+          std::tie(state, stats) = testee.produceRows(result);
+          if (state == ExecutionState::WAITING) {
+            REQUIRE(!result.produced());
+            ++waited;
+            continue;
+          }
+          REQUIRE(result.produced());
+          ++produced;
+          result.advanceRow();
+        } while (state != ExecutionState::DONE);
+        REQUIRE(waited == 7);
+        REQUIRE(produced == 7);
+
+        block = result.stealBlock();
+        std::vector<int64_t> expectedPositions{2, 5, 1, 4, 6, 0, 3};
+        for (size_t i = 0; i < 7; ++i) {
+          AqlValue v = block->getValue(i, 1);
+          REQUIRE(v.isNumber());
+          REQUIRE(v.toInt64() == expectedPositions[i]);
+        }
+        AqlValue v = block->getValue(6, 0);
+        REQUIRE(v.isString());
+      }
+    }
+  }
+
+  GIVEN("there are no rows upstream") {
+    VPackBuilder input;
+    AllRowsFetcherHelper fetcher(input.steal(), false);
+    SortExecutor testee(fetcher, infos);
+    NoStats stats{};
+
+    THEN("the executor should return DONE") {
+      // asking for the number of rows does not fetch the input
+      size_t expected;
+      std::tie(state, expected) = testee.expectedNumberOfRows(1000);
+      REQUIRE(state == ExecutionState::HASMORE);
+      REQUIRE(expected == 1000);
+
+      OutputAqlItemRow result{std::move(block), infos.getOutputRegisters(),
+                              infos.registersToKeep(), infos.registersToClear()};
+      std::tie(state, stats) = testee.produceRows(result);
+      REQUIRE(state == ExecutionState::DONE);
+      REQUIRE(!result.produced());
+
+      std::tie(state, expected) = testee.expectedNumberOfRows(1000);
+      REQUIRE(state == ExecutionState::DONE);
+      REQUIRE(expected == 0);
+    }
+  }
+}
+
 }  // namespace aql
 }  // namespace tests
 }  // namespace arangodb
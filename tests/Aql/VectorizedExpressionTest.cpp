@@ -0,0 +1,128 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "AqlItemBlockHelper.h"
+#include "catch.hpp"
+
+#include "Aql/AqlItemBlockManager.h"
+#include "Aql/Ast.h"
+#include "Aql/Query.h"
+#include "Aql/ResourceUsage.h"
+#include "Aql/Variable.h"
+#include "Aql/VectorizedExpression.h"
+
+// required for QuerySetup
+#include "../Mocks/Servers.h"
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace arangodb {
+namespace tests {
+namespace aql {
+
+SCENARIO("VectorizedExpression", "[AQL][EXPRESSION][VECTORIZED]") {
+  ResourceMonitor monitor;
+  AqlItemBlockManager itemBlockManager{&monitor};
+
+  mocks::MockAqlServer server{};
+  std::unique_ptr<arangodb::aql::Query> fakedQuery = server.createFakeQuery();
+
+  Ast ast{fakedQuery.get()};
+  Variable var{"a", 0};
+  ast.scopes()->start(ScopeType::AQL_SCOPE_MAIN);
+  ast.scopes()->addVariable(&var);
+  AstNode* a = ast.createNodeReference("a");
+  ast.scopes()->endCurrent();
+
+  std::vector<Variable const*> vars{&var};
+  std::vector<RegisterId> regs{0};
+
+  auto block = buildBlock<1>(itemBlockManager, {{{R"({"x": 2, "y": "foo"})"}},
+                                                {{R"({"x": 0, "y": "foo"})"}},
+                                                {{R"({"x": 3, "y": "bar"})"}},
+                                                {{R"({"x": "3", "y": "foo"})"}},
+                                                {{R"({"x": [3], "y": "foo"})"}},
+                                                {{R"({"y": "foo"})"}},
+                                                {{R"(17)"}}});
+
+  WHEN("evaluating a numeric filter condition") {
+    // a.x > 1 && a.y == "foo"
+    AstNode* gt = ast.createNodeBinaryOperator(
+        NODE_TYPE_OPERATOR_BINARY_GT, ast.createNodeAttributeAccess(a, "x", 1),
+        ast.createNodeValueInt(1));
+    AstNode* eq = ast.createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_EQ,
+                                               ast.createNodeAttributeAccess(a, "y", 1),
+                                               ast.createNodeValueString("foo", 3));
+    AstNode* node = ast.createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_AND, gt, eq);
+
+    auto testee = VectorizedExpression::compile(node, vars, regs);
+    REQUIRE(testee != nullptr);
+    testee->evaluate(*block, 0, block->size());
+
+    std::vector<bool> expected{true, false, false, true, true, false, false};
+    for (size_t i = 0; i < block->size(); ++i) {
+      REQUIRE(testee->covers(*block, i));
+      AqlValue result;
+      if (i == 4) {
+        // arrays are left to the interpreter
+        REQUIRE(!testee->getResult(i, result));
+        continue;
+      }
+      REQUIRE(testee->getResult(i, result));
+      REQUIRE(result.isBoolean());
+      REQUIRE(result.toBoolean() == expected[i]);
+    }
+  }
+
+  WHEN("evaluating arithmetic") {
+    // 10 / a.x
+    AstNode* node = ast.createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_DIV,
+                                                 ast.createNodeValueInt(10),
+                                                 ast.createNodeAttributeAccess(a, "x", 1));
+
+    auto testee = VectorizedExpression::compile(node, vars, regs);
+    REQUIRE(testee != nullptr);
+    testee->evaluate(*block, 0, 3);
+
+    AqlValue result;
+    REQUIRE(testee->getResult(0, result));
+    REQUIRE(result.toDouble() == 5.0);
+    // division by zero must produce a warning, which only the interpreter does
+    REQUIRE(!testee->getResult(1, result));
+    REQUIRE(testee->getResult(2, result));
+    REQUIRE(result.toDouble() == 10.0 / 3.0);
+    REQUIRE(!testee->covers(*block, 3));
+  }
+
+  WHEN("the expression is not supported") {
+    // a.x IN [1]
+    AstNode* array = ast.createNodeArray();
+    array->addMember(ast.createNodeValueInt(1));
+    AstNode* node =
+        ast.createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_IN,
+                                     ast.createNodeAttributeAccess(a, "x", 1), array);
+    REQUIRE(VectorizedExpression::compile(node, vars, regs) == nullptr);
+  }
+}
+
+}  // namespace aql
+}  // namespace tests
+}  // namespace arangodb
@@ -31,7 +31,11 @@
 #include "catch.hpp"
 
 #include "Logger/Logger.h"
+#include "Logger/LogAppender.h"
 #include "Logger/LogAppenderFile.h"
+#include "Logger/LogThread.h"
+
+#include <thread>
 
 using namespace arangodb;
 using namespace arangodb::basics;
@@ -132,3 +136,91 @@ TEST_CASE("LoggerTest", "[loggertest]") {
   FileUtils::remove(logfile1);
   FileUtils::remove(logfile2);
 }
+
+namespace {
+
+/// @brief messages written by the log thread while a test collects them
+std::vector<std::string>* collected = nullptr;
+
+}  // namespace
+
+TEST_CASE("LogThreadTest", "[loggertest]") {
+  // switch to threaded logging without any appenders
+  Logger::shutdown();
+  Logger::initialize(true);
+
+  static bool registered = false;
+  if (!registered) {
+    // loggers cannot be removed again, and are called under the appenders lock
+    LogAppender::addLogger([](LogMessage* message) {
+      if (collected != nullptr) {
+        collected->emplace_back(message->_message.substr(message->_offset));
+      }
+    });
+    registered = true;
+  }
+
+  std::vector<std::string> messages;
+  collected = &messages;
+
+  SECTION("full rings drop messages below WARN without blocking") {
+    size_t const numThreads = 4;
+    size_t const numMessages = 3 * LogThread::RingSize;
+
+    uint64_t const droppedBefore = LogThread::numDropped();
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < numThreads; ++t) {
+      threads.emplace_back([t, numMessages]() {
+        for (size_t i = 0; i < numMessages; ++i) {
+          if (i % 1000 == 0) {
+            LOG_TOPIC("4c9a1", WARN, Logger::FIXME) << "ring-test " << t << " " << i;
+          } else {
+            LOG_TOPIC("8e2d6", INFO, Logger::FIXME) << "ring-test " << t << " " << i;
+          }
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    // writes all queued messages
+    Logger::shutdown();
+    collected = nullptr;
+
+    // WARN messages are written directly if the ring is full, so only the
+    // queued messages of a thread are in order
+    std::vector<size_t> next(numThreads, 0);
+    std::vector<size_t> warnings(numThreads, 0);
+    size_t count = 0;
+    for (auto const& message : messages) {
+      size_t t;
+      size_t i;
+      if (sscanf(message.c_str(), "ring-test %zu %zu", &t, &i) != 2) {
+        continue;
+      }
+      REQUIRE(t < numThreads);
+      if (i % 1000 == 0) {
+        ++warnings[t];
+      } else {
+        CHECK(next[t] <= i);
+        next[t] = i + 1;
+      }
+      ++count;
+    }
+
+    // no WARN message is dropped, and every other message is either written
+    // or counted as dropped
+    for (size_t t = 0; t < numThreads; ++t) {
+      CHECK(warnings[t] == (numMessages + 999) / 1000);
+    }
+    CHECK(count + (LogThread::numDropped() - droppedBefore) == numThreads * numMessages);
+  }
+
+  // restore the logging of the other tests
+  collected = nullptr;
+  Logger::shutdown();
+  Logger::initialize(false);
+  LogAppender::addAppender("-");
+}
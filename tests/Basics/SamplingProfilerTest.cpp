@@ -0,0 +1,84 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for the sampling profiler
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Basics/SamplingProfiler.h"
+
+#include <chrono>
+
+using namespace arangodb::basics;
+
+TEST_CASE("SamplingProfiler", "[profiler]") {
+  SECTION("tst_thread_role") {
+    CHECK(std::string("scheduler") == SamplingProfiler::threadRole("SchedWorker"));
+    CHECK(std::string("io") == SamplingProfiler::threadRole("Io"));
+    CHECK(std::string("rocksdb") == SamplingProfiler::threadRole("rocksdb:low0"));
+    CHECK(std::string("maintenance") == SamplingProfiler::threadRole("MaintenanceWorker"));
+    CHECK(std::string("other") == SamplingProfiler::threadRole("Statistics"));
+    CHECK(std::string("unknown") == SamplingProfiler::threadRole(nullptr));
+  }
+
+  SECTION("tst_invalid_parameters") {
+    CHECK(SamplingProfiler::start(0, 1000).fail());
+    CHECK(SamplingProfiler::start(100, 0).fail());
+    CHECK(SamplingProfiler::stop().fail());
+  }
+
+#ifdef __linux__
+  SECTION("tst_sample") {
+    REQUIRE(SamplingProfiler::start(1000, 10000).ok());
+    CHECK(SamplingProfiler::isRunning());
+    CHECK(SamplingProfiler::start(1000, 10000).fail());
+
+    // burn some CPU
+    auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(300);
+    volatile uint64_t x = 0;
+    while (std::chrono::steady_clock::now() < end) {
+      ++x;
+    }
+
+    REQUIRE(SamplingProfiler::stop().ok());
+    CHECK(!SamplingProfiler::isRunning());
+
+    std::string folded;
+    SamplingProfiler::collect(folded);
+    if (SamplingProfiler::numSamples() > 0) {
+      CHECK(!folded.empty());
+      CHECK('\n' == folded.back());
+      // every line ends with a sample count
+      std::string const firstLine = folded.substr(0, folded.find('\n'));
+      CHECK(firstLine.find(';') != std::string::npos);
+      CHECK(firstLine.rfind(' ') != std::string::npos);
+    }
+
+    // collected samples are gone
+    std::string again;
+    SamplingProfiler::collect(again);
+    CHECK(again.empty());
+  }
+#endif
+}
@@ -0,0 +1,108 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for VelocyPackBuilderPool
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Basics/ReadLocker.h"
+#include "Basics/ScalableReadWriteLock.h"
+#include "Basics/WriteLocker.h"
+
+#include <thread>
+
+using namespace arangodb;
+using namespace arangodb::basics;
+
+TEST_CASE("ScalableReadWriteLockTest", "[locks]") {
+
+SECTION("test_readers_share_the_lock") {
+  ScalableReadWriteLock lock;
+  CHECK(lock.tryReadLock());
+  CHECK(lock.tryReadLock());
+  CHECK_FALSE(lock.tryWriteLock());
+
+  lock.unlockRead();
+  CHECK_FALSE(lock.tryWriteLock());
+
+  lock.unlock();
+  CHECK(lock.tryWriteLock());
+  lock.unlockWrite();
+}
+
+SECTION("test_writer_excludes_everyone") {
+  ScalableReadWriteLock lock;
+  CHECK(lock.tryWriteLock());
+  CHECK_FALSE(lock.tryReadLock());
+  CHECK_FALSE(lock.tryWriteLock());
+
+  lock.unlock();
+  CHECK(lock.tryReadLock());
+  lock.unlockRead();
+}
+
+SECTION("test_read_lock_released_by_other_thread") {
+  ScalableReadWriteLock lock;
+  lock.readLock();
+  std::thread([&lock]() { lock.unlockRead(); }).join();
+  CHECK(lock.tryWriteLock());
+  lock.unlockWrite();
+}
+
+SECTION("test_concurrent_readers_and_writers") {
+  ScalableReadWriteLock lock;
+  uint64_t a = 0;
+  uint64_t b = 0;
+  std::atomic<bool> consistent(true);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&]() {
+      for (int i = 0; i < 20000; ++i) {
+        READ_LOCKER(locker, lock);
+        if (a != b) {
+          consistent = false;
+        }
+      }
+    });
+  }
+  for (int t = 0; t < 2; ++t) {
+    threads.emplace_back([&]() {
+      for (int i = 0; i < 5000; ++i) {
+        WRITE_LOCKER(locker, lock);
+        ++a;
+        ++b;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  CHECK(consistent.load());
+  CHECK(a == 10000);
+  CHECK(b == 10000);
+}
+
+}
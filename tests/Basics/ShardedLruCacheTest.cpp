@@ -0,0 +1,129 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for VelocyPackBuilderPool
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Basics/ShardedLruCache.h"
+
+#include <thread>
+
+using namespace arangodb;
+using namespace arangodb::basics;
+
+TEST_CASE("ShardedLruCacheTest", "[cache]") {
+
+SECTION("test_put_get_remove") {
+  ShardedLruCache<std::string, int> cache(100);
+  int value = 0;
+  CHECK_FALSE(cache.get("foo", value));
+
+  cache.put("foo", 1);
+  cache.put("bar", 2);
+  CHECK(cache.size() == 2);
+  CHECK(cache.get("foo", value));
+  CHECK(value == 1);
+
+  cache.put("foo", 3);
+  CHECK(cache.size() == 2);
+  CHECK(cache.get("foo", value));
+  CHECK(value == 3);
+
+  CHECK(cache.remove("foo"));
+  CHECK_FALSE(cache.remove("foo"));
+  CHECK_FALSE(cache.get("foo", value));
+  CHECK(cache.size() == 1);
+
+  auto stats = cache.statistics();
+  CHECK(stats.hits == 2);
+  CHECK(stats.misses == 2);
+  CHECK(stats.size == 1);
+
+  cache.clear();
+  CHECK(cache.size() == 0);
+}
+
+SECTION("test_size_is_bounded") {
+  ShardedLruCache<int, int> cache(10, 1);
+  for (int i = 0; i < 100; ++i) {
+    cache.put(i, i);
+    CHECK(cache.size() <= 10);
+  }
+  CHECK(cache.size() == 10);
+  CHECK(cache.statistics().evictions == 90);
+
+  // the most recent entries are kept
+  int value = 0;
+  CHECK(cache.get(99, value));
+  CHECK(value == 99);
+  CHECK_FALSE(cache.get(0, value));
+}
+
+SECTION("test_referenced_entries_are_kept") {
+  ShardedLruCache<int, int> cache(4, 1);
+  for (int i = 0; i < 4; ++i) {
+    cache.put(i, i);
+  }
+
+  int value = 0;
+  for (int i = 4; i < 20; ++i) {
+    CHECK(cache.get(0, value));
+    cache.put(i, i);
+  }
+  CHECK(cache.get(0, value));
+  CHECK(value == 0);
+  CHECK(cache.size() == 4);
+}
+
+SECTION("test_concurrent_access") {
+  ShardedLruCache<int, int> cache(1000);
+  std::atomic<bool> consistent(true);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&cache, &consistent, t]() {
+      int value = 0;
+      for (int i = 0; i < 10000; ++i) {
+        int key = (i * 7 + t) % 2000;
+        if (cache.get(key, value)) {
+          if (value != key) {
+            consistent = false;
+          }
+        } else {
+          cache.put(key, key);
+        }
+        if (i % 100 == 0) {
+          cache.remove(key);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  CHECK(consistent.load());
+  CHECK(cache.size() <= 1008);
+}
+
+}
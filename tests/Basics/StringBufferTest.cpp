@@ -30,6 +30,7 @@
 #include "catch.hpp"
 
 #include "Basics/StringBuffer.h"
+#include "Basics/StringUtils.h"
 
 using namespace arangodb;
 using namespace arangodb::basics;
@@ -77,6 +78,52 @@ SECTION("test_StringBuffer2") {
   CHECK(std::string(buffer.c_str()) == "Hallo World1234");
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test_StringBufferCompress
+////////////////////////////////////////////////////////////////////////////////
+
+SECTION("test_StringBufferCompress") {
+  StringBuffer buffer(true);
+  for (int i = 0; i < 10000; ++i) {
+    buffer.appendText("{\"_key\":\"");
+    buffer.appendInteger(i);
+    buffer.appendText("\",\"value\":true}");
+  }
+  std::string const original(buffer.c_str(), buffer.length());
+
+  // zlib format, as used by "content-encoding: deflate"
+  StringBuffer deflated(true);
+  CHECK(buffer.compress(deflated, false) == TRI_ERROR_NO_ERROR);
+  CHECK(deflated.length() < buffer.length() / 4);
+  CHECK(std::string(buffer.c_str(), buffer.length()) == original);
+
+  StringBuffer inflated(true);
+  CHECK(deflated.inflate(inflated) == TRI_ERROR_NO_ERROR);
+  CHECK(std::string(inflated.c_str(), inflated.length()) == original);
+
+  // gzip format
+  StringBuffer gzipped(true);
+  gzipped.appendText("xx");
+  CHECK(buffer.compress(gzipped, true, 1) == TRI_ERROR_NO_ERROR);
+  REQUIRE(gzipped.length() > 4);
+  CHECK(gzipped.c_str()[0] == 'x');
+  CHECK((unsigned char)gzipped.c_str()[2] == 0x1f);
+  CHECK((unsigned char)gzipped.c_str()[3] == 0x8b);
+
+  std::string uncompressed;
+  CHECK(StringUtils::gzipUncompress(gzipped.c_str() + 2, gzipped.length() - 2,
+                                    uncompressed));
+  CHECK(uncompressed == original);
+
+  // empty input still produces a valid stream
+  StringBuffer empty(true);
+  StringBuffer emptyDeflated(true);
+  CHECK(empty.compress(emptyDeflated, false) == TRI_ERROR_NO_ERROR);
+  StringBuffer emptyInflated(true);
+  CHECK(emptyDeflated.inflate(emptyInflated) == TRI_ERROR_NO_ERROR);
+  CHECK(emptyInflated.length() == 0);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief generate tests
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,103 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for VelocyPackBuilderPool
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include <velocypack/Buffer.h>
+#include <velocypack/Options.h>
+#include <velocypack/Value.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include "Basics/VelocyPackBuilderPool.h"
+
+using namespace arangodb;
+using namespace arangodb::basics;
+
+TEST_CASE("VelocyPackBuilderPoolTest", "[vpack]") {
+
+SECTION("test_capacity_is_retained") {
+  velocypack::ValueLength capacity;
+  {
+    PooledBuilder builder;
+    CHECK(builder->isEmpty());
+    builder->openArray();
+    for (int i = 0; i < 10000; ++i) {
+      builder->add(VPackValue(i));
+    }
+    builder->close();
+    capacity = builder->buffer()->capacity();
+  }
+  CHECK(VelocyPackBuilderPool::numPooled() >= 1);
+
+  PooledBuilder builder;
+  CHECK(builder->isEmpty());
+  CHECK(builder->buffer()->capacity() == capacity);
+
+  builder->add(VPackValue("abc"));
+  CHECK(builder->slice().isEqualString("abc"));
+}
+
+SECTION("test_options_are_reset") {
+  VPackOptions options;
+  {
+    PooledBuilder builder(&options);
+    CHECK(builder->options == &options);
+  }
+  PooledBuilder builder;
+  CHECK(builder->options == &VPackOptions::Defaults);
+}
+
+SECTION("test_large_buffers_are_freed") {
+  {
+    PooledBuilder builder;
+    builder->add(VPackValue(std::string(VelocyPackBuilderPool::MaxRetainedCapacity + 1, 'x')));
+  }
+  PooledBuilder builder;
+  CHECK(builder->buffer()->capacity() <= VelocyPackBuilderPool::MaxRetainedCapacity);
+}
+
+SECTION("test_stolen_builders_are_not_pooled") {
+  size_t const pooled = VelocyPackBuilderPool::numPooled();
+  {
+    PooledBuilder builder;
+    builder->add(VPackValue(1));
+    auto buffer = builder->steal();
+    CHECK(buffer != nullptr);
+  }
+  CHECK(VelocyPackBuilderPool::numPooled() == (pooled > 0 ? pooled - 1 : 0));
+}
+
+SECTION("test_pool_size_is_bounded") {
+  {
+    std::vector<std::unique_ptr<PooledBuilder>> builders;
+    for (size_t i = 0; i < 2 * VelocyPackBuilderPool::MaxPooled; ++i) {
+      builders.emplace_back(std::make_unique<PooledBuilder>());
+    }
+  }
+  CHECK(VelocyPackBuilderPool::numPooled() == VelocyPackBuilderPool::MaxPooled);
+}
+
+}
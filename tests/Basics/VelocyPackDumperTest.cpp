@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for VelocyPackDumper
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Options.h>
+#include <velocypack/Value.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include "Basics/StringBuffer.h"
+#include "Basics/VelocyPackDumper.h"
+
+using namespace arangodb;
+using namespace arangodb::basics;
+
+namespace {
+
+std::string dump(std::string const& value,
+                 VPackOptions const* options = &VPackOptions::Defaults) {
+  VPackBuilder builder;
+  builder.add(VPackValue(value));
+
+  StringBuffer buffer(true);
+  VelocyPackDumper dumper(&buffer, options);
+  dumper.dumpValue(builder.slice());
+  return std::string(buffer.c_str(), buffer.length());
+}
+
+}  // namespace
+
+TEST_CASE("VelocyPackDumperTest", "[vpack]") {
+
+SECTION("test_plain_strings") {
+  CHECK(dump("") == "\"\"");
+  CHECK(dump("abc") == "\"abc\"");
+
+  // longer than the blocks checked at once
+  std::string const value(100, 'x');
+  CHECK(dump(value) == "\"" + value + "\"");
+}
+
+SECTION("test_escapes_at_every_position") {
+  std::vector<std::pair<std::string, std::string>> const escapes = {
+      {"\"", "\\\""},   {"\\", "\\\\"},      {"/", "/"},
+      {"\n", "\\n"},    {"\t", "\\t"},       {"\x01", "\\u0001"},
+      {"\x1f", "\\u001F"}, {"\xc3\xa4", "\xc3\xa4"}, {"\xe2\x82\xac", "\xe2\x82\xac"}};
+
+  for (auto const& escape : escapes) {
+    for (size_t position = 0; position < 40; ++position) {
+      std::string const prefix(position, 'a');
+      std::string const suffix(40 - position, 'b');
+
+      CHECK(dump(prefix + escape.first + suffix) ==
+            "\"" + prefix + escape.second + suffix + "\"");
+    }
+  }
+}
+
+SECTION("test_escape_forward_slashes") {
+  VPackOptions options;
+  options.escapeForwardSlashes = true;
+
+  std::string const prefix(20, 'a');
+  CHECK(dump(prefix + "/" + prefix, &options) == "\"" + prefix + "\\/" + prefix + "\"");
+}
+
+SECTION("test_escape_unicode") {
+  VPackOptions options;
+  options.escapeUnicode = true;
+
+  std::string const prefix(20, 'a');
+  CHECK(dump(prefix + "\xc3\xa4" + prefix, &options) ==
+        "\"" + prefix + "\\u00E4" + prefix + "\"");
+}
+
+}
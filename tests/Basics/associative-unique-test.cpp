@@ -0,0 +1,169 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for AssocUnique
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Basics/AssocUnique.h"
+#include "Basics/fasthash.h"
+
+namespace {
+
+struct data_container_t {
+  int key;
+  int value;
+};
+
+template <bool collide>
+struct AssocUniqueTestHelper {
+  static inline uint64_t hash(int key) {
+    if (collide) {
+      // few distinct hash values with identical tags, so that probe
+      // sequences are long and every tag compare is a hit
+      return static_cast<uint64_t>(key % 7);
+    }
+    return fasthash64(&key, sizeof(int), 0x12345678);
+  }
+
+  static inline uint64_t HashKey(int const* key) { return hash(*key); }
+
+  static inline uint64_t HashElement(data_container_t* const& element, bool) {
+    return hash(element->key);
+  }
+
+  inline bool IsEqualKeyElement(void*, int const* key,
+                                data_container_t* const& element) const {
+    return *key == element->key;
+  }
+
+  inline bool IsEqualElementElement(void*, data_container_t* const& left,
+                                    data_container_t* const& right) const {
+    return left == right;
+  }
+
+  inline bool IsEqualElementElementByKey(void*, data_container_t* const& left,
+                                         data_container_t* const& right) const {
+    return left->key == right->key;
+  }
+};
+
+template <bool collide>
+using TestAssocUnique =
+    arangodb::basics::AssocUnique<int, data_container_t*, AssocUniqueTestHelper<collide>>;
+
+template <bool collide>
+void checkInsertFindRemove(size_t numberBuckets, int n) {
+  TestAssocUnique<collide> a(AssocUniqueTestHelper<collide>(), numberBuckets);
+  std::vector<data_container_t> elements(n);
+
+  for (int i = 0; i < n; ++i) {
+    elements[i].key = i;
+    elements[i].value = 2 * i;
+    CHECK(TRI_ERROR_NO_ERROR == a.insert(nullptr, &elements[i]));
+  }
+  CHECK(static_cast<size_t>(n) == a.size());
+
+  // duplicate keys are rejected
+  data_container_t duplicate{n / 2, -1};
+  CHECK(TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED == a.insert(nullptr, &duplicate));
+  CHECK(&elements[n / 2] == a.find(nullptr, &duplicate));
+
+  for (int i = 0; i < n; ++i) {
+    CHECK(&elements[i] == a.findByKey(nullptr, &i));
+  }
+  for (int i = n; i < 2 * n; ++i) {
+    CHECK(nullptr == a.findByKey(nullptr, &i));
+  }
+
+  // remove every other element, the remaining ones must still be found
+  // after the holes have been healed
+  for (int i = 0; i < n; i += 2) {
+    CHECK(&elements[i] == a.removeByKey(nullptr, &i));
+  }
+  CHECK(static_cast<size_t>(n / 2) == a.size());
+
+  for (int i = 0; i < n; ++i) {
+    data_container_t* expected = (i % 2 == 0) ? nullptr : &elements[i];
+    CHECK(expected == a.findByKey(nullptr, &i));
+  }
+
+  // an element with the same key but a different identity is not removed
+  data_container_t other{1, 2};
+  CHECK(nullptr == a.remove(nullptr, &other));
+  CHECK(&elements[1] == a.remove(nullptr, &elements[1]));
+  int one = 1;
+  CHECK(nullptr == a.findByKey(nullptr, &one));
+
+  // freed slots can be reused
+  for (int i = 0; i < n; i += 2) {
+    CHECK(TRI_ERROR_NO_ERROR == a.insert(nullptr, &elements[i]));
+  }
+  for (int i = 0; i < n; i += 2) {
+    CHECK(&elements[i] == a.findByKey(nullptr, &i));
+  }
+}
+
+}  // namespace
+
+TEST_CASE("associative unique", "[associative]") {
+  SECTION("tst_init") {
+    TestAssocUnique<false> a((AssocUniqueTestHelper<false>()));
+    CHECK(0 == a.size());
+    CHECK(a.isEmpty());
+    int key = 1;
+    CHECK(nullptr == a.findByKey(nullptr, &key));
+  }
+
+  SECTION("tst_insert_find_remove") {
+    checkInsertFindRemove<false>(1, 20000);
+  }
+
+  SECTION("tst_insert_find_remove_buckets") {
+    checkInsertFindRemove<false>(8, 20000);
+  }
+
+  SECTION("tst_insert_find_remove_colliding") {
+    checkInsertFindRemove<true>(1, 2000);
+  }
+
+  SECTION("tst_find_by_key_position") {
+    TestAssocUnique<false> a((AssocUniqueTestHelper<false>()));
+    std::vector<data_container_t> elements(100);
+    for (int i = 0; i < 100; ++i) {
+      elements[i].key = i;
+      CHECK(TRI_ERROR_NO_ERROR == a.insert(nullptr, &elements[i]));
+    }
+
+    // look up a missing key and insert it at the returned position
+    data_container_t added{1000, 0};
+    arangodb::basics::BucketPosition position;
+    uint64_t hash;
+    CHECK(nullptr == a.findByKey(nullptr, &added.key, position, hash));
+    CHECK(TRI_ERROR_NO_ERROR == a.insertAtPosition(nullptr, &added, position));
+    CHECK(&added == a.findByKey(nullptr, &added.key));
+    CHECK(&added == a.removeByKey(nullptr, &added.key));
+    CHECK(nullptr == a.findByKey(nullptr, &added.key));
+  }
+}
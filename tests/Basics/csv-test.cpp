@@ -383,6 +383,52 @@ SECTION("tst_csv_semicolon_noquote") {
   TRI_DestroyCsvParser(&parser);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test long fields, which are scanned in blocks
+////////////////////////////////////////////////////////////////////////////////
+
+SECTION("tst_csv_long_fields") {
+  INIT_PARSER
+  TRI_SetSeparatorCsvParser(&parser, ',');
+  TRI_SetQuoteCsvParser(&parser, '"', true);
+
+  std::string const plain(70, 'a');
+  std::string const quoted(40, 'b');
+
+  std::string const csv =
+    plain + "," + plain + LF
+    "\"" + quoted + "\"\"" + quoted + "\"," + plain + "x" LF;
+
+  // feed the input in two parts, so a block ends within a field
+  TRI_ParseCsvString(&parser, csv.c_str(), 50);
+  TRI_ParseCsvString(&parser, csv.c_str() + 50, csv.size() - 50);
+  CHECK("0:" + plain + "," + plain + "\n"
+        "1:ESC" + quoted + "\"" + quoted + "ESC," + plain + "x\n" == setup.out.str());
+
+  TRI_DestroyCsvParser(&parser);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test long quoted fields with backslash escapes
+////////////////////////////////////////////////////////////////////////////////
+
+SECTION("tst_csv_long_fields_backslash") {
+  INIT_PARSER
+  TRI_SetSeparatorCsvParser(&parser, ';');
+  TRI_SetQuoteCsvParser(&parser, '"', true);
+  TRI_UseBackslashCsvParser(&parser, true);
+
+  std::string const value(33, 'c');
+
+  std::string const csv =
+    "\"" + value + "\\\"" + value + "\\\\\";" + value + LF;
+
+  TRI_ParseCsvString(&parser, csv.c_str(), csv.size());
+  CHECK("0:ESC" + value + "\"" + value + "\\ESC," + value + "\n" == setup.out.str());
+
+  TRI_DestroyCsvParser(&parser);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief generate tests
 ////////////////////////////////////////////////////////////////////////////////
@@ -340,6 +340,22 @@ SECTION("tst_fnv64_utf8") {
 /// @brief test crc32 for simple strings
 ////////////////////////////////////////////////////////////////////////////////
 
+SECTION("tst_crc32_matches_table_version") {
+  // TRI_BlockCrc32 may use hardware instructions, which must produce the
+  // same values as the table-based version for any length and alignment
+  std::string buffer;
+  for (int i = 0; i < 300; ++i) {
+    buffer.push_back(static_cast<char>((i * 131) ^ (i >> 3)));
+  }
+  for (size_t offset = 0; offset < 8; ++offset) {
+    for (size_t length = 0; offset + length <= buffer.size(); length += 7) {
+      char const* data = buffer.data() + offset;
+      CHECK(TRI_BlockCrc32_C(TRI_InitialCrc32(), data, length) ==
+            TRI_BlockCrc32(TRI_InitialCrc32(), data, length));
+    }
+  }
+}
+
 SECTION("tst_crc32_simple") {
   std::string buffer;
 
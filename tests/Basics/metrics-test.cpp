@@ -0,0 +1,114 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for the metrics registry
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Basics/Exceptions.h"
+#include "Basics/Metrics.h"
+
+#include <thread>
+
+using namespace arangodb::metrics;
+
+TEST_CASE("metrics", "[metrics]") {
+  SECTION("tst_counter_threads") {
+    Counter counter;
+    CHECK(0 == counter.load());
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; ++i) {
+      threads.emplace_back([&counter]() {
+        for (int j = 0; j < 10000; ++j) {
+          counter.count();
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    CHECK(80000 == counter.load());
+  }
+
+  SECTION("tst_gauge") {
+    Gauge gauge;
+    gauge.add(10);
+    gauge.sub(3);
+    CHECK(7 == gauge.load());
+    gauge.set(-5);
+    CHECK(-5 == gauge.load());
+  }
+
+  SECTION("tst_histogram_buckets") {
+    Histogram histogram(-1, 1);
+    // 0.1 ... 0.9, 1 ... 9, 10
+    CHECK(19 == histogram.bounds().size());
+
+    histogram.count(0.05);  // first bucket
+    histogram.count(0.1);   // bounds are inclusive
+    histogram.count(2.5);   // bucket with bound 3
+    histogram.count(100);   // overflow bucket
+
+    CHECK(2 == histogram.bucket(0));
+    CHECK(1 == histogram.bucket(11));
+    CHECK(1 == histogram.bucket(19));
+    CHECK(4 == histogram.total());
+    CHECK(102.65 == Approx(histogram.sum()));
+  }
+
+  SECTION("tst_registry") {
+    Registry registry;
+    Counter& counter = registry.counter("test_total", "a counter");
+    CHECK(&counter == &registry.counter("test_total", "a counter"));
+    CHECK_THROWS_AS(registry.gauge("test_total", "a gauge"), arangodb::basics::Exception);
+
+    counter.count(3);
+    registry.gauge("test_open", "a gauge").add(2);
+    registry.histogram("test_seconds", "a histogram", 0, 1).count(5);
+    registry.addCollector("test", [](std::string& result) {
+      Registry::appendSample(result, "test_collected", "{a=\"b\"}", 1.5);
+    });
+
+    std::string result;
+    registry.toPrometheus(result);
+    CHECK(result.find("# TYPE test_total counter\ntest_total 3\n") != std::string::npos);
+    CHECK(result.find("# TYPE test_open gauge\ntest_open 2\n") != std::string::npos);
+    CHECK(result.find("test_seconds_bucket{le=\"4\"} 0\n") != std::string::npos);
+    CHECK(result.find("test_seconds_bucket{le=\"5\"} 1\n") != std::string::npos);
+    CHECK(result.find("test_seconds_bucket{le=\"+Inf\"} 1\n") != std::string::npos);
+    CHECK(result.find("test_seconds_sum 5\ntest_seconds_count 1\n") != std::string::npos);
+    CHECK(result.find("test_collected{a=\"b\"} 1.5\n") != std::string::npos);
+
+    registry.removeCollector("test");
+    result.clear();
+    registry.toPrometheus(result);
+    CHECK(result.find("test_collected") == std::string::npos);
+  }
+
+  SECTION("tst_sanitize") {
+    CHECK("rocksdb_estimate_num_keys" == Registry::sanitize("rocksdb.estimate-num-keys"));
+    CHECK("_1x" == Registry::sanitize("11x"));
+  }
+}
@@ -33,6 +33,8 @@
 #include "Basics/voc-errors.h"
 #include "Random/RandomGenerator.h"
 
+#include <algorithm>
+#include <thread>
 #include <vector>
 
 static bool Initialized = false;
@@ -441,6 +443,164 @@ SECTION("tst_unique_remove_all") {
     delete i;
   }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that the memory of removed nodes is reused
+////////////////////////////////////////////////////////////////////////////////
+
+SECTION("tst_unique_remove_reinsert") {
+  arangodb::MMFilesSkiplist<void, void> skiplist(CmpElmElm, CmpKeyElm, FreeElm, true, false);
+
+  std::vector<int*> values;
+  for (int i = 0; i < 10000; ++i) {
+    values.push_back(new int(i));
+  }
+
+  for (int i = 0; i < 10000; ++i) {
+    CHECK(0 == skiplist.insert(nullptr, values[i]));
+  }
+  size_t const memory = skiplist.memoryUsage();
+
+  for (int round = 0; round < 5; ++round) {
+    for (int i = round; i < 10000; i += 5) {
+      CHECK(0 == skiplist.remove(nullptr, values[i]));
+    }
+    for (int i = round; i < 10000; i += 5) {
+      CHECK(0 == skiplist.insert(nullptr, values[i]));
+    }
+  }
+
+  CHECK(10000 == (int) skiplist.getNrUsed());
+  // nodes of the same height are recycled, only a few new blocks
+  // may be needed for nodes that got taller
+  CHECK(skiplist.memoryUsage() <= memory + 2 * arangodb::MMFilesSkiplistArena::MaxBlockSize);
+
+  auto current = skiplist.startNode()->nextNode();
+  for (int i = 0; i < 10000; ++i) {
+    CHECK(values[i] == current->document());
+    current = current->nextNode();
+  }
+  CHECK((void*) nullptr == current);
+
+  skiplist.truncate(true);
+  CHECK(0 == (int) skiplist.getNrUsed());
+  CHECK((void*) nullptr == skiplist.startNode()->nextNode());
+
+  // clean up
+  for (auto i : values) {
+    delete i;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that small skiplists only use small blocks
+////////////////////////////////////////////////////////////////////////////////
+
+SECTION("tst_unique_block_growth") {
+  typedef arangodb::MMFilesSkiplistArena Arena;
+  arangodb::MMFilesSkiplist<void, void> skiplist(CmpElmElm, CmpKeyElm, FreeElm, true, false);
+
+  std::vector<int*> values;
+  for (int i = 0; i < 100000; ++i) {
+    values.push_back(new int(i));
+  }
+
+  size_t const base = sizeof(skiplist);
+  CHECK(skiplist.memoryUsage() <= base + Arena::MinBlockSize + Arena::CacheLineSize);
+
+  CHECK(0 == skiplist.insert(nullptr, values[0]));
+  CHECK(skiplist.memoryUsage() <= base + Arena::MinBlockSize + Arena::CacheLineSize);
+
+  // nodes take 32 bytes, or 64 bytes from height 2 on. blocks grow
+  // geometrically, so at most the largest block is unused
+  for (int i = 1; i < 100000; ++i) {
+    CHECK(0 == skiplist.insert(nullptr, values[i]));
+  }
+  CHECK(skiplist.memoryUsage() > base + 100000 * (Arena::CacheLineSize / 2));
+  CHECK(skiplist.memoryUsage() <= base + 100000 * Arena::CacheLineSize + Arena::MaxBlockSize);
+
+  // truncate starts over with a small block
+  skiplist.truncate(true);
+  CHECK(0 == skiplist.insert(nullptr, values[0]));
+  CHECK(skiplist.memoryUsage() <= base + Arena::MinBlockSize + Arena::CacheLineSize);
+
+  // clean up
+  for (auto i : values) {
+    delete i;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test lookups and iteration concurrent to an inserting thread
+////////////////////////////////////////////////////////////////////////////////
+
+SECTION("tst_unique_concurrent_read_insert") {
+  arangodb::MMFilesSkiplist<void, void> skiplist(CmpElmElm, CmpKeyElm, FreeElm, true, false);
+
+  int const n = 50000;
+  std::vector<int*> values;
+  std::vector<int> order;
+  for (int i = 0; i < n; ++i) {
+    values.push_back(new int(i));
+    order.push_back(i);
+  }
+  std::random_shuffle(order.begin(), order.end());
+
+  std::unique_ptr<std::atomic<bool>[]> inserted(new std::atomic<bool>[n]);
+  for (int i = 0; i < n; ++i) {
+    inserted[i] = false;
+  }
+  std::atomic<bool> done(false);
+  std::atomic<uint64_t> failures(0);
+
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t) {
+    readers.emplace_back([&, t]() {
+      uint32_t r = 12345 + t;
+      while (!done.load()) {
+        // values seen as inserted must be found
+        for (int j = 0; j < 1000; ++j) {
+          r = r * 1103515245 + 12345;
+          int i = static_cast<int>((r >> 8) % n);
+          if (inserted[i].load(std::memory_order_acquire) &&
+              skiplist.lookup(nullptr, values[i]) == nullptr) {
+            ++failures;
+          }
+        }
+        // forward iteration must see ascending values
+        int last = -1;
+        for (auto node = skiplist.startNode()->nextNode(); node != nullptr;
+             node = node->nextNode()) {
+          int value = *static_cast<int const*>(node->document());
+          if (value <= last) {
+            ++failures;
+          }
+          last = value;
+        }
+      }
+    });
+  }
+
+  for (int i : order) {
+    CHECK(0 == skiplist.insert(nullptr, values[i]));
+    inserted[i].store(true, std::memory_order_release);
+  }
+  done = true;
+  for (auto& it : readers) {
+    it.join();
+  }
+
+  CHECK(0 == failures.load());
+  CHECK(n == (int) skiplist.getNrUsed());
+  for (int i = 0; i < n; ++i) {
+    CHECK(values[i] == skiplist.lookup(nullptr, values[i])->document());
+  }
+
+  // clean up
+  for (auto i : values) {
+    delete i;
+  }
+}
 }
 
 // Local Variables:
@@ -230,6 +230,27 @@ SECTION("tst_5") {
   arangodb::basics::Utf8Helper::DefaultUtf8Helper.tokenize(words, arangodb::velocypack::StringRef(""), 4, UINT32_MAX, false);
   CHECK(words.empty());
 }
+
+SECTION("tst_sort_keys") {
+  auto const& helper = arangodb::basics::Utf8Helper::DefaultUtf8Helper;
+  std::vector<std::string> const values{
+      "", "a", "A", "aa", "ab", "b", "B", "Müller", "Mueller", "muller",
+      "Ärger", "Zebra", "zebra", "1", "10", "9", " ", "a b", "ab ", "ß", "ss",
+      "\xe2\x82\xac", std::string(1000, 'x') + "y", std::string(1000, 'x')};
+
+  std::string lhsKey;
+  std::string rhsKey;
+  for (auto const& lhs : values) {
+    helper.sortKeyUtf8(lhs.data(), lhs.size(), lhsKey);
+    for (auto const& rhs : values) {
+      helper.sortKeyUtf8(rhs.data(), rhs.size(), rhsKey);
+      int expected = helper.compareUtf8(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+      int actual = lhsKey.compare(rhsKey);
+      CHECK((expected < 0) == (actual < 0));
+      CHECK((expected > 0) == (actual > 0));
+    }
+  }
+}
 }
 
 // Local Variables:
@@ -0,0 +1,145 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MicroBenchmark.h"
+
+#include "Aql/AqlItemBlock.h"
+#include "Aql/AqlItemBlockManager.h"
+#include "Aql/AqlValue.h"
+#include "Aql/ResourceUsage.h"
+#include "Aql/SharedAqlItemBlockPtr.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <random>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+using namespace arangodb::benchmarks;
+
+namespace {
+
+/// @brief a mix of the value types queries usually produce: numbers,
+/// short strings stored inline, longer strings and small arrays
+std::vector<AqlValue> makeValues(size_t n) {
+  std::mt19937_64 rng(42);
+  std::vector<AqlValue> values;
+  values.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    switch (i % 5) {
+      case 0:
+        values.emplace_back(AqlValueHintInt(static_cast<int64_t>(rng() % 100000)));
+        break;
+      case 1:
+        values.emplace_back(AqlValueHintDouble(static_cast<double>(rng() % 100000) / 7.0));
+        break;
+      case 2:
+        values.emplace_back("key" + std::to_string(rng() % 100000));
+        break;
+      case 3:
+        values.emplace_back("users/" + std::to_string(rng()) + "/" + std::to_string(rng()));
+        break;
+      default: {
+        VPackBuilder builder;
+        builder.openArray();
+        for (int j = 0; j < 4; ++j) {
+          builder.add(VPackValue(static_cast<int64_t>(rng() % 1000)));
+        }
+        builder.close();
+        values.emplace_back(builder.slice());
+        break;
+      }
+    }
+  }
+  return values;
+}
+
+void destroyValues(std::vector<AqlValue>& values) {
+  for (auto& value : values) {
+    value.destroy();
+  }
+}
+
+void fillBlock(AqlItemBlock& block, std::vector<AqlValue> const& values) {
+  size_t k = 0;
+  for (size_t row = 0; row < block.size(); ++row) {
+    for (RegisterId reg = 0; reg < block.getNrRegs(); ++reg) {
+      block.emplaceValue(row, reg, values[k++ % values.size()].clone());
+    }
+  }
+}
+
+}  // namespace
+
+MICRO_BENCHMARK(AqlValueHashMixed) {
+  auto values = makeValues(1024);
+  size_t i = 0;
+  while (state.keepRunning()) {
+    doNotOptimize(values[i++ & 1023].hash(nullptr));
+  }
+  destroyValues(values);
+}
+
+MICRO_BENCHMARK(AqlValueCloneMixed) {
+  auto values = makeValues(1024);
+  size_t i = 0;
+  while (state.keepRunning()) {
+    AqlValue copy = values[i++ & 1023].clone();
+    doNotOptimize(copy);
+    copy.destroy();
+  }
+  destroyValues(values);
+}
+
+MICRO_BENCHMARK(AqlItemBlockSlice1000x4) {
+  ResourceMonitor monitor;
+  AqlItemBlockManager manager(&monitor);
+  auto values = makeValues(1024);
+  SharedAqlItemBlockPtr block = manager.requestBlock(1000, 4);
+  fillBlock(*block, values);
+
+  while (state.keepRunning()) {
+    SharedAqlItemBlockPtr copy = block->slice(0, 1000);
+    doNotOptimize(copy.get());
+  }
+  destroyValues(values);
+}
+
+MICRO_BENCHMARK(AqlItemBlockSteal1000x4) {
+  ResourceMonitor monitor;
+  AqlItemBlockManager manager(&monitor);
+  auto values = makeValues(1024);
+  SharedAqlItemBlockPtr block = manager.requestBlock(1000, 4);
+  std::vector<size_t> chosen(1000);
+  for (size_t i = 0; i < chosen.size(); ++i) {
+    chosen[i] = i;
+  }
+
+  while (state.keepRunning()) {
+    state.pauseTiming();
+    fillBlock(*block, values);
+    state.resumeTiming();
+
+    SharedAqlItemBlockPtr stolen = block->steal(chosen, 0, chosen.size());
+    doNotOptimize(stolen.get());
+  }
+  destroyValues(values);
+}
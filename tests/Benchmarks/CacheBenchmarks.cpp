@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MicroBenchmark.h"
+
+#include "Cache/CachedValue.h"
+#include "Cache/Common.h"
+#include "Cache/Finding.h"
+#include "Cache/Manager.h"
+#include "Cache/PlainCache.h"
+
+#include <random>
+
+using namespace arangodb;
+using namespace arangodb::cache;
+using namespace arangodb::benchmarks;
+
+namespace {
+
+uint64_t const numKeys = 100000;
+
+std::shared_ptr<Cache> makeFilledCache(Manager& manager) {
+  auto cache = manager.createCache(CacheType::Plain, false, 64 * 1024 * 1024);
+  for (uint64_t i = 0; i < numKeys; ++i) {
+    uint64_t value = i * 3;
+    CachedValue* cached = CachedValue::construct(&i, sizeof(i), &value, sizeof(value));
+    if (!cache->insert(cached).ok()) {
+      delete cached;
+    }
+  }
+  return cache;
+}
+
+}  // namespace
+
+MICRO_BENCHMARK(PlainCacheFindHit) {
+  auto postFn = [](std::function<void()>) -> bool { return false; };
+  Manager manager(postFn, 256 * 1024 * 1024);
+  auto cache = makeFilledCache(manager);
+
+  std::mt19937_64 rng(42);
+  std::vector<uint64_t> keys(1 << 16);
+  for (auto& key : keys) {
+    key = rng() % numKeys;
+  }
+  size_t i = 0;
+  while (state.keepRunning()) {
+    uint64_t key = keys[i++ & 0xFFFF];
+    Finding finding = cache->find(&key, sizeof(key));
+    doNotOptimize(finding.found());
+  }
+  manager.destroyCache(cache);
+}
+
+MICRO_BENCHMARK(PlainCacheFindMiss) {
+  auto postFn = [](std::function<void()>) -> bool { return false; };
+  Manager manager(postFn, 256 * 1024 * 1024);
+  auto cache = makeFilledCache(manager);
+
+  uint64_t key = numKeys;
+  while (state.keepRunning()) {
+    ++key;
+    Finding finding = cache->find(&key, sizeof(key));
+    doNotOptimize(finding.found());
+  }
+  manager.destroyCache(cache);
+}
+
+MICRO_BENCHMARK(PlainCacheInsert) {
+  auto postFn = [](std::function<void()>) -> bool { return false; };
+  Manager manager(postFn, 256 * 1024 * 1024);
+  auto cache = manager.createCache(CacheType::Plain, false, 64 * 1024 * 1024);
+
+  uint64_t key = 0;
+  while (state.keepRunning()) {
+    ++key;
+    uint64_t value = key * 3;
+    CachedValue* cached = CachedValue::construct(&key, sizeof(key), &value, sizeof(value));
+    if (!cache->insert(cached).ok()) {
+      delete cached;
+    }
+  }
+  manager.destroyCache(cache);
+}
@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MicroBenchmark.h"
+
+#include <iomanip>
+#include <iostream>
+
+using namespace arangodb::benchmarks;
+
+namespace {
+struct Benchmark {
+  std::string name;
+  std::function<void(State&)> fn;
+};
+
+std::vector<Benchmark>& registry() {
+  static std::vector<Benchmark> benchmarks;
+  return benchmarks;
+}
+
+bool matches(std::string const& name, std::vector<std::string> const& filters) {
+  if (filters.empty()) {
+    return true;
+  }
+  for (auto const& filter : filters) {
+    if (name.find(filter) != std::string::npos) {
+      return true;
+    }
+  }
+  return false;
+}
+}  // namespace
+
+Registration::Registration(char const* name, std::function<void(State&)> fn) {
+  registry().push_back({name, std::move(fn)});
+}
+
+int arangodb::benchmarks::runBenchmarks(std::vector<std::string> const& filters,
+                                        double minTime) {
+  auto const minDuration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::duration<double>(minTime));
+
+  std::cout << std::left << std::setw(48) << "benchmark" << std::right
+            << std::setw(14) << "ns/op" << std::setw(14) << "iterations" << std::endl;
+
+  for (auto const& benchmark : registry()) {
+    if (!matches(benchmark.name, filters)) {
+      continue;
+    }
+
+    // grow the number of iterations until a run takes long enough to be
+    // measured reliably
+    uint64_t iterations = 1;
+    while (true) {
+      State state(iterations);
+      benchmark.fn(state);
+      auto const elapsed = state.elapsed();
+
+      if (elapsed >= minDuration || iterations >= (uint64_t(1) << 40)) {
+        double const perOp = static_cast<double>(elapsed.count()) / iterations;
+        std::cout << std::left << std::setw(48) << benchmark.name << std::right
+                  << std::setw(14) << std::fixed << std::setprecision(1) << perOp
+                  << std::setw(14) << iterations << std::endl;
+        break;
+      }
+
+      if (elapsed.count() <= 0) {
+        iterations *= 10;
+      } else {
+        // aim a bit above the minimum, but grow by at most 10x per step
+        double factor = 1.2 * static_cast<double>(minDuration.count()) / elapsed.count();
+        factor = (std::min)((std::max)(factor, 2.0), 10.0);
+        iterations = static_cast<uint64_t>(iterations * factor);
+      }
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_TESTS_BENCHMARKS_MICRO_BENCHMARK_H
+#define ARANGODB_TESTS_BENCHMARKS_MICRO_BENCHMARK_H 1
+
+#include "Basics/Common.h"
+
+#include <chrono>
+#include <functional>
+
+namespace arangodb {
+namespace benchmarks {
+
+/// @brief the state of a single benchmark run. A benchmark function repeats
+/// the operation to measure as long as keepRunning() returns true. Setup
+/// work before the loop is not measured:
+///
+///   MICRO_BENCHMARK(MyBenchmark) {
+///     auto data = prepare();
+///     while (state.keepRunning()) {
+///       doNotOptimize(operation(data));
+///     }
+///   }
+class State {
+ public:
+  explicit State(uint64_t iterations)
+      : _iterations(iterations), _remaining(iterations), _started(false), _elapsed(0) {}
+
+  bool keepRunning() {
+    if (!_started) {
+      _started = true;
+      _start = std::chrono::steady_clock::now();
+    }
+    if (_remaining == 0) {
+      _elapsed += std::chrono::steady_clock::now() - _start;
+      return false;
+    }
+    --_remaining;
+    return true;
+  }
+
+  /// @brief excludes work inside the loop from the measurement, must be
+  /// followed by resumeTiming()
+  void pauseTiming() { _elapsed += std::chrono::steady_clock::now() - _start; }
+  void resumeTiming() { _start = std::chrono::steady_clock::now(); }
+
+  uint64_t iterations() const { return _iterations; }
+  std::chrono::nanoseconds elapsed() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(_elapsed);
+  }
+
+ private:
+  uint64_t const _iterations;
+  uint64_t _remaining;
+  bool _started;
+  std::chrono::steady_clock::time_point _start;
+  std::chrono::steady_clock::duration _elapsed;
+};
+
+/// @brief keeps the compiler from optimizing away a computed value
+template <typename T>
+inline void doNotOptimize(T const& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile char sink;
+  sink = *reinterpret_cast<char const volatile*>(&value);
+#endif
+}
+
+/// @brief registers a benchmark function, used by MICRO_BENCHMARK
+struct Registration {
+  Registration(char const* name, std::function<void(State&)> fn);
+};
+
+/// @brief runs all benchmarks whose name contains one of the filters, or
+/// all of them if there are no filters
+int runBenchmarks(std::vector<std::string> const& filters, double minTime);
+
+}  // namespace benchmarks
+}  // namespace arangodb
+
+#define MICRO_BENCHMARK(name)                                                     \
+  static void name(arangodb::benchmarks::State& state);                           \
+  static arangodb::benchmarks::Registration name##Registration(#name, name); \
+  static void name(arangodb::benchmarks::State& state)
+
+#endif
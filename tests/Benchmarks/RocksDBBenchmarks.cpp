@@ -0,0 +1,102 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MicroBenchmark.h"
+
+#include "RocksDBEngine/RocksDBCuckooIndexEstimator.h"
+#include "RocksDBEngine/RocksDBKey.h"
+#include "VocBase/LocalDocumentId.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/StringRef.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <random>
+
+using namespace arangodb;
+using namespace arangodb::benchmarks;
+
+namespace {
+/// @brief the size of the estimators of the RocksDB indexes
+uint64_t const estimatorSize = 4096;
+}  // namespace
+
+MICRO_BENCHMARK(RocksDBKeyPrimaryIndexValue) {
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < 1024; ++i) {
+    keys.emplace_back(std::to_string(1000000 + i * 7919));
+  }
+  RocksDBKey key;
+  size_t i = 0;
+  while (state.keepRunning()) {
+    key.constructPrimaryIndexValue(42, velocypack::StringRef(keys[i++ & 1023]));
+    doNotOptimize(key.string());
+  }
+}
+
+MICRO_BENCHMARK(RocksDBKeyVPackIndexValue) {
+  std::mt19937_64 rng(42);
+  std::vector<VPackBuilder> values(1024);
+  for (auto& builder : values) {
+    builder.openArray();
+    builder.add(VPackValue("user-" + std::to_string(rng() % 1000)));
+    builder.add(VPackValue(static_cast<int64_t>(rng() % 100)));
+    builder.close();
+  }
+  RocksDBKey key;
+  size_t i = 0;
+  while (state.keepRunning()) {
+    key.constructVPackIndexValue(42, values[i & 1023].slice(), LocalDocumentId(i));
+    doNotOptimize(key.string());
+    ++i;
+  }
+}
+
+MICRO_BENCHMARK(RocksDBCuckooEstimatorInsert) {
+  // index values with a skewed distribution: most values are rare, a few
+  // are very frequent
+  std::mt19937_64 rng(42);
+  std::vector<uint64_t> hashes(1 << 16);
+  for (auto& hash : hashes) {
+    hash = (rng() % 4 == 0) ? rng() % 16 : rng();
+  }
+  RocksDBCuckooIndexEstimator<uint64_t> estimator(estimatorSize);
+  size_t i = 0;
+  while (state.keepRunning()) {
+    estimator.insert(hashes[i++ & 0xFFFF]);
+  }
+  doNotOptimize(estimator.computeEstimate());
+}
+
+MICRO_BENCHMARK(RocksDBCuckooEstimatorLookup) {
+  std::mt19937_64 rng(42);
+  std::vector<uint64_t> hashes(1 << 16);
+  for (auto& hash : hashes) {
+    hash = (rng() % 4 == 0) ? rng() % 16 : rng();
+  }
+  RocksDBCuckooIndexEstimator<uint64_t> estimator(estimatorSize);
+  for (size_t i = 0; i < hashes.size(); i += 2) {
+    estimator.insert(hashes[i]);
+  }
+  size_t i = 0;
+  while (state.keepRunning()) {
+    doNotOptimize(estimator.lookup(hashes[i++ & 0xFFFF]));
+  }
+}
@@ -0,0 +1,90 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MicroBenchmark.h"
+
+#include "Basics/VelocyPackHelper.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <random>
+
+using namespace arangodb;
+using namespace arangodb::benchmarks;
+
+namespace {
+
+/// @brief documents that look like a typical user collection, many of them
+/// share a prefix in their string attributes
+std::vector<VPackBuilder> makeDocuments(size_t n) {
+  std::mt19937_64 rng(42);
+  std::vector<VPackBuilder> documents(n);
+  for (auto& builder : documents) {
+    builder.openObject();
+    builder.add("_key", VPackValue(std::to_string(rng() % 1000000)));
+    builder.add("name", VPackValue("user-" + std::to_string(rng() % 1000)));
+    builder.add("age", VPackValue(static_cast<int64_t>(rng() % 100)));
+    builder.add("score", VPackValue(static_cast<double>(rng() % 10000) / 3.0));
+    builder.add("active", VPackValue(rng() % 2 == 0));
+    builder.add("tags", VPackValue(VPackValueType::Array));
+    builder.add(VPackValue("tag" + std::to_string(rng() % 10)));
+    builder.add(VPackValue("tag" + std::to_string(rng() % 10)));
+    builder.close();
+    builder.close();
+  }
+  return documents;
+}
+
+}  // namespace
+
+MICRO_BENCHMARK(VelocyPackCompareDocuments) {
+  auto documents = makeDocuments(1024);
+  size_t i = 0;
+  while (state.keepRunning()) {
+    VPackSlice lhs = documents[i & 1023].slice();
+    VPackSlice rhs = documents[(i * 7 + 1) & 1023].slice();
+    doNotOptimize(basics::VelocyPackHelper::compare(lhs, rhs, true));
+    ++i;
+  }
+}
+
+MICRO_BENCHMARK(VelocyPackCompareStrings) {
+  auto documents = makeDocuments(1024);
+  size_t i = 0;
+  while (state.keepRunning()) {
+    VPackSlice lhs = documents[i & 1023].slice().get("name");
+    VPackSlice rhs = documents[(i * 7 + 1) & 1023].slice().get("name");
+    doNotOptimize(basics::VelocyPackHelper::compare(lhs, rhs, true));
+    ++i;
+  }
+}
+
+MICRO_BENCHMARK(VelocyPackCompareNumbers) {
+  auto documents = makeDocuments(1024);
+  size_t i = 0;
+  while (state.keepRunning()) {
+    VPackSlice lhs = documents[i & 1023].slice().get("score");
+    VPackSlice rhs = documents[(i * 7 + 1) & 1023].slice().get("age");
+    doNotOptimize(basics::VelocyPackHelper::compare(lhs, rhs, true));
+    ++i;
+  }
+}
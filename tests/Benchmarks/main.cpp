@@ -0,0 +1,68 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/ArangoGlobalContext.h"
+#include "Logger/LogAppender.h"
+#include "Logger/Logger.h"
+#include "Random/RandomGenerator.h"
+#include "RocksDBEngine/RocksDBFormat.h"
+#include "tests/Basics/icu-helper.h"
+
+#include "MicroBenchmark.h"
+
+#include <iostream>
+
+char const* ARGV0 = "";
+
+int main(int argc, char* argv[]) {
+  TRI_GET_ARGV(argc, argv);
+  ARGV0 = argv[0];
+
+  double minTime = 0.5;
+  std::vector<std::string> filters;
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+      minTime = std::stod(argv[++i]);
+    } else if (strcmp(argv[i], "--help") == 0) {
+      std::cout << "usage: " << ARGV0 << " [--min-time <seconds>] [<filter>...]"
+                << std::endl
+                << "runs the benchmarks whose names contain one of the filters"
+                << std::endl;
+      return 0;
+    } else {
+      filters.emplace_back(argv[i]);
+    }
+  }
+
+  arangodb::RandomGenerator::initialize(arangodb::RandomGenerator::RandomType::MERSENNE);
+  arangodb::Logger::initialize(false);
+  arangodb::LogAppender::addAppender("-");
+
+  arangodb::ArangoGlobalContext ctx(1, const_cast<char**>(&ARGV0), ".");
+  ctx.exit(0);
+
+  IcuInitializer::setup(ARGV0);
+  arangodb::rocksutils::setRocksDBKeyFormatEndianess(arangodb::RocksDBEndianness::Big);
+
+  int result = arangodb::benchmarks::runBenchmarks(filters, minTime);
+
+  arangodb::Logger::shutdown();
+  return result;
+}
@@ -96,4 +96,39 @@ TEST_CASE("cache::BucketState", "[cache]") {
     REQUIRE(!state.isSet(BucketState::Flag::migrated));
     state.unlock();
   }
+
+  SECTION("test optimistic reads") {
+    BucketState state;
+    uint32_t snapshot;
+
+    REQUIRE(state.beginOptimisticRead(snapshot));
+    REQUIRE(state.validateOptimisticRead(snapshot));
+
+    // any lock invalidates the read, even if it was released again
+    REQUIRE(state.lock());
+    REQUIRE(!state.validateOptimisticRead(snapshot));
+    REQUIRE(!state.beginOptimisticRead(snapshot));
+    state.unlock();
+    REQUIRE(!state.validateOptimisticRead(snapshot));
+
+    // the version does not disturb the flags
+    REQUIRE(state.beginOptimisticRead(snapshot));
+    REQUIRE(state.lock());
+    state.toggleFlag(BucketState::Flag::evictions);
+    state.unlock();
+    REQUIRE(state.lock());
+    REQUIRE(state.isSet(BucketState::Flag::evictions));
+    REQUIRE(!state.isSet(BucketState::Flag::migrated));
+    state.clear();
+    REQUIRE(state.isLocked());
+    REQUIRE(!state.isSet(BucketState::Flag::evictions));
+    state.unlock();
+    REQUIRE(!state.isLocked());
+
+    // migrated buckets must not be read optimistically
+    REQUIRE(state.lock());
+    state.toggleFlag(BucketState::Flag::migrated);
+    state.unlock();
+    REQUIRE(!state.beginOptimisticRead(snapshot));
+  }
 }
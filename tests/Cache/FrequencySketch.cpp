@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for arangodb::cache::FrequencySketch
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Cache/FrequencySketch.h"
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include <stdint.h>
+
+using namespace arangodb::cache;
+
+TEST_CASE("cache::FrequencySketch", "[cache]") {
+  SECTION("test counting of accesses") {
+    FrequencySketch sketch(1024);
+
+    // eight 4-bit counters per entry
+    REQUIRE(FrequencySketch::allocationSize(1024) ==
+            sizeof(FrequencySketch) + 1024 * 8 / 16 * sizeof(uint64_t));
+
+    for (uint32_t hash = 1; hash <= 100; hash++) {
+      REQUIRE(0 == sketch.frequency(hash));
+    }
+
+    for (uint32_t i = 0; i < 3; i++) {
+      sketch.record(42);
+    }
+    REQUIRE(sketch.frequency(42) >= 3);
+    for (uint32_t i = 0; i < 100; i++) {
+      sketch.record(42);
+    }
+    REQUIRE(FrequencySketch::maxFrequency == sketch.frequency(42));
+
+    sketch.record(43);
+    REQUIRE(sketch.frequency(43) >= 1);
+    REQUIRE(sketch.frequency(43) < sketch.frequency(42));
+
+    sketch.clear();
+    REQUIRE(0 == sketch.frequency(42));
+    REQUIRE(0 == sketch.frequency(43));
+  }
+
+  SECTION("test aging of counters") {
+    FrequencySketch sketch(128);
+
+    for (uint32_t i = 0; i < FrequencySketch::maxFrequency; i++) {
+      sketch.record(42);
+    }
+    REQUIRE(FrequencySketch::maxFrequency == sketch.frequency(42));
+
+    // lots of keys accessed once make the sketch halve all counters
+    for (uint32_t hash = 1000; hash < 1000 + 10 * 128; hash++) {
+      sketch.record(hash);
+      if (sketch.frequency(42) < FrequencySketch::maxFrequency) {
+        break;
+      }
+    }
+    REQUIRE(sketch.frequency(42) <= FrequencySketch::maxFrequency / 2 + 1);
+  }
+}
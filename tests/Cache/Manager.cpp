@@ -29,6 +29,7 @@
 #include "Basics/Common.h"
 #include "Cache/CacheManagerFeatureThreads.h"
 #include "Cache/Common.h"
+#include "Cache/NumaNodes.h"
 #include "Cache/PlainCache.h"
 #include "Random/RandomGenerator.h"
 
@@ -64,6 +65,28 @@ TEST_CASE("cache::Manager", "[cache][!hide][longRunning]") {
     REQUIRE(bigRequestLimit > bigManager.globalAllocation());
   }
 
+  SECTION("test table allocation per numa node") {
+    auto postFn = [](std::function<void()>) -> bool { return false; };
+    Manager manager(postFn, 1024ULL * 1024ULL * 1024ULL);
+
+    auto before = manager.tableAllocationPerNode();
+    REQUIRE(before.size() == NumaNodes::count());
+    for (uint64_t allocation : before) {
+      REQUIRE(allocation == 0);
+    }
+
+    auto cache = manager.createCache(CacheType::Plain);
+    REQUIRE(cache.get() != nullptr);
+    uint64_t total = 0;
+    for (uint64_t allocation : manager.tableAllocationPerNode()) {
+      total += allocation;
+    }
+    REQUIRE(total >= Table::allocationSize(Table::minLogSize));
+    REQUIRE(total < manager.globalAllocation());
+
+    manager.destroyCache(cache);
+  }
+
   SECTION("test mixed cache types under mixed load") {
     RandomGenerator::initialize(RandomGenerator::RandomType::MERSENNE);
     MockScheduler scheduler(4);
@@ -135,6 +135,47 @@ TEST_CASE("cache::PlainBucket", "[cache]") {
     }
   }
 
+  SECTION("verify lookups without lock work correctly") {
+    auto bucket = std::make_unique<PlainBucket>();
+    bool success;
+
+    uint32_t hashes[2] = {1, 2};
+    uint64_t keys[2] = {0, 1};
+    uint64_t values[2] = {0, 1};
+    CachedValue* ptrs[2];
+    for (size_t i = 0; i < 2; i++) {
+      ptrs[i] = CachedValue::construct(&(keys[i]), sizeof(uint64_t),
+                                       &(values[i]), sizeof(uint64_t));
+      TRI_ASSERT(ptrs[i] != nullptr);
+    }
+
+    REQUIRE(bucket->lacks(hashes[0]));
+    REQUIRE(bucket->lacks(hashes[1]));
+
+    success = bucket->lock(-1LL);
+    REQUIRE(success);
+    bucket->insert(hashes[0], ptrs[0]);
+    // cannot tell while the bucket is locked
+    REQUIRE(!bucket->lacks(hashes[1]));
+    bucket->unlock();
+
+    REQUIRE(!bucket->lacks(hashes[0]));
+    REQUIRE(bucket->lacks(hashes[1]));
+
+    success = bucket->lock(-1LL);
+    REQUIRE(success);
+    CachedValue* res = bucket->remove(hashes[0], ptrs[0]->key(), ptrs[0]->keySize());
+    REQUIRE(res == ptrs[0]);
+    bucket->unlock();
+
+    REQUIRE(bucket->lacks(hashes[0]));
+
+    // cleanup
+    for (size_t i = 0; i < 2; i++) {
+      delete ptrs[i];
+    }
+  }
+
   SECTION("verify eviction works correctly") {
     auto bucket = std::make_unique<PlainBucket>();
     bool success;
@@ -36,6 +36,7 @@
 #include "catch.hpp"
 
 #include <stdint.h>
+#include <set>
 #include <string>
 #include <thread>
 #include <vector>
@@ -169,6 +170,84 @@ TEST_CASE("cache::PlainCache", "[cache][!hide][longRunning]") {
     manager.destroyCache(cache);
   }
 
+  SECTION("verify that the keys of cached values can be collected") {
+    uint64_t cacheLimit = 256 * 1024;
+    auto postFn = [](std::function<void()>) -> bool { return false; };
+    Manager manager(postFn, 4 * cacheLimit);
+    auto cache = manager.createCache(CacheType::Plain, false, cacheLimit);
+
+    std::set<uint64_t> inserted;
+    for (uint64_t i = 0; i < 1024; i++) {
+      CachedValue* value =
+          CachedValue::construct(&i, sizeof(uint64_t), &i, sizeof(uint64_t));
+      TRI_ASSERT(value != nullptr);
+      auto status = cache->insert(value);
+      if (status.ok()) {
+        inserted.emplace(i);
+      } else {
+        delete value;
+      }
+    }
+    REQUIRE(inserted.size() > 10);
+
+    auto keys = cache->keys(10);
+    REQUIRE(keys.size() == 10);
+
+    keys = cache->keys(UINT64_MAX);
+    REQUIRE(keys.size() <= inserted.size());
+    std::set<uint64_t> found;
+    for (auto const& key : keys) {
+      REQUIRE(key.size() == sizeof(uint64_t));
+      uint64_t i;
+      memcpy(&i, key.data(), sizeof(uint64_t));
+      REQUIRE(inserted.find(i) != inserted.end());
+      REQUIRE(found.emplace(i).second);
+    }
+
+    manager.destroyCache(cache);
+  }
+
+  SECTION("verify that the lifetime counters are maintained") {
+    uint64_t cacheLimit = 256 * 1024;
+    auto postFn = [](std::function<void()>) -> bool { return false; };
+    Manager manager(postFn, 4 * cacheLimit);
+    auto cache = manager.createCache(CacheType::Plain, false, cacheLimit);
+
+    auto stats = cache->statistics();
+    REQUIRE(stats.inserts == 0);
+    REQUIRE(stats.evictions == 0);
+    REQUIRE(stats.insertRejections == 0);
+
+    uint64_t inserted = 0;
+    uint64_t rejected = 0;
+    for (uint64_t i = 0; i < 4096; i++) {
+      CachedValue* value =
+          CachedValue::construct(&i, sizeof(uint64_t), &i, sizeof(uint64_t));
+      TRI_ASSERT(value != nullptr);
+      auto status = cache->insert(value);
+      if (status.ok()) {
+        inserted++;
+      } else {
+        if (status.errorNumber() != TRI_ERROR_LOCK_TIMEOUT) {
+          rejected++;
+        }
+        delete value;
+      }
+    }
+    for (uint64_t i = 0; i < 4096; i++) {
+      cache->find(&i, sizeof(uint64_t));
+    }
+
+    stats = cache->statistics();
+    REQUIRE(stats.inserts == inserted);
+    REQUIRE(stats.evictions <= inserted);
+    REQUIRE(stats.insertRejections == rejected);
+    REQUIRE(stats.findHits + stats.findMisses > 0);
+    REQUIRE(stats.findHits + stats.findMisses <= 8 * 4096);
+
+    manager.destroyCache(cache);
+  }
+
   SECTION("verify that cache can indeed grow when it runs out of space") {
     uint64_t minimumUsage = 1024 * 1024;
     MockScheduler scheduler(4);
@@ -28,6 +28,7 @@
 #include "Cache/Table.h"
 #include "Basics/Common.h"
 #include "Cache/Common.h"
+#include "Cache/NumaNodes.h"
 #include "Cache/PlainBucket.h"
 
 #include "catch.hpp"
@@ -53,9 +54,30 @@ TEST_CASE("cache::Table", "[cache]") {
               (sizeof(Table) + (BUCKET_SIZE << i) + Table::padding));
       REQUIRE(table->logSize() == i);
       REQUIRE(table->size() == (static_cast<uint64_t>(1) << i));
+      REQUIRE(table->numaNode() < NumaNodes::count());
     }
   }
 
+  SECTION("test lazy allocation of the frequency sketch") {
+    auto table = std::make_shared<Table>(Table::minLogSize);
+    REQUIRE(table.get() != nullptr);
+    table->enable();
+
+    FrequencySketch* sketch = table->sketch();
+    REQUIRE(sketch != nullptr);
+    REQUIRE(table->sketch() == sketch);
+    sketch->record(42);
+    REQUIRE(sketch->frequency(42) >= 1);
+
+    // the sketch is freed with the table's contents, and a new one starts
+    // from scratch
+    table->clear();
+    REQUIRE(table->memoryUsage() == Table::allocationSize(Table::minLogSize));
+    sketch = table->sketch();
+    REQUIRE(sketch != nullptr);
+    REQUIRE(0 == sketch->frequency(42));
+  }
+
   SECTION("test basic bucket-fetching behavior") {
     auto table = std::make_shared<Table>(Table::minLogSize);
     REQUIRE(table.get() != nullptr);
@@ -41,7 +41,7 @@ using namespace arangodb::rest;
 class ClusterCommTester : public ClusterComm {
  public:
   ClusterCommTester()
-      : ClusterComm(false), _oldSched(nullptr), _testerSched(1, 2, 3, 4, 5) {
+      : ClusterComm(false), _oldSched(nullptr), _testerSched(1, 2, 3, 4, 5, 0.0) {
     // fake a scheduler object
     _oldSched = SchedulerFeature::SCHEDULER;
     SchedulerFeature::SCHEDULER = &_testerSched;
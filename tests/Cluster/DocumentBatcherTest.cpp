@@ -0,0 +1,266 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for DocumentBatcher
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Basics/StaticStrings.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Cluster/DocumentBatcher.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <thread>
+
+using namespace arangodb;
+
+namespace {
+
+/// @brief answers each document with its "value" attribute, and with an
+/// error for documents that have "fail" set
+DocumentBatcher::Result echo(std::vector<size_t>& batchSizes,
+                             VPackSlice documents) {
+  batchSizes.push_back(documents.length());
+
+  DocumentBatcher::Result result;
+  result.code = rest::ResponseCode::ACCEPTED;
+  result.body = std::make_shared<VPackBuilder>();
+  result.body->openArray();
+  for (VPackSlice doc : VPackArrayIterator(documents)) {
+    result.body->openObject();
+    if (doc.get("fail").isTrue()) {
+      result.body->add(StaticStrings::Error, VPackValue(true));
+      result.body->add(StaticStrings::ErrorNum,
+                       VPackValue(TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED));
+    } else {
+      result.body->add("value", doc.get("value"));
+    }
+    result.body->close();
+  }
+  result.body->close();
+  return result;
+}
+
+}  // namespace
+
+TEST_CASE("DocumentBatcher", "[cluster][batcher]") {
+  std::vector<size_t> batchSizes;
+  std::mutex mutex;
+
+  auto send = [&](rest::RequestType, std::string const&, std::string const&,
+                  VPackSlice documents) {
+    std::lock_guard<std::mutex> guard(mutex);
+    return ::echo(batchSizes, documents);
+  };
+
+  SECTION("a single operation is sent after the window") {
+    DocumentBatcher batcher(std::chrono::microseconds(1000), 10, send);
+
+    auto doc = VPackParser::fromJson("{\"value\":42}");
+    auto r = batcher.execute(rest::RequestType::POST, "s1", "/url", doc->slice());
+
+    CHECK(r.error == TRI_ERROR_NO_ERROR);
+    CHECK(r.code == rest::ResponseCode::ACCEPTED);
+    REQUIRE(r.body != nullptr);
+    CHECK(r.body->slice().isObject());
+    CHECK(r.body->slice().get("value").getNumber<int>() == 42);
+    CHECK(batcher.numRequests() == 1);
+    CHECK(batchSizes == std::vector<size_t>{1});
+  }
+
+  SECTION("concurrent operations are combined and results are split") {
+    size_t const n = 4;
+    // the window is long enough for all threads to join, the batch is
+    // sent as soon as it is full
+    DocumentBatcher batcher(std::chrono::microseconds(60 * 1000 * 1000), n, send);
+
+    std::vector<DocumentBatcher::Result> results(n);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < n; ++i) {
+      threads.emplace_back([&batcher, &results, i]() {
+        VPackBuilder doc;
+        doc.openObject();
+        doc.add("value", VPackValue(i));
+        doc.add("fail", VPackValue(i == 2));
+        doc.close();
+        results[i] = batcher.execute(rest::RequestType::POST, "s1", "/url", doc.slice());
+      });
+    }
+    for (auto& t : threads) {
+      t.join();
+    }
+
+    CHECK(batcher.numRequests() == 1);
+    CHECK(batchSizes == std::vector<size_t>{n});
+    for (size_t i = 0; i < n; ++i) {
+      auto const& r = results[i];
+      CHECK(r.error == TRI_ERROR_NO_ERROR);
+      REQUIRE(r.body != nullptr);
+      if (i == 2) {
+        CHECK(r.code == rest::ResponseCode::CONFLICT);
+        CHECK(r.body->slice().get(StaticStrings::ErrorNum).getNumber<int>() ==
+              TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED);
+      } else {
+        CHECK(r.code == rest::ResponseCode::ACCEPTED);
+        CHECK(r.body->slice().get("value").getNumber<size_t>() == i);
+      }
+    }
+  }
+
+  SECTION("operations on different urls are not combined") {
+    DocumentBatcher batcher(std::chrono::microseconds(1000), 10, send);
+
+    auto doc = VPackParser::fromJson("{\"value\":1}");
+    batcher.execute(rest::RequestType::POST, "s1", "/url1", doc->slice());
+    batcher.execute(rest::RequestType::POST, "s2", "/url2", doc->slice());
+
+    CHECK(batcher.numRequests() == 2);
+    CHECK(batchSizes == (std::vector<size_t>{1, 1}));
+  }
+
+  SECTION("operations for different destinations are not combined") {
+    // each batch is sent as soon as both operations for its destination
+    // have joined
+    DocumentBatcher batcher(std::chrono::microseconds(60 * 1000 * 1000), 2, send);
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 4; ++i) {
+      threads.emplace_back([&batcher, i]() {
+        auto doc = VPackParser::fromJson("{\"value\":1}");
+        batcher.execute(rest::RequestType::POST, (i % 2 == 0) ? "f1" : "f2",
+                        "/url", doc->slice());
+      });
+    }
+    for (auto& t : threads) {
+      t.join();
+    }
+
+    CHECK(batcher.numRequests() == 2);
+    CHECK(batchSizes == (std::vector<size_t>{2, 2}));
+  }
+
+  SECTION("a failed request fails all operations of the batch") {
+    DocumentBatcher batcher(std::chrono::microseconds(1000), 10,
+                            [](rest::RequestType, std::string const&,
+                               std::string const&, VPackSlice) {
+                              DocumentBatcher::Result result;
+                              result.error = TRI_ERROR_CLUSTER_TIMEOUT;
+                              return result;
+                            });
+
+    auto doc = VPackParser::fromJson("{\"value\":1}");
+    auto r = batcher.execute(rest::RequestType::PATCH, "s1", "/url", doc->slice());
+    CHECK(r.error == TRI_ERROR_CLUSTER_TIMEOUT);
+  }
+
+  SECTION("follower answers are split into per-document response codes") {
+    auto ok = VPackParser::fromJson("[{},{}]");
+    auto failed = VPackParser::fromJson("[{},{\"error\":true,\"errorNum\":1210}]");
+
+    std::vector<DocumentBatcher::FollowerAnswer> answers(3);
+    answers[0].received = true;
+    answers[0].code = rest::ResponseCode::ACCEPTED;
+    answers[0].body = ok->slice();
+    answers[1].received = true;
+    answers[1].code = rest::ResponseCode::ACCEPTED;
+    answers[1].body = failed->slice();
+    // the third follower did not answer
+
+    auto r = DocumentBatcher::followerResult({"f1", "f2", "f3"}, answers, 2);
+    CHECK(r.error == TRI_ERROR_NO_ERROR);
+    REQUIRE(r.body != nullptr);
+    auto expected = VPackParser::fromJson(
+        "[{\"f1\":202,\"f2\":202,\"f3\":0},{\"f1\":202,\"f2\":409,\"f3\":0}]");
+    CHECK(0 == basics::VelocyPackHelper::compare(expected->slice(), r.body->slice(), true));
+  }
+
+  SECTION("a follower answer without per-document results counts for all") {
+    auto refusal = VPackParser::fromJson("{\"error\":true,\"errorNum\":1489}");
+
+    std::vector<DocumentBatcher::FollowerAnswer> answers(1);
+    answers[0].received = true;
+    answers[0].code = rest::ResponseCode::NOT_ACCEPTABLE;
+    answers[0].body = refusal->slice();
+
+    auto r = DocumentBatcher::followerResult({"f1"}, answers, 2);
+    REQUIRE(r.body != nullptr);
+    auto expected = VPackParser::fromJson("[{\"f1\":406},{\"f1\":406}]");
+    CHECK(0 == basics::VelocyPackHelper::compare(expected->slice(), r.body->slice(), true));
+  }
+
+  SECTION("concurrent replications to the same followers are combined") {
+    size_t const n = 2;
+    std::vector<std::string> const followers{"f1", "f2"};
+
+    // the first follower accepts the batch as a whole, the second one
+    // answers per document and fails the documents that have "fail" set
+    DocumentBatcher batcher(
+        std::chrono::microseconds(60 * 1000 * 1000), n,
+        [&](rest::RequestType, std::string const& destination, std::string const&,
+            VPackSlice documents) {
+          std::vector<DocumentBatcher::FollowerAnswer> answers(followers.size());
+          std::vector<size_t> unused;
+          auto accepted = ::echo(unused, documents);
+          answers[0].received = true;
+          answers[0].code = rest::ResponseCode::ACCEPTED;
+          answers[0].body = VPackSlice::emptyArraySlice();
+          answers[1].received = true;
+          answers[1].code = rest::ResponseCode::ACCEPTED;
+          answers[1].body = accepted.body->slice();
+
+          std::lock_guard<std::mutex> guard(mutex);
+          batchSizes.push_back(documents.length());
+          CHECK(destination == "f1,f2");
+          return DocumentBatcher::followerResult(followers, answers, documents.length());
+        });
+
+    std::vector<DocumentBatcher::Result> results(n);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < n; ++i) {
+      threads.emplace_back([&batcher, &results, i]() {
+        VPackBuilder doc;
+        doc.openObject();
+        doc.add("value", VPackValue(i));
+        doc.add("fail", VPackValue(i == 1));
+        doc.close();
+        results[i] = batcher.execute(rest::RequestType::POST, "f1,f2", "/url", doc.slice());
+      });
+    }
+    for (auto& t : threads) {
+      t.join();
+    }
+
+    CHECK(batcher.numRequests() == 1);
+    CHECK(batchSizes == std::vector<size_t>{n});
+    for (size_t i = 0; i < n; ++i) {
+      auto const& r = results[i];
+      CHECK(r.error == TRI_ERROR_NO_ERROR);
+      REQUIRE(r.body != nullptr);
+      CHECK(r.body->slice().get("f1").getNumber<int>() == 202);
+      CHECK(r.body->slice().get("f2").getNumber<int>() == (i == 1 ? 409 : 202));
+    }
+  }
+}
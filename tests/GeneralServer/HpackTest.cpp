@@ -0,0 +1,216 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for HPACK header compression
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "GeneralServer/Hpack.h"
+
+using namespace arangodb::rest::hpack;
+
+namespace {
+
+std::string fromHex(std::string const& hex) {
+  std::string result;
+  for (size_t i = 0; i + 1 < hex.size(); i += 2) {
+    result.push_back(static_cast<char>(std::stoi(hex.substr(i, 2), nullptr, 16)));
+  }
+  return result;
+}
+
+bool decode(Decoder& decoder, std::string const& block, std::vector<HeaderField>& fields) {
+  fields.clear();
+  return decoder.decode(reinterpret_cast<uint8_t const*>(block.data()),
+                        block.size(), fields);
+}
+
+std::vector<HeaderField> const firstRequest = {{":method", "GET"},
+                                               {":scheme", "http"},
+                                               {":path", "/"},
+                                               {":authority", "www.example.com"}};
+
+std::vector<HeaderField> const secondRequest = {{":method", "GET"},
+                                                {":scheme", "http"},
+                                                {":path", "/"},
+                                                {":authority", "www.example.com"},
+                                                {"cache-control", "no-cache"}};
+
+std::vector<HeaderField> const thirdRequest = {{":method", "GET"},
+                                               {":scheme", "https"},
+                                               {":path", "/index.html"},
+                                               {":authority", "www.example.com"},
+                                               {"custom-key", "custom-value"}};
+
+}  // namespace
+
+TEST_CASE("HpackTest", "[hpack]") {
+
+SECTION("integers") {
+  std::string out;
+  encodeInteger(10, 5, 0x00, out);
+  CHECK(out == fromHex("0a"));
+
+  out.clear();
+  encodeInteger(1337, 5, 0xe0, out);
+  CHECK(out == fromHex("ff9a0a"));
+
+  uint64_t value;
+  uint8_t const* p = reinterpret_cast<uint8_t const*>(out.data());
+  REQUIRE(decodeInteger(p, p + out.size(), 5, value));
+  CHECK(value == 1337);
+
+  // truncated
+  p = reinterpret_cast<uint8_t const*>(out.data());
+  CHECK_FALSE(decodeInteger(p, p + 2, 5, value));
+
+  // overflow
+  std::string huge = fromHex("1fffffffffffffffffff7f");
+  p = reinterpret_cast<uint8_t const*>(huge.data());
+  CHECK_FALSE(decodeInteger(p, p + huge.size(), 5, value));
+}
+
+SECTION("huffman code") {
+  std::string out;
+  std::string const value = "www.example.com";
+  huffmanEncode(value.data(), value.size(), out);
+  CHECK(out == fromHex("f1e3c2e5f23a6ba0ab90f4ff"));
+  CHECK(huffmanEncodedLength(value.data(), value.size()) == out.size());
+
+  std::string all;
+  for (int c = 0; c < 256; ++c) {
+    all.push_back(static_cast<char>(c));
+  }
+  out.clear();
+  huffmanEncode(all.data(), all.size(), out);
+  std::string decoded;
+  REQUIRE(huffmanDecode(reinterpret_cast<uint8_t const*>(out.data()), out.size(), decoded));
+  CHECK(decoded == all);
+}
+
+SECTION("huffman padding") {
+  std::string decoded;
+  // 'a' is 00011, padded with ones
+  std::string valid = fromHex("1f");
+  CHECK(huffmanDecode(reinterpret_cast<uint8_t const*>(valid.data()), 1, decoded));
+  CHECK(decoded == "a");
+
+  // padding with zeros
+  std::string zeros = fromHex("18");
+  CHECK_FALSE(huffmanDecode(reinterpret_cast<uint8_t const*>(zeros.data()), 1, decoded));
+
+  // padding longer than 7 bits
+  std::string longer = fromHex("1fff");
+  CHECK_FALSE(huffmanDecode(reinterpret_cast<uint8_t const*>(longer.data()), 2, decoded));
+
+  // EOS in the string
+  std::string eos = fromHex("ffffffff");
+  CHECK_FALSE(huffmanDecode(reinterpret_cast<uint8_t const*>(eos.data()), 4, decoded));
+}
+
+SECTION("requests without huffman coding, RFC 7541 C.3") {
+  Decoder decoder;
+  std::vector<HeaderField> fields;
+
+  REQUIRE(decode(decoder, fromHex("828684410f7777772e6578616d706c652e636f6d"), fields));
+  CHECK(fields == firstRequest);
+  CHECK(decoder.tableSize() == 57);
+
+  REQUIRE(decode(decoder, fromHex("828684be58086e6f2d6361636865"), fields));
+  CHECK(fields == secondRequest);
+  CHECK(decoder.tableSize() == 110);
+
+  REQUIRE(decode(decoder, fromHex("828785bf400a637573746f6d2d6b65790c637573746f6d2d76616c7565"), fields));
+  CHECK(fields == thirdRequest);
+  CHECK(decoder.tableSize() == 164);
+}
+
+SECTION("requests with huffman coding, RFC 7541 C.4") {
+  Decoder decoder;
+  std::vector<HeaderField> fields;
+
+  REQUIRE(decode(decoder, fromHex("828684418cf1e3c2e5f23a6ba0ab90f4ff"), fields));
+  CHECK(fields == firstRequest);
+
+  REQUIRE(decode(decoder, fromHex("828684be5886a8eb10649cbf"), fields));
+  CHECK(fields == secondRequest);
+
+  REQUIRE(decode(decoder, fromHex("828785bf408825a849e95ba97d7f8925a849e95bb8e8b4bf"), fields));
+  CHECK(fields == thirdRequest);
+  CHECK(decoder.tableSize() == 164);
+}
+
+SECTION("eviction") {
+  Decoder decoder(100);
+  std::vector<HeaderField> fields;
+
+  REQUIRE(decode(decoder, fromHex("828684410f7777772e6578616d706c652e636f6d"), fields));
+  CHECK(decoder.tableSize() == 57);
+
+  // cache-control: no-cache evicts :authority
+  REQUIRE(decode(decoder, fromHex("58086e6f2d6361636865"), fields));
+  CHECK(decoder.tableSize() == 53);
+  CHECK_FALSE(decode(decoder, fromHex("bf"), fields));
+
+  // table size update to 0 empties the table
+  REQUIRE(decode(decoder, fromHex("2082"), fields));
+  CHECK(decoder.tableSize() == 0);
+  CHECK(fields == std::vector<HeaderField>{{":method", "GET"}});
+
+  // larger than announced
+  CHECK_FALSE(decode(decoder, fromHex("3f46"), fields));
+  // not at the start of the block
+  CHECK_FALSE(decode(decoder, fromHex("8220"), fields));
+}
+
+SECTION("invalid blocks") {
+  Decoder decoder;
+  std::vector<HeaderField> fields;
+
+  // index 0
+  CHECK_FALSE(decode(decoder, fromHex("80"), fields));
+  // index beyond the tables
+  CHECK_FALSE(decode(decoder, fromHex("be"), fields));
+  // string longer than the block
+  CHECK_FALSE(decode(decoder, fromHex("410f7777"), fields));
+}
+
+SECTION("encoder") {
+  std::vector<HeaderField> const response = {{":status", "200"},
+                                             {":status", "302"},
+                                             {"content-type", "application/json; charset=utf-8"},
+                                             {"x-content-type-options", "nosniff"},
+                                             {"server", "ArangoDB"}};
+  std::string block;
+  for (auto const& f : response) {
+    Encoder::encode(f.first, f.second, block);
+  }
+  CHECK(block.substr(0, 1) == fromHex("88"));
+
+  Decoder decoder;
+  std::vector<HeaderField> fields;
+  REQUIRE(decode(decoder, block, fields));
+  CHECK(fields == response);
+  CHECK(decoder.tableSize() == 0);
+}
+
+}
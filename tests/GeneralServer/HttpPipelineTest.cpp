@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "GeneralServer/HttpPipeline.h"
+
+using namespace arangodb::rest;
+
+namespace {
+
+struct TestRequest {
+  uint64_t messageId = 0;
+  bool safe = true;
+  std::unique_ptr<std::string> response;
+};
+
+std::shared_ptr<TestRequest> makeRequest(uint64_t messageId, RequestType type) {
+  auto request = std::make_shared<TestRequest>();
+  request->messageId = messageId;
+  request->safe = HttpPipeline<TestRequest>::isSafe(type);
+  return request;
+}
+
+/// @brief the message ids of the responses written
+std::vector<uint64_t> written(HttpPipeline<TestRequest>& pipeline) {
+  std::vector<uint64_t> result;
+  pipeline.popReady([&result](TestRequest& request) {
+    result.push_back(request.messageId);
+  });
+  return result;
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+TEST_CASE("HttpPipeline", "[http]") {
+  HttpPipeline<TestRequest> pipeline(3);
+
+  SECTION("safe methods") {
+    CHECK((HttpPipeline<TestRequest>::isSafe(RequestType::GET)));
+    CHECK((HttpPipeline<TestRequest>::isSafe(RequestType::HEAD)));
+    CHECK((HttpPipeline<TestRequest>::isSafe(RequestType::OPTIONS)));
+    CHECK((!HttpPipeline<TestRequest>::isSafe(RequestType::POST)));
+    CHECK((!HttpPipeline<TestRequest>::isSafe(RequestType::PUT)));
+    CHECK((!HttpPipeline<TestRequest>::isSafe(RequestType::DELETE_REQ)));
+    CHECK((!HttpPipeline<TestRequest>::isSafe(RequestType::PATCH)));
+  }
+
+  SECTION("requests with safe methods run concurrently up to the limit") {
+    CHECK((pipeline.canExecute(RequestType::GET)));
+    pipeline.push(makeRequest(2, RequestType::GET));
+    CHECK((pipeline.canExecute(RequestType::HEAD)));
+    pipeline.push(makeRequest(3, RequestType::HEAD));
+    CHECK((pipeline.canExecute(RequestType::GET)));
+    pipeline.push(makeRequest(4, RequestType::GET));
+    CHECK((!pipeline.canExecute(RequestType::GET)));
+    CHECK((3 == pipeline.size()));
+  }
+
+  SECTION("a request with another method runs on its own") {
+    CHECK((pipeline.canExecute(RequestType::POST)));
+    pipeline.push(makeRequest(2, RequestType::GET));
+    CHECK((!pipeline.canExecute(RequestType::POST)));
+
+    pipeline.front()->response.reset(new std::string("a"));
+    CHECK((std::vector<uint64_t>{2} == written(pipeline)));
+    CHECK((pipeline.canExecute(RequestType::POST)));
+
+    // no request starts before it is answered
+    pipeline.push(makeRequest(3, RequestType::POST));
+    CHECK((!pipeline.canExecute(RequestType::GET)));
+    CHECK((!pipeline.canExecute(RequestType::POST)));
+  }
+
+  SECTION("responses are written in request order") {
+    pipeline.push(makeRequest(2, RequestType::GET));
+    pipeline.push(makeRequest(3, RequestType::GET));
+    pipeline.push(makeRequest(4, RequestType::GET));
+
+    // a later response waits for the earlier ones
+    pipeline.find(3)->response.reset(new std::string("b"));
+    CHECK((written(pipeline).empty()));
+
+    pipeline.find(2)->response.reset(new std::string("a"));
+    CHECK((std::vector<uint64_t>{2, 3} == written(pipeline)));
+    CHECK((1 == pipeline.size()));
+
+    pipeline.find(4)->response.reset(new std::string("c"));
+    CHECK((std::vector<uint64_t>{4} == written(pipeline)));
+    CHECK((pipeline.empty()));
+  }
+
+  SECTION("unknown requests are not found") {
+    pipeline.push(makeRequest(2, RequestType::GET));
+    CHECK((nullptr != pipeline.find(2)));
+    CHECK((nullptr == pipeline.find(3)));
+
+    // written requests are gone
+    pipeline.find(2)->response.reset(new std::string("a"));
+    written(pipeline);
+    CHECK((nullptr == pipeline.find(2)));
+  }
+}
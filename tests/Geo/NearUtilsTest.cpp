@@ -34,6 +34,7 @@
 #include <s2/s1angle.h>
 #include <s2/s2metrics.h>
 #include <s2/s2latlng.h>
+#include <s2/s2latlng_rect.h>
 #include <velocypack/Builder.h>
 #include <velocypack/Parser.h>
 #include <velocypack/velocypack-aliases.h>
@@ -193,6 +194,23 @@ TEST_CASE("Simple near queries", "[geo][s2index]") {
     REQUIRE(coords[4] == S2LatLng::FromDegrees(1,0));
   }
 
+  SECTION("query all sorted ascending with limit in params") {
+    params.ascending = true;
+    params.limit = 5;
+    AscIterator near(std::move(params));
+
+    std::vector<LocalDocumentId> result = nearSearch(index, docs, near, 5);
+    REQUIRE(result.size() == 5);
+
+    std::vector<S2LatLng> coords = convert(docs, result);
+    std::sort(coords.begin(), coords.end());
+    REQUIRE(coords[0] == S2LatLng::FromDegrees(-1,0));
+    REQUIRE(coords[1] == S2LatLng::FromDegrees(0,-1));
+    REQUIRE(coords[2] == S2LatLng::FromDegrees(0,0));
+    REQUIRE(coords[3] == S2LatLng::FromDegrees(0,1));
+    REQUIRE(coords[4] == S2LatLng::FromDegrees(1,0));
+  }
+
   SECTION("query sorted ascending with limit and max distance") {
     params.ascending = true;
     params.maxDistance = 111200.0;
@@ -476,4 +494,88 @@ TEST_CASE("Query points contained in", "[geo][s2index]") {
   }
 }
 
+TEST_CASE("Filter by index values", "[geo][s2index]") {
+  geo::QueryParams params;
+  params.sorted = true;
+  params.ascending = true;
+  params.filterType = geo::FilterType::CONTAINS;
+
+  auto rect = createBuilder(R"=({"type": "Polygon", "coordinates":[[[0,0],[10,0],[10,10],[0,10],[0,0]]]})=");
+  geo::geojson::parsePolygon(rect->slice(), params.filterShape);
+  params.filterShape.updateBounds(params);
+
+  AscIterator near(std::move(params));
+
+  // shapes outside of the filter bounds are rejected without reading them
+  S2LatLngRect outside(S2LatLng::FromDegrees(20, 20), S2LatLng::FromDegrees(30, 30));
+  near.reportFound(LocalDocumentId(1), S2LatLng::FromDegrees(5, 5).ToPoint(), &outside);
+  CHECK(1 == near._rejection);
+  CHECK(0 == near._found);
+
+  // shapes within the filter bounds still need the exact test
+  S2LatLngRect inside(S2LatLng::FromDegrees(1, 1), S2LatLng::FromDegrees(2, 2));
+  near.reportFound(LocalDocumentId(2), S2LatLng::FromDegrees(1.5, 1.5).ToPoint(), &inside);
+  CHECK(1 == near._rejection);
+  CHECK(1 == near._found);
+
+  // points are tested exactly
+  S2LatLng point = S2LatLng::FromDegrees(-1, 5);
+  S2LatLngRect pointBound = S2LatLngRect::FromPoint(point);
+  near.reportFound(LocalDocumentId(3), point.ToPoint(), &pointBound);
+  CHECK(2 == near._rejection);
+  CHECK(1 == near._found);
+
+  point = S2LatLng::FromDegrees(3, 3);
+  pointBound = S2LatLngRect::FromPoint(point);
+  near.reportFound(LocalDocumentId(4), point.ToPoint(), &pointBound);
+  CHECK(2 == near._rejection);
+  CHECK(2 == near._found);
+}
+
+TEST_CASE("Scan intervals of adjacent cells", "[geo][s2index]") {
+  geo::QueryParams params;
+  params.pointsOnly = true;
+  params.cover.worstIndexedLevel = 4;
+
+  S2CellId cell = S2CellId(S2LatLng::FromDegrees(5, 5)).parent(10);
+  std::vector<S2CellId> cover{cell, cell.next(), cell.next().next().next()};
+
+  std::vector<geo::Interval> intervals;
+  geo::GeoUtils::scanIntervals(params, cover, intervals);
+
+  // the first two cells are scanned as one range
+  REQUIRE(2 == intervals.size());
+  CHECK(cell.range_min() == intervals[0].range_min);
+  CHECK(cell.next().range_max() == intervals[0].range_max);
+  CHECK(cover[2].range_min() == intervals[1].range_min);
+  CHECK(cover[2].range_max() == intervals[1].range_max);
+}
+
+TEST_CASE("Near query in sparse regions", "[geo][s2index]") {
+  // a handful of points, far away from the query origin
+  index_t index;
+  coords_t docs;
+  size_t counter = 0;
+  for (double lon = 100; lon <= 104; ++lon) {
+    S2LatLng cc = S2LatLng::FromDegrees(40, lon);
+    LocalDocumentId rev(counter++);
+    index.emplace(S2CellId(cc.ToPoint()), rev);
+    docs.emplace(rev, cc);
+  }
+
+  geo::QueryParams params;
+  params.sorted = true;
+  params.ascending = true;
+  params.limit = 3;
+  params.origin = S2LatLng::FromDegrees(-10, -10);
+  AscIterator near(std::move(params));
+
+  std::vector<LocalDocumentId> result = nearSearch(index, docs, near, 3);
+  REQUIRE(result.size() == 3);
+  std::vector<S2LatLng> coords = convert(docs, result);
+  CHECK(coords[0] == S2LatLng::FromDegrees(40, 100));
+  CHECK(coords[1] == S2LatLng::FromDegrees(40, 101));
+  CHECK(coords[2] == S2LatLng::FromDegrees(40, 102));
+}
+
 /* end of NearUtilsTest.cpp  */
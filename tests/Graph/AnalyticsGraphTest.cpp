@@ -0,0 +1,88 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2019 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Graph/AnalyticsGraph.h"
+
+#include <velocypack/StringRef.h>
+
+using namespace arangodb;
+using namespace arangodb::graph;
+
+namespace arangodb {
+namespace tests {
+namespace graph {
+
+TEST_CASE("AnalyticsGraph", "[graph]") {
+  // a triangle a, b, c with a tail to d, and a separate edge from e to f
+  AnalyticsGraph graph;
+  for (auto const& edge : std::vector<std::pair<std::string, std::string>>{
+           {"v/a", "v/b"}, {"v/b", "v/c"}, {"v/c", "v/a"}, {"v/c", "v/d"}, {"v/e", "v/f"}}) {
+    graph.addEdge(velocypack::StringRef(edge.first), velocypack::StringRef(edge.second));
+  }
+  graph.finish();
+
+  REQUIRE(graph.numVertices() == 6);
+  REQUIRE(graph.numEdges() == 5);
+  REQUIRE(graph.vertex(0) == "v/a");
+  REQUIRE(graph.vertex(5) == "v/f");
+
+  SECTION("connected components") {
+    auto components = graph.connectedComponents();
+    for (AnalyticsGraph::VertexId v = 0; v < 4; ++v) {
+      CHECK(graph.vertex(components[v]) == "v/a");
+    }
+    CHECK(graph.vertex(components[4]) == "v/e");
+    CHECK(graph.vertex(components[5]) == "v/e");
+  }
+
+  SECTION("degree centrality") {
+    auto any = graph.degreeCentrality(TRI_EDGE_ANY);
+    CHECK(any[2] == Approx(3.0 / 5.0));
+    CHECK(any[3] == Approx(1.0 / 5.0));
+    auto outbound = graph.degreeCentrality(TRI_EDGE_OUT);
+    CHECK(outbound[2] == Approx(2.0 / 5.0));
+    CHECK(outbound[3] == Approx(0.0));
+    auto inbound = graph.degreeCentrality(TRI_EDGE_IN);
+    CHECK(inbound[3] == Approx(1.0 / 5.0));
+  }
+
+  SECTION("triangle count") {
+    auto triangles = graph.triangleCount();
+    CHECK(triangles == std::vector<uint64_t>{1, 1, 1, 0, 0, 0});
+  }
+
+  SECTION("pagerank") {
+    auto ranks = graph.pageRank(0.85, 0.000001, 100);
+    double sum = 0.0;
+    for (double rank : ranks) {
+      sum += rank;
+    }
+    CHECK(sum == Approx(1.0));
+    CHECK(ranks[4] < ranks[5]);
+    CHECK(ranks[2] > ranks[3]);
+  }
+}
+
+}  // namespace graph
+}  // namespace tests
+}  // namespace arangodb
@@ -101,6 +101,40 @@ TEST_CASE("ClusterTraverserCache", "[aql][cluster]") {
     fakeit::Verify(OverloadedMethod(queryMock, registerWarning, void(int,const char*))).Exactly(1);
   }
 
+  SECTION("it should intern vertex ids densely") {
+    std::unordered_map<ServerID, traverser::TraverserEngineID> engines;
+
+    fakeit::Mock<transaction::Methods> trxMock;
+    transaction::Methods& trx = trxMock.get();
+
+    fakeit::Mock<Query> queryMock;
+    Query& query = queryMock.get();
+    fakeit::When(Method(queryMock, trx)).AlwaysReturn(&trx);
+
+    ClusterTraverserCache testee(&query, &engines);
+
+    std::string a = "UnitTest/A";
+    std::string b = "UnitTest/B";
+    InternedId idA = testee.internString(arangodb::velocypack::StringRef(a));
+    InternedId idB = testee.internString(arangodb::velocypack::StringRef(b));
+    REQUIRE(idA == 0);
+    REQUIRE(idB == 1);
+    REQUIRE(testee.internString(arangodb::velocypack::StringRef(a)) == idA);
+    REQUIRE(testee.internedString(idB) == arangodb::velocypack::StringRef(b));
+    // the persisted string is owned by the cache
+    REQUIRE(testee.persistString(arangodb::velocypack::StringRef(a)).data() ==
+            testee.internedString(idA).data());
+
+    InternedIdSet visited;
+    REQUIRE(visited.insert(idB));
+    REQUIRE_FALSE(visited.insert(idB));
+    REQUIRE(visited.contains(idB));
+    REQUIRE_FALSE(visited.contains(idA));
+
+    testee.clear();
+    REQUIRE(testee.internString(arangodb::velocypack::StringRef(b)) == 0);
+  }
+
 }
 
 } // cluster_traveser_cache_test
@@ -202,6 +202,25 @@ TEST_CASE("KShortestPathsFinder", "[graph]") {
     REQUIRE(false == finder->getNextPathShortestPathResult(result));
   }
 
+  SECTION("paths up to a maximal weight") {
+    auto start = velocypack::Parser::fromJson("\"v/21\"");
+    auto end = velocypack::Parser::fromJson("\"v/25\"");
+    ShortestPathResult result;
+
+    spo->maxWeight = 4;
+    finder->startKShortestPathsTraversal(start->slice(), end->slice());
+
+    REQUIRE(true == finder->getNextPathShortestPathResult(result));
+    REQUIRE(result.length() == 5);
+    REQUIRE(true == finder->getNextPathShortestPathResult(result));
+    REQUIRE(result.length() == 5);
+    REQUIRE(false == finder->getNextPathShortestPathResult(result));
+
+    spo->maxWeight = 3;
+    finder->startKShortestPathsTraversal(start->slice(), end->slice());
+    REQUIRE(false == finder->getNextPathShortestPathResult(result));
+  }
+
   delete finder;
 }
 }  // namespace graph
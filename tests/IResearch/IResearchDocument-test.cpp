@@ -2079,6 +2079,39 @@ SECTION("test_rid_filter") {
   }
 }
 
+SECTION("test_primary_sort_values") {
+  auto const parse = [](std::string const& field) {
+    std::vector<arangodb::basics::AttributeName> attributes;
+    arangodb::basics::TRI_ParseAttributeString(field, attributes, false);
+    return attributes;
+  };
+  std::vector<std::vector<arangodb::basics::AttributeName>> const fields{
+      parse("date"), parse("a.b")};
+
+  auto lhsDoc = arangodb::velocypack::Parser::fromJson("{ \"date\": 2, \"a\": { \"b\": \"x\" } }");
+  auto rhsDoc = arangodb::velocypack::Parser::fromJson("{ \"date\": 2, \"a\": 1 }");
+  arangodb::velocypack::Builder lhs;
+  arangodb::velocypack::Builder rhs;
+  arangodb::iresearch::DocumentPrimarySort::build(lhs, lhsDoc->slice(), fields);
+  arangodb::iresearch::DocumentPrimarySort::build(rhs, rhsDoc->slice(), fields);
+
+  REQUIRE((lhs.slice().isArray() && 2 == lhs.slice().length()));
+  CHECK((2 == lhs.slice().at(0).getNumber<int>()));
+  CHECK(("x" == lhs.slice().at(1).copyString()));
+  REQUIRE((rhs.slice().isArray() && 2 == rhs.slice().length()));
+  CHECK((rhs.slice().at(1).isNull()));  // 'a' is not an object
+
+  // equal first values, null sorts before strings
+  CHECK((false == arangodb::iresearch::DocumentPrimarySort::less(lhs.slice(), rhs.slice(), {true})));
+  CHECK((false == arangodb::iresearch::DocumentPrimarySort::less(rhs.slice(), lhs.slice(), {true})));
+  CHECK((true == arangodb::iresearch::DocumentPrimarySort::less(rhs.slice(), lhs.slice(), {true, true})));
+  CHECK((true == arangodb::iresearch::DocumentPrimarySort::less(lhs.slice(), rhs.slice(), {true, false})));
+
+  // missing values sort like null
+  CHECK((true == arangodb::iresearch::DocumentPrimarySort::less(
+      arangodb::velocypack::Slice::noneSlice(), lhs.slice(), {true})));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief generate tests
 ////////////////////////////////////////////////////////////////////////////////
@@ -263,6 +263,13 @@ SECTION("test_defaults") {
       && 0 < slice.get("figures").get("memory").getUInt()
     ));
 
+    auto indexing = slice.get("figures").get("indexing");
+    CHECK((indexing.isObject()));
+    CHECK((0 == indexing.get("pendingOperations").getUInt()));
+    CHECK((indexing.get("pendingSeconds").isNumber()));
+    CHECK((indexing.get("commits").isNumber()));
+    CHECK((indexing.get("lastCommitLag").isNumber()));
+
     CHECK((logicalCollection->dropIndex(link->id()) && logicalCollection->getIndexes().empty()));
   }
 
@@ -1124,6 +1124,59 @@ SECTION("test_readMaskNone") {
   CHECK(false == mask._analyzers);
 }
 
+SECTION("test_storedValues") {
+  // read and write
+  {
+    arangodb::iresearch::IResearchLinkMeta meta;
+    arangodb::iresearch::IResearchLinkMeta::Mask mask;
+    std::string tmpString;
+
+    auto json = arangodb::velocypack::Parser::fromJson("{ \
+      \"storedValues\": [ \"title\", \"date\", \"title\" ] \
+    }");
+    CHECK(true == meta.init(json->slice(), false, tmpString, nullptr, arangodb::iresearch::IResearchLinkMeta::DEFAULT(), &mask));
+    CHECK(true == mask._storedValues);
+    CHECK((std::vector<std::string>{"title", "date"} == meta._storedValues));
+
+    arangodb::velocypack::Builder builder;
+    builder.openObject();
+    CHECK((true == meta.json(builder, false)));
+    builder.close();
+
+    auto slice = builder.slice().get("storedValues");
+    REQUIRE(slice.isArray());
+    CHECK((2U == slice.length()));
+    CHECK(("title" == slice.at(0).copyString()));
+    CHECK(("date" == slice.at(1).copyString()));
+
+    arangodb::iresearch::IResearchLinkMeta other;
+    CHECK(true == other.init(builder.slice(), false, tmpString));
+    CHECK((meta == other));
+  }
+
+  // not written by default
+  {
+    arangodb::iresearch::IResearchLinkMeta meta;
+    arangodb::velocypack::Builder builder;
+    builder.openObject();
+    CHECK((true == meta.json(builder, false)));
+    builder.close();
+    CHECK((builder.slice().get("storedValues").isNone()));
+  }
+
+  // invalid values
+  for (auto const* definition : {"{ \"storedValues\": \"title\" }",
+                                 "{ \"storedValues\": [ 1 ] }",
+                                 "{ \"storedValues\": [ \"\" ] }",
+                                 "{ \"storedValues\": [ \"_id\" ] }"}) {
+    arangodb::iresearch::IResearchLinkMeta meta;
+    std::string tmpString;
+    auto json = arangodb::velocypack::Parser::fromJson(definition);
+    CHECK(false == meta.init(json->slice(), false, tmpString));
+    CHECK(0 == tmpString.find("storedValues"));
+  }
+}
+
 SECTION("test_writeMaskAll") {
   // not fullAnalyzerDefinition
   {
@@ -409,6 +409,54 @@ TEST_CASE("IResearchQueryTestAggregate", "[iresearch][iresearch-query]") {
     itr.next();
     CHECK(!itr.valid());
   }
+
+  // test grouping with counting by the view, testCollection0 has no stored
+  // values and is counted from the documents
+  {
+    auto updateJson = arangodb::velocypack::Parser::fromJson(
+      "{ \"links\": {"
+        "\"testCollection1\": { \"includeAllFields\": true, \"storedValues\": [ \"value\" ] }"
+      "}}"
+    );
+    auto* impl = dynamic_cast<arangodb::iresearch::IResearchView*>(view);
+    REQUIRE((false == !impl));
+    CHECK((impl->properties(updateJson->slice(), true).ok()));
+    CHECK((arangodb::tests::executeQuery(vocbase, "FOR d IN testView SEARCH 1 ==1 OPTIONS { waitForSync: true } RETURN d").result.ok())); // commit
+
+    std::map<double_t, size_t> expected {
+      { 100.,   5 },
+      { 12. ,   2 },
+      { 95.,    1 },
+      { 90.564, 1 },
+      { 1.,     1 },
+      { 0.,     1 },
+      { 50.,    1 },
+      { -32.5,  1 },
+      { 3.14,   1 }
+    };
+
+    auto result = arangodb::tests::executeQuery(
+      vocbase,
+      "FOR d IN testView SEARCH d.value <= 100 COLLECT value = d.value WITH COUNT INTO size RETURN { 'value' : value, 'names' : size }"
+    );
+    REQUIRE(result.result.ok());
+    auto slice = result.data->slice();
+    CHECK(slice.isArray());
+
+    arangodb::velocypack::ArrayIterator itr(slice);
+    REQUIRE(expected.size() == itr.size());
+
+    for (; itr.valid(); itr.next()) {
+      auto const value = itr.value();
+      auto const key = value.get("value").getNumber<double_t>();
+
+      auto expectedValue = expected.find(key);
+      REQUIRE(expectedValue != expected.end());
+      REQUIRE(expectedValue->second == value.get("names").getNumber<size_t>());
+      REQUIRE(1 == expected.erase(key));
+    }
+    REQUIRE(expected.empty());
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -1107,6 +1107,42 @@ TEST_CASE("IResearchQueryTestOptionsWaitForSync", "[iresearch][iresearch-query]"
     }
     CHECK(expectedDocs.empty());
   }
+
+  // parallel search produces the same documents
+  {
+    auto const names = [&vocbase](std::string const& query) {
+      auto queryResult = arangodb::tests::executeQuery(vocbase, query);
+      REQUIRE(queryResult.result.ok());
+      auto result = queryResult.data->slice();
+      REQUIRE(result.isArray());
+
+      std::vector<std::string> values;
+      for (auto const name : arangodb::velocypack::ArrayIterator(result)) {
+        values.emplace_back(name.copyString());
+      }
+      std::sort(values.begin(), values.end());
+      return values;
+    };
+
+    auto const expected = names(
+        "FOR d IN testView SEARCH d.name >= 'A' RETURN d.name");
+    CHECK(!expected.empty());
+    CHECK(expected == names(
+        "FOR d IN testView SEARCH d.name >= 'A' OPTIONS { parallelism : 4 } "
+        "RETURN d.name"));
+    CHECK(expected == names(
+        "FOR d IN testView SEARCH d.name >= 'A' OPTIONS { parallelism : 4 } "
+        "SORT TFIDF(d) RETURN d.name"));
+  }
+
+  // invalid parallelism
+  {
+    auto queryResult = arangodb::tests::executeQuery(
+      vocbase,
+      "FOR d IN testView SEARCH d.name == 'A' OPTIONS { parallelism : 0 } RETURN d"
+    );
+    CHECK(queryResult.result.fail());
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -1824,6 +1824,95 @@ TEST_CASE("IResearchQueryScorer", "[iresearch][iresearch-query]") {
       CHECK(static_cast<const void*>(scorers[i].var) == sub->getData());
     }
   }
+
+  // SORT on scorers followed by LIMIT is pushed into the view
+  {
+    std::string const queryString =
+      "FOR d IN testView SEARCH IN_RANGE(d.name, 'A', 'Z', true, true) "
+      "SORT BM25(d) DESC LIMIT 2, 3 RETURN d";
+
+    arangodb::aql::Query query(
+      false,
+      vocbase,
+      arangodb::aql::QueryString(queryString),
+      std::shared_ptr<arangodb::velocypack::Builder>(),
+      arangodb::velocypack::Parser::fromJson("{}"),
+      arangodb::aql::PART_MAIN
+    );
+
+    query.prepare(arangodb::QueryRegistryFeature::registry());
+    auto* plan = query.plan();
+    REQUIRE(plan);
+
+    arangodb::SmallVector<arangodb::aql::ExecutionNode*>::allocator_type::arena_type a;
+    arangodb::SmallVector<arangodb::aql::ExecutionNode*> nodes{a};
+
+    plan->findNodesOfType(nodes, arangodb::aql::ExecutionNode::ENUMERATE_IRESEARCH_VIEW, true);
+    REQUIRE(1 == nodes.size());
+    auto* viewNode = arangodb::aql::ExecutionNode::castTo<arangodb::iresearch::IResearchViewNode*>(nodes.front());
+    REQUIRE(viewNode);
+    REQUIRE(1 == viewNode->scorers().size());
+    CHECK((std::vector<std::pair<size_t, bool>>{{0, false}} == viewNode->scorersSort()));
+    CHECK(5 == viewNode->scorersSortLimit());
+
+    // the SORT stays in place
+    nodes.clear();
+    plan->findNodesOfType(nodes, arangodb::aql::ExecutionNode::SORT, true);
+    CHECK(1 == nodes.size());
+  }
+
+  // SORT on other attributes is not pushed into the view
+  {
+    std::string const queryString =
+      "FOR d IN testView SEARCH IN_RANGE(d.name, 'A', 'Z', true, true) "
+      "SORT BM25(d) DESC, d.seq LIMIT 3 RETURN d";
+
+    arangodb::aql::Query query(
+      false,
+      vocbase,
+      arangodb::aql::QueryString(queryString),
+      std::shared_ptr<arangodb::velocypack::Builder>(),
+      arangodb::velocypack::Parser::fromJson("{}"),
+      arangodb::aql::PART_MAIN
+    );
+
+    query.prepare(arangodb::QueryRegistryFeature::registry());
+    auto* plan = query.plan();
+    REQUIRE(plan);
+
+    arangodb::SmallVector<arangodb::aql::ExecutionNode*>::allocator_type::arena_type a;
+    arangodb::SmallVector<arangodb::aql::ExecutionNode*> nodes{a};
+
+    plan->findNodesOfType(nodes, arangodb::aql::ExecutionNode::ENUMERATE_IRESEARCH_VIEW, true);
+    REQUIRE(1 == nodes.size());
+    auto* viewNode = arangodb::aql::ExecutionNode::castTo<arangodb::iresearch::IResearchViewNode*>(nodes.front());
+    REQUIRE(viewNode);
+    CHECK(viewNode->scorersSort().empty());
+  }
+
+  // the best documents are the same as with a full sort
+  {
+    auto fullResult = arangodb::tests::executeQuery(
+      vocbase,
+      "FOR d IN testView SEARCH IN_RANGE(d.name, 'A', 'Z', true, true) "
+      "LET score = BM25(d) SORT score DESC RETURN score");
+    REQUIRE(fullResult.result.ok());
+    auto full = fullResult.data->slice();
+    REQUIRE(full.isArray());
+
+    auto limitedResult = arangodb::tests::executeQuery(
+      vocbase,
+      "FOR d IN testView SEARCH IN_RANGE(d.name, 'A', 'Z', true, true) "
+      "LET score = BM25(d) SORT score DESC LIMIT 2, 3 RETURN score");
+    REQUIRE(limitedResult.result.ok());
+    auto limited = limitedResult.data->slice();
+    REQUIRE(limited.isArray());
+    REQUIRE(std::min<size_t>(3, full.length() - std::min<size_t>(2, full.length())) == limited.length());
+
+    for (size_t i = 0; i < limited.length(); ++i) {
+      CHECK(full.at(i + 2).getNumber<double>() == limited.at(i).getNumber<double>());
+    }
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -83,6 +83,10 @@ void GeneralResponseMock::reset(arangodb::ResponseCode code) {
   _responseCode = code;
 }
 
+size_t GeneralResponseMock::bodySize() const {
+  return _payload.isClosed() ? _payload.size() : 0;
+}
+
 arangodb::Endpoint::TransportType GeneralResponseMock::transportType() {
   return arangodb::Endpoint::TransportType::HTTP; // arbitrary value
 }
@@ -45,6 +45,7 @@ struct GeneralRequestMock: public arangodb::GeneralRequest {
   virtual arangodb::velocypack::StringRef rawPayload() const override;
   virtual arangodb::velocypack::Slice payload(arangodb::velocypack::Options const* options = &arangodb::velocypack::Options::Defaults) override;
   virtual arangodb::Endpoint::TransportType transportType() override;
+  std::unordered_map<std::string, std::string>& headers() { return _headers; }
   std::unordered_map<std::string, std::string>& values() { return _values; }
 };
 
@@ -55,6 +56,7 @@ struct GeneralResponseMock: public arangodb::GeneralResponse {
   virtual void addPayload(arangodb::velocypack::Buffer<uint8_t>&& buffer, arangodb::velocypack::Options const* options = nullptr, bool resolveExternals = true) override;
   virtual void addPayload(arangodb::velocypack::Slice const& slice, arangodb::velocypack::Options const* options = nullptr, bool resolveExternals = true) override;
   virtual void reset(arangodb::ResponseCode code) override;
+  virtual size_t bodySize() const override;
   virtual arangodb::Endpoint::TransportType transportType() override;
 };
 
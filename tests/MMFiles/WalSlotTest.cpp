@@ -0,0 +1,145 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "MMFiles/MMFilesWalLogfile.h"
+#include "MMFiles/MMFilesWalSlot.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace arangodb;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+TEST_CASE("MMFilesWalSlot", "[mmfiles][wal]") {
+  // the slot only refers to the logfile, which does not need a datafile here
+  MMFilesWalLogfile logfile(42, nullptr, MMFilesWalLogfile::StatusType::OPEN);
+
+  SECTION("a new slot is unused") {
+    MMFilesWalSlot slot;
+    CHECK((slot.isUnused()));
+    CHECK((!slot.isUsed()));
+    CHECK((!slot.isReturned()));
+    CHECK((0 == slot.tick()));
+    CHECK((0 == slot.logfileId()));
+    CHECK((nullptr == slot.mem()));
+    CHECK(("unused" == slot.statusText()));
+  }
+
+  SECTION("a slot goes through used and returned back to unused") {
+    char buffer[64];
+    MMFilesWalSlot slot;
+
+    slot.setUsed(&buffer[0], sizeof(buffer), &logfile, 123);
+    CHECK((slot.isUsed()));
+    CHECK((!slot.isReturned()));
+    CHECK((123 == slot.tick()));
+    CHECK((42 == slot.logfileId()));
+    CHECK((&buffer[0] == slot.mem()));
+    CHECK((sizeof(buffer) == slot.size()));
+    CHECK(("used" == slot.statusText()));
+
+    slot.setReturned(false);
+    CHECK((slot.isReturned()));
+    CHECK((!slot.isUsed()));
+    CHECK((!slot.waitForSync()));
+    CHECK(("returned" == slot.statusText()));
+
+    slot.setUnused();
+    CHECK((slot.isUnused()));
+    CHECK((0 == slot.tick()));
+    CHECK((nullptr == slot.logfile()));
+    CHECK((0 == slot.size()));
+  }
+
+  SECTION("a slot returned with waitForSync requests a sync") {
+    char buffer[64];
+    MMFilesWalSlot slot;
+
+    slot.setUsed(&buffer[0], sizeof(buffer), &logfile, 1);
+    slot.setReturned(true);
+    CHECK((slot.isReturned()));
+    CHECK((slot.waitForSync()));
+    CHECK(("returned (wfs)" == slot.statusText()));
+  }
+
+  SECTION("returning a slot publishes the data written into it") {
+    // the writer fills the slot and returns it without any lock, the reader
+    // waits for the slot to be returned and must then see all of the data
+    constexpr size_t numSlots = 64;
+    constexpr size_t slotSize = 256;
+    constexpr size_t numRounds = 200;
+
+    std::vector<char> memory(numSlots * slotSize);
+    std::vector<MMFilesWalSlot> slots(numSlots);
+    std::atomic<size_t> errors(0);
+
+    for (size_t round = 0; round < numRounds; ++round) {
+      for (size_t i = 0; i < numSlots; ++i) {
+        slots[i].setUsed(&memory[i * slotSize], slotSize, &logfile, round * numSlots + i);
+      }
+
+      std::thread writer([&]() {
+        for (size_t i = 0; i < numSlots; ++i) {
+          char* mem = static_cast<char*>(slots[i].mem());
+          for (size_t j = 0; j < slotSize; ++j) {
+            mem[j] = static_cast<char>(round + i + j);
+          }
+          slots[i].setReturned((i % 2) == 0);
+        }
+      });
+
+      std::thread reader([&]() {
+        for (size_t i = 0; i < numSlots; ++i) {
+          while (!slots[i].isReturned()) {
+            std::this_thread::yield();
+          }
+          char const* mem = static_cast<char const*>(slots[i].mem());
+          for (size_t j = 0; j < slotSize; ++j) {
+            if (mem[j] != static_cast<char>(round + i + j)) {
+              ++errors;
+            }
+          }
+          if (slots[i].waitForSync() != ((i % 2) == 0)) {
+            ++errors;
+          }
+        }
+      });
+
+      writer.join();
+      reader.join();
+
+      for (auto& slot : slots) {
+        slot.setUnused();
+      }
+    }
+
+    CHECK((0 == errors.load()));
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
@@ -389,6 +389,28 @@ TEST_CASE("MaintenanceFeatureUnthreaded", "[cluster][maintenance][devel]") {
     REQUIRE(tf._recentAction->getStartTime() <= tf._recentAction->getDoneTime());
     REQUIRE(tf._recentAction->getLastStatTime() <= tf._recentAction->getDoneTime());
   }
+
+  SECTION("Synchronizations are throttled to the configured bandwidth") {
+    std::shared_ptr<arangodb::options::ProgramOptions> po =
+      std::make_shared<arangodb::options::ProgramOptions>(
+        "test", std::string(), std::string(), "path");
+    arangodb::application_features::ApplicationServer as(po, nullptr);
+    TestMaintenanceFeature tf(as);
+
+    // unlimited by default
+    auto start = std::chrono::steady_clock::now();
+    tf.throttleSynchronization(1ULL << 30);
+    REQUIRE(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(500));
+
+    // one second worth of data passes without waiting, anything beyond
+    // that has to wait for the bandwidth
+    tf.setSyncBandwidth(1 << 20);
+    start = std::chrono::steady_clock::now();
+    tf.throttleSynchronization(1 << 20);
+    REQUIRE(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(500));
+    tf.throttleSynchronization(1 << 19);
+    REQUIRE(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(450));
+  }
 } // MaintenanceFeatureUnthreaded
 
 TEST_CASE("MaintenanceFeatureThreaded", "[cluster][maintenance][devel]") {
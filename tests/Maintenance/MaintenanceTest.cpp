@@ -448,6 +448,105 @@ TEST_CASE("ActionPhaseOne", "[cluster][maintenance]") {
 
   }
 
+  SECTION("Databases found in sync are compared again after a plan change") {
+
+    plan = originalPlan;
+
+    for (size_t i = 0; i < 2; ++i) {
+      for (auto const& node : localNodes) {
+        std::vector<ActionDescription> actions;
+        arangodb::maintenance::diffPlanLocal(
+          plan.toBuilder().slice(), node.second.toBuilder().slice(),
+          node.first, errors, feature, actions);
+        REQUIRE(actions.size() == 0);
+      }
+    }
+
+    auto cid = collectionMap(plan).at("_system/_queues");
+    auto shards = plan({"Collections","_system",cid,"shards"}).children();
+
+    createPlanIndex(
+      "_system", cid, "hash", {"someField"}, false, false, false, plan);
+
+    for (auto const& node : localNodes) {
+      std::vector<ActionDescription> actions;
+
+      auto local = node.second;
+
+      arangodb::maintenance::diffPlanLocal(
+        plan.toBuilder().slice(), local.toBuilder().slice(), node.first, errors, feature,
+        actions);
+
+      size_t n = 0;
+      for (auto const& shard : shards) {
+        if (local.has({"_system", shard.first})) {
+          ++n;
+        }
+      }
+
+      REQUIRE(actions.size() == n);
+      for (auto const& action : actions) {
+        REQUIRE(action.name() == "EnsureIndex");
+      }
+    }
+
+  }
+
+  SECTION("Databases with errors are not remembered as in sync") {
+
+    plan = originalPlan;
+
+    auto cid = collectionMap(plan).at("_system/_queues");
+    auto shards = plan({"Collections","_system",cid,"shards"}).children();
+
+    createPlanIndex(
+      "_system", cid, "hash", {"someField"}, false, false, false, plan);
+    auto indexes = plan({"Collections","_system",cid,"indexes"}).toBuilder();
+    std::string const id =
+      indexes.slice().at(indexes.slice().length() - 1).get("id").copyString();
+
+    // creating the index has failed before on all shards
+    MaintenanceFeature::errors_t indexErrors;
+    for (auto const& shard : shards) {
+      indexErrors.indexes["_system/" + cid + "/" + shard.first][id] =
+        std::make_shared<VPackBuffer<uint8_t>>();
+    }
+
+    for (size_t i = 0; i < 2; ++i) {
+      for (auto const& node : localNodes) {
+        std::vector<ActionDescription> actions;
+        arangodb::maintenance::diffPlanLocal(
+          plan.toBuilder().slice(), node.second.toBuilder().slice(),
+          node.first, indexErrors, feature, actions);
+        REQUIRE(actions.size() == 0);
+      }
+    }
+
+    // once the errors are gone, the index is created
+    for (auto const& node : localNodes) {
+      std::vector<ActionDescription> actions;
+
+      auto local = node.second;
+
+      arangodb::maintenance::diffPlanLocal(
+        plan.toBuilder().slice(), local.toBuilder().slice(), node.first, errors, feature,
+        actions);
+
+      size_t n = 0;
+      for (auto const& shard : shards) {
+        if (local.has({"_system", shard.first})) {
+          ++n;
+        }
+      }
+
+      REQUIRE(actions.size() == n);
+      for (auto const& action : actions) {
+        REQUIRE(action.name() == "EnsureIndex");
+      }
+    }
+
+  }
+
   
   SECTION("Local databases one more empty database should be dropped") {
 
@@ -417,6 +417,93 @@ class AllIteratorMock final : public arangodb::IndexIterator {
   uint64_t _end;
 };  // AllIteratorMock
 
+class PrimaryIndexIteratorMock final : public arangodb::IndexIterator {
+ public:
+  PrimaryIndexIteratorMock(arangodb::LogicalCollection& coll,
+                           arangodb::transaction::Methods* trx,
+                           std::deque<std::pair<arangodb::velocypack::Builder, bool>> const& documents)
+      : arangodb::IndexIterator(&coll, trx), _documents(documents), _pos(0) {}
+
+  char const* typeName() const override { return "PrimaryIndexIteratorMock"; }
+
+  void reset() override { _pos = 0; }
+
+  bool hasCovering() const override { return true; }
+
+  bool next(LocalDocumentIdCallback const& callback, size_t limit) override {
+    return nextCovering([&callback](arangodb::LocalDocumentId const& id,
+                                    arangodb::velocypack::Slice) { callback(id); },
+                        limit);
+  }
+
+  /// @brief produces the _key of the documents
+  bool nextCovering(DocumentCallback const& callback, size_t limit) override {
+    while (_pos < _documents.size() && limit > 0) {
+      auto const& entry = _documents[_pos++];
+
+      if (entry.second) {
+        callback(arangodb::LocalDocumentId(_pos),  // always > 0
+                 entry.first.slice().get(arangodb::StaticStrings::KeyString));
+        --limit;
+      }
+    }
+
+    return _pos < _documents.size();
+  }
+
+ private:
+  std::deque<std::pair<arangodb::velocypack::Builder, bool>> const& _documents;
+  size_t _pos;
+};  // PrimaryIndexIteratorMock
+
+/// @brief a primary index that only supports full scans, reading the
+/// documents of the collection directly
+class PrimaryIndexMock final : public arangodb::Index {
+ public:
+  PrimaryIndexMock(TRI_idx_iid_t iid, arangodb::LogicalCollection& collection)
+      : arangodb::Index(iid, collection, arangodb::StaticStrings::IndexNamePrimary,
+                        {{arangodb::basics::AttributeName(arangodb::StaticStrings::KeyString, false)}},
+                        true, false) {}
+
+  IndexType type() const override { return Index::TRI_IDX_TYPE_PRIMARY_INDEX; }
+
+  char const* typeName() const override { return "primary"; }
+
+  bool isPersistent() const override { return false; }
+
+  bool canBeDropped() const override { return false; }
+
+  bool isHidden() const override { return false; }
+
+  bool isSorted() const override { return false; }
+
+  bool hasSelectivityEstimate() const override { return false; }
+
+  bool hasCoveringIterator() const override { return true; }
+
+  size_t memory() const override { return sizeof(PrimaryIndexMock); }
+
+  void load() override {}
+  void unload() override {}
+
+  void toVelocyPack(VPackBuilder& builder,
+                    std::underlying_type<arangodb::Index::Serialize>::type flags) const override {
+    builder.openObject();
+    Index::toVelocyPack(builder, flags);
+    builder.add("unique", VPackValue(true));
+    builder.add("sparse", VPackValue(false));
+    builder.close();
+  }
+
+  arangodb::IndexIterator* iteratorForCondition(arangodb::transaction::Methods* trx,
+                                                arangodb::aql::AstNode const*,
+                                                arangodb::aql::Variable const*,
+                                                arangodb::IndexIteratorOptions const&) override {
+    auto* physical = static_cast<PhysicalCollectionMock*>(_collection.getPhysical());
+    return new PrimaryIndexIteratorMock(_collection, trx, physical->documents);
+  }
+};  // PrimaryIndexMock
+
 struct IndexFactoryMock : arangodb::IndexFactory {
   virtual void fillSystemIndexes(arangodb::LogicalCollection& col,
                                  std::vector<std::shared_ptr<arangodb::Index>>& systemIndexes) const override {
@@ -482,6 +569,8 @@ std::shared_ptr<arangodb::Index> PhysicalCollectionMock::createIndex(
 
   if (0 == type.compare("edge")) {
     index = EdgeIndexMock::make(id, _logicalCollection, info);
+  } else if (0 == type.compare("primary")) {
+    index = std::make_shared<PrimaryIndexMock>(id, _logicalCollection);
   } else if (0 == type.compare(arangodb::iresearch::DATA_SOURCE_TYPE.name())) {
     if (arangodb::ServerState::instance()->isCoordinator()) {
       arangodb::iresearch::IResearchLinkCoordinator::factory().instantiate(index, _logicalCollection,
@@ -522,6 +611,8 @@ std::shared_ptr<arangodb::Index> PhysicalCollectionMock::createIndex(
     TRI_ASSERT(l != nullptr);
     ;
     l->batchInsert(trx, docs, taskQueuePtr);
+  } else if (index->type() == arangodb::Index::TRI_IDX_TYPE_PRIMARY_INDEX) {
+    // reads the documents of the collection directly
   } else {
     TRI_ASSERT(false);
   }
@@ -602,8 +693,16 @@ arangodb::Result PhysicalCollectionMock::insert(
     return res;
   }
 
+  // keys are only checked for uniqueness where tests rely on it, i.e. for
+  // repserts which replace the document if the insert fails
+  if (options.overwrite &&
+      lookupKey(trx, builder.slice().get(arangodb::StaticStrings::KeyString)).isSet()) {
+    return arangodb::Result(TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED);
+  }
+
   documents.emplace_back(std::move(builder), true);
   arangodb::LocalDocumentId docId(documents.size());  // always > 0
+  trx->state()->trackOperation(_logicalCollection.id());
 
   result.setUnmanaged(documents.back().first.data());
   TRI_ASSERT(result.revisionId() == unused);
@@ -657,9 +756,17 @@ void PhysicalCollectionMock::invokeOnAllElements(
 }
 
 arangodb::LocalDocumentId PhysicalCollectionMock::lookupKey(
-    arangodb::transaction::Methods*, arangodb::velocypack::Slice const&) const {
+    arangodb::transaction::Methods*, arangodb::velocypack::Slice const& key) const {
   before();
-  TRI_ASSERT(false);
+
+  for (size_t i = documents.size(); i; --i) {
+    auto& entry = documents[i - 1];
+
+    if (entry.second && key == entry.first.slice().get(arangodb::StaticStrings::KeyString)) {
+      return arangodb::LocalDocumentId(i);  // '_data' always > 0
+    }
+  }
+
   return arangodb::LocalDocumentId();
 }
 
@@ -769,6 +876,13 @@ arangodb::Result PhysicalCollectionMock::read(arangodb::transaction::Methods*,
   return TRI_ERROR_INTERNAL;
 }
 
+arangodb::Result PhysicalCollectionMock::readLatestCommitted(arangodb::velocypack::StringRef const& key,
+                                                             arangodb::ManagedDocumentResult& result) const {
+  // the mock has no uncommitted state, so the latest committed revision is
+  // whatever a regular read returns
+  return const_cast<PhysicalCollectionMock*>(this)->read(nullptr, key, result, false);
+}
+
 bool PhysicalCollectionMock::readDocument(arangodb::transaction::Methods* trx,
                                           arangodb::LocalDocumentId const& token,
                                           arangodb::ManagedDocumentResult& result) const {
@@ -832,6 +946,7 @@ arangodb::Result PhysicalCollectionMock::remove(
       entry.second = false;
       previous.setUnmanaged(doc.data());
       TRI_ASSERT(previous.revisionId() == TRI_ExtractRevisionId(doc.slice()));
+      trx.state()->trackOperation(_logicalCollection.id());
 
       return arangodb::Result(TRI_ERROR_NO_ERROR);  // assume document was removed
     }
@@ -883,6 +998,12 @@ arangodb::Result PhysicalCollectionMock::update(
 
   before();
 
+  // the document is re-inserted, its key was already accepted by the key
+  // generator when it was first inserted
+  arangodb::OperationOptions insertOptions = options;
+  insertOptions.isRestore = true;
+  insertOptions.overwrite = false;
+
   for (size_t i = documents.size(); i; --i) {
     auto& entry = documents[i - 1];
 
@@ -898,7 +1019,7 @@ arangodb::Result PhysicalCollectionMock::update(
         previous.setUnmanaged(doc.data());
         TRI_ASSERT(previous.revisionId() == TRI_ExtractRevisionId(doc.slice()));
 
-        return insert(trx, newSlice, result, options, lock, nullptr, nullptr);
+        return insert(trx, newSlice, result, insertOptions, lock, nullptr, nullptr);
       }
 
       arangodb::velocypack::Builder builder;
@@ -922,7 +1043,7 @@ arangodb::Result PhysicalCollectionMock::update(
       previous.setUnmanaged(doc.data());
       TRI_ASSERT(previous.revisionId() == TRI_ExtractRevisionId(doc.slice()));
 
-      return insert(trx, builder.slice(), result, options, lock, nullptr, nullptr);
+      return insert(trx, builder.slice(), result, insertOptions, lock, nullptr, nullptr);
     }
   }
 
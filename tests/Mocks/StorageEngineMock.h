@@ -78,6 +78,7 @@ class PhysicalCollectionMock: public arangodb::PhysicalCollection {
                       arangodb::velocypack::StringRef const& key,
                       arangodb::ManagedDocumentResult& result, bool) override;
   virtual arangodb::Result read(arangodb::transaction::Methods*, arangodb::velocypack::Slice const& key, arangodb::ManagedDocumentResult& result, bool) override;
+  virtual arangodb::Result readLatestCommitted(arangodb::velocypack::StringRef const& key, arangodb::ManagedDocumentResult& result) const override;
   virtual bool readDocument(arangodb::transaction::Methods* trx, arangodb::LocalDocumentId const& token, arangodb::ManagedDocumentResult& result) const override;
   virtual bool readDocumentWithCallback(arangodb::transaction::Methods* trx, arangodb::LocalDocumentId const& token, arangodb::IndexIterator::DocumentCallback const& cb) const override;
   virtual arangodb::Result remove(
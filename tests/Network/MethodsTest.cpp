@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Network/Methods.h"
+#include "Network/NetworkFeature.h"
+
+#include <fuerte/message.h>
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace {
+
+/// @brief a successful response with the given body and content type
+network::Response makeResponse(VPackBuffer<uint8_t> body, fuerte::ContentType type) {
+  fuerte::ResponseHeader header;
+  header.responseCode = fuerte::StatusOK;
+  header.contentType(type);
+  auto response = std::make_unique<fuerte::Response>(std::move(header));
+  response->setPayload(std::move(body), 0);
+  return network::Response{"server:PRMR-1234",
+                           fuerte::errorToInt(fuerte::ErrorCondition::NoError),
+                           std::move(response)};
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+TEST_CASE("NetworkResponse", "[network]") {
+  SECTION("the body of a successful response") {
+    auto body = VPackParser::fromJson("{\"figures\": {\"alive\": {\"count\": 1}}}");
+    VPackBuffer<uint8_t> buffer;
+    buffer.append(body->slice().start(), body->slice().byteSize());
+    auto r = makeResponse(std::move(buffer), fuerte::ContentType::VPack);
+
+    CHECK((r.ok()));
+    CHECK((fuerte::StatusOK == r.statusCode()));
+    CHECK((TRI_ERROR_NO_ERROR == r.errorCode()));
+    REQUIRE((r.slice().isObject()));
+    CHECK((r.slice().get("figures").isObject()));
+  }
+
+  SECTION("an invalid body is a none slice") {
+    // an object header announcing more bytes than there are
+    VPackBuffer<uint8_t> buffer;
+    for (uint8_t byte : {0x0b, 0x40, 0x01, 0x41, 0x61}) {
+      buffer.push_back(byte);
+    }
+    auto r = makeResponse(std::move(buffer), fuerte::ContentType::VPack);
+
+    CHECK((r.ok()));
+    VPackSlice slice;
+    CHECK_NOTHROW((slice = r.slice()));
+    CHECK((slice.isNone()));
+  }
+
+  SECTION("a body that is not velocypack is a none slice") {
+    std::string const json = "{\"figures\": {}}";
+    VPackBuffer<uint8_t> buffer;
+    buffer.append(json.data(), json.size());
+    auto r = makeResponse(std::move(buffer), fuerte::ContentType::Json);
+
+    CHECK((r.ok()));
+    CHECK((r.slice().isNone()));
+  }
+
+  SECTION("a failed request has no body") {
+    network::Response r{"server:PRMR-1234",
+                        fuerte::errorToInt(fuerte::ErrorCondition::Timeout), nullptr};
+
+    CHECK((!r.ok()));
+    CHECK((fuerte::StatusUndefined == r.statusCode()));
+    CHECK((TRI_ERROR_CLUSTER_TIMEOUT == r.errorCode()));
+    CHECK((r.slice().isNone()));
+  }
+
+  SECTION("errors are mapped to ArangoDB error codes") {
+    auto errorCode = [](fuerte::ErrorCondition err) {
+      return network::Response{"", fuerte::errorToInt(err), nullptr}.errorCode();
+    };
+    CHECK((TRI_ERROR_CLUSTER_BACKEND_UNAVAILABLE ==
+           errorCode(fuerte::ErrorCondition::CouldNotConnect)));
+    CHECK((TRI_ERROR_CLUSTER_TIMEOUT == errorCode(fuerte::ErrorCondition::Timeout)));
+    CHECK((TRI_ERROR_SHUTTING_DOWN == errorCode(fuerte::ErrorCondition::Canceled)));
+    CHECK((TRI_ERROR_CLUSTER_CONNECTION_LOST ==
+           errorCode(fuerte::ErrorCondition::ProtocolError)));
+  }
+}
+
+TEST_CASE("NetworkSendRequest", "[network]") {
+  SECTION("requests fail without a connection pool") {
+    REQUIRE((nullptr == NetworkFeature::pool()));
+
+    auto r = network::sendRequest("server:PRMR-1234", fuerte::RestVerb::Get,
+                                  "_system", "/_api/version",
+                                  VPackBuffer<uint8_t>(), network::Timeout(1.0))
+                 .get();
+    CHECK((!r.ok()));
+    CHECK((TRI_ERROR_SHUTTING_DOWN == r.errorCode()));
+    CHECK((r.slice().isNone()));
+  }
+}
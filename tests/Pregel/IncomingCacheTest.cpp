@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2019 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Basics/Exceptions.h"
+#include "Pregel/IncomingCache.h"
+#include "Pregel/MessageCombiner.h"
+#include "Pregel/Utils.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <cstring>
+
+using namespace arangodb;
+using namespace arangodb::pregel;
+
+namespace {
+void appendVertex(std::string& batch, std::string const& key,
+                  std::vector<float> const& values) {
+  uint32_t length = static_cast<uint32_t>(key.size());
+  uint32_t count = static_cast<uint32_t>(values.size());
+  batch.append(reinterpret_cast<char const*>(&length), sizeof(length));
+  batch.append(key);
+  batch.append(reinterpret_cast<char const*>(&count), sizeof(count));
+  batch.append(reinterpret_cast<char const*>(values.data()), values.size() * sizeof(float));
+}
+
+VPackBuilder messages(std::string const& batch) {
+  VPackBuilder builder;
+  builder.openObject();
+  builder.add(Utils::shardIdKey, VPackValue(3));
+  builder.add(Utils::binaryMessagesKey,
+              VPackValuePair(batch.data(), batch.size(), VPackValueType::Binary));
+  builder.close();
+  return builder;
+}
+}  // namespace
+
+TEST_CASE("InCache binary message batches", "[pregel]") {
+  NumberMessageFormat<float> format;
+  ArrayInCache<float> cache(nullptr, &format);
+
+  std::string batch;
+  ::appendVertex(batch, "a", {1.0f, 2.5f});
+  ::appendVertex(batch, "bb", {4.0f});
+
+  SECTION("stores all messages") {
+    cache.parseMessages(::messages(batch).slice());
+    CHECK(cache.containedMessageCount() == 3);
+
+    std::vector<float> a;
+    for (float const* value : cache.getMessages(3, "a")) {
+      a.emplace_back(*value);
+    }
+    CHECK(a == std::vector<float>{1.0f, 2.5f});
+
+    std::vector<float> b;
+    for (float const* value : cache.getMessages(3, "bb")) {
+      b.emplace_back(*value);
+    }
+    CHECK(b == std::vector<float>{4.0f});
+  }
+
+  SECTION("rejects truncated batches") {
+    batch.pop_back();
+    CHECK_THROWS_AS(cache.parseMessages(::messages(batch).slice()),
+                    basics::Exception);
+  }
+}
+
+TEST_CASE("DenseCombiningInCache", "[pregel]") {
+  NumberMessageFormat<float> format;
+  SumCombiner<float> combiner;
+  std::vector<VertexEntry> vertices{VertexEntry(3, "a"), VertexEntry(3, "b"),
+                                    VertexEntry(4, "a")};
+  auto offsets = std::make_shared<VertexOffsets const>(
+      RangeIterator<VertexEntry>(vertices.data(), vertices.size()));
+  CHECK(offsets->find(4, "a") == 2);
+  CHECK(offsets->find(4, "b") == offsets->size());
+
+  DenseCombiningInCache<float> cache(nullptr, &format, &combiner, offsets);
+  cache.storeMessage(3, "b", 1.0f);
+  cache.storeMessage(3, "b", 2.0f);
+  cache.storeMessage(4, "a", 5.0f);
+  // not loaded, dropped
+  cache.storeMessage(5, "a", 7.0f);
+
+  SECTION("combines messages per vertex") {
+    size_t count = 0;
+    for (float const* value : cache.getMessages(1, vertices[1])) {
+      CHECK(*value == 3.0f);
+      ++count;
+    }
+    CHECK(count == 1);
+    CHECK(cache.getMessages(0, vertices[0]).size() == 0);
+    CHECK(cache.getMessages(4, "a").size() == 1);
+  }
+
+  SECTION("clear and erase") {
+    cache.erase(4, "a");
+    CHECK(cache.getMessages(2, vertices[2]).size() == 0);
+    cache.clear();
+    CHECK(cache.getMessages(1, vertices[1]).size() == 0);
+    CHECK(cache.containedMessageCount() == 0);
+  }
+}
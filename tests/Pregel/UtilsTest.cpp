@@ -0,0 +1,50 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2019 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Pregel/Utils.h"
+
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::pregel;
+
+TEST_CASE("Pregel matchesExample", "[pregel]") {
+  auto document = VPackParser::fromJson(
+      R"({"type": "follows", "weight": 2, "meta": {"source": "import"}})");
+
+  auto matches = [&document](char const* example) {
+    return Utils::matchesExample(VPackParser::fromJson(example)->slice(),
+                                 document->slice());
+  };
+
+  CHECK(matches("{}"));
+  CHECK(matches(R"({"type": "follows"})"));
+  CHECK(matches(R"({"type": "follows", "weight": 2.0})"));
+  CHECK(matches(R"({"meta.source": "import"})"));
+  CHECK(matches(R"({"missing": null})"));
+  CHECK_FALSE(matches(R"({"type": "likes"})"));
+  CHECK_FALSE(matches(R"({"type": "follows", "weight": 3})"));
+  CHECK_FALSE(matches(R"({"meta.source": "user"})"));
+  CHECK_FALSE(matches(R"({"missing": 1})"));
+}
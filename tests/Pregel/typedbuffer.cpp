@@ -74,3 +74,20 @@ TEST_CASE("tst_pregel1", "[pregel][mmap]") {
   REQUIRE(mapped.data() == nullptr);
 }
 
+
+TEST_CASE("tst_pregel2", "[pregel][mmap]") {
+  MappedFileBuffer<int> mapped(TRI_GetTempPath(), 4096);
+  REQUIRE(mapped.isPhysical());
+  int *ptr = mapped.data();
+  for (int i = 0; i < 4096; i++) {
+    *(ptr+i) = i;
+  }
+  mapped.dontNeed(1000, 2000);
+  mapped.willNeed(1000, 2000);
+  for (int i = 0; i < 4096; i++) {
+    REQUIRE(*(ptr+i) == i);
+  }
+
+  mapped.close();
+  REQUIRE(mapped.data() == nullptr);
+}
@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Replication/ParallelApply.h"
+#include "Replication/ReplicationApplierConfiguration.h"
+#include "Scheduler/SchedulerFeature.h"
+
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <atomic>
+#include <thread>
+
+using namespace arangodb;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+TEST_CASE("ParallelApply", "[replication]") {
+  // without a scheduler, the calling thread runs all jobs
+  auto* scheduler = SchedulerFeature::SCHEDULER;
+  SchedulerFeature::SCHEDULER = nullptr;
+
+  SECTION("every job runs exactly once") {
+    std::vector<std::atomic<int>> calls(8);
+    auto shared = std::make_shared<ParallelApply>();
+    for (size_t i = 0; i < calls.size(); ++i) {
+      shared->jobs.emplace_back([&calls, i]() { ++calls[i]; });
+    }
+    ParallelApply::execute(shared);
+
+    for (auto const& it : calls) {
+      CHECK((1 == it.load()));
+    }
+    CHECK((shared->jobs.empty()));
+    CHECK((0 == shared->running));
+
+    // late runs find nothing left to do
+    ParallelApply::run(shared, 0);
+    ParallelApply::run(shared, 100);
+    CHECK((1 == calls[0].load()));
+  }
+
+  SECTION("jobs taken by other threads are not run twice and are waited for") {
+    std::atomic<bool> started(false);
+    std::atomic<bool> finished(false);
+    std::atomic<int> calls(0);
+    auto shared = std::make_shared<ParallelApply>();
+    shared->jobs.emplace_back([&calls]() { ++calls; });
+    shared->jobs.emplace_back([&]() {
+      ++calls;
+      started.store(true);
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      finished.store(true);
+    });
+
+    // another thread takes the second job, like a scheduler thread would
+    std::thread other([shared]() { ParallelApply::run(shared, 1); });
+    while (!started.load()) {
+      std::this_thread::yield();
+    }
+
+    ParallelApply::execute(shared);
+    CHECK((finished.load()));
+    CHECK((2 == calls.load()));
+    other.join();
+  }
+
+  SECTION("no jobs") {
+    auto shared = std::make_shared<ParallelApply>();
+    ParallelApply::execute(shared);
+    CHECK((0 == shared->running));
+  }
+
+  SchedulerFeature::SCHEDULER = scheduler;
+}
+
+TEST_CASE("ReplicationApplierConfigurationApplyThreads", "[replication]") {
+  // an explicit jwt keeps the configuration from looking at the cluster
+  auto parse = [](std::string const& json) {
+    return ReplicationApplierConfiguration::fromVelocyPack(
+        VPackParser::fromJson(json)->slice(), "testVocbase");
+  };
+
+  CHECK((1 == ReplicationApplierConfiguration()._applyThreads));
+  CHECK((1 == parse("{ \"jwt\": \"\" }")._applyThreads));
+  CHECK((8 == parse("{ \"jwt\": \"\", \"applyThreads\": 8 }")._applyThreads));
+  CHECK((1 == parse("{ \"jwt\": \"\", \"applyThreads\": 0 }")._applyThreads));
+  CHECK((64 == parse("{ \"jwt\": \"\", \"applyThreads\": 1000 }")._applyThreads));
+
+  VPackBuilder builder;
+  builder.openObject();
+  parse("{ \"jwt\": \"\", \"applyThreads\": 4 }").toVelocyPack(builder, false, false);
+  builder.close();
+  CHECK((4 == builder.slice().get("applyThreads").getNumber<uint64_t>()));
+}
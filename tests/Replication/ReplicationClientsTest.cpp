@@ -0,0 +1,145 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Basics/FileUtils.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Basics/files.h"
+#include "Basics/system-functions.h"
+#include "Replication/ReplicationClients.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::basics;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+TEST_CASE("ReplicationClientsSubscriptions", "[replication]") {
+  std::string const filename =
+      FileUtils::buildFilename(TRI_GetTempPath(), "subscriptions-test.json");
+  FileUtils::remove(filename);
+
+  ReplicationClientsProgressTracker tracker;
+  tracker.loadSubscriptions(filename);
+
+  SECTION("subscriptions hold back the lowest served tick") {
+    CHECK((UINT64_MAX == tracker.lowestServedValue()));
+    CHECK((UINT64_MAX == tracker.lowestCommittedTick()));
+
+    CHECK((tracker.subscribe("a", {}, 100).ok()));
+    CHECK((tracker.subscribe("b", {"c1", "c2"}, 200).ok()));
+    CHECK((100 == tracker.lowestServedValue()));
+    CHECK((100 == tracker.lowestCommittedTick()));
+
+    // the tick of an existing subscription is kept
+    CHECK((tracker.subscribe("a", {"c1"}, 300).ok()));
+    ReplicationSubscription subscription;
+    REQUIRE((tracker.subscription("a", subscription)));
+    CHECK((100 == subscription.committedTick));
+    CHECK((std::vector<std::string>{"c1"} == subscription.collections));
+
+    CHECK((tracker.commit("a", 250).ok()));
+    CHECK((200 == tracker.lowestCommittedTick()));
+
+    // ticks never go back
+    CHECK((tracker.commit("a", 50).ok()));
+    REQUIRE((tracker.subscription("a", subscription)));
+    CHECK((250 == subscription.committedTick));
+
+    CHECK((TRI_ERROR_HTTP_NOT_FOUND == tracker.commit("c", 1).errorNumber()));
+    CHECK((tracker.unsubscribe("b").ok()));
+    CHECK((TRI_ERROR_HTTP_NOT_FOUND == tracker.unsubscribe("b").errorNumber()));
+    CHECK((250 == tracker.lowestCommittedTick()));
+    CHECK((TRI_ERROR_BAD_PARAMETER == tracker.subscribe("", {}, 1).errorNumber()));
+  }
+
+  SECTION("subscriptions are persisted") {
+    CHECK((tracker.subscribe("a", {"c1"}, 100, 60.0).ok()));
+    CHECK((tracker.subscribe("b", {}, 200).ok()));
+    CHECK((tracker.commit("a", 150).ok()));
+
+    ReplicationClientsProgressTracker other;
+    other.loadSubscriptions(filename);
+
+    ReplicationSubscription expected;
+    ReplicationSubscription actual;
+    for (std::string const name : {"a", "b"}) {
+      REQUIRE((tracker.subscription(name, expected)));
+      REQUIRE((other.subscription(name, actual)));
+      CHECK((expected.committedTick == actual.committedTick));
+      CHECK((expected.collections == actual.collections));
+      CHECK((expected.ttl == actual.ttl));
+      CHECK((expected.expireStamp == actual.expireStamp));
+    }
+    REQUIRE((other.subscription("a", actual)));
+    CHECK((60.0 == actual.ttl));
+    REQUIRE((other.subscription("b", actual)));
+    CHECK((ReplicationSubscription::DefaultTtl == actual.ttl));
+
+    // the listing is what ends up in the file
+    VPackBuilder listing;
+    tracker.subscriptionsToVelocyPack(listing);
+    VPackBuilder file = VelocyPackHelper::velocyPackFromFile(filename);
+    CHECK((listing.slice().toJson() == file.slice().toJson()));
+
+    // dropping the database removes the file
+    tracker.dropSubscriptions();
+    CHECK((UINT64_MAX == tracker.lowestCommittedTick()));
+    CHECK((!FileUtils::exists(filename)));
+  }
+
+  SECTION("subscriptions expire after their TTL") {
+    CHECK((tracker.subscribe("short", {}, 100, 10.0).ok()));
+    CHECK((tracker.subscribe("long", {}, 200).ok()));
+
+    ReplicationSubscription subscription;
+    REQUIRE((tracker.subscription("short", subscription)));
+    CHECK((10.0 == subscription.ttl));
+    double const expires = subscription.expireStamp;
+    CHECK((expires <= TRI_microtime() + 10.0));
+
+    tracker.garbageCollect(TRI_microtime());
+    CHECK((100 == tracker.lowestCommittedTick()));
+
+    // committing, even without progress, keeps the consumer alive
+    CHECK((tracker.commit("short", 100).ok()));
+    REQUIRE((tracker.subscription("short", subscription)));
+    CHECK((subscription.expireStamp >= expires));
+
+    tracker.garbageCollect(TRI_microtime() + 3600.0);
+    CHECK((!tracker.subscription("short", subscription)));
+    CHECK((tracker.subscription("long", subscription)));
+    CHECK((200 == tracker.lowestCommittedTick()));
+    CHECK((200 == tracker.lowestServedValue()));
+
+    // the expiry is persisted
+    ReplicationClientsProgressTracker other;
+    other.loadSubscriptions(filename);
+    CHECK((!other.subscription("short", subscription)));
+    CHECK((200 == other.lowestCommittedTick()));
+  }
+
+  FileUtils::remove(filename);
+}
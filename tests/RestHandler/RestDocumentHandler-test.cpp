@@ -0,0 +1,190 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+#include "../Mocks/StorageEngineMock.h"
+#include "../IResearch/RestHandlerMock.h"
+
+#if USE_ENTERPRISE
+  #include "Enterprise/Ldap/LdapFeature.h"
+#endif
+
+#include "Basics/Exceptions.h"
+#include "Basics/StaticStrings.h"
+#include "Cluster/ServerState.h"
+#include "GeneralServer/AuthenticationFeature.h"
+#include "RestHandler/RestDocumentHandler.h"
+#include "RestServer/DatabaseFeature.h"
+#include "RestServer/QueryRegistryFeature.h"
+#include "StorageEngine/EngineSelectorFeature.h"
+#include "Transaction/ManagerFeature.h"
+#include "Transaction/StandaloneContext.h"
+#include "Utils/OperationOptions.h"
+#include "Utils/SingleCollectionTransaction.h"
+#include "VocBase/LogicalCollection.h"
+#include "velocypack/Parser.h"
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 setup / tear-down
+// -----------------------------------------------------------------------------
+
+struct RestDocumentHandlerSetup {
+  arangodb::application_features::ApplicationServer server;
+  StorageEngineMock engine;
+  std::vector<std::pair<arangodb::application_features::ApplicationFeature*, bool>> features;
+  arangodb::ServerState::RoleEnum oldRole;
+
+  RestDocumentHandlerSetup(): server(nullptr, nullptr), engine(server) {
+    arangodb::EngineSelectorFeature::ENGINE = &engine;
+
+    // the single document read fast path is only taken on single servers
+    oldRole = arangodb::ServerState::instance()->getRole();
+    arangodb::ServerState::instance()->setRole(arangodb::ServerState::ROLE_SINGLE);
+
+    // suppress INFO {authentication} Authentication is turned on (system only), authentication for unix sockets is turned on
+    // suppress WARNING {authentication} --server.jwt-secret is insecure. Use --server.jwt-secret-keyfile instead
+    arangodb::LogTopic::setLogLevel(arangodb::Logger::AUTHENTICATION.name(), arangodb::LogLevel::ERR);
+
+    // setup required application features
+    features.emplace_back(new arangodb::AuthenticationFeature(server), false); // required for VocbaseContext
+    features.emplace_back(new arangodb::DatabaseFeature(server), false); // required for TRI_vocbase_t
+    features.emplace_back(new arangodb::QueryRegistryFeature(server), false); // required for TRI_vocbase_t
+    features.emplace_back(new arangodb::transaction::ManagerFeature(server), false); // required for x-arango-trx-id lookups
+
+#if USE_ENTERPRISE
+      features.emplace_back(new arangodb::LdapFeature(server), false); // required for AuthenticationFeature with USE_ENTERPRISE
+#endif
+
+    for (auto& f: features) {
+      arangodb::application_features::ApplicationServer::server->addFeature(f.first);
+    }
+
+    for (auto& f: features) {
+      f.first->prepare();
+    }
+
+    for (auto& f: features) {
+      if (f.second) {
+        f.first->start();
+      }
+    }
+  }
+
+  ~RestDocumentHandlerSetup() {
+    arangodb::application_features::ApplicationServer::server = nullptr;
+    arangodb::EngineSelectorFeature::ENGINE = nullptr;
+
+    // destroy application features
+    for (auto& f : features) {
+      if (f.second) {
+        f.first->stop();
+      }
+    }
+
+    for (auto& f : features) {
+      f.first->unprepare();
+    }
+
+    arangodb::LogTopic::setLogLevel(arangodb::Logger::AUTHENTICATION.name(), arangodb::LogLevel::DEFAULT);
+    arangodb::ServerState::instance()->setRole(oldRole);
+  }
+};
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+TEST_CASE("RestDocumentHandlerTest", "[rest]") {
+  RestDocumentHandlerSetup s;
+  (void)(s);
+
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1, "testVocbase");
+  auto createJson = arangodb::velocypack::Parser::fromJson("{ \"name\": \"testCollection\" }");
+  auto collection = vocbase.createCollection(createJson->slice());
+  REQUIRE((nullptr != collection));
+
+  {
+    auto doc = arangodb::velocypack::Parser::fromJson("{ \"_key\": \"abc\", \"value\": 1 }");
+    arangodb::OperationOptions options;
+    arangodb::SingleCollectionTransaction trx(arangodb::transaction::StandaloneContext::Create(vocbase),
+                                              *collection,
+                                              arangodb::AccessMode::Type::WRITE);
+    REQUIRE((trx.begin().ok()));
+    REQUIRE((trx.insert(collection->name(), doc->slice(), options).ok()));
+    REQUIRE((trx.commit().ok()));
+  }
+
+  auto makeHandler = [&vocbase](GeneralRequestMock*& request, GeneralResponseMock*& response) {
+    auto requestPtr = std::make_unique<GeneralRequestMock>(vocbase);
+    auto responsePtr = std::make_unique<GeneralResponseMock>();
+    request = requestPtr.get();
+    response = responsePtr.get();
+    request->setRequestType(arangodb::rest::RequestType::GET);
+    request->addSuffix("testCollection");
+    request->addSuffix("abc");
+    return std::make_unique<arangodb::RestDocumentHandler>(requestPtr.release(), responsePtr.release());
+  };
+
+SECTION("test_read_without_transaction_id") {
+  GeneralRequestMock* request = nullptr;
+  GeneralResponseMock* response = nullptr;
+  auto handler = makeHandler(request, response);
+
+  auto status = handler->execute();
+  CHECK((arangodb::RestStatus::DONE == status));
+  CHECK((arangodb::rest::ResponseCode::OK == response->responseCode()));
+  auto slice = response->_payload.slice();
+  CHECK((slice.isObject()));
+  CHECK((slice.get(arangodb::StaticStrings::KeyString).isString() && std::string("abc") == slice.get(arangodb::StaticStrings::KeyString).copyString()));
+  CHECK((slice.get("value").isNumber<int>() && 1 == slice.get("value").getNumber<int>()));
+}
+
+SECTION("test_read_with_unknown_transaction_id") {
+  GeneralRequestMock* request = nullptr;
+  GeneralResponseMock* response = nullptr;
+  auto handler = makeHandler(request, response);
+  request->headers()[arangodb::StaticStrings::TransactionId] = "12345";
+
+  // the document exists, so only skipping the fast path surfaces the error
+  int code = TRI_ERROR_NO_ERROR;
+  try {
+    handler->execute();
+  } catch (arangodb::basics::Exception const& ex) {
+    code = ex.code();
+  }
+  CHECK((TRI_ERROR_TRANSACTION_NOT_FOUND == code));
+}
+
+SECTION("test_read_with_invalid_transaction_id") {
+  GeneralRequestMock* request = nullptr;
+  GeneralResponseMock* response = nullptr;
+  auto handler = makeHandler(request, response);
+  request->headers()[arangodb::StaticStrings::TransactionId] = "abc";
+
+  int code = TRI_ERROR_NO_ERROR;
+  try {
+    handler->execute();
+  } catch (arangodb::basics::Exception const& ex) {
+    code = ex.code();
+  }
+  CHECK((TRI_ERROR_BAD_PARAMETER == code));
+}
+
+}
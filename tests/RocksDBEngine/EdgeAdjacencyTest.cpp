@@ -0,0 +1,164 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+#include "catch.hpp"
+
+#include "Basics/FileUtils.h"
+#include "Basics/files.h"
+#include "Basics/system-functions.h"
+#include "RocksDBEngine/RocksDBEdgeAdjacency.h"
+#include "RocksDBEngine/RocksDBFormat.h"
+#include "RocksDBEngine/RocksDBKey.h"
+#include "RocksDBEngine/RocksDBTypes.h"
+#include "RocksDBEngine/RocksDBValue.h"
+#include "Scheduler/SchedulerFeature.h"
+
+#include <rocksdb/db.h>
+#include <rocksdb/options.h>
+#include <velocypack/StringRef.h>
+
+using namespace arangodb;
+
+namespace {
+
+/// @brief a database in a temporary directory, removed afterwards
+struct EdgeAdjacencyDatabase {
+  std::string directory;
+  rocksdb::DB* db;
+
+  EdgeAdjacencyDatabase() : db(nullptr) {
+    directory = basics::FileUtils::buildFilename(
+        TRI_GetTempPath(), "edge-adjacency-test-" + std::to_string(TRI_microtime()));
+    rocksdb::Options options;
+    options.create_if_missing = true;
+    REQUIRE((rocksdb::DB::Open(options, directory, &db).ok()));
+  }
+
+  ~EdgeAdjacencyDatabase() {
+    delete db;
+    TRI_RemoveDirectory(directory.c_str());
+  }
+
+  /// @brief writes the edge index entry of an edge from vertex to other
+  void insert(uint64_t objectId, std::string const& vertex,
+              std::string const& other, uint64_t documentId) {
+    RocksDBKey key;
+    key.constructEdgeIndexValue(objectId, velocypack::StringRef(vertex),
+                                LocalDocumentId(documentId));
+    RocksDBValue value = RocksDBValue::EdgeIndexValue(velocypack::StringRef(other));
+    REQUIRE((db->Put(rocksdb::WriteOptions(), key.string(), value.string()).ok()));
+  }
+};
+
+/// @brief the neighbors and document ids of the vertex, in index order
+std::vector<std::pair<std::string, uint64_t>> edges(RocksDBEdgeAdjacency const& adjacency,
+                                                    std::string const& vertex) {
+  size_t begin = 0;
+  size_t end = 0;
+  REQUIRE((adjacency.lookup(velocypack::StringRef(vertex), 0, begin, end)));
+  std::vector<std::pair<std::string, uint64_t>> result;
+  for (size_t i = begin; i < end; ++i) {
+    result.emplace_back(adjacency.neighbor(i).copyString(), adjacency.documentId(i).id());
+  }
+  return result;
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+TEST_CASE("RocksDBEdgeAdjacency", "[rocksdb][edge-adjacency]") {
+  rocksutils::setRocksDBKeyFormatEndianess(RocksDBEndianness::Little);
+
+  EdgeAdjacencyDatabase database;
+  rocksdb::ColumnFamilyHandle* cf = database.db->DefaultColumnFamily();
+  std::atomic<bool> canceled(false);
+
+  database.insert(1, "v/a", "v/b", 1);
+  database.insert(1, "v/a", "v/c", 2);
+  database.insert(1, "v/b", "v/c", 3);
+  // the edges of another index are not read
+  database.insert(2, "v/c", "v/a", 4);
+
+  SECTION("the edges of each vertex are read from the snapshot") {
+    RocksDBEdgeAdjacency adjacency;
+    REQUIRE((adjacency.build(database.db, cf, 1, UINT64_MAX, canceled)));
+    CHECK((0 < adjacency.memory()));
+
+    std::vector<std::pair<std::string, uint64_t>> expected{{"v/b", 1}, {"v/c", 2}};
+    CHECK((expected == edges(adjacency, "v/a")));
+    expected = {{"v/c", 3}};
+    CHECK((expected == edges(adjacency, "v/b")));
+    CHECK((edges(adjacency, "v/c").empty()));
+    CHECK((edges(adjacency, "v/unknown").empty()));
+
+    // later writes are not part of the snapshot
+    rocksdb::SequenceNumber snapshot = adjacency.sequenceNumber();
+    database.insert(1, "v/c", "v/a", 5);
+    CHECK((snapshot < database.db->GetLatestSequenceNumber()));
+    CHECK((edges(adjacency, "v/c").empty()));
+  }
+
+  SECTION("changed vertices are looked up in the index") {
+    RocksDBEdgeAdjacency adjacency;
+    REQUIRE((adjacency.build(database.db, cf, 1, UINT64_MAX, canceled)));
+
+    size_t begin = 0;
+    size_t end = 0;
+    adjacency.markChanged({42});
+    CHECK((!adjacency.lookup(velocypack::StringRef("v/a"), 42, begin, end)));
+    CHECK((adjacency.lookup(velocypack::StringRef("v/a"), 43, begin, end)));
+    CHECK((2 == end - begin));
+  }
+
+  SECTION("many changed vertices need a rebuild") {
+    RocksDBEdgeAdjacency adjacency;
+    REQUIRE((adjacency.build(database.db, cf, 1, UINT64_MAX, canceled)));
+    CHECK((!adjacency.needsRebuild()));
+
+    std::vector<uint64_t> hashes;
+    for (uint64_t i = 0; i < 1024; ++i) {
+      hashes.emplace_back(i);
+    }
+    adjacency.markChanged(hashes);
+    CHECK((!adjacency.needsRebuild()));
+    adjacency.markChanged({1024});
+    CHECK((adjacency.needsRebuild()));
+  }
+
+  SECTION("edges above the memory limit are not kept") {
+    RocksDBEdgeAdjacency adjacency;
+    CHECK((!adjacency.build(database.db, cf, 1, 16, canceled)));
+  }
+
+  SECTION("the cache has nothing to hand out before a build") {
+    // without a scheduler, no build is started
+    auto* scheduler = SchedulerFeature::SCHEDULER;
+    SchedulerFeature::SCHEDULER = nullptr;
+    auto cache = std::make_shared<RocksDBEdgeAdjacencyCache>(cf, 1, UINT64_MAX);
+    CHECK((nullptr == cache->get(database.db->GetLatestSequenceNumber())));
+    cache->markChanged({42});
+    CHECK((0 == cache->memory()));
+    SchedulerFeature::SCHEDULER = scheduler;
+  }
+}
@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "catch.hpp"
+
+#include "RocksDBEngine/RocksDBComparator.h"
+#include "RocksDBEngine/RocksDBFilterPolicy.h"
+#include "RocksDBEngine/RocksDBFormat.h"
+#include "RocksDBEngine/RocksDBKey.h"
+
+#include <rocksdb/filter_policy.h>
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace {
+RocksDBKey uniqueKey(uint64_t objectId, VPackSlice values) {
+  RocksDBKey key;
+  key.constructUniqueVPackIndexValue(objectId, values);
+  return key;
+}
+
+std::string entry(RocksDBKey const& key) {
+  char buffer[RocksDBVPackIndexFilterPolicy::entrySize()];
+  return RocksDBVPackIndexFilterPolicy::filterEntry(key.string(), &buffer[0]).ToString();
+}
+}  // namespace
+
+TEST_CASE("RocksDBVPackIndexFilterPolicy", "[rocksdb][filterpolicy]") {
+  rocksutils::setRocksDBKeyFormatEndianess(RocksDBEndianness::Little);
+  RocksDBVPackComparator cmp;
+
+  SECTION("equal keys have equal filter entries") {
+    VPackBuilder values;
+    values.openArray();
+    values.add(VPackValue(1));
+    values.add(VPackValue(0));
+    values.add(VPackValue("foo"));
+    values.close();
+    VPackBuilder other;
+    other.openArray();
+    other.add(VPackValue(1.0));
+    other.add(VPackValue(-0.0));
+    other.add(VPackValue("foo"));
+    other.close();
+
+    RocksDBKey key1 = uniqueKey(42, values.slice());
+    RocksDBKey key2 = uniqueKey(42, other.slice());
+    CHECK(key1.string() != key2.string());
+    REQUIRE(cmp.Compare(key1.string(), key2.string()) == 0);
+    CHECK(entry(key1) == entry(key2));
+    CHECK(entry(key1).size() == RocksDBVPackIndexFilterPolicy::entrySize());
+  }
+
+  SECTION("canonically equivalent strings have equal filter entries") {
+    // "café" in NFC and NFD
+    VPackBuilder nfc;
+    nfc.openArray();
+    nfc.add(VPackValue("caf\xC3\xA9"));
+    nfc.close();
+    VPackBuilder nfd;
+    nfd.openArray();
+    nfd.add(VPackValue("cafe\xCC\x81"));
+    nfd.close();
+
+    RocksDBKey key1 = uniqueKey(42, nfc.slice());
+    RocksDBKey key2 = uniqueKey(42, nfd.slice());
+    CHECK(key1.string() != key2.string());
+    REQUIRE(cmp.Compare(key1.string(), key2.string()) == 0);
+    CHECK(entry(key1) == entry(key2));
+
+    RocksDBVPackIndexFilterPolicy policy(rocksdb::NewBloomFilterPolicy(10, false));
+    std::unique_ptr<rocksdb::FilterBitsBuilder> builder(policy.GetFilterBitsBuilder());
+    REQUIRE(builder != nullptr);
+    builder->AddKey(key1.string());
+    std::unique_ptr<char const[]> buf;
+    rocksdb::Slice filter = builder->Finish(&buf);
+    std::unique_ptr<rocksdb::FilterBitsReader> reader(policy.GetFilterBitsReader(filter));
+    REQUIRE(reader != nullptr);
+    CHECK(reader->MayMatch(key2.string()));
+  }
+
+  SECTION("different keys have different filter entries") {
+    auto values = VPackParser::fromJson("[1, \"foo\"]");
+    auto other = VPackParser::fromJson("[1, \"bar\"]");
+    CHECK(entry(uniqueKey(42, values->slice())) != entry(uniqueKey(42, other->slice())));
+    CHECK(entry(uniqueKey(42, values->slice())) != entry(uniqueKey(43, values->slice())));
+  }
+
+  SECTION("prefixes pass through") {
+    RocksDBKey key = uniqueKey(42, VPackParser::fromJson("[1]")->slice());
+    rocksdb::Slice prefix(key.string().data(), RocksDBKey::objectIdSize());
+    char buffer[RocksDBVPackIndexFilterPolicy::entrySize()];
+    CHECK(RocksDBVPackIndexFilterPolicy::filterEntry(prefix, &buffer[0]) == prefix);
+  }
+
+  SECTION("lookups of equal keys match the filter") {
+    RocksDBVPackIndexFilterPolicy policy(rocksdb::NewBloomFilterPolicy(10, false));
+    std::unique_ptr<rocksdb::FilterBitsBuilder> builder(policy.GetFilterBitsBuilder());
+    REQUIRE(builder != nullptr);
+    for (int i = 0; i < 100; ++i) {
+      VPackBuilder values;
+      values.openArray();
+      values.add(VPackValue(i));
+      values.close();
+      builder->AddKey(uniqueKey(42, values.slice()).string());
+    }
+    std::unique_ptr<char const[]> buf;
+    rocksdb::Slice filter = builder->Finish(&buf);
+    std::unique_ptr<rocksdb::FilterBitsReader> reader(policy.GetFilterBitsReader(filter));
+    REQUIRE(reader != nullptr);
+    for (int i = 0; i < 100; ++i) {
+      VPackBuilder values;
+      values.openArray();
+      values.add(VPackValue(static_cast<double>(i)));
+      values.close();
+      CHECK(reader->MayMatch(uniqueKey(42, values.slice()).string()));
+    }
+  }
+}
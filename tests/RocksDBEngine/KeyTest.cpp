@@ -611,6 +611,35 @@ TEST_CASE("RocksDBKeyBoundsTest Little-Endian", "[rocksdb][keybounds]") {
     CHECK(cmp->Compare(key6.string(), key7.string()) < 0);
     CHECK(cmp->Compare(key4.string(), key7.string()) < 0);
   }
+
+  SECTION("test_combined_hash_index") {
+    auto cmp = std::make_unique<RocksDBVPackComparator>();
+
+    VPackBuilder a;
+    a(VPackValue(VPackValueType::Array))(VPackValue("foo"))(VPackValue(1))();
+    VPackBuilder b;
+    b(VPackValue(VPackValueType::Array))(VPackValue("foo"))(VPackValue(2))();
+    VPackBuilder c;
+    c(VPackValue(VPackValueType::Array))(VPackValue("foo"))(VPackValue(2.0))();
+    VPackBuilder d;
+    d(VPackValue(VPackValueType::Array))(VPackValue("foo"))();
+
+    RocksDBKey key1, key2, key3, key4, key5;
+    key1.constructVPackIndexValue(1, a.slice(), LocalDocumentId(18));
+    key2.constructVPackIndexValue(1, a.slice(), LocalDocumentId(60));
+    key3.constructVPackIndexValue(1, b.slice(), LocalDocumentId(12));
+    key4.constructVPackIndexValue(1, c.slice(), LocalDocumentId(12));
+    key5.constructVPackIndexValue(1, d.slice(), LocalDocumentId(90));
+
+    CHECK(cmp->Compare(key1.string(), key1.string()) == 0);
+    CHECK(cmp->Compare(key1.string(), key2.string()) < 0);
+    CHECK(cmp->Compare(key2.string(), key1.string()) > 0);
+    CHECK(cmp->Compare(key2.string(), key3.string()) < 0);
+    // same value, different representation
+    CHECK(cmp->Compare(key3.string(), key4.string()) == 0);
+    CHECK(cmp->Compare(key5.string(), key1.string()) < 0);
+    CHECK(cmp->Compare(key3.string(), key5.string()) > 0);
+  }
 }
 
 
@@ -0,0 +1,162 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+#include "catch.hpp"
+
+#include "Basics/FileUtils.h"
+#include "Basics/files.h"
+#include "Basics/system-functions.h"
+#include "RocksDBEngine/RocksDBCollection.h"
+#include "RocksDBEngine/RocksDBFormat.h"
+#include "RocksDBEngine/RocksDBKey.h"
+#include "RocksDBEngine/RocksDBTypes.h"
+
+#include <rocksdb/db.h>
+#include <rocksdb/options.h>
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <algorithm>
+
+using namespace arangodb;
+
+namespace {
+
+/// @brief a database in a temporary directory, removed afterwards
+struct ReadMultipleDatabase {
+  std::string directory;
+  rocksdb::DB* db;
+
+  ReadMultipleDatabase() : db(nullptr) {
+    directory = basics::FileUtils::buildFilename(
+        TRI_GetTempPath(), "read-multiple-test-" + std::to_string(TRI_microtime()));
+    rocksdb::Options options;
+    options.create_if_missing = true;
+    REQUIRE((rocksdb::DB::Open(options, directory, &db).ok()));
+  }
+
+  ~ReadMultipleDatabase() {
+    delete db;
+    TRI_RemoveDirectory(directory.c_str());
+  }
+
+  /// @brief writes a document with the given id, its value attribute is the
+  /// id as well
+  void insert(uint64_t objectId, uint64_t documentId) {
+    RocksDBKey key;
+    key.constructDocument(objectId, LocalDocumentId(documentId));
+    VPackBuilder document;
+    document.openObject();
+    document.add("value", VPackValue(documentId));
+    document.close();
+    rocksdb::Slice value(reinterpret_cast<char const*>(document.slice().start()),
+                         document.slice().byteSize());
+    REQUIRE((db->Put(rocksdb::WriteOptions(), key.string(), value).ok()));
+  }
+};
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+TEST_CASE("RocksDBCollectionReadMultiple", "[rocksdb][read-multiple]") {
+  rocksutils::setRocksDBKeyFormatEndianess(RocksDBEndianness::Little);
+
+  ReadMultipleDatabase database;
+  for (uint64_t id : {1, 2, 3, 4, 5}) {
+    database.insert(1, id);
+  }
+  // a document with the same id in another collection
+  database.insert(2, 6);
+
+  std::vector<std::vector<std::string>> lookups;
+  RocksDBCollection::MultiGetFunction multiGet =
+      [&database, &lookups](std::vector<rocksdb::Slice> const& keys,
+                            std::vector<std::string>* values) {
+        lookups.emplace_back();
+        for (auto const& key : keys) {
+          lookups.back().emplace_back(key.ToString());
+        }
+        std::vector<rocksdb::ColumnFamilyHandle*> cfs(keys.size(),
+                                                      database.db->DefaultColumnFamily());
+        return database.db->MultiGet(rocksdb::ReadOptions(), cfs, keys, values);
+      };
+
+  // reads the documents and returns the pairs of id and value attribute, in
+  // the order of the callbacks
+  auto read = [&](std::vector<LocalDocumentId> const& ids, size_t& found)
+      -> std::vector<std::pair<uint64_t, uint64_t>> {
+    std::vector<std::pair<uint64_t, uint64_t>> result;
+    found = RocksDBCollection::readMultiple(
+        1, nullptr, ids, multiGet, [&result](LocalDocumentId const& id, VPackSlice doc) {
+          result.emplace_back(id.id(), doc.get("value").getNumber<uint64_t>());
+        });
+    return result;
+  };
+
+  SECTION("the documents are returned in the order of the ids") {
+    size_t found = 0;
+    auto result = read({LocalDocumentId(4), LocalDocumentId(1), LocalDocumentId(5),
+                        LocalDocumentId(2)},
+                       found);
+    std::vector<std::pair<uint64_t, uint64_t>> expected{{4, 4}, {1, 1}, {5, 5}, {2, 2}};
+    CHECK((expected == result));
+    CHECK((4 == found));
+
+    // all documents are read with a single lookup, in the order of their keys
+    REQUIRE((1 == lookups.size()));
+    CHECK((4 == lookups[0].size()));
+    CHECK((std::is_sorted(lookups[0].begin(), lookups[0].end())));
+  }
+
+  SECTION("missing documents are left out") {
+    size_t found = 0;
+    auto result = read({LocalDocumentId(3), LocalDocumentId(42), LocalDocumentId(6),
+                        LocalDocumentId(), LocalDocumentId(1)},
+                       found);
+    std::vector<std::pair<uint64_t, uint64_t>> expected{{3, 3}, {1, 1}};
+    CHECK((expected == result));
+    CHECK((2 == found));
+
+    // the unset id is not looked up
+    REQUIRE((1 == lookups.size()));
+    CHECK((4 == lookups[0].size()));
+  }
+
+  SECTION("repeated ids return the document every time") {
+    size_t found = 0;
+    auto result = read({LocalDocumentId(2), LocalDocumentId(5), LocalDocumentId(2),
+                        LocalDocumentId(2)},
+                       found);
+    std::vector<std::pair<uint64_t, uint64_t>> expected{{2, 2}, {5, 5}, {2, 2}, {2, 2}};
+    CHECK((expected == result));
+    CHECK((4 == found));
+  }
+
+  SECTION("no documents found") {
+    size_t found = 0;
+    auto result = read({LocalDocumentId(42), LocalDocumentId(43)}, found);
+    CHECK((result.empty()));
+    CHECK((0 == found));
+  }
+}
@@ -0,0 +1,63 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "RocksDBEngine/RocksDBReplicationCommon.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace {
+
+/// @brief the way chunk hashes were computed before, servers of different
+/// versions must agree on them
+uint64_t hashWithBuilder(std::string const& key, TRI_voc_rid_t rid) {
+  VPackBuilder b;
+  b.add(VPackValue(key));
+  uint64_t hash = b.slice().hashString();
+  b.clear();
+  char ridBuffer[21];
+  b.add(TRI_RidToValuePair(rid, &ridBuffer[0]));
+  return hash ^ b.slice().hashString();
+}
+
+}  // namespace
+
+TEST_CASE("RocksDBReplicationCommon", "[rocksdb][replication]") {
+  SECTION("test_key_hash_is_compatible") {
+    std::vector<TRI_voc_rid_t> rids{1, 12345, 1564565044887879680ULL,
+                                    std::numeric_limits<TRI_voc_rid_t>::max()};
+    std::vector<std::string> keys{"a", "abc", std::string(126, 'x'),
+                                  std::string(127, 'y'), std::string(254, 'z'),
+                                  std::string(300, 'w')};
+
+    for (auto const& key : keys) {
+      for (auto rid : rids) {
+        CHECK(hashKeyAndRevision(velocypack::StringRef(key), rid) ==
+              hashWithBuilder(key, rid));
+      }
+    }
+  }
+}
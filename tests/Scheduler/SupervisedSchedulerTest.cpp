@@ -0,0 +1,131 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for the SupervisedScheduler
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Cluster/ServerState.h"
+#include "Scheduler/SupervisedScheduler.h"
+
+#include <future>
+#include <thread>
+
+using namespace arangodb;
+
+TEST_CASE("SupervisedScheduler load shedding", "[scheduler]") {
+  std::vector<RequestLane> const sheddable = {RequestLane::CLIENT_AQL,
+                                              RequestLane::CLIENT_V8,
+                                              RequestLane::CLIENT_SLOW};
+  std::vector<RequestLane> const protectedLanes = {
+      RequestLane::CLIENT_FAST,     RequestLane::CLIENT_UI,
+      RequestLane::AGENCY_INTERNAL, RequestLane::AGENCY_CLUSTER,
+      RequestLane::CLUSTER_INTERNAL, RequestLane::CLUSTER_V8,
+      RequestLane::SERVER_REPLICATION, RequestLane::TASK_V8};
+
+  SECTION("coordinators and single servers shed slow client requests") {
+    for (auto role : {ServerState::ROLE_COORDINATOR, ServerState::ROLE_SINGLE}) {
+      for (auto lane : sheddable) {
+        CHECK(SupervisedScheduler::canShedLoad(lane, role));
+      }
+      for (auto lane : protectedLanes) {
+        CHECK(!SupervisedScheduler::canShedLoad(lane, role));
+      }
+    }
+  }
+
+  SECTION("DB servers and agents never shed load") {
+    // their requests come from coordinators, e.g. synchronous replication
+    for (auto role : {ServerState::ROLE_DBSERVER, ServerState::ROLE_AGENT,
+                      ServerState::ROLE_UNDEFINED}) {
+      for (auto lane : sheddable) {
+        CHECK(!SupervisedScheduler::canShedLoad(lane, role));
+      }
+      for (auto lane : protectedLanes) {
+        CHECK(!SupervisedScheduler::canShedLoad(lane, role));
+      }
+    }
+  }
+
+  SECTION("an idle scheduler is not overloaded") {
+    SupervisedScheduler scheduler(1, 2, 16, 16, 16, 0.001);
+    for (auto lane : sheddable) {
+      CHECK(!scheduler.isOverloaded(lane));
+    }
+  }
+}
+
+TEST_CASE("SupervisedScheduler local queues", "[scheduler]") {
+  // no threads are started, the test runs the worker loop itself
+  SupervisedScheduler scheduler(1, 2, 16, 16, 16, 0.0);
+
+  auto worker = std::make_shared<SupervisedScheduler::WorkerState>(scheduler);
+  worker->_localQueue = &scheduler._localQueues[0];
+  worker->_queueRetryCount = 3;
+
+  SECTION("a stopped worker drains its local queue") {
+    int ran = 0;
+    SupervisedScheduler::_threadLocalQueue = worker->_localQueue;
+    CHECK(scheduler.queueLocal(RequestLane::CLIENT_FAST, [&ran]() { ++ran; }));
+    CHECK(scheduler.queueLocal(RequestLane::CLIENT_FAST, [&ran]() { ++ran; }));
+    SupervisedScheduler::_threadLocalQueue = nullptr;
+    CHECK(2 == worker->_localQueue->_size.load());
+
+    worker->_stop = true;
+    while (auto work = scheduler.getWork(worker)) {
+      (*work)();
+    }
+    CHECK(2 == ran);
+    CHECK(0 == worker->_localQueue->_size.load());
+  }
+
+  SECTION("queueing locally wakes up a sleeping worker") {
+    worker->_sleepTimeout_ms = 0;  // sleep until notified
+    auto result = std::async(std::launch::async, [&scheduler, &worker]() {
+      return scheduler.getWork(worker);
+    });
+
+    while (scheduler._numSleepingWorker.load() == 0) {
+      std::this_thread::yield();
+    }
+
+    // the job goes to the local queue of another worker, which is busy
+    bool ran = false;
+    SupervisedScheduler::_threadLocalQueue = &scheduler._localQueues[1];
+    CHECK(scheduler.queueLocal(RequestLane::CLIENT_FAST, [&ran]() { ran = true; }));
+    SupervisedScheduler::_threadLocalQueue = nullptr;
+
+    bool woken = (std::future_status::ready == result.wait_for(std::chrono::seconds(10)));
+    CHECK(woken);
+    if (!woken) {
+      // release the worker, so that the test does not hang
+      std::lock_guard<std::mutex> guard(scheduler._mutex);
+      worker->_stop = true;
+      scheduler._conditionWork.notify_all();
+    }
+
+    auto work = result.get();
+    REQUIRE(work != nullptr);
+    (*work)();
+    CHECK(ran);
+  }
+}
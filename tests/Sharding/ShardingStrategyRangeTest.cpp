@@ -0,0 +1,71 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for ShardingStrategyRange
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Basics/Exceptions.h"
+#include "Sharding/ShardingStrategyRange.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace {
+
+bool isValid(std::string const& boundaries, size_t numberOfShards) {
+  auto builder = VPackParser::fromJson(boundaries);
+  try {
+    ShardingStrategyRange::validateBoundaries(builder->slice(), numberOfShards);
+  } catch (basics::Exception const& ex) {
+    CHECK(ex.code() == TRI_ERROR_BAD_PARAMETER);
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+TEST_CASE("ShardingStrategyRangeTest", "[sharding]") {
+  SECTION("test_valid_boundaries") {
+    CHECK(isValid("[]", 1));
+    CHECK(isValid("[10]", 2));
+    CHECK(isValid("[10, 20, 30]", 4));
+    CHECK(isValid("[\"2019-01\", \"2019-02\", \"2019-03\"]", 4));
+    // values of different types are ordered like in AQL
+    CHECK(isValid("[null, false, 1, \"a\", [], {}]", 7));
+  }
+
+  SECTION("test_invalid_boundaries") {
+    CHECK(!isValid("null", 1));
+    CHECK(!isValid("{}", 1));
+    CHECK(!isValid("[10]", 1));
+    CHECK(!isValid("[10]", 3));
+    CHECK(!isValid("[]", 0));
+    CHECK(!isValid("[20, 10]", 3));
+    CHECK(!isValid("[10, 10]", 3));
+    CHECK(!isValid("[\"a\", 1]", 3));
+  }
+}
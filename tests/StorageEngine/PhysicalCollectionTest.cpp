@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+#include "../Mocks/StorageEngineMock.h"
+
+#include "RestServer/DatabaseFeature.h"
+#include "RestServer/QueryRegistryFeature.h"
+#include "StorageEngine/EngineSelectorFeature.h"
+#include "VocBase/LogicalCollection.h"
+#include "velocypack/Parser.h"
+
+#include <limits>
+
+namespace {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 setup / tear-down
+// -----------------------------------------------------------------------------
+
+struct PhysicalCollectionSetup {
+  arangodb::application_features::ApplicationServer server;
+  StorageEngineMock engine;
+  std::vector<std::pair<arangodb::application_features::ApplicationFeature*, bool>> features;
+
+  PhysicalCollectionSetup(): server(nullptr, nullptr), engine(server) {
+    arangodb::EngineSelectorFeature::ENGINE = &engine;
+
+    // setup required application features
+    features.emplace_back(new arangodb::DatabaseFeature(server), false);
+    features.emplace_back(new arangodb::QueryRegistryFeature(server), false); // required for TRI_vocbase_t instantiation
+
+    for (auto& f: features) {
+      arangodb::application_features::ApplicationServer::server->addFeature(f.first);
+    }
+
+    for (auto& f: features) {
+      f.first->prepare();
+    }
+  }
+
+  ~PhysicalCollectionSetup() {
+    arangodb::application_features::ApplicationServer::server = nullptr;
+    arangodb::EngineSelectorFeature::ENGINE = nullptr;
+
+    for (auto& f: features) {
+      f.first->unprepare();
+    }
+  }
+};
+
+/// @brief makes the document preparation methods accessible
+struct PhysicalCollectionTester : public PhysicalCollectionMock {
+  using PhysicalCollectionMock::PhysicalCollectionMock;
+  using arangodb::PhysicalCollection::mergeObjectsForUpdate;
+};
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+TEST_CASE("PhysicalCollection incrementNumbers", "[storage]") {
+  PhysicalCollectionSetup s;
+  (void)(s);
+
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1, "testVocbase");
+  auto json = arangodb::velocypack::Parser::fromJson("{ \"name\": \"testCollection\" }");
+  auto collection = vocbase.createCollection(json->slice());
+  REQUIRE((nullptr != collection));
+  PhysicalCollectionTester physical(*collection, json->slice());
+
+  auto increment = [&physical](std::string const& oldJson, std::string const& deltaJson) {
+    auto oldValue = arangodb::velocypack::Parser::fromJson(oldJson);
+    auto delta = arangodb::velocypack::Parser::fromJson(deltaJson);
+    arangodb::velocypack::Builder builder;
+    TRI_voc_rid_t revisionId = 0;
+    auto res = physical.mergeObjectsForUpdate(nullptr, oldValue->slice(), delta->slice(),
+                                              false, true, true, builder, false,
+                                              revisionId, true);
+    REQUIRE(res.ok());
+    arangodb::velocypack::Builder value;
+    value.add(builder.slice().get("value"));
+    return value;
+  };
+
+  std::string const prefix = "{ \"_key\": \"a\", \"_id\": \"testCollection/a\", \"_rev\": \"1\", \"value\": ";
+
+  SECTION("integers are added as integers") {
+    auto value = increment(prefix + "40 }", "{ \"value\": 2 }");
+    CHECK(value.slice().isInteger());
+    CHECK(42 == value.slice().getNumber<int64_t>());
+
+    value = increment(prefix + "-40 }", "{ \"value\": -2 }");
+    CHECK(value.slice().isInteger());
+    CHECK(-42 == value.slice().getNumber<int64_t>());
+  }
+
+  SECTION("doubles are added as doubles") {
+    auto value = increment(prefix + "1.5 }", "{ \"value\": 2 }");
+    CHECK(value.slice().isDouble());
+    CHECK(3.5 == value.slice().getNumber<double>());
+  }
+
+  SECTION("integer overflow falls back to doubles") {
+    std::string const max = std::to_string(std::numeric_limits<int64_t>::max());
+    std::string const min = std::to_string(std::numeric_limits<int64_t>::min());
+
+    auto value = increment(prefix + max + " }", "{ \"value\": 1 }");
+    CHECK(value.slice().isDouble());
+    CHECK(9223372036854775808.0 == value.slice().getNumber<double>());
+
+    value = increment(prefix + min + " }", "{ \"value\": -1 }");
+    CHECK(value.slice().isDouble());
+    CHECK(-9223372036854775808.0 == value.slice().getNumber<double>());
+
+    // the sum stays an integer as long as it fits
+    value = increment(prefix + max + " }", "{ \"value\": -1 }");
+    CHECK(value.slice().isInteger());
+    CHECK(std::numeric_limits<int64_t>::max() - 1 == value.slice().getNumber<int64_t>());
+  }
+
+  SECTION("integers above INT64_MAX do not throw") {
+    auto value = increment(prefix + "18446744073709551615 }", "{ \"value\": 1 }");
+    CHECK(value.slice().isDouble());
+    CHECK(18446744073709551616.0 == value.slice().getNumber<double>());
+
+    value = increment(prefix + "1 }", "{ \"value\": 18446744073709551615 }");
+    CHECK(value.slice().isDouble());
+    CHECK(18446744073709551616.0 == value.slice().getNumber<double>());
+  }
+}
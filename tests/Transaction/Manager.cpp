@@ -47,6 +47,8 @@
 
 #include "catch.hpp"
 
+#include <thread>
+
 using namespace arangodb;
 
 // -----------------------------------------------------------------------------
@@ -396,6 +398,40 @@ TEST_CASE("TransactionManagerTest", "[transaction]") {
     
     REQUIRE((mgr->getManagedTrxStatus(tid) == transaction::Status::ABORTED));
   }
+
+  SECTION("Active transactions ending on other threads") {
+    transaction::Manager manager(true);
+    std::vector<TRI_voc_tid_t> tids;
+    for (size_t i = 0; i < 100; ++i) {
+      tids.emplace_back(TRI_NewTickServer());
+      manager.registerTransaction(tids.back(), std::make_unique<TransactionData>());
+    }
+    CHECK(manager.getActiveTransactionCount() == 100);
+
+    size_t seen = 0;
+    manager.iterateActiveTransactions(
+        [&seen](TRI_voc_tid_t, TransactionData const*) { ++seen; });
+    CHECK(seen == 100);
+
+    std::thread other([&manager, &tids]() {
+      for (size_t i = 0; i < 50; ++i) {
+        manager.unregisterTransaction(tids[i], i % 10 == 0);
+      }
+    });
+    other.join();
+    CHECK(manager.getActiveTransactionCount() == 50);
+    CHECK(manager.getFailedTransactions().size() == 5);
+
+    for (size_t i = 50; i < tids.size(); ++i) {
+      manager.unregisterTransaction(tids[i], false);
+    }
+    CHECK(manager.getActiveTransactionCount() == 0);
+
+    seen = 0;
+    manager.iterateActiveTransactions(
+        [&seen](TRI_voc_tid_t, TransactionData const*) { ++seen; });
+    CHECK(seen == 0);
+  }
   
   
 
@@ -0,0 +1,199 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/StaticStrings.h"
+#include "RestServer/DatabaseFeature.h"
+#include "RestServer/QueryRegistryFeature.h"
+#include "StorageEngine/EngineSelectorFeature.h"
+#include "Transaction/Methods.h"
+#include "Transaction/StandaloneContext.h"
+#include "Utils/OperationOptions.h"
+#include "Utils/OperationResult.h"
+#include "Utils/SingleCollectionTransaction.h"
+#include "VocBase/LogicalCollection.h"
+
+#include "../Mocks/StorageEngineMock.h"
+
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include "catch.hpp"
+
+using namespace arangodb;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 setup / tear-down
+// -----------------------------------------------------------------------------
+
+struct TransactionMethodsSetup {
+  arangodb::application_features::ApplicationServer server;
+  StorageEngineMock engine;
+  std::vector<std::pair<arangodb::application_features::ApplicationFeature*, bool>> features;
+
+  TransactionMethodsSetup(): server(nullptr, nullptr), engine(server) {
+    arangodb::EngineSelectorFeature::ENGINE = &engine;
+
+    // setup required application features
+    features.emplace_back(new arangodb::DatabaseFeature(server), false); // required for TRI_vocbase_t
+    features.emplace_back(new arangodb::QueryRegistryFeature(server), false); // required for TRI_vocbase_t
+
+    for (auto& f: features) {
+      arangodb::application_features::ApplicationServer::server->addFeature(f.first);
+    }
+
+    for (auto& f: features) {
+      f.first->prepare();
+    }
+
+    for (auto& f: features) {
+      if (f.second) {
+        f.first->start();
+      }
+    }
+  }
+
+  ~TransactionMethodsSetup() {
+    arangodb::application_features::ApplicationServer::server = nullptr;
+    arangodb::EngineSelectorFeature::ENGINE = nullptr;
+
+    // destroy application features
+    for (auto& f: features) {
+      if (f.second) {
+        f.first->stop();
+      }
+    }
+
+    for (auto& f: features) {
+      f.first->unprepare();
+    }
+  }
+};
+
+namespace {
+
+/// @brief repserts the given document, or an array with just that
+/// document, and returns the error code of the operation on the document
+int repsert(TRI_vocbase_t& vocbase, LogicalCollection& collection,
+            VPackSlice document, bool asArray) {
+  VPackBuilder value;
+  if (asArray) {
+    value.openArray();
+    value.add(document);
+    value.close();
+  } else {
+    value.add(document);
+  }
+
+  OperationOptions options;
+  options.overwrite = true;
+  SingleCollectionTransaction trx(transaction::StandaloneContext::Create(vocbase),
+                                  collection, AccessMode::Type::WRITE);
+  REQUIRE((trx.begin().ok()));
+  OperationResult result = trx.insert(collection.name(), value.slice(), options);
+  REQUIRE((trx.commit().ok()));
+
+  if (!asArray) {
+    return result.errorNumber();
+  }
+
+  // errors of the documents of an array are reported in the body
+  REQUIRE((result.ok()));
+  VPackSlice slice = result.slice();
+  REQUIRE((slice.isArray() && 1 == slice.length()));
+  VPackSlice errorNum = slice.at(0).get(StaticStrings::ErrorNum);
+  return errorNum.isNumber() ? errorNum.getNumber<int>() : TRI_ERROR_NO_ERROR;
+}
+
+/// @brief returns the value attribute of the document with the given key
+int documentValue(TRI_vocbase_t& vocbase, LogicalCollection& collection,
+                  std::string const& key) {
+  VPackBuilder search;
+  search.openObject();
+  search.add(StaticStrings::KeyString, VPackValue(key));
+  search.close();
+
+  OperationOptions options;
+  SingleCollectionTransaction trx(transaction::StandaloneContext::Create(vocbase),
+                                  collection, AccessMode::Type::READ);
+  REQUIRE((trx.begin().ok()));
+  OperationResult result = trx.document(collection.name(), search.slice(), options);
+  REQUIRE((result.ok()));
+  int value = result.slice().get("value").getNumber<int>();
+  REQUIRE((trx.commit().ok()));
+  return value;
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+TEST_CASE("TransactionMethodsRepsert", "[transaction]") {
+  TransactionMethodsSetup s;
+  (void)(s);
+
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1, "testVocbase");
+
+  SECTION("single and array repserts replace existing documents alike") {
+    auto createJson = VPackParser::fromJson("{ \"name\": \"testCollection\" }");
+    auto collection = vocbase.createCollection(createJson->slice());
+    REQUIRE((nullptr != collection));
+
+    auto doc = VPackParser::fromJson("{ \"_key\": \"abc\", \"value\": 1 }");
+    CHECK((TRI_ERROR_NO_ERROR == repsert(vocbase, *collection, doc->slice(), false)));
+    CHECK((1 == documentValue(vocbase, *collection, "abc")));
+
+    doc = VPackParser::fromJson("{ \"_key\": \"abc\", \"value\": 2 }");
+    CHECK((TRI_ERROR_NO_ERROR == repsert(vocbase, *collection, doc->slice(), false)));
+    CHECK((2 == documentValue(vocbase, *collection, "abc")));
+
+    doc = VPackParser::fromJson("{ \"_key\": \"abc\", \"value\": 3 }");
+    CHECK((TRI_ERROR_NO_ERROR == repsert(vocbase, *collection, doc->slice(), true)));
+    CHECK((3 == documentValue(vocbase, *collection, "abc")));
+  }
+
+  SECTION("single and array repserts validate the key alike") {
+    auto createJson = VPackParser::fromJson(
+        "{ \"name\": \"testCollection\", \"keyOptions\": { \"allowUserKeys\": "
+        "false } }");
+    auto collection = vocbase.createCollection(createJson->slice());
+    REQUIRE((nullptr != collection));
+
+    // a restore may bring in documents with keys the generator would reject
+    {
+      auto doc = VPackParser::fromJson("{ \"_key\": \"abc\", \"value\": 1 }");
+      OperationOptions options;
+      options.isRestore = true;
+      SingleCollectionTransaction trx(transaction::StandaloneContext::Create(vocbase),
+                                      *collection, AccessMode::Type::WRITE);
+      REQUIRE((trx.begin().ok()));
+      REQUIRE((trx.insert(collection->name(), doc->slice(), options).ok()));
+      REQUIRE((trx.commit().ok()));
+    }
+
+    auto doc = VPackParser::fromJson("{ \"_key\": \"abc\", \"value\": 2 }");
+    CHECK((TRI_ERROR_ARANGO_DOCUMENT_KEY_UNEXPECTED ==
+           repsert(vocbase, *collection, doc->slice(), false)));
+    CHECK((TRI_ERROR_ARANGO_DOCUMENT_KEY_UNEXPECTED ==
+           repsert(vocbase, *collection, doc->slice(), true)));
+    CHECK((1 == documentValue(vocbase, *collection, "abc")));
+  }
+}
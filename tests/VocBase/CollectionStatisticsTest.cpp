@@ -0,0 +1,180 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Basics/Exceptions.h"
+#include "VocBase/CollectionStatistics.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/Options.h>
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace {
+VPackOptions const* options = &VPackOptions::Defaults;
+
+/// @brief 1000 documents. "unique" is different in every document, "skewed"
+/// is "hot" in half of them and one of 50 other values in the rest, and
+/// "sparse" is only there in every other document
+VPackBuilder makeDocuments() {
+  VPackBuilder builder;
+  builder.openArray();
+  for (size_t i = 0; i < 1000; ++i) {
+    builder.openObject();
+    builder.add("_key", VPackValue(std::to_string(i)));
+    builder.add("unique", VPackValue(i));
+    builder.add("skewed", VPackValue(i < 500 ? std::string("hot")
+                                             : "cold" + std::to_string(i % 50)));
+    if (i % 2 == 0) {
+      builder.add("sparse", VPackValue(1));
+    }
+    builder.close();
+  }
+  builder.close();
+  return builder;
+}
+
+std::vector<VPackSlice> slices(VPackSlice documents) {
+  std::vector<VPackSlice> result;
+  for (VPackSlice it : VPackArrayIterator(documents)) {
+    result.emplace_back(it);
+  }
+  return result;
+}
+
+VPackBuilder value(std::string const& v) {
+  VPackBuilder builder;
+  builder.add(VPackValue(v));
+  return builder;
+}
+
+VPackBuilder value(int v) {
+  VPackBuilder builder;
+  builder.add(VPackValue(v));
+  return builder;
+}
+}  // namespace
+
+SCENARIO("Collection statistics", "[VocBase][STATISTICS]") {
+  GIVEN("statistics of all documents of a collection") {
+    VPackBuilder documents = makeDocuments();
+    CollectionStatistics statistics(slices(documents.slice()), 1000, options);
+
+    THEN("system attributes are left out") {
+      CHECK(statistics.sampleSize() == 1000);
+      CHECK(statistics.numberDocuments() == 1000);
+      CHECK(statistics.attribute("_key") == nullptr);
+      CHECK(statistics.attribute("missing") == nullptr);
+    }
+
+    THEN("equality is judged by the frequency of the value") {
+      auto attribute = statistics.attribute("skewed");
+      REQUIRE(attribute != nullptr);
+      CHECK(attribute->distinctValues == Approx(51.0));
+      CHECK(attribute->mostCommonFrequencies.size() == 1);
+      CHECK(attribute->equalitySelectivity(value("hot").slice(), options) == Approx(0.5));
+      CHECK(attribute->equalitySelectivity(value("cold7").slice(), options) == Approx(0.01));
+      CHECK(attribute->equalitySelectivity(VPackSlice::nullSlice(), options) == Approx(0.0));
+
+      attribute = statistics.attribute("unique");
+      REQUIRE(attribute != nullptr);
+      CHECK(attribute->mostCommonFrequencies.empty());
+      CHECK(attribute->equalitySelectivity(value(5).slice(), options) == Approx(0.001));
+    }
+
+    THEN("ranges are judged by the histogram") {
+      auto attribute = statistics.attribute("unique");
+      REQUIRE(attribute != nullptr);
+      CHECK(attribute->rangeSelectivity(VPackSlice::noneSlice(), false,
+                                        value(250).slice(), false, options) ==
+            Approx(0.25).margin(0.01));
+      CHECK(attribute->rangeSelectivity(value(100).slice(), true, value(200).slice(),
+                                        false, options) == Approx(0.1).margin(0.01));
+      CHECK(attribute->rangeSelectivity(value(2000).slice(), true,
+                                        VPackSlice::noneSlice(), false, options) ==
+            Approx(0.0));
+      CHECK(attribute->rangeSelectivity(VPackSlice::noneSlice(), false,
+                                        VPackSlice::noneSlice(), false, options) ==
+            Approx(1.0));
+    }
+
+    THEN("missing attributes count as null") {
+      auto attribute = statistics.attribute("sparse");
+      REQUIRE(attribute != nullptr);
+      CHECK(attribute->nullFraction == Approx(0.5));
+      CHECK(attribute->equalitySelectivity(VPackSlice::nullSlice(), options) == Approx(0.5));
+      CHECK(attribute->equalitySelectivity(value(1).slice(), options) == Approx(0.5));
+      // null is smaller than any number
+      CHECK(attribute->rangeSelectivity(VPackSlice::noneSlice(), false,
+                                        value(5).slice(), false, options) == Approx(1.0));
+      CHECK(attribute->rangeSelectivity(value(0).slice(), false,
+                                        VPackSlice::noneSlice(), false, options) ==
+            Approx(0.5));
+    }
+
+    THEN("they survive serialization") {
+      VPackBuilder builder;
+      statistics.toVelocyPack(builder);
+      CollectionStatistics other(builder.slice());
+      CHECK(other.sampleSize() == 1000);
+      CHECK(other.numberDocuments() == 1000);
+
+      auto attribute = other.attribute("skewed");
+      REQUIRE(attribute != nullptr);
+      CHECK(attribute->equalitySelectivity(value("hot").slice(), options) == Approx(0.5));
+      attribute = other.attribute("unique");
+      REQUIRE(attribute != nullptr);
+      CHECK(attribute->rangeSelectivity(VPackSlice::noneSlice(), false,
+                                        value(250).slice(), false, options) ==
+            Approx(0.25).margin(0.01));
+    }
+  }
+
+  GIVEN("statistics of a sample") {
+    VPackBuilder documents = makeDocuments();
+    CollectionStatistics statistics(slices(documents.slice()), 10000, options);
+
+    THEN("the number of distinct values is extrapolated") {
+      auto attribute = statistics.attribute("unique");
+      REQUIRE(attribute != nullptr);
+      CHECK(attribute->distinctValues == Approx(10000.0));
+
+      // every value has been seen often, there are probably no others
+      attribute = statistics.attribute("skewed");
+      REQUIRE(attribute != nullptr);
+      CHECK(attribute->distinctValues == Approx(51.0));
+    }
+  }
+
+  GIVEN("invalid statistics") {
+    VPackBuilder builder;
+    builder.openObject();
+    builder.add("numberDocuments", VPackValue(1));
+    builder.close();
+
+    THEN("they are rejected") {
+      CHECK_THROWS_AS(CollectionStatistics(builder.slice()), basics::Exception);
+    }
+  }
+}